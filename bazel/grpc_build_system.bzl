@@ -33,8 +33,9 @@ load("@upb//bazel:upb_proto_library.bzl", "upb_proto_library", "upb_proto_reflec
 load("@build_bazel_rules_apple//apple:ios.bzl", "ios_unit_test")
 load("@build_bazel_rules_apple//apple/testing/default_runner:ios_test_runner.bzl", "ios_test_runner")
 
-# The set of pollers to test against if a test exercises polling
-POLLERS = ["epoll1", "poll"]
+# The set of pollers to test against if a test exercises polling. The io_uring
+# variants of tests exit early on kernels that don't support it.
+POLLERS = ["epoll1", "io_uring", "poll"]
 
 # The set of known EventEngines to test
 EVENT_ENGINES = {"default": {"tags": []}}
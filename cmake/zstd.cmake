@@ -0,0 +1,39 @@
+# Copyright 2026 gRPC authors.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# zstd is not bundled in third_party, so it is only used when requested with
+# gRPC_ZSTD_PROVIDER=package. It backs the GRPC_COMPRESS_ZSTD algorithm,
+# which channels never enable when gRPC is built without it.
+
+if(gRPC_ZSTD_PROVIDER STREQUAL "package")
+  # zstd installed by its own cmake build provides a config package, while
+  # distribution packages often only ship the library and header.
+  find_package(zstd CONFIG QUIET)
+  if(TARGET zstd::libzstd_shared)
+    set(_gRPC_ZSTD_LIBRARIES zstd::libzstd_shared)
+    set(_gRPC_FIND_ZSTD "if(NOT zstd_FOUND)\n  find_package(zstd CONFIG)\nendif()")
+  elseif(TARGET zstd::libzstd_static)
+    set(_gRPC_ZSTD_LIBRARIES zstd::libzstd_static)
+    set(_gRPC_FIND_ZSTD "if(NOT zstd_FOUND)\n  find_package(zstd CONFIG)\nendif()")
+  else()
+    find_path(ZSTD_INCLUDE_DIR zstd.h)
+    find_library(ZSTD_LIBRARY NAMES zstd)
+    if(NOT ZSTD_INCLUDE_DIR OR NOT ZSTD_LIBRARY)
+      message(FATAL_ERROR "gRPC_ZSTD_PROVIDER is \"package\" but zstd was not found")
+    endif()
+    include_directories("${ZSTD_INCLUDE_DIR}")
+    set(_gRPC_ZSTD_LIBRARIES ${ZSTD_LIBRARY})
+  endif()
+  add_definitions(-DGRPC_ZSTD=1)
+endif()
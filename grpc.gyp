@@ -314,6 +314,7 @@
         'src/core/lib/gpr/atm.cc',
         'src/core/lib/gpr/cpu_iphone.cc',
         'src/core/lib/gpr/cpu_linux.cc',
+        'src/core/lib/gpr/cpu_numa.cc',
         'src/core/lib/gpr/cpu_posix.cc',
         'src/core/lib/gpr/cpu_windows.cc',
         'src/core/lib/gpr/env_linux.cc',
@@ -321,6 +322,7 @@
         'src/core/lib/gpr/env_windows.cc',
         'src/core/lib/gpr/log.cc',
         'src/core/lib/gpr/log_android.cc',
+        'src/core/lib/gpr/log_async.cc',
         'src/core/lib/gpr/log_linux.cc',
         'src/core/lib/gpr/log_posix.cc',
         'src/core/lib/gpr/log_windows.cc',
@@ -342,6 +344,7 @@
         'src/core/lib/gpr/tmpfile_windows.cc',
         'src/core/lib/gpr/wrap_memcpy.cc',
         'src/core/lib/gprpp/examine_stack.cc',
+        'src/core/lib/gprpp/fast_random.cc',
         'src/core/lib/gprpp/fork.cc',
         'src/core/lib/gprpp/global_config_env.cc',
         'src/core/lib/gprpp/host_port.cc',
@@ -373,9 +376,11 @@
         'address_sorting',
       ],
       'sources': [
+        'src/core/ext/filters/backend_metrics/backend_metric_filter.cc',
         'src/core/ext/filters/census/grpc_context.cc',
         'src/core/ext/filters/channel_idle/channel_idle_filter.cc',
         'src/core/ext/filters/channel_idle/idle_filter_state.cc',
+        'src/core/ext/filters/client_channel/adaptive_throttle_filter.cc',
         'src/core/ext/filters/client_channel/backend_metric.cc',
         'src/core/ext/filters/client_channel/backup_poller.cc',
         'src/core/ext/filters/client_channel/channel_connectivity.cc',
@@ -396,12 +401,15 @@
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_balancer_addresses.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
+        'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
         'src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.cc',
+        'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
         'src/core/ext/filters/client_channel/lb_policy/priority/priority.cc',
         'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
         'src/core/ext/filters/client_channel/lb_policy/rls/rls.cc',
         'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+        'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
         'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
         'src/core/ext/filters/client_channel/lb_policy/xds/cds.cc',
         'src/core/ext/filters/client_channel/lb_policy/xds/xds_cluster_impl.cc',
@@ -427,6 +435,7 @@
         'src/core/ext/filters/client_channel/resolver/sockaddr/sockaddr_resolver.cc',
         'src/core/ext/filters/client_channel/resolver/xds/xds_resolver.cc',
         'src/core/ext/filters/client_channel/resolver_result_parsing.cc',
+        'src/core/ext/filters/client_channel/response_cache_filter.cc',
         'src/core/ext/filters/client_channel/retry_filter.cc',
         'src/core/ext/filters/client_channel/retry_service_config.cc',
         'src/core/ext/filters/client_channel/retry_throttle.cc',
@@ -434,6 +443,7 @@
         'src/core/ext/filters/client_channel/subchannel.cc',
         'src/core/ext/filters/client_channel/subchannel_pool_interface.cc',
         'src/core/ext/filters/client_channel/subchannel_stream_client.cc',
+        'src/core/ext/filters/concurrency_limit/concurrency_limit_filter.cc',
         'src/core/ext/filters/deadline/deadline_filter.cc',
         'src/core/ext/filters/fault_injection/fault_injection_filter.cc',
         'src/core/ext/filters/fault_injection/service_config_parser.cc',
@@ -786,6 +796,7 @@
         'src/core/lib/channel/connected_channel.cc',
         'src/core/lib/channel/promise_based_filter.cc',
         'src/core/lib/channel/status_util.cc',
+        'src/core/lib/channel/tx_latency_reporter.cc',
         'src/core/lib/compression/compression.cc',
         'src/core/lib/compression/compression_internal.cc',
         'src/core/lib/compression/message_compress.cc',
@@ -793,10 +804,16 @@
         'src/core/lib/debug/stats.cc',
         'src/core/lib/debug/stats_data.cc',
         'src/core/lib/debug/trace.cc',
+        'src/core/lib/event_engine/caching_dns_resolver.cc',
         'src/core/lib/event_engine/channel_args_endpoint_config.cc',
         'src/core/lib/event_engine/default_event_engine_factory.cc',
         'src/core/lib/event_engine/event_engine.cc',
         'src/core/lib/event_engine/memory_allocator.cc',
+        'src/core/lib/event_engine/posix_engine/event_poller.cc',
+        'src/core/lib/event_engine/posix_engine/posix_endpoint.cc',
+        'src/core/lib/event_engine/posix_engine/posix_engine.cc',
+        'src/core/lib/event_engine/posix_engine/thread_pool.cc',
+        'src/core/lib/event_engine/posix_engine/timer_manager.cc',
         'src/core/lib/event_engine/resolved_address.cc',
         'src/core/lib/event_engine/slice.cc',
         'src/core/lib/event_engine/slice_buffer.cc',
@@ -820,6 +837,7 @@
         'src/core/lib/iomgr/error_cfstream.cc',
         'src/core/lib/iomgr/ev_apple.cc',
         'src/core/lib/iomgr/ev_epoll1_linux.cc',
+        'src/core/lib/iomgr/ev_io_uring_linux.cc',
         'src/core/lib/iomgr/ev_poll_posix.cc',
         'src/core/lib/iomgr/ev_posix.cc',
         'src/core/lib/iomgr/ev_windows.cc',
@@ -835,6 +853,7 @@
         'src/core/lib/iomgr/executor.cc',
         'src/core/lib/iomgr/executor/mpmcqueue.cc',
         'src/core/lib/iomgr/executor/threadpool.cc',
+        'src/core/lib/iomgr/executor/work_stealing_threadpool.cc',
         'src/core/lib/iomgr/fork_posix.cc',
         'src/core/lib/iomgr/fork_windows.cc',
         'src/core/lib/iomgr/gethostname_fallback.cc',
@@ -884,6 +903,7 @@
         'src/core/lib/iomgr/timer_generic.cc',
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
         'src/core/lib/iomgr/wakeup_fd_eventfd.cc',
@@ -897,6 +917,7 @@
         'src/core/lib/matchers/matchers.cc',
         'src/core/lib/promise/activity.cc',
         'src/core/lib/promise/sleep.cc',
+        'src/core/lib/resolver/dns_cache.cc',
         'src/core/lib/resolver/resolver.cc',
         'src/core/lib/resolver/resolver_registry.cc',
         'src/core/lib/resolver/server_address.cc',
@@ -969,6 +990,7 @@
         'src/core/lib/service_config/service_config_impl.cc',
         'src/core/lib/service_config/service_config_parser.cc',
         'src/core/lib/slice/b64.cc',
+        'src/core/lib/slice/b64_kernels.cc',
         'src/core/lib/slice/percent_encoding.cc',
         'src/core/lib/slice/slice.cc',
         'src/core/lib/slice/slice_api.cc',
@@ -1129,9 +1151,11 @@
         'address_sorting',
       ],
       'sources': [
+        'src/core/ext/filters/backend_metrics/backend_metric_filter.cc',
         'src/core/ext/filters/census/grpc_context.cc',
         'src/core/ext/filters/channel_idle/channel_idle_filter.cc',
         'src/core/ext/filters/channel_idle/idle_filter_state.cc',
+        'src/core/ext/filters/client_channel/adaptive_throttle_filter.cc',
         'src/core/ext/filters/client_channel/backend_metric.cc',
         'src/core/ext/filters/client_channel/backup_poller.cc',
         'src/core/ext/filters/client_channel/channel_connectivity.cc',
@@ -1152,12 +1176,15 @@
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_balancer_addresses.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
+        'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
         'src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.cc',
+        'src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.cc',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
         'src/core/ext/filters/client_channel/lb_policy/priority/priority.cc',
         'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
         'src/core/ext/filters/client_channel/lb_policy/rls/rls.cc',
         'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+        'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
         'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
         'src/core/ext/filters/client_channel/lb_policy_registry.cc',
         'src/core/ext/filters/client_channel/local_subchannel_pool.cc',
@@ -1177,6 +1204,7 @@
         'src/core/ext/filters/client_channel/resolver/polling_resolver.cc',
         'src/core/ext/filters/client_channel/resolver/sockaddr/sockaddr_resolver.cc',
         'src/core/ext/filters/client_channel/resolver_result_parsing.cc',
+        'src/core/ext/filters/client_channel/response_cache_filter.cc',
         'src/core/ext/filters/client_channel/retry_filter.cc',
         'src/core/ext/filters/client_channel/retry_service_config.cc',
         'src/core/ext/filters/client_channel/retry_throttle.cc',
@@ -1184,6 +1212,7 @@
         'src/core/ext/filters/client_channel/subchannel.cc',
         'src/core/ext/filters/client_channel/subchannel_pool_interface.cc',
         'src/core/ext/filters/client_channel/subchannel_stream_client.cc',
+        'src/core/ext/filters/concurrency_limit/concurrency_limit_filter.cc',
         'src/core/ext/filters/deadline/deadline_filter.cc',
         'src/core/ext/filters/fault_injection/fault_injection_filter.cc',
         'src/core/ext/filters/fault_injection/service_config_parser.cc',
@@ -1251,6 +1280,7 @@
         'src/core/lib/channel/connected_channel.cc',
         'src/core/lib/channel/promise_based_filter.cc',
         'src/core/lib/channel/status_util.cc',
+        'src/core/lib/channel/tx_latency_reporter.cc',
         'src/core/lib/compression/compression.cc',
         'src/core/lib/compression/compression_internal.cc',
         'src/core/lib/compression/message_compress.cc',
@@ -1258,10 +1288,16 @@
         'src/core/lib/debug/stats.cc',
         'src/core/lib/debug/stats_data.cc',
         'src/core/lib/debug/trace.cc',
+        'src/core/lib/event_engine/caching_dns_resolver.cc',
         'src/core/lib/event_engine/channel_args_endpoint_config.cc',
         'src/core/lib/event_engine/default_event_engine_factory.cc',
         'src/core/lib/event_engine/event_engine.cc',
         'src/core/lib/event_engine/memory_allocator.cc',
+        'src/core/lib/event_engine/posix_engine/event_poller.cc',
+        'src/core/lib/event_engine/posix_engine/posix_endpoint.cc',
+        'src/core/lib/event_engine/posix_engine/posix_engine.cc',
+        'src/core/lib/event_engine/posix_engine/thread_pool.cc',
+        'src/core/lib/event_engine/posix_engine/timer_manager.cc',
         'src/core/lib/event_engine/resolved_address.cc',
         'src/core/lib/event_engine/slice.cc',
         'src/core/lib/event_engine/slice_buffer.cc',
@@ -1284,6 +1320,7 @@
         'src/core/lib/iomgr/error_cfstream.cc',
         'src/core/lib/iomgr/ev_apple.cc',
         'src/core/lib/iomgr/ev_epoll1_linux.cc',
+        'src/core/lib/iomgr/ev_io_uring_linux.cc',
         'src/core/lib/iomgr/ev_poll_posix.cc',
         'src/core/lib/iomgr/ev_posix.cc',
         'src/core/lib/iomgr/ev_windows.cc',
@@ -1299,6 +1336,7 @@
         'src/core/lib/iomgr/executor.cc',
         'src/core/lib/iomgr/executor/mpmcqueue.cc',
         'src/core/lib/iomgr/executor/threadpool.cc',
+        'src/core/lib/iomgr/executor/work_stealing_threadpool.cc',
         'src/core/lib/iomgr/fork_posix.cc',
         'src/core/lib/iomgr/fork_windows.cc',
         'src/core/lib/iomgr/gethostname_fallback.cc',
@@ -1348,6 +1386,7 @@
         'src/core/lib/iomgr/timer_generic.cc',
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
         'src/core/lib/iomgr/wakeup_fd_eventfd.cc',
@@ -1360,6 +1399,7 @@
         'src/core/lib/json/json_writer.cc',
         'src/core/lib/promise/activity.cc',
         'src/core/lib/promise/sleep.cc',
+        'src/core/lib/resolver/dns_cache.cc',
         'src/core/lib/resolver/resolver.cc',
         'src/core/lib/resolver/resolver_registry.cc',
         'src/core/lib/resolver/server_address.cc',
@@ -1394,6 +1434,7 @@
         'src/core/lib/service_config/service_config_impl.cc',
         'src/core/lib/service_config/service_config_parser.cc',
         'src/core/lib/slice/b64.cc',
+        'src/core/lib/slice/b64_kernels.cc',
         'src/core/lib/slice/percent_encoding.cc',
         'src/core/lib/slice/slice.cc',
         'src/core/lib/slice/slice_api.cc',
@@ -1489,6 +1530,7 @@
         'src/core/ext/transport/binder/wire_format/wire_reader_impl.cc',
         'src/core/ext/transport/binder/wire_format/wire_writer.cc',
         'src/cpp/client/channel_cc.cc',
+        'src/cpp/client/channel_pool.cc',
         'src/cpp/client/client_callback.cc',
         'src/cpp/client/client_context.cc',
         'src/cpp/client/client_interceptor.cc',
@@ -1517,6 +1559,7 @@
         'src/cpp/common/validate_service_config.cc',
         'src/cpp/common/version_cc.cc',
         'src/cpp/server/async_generic_service.cc',
+        'src/cpp/server/backend_metric_recorder.cc',
         'src/cpp/server/channel_argument_option.cc',
         'src/cpp/server/create_default_thread_pool.cc',
         'src/cpp/server/dynamic_thread_pool.cc',
@@ -1622,6 +1665,7 @@
       ],
       'sources': [
         'src/cpp/client/channel_cc.cc',
+        'src/cpp/client/channel_pool.cc',
         'src/cpp/client/client_callback.cc',
         'src/cpp/client/client_context.cc',
         'src/cpp/client/client_interceptor.cc',
@@ -1642,6 +1686,7 @@
         'src/cpp/common/validate_service_config.cc',
         'src/cpp/common/version_cc.cc',
         'src/cpp/server/async_generic_service.cc',
+        'src/cpp/server/backend_metric_recorder.cc',
         'src/cpp/server/channel_argument_option.cc',
         'src/cpp/server/create_default_thread_pool.cc',
         'src/cpp/server/dynamic_thread_pool.cc',
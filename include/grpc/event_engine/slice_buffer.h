@@ -52,15 +52,42 @@ class SliceBuffer {
  public:
   explicit SliceBuffer() { grpc_slice_buffer_init(&slice_buffer_); }
   SliceBuffer(const SliceBuffer& other) = delete;
-  SliceBuffer(SliceBuffer&& other) noexcept
-      : slice_buffer_(other.slice_buffer_) {
-    grpc_slice_buffer_reset_and_unref(&slice_buffer_);
+  SliceBuffer(SliceBuffer&& other) noexcept {
+    grpc_slice_buffer_init(&slice_buffer_);
     grpc_slice_buffer_swap(&slice_buffer_, &other.slice_buffer_);
   }
   /// Upon destruction, the underlying raw slice buffer is cleaned out and all
   /// slices are unreffed.
   ~SliceBuffer() { grpc_slice_buffer_destroy(&slice_buffer_); }
 
+  SliceBuffer& operator=(SliceBuffer&& other) noexcept {
+    grpc_slice_buffer_reset_and_unref(&slice_buffer_);
+    grpc_slice_buffer_swap(&slice_buffer_, &other.slice_buffer_);
+    return *this;
+  }
+
+  /// Ownership transfer from and to a \a grpc_slice_buffer, for endpoint
+  /// shims and custom EventEngines that exchange data with C-core. The
+  /// slices themselves change hands: none is copied, reffed or unreffed, and
+  /// no memory is allocated, so a transfer costs the same however much data
+  /// the buffers hold.
+  ///
+  /// Returns a SliceBuffer holding the slices of \a slice_buffer, which is
+  /// left empty but still initialized.
+  static SliceBuffer TakeCSliceBuffer(grpc_slice_buffer& slice_buffer) {
+    SliceBuffer taken;
+    grpc_slice_buffer_swap(&taken.slice_buffer_, &slice_buffer);
+    return taken;
+  }
+
+  /// Moves the slices of the SliceBuffer to the end of \a slice_buffer,
+  /// leaving the SliceBuffer empty. Transfers ownership as \a
+  /// TakeCSliceBuffer does if \a slice_buffer is empty; otherwise the slice
+  /// handles are appended to it one by one.
+  void MoveIntoCSliceBuffer(grpc_slice_buffer& slice_buffer) {
+    grpc_slice_buffer_move_into(&slice_buffer_, &slice_buffer);
+  }
+
   /// Appends a new slice into the SliceBuffer and makes an attempt to merge
   /// this slice with the last slice in the SliceBuffer.
   void Append(Slice slice);
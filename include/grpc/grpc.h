@@ -134,6 +134,22 @@ GRPCAPI grpc_event grpc_completion_queue_next(grpc_completion_queue* cq,
                                               gpr_timespec deadline,
                                               void* reserved);
 
+/** Like grpc_completion_queue_next, but once an event is available also
+    returns up to max_events - 1 further events that are already queued,
+    without polling again.
+
+    'events' must point to an array of at least max_events (> 0) entries.
+    Returns the number of events written to it, which is always at least one:
+    on timeout or shutdown a single GRPC_QUEUE_TIMEOUT or GRPC_QUEUE_SHUTDOWN
+    event is returned.
+
+    Only valid on completion queues of type GRPC_CQ_NEXT. */
+GRPCAPI size_t grpc_completion_queue_next_batch(grpc_completion_queue* cq,
+                                                grpc_event* events,
+                                                size_t max_events,
+                                                gpr_timespec deadline,
+                                                void* reserved);
+
 /** Blocks until an event with tag 'tag' is available, the completion queue is
     being shutdown or deadline is reached.
 
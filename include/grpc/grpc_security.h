@@ -887,6 +887,52 @@ GRPCAPI void grpc_tls_credentials_options_set_cert_request_type(
 GRPCAPI void grpc_tls_credentials_options_set_crl_directory(
     grpc_tls_credentials_options* options, const char* crl_directory);
 
+/**
+ * EXPERIMENTAL API - Subject to change
+ *
+ * Callback through which a grpc_tls_private_key_signer returns the result of
+ * a sign request. It must be called exactly once per request, from any
+ * thread. If status is not GRPC_STATUS_OK, signature is ignored.
+ */
+typedef void (*grpc_tls_private_key_sign_done_cb)(
+    void* done_arg, grpc_status_code status, const unsigned char* signature,
+    size_t signature_size);
+
+/**
+ * EXPERIMENTAL API - Subject to change
+ *
+ * Signs TLS handshakes with an identity private key that gRPC does not hold,
+ * e.g. one kept in a hardware security module or by a remote signing service.
+ * - sign signs |in| with |signature_algorithm|, a TLS SignatureScheme code
+ *   point such as 0x0804 (rsa_pss_rsae_sha256), and passes the signature to
+ *   |done_cb|. It may call |done_cb| before returning, or later from another
+ *   thread: the handshake is suspended, without blocking the thread that
+ *   drives it, until the signature is available. |in| is only valid until
+ *   sign returns.
+ * - destroy, if not NULL, is called with user_data when the signer is no
+ *   longer used.
+ */
+typedef struct grpc_tls_private_key_signer {
+  void* user_data;
+  void (*sign)(void* user_data, uint16_t signature_algorithm,
+               const unsigned char* in, size_t in_len,
+               grpc_tls_private_key_sign_done_cb done_cb, void* done_arg);
+  void (*destroy)(void* user_data);
+} grpc_tls_private_key_signer;
+
+/**
+ * EXPERIMENTAL API - Subject to change
+ *
+ * Makes handshakes sign with |signer| instead of the private key of the
+ * identity key-cert pair, which may then be empty. The signer is copied, and
+ * its user_data is owned by the options from then on. Only supported when
+ * gRPC is built with BoringSSL; with other SSL libraries the security
+ * connectors of these options fail to be created.
+ */
+GRPCAPI void grpc_tls_credentials_options_set_private_key_signer(
+    grpc_tls_credentials_options* options,
+    const grpc_tls_private_key_signer* signer);
+
 /**
  * EXPERIMENTAL API - Subject to change
  *
@@ -1087,6 +1133,20 @@ void grpc_tls_credentials_options_set_certificate_verifier(
     grpc_tls_credentials_options* options,
     grpc_tls_certificate_verifier* verifier);
 
+/**
+ * EXPERIMENTAL API - Subject to change
+ *
+ * Caches successful results of the verifier in options for |ttl_ms|
+ * milliseconds, keyed by the certificate chain the peer presented and the
+ * target name. The cache is shared by all handshakes that use |options|, so a
+ * peer that reconnects is not verified again until its result expires. All
+ * cached results are dropped when the root certificates are updated. Failed
+ * verifications are not cached. A |ttl_ms| of 0 or less disables the cache,
+ * which is the default.
+ */
+void grpc_tls_credentials_options_set_verification_cache_ttl(
+    grpc_tls_credentials_options* options, int ttl_ms);
+
 /**
  * EXPERIMENTAL API - Subject to change
  *
@@ -52,6 +52,17 @@ extern "C" {
  * be ignored). */
 #define GRPC_COMPRESSION_CHANNEL_ENABLED_ALGORITHMS_BITSET \
   "grpc.compression_enabled_algorithms_bitset"
+/** Decide per message whether compressing it is worthwhile. Messages smaller
+ * than \a GRPC_COMPRESSION_CHANNEL_ADAPTIVE_MIN_MESSAGE_SIZE, messages of
+ * methods whose recent messages compressed poorly, and messages that would
+ * exceed the process's compression CPU budget (the
+ * GRPC_COMPRESSION_CPU_BUDGET_MS environment variable) are sent uncompressed.
+ * Boolean, defaults to false. */
+#define GRPC_COMPRESSION_CHANNEL_ADAPTIVE "grpc.compression_adaptive"
+/** Size in bytes under which adaptive compression sends messages
+ * uncompressed. Int valued, defaults to 256. */
+#define GRPC_COMPRESSION_CHANNEL_ADAPTIVE_MIN_MESSAGE_SIZE \
+  "grpc.compression_adaptive_min_message_size"
 /** \} */
 
 /** The various compression algorithms supported by gRPC (not sorted by
@@ -60,6 +71,10 @@ typedef enum {
   GRPC_COMPRESS_NONE = 0,
   GRPC_COMPRESS_DEFLATE,
   GRPC_COMPRESS_GZIP,
+  /** Only available if gRPC is built with zstd, e.g. by configuring CMake
+   * with -DgRPC_ZSTD_PROVIDER=package. Otherwise it is never enabled in
+   * channels, and so neither advertised nor used. */
+  GRPC_COMPRESS_ZSTD,
   /* TODO(ctiller): snappy */
   GRPC_COMPRESS_ALGORITHMS_COUNT
 } grpc_compression_algorithm;
@@ -201,6 +201,20 @@ typedef struct {
 #define GRPC_ARG_HTTP2_MAX_FRAME_SIZE "grpc.http2.max_frame_size"
 /** Should BDP probing be performed? */
 #define GRPC_ARG_HTTP2_BDP_PROBE "grpc.http2.bdp_probe"
+/** Should the flow control windows be sized from a model of the bottleneck
+    bandwidth and min RTT measured by the BDP pings (BBR style), instead of
+    the default BDP estimator? Boolean, defaults to false. Has no effect if
+    BDP probing is disabled. */
+#define GRPC_ARG_HTTP2_BBR_FLOW_CONTROL "grpc.http2.bbr_flow_control"
+/** Should some SETTINGS be re-tuned from the observed traffic while the
+    connection is up? MAX_FRAME_SIZE is then also capped by the size of the
+    largest recently received messages, so that frames stay short (and streams
+    interleave) while only small messages flow, and HEADER_TABLE_SIZE is grown
+    while the peer keeps evicting entries from the HPACK decoder table.
+    Boolean, defaults to false. Needs BDP probing, which drives the updates;
+    HEADER_TABLE_SIZE is left alone if GRPC_ARG_HTTP2_HPACK_TABLE_SIZE_DECODER
+    is set. */
+#define GRPC_ARG_HTTP2_SETTINGS_AUTO_TUNING "grpc.http2.settings_auto_tuning"
 /** (DEPRECATED) Does not have any effect.
     Earlier, this arg configured the minimum time between successive ping frames
     without receiving any data/header frame, Int valued, milliseconds. This put
@@ -231,6 +245,23 @@ typedef struct {
 /** How much data are we willing to queue up per stream if
     GRPC_WRITE_BUFFER_HINT is set? This is an upper bound */
 #define GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE "grpc.http2.write_buffer_size"
+/** Write coalescing window, Int valued, microseconds. When non-zero, a write
+    that is smaller than GRPC_ARG_HTTP2_WRITE_COALESCING_BYTES is held back for
+    up to this long so that frames produced in the meantime go out in the same
+    endpoint write. Trades latency for fewer syscalls and larger packets.
+    Defaults to 0 (disabled). */
+#define GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_US \
+  "grpc.http2.write_coalescing_delay_us"
+/** Number of bytes that ends a write coalescing window early, Int valued.
+    Only used when GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_US is set.
+    Defaults to 16384. */
+#define GRPC_ARG_HTTP2_WRITE_COALESCING_BYTES \
+  "grpc.http2.write_coalescing_bytes"
+/** How many bytes of DATA frames a stream may write each time its turn comes
+    up before the other writable streams on the connection get a turn, Int
+    valued. Bounds how long small RPCs wait behind bulk transfers. 0 disables
+    the limit. Defaults to 16384. */
+#define GRPC_ARG_HTTP2_STREAM_WRITE_QUANTUM "grpc.http2.stream_write_quantum"
 /** Should we allow receipt of true-binary data on http2 connections?
     Defaults to on (1) */
 #define GRPC_ARG_HTTP2_ENABLE_TRUE_BINARY "grpc.http2.true_binary"
@@ -261,6 +292,23 @@ typedef struct {
 /** The time between the first and second connection attempts, in ms */
 #define GRPC_ARG_INITIAL_RECONNECT_BACKOFF_MS \
   "grpc.initial_reconnect_backoff_ms"
+/** If set to a positive value, pick_first does not wait for a connection
+    attempt to fail before trying the next address: after this many ms, it
+    starts connecting to the next address in parallel, and addresses of
+    different families are interleaved (RFC 8305, "Happy Eyeballs"). The first
+    attempt to succeed wins and the others are cancelled. Defaults to 0, which
+    tries the addresses one at a time. 250 is the value recommended by the
+    RFC. */
+#define GRPC_ARG_HAPPY_EYEBALLS_CONNECTION_ATTEMPT_DELAY_MS \
+  "grpc.experimental.happy_eyeballs_connection_attempt_delay_ms"
+/** If set to true, round_robin keeps one pick index per CPU instead of one
+    shared by all picks, so that picks made concurrently on different CPUs
+    do not contend on the same cache line. Each CPU's picks still go round
+    robin, but successive picks made on different CPUs may return the same
+    backend, so the distribution is only uniform to within one pick per CPU.
+    Boolean, defaults to false. */
+#define GRPC_ARG_ROUND_ROBIN_PER_CPU_PICKS \
+  "grpc.experimental.round_robin_per_cpu_picks"
 /** Minimum amount of time between DNS resolutions, in ms */
 #define GRPC_ARG_DNS_MIN_TIME_BETWEEN_RESOLUTIONS_MS \
   "grpc.dns_min_time_between_resolutions_ms"
@@ -279,6 +327,15 @@ typedef struct {
     grpc_ssl_session_cache*). (use grpc_ssl_session_cache_arg_vtable() to fetch
     an appropriate pointer arg vtable) */
 #define GRPC_SSL_SESSION_CACHE_ARG "grpc.ssl_session_cache"
+/** If non-zero, SSL connections that negotiate TLS 1.3 with AES-GCM or
+    ChaCha20-Poly1305 hand their write keys to the kernel (Linux kernel TLS)
+    after the handshake, so that writes are encrypted by the kernel, or the
+    NIC if it supports TLS offload, rather than by the secure endpoint.
+    Reads are still decrypted in user space. Falls back to user space
+    encryption if the kernel does not support it, or if
+    GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED is set, since kernel TLS does not accept
+    MSG_ZEROCOPY writes. Defaults to 0. */
+#define GRPC_ARG_SSL_KERNEL_TLS_TX "grpc.experimental.ssl_kernel_tls_tx"
 /** If non-zero, it will determine the maximum frame size used by TSI's frame
  *  protector.
  *
@@ -287,11 +344,48 @@ typedef struct {
  *        can break old binaries that don't support larger than 1MiB frame
  *        size. */
 #define GRPC_ARG_TSI_MAX_FRAME_SIZE "grpc.tsi.max_frame_size"
+/** If non-zero, the security handshaker runs the TSI handshaker (and so the
+    handshake crypto, such as RSA or ECDSA signing) on a dedicated thread
+    pool, with one thread per core, rather than on the thread that received
+    the handshake bytes. This keeps reconnect storms from stalling the
+    pollers that serve RPCs. Defaults to 0. */
+#define GRPC_ARG_SECURITY_HANDSHAKE_OFFLOAD \
+  "grpc.experimental.security_handshake_offload"
 /** Maximum metadata size, in bytes. Note this limit applies to the max sum of
     all metadata key-value entries in a batch of headers. */
 #define GRPC_ARG_MAX_METADATA_SIZE "grpc.max_metadata_size"
 /** If non-zero, allow the use of SO_REUSEPORT if it's available (default 1) */
 #define GRPC_ARG_ALLOW_REUSEPORT "grpc.so_reuseport"
+/** If non-zero, and SO_REUSEPORT is in use, a server started with several
+    pollsets gives each of them its own listening socket per port, hints the
+    kernel (via SO_INCOMING_CPU) that listener i serves CPU i, and keeps the
+    connections a listener accepts on that listener's pollset instead of
+    spreading them round-robin. (default 0) */
+#define GRPC_ARG_TCP_SERVER_PER_CPU_LISTENERS \
+  "grpc.experimental.tcp_server_per_cpu_listeners"
+/** If non-zero along with GRPC_ARG_TCP_SERVER_PER_CPU_LISTENERS, attach a
+    BPF program to each port's SO_REUSEPORT group that hands a connection
+    received on CPU c to listener (c % number of pollsets). Linux only.
+    (default 0) */
+#define GRPC_ARG_TCP_SERVER_CPU_STEERING_BPF \
+  "grpc.experimental.tcp_server_cpu_steering_bpf"
+/** If non-zero, the threads that poll and serve the i-th completion queue of
+    a C++ synchronous server are pinned to CPU i (modulo the number of CPUs).
+    Together with GRPC_ARG_TCP_SERVER_PER_CPU_LISTENERS, the connections
+    accepted by listener i, and their calls, stay on CPU i. Linux only.
+    (default 0) */
+#define GRPC_ARG_SYNC_SERVER_PIN_THREADS \
+  "grpc.experimental.sync_server_pin_threads"
+/** TCP Fast Open (Linux). On a client channel, if non-zero, connections are
+    made with TCP_FASTOPEN_CONNECT: once the client holds a Fast Open cookie
+    for the server, the first bytes of the handshake (the TLS ClientHello or
+    the HTTP/2 preface) are sent in the SYN, saving a round trip. On a
+    server, the maximum number of connections with data in their SYN that
+    may be pending their handshake on each listening socket (TCP_FASTOPEN);
+    the kernel must also allow server Fast Open (net.ipv4.tcp_fastopen).
+    Note that data in a SYN may be replayed by the network. Ignored where
+    unsupported. (default 0) */
+#define GRPC_ARG_TCP_FASTOPEN "grpc.experimental.tcp_fastopen"
 /** If non-zero, a pointer to a buffer pool (a pointer of type
  * grpc_resource_quota*). (use grpc_resource_quota_arg_vtable() to fetch an
  * appropriate pointer arg vtable) */
@@ -335,6 +429,13 @@ typedef struct {
   "grpc.experimental.tcp_min_read_chunk_size"
 #define GRPC_ARG_TCP_MAX_READ_CHUNK_SIZE \
   "grpc.experimental.tcp_max_read_chunk_size"
+/* TCP read buffer release: when non-zero, a TCP endpoint that has to wait for
+   data frees its read buffers until the data arrives, and after being idle
+   for a second goes back to reading GRPC_ARG_TCP_READ_CHUNK_SIZE bytes at a
+   time.  When zero, read buffers stay allocated between reads.  By default,
+   this is 1 (enabled). */
+#define GRPC_ARG_TCP_RELEASE_IDLE_READ_BUFFERS \
+  "grpc.experimental.tcp_release_idle_read_buffers"
 /* TCP TX Zerocopy enable state: zero is disabled, non-zero is enabled. By
    default, it is disabled. */
 #define GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED \
@@ -349,6 +450,85 @@ typedef struct {
    issued by the tcp_write(). By default, this is set to 4. */
 #define GRPC_ARG_TCP_TX_ZEROCOPY_MAX_SIMULT_SENDS \
   "grpc.experimental.tcp_tx_zerocopy_max_simultaneous_sends"
+/* TCP RX Zerocopy enable state: zero is disabled, non-zero is enabled. When
+   enabled, large reads map the received pages with TCP_ZEROCOPY_RECEIVE
+   instead of copying them, falling back to copying when the kernel does not
+   support it. By default, it is disabled. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED \
+  "grpc.experimental.tcp_rx_zerocopy_enabled"
+/* TCP RX Zerocopy receive threshold: only zerocopy if >= this many bytes are
+   pending on the socket. By default, this is set to 64KB. */
+#define GRPC_ARG_TCP_RX_ZEROCOPY_RECV_BYTES_THRESHOLD \
+  "grpc.experimental.tcp_rx_zerocopy_recv_bytes_threshold"
+/* Unix domain socket fd passing threshold, in bytes. When set to a positive
+   value on both ends of a connection over a unix: or unix-abstract: address,
+   writes of at least this many bytes are placed in a sealed memfd that is
+   passed with SCM_RIGHTS, and the receiver maps it instead of reading the
+   bytes through the socket. Only available on Linux, and not used under
+   transport security. By default, this is 0 (disabled). */
+#define GRPC_ARG_UNIX_FD_PASSING_THRESHOLD \
+  "grpc.experimental.unix_fd_passing_threshold"
+/* If set to non zero, calls on this channel report the latencies of the
+   kernel TX timestamps (sendmsg -> sent -> acked) of their writes to their
+   call attempt tracer and to the channel's channelz node. Only effective on
+   Linux when the kernel supports error queue timestamps. Defaults to 0. */
+#define GRPC_ARG_TCP_TX_TIMESTAMPS_ENABLED \
+  "grpc.experimental.tcp_tx_timestamps_enabled"
+/* C++ callback API: if set to a positive value, the callback completion queue
+   of a server or channel created with this arg runs reactions (OnReadDone,
+   OnWriteDone, ...) on the thread that completed the operation instead of
+   handing them to the executor. The value bounds how many such reactions one
+   thread runs back to back before the rest are handed off again, so
+   reactions must not block. Only effective when gRPC core backs callback
+   completion queues with its own pollers. Defaults to 0 (disabled). */
+#define GRPC_ARG_INLINE_CALLBACK_REACTIONS \
+  "grpc.experimental.inline_callback_reactions"
+/* In-process channels only: if set to 1, C++ messages sent over a channel
+   created by grpc::Server::InProcessChannel() with this arg, and the server's
+   replies on it, are handed to the receiver as copies of the message objects
+   instead of being serialized and parsed again. Messages still go through
+   their byte form when an interceptor is registered on the call, and the
+   channel's default compression settings turn the mode off. Defaults to 0. */
+#define GRPC_ARG_INPROC_OBJECT_PASSING "grpc.experimental.inproc_object_passing"
+/* Server only: if set to a positive value, every method of the server is
+   subject to an adaptive concurrency limit starting at this many concurrent
+   calls. The limit follows the observed call latency, and calls arriving while
+   the limit is reached fail immediately with RESOURCE_EXHAUSTED. Per method
+   limits may also be configured with the "concurrencyLimit" field of a method
+   config in a service config passed to the server in GRPC_ARG_SERVICE_CONFIG.
+   Defaults to 0 (disabled). */
+#define GRPC_ARG_SERVER_CONCURRENCY_LIMIT \
+  "grpc.experimental.server_concurrency_limit"
+/* How a server picks the completion queue that a new connection publishes
+   its calls to. "accepting" (the default) uses the queue whose poller
+   accepted the connection. "least_loaded" uses the queue with the fewest
+   active calls, then the fewest connections. */
+#define GRPC_ARG_SERVER_CQ_ASSIGNMENT "grpc.experimental.server_cq_assignment"
+/* If non-zero, a server connection whose completion queue has far more active
+   calls than the least loaded one publishes its later calls to that queue
+   instead. Defaults to 0 (disabled). */
+#define GRPC_ARG_SERVER_CQ_MIGRATION "grpc.experimental.server_cq_migration"
+/* If non-zero, a server sends the metrics that handlers record on a call's
+   CallMetricRecorder as an ORCA load report in the call's trailing metadata.
+   Defaults to 0 (disabled). */
+#define GRPC_ARG_SERVER_CALL_METRIC_RECORDING \
+  "grpc.experimental.server_call_metric_recording"
+/* QoS classes of the calls of a server, as a comma separated list of
+   path=class entries. The path is a method ("/pkg.Service/Method"), all the
+   methods of a service ("/pkg.Service/" followed by '*') or "*" for the
+   default class.
+   Classes go from 0 to 3, 1 being the default: when calls wait for the
+   application to request them, those of a lower class are matched first. */
+#define GRPC_ARG_SERVER_QOS_CLASSES "grpc.experimental.server_qos_classes"
+/* Metadata key whose value, if a valid class, overrides the QoS class of a
+   call. Only for servers whose clients are trusted to pick their class. */
+#define GRPC_ARG_SERVER_QOS_CLASS_METADATA_KEY \
+  "grpc.experimental.server_qos_class_metadata_key"
+/* Longest time in milliseconds that a call of a class other than 0 waits to
+   be requested before it is failed with RESOURCE_EXHAUSTED. Highest classes
+   are shed first. Defaults to 0 (disabled). */
+#define GRPC_ARG_SERVER_QOS_QUEUEING_DELAY_TARGET_MS \
+  "grpc.experimental.server_qos_queueing_delay_target_ms"
 /* Timeout in milliseconds to use for calls to the grpclb load balancer.
    If 0 or unset, the balancer calls will have no deadline. */
 #define GRPC_ARG_GRPCLB_CALL_TIMEOUT_MS "grpc.grpclb_call_timeout_ms"
@@ -363,6 +543,13 @@ typedef struct {
    the future. */
 #define GRPC_ARG_TEST_ONLY_DO_NOT_USE_IN_PROD_XDS_BOOTSTRAP_CONFIG \
   "grpc.TEST_ONLY_DO_NOT_USE_IN_PROD.xds_bootstrap_config"
+/* Window in milliseconds over which xDS LB policies coalesce updates. When
+   non-zero, an update (such as an EDS update or a child picker change) is
+   applied immediately, but further updates within the window are held and
+   applied together once it ends, so a burst of updates rebuilds the LB tree
+   and picker once instead of once per update. Defaults to 0 (disabled). */
+#define GRPC_ARG_XDS_UPDATE_COALESCING_WINDOW_MS \
+  "grpc.experimental.xds_update_coalescing_window_ms"
 /* Timeout in milliseconds to wait for the serverlist from the grpclb load
    balancer before using fallback backend addresses from the resolver.
    If 0, enter fallback mode immediately. Default value is 10000. */
@@ -372,6 +559,14 @@ typedef struct {
    over to the next priority. Default value is 10 seconds. */
 #define GRPC_ARG_PRIORITY_FAILOVER_TIMEOUT_MS \
   "grpc.priority_failover_timeout_ms"
+/* Number of priorities below the one in use that the priority LB policy
+   keeps connected, so that failing over to them does not wait for new
+   connections. While a higher priority is attempting to connect, a
+   pre-warmed priority that is READY is used instead of waiting for the
+   failover timeout. Each pre-warmed priority holds the connections of its
+   child policy. Default value is 0. */
+#define GRPC_ARG_PRIORITY_PREWARM_CHILDREN \
+  "grpc.experimental.priority_prewarm_children"
 /** If non-zero, grpc server's cronet compression workaround will be enabled */
 #define GRPC_ARG_WORKAROUND_CRONET_COMPRESSION \
   "grpc.workaround.cronet_compression"
@@ -388,15 +583,16 @@ typedef struct {
     retries are enabled when they are configured via the service config.
     For details, see:
       https://github.com/grpc/proposal/blob/master/A6-client-retries.md
-    NOTE: Hedging functionality is not yet implemented, so those
-          fields in the service config will currently be ignored.  See
-          also the GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING arg below.
+    NOTE: Hedging policies in the service config are ignored unless the
+          GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING arg below is also set.
  */
 #define GRPC_ARG_ENABLE_RETRIES "grpc.enable_retries"
 /** Enables hedging functionality, as described in:
       https://github.com/grpc/proposal/blob/master/A6-client-retries.md
-    Default is currently false, since this functionality is not yet
-    fully implemented.
+    When enabled, a method's hedgingPolicy sends additional attempts every
+    hedgingDelay until one of them receives response headers or a fatal
+    status, and hedged attempts are subject to retry throttling.
+    Default is currently false.
     NOTE: This channel arg is experimental and will eventually be removed.
           Once hedging functionality has been implemented and proves stable,
           this arg will be removed, and the hedging functionality will
@@ -404,6 +600,13 @@ typedef struct {
 #define GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING "grpc.experimental.enable_hedging"
 /** Per-RPC retry buffer size, in bytes. Default is 256 KiB. */
 #define GRPC_ARG_PER_RPC_RETRY_BUFFER_SIZE "grpc.per_rpc_retry_buffer_size"
+/** Retry buffer size, in bytes, shared by all RPCs on a channel. An RPC whose
+    send ops would take the channel over this limit is committed, i.e. it will
+    no longer be retried. RPCs are also committed this way while the channel's
+    resource quota is under memory pressure. Default is 0, which means no
+    per-channel limit. */
+#define GRPC_ARG_PER_CHANNEL_RETRY_BUFFER_SIZE \
+  "grpc.per_channel_retry_buffer_size"
 /** Channel arg that carries the bridged objective c object for custom metrics
  * logging filter. */
 #define GRPC_ARG_MOBILE_LOG_CONTEXT "grpc.mobile_log_context"
@@ -532,6 +735,16 @@ typedef enum grpc_call_error {
    GRPC_INITIAL_METADATA_WAIT_FOR_READY | GRPC_INITIAL_METADATA_CORKED | \
    GRPC_WRITE_THROUGH)
 
+/** Receive message flags */
+/** Deliver the message in chunks: a GRPC_OP_RECV_MESSAGE op with this flag
+    completes once part of the message has arrived rather than all of it, and
+    the following GRPC_OP_RECV_MESSAGE ops continue the same message until
+    grpc_op.data.recv_message.message_complete reports its end. Compressed
+    messages are still delivered whole. */
+#define GRPC_RECV_MESSAGE_CHUNKED (0x00000001u)
+/** Mask of all valid flags */
+#define GRPC_RECV_MESSAGE_USED_MASK (GRPC_RECV_MESSAGE_CHUNKED)
+
 /** A single metadata element */
 typedef struct grpc_metadata {
   /** the key, value values are expected to line up with grpc_mdelem: if
@@ -690,6 +903,10 @@ typedef struct grpc_op {
        */
     struct grpc_op_recv_message {
       struct grpc_byte_buffer** recv_message;
+      /** Only used with GRPC_RECV_MESSAGE_CHUNKED (and may then be NULL): out
+          argument, set to 1 if the returned byte buffer ends the message (or
+          is NULL), 0 if more of the message follows. */
+      int* message_complete;
     } recv_message;
     struct grpc_op_recv_status_on_client {
       /** ownership of the array is with the caller, but ownership of the
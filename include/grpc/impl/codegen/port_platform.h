@@ -516,6 +516,12 @@ typedef unsigned __int64 uint64_t;
 #define GRPC_ARES 1
 #endif
 
+/* zstd message compression needs libzstd, which is not bundled. The CMake
+   build defines GRPC_ZSTD=1 when configured with gRPC_ZSTD_PROVIDER=package. */
+#ifndef GRPC_ZSTD
+#define GRPC_ZSTD 0
+#endif
+
 #ifndef GRPC_IF_NAMETOINDEX
 #define GRPC_IF_NAMETOINDEX 1
 #endif
@@ -0,0 +1,88 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_CHANNEL_SET_H
+#define GRPCPP_CHANNEL_SET_H
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include <grpc/impl/codegen/connectivity_state.h>
+#include <grpc/support/time.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/impl/codegen/time.h>
+
+namespace grpc {
+namespace experimental {
+
+/// EXPERIMENTAL
+/// Watches the connectivity state of many channels at once. Unlike
+/// \a Channel::NotifyOnStateChange, a watch is registered once per channel
+/// and lasts until the set is shut down: there is no watch to re-arm, no
+/// timer per watch, and state changes of all the channels are read in
+/// batches from a single queue.
+class ChannelSet final {
+ public:
+  /// The state of a channel of the set after it changed.
+  struct StateChange {
+    /// Index of the channel in the set, in the order channels were added.
+    size_t index;
+    grpc_connectivity_state state;
+  };
+
+  ChannelSet();
+  /// Shuts the set down if that was not done yet.
+  ~ChannelSet();
+
+  ChannelSet(const ChannelSet&) = delete;
+  ChannelSet& operator=(const ChannelSet&) = delete;
+
+  /// Adds \a channels to the set and starts watching them. Their current
+  /// states are the first changes read for them. Returns the index of the
+  /// first of them.
+  size_t WatchAll(const std::vector<std::shared_ptr<Channel>>& channels);
+
+  /// Blocks until the state of at least one channel has changed, up to
+  /// \a deadline, then appends to \a changes the current state of every
+  /// channel whose state changed since it was last read: a channel changing
+  /// state several times in between is reported once.
+  /// \return false on timeout or once the set is shut down.
+  template <typename T>
+  bool Next(std::vector<StateChange>* changes, const T& deadline) {
+    grpc::TimePoint<T> deadline_tp(deadline);
+    return NextInternal(changes, deadline_tp.raw_time());
+  }
+
+  /// Stops watching all the channels. Blocked and later calls to \a Next
+  /// return false.
+  void Shutdown();
+
+ private:
+  class Impl;
+
+  bool NextInternal(std::vector<StateChange>* changes, gpr_timespec deadline);
+
+  const std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // GRPCPP_CHANNEL_SET_H
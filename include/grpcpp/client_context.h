@@ -29,7 +29,8 @@
 /// compression options, can be made persistent at channel construction time
 /// (see \a grpc::CreateCustomChannel).
 ///
-/// \warning ClientContext instances should \em not be reused across rpcs.
+/// \warning ClientContext instances should \em not be reused across rpcs,
+///          unless they are reset with \a Reset() in between.
 
 #ifndef GRPCPP_CLIENT_CONTEXT_H
 #define GRPCPP_CLIENT_CONTEXT_H
@@ -72,6 +72,38 @@ std::shared_ptr<Channel> CreateCustomChannelWithInterceptors(
     std::vector<
         std::unique_ptr<experimental::ClientInterceptorFactoryInterface>>
         interceptor_creators);
+
+/// Options of a channel pool created by \a CreateChannelPool.
+struct ChannelPoolOptions {
+  /// Maximum number of channels, and hence connections per backend, that the
+  /// pool opens.
+  int max_channels = 4;
+  /// Number of calls in flight on every open channel beyond which the pool
+  /// opens another channel.
+  int max_calls_per_channel = 100;
+};
+
+/// Create a pool of \em custom channels pointing to \a target that is used
+/// like a single channel. The pool starts with one channel and opens another,
+/// with its own connections, whenever every open channel has more than
+/// \a options.max_calls_per_channel calls in flight. Each call goes to the
+/// channel with the fewest calls in flight.
+///
+/// Useful for clients whose calls would otherwise be limited by a server's
+/// MAX_CONCURRENT_STREAMS or by the throughput of a single connection.
+///
+/// \param target The URI of the endpoint to connect to.
+/// \param creds Credentials to use for the created channels.
+/// \param args Options for the creation of each channel.
+/// \param options Options for the pool.
+/// \param interceptor_creators Factories of the interceptors of each channel.
+std::shared_ptr<ChannelInterface> CreateChannelPool(
+    const grpc::string& target,
+    const std::shared_ptr<ChannelCredentials>& creds,
+    const ChannelArguments& args, const ChannelPoolOptions& options,
+    std::vector<
+        std::unique_ptr<experimental::ClientInterceptorFactoryInterface>>
+        interceptor_creators = {});
 }  // namespace experimental
 }  // namespace grpc
 
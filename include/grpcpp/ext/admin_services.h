@@ -19,6 +19,8 @@
 #ifndef GRPCPP_EXT_ADMIN_SERVICES_H
 #define GRPCPP_EXT_ADMIN_SERVICES_H
 
+#include <string>
+
 #include <grpcpp/server_builder.h>
 
 namespace grpc {
@@ -28,6 +30,23 @@ namespace grpc {
 // CSDS service if xDS is enabled in this binary.
 void AddAdminServices(grpc::ServerBuilder* builder);
 
+namespace experimental {
+
+// Renders the process-wide gRPC metrics in the OpenMetrics text format
+// (Content-Type: application/openmetrics-text; version=1.0.0), for serving
+// from the application's own HTTP metrics endpoint. This covers the core
+// stats, the call counters of every channel, subchannel and server known to
+// channelz, and the state of the default resource quota. Counters are summed
+// over per-cpu shards without locking, so this is cheap enough to scrape
+// frequently.
+std::string ExportOpenMetrics();
+
+// Renders the events buffered by the always-on binary trace ring (see
+// GRPC_TRACE_RING_SIZE), oldest first, for post-mortem debugging.
+std::string DumpTraceRing();
+
+}  // namespace experimental
+
 }  // namespace grpc
 
 #endif  // GRPCPP_EXT_ADMIN_SERVICES_H
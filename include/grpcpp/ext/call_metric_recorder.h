@@ -0,0 +1,59 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPCPP_EXT_CALL_METRIC_RECORDER_H
+#define GRPCPP_EXT_CALL_METRIC_RECORDER_H
+
+#include <grpcpp/support/string_ref.h>
+
+namespace grpc {
+namespace experimental {
+
+// Records backend metrics of one call, which are sent to the client as an
+// ORCA load report in the call's trailing metadata. Obtained from
+// ServerContextBase::ExperimentalGetCallMetricRecorder(). Metrics are only
+// sent by servers built with
+// ServerBuilder::experimental().EnableCallMetricRecording().
+//
+// Recording a metric again overwrites its previous value. Metrics recorded
+// after the call's status has been sent are dropped.
+class CallMetricRecorder {
+ public:
+  virtual ~CallMetricRecorder() = default;
+
+  // Records the CPU utilization of the server, as a fraction of the CPU
+  // available to it. Values outside [0, 1] are ignored.
+  virtual CallMetricRecorder& RecordCpuUtilizationMetric(double value) = 0;
+
+  // Records the memory utilization of the server, as a fraction of the memory
+  // available to it. Values outside [0, 1] are ignored.
+  virtual CallMetricRecorder& RecordMemoryUtilizationMetric(double value) = 0;
+
+  // Records an application-specific utilization metric, in [0, 1]. Values
+  // outside that range are ignored.
+  virtual CallMetricRecorder& RecordUtilizationMetric(string_ref name,
+                                                      double value) = 0;
+
+  // Records an application-specific cost of the call, such as the bytes of
+  // storage it used.
+  virtual CallMetricRecorder& RecordRequestCostMetric(string_ref name,
+                                                      double value) = 0;
+};
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // GRPCPP_EXT_CALL_METRIC_RECORDER_H
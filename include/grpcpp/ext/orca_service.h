@@ -17,12 +17,16 @@
 #ifndef GRPCPP_EXT_ORCA_SERVICE_H
 #define GRPCPP_EXT_ORCA_SERVICE_H
 
+#include <stdint.h>
+
 #include <map>
+#include <memory>
 #include <string>
 
 #include "absl/time/time.h"
 #include "absl/types/optional.h"
 
+#include <grpcpp/ext/server_metric_recorder.h>
 #include <grpcpp/impl/codegen/server_callback.h>
 #include <grpcpp/impl/codegen/service_type.h>
 #include <grpcpp/impl/codegen/sync.h>
@@ -40,16 +44,25 @@ class OrcaService : public Service {
     // Minimum report interval.  If a client requests an interval lower
     // than this value, this value will be used instead.
     absl::Duration min_report_duration = absl::Seconds(30);
+    // Source of the reported metrics. Must outlive the service. If null, the
+    // service uses one of its own, updated by the setters below.
+    ServerMetricRecorder* server_metric_recorder = nullptr;
 
     Options() = default;
     Options& set_min_report_duration(absl::Duration duration) {
       min_report_duration = duration;
       return *this;
     }
+    Options& set_server_metric_recorder(ServerMetricRecorder* recorder) {
+      server_metric_recorder = recorder;
+      return *this;
+    }
   };
 
   explicit OrcaService(Options options);
 
+  // The setters below update the service's ServerMetricRecorder.
+
   // Sets or removes the CPU utilization value to be reported to clients.
   void SetCpuUtilization(double cpu_utilization);
   void DeleteCpuUtilization();
@@ -66,15 +79,18 @@ class OrcaService : public Service {
  private:
   class Reactor;
 
+  // Returns the serialized report of the recorder's current metrics. It is
+  // only rebuilt after they change, and shared by all streams.
   Slice GetOrCreateSerializedResponse();
 
   const absl::Duration min_report_duration_;
+  std::unique_ptr<ServerMetricRecorder> owned_recorder_;
+  ServerMetricRecorder* const recorder_;
 
   grpc::internal::Mutex mu_;
-  double cpu_utilization_ ABSL_GUARDED_BY(&mu_) = -1;
-  double memory_utilization_ ABSL_GUARDED_BY(&mu_) = -1;
-  std::map<std::string, double> named_utilization_ ABSL_GUARDED_BY(&mu_);
   absl::optional<Slice> response_slice_ ABSL_GUARDED_BY(&mu_);
+  // The recorder's sequence number when response_slice_ was built.
+  uint64_t response_sequence_number_ ABSL_GUARDED_BY(&mu_) = 0;
 };
 
 }  // namespace experimental
@@ -0,0 +1,87 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPCPP_EXT_SERVER_METRIC_RECORDER_H
+#define GRPCPP_EXT_SERVER_METRIC_RECORDER_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <map>
+#include <string>
+
+#include <grpcpp/impl/codegen/sync.h>
+
+namespace grpc {
+namespace experimental {
+
+// Records server-wide backend metrics, which OrcaService reports to its
+// clients out of band.
+//
+// CPU and memory utilization are plain atomics, so that they can be updated
+// as often as they are measured. Named utilizations are expected to change
+// rarely, and take a lock.
+class ServerMetricRecorder {
+ public:
+  ServerMetricRecorder() = default;
+  ServerMetricRecorder(const ServerMetricRecorder&) = delete;
+  ServerMetricRecorder& operator=(const ServerMetricRecorder&) = delete;
+
+  // Sets or removes the CPU utilization, as a fraction of the CPU available
+  // to the server. Values outside [0, 1] are ignored.
+  void SetCpuUtilization(double value);
+  void ClearCpuUtilization();
+
+  // Sets or removes the memory utilization, as a fraction of the memory
+  // available to the server. Values outside [0, 1] are ignored.
+  void SetMemoryUtilization(double value);
+  void ClearMemoryUtilization();
+
+  // Sets or removes application-specific utilizations, in [0, 1]. Values
+  // outside that range are ignored.
+  void SetNamedUtilization(std::string name, double value);
+  void ClearNamedUtilization(const std::string& name);
+  void SetAllNamedUtilization(std::map<std::string, double> named_utilization);
+
+ private:
+  friend class OrcaService;
+
+  // Changes with every update, so that reports can be rebuilt only when
+  // something changed.
+  uint64_t sequence_number() const {
+    return sequence_number_.load(std::memory_order_acquire);
+  }
+  // Negative when not set.
+  double cpu_utilization() const {
+    return cpu_utilization_.load(std::memory_order_relaxed);
+  }
+  double memory_utilization() const {
+    return memory_utilization_.load(std::memory_order_relaxed);
+  }
+  std::map<std::string, double> named_utilization() const;
+
+  std::atomic<double> cpu_utilization_{-1};
+  std::atomic<double> memory_utilization_{-1};
+  mutable grpc::internal::Mutex named_mu_;
+  std::map<std::string, double> named_utilization_
+      ABSL_GUARDED_BY(&named_mu_);
+  std::atomic<uint64_t> sequence_number_{0};
+};
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // GRPCPP_EXT_SERVER_METRIC_RECORDER_H
@@ -0,0 +1,147 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_EXT_UPB_MESSAGE_H
+#define GRPCPP_EXT_UPB_MESSAGE_H
+
+#include <stddef.h>
+
+#include <utility>
+
+#include "upb/decode.h"
+#include "upb/encode.h"
+#include "upb/msg.h"
+#include "upb/msg_internal.h"
+#include "upb/upb.hpp"
+
+#include <grpc/slice.h>
+#include <grpcpp/impl/codegen/byte_buffer.h>
+#include <grpcpp/impl/codegen/serialization_traits.h>
+#include <grpcpp/impl/codegen/slice.h>
+#include <grpcpp/impl/codegen/status.h>
+
+namespace grpc {
+namespace experimental {
+
+/// EXPERIMENTAL
+/// A upb message, as the request and response type of stubs and services
+/// generated with the upb_messages=true option of the C++ plugin. \a Msg is
+/// the upb message type and \a kMiniTable its mini table, e.g.
+/// UpbMessage<foo_Bar, &foo_Bar_msginit>.
+///
+/// The message and everything it references are allocated in an arena owned
+/// by the UpbMessage. Strings and bytes of a received message are not
+/// copied: they reference the received slices, which the UpbMessage keeps
+/// alive. A message sent is serialized into a slice referencing the encoded
+/// bytes, without copying them either.
+template <typename Msg, const upb_MiniTable* kMiniTable>
+class UpbMessage {
+ public:
+  UpbMessage() = default;
+  UpbMessage(UpbMessage&&) = default;
+  UpbMessage& operator=(UpbMessage&&) = default;
+
+  /// The message, or null if it was neither created nor received.
+  const Msg* msg() const { return msg_; }
+
+  /// The message, created empty if it was neither created nor received.
+  Msg* mutable_msg() {
+    if (msg_ == nullptr) {
+      msg_ = reinterpret_cast<Msg*>(_upb_Message_New(kMiniTable, arena()));
+    }
+    return msg_;
+  }
+
+  /// The arena to allocate the fields of the message in. Memory allocated
+  /// in it is only freed with the UpbMessage, so a message reused for many
+  /// calls keeps growing.
+  upb_Arena* arena() { return arena_.ptr(); }
+
+ private:
+  friend class SerializationTraits<UpbMessage>;
+
+  upb::Arena arena_;
+  Msg* msg_ = nullptr;
+  // The serialized message received, which the message references.
+  Slice received_;
+};
+
+}  // namespace experimental
+
+template <typename Msg, const upb_MiniTable* kMiniTable>
+class SerializationTraits<experimental::UpbMessage<Msg, kMiniTable>> {
+ public:
+  static Status Serialize(const experimental::UpbMessage<Msg, kMiniTable>& msg,
+                          ByteBuffer* bb, bool* own_buffer) {
+    *own_buffer = true;
+    if (msg.msg_ == nullptr) {
+      // An empty message has no bytes.
+      Slice slice;
+      ByteBuffer tmp(&slice, 1);
+      bb->Swap(&tmp);
+      return Status::OK;
+    }
+    // The bytes are encoded in an arena of their own, which is owned by the
+    // slice referencing them.
+    upb_Arena* arena = upb_Arena_New();
+    size_t size;
+    char* bytes = upb_Encode(msg.msg_, kMiniTable, 0, arena, &size);
+    if (bytes == nullptr) {
+      upb_Arena_Free(arena);
+      return Status(StatusCode::INTERNAL, "Failed to serialize message");
+    }
+    Slice slice(grpc_slice_new_with_user_data(
+                    bytes, size,
+                    [](void* arena) {
+                      upb_Arena_Free(static_cast<upb_Arena*>(arena));
+                    },
+                    arena),
+                Slice::STEAL_REF);
+    ByteBuffer tmp(&slice, 1);
+    bb->Swap(&tmp);
+    return Status::OK;
+  }
+
+  static Status Deserialize(ByteBuffer* buffer,
+                            experimental::UpbMessage<Msg, kMiniTable>* msg) {
+    if (!buffer->Valid()) {
+      return Status(StatusCode::INTERNAL, "No payload");
+    }
+    // Messages received in a single slice are referenced in place.
+    Slice slice;
+    Status status = buffer->TrySingleSlice(&slice);
+    if (!status.ok()) status = buffer->DumpToSingleSlice(&slice);
+    buffer->Clear();
+    if (!status.ok()) return status;
+    Msg* parsed =
+        reinterpret_cast<Msg*>(_upb_Message_New(kMiniTable, msg->arena()));
+    if (parsed == nullptr ||
+        upb_Decode(reinterpret_cast<const char*>(slice.begin()), slice.size(),
+                   parsed, kMiniTable, nullptr, kUpb_DecodeOption_AliasString,
+                   msg->arena()) != kUpb_DecodeStatus_Ok) {
+      return Status(StatusCode::INTERNAL, "Failed to parse message");
+    }
+    msg->msg_ = parsed;
+    msg->received_ = std::move(slice);
+    return Status::OK;
+  }
+};
+
+}  // namespace grpc
+
+#endif  // GRPCPP_EXT_UPB_MESSAGE_H
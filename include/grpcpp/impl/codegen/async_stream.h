@@ -577,6 +577,25 @@ class ClientAsyncReaderWriter final
     call_.PerformOps(&write_ops_);
   }
 
+  /// Like the Write() overloads above, but \a msg may be moved into the call
+  /// instead of copied. A \a ByteBuffer read from another call is forwarded
+  /// without new slice references, which is what a proxy between a generic
+  /// service and a generic stub wants.
+  void Write(W&& msg, void* tag) {
+    Write(std::move(msg), grpc::WriteOptions(), tag);
+  }
+
+  void Write(W&& msg, grpc::WriteOptions options, void* tag) {
+    GPR_CODEGEN_ASSERT(started_);
+    write_ops_.set_output_tag(tag);
+    if (options.is_last_message()) {
+      options.set_buffer_hint();
+      write_ops_.ClientSendClose();
+    }
+    GPR_CODEGEN_ASSERT(write_ops_.SendMessage(std::move(msg), options).ok());
+    call_.PerformOps(&write_ops_);
+  }
+
   void WritesDone(void* tag) override {
     GPR_CODEGEN_ASSERT(started_);
     write_ops_.set_output_tag(tag);
@@ -1057,6 +1076,23 @@ class ServerAsyncReaderWriter final
     call_.PerformOps(&write_ops_);
   }
 
+  /// Like the Write() overloads above, but \a msg may be moved into the call
+  /// instead of copied. A \a ByteBuffer read from another call is forwarded
+  /// without new slice references.
+  void Write(W&& msg, void* tag) {
+    Write(std::move(msg), grpc::WriteOptions(), tag);
+  }
+
+  void Write(W&& msg, grpc::WriteOptions options, void* tag) {
+    write_ops_.set_output_tag(tag);
+    if (options.is_last_message()) {
+      options.set_buffer_hint();
+    }
+    EnsureInitialMetadataSent(&write_ops_);
+    GPR_CODEGEN_ASSERT(write_ops_.SendMessage(std::move(msg), options).ok());
+    call_.PerformOps(&write_ops_);
+  }
+
   /// See the \a ServerAsyncReaderWriterInterface.WriteAndFinish
   /// method for semantics.
   ///
@@ -51,10 +51,12 @@ class CallOpSendMessage;
 template <class R>
 class CallOpRecvMessage;
 class CallOpGenericRecvMessage;
+class CallOpRecvMessageChunk;
 class ExternalConnectionAcceptorImpl;
 template <class R>
 class DeserializeFuncType;
 class GrpcByteBufferPeer;
+class MessageObjectBuffer;
 
 }  // namespace internal
 /// A sequence of bytes.
@@ -170,6 +172,7 @@ class ByteBuffer final {
   template <class R>
   friend class internal::CallOpRecvMessage;
   friend class internal::CallOpGenericRecvMessage;
+  friend class internal::CallOpRecvMessageChunk;
   template <class RequestType>
   friend void* internal::UnaryDeserializeHelper(grpc_byte_buffer*,
                                                 grpc::Status*, RequestType*);
@@ -187,6 +190,7 @@ class ByteBuffer final {
   friend class ProtoBufferWriter;
   friend class internal::GrpcByteBufferPeer;
   friend class internal::ExternalConnectionAcceptorImpl;
+  friend class internal::MessageObjectBuffer;
 
   grpc_byte_buffer* buffer_;
 
@@ -219,12 +223,73 @@ class ByteBuffer final {
   ByteBufferPointer bbuf_ptr() const { return ByteBufferPointer(this); }
 };
 
+namespace internal {
+
+/// Describes the C++ type of a message object that a ByteBuffer carries in
+/// place of the message's bytes (see GRPC_ARG_INPROC_OBJECT_PASSING). Each
+/// type has one static instance, whose address identifies the type.
+struct MessageObjectType {
+  /// Serializes \a object into \a bb, for receivers that need the bytes.
+  Status (*serialize)(const void* object, ByteBuffer* bb);
+  /// Deletes \a object.
+  void (*destroy)(void* object);
+};
+
+/// Wraps message objects in ByteBuffers and unwraps them.
+class MessageObjectBuffer {
+ public:
+  /// Makes \a bb carry \a object, of type \a type, taking ownership of it.
+  static void Wrap(void* object, const MessageObjectType* type,
+                   ByteBuffer* bb) {
+    Slice slice(g_core_codegen_interface->grpc_slice_from_object(
+                    object, type, type->destroy),
+                Slice::STEAL_REF);
+    ByteBuffer tmp(&slice, 1);
+    bb->Swap(&tmp);
+  }
+
+  /// If \a bb carries a message object, returns it and sets \a *type to its
+  /// type and \a *unique to whether \a bb holds the only reference to it, in
+  /// which case the caller may take the object's contents. Otherwise returns
+  /// nullptr.
+  static void* Get(const ByteBuffer& bb, const MessageObjectType** type,
+                   bool* unique) {
+    const grpc_byte_buffer* buffer = bb.buffer_;
+    // A message object is carried by a single one byte slice: don't call
+    // into core for anything else.
+    if (buffer == nullptr || buffer->data.raw.slice_buffer.count != 1 ||
+        buffer->data.raw.slice_buffer.length != 1) {
+      return nullptr;
+    }
+    const void* object_type;
+    void* object = g_core_codegen_interface->grpc_slice_get_object(
+        buffer->data.raw.slice_buffer.slices[0], &object_type, unique);
+    *type = static_cast<const MessageObjectType*>(object_type);
+    return object;
+  }
+
+  /// If \a bb carries a message object, replaces it with the object's bytes.
+  static Status ToBytes(ByteBuffer* bb) {
+    const MessageObjectType* type;
+    bool unique;
+    void* object = Get(*bb, &type, &unique);
+    if (object == nullptr) return g_core_codegen_interface->ok();
+    ByteBuffer bytes;
+    Status result = type->serialize(object, &bytes);
+    bb->Swap(&bytes);
+    return result;
+  }
+};
+
+}  // namespace internal
+
 template <>
 class SerializationTraits<ByteBuffer, void> {
  public:
   static Status Deserialize(ByteBuffer* byte_buffer, ByteBuffer* dest) {
     dest->set_buffer(byte_buffer->buffer_);
-    return Status::OK;
+    // Generic handlers get the bytes of messages passed as objects.
+    return internal::MessageObjectBuffer::ToBytes(dest);
   }
   static Status Serialize(const ByteBuffer& source, ByteBuffer* buffer,
                           bool* own_buffer) {
@@ -286,6 +286,19 @@ class CallOpSendInitialMetadata {
   } maybe_compression_level_;
 };
 
+// Wraps a copy of \a message in \a bb in place of its bytes, if the
+// SerializationTraits of M support it (see GRPC_ARG_INPROC_OBJECT_PASSING).
+template <class M>
+auto SerializeObject(const M& message, ByteBuffer* bb, int)
+    -> decltype(SerializationTraits<M, void>::SerializeObject(message, bb),
+                bool()) {
+  return SerializationTraits<M, void>::SerializeObject(message, bb).ok();
+}
+template <class M>
+bool SerializeObject(const M& /*message*/, ByteBuffer* /*bb*/, long) {
+  return false;
+}
+
 class CallOpSendMessage {
  public:
   CallOpSendMessage() : send_buf_() {}
@@ -299,6 +312,15 @@ class CallOpSendMessage {
   template <class M>
   Status SendMessage(const M& message) GRPC_MUST_USE_RESULT;
 
+  /// Send \a message using \a options for the write. The slices of \a message
+  /// are moved into the call rather than referenced again, and \a message is
+  /// left empty. This lets a received message be forwarded to another call
+  /// without touching its bytes or slice refcounts.
+  Status SendMessage(ByteBuffer&& message,
+                     WriteOptions options) GRPC_MUST_USE_RESULT;
+
+  Status SendMessage(ByteBuffer&& message) GRPC_MUST_USE_RESULT;
+
   /// Send \a message using \a options for the write. The \a options are cleared
   /// after use. This form of SendMessage allows gRPC to reference \a message
   /// beyond the lifetime of SendMessage.
@@ -311,20 +333,39 @@ class CallOpSendMessage {
   template <class M>
   Status SendMessagePtr(const M* message) GRPC_MUST_USE_RESULT;
 
+  /// Lets a message passed to SendMessagePtr() be sent as a copy of the
+  /// object rather than its bytes, when \a call allows it. Only for batches
+  /// that no interceptor looks at, since interceptors see the bytes.
+  void AllowObjectPassing(Call* call) {
+    if (msg_ != nullptr) {
+      object_passing_ =
+          g_core_codegen_interface->grpc_call_object_passing(call->call());
+    }
+  }
+
  protected:
   void AddOp(grpc_op* ops, size_t* nops) {
     if (msg_ == nullptr && !send_buf_.Valid()) return;
     if (hijacked_) {
       serializer_ = nullptr;
+      object_passing_ = false;
       return;
     }
+    uint32_t flags = write_options_.flags();
     if (msg_ != nullptr) {
-      GPR_CODEGEN_ASSERT(serializer_(msg_).ok());
+      if (object_passing_ &&
+          object_serializer_(msg_, send_buf_.bbuf_ptr())) {
+        // Compressing the stand-in bytes of an object would lose it.
+        flags |= GRPC_WRITE_NO_COMPRESS;
+      } else {
+        GPR_CODEGEN_ASSERT(serializer_(msg_).ok());
+      }
     }
     serializer_ = nullptr;
+    object_passing_ = false;
     grpc_op* op = &ops[(*nops)++];
     op->op = GRPC_OP_SEND_MESSAGE;
-    op->flags = write_options_.flags();
+    op->flags = flags;
     op->reserved = nullptr;
     op->data.send_message.send_message = send_buf_.c_buffer();
     // Flags are per-message: clear them after use.
@@ -373,9 +414,11 @@ class CallOpSendMessage {
   const void* msg_ = nullptr;  // The original non-serialized message
   bool hijacked_ = false;
   bool failed_send_ = false;
+  bool object_passing_ = false;
   ByteBuffer send_buf_;
   WriteOptions write_options_;
   std::function<Status(const void*)> serializer_;
+  bool (*object_serializer_)(const void* message, ByteBuffer* bb) = nullptr;
 };
 
 template <class M>
@@ -400,6 +443,18 @@ Status CallOpSendMessage::SendMessage(const M& message) {
   return SendMessage(message, WriteOptions());
 }
 
+inline Status CallOpSendMessage::SendMessage(ByteBuffer&& message,
+                                             WriteOptions options) {
+  write_options_ = options;
+  send_buf_.Clear();
+  send_buf_.Swap(&message);
+  return g_core_codegen_interface->ok();
+}
+
+inline Status CallOpSendMessage::SendMessage(ByteBuffer&& message) {
+  return SendMessage(std::move(message), WriteOptions());
+}
+
 template <class M>
 Status CallOpSendMessage::SendMessagePtr(const M* message,
                                          WriteOptions options) {
@@ -419,6 +474,9 @@ Status CallOpSendMessage::SendMessagePtr(const M* message,
     }
     return result;
   };
+  object_serializer_ = [](const void* message, ByteBuffer* bb) {
+    return SerializeObject(*static_cast<const M*>(message), bb, 0);
+  };
   return Status();
 }
 
@@ -623,6 +681,55 @@ class CallOpGenericRecvMessage {
   bool hijacked_recv_message_failed_ = false;
 };
 
+/// Receives the next chunk of a message as raw bytes, using
+/// GRPC_RECV_MESSAGE_CHUNKED. Chunks are not seen by interceptors.
+class CallOpRecvMessageChunk {
+ public:
+  void RecvMessageChunk(ByteBuffer* chunk, bool* last) {
+    chunk_ = chunk;
+    last_ = last;
+  }
+
+ protected:
+  void AddOp(grpc_op* ops, size_t* nops) {
+    if (chunk_ == nullptr || hijacked_) return;
+    grpc_op* op = &ops[(*nops)++];
+    op->op = GRPC_OP_RECV_MESSAGE;
+    op->flags = GRPC_RECV_MESSAGE_CHUNKED;
+    op->reserved = nullptr;
+    op->data.recv_message.recv_message = recv_buf_.c_buffer_ptr();
+    op->data.recv_message.message_complete = &message_complete_;
+  }
+
+  void FinishOp(bool* status) {
+    if (chunk_ == nullptr) return;
+    if (recv_buf_.Valid() && *status) {
+      chunk_->Swap(&recv_buf_);
+      *last_ = message_complete_ != 0;
+    } else {
+      // No message, or the op was hijacked: there is nothing to hand out.
+      *status = false;
+    }
+    recv_buf_.Clear();
+    chunk_ = nullptr;
+  }
+
+  void SetInterceptionHookPoint(
+      InterceptorBatchMethodsImpl* /*interceptor_methods*/) {}
+  void SetFinishInterceptionHookPoint(
+      InterceptorBatchMethodsImpl* /*interceptor_methods*/) {}
+  void SetHijackingState(InterceptorBatchMethodsImpl* /*interceptor_methods*/) {
+    hijacked_ = true;
+  }
+
+ private:
+  ByteBuffer* chunk_ = nullptr;
+  bool* last_ = nullptr;
+  ByteBuffer recv_buf_;
+  int message_complete_ = 0;
+  bool hijacked_ = false;
+};
+
 class CallOpClientSendClose {
  public:
   CallOpClientSendClose() : send_(false) {}
@@ -853,6 +960,13 @@ class CallOpClientRecvStatus {
   grpc_slice error_message_;
 };
 
+// Lets the CallOpSendMessage of a CallOpSet pass its message as an object.
+template <class Op>
+void MaybeAllowObjectPassing(Op* /*op*/, Call* /*call*/) {}
+inline void MaybeAllowObjectPassing(CallOpSendMessage* op, Call* call) {
+  op->AllowObjectPassing(call);
+}
+
 template <class Op1 = CallNoOp<1>, class Op2 = CallNoOp<2>,
           class Op3 = CallNoOp<3>, class Op4 = CallNoOp<4>,
           class Op5 = CallNoOp<5>, class Op6 = CallNoOp<6>>
@@ -902,6 +1016,20 @@ class CallOpSet : public CallOpSetInterface,
     call_ =
         *call;  // It's fine to create a copy of call since it's just pointers
 
+    // Calls without interceptors skip all of the interception bookkeeping,
+    // including copying the serializer into interceptor_methods_.
+    intercepted_ = HasInterceptors();
+    if (!intercepted_) {
+      // Nothing needs the bytes of messages sent without interceptors.
+      MaybeAllowObjectPassing(static_cast<Op1*>(this), &call_);
+      MaybeAllowObjectPassing(static_cast<Op2*>(this), &call_);
+      MaybeAllowObjectPassing(static_cast<Op3*>(this), &call_);
+      MaybeAllowObjectPassing(static_cast<Op4*>(this), &call_);
+      MaybeAllowObjectPassing(static_cast<Op5*>(this), &call_);
+      MaybeAllowObjectPassing(static_cast<Op6*>(this), &call_);
+      ContinueFillOpsAfterInterception();
+      return;
+    }
     if (RunInterceptors()) {
       ContinueFillOpsAfterInterception();
     } else {
@@ -930,6 +1058,13 @@ class CallOpSet : public CallOpSetInterface,
     this->Op5::FinishOp(status);
     this->Op6::FinishOp(status);
     saved_status_ = *status;
+    if (!intercepted_) {
+      // The finish hook points also reset per-batch op state.
+      SetFinishInterceptionHookPoints();
+      *tag = return_tag_;
+      g_core_codegen_interface->grpc_call_unref(call_.call());
+      return true;
+    }
     if (RunInterceptorsPostRecv()) {
       *tag = return_tag_;
       g_core_codegen_interface->grpc_call_unref(call_.call());
@@ -998,6 +1133,11 @@ class CallOpSet : public CallOpSetInterface,
   }
 
  private:
+  bool HasInterceptors() {
+    interceptor_methods_.SetCall(&call_);
+    return !interceptor_methods_.InterceptorsListEmpty();
+  }
+
   // Returns true if no interceptors need to be run
   bool RunInterceptors() {
     interceptor_methods_.ClearState();
@@ -1022,19 +1162,24 @@ class CallOpSet : public CallOpSetInterface,
     // Call and OpSet had already been set on the set state.
     // SetReverse also clears previously set hook points
     interceptor_methods_.SetReverse();
+    SetFinishInterceptionHookPoints();
+    return interceptor_methods_.RunInterceptors();
+  }
+
+  void SetFinishInterceptionHookPoints() {
     this->Op1::SetFinishInterceptionHookPoint(&interceptor_methods_);
     this->Op2::SetFinishInterceptionHookPoint(&interceptor_methods_);
     this->Op3::SetFinishInterceptionHookPoint(&interceptor_methods_);
     this->Op4::SetFinishInterceptionHookPoint(&interceptor_methods_);
     this->Op5::SetFinishInterceptionHookPoint(&interceptor_methods_);
     this->Op6::SetFinishInterceptionHookPoint(&interceptor_methods_);
-    return interceptor_methods_.RunInterceptors();
   }
 
   void* core_cq_tag_;
   void* return_tag_;
   Call call_;
   bool done_intercepting_ = false;
+  bool intercepted_ = false;
   InterceptorBatchMethodsImpl interceptor_methods_;
   bool saved_status_;
 };
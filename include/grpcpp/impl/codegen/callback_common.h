@@ -25,6 +25,7 @@
 
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpcpp/impl/codegen/call.h>
+#include <grpcpp/impl/codegen/call_op_set.h>
 #include <grpcpp/impl/codegen/channel_interface.h>
 #include <grpcpp/impl/codegen/completion_queue_tag.h>
 #include <grpcpp/impl/codegen/config.h>
@@ -216,6 +217,40 @@ class CallbackWithSuccessTag : public grpc_completion_queue_functor {
   }
 };
 
+/// Progress of a StartWriteBatch on a callback reactor. Reactors only have
+/// one write outstanding, so this is only touched by the thread starting the
+/// batch and then by each write's reaction in turn.
+template <class Msg>
+class WriteBatchState {
+ public:
+  void Start(const Msg* msgs, size_t count, grpc::WriteOptions options) {
+    GPR_CODEGEN_ASSERT(count > 0);
+    next_ = msgs;
+    remaining_ = count;
+    options_ = options;
+  }
+
+  bool active() const { return remaining_ > 0; }
+  void Clear() { remaining_ = 0; }
+
+  /// Returns the next message to write and sets \a options for it. All but
+  /// the last message carry the buffer hint so that the transport coalesces
+  /// the batch, and only the last may be marked as the last message.
+  const Msg* Next(grpc::WriteOptions* options) {
+    remaining_--;
+    *options = options_;
+    if (remaining_ > 0) {
+      options->set_buffer_hint().clear_last_message();
+    }
+    return next_++;
+  }
+
+ private:
+  const Msg* next_ = nullptr;
+  size_t remaining_ = 0;
+  grpc::WriteOptions options_;
+};
+
 }  // namespace internal
 }  // namespace grpc
 
@@ -57,6 +57,7 @@ class ClientContext;
 class CompletionQueue;
 
 namespace experimental {
+class ChannelPool;
 class DelegatingChannel;
 }
 
@@ -130,6 +131,7 @@ class ChannelInterface {
   template <class InputMessage, class OutputMessage>
   friend class grpc::internal::CallbackUnaryCallImpl;
   friend class grpc::internal::RpcMethod;
+  friend class grpc::experimental::ChannelPool;
   friend class grpc::experimental::DelegatingChannel;
   friend class grpc::internal::InterceptedChannel;
   virtual internal::Call CreateCall(const internal::RpcMethod& method,
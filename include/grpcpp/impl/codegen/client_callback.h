@@ -181,6 +181,7 @@ class ClientCallbackReader {
   virtual ~ClientCallbackReader() {}
   virtual void StartCall() = 0;
   virtual void Read(Response* resp) = 0;
+  virtual void ReadChunk(grpc::ByteBuffer* chunk, bool* last) = 0;
   virtual void AddHold(int holds) = 0;
   virtual void RemoveHold() = 0;
 
@@ -283,6 +284,23 @@ class ClientBidiReactor : public internal::ClientReactor {
     StartWrite(req, options.set_last_message());
   }
 
+  /// Initiate writes of the \a count messages at \a reqs as one transport
+  /// write, with a single OnWriteDone once the last one is done or as soon as
+  /// one fails. All but the last message are written with
+  /// WriteOptions::set_buffer_hint, and the last one flushes the batch.
+  ///
+  /// \param[in] reqs The messages to be written. The library does not take
+  ///                  ownership but the caller must ensure that they are not
+  ///                  deleted or modified until OnWriteDone is called.
+  /// \param[in] count The number of messages, which must not be zero.
+  /// \param[in] options The WriteOptions to use for writing the messages
+  void StartWriteBatch(const Request* reqs, size_t count,
+                       grpc::WriteOptions options = grpc::WriteOptions()) {
+    write_batch_.Start(reqs, count, options);
+    const Request* first = write_batch_.Next(&options);
+    StartWrite(first, options);
+  }
+
   /// Indicate that the RPC will have no more write operations. This can only be
   /// issued once for a given RPC. This is not required or allowed if
   /// StartWriteLast is used since that already has the same implication.
@@ -351,6 +369,19 @@ class ClientBidiReactor : public internal::ClientReactor {
   ///               will succeed, and any further Start* should not be called.
   virtual void OnWriteDone(bool /*ok*/) {}
 
+  /// Not part of the public API: called by the library when a write
+  /// completes, to continue a StartWriteBatch or notify OnWriteDone.
+  void InternalWriteDone(bool ok) {
+    if (ok && write_batch_.active()) {
+      grpc::WriteOptions options;
+      const Request* next = write_batch_.Next(&options);
+      StartWrite(next, options);
+      return;
+    }
+    write_batch_.Clear();
+    OnWriteDone(ok);
+  }
+
   /// Notifies the application that a StartWritesDone operation completed. Note
   /// that this is only used on explicit StartWritesDone operations and not for
   /// those that are implicitly invoked as part of a StartWriteLast.
@@ -366,6 +397,7 @@ class ClientBidiReactor : public internal::ClientReactor {
     stream_ = stream;
   }
   ClientCallbackReaderWriter<Request, Response>* stream_;
+  grpc::internal::WriteBatchState<Request> write_batch_;
 };
 
 /// \a ClientReadReactor is the interface for a server-streaming RPC.
@@ -375,6 +407,19 @@ class ClientReadReactor : public internal::ClientReactor {
  public:
   void StartCall() { reader_->StartCall(); }
   void StartRead(Response* resp) { reader_->Read(resp); }
+  /// Initiate a read of the next chunk of the current response message as
+  /// raw serialized bytes, so that a large message can be consumed before all
+  /// of it has arrived. A chunk ends once at least 64KiB of the message has
+  /// arrived, or at the end of the message, in which case *last is set to
+  /// true. Compressed messages are delivered as a single chunk. Chunked reads
+  /// bypass interceptors and must not be outstanding together with StartRead.
+  ///
+  /// \param[out] chunk Where to store the chunk; must remain valid until
+  ///                   OnReadChunkDone is called
+  /// \param[out] last Set to whether this chunk completes the message
+  void StartReadChunk(grpc::ByteBuffer* chunk, bool* last) {
+    reader_->ReadChunk(chunk, last);
+  }
 
   void AddHold() { AddMultipleHolds(1); }
   void AddMultipleHolds(int holds) {
@@ -386,6 +431,9 @@ class ClientReadReactor : public internal::ClientReactor {
   void OnDone(const grpc::Status& /*s*/) override {}
   virtual void OnReadInitialMetadataDone(bool /*ok*/) {}
   virtual void OnReadDone(bool /*ok*/) {}
+  /// Notifies the application that a StartReadChunk operation completed. ok
+  /// is false if there was no message left to read.
+  virtual void OnReadChunkDone(bool /*ok*/) {}
 
  private:
   friend class ClientCallbackReader<Response>;
@@ -406,6 +454,23 @@ class ClientWriteReactor : public internal::ClientReactor {
   void StartWriteLast(const Request* req, grpc::WriteOptions options) {
     StartWrite(req, options.set_last_message());
   }
+
+  /// Initiate writes of the \a count messages at \a reqs as one transport
+  /// write, with a single OnWriteDone once the last one is done or as soon as
+  /// one fails. All but the last message are written with
+  /// WriteOptions::set_buffer_hint, and the last one flushes the batch.
+  ///
+  /// \param[in] reqs The messages to be written. The library does not take
+  ///                  ownership but the caller must ensure that they are not
+  ///                  deleted or modified until OnWriteDone is called.
+  /// \param[in] count The number of messages, which must not be zero.
+  /// \param[in] options The WriteOptions to use for writing the messages
+  void StartWriteBatch(const Request* reqs, size_t count,
+                       grpc::WriteOptions options = grpc::WriteOptions()) {
+    write_batch_.Start(reqs, count, options);
+    const Request* first = write_batch_.Next(&options);
+    StartWrite(first, options);
+  }
   void StartWritesDone() { writer_->WritesDone(); }
 
   void AddHold() { AddMultipleHolds(1); }
@@ -420,11 +485,25 @@ class ClientWriteReactor : public internal::ClientReactor {
   virtual void OnWriteDone(bool /*ok*/) {}
   virtual void OnWritesDoneDone(bool /*ok*/) {}
 
+  /// Not part of the public API: called by the library when a write
+  /// completes, to continue a StartWriteBatch or notify OnWriteDone.
+  void InternalWriteDone(bool ok) {
+    if (ok && write_batch_.active()) {
+      grpc::WriteOptions options;
+      const Request* next = write_batch_.Next(&options);
+      StartWrite(next, options);
+      return;
+    }
+    write_batch_.Clear();
+    OnWriteDone(ok);
+  }
+
  private:
   friend class ClientCallbackWriter<Request>;
   void BindWriter(ClientCallbackWriter<Request>* writer) { writer_ = writer; }
 
   ClientCallbackWriter<Request>* writer_;
+  grpc::internal::WriteBatchState<Request> write_batch_;
 };
 
 /// \a ClientUnaryReactor is a reactor-style interface for a unary RPC.
@@ -613,7 +692,7 @@ class ClientCallbackReaderWriterImpl
     write_tag_.Set(
         call_.call(),
         [this](bool ok) {
-          reactor_->OnWriteDone(ok);
+          reactor_->InternalWriteDone(ok);
           MaybeFinish(/*from_reaction=*/true);
         },
         &write_ops_, /*can_inline=*/false);
@@ -766,12 +845,23 @@ class ClientCallbackReaderImpl : public ClientCallbackReader<Response> {
         },
         &read_ops_, /*can_inline=*/false);
     read_ops_.set_core_cq_tag(&read_tag_);
+    read_chunk_tag_.Set(
+        call_.call(),
+        [this](bool ok) {
+          reactor_->OnReadChunkDone(ok);
+          MaybeFinish(/*from_reaction=*/true);
+        },
+        &read_chunk_ops_, /*can_inline=*/false);
+    read_chunk_ops_.set_core_cq_tag(&read_chunk_tag_);
 
     {
       grpc::internal::MutexLock lock(&start_mu_);
       if (backlog_.read_ops) {
         call_.PerformOps(&read_ops_);
       }
+      if (backlog_.read_chunk_ops) {
+        call_.PerformOps(&read_chunk_ops_);
+      }
       started_.store(true, std::memory_order_release);
     }
 
@@ -797,6 +887,19 @@ class ClientCallbackReaderImpl : public ClientCallbackReader<Response> {
     call_.PerformOps(&read_ops_);
   }
 
+  void ReadChunk(grpc::ByteBuffer* chunk, bool* last) override {
+    read_chunk_ops_.RecvMessageChunk(chunk, last);
+    callbacks_outstanding_.fetch_add(1, std::memory_order_relaxed);
+    if (GPR_UNLIKELY(!started_.load(std::memory_order_acquire))) {
+      grpc::internal::MutexLock lock(&start_mu_);
+      if (GPR_LIKELY(!started_.load(std::memory_order_relaxed))) {
+        backlog_.read_chunk_ops = true;
+        return;
+      }
+    }
+    call_.PerformOps(&read_chunk_ops_);
+  }
+
   void AddHold(int holds) override {
     callbacks_outstanding_.fetch_add(holds, std::memory_order_relaxed);
   }
@@ -852,8 +955,13 @@ class ClientCallbackReaderImpl : public ClientCallbackReader<Response> {
       read_ops_;
   grpc::internal::CallbackWithSuccessTag read_tag_;
 
+  grpc::internal::CallOpSet<grpc::internal::CallOpRecvMessageChunk>
+      read_chunk_ops_;
+  grpc::internal::CallbackWithSuccessTag read_chunk_tag_;
+
   struct StartCallBacklog {
     bool read_ops = false;
+    bool read_chunk_ops = false;
   };
   StartCallBacklog backlog_ ABSL_GUARDED_BY(start_mu_);
 
@@ -1016,7 +1124,7 @@ class ClientCallbackWriterImpl : public ClientCallbackWriter<Request> {
     write_tag_.Set(
         call_.call(),
         [this](bool ok) {
-          reactor_->OnWriteDone(ok);
+          reactor_->InternalWriteDone(ok);
           MaybeFinish(/*from_reaction=*/true);
         },
         &write_ops_, /*can_inline=*/false);
@@ -39,6 +39,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <grpc/impl/codegen/compression_types.h>
 #include <grpc/impl/codegen/propagation_bits.h>
@@ -176,6 +177,34 @@ class PropagationOptions {
   uint32_t propagate_;
 };
 
+/// A custom metadata key-value pair that is interned once, for pairs sent on
+/// most calls (eg. tenant or routing keys). Transports remember how the pair
+/// was last sent on each connection and refer back to that on later calls: for
+/// HTTP/2, after the first call the pair is sent as a single indexed HPACK
+/// header field instead of being encoded again.
+///
+/// Create one instance per distinct pair and reuse it across calls; copies are
+/// cheap and share the interned pair. Creating an instance per call works but
+/// gains nothing. Keys and values follow the rules of
+/// \a ClientContext::AddMetadata; binary ("-bin") pairs are accepted but are
+/// not cached.
+class PreEncodedMetadata {
+ public:
+  PreEncodedMetadata(const std::string& key, const std::string& value);
+  PreEncodedMetadata(const PreEncodedMetadata& other);
+  PreEncodedMetadata& operator=(const PreEncodedMetadata& other);
+  ~PreEncodedMetadata();
+
+  grpc::string_ref key() const;
+  grpc::string_ref value() const;
+
+ private:
+  friend class ClientContext;
+
+  // The value slice of the interned pair; its refcount is the core element.
+  grpc_slice value_;
+};
+
 /// A ClientContext allows the person implementing a service client to:
 ///
 /// - Add custom metadata key-value pairs that will propagated to the server
@@ -189,7 +218,8 @@ class PropagationOptions {
 /// compression options, can be made persistent at channel construction time
 /// (see \a grpc::CreateCustomChannel).
 ///
-/// \warning ClientContext instances should \em not be reused across rpcs.
+/// \warning ClientContext instances should \em not be reused across rpcs,
+///          unless they are reset with \a Reset() in between.
 /// \warning The ClientContext instance used for creating an rpc must remain
 ///          alive and valid for the lifetime of the rpc.
 class ClientContext {
@@ -197,6 +227,12 @@ class ClientContext {
   ClientContext();
   ~ClientContext();
 
+  /// EXPERIMENTAL: Returns the context to the state of a newly constructed
+  /// one, so that it can be used for another rpc without allocating a new
+  /// context. Must only be called once the rpc the context was used for, if
+  /// any, has completed.
+  void Reset();
+
   /// Create a new \a ClientContext as a child of an incoming server call,
   /// according to \a options (\see PropagationOptions).
   ///
@@ -238,6 +274,15 @@ class ClientContext {
   **/
   void AddMetadata(const std::string& meta_key, const std::string& meta_value);
 
+  /// Add the interned \a metadata pair to the metadata associated with a
+  /// client call, like AddMetadata(meta_key, meta_value) but letting the
+  /// transport reuse the encoding of the pair from earlier calls.
+  ///
+  /// \warning This method should only be called before invoking the rpc.
+  /// Unlike metadata added by key and value, pre-encoded metadata is not
+  /// visible to interceptors.
+  void AddMetadata(const PreEncodedMetadata& metadata);
+
   /// Return a collection of initial metadata key-value pairs. Note that keys
   /// may happen more than once (ie, a \a std::multimap is returned).
   ///
@@ -358,6 +403,18 @@ class ClientContext {
     initial_metadata_corked_ = corked;
   }
 
+  /// EXPERIMENTAL API
+  /// Bound the number of bytes of response messages that the transport lets
+  /// the server send ahead of the reads of the application, so that a slow
+  /// reader does not have a whole flow control window buffered for it. 0, the
+  /// default, leaves the transport's flow control to decide.
+  /// It is only valid to call this before the client call is created.
+  ///
+  /// \param max_bytes The bound, in bytes, or 0 for none.
+  void set_max_buffered_receive_bytes(uint32_t max_bytes) {
+    max_buffered_receive_bytes_ = max_bytes;
+  }
+
   /// Return the peer uri in a string.
   /// It is only valid to call this during the lifetime of the client call.
   ///
@@ -500,6 +557,7 @@ class ClientContext {
   mutable std::shared_ptr<const grpc::AuthContext> auth_context_;
   struct census_context* census_context_;
   std::multimap<std::string, std::string> send_initial_metadata_;
+  std::vector<PreEncodedMetadata> send_pre_encoded_metadata_;
   mutable grpc::internal::MetadataMap recv_initial_metadata_;
   mutable grpc::internal::MetadataMap trailing_metadata_;
 
@@ -508,12 +566,48 @@ class ClientContext {
 
   grpc_compression_algorithm compression_algorithm_;
   bool initial_metadata_corked_;
+  uint32_t max_buffered_receive_bytes_;
 
   std::string debug_error_string_;
 
   grpc::experimental::ClientRpcInfo rpc_info_;
 };
 
+namespace experimental {
+
+/// EXPERIMENTAL: A pool of ClientContexts for clients making rpcs at high
+/// rates, typically one per stub. Contexts are reset when they return to the
+/// pool, so every rpc still starts with a fresh context.
+class ClientContextPool {
+ public:
+  /// Returns a context to its pool.
+  class Returner {
+   public:
+    Returner() = default;
+    explicit Returner(ClientContextPool* pool) : pool_(pool) {}
+    void operator()(ClientContext* context) const { pool_->Return(context); }
+
+   private:
+    ClientContextPool* pool_ = nullptr;
+  };
+  using Ptr = std::unique_ptr<ClientContext, Returner>;
+
+  /// Keeps up to \a max_size idle contexts.
+  explicit ClientContextPool(size_t max_size = 64) : max_size_(max_size) {}
+  ~ClientContextPool();
+
+  /// Returns a context for a new rpc. The pool must outlive it.
+  Ptr Get();
+
+ private:
+  void Return(ClientContext* context);
+
+  const size_t max_size_;
+  grpc::internal::Mutex mu_;
+  std::vector<ClientContext*> contexts_;
+};
+
+}  // namespace experimental
 }  // namespace grpc
 
 #endif  // GRPCPP_IMPL_CODEGEN_CLIENT_CONTEXT_H
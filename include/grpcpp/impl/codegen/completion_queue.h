@@ -184,6 +184,25 @@ class CompletionQueue : private grpc::GrpcLibraryCodegen {
                                   GPR_CLOCK_REALTIME)) == GOT_EVENT);
   }
 
+  /// EXPERIMENTAL
+  /// Like \a Next, but hands back up to \a max_events events per call: once
+  /// one event is available, any further events that are already queued are
+  /// returned with it, saving a round trip through the queue per event.
+  ///
+  /// \param[out] tags Array of at least \a max_events entries, filled with
+  ///        the tags of the events read.
+  /// \param[out] oks Array of at least \a max_events entries, filled with
+  ///        the \a ok value of each event (see \a Next).
+  /// \param[in] max_events Maximum number of events to read; must be > 0.
+  ///
+  /// \return The number of events read, or 0 if the queue is fully drained
+  ///         and shut down.
+  size_t NextBatch(void** tags, bool* oks, size_t max_events) {
+    return NextBatchInternal(
+        tags, oks, max_events,
+        grpc::g_core_codegen_interface->gpr_inf_future(GPR_CLOCK_REALTIME));
+  }
+
   /// Read from the queue, blocking up to \a deadline (or the queue's shutdown).
   /// Both \a tag and \a ok are updated upon success (if an event is available
   /// within the \a deadline).  A \a tag points to an arbitrary location usually
@@ -309,6 +328,8 @@ class CompletionQueue : private grpc::GrpcLibraryCodegen {
   };
 
   NextStatus AsyncNextInternal(void** tag, bool* ok, gpr_timespec deadline);
+  size_t NextBatchInternal(void** tags, bool* oks, size_t max_events,
+                           gpr_timespec deadline);
 
   /// Wraps \a grpc_completion_queue_pluck.
   /// \warning Must not be mixed with calls to \a Next.
@@ -65,6 +65,14 @@
 #define GRPC_CUSTOM_CODEDINPUTSTREAM ::google::protobuf::io::CodedInputStream
 #endif
 
+// Protobuf releases that can keep bytes fields in an absl::Cord pull them
+// from input streams through ZeroCopyInputStream::ReadCord.
+#ifndef GRPC_PROTOBUF_CORD_SUPPORT_ENABLED
+#if defined(GOOGLE_PROTOBUF_VERSION) && GOOGLE_PROTOBUF_VERSION >= 4022000
+#define GRPC_PROTOBUF_CORD_SUPPORT_ENABLED
+#endif
+#endif
+
 #ifndef GRPC_CUSTOM_JSONUTIL
 #include <google/protobuf/util/json_util.h>
 #include <google/protobuf/util/type_resolver_util.h>
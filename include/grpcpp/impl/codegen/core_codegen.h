@@ -119,6 +119,12 @@ class CoreCodegen final : public CoreCodegenInterface {
   gpr_timespec gpr_inf_future(gpr_clock_type type) override;
   gpr_timespec gpr_time_0(gpr_clock_type type) override;
 
+  bool grpc_call_object_passing(grpc_call* call) override;
+  grpc_slice grpc_slice_from_object(void* object, const void* type,
+                                    void (*destroy)(void*)) override;
+  void* grpc_slice_get_object(grpc_slice slice, const void** type,
+                              bool* unique) override;
+
   const Status& ok() override;
   const Status& cancelled() override;
 
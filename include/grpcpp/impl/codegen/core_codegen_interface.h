@@ -143,6 +143,13 @@ class CoreCodegenInterface {
 
   virtual gpr_timespec gpr_inf_future(gpr_clock_type type) = 0;
   virtual gpr_timespec gpr_time_0(gpr_clock_type type) = 0;
+
+  // Message object passing, see GRPC_ARG_INPROC_OBJECT_PASSING.
+  virtual bool grpc_call_object_passing(grpc_call* call) = 0;
+  virtual grpc_slice grpc_slice_from_object(void* object, const void* type,
+                                            void (*destroy)(void*)) = 0;
+  virtual void* grpc_slice_get_object(grpc_slice slice, const void** type,
+                                      bool* unique) = 0;
 };
 
 extern CoreCodegenInterface* g_core_codegen_interface;
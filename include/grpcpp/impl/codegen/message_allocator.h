@@ -57,10 +57,16 @@ class MessageHolder : public RpcAllocatorState {
   ResponseT* response_;
 };
 
-// A custom allocator can be set via the generated code to a callback unary
-// method, such as SetMessageAllocatorFor_Echo(custom_allocator). The allocator
+// A custom allocator can be set via the generated code to a callback method,
+// such as SetMessageAllocatorFor_Echo(custom_allocator). The allocator
 // needs to be alive for the lifetime of the server.
 // Implementations need to be thread-safe.
+// One MessageHolder is allocated per call and released after the reactor's
+// OnDone, so messages can live on a per-call arena. Reactors of streaming
+// methods reach it through the context's GetRpcAllocatorState(): the server
+// streaming request and the client streaming response are the ones used by
+// the library, the other messages are free for the reactor to reuse.
+// Client stubs take caller-owned messages and need no allocator.
 template <typename RequestT, typename ResponseT>
 class MessageAllocator {
  public:
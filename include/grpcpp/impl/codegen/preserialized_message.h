@@ -0,0 +1,91 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_IMPL_CODEGEN_PRESERIALIZED_MESSAGE_H
+#define GRPCPP_IMPL_CODEGEN_PRESERIALIZED_MESSAGE_H
+
+#include <stddef.h>
+
+#include <memory>
+
+#include <grpcpp/impl/codegen/byte_buffer.h>
+#include <grpcpp/impl/codegen/serialization_traits.h>
+#include <grpcpp/impl/codegen/status.h>
+
+namespace grpc {
+namespace experimental {
+
+/// EXPERIMENTAL
+/// A message of type \a M serialized once, to be written to many streams.
+/// The serialized bytes are immutable and shared by all the copies of a
+/// PreserializedMessage, and writing one only takes a reference on each of
+/// its slices: sending it to N streams costs N refcount updates instead of
+/// N serializations. Copying and writing are thread-safe.
+template <class M>
+class PreserializedMessage {
+ public:
+  /// An empty message, which fails to be written.
+  PreserializedMessage() = default;
+
+  /// Serializes \a message with SerializationTraits<M>. If that fails,
+  /// status() is the error, which writing the message fails with.
+  explicit PreserializedMessage(const M& message) {
+    ByteBuffer buffer;
+    bool own_buffer;
+    status_ = SerializationTraits<M>::Serialize(message, &buffer, &own_buffer);
+    if (!status_.ok()) return;
+    if (!own_buffer) buffer.Duplicate();
+    auto shared = std::make_shared<ByteBuffer>();
+    shared->Swap(&buffer);
+    buffer_ = std::move(shared);
+  }
+
+  const Status& status() const { return status_; }
+
+  /// Size of the serialized message in bytes.
+  size_t Length() const { return buffer_ == nullptr ? 0 : buffer_->Length(); }
+
+ private:
+  friend class SerializationTraits<PreserializedMessage>;
+
+  Status status_;
+  std::shared_ptr<const ByteBuffer> buffer_;
+};
+
+}  // namespace experimental
+
+template <class M>
+class SerializationTraits<experimental::PreserializedMessage<M>> {
+ public:
+  static Status Serialize(const experimental::PreserializedMessage<M>& msg,
+                          ByteBuffer* bb, bool* own_buffer) {
+    *own_buffer = true;
+    if (!msg.status_.ok()) return msg.status_;
+    if (msg.buffer_ == nullptr) {
+      return Status(StatusCode::FAILED_PRECONDITION,
+                    "Empty preserialized message");
+    }
+    // Copying a ByteBuffer references its slices.
+    *bb = *msg.buffer_;
+    return Status::OK;
+  }
+};
+
+}  // namespace grpc
+
+#endif  // GRPCPP_IMPL_CODEGEN_PRESERIALIZED_MESSAGE_H
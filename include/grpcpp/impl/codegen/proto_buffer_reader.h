@@ -32,6 +32,10 @@
 #include <grpcpp/impl/codegen/serialization_traits.h>
 #include <grpcpp/impl/codegen/status.h>
 
+#ifdef GRPC_PROTOBUF_CORD_SUPPORT_ENABLED
+#include "absl/strings/cord.h"
+#endif
+
 /// This header provides an object that reads bytes directly from a
 /// grpc::ByteBuffer, via the ZeroCopyInputStream interface
 
@@ -125,6 +129,49 @@ class ProtoBufferReader : public grpc::protobuf::io::ZeroCopyInputStream {
   /// Returns the total number of bytes read since this object was created.
   int64_t ByteCount() const override { return byte_count_ - backup_count_; }
 
+#ifdef GRPC_PROTOBUF_CORD_SUPPORT_ENABLED
+  /// The proto library calls this to read \a count bytes into a Cord field.
+  /// The Cord aliases the received slices, which stay referenced until the
+  /// Cord lets go of them, so large bytes fields are never copied.
+  bool ReadCord(absl::Cord* cord, int count) override {
+    if (!status_.ok()) {
+      return false;
+    }
+    /// First hand out what is left of a backed-up slice
+    if (backup_count_ > 0 && count > 0) {
+      size_t length = GRPC_SLICE_LENGTH(*slice_);
+      size_t begin = length - backup_count_;
+      if (backup_count_ > count) {
+        AppendSlice(cord, g_core_codegen_interface->grpc_slice_sub(
+                              *slice_, begin, begin + count));
+        backup_count_ -= count;
+        return true;
+      }
+      AppendSlice(cord, g_core_codegen_interface->grpc_slice_sub(
+                            *slice_, begin, length));
+      count -= static_cast<int>(backup_count_);
+      backup_count_ = 0;
+    }
+    while (count > 0) {
+      if (!g_core_codegen_interface->grpc_byte_buffer_reader_peek(&reader_,
+                                                                  &slice_)) {
+        return false;
+      }
+      size_t length = GRPC_SLICE_LENGTH(*slice_);
+      byte_count_ += length;
+      if (length > static_cast<size_t>(count)) {
+        AppendSlice(cord,
+                    g_core_codegen_interface->grpc_slice_sub(*slice_, 0, count));
+        backup_count_ = length - count;
+        return true;
+      }
+      AppendSlice(cord, g_core_codegen_interface->grpc_slice_ref(*slice_));
+      count -= static_cast<int>(length);
+    }
+    return true;
+  }
+#endif
+
   // These protected members are needed to support internal optimizations.
   // they expose internal bits of grpc core that are NOT stable. If you have
   // a use case needs to use one of these functions, please send an email to
@@ -138,6 +185,24 @@ class ProtoBufferReader : public grpc::protobuf::io::ZeroCopyInputStream {
   grpc_slice** mutable_slice_ptr() { return &slice_; }
 
  private:
+#ifdef GRPC_PROTOBUF_CORD_SUPPORT_ENABLED
+  /// Appends \a slice to \a cord, taking over its reference. Inlined slices
+  /// carry their bytes in the slice itself and are copied.
+  static void AppendSlice(absl::Cord* cord, grpc_slice slice) {
+    absl::string_view view(
+        reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(slice)),
+        GRPC_SLICE_LENGTH(slice));
+    if (slice.refcount == nullptr) {
+      cord->Append(view);
+      return;
+    }
+    cord->Append(absl::MakeCordFromExternal(
+        view, [slice](absl::string_view /*view*/) {
+          g_core_codegen_interface->grpc_slice_unref(slice);
+        }));
+  }
+#endif
+
   int64_t byte_count_;              ///< total bytes read since object creation
   int64_t backup_count_;            ///< how far backed up in the stream we are
   grpc_byte_buffer_reader reader_;  ///< internal object to read \a grpc_slice
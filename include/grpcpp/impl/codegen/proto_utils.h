@@ -52,7 +52,10 @@ Status GenericSerialize(const grpc::protobuf::MessageLite& msg, ByteBuffer* bb,
                 "::protobuf::io::ZeroCopyOutputStream");
   *own_buffer = true;
   int byte_size = static_cast<int>(msg.ByteSizeLong());
-  if (static_cast<size_t>(byte_size) <= GRPC_SLICE_INLINED_SIZE) {
+  // Messages that fit in one writer block get a single slice of exactly
+  // their size, skipping the stream. Larger ones are scattered over
+  // pre-sized blocks by the writer.
+  if (byte_size <= kProtoBufferWriterMaxBufferLength) {
     Slice slice(byte_size);
     // We serialize directly into the allocated slices memory
     GPR_CODEGEN_ASSERT(slice.end() == msg.SerializeWithCachedSizesToArray(
@@ -96,6 +99,24 @@ Status GenericDeserialize(ByteBuffer* buffer,
 // this is needed so the following class does not conflict with protobuf
 // serializers that utilize internal-only tools.
 #ifdef GRPC_OPEN_SOURCE_PROTO
+namespace internal {
+// The MessageObjectType of protobuf messages of type T.
+template <class T>
+struct ProtoObjectType {
+  static Status Serialize(const void* object, ByteBuffer* bb) {
+    bool own_buffer;
+    return GenericSerialize<ProtoBufferWriter, T>(
+        *static_cast<const T*>(object), bb, &own_buffer);
+  }
+  static void Destroy(void* object) { delete static_cast<T*>(object); }
+
+  static const MessageObjectType kType;
+};
+
+template <class T>
+const MessageObjectType ProtoObjectType<T>::kType = {Serialize, Destroy};
+}  // namespace internal
+
 // This class provides a protobuf serializer. It translates between protobuf
 // objects and grpc_byte_buffers. More information about SerializationTraits can
 // be found in include/grpcpp/impl/codegen/serialization_traits.h.
@@ -111,8 +132,41 @@ class SerializationTraits<
 
   static Status Deserialize(ByteBuffer* buffer,
                             grpc::protobuf::MessageLite* msg) {
+    if (buffer != nullptr) {
+      const internal::MessageObjectType* type;
+      bool unique;
+      void* object =
+          internal::MessageObjectBuffer::Get(*buffer, &type, &unique);
+      if (object != nullptr && type == &internal::ProtoObjectType<T>::kType) {
+        // The sender's copy is ours to take if nobody else holds it.
+        if (unique) {
+          static_cast<T*>(msg)->Swap(static_cast<T*>(object));
+        } else {
+          static_cast<T*>(msg)->CopyFrom(*static_cast<const T*>(object));
+        }
+        buffer->Clear();
+        return g_core_codegen_interface->ok();
+      }
+      if (object != nullptr) {
+        // A message of another type: fall back to its bytes.
+        Status result = internal::MessageObjectBuffer::ToBytes(buffer);
+        if (!result.ok()) return result;
+      }
+    }
     return GenericDeserialize<ProtoBufferReader, T>(buffer, msg);
   }
+
+  // Wraps a copy of \a msg in \a bb in place of its bytes, for calls that may
+  // pass message objects (see GRPC_ARG_INPROC_OBJECT_PASSING). Copying is
+  // cheaper than serializing and parsing, and leaves the caller's message,
+  // which may live on an arena, untouched.
+  static Status SerializeObject(const grpc::protobuf::MessageLite& msg,
+                                ByteBuffer* bb) {
+    internal::MessageObjectBuffer::Wrap(
+        new T(static_cast<const T&>(msg)), &internal::ProtoObjectType<T>::kType,
+        bb);
+    return g_core_codegen_interface->ok();
+  }
 };
 #endif
 
@@ -63,6 +63,13 @@ class RpcMethod {
         method_type_(type),
         channel_tag_(channel->RegisterMethod(name)) {}
 
+  // Copy of \a method carrying another channel's registration.
+  RpcMethod(const RpcMethod& method, void* channel_tag)
+      : name_(method.name_),
+        suffix_for_stats_(method.suffix_for_stats_),
+        method_type_(method.method_type_),
+        channel_tag_(channel_tag) {}
+
   const char* name() const { return name_; }
   const char* suffix_for_stats() const { return suffix_for_stats_; }
   RpcType method_type() const { return method_type_; }
@@ -30,6 +30,7 @@
 #include <grpcpp/impl/codegen/config.h>
 #include <grpcpp/impl/codegen/core_codegen_interface.h>
 #include <grpcpp/impl/codegen/message_allocator.h>
+#include <grpcpp/impl/codegen/preserialized_message.h>
 #include <grpcpp/impl/codegen/status.h>
 #include <grpcpp/impl/codegen/sync.h>
 
@@ -212,6 +213,7 @@ class ServerCallbackReader : public internal::ServerCallbackCall {
   virtual void Finish(grpc::Status s) = 0;
   virtual void SendInitialMetadata() = 0;
   virtual void Read(Request* msg) = 0;
+  virtual void ReadChunk(grpc::ByteBuffer* chunk, bool* last) = 0;
 
  protected:
   void BindReactor(ServerReadReactor<Request>* reactor) {
@@ -227,6 +229,9 @@ class ServerCallbackWriter : public internal::ServerCallbackCall {
   virtual void Finish(grpc::Status s) = 0;
   virtual void SendInitialMetadata() = 0;
   virtual void Write(const Response* msg, grpc::WriteOptions options) = 0;
+  virtual void WritePreserialized(
+      const experimental::PreserializedMessage<Response>& msg,
+      grpc::WriteOptions options) = 0;
   virtual void WriteAndFinish(const Response* msg, grpc::WriteOptions options,
                               grpc::Status s) = 0;
 
@@ -386,6 +391,23 @@ class ServerBidiReactor : public internal::ServerReactor {
     StartWrite(resp, options.set_last_message());
   }
 
+  /// Initiate writes of the \a count messages at \a resps as one transport
+  /// write, with a single OnWriteDone once the last one is done or as soon as
+  /// one fails. All but the last message are written with
+  /// WriteOptions::set_buffer_hint, and the last one flushes the batch.
+  ///
+  /// \param[in] resps The messages to be written. The library does not take
+  ///                  ownership but the caller must ensure that they are not
+  ///                  deleted or modified until OnWriteDone is called.
+  /// \param[in] count The number of messages, which must not be zero.
+  /// \param[in] options The WriteOptions to use for writing the messages
+  void StartWriteBatch(const Response* resps, size_t count,
+                       grpc::WriteOptions options = grpc::WriteOptions()) {
+    write_batch_.Start(resps, count, options);
+    const Response* first = write_batch_.Next(&options);
+    StartWrite(first, options);
+  }
+
   /// Indicate that the stream is to be finished and the trailing metadata and
   /// RPC status are to be sent. Every RPC MUST be finished using either Finish
   /// or StartWriteAndFinish (but not both), even if the RPC is already
@@ -428,6 +450,19 @@ class ServerBidiReactor : public internal::ServerReactor {
   ///               will succeed.
   virtual void OnWriteDone(bool /*ok*/) {}
 
+  /// Not part of the public API: called by the library when a write
+  /// completes, to continue a StartWriteBatch or notify OnWriteDone.
+  void InternalWriteDone(bool ok) {
+    if (ok && write_batch_.active()) {
+      grpc::WriteOptions options;
+      const Response* next = write_batch_.Next(&options);
+      StartWrite(next, options);
+      return;
+    }
+    write_batch_.Clear();
+    OnWriteDone(ok);
+  }
+
   /// Notifies the application that all operations associated with this RPC
   /// have completed. This is an override (from the internal base class) but
   /// still abstract, so derived classes MUST override it to be instantiated.
@@ -485,6 +520,7 @@ class ServerBidiReactor : public internal::ServerReactor {
     grpc::Status status_wanted;
   };
   PreBindBacklog backlog_ ABSL_GUARDED_BY(stream_mu_);
+  grpc::internal::WriteBatchState<Response> write_batch_;
 };
 
 /// \a ServerReadReactor is the interface for a client-streaming RPC.
@@ -521,6 +557,31 @@ class ServerReadReactor : public internal::ServerReactor {
     }
     reader->Read(req);
   }
+  /// Initiate a read of the next chunk of the current request message as raw
+  /// serialized bytes, so that a large message can be consumed before all of
+  /// it has arrived. A chunk ends once at least 64KiB of the message has
+  /// arrived, or at the end of the message, in which case *last is set to
+  /// true. Compressed messages are delivered as a single chunk. Chunked reads
+  /// bypass interceptors and must not be outstanding together with StartRead.
+  ///
+  /// \param[out] chunk Where to store the chunk; must remain valid until
+  ///                   OnReadChunkDone is called
+  /// \param[out] last Set to whether this chunk completes the message
+  void StartReadChunk(grpc::ByteBuffer* chunk, bool* last)
+      ABSL_LOCKS_EXCLUDED(reader_mu_) {
+    ServerCallbackReader<Request>* reader =
+        reader_.load(std::memory_order_acquire);
+    if (reader == nullptr) {
+      grpc::internal::MutexLock l(&reader_mu_);
+      reader = reader_.load(std::memory_order_relaxed);
+      if (reader == nullptr) {
+        backlog_.read_chunk_wanted = chunk;
+        backlog_.read_chunk_last_wanted = last;
+        return;
+      }
+    }
+    reader->ReadChunk(chunk, last);
+  }
   void Finish(grpc::Status s) ABSL_LOCKS_EXCLUDED(reader_mu_) {
     ServerCallbackReader<Request>* reader =
         reader_.load(std::memory_order_acquire);
@@ -539,6 +600,9 @@ class ServerReadReactor : public internal::ServerReactor {
   /// The following notifications are exactly like ServerBidiReactor.
   virtual void OnSendInitialMetadataDone(bool /*ok*/) {}
   virtual void OnReadDone(bool /*ok*/) {}
+  /// Notifies the application that a StartReadChunk operation completed. ok
+  /// is false if there was no message left to read or the call was cancelled.
+  virtual void OnReadChunkDone(bool /*ok*/) {}
   void OnDone() override = 0;
   void OnCancel() override {}
 
@@ -557,6 +621,10 @@ class ServerReadReactor : public internal::ServerReactor {
     if (GPR_UNLIKELY(backlog_.read_wanted != nullptr)) {
       reader->Read(backlog_.read_wanted);
     }
+    if (GPR_UNLIKELY(backlog_.read_chunk_wanted != nullptr)) {
+      reader->ReadChunk(backlog_.read_chunk_wanted,
+                        backlog_.read_chunk_last_wanted);
+    }
     if (GPR_UNLIKELY(backlog_.finish_wanted)) {
       reader->Finish(std::move(backlog_.status_wanted));
     }
@@ -570,6 +638,8 @@ class ServerReadReactor : public internal::ServerReactor {
     bool send_initial_metadata_wanted = false;
     bool finish_wanted = false;
     Request* read_wanted = nullptr;
+    grpc::ByteBuffer* read_chunk_wanted = nullptr;
+    bool* read_chunk_last_wanted = nullptr;
     grpc::Status status_wanted;
   };
   PreBindBacklog backlog_ ABSL_GUARDED_BY(reader_mu_);
@@ -634,6 +704,52 @@ class ServerWriteReactor : public internal::ServerReactor {
   void StartWriteLast(const Response* resp, grpc::WriteOptions options) {
     StartWrite(resp, options.set_last_message());
   }
+
+  /// EXPERIMENTAL
+  /// Initiate a write of \a msg, sharing its serialized bytes with the other
+  /// streams it is written to. Unlike the messages of the other forms of
+  /// StartWrite, \a msg may be destroyed as soon as this returns. It must
+  /// have been serialized successfully.
+  void StartWrite(const experimental::PreserializedMessage<Response>& msg) {
+    StartWrite(msg, grpc::WriteOptions());
+  }
+  void StartWrite(const experimental::PreserializedMessage<Response>& msg,
+                  grpc::WriteOptions options) ABSL_LOCKS_EXCLUDED(writer_mu_) {
+    ServerCallbackWriter<Response>* writer =
+        writer_.load(std::memory_order_acquire);
+    if (writer == nullptr) {
+      grpc::internal::MutexLock l(&writer_mu_);
+      writer = writer_.load(std::memory_order_relaxed);
+      if (writer == nullptr) {
+        backlog_.preserialized_write_wanted = true;
+        backlog_.preserialized_wanted = msg;
+        backlog_.write_options_wanted = options;
+        return;
+      }
+    }
+    writer->WritePreserialized(msg, options);
+  }
+  void StartWriteLast(const experimental::PreserializedMessage<Response>& msg,
+                      grpc::WriteOptions options) {
+    StartWrite(msg, options.set_last_message());
+  }
+
+  /// Initiate writes of the \a count messages at \a resps as one transport
+  /// write, with a single OnWriteDone once the last one is done or as soon as
+  /// one fails. All but the last message are written with
+  /// WriteOptions::set_buffer_hint, and the last one flushes the batch.
+  ///
+  /// \param[in] resps The messages to be written. The library does not take
+  ///                  ownership but the caller must ensure that they are not
+  ///                  deleted or modified until OnWriteDone is called.
+  /// \param[in] count The number of messages, which must not be zero.
+  /// \param[in] options The WriteOptions to use for writing the messages
+  void StartWriteBatch(const Response* resps, size_t count,
+                       grpc::WriteOptions options = grpc::WriteOptions()) {
+    write_batch_.Start(resps, count, options);
+    const Response* first = write_batch_.Next(&options);
+    StartWrite(first, options);
+  }
   void Finish(grpc::Status s) ABSL_LOCKS_EXCLUDED(writer_mu_) {
     ServerCallbackWriter<Response>* writer =
         writer_.load(std::memory_order_acquire);
@@ -655,6 +771,19 @@ class ServerWriteReactor : public internal::ServerReactor {
   void OnDone() override = 0;
   void OnCancel() override {}
 
+  /// Not part of the public API: called by the library when a write
+  /// completes, to continue a StartWriteBatch or notify OnWriteDone.
+  void InternalWriteDone(bool ok) {
+    if (ok && write_batch_.active()) {
+      grpc::WriteOptions options;
+      const Response* next = write_batch_.Next(&options);
+      StartWrite(next, options);
+      return;
+    }
+    write_batch_.Clear();
+    OnWriteDone(ok);
+  }
+
  private:
   friend class ServerCallbackWriter<Response>;
   // May be overridden by internal implementation details. This is not a public
@@ -674,6 +803,11 @@ class ServerWriteReactor : public internal::ServerReactor {
       if (GPR_UNLIKELY(backlog_.write_wanted != nullptr)) {
         writer->Write(backlog_.write_wanted,
                       std::move(backlog_.write_options_wanted));
+      } else if (GPR_UNLIKELY(backlog_.preserialized_write_wanted)) {
+        writer->WritePreserialized(backlog_.preserialized_wanted,
+                                   std::move(backlog_.write_options_wanted));
+        backlog_.preserialized_wanted =
+            experimental::PreserializedMessage<Response>();
       }
       if (GPR_UNLIKELY(backlog_.finish_wanted)) {
         writer->Finish(std::move(backlog_.status_wanted));
@@ -689,11 +823,14 @@ class ServerWriteReactor : public internal::ServerReactor {
     bool send_initial_metadata_wanted = false;
     bool write_and_finish_wanted = false;
     bool finish_wanted = false;
+    bool preserialized_write_wanted = false;
     const Response* write_wanted = nullptr;
+    experimental::PreserializedMessage<Response> preserialized_wanted;
     grpc::WriteOptions write_options_wanted;
     grpc::Status status_wanted;
   };
   PreBindBacklog backlog_ ABSL_GUARDED_BY(writer_mu_);
+  grpc::internal::WriteBatchState<Response> write_batch_;
 };
 
 class ServerUnaryReactor : public internal::ServerReactor {
@@ -21,6 +21,7 @@
 // IWYU pragma: private
 
 #include <grpcpp/impl/codegen/message_allocator.h>
+#include <grpcpp/impl/codegen/preserialized_message.h>
 #include <grpcpp/impl/codegen/rpc_service_method.h>
 #include <grpcpp/impl/codegen/server_callback.h>
 #include <grpcpp/impl/codegen/server_context.h>
@@ -256,6 +257,14 @@ class CallbackClientStreamingHandler : public grpc::internal::MethodHandler {
           grpc::CallbackServerContext*, ResponseType*)>
           get_reactor)
       : get_reactor_(std::move(get_reactor)) {}
+
+  // The allocated messages live for the whole call. The response is the one
+  // sent by Finish, while the request is free for the reactor to read into.
+  void SetMessageAllocator(
+      MessageAllocator<RequestType, ResponseType>* allocator) {
+    allocator_ = allocator;
+  }
+
   void RunHandler(const HandlerParameter& param) final {
     // Arena allocate a reader structure (that includes response)
     grpc::g_core_codegen_interface->grpc_call_ref(param.call->call());
@@ -264,7 +273,9 @@ class CallbackClientStreamingHandler : public grpc::internal::MethodHandler {
         param.call->call(), sizeof(ServerCallbackReaderImpl)))
         ServerCallbackReaderImpl(
             static_cast<grpc::CallbackServerContext*>(param.server_context),
-            param.call, param.call_requester);
+            param.call,
+            allocator_ != nullptr ? allocator_->AllocateMessages() : nullptr,
+            param.call_requester);
     // Inlineable OnDone can be false in the CompletionOp callback because there
     // is no read reactor that has an inlineable OnDone; this only applies to
     // the DefaultReactor (which is unary).
@@ -297,6 +308,7 @@ class CallbackClientStreamingHandler : public grpc::internal::MethodHandler {
   std::function<ServerReadReactor<RequestType>*(grpc::CallbackServerContext*,
                                                 ResponseType*)>
       get_reactor_;
+  MessageAllocator<RequestType, ResponseType>* allocator_ = nullptr;
 
   class ServerCallbackReaderImpl : public ServerCallbackReader<RequestType> {
    public:
@@ -324,7 +336,7 @@ class CallbackClientStreamingHandler : public grpc::internal::MethodHandler {
       // The response is dropped if the status is not OK.
       if (s.ok()) {
         finish_ops_.ServerSendStatus(&ctx_->trailing_metadata_,
-                                     finish_ops_.SendMessagePtr(&resp_));
+                                     finish_ops_.SendMessagePtr(response()));
       } else {
         finish_ops_.ServerSendStatus(&ctx_->trailing_metadata_, s);
       }
@@ -363,13 +375,25 @@ class CallbackClientStreamingHandler : public grpc::internal::MethodHandler {
       call_.PerformOps(&read_ops_);
     }
 
+    void ReadChunk(grpc::ByteBuffer* chunk, bool* last) override {
+      this->Ref();
+      read_chunk_ops_.RecvMessageChunk(chunk, last);
+      call_.PerformOps(&read_chunk_ops_);
+    }
+
    private:
     friend class CallbackClientStreamingHandler<RequestType, ResponseType>;
 
-    ServerCallbackReaderImpl(grpc::CallbackServerContext* ctx,
-                             grpc::internal::Call* call,
-                             std::function<void()> call_requester)
-        : ctx_(ctx), call_(*call), call_requester_(std::move(call_requester)) {}
+    ServerCallbackReaderImpl(
+        grpc::CallbackServerContext* ctx, grpc::internal::Call* call,
+        MessageHolder<RequestType, ResponseType>* allocator_state,
+        std::function<void()> call_requester)
+        : ctx_(ctx),
+          call_(*call),
+          allocator_state_(allocator_state),
+          call_requester_(std::move(call_requester)) {
+      ctx_->set_message_allocator_state(allocator_state);
+    }
 
     void SetupReactor(ServerReadReactor<RequestType>* reactor) {
       reactor_.store(reactor, std::memory_order_relaxed);
@@ -387,6 +411,17 @@ class CallbackClientStreamingHandler : public grpc::internal::MethodHandler {
           },
           &read_ops_, /*can_inline=*/false);
       read_ops_.set_core_cq_tag(&read_tag_);
+      read_chunk_tag_.Set(
+          call_.call(),
+          [this, reactor](bool ok) {
+            if (GPR_UNLIKELY(!ok)) {
+              ctx_->MaybeMarkCancelledOnRead();
+            }
+            reactor->OnReadChunkDone(ok);
+            this->MaybeDone(/*inlineable_ondone=*/true);
+          },
+          &read_chunk_ops_, /*can_inline=*/false);
+      read_chunk_ops_.set_core_cq_tag(&read_chunk_tag_);
       this->BindReactor(reactor);
       this->MaybeCallOnCancel(reactor);
       // Inlineable OnDone can be false here because there is no read
@@ -397,12 +432,18 @@ class CallbackClientStreamingHandler : public grpc::internal::MethodHandler {
 
     ~ServerCallbackReaderImpl() {}
 
-    ResponseType* response() { return &resp_; }
+    ResponseType* response() {
+      return allocator_state_ != nullptr ? allocator_state_->response()
+                                         : &resp_;
+    }
 
     void CallOnDone() override {
       reactor_.load(std::memory_order_relaxed)->OnDone();
       grpc_call* call = call_.call();
       auto call_requester = std::move(call_requester_);
+      if (allocator_state_ != nullptr) {
+        allocator_state_->Release();
+      }
       if (ctx_->context_allocator() != nullptr) {
         ctx_->context_allocator()->Release(ctx_);
       }
@@ -426,9 +467,14 @@ class CallbackClientStreamingHandler : public grpc::internal::MethodHandler {
     grpc::internal::CallOpSet<grpc::internal::CallOpRecvMessage<RequestType>>
         read_ops_;
     grpc::internal::CallbackWithSuccessTag read_tag_;
+    grpc::internal::CallOpSet<grpc::internal::CallOpRecvMessageChunk>
+        read_chunk_ops_;
+    grpc::internal::CallbackWithSuccessTag read_chunk_tag_;
 
     grpc::CallbackServerContext* const ctx_;
     grpc::internal::Call call_;
+    MessageHolder<RequestType, ResponseType>* const allocator_state_;
+    // Only used without an allocator.
     ResponseType resp_;
     std::function<void()> call_requester_;
     // The memory ordering of reactor_ follows ServerCallbackUnaryImpl.
@@ -447,6 +493,15 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
           grpc::CallbackServerContext*, const RequestType*)>
           get_reactor)
       : get_reactor_(std::move(get_reactor)) {}
+
+  // The allocated messages live for the whole call. The request is the one
+  // passed to the reactor, while the response is free for the reactor to
+  // write from.
+  void SetMessageAllocator(
+      MessageAllocator<RequestType, ResponseType>* allocator) {
+    allocator_ = allocator;
+  }
+
   void RunHandler(const HandlerParameter& param) final {
     // Arena allocate a writer structure
     grpc::g_core_codegen_interface->grpc_call_ref(param.call->call());
@@ -456,6 +511,8 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
         ServerCallbackWriterImpl(
             static_cast<grpc::CallbackServerContext*>(param.server_context),
             param.call, static_cast<RequestType*>(param.request),
+            static_cast<MessageHolder<RequestType, ResponseType>*>(
+                param.internal_data),
             param.call_requester);
     // Inlineable OnDone can be false in the CompletionOp callback because there
     // is no write reactor that has an inlineable OnDone; this only applies to
@@ -485,18 +542,28 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
   }
 
   void* Deserialize(grpc_call* call, grpc_byte_buffer* req,
-                    grpc::Status* status, void** /*handler_data*/) final {
+                    grpc::Status* status, void** handler_data) final {
     grpc::ByteBuffer buf;
     buf.set_buffer(req);
-    auto* request = new (grpc::g_core_codegen_interface->grpc_call_arena_alloc(
-        call, sizeof(RequestType))) RequestType();
+    RequestType* request;
+    if (allocator_ != nullptr) {
+      // Handed to the writer through handler_data, which releases it.
+      auto* allocator_state = allocator_->AllocateMessages();
+      *handler_data = allocator_state;
+      request = allocator_state->request();
+    } else {
+      request = new (grpc::g_core_codegen_interface->grpc_call_arena_alloc(
+          call, sizeof(RequestType))) RequestType();
+    }
     *status =
         grpc::SerializationTraits<RequestType>::Deserialize(&buf, request);
     buf.Release();
     if (status->ok()) {
       return request;
     }
-    request->~RequestType();
+    if (allocator_ == nullptr) {
+      request->~RequestType();
+    }
     return nullptr;
   }
 
@@ -504,6 +571,7 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
   std::function<ServerWriteReactor<ResponseType>*(grpc::CallbackServerContext*,
                                                   const RequestType*)>
       get_reactor_;
+  MessageAllocator<RequestType, ResponseType>* allocator_ = nullptr;
 
   class ServerCallbackWriterImpl : public ServerCallbackWriter<ResponseType> {
    public:
@@ -577,6 +645,26 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
       call_.PerformOps(&write_ops_);
     }
 
+    void WritePreserialized(
+        const experimental::PreserializedMessage<ResponseType>& msg,
+        grpc::WriteOptions options) override {
+      this->Ref();
+      if (options.is_last_message()) {
+        options.set_buffer_hint();
+      }
+      if (!ctx_->sent_initial_metadata_) {
+        write_ops_.SendInitialMetadata(&ctx_->initial_metadata_,
+                                       ctx_->initial_metadata_flags());
+        if (ctx_->compression_level_set()) {
+          write_ops_.set_compression_level(ctx_->compression_level());
+        }
+        ctx_->sent_initial_metadata_ = true;
+      }
+      // Only references the slices of msg, so it need not outlive the write.
+      GPR_CODEGEN_ASSERT(write_ops_.SendMessage(msg, options).ok());
+      call_.PerformOps(&write_ops_);
+    }
+
     void WriteAndFinish(const ResponseType* resp, grpc::WriteOptions options,
                         grpc::Status s) override {
       // This combines the write into the finish callback
@@ -588,13 +676,18 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
    private:
     friend class CallbackServerStreamingHandler<RequestType, ResponseType>;
 
-    ServerCallbackWriterImpl(grpc::CallbackServerContext* ctx,
-                             grpc::internal::Call* call, const RequestType* req,
-                             std::function<void()> call_requester)
+    ServerCallbackWriterImpl(
+        grpc::CallbackServerContext* ctx, grpc::internal::Call* call,
+        const RequestType* req,
+        MessageHolder<RequestType, ResponseType>* allocator_state,
+        std::function<void()> call_requester)
         : ctx_(ctx),
           call_(*call),
           req_(req),
-          call_requester_(std::move(call_requester)) {}
+          allocator_state_(allocator_state),
+          call_requester_(std::move(call_requester)) {
+      ctx_->set_message_allocator_state(allocator_state);
+    }
 
     void SetupReactor(ServerWriteReactor<ResponseType>* reactor) {
       reactor_.store(reactor, std::memory_order_relaxed);
@@ -604,7 +697,7 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
       write_tag_.Set(
           call_.call(),
           [this, reactor](bool ok) {
-            reactor->OnWriteDone(ok);
+            reactor->InternalWriteDone(ok);
             this->MaybeDone(/*inlineable_ondone=*/true);
           },
           &write_ops_, /*can_inline=*/false);
@@ -617,7 +710,9 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
       this->MaybeDone(/*inlineable_ondone=*/false);
     }
     ~ServerCallbackWriterImpl() {
-      if (req_ != nullptr) {
+      if (allocator_state_ != nullptr) {
+        allocator_state_->Release();
+      } else if (req_ != nullptr) {
         req_->~RequestType();
       }
     }
@@ -656,6 +751,7 @@ class CallbackServerStreamingHandler : public grpc::internal::MethodHandler {
     grpc::CallbackServerContext* const ctx_;
     grpc::internal::Call call_;
     const RequestType* req_;
+    MessageHolder<RequestType, ResponseType>* const allocator_state_;
     std::function<void()> call_requester_;
     // The memory ordering of reactor_ follows ServerCallbackUnaryImpl.
     std::atomic<ServerWriteReactor<ResponseType>*> reactor_;
@@ -673,6 +769,14 @@ class CallbackBidiHandler : public grpc::internal::MethodHandler {
           grpc::CallbackServerContext*)>
           get_reactor)
       : get_reactor_(std::move(get_reactor)) {}
+
+  // The allocated messages live for the whole call and are free for the
+  // reactor to read into and write from.
+  void SetMessageAllocator(
+      MessageAllocator<RequestType, ResponseType>* allocator) {
+    allocator_ = allocator;
+  }
+
   void RunHandler(const HandlerParameter& param) final {
     grpc::g_core_codegen_interface->grpc_call_ref(param.call->call());
 
@@ -680,7 +784,9 @@ class CallbackBidiHandler : public grpc::internal::MethodHandler {
         param.call->call(), sizeof(ServerCallbackReaderWriterImpl)))
         ServerCallbackReaderWriterImpl(
             static_cast<grpc::CallbackServerContext*>(param.server_context),
-            param.call, param.call_requester);
+            param.call,
+            allocator_ != nullptr ? allocator_->AllocateMessages() : nullptr,
+            param.call_requester);
     // Inlineable OnDone can be false in the CompletionOp callback because there
     // is no bidi reactor that has an inlineable OnDone; this only applies to
     // the DefaultReactor (which is unary).
@@ -713,6 +819,7 @@ class CallbackBidiHandler : public grpc::internal::MethodHandler {
   std::function<ServerBidiReactor<RequestType, ResponseType>*(
       grpc::CallbackServerContext*)>
       get_reactor_;
+  MessageAllocator<RequestType, ResponseType>* allocator_ = nullptr;
 
   class ServerCallbackReaderWriterImpl
       : public ServerCallbackReaderWriter<RequestType, ResponseType> {
@@ -803,10 +910,16 @@ class CallbackBidiHandler : public grpc::internal::MethodHandler {
    private:
     friend class CallbackBidiHandler<RequestType, ResponseType>;
 
-    ServerCallbackReaderWriterImpl(grpc::CallbackServerContext* ctx,
-                                   grpc::internal::Call* call,
-                                   std::function<void()> call_requester)
-        : ctx_(ctx), call_(*call), call_requester_(std::move(call_requester)) {}
+    ServerCallbackReaderWriterImpl(
+        grpc::CallbackServerContext* ctx, grpc::internal::Call* call,
+        MessageHolder<RequestType, ResponseType>* allocator_state,
+        std::function<void()> call_requester)
+        : ctx_(ctx),
+          call_(*call),
+          allocator_state_(allocator_state),
+          call_requester_(std::move(call_requester)) {
+      ctx_->set_message_allocator_state(allocator_state);
+    }
 
     void SetupReactor(ServerBidiReactor<RequestType, ResponseType>* reactor) {
       reactor_.store(reactor, std::memory_order_relaxed);
@@ -816,7 +929,7 @@ class CallbackBidiHandler : public grpc::internal::MethodHandler {
       write_tag_.Set(
           call_.call(),
           [this, reactor](bool ok) {
-            reactor->OnWriteDone(ok);
+            reactor->InternalWriteDone(ok);
             this->MaybeDone(/*inlineable_ondone=*/true);
           },
           &write_ops_, /*can_inline=*/false);
@@ -844,6 +957,9 @@ class CallbackBidiHandler : public grpc::internal::MethodHandler {
       reactor_.load(std::memory_order_relaxed)->OnDone();
       grpc_call* call = call_.call();
       auto call_requester = std::move(call_requester_);
+      if (allocator_state_ != nullptr) {
+        allocator_state_->Release();
+      }
       if (ctx_->context_allocator() != nullptr) {
         ctx_->context_allocator()->Release(ctx_);
       }
@@ -874,6 +990,7 @@ class CallbackBidiHandler : public grpc::internal::MethodHandler {
 
     grpc::CallbackServerContext* const ctx_;
     grpc::internal::Call call_;
+    MessageHolder<RequestType, ResponseType>* const allocator_state_;
     std::function<void()> call_requester_;
     // The memory ordering of reactor_ follows ServerCallbackUnaryImpl.
     std::atomic<ServerBidiReactor<RequestType, ResponseType>*> reactor_;
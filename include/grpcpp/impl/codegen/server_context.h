@@ -107,6 +107,10 @@ class ServerInterface;
 class ContextAllocator;
 class GenericCallbackServerContext;
 
+namespace experimental {
+class CallMetricRecorder;
+}  // namespace experimental
+
 namespace internal {
 class Call;
 }  // namespace internal
@@ -260,6 +264,23 @@ class ServerContextBase {
   /// Set the serialized load reporting costs in \a cost_data for the call.
   void SetLoadReportingCosts(const std::vector<std::string>& cost_data);
 
+  /// EXPERIMENTAL API
+  /// Bound the number of bytes of request messages that the transport lets
+  /// the client send ahead of the reads of the application, so that a slow
+  /// reader does not have a whole flow control window buffered for it. 0, the
+  /// default, leaves the transport's flow control to decide.
+  /// Applies to the reads started after this call.
+  ///
+  /// \param max_bytes The bound, in bytes, or 0 for none.
+  void set_max_buffered_receive_bytes(uint32_t max_bytes);
+
+  /// EXPERIMENTAL API
+  /// Returns the recorder for the backend metrics of this call. They are sent
+  /// to the client in the call's trailing metadata if the server was built
+  /// with ServerBuilder::experimental().EnableCallMetricRecording(). The
+  /// recorder is created on the first call, and belongs to the call.
+  experimental::CallMetricRecorder* ExperimentalGetCallMetricRecorder();
+
   /// Return the authentication context for this server call.
   ///
   /// \see grpc::AuthContext.
@@ -296,7 +317,7 @@ class ServerContextBase {
 
   /// NOTE: This is an API for advanced users who need custom allocators.
   /// Get and maybe mutate the allocator state associated with the current RPC.
-  /// Currently only applicable for callback unary RPC methods.
+  /// Currently only applicable for callback RPC methods.
   RpcAllocatorState* GetRpcAllocatorState() { return message_allocator_state_; }
 
   /// Get a library-owned default unary reactor for use in minimal reaction
@@ -466,6 +487,7 @@ class ServerContextBase {
   grpc::experimental::ServerRpcInfo* rpc_info_ = nullptr;
   RpcAllocatorState* message_allocator_state_ = nullptr;
   ContextAllocator* context_allocator_ = nullptr;
+  experimental::CallMetricRecorder* call_metric_recorder_ = nullptr;
 
   class Reactor : public grpc::ServerUnaryReactor {
    public:
@@ -555,11 +577,13 @@ class ServerContext : public ServerContextBase {
   using ServerContextBase::compression_level;
   using ServerContextBase::compression_level_set;
   using ServerContextBase::deadline;
+  using ServerContextBase::ExperimentalGetCallMetricRecorder;
   using ServerContextBase::IsCancelled;
   using ServerContextBase::peer;
   using ServerContextBase::raw_deadline;
   using ServerContextBase::set_compression_algorithm;
   using ServerContextBase::set_compression_level;
+  using ServerContextBase::set_max_buffered_receive_bytes;
   using ServerContextBase::SetLoadReportingCosts;
   using ServerContextBase::TryCancel;
 
@@ -598,11 +622,13 @@ class CallbackServerContext : public ServerContextBase {
   using ServerContextBase::compression_level_set;
   using ServerContextBase::context_allocator;
   using ServerContextBase::deadline;
+  using ServerContextBase::ExperimentalGetCallMetricRecorder;
   using ServerContextBase::IsCancelled;
   using ServerContextBase::peer;
   using ServerContextBase::raw_deadline;
   using ServerContextBase::set_compression_algorithm;
   using ServerContextBase::set_compression_level;
+  using ServerContextBase::set_max_buffered_receive_bytes;
   using ServerContextBase::set_context_allocator;
   using ServerContextBase::SetLoadReportingCosts;
   using ServerContextBase::TryCancel;
@@ -25,6 +25,7 @@
 #include <grpcpp/impl/codegen/client_context.h>
 #include <grpcpp/impl/codegen/completion_queue.h>
 #include <grpcpp/impl/codegen/core_codegen_interface.h>
+#include <grpcpp/impl/codegen/preserialized_message.h>
 #include <grpcpp/impl/codegen/server_context.h>
 #include <grpcpp/impl/codegen/service_type.h>
 #include <grpcpp/impl/codegen/status.h>
@@ -141,6 +142,25 @@ class WriterInterface {
   void WriteLast(const W& msg, grpc::WriteOptions options) {
     Write(msg, options.set_last_message());
   }
+
+  /// Block to write the \a count messages at \a msgs as one transport write.
+  /// All but the last message are written with WriteOptions::set_buffer_hint,
+  /// which lets them return as soon as they are buffered, and the last one
+  /// flushes the whole batch. \a options apply to every message, except that
+  /// only the last one may be marked as the last message.
+  ///
+  /// \return \a true on success, \a false when the stream has been closed.
+  bool WriteBatch(const W* msgs, size_t count,
+                  grpc::WriteOptions options = grpc::WriteOptions()) {
+    for (size_t i = 0; i < count; i++) {
+      grpc::WriteOptions msg_options = options;
+      if (i + 1 < count) {
+        msg_options.set_buffer_hint().clear_last_message();
+      }
+      if (!Write(msgs[i], msg_options)) return false;
+    }
+    return true;
+  }
 };
 
 }  // namespace internal
@@ -668,6 +688,30 @@ class ServerWriter final : public ServerWriterInterface<W> {
     if (!ctx_->pending_ops_.SendMessagePtr(&msg, options).ok()) {
       return false;
     }
+    return PerformWrite(options);
+  }
+
+  /// EXPERIMENTAL
+  /// Writes \a msg as \a Write does, sharing its serialized bytes with the
+  /// other streams it is written to. \a msg may be destroyed as soon as this
+  /// returns.
+  bool Write(const experimental::PreserializedMessage<W>& msg,
+             grpc::WriteOptions options) {
+    if (options.is_last_message()) {
+      options.set_buffer_hint();
+    }
+    if (!ctx_->pending_ops_.SendMessage(msg, options).ok()) {
+      return false;
+    }
+    return PerformWrite(options);
+  }
+  bool Write(const experimental::PreserializedMessage<W>& msg) {
+    return Write(msg, grpc::WriteOptions());
+  }
+
+ private:
+  // Sends the message set on ctx_->pending_ops_.
+  bool PerformWrite(grpc::WriteOptions options) {
     if (!ctx_->sent_initial_metadata_) {
       ctx_->pending_ops_.SendInitialMetadata(&ctx_->initial_metadata_,
                                              ctx_->initial_metadata_flags());
@@ -688,7 +732,6 @@ class ServerWriter final : public ServerWriterInterface<W> {
     return call_->cq()->Pluck(&ctx_->pending_ops_);
   }
 
- private:
   grpc::internal::Call* const call_;
   grpc::ServerContext* const ctx_;
 
@@ -19,6 +19,7 @@
 #ifndef GRPCPP_OPENCENSUS_H
 #define GRPCPP_OPENCENSUS_H
 
+#include "absl/strings/string_view.h"
 #include "opencensus/trace/span.h"
 
 namespace grpc {
@@ -39,6 +40,18 @@ void RegisterOpenCensusPlugin();
 // ViewDescriptors below.
 void RegisterOpenCensusViewsForExport();
 
+// Sets the fraction, in [0, 1], of calls that are traced and have their full
+// per-call stats recorded. Calls that are part of a trace started upstream
+// follow that trace's sampling decision instead. The remaining calls skip the
+// plugin's per-call work and only count towards the
+// grpc.io/{client,server}/unsampled_rpcs measures. Defaults to 1. Like the
+// function below, this must be called before any RPCs are made.
+void SetOpenCensusSamplingRate(double rate);
+
+// Overrides the sampling rate for calls to \a method, given as
+// "package.Service/Method".
+void SetOpenCensusMethodSamplingRate(absl::string_view method, double rate);
+
 // Returns the tracing Span for the current RPC.
 ::opencensus::trace::Span GetSpanFromServerContext(ServerContext* context);
 
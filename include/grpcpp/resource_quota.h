@@ -21,6 +21,8 @@
 
 struct grpc_resource_quota;
 
+#include <stddef.h>
+
 #include <grpcpp/impl/codegen/config.h>
 #include <grpcpp/impl/codegen/grpc_library.h>
 
@@ -54,6 +56,32 @@ class ResourceQuota final : private grpc::GrpcLibraryCodegen {
   /// normal course.
   ResourceQuota& SetMaxThreads(int new_max_threads);
 
+  /// Memory currently in use by everything attached to this ResourceQuota, in
+  /// bytes, broken down by what it is used for.
+  struct MemoryUsage {
+    /// Call arenas.
+    size_t call_arenas = 0;
+    /// Buffers for data read from (or being encrypted for) connections.
+    size_t read_buffers = 0;
+    /// HPACK header compression tables.
+    size_t hpack_tables = 0;
+    /// Data handed to connections and not yet written out.
+    size_t pending_writes = 0;
+    /// Per connection transport state.
+    size_t transports = 0;
+    /// Messages and metadata buffered so that calls can be retried.
+    size_t retry_buffers = 0;
+    /// Responses cached by channels with a response cache.
+    size_t response_caches = 0;
+    /// Everything else.
+    size_t other = 0;
+  };
+
+  /// Get the current memory usage breakdown of this ResourceQuota. This walks
+  /// all of the users of the quota, so it is meant for occasional monitoring
+  /// (eg. to find out what fills up a quota), not for every request.
+  MemoryUsage GetMemoryUsage() const;
+
   grpc_resource_quota* c_resource_quota() const { return impl_; }
 
  private:
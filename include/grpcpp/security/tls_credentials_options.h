@@ -87,6 +87,12 @@ class TlsCredentialsOptions {
   // checks.
   void set_certificate_verifier(
       std::shared_ptr<CertificateVerifier> certificate_verifier);
+  // Caches successful results of the certificate verifier for |ttl_ms|
+  // milliseconds, keyed by the peer's certificate chain and the target name.
+  // The cache is shared by all handshakes using these options, and is cleared
+  // when the root certificates are updated. Disabled if |ttl_ms| is not
+  // positive, which is the default.
+  void set_verification_cache_ttl(int ttl_ms);
   // Sets the options of whether to check the hostname of the peer on a per-call
   // basis. This is usually used in a combination with virtual hosting at the
   // client side, where each individual call on a channel can have a different
@@ -336,6 +336,9 @@ class Server : public ServerInterface, private GrpcLibraryCodegen {
   // shutdown callback tag (invoked when the CQ is fully shutdown).
   std::atomic<CompletionQueue*> callback_cq_{nullptr};
 
+  // Value of GRPC_ARG_INLINE_CALLBACK_REACTIONS, applied to callback_cq_.
+  int inline_callback_reactions_ = 0;
+
   // List of CQs passed in by user that must be Shutdown only after Server is
   // Shutdown.  Even though this is only used with NDEBUG, instantiate it in all
   // cases since otherwise the size will be inconsistent.
@@ -24,6 +24,7 @@
 #include <climits>
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <grpc/compression.h>
@@ -74,6 +75,13 @@ class ExternalConnectionAcceptor {
   // If called before grpc::Server is started or after it is shut down, the new
   // connection will be closed.
   virtual void HandleNewConnection(NewConnectionParameters* p) = 0;
+  // Hands over \a count connections at once, which is cheaper than handing
+  // them over one at a time when many connections are accepted together.
+  // Same semantics as HandleNewConnection for each connection.
+  virtual void HandleNewConnections(NewConnectionParameters* connections,
+                                    size_t count) {
+    for (size_t i = 0; i < count; ++i) HandleNewConnection(&connections[i]);
+  }
 };
 
 }  // namespace experimental
@@ -218,6 +226,14 @@ class ServerBuilder {
   ServerBuilder& SetDefaultCompressionAlgorithm(
       grpc_compression_algorithm algorithm);
 
+  /// Set the zstd dictionaries of the server, in the format of zstd's
+  /// dictionary trainer. Incoming messages may be compressed with any of
+  /// them, and outgoing messages compressed with \a GRPC_COMPRESS_ZSTD use
+  /// the highest-id one the client also has. See
+  /// \a ChannelArguments::SetZstdCompressionDictionaries.
+  ServerBuilder& SetZstdCompressionDictionaries(
+      std::vector<std::string> dictionaries);
+
   /// Set the attached buffer pool for this server
   ServerBuilder& SetResourceQuota(const grpc::ResourceQuota& resource_quota);
 
@@ -282,6 +298,27 @@ class ServerBuilder {
         std::shared_ptr<experimental::AuthorizationPolicyProviderInterface>
             provider);
 
+    /// Limits the number of concurrent calls to each method, starting at
+    /// \a initial_limit and adapting the limit to the observed latency.
+    /// Calls beyond the limit fail with RESOURCE_EXHAUSTED. Individual methods
+    /// can be configured with the "concurrencyLimit" field of their method
+    /// config in \a service_config_json.
+    void SetAdaptiveConcurrencyLimit(
+        int initial_limit, const std::string& service_config_json = "");
+
+    /// Sends the metrics that handlers record with
+    /// ServerContextBase::ExperimentalGetCallMetricRecorder() to clients, as
+    /// an ORCA load report in each call's trailing metadata.
+    void EnableCallMetricRecording();
+
+    /// Runs the synchronous part of the server as \a shards shards (one per
+    /// CPU if \a shards is not positive). Shard i has its own completion
+    /// queue, a single poller, and threads pinned to CPU i, and serves the
+    /// connections accepted by its own SO_REUSEPORT listener, so that a
+    /// connection's calls are handled on one CPU. Overrides the NUM_CQS,
+    /// MIN_POLLERS and MAX_POLLERS sync server options. Linux only.
+    void EnableThreadPerCoreShards(int shards = 0);
+
    private:
     ServerBuilder* builder_;
   };
@@ -399,6 +436,7 @@ class ServerBuilder {
     grpc_compression_algorithm algorithm;
   } maybe_default_compression_algorithm_;
   uint32_t enabled_compression_algorithms_bitset_;
+  std::vector<std::string> zstd_compression_dictionaries_;
   std::vector<
       std::unique_ptr<grpc::experimental::ServerInterceptorFactoryInterface>>
       interceptor_creators_;
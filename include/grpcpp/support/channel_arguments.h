@@ -20,6 +20,7 @@
 #define GRPCPP_SUPPORT_CHANNEL_ARGUMENTS_H
 
 #include <list>
+#include <string>
 #include <vector>
 
 #include <grpc/compression.h>
@@ -64,6 +65,15 @@ class ChannelArguments {
   /// Set the compression algorithm for the channel.
   void SetCompressionAlgorithm(grpc_compression_algorithm algorithm);
 
+  /// Set the zstd dictionaries for the channel, in the format of zstd's
+  /// dictionary trainer. Messages compressed with \a GRPC_COMPRESS_ZSTD use
+  /// the highest-id dictionary the server also has, which compresses small
+  /// messages much better. Until the server's initial metadata says which
+  /// dictionaries it has, the channel assumes it has all of them, so servers
+  /// must get new dictionaries first. Needs gRPC built with zstd.
+  void SetZstdCompressionDictionaries(
+      const std::vector<std::string>& dictionaries);
+
   /// Set the grpclb fallback timeout (in ms) for the channel. If this amount
   /// of time has passed but we have not gotten any non-empty \a serverlist from
   /// the balancer, we will fall back to use the backend address(es) returned by
@@ -0,0 +1,237 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPCPP_SUPPORT_COROUTINE_H
+#define GRPCPP_SUPPORT_COROUTINE_H
+
+/// C++20 coroutine support on top of the callback API. Only available when
+/// the compiler supports coroutines; the rest of the library does not depend
+/// on it.
+///
+/// Client side, a unary call is awaited on its generated async stub:
+///
+///   Status status = co_await grpc::experimental::UnaryCall(
+///       stub->async(), &Service::Stub::async::Echo, &ctx, &req, &resp);
+///
+/// Server side, a callback method hands a coroutine to the library:
+///
+///   ServerUnaryReactor* Echo(CallbackServerContext* ctx,
+///                            const EchoRequest* req,
+///                            EchoResponse* resp) override {
+///     return grpc::experimental::StartUnaryCoroutine(
+///         ctx, EchoCoroutine(ctx, req, resp));
+///   }
+///   grpc::experimental::ServerUnaryCoroutine EchoCoroutine(
+///       CallbackServerContext* ctx, const EchoRequest* req,
+///       EchoResponse* resp) {
+///     ...
+///     co_return Status::OK;
+///   }
+///
+/// Awaited operations resume the coroutine on the thread that completes
+/// them, like callback reactions. Server coroutines that take the
+/// CallbackServerContext* as their first parameter have their frame
+/// allocated on the call arena.
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <utility>
+
+#include <grpcpp/impl/codegen/core_codegen_interface.h>
+#include <grpcpp/impl/codegen/server_callback.h>
+#include <grpcpp/impl/codegen/server_context.h>
+#include <grpcpp/impl/codegen/status.h>
+
+namespace grpc {
+
+class ClientContext;
+
+namespace experimental {
+
+/// Awaitable for a unary call started through a generated async stub. The
+/// awaiting expression yields the call's Status.
+template <class AsyncStub, class Request, class Response>
+class UnaryCallAwaiter {
+ public:
+  using Method = void (AsyncStub::*)(grpc::ClientContext*, const Request*,
+                                     Response*, std::function<void(Status)>);
+
+  UnaryCallAwaiter(AsyncStub* stub, Method method,
+                   grpc::ClientContext* context, const Request* request,
+                   Response* response)
+      : stub_(stub),
+        method_(method),
+        context_(context),
+        request_(request),
+        response_(response) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    // The callback captures two pointers, which std::function keeps without
+    // allocating. It may run before the call below returns, so nothing may
+    // touch this awaiter after starting the call.
+    (stub_->*method_)(context_, request_, response_,
+                      [this, handle](Status status) {
+                        status_ = std::move(status);
+                        handle.resume();
+                      });
+  }
+
+  Status await_resume() { return std::move(status_); }
+
+ private:
+  AsyncStub* const stub_;
+  const Method method_;
+  grpc::ClientContext* const context_;
+  const Request* const request_;
+  Response* const response_;
+  Status status_;
+};
+
+template <class AsyncStub, class Request, class Response>
+UnaryCallAwaiter<AsyncStub, Request, Response> UnaryCall(
+    AsyncStub* stub,
+    typename UnaryCallAwaiter<AsyncStub, Request, Response>::Method method,
+    grpc::ClientContext* context, const Request* request,
+    Response* response) {
+  return UnaryCallAwaiter<AsyncStub, Request, Response>(stub, method, context,
+                                                        request, response);
+}
+
+/// Return type of coroutines implementing a callback unary method. The
+/// coroutine starts once passed to StartUnaryCoroutine, and the Status it
+/// co_returns finishes the RPC.
+class ServerUnaryCoroutine {
+ public:
+  class promise_type {
+   public:
+    ServerUnaryCoroutine get_return_object() {
+      return ServerUnaryCoroutine(
+          std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    // The frame is gone before the RPC is finished: finishing may release
+    // the call, and with it the arena holding the frame, on another thread.
+    struct FinalAwaiter {
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(
+          std::coroutine_handle<promise_type> handle) noexcept {
+        ServerUnaryReactor* reactor = handle.promise().reactor_;
+        Status status = std::move(handle.promise().status_);
+        handle.destroy();
+        reactor->Finish(std::move(status));
+      }
+      void await_resume() const noexcept {}
+    };
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    void return_value(Status status) { status_ = std::move(status); }
+    void unhandled_exception() {
+      status_ = Status(StatusCode::UNKNOWN, "Unexpected error in RPC handling");
+    }
+
+    // Frames of coroutines whose first parameter, after the object for
+    // member functions, is the call's context live on the call arena.
+    template <class... Args>
+    static void* operator new(std::size_t size,
+                              grpc::CallbackServerContext* context,
+                              Args&... /*args*/) {
+      return Allocate(size, context->c_call());
+    }
+    template <class Self, class... Args>
+    static void* operator new(std::size_t size, Self& /*self*/,
+                              grpc::CallbackServerContext* context,
+                              Args&... /*args*/) {
+      return Allocate(size, context->c_call());
+    }
+    static void* operator new(std::size_t size) {
+      return Allocate(size, nullptr);
+    }
+    static void operator delete(void* p, std::size_t /*size*/) {
+      char* header = static_cast<char*>(p) - kHeaderSize;
+      // Arena memory is released with the call.
+      if (!*reinterpret_cast<bool*>(header)) {
+        ::operator delete(header);
+      }
+    }
+
+   private:
+    friend class ServerUnaryCoroutine;
+
+    // Records in front of the frame whether it came from the arena.
+    static constexpr std::size_t kHeaderSize = alignof(std::max_align_t);
+
+    static void* Allocate(std::size_t size, grpc_call* call) {
+      char* header =
+          call != nullptr
+              ? static_cast<char*>(
+                    g_core_codegen_interface->grpc_call_arena_alloc(
+                        call, kHeaderSize + size))
+              : static_cast<char*>(::operator new(kHeaderSize + size));
+      *reinterpret_cast<bool*>(header) = call != nullptr;
+      return header + kHeaderSize;
+    }
+
+    ServerUnaryReactor* reactor_ = nullptr;
+    Status status_;
+  };
+
+  ServerUnaryCoroutine(ServerUnaryCoroutine&& other) noexcept
+      : handle_(std::exchange(other.handle_, nullptr)) {}
+  ServerUnaryCoroutine& operator=(ServerUnaryCoroutine&&) = delete;
+  ~ServerUnaryCoroutine() {
+    if (handle_) handle_.destroy();
+  }
+
+ private:
+  friend ServerUnaryReactor* StartUnaryCoroutine(
+      grpc::CallbackServerContext* context, ServerUnaryCoroutine coroutine);
+
+  explicit ServerUnaryCoroutine(std::coroutine_handle<promise_type> handle)
+      : handle_(handle) {}
+
+  ServerUnaryReactor* Start(grpc::CallbackServerContext* context) {
+    ServerUnaryReactor* reactor = context->DefaultReactor();
+    auto handle = std::exchange(handle_, nullptr);
+    handle.promise().reactor_ = reactor;
+    handle.resume();
+    return reactor;
+  }
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+/// Runs \a coroutine until its first suspension and returns the reactor
+/// that its co_return finishes.
+inline ServerUnaryReactor* StartUnaryCoroutine(
+    grpc::CallbackServerContext* context, ServerUnaryCoroutine coroutine) {
+  return coroutine.Start(context);
+}
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#endif  // GRPCPP_SUPPORT_COROUTINE_H
@@ -39,6 +39,22 @@ inline bool ServerOnlyStreaming(const grpc_generator::Method* method) {
   return !method->ClientStreaming() && method->ServerStreaming();
 }
 
+// Returns the name of the ::grpc::internal::RpcMethod::RpcType of a method.
+const char* RpcTypeName(const grpc_generator::Method* method) {
+  if (method->NoStreaming()) {
+    // NOTE: There is no reason to consider streamed-unary as a separate
+    // category here since this is how the method appears on the wire, and
+    // that is a NORMAL_RPC.
+    return "NORMAL_RPC";
+  } else if (ClientOnlyStreaming(method)) {
+    return "CLIENT_STREAMING";
+  } else if (ServerOnlyStreaming(method)) {
+    return "SERVER_STREAMING";
+  } else {
+    return "BIDI_STREAMING";
+  }
+}
+
 std::string FilenameIdentifier(const std::string& filename) {
   std::string result;
   for (unsigned i = 0; i < filename.size(); i++) {
@@ -135,6 +151,21 @@ std::string GetHeaderIncludes(grpc_generator::File* file,
       PrintIncludes(printer.get(), params.additional_header_includes, false,
                     "");
     }
+    static const char* lite_headers_strs[] = {
+        "functional",
+        "grpcpp/impl/codegen/client_callback.h",
+        "grpcpp/impl/codegen/client_context.h",
+        "grpcpp/impl/codegen/message_allocator.h",
+        "grpcpp/impl/codegen/proto_utils.h",
+        "grpcpp/impl/codegen/rpc_method.h",
+        "grpcpp/impl/codegen/rpc_service_method.h",
+        "grpcpp/impl/codegen/server_callback.h",
+        "grpcpp/impl/codegen/server_callback_handlers.h",
+        "grpcpp/impl/codegen/server_context.h",
+        "grpcpp/impl/codegen/service_type.h",
+        "grpcpp/impl/codegen/status.h",
+        "grpcpp/impl/codegen/stub_options.h",
+    };
     static const char* headers_strs[] = {
         "functional",
         "grpcpp/impl/codegen/async_generic_service.h",
@@ -155,7 +186,14 @@ std::string GetHeaderIncludes(grpc_generator::File* file,
         "grpcpp/impl/codegen/stub_options.h",
         "grpcpp/impl/codegen/sync_stream.h",
     };
-    std::vector<std::string> headers(headers_strs, array_end(headers_strs));
+    std::vector<std::string> headers =
+        params.lite_callback_only
+            ? std::vector<std::string>(lite_headers_strs,
+                                       array_end(lite_headers_strs))
+            : std::vector<std::string>(headers_strs, array_end(headers_strs));
+    if (params.upb_messages) {
+      headers.insert(headers.begin() + 1, "grpcpp/ext/upb_message.h");
+    }
     PrintIncludes(printer.get(), headers, params.use_system_headers,
                   params.grpc_search_path);
     printer->Print(vars, "\n");
@@ -982,6 +1020,7 @@ void PrintHeaderServerMethodCallback(grpc_generator::Printer* printer,
   printer->Indent();
   printer->Print(*vars, "WithCallbackMethod_$Method$() {\n");
   if (method->NoStreaming()) {
+    (*vars)["CallbackHandler"] = "CallbackUnaryHandler";
     printer->Print(
         *vars,
         "  ::grpc::Service::MarkMethodCallback($Idx$,\n"
@@ -993,16 +1032,8 @@ void PrintHeaderServerMethodCallback(grpc_generator::Printer* printer,
         "request, "
         "$RealResponse$* response) { "
         "return this->$Method$(context, request, response); }));}\n");
-    printer->Print(*vars,
-                   "void SetMessageAllocatorFor_$Method$(\n"
-                   "    ::grpc::MessageAllocator< "
-                   "$RealRequest$, $RealResponse$>* allocator) {\n"
-                   "  ::grpc::internal::MethodHandler* const handler = "
-                   "::grpc::Service::GetHandler($Idx$);\n"
-                   "  static_cast<::grpc::internal::CallbackUnaryHandler< "
-                   "$RealRequest$, $RealResponse$>*>(handler)\n"
-                   "          ->SetMessageAllocator(allocator);\n");
   } else if (ClientOnlyStreaming(method)) {
+    (*vars)["CallbackHandler"] = "CallbackClientStreamingHandler";
     printer->Print(
         *vars,
         "  ::grpc::Service::MarkMethodCallback($Idx$,\n"
@@ -1012,8 +1043,9 @@ void PrintHeaderServerMethodCallback(grpc_generator::Printer* printer,
         "               ::grpc::CallbackServerContext* context, "
         "$RealResponse$* "
         "response) { "
-        "return this->$Method$(context, response); }));\n");
+        "return this->$Method$(context, response); }));}\n");
   } else if (ServerOnlyStreaming(method)) {
+    (*vars)["CallbackHandler"] = "CallbackServerStreamingHandler";
     printer->Print(
         *vars,
         "  ::grpc::Service::MarkMethodCallback($Idx$,\n"
@@ -1023,16 +1055,26 @@ void PrintHeaderServerMethodCallback(grpc_generator::Printer* printer,
         "               ::grpc::CallbackServerContext* context, "
         "const $RealRequest$* "
         "request) { "
-        "return this->$Method$(context, request); }));\n");
+        "return this->$Method$(context, request); }));}\n");
   } else if (method->BidiStreaming()) {
+    (*vars)["CallbackHandler"] = "CallbackBidiHandler";
     printer->Print(*vars,
                    "  ::grpc::Service::MarkMethodCallback($Idx$,\n"
                    "      new ::grpc::internal::CallbackBidiHandler< "
                    "$RealRequest$, $RealResponse$>(\n"
                    "        [this](\n"
                    "               ::grpc::CallbackServerContext* context) "
-                   "{ return this->$Method$(context); }));\n");
+                   "{ return this->$Method$(context); }));}\n");
   }
+  printer->Print(*vars,
+                 "void SetMessageAllocatorFor_$Method$(\n"
+                 "    ::grpc::MessageAllocator< "
+                 "$RealRequest$, $RealResponse$>* allocator) {\n"
+                 "  ::grpc::internal::MethodHandler* const handler = "
+                 "::grpc::Service::GetHandler($Idx$);\n"
+                 "  static_cast<::grpc::internal::$CallbackHandler$< "
+                 "$RealRequest$, $RealResponse$>*>(handler)\n"
+                 "          ->SetMessageAllocator(allocator);\n");
   printer->Print(*vars, "}\n");
   printer->Print(*vars,
                  "~WithCallbackMethod_$Method$() override {\n"
@@ -1552,6 +1594,211 @@ void PrintHeaderService(grpc_generator::Printer* printer,
   printer->Print(service->GetTrailingComments("//").c_str());
 }
 
+// Prints a service for lite_callback_only: a non-virtual callback stub, and a
+// CRTP service template whose handlers call the implementation's methods
+// directly instead of through a vtable.
+void PrintHeaderServiceLite(grpc_generator::Printer* printer,
+                            const grpc_generator::Service* service,
+                            std::map<std::string, std::string>* vars) {
+  (*vars)["Service"] = service->name();
+
+  printer->Print(service->GetLeadingComments("//").c_str());
+  printer->Print(*vars,
+                 "class $Service$ final {\n"
+                 " public:\n");
+  printer->Indent();
+
+  // Service metadata
+  printer->Print(*vars,
+                 "static constexpr char const* service_full_name() {\n"
+                 "  return \"$Package$$Service$\";\n"
+                 "}\n");
+  for (int i = 0; i < service->method_count(); ++i) {
+    (*vars)["Method"] = service->method(i)->name();
+    printer->Print(*vars,
+                   "static constexpr char const* $Method$_method_path() {\n"
+                   "  return \"/$Package$$Service$/$Method$\";\n"
+                   "}\n");
+  }
+
+  // Client side
+  printer->Print(
+      "class Stub final {\n"
+      " public:\n");
+  printer->Indent();
+  printer->Print(
+      "Stub(const std::shared_ptr< ::grpc::ChannelInterface>& "
+      "channel, const ::grpc::StubOptions& options = "
+      "::grpc::StubOptions());\n");
+  for (int i = 0; i < service->method_count(); ++i) {
+    auto method = service->method(i);
+    (*vars)["Method"] = method->name();
+    (*vars)["Request"] = method->input_type_name();
+    (*vars)["Response"] = method->output_type_name();
+    printer->Print(method->GetLeadingComments("//").c_str());
+    if (method->NoStreaming()) {
+      printer->Print(*vars,
+                     "void $Method$(::grpc::ClientContext* context, "
+                     "const $Request$* request, $Response$* response, "
+                     "std::function<void(::grpc::Status)>);\n");
+      printer->Print(*vars,
+                     "void $Method$(::grpc::ClientContext* context, "
+                     "const $Request$* request, $Response$* response, "
+                     "::grpc::ClientUnaryReactor* reactor);\n");
+    } else if (ClientOnlyStreaming(method.get())) {
+      printer->Print(*vars,
+                     "void $Method$(::grpc::ClientContext* context, "
+                     "$Response$* response, "
+                     "::grpc::ClientWriteReactor< $Request$>* reactor);\n");
+    } else if (ServerOnlyStreaming(method.get())) {
+      printer->Print(*vars,
+                     "void $Method$(::grpc::ClientContext* context, "
+                     "const $Request$* request, "
+                     "::grpc::ClientReadReactor< $Response$>* reactor);\n");
+    } else if (method->BidiStreaming()) {
+      printer->Print(*vars,
+                     "void $Method$(::grpc::ClientContext* context, "
+                     "::grpc::ClientBidiReactor< "
+                     "$Request$,$Response$>* reactor);\n");
+    }
+    printer->Print(method->GetTrailingComments("//").c_str());
+  }
+  // Lets code written against the full stub's async() keep compiling.
+  printer->Print("Stub* async() { return this; }\n");
+  printer->Outdent();
+  printer->Print("\n private:\n");
+  printer->Indent();
+  printer->Print("std::shared_ptr< ::grpc::ChannelInterface> channel_;\n");
+  for (int i = 0; i < service->method_count(); ++i) {
+    PrintHeaderClientMethodData(printer, service->method(i).get(), vars);
+  }
+  printer->Outdent();
+  printer->Print("};\n");
+  printer->Print(
+      "static std::unique_ptr<Stub> NewStub(const std::shared_ptr< "
+      "::grpc::ChannelInterface>& channel, "
+      "const ::grpc::StubOptions& options = ::grpc::StubOptions());\n");
+
+  printer->Print("\n");
+
+  // Server side. Impl derives from CallbackService<Impl> and hides the
+  // methods it implements; the others reply UNIMPLEMENTED.
+  printer->Print(
+      "template <class Impl>\n"
+      "class CallbackService : public ::grpc::Service {\n"
+      " public:\n");
+  printer->Indent();
+  printer->Print("CallbackService() {\n");
+  printer->Indent();
+  for (int i = 0; i < service->method_count(); ++i) {
+    auto method = service->method(i);
+    (*vars)["Idx"] = as_string(i);
+    (*vars)["Method"] = method->name();
+    (*vars)["Request"] = method->input_type_name();
+    (*vars)["Response"] = method->output_type_name();
+    (*vars)["StreamingType"] = RpcTypeName(method.get());
+    printer->Print(*vars,
+                   "AddMethod(new ::grpc::internal::RpcServiceMethod(\n"
+                   "    $Method$_method_path(),\n"
+                   "    ::grpc::internal::RpcMethod::$StreamingType$,\n"
+                   "    nullptr));\n");
+    if (method->NoStreaming()) {
+      printer->Print(
+          *vars,
+          "::grpc::Service::MarkMethodCallback($Idx$,\n"
+          "    new ::grpc::internal::CallbackUnaryHandler< "
+          "$Request$, $Response$>(\n"
+          "      [this](::grpc::CallbackServerContext* context, "
+          "const $Request$* request, $Response$* response) {\n"
+          "        return static_cast<Impl*>(this)->$Method$(context, "
+          "request, response);\n"
+          "      }));\n");
+    } else if (ClientOnlyStreaming(method.get())) {
+      printer->Print(
+          *vars,
+          "::grpc::Service::MarkMethodCallback($Idx$,\n"
+          "    new ::grpc::internal::CallbackClientStreamingHandler< "
+          "$Request$, $Response$>(\n"
+          "      [this](::grpc::CallbackServerContext* context, "
+          "$Response$* response) {\n"
+          "        return static_cast<Impl*>(this)->$Method$(context, "
+          "response);\n"
+          "      }));\n");
+    } else if (ServerOnlyStreaming(method.get())) {
+      printer->Print(
+          *vars,
+          "::grpc::Service::MarkMethodCallback($Idx$,\n"
+          "    new ::grpc::internal::CallbackServerStreamingHandler< "
+          "$Request$, $Response$>(\n"
+          "      [this](::grpc::CallbackServerContext* context, "
+          "const $Request$* request) {\n"
+          "        return static_cast<Impl*>(this)->$Method$(context, "
+          "request);\n"
+          "      }));\n");
+    } else if (method->BidiStreaming()) {
+      printer->Print(
+          *vars,
+          "::grpc::Service::MarkMethodCallback($Idx$,\n"
+          "    new ::grpc::internal::CallbackBidiHandler< "
+          "$Request$, $Response$>(\n"
+          "      [this](::grpc::CallbackServerContext* context) {\n"
+          "        return static_cast<Impl*>(this)->$Method$(context);\n"
+          "      }));\n");
+    }
+  }
+  printer->Outdent();
+  printer->Print("}\n");
+  for (int i = 0; i < service->method_count(); ++i) {
+    auto method = service->method(i);
+    (*vars)["Idx"] = as_string(i);
+    (*vars)["Method"] = method->name();
+    (*vars)["Request"] = method->input_type_name();
+    (*vars)["Response"] = method->output_type_name();
+    if (method->NoStreaming()) {
+      printer->Print(*vars,
+                     "void SetMessageAllocatorFor_$Method$(\n"
+                     "    ::grpc::MessageAllocator< "
+                     "$Request$, $Response$>* allocator) {\n"
+                     "  ::grpc::internal::MethodHandler* const handler = "
+                     "::grpc::Service::GetHandler($Idx$);\n"
+                     "  static_cast<::grpc::internal::CallbackUnaryHandler< "
+                     "$Request$, $Response$>*>(handler)\n"
+                     "          ->SetMessageAllocator(allocator);\n"
+                     "}\n");
+      printer->Print(*vars,
+                     "::grpc::ServerUnaryReactor* $Method$(\n"
+                     "  ::grpc::CallbackServerContext* /*context*/, "
+                     "const $Request$* /*request*/, "
+                     "$Response$* /*response*/)"
+                     "  { return nullptr; }\n");
+    } else if (ClientOnlyStreaming(method.get())) {
+      printer->Print(*vars,
+                     "::grpc::ServerReadReactor< $Request$>* $Method$(\n"
+                     "  ::grpc::CallbackServerContext* "
+                     "/*context*/, $Response$* /*response*/)"
+                     "  { return nullptr; }\n");
+    } else if (ServerOnlyStreaming(method.get())) {
+      printer->Print(*vars,
+                     "::grpc::ServerWriteReactor< $Response$>* $Method$(\n"
+                     "  ::grpc::CallbackServerContext* "
+                     "/*context*/, const $Request$* /*request*/)"
+                     "  { return nullptr; }\n");
+    } else if (method->BidiStreaming()) {
+      printer->Print(
+          *vars,
+          "::grpc::ServerBidiReactor< $Request$, $Response$>* $Method$(\n"
+          "  ::grpc::CallbackServerContext* /*context*/)\n"
+          "  { return nullptr; }\n");
+    }
+  }
+  printer->Outdent();
+  printer->Print("};\n");
+
+  printer->Outdent();
+  printer->Print("};\n");
+  printer->Print(service->GetTrailingComments("//").c_str());
+}
+
 std::string GetHeaderServices(grpc_generator::File* file,
                               const Parameters& params) {
   std::string output;
@@ -1572,7 +1819,11 @@ std::string GetHeaderServices(grpc_generator::File* file,
     }
 
     for (int i = 0; i < file->service_count(); ++i) {
-      PrintHeaderService(printer.get(), file->service(i).get(), &vars);
+      if (params.lite_callback_only) {
+        PrintHeaderServiceLite(printer.get(), file->service(i).get(), &vars);
+      } else {
+        PrintHeaderService(printer.get(), file->service(i).get(), &vars);
+      }
       printer->Print("\n");
     }
 
@@ -1646,6 +1897,9 @@ std::string GetSourceIncludes(grpc_generator::File* file,
     // Scope the output stream so it closes and finalizes output to the string.
     auto printer = file->CreatePrinter(&output);
     std::map<std::string, std::string> vars;
+    static const char* lite_headers_strs[] = {
+        "functional", "grpcpp/impl/codegen/channel_interface.h",
+        "grpcpp/impl/codegen/client_callback.h"};
     static const char* headers_strs[] = {
         "functional",
         "grpcpp/impl/codegen/async_stream.h",
@@ -1661,7 +1915,11 @@ std::string GetSourceIncludes(grpc_generator::File* file,
         "grpcpp/impl/codegen/server_context.h",
         "grpcpp/impl/codegen/service_type.h",
         "grpcpp/impl/codegen/sync_stream.h"};
-    std::vector<std::string> headers(headers_strs, array_end(headers_strs));
+    std::vector<std::string> headers =
+        params.lite_callback_only
+            ? std::vector<std::string>(lite_headers_strs,
+                                       array_end(lite_headers_strs))
+            : std::vector<std::string>(headers_strs, array_end(headers_strs));
     PrintIncludes(printer.get(), headers, params.use_system_headers,
                   params.grpc_search_path);
 
@@ -1985,18 +2243,7 @@ void PrintSourceService(grpc_generator::Printer* printer,
     auto method = service->method(i);
     (*vars)["Method"] = method->name();
     (*vars)["Idx"] = as_string(i);
-    if (method->NoStreaming()) {
-      (*vars)["StreamingType"] = "NORMAL_RPC";
-      // NOTE: There is no reason to consider streamed-unary as a separate
-      // category here since this part is setting up the client-side stub
-      // and this appears as a NORMAL_RPC from the client-side.
-    } else if (ClientOnlyStreaming(method.get())) {
-      (*vars)["StreamingType"] = "CLIENT_STREAMING";
-    } else if (ServerOnlyStreaming(method.get())) {
-      (*vars)["StreamingType"] = "SERVER_STREAMING";
-    } else {
-      (*vars)["StreamingType"] = "BIDI_STREAMING";
-    }
+    (*vars)["StreamingType"] = RpcTypeName(method.get());
     printer->Print(
         *vars,
         ", rpcmethod_$Method$_("
@@ -2090,6 +2337,111 @@ void PrintSourceService(grpc_generator::Printer* printer,
   }
 }
 
+void PrintSourceServiceLite(grpc_generator::Printer* printer,
+                            const grpc_generator::Service* service,
+                            std::map<std::string, std::string>* vars) {
+  (*vars)["Service"] = service->name();
+
+  printer->Print(*vars,
+                 "std::unique_ptr< $ns$$Service$::Stub> $ns$$Service$::NewStub("
+                 "const std::shared_ptr< ::grpc::ChannelInterface>& channel, "
+                 "const ::grpc::StubOptions& options) {\n"
+                 "  (void)options;\n"
+                 "  std::unique_ptr< $ns$$Service$::Stub> stub(new "
+                 "$ns$$Service$::Stub(channel, options));\n"
+                 "  return stub;\n"
+                 "}\n\n");
+  printer->Print(*vars,
+                 "$ns$$Service$::Stub::Stub(const std::shared_ptr< "
+                 "::grpc::ChannelInterface>& channel, const "
+                 "::grpc::StubOptions& options)\n");
+  printer->Indent();
+  printer->Print(": channel_(channel)");
+  for (int i = 0; i < service->method_count(); ++i) {
+    auto method = service->method(i);
+    (*vars)["Method"] = method->name();
+    (*vars)["StreamingType"] = RpcTypeName(method.get());
+    printer->Print(*vars,
+                   ", rpcmethod_$Method$_("
+                   "$ns$$Service$::$Method$_method_path(), "
+                   "options.suffix_for_stats(),"
+                   "::grpc::internal::RpcMethod::$StreamingType$, "
+                   "channel"
+                   ")\n");
+  }
+  printer->Print("{}\n\n");
+  printer->Outdent();
+
+  for (int i = 0; i < service->method_count(); ++i) {
+    auto method = service->method(i);
+    (*vars)["Method"] = method->name();
+    (*vars)["Request"] = method->input_type_name();
+    (*vars)["Response"] = method->output_type_name();
+    if (method->NoStreaming()) {
+      printer->Print(*vars,
+                     "void $ns$$Service$::Stub::$Method$("
+                     "::grpc::ClientContext* context, "
+                     "const $Request$* request, $Response$* response, "
+                     "std::function<void(::grpc::Status)> f) {\n");
+      printer->Print(*vars,
+                     "  ::grpc::internal::CallbackUnaryCall"
+                     "< $Request$, $Response$, ::grpc::protobuf::MessageLite, "
+                     "::grpc::protobuf::MessageLite>"
+                     "(channel_.get(), rpcmethod_$Method$_, "
+                     "context, request, response, std::move(f));\n}\n\n");
+      printer->Print(*vars,
+                     "void $ns$$Service$::Stub::$Method$("
+                     "::grpc::ClientContext* context, "
+                     "const $Request$* request, $Response$* response, "
+                     "::grpc::ClientUnaryReactor* reactor) {\n");
+      printer->Print(*vars,
+                     "  ::grpc::internal::ClientCallbackUnaryFactory::Create"
+                     "< ::grpc::protobuf::MessageLite, "
+                     "::grpc::protobuf::MessageLite>"
+                     "(channel_.get(), rpcmethod_$Method$_, "
+                     "context, request, response, reactor);\n}\n\n");
+    } else if (ClientOnlyStreaming(method.get())) {
+      printer->Print(*vars,
+                     "void $ns$$Service$::Stub::$Method$("
+                     "::grpc::ClientContext* context, $Response$* response, "
+                     "::grpc::ClientWriteReactor< $Request$>* reactor) {\n");
+      printer->Print(*vars,
+                     "  ::grpc::internal::ClientCallbackWriterFactory< "
+                     "$Request$>::Create("
+                     "channel_.get(), "
+                     "rpcmethod_$Method$_, "
+                     "context, response, reactor);\n"
+                     "}\n\n");
+    } else if (ServerOnlyStreaming(method.get())) {
+      printer->Print(*vars,
+                     "void $ns$$Service$::Stub::$Method$("
+                     "::grpc::ClientContext* context, "
+                     "const $Request$* request, "
+                     "::grpc::ClientReadReactor< $Response$>* reactor) {\n");
+      printer->Print(*vars,
+                     "  ::grpc::internal::ClientCallbackReaderFactory< "
+                     "$Response$>::Create("
+                     "channel_.get(), "
+                     "rpcmethod_$Method$_, "
+                     "context, request, reactor);\n"
+                     "}\n\n");
+    } else if (method->BidiStreaming()) {
+      printer->Print(*vars,
+                     "void $ns$$Service$::Stub::$Method$("
+                     "::grpc::ClientContext* context, "
+                     "::grpc::ClientBidiReactor< $Request$,$Response$>* "
+                     "reactor) {\n");
+      printer->Print(*vars,
+                     "  ::grpc::internal::ClientCallbackReaderWriterFactory< "
+                     "$Request$,$Response$>::Create("
+                     "channel_.get(), "
+                     "rpcmethod_$Method$_, "
+                     "context, reactor);\n"
+                     "}\n\n");
+    }
+  }
+}
+
 std::string GetSourceServices(grpc_generator::File* file,
                               const Parameters& params) {
   std::string output;
@@ -2112,7 +2464,11 @@ std::string GetSourceServices(grpc_generator::File* file,
     }
 
     for (int i = 0; i < file->service_count(); ++i) {
-      PrintSourceService(printer.get(), file->service(i).get(), &vars);
+      if (params.lite_callback_only) {
+        PrintSourceServiceLite(printer.get(), file->service(i).get(), &vars);
+      } else {
+        PrintSourceService(printer.get(), file->service(i).get(), &vars);
+      }
       printer->Print("\n");
     }
   }
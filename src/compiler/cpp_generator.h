@@ -64,6 +64,14 @@ struct Parameters {
   std::string message_header_extension;
   // Whether to include headers corresponding to imports in source file.
   bool include_import_headers;
+  // Generate only the callback API: a stub without virtual methods, and a
+  // callback service template whose handlers call the implementation's
+  // methods without virtual dispatch.
+  bool lite_callback_only;
+  // Use upb messages (grpc::experimental::UpbMessage) rather than protobuf
+  // classes as request and response types. The default message header
+  // extension becomes ".upb.h".
+  bool upb_messages;
 };
 
 // Return the prologue of the generated header file.
@@ -51,6 +51,15 @@ inline std::string ClassName(const grpc::protobuf::Descriptor* descriptor,
   }
 }
 
+// The type of a message in code generated on upb messages: the upb message
+// type, named after the full name of the message, with its mini table.
+inline std::string UpbMessageClassName(
+    const grpc::protobuf::Descriptor* descriptor) {
+  const std::string upb_name = DotsToUnderscores(descriptor->full_name());
+  return "::grpc::experimental::UpbMessage<" + upb_name + ", &" + upb_name +
+         "_msginit>";
+}
+
 // Get leading or trailing comments in a string. Comment lines start with "// ".
 // Leading detached comments are put in front of leading comments.
 template <typename DescriptorType>
@@ -53,8 +53,8 @@ class CppGrpcGenerator : public grpc::protobuf::compiler::CodeGenerator {
     generator_parameters.use_system_headers = true;
     generator_parameters.generate_mock_code = false;
     generator_parameters.include_import_headers = false;
-
-    ProtoBufFile pbfile(file);
+    generator_parameters.lite_callback_only = false;
+    generator_parameters.upb_messages = false;
 
     if (!parameter.empty()) {
       std::vector<std::string> parameters_list =
@@ -97,6 +97,20 @@ class CppGrpcGenerator : public grpc::protobuf::compiler::CodeGenerator {
             *error = std::string("Invalid parameter: ") + *parameter_string;
             return false;
           }
+        } else if (param[0] == "lite_callback_only") {
+          if (param[1] == "true") {
+            generator_parameters.lite_callback_only = true;
+          } else if (param[1] != "false") {
+            *error = std::string("Invalid parameter: ") + *parameter_string;
+            return false;
+          }
+        } else if (param[0] == "upb_messages") {
+          if (param[1] == "true") {
+            generator_parameters.upb_messages = true;
+          } else if (param[1] != "false") {
+            *error = std::string("Invalid parameter: ") + *parameter_string;
+            return false;
+          }
         } else {
           *error = std::string("Unknown parameter: ") + *parameter_string;
           return false;
@@ -104,6 +118,21 @@ class CppGrpcGenerator : public grpc::protobuf::compiler::CodeGenerator {
       }
     }
 
+    if (generator_parameters.lite_callback_only &&
+        generator_parameters.generate_mock_code) {
+      *error =
+          "generate_mock_code is not supported with lite_callback_only, "
+          "whose stubs have no virtual methods to mock.";
+      return false;
+    }
+
+    if (generator_parameters.upb_messages &&
+        generator_parameters.message_header_extension.empty()) {
+      generator_parameters.message_header_extension = ".upb.h";
+    }
+
+    ProtoBufFile pbfile(file, generator_parameters.upb_messages);
+
     std::string file_name = grpc_generator::StripProto(file->name());
 
     std::string header_code =
@@ -36,16 +36,21 @@ inline std::string GetCommentsHelper(const DescriptorType* desc, bool leading,
 
 class ProtoBufMethod : public grpc_generator::Method {
  public:
-  ProtoBufMethod(const grpc::protobuf::MethodDescriptor* method)
-      : method_(method) {}
+  ProtoBufMethod(const grpc::protobuf::MethodDescriptor* method,
+                 bool upb_messages = false)
+      : method_(method), upb_messages_(upb_messages) {}
 
   std::string name() const { return method_->name(); }
 
   std::string input_type_name() const {
-    return grpc_cpp_generator::ClassName(method_->input_type(), true);
+    return upb_messages_
+               ? grpc_cpp_generator::UpbMessageClassName(method_->input_type())
+               : grpc_cpp_generator::ClassName(method_->input_type(), true);
   }
   std::string output_type_name() const {
-    return grpc_cpp_generator::ClassName(method_->output_type(), true);
+    return upb_messages_
+               ? grpc_cpp_generator::UpbMessageClassName(method_->output_type())
+               : grpc_cpp_generator::ClassName(method_->output_type(), true);
   }
 
   std::string get_input_type_name() const {
@@ -100,19 +105,22 @@ class ProtoBufMethod : public grpc_generator::Method {
 
  private:
   const grpc::protobuf::MethodDescriptor* method_;
+  // Whether message types are upb messages rather than protobuf classes.
+  const bool upb_messages_;
 };
 
 class ProtoBufService : public grpc_generator::Service {
  public:
-  ProtoBufService(const grpc::protobuf::ServiceDescriptor* service)
-      : service_(service) {}
+  ProtoBufService(const grpc::protobuf::ServiceDescriptor* service,
+                  bool upb_messages = false)
+      : service_(service), upb_messages_(upb_messages) {}
 
   std::string name() const { return service_->name(); }
 
   int method_count() const { return service_->method_count(); }
   std::unique_ptr<const grpc_generator::Method> method(int i) const {
     return std::unique_ptr<const grpc_generator::Method>(
-        new ProtoBufMethod(service_->method(i)));
+        new ProtoBufMethod(service_->method(i), upb_messages_));
   }
 
   std::string GetLeadingComments(const std::string prefix) const {
@@ -129,6 +137,7 @@ class ProtoBufService : public grpc_generator::Service {
 
  private:
   const grpc::protobuf::ServiceDescriptor* service_;
+  const bool upb_messages_;
 };
 
 class ProtoBufPrinter : public grpc_generator::Printer {
@@ -153,7 +162,9 @@ class ProtoBufPrinter : public grpc_generator::Printer {
 
 class ProtoBufFile : public grpc_generator::File {
  public:
-  ProtoBufFile(const grpc::protobuf::FileDescriptor* file) : file_(file) {}
+  ProtoBufFile(const grpc::protobuf::FileDescriptor* file,
+               bool upb_messages = false)
+      : file_(file), upb_messages_(upb_messages) {}
 
   std::string filename() const { return file_->name(); }
   std::string filename_without_ext() const {
@@ -170,7 +181,7 @@ class ProtoBufFile : public grpc_generator::File {
   int service_count() const { return file_->service_count(); }
   std::unique_ptr<const grpc_generator::Service> service(int i) const {
     return std::unique_ptr<const grpc_generator::Service>(
-        new ProtoBufService(file_->service(i)));
+        new ProtoBufService(file_->service(i), upb_messages_));
   }
 
   std::unique_ptr<grpc_generator::Printer> CreatePrinter(
@@ -201,6 +212,7 @@ class ProtoBufFile : public grpc_generator::File {
 
  private:
   const grpc::protobuf::FileDescriptor* file_;
+  const bool upb_messages_;
 };
 
 #endif  // GRPC_INTERNAL_COMPILER_PROTOBUF_PLUGIN_H
@@ -0,0 +1,122 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/backend_metrics/backend_metric_filter.h"
+
+#include <utility>
+
+#include "upb/upb.h"
+#include "upb/upb.hpp"
+#include "xds/data/orca/v3/orca_load_report.upb.h"
+
+#include <grpc/impl/codegen/grpc_types.h>
+
+#include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/channel/context.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/promise/context.h"
+#include "src/core/lib/promise/map.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "src/core/lib/surface/channel_stack_type.h"
+#include "src/core/lib/transport/metadata_batch.h"
+
+namespace grpc_core {
+
+absl::optional<std::string> SerializeBackendMetricData(
+    const BackendMetricData& data) {
+  upb::Arena arena;
+  xds_data_orca_v3_OrcaLoadReport* report =
+      xds_data_orca_v3_OrcaLoadReport_new(arena.ptr());
+  bool has_data = false;
+  if (data.cpu_utilization >= 0) {
+    xds_data_orca_v3_OrcaLoadReport_set_cpu_utilization(report,
+                                                        data.cpu_utilization);
+    has_data = true;
+  }
+  if (data.mem_utilization >= 0) {
+    xds_data_orca_v3_OrcaLoadReport_set_mem_utilization(report,
+                                                        data.mem_utilization);
+    has_data = true;
+  }
+  for (const auto& p : data.request_cost) {
+    xds_data_orca_v3_OrcaLoadReport_request_cost_set(
+        report, upb_StringView_FromDataAndSize(p.first.data(), p.first.size()),
+        p.second, arena.ptr());
+    has_data = true;
+  }
+  for (const auto& p : data.utilization) {
+    xds_data_orca_v3_OrcaLoadReport_utilization_set(
+        report, upb_StringView_FromDataAndSize(p.first.data(), p.first.size()),
+        p.second, arena.ptr());
+    has_data = true;
+  }
+  if (!has_data) return absl::nullopt;
+  size_t length;
+  char* serialized =
+      xds_data_orca_v3_OrcaLoadReport_serialize(report, arena.ptr(), &length);
+  if (serialized == nullptr) return absl::nullopt;
+  return std::string(serialized, length);
+}
+
+absl::StatusOr<BackendMetricFilter> BackendMetricFilter::Create(
+    ChannelArgs, ChannelFilter::Args) {
+  return BackendMetricFilter();
+}
+
+ArenaPromise<ServerMetadataHandle> BackendMetricFilter::MakeCallPromise(
+    CallArgs call_args, NextPromiseFactory next_promise_factory) {
+  // The application sets the provider once the call has started, so only
+  // look for it when the trailing metadata goes out.
+  grpc_call_context_element* context = GetContext<grpc_call_context_element>();
+  return Map(next_promise_factory(std::move(call_args)),
+             [context](ServerMetadataHandle trailing_metadata) {
+               auto* provider = static_cast<BackendMetricProvider*>(
+                   context[GRPC_CONTEXT_BACKEND_METRIC_PROVIDER].value);
+               if (provider == nullptr) return trailing_metadata;
+               absl::optional<std::string> serialized =
+                   SerializeBackendMetricData(
+                       provider->GetBackendMetricData());
+               if (serialized.has_value()) {
+                 trailing_metadata->Set(
+                     XEndpointLoadMetricsBinMetadata(),
+                     Slice::FromCopiedString(std::move(*serialized)));
+               }
+               return trailing_metadata;
+             });
+}
+
+const grpc_channel_filter BackendMetricFilter::kFilter =
+    MakePromiseBasedFilter<BackendMetricFilter, FilterEndpoint::kServer>(
+        "backend_metric");
+
+void RegisterBackendMetricFilter(CoreConfiguration::Builder* builder) {
+  builder->channel_init()->RegisterStage(
+      GRPC_SERVER_CHANNEL, GRPC_CHANNEL_INIT_BUILTIN_PRIORITY,
+      [](ChannelStackBuilder* builder) {
+        auto channel_args = builder->channel_args();
+        if (channel_args.WantMinimalStack()) return true;
+        if (channel_args.GetBool(GRPC_ARG_SERVER_CALL_METRIC_RECORDING)
+                .value_or(false)) {
+          builder->PrependFilter(&BackendMetricFilter::kFilter);
+        }
+        return true;
+      });
+}
+
+}  // namespace grpc_core
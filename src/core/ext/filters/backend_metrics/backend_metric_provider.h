@@ -0,0 +1,52 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_BACKEND_METRICS_BACKEND_METRIC_PROVIDER_H
+#define GRPC_CORE_EXT_FILTERS_BACKEND_METRICS_BACKEND_METRIC_PROVIDER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <map>
+
+#include "absl/strings/string_view.h"
+
+namespace grpc_core {
+
+// Backend metrics reported for one call.
+struct BackendMetricData {
+  // Fractions of the available resources. Negative when not reported.
+  double cpu_utilization = -1;
+  double mem_utilization = -1;
+  // Application-specific costs of the call, by metric name.
+  std::map<absl::string_view, double> request_cost;
+  // Application-specific utilizations, by metric name.
+  std::map<absl::string_view, double> utilization;
+};
+
+// Supplies the backend metrics of a server call. Set as the
+// GRPC_CONTEXT_BACKEND_METRIC_PROVIDER element of the call context.
+class BackendMetricProvider {
+ public:
+  virtual ~BackendMetricProvider() = default;
+
+  // Called once the call sends its trailing metadata. The names in the
+  // result stay valid as long as the provider.
+  virtual BackendMetricData GetBackendMetricData() = 0;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_BACKEND_METRICS_BACKEND_METRIC_PROVIDER_H
@@ -211,21 +211,21 @@ bool ChannelIdleFilter::StartTransportOp(grpc_transport_op* op) {
 }
 
 void ChannelIdleFilter::Shutdown() {
-  // IncreaseCallCount() introduces a phony call and prevent the timer from
-  // being reset by other threads.
-  IncreaseCallCount();
+  // Introduce a phony call, which prevents the timer from being restarted by
+  // other threads.
+  (void)idle_filter_state_->IncreaseCallCount();
   activity_.Reset();
 }
 
 void ChannelIdleFilter::IncreaseCallCount() {
-  idle_filter_state_->IncreaseCallCount();
+  if (idle_filter_state_->IncreaseCallCount()) {
+    // If the channel was idle, start the idle timer.
+    StartIdleTimer();
+  }
 }
 
 void ChannelIdleFilter::DecreaseCallCount() {
-  if (idle_filter_state_->DecreaseCallCount()) {
-    // If there are no more calls in progress, start the idle timer.
-    StartIdleTimer();
-  }
+  idle_filter_state_->DecreaseCallCount();
 }
 
 void ChannelIdleFilter::StartIdleTimer() {
@@ -16,81 +16,61 @@
 
 #include "src/core/ext/filters/channel_idle/idle_filter_state.h"
 
-#include <assert.h>
+#include <grpc/support/cpu.h>
 
 namespace grpc_core {
 
 IdleFilterState::IdleFilterState(bool start_timer)
-    : state_(start_timer ? kTimerStarted : 0) {}
+    : timer_started_(start_timer) {}
 
-void IdleFilterState::IncreaseCallCount() {
-  uintptr_t state = state_.load(std::memory_order_relaxed);
-  uintptr_t new_state;
-  do {
-    // Increment the counter, and flag that there's been activity.
-    new_state = state;
-    new_state |= kCallsStartedSinceLastTimerCheck;
-    new_state += kCallIncrement;
-  } while (!state_.compare_exchange_weak(
-      state, new_state, std::memory_order_acq_rel, std::memory_order_relaxed));
+IdleFilterState::Shard* IdleFilterState::CurrentShard() {
+  return &shards_[gpr_cpu_current_cpu() % kNumShards];
 }
 
-bool IdleFilterState::DecreaseCallCount() {
-  uintptr_t state = state_.load(std::memory_order_relaxed);
-  uintptr_t new_state;
-  bool start_timer;
-  do {
-    start_timer = false;
-    new_state = state;
-    // Decrement call count (and assert there's at least one call outstanding!)
-    assert(new_state >= kCallIncrement);
-    new_state -= kCallIncrement;
-    // If that decrement reaches a call count of zero and we have not started a
-    // timer
-    if ((new_state >> kCallsInProgressShift) == 0 &&
-        (new_state & kTimerStarted) == 0) {
-      // Flag that we will start a timer, and mark it started so nobody else
-      // does.
-      start_timer = true;
-      new_state |= kTimerStarted;
-      new_state &= ~kCallsInProgressShift;
-    }
-  } while (!state_.compare_exchange_weak(
-      state, new_state, std::memory_order_acq_rel, std::memory_order_relaxed));
-  return start_timer;
+bool IdleFilterState::IncreaseCallCount() {
+  Shard* shard = CurrentShard();
+  shard->active.store(true, std::memory_order_release);
+  shard->calls_in_progress.fetch_add(1, std::memory_order_release);
+  // The timer keeps running while there are calls, so it only needs starting
+  // by the first call after the channel was idle.
+  return !timer_started_.load(std::memory_order_relaxed) &&
+         !timer_started_.exchange(true, std::memory_order_acq_rel);
+}
+
+void IdleFilterState::DecreaseCallCount() {
+  Shard* shard = CurrentShard();
+  shard->active.store(true, std::memory_order_release);
+  shard->calls_in_progress.fetch_sub(1, std::memory_order_release);
 }
 
 bool IdleFilterState::CheckTimer() {
-  uintptr_t state = state_.load(std::memory_order_relaxed);
-  uintptr_t new_state;
-  bool start_timer;
-  do {
-    if ((state >> kCallsInProgressShift) != 0) {
-      // Still calls in progress: nothing needs updating, just return
-      // and keep the timer going!
-      return true;
-    }
-    new_state = state;
-    bool is_active = false;
-    if (new_state & kCallsStartedSinceLastTimerCheck) {
-      // If any calls started since the last time we checked, then consider the
-      // channel still active and try again.
-      is_active = true;
-      new_state &= ~kCallsStartedSinceLastTimerCheck;
-    }
-    if (is_active) {
-      // If we are still active, we should signal that the timer should start
-      // again.
-      start_timer = true;
-    } else {
-      // Otherwise, we should not start the timer again, and we should signal
-      // that in the updated state.
-      start_timer = false;
-      new_state &= ~kTimerStarted;
+  // The shards are not read atomically: a call may be seen finishing on one
+  // shard but not starting on another, making the sum too low. Calls set the
+  // activity flag before updating the count, and the flags are read after
+  // the counts, so such a call is always seen as activity.
+  intptr_t calls_in_progress = 0;
+  for (Shard& shard : shards_) {
+    calls_in_progress +=
+        shard.calls_in_progress.load(std::memory_order_acquire);
+  }
+  bool active = false;
+  for (Shard& shard : shards_) {
+    // Only write the flags that are set, to leave idle shards' cache lines
+    // alone.
+    if (shard.active.load(std::memory_order_relaxed) &&
+        shard.active.exchange(false, std::memory_order_acq_rel)) {
+      active = true;
     }
-  } while (!state_.compare_exchange_weak(
-      state, new_state, std::memory_order_acq_rel, std::memory_order_relaxed));
-  return start_timer;
+  }
+  if (active || calls_in_progress != 0) {
+    // Still calls in progress, or calls started or finished since the last
+    // check: keep the timer going!
+    return true;
+  }
+  // Otherwise, we should not start the timer again, and we should signal
+  // that in the updated state.
+  timer_started_.store(false, std::memory_order_release);
+  return false;
 }
 
 }  // namespace grpc_core
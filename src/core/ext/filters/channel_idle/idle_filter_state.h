@@ -17,13 +17,21 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <atomic>
 
 namespace grpc_core {
 
-// State machine for the idle filter.
-// Keeps track of how many calls are in progress, whether there is a timer
-// started, and whether we've seen calls since the previous timer fired.
+// Tracks the calls on a channel for the idle timer.
+//
+// Calls are counted in per-CPU shards, and each shard has a flag recording
+// activity since the last timer check, so that starting or finishing a call
+// only touches the current CPU's cache line, with no compare-and-swap. The
+// idle timer, which runs periodically for as long as the channel is in use,
+// sums the shards: the channel is idle when no calls are in progress and
+// none started or finished during a full timer period.
 class IdleFilterState {
  public:
   explicit IdleFilterState(bool start_timer);
@@ -33,32 +41,38 @@ class IdleFilterState {
   IdleFilterState& operator=(const IdleFilterState&) = delete;
 
   // Increment the number of calls in progress.
-  void IncreaseCallCount();
+  // Return true if the timer is not running and should be started.
+  GRPC_MUST_USE_RESULT bool IncreaseCallCount();
 
   // Decrement the number of calls in progress.
-  // Return true if we reached idle with no timer started.
-  GRPC_MUST_USE_RESULT bool DecreaseCallCount();
-
-  // Check if there's been any activity since the last timer check.
-  // If there was, reset the activity flag and return true to indicated that
-  // a new timer should be started.
-  // If there was not, reset the timer flag and return false - in this case
-  // we know that the channel is idle and has been for one full cycle.
+  void DecreaseCallCount();
+
+  // Check if there's been any activity since the last timer check, or if
+  // there are calls in progress.
+  // If so, reset the activity flags and return true to indicate that a new
+  // timer should be started.
+  // If not, reset the timer flag and return false - in this case we know that
+  // the channel is idle and has been for one full cycle.
   GRPC_MUST_USE_RESULT bool CheckTimer();
 
  private:
-  // Bit in state_ indicating that the timer has been started.
-  static constexpr uintptr_t kTimerStarted = 1;
-  // Bit in state_ indicating that we've seen a call start or stop since the
-  // last timer.
-  static constexpr uintptr_t kCallsStartedSinceLastTimerCheck = 2;
-  // How much should we shift to get the number of calls in progress.
-  static constexpr uintptr_t kCallsInProgressShift = 2;
-  // How much to increment/decrement the state_ when a call is started/stopped.
-  // Ensures we don't clobber the preceding bits.
-  static constexpr uintptr_t kCallIncrement = uintptr_t(1)
-                                              << kCallsInProgressShift;
-  std::atomic<uintptr_t> state_;
+  // Calls are counted in this many shards, picked by the current CPU.
+  static constexpr size_t kNumShards = 16;
+
+  struct Shard {
+    // Calls started minus calls finished on this shard: a call may finish on
+    // a different CPU than it started on, so this may be negative.
+    std::atomic<intptr_t> calls_in_progress{0};
+    // Set when a call starts or finishes on this shard.
+    std::atomic<bool> active{false};
+    char padding[GPR_CACHELINE_SIZE - sizeof(std::atomic<intptr_t>) -
+                 sizeof(std::atomic<bool>)];
+  };
+
+  Shard* CurrentShard();
+
+  std::atomic<bool> timer_started_;
+  Shard shards_[kNumShards];
 };
 
 }  // namespace grpc_core
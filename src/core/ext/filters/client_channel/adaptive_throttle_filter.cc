@@ -0,0 +1,168 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/adaptive_throttle_filter.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/strip.h"
+
+#include <grpc/status.h>
+
+#include "src/core/ext/filters/client_channel/client_channel.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/json/json_util.h"
+#include "src/core/lib/promise/promise.h"
+#include "src/core/lib/promise/seq.h"
+#include "src/core/lib/service_config/service_config.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/uri/uri_parser.h"
+
+namespace grpc_core {
+
+//
+// AdaptiveThrottleServiceConfigParser
+//
+
+namespace {
+
+// The SRE book's recommended multiplier: backends may refuse up to half of
+// the calls before clients start rejecting any locally.
+constexpr double kDefaultAcceptsMultiplier = 2;
+constexpr Duration kDefaultWindow = Duration::Minutes(2);
+
+}  // namespace
+
+std::unique_ptr<ServiceConfigParser::ParsedConfig>
+AdaptiveThrottleServiceConfigParser::ParseGlobalParams(
+    const grpc_channel_args* /*args*/, const Json& json,
+    grpc_error_handle* error) {
+  GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+  std::vector<grpc_error_handle> error_list;
+  const Json::Object* throttle_json;
+  if (!ParseJsonObjectField(json.object_value(), "adaptiveThrottling",
+                            &throttle_json, &error_list, false)) {
+    *error = GRPC_ERROR_CREATE_FROM_VECTOR("adaptiveThrottling", &error_list);
+    return nullptr;
+  }
+  double accepts_multiplier = kDefaultAcceptsMultiplier;
+  auto it = throttle_json->find("acceptsMultiplier");
+  if (it != throttle_json->end()) {
+    if (it->second.type() != Json::Type::NUMBER ||
+        !absl::SimpleAtod(it->second.string_value(), &accepts_multiplier)) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:acceptsMultiplier error:should be a number"));
+    } else if (accepts_multiplier < 1) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:acceptsMultiplier error:must be at least 1"));
+    }
+  }
+  Duration window = kDefaultWindow;
+  if (ParseJsonObjectFieldAsDuration(*throttle_json, "window", &window,
+                                     &error_list, false) &&
+      window <= Duration::Zero()) {
+    error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "field:window error:must be greater than 0"));
+  }
+  *error = GRPC_ERROR_CREATE_FROM_VECTOR("adaptiveThrottling", &error_list);
+  if (*error != GRPC_ERROR_NONE) return nullptr;
+  return absl::make_unique<AdaptiveThrottleGlobalConfig>(accepts_multiplier,
+                                                         window);
+}
+
+void AdaptiveThrottleServiceConfigParser::Register(
+    CoreConfiguration::Builder* builder) {
+  builder->service_config_parser()->RegisterParser(
+      absl::make_unique<AdaptiveThrottleServiceConfigParser>());
+}
+
+size_t AdaptiveThrottleServiceConfigParser::ParserIndex() {
+  return CoreConfiguration::Get().service_config_parser().GetParserIndex(
+      parser_name());
+}
+
+//
+// AdaptiveThrottleFilter
+//
+
+absl::StatusOr<AdaptiveThrottleFilter> AdaptiveThrottleFilter::Create(
+    ChannelArgs args, ChannelFilter::Args) {
+  auto* service_config =
+      args.GetPointer<ServiceConfig>(GRPC_ARG_SERVICE_CONFIG_OBJ);
+  if (service_config == nullptr) {
+    return absl::InvalidArgumentError(
+        "service config missing from adaptive throttle filter args");
+  }
+  const auto* config = static_cast<const AdaptiveThrottleGlobalConfig*>(
+      service_config->GetGlobalParsedConfig(
+          AdaptiveThrottleServiceConfigParser::ParserIndex()));
+  if (config == nullptr) {
+    return absl::InvalidArgumentError(
+        "service config has no adaptiveThrottling field");
+  }
+  absl::optional<absl::string_view> server_uri =
+      args.GetString(GRPC_ARG_SERVER_URI);
+  if (!server_uri.has_value()) {
+    return absl::InvalidArgumentError(
+        "server URI channel arg missing or wrong type in adaptive throttle "
+        "filter");
+  }
+  absl::StatusOr<URI> uri = URI::Parse(*server_uri);
+  if (!uri.ok() || uri->path().empty()) {
+    return absl::InvalidArgumentError(
+        "could not extract server name from target URI");
+  }
+  std::string server_name(absl::StripPrefix(uri->path(), "/"));
+  return AdaptiveThrottleFilter(
+      internal::ServerAdaptiveThrottleMap::Get()->GetDataForServer(
+          server_name, config->accepts_multiplier(), config->window()));
+}
+
+AdaptiveThrottleFilter::AdaptiveThrottleFilter(
+    RefCountedPtr<internal::ServerAdaptiveThrottleData> throttle_data)
+    : throttle_data_(std::move(throttle_data)) {}
+
+ArenaPromise<ServerMetadataHandle> AdaptiveThrottleFilter::MakeCallPromise(
+    CallArgs call_args, NextPromiseFactory next_promise_factory) {
+  if (throttle_data_->ShouldThrottle(ExecCtx::Get()->Now())) {
+    return Immediate(ServerMetadataHandle(absl::UnavailableError(
+        "Call rejected locally by client-side adaptive throttling")));
+  }
+  return Seq(next_promise_factory(std::move(call_args)),
+             [this](ServerMetadataHandle md) {
+               grpc_status_code status =
+                   md->get(GrpcStatusMetadata()).value_or(GRPC_STATUS_UNKNOWN);
+               throttle_data_->RecordResult(
+                   status != GRPC_STATUS_RESOURCE_EXHAUSTED &&
+                       status != GRPC_STATUS_UNAVAILABLE,
+                   ExecCtx::Get()->Now());
+               return md;
+             });
+}
+
+const grpc_channel_filter AdaptiveThrottleFilter::kFilter =
+    MakePromiseBasedFilter<AdaptiveThrottleFilter, FilterEndpoint::kClient>(
+        "adaptive_throttle");
+
+}  // namespace grpc_core
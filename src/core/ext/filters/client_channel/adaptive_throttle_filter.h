@@ -0,0 +1,100 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_ADAPTIVE_THROTTLE_FILTER_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_ADAPTIVE_THROTTLE_FILTER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <memory>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/impl/codegen/grpc_types.h>
+
+#include "src/core/ext/filters/client_channel/retry_throttle.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/channel/promise_based_filter.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/service_config/service_config_parser.h"
+
+namespace grpc_core {
+
+class AdaptiveThrottleGlobalConfig : public ServiceConfigParser::ParsedConfig {
+ public:
+  AdaptiveThrottleGlobalConfig(double accepts_multiplier, Duration window)
+      : accepts_multiplier_(accepts_multiplier), window_(window) {}
+
+  double accepts_multiplier() const { return accepts_multiplier_; }
+  Duration window() const { return window_; }
+
+ private:
+  double accepts_multiplier_;
+  Duration window_;
+};
+
+class AdaptiveThrottleServiceConfigParser final
+    : public ServiceConfigParser::Parser {
+ public:
+  absl::string_view name() const override { return parser_name(); }
+  // Parses the "adaptiveThrottling" field of the service config.
+  std::unique_ptr<ServiceConfigParser::ParsedConfig> ParseGlobalParams(
+      const grpc_channel_args* args, const Json& json,
+      grpc_error_handle* error) override;
+  static size_t ParserIndex();
+  static void Register(CoreConfiguration::Builder* builder);
+
+ private:
+  static absl::string_view parser_name() { return "adaptive_throttle"; }
+};
+
+// Client-side adaptive throttling, as described in the SRE book's chapter on
+// handling overload.  Rejects new calls locally with UNAVAILABLE in
+// proportion to how many recent calls the backends refused with
+// RESOURCE_EXHAUSTED or UNAVAILABLE, so that clients do not amplify an
+// overload they can already see.  Added to the client channel's dynamic
+// filters when the service config has an "adaptiveThrottling" field; the
+// state is shared by all channels to the same server name.
+class AdaptiveThrottleFilter : public ChannelFilter {
+ public:
+  static const grpc_channel_filter kFilter;
+
+  static absl::StatusOr<AdaptiveThrottleFilter> Create(
+      ChannelArgs args, ChannelFilter::Args filter_args);
+
+  // Construct a promise for one call.
+  ArenaPromise<ServerMetadataHandle> MakeCallPromise(
+      CallArgs call_args, NextPromiseFactory next_promise_factory) override;
+
+ private:
+  explicit AdaptiveThrottleFilter(
+      RefCountedPtr<internal::ServerAdaptiveThrottleData> throttle_data);
+
+  RefCountedPtr<internal::ServerAdaptiveThrottleData> throttle_data_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_ADAPTIVE_THROTTLE_FILTER_H
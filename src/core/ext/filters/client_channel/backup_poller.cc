@@ -28,6 +28,7 @@
 
 #include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/error.h"
@@ -36,6 +37,7 @@
 #include "src/core/lib/iomgr/pollset.h"
 #include "src/core/lib/iomgr/pollset_set.h"
 #include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
 
 #define DEFAULT_POLL_INTERVAL_MS 5000
 
@@ -47,6 +49,8 @@ struct backup_poller {
   gpr_mu* pollset_mu;
   grpc_pollset* pollset;  // guarded by pollset_mu
   bool shutting_down;     // guarded by pollset_mu
+  // Whether the pollset is polled by a thread rather than on a timer.
+  bool use_thread;
   gpr_refcount refs;
   gpr_refcount shutdown_refs;
 };
@@ -60,6 +64,8 @@ static backup_poller* g_poller = nullptr;  // guarded by g_poller_mu
 // treated as const.
 static grpc_core::Duration g_poll_interval =
     grpc_core::Duration::Milliseconds(DEFAULT_POLL_INTERVAL_MS);
+// Set only once in grpc_client_channel_global_init_backup_polling().
+static bool g_use_poller_thread = false;
 
 GPR_GLOBAL_CONFIG_DEFINE_INT32(
     grpc_client_channel_backup_poll_interval_ms, DEFAULT_POLL_INTERVAL_MS,
@@ -70,6 +76,14 @@ GPR_GLOBAL_CONFIG_DEFINE_INT32(
     "idleness), so that the next RPC on this channel won't fail. Set to 0 to "
     "turn off the backup polls.");
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_client_channel_backup_poller_thread, false,
+    "If true, the backup polls on client channels are made by a single "
+    "process-wide thread that blocks in the poller until there is I/O to "
+    "process, instead of by the timer thread every "
+    "GRPC_CLIENT_CHANNEL_BACKUP_POLL_INTERVAL_MS. Idle channels then cause no "
+    "wakeups, and connection failures are processed as soon as they happen.");
+
 void grpc_client_channel_global_init_backup_polling() {
   gpr_once_init(&g_once, [] { gpr_mu_init(&g_poller_mu); });
   int32_t poll_interval_ms =
@@ -82,6 +96,8 @@ void grpc_client_channel_global_init_backup_polling() {
   } else {
     g_poll_interval = grpc_core::Duration::Milliseconds(poll_interval_ms);
   }
+  g_use_poller_thread =
+      GPR_GLOBAL_CONFIG_GET(grpc_client_channel_backup_poller_thread);
 }
 
 static void backup_poller_shutdown_unref(backup_poller* p) {
@@ -108,7 +124,8 @@ static void g_poller_unref() {
         p->pollset, GRPC_CLOSURE_INIT(&p->shutdown_closure, done_poller, p,
                                       grpc_schedule_on_exec_ctx));
     gpr_mu_unlock(p->pollset_mu);
-    grpc_timer_cancel(&p->polling_timer);
+    // The poller thread, if any, is kicked by the pollset shutdown.
+    if (!p->use_thread) grpc_timer_cancel(&p->polling_timer);
     backup_poller_shutdown_unref(p);
   } else {
     gpr_mu_unlock(&g_poller_mu);
@@ -139,6 +156,27 @@ static void run_poller(void* arg, grpc_error_handle error) {
                   &p->run_poller_closure);
 }
 
+// Body of the poller thread used instead of the polling timer when
+// g_use_poller_thread is set and the thread quota has room. It holds the
+// shutdown ref that the timer would otherwise hold, and exits when the pollset
+// is shut down.
+static void run_poller_thread(void* arg) {
+  backup_poller* p = static_cast<backup_poller*>(arg);
+  grpc_core::ExecCtx exec_ctx;
+  gpr_mu_lock(p->pollset_mu);
+  while (!p->shutting_down) {
+    grpc_error_handle err = grpc_pollset_work(
+        p->pollset, nullptr, grpc_core::Timestamp::InfFuture());
+    gpr_mu_unlock(p->pollset_mu);
+    GRPC_LOG_IF_ERROR("Run client channel backup poller", err);
+    exec_ctx.Flush();
+    gpr_mu_lock(p->pollset_mu);
+  }
+  gpr_mu_unlock(p->pollset_mu);
+  backup_poller_shutdown_unref(p);
+  grpc_core::ResourceQuota::Default()->thread_quota()->Release(1);
+}
+
 static void g_poller_init_locked() {
   if (g_poller == nullptr) {
     g_poller = grpc_core::Zalloc<backup_poller>();
@@ -147,8 +185,20 @@ static void g_poller_init_locked() {
     g_poller->shutting_down = false;
     grpc_pollset_init(g_poller->pollset, &g_poller->pollset_mu);
     gpr_ref_init(&g_poller->refs, 0);
-    // one for timer cancellation, one for pollset shutdown, one for g_poller
+    // one for timer cancellation (or the poller thread), one for pollset
+    // shutdown, one for g_poller
     gpr_ref_init(&g_poller->shutdown_refs, 3);
+    // Without room in the thread quota, poll on a timer instead.
+    g_poller->use_thread =
+        g_use_poller_thread &&
+        grpc_core::ResourceQuota::Default()->thread_quota()->Reserve(1);
+    if (g_poller->use_thread) {
+      grpc_core::Thread poller_thread(
+          "grpc_backup_poller", run_poller_thread, g_poller, nullptr,
+          grpc_core::Thread::Options().set_joinable(false));
+      poller_thread.Start();
+      return;
+    }
     GRPC_CLOSURE_INIT(&g_poller->run_poller_closure, run_poller, g_poller,
                       grpc_schedule_on_exec_ctx);
     grpc_timer_init(&g_poller->polling_timer,
@@ -43,9 +43,12 @@
 #include <grpc/slice.h>
 #include <grpc/status.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
+#include <grpc/support/time.h>
 
+#include "src/core/ext/filters/client_channel/adaptive_throttle_filter.h"
 #include "src/core/ext/filters/client_channel/backend_metric.h"
 #include "src/core/ext/filters/client_channel/backup_poller.h"
 #include "src/core/ext/filters/client_channel/client_channel_channelz.h"
@@ -57,6 +60,7 @@
 #include "src/core/ext/filters/client_channel/local_subchannel_pool.h"
 #include "src/core/ext/filters/client_channel/proxy_mapper_registry.h"
 #include "src/core/ext/filters/client_channel/resolver_result_parsing.h"
+#include "src/core/ext/filters/client_channel/response_cache_filter.h"
 #include "src/core/ext/filters/client_channel/retry_filter.h"
 #include "src/core/ext/filters/client_channel/subchannel.h"
 #include "src/core/ext/filters/client_channel/subchannel_interface.h"
@@ -66,6 +70,7 @@
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/channel_trace.h"
 #include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/debug_location.h"
@@ -170,13 +175,15 @@ class ClientChannel::CallData {
   // Resumes all pending batches on lb_call_.
   void PendingBatchesResume(grpc_call_element* elem);
 
-  // Applies service config to the call.  Must be invoked once we know
-  // that the resolver has returned results to the channel.
+  // Applies service config from resolver_data to the call.  The caller
+  // keeps resolver_data alive, either by holding
+  // ClientChannel::resolution_mu_ or from inside a ReadSection of
+  // ClientChannel::resolver_data_readers_.
   // If an error is returned, the error indicates the status with which
   // the call should be failed.
-  grpc_error_handle ApplyServiceConfigToCallLocked(
-      grpc_call_element* elem, grpc_metadata_batch* initial_metadata)
-      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::resolution_mu_);
+  grpc_error_handle ApplyServiceConfigToCall(
+      grpc_call_element* elem, grpc_metadata_batch* initial_metadata,
+      const ResolverData& resolver_data);
   // Invoked when the resolver result is applied to the caller, on both
   // success or failure.
   static void ResolutionDone(void* arg, grpc_error_handle error);
@@ -415,6 +422,45 @@ const grpc_channel_filter DynamicTerminationFilter::kFilterVtable = {
 
 }  // namespace
 
+//
+// ClientChannel::DataPlaneReaders
+//
+
+ClientChannel::DataPlaneReaders::ReadSection::ReadSection(
+    DataPlaneReaders* readers) {
+  PerCpuCounters& counters =
+      readers->counters_[ExecCtx::Get()->starting_cpu() % readers->num_cpus_];
+  counter_ = &counters.readers[readers->epoch_.load(std::memory_order_relaxed) &
+                               1];
+  // Pairs with the writer's swap of the published pointer followed by its
+  // load of this counter: either the writer sees this reader, or this
+  // reader sees the new pointer.
+  counter_->fetch_add(1, std::memory_order_seq_cst);
+}
+
+ClientChannel::DataPlaneReaders::ReadSection::~ReadSection() {
+  counter_->fetch_sub(1, std::memory_order_release);
+}
+
+ClientChannel::DataPlaneReaders::DataPlaneReaders()
+    : num_cpus_(std::max(1u, std::min(gpr_cpu_num_cores(), 64u))),
+      counters_(new PerCpuCounters[num_cpus_]) {}
+
+void ClientChannel::DataPlaneReaders::Synchronize() {
+  MutexLock lock(&synchronize_mu_);
+  const size_t draining = epoch_.fetch_add(1, std::memory_order_seq_cst) & 1;
+  for (size_t i = 0; i < num_cpus_; ++i) {
+    while (counters_[i].readers[draining].load(std::memory_order_seq_cst) !=
+           0) {
+      // Readers only hold their section across a pick, so this is short;
+      // sleep rather than spin so that a preempted reader on this CPU
+      // gets to finish.
+      gpr_sleep_until(gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                                   gpr_time_from_micros(1, GPR_TIMESPAN)));
+    }
+  }
+}
+
 //
 // ClientChannel::ResolverResultHandler
 //
@@ -1057,6 +1103,10 @@ ClientChannel::ClientChannel(grpc_channel_element_args* args,
                              grpc_error_handle* error)
     : deadline_checking_enabled_(
           grpc_deadline_checking_enabled(args->channel_args)),
+      deadline_timer_granularity_(
+          grpc_deadline_timer_granularity(args->channel_args)),
+      tx_timestamps_enabled_(grpc_channel_args_find_bool(
+          args->channel_args, GRPC_ARG_TCP_TX_TIMESTAMPS_ENABLED, false)),
       owning_stack_(args->channel_stack),
       client_channel_factory_(
           ClientChannelFactory::GetFromChannelArgs(args->channel_args)),
@@ -1151,6 +1201,8 @@ ClientChannel::~ClientChannel() {
   grpc_client_channel_stop_backup_polling(interested_parties_);
   grpc_pollset_set_destroy(interested_parties_);
   GRPC_ERROR_UNREF(disconnect_error_);
+  delete resolver_data_.load(std::memory_order_relaxed);
+  delete picker_.load(std::memory_order_relaxed);
 }
 
 OrphanablePtr<ClientChannel::LoadBalancedCall>
@@ -1518,6 +1570,22 @@ void ClientChannel::UpdateServiceConfigInDataPlaneLocked() {
   // Construct dynamic filter stack.
   std::vector<const grpc_channel_filter*> filters =
       config_selector->GetFilters();
+  // Serve cached responses below the config selector's filters, so that
+  // e.g. fault injection still applies, and above throttling and retries,
+  // which hits have no business with.
+  if (service_config != nullptr &&
+      service_config->GetGlobalParsedConfig(
+          ResponseCacheServiceConfigParser::ParserIndex()) != nullptr) {
+    filters.push_back(&kResponseCacheFilterVtable);
+  }
+  // Throttle below the config selector's filters, so that calls failed by
+  // e.g. fault injection are not counted against the backends, and above
+  // retries, so that a call is throttled at most once.
+  if (service_config != nullptr &&
+      service_config->GetGlobalParsedConfig(
+          AdaptiveThrottleServiceConfigParser::ParserIndex()) != nullptr) {
+    filters.push_back(&AdaptiveThrottleFilter::kFilter);
+  }
   if (enable_retries) {
     filters.push_back(&kRetryFilterVtable);
   } else {
@@ -1527,19 +1595,21 @@ void ClientChannel::UpdateServiceConfigInDataPlaneLocked() {
       DynamicFilters::Create(new_args, std::move(filters));
   GPR_ASSERT(dynamic_filters != nullptr);
   grpc_channel_args_destroy(new_args);
+  auto* resolver_data =
+      new ResolverData{std::move(service_config), std::move(config_selector),
+                       std::move(dynamic_filters)};
   // Grab data plane lock to update service config.
   //
   // We defer unreffing the old values (and deallocating memory) until
   // after releasing the lock to keep the critical section small.
+  ResolverData* old_resolver_data;
   {
     MutexLock lock(&resolution_mu_);
     resolver_transient_failure_error_ = absl::OkStatus();
     // Update service config.
-    received_service_config_data_ = true;
     // Old values will be unreffed after lock is released.
-    service_config_.swap(service_config);
-    config_selector_.swap(config_selector);
-    dynamic_filters_.swap(dynamic_filters);
+    old_resolver_data =
+        resolver_data_.exchange(resolver_data, std::memory_order_seq_cst);
     // Process calls that were queued waiting for the resolver result.
     for (ResolverQueuedCall* call = resolver_queued_calls_; call != nullptr;
          call = call->next) {
@@ -1560,8 +1630,12 @@ void ClientChannel::UpdateServiceConfigInDataPlaneLocked() {
       }
     }
   }
-  // Old values will be unreffed after lock is released when they go out
-  // of scope.
+  // Old values will be unreffed after lock is released, once calls that
+  // read them without the lock are done with them.
+  if (old_resolver_data != nullptr) {
+    resolver_data_readers_.Synchronize();
+    delete old_resolver_data;
+  }
 }
 
 void ClientChannel::CreateResolverLocked() {
@@ -1613,15 +1687,15 @@ void ClientChannel::UpdateStateAndPickerLocked(
     // Acquire resolution lock to update config selector and associated state.
     // To minimize lock contention, we wait to unref these objects until
     // after we release the lock.
-    RefCountedPtr<ServiceConfig> service_config_to_unref;
-    RefCountedPtr<ConfigSelector> config_selector_to_unref;
-    RefCountedPtr<DynamicFilters> dynamic_filters_to_unref;
+    ResolverData* resolver_data_to_unref;
     {
       MutexLock lock(&resolution_mu_);
-      received_service_config_data_ = false;
-      service_config_to_unref = std::move(service_config_);
-      config_selector_to_unref = std::move(config_selector_);
-      dynamic_filters_to_unref = std::move(dynamic_filters_);
+      resolver_data_to_unref =
+          resolver_data_.exchange(nullptr, std::memory_order_seq_cst);
+    }
+    if (resolver_data_to_unref != nullptr) {
+      resolver_data_readers_.Synchronize();
+      delete resolver_data_to_unref;
     }
   }
   // Update connectivity state.
@@ -1635,11 +1709,13 @@ void ClientChannel::UpdateStateAndPickerLocked(
                 state)));
   }
   // Grab data plane lock to update the picker.
+  LoadBalancingPolicy::SubchannelPicker* old_picker;
   {
     MutexLock lock(&data_plane_mu_);
     // Swap out the picker.
     // Note: Original value will be destroyed after the lock is released.
-    picker_.swap(picker);
+    old_picker = picker_.exchange(picker.release(), std::memory_order_seq_cst);
+    picker_generation_.fetch_add(1, std::memory_order_release);
     // Re-process queued picks.
     for (LbQueuedCall* call = lb_queued_calls_; call != nullptr;
          call = call->next) {
@@ -1658,6 +1734,11 @@ void ClientChannel::UpdateStateAndPickerLocked(
       }
     }
   }
+  // Picks made without the lock may still be using the old picker.
+  if (old_picker != nullptr) {
+    picker_readers_.Synchronize();
+    delete old_picker;
+  }
 }
 
 namespace {
@@ -1700,8 +1781,9 @@ grpc_error_handle ClientChannel::DoPingLocked(grpc_transport_op* op) {
   }
   LoadBalancingPolicy::PickResult result;
   {
-    MutexLock lock(&data_plane_mu_);
-    result = picker_->Pick(LoadBalancingPolicy::PickArgs());
+    DataPlaneReaders::ReadSection read_section(&picker_readers_);
+    result = picker_.load(std::memory_order_seq_cst)
+                 ->Pick(LoadBalancingPolicy::PickArgs());
   }
   return HandlePickResult<grpc_error_handle>(
       &result,
@@ -1888,7 +1970,8 @@ ClientChannel::CallData::CallData(grpc_call_element* elem,
     : deadline_state_(elem, args,
                       GPR_LIKELY(chand.deadline_checking_enabled_)
                           ? args.deadline
-                          : Timestamp::InfFuture()),
+                          : Timestamp::InfFuture(),
+                      chand.deadline_timer_granularity_),
       path_(grpc_slice_ref_internal(args.path)),
       call_start_time_(args.start_time),
       deadline_(args.deadline),
@@ -2233,14 +2316,15 @@ void ClientChannel::CallData::MaybeAddCallToResolverQueuedCallsLocked(
   resolver_call_canceller_ = new ResolverQueuedCallCanceller(elem);
 }
 
-grpc_error_handle ClientChannel::CallData::ApplyServiceConfigToCallLocked(
-    grpc_call_element* elem, grpc_metadata_batch* initial_metadata) {
+grpc_error_handle ClientChannel::CallData::ApplyServiceConfigToCall(
+    grpc_call_element* elem, grpc_metadata_batch* initial_metadata,
+    const ResolverData& resolver_data) {
   ClientChannel* chand = static_cast<ClientChannel*>(elem->channel_data);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_call_trace)) {
     gpr_log(GPR_INFO, "chand=%p calld=%p: applying service config to call",
             chand, this);
   }
-  ConfigSelector* config_selector = chand->config_selector_.get();
+  ConfigSelector* config_selector = resolver_data.config_selector.get();
   if (config_selector != nullptr) {
     // Use the ConfigSelector to determine the config for the call.
     ConfigSelector::CallConfig call_config =
@@ -2289,7 +2373,7 @@ grpc_error_handle ClientChannel::CallData::ApplyServiceConfigToCallLocked(
       }
     }
     // Set the dynamic filter stack.
-    dynamic_filters_ = chand->dynamic_filters_;
+    dynamic_filters_ = resolver_data.dynamic_filters;
   }
   return GRPC_ERROR_NONE;
 }
@@ -2347,8 +2431,24 @@ void ClientChannel::CallData::CheckResolution(void* arg,
   grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
   CallData* calld = static_cast<CallData*>(elem->call_data);
   ClientChannel* chand = static_cast<ClientChannel*>(elem->channel_data);
-  bool resolution_complete;
-  {
+  bool resolution_complete = false;
+  // Fast path: if the channel already has a resolver result, apply it to
+  // the call without taking resolution_mu_.  The call has not been queued
+  // yet, so there is nothing else to update.
+  if (GPR_LIKELY(chand->CheckConnectivityState(false) != GRPC_CHANNEL_IDLE)) {
+    DataPlaneReaders::ReadSection read_section(&chand->resolver_data_readers_);
+    ResolverData* resolver_data =
+        chand->resolver_data_.load(std::memory_order_seq_cst);
+    if (GPR_LIKELY(resolver_data != nullptr)) {
+      error = calld->ApplyServiceConfigToCall(
+          elem,
+          calld->pending_batches_[0]
+              ->payload->send_initial_metadata.send_initial_metadata,
+          *resolver_data);
+      resolution_complete = true;
+    }
+  }
+  if (!resolution_complete) {
     MutexLock lock(&chand->resolution_mu_);
     resolution_complete = calld->CheckResolutionLocked(elem, &error);
   }
@@ -2397,7 +2497,9 @@ bool ClientChannel::CallData::CheckResolutionLocked(grpc_call_element* elem,
       send_initial_metadata.send_initial_metadata_flags;
   // If we don't yet have a resolver result, we need to queue the call
   // until we get one.
-  if (GPR_UNLIKELY(!chand->received_service_config_data_)) {
+  ResolverData* resolver_data =
+      chand->resolver_data_.load(std::memory_order_relaxed);
+  if (GPR_UNLIKELY(resolver_data == nullptr)) {
     // If the resolver returned transient failure before returning the
     // first service config, fail any non-wait_for_ready calls.
     absl::Status resolver_error = chand->resolver_transient_failure_error_;
@@ -2424,7 +2526,8 @@ bool ClientChannel::CallData::CheckResolutionLocked(grpc_call_element* elem,
   // Apply service config to call if not yet applied.
   if (GPR_LIKELY(!service_config_applied_)) {
     service_config_applied_ = true;
-    *error = ApplyServiceConfigToCallLocked(elem, initial_metadata_batch);
+    *error = ApplyServiceConfigToCall(elem, initial_metadata_batch,
+                                      *resolver_data);
   }
   MaybeRemoveCallFromResolverQueuedCallsLocked(elem);
   return true;
@@ -2645,6 +2748,20 @@ ClientChannel::LoadBalancedCall::LoadBalancedCall(
   if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
     gpr_log(GPR_INFO, "chand=%p lb_call=%p: created", chand_, this);
   }
+  if (chand_->tx_timestamps_enabled_ &&
+      (call_attempt_tracer_ != nullptr || chand_->channelz_node_ != nullptr)) {
+    RefCountedPtr<channelz::ChannelNode> channelz_node;
+    if (chand_->channelz_node_ != nullptr) {
+      chand_->channelz_node_->Ref().release();
+      channelz_node.reset(chand_->channelz_node_);
+    }
+    tx_latency_reporter_ = MakeRefCounted<TxLatencyReporter>(
+        call_attempt_tracer_, std::move(channelz_node));
+    // The transport takes its own ref when it sees the first traced batch.
+    call_context_[GRPC_CONTEXT_TX_LATENCY_REPORTER].value =
+        tx_latency_reporter_.get();
+    call_context_[GRPC_CONTEXT_TX_LATENCY_REPORTER].destroy = nullptr;
+  }
 }
 
 ClientChannel::LoadBalancedCall::~LoadBalancedCall() {
@@ -2671,6 +2788,15 @@ void ClientChannel::LoadBalancedCall::Orphan() {
   if (recv_trailing_metadata_ == nullptr) {
     RecordCallCompletion(absl::CancelledError("call cancelled"));
   }
+  // Timestamps may still arrive for this attempt's writes, but they can no
+  // longer go to its tracer.
+  if (tx_latency_reporter_ != nullptr) {
+    tx_latency_reporter_->Detach();
+    if (call_context_[GRPC_CONTEXT_TX_LATENCY_REPORTER].value ==
+        tx_latency_reporter_.get()) {
+      call_context_[GRPC_CONTEXT_TX_LATENCY_REPORTER].value = nullptr;
+    }
+  }
   // Compute latency and report it to the tracer.
   if (call_attempt_tracer_ != nullptr) {
     gpr_timespec latency =
@@ -2803,6 +2929,8 @@ void ClientChannel::LoadBalancedCall::StartTransportStreamOpBatch(
             chand_, this, grpc_transport_stream_op_batch_string(batch).c_str(),
             call_attempt_tracer_);
   }
+  // Ask the transport for TX timestamps.
+  if (tx_latency_reporter_ != nullptr) batch->is_traced = true;
   // Handle call tracing.
   if (call_attempt_tracer_ != nullptr) {
     // Record send ops in tracer.
@@ -3161,6 +3289,10 @@ void ClientChannel::LoadBalancedCall::PickDone(void* arg,
     self->PendingBatchesFail(GRPC_ERROR_REF(error), YieldCallCombiner);
     return;
   }
+  GRPC_STATS_INC_LB_PICK_LATENCY_MICROS(
+      grpc_stats_micros_since(self->lb_call_start_time_));
+  GRPC_USDT_PROBE(lb_pick_complete, self->owning_call_,
+                  grpc_stats_micros_since(self->lb_call_start_time_));
   self->call_dispatch_controller_->Commit();
   self->CreateSubchannelCall();
 }
@@ -3168,10 +3300,28 @@ void ClientChannel::LoadBalancedCall::PickDone(void* arg,
 void ClientChannel::LoadBalancedCall::PickSubchannel(void* arg,
                                                      grpc_error_handle error) {
   auto* self = static_cast<LoadBalancedCall*>(arg);
+  auto* chand = self->chand_;
+  // Fast path: pick without the data plane mutex.  Only if the call has
+  // to wait for a new picker do we need the mutex, to queue it.
   bool pick_complete;
+  size_t picker_generation;
   {
-    MutexLock lock(&self->chand_->data_plane_mu_);
-    pick_complete = self->PickSubchannelLocked(&error);
+    DataPlaneReaders::ReadSection read_section(&chand->picker_readers_);
+    picker_generation =
+        chand->picker_generation_.load(std::memory_order_acquire);
+    pick_complete = self->PickSubchannelImpl(
+        chand->picker_.load(std::memory_order_seq_cst), &error);
+  }
+  if (!pick_complete) {
+    MutexLock lock(&chand->data_plane_mu_);
+    // If the picker was replaced since our pick, the call was not there
+    // to be re-processed, so pick again with the new one.
+    if (chand->picker_generation_.load(std::memory_order_relaxed) ==
+        picker_generation) {
+      self->MaybeAddCallToLbQueuedCallsLocked();
+    } else {
+      pick_complete = self->PickSubchannelLocked(&error);
+    }
   }
   if (pick_complete) {
     PickDone(self, error);
@@ -3181,8 +3331,21 @@ void ClientChannel::LoadBalancedCall::PickSubchannel(void* arg,
 
 bool ClientChannel::LoadBalancedCall::PickSubchannelLocked(
     grpc_error_handle* error) {
+  if (PickSubchannelImpl(chand_->picker_.load(std::memory_order_relaxed),
+                         error)) {
+    MaybeRemoveCallFromLbQueuedCallsLocked();
+    return true;
+  }
+  MaybeAddCallToLbQueuedCallsLocked();
+  return false;
+}
+
+bool ClientChannel::LoadBalancedCall::PickSubchannelImpl(
+    LoadBalancingPolicy::SubchannelPicker* picker, grpc_error_handle* error) {
   GPR_ASSERT(connected_subchannel_ == nullptr);
   GPR_ASSERT(subchannel_call_ == nullptr);
+  // There is no picker while the channel is IDLE.
+  if (picker == nullptr) return false;
   // Grab initial metadata.
   auto& send_initial_metadata =
       pending_batches_[0]->payload->send_initial_metadata;
@@ -3197,93 +3360,82 @@ bool ClientChannel::LoadBalancedCall::PickSubchannelLocked(
   pick_args.call_state = &lb_call_state;
   Metadata initial_metadata(initial_metadata_batch);
   pick_args.initial_metadata = &initial_metadata;
-  auto result = chand_->picker_->Pick(pick_args);
+  auto result = picker->Pick(pick_args);
   return HandlePickResult<bool>(
       &result,
       // CompletePick
-      [this](LoadBalancingPolicy::PickResult::Complete* complete_pick)
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_) {
-            if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
-              gpr_log(GPR_INFO,
-                      "chand=%p lb_call=%p: LB pick succeeded: subchannel=%p",
-                      chand_, this, complete_pick->subchannel.get());
-            }
-            GPR_ASSERT(complete_pick->subchannel != nullptr);
-            // Grab a ref to the connected subchannel while we're still
-            // holding the data plane mutex.
-            SubchannelWrapper* subchannel = static_cast<SubchannelWrapper*>(
-                complete_pick->subchannel.get());
-            connected_subchannel_ = subchannel->connected_subchannel();
-            // If the subchannel has no connected subchannel (e.g., if the
-            // subchannel has moved out of state READY but the LB policy hasn't
-            // yet seen that change and given us a new picker), then just
-            // queue the pick.  We'll try again as soon as we get a new picker.
-            if (connected_subchannel_ == nullptr) {
-              if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
-                gpr_log(GPR_INFO,
-                        "chand=%p lb_call=%p: subchannel returned by LB picker "
-                        "has no connected subchannel; queueing pick",
-                        chand_, this);
-              }
-              MaybeAddCallToLbQueuedCallsLocked();
-              return false;
-            }
-            lb_subchannel_call_tracker_ =
-                std::move(complete_pick->subchannel_call_tracker);
-            if (lb_subchannel_call_tracker_ != nullptr) {
-              lb_subchannel_call_tracker_->Start();
-            }
-            MaybeRemoveCallFromLbQueuedCallsLocked();
-            return true;
-          },
+      [this](LoadBalancingPolicy::PickResult::Complete* complete_pick) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+          gpr_log(GPR_INFO,
+                  "chand=%p lb_call=%p: LB pick succeeded: subchannel=%p",
+                  chand_, this, complete_pick->subchannel.get());
+        }
+        GPR_ASSERT(complete_pick->subchannel != nullptr);
+        // Grab a ref to the connected subchannel.
+        SubchannelWrapper* subchannel = static_cast<SubchannelWrapper*>(
+            complete_pick->subchannel.get());
+        connected_subchannel_ = subchannel->connected_subchannel();
+        // If the subchannel has no connected subchannel (e.g., if the
+        // subchannel has moved out of state READY but the LB policy hasn't
+        // yet seen that change and given us a new picker), then just
+        // queue the pick.  We'll try again as soon as we get a new picker.
+        if (connected_subchannel_ == nullptr) {
+          if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+            gpr_log(GPR_INFO,
+                    "chand=%p lb_call=%p: subchannel returned by LB picker "
+                    "has no connected subchannel; queueing pick",
+                    chand_, this);
+          }
+          return false;
+        }
+        lb_subchannel_call_tracker_ =
+            std::move(complete_pick->subchannel_call_tracker);
+        if (lb_subchannel_call_tracker_ != nullptr) {
+          lb_subchannel_call_tracker_->Start();
+        }
+        return true;
+      },
       // QueuePick
-      [this](LoadBalancingPolicy::PickResult::Queue* /*queue_pick*/)
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_) {
-            if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
-              gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick queued", chand_,
-                      this);
-            }
-            MaybeAddCallToLbQueuedCallsLocked();
-            return false;
-          },
+      [this](LoadBalancingPolicy::PickResult::Queue* /*queue_pick*/) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+          gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick queued", chand_,
+                  this);
+        }
+        return false;
+      },
       // FailPick
       [this, send_initial_metadata_flags,
-       &error](LoadBalancingPolicy::PickResult::Fail* fail_pick)
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_) {
-            if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
-              gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick failed: %s",
-                      chand_, this, fail_pick->status.ToString().c_str());
-            }
-            // If wait_for_ready is false, then the error indicates the RPC
-            // attempt's final status.
-            if ((send_initial_metadata_flags &
-                 GRPC_INITIAL_METADATA_WAIT_FOR_READY) == 0) {
-              grpc_error_handle lb_error =
-                  absl_status_to_grpc_error(fail_pick->status);
-              *error = GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
-                  "Failed to pick subchannel", &lb_error, 1);
-              GRPC_ERROR_UNREF(lb_error);
-              MaybeRemoveCallFromLbQueuedCallsLocked();
-              return true;
-            }
-            // If wait_for_ready is true, then queue to retry when we get a new
-            // picker.
-            MaybeAddCallToLbQueuedCallsLocked();
-            return false;
-          },
+       &error](LoadBalancingPolicy::PickResult::Fail* fail_pick) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+          gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick failed: %s", chand_,
+                  this, fail_pick->status.ToString().c_str());
+        }
+        // If wait_for_ready is false, then the error indicates the RPC
+        // attempt's final status.
+        if ((send_initial_metadata_flags &
+             GRPC_INITIAL_METADATA_WAIT_FOR_READY) == 0) {
+          grpc_error_handle lb_error =
+              absl_status_to_grpc_error(fail_pick->status);
+          *error = GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
+              "Failed to pick subchannel", &lb_error, 1);
+          GRPC_ERROR_UNREF(lb_error);
+          return true;
+        }
+        // If wait_for_ready is true, then queue to retry when we get a new
+        // picker.
+        return false;
+      },
       // DropPick
-      [this, &error](LoadBalancingPolicy::PickResult::Drop* drop_pick)
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_) {
-            if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
-              gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick dropped: %s",
-                      chand_, this, drop_pick->status.ToString().c_str());
-            }
-            *error =
-                grpc_error_set_int(absl_status_to_grpc_error(drop_pick->status),
-                                   GRPC_ERROR_INT_LB_POLICY_DROP, 1);
-            MaybeRemoveCallFromLbQueuedCallsLocked();
-            return true;
-          });
+      [this, &error](LoadBalancingPolicy::PickResult::Drop* drop_pick) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+          gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick dropped: %s", chand_,
+                  this, drop_pick->status.ToString().c_str());
+        }
+        *error =
+            grpc_error_set_int(absl_status_to_grpc_error(drop_pick->status),
+                               GRPC_ERROR_INT_LB_POLICY_DROP, 1);
+        return true;
+      });
 }
 
 }  // namespace grpc_core
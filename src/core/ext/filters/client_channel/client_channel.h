@@ -47,6 +47,7 @@
 #include "src/core/lib/channel/channel_stack_builder.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/channel/context.h"
+#include "src/core/lib/channel/tx_latency_reporter.h"
 #include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted.h"
@@ -210,6 +211,58 @@ class ClientChannel {
     std::atomic<bool> done_{false};
   };
 
+  // Lets calls read data published by the control plane through an atomic
+  // pointer without taking a lock, in the style of RCU.  A reader uses the
+  // data only inside a ReadSection.  A writer that has swapped the pointer
+  // calls Synchronize() before destroying the old data; that waits until
+  // every ReadSection that may still see it has ended.
+  //
+  // Readers only touch a counter on their own CPU's cache line, so calls
+  // on different CPUs do not contend.  Each counter has two halves, and
+  // Synchronize() switches new readers to the other half before waiting
+  // for the old one to drain, so that a steady stream of readers cannot
+  // hold off a writer.
+  //
+  // Code inside a ReadSection should be short, and must not wait for the
+  // WorkSerializer, from which Synchronize() is called.
+  class DataPlaneReaders {
+   public:
+    class ReadSection {
+     public:
+      explicit ReadSection(DataPlaneReaders* readers);
+      ~ReadSection();
+
+      ReadSection(const ReadSection&) = delete;
+      ReadSection& operator=(const ReadSection&) = delete;
+
+     private:
+      std::atomic<intptr_t>* counter_;
+    };
+
+    DataPlaneReaders();
+
+    void Synchronize();
+
+   private:
+    struct PerCpuCounters {
+      std::atomic<intptr_t> readers[2] = {{0}, {0}};
+      uint8_t padding[GPR_CACHELINE_SIZE - 2 * sizeof(std::atomic<intptr_t>)];
+    };
+
+    const size_t num_cpus_;
+    std::unique_ptr<PerCpuCounters[]> counters_;
+    std::atomic<size_t> epoch_{0};
+    // Serializes writers, so that only one half is ever draining.
+    Mutex synchronize_mu_;
+  };
+
+  // What calls need from the last resolver result.  Replaced as a unit.
+  struct ResolverData {
+    RefCountedPtr<ServiceConfig> service_config;
+    RefCountedPtr<ConfigSelector> config_selector;
+    RefCountedPtr<DynamicFilters> dynamic_filters;
+  };
+
   struct ResolverQueuedCall {
     grpc_call_element* elem;
     ResolverQueuedCall* next = nullptr;
@@ -291,6 +344,8 @@ class ClientChannel {
   // Fields set at construction and never modified.
   //
   const bool deadline_checking_enabled_;
+  const Duration deadline_timer_granularity_;
+  const bool tx_timestamps_enabled_;
   grpc_channel_stack* owning_stack_;
   ClientChannelFactory* client_channel_factory_;
   const grpc_channel_args* channel_args_;
@@ -311,19 +366,23 @@ class ClientChannel {
   // Data from service config.
   absl::Status resolver_transient_failure_error_
       ABSL_GUARDED_BY(resolution_mu_);
-  bool received_service_config_data_ ABSL_GUARDED_BY(resolution_mu_) = false;
-  RefCountedPtr<ServiceConfig> service_config_ ABSL_GUARDED_BY(resolution_mu_);
-  RefCountedPtr<ConfigSelector> config_selector_
-      ABSL_GUARDED_BY(resolution_mu_);
-  RefCountedPtr<DynamicFilters> dynamic_filters_
-      ABSL_GUARDED_BY(resolution_mu_);
+  // Null until a resolver result has been received.  Only set while holding
+  // resolution_mu_, and read either while holding it or inside one of
+  // resolver_data_readers_'s ReadSections.  Owned.
+  std::atomic<ResolverData*> resolver_data_{nullptr};
+  DataPlaneReaders resolver_data_readers_;
 
   //
   // Fields used in the data plane.  Guarded by data_plane_mu_.
   //
   mutable Mutex data_plane_mu_;
-  std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker_
-      ABSL_GUARDED_BY(data_plane_mu_);
+  // Only set while holding data_plane_mu_, and read either while holding
+  // it or inside one of picker_readers_'s ReadSections.  Owned.
+  std::atomic<LoadBalancingPolicy::SubchannelPicker*> picker_{nullptr};
+  // Incremented with each picker_ update, so that a pick made without the
+  // lock can tell whether the picker changed before the call got queued.
+  std::atomic<size_t> picker_generation_{0};
+  DataPlaneReaders picker_readers_;
   // Linked list of calls queued waiting for LB pick.
   LbQueuedCall* lb_queued_calls_ ABSL_GUARDED_BY(data_plane_mu_) = nullptr;
 
@@ -456,6 +515,11 @@ class ClientChannel::LoadBalancedCall
   void RecordCallCompletion(absl::Status status);
 
   void CreateSubchannelCall();
+  // Performs an LB pick with picker, which the caller keeps alive, without
+  // touching the channel's list of queued picks.  Returns true if the pick
+  // is complete, or false if the call has to wait for a new picker.
+  bool PickSubchannelImpl(LoadBalancingPolicy::SubchannelPicker* picker,
+                          grpc_error_handle* error);
   // Invoked when a pick is completed, on both success or failure.
   static void PickDone(void* arg, grpc_error_handle error);
   // Removes the call from the channel's list of queued picks if present.
@@ -481,6 +545,9 @@ class ClientChannel::LoadBalancedCall
   ConfigSelector::CallDispatchController* call_dispatch_controller_;
 
   CallTracer::CallAttemptTracer* call_attempt_tracer_;
+  // Set if GRPC_ARG_TCP_TX_TIMESTAMPS_ENABLED is on and there is a tracer or
+  // a channelz node to report to.
+  RefCountedPtr<TxLatencyReporter> tx_latency_reporter_;
 
   gpr_cycle_counter lb_call_start_time_ = gpr_get_cycle_counter();
 
@@ -56,6 +56,10 @@ class SubchannelNode : public BaseNode {
 
   Json RenderJson() override;
 
+  absl::optional<CallCounts> GetCallCounts() override {
+    return call_counter_.GetCallCounts();
+  }
+
   // proxy methods to composed classes.
   void AddTraceEvent(ChannelTrace::Severity severity, const grpc_slice& data) {
     trace_.AddTraceEvent(severity, data);
@@ -22,13 +22,16 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <map>
 #include <memory>
+#include <set>
 #include <utility>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "upb/upb.h"
 #include "upb/upb.hpp"
 
@@ -39,6 +42,7 @@
 
 #include "src/core/lib/channel/channel_trace.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/proto/grpc/health/v1/health.upb.h"
 
@@ -155,6 +159,198 @@ class HealthStreamEventHandler
   RefCountedPtr<ConnectivityStateWatcherInterface> watcher_;
 };
 
+class SharedHealthCheckStream;
+
+// A caller's watch on the SharedHealthCheckStream for an address and
+// service name.
+class SharedHealthCheckWatch : public Orphanable {
+ public:
+  SharedHealthCheckWatch(
+      std::string address, std::string service_name,
+      RefCountedPtr<ConnectedSubchannel> connected_subchannel,
+      grpc_pollset_set* interested_parties,
+      RefCountedPtr<channelz::SubchannelNode> channelz_node,
+      RefCountedPtr<ConnectivityStateWatcherInterface> watcher);
+
+  void Orphan() override;
+
+  const RefCountedPtr<ConnectedSubchannel>& connected_subchannel() const {
+    return connected_subchannel_;
+  }
+  grpc_pollset_set* interested_parties() const { return interested_parties_; }
+  const RefCountedPtr<channelz::SubchannelNode>& channelz_node() const {
+    return channelz_node_;
+  }
+  ConnectivityStateWatcherInterface* watcher() const { return watcher_.get(); }
+
+ private:
+  const std::string address_;
+  const std::string service_name_;
+  RefCountedPtr<ConnectedSubchannel> connected_subchannel_;
+  grpc_pollset_set* interested_parties_;
+  RefCountedPtr<channelz::SubchannelNode> channelz_node_;
+  RefCountedPtr<ConnectivityStateWatcherInterface> watcher_;
+  RefCountedPtr<SharedHealthCheckStream> stream_;
+};
+
+// A health check stream for one service name on one address, shared by all
+// the SharedHealthCheckWatches for them.
+//
+// The stream runs on the connection of one of the watches, the owner.  When
+// the owner goes away, the stream is restarted on the connection of another
+// watch.  Each stream started gets a new generation, so that the status
+// changes still queued from an old stream are ignored.
+class SharedHealthCheckStream : public RefCounted<SharedHealthCheckStream> {
+ public:
+  explicit SharedHealthCheckStream(std::string service_name)
+      : service_name_(std::move(service_name)) {}
+
+  void AddWatch(SharedHealthCheckWatch* watch) {
+    MutexLock lock(&mu_);
+    watches_.insert(watch);
+    if (owner_ == nullptr) {
+      StartLocked(watch);
+    } else if (state_.has_value()) {
+      watch->watcher()->Notify(*state_, status_);
+    }
+  }
+
+  void RemoveWatch(SharedHealthCheckWatch* watch) {
+    MutexLock lock(&mu_);
+    watches_.erase(watch);
+    if (watch != owner_) return;
+    client_.reset();
+    owner_ = nullptr;
+    if (!watches_.empty()) StartLocked(*watches_.begin());
+  }
+
+ private:
+  // Passes the health status reported by the stream of one generation to
+  // the SharedHealthCheckStream.
+  class StreamWatcher : public AsyncConnectivityStateWatcherInterface {
+   public:
+    StreamWatcher(RefCountedPtr<SharedHealthCheckStream> stream,
+                  uint64_t generation)
+        : stream_(std::move(stream)), generation_(generation) {}
+
+   private:
+    void OnConnectivityStateChange(grpc_connectivity_state new_state,
+                                   const absl::Status& status) override {
+      stream_->OnHealthStatusChange(generation_, new_state, status);
+    }
+
+    RefCountedPtr<SharedHealthCheckStream> stream_;
+    const uint64_t generation_;
+  };
+
+  // The stream's health status is reported asynchronously, so the stream
+  // may be created and destroyed while holding mu_.
+  void StartLocked(SharedHealthCheckWatch* owner)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    owner_ = owner;
+    ++generation_;
+    generation_reported_ = false;
+    client_ = MakeHealthCheckClient(
+        service_name_, owner->connected_subchannel(),
+        owner->interested_parties(), owner->channelz_node(),
+        MakeRefCounted<StreamWatcher>(Ref(), generation_));
+  }
+
+  void OnHealthStatusChange(uint64_t generation, grpc_connectivity_state state,
+                            const absl::Status& status) {
+    MutexLock lock(&mu_);
+    if (generation != generation_) return;
+    // A restarted stream starts out CONNECTING.  Keep reporting the last
+    // status until it has a real one, rather than making every watch
+    // flap because the owner went away.
+    if (!generation_reported_ && state_.has_value() &&
+        state == GRPC_CHANNEL_CONNECTING) {
+      return;
+    }
+    generation_reported_ = true;
+    state_ = state;
+    status_ = status;
+    for (SharedHealthCheckWatch* watch : watches_) {
+      watch->watcher()->Notify(state, status);
+    }
+  }
+
+  const std::string service_name_;
+  Mutex mu_;
+  std::set<SharedHealthCheckWatch*> watches_ ABSL_GUARDED_BY(mu_);
+  SharedHealthCheckWatch* owner_ ABSL_GUARDED_BY(mu_) = nullptr;
+  OrphanablePtr<SubchannelStreamClient> client_ ABSL_GUARDED_BY(mu_);
+  uint64_t generation_ ABSL_GUARDED_BY(mu_) = 0;
+  bool generation_reported_ ABSL_GUARDED_BY(mu_) = false;
+  absl::optional<grpc_connectivity_state> state_ ABSL_GUARDED_BY(mu_);
+  absl::Status status_ ABSL_GUARDED_BY(mu_);
+};
+
+// The SharedHealthCheckStreams in the process, keyed by address and service
+// name.  A stream is removed once its last watch goes away.
+class SharedHealthCheckStreamMap {
+ public:
+  static SharedHealthCheckStreamMap* Get() {
+    static SharedHealthCheckStreamMap* map = new SharedHealthCheckStreamMap();
+    return map;
+  }
+
+  RefCountedPtr<SharedHealthCheckStream> Ref(const std::string& address,
+                                             const std::string& service_name) {
+    MutexLock lock(&mu_);
+    Entry& entry = map_[std::make_pair(address, service_name)];
+    if (entry.stream == nullptr) {
+      entry.stream = MakeRefCounted<SharedHealthCheckStream>(service_name);
+    }
+    ++entry.num_watches;
+    return entry.stream;
+  }
+
+  void Unref(const std::string& address, const std::string& service_name) {
+    MutexLock lock(&mu_);
+    auto it = map_.find(std::make_pair(address, service_name));
+    GPR_ASSERT(it != map_.end());
+    if (--it->second.num_watches == 0) map_.erase(it);
+  }
+
+ private:
+  struct Entry {
+    RefCountedPtr<SharedHealthCheckStream> stream;
+    size_t num_watches = 0;
+  };
+
+  Mutex mu_;
+  std::map<std::pair<std::string, std::string>, Entry> map_
+      ABSL_GUARDED_BY(mu_);
+};
+
+SharedHealthCheckWatch::SharedHealthCheckWatch(
+    std::string address, std::string service_name,
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel,
+    grpc_pollset_set* interested_parties,
+    RefCountedPtr<channelz::SubchannelNode> channelz_node,
+    RefCountedPtr<ConnectivityStateWatcherInterface> watcher)
+    : address_(std::move(address)),
+      service_name_(std::move(service_name)),
+      connected_subchannel_(std::move(connected_subchannel)),
+      interested_parties_(interested_parties),
+      channelz_node_(std::move(channelz_node)),
+      watcher_(std::move(watcher)),
+      stream_(SharedHealthCheckStreamMap::Get()->Ref(address_, service_name_)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_health_check_client_trace)) {
+    gpr_log(GPR_INFO,
+            "SharedHealthCheckWatch %p: watching stream %p for {%s, %s}",
+            this, stream_.get(), address_.c_str(), service_name_.c_str());
+  }
+  stream_->AddWatch(this);
+}
+
+void SharedHealthCheckWatch::Orphan() {
+  stream_->RemoveWatch(this);
+  SharedHealthCheckStreamMap::Get()->Unref(address_, service_name_);
+  delete this;
+}
+
 }  // namespace
 
 OrphanablePtr<SubchannelStreamClient> MakeHealthCheckClient(
@@ -173,4 +369,16 @@ OrphanablePtr<SubchannelStreamClient> MakeHealthCheckClient(
           : nullptr);
 }
 
+OrphanablePtr<Orphanable> MakeSharedHealthCheckClient(
+    std::string address, std::string service_name,
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel,
+    grpc_pollset_set* interested_parties,
+    RefCountedPtr<channelz::SubchannelNode> channelz_node,
+    RefCountedPtr<ConnectivityStateWatcherInterface> watcher) {
+  return MakeOrphanable<SharedHealthCheckWatch>(
+      std::move(address), std::move(service_name),
+      std::move(connected_subchannel), interested_parties,
+      std::move(channelz_node), std::move(watcher));
+}
+
 }  // namespace grpc_core
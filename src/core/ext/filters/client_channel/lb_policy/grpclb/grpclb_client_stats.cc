@@ -22,54 +22,85 @@
 
 #include <string.h>
 
+#include <algorithm>
+
 #include "absl/memory/memory.h"
 
-#include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/string_util.h>
 
 #include "src/core/lib/gprpp/sync.h"
 
 namespace grpc_core {
 
+GrpcLbClientStats::GrpcLbClientStats()
+    : num_call_stats_(std::max(1u, gpr_cpu_num_cores())),
+      call_stats_(new CallStats[num_call_stats_]) {}
+
+GrpcLbClientStats::~GrpcLbClientStats() {
+  InternedDropToken* drop_token =
+      drop_tokens_.load(std::memory_order_relaxed);
+  while (drop_token != nullptr) {
+    InternedDropToken* next = drop_token->next;
+    delete drop_token;
+    drop_token = next;
+  }
+}
+
+GrpcLbClientStats::CallStats* GrpcLbClientStats::CurrentCallStats() {
+  return &call_stats_[gpr_cpu_current_cpu() % num_call_stats_];
+}
+
 void GrpcLbClientStats::AddCallStarted() {
-  gpr_atm_full_fetch_add(&num_calls_started_, (gpr_atm)1);
+  CurrentCallStats()->num_calls_started.fetch_add(1,
+                                                  std::memory_order_relaxed);
 }
 
 void GrpcLbClientStats::AddCallFinished(
     bool finished_with_client_failed_to_send, bool finished_known_received) {
-  gpr_atm_full_fetch_add(&num_calls_finished_, (gpr_atm)1);
+  CallStats* stats = CurrentCallStats();
+  stats->num_calls_finished.fetch_add(1, std::memory_order_relaxed);
   if (finished_with_client_failed_to_send) {
-    gpr_atm_full_fetch_add(&num_calls_finished_with_client_failed_to_send_,
-                           (gpr_atm)1);
+    stats->num_calls_finished_with_client_failed_to_send.fetch_add(
+        1, std::memory_order_relaxed);
   }
   if (finished_known_received) {
-    gpr_atm_full_fetch_add(&num_calls_finished_known_received_, (gpr_atm)1);
+    stats->num_calls_finished_known_received.fetch_add(
+        1, std::memory_order_relaxed);
   }
 }
 
+GrpcLbClientStats::InternedDropToken* GrpcLbClientStats::FindDropToken(
+    const char* token) {
+  InternedDropToken* head = drop_tokens_.load(std::memory_order_acquire);
+  for (InternedDropToken* t = head; t != nullptr; t = t->next) {
+    if (t->token == token) return t;
+  }
+  // Not found, so intern it.  Another thread may have added it, or other
+  // tokens, since we loaded the head.
+  MutexLock lock(&drop_token_mu_);
+  InternedDropToken* new_head = drop_tokens_.load(std::memory_order_relaxed);
+  for (InternedDropToken* t = new_head; t != head; t = t->next) {
+    if (t->token == token) return t;
+  }
+  InternedDropToken* drop_token = new InternedDropToken(token, new_head);
+  drop_tokens_.store(drop_token, std::memory_order_release);
+  return drop_token;
+}
+
 void GrpcLbClientStats::AddCallDropped(const char* token) {
   // Increment num_calls_started and num_calls_finished.
-  gpr_atm_full_fetch_add(&num_calls_started_, (gpr_atm)1);
-  gpr_atm_full_fetch_add(&num_calls_finished_, (gpr_atm)1);
+  CallStats* stats = CurrentCallStats();
+  stats->num_calls_started.fetch_add(1, std::memory_order_relaxed);
+  stats->num_calls_finished.fetch_add(1, std::memory_order_relaxed);
   // Record the drop.
-  MutexLock lock(&drop_count_mu_);
-  if (drop_token_counts_ == nullptr) {
-    drop_token_counts_ = absl::make_unique<DroppedCallCounts>();
-  }
-  for (size_t i = 0; i < drop_token_counts_->size(); ++i) {
-    if (strcmp((*drop_token_counts_)[i].token.get(), token) == 0) {
-      ++(*drop_token_counts_)[i].count;
-      return;
-    }
-  }
-  // Not found, so add a new entry.
-  drop_token_counts_->emplace_back(UniquePtr<char>(gpr_strdup(token)), 1);
+  FindDropToken(token)->count.fetch_add(1, std::memory_order_relaxed);
 }
 
 namespace {
 
-void AtomicGetAndResetCounter(int64_t* value, gpr_atm* counter) {
-  *value = static_cast<int64_t>(gpr_atm_full_xchg(counter, (gpr_atm)0));
+int64_t GetAndResetCounter(std::atomic<int64_t>* counter) {
+  return counter->exchange(0, std::memory_order_relaxed);
 }
 
 }  // namespace
@@ -79,14 +110,30 @@ void GrpcLbClientStats::Get(
     int64_t* num_calls_finished_with_client_failed_to_send,
     int64_t* num_calls_finished_known_received,
     std::unique_ptr<DroppedCallCounts>* drop_token_counts) {
-  AtomicGetAndResetCounter(num_calls_started, &num_calls_started_);
-  AtomicGetAndResetCounter(num_calls_finished, &num_calls_finished_);
-  AtomicGetAndResetCounter(num_calls_finished_with_client_failed_to_send,
-                           &num_calls_finished_with_client_failed_to_send_);
-  AtomicGetAndResetCounter(num_calls_finished_known_received,
-                           &num_calls_finished_known_received_);
-  MutexLock lock(&drop_count_mu_);
-  *drop_token_counts = std::move(drop_token_counts_);
+  *num_calls_started = 0;
+  *num_calls_finished = 0;
+  *num_calls_finished_with_client_failed_to_send = 0;
+  *num_calls_finished_known_received = 0;
+  for (size_t i = 0; i < num_call_stats_; ++i) {
+    CallStats& stats = call_stats_[i];
+    *num_calls_started += GetAndResetCounter(&stats.num_calls_started);
+    *num_calls_finished += GetAndResetCounter(&stats.num_calls_finished);
+    *num_calls_finished_with_client_failed_to_send += GetAndResetCounter(
+        &stats.num_calls_finished_with_client_failed_to_send);
+    *num_calls_finished_known_received +=
+        GetAndResetCounter(&stats.num_calls_finished_known_received);
+  }
+  drop_token_counts->reset();
+  for (InternedDropToken* t = drop_tokens_.load(std::memory_order_acquire);
+       t != nullptr; t = t->next) {
+    int64_t count = GetAndResetCounter(&t->count);
+    if (count == 0) continue;
+    if (*drop_token_counts == nullptr) {
+      *drop_token_counts = absl::make_unique<DroppedCallCounts>();
+    }
+    (*drop_token_counts)
+        ->emplace_back(UniquePtr<char>(gpr_strdup(t->token.c_str())), count);
+  }
 }
 
 }  // namespace grpc_core
@@ -23,14 +23,14 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/container/inlined_vector.h"
 
-#include <grpc/support/atm.h>
-
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/sync.h"
@@ -39,6 +39,9 @@ namespace grpc_core {
 
 class GrpcLbClientStats : public RefCounted<GrpcLbClientStats> {
  public:
+  GrpcLbClientStats();
+  ~GrpcLbClientStats() override;
+
   struct DropTokenCount {
     UniquePtr<char> token;
     int64_t count;
@@ -67,13 +70,35 @@ class GrpcLbClientStats : public RefCounted<GrpcLbClientStats> {
   }
 
  private:
-  gpr_atm num_calls_started_ = 0;
-  gpr_atm num_calls_finished_ = 0;
-  gpr_atm num_calls_finished_with_client_failed_to_send_ = 0;
-  gpr_atm num_calls_finished_known_received_ = 0;
-  Mutex drop_count_mu_;  // Guards drop_token_counts_.
-  std::unique_ptr<DroppedCallCounts> drop_token_counts_
-      ABSL_GUARDED_BY(drop_count_mu_);
+  // The call counts are kept in per-CPU slots, so that calls on different
+  // CPUs don't contend on the same cache line.  They are summed in Get().
+  struct CallStats {
+    std::atomic<int64_t> num_calls_started{0};
+    std::atomic<int64_t> num_calls_finished{0};
+    std::atomic<int64_t> num_calls_finished_with_client_failed_to_send{0};
+    std::atomic<int64_t> num_calls_finished_known_received{0};
+    char padding[GPR_CACHELINE_SIZE - 4 * sizeof(std::atomic<int64_t>)];
+  };
+
+  // A drop token seen by AddCallDropped().  Tokens are interned in a list
+  // that only grows, so that a drop only takes drop_token_mu_ the first time
+  // its token is seen.
+  struct InternedDropToken {
+    InternedDropToken(const char* token, InternedDropToken* next)
+        : token(token), next(next) {}
+
+    const std::string token;
+    std::atomic<int64_t> count{0};
+    InternedDropToken* const next;
+  };
+
+  CallStats* CurrentCallStats();
+  InternedDropToken* FindDropToken(const char* token);
+
+  const size_t num_call_stats_;
+  std::unique_ptr<CallStats[]> call_stats_;
+  Mutex drop_token_mu_;  // Serializes additions to drop_tokens_.
+  std::atomic<InternedDropToken*> drop_tokens_{nullptr};
 };
 
 }  // namespace grpc_core
@@ -0,0 +1,1063 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.h"
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/random/random.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "absl/types/variant.h"
+
+#include <grpc/impl/codegen/connectivity_state.h>
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy/child_policy_handler.h"
+#include "src/core/ext/filters/client_channel/lb_policy_factory.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/json/json_util.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_outlier_detection_lb_trace(false, "outlier_detection_lb");
+
+Json::Object OutlierDetectionConfig::ToJson() const {
+  Json::Object json = {
+      {"interval", interval.ToJsonString()},
+      {"baseEjectionTime", base_ejection_time.ToJsonString()},
+      {"maxEjectionTime", max_ejection_time.ToJsonString()},
+      {"maxEjectionPercent", max_ejection_percent},
+  };
+  if (success_rate_ejection.has_value()) {
+    json["successRateEjection"] = Json::Object{
+        {"stdevFactor", success_rate_ejection->stdev_factor},
+        {"enforcementPercentage",
+         success_rate_ejection->enforcement_percentage},
+        {"minimumHosts", success_rate_ejection->minimum_hosts},
+        {"requestVolume", success_rate_ejection->request_volume},
+    };
+  }
+  if (failure_percentage_ejection.has_value()) {
+    json["failurePercentageEjection"] = Json::Object{
+        {"threshold", failure_percentage_ejection->threshold},
+        {"enforcementPercentage",
+         failure_percentage_ejection->enforcement_percentage},
+        {"minimumHosts", failure_percentage_ejection->minimum_hosts},
+        {"requestVolume", failure_percentage_ejection->request_volume},
+    };
+  }
+  if (consecutive_failure_ejection.has_value()) {
+    json["consecutiveFailureEjection"] = Json::Object{
+        {"threshold", consecutive_failure_ejection->threshold},
+        {"enforcementPercentage",
+         consecutive_failure_ejection->enforcement_percentage},
+    };
+  }
+  return json;
+}
+
+namespace {
+
+constexpr char kOutlierDetection[] = "outlier_detection_experimental";
+
+// Config for the outlier_detection LB policy.
+class OutlierDetectionLbConfig : public LoadBalancingPolicy::Config {
+ public:
+  OutlierDetectionLbConfig(
+      OutlierDetectionConfig outlier_detection_config,
+      RefCountedPtr<LoadBalancingPolicy::Config> child_policy)
+      : outlier_detection_config_(std::move(outlier_detection_config)),
+        child_policy_(std::move(child_policy)) {}
+
+  const char* name() const override { return kOutlierDetection; }
+
+  const OutlierDetectionConfig& outlier_detection_config() const {
+    return outlier_detection_config_;
+  }
+  RefCountedPtr<LoadBalancingPolicy::Config> child_policy() const {
+    return child_policy_;
+  }
+
+ private:
+  OutlierDetectionConfig outlier_detection_config_;
+  RefCountedPtr<LoadBalancingPolicy::Config> child_policy_;
+};
+
+// outlier_detection LB policy. Wraps the subchannels of its child so that
+// ejected endpoints look like they are in TRANSIENT_FAILURE to the child.
+class OutlierDetectionLb : public LoadBalancingPolicy {
+ public:
+  explicit OutlierDetectionLb(Args args);
+
+  const char* name() const override { return kOutlierDetection; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ExitIdleLocked() override;
+  void ResetBackoffLocked() override;
+
+ private:
+  class SubchannelWrapper;
+
+  // Call results and ejection state of one endpoint address, shared by all
+  // subchannels created for that address. Call results are recorded from
+  // the data plane; everything else is only touched in the work
+  // serializer.
+  class SubchannelState : public RefCounted<SubchannelState> {
+   public:
+    void AddCallResult(bool success) {
+      Bucket* bucket = active_bucket_.load(std::memory_order_acquire);
+      if (success) {
+        bucket->successes.fetch_add(1, std::memory_order_relaxed);
+        // Avoids a write on the common path of a healthy endpoint.
+        if (consecutive_failures_.load(std::memory_order_relaxed) != 0) {
+          consecutive_failures_.store(0, std::memory_order_relaxed);
+        }
+      } else {
+        bucket->failures.fetch_add(1, std::memory_order_relaxed);
+        consecutive_failures_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    // Starts a new interval. The counts of the interval that just ended
+    // are then available from successes() and failures().
+    void RotateBucket() {
+      inactive_bucket_->successes.store(0, std::memory_order_relaxed);
+      inactive_bucket_->failures.store(0, std::memory_order_relaxed);
+      inactive_bucket_ = active_bucket_.exchange(inactive_bucket_,
+                                                 std::memory_order_acq_rel);
+    }
+
+    uint64_t successes() const {
+      return inactive_bucket_->successes.load(std::memory_order_relaxed);
+    }
+    uint64_t failures() const {
+      return inactive_bucket_->failures.load(std::memory_order_relaxed);
+    }
+    uint64_t request_volume() const { return successes() + failures(); }
+    uint32_t consecutive_failures() const {
+      return consecutive_failures_.load(std::memory_order_relaxed);
+    }
+
+    void AddSubchannel(SubchannelWrapper* wrapper) {
+      subchannels_.insert(wrapper);
+    }
+    void RemoveSubchannel(SubchannelWrapper* wrapper) {
+      subchannels_.erase(wrapper);
+    }
+
+    bool ejected() const { return ejection_time_.has_value(); }
+
+    void Eject(Timestamp now);
+    void Uneject();
+
+    // Unejects the endpoint once its ejection time is over, and lowers
+    // the multiplier of endpoints that stayed healthy for an interval.
+    void MaybeUneject(Duration base_ejection_time, Duration max_ejection_time);
+
+   private:
+    struct Bucket {
+      std::atomic<uint64_t> successes{0};
+      std::atomic<uint64_t> failures{0};
+    };
+
+    Bucket buckets_[2];
+    std::atomic<Bucket*> active_bucket_{&buckets_[0]};
+    Bucket* inactive_bucket_ = &buckets_[1];
+    std::atomic<uint32_t> consecutive_failures_{0};
+    absl::optional<Timestamp> ejection_time_;
+    uint32_t multiplier_ = 0;
+    std::set<SubchannelWrapper*> subchannels_;
+  };
+
+  class SubchannelWrapper : public DelegatingSubchannel {
+   public:
+    SubchannelWrapper(RefCountedPtr<SubchannelState> subchannel_state,
+                      RefCountedPtr<SubchannelInterface> subchannel)
+        : DelegatingSubchannel(std::move(subchannel)),
+          subchannel_state_(std::move(subchannel_state)) {
+      if (subchannel_state_ != nullptr) {
+        subchannel_state_->AddSubchannel(this);
+        ejected_ = subchannel_state_->ejected();
+      }
+    }
+
+    ~SubchannelWrapper() override {
+      if (subchannel_state_ != nullptr) {
+        subchannel_state_->RemoveSubchannel(this);
+      }
+    }
+
+    void Eject();
+    void Uneject();
+
+    grpc_connectivity_state CheckConnectivityState() override;
+    void WatchConnectivityState(
+        grpc_connectivity_state initial_state,
+        std::unique_ptr<ConnectivityStateWatcherInterface> watcher) override;
+    void CancelConnectivityStateWatch(
+        ConnectivityStateWatcherInterface* watcher) override;
+
+    SubchannelState* subchannel_state() const {
+      return subchannel_state_.get();
+    }
+
+   private:
+    // Reports TRANSIENT_FAILURE while the endpoint is ejected, and the
+    // latest state of the subchannel once it is unejected.
+    class WatcherWrapper : public ConnectivityStateWatcherInterface {
+     public:
+      WatcherWrapper(
+          std::unique_ptr<ConnectivityStateWatcherInterface> watcher,
+          bool ejected)
+          : watcher_(std::move(watcher)), ejected_(ejected) {}
+
+      void Eject() {
+        ejected_ = true;
+        if (last_seen_state_.has_value()) {
+          watcher_->OnConnectivityStateChange(
+              GRPC_CHANNEL_TRANSIENT_FAILURE);
+        }
+      }
+
+      void Uneject() {
+        ejected_ = false;
+        if (last_seen_state_.has_value()) {
+          watcher_->OnConnectivityStateChange(*last_seen_state_);
+        }
+      }
+
+      void OnConnectivityStateChange(
+          grpc_connectivity_state new_state) override {
+        last_seen_state_ = new_state;
+        if (!ejected_) watcher_->OnConnectivityStateChange(new_state);
+      }
+
+      grpc_pollset_set* interested_parties() override {
+        return watcher_->interested_parties();
+      }
+
+     private:
+      std::unique_ptr<ConnectivityStateWatcherInterface> watcher_;
+      absl::optional<grpc_connectivity_state> last_seen_state_;
+      bool ejected_;
+    };
+
+    RefCountedPtr<SubchannelState> subchannel_state_;
+    bool ejected_ = false;
+    std::map<ConnectivityStateWatcherInterface*, WatcherWrapper*> watchers_;
+  };
+
+  // A simple wrapper for ref-counting a picker from the child policy.
+  class RefCountedPicker : public RefCounted<RefCountedPicker> {
+   public:
+    explicit RefCountedPicker(std::unique_ptr<SubchannelPicker> picker)
+        : picker_(std::move(picker)) {}
+    PickResult Pick(PickArgs args) { return picker_->Pick(args); }
+
+   private:
+    std::unique_ptr<SubchannelPicker> picker_;
+  };
+
+  // A picker that wraps the picker from the child to count call results.
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(OutlierDetectionLb* outlier_detection_lb,
+           RefCountedPtr<RefCountedPicker> picker, bool counting_enabled);
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    class SubchannelCallTracker;
+
+    RefCountedPtr<RefCountedPicker> picker_;
+    bool counting_enabled_;
+  };
+
+  class Helper : public ChannelControlHelper {
+   public:
+    explicit Helper(RefCountedPtr<OutlierDetectionLb> outlier_detection_policy)
+        : outlier_detection_policy_(std::move(outlier_detection_policy)) {}
+
+    ~Helper() override {
+      outlier_detection_policy_.reset(DEBUG_LOCATION, "Helper");
+    }
+
+    RefCountedPtr<SubchannelInterface> CreateSubchannel(
+        ServerAddress address, const grpc_channel_args& args) override;
+    void UpdateState(grpc_connectivity_state state, const absl::Status& status,
+                     std::unique_ptr<SubchannelPicker> picker) override;
+    void RequestReresolution() override;
+    absl::string_view GetAuthority() override;
+    void AddTraceEvent(TraceSeverity severity,
+                       absl::string_view message) override;
+
+   private:
+    RefCountedPtr<OutlierDetectionLb> outlier_detection_policy_;
+  };
+
+  ~OutlierDetectionLb() override;
+
+  void ShutdownLocked() override;
+
+  OrphanablePtr<LoadBalancingPolicy> CreateChildPolicyLocked(
+      const grpc_channel_args* args);
+
+  void MaybeUpdatePickerLocked();
+
+  void StartEjectionTimerLocked();
+  static void OnEjectionTimer(void* arg, grpc_error_handle error);
+  void OnEjectionTimerLocked(grpc_error_handle error);
+  void EjectOutliersLocked();
+
+  static std::string MakeKeyForAddress(const ServerAddress& address);
+
+  // Current config from the resolver.
+  RefCountedPtr<OutlierDetectionLbConfig> config_;
+
+  // Internal state.
+  bool shutting_down_ = false;
+
+  OrphanablePtr<LoadBalancingPolicy> child_policy_;
+
+  // Latest state and picker reported by the child policy.
+  grpc_connectivity_state state_ = GRPC_CHANNEL_IDLE;
+  absl::Status status_;
+  RefCountedPtr<RefCountedPicker> picker_;
+
+  // Endpoints of the latest update, keyed by address.
+  std::map<std::string, RefCountedPtr<SubchannelState>> subchannel_state_map_;
+
+  // Periodically ejects and unejects endpoints.
+  grpc_timer ejection_timer_;
+  grpc_closure on_ejection_timer_;
+  bool ejection_timer_pending_ = false;
+};
+
+//
+// OutlierDetectionLb::SubchannelState
+//
+
+void OutlierDetectionLb::SubchannelState::Eject(Timestamp now) {
+  ejection_time_ = now;
+  ++multiplier_;
+  for (SubchannelWrapper* subchannel : subchannels_) subchannel->Eject();
+}
+
+void OutlierDetectionLb::SubchannelState::Uneject() {
+  ejection_time_.reset();
+  for (SubchannelWrapper* subchannel : subchannels_) subchannel->Uneject();
+}
+
+void OutlierDetectionLb::SubchannelState::MaybeUneject(
+    Duration base_ejection_time, Duration max_ejection_time) {
+  if (!ejection_time_.has_value()) {
+    if (multiplier_ > 0) --multiplier_;
+    return;
+  }
+  const Duration ejection_duration =
+      std::min(base_ejection_time * multiplier_,
+               std::max(base_ejection_time, max_ejection_time));
+  if (ExecCtx::Get()->Now() >= *ejection_time_ + ejection_duration) {
+    Uneject();
+  }
+}
+
+//
+// OutlierDetectionLb::SubchannelWrapper
+//
+
+void OutlierDetectionLb::SubchannelWrapper::Eject() {
+  ejected_ = true;
+  for (auto& p : watchers_) p.second->Eject();
+}
+
+void OutlierDetectionLb::SubchannelWrapper::Uneject() {
+  ejected_ = false;
+  for (auto& p : watchers_) p.second->Uneject();
+}
+
+grpc_connectivity_state
+OutlierDetectionLb::SubchannelWrapper::CheckConnectivityState() {
+  if (ejected_) return GRPC_CHANNEL_TRANSIENT_FAILURE;
+  return DelegatingSubchannel::CheckConnectivityState();
+}
+
+void OutlierDetectionLb::SubchannelWrapper::WatchConnectivityState(
+    grpc_connectivity_state initial_state,
+    std::unique_ptr<ConnectivityStateWatcherInterface> watcher) {
+  ConnectivityStateWatcherInterface* key = watcher.get();
+  auto watcher_wrapper =
+      absl::make_unique<WatcherWrapper>(std::move(watcher), ejected_);
+  watchers_[key] = watcher_wrapper.get();
+  DelegatingSubchannel::WatchConnectivityState(initial_state,
+                                               std::move(watcher_wrapper));
+}
+
+void OutlierDetectionLb::SubchannelWrapper::CancelConnectivityStateWatch(
+    ConnectivityStateWatcherInterface* watcher) {
+  auto it = watchers_.find(watcher);
+  if (it == watchers_.end()) return;
+  DelegatingSubchannel::CancelConnectivityStateWatch(it->second);
+  watchers_.erase(it);
+}
+
+//
+// OutlierDetectionLb::Picker::SubchannelCallTracker
+//
+
+class OutlierDetectionLb::Picker::SubchannelCallTracker
+    : public LoadBalancingPolicy::SubchannelCallTrackerInterface {
+ public:
+  SubchannelCallTracker(
+      std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>
+          original_subchannel_call_tracker,
+      RefCountedPtr<SubchannelState> subchannel_state)
+      : original_subchannel_call_tracker_(
+            std::move(original_subchannel_call_tracker)),
+        subchannel_state_(std::move(subchannel_state)) {}
+
+  ~SubchannelCallTracker() override {
+    subchannel_state_.reset(DEBUG_LOCATION, "SubchannelCallTracker");
+  }
+
+  void Start() override {
+    // Delegate if needed.
+    if (original_subchannel_call_tracker_ != nullptr) {
+      original_subchannel_call_tracker_->Start();
+    }
+  }
+
+  void Finish(FinishArgs args) override {
+    // Delegate if needed.
+    if (original_subchannel_call_tracker_ != nullptr) {
+      original_subchannel_call_tracker_->Finish(args);
+    }
+    // Record call completion for outlier detection.
+    subchannel_state_->AddCallResult(args.status.ok());
+  }
+
+ private:
+  std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>
+      original_subchannel_call_tracker_;
+  RefCountedPtr<SubchannelState> subchannel_state_;
+};
+
+//
+// OutlierDetectionLb::Picker
+//
+
+OutlierDetectionLb::Picker::Picker(OutlierDetectionLb* outlier_detection_lb,
+                                   RefCountedPtr<RefCountedPicker> picker,
+                                   bool counting_enabled)
+    : picker_(std::move(picker)), counting_enabled_(counting_enabled) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
+    gpr_log(GPR_INFO,
+            "[outlier_detection_lb %p] constructed new picker %p and counting "
+            "is %s",
+            outlier_detection_lb, this,
+            counting_enabled_ ? "enabled" : "disabled");
+  }
+}
+
+LoadBalancingPolicy::PickResult OutlierDetectionLb::Picker::Pick(
+    LoadBalancingPolicy::PickArgs args) {
+  if (picker_ == nullptr) {  // Should never happen.
+    return PickResult::Fail(absl::InternalError(
+        "outlier_detection picker not given any child picker"));
+  }
+  // Delegate to child picker.
+  PickResult result = picker_->Pick(args);
+  auto* complete_pick = absl::get_if<PickResult::Complete>(&result.result);
+  if (complete_pick != nullptr) {
+    auto* subchannel_wrapper =
+        static_cast<SubchannelWrapper*>(complete_pick->subchannel.get());
+    // Inject subchannel call tracker to record call completion.
+    SubchannelState* subchannel_state = subchannel_wrapper->subchannel_state();
+    if (counting_enabled_ && subchannel_state != nullptr) {
+      complete_pick->subchannel_call_tracker =
+          absl::make_unique<SubchannelCallTracker>(
+              std::move(complete_pick->subchannel_call_tracker),
+              subchannel_state->Ref(DEBUG_LOCATION, "SubchannelCallTracker"));
+    }
+    // Unwrap subchannel to pass back up the stack.
+    complete_pick->subchannel = subchannel_wrapper->wrapped_subchannel();
+  }
+  return result;
+}
+
+//
+// OutlierDetectionLb
+//
+
+OutlierDetectionLb::OutlierDetectionLb(Args args)
+    : LoadBalancingPolicy(std::move(args)) {
+  GRPC_CLOSURE_INIT(&on_ejection_timer_, OnEjectionTimer, this, nullptr);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
+    gpr_log(GPR_INFO, "[outlier_detection_lb %p] created", this);
+  }
+}
+
+OutlierDetectionLb::~OutlierDetectionLb() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
+    gpr_log(GPR_INFO,
+            "[outlier_detection_lb %p] destroying outlier_detection LB policy",
+            this);
+  }
+}
+
+void OutlierDetectionLb::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
+    gpr_log(GPR_INFO, "[outlier_detection_lb %p] shutting down", this);
+  }
+  shutting_down_ = true;
+  if (ejection_timer_pending_) grpc_timer_cancel(&ejection_timer_);
+  // Remove the child policy's interested_parties pollset_set from the
+  // outlier_detection policy.
+  if (child_policy_ != nullptr) {
+    grpc_pollset_set_del_pollset_set(child_policy_->interested_parties(),
+                                     interested_parties());
+    child_policy_.reset();
+  }
+  // Drop our ref to the child's picker, in case it's holding a ref to
+  // the child.
+  picker_.reset();
+}
+
+void OutlierDetectionLb::ExitIdleLocked() {
+  if (child_policy_ != nullptr) child_policy_->ExitIdleLocked();
+}
+
+void OutlierDetectionLb::ResetBackoffLocked() {
+  if (child_policy_ != nullptr) child_policy_->ResetBackoffLocked();
+}
+
+void OutlierDetectionLb::UpdateLocked(UpdateArgs args) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
+    gpr_log(GPR_INFO, "[outlier_detection_lb %p] Received update", this);
+  }
+  auto old_config = std::move(config_);
+  config_ = std::move(args.config);
+  const bool counting_enabled =
+      config_->outlier_detection_config().CountingEnabled();
+  if (counting_enabled) {
+    StartEjectionTimerLocked();
+  } else {
+    // Nothing gets ejected any more, so release what was ejected before.
+    if (ejection_timer_pending_) grpc_timer_cancel(&ejection_timer_);
+    for (auto& p : subchannel_state_map_) {
+      if (p.second->ejected()) p.second->Uneject();
+    }
+  }
+  // Keep the state of endpoints that are still present, so that an update
+  // does not reset their call counts or unejects them.
+  if (args.addresses.ok()) {
+    std::map<std::string, RefCountedPtr<SubchannelState>> subchannel_state_map;
+    for (const ServerAddress& address : *args.addresses) {
+      std::string key = MakeKeyForAddress(address);
+      if (key.empty()) continue;
+      auto it = subchannel_state_map_.find(key);
+      if (it != subchannel_state_map_.end()) {
+        subchannel_state_map.emplace(std::move(key), std::move(it->second));
+      } else {
+        subchannel_state_map.emplace(std::move(key),
+                                     MakeRefCounted<SubchannelState>());
+      }
+    }
+    subchannel_state_map_ = std::move(subchannel_state_map);
+  }
+  // Update picker if counting was toggled.
+  if (old_config == nullptr ||
+      old_config->outlier_detection_config().CountingEnabled() !=
+          counting_enabled) {
+    MaybeUpdatePickerLocked();
+  }
+  // Create policy if needed.
+  if (child_policy_ == nullptr) {
+    child_policy_ = CreateChildPolicyLocked(args.args);
+  }
+  // Update the child policy.
+  UpdateArgs update_args;
+  update_args.addresses = std::move(args.addresses);
+  update_args.resolution_note = std::move(args.resolution_note);
+  update_args.config = config_->child_policy();
+  update_args.args = grpc_channel_args_copy(args.args);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
+    gpr_log(GPR_INFO,
+            "[outlier_detection_lb %p] Updating child policy handler %p", this,
+            child_policy_.get());
+  }
+  child_policy_->UpdateLocked(std::move(update_args));
+}
+
+void OutlierDetectionLb::MaybeUpdatePickerLocked() {
+  // Update only if we have a child picker.
+  if (picker_ == nullptr) return;
+  auto outlier_detection_picker = absl::make_unique<Picker>(
+      this, picker_, config_->outlier_detection_config().CountingEnabled());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
+    gpr_log(GPR_INFO,
+            "[outlier_detection_lb %p] updating connectivity: state=%s "
+            "status=(%s) picker=%p",
+            this, ConnectivityStateName(state_), status_.ToString().c_str(),
+            outlier_detection_picker.get());
+  }
+  channel_control_helper()->UpdateState(state_, status_,
+                                        std::move(outlier_detection_picker));
+}
+
+OrphanablePtr<LoadBalancingPolicy> OutlierDetectionLb::CreateChildPolicyLocked(
+    const grpc_channel_args* args) {
+  LoadBalancingPolicy::Args lb_policy_args;
+  lb_policy_args.work_serializer = work_serializer();
+  lb_policy_args.args = args;
+  lb_policy_args.channel_control_helper =
+      absl::make_unique<Helper>(Ref(DEBUG_LOCATION, "Helper"));
+  OrphanablePtr<LoadBalancingPolicy> lb_policy =
+      MakeOrphanable<ChildPolicyHandler>(std::move(lb_policy_args),
+                                         &grpc_outlier_detection_lb_trace);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
+    gpr_log(GPR_INFO,
+            "[outlier_detection_lb %p] Created new child policy handler %p",
+            this, lb_policy.get());
+  }
+  // Add our interested_parties pollset_set to that of the newly created
+  // child policy. This will make the child policy progress upon activity on
+  // this policy, which in turn is tied to the application's call.
+  grpc_pollset_set_add_pollset_set(lb_policy->interested_parties(),
+                                   interested_parties());
+  return lb_policy;
+}
+
+void OutlierDetectionLb::StartEjectionTimerLocked() {
+  if (ejection_timer_pending_ || shutting_down_) return;
+  ejection_timer_pending_ = true;
+  Ref(DEBUG_LOCATION, "EjectionTimer").release();
+  grpc_timer_init(&ejection_timer_,
+                  ExecCtx::Get()->Now() +
+                      config_->outlier_detection_config().interval,
+                  &on_ejection_timer_);
+}
+
+void OutlierDetectionLb::OnEjectionTimer(void* arg, grpc_error_handle error) {
+  auto* self = static_cast<OutlierDetectionLb*>(arg);
+  (void)GRPC_ERROR_REF(error);  // ref owned by lambda
+  self->work_serializer()->Run(
+      [self, error]() { self->OnEjectionTimerLocked(error); }, DEBUG_LOCATION);
+}
+
+void OutlierDetectionLb::OnEjectionTimerLocked(grpc_error_handle error) {
+  ejection_timer_pending_ = false;
+  if (!shutting_down_ &&
+      config_->outlier_detection_config().CountingEnabled()) {
+    if (error == GRPC_ERROR_NONE) EjectOutliersLocked();
+    // Also restarts a timer that was cancelled when counting was disabled
+    // and has since been enabled again.
+    StartEjectionTimerLocked();
+  }
+  Unref(DEBUG_LOCATION, "EjectionTimer");
+  GRPC_ERROR_UNREF(error);
+}
+
+void OutlierDetectionLb::EjectOutliersLocked() {
+  const OutlierDetectionConfig& config = config_->outlier_detection_config();
+  const Timestamp now = ExecCtx::Get()->Now();
+  size_t ejected_count = 0;
+  for (auto& p : subchannel_state_map_) {
+    p.second->RotateBucket();
+    if (p.second->ejected()) ++ejected_count;
+  }
+  const size_t total_count = subchannel_state_map_.size();
+  absl::BitGen bit_gen;
+  // Ejects the endpoint if the enforcement roll and the cap on ejected
+  // endpoints allow it.
+  auto maybe_eject = [&](const std::string& address, SubchannelState* state,
+                         uint32_t enforcement_percentage,
+                         const char* algorithm) {
+    if (state->ejected()) return;
+    if (ejected_count * 100 >= config.max_ejection_percent * total_count) {
+      return;
+    }
+    if (absl::Uniform<uint32_t>(bit_gen, 0, 100) >= enforcement_percentage) {
+      return;
+    }
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
+      gpr_log(GPR_INFO, "[outlier_detection_lb %p] ejecting %s by %s", this,
+              address.c_str(), algorithm);
+    }
+    state->Eject(now);
+    ++ejected_count;
+  };
+  // Success rate: eject endpoints far below the mean of their peers.
+  if (config.success_rate_ejection.has_value()) {
+    const auto& success_rate_ejection = *config.success_rate_ejection;
+    std::vector<std::pair<const std::string*, SubchannelState*>> candidates;
+    double sum = 0;
+    for (auto& p : subchannel_state_map_) {
+      const uint64_t volume = p.second->request_volume();
+      if (volume == 0 || volume < success_rate_ejection.request_volume) {
+        continue;
+      }
+      candidates.emplace_back(&p.first, p.second.get());
+      sum += static_cast<double>(p.second->successes()) / volume;
+    }
+    if (!candidates.empty() &&
+        candidates.size() >= success_rate_ejection.minimum_hosts) {
+      const double mean = sum / candidates.size();
+      double variance = 0;
+      for (const auto& candidate : candidates) {
+        const double rate =
+            static_cast<double>(candidate.second->successes()) /
+            candidate.second->request_volume();
+        variance += (rate - mean) * (rate - mean);
+      }
+      const double stdev = std::sqrt(variance / candidates.size());
+      const double threshold =
+          mean - stdev * (success_rate_ejection.stdev_factor / 1000.0);
+      for (const auto& candidate : candidates) {
+        const double rate =
+            static_cast<double>(candidate.second->successes()) /
+            candidate.second->request_volume();
+        if (rate < threshold) {
+          maybe_eject(*candidate.first, candidate.second,
+                      success_rate_ejection.enforcement_percentage,
+                      "success rate");
+        }
+      }
+    }
+  }
+  // Failure percentage: eject endpoints failing more than the threshold.
+  if (config.failure_percentage_ejection.has_value()) {
+    const auto& failure_percentage_ejection =
+        *config.failure_percentage_ejection;
+    std::vector<std::pair<const std::string*, SubchannelState*>> candidates;
+    for (auto& p : subchannel_state_map_) {
+      const uint64_t volume = p.second->request_volume();
+      if (volume == 0 || volume < failure_percentage_ejection.request_volume) {
+        continue;
+      }
+      candidates.emplace_back(&p.first, p.second.get());
+    }
+    if (!candidates.empty() &&
+        candidates.size() >= failure_percentage_ejection.minimum_hosts) {
+      for (const auto& candidate : candidates) {
+        if (candidate.second->failures() * 100 >
+            failure_percentage_ejection.threshold *
+                candidate.second->request_volume()) {
+          maybe_eject(*candidate.first, candidate.second,
+                      failure_percentage_ejection.enforcement_percentage,
+                      "failure percentage");
+        }
+      }
+    }
+  }
+  // Consecutive failures: eject endpoints whose recent calls all failed.
+  if (config.consecutive_failure_ejection.has_value()) {
+    const auto& consecutive_failure_ejection =
+        *config.consecutive_failure_ejection;
+    for (auto& p : subchannel_state_map_) {
+      if (p.second->consecutive_failures() >=
+          consecutive_failure_ejection.threshold) {
+        maybe_eject(p.first, p.second.get(),
+                    consecutive_failure_ejection.enforcement_percentage,
+                    "consecutive failures");
+      }
+    }
+  }
+  // Uneject endpoints whose ejection time is over.
+  for (auto& p : subchannel_state_map_) {
+    const bool was_ejected = p.second->ejected();
+    p.second->MaybeUneject(config.base_ejection_time,
+                           config.max_ejection_time);
+    if (was_ejected && !p.second->ejected() &&
+        GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
+      gpr_log(GPR_INFO, "[outlier_detection_lb %p] unejecting %s", this,
+              p.first.c_str());
+    }
+  }
+}
+
+std::string OutlierDetectionLb::MakeKeyForAddress(
+    const ServerAddress& address) {
+  auto addr_str = grpc_sockaddr_to_string(&address.address(), false);
+  if (!addr_str.ok()) return "";
+  return std::move(*addr_str);
+}
+
+//
+// OutlierDetectionLb::Helper
+//
+
+RefCountedPtr<SubchannelInterface> OutlierDetectionLb::Helper::CreateSubchannel(
+    ServerAddress address, const grpc_channel_args& args) {
+  if (outlier_detection_policy_->shutting_down_) return nullptr;
+  RefCountedPtr<SubchannelState> subchannel_state;
+  std::string key = MakeKeyForAddress(address);
+  RefCountedPtr<SubchannelInterface> subchannel =
+      outlier_detection_policy_->channel_control_helper()->CreateSubchannel(
+          std::move(address), args);
+  if (subchannel == nullptr) return nullptr;
+  auto it = outlier_detection_policy_->subchannel_state_map_.find(key);
+  if (it != outlier_detection_policy_->subchannel_state_map_.end()) {
+    subchannel_state = it->second;
+  }
+  return MakeRefCounted<SubchannelWrapper>(std::move(subchannel_state),
+                                           std::move(subchannel));
+}
+
+void OutlierDetectionLb::Helper::UpdateState(
+    grpc_connectivity_state state, const absl::Status& status,
+    std::unique_ptr<SubchannelPicker> picker) {
+  if (outlier_detection_policy_->shutting_down_) return;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
+    gpr_log(GPR_INFO,
+            "[outlier_detection_lb %p] child connectivity state update: "
+            "state=%s (%s) picker=%p",
+            outlier_detection_policy_.get(), ConnectivityStateName(state),
+            status.ToString().c_str(), picker.get());
+  }
+  // Save the state and picker.
+  outlier_detection_policy_->state_ = state;
+  outlier_detection_policy_->status_ = status;
+  outlier_detection_policy_->picker_ =
+      MakeRefCounted<RefCountedPicker>(std::move(picker));
+  // Wrap the picker and return it to the channel.
+  outlier_detection_policy_->MaybeUpdatePickerLocked();
+}
+
+void OutlierDetectionLb::Helper::RequestReresolution() {
+  if (outlier_detection_policy_->shutting_down_) return;
+  outlier_detection_policy_->channel_control_helper()->RequestReresolution();
+}
+
+absl::string_view OutlierDetectionLb::Helper::GetAuthority() {
+  return outlier_detection_policy_->channel_control_helper()->GetAuthority();
+}
+
+void OutlierDetectionLb::Helper::AddTraceEvent(TraceSeverity severity,
+                                               absl::string_view message) {
+  if (outlier_detection_policy_->shutting_down_) return;
+  outlier_detection_policy_->channel_control_helper()->AddTraceEvent(severity,
+                                                                     message);
+}
+
+//
+// factory
+//
+
+class OutlierDetectionLbFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<OutlierDetectionLb>(std::move(args));
+  }
+
+  const char* name() const override { return kOutlierDetection; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const Json& json, grpc_error_handle* error) const override {
+    GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+    if (json.type() == Json::Type::JSON_NULL) {
+      // This policy was configured in the deprecated loadBalancingPolicy
+      // field or in the client API.
+      *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:loadBalancingPolicy error:outlier_detection policy requires "
+          "configuration. Please use loadBalancingConfig field of service "
+          "config instead.");
+      return nullptr;
+    }
+    std::vector<grpc_error_handle> error_list;
+    const Json::Object& object = json.object_value();
+    OutlierDetectionConfig config;
+    ParseJsonObjectFieldAsDuration(object, "interval", &config.interval,
+                                   &error_list, /*required=*/false);
+    ParseJsonObjectFieldAsDuration(object, "baseEjectionTime",
+                                   &config.base_ejection_time, &error_list,
+                                   /*required=*/false);
+    ParseJsonObjectFieldAsDuration(object, "maxEjectionTime",
+                                   &config.max_ejection_time, &error_list,
+                                   /*required=*/false);
+    ParseJsonObjectField(object, "maxEjectionPercent",
+                         &config.max_ejection_percent, &error_list,
+                         /*required=*/false);
+    if (config.interval <= Duration::Zero()) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:interval error:must be positive"));
+    }
+    if (config.max_ejection_percent > 100) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:maxEjectionPercent error:must be <= 100"));
+    }
+    const Json::Object* sub_object;
+    if (ParseJsonObjectField(object, "successRateEjection", &sub_object,
+                             &error_list, /*required=*/false)) {
+      OutlierDetectionConfig::SuccessRateEjection success_rate_ejection;
+      std::vector<grpc_error_handle> child_errors;
+      ParseJsonObjectField(*sub_object, "stdevFactor",
+                           &success_rate_ejection.stdev_factor, &child_errors,
+                           /*required=*/false);
+      ParseJsonObjectField(*sub_object, "enforcementPercentage",
+                           &success_rate_ejection.enforcement_percentage,
+                           &child_errors, /*required=*/false);
+      ParseJsonObjectField(*sub_object, "minimumHosts",
+                           &success_rate_ejection.minimum_hosts,
+                           &child_errors, /*required=*/false);
+      ParseJsonObjectField(*sub_object, "requestVolume",
+                           &success_rate_ejection.request_volume,
+                           &child_errors, /*required=*/false);
+      if (success_rate_ejection.enforcement_percentage > 100) {
+        child_errors.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:enforcementPercentage error:must be <= 100"));
+      }
+      if (!child_errors.empty()) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_VECTOR(
+            "field:successRateEjection", &child_errors));
+      }
+      config.success_rate_ejection = success_rate_ejection;
+    }
+    if (ParseJsonObjectField(object, "failurePercentageEjection", &sub_object,
+                             &error_list, /*required=*/false)) {
+      OutlierDetectionConfig::FailurePercentageEjection
+          failure_percentage_ejection;
+      std::vector<grpc_error_handle> child_errors;
+      ParseJsonObjectField(*sub_object, "threshold",
+                           &failure_percentage_ejection.threshold,
+                           &child_errors, /*required=*/false);
+      ParseJsonObjectField(*sub_object, "enforcementPercentage",
+                           &failure_percentage_ejection.enforcement_percentage,
+                           &child_errors, /*required=*/false);
+      ParseJsonObjectField(*sub_object, "minimumHosts",
+                           &failure_percentage_ejection.minimum_hosts,
+                           &child_errors, /*required=*/false);
+      ParseJsonObjectField(*sub_object, "requestVolume",
+                           &failure_percentage_ejection.request_volume,
+                           &child_errors, /*required=*/false);
+      if (failure_percentage_ejection.threshold > 100) {
+        child_errors.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:threshold error:must be <= 100"));
+      }
+      if (failure_percentage_ejection.enforcement_percentage > 100) {
+        child_errors.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:enforcementPercentage error:must be <= 100"));
+      }
+      if (!child_errors.empty()) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_VECTOR(
+            "field:failurePercentageEjection", &child_errors));
+      }
+      config.failure_percentage_ejection = failure_percentage_ejection;
+    }
+    if (ParseJsonObjectField(object, "consecutiveFailureEjection", &sub_object,
+                             &error_list, /*required=*/false)) {
+      OutlierDetectionConfig::ConsecutiveFailureEjection
+          consecutive_failure_ejection;
+      std::vector<grpc_error_handle> child_errors;
+      ParseJsonObjectField(*sub_object, "threshold",
+                           &consecutive_failure_ejection.threshold,
+                           &child_errors, /*required=*/false);
+      ParseJsonObjectField(
+          *sub_object, "enforcementPercentage",
+          &consecutive_failure_ejection.enforcement_percentage, &child_errors,
+          /*required=*/false);
+      if (consecutive_failure_ejection.threshold == 0) {
+        child_errors.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:threshold error:must be positive"));
+      }
+      if (consecutive_failure_ejection.enforcement_percentage > 100) {
+        child_errors.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:enforcementPercentage error:must be <= 100"));
+      }
+      if (!child_errors.empty()) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_VECTOR(
+            "field:consecutiveFailureEjection", &child_errors));
+      }
+      config.consecutive_failure_ejection = consecutive_failure_ejection;
+    }
+    // Child policy.
+    RefCountedPtr<LoadBalancingPolicy::Config> child_policy;
+    auto it = object.find("childPolicy");
+    if (it == object.end()) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:childPolicy error:required field missing"));
+    } else {
+      grpc_error_handle parse_error = GRPC_ERROR_NONE;
+      child_policy = LoadBalancingPolicyRegistry::ParseLoadBalancingConfig(
+          it->second, &parse_error);
+      if (child_policy == nullptr) {
+        GPR_DEBUG_ASSERT(parse_error != GRPC_ERROR_NONE);
+        std::vector<grpc_error_handle> child_errors;
+        child_errors.push_back(parse_error);
+        error_list.push_back(
+            GRPC_ERROR_CREATE_FROM_VECTOR("field:childPolicy", &child_errors));
+      }
+    }
+    if (!error_list.empty()) {
+      *error = GRPC_ERROR_CREATE_FROM_VECTOR(
+          "outlier_detection_experimental LB policy config", &error_list);
+      return nullptr;
+    }
+    return MakeRefCounted<OutlierDetectionLbConfig>(std::move(config),
+                                                    std::move(child_policy));
+  }
+};
+
+}  // namespace
+
+}  // namespace grpc_core
+
+//
+// Plugin registration
+//
+
+void grpc_lb_policy_outlier_detection_init() {
+  grpc_core::LoadBalancingPolicyRegistry::Builder::
+      RegisterLoadBalancingPolicyFactory(
+          absl::make_unique<grpc_core::OutlierDetectionLbFactory>());
+}
+
+void grpc_lb_policy_outlier_detection_shutdown() {}
@@ -17,11 +17,14 @@
 #include <grpc/support/port_platform.h>
 
 #include <inttypes.h>
+#include <limits.h>
 #include <string.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/container/inlined_vector.h"
 #include "absl/memory/memory.h"
@@ -38,12 +41,17 @@
 #include "src/core/ext/filters/client_channel/lb_policy_factory.h"
 #include "src/core/ext/filters/client_channel/lb_policy_registry.h"
 #include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/resolver/server_address.h"
 #include "src/core/lib/transport/connectivity_state.h"
@@ -118,13 +126,42 @@ class PickFirst : public LoadBalancingPolicy {
       p->Unref(DEBUG_LOCATION, "subchannel_list");
     }
 
+    void Orphan() override {
+      CancelConnectionAttemptTimerLocked();
+      SubchannelList::Orphan();
+    }
+
     bool in_transient_failure() const { return in_transient_failure_; }
     void set_in_transient_failure(bool in_transient_failure) {
       in_transient_failure_ = in_transient_failure;
     }
 
+    // Starts connecting to the next subchannel in the list, if any. With a
+    // connection attempt delay, the one after it is started when the delay
+    // elapses, unless an attempt succeeds or fails first.
+    void StartNextConnectionAttemptLocked();
+    // Starts a new pass over the list from its first subchannel.
+    void RestartConnectionAttemptsLocked() {
+      next_attempt_index_ = 0;
+      StartNextConnectionAttemptLocked();
+    }
+    // Returns true if the current pass has not reached the end of the list.
+    bool HasMoreConnectionAttemptsLocked() const {
+      return next_attempt_index_ < num_subchannels();
+    }
+    // Returns true if a subchannel of the current pass is still connecting.
+    bool HasConnectionAttemptsInFlightLocked();
+    void CancelConnectionAttemptTimerLocked();
+
    private:
+    static void OnConnectionAttemptTimer(void* arg, grpc_error_handle error);
+    void OnConnectionAttemptTimerLocked(grpc_error_handle error);
+
     bool in_transient_failure_ = false;
+    size_t next_attempt_index_ = 0;
+    grpc_timer connection_attempt_timer_;
+    grpc_closure on_connection_attempt_timer_;
+    bool connection_attempt_timer_pending_ = false;
   };
 
   class Picker : public SubchannelPicker {
@@ -144,6 +181,10 @@ class PickFirst : public LoadBalancingPolicy {
 
   void AttemptToConnectUsingLatestUpdateArgsLocked();
 
+  // Delay before starting a connection attempt to the next address while the
+  // previous one is still in progress (RFC 8305). Zero disables parallel
+  // attempts.
+  const Duration connection_attempt_delay_;
   // Lateset update args.
   UpdateArgs latest_update_args_;
   // All our subchannels.
@@ -158,7 +199,43 @@ class PickFirst : public LoadBalancingPolicy {
   bool shutdown_ = false;
 };
 
-PickFirst::PickFirst(Args args) : LoadBalancingPolicy(std::move(args)) {
+// Reorders the addresses so that address families alternate, starting with
+// the family of the first address, as described in RFC 8305 section 4.
+// Addresses of the same family keep their relative order.
+ServerAddressList InterleaveAddressFamilies(ServerAddressList addresses) {
+  std::vector<std::pair<int, std::vector<ServerAddress*>>> families;
+  for (ServerAddress& address : addresses) {
+    int family = grpc_sockaddr_get_family(&address.address());
+    auto it = std::find_if(
+        families.begin(), families.end(),
+        [family](const std::pair<int, std::vector<ServerAddress*>>& entry) {
+          return entry.first == family;
+        });
+    if (it == families.end()) {
+      families.emplace_back(family, std::vector<ServerAddress*>());
+      it = families.end() - 1;
+    }
+    it->second.push_back(&address);
+  }
+  if (families.size() < 2) return addresses;
+  ServerAddressList interleaved;
+  interleaved.reserve(addresses.size());
+  for (size_t i = 0; interleaved.size() < addresses.size(); ++i) {
+    for (auto& family : families) {
+      if (i < family.second.size()) {
+        interleaved.push_back(std::move(*family.second[i]));
+      }
+    }
+  }
+  return interleaved;
+}
+
+PickFirst::PickFirst(Args args)
+    : LoadBalancingPolicy(std::move(args)),
+      connection_attempt_delay_(Duration::Milliseconds(
+          grpc_channel_args_find_integer(
+              args.args, GRPC_ARG_HAPPY_EYEBALLS_CONNECTION_ATTEMPT_DELAY_MS,
+              {0, 0, INT_MAX}))) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
     gpr_log(GPR_INFO, "Pick First %p created.", this);
   }
@@ -205,6 +282,9 @@ void PickFirst::AttemptToConnectUsingLatestUpdateArgsLocked() {
   if (latest_update_args_.addresses.ok()) {
     addresses = *latest_update_args_.addresses;
   }
+  if (connection_attempt_delay_ > Duration::Zero()) {
+    addresses = InterleaveAddressFamilies(std::move(addresses));
+  }
   auto subchannel_list = MakeOrphanable<PickFirstSubchannelList>(
       this, std::move(addresses), *latest_update_args_.args);
   // Empty update or no valid subchannels.
@@ -252,11 +332,7 @@ void PickFirst::AttemptToConnectUsingLatestUpdateArgsLocked() {
     subchannel_list_ = std::move(subchannel_list);
     // If we're not in IDLE state, start trying to connect to the first
     // subchannel in the new list.
-    // Note: No need to use CheckConnectivityStateAndStartWatchingLocked()
-    // here, since we've already checked the initial connectivity
-    // state of all subchannels above.
-    subchannel_list_->subchannel(0)->StartConnectivityWatchLocked();
-    subchannel_list_->subchannel(0)->subchannel()->RequestConnection();
+    subchannel_list_->StartNextConnectionAttemptLocked();
   } else {
     // We do have a selected subchannel (which means it's READY), so keep
     // using it until one of the subchannels in the new list reports READY.
@@ -272,14 +348,7 @@ void PickFirst::AttemptToConnectUsingLatestUpdateArgsLocked() {
     latest_pending_subchannel_list_ = std::move(subchannel_list);
     // If we're not in IDLE state, start trying to connect to the first
     // subchannel in the new list.
-    // Note: No need to use CheckConnectivityStateAndStartWatchingLocked()
-    // here, since we've already checked the initial connectivity
-    // state of all subchannels above.
-    latest_pending_subchannel_list_->subchannel(0)
-        ->StartConnectivityWatchLocked();
-    latest_pending_subchannel_list_->subchannel(0)
-        ->subchannel()
-        ->RequestConnection();
+    latest_pending_subchannel_list_->StartNextConnectionAttemptLocked();
   }
 }
 
@@ -395,46 +464,48 @@ void PickFirst::PickFirstSubchannelData::ProcessConnectivityChangeLocked(
     case GRPC_CHANNEL_TRANSIENT_FAILURE:
     case GRPC_CHANNEL_IDLE: {
       CancelConnectivityWatchLocked("connection attempt failed");
-      PickFirstSubchannelData* sd = this;
-      size_t next_index =
-          (sd->Index() + 1) % subchannel_list()->num_subchannels();
-      sd = subchannel_list()->subchannel(next_index);
-      // If we're tried all subchannels, set state to TRANSIENT_FAILURE.
-      if (sd->Index() == 0) {
+      // Move on to the next subchannel right away, without waiting for the
+      // connection attempt delay.
+      if (subchannel_list()->HasMoreConnectionAttemptsLocked()) {
+        subchannel_list()->StartNextConnectionAttemptLocked();
+        break;
+      }
+      // Wait for the attempts that are still in progress.
+      if (subchannel_list()->HasConnectionAttemptsInFlightLocked()) break;
+      // We've tried all subchannels, so set state to TRANSIENT_FAILURE.
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
+        gpr_log(GPR_INFO,
+                "Pick First %p subchannel list %p failed to connect to "
+                "all subchannels",
+                p, subchannel_list());
+      }
+      subchannel_list()->set_in_transient_failure(true);
+      // In case 2, swap to the new subchannel list.  This means reporting
+      // TRANSIENT_FAILURE and dropping the existing (working) connection,
+      // but we can't ignore what the control plane has told us.
+      if (subchannel_list() == p->latest_pending_subchannel_list_.get()) {
         if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
           gpr_log(GPR_INFO,
-                  "Pick First %p subchannel list %p failed to connect to "
-                  "all subchannels",
-                  p, subchannel_list());
-        }
-        subchannel_list()->set_in_transient_failure(true);
-        // In case 2, swap to the new subchannel list.  This means reporting
-        // TRANSIENT_FAILURE and dropping the existing (working) connection,
-        // but we can't ignore what the control plane has told us.
-        if (subchannel_list() == p->latest_pending_subchannel_list_.get()) {
-          if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
-            gpr_log(GPR_INFO,
-                    "Pick First %p promoting pending subchannel list %p to "
-                    "replace %p",
-                    p, p->latest_pending_subchannel_list_.get(),
-                    p->subchannel_list_.get());
-          }
-          p->selected_ = nullptr;  // owned by p->subchannel_list_
-          p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
-        }
-        // If this is the current subchannel list (either because we were
-        // in case 1 or because we were in case 2 and just promoted it to
-        // be the current list), re-resolve and report new state.
-        if (subchannel_list() == p->subchannel_list_.get()) {
-          p->channel_control_helper()->RequestReresolution();
-          absl::Status status =
-              absl::UnavailableError("failed to connect to all addresses");
-          p->channel_control_helper()->UpdateState(
-              GRPC_CHANNEL_TRANSIENT_FAILURE, status,
-              absl::make_unique<TransientFailurePicker>(status));
+                  "Pick First %p promoting pending subchannel list %p to "
+                  "replace %p",
+                  p, p->latest_pending_subchannel_list_.get(),
+                  p->subchannel_list_.get());
         }
+        p->selected_ = nullptr;  // owned by p->subchannel_list_
+        p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+      }
+      // If this is the current subchannel list (either because we were
+      // in case 1 or because we were in case 2 and just promoted it to
+      // be the current list), re-resolve and report new state.
+      if (subchannel_list() == p->subchannel_list_.get()) {
+        p->channel_control_helper()->RequestReresolution();
+        absl::Status status =
+            absl::UnavailableError("failed to connect to all addresses");
+        p->channel_control_helper()->UpdateState(
+            GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+            absl::make_unique<TransientFailurePicker>(status));
       }
-      sd->CheckConnectivityStateAndStartWatchingLocked();
+      subchannel_list()->RestartConnectionAttemptsLocked();
       break;
     }
     case GRPC_CHANNEL_CONNECTING: {
@@ -483,6 +554,7 @@ void PickFirst::PickFirstSubchannelData::ProcessUnselectedReadyLocked() {
     gpr_log(GPR_INFO, "Pick First %p selected subchannel %p", p, subchannel());
   }
   p->selected_ = this;
+  subchannel_list()->CancelConnectionAttemptTimerLocked();
   p->channel_control_helper()->UpdateState(
       GRPC_CHANNEL_READY, absl::Status(),
       absl::make_unique<Picker>(subchannel()->Ref()));
@@ -511,6 +583,70 @@ void PickFirst::PickFirstSubchannelData::
   }
 }
 
+//
+// PickFirst::PickFirstSubchannelList
+//
+
+void PickFirst::PickFirstSubchannelList::StartNextConnectionAttemptLocked() {
+  CancelConnectionAttemptTimerLocked();
+  if (!HasMoreConnectionAttemptsLocked()) return;
+  PickFirst* p = static_cast<PickFirst*>(policy());
+  PickFirstSubchannelData* sd = subchannel(next_attempt_index_++);
+  // This may select the subchannel right away if it is already READY.
+  sd->CheckConnectivityStateAndStartWatchingLocked();
+  if (p->selected_ == sd || p->connection_attempt_delay_ == Duration::Zero() ||
+      !HasMoreConnectionAttemptsLocked()) {
+    return;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_pick_first_trace)) {
+    gpr_log(GPR_INFO,
+            "Pick First %p subchannel list %p: starting next connection "
+            "attempt in %" PRId64 "ms",
+            p, this, p->connection_attempt_delay_.millis());
+  }
+  Ref(DEBUG_LOCATION, "connection_attempt_timer").release();
+  GRPC_CLOSURE_INIT(&on_connection_attempt_timer_, OnConnectionAttemptTimer,
+                    this, nullptr);
+  connection_attempt_timer_pending_ = true;
+  grpc_timer_init(&connection_attempt_timer_,
+                  ExecCtx::Get()->Now() + p->connection_attempt_delay_,
+                  &on_connection_attempt_timer_);
+}
+
+bool PickFirst::PickFirstSubchannelList::HasConnectionAttemptsInFlightLocked() {
+  for (size_t i = 0; i < next_attempt_index_; ++i) {
+    if (subchannel(i)->connectivity_watch_started()) return true;
+  }
+  return false;
+}
+
+void PickFirst::PickFirstSubchannelList::CancelConnectionAttemptTimerLocked() {
+  if (connection_attempt_timer_pending_) {
+    connection_attempt_timer_pending_ = false;
+    grpc_timer_cancel(&connection_attempt_timer_);
+  }
+}
+
+void PickFirst::PickFirstSubchannelList::OnConnectionAttemptTimer(
+    void* arg, grpc_error_handle error) {
+  auto* self = static_cast<PickFirstSubchannelList*>(arg);
+  (void)GRPC_ERROR_REF(error);  // ref owned by lambda
+  static_cast<PickFirst*>(self->policy())
+      ->work_serializer()
+      ->Run([self, error]() { self->OnConnectionAttemptTimerLocked(error); },
+            DEBUG_LOCATION);
+}
+
+void PickFirst::PickFirstSubchannelList::OnConnectionAttemptTimerLocked(
+    grpc_error_handle error) {
+  if (error == GRPC_ERROR_NONE && connection_attempt_timer_pending_) {
+    connection_attempt_timer_pending_ = false;
+    if (!shutting_down()) StartNextConnectionAttemptLocked();
+  }
+  Unref(DEBUG_LOCATION, "connection_attempt_timer");
+  GRPC_ERROR_UNREF(error);
+}
+
 class PickFirstConfig : public LoadBalancingPolicy::Config {
  public:
   const char* name() const override { return kPickFirst; }
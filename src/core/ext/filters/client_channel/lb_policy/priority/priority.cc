@@ -281,11 +281,18 @@ class PriorityLb : public LoadBalancingPolicy {
   void ChoosePriorityLocked(bool report_connecting);
 
   // Sets the specified priority as the current priority.
-  // Deactivates any children at lower priorities.
+  // Pre-warms the next prewarm_children_ priorities and deactivates any
+  // children at lower priorities.
   // Returns the child's picker to the channel.
   void SetCurrentPriorityLocked(uint32_t priority);
 
+  // Creates or reactivates the child for a priority below the current one
+  // and has it connect, without using it.
+  void PrewarmChildLocked(uint32_t priority);
+
   const Duration child_failover_timeout_;
+  // How many priorities below the current one to keep connected.
+  const uint32_t prewarm_children_;
 
   // Current channel args and config from the resolver.
   const grpc_channel_args* args_ = nullptr;
@@ -318,7 +325,9 @@ PriorityLb::PriorityLb(Args args)
           Duration::Milliseconds(grpc_channel_args_find_integer(
               args.args, GRPC_ARG_PRIORITY_FAILOVER_TIMEOUT_MS,
               {static_cast<int>(kDefaultChildFailoverTimeout.millis()), 0,
-               INT_MAX}))) {
+               INT_MAX}))),
+      prewarm_children_(grpc_channel_args_find_integer(
+          args.args, GRPC_ARG_PRIORITY_PREWARM_CHILDREN, {0, 0, INT_MAX})) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_priority_trace)) {
     gpr_log(GPR_INFO, "[priority_lb %p] created", this);
   }
@@ -502,8 +511,27 @@ void PriorityLb::ChoosePriorityLocked(bool report_connecting) {
       return;
     }
     // Child is not READY or IDLE.
-    // If its failover timer is still pending, give it time to fire.
+    // If its failover timer is still pending, give it time to fire, unless
+    // a pre-warmed lower priority is already READY: use that one in the
+    // meantime.
     if (child->FailoverTimerPending()) {
+      for (uint32_t p = priority + 1;
+           p <= priority + prewarm_children_ &&
+           p < config_->priorities().size();
+           ++p) {
+        auto it = children_.find(config_->priorities()[p]);
+        if (it != children_.end() &&
+            it->second->connectivity_state() == GRPC_CHANNEL_READY) {
+          if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_priority_trace)) {
+            gpr_log(GPR_INFO,
+                    "[priority_lb %p] priority %u, child %s: child still "
+                    "attempting to connect, using pre-warmed priority %u",
+                    this, priority, child_name.c_str(), p);
+          }
+          SetCurrentPriorityLocked(p);
+          return;
+        }
+      }
       if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_priority_trace)) {
         gpr_log(GPR_INFO,
                 "[priority_lb %p] priority %u, child %s: child still "
@@ -547,8 +575,12 @@ void PriorityLb::SetCurrentPriorityLocked(uint32_t priority) {
   }
   current_priority_ = priority;
   current_child_from_before_update_ = nullptr;
-  // Deactivate lower priorities.
+  // Pre-warm the next priorities and deactivate the lower ones.
   for (uint32_t p = priority + 1; p < config_->priorities().size(); ++p) {
+    if (p <= priority + prewarm_children_) {
+      PrewarmChildLocked(p);
+      continue;
+    }
     const std::string& child_name = config_->priorities()[p];
     auto it = children_.find(child_name);
     if (it != children_.end()) it->second->MaybeDeactivateLocked();
@@ -560,6 +592,31 @@ void PriorityLb::SetCurrentPriorityLocked(uint32_t priority) {
                                         child->GetPicker());
 }
 
+void PriorityLb::PrewarmChildLocked(uint32_t priority) {
+  const std::string& child_name = config_->priorities()[priority];
+  // The child's state updates are ignored while we set it up: it is not
+  // in use, and ChoosePriorityLocked() will see its state when needed.
+  bool update_in_progress = update_in_progress_;
+  update_in_progress_ = true;
+  auto& child = children_[child_name];
+  if (child == nullptr) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_priority_trace)) {
+      gpr_log(GPR_INFO, "[priority_lb %p] pre-warming priority %u, child %s",
+              this, priority, child_name.c_str());
+    }
+    child = MakeOrphanable<ChildPriority>(Ref(DEBUG_LOCATION, "ChildPriority"),
+                                          child_name);
+    auto child_config = config_->children().find(child_name);
+    GPR_DEBUG_ASSERT(child_config != config_->children().end());
+    child->UpdateLocked(child_config->second.config,
+                        child_config->second.ignore_reresolution_requests);
+  } else {
+    child->MaybeReactivateLocked();
+  }
+  child->ExitIdleLocked();
+  update_in_progress_ = update_in_progress;
+}
+
 //
 // PriorityLb::ChildPriority::DeactivationTimer
 //
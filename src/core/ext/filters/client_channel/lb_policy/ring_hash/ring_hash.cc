@@ -16,12 +16,15 @@
 
 #include <grpc/support/port_platform.h>
 
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+
 #include <inttypes.h>
 #include <stdlib.h>
 
 #include <algorithm>
 #include <atomic>
 #include <cmath>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -112,21 +115,202 @@ void ParseRingHashLbConfig(const Json& json, size_t* min_ring_size,
   }
 }
 
+//
+// RingHashTable
+//
+
+RingHashTable RingHashTable::MakeRing(const std::vector<Endpoint>& endpoints,
+                                      size_t min_ring_size,
+                                      size_t max_ring_size) {
+  size_t sum = 0;
+  for (const Endpoint& endpoint : endpoints) sum += endpoint.weight;
+  // Calculating normalized weights and find min.
+  std::vector<double> normalized_weights;
+  normalized_weights.reserve(endpoints.size());
+  double min_normalized_weight = 1.0;
+  for (const Endpoint& endpoint : endpoints) {
+    normalized_weights.push_back(static_cast<double>(endpoint.weight) / sum);
+    min_normalized_weight =
+        std::min(normalized_weights.back(), min_normalized_weight);
+  }
+  // Scale up the number of hashes per host such that the least-weighted host
+  // gets a whole number of hashes on the ring. Other hosts might not end up
+  // with whole numbers, and that's fine (the ring-building algorithm below can
+  // handle this). This preserves the original implementation's behavior: when
+  // weights aren't provided, all hosts should get an equal number of hashes. In
+  // the case where this number exceeds the max_ring_size, it's scaled back down
+  // to fit.
+  const double scale = std::min(
+      std::ceil(min_normalized_weight * min_ring_size) / min_normalized_weight,
+      static_cast<double>(max_ring_size));
+  // Reserve memory for the entire ring up front.
+  const uint64_t ring_size = std::ceil(scale);
+  struct Entry {
+    uint64_t hash;
+    uint32_t endpoint_index;
+  };
+  std::vector<Entry> entries;
+  entries.reserve(ring_size);
+  // Populate the hash ring by walking through the (host, weight) pairs in
+  // normalized_host_weights, and generating (scale * weight) hashes for each
+  // host. Since these aren't necessarily whole numbers, we maintain running
+  // sums -- current_hashes and target_hashes -- which allows us to populate the
+  // ring in a mostly stable way.
+  absl::InlinedVector<char, 196> hash_key_buffer;
+  double current_hashes = 0.0;
+  double target_hashes = 0.0;
+  for (size_t i = 0; i < endpoints.size(); ++i) {
+    const std::string& address_string = endpoints[i].address;
+    hash_key_buffer.assign(address_string.begin(), address_string.end());
+    hash_key_buffer.emplace_back('_');
+    const size_t prefix_size = hash_key_buffer.size();
+    target_hashes += scale * normalized_weights[i];
+    size_t count = 0;
+    while (current_hashes < target_hashes) {
+      // AlphaNum formats into an inline buffer, so building the key of each
+      // entry does not allocate.
+      const absl::AlphaNum count_str(count);
+      hash_key_buffer.resize(prefix_size);
+      hash_key_buffer.insert(hash_key_buffer.end(), count_str.data(),
+                             count_str.data() + count_str.size());
+      const uint64_t hash =
+          XXH64(hash_key_buffer.data(), hash_key_buffer.size(), 0);
+      entries.push_back({hash, static_cast<uint32_t>(i)});
+      ++count;
+      ++current_hashes;
+    }
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& lhs, const Entry& rhs) -> bool {
+              return lhs.hash < rhs.hash;
+            });
+  // Keep hashes and indexes in separate arrays: 12 bytes per entry rather
+  // than 16 for a padded struct, and the binary search only touches hashes.
+  RingHashTable table;
+  table.hashes_.reserve(entries.size());
+  table.endpoint_indexes_.reserve(entries.size());
+  for (const Entry& entry : entries) {
+    table.hashes_.push_back(entry.hash);
+    table.endpoint_indexes_.push_back(entry.endpoint_index);
+  }
+  return table;
+}
+
+RingHashTable RingHashTable::MakeMaglev(
+    const std::vector<Endpoint>& endpoints, size_t table_size) {
+  GPR_ASSERT(!endpoints.empty());
+  GPR_ASSERT(table_size > 1);
+  // Each endpoint walks its own permutation of the table, given by an offset
+  // and a skip derived from its address, and takes the next free entry on
+  // its turn. Since table_size is prime, every permutation covers the
+  // table.
+  struct Permutation {
+    uint64_t offset;
+    uint64_t skip;
+    uint64_t next = 0;
+    // Turns are taken in proportion to the weights: an endpoint gets one
+    // each time its credit reaches the largest weight.
+    uint64_t credit = 0;
+  };
+  uint32_t max_weight = 0;
+  std::vector<Permutation> permutations(endpoints.size());
+  for (size_t i = 0; i < endpoints.size(); ++i) {
+    const std::string& address = endpoints[i].address;
+    permutations[i].offset =
+        XXH64(address.data(), address.size(), 0) % table_size;
+    permutations[i].skip =
+        XXH64(address.data(), address.size(), 1) % (table_size - 1) + 1;
+    max_weight = std::max(max_weight, endpoints[i].weight);
+  }
+  constexpr uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+  RingHashTable table;
+  table.endpoint_indexes_.assign(table_size, kEmpty);
+  size_t filled = 0;
+  while (filled < table_size) {
+    for (size_t i = 0; i < endpoints.size() && filled < table_size; ++i) {
+      Permutation& permutation = permutations[i];
+      permutation.credit += endpoints[i].weight;
+      if (permutation.credit < max_weight) continue;
+      permutation.credit -= max_weight;
+      uint64_t position;
+      do {
+        position = (permutation.offset +
+                    permutation.skip * permutation.next++) %
+                   table_size;
+      } while (table.endpoint_indexes_[position] != kEmpty);
+      table.endpoint_indexes_[position] = static_cast<uint32_t>(i);
+      ++filled;
+    }
+  }
+  return table;
+}
+
+size_t RingHashTable::FindPosition(uint64_t hash) const {
+  if (hashes_.empty()) return hash % endpoint_indexes_.size();
+  // Ported from https://github.com/RJ/ketama/blob/master/libketama/ketama.c
+  // (ketama_get_server) NOTE: The algorithm depends on using signed integers
+  // for lowp, highp, and first_index. Do not change them!
+  int64_t lowp = 0;
+  int64_t highp = hashes_.size();
+  int64_t first_index = 0;
+  while (true) {
+    first_index = (lowp + highp) / 2;
+    if (first_index == static_cast<int64_t>(hashes_.size())) {
+      first_index = 0;
+      break;
+    }
+    uint64_t midval = hashes_[first_index];
+    uint64_t midval1 = first_index == 0 ? 0 : hashes_[first_index - 1];
+    if (hash <= midval && hash > midval1) {
+      break;
+    }
+    if (midval < hash) {
+      lowp = first_index + 1;
+    } else {
+      highp = first_index - 1;
+    }
+    if (lowp > highp) {
+      first_index = 0;
+      break;
+    }
+  }
+  return first_index;
+}
+
 namespace {
 
 constexpr char kRingHash[] = "ring_hash_experimental";
 
+constexpr size_t kDefaultMaglevTableSize = 65537;
+constexpr size_t kMaxMaglevTableSize = 5000011;
+
+bool IsPrime(size_t n) {
+  if (n < 2) return false;
+  for (size_t i = 2; i * i <= n; ++i) {
+    if (n % i == 0) return false;
+  }
+  return true;
+}
+
 class RingHashLbConfig : public LoadBalancingPolicy::Config {
  public:
-  RingHashLbConfig(size_t min_ring_size, size_t max_ring_size)
-      : min_ring_size_(min_ring_size), max_ring_size_(max_ring_size) {}
+  RingHashLbConfig(size_t min_ring_size, size_t max_ring_size,
+                   bool use_maglev, size_t maglev_table_size)
+      : min_ring_size_(min_ring_size),
+        max_ring_size_(max_ring_size),
+        use_maglev_(use_maglev),
+        maglev_table_size_(maglev_table_size) {}
   const char* name() const override { return kRingHash; }
   size_t min_ring_size() const { return min_ring_size_; }
   size_t max_ring_size() const { return max_ring_size_; }
+  bool use_maglev() const { return use_maglev_; }
+  size_t maglev_table_size() const { return maglev_table_size_; }
 
  private:
   size_t min_ring_size_;
   size_t max_ring_size_;
+  bool use_maglev_;
+  size_t maglev_table_size_;
 };
 
 //
@@ -161,15 +345,12 @@ class RingHash : public LoadBalancingPolicy {
             subchannel_list,
         const ServerAddress& address,
         RefCountedPtr<SubchannelInterface> subchannel)
-        : SubchannelData(subchannel_list, address, std::move(subchannel)),
-          address_(address) {}
+        : SubchannelData(subchannel_list, address, std::move(subchannel)) {}
 
     grpc_connectivity_state GetConnectivityState() const {
       return connectivity_state_for_picker_.load(std::memory_order_relaxed);
     }
 
-    const ServerAddress& address() const { return address_; }
-
     // Performs connectivity state updates that need to be done both when we
     // first start watching and when a watcher notification is received.
     void UpdateConnectivityStateLocked(
@@ -181,8 +362,6 @@ class RingHash : public LoadBalancingPolicy {
     void ProcessConnectivityChangeLocked(
         grpc_connectivity_state connectivity_state) override;
 
-    ServerAddress address_;
-
     // Last logical connectivity state seen.
     // Note that this may differ from the state actually reported by the
     // subchannel in some cases; for example, once this is set to
@@ -201,13 +380,14 @@ class RingHash : public LoadBalancingPolicy {
       : public SubchannelList<RingHashSubchannelList, RingHashSubchannelData> {
    public:
     RingHashSubchannelList(RingHash* policy, ServerAddressList addresses,
-                           const grpc_channel_args& args)
+                           const grpc_channel_args& args,
+                           RingHashSubchannelList* previous_list)
         : SubchannelList(policy,
                          (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)
                               ? "RingHashSubchannelList"
                               : nullptr),
                          std::move(addresses), policy->channel_control_helper(),
-                         args) {
+                         args, previous_list) {
       // Need to maintain a ref to the LB policy as long as we maintain
       // any references to subchannels, since the subchannels'
       // pollset_sets will include the LB policy's pollset_set.
@@ -219,7 +399,9 @@ class RingHash : public LoadBalancingPolicy {
       p->Unref(DEBUG_LOCATION, "subchannel_list");
     }
 
-    // Starts watching the subchannels in this list.
+    // Starts watching the subchannels in this list, taking over the
+    // watches of the previous list for the subchannels reused from it.
+    // Must be called before the previous list is orphaned.
     void StartWatchingLocked();
 
     // Updates the counters of subchannels in each state when a
@@ -253,19 +435,19 @@ class RingHash : public LoadBalancingPolicy {
 
   class Ring : public RefCounted<Ring> {
    public:
-    struct Entry {
-      uint64_t hash;
-      RingHashSubchannelData* subchannel;
-    };
-
     Ring(RingHash* parent,
          RefCountedPtr<RingHashSubchannelList> subchannel_list);
 
-    const std::vector<Entry>& ring() const { return ring_; }
+    const RingHashTable& table() const { return table_; }
+
+    // Returns the subchannel at position in the table.
+    RingHashSubchannelData* subchannel(size_t position) const {
+      return subchannel_list_->subchannel(table_.endpoint_index(position));
+    }
 
    private:
     RefCountedPtr<RingHashSubchannelList> subchannel_list_;
-    std::vector<Entry> ring_;
+    RingHashTable table_;
   };
 
   class Picker : public SubchannelPicker {
@@ -291,7 +473,7 @@ class RingHash : public LoadBalancingPolicy {
       }
 
       void Orphan() override {
-        // Hop into ExecCtx, so that we're not holding the data plane mutex
+        // Hop into ExecCtx, so that we're not in the middle of a pick
         // while we run control-plane code.
         ExecCtx::Run(DEBUG_LOCATION, &closure_, GRPC_ERROR_NONE);
       }
@@ -342,99 +524,36 @@ RingHash::Ring::Ring(RingHash* parent,
                      RefCountedPtr<RingHashSubchannelList> subchannel_list)
     : subchannel_list_(std::move(subchannel_list)) {
   size_t num_subchannels = subchannel_list_->num_subchannels();
-  // Store the weights while finding the sum.
-  struct AddressWeight {
-    std::string address;
-    // Default weight is 1 for the cases where a weight is not provided,
-    // each occurrence of the address will be counted a weight value of 1.
-    uint32_t weight = 1;
-    double normalized_weight;
-  };
-  std::vector<AddressWeight> address_weights;
-  size_t sum = 0;
-  address_weights.reserve(num_subchannels);
+  std::vector<RingHashTable::Endpoint> endpoints;
+  endpoints.reserve(num_subchannels);
   for (size_t i = 0; i < num_subchannels; ++i) {
     RingHashSubchannelData* sd = subchannel_list_->subchannel(i);
     const ServerAddressWeightAttribute* weight_attribute = static_cast<
         const ServerAddressWeightAttribute*>(sd->address().GetAttribute(
         ServerAddressWeightAttribute::kServerAddressWeightAttributeKey));
-    AddressWeight address_weight;
-    address_weight.address =
+    RingHashTable::Endpoint endpoint;
+    endpoint.address =
         grpc_sockaddr_to_string(&sd->address().address(), false).value();
+    // Default weight is 1 for the cases where a weight is not provided,
+    // each occurrence of the address will be counted a weight value of 1.
     if (weight_attribute != nullptr) {
       GPR_ASSERT(weight_attribute->weight() != 0);
-      address_weight.weight = weight_attribute->weight();
+      endpoint.weight = weight_attribute->weight();
     }
-    sum += address_weight.weight;
-    address_weights.push_back(std::move(address_weight));
+    endpoints.push_back(std::move(endpoint));
   }
-  // Calculating normalized weights and find min and max.
-  double min_normalized_weight = 1.0;
-  double max_normalized_weight = 0.0;
-  for (auto& address : address_weights) {
-    address.normalized_weight = static_cast<double>(address.weight) / sum;
-    min_normalized_weight =
-        std::min(address.normalized_weight, min_normalized_weight);
-    max_normalized_weight =
-        std::max(address.normalized_weight, max_normalized_weight);
-  }
-  // Scale up the number of hashes per host such that the least-weighted host
-  // gets a whole number of hashes on the ring. Other hosts might not end up
-  // with whole numbers, and that's fine (the ring-building algorithm below can
-  // handle this). This preserves the original implementation's behavior: when
-  // weights aren't provided, all hosts should get an equal number of hashes. In
-  // the case where this number exceeds the max_ring_size, it's scaled back down
-  // to fit.
-  const size_t min_ring_size = parent->config_->min_ring_size();
-  const size_t max_ring_size = parent->config_->max_ring_size();
-  const double scale = std::min(
-      std::ceil(min_normalized_weight * min_ring_size) / min_normalized_weight,
-      static_cast<double>(max_ring_size));
-  // Reserve memory for the entire ring up front.
-  const uint64_t ring_size = std::ceil(scale);
-  ring_.reserve(ring_size);
-  // Populate the hash ring by walking through the (host, weight) pairs in
-  // normalized_host_weights, and generating (scale * weight) hashes for each
-  // host. Since these aren't necessarily whole numbers, we maintain running
-  // sums -- current_hashes and target_hashes -- which allows us to populate the
-  // ring in a mostly stable way.
-  absl::InlinedVector<char, 196> hash_key_buffer;
-  double current_hashes = 0.0;
-  double target_hashes = 0.0;
-  uint64_t min_hashes_per_host = ring_size;
-  uint64_t max_hashes_per_host = 0;
-  for (size_t i = 0; i < num_subchannels; ++i) {
-    const std::string& address_string = address_weights[i].address;
-    hash_key_buffer.assign(address_string.begin(), address_string.end());
-    hash_key_buffer.emplace_back('_');
-    auto offset_start = hash_key_buffer.end();
-    target_hashes += scale * address_weights[i].normalized_weight;
-    size_t count = 0;
-    while (current_hashes < target_hashes) {
-      const std::string count_str = absl::StrCat(count);
-      hash_key_buffer.insert(offset_start, count_str.begin(), count_str.end());
-      absl::string_view hash_key(hash_key_buffer.data(),
-                                 hash_key_buffer.size());
-      const uint64_t hash = XXH64(hash_key.data(), hash_key.size(), 0);
-      ring_.push_back({hash, subchannel_list_->subchannel(i)});
-      ++count;
-      ++current_hashes;
-      hash_key_buffer.erase(offset_start, hash_key_buffer.end());
-    }
-    min_hashes_per_host =
-        std::min(static_cast<uint64_t>(i), min_hashes_per_host);
-    max_hashes_per_host =
-        std::max(static_cast<uint64_t>(i), max_hashes_per_host);
-  }
-  std::sort(ring_.begin(), ring_.end(),
-            [](const Entry& lhs, const Entry& rhs) -> bool {
-              return lhs.hash < rhs.hash;
-            });
+  const RingHashLbConfig& config = *parent->config_;
+  table_ = config.use_maglev()
+               ? RingHashTable::MakeMaglev(endpoints,
+                                           config.maglev_table_size())
+               : RingHashTable::MakeRing(endpoints, config.min_ring_size(),
+                                         config.max_ring_size());
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
     gpr_log(GPR_INFO,
-            "[RH %p picker %p] created ring from subchannel_list=%p "
-            "with %" PRIuPTR " ring entries",
-            parent, this, subchannel_list_.get(), ring_.size());
+            "[RH %p picker %p] created %s from subchannel_list=%p "
+            "with %" PRIuPTR " entries",
+            parent, this, config.use_maglev() ? "maglev table" : "ring",
+            subchannel_list_.get(), table_.size());
   }
 }
 
@@ -450,34 +569,8 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
     return PickResult::Fail(
         absl::InternalError("xds ring hash value is not a number"));
   }
-  const std::vector<Ring::Entry>& ring = ring_->ring();
-  // Ported from https://github.com/RJ/ketama/blob/master/libketama/ketama.c
-  // (ketama_get_server) NOTE: The algorithm depends on using signed integers
-  // for lowp, highp, and first_index. Do not change them!
-  int64_t lowp = 0;
-  int64_t highp = ring.size();
-  int64_t first_index = 0;
-  while (true) {
-    first_index = (lowp + highp) / 2;
-    if (first_index == static_cast<int64_t>(ring.size())) {
-      first_index = 0;
-      break;
-    }
-    uint64_t midval = ring[first_index].hash;
-    uint64_t midval1 = first_index == 0 ? 0 : ring[first_index - 1].hash;
-    if (h <= midval && h > midval1) {
-      break;
-    }
-    if (midval < h) {
-      lowp = first_index + 1;
-    } else {
-      highp = first_index - 1;
-    }
-    if (lowp > highp) {
-      first_index = 0;
-      break;
-    }
-  }
+  const RingHashTable& table = ring_->table();
+  const size_t first_index = table.FindPosition(h);
   OrphanablePtr<SubchannelConnectionAttempter> subchannel_connection_attempter;
   auto ScheduleSubchannelConnectionAttempt =
       [&](RefCountedPtr<SubchannelInterface> subchannel) {
@@ -487,41 +580,41 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
         }
         subchannel_connection_attempter->AddSubchannel(std::move(subchannel));
       };
-  switch (ring[first_index].subchannel->GetConnectivityState()) {
+  RingHashSubchannelData* first_subchannel = ring_->subchannel(first_index);
+  switch (first_subchannel->GetConnectivityState()) {
     case GRPC_CHANNEL_READY:
-      return PickResult::Complete(
-          ring[first_index].subchannel->subchannel()->Ref());
+      return PickResult::Complete(first_subchannel->subchannel()->Ref());
     case GRPC_CHANNEL_IDLE:
       ScheduleSubchannelConnectionAttempt(
-          ring[first_index].subchannel->subchannel()->Ref());
+          first_subchannel->subchannel()->Ref());
       ABSL_FALLTHROUGH_INTENDED;
     case GRPC_CHANNEL_CONNECTING:
       return PickResult::Queue();
     default:  // GRPC_CHANNEL_TRANSIENT_FAILURE
       break;
   }
-  ScheduleSubchannelConnectionAttempt(
-      ring[first_index].subchannel->subchannel()->Ref());
+  ScheduleSubchannelConnectionAttempt(first_subchannel->subchannel()->Ref());
   // Loop through remaining subchannels to find one in READY.
   // On the way, we make sure the right set of connection attempts
   // will happen.
   bool found_second_subchannel = false;
   bool found_first_non_failed = false;
-  for (size_t i = 1; i < ring.size(); ++i) {
-    const Ring::Entry& entry = ring[(first_index + i) % ring.size()];
-    if (entry.subchannel == ring[first_index].subchannel) {
+  for (size_t i = 1; i < table.size(); ++i) {
+    RingHashSubchannelData* entry_subchannel =
+        ring_->subchannel((first_index + i) % table.size());
+    if (entry_subchannel == first_subchannel) {
       continue;
     }
     grpc_connectivity_state connectivity_state =
-        entry.subchannel->GetConnectivityState();
+        entry_subchannel->GetConnectivityState();
     if (connectivity_state == GRPC_CHANNEL_READY) {
-      return PickResult::Complete(entry.subchannel->subchannel()->Ref());
+      return PickResult::Complete(entry_subchannel->subchannel()->Ref());
     }
     if (!found_second_subchannel) {
       switch (connectivity_state) {
         case GRPC_CHANNEL_IDLE:
           ScheduleSubchannelConnectionAttempt(
-              entry.subchannel->subchannel()->Ref());
+              entry_subchannel->subchannel()->Ref());
           ABSL_FALLTHROUGH_INTENDED;
         case GRPC_CHANNEL_CONNECTING:
           return PickResult::Queue();
@@ -533,11 +626,11 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
     if (!found_first_non_failed) {
       if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
         ScheduleSubchannelConnectionAttempt(
-            entry.subchannel->subchannel()->Ref());
+            entry_subchannel->subchannel()->Ref());
       } else {
         if (connectivity_state == GRPC_CHANNEL_IDLE) {
           ScheduleSubchannelConnectionAttempt(
-              entry.subchannel->subchannel()->Ref());
+              entry_subchannel->subchannel()->Ref());
         }
         found_first_non_failed = true;
       }
@@ -553,24 +646,23 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
 
 void RingHash::RingHashSubchannelList::StartWatchingLocked() {
   GPR_ASSERT(num_subchannels() != 0);
-  // Check current state of each subchannel synchronously.
+  // Check current state of each subchannel synchronously.  Subchannels
+  // reused from the previous list start from the state that list has for
+  // them.
   for (size_t i = 0; i < num_subchannels(); ++i) {
+    RingHashSubchannelData* sd = subchannel(i);
     grpc_connectivity_state state =
-        subchannel(i)->CheckConnectivityStateLocked();
-    subchannel(i)->UpdateConnectivityStateLocked(state);
+        sd->previous_data() != nullptr
+            ? sd->previous_data()->GetConnectivityState()
+            : sd->CheckConnectivityStateLocked();
+    sd->UpdateConnectivityStateLocked(state);
   }
   // Start connectivity watch for each subchannel.
   for (size_t i = 0; i < num_subchannels(); i++) {
     if (subchannel(i)->subchannel() != nullptr) {
-      subchannel(i)->StartConnectivityWatchLocked();
+      subchannel(i)->AdoptConnectivityWatchLocked();
     }
   }
-  // Send updated state to parent based on reported subchannel states.
-  // Pretend we're getting this update from the last subchannel, so that
-  // if we need to proactively start connecting, we'll start from the
-  // first subchannel.
-  UpdateRingHashConnectivityStateLocked(num_subchannels() - 1,
-                                        /*connection_attempt_complete=*/false);
 }
 
 void RingHash::RingHashSubchannelList::UpdateStateCountersLocked(
@@ -805,8 +897,15 @@ void RingHash::UpdateLocked(UpdateArgs args) {
     // failure and keep using the existing list.
     if (subchannel_list_ != nullptr) return;
   }
-  subchannel_list_ = MakeOrphanable<RingHashSubchannelList>(
-      this, std::move(addresses), *args.args);
+  // Addresses that the current list already has keep their subchannels and
+  // connectivity watches, so the new list must start watching before the
+  // current one is orphaned.
+  auto subchannel_list = MakeOrphanable<RingHashSubchannelList>(
+      this, std::move(addresses), *args.args, subchannel_list_.get());
+  if (subchannel_list->num_subchannels() > 0) {
+    subchannel_list->StartWatchingLocked();
+  }
+  subchannel_list_ = std::move(subchannel_list);
   if (subchannel_list_->num_subchannels() == 0) {
     // If the new list is empty, immediately transition to TRANSIENT_FAILURE.
     absl::Status status =
@@ -819,8 +918,13 @@ void RingHash::UpdateLocked(UpdateArgs args) {
   } else {
     // Build the ring.
     ring_ = subchannel_list_->MakeRing();
-    // Start watching the new list.
-    subchannel_list_->StartWatchingLocked();
+    // Send updated state to parent based on reported subchannel states.
+    // Pretend we're getting this update from the last subchannel, so that
+    // if we need to proactively start connecting, we'll start from the
+    // first subchannel.
+    subchannel_list_->UpdateRingHashConnectivityStateLocked(
+        subchannel_list_->num_subchannels() - 1,
+        /*connection_attempt_complete=*/false);
   }
 }
 
@@ -843,8 +947,43 @@ class RingHashFactory : public LoadBalancingPolicyFactory {
     size_t max_ring_size;
     std::vector<grpc_error_handle> error_list;
     ParseRingHashLbConfig(json, &min_ring_size, &max_ring_size, &error_list);
+    bool use_maglev = false;
+    size_t maglev_table_size = kDefaultMaglevTableSize;
+    if (json.type() == Json::Type::OBJECT) {
+      const Json::Object& ring_hash = json.object_value();
+      auto it = ring_hash.find("lookup_table");
+      if (it != ring_hash.end()) {
+        if (it->second.type() != Json::Type::STRING ||
+            (it->second.string_value() != "ring" &&
+             it->second.string_value() != "maglev")) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:lookup_table error: should be \"ring\" or \"maglev\""));
+        } else {
+          use_maglev = it->second.string_value() == "maglev";
+        }
+      }
+      it = ring_hash.find("maglev_table_size");
+      if (it != ring_hash.end()) {
+        if (it->second.type() != Json::Type::NUMBER) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:maglev_table_size error: should be of type number"));
+        } else {
+          int size = gpr_parse_nonnegative_int(
+              it->second.string_value().c_str());
+          if (size < 2 || static_cast<size_t>(size) > kMaxMaglevTableSize ||
+              !IsPrime(size)) {
+            error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                "field:maglev_table_size error: should be a prime number "
+                "no larger than 5000011"));
+          } else {
+            maglev_table_size = size;
+          }
+        }
+      }
+    }
     if (error_list.empty()) {
-      return MakeRefCounted<RingHashLbConfig>(min_ring_size, max_ring_size);
+      return MakeRefCounted<RingHashLbConfig>(min_ring_size, max_ring_size,
+                                              use_maglev, maglev_table_size);
     } else {
       *error = GRPC_ERROR_CREATE_FROM_VECTOR(
           "ring_hash_experimental LB policy config", &error_list);
@@ -19,8 +19,10 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
 #include <stdlib.h>
 
+#include <string>
 #include <vector>
 
 #include "src/core/lib/iomgr/error.h"
@@ -34,6 +36,45 @@ extern const char* kRequestRingHashAttribute;
 void ParseRingHashLbConfig(const Json& json, size_t* min_ring_size,
                            size_t* max_ring_size,
                            std::vector<grpc_error_handle>* error_list);
+
+// Maps request hashes to endpoints, either as a ketama ring whose size
+// grows with the spread of the endpoint weights, or as a Maglev lookup
+// table of fixed size. A hash maps to a position; positions after it are
+// the fallbacks, wrapping around at size().
+class RingHashTable {
+ public:
+  struct Endpoint {
+    // Hash key of the endpoint.
+    std::string address;
+    uint32_t weight = 1;
+  };
+
+  // Places each endpoint on the ring at least once per min_ring_size
+  // entries of its weight, up to max_ring_size entries in total.
+  static RingHashTable MakeRing(const std::vector<Endpoint>& endpoints,
+                                size_t min_ring_size, size_t max_ring_size);
+
+  // Fills a Maglev table of table_size entries, which must be prime.
+  static RingHashTable MakeMaglev(const std::vector<Endpoint>& endpoints,
+                                  size_t table_size);
+
+  size_t size() const { return endpoint_indexes_.size(); }
+
+  // Returns the position that hash maps to.
+  size_t FindPosition(uint64_t hash) const;
+
+  // Returns the index in the endpoint list of the entry at position.
+  uint32_t endpoint_index(size_t position) const {
+    return endpoint_indexes_[position];
+  }
+
+ private:
+  // Sorted ring hashes, parallel to endpoint_indexes_. Empty for Maglev
+  // tables, which are indexed by hash modulo size().
+  std::vector<uint64_t> hashes_;
+  std::vector<uint32_t> endpoint_indexes_;
+};
+
 }  // namespace grpc_core
 
 #endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_RING_HASH_H
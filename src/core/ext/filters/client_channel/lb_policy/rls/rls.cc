@@ -27,6 +27,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <deque>
 #include <list>
 #include <map>
@@ -90,6 +91,8 @@
 #include "src/core/lib/json/json_util.h"
 #include "src/core/lib/resolver/resolver_registry.h"
 #include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/resource_quota/api.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/lib/security/credentials/credentials.h"
 #include "src/core/lib/security/credentials/fake/fake_credentials.h"
 #include "src/core/lib/service_config/service_config_impl.h"
@@ -275,6 +278,13 @@ class RlsLb : public LoadBalancingPolicy {
       return picker_->Pick(args);
     }
 
+    // Returns the child's current picker, which the caller may keep using
+    // without the lock after the child replaces it.
+    std::shared_ptr<SubchannelPicker> picker() const
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+      return picker_;
+    }
+
     // Updates for the child policy are handled in two phases:
     // 1. In StartUpdate(), we parse and validate the new child policy
     //    config and store the parsed config.
@@ -348,24 +358,11 @@ class RlsLb : public LoadBalancingPolicy {
 
     grpc_connectivity_state connectivity_state_ ABSL_GUARDED_BY(&RlsLb::mu_) =
         GRPC_CHANNEL_IDLE;
-    std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker_
+    std::shared_ptr<LoadBalancingPolicy::SubchannelPicker> picker_
         ABSL_GUARDED_BY(&RlsLb::mu_);
   };
 
-  // A picker that uses the cache and the request map in the LB policy
-  // (synchronized via a mutex) to determine how to route requests.
-  class Picker : public LoadBalancingPolicy::SubchannelPicker {
-   public:
-    explicit Picker(RefCountedPtr<RlsLb> lb_policy);
-    ~Picker() override;
-
-    PickResult Pick(PickArgs args) override;
-
-   private:
-    RefCountedPtr<RlsLb> lb_policy_;
-    RefCountedPtr<RlsLbConfig> config_;
-    RefCountedPtr<ChildPolicyWrapper> default_child_policy_;
-  };
+  class Picker;
 
   // An LRU cache with adjustable size.
   class Cache {
@@ -410,11 +407,32 @@ class RlsLb : public LoadBalancingPolicy {
         return min_expiration_time_;
       }
 
+      const std::vector<RefCountedPtr<ChildPolicyWrapper>>&
+      child_policy_wrappers() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+        return child_policy_wrappers_;
+      }
+
       std::unique_ptr<BackOff> TakeBackoffState()
           ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
         return std::move(backoff_state_);
       }
 
+      // Takes a ref held by a picker's copy of the entry.
+      RefCountedPtr<Entry> RefForPicker() {
+        return Ref(DEBUG_LOCATION, "Picker");
+      }
+
+      // Records that a picker routed a call with its copy of the entry,
+      // without the lock.  The LRU order is updated on the next eviction.
+      void NoteLockFreePick() {
+        lock_free_pick_.store(true, std::memory_order_relaxed);
+      }
+
+      // Returns whether a picker used the entry since the last call.
+      bool TakeLockFreePick() {
+        return lock_free_pick_.exchange(false, std::memory_order_relaxed);
+      }
+
       // Cache size of entry.
       size_t Size() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
@@ -485,9 +503,12 @@ class RlsLb : public LoadBalancingPolicy {
 
       Timestamp min_expiration_time_ ABSL_GUARDED_BY(&RlsLb::mu_);
       Cache::Iterator lru_iterator_ ABSL_GUARDED_BY(&RlsLb::mu_);
+
+      std::atomic<bool> lock_free_pick_{false};
     };
 
-    explicit Cache(RlsLb* lb_policy);
+    // Entries are charged to the resource quota in \a args.
+    Cache(RlsLb* lb_policy, const grpc_channel_args* args);
 
     // Finds an entry from the cache that corresponds to a key. If an entry is
     // not found, nullptr is returned. Otherwise, the entry is considered
@@ -505,7 +526,8 @@ class RlsLb : public LoadBalancingPolicy {
 
     // Resizes the cache. If the new cache size is greater than the current size
     // of the cache, do nothing. Otherwise, evict the oldest entries that
-    // exceed the new size limit of the cache.
+    // exceed the new size limit of the cache.  Entries that pickers used
+    // since they were last moved get a second chance, as in CLOCK.
     void Resize(size_t bytes) ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
     // Resets backoff of all the cache entries.
@@ -521,22 +543,76 @@ class RlsLb : public LoadBalancingPolicy {
     static size_t EntrySizeForKey(const RequestKey& key);
 
     // Evicts oversized cache elements when the current size is greater than
-    // the specified limit.
+    // the specified limit.  An entry at the head of the LRU list that was
+    // picked without the lock is moved to the end instead of being evicted.
     void MaybeShrinkSize(size_t bytes)
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
+    // Brings the bytes reserved from the memory quota in line with size_.
+    // When the cache grew, makes sure that a reclaimer is posted.
+    void UpdateReservationLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+
     RlsLb* lb_policy_;
 
     size_t size_limit_ ABSL_GUARDED_BY(&RlsLb::mu_) = 0;
     size_t size_ ABSL_GUARDED_BY(&RlsLb::mu_) = 0;
 
+    // Reset on shutdown.
+    MemoryOwner memory_owner_;
+    size_t reserved_ ABSL_GUARDED_BY(&RlsLb::mu_) = 0;
+    bool reclaimer_posted_ ABSL_GUARDED_BY(&RlsLb::mu_) = false;
+
     std::list<RequestKey> lru_list_ ABSL_GUARDED_BY(&RlsLb::mu_);
     std::unordered_map<RequestKey, OrphanablePtr<Entry>, absl::Hash<RequestKey>>
         map_ ABSL_GUARDED_BY(&RlsLb::mu_);
     grpc_timer cleanup_timer_;
+
+    friend class Picker;
     grpc_closure timer_callback_;
   };
 
+  // A picker that uses the cache and the request map in the LB policy
+  // (synchronized via a mutex) to determine how to route requests.
+  //
+  // The picker also keeps a read-only copy of the cache entries that had
+  // usable data when it was created.  Any change to an entry's data or to
+  // the state of a child policy results in a new picker, so picks for keys
+  // with fresh data are routed from that copy without taking the mutex;
+  // only misses, stale entries and entries in backoff go through the cache.
+  class Picker : public LoadBalancingPolicy::SubchannelPicker {
+   public:
+    explicit Picker(RefCountedPtr<RlsLb> lb_policy);
+    ~Picker() override;
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    struct ChildSnapshot {
+      std::string target;
+      grpc_connectivity_state state;
+      std::shared_ptr<SubchannelPicker> picker;
+    };
+
+    struct RouteSnapshot {
+      // Only used to tell the cache that the entry was picked.
+      RefCountedPtr<Cache::Entry> entry;
+      std::string header_data;
+      Timestamp stale_time;
+      Timestamp data_expiration_time;
+      std::vector<const ChildSnapshot*> children;
+    };
+
+    PickResult PickFromSnapshot(const RequestKey& key,
+                                const RouteSnapshot& route, PickArgs args);
+
+    RefCountedPtr<RlsLb> lb_policy_;
+    RefCountedPtr<RlsLbConfig> config_;
+    RefCountedPtr<ChildPolicyWrapper> default_child_policy_;
+    std::unordered_map<ChildPolicyWrapper*, ChildSnapshot> children_;
+    std::unordered_map<RequestKey, RouteSnapshot, absl::Hash<RequestKey>>
+        routes_;
+  };
+
   // Channel for communicating with the RLS server.
   // Contains throttling logic for RLS requests.
   class RlsChannel : public InternallyRefCounted<RlsChannel> {
@@ -990,6 +1066,35 @@ RlsLb::Picker::Picker(RefCountedPtr<RlsLb> lb_policy)
     default_child_policy_ =
         lb_policy_->default_child_policy_->Ref(DEBUG_LOCATION, "Picker");
   }
+  // Copy the entries with usable data.  Entries that are stale or in
+  // backoff are left out, since picking for them may start an RLS request.
+  Timestamp now = ExecCtx::Get()->Now();
+  MutexLock lock(&lb_policy_->mu_);
+  if (lb_policy_->is_shutdown_) return;
+  for (const auto& p : lb_policy_->cache_.map_) {
+    Cache::Entry* entry = p.second.get();
+    if (entry->stale_time() < now || entry->data_expiration_time() < now ||
+        entry->backoff_time() >= now) {
+      continue;
+    }
+    RouteSnapshot& route = routes_[p.first];
+    route.entry = entry->RefForPicker();
+    route.header_data = entry->header_data();
+    route.stale_time = entry->stale_time();
+    route.data_expiration_time = entry->data_expiration_time();
+    for (const auto& wrapper : entry->child_policy_wrappers()) {
+      auto it = children_.find(wrapper.get());
+      if (it == children_.end()) {
+        it = children_
+                 .emplace(wrapper.get(),
+                          ChildSnapshot{wrapper->target(),
+                                        wrapper->connectivity_state(),
+                                        wrapper->picker()})
+                 .first;
+      }
+      route.children.push_back(&it->second);
+    }
+  }
 }
 
 RlsLb::Picker::~Picker() {
@@ -1015,6 +1120,11 @@ LoadBalancingPolicy::PickResult RlsLb::Picker::Pick(PickArgs args) {
             lb_policy_.get(), this, key.ToString().c_str());
   }
   Timestamp now = ExecCtx::Get()->Now();
+  auto route = routes_.find(key);
+  if (route != routes_.end() && route->second.stale_time >= now &&
+      route->second.data_expiration_time >= now) {
+    return PickFromSnapshot(key, route->second, args);
+  }
   MutexLock lock(&lb_policy_->mu_);
   if (lb_policy_->is_shutdown_) {
     return PickResult::Fail(
@@ -1095,6 +1205,36 @@ LoadBalancingPolicy::PickResult RlsLb::Picker::Pick(PickArgs args) {
   return PickResult::Queue();
 }
 
+LoadBalancingPolicy::PickResult RlsLb::Picker::PickFromSnapshot(
+    const RequestKey& key, const RouteSnapshot& route, PickArgs args) {
+  route.entry->NoteLockFreePick();
+  for (const ChildSnapshot* child : route.children) {
+    if (child->state == GRPC_CHANNEL_TRANSIENT_FAILURE) continue;
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
+      gpr_log(GPR_INFO,
+              "[rlslb %p] picker=%p: key=%s: using cached target %s in "
+              "state %s",
+              lb_policy_.get(), this, key.ToString().c_str(),
+              child->target.c_str(), ConnectivityStateName(child->state));
+    }
+    if (!route.header_data.empty()) {
+      char* copied_header_data = static_cast<char*>(
+          args.call_state->Alloc(route.header_data.length() + 1));
+      strcpy(copied_header_data, route.header_data.c_str());
+      args.initial_metadata->Add(kRlsHeaderKey, copied_header_data);
+    }
+    return child->picker->Pick(args);
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
+    gpr_log(GPR_INFO,
+            "[rlslb %p] picker=%p: key=%s: no healthy cached target found; "
+            "failing pick",
+            lb_policy_.get(), this, key.ToString().c_str());
+  }
+  return PickResult::Fail(
+      absl::UnavailableError("all RLS targets unreachable"));
+}
+
 //
 // RlsLb::Cache::Entry::BackoffTimer
 //
@@ -1344,7 +1484,11 @@ RlsLb::Cache::Entry::OnRlsResponseLocked(
 // RlsLb::Cache
 //
 
-RlsLb::Cache::Cache(RlsLb* lb_policy) : lb_policy_(lb_policy) {
+RlsLb::Cache::Cache(RlsLb* lb_policy, const grpc_channel_args* args)
+    : lb_policy_(lb_policy),
+      memory_owner_(
+          ResourceQuotaFromChannelArgs(args)->memory_quota()->CreateMemoryOwner(
+              "rls_cache")) {
   Timestamp now = ExecCtx::Get()->Now();
   lb_policy_->Ref(DEBUG_LOCATION, "CacheCleanupTimer").release();
   GRPC_CLOSURE_INIT(&timer_callback_, OnCleanupTimer, this, nullptr);
@@ -1369,6 +1513,7 @@ RlsLb::Cache::Entry* RlsLb::Cache::FindOrInsert(const RequestKey& key) {
         new Entry(lb_policy_->Ref(DEBUG_LOCATION, "CacheEntry"), key);
     map_.emplace(key, OrphanablePtr<Entry>(entry));
     size_ += entry_size;
+    UpdateReservationLocked();
     if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
       gpr_log(GPR_INFO, "[rlslb %p] key=%s: cache entry added, entry=%p",
               lb_policy_, key.ToString().c_str(), entry);
@@ -1403,6 +1548,10 @@ void RlsLb::Cache::ResetAllBackoff() {
 void RlsLb::Cache::Shutdown() {
   map_.clear();
   lru_list_.clear();
+  size_ = 0;
+  UpdateReservationLocked();
+  // Cancels the reclaimer, which drops its ref to the LB policy.
+  memory_owner_.Reset();
   grpc_timer_cancel(&cleanup_timer_);
 }
 
@@ -1428,6 +1577,7 @@ void RlsLb::Cache::OnCleanupTimer(void* arg, grpc_error_handle error) {
             ++it;
           }
         }
+        cache->UpdateReservationLocked();
         Timestamp now = ExecCtx::Get()->Now();
         lb_policy.release();
         grpc_timer_init(&cache->cleanup_timer_,
@@ -1448,6 +1598,10 @@ void RlsLb::Cache::MaybeShrinkSize(size_t bytes) {
     if (GPR_UNLIKELY(lru_it == lru_list_.end())) break;
     auto map_it = map_.find(*lru_it);
     GPR_ASSERT(map_it != map_.end());
+    if (map_it->second->TakeLockFreePick()) {
+      map_it->second->MarkUsed();
+      continue;
+    }
     if (!map_it->second->CanEvict()) break;
     if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
       gpr_log(GPR_INFO, "[rlslb %p] LRU eviction: removing entry %p %s",
@@ -1456,6 +1610,7 @@ void RlsLb::Cache::MaybeShrinkSize(size_t bytes) {
     size_ -= map_it->second->Size();
     map_.erase(map_it);
   }
+  UpdateReservationLocked();
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
     gpr_log(GPR_INFO,
             "[rlslb %p] LRU pass complete: desired size=%" PRIuPTR
@@ -1464,6 +1619,50 @@ void RlsLb::Cache::MaybeShrinkSize(size_t bytes) {
   }
 }
 
+void RlsLb::Cache::UpdateReservationLocked() {
+  if (!memory_owner_.is_valid()) return;
+  if (size_ < reserved_) {
+    memory_owner_.Release(reserved_ - size_);
+    reserved_ = size_;
+    return;
+  }
+  if (size_ == reserved_) return;
+  memory_owner_.Reserve(size_ - reserved_);
+  reserved_ = size_;
+  if (reclaimer_posted_) return;
+  reclaimer_posted_ = true;
+  // Evicted entries cost an RLS request when they are needed again, so
+  // only give them up when idle reclamation is reached, after the benign
+  // pass has dropped what is cheaper to rebuild.  Entries still within
+  // their min_expiration_time are kept.  The reclaimer is posted again on
+  // the next insertion.
+  RefCountedPtr<RlsLb> lb_policy =
+      lb_policy_->Ref(DEBUG_LOCATION, "CacheReclaimer");
+  memory_owner_.PostReclaimer(
+      ReclamationPass::kIdle,
+      [lb_policy](absl::optional<ReclamationSweep> sweep) {
+        if (!sweep.has_value()) return;
+        // Evicting entries may shut down child policies, which must be done
+        // in the WorkSerializer.  The sweep is complete once it is dropped.
+        auto shared_sweep =
+            std::make_shared<ReclamationSweep>(std::move(*sweep));
+        lb_policy->work_serializer()->Run(
+            [lb_policy, shared_sweep]() {
+              MutexLock lock(&lb_policy->mu_);
+              if (lb_policy->is_shutdown_) return;
+              Cache& cache = lb_policy->cache_;
+              if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
+                gpr_log(GPR_INFO,
+                        "[rlslb %p] reclaiming cache memory, size=%" PRIuPTR,
+                        lb_policy.get(), cache.size_);
+              }
+              cache.reclaimer_posted_ = false;
+              cache.MaybeShrinkSize(0);
+            },
+            DEBUG_LOCATION);
+      });
+}
+
 //
 // RlsLb::RlsChannel::StateWatcher
 //
@@ -1899,7 +2098,7 @@ std::string GetServerUri(const grpc_channel_args* args) {
 RlsLb::RlsLb(Args args)
     : LoadBalancingPolicy(std::move(args)),
       server_name_(GetServerUri(args.args)),
-      cache_(this) {
+      cache_(this, args.args) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
     gpr_log(GPR_INFO, "[rlslb %p] policy created", this);
   }
@@ -17,8 +17,10 @@
 #include <grpc/support/port_platform.h>
 
 #include <inttypes.h>
-#include <stdlib.h>
+#include <stdint.h>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -31,6 +33,7 @@
 
 #include <grpc/impl/codegen/connectivity_state.h>
 #include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
 #include "src/core/ext/filters/client_channel/lb_policy.h"
@@ -38,11 +41,14 @@
 #include "src/core/ext/filters/client_channel/lb_policy_factory.h"
 #include "src/core/ext/filters/client_channel/lb_policy_registry.h"
 #include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/fast_random.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/resolver/server_address.h"
 #include "src/core/lib/transport/connectivity_state.h"
@@ -116,13 +122,14 @@ class RoundRobin : public LoadBalancingPolicy {
                               RoundRobinSubchannelData> {
    public:
     RoundRobinSubchannelList(RoundRobin* policy, ServerAddressList addresses,
-                             const grpc_channel_args& args)
+                             const grpc_channel_args& args,
+                             RoundRobinSubchannelList* previous_list)
         : SubchannelList(policy,
                          (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)
                               ? "RoundRobinSubchannelList"
                               : nullptr),
                          std::move(addresses), policy->channel_control_helper(),
-                         args) {
+                         args, previous_list) {
       // Need to maintain a ref to the LB policy as long as we maintain
       // any references to subchannels, since the subchannels'
       // pollset_sets will include the LB policy's pollset_set.
@@ -149,6 +156,10 @@ class RoundRobin : public LoadBalancingPolicy {
         absl::Status status_for_tf);
 
    private:
+    // Returns true if this is latest_pending_subchannel_list_ and should
+    // now be swapped into subchannel_list_.
+    bool ShouldReplaceCurrentListLocked() const;
+
     std::string CountersString() const {
       return absl::StrCat("num_subchannels=", num_subchannels(),
                           " num_ready=", num_ready_,
@@ -161,6 +172,12 @@ class RoundRobin : public LoadBalancingPolicy {
     size_t num_transient_failure_ = 0;
   };
 
+  // With GRPC_ARG_ROUND_ROBIN_PER_CPU_PICKS, picks are spread over one index
+  // per CPU, each cycling through all subchannels from its own starting
+  // point, so that concurrent picks on different CPUs do not write to the
+  // same cache line. Since every index goes round robin, each subchannel
+  // gets within one pick per CPU of its share. Otherwise a single index
+  // gives strict round robin order.
   class Picker : public SubchannelPicker {
    public:
     Picker(RoundRobin* parent, RoundRobinSubchannelList* subchannel_list);
@@ -168,11 +185,18 @@ class RoundRobin : public LoadBalancingPolicy {
     PickResult Pick(PickArgs args) override;
 
    private:
+    // Padded so that indexes of different CPUs are a cache line apart.
+    struct PerCpuIndex {
+      std::atomic<uint32_t> last_picked_index{0};
+      uint8_t padding[GPR_CACHELINE_SIZE - sizeof(std::atomic<uint32_t>)];
+    };
+
     // Using pointer value only, no ref held -- do not dereference!
     RoundRobin* parent_;
 
-    size_t last_picked_index_;
     absl::InlinedVector<RefCountedPtr<SubchannelInterface>, 10> subchannels_;
+    size_t num_indexes_;
+    std::unique_ptr<PerCpuIndex[]> indexes_;
   };
 
   void ShutdownLocked() override;
@@ -185,6 +209,8 @@ class RoundRobin : public LoadBalancingPolicy {
   // list becomes READY.
   OrphanablePtr<RoundRobinSubchannelList> latest_pending_subchannel_list_;
 
+  const bool per_cpu_picks_;
+
   bool shutdown_ = false;
 };
 
@@ -201,36 +227,57 @@ RoundRobin::Picker::Picker(RoundRobin* parent,
       subchannels_.push_back(sd->subchannel()->Ref());
     }
   }
+  // Beyond a few dozen CPUs, sharing an index between two CPUs costs
+  // little and keeps pickers small, as one is built per state change.
+  constexpr unsigned kMaxIndexes = 64;
+  num_indexes_ =
+      parent->per_cpu_picks_
+          ? std::min(std::max(gpr_cpu_num_cores(), 1u), kMaxIndexes)
+          : 1;
+  indexes_.reset(new PerCpuIndex[num_indexes_]);
   // For discussion on why we generate a random starting index for
   // the picker, see https://github.com/grpc/grpc-go/issues/2580.
-  // TODO(roth): rand(3) is not thread-safe.  This should be replaced with
-  // something better as part of https://github.com/grpc/grpc/issues/17891.
-  last_picked_index_ = rand() % subchannels_.size();
+  const size_t start =
+      FastRandomUniform(static_cast<uint32_t>(subchannels_.size()));
+  // Stagger the CPUs' starting points, so that picks made on different
+  // CPUs at the same time go to different subchannels.
+  for (size_t i = 0; i < num_indexes_; ++i) {
+    indexes_[i].last_picked_index.store(
+        static_cast<uint32_t>(
+            (start + i * subchannels_.size() / num_indexes_) %
+            subchannels_.size()),
+        std::memory_order_relaxed);
+  }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
     gpr_log(GPR_INFO,
             "[RR %p picker %p] created picker from subchannel_list=%p "
-            "with %" PRIuPTR " READY subchannels; last_picked_index_=%" PRIuPTR,
-            parent_, this, subchannel_list, subchannels_.size(),
-            last_picked_index_);
+            "with %" PRIuPTR " READY subchannels; start index=%" PRIuPTR,
+            parent_, this, subchannel_list, subchannels_.size(), start);
   }
 }
 
 RoundRobin::PickResult RoundRobin::Picker::Pick(PickArgs /*args*/) {
-  last_picked_index_ = (last_picked_index_ + 1) % subchannels_.size();
+  PerCpuIndex& index =
+      indexes_[ExecCtx::Get()->starting_cpu() % num_indexes_];
+  const size_t picked_index =
+      (index.last_picked_index.fetch_add(1, std::memory_order_relaxed) + 1) %
+      subchannels_.size();
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
     gpr_log(GPR_INFO,
             "[RR %p picker %p] returning index %" PRIuPTR ", subchannel=%p",
-            parent_, this, last_picked_index_,
-            subchannels_[last_picked_index_].get());
+            parent_, this, picked_index, subchannels_[picked_index].get());
   }
-  return PickResult::Complete(subchannels_[last_picked_index_]);
+  return PickResult::Complete(subchannels_[picked_index]);
 }
 
 //
 // RoundRobin
 //
 
-RoundRobin::RoundRobin(Args args) : LoadBalancingPolicy(std::move(args)) {
+RoundRobin::RoundRobin(Args args)
+    : LoadBalancingPolicy(std::move(args)),
+      per_cpu_picks_(grpc_channel_args_find_bool(
+          args.args, GRPC_ARG_ROUND_ROBIN_PER_CPU_PICKS, false)) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
     gpr_log(GPR_INFO, "[RR %p] Created", this);
   }
@@ -278,13 +325,14 @@ void RoundRobin::UpdateLocked(UpdateArgs args) {
     if (subchannel_list_ != nullptr) return;
   }
   // Create new subchannel list, replacing the previous pending list, if any.
+  // Addresses that the current list already has keep their subchannels.
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace) &&
       latest_pending_subchannel_list_ != nullptr) {
     gpr_log(GPR_INFO, "[RR %p] replacing previous pending subchannel list %p",
             this, latest_pending_subchannel_list_.get());
   }
   latest_pending_subchannel_list_ = MakeOrphanable<RoundRobinSubchannelList>(
-      this, std::move(addresses), *args.args);
+      this, std::move(addresses), *args.args, subchannel_list_.get());
   // Start watching the new list.  If appropriate, this will cause it to be
   // immediately promoted to subchannel_list_ and to generate a new picker.
   latest_pending_subchannel_list_->StartWatchingLocked(
@@ -301,19 +349,30 @@ void RoundRobin::RoundRobinSubchannelList::StartWatchingLocked(
     absl::Status status_for_tf) {
   // Check current state of each subchannel synchronously, since any
   // subchannel already used by some other channel may have a non-IDLE
-  // state.
+  // state.  Subchannels reused from the current list start from the
+  // state that list has for them.
   for (size_t i = 0; i < num_subchannels(); ++i) {
+    RoundRobinSubchannelData* sd = subchannel(i);
     grpc_connectivity_state state =
-        subchannel(i)->CheckConnectivityStateLocked();
+        sd->previous_data() != nullptr
+            ? sd->previous_data()->connectivity_state()
+            : sd->CheckConnectivityStateLocked();
     if (state != GRPC_CHANNEL_IDLE) {
-      subchannel(i)->UpdateLogicalConnectivityStateLocked(state);
+      sd->UpdateLogicalConnectivityStateLocked(state);
     }
   }
-  // Start connectivity watch for each subchannel.
+  // Start connectivity watch for each subchannel.  If this list is about
+  // to replace the current one, reused subchannels take over the watches
+  // of the current list instead; they have already been asked to connect.
+  const bool replaces_current_list = ShouldReplaceCurrentListLocked();
   for (size_t i = 0; i < num_subchannels(); i++) {
-    if (subchannel(i)->subchannel() != nullptr) {
-      subchannel(i)->StartConnectivityWatchLocked();
-      subchannel(i)->subchannel()->RequestConnection();
+    RoundRobinSubchannelData* sd = subchannel(i);
+    if (sd->subchannel() == nullptr) continue;
+    if (replaces_current_list && sd->previous_data() != nullptr) {
+      sd->AdoptConnectivityWatchLocked();
+    } else {
+      sd->StartConnectivityWatchLocked();
+      sd->subchannel()->RequestConnection();
     }
   }
   // Update RR connectivity state if needed.
@@ -343,8 +402,8 @@ void RoundRobin::RoundRobinSubchannelList::UpdateStateCountersLocked(
   }
 }
 
-void RoundRobin::RoundRobinSubchannelList::
-    MaybeUpdateRoundRobinConnectivityStateLocked(absl::Status status_for_tf) {
+bool RoundRobin::RoundRobinSubchannelList::ShouldReplaceCurrentListLocked()
+    const {
   RoundRobin* p = static_cast<RoundRobin*>(policy());
   // If this is latest_pending_subchannel_list_, then swap it into
   // subchannel_list_ in the following cases:
@@ -355,11 +414,17 @@ void RoundRobin::RoundRobinSubchannelList::
   //   the list is empty.  (This may cause the channel to go from READY
   //   to TRANSIENT_FAILURE, but we're doing what the control plane told
   //   us to do.
-  if (p->latest_pending_subchannel_list_.get() == this &&
-      (p->subchannel_list_ == nullptr || p->subchannel_list_->num_ready_ == 0 ||
-       num_ready_ > 0 ||
-       // Note: num_transient_failure_ and num_subchannels() may both be 0.
-       num_transient_failure_ == num_subchannels())) {
+  return p->latest_pending_subchannel_list_.get() == this &&
+         (p->subchannel_list_ == nullptr ||
+          p->subchannel_list_->num_ready_ == 0 || num_ready_ > 0 ||
+          // Note: num_transient_failure_ and num_subchannels() may both be 0.
+          num_transient_failure_ == num_subchannels());
+}
+
+void RoundRobin::RoundRobinSubchannelList::
+    MaybeUpdateRoundRobinConnectivityStateLocked(absl::Status status_for_tf) {
+  RoundRobin* p = static_cast<RoundRobin*>(policy());
+  if (ShouldReplaceCurrentListLocked()) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_round_robin_trace)) {
       const std::string old_counters_string =
           p->subchannel_list_ != nullptr ? p->subchannel_list_->CountersString()
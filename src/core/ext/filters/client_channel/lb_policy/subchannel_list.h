@@ -24,6 +24,7 @@
 #include <inttypes.h>
 #include <string.h>
 
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -36,6 +37,7 @@
 
 #include "src/core/ext/filters/client_channel/lb_policy.h"
 #include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/gprpp/orphanable.h"
@@ -93,6 +95,15 @@ class SubchannelData {
   // Returns a pointer to the subchannel.
   SubchannelInterface* subchannel() const { return subchannel_.get(); }
 
+  // Returns the address the subchannel was created for.
+  const ServerAddress& address() const { return address_; }
+
+  // If this entry reuses the subchannel of an entry in the previous
+  // subchannel list (see SubchannelList), returns that entry.  Only set
+  // until the connectivity watch is started, while the previous list is
+  // still alive.
+  SubchannelDataType* previous_data() const { return previous_data_; }
+
   // Synchronously checks the subchannel's connectivity state.
   // Must not be called while there is a connectivity notification
   // pending (i.e., between calling StartConnectivityWatchLocked() and
@@ -113,9 +124,22 @@ class SubchannelData {
   // connectivity state changes.
   void StartConnectivityWatchLocked();
 
+  // Same as StartConnectivityWatchLocked(), except that if previous_data()
+  // is watching the subchannel, that watch is moved to this entry instead
+  // of starting a new one.  previous_data() gets no further notifications,
+  // so this may only be used when the previous list is about to be
+  // replaced by this one.
+  void AdoptConnectivityWatchLocked();
+
   // Cancels watching the connectivity state of the subchannel.
   void CancelConnectivityWatchLocked(const char* reason);
 
+  // Returns true between StartConnectivityWatchLocked() and
+  // CancelConnectivityWatchLocked().
+  bool connectivity_watch_started() const {
+    return pending_watcher_ != nullptr;
+  }
+
   // Cancels any pending connectivity watch and unrefs the subchannel.
   void ShutdownLocked();
 
@@ -150,6 +174,14 @@ class SubchannelData {
 
     void OnConnectivityStateChange(grpc_connectivity_state new_state) override;
 
+    // Moves the watcher to an entry of a newer subchannel list.
+    void Retarget(
+        SubchannelData<SubchannelListType, SubchannelDataType>* subchannel_data,
+        RefCountedPtr<SubchannelListType> subchannel_list) {
+      subchannel_data_ = subchannel_data;
+      subchannel_list_ = std::move(subchannel_list);
+    }
+
     grpc_pollset_set* interested_parties() override {
       return subchannel_list_->policy()->interested_parties();
     }
@@ -159,13 +191,19 @@ class SubchannelData {
     RefCountedPtr<SubchannelListType> subchannel_list_;
   };
 
+  // For setting previous_data_.
+  friend class SubchannelList<SubchannelListType, SubchannelDataType>;
+
   // Unrefs the subchannel.
   void UnrefSubchannelLocked(const char* reason);
 
   // Backpointer to owning subchannel list.  Not owned.
   SubchannelList<SubchannelListType, SubchannelDataType>* subchannel_list_;
+  const ServerAddress address_;
   // The subchannel.
   RefCountedPtr<SubchannelInterface> subchannel_;
+  // The entry of the previous list whose subchannel is reused.  Not owned.
+  SubchannelDataType* previous_data_ = nullptr;
   // Will be non-null when the subchannel's state is being watched.
   SubchannelInterface::ConnectivityStateWatcherInterface* pending_watcher_ =
       nullptr;
@@ -208,10 +246,15 @@ class SubchannelList : public InternallyRefCounted<SubchannelListType> {
   }
 
  protected:
+  // If previous_list is non-null, addresses that it also has reuse its
+  // subchannels instead of creating new ones, as long as both lists are
+  // created with the same channel args.  Those entries have previous_data()
+  // set, so that the subclass can carry over their state.
   SubchannelList(LoadBalancingPolicy* policy, const char* tracer,
                  ServerAddressList addresses,
                  LoadBalancingPolicy::ChannelControlHelper* helper,
-                 const grpc_channel_args& args);
+                 const grpc_channel_args& args,
+                 SubchannelListType* previous_list = nullptr);
 
   virtual ~SubchannelList();
 
@@ -226,6 +269,9 @@ class SubchannelList : public InternallyRefCounted<SubchannelListType> {
 
   const char* tracer_;
 
+  // The args the subchannels were created with.
+  grpc_channel_args* args_;
+
   // The list of subchannels.
   SubchannelVector subchannels_;
 
@@ -273,9 +319,10 @@ void SubchannelData<SubchannelListType, SubchannelDataType>::Watcher::
 template <typename SubchannelListType, typename SubchannelDataType>
 SubchannelData<SubchannelListType, SubchannelDataType>::SubchannelData(
     SubchannelList<SubchannelListType, SubchannelDataType>* subchannel_list,
-    const ServerAddress& /*address*/,
+    const ServerAddress& address,
     RefCountedPtr<SubchannelInterface> subchannel)
     : subchannel_list_(subchannel_list),
+      address_(address),
       subchannel_(std::move(subchannel)),
       // We assume that the current state is IDLE.  If not, we'll get a
       // callback telling us that.
@@ -322,6 +369,7 @@ void SubchannelData<SubchannelListType,
             subchannel_.get(), ConnectivityStateName(connectivity_state_));
   }
   GPR_ASSERT(pending_watcher_ == nullptr);
+  previous_data_ = nullptr;
   pending_watcher_ =
       new Watcher(this, subchannel_list()->Ref(DEBUG_LOCATION, "Watcher"));
   subchannel_->WatchConnectivityState(
@@ -330,6 +378,33 @@ void SubchannelData<SubchannelListType,
           pending_watcher_));
 }
 
+template <typename SubchannelListType, typename SubchannelDataType>
+void SubchannelData<SubchannelListType,
+                    SubchannelDataType>::AdoptConnectivityWatchLocked() {
+  SubchannelData* previous = previous_data_;
+  if (previous == nullptr || previous->pending_watcher_ == nullptr) {
+    StartConnectivityWatchLocked();
+    return;
+  }
+  if (GPR_UNLIKELY(subchannel_list_->tracer() != nullptr)) {
+    gpr_log(GPR_INFO,
+            "[%s %p] subchannel list %p index %" PRIuPTR " of %" PRIuPTR
+            " (subchannel %p): taking over watch from subchannel list %p "
+            "(in %s)",
+            subchannel_list_->tracer(), subchannel_list_->policy(),
+            subchannel_list_, Index(), subchannel_list_->num_subchannels(),
+            subchannel_.get(), previous->subchannel_list_,
+            ConnectivityStateName(previous->connectivity_state_));
+  }
+  GPR_ASSERT(pending_watcher_ == nullptr);
+  previous_data_ = nullptr;
+  connectivity_state_ = previous->connectivity_state_;
+  pending_watcher_ = previous->pending_watcher_;
+  previous->pending_watcher_ = nullptr;
+  static_cast<Watcher*>(pending_watcher_)
+      ->Retarget(this, subchannel_list()->Ref(DEBUG_LOCATION, "Watcher"));
+}
+
 template <typename SubchannelListType, typename SubchannelDataType>
 void SubchannelData<SubchannelListType, SubchannelDataType>::
     CancelConnectivityWatchLocked(const char* reason) {
@@ -362,20 +437,48 @@ SubchannelList<SubchannelListType, SubchannelDataType>::SubchannelList(
     LoadBalancingPolicy* policy, const char* tracer,
     ServerAddressList addresses,
     LoadBalancingPolicy::ChannelControlHelper* helper,
-    const grpc_channel_args& args)
+    const grpc_channel_args& args, SubchannelListType* previous_list)
     : InternallyRefCounted<SubchannelListType>(tracer),
       policy_(policy),
-      tracer_(tracer) {
+      tracer_(tracer),
+      args_(grpc_channel_args_copy(&args)) {
   if (GPR_UNLIKELY(tracer_ != nullptr)) {
     gpr_log(GPR_INFO,
-            "[%s %p] Creating subchannel list %p for %" PRIuPTR " subchannels",
-            tracer_, policy, this, addresses.size());
+            "[%s %p] Creating subchannel list %p for %" PRIuPTR
+            " subchannels (previous list %p)",
+            tracer_, policy, this, addresses.size(), previous_list);
+  }
+  // Index the subchannels of the previous list by address.  An address
+  // may appear more than once, so each entry can only be reused once.
+  struct AddressLess {
+    bool operator()(const ServerAddress* a, const ServerAddress* b) const {
+      return a->Cmp(*b) < 0;
+    }
+  };
+  std::multimap<const ServerAddress*, SubchannelDataType*, AddressLess>
+      previous_subchannels;
+  if (previous_list != nullptr && !previous_list->shutting_down() &&
+      grpc_channel_args_compare(previous_list->args_, &args) == 0) {
+    for (size_t i = 0; i < previous_list->num_subchannels(); ++i) {
+      SubchannelDataType* sd = previous_list->subchannel(i);
+      if (sd->subchannel() != nullptr) {
+        previous_subchannels.emplace(&sd->address(), sd);
+      }
+    }
   }
   subchannels_.reserve(addresses.size());
-  // Create a subchannel for each address.
+  // Create a subchannel for each address, unless the previous list has one.
   for (ServerAddress address : addresses) {
-    RefCountedPtr<SubchannelInterface> subchannel =
-        helper->CreateSubchannel(address, args);
+    RefCountedPtr<SubchannelInterface> subchannel;
+    SubchannelDataType* previous_data = nullptr;
+    auto it = previous_subchannels.find(&address);
+    if (it != previous_subchannels.end()) {
+      previous_data = it->second;
+      previous_subchannels.erase(it);
+      subchannel = previous_data->subchannel()->Ref();
+    } else {
+      subchannel = helper->CreateSubchannel(address, args);
+    }
     if (subchannel == nullptr) {
       // Subchannel could not be created.
       if (GPR_UNLIKELY(tracer_ != nullptr)) {
@@ -388,12 +491,19 @@ SubchannelList<SubchannelListType, SubchannelDataType>::SubchannelList(
     if (GPR_UNLIKELY(tracer_ != nullptr)) {
       gpr_log(GPR_INFO,
               "[%s %p] subchannel list %p index %" PRIuPTR
-              ": Created subchannel %p for address %s",
-              tracer_, policy_, this, subchannels_.size(), subchannel.get(),
-              address.ToString().c_str());
+              ": %s subchannel %p for address %s",
+              tracer_, policy_, this, subchannels_.size(),
+              previous_data != nullptr ? "Reused" : "Created",
+              subchannel.get(), address.ToString().c_str());
     }
     subchannels_.emplace_back();
     subchannels_.back().Init(this, std::move(address), std::move(subchannel));
+    if (previous_data != nullptr) {
+      SubchannelData<SubchannelListType, SubchannelDataType>* sd =
+          subchannels_.back().get();
+      sd->previous_data_ = previous_data;
+      sd->connectivity_state_ = previous_data->connectivity_state_;
+    }
   }
 }
 
@@ -406,6 +516,7 @@ SubchannelList<SubchannelListType, SubchannelDataType>::~SubchannelList() {
   for (auto& sd : subchannels_) {
     sd.Destroy();
   }
+  grpc_channel_args_destroy(args_);
 }
 
 template <typename SubchannelListType, typename SubchannelDataType>
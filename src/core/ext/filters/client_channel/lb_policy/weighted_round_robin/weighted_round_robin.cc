@@ -0,0 +1,860 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/impl/codegen/connectivity_state.h>
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy/oob_backend_metric.h"
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy_factory.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/fast_random.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/json/json_util.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_wrr_trace(false, "weighted_round_robin_lb");
+
+namespace {
+
+//
+// StaticStrideScheduler
+//
+
+// Weights are scaled so that the largest one is kMaxWeight.
+constexpr uint16_t kMaxWeight = 0xFFFF;
+// Offsets the phase of each backend, so that backends with equal weights
+// are not all skipped in the same rounds.
+constexpr uint32_t kOffset = kMaxWeight / 2;
+
+// Picks indexes in proportion to a fixed set of weights. Pick() is
+// thread-safe and lock-free, and takes O(1) steps on average: every pass
+// over the weights picks the largest one at least once.
+class StaticStrideScheduler {
+ public:
+  // Returns nullptr if fewer than two weights are positive, in which case
+  // weighting would make no difference. Weights that are not positive are
+  // replaced by the mean of the positive ones.
+  static std::unique_ptr<StaticStrideScheduler> Make(
+      const std::vector<float>& weights, uint32_t initial_sequence) {
+    size_t num_positive = 0;
+    double sum = 0;
+    float max = 0;
+    for (float weight : weights) {
+      if (weight > 0) {
+        ++num_positive;
+        sum += weight;
+        max = std::max(max, weight);
+      }
+    }
+    if (num_positive < 2) return nullptr;
+    const float mean = static_cast<float>(sum / num_positive);
+    const double scale = kMaxWeight / static_cast<double>(max);
+    std::vector<uint16_t> scaled_weights;
+    scaled_weights.reserve(weights.size());
+    for (float weight : weights) {
+      if (weight <= 0) weight = mean;
+      // Every backend stays pickable, however small its weight.
+      scaled_weights.push_back(static_cast<uint16_t>(
+          std::max(1.0, std::round(weight * scale))));
+    }
+    return absl::WrapUnique(new StaticStrideScheduler(
+        std::move(scaled_weights), initial_sequence));
+  }
+
+  size_t Pick() const {
+    // Each pass over the weights is a generation. In generation g, index i
+    // of scaled weight w is picked when (w * g + offset_i) mod kMaxWeight
+    // falls in the top w values, i.e. in w / kMaxWeight of generations.
+    while (true) {
+      const uint64_t sequence =
+          sequence_.fetch_add(1, std::memory_order_relaxed);
+      const size_t index = sequence % weights_.size();
+      const uint64_t generation = sequence / weights_.size();
+      const uint64_t weight = weights_[index];
+      const uint64_t offset = static_cast<uint64_t>(kOffset) * index;
+      if ((weight * generation + offset) % kMaxWeight >= kMaxWeight - weight) {
+        return index;
+      }
+    }
+  }
+
+ private:
+  StaticStrideScheduler(std::vector<uint16_t> weights,
+                        uint32_t initial_sequence)
+      : weights_(std::move(weights)), sequence_(initial_sequence) {}
+
+  const std::vector<uint16_t> weights_;
+  mutable std::atomic<uint32_t> sequence_;
+};
+
+//
+// weighted_round_robin LB policy
+//
+
+constexpr char kWeightedRoundRobin[] = "weighted_round_robin_experimental";
+
+constexpr Duration kDefaultOobReportingPeriod = Duration::Seconds(10);
+constexpr Duration kDefaultBlackoutPeriod = Duration::Seconds(10);
+constexpr Duration kDefaultWeightUpdatePeriod = Duration::Seconds(1);
+constexpr Duration kMinWeightUpdatePeriod = Duration::Milliseconds(100);
+constexpr Duration kDefaultWeightExpirationPeriod = Duration::Minutes(3);
+
+class WeightedRoundRobinConfig : public LoadBalancingPolicy::Config {
+ public:
+  WeightedRoundRobinConfig(bool enable_oob_load_report,
+                           Duration oob_reporting_period,
+                           Duration blackout_period,
+                           Duration weight_update_period,
+                           Duration weight_expiration_period)
+      : enable_oob_load_report_(enable_oob_load_report),
+        oob_reporting_period_(oob_reporting_period),
+        blackout_period_(blackout_period),
+        weight_update_period_(weight_update_period),
+        weight_expiration_period_(weight_expiration_period) {}
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  bool enable_oob_load_report() const { return enable_oob_load_report_; }
+  Duration oob_reporting_period() const { return oob_reporting_period_; }
+  Duration blackout_period() const { return blackout_period_; }
+  Duration weight_update_period() const { return weight_update_period_; }
+  Duration weight_expiration_period() const {
+    return weight_expiration_period_;
+  }
+
+ private:
+  bool enable_oob_load_report_;
+  Duration oob_reporting_period_;
+  Duration blackout_period_;
+  Duration weight_update_period_;
+  Duration weight_expiration_period_;
+};
+
+// Weight of one endpoint, derived from the load reports it sends.
+class EndpointWeight : public RefCounted<EndpointWeight> {
+ public:
+  // Records a load report. Reports without qps or utilization say nothing
+  // about the endpoint's capacity and are ignored.
+  void MaybeUpdateWeight(double qps, double cpu_utilization) {
+    if (qps <= 0 || cpu_utilization <= 0) return;
+    const Timestamp now = ExecCtx::Get()->Now();
+    MutexLock lock(&mu_);
+    weight_ = static_cast<float>(qps / cpu_utilization);
+    if (non_empty_since_ == Timestamp::InfFuture()) non_empty_since_ = now;
+    last_update_time_ = now;
+  }
+
+  // Returns the weight to pick with, or 0 if the endpoint has not reported
+  // for weight_expiration_period, or started reporting less than
+  // blackout_period ago.
+  float GetWeight(Timestamp now, Duration weight_expiration_period,
+                  Duration blackout_period) {
+    MutexLock lock(&mu_);
+    if (now - last_update_time_ >= weight_expiration_period) {
+      // The blackout period applies again once reports resume.
+      non_empty_since_ = Timestamp::InfFuture();
+      return 0;
+    }
+    if (blackout_period > Duration::Zero() &&
+        now - non_empty_since_ < blackout_period) {
+      return 0;
+    }
+    return weight_;
+  }
+
+ private:
+  Mutex mu_;
+  float weight_ ABSL_GUARDED_BY(mu_) = 0;
+  Timestamp non_empty_since_ ABSL_GUARDED_BY(mu_) = Timestamp::InfFuture();
+  Timestamp last_update_time_ ABSL_GUARDED_BY(mu_) = Timestamp::InfPast();
+};
+
+class WeightedRoundRobin : public LoadBalancingPolicy {
+ public:
+  explicit WeightedRoundRobin(Args args);
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ private:
+  ~WeightedRoundRobin() override;
+
+  // Forward declaration.
+  class WrrSubchannelList;
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  // - Holds the weight of the subchannel's endpoint, fed by out-of-band
+  //   load reports if they are enabled.
+  class WrrSubchannelData
+      : public SubchannelData<WrrSubchannelList, WrrSubchannelData> {
+   public:
+    WrrSubchannelData(
+        SubchannelList<WrrSubchannelList, WrrSubchannelData>* subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel);
+
+    grpc_connectivity_state connectivity_state() const {
+      return logical_connectivity_state_;
+    }
+
+    const RefCountedPtr<EndpointWeight>& weight() const { return weight_; }
+
+    // Computes and updates the logical connectivity state of the subchannel.
+    // Same as in round_robin: after TRANSIENT_FAILURE, subsequent state
+    // changes are ignored until READY.  Returns true if the state changed.
+    bool UpdateLogicalConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state);
+
+   private:
+    // Performs connectivity state updates that need to be done only
+    // after we have started watching.
+    void ProcessConnectivityChangeLocked(
+        grpc_connectivity_state connectivity_state) override;
+
+    grpc_connectivity_state logical_connectivity_state_ = GRPC_CHANNEL_IDLE;
+    RefCountedPtr<EndpointWeight> weight_;
+  };
+
+  // A list of subchannels.
+  class WrrSubchannelList
+      : public SubchannelList<WrrSubchannelList, WrrSubchannelData> {
+   public:
+    WrrSubchannelList(WeightedRoundRobin* policy, ServerAddressList addresses,
+                      const grpc_channel_args& args)
+        : SubchannelList(policy,
+                         (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)
+                              ? "WrrSubchannelList"
+                              : nullptr),
+                         std::move(addresses), policy->channel_control_helper(),
+                         args) {
+      // Need to maintain a ref to the LB policy as long as we maintain
+      // any references to subchannels, since the subchannels'
+      // pollset_sets will include the LB policy's pollset_set.
+      policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+    }
+
+    ~WrrSubchannelList() override {
+      WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    // Starts watching the subchannels in this list.
+    void StartWatchingLocked(absl::Status status_for_tf);
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(grpc_connectivity_state old_state,
+                                   grpc_connectivity_state new_state);
+
+    // Ensures that the right subchannel list is used and then updates
+    // the policy's connectivity state based on the subchannel list's
+    // state counters.
+    void MaybeUpdateWrrConnectivityStateLocked(absl::Status status_for_tf);
+
+    // Reports a picker with the current weights, if the list is READY.
+    void UpdateWeightsLocked();
+
+   private:
+    std::string CountersString() const {
+      return absl::StrCat("num_subchannels=", num_subchannels(),
+                          " num_ready=", num_ready_,
+                          " num_connecting=", num_connecting_,
+                          " num_transient_failure=", num_transient_failure_);
+    }
+
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+  };
+
+  // Feeds the load reports returned with calls into the endpoint's weight.
+  class CallTracker : public SubchannelCallTrackerInterface {
+   public:
+    explicit CallTracker(RefCountedPtr<EndpointWeight> weight)
+        : weight_(std::move(weight)) {}
+
+    void Start() override {}
+
+    void Finish(FinishArgs args) override {
+      const BackendMetricAccessor::BackendMetricData* backend_metric_data =
+          args.backend_metric_accessor->GetBackendMetricData();
+      if (backend_metric_data != nullptr) {
+        weight_->MaybeUpdateWeight(
+            static_cast<double>(backend_metric_data->requests_per_second),
+            backend_metric_data->cpu_utilization);
+      }
+    }
+
+   private:
+    RefCountedPtr<EndpointWeight> weight_;
+  };
+
+  // Feeds out-of-band load reports into the endpoint's weight.
+  class OobWatcher : public OobBackendMetricWatcher {
+   public:
+    explicit OobWatcher(RefCountedPtr<EndpointWeight> weight)
+        : weight_(std::move(weight)) {}
+
+    void OnBackendMetricReport(
+        const BackendMetricAccessor::BackendMetricData& backend_metric_data)
+        override {
+      weight_->MaybeUpdateWeight(
+          static_cast<double>(backend_metric_data.requests_per_second),
+          backend_metric_data.cpu_utilization);
+    }
+
+   private:
+    RefCountedPtr<EndpointWeight> weight_;
+  };
+
+  // Picks READY subchannels in proportion to their weights. The weights
+  // are fixed when the picker is created; the policy creates a new picker
+  // every weight update period. Without two positive weights, picks go
+  // round robin.
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(WeightedRoundRobin* parent, WrrSubchannelList* subchannel_list);
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    struct ReadySubchannel {
+      RefCountedPtr<SubchannelInterface> subchannel;
+      RefCountedPtr<EndpointWeight> weight;
+    };
+
+    // Using pointer value only, no ref held -- do not dereference!
+    WeightedRoundRobin* parent_;
+
+    const bool report_weights_;
+    std::vector<ReadySubchannel> subchannels_;
+    std::unique_ptr<StaticStrideScheduler> scheduler_;
+    // Used when there is no scheduler.
+    std::atomic<size_t> last_picked_index_;
+  };
+
+  struct ServerAddressLess {
+    bool operator()(const ServerAddress& a, const ServerAddress& b) const {
+      return a.Cmp(b) < 0;
+    }
+  };
+
+  void ShutdownLocked() override;
+
+  // Returns the weight that the previous subchannel list had for \a address,
+  // or a new one.
+  RefCountedPtr<EndpointWeight> GetEndpointWeightLocked(
+      const ServerAddress& address);
+
+  void StartWeightUpdateTimerLocked();
+  static void OnWeightUpdateTimer(void* arg, grpc_error_handle error);
+  void OnWeightUpdateTimerLocked(grpc_error_handle error);
+
+  RefCountedPtr<WeightedRoundRobinConfig> config_;
+  // Weights of the current subchannel list while a new one is created, so
+  // that endpoints it keeps do not go through the blackout period again.
+  std::map<ServerAddress, RefCountedPtr<EndpointWeight>, ServerAddressLess>
+      previous_weights_;
+  // List of subchannels.
+  OrphanablePtr<WrrSubchannelList> subchannel_list_;
+  // Latest pending subchannel list.
+  // When we get an updated address list, we create a new subchannel list
+  // for it here, and we wait to swap it into subchannel_list_ until the new
+  // list becomes READY.
+  OrphanablePtr<WrrSubchannelList> latest_pending_subchannel_list_;
+
+  grpc_timer weight_update_timer_;
+  grpc_closure on_weight_update_timer_;
+  bool weight_update_timer_pending_ = false;
+
+  bool shutdown_ = false;
+};
+
+//
+// WeightedRoundRobin::Picker
+//
+
+WeightedRoundRobin::Picker::Picker(WeightedRoundRobin* parent,
+                                   WrrSubchannelList* subchannel_list)
+    : parent_(parent),
+      report_weights_(!parent->config_->enable_oob_load_report()) {
+  std::vector<float> weights;
+  const Timestamp now = ExecCtx::Get()->Now();
+  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+    WrrSubchannelData* sd = subchannel_list->subchannel(i);
+    if (sd->connectivity_state() == GRPC_CHANNEL_READY) {
+      subchannels_.push_back(
+          ReadySubchannel{sd->subchannel()->Ref(), sd->weight()});
+      weights.push_back(sd->weight()->GetWeight(
+          now, parent->config_->weight_expiration_period(),
+          parent->config_->blackout_period()));
+    }
+  }
+  // For discussion on why we generate a random starting index for
+  // the picker, see https://github.com/grpc/grpc-go/issues/2580.
+  const uint32_t initial_sequence = static_cast<uint32_t>(FastRandom64());
+  scheduler_ = StaticStrideScheduler::Make(weights, initial_sequence);
+  last_picked_index_.store(initial_sequence % subchannels_.size(),
+                           std::memory_order_relaxed);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] created picker from subchannel_list=%p "
+            "with %" PRIuPTR " READY subchannels, %s",
+            parent_, this, subchannel_list, subchannels_.size(),
+            scheduler_ != nullptr ? "weighted" : "unweighted");
+  }
+}
+
+WeightedRoundRobin::PickResult WeightedRoundRobin::Picker::Pick(
+    PickArgs /*args*/) {
+  size_t index;
+  if (scheduler_ != nullptr) {
+    index = scheduler_->Pick();
+  } else {
+    index = last_picked_index_.fetch_add(1, std::memory_order_relaxed) %
+            subchannels_.size();
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] returning index %" PRIuPTR ", subchannel=%p",
+            parent_, this, index, subchannels_[index].subchannel.get());
+  }
+  const ReadySubchannel& picked = subchannels_[index];
+  if (!report_weights_) return PickResult::Complete(picked.subchannel);
+  return PickResult::Complete(picked.subchannel,
+                              absl::make_unique<CallTracker>(picked.weight));
+}
+
+//
+// WeightedRoundRobin
+//
+
+WeightedRoundRobin::WeightedRoundRobin(Args args)
+    : LoadBalancingPolicy(std::move(args)) {
+  GRPC_CLOSURE_INIT(&on_weight_update_timer_, OnWeightUpdateTimer, this,
+                    nullptr);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Created", this);
+  }
+}
+
+WeightedRoundRobin::~WeightedRoundRobin() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Destroying Weighted Round Robin policy",
+            this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+void WeightedRoundRobin::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Shutting down", this);
+  }
+  shutdown_ = true;
+  if (weight_update_timer_pending_) grpc_timer_cancel(&weight_update_timer_);
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+}
+
+void WeightedRoundRobin::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+void WeightedRoundRobin::UpdateLocked(UpdateArgs args) {
+  config_ = std::move(args.config);
+  ServerAddressList addresses;
+  if (args.addresses.ok()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] received update with %" PRIuPTR " addresses",
+              this, args.addresses->size());
+    }
+    addresses = std::move(*args.addresses);
+  } else {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] received update with address error: %s",
+              this, args.addresses.status().ToString().c_str());
+    }
+    // If we already have a subchannel list, then ignore the resolver
+    // failure and keep using the existing list.
+    if (subchannel_list_ != nullptr) return;
+  }
+  // Create new subchannel list, replacing the previous pending list, if any.
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace) &&
+      latest_pending_subchannel_list_ != nullptr) {
+    gpr_log(GPR_INFO, "[WRR %p] replacing previous pending subchannel list %p",
+            this, latest_pending_subchannel_list_.get());
+  }
+  // Out-of-band watchers are set up per subchannel list, so weights carry
+  // over only while the reporting mode stays the same.
+  if (subchannel_list_ != nullptr) {
+    for (size_t i = 0; i < subchannel_list_->num_subchannels(); ++i) {
+      WrrSubchannelData* sd = subchannel_list_->subchannel(i);
+      previous_weights_.emplace(sd->address(), sd->weight());
+    }
+  }
+  latest_pending_subchannel_list_ = MakeOrphanable<WrrSubchannelList>(
+      this, std::move(addresses), *args.args);
+  previous_weights_.clear();
+  // Start watching the new list.  If appropriate, this will cause it to be
+  // immediately promoted to subchannel_list_ and to generate a new picker.
+  latest_pending_subchannel_list_->StartWatchingLocked(
+      args.addresses.ok() ? absl::UnavailableError(absl::StrCat(
+                                "empty address list: ", args.resolution_note))
+                          : args.addresses.status());
+}
+
+RefCountedPtr<EndpointWeight> WeightedRoundRobin::GetEndpointWeightLocked(
+    const ServerAddress& address) {
+  auto it = previous_weights_.find(address);
+  if (it == previous_weights_.end()) return MakeRefCounted<EndpointWeight>();
+  return it->second;
+}
+
+void WeightedRoundRobin::StartWeightUpdateTimerLocked() {
+  if (weight_update_timer_pending_ || shutdown_) return;
+  weight_update_timer_pending_ = true;
+  Ref(DEBUG_LOCATION, "WeightUpdateTimer").release();
+  grpc_timer_init(&weight_update_timer_,
+                  ExecCtx::Get()->Now() + config_->weight_update_period(),
+                  &on_weight_update_timer_);
+}
+
+void WeightedRoundRobin::OnWeightUpdateTimer(void* arg,
+                                             grpc_error_handle error) {
+  auto* self = static_cast<WeightedRoundRobin*>(arg);
+  (void)GRPC_ERROR_REF(error);  // ref owned by lambda
+  self->work_serializer()->Run(
+      [self, error]() { self->OnWeightUpdateTimerLocked(error); },
+      DEBUG_LOCATION);
+}
+
+void WeightedRoundRobin::OnWeightUpdateTimerLocked(grpc_error_handle error) {
+  weight_update_timer_pending_ = false;
+  if (error == GRPC_ERROR_NONE && !shutdown_ && subchannel_list_ != nullptr) {
+    // Restarts the timer if the list is still READY.
+    subchannel_list_->UpdateWeightsLocked();
+  }
+  Unref(DEBUG_LOCATION, "WeightUpdateTimer");
+  GRPC_ERROR_UNREF(error);
+}
+
+//
+// WrrSubchannelList
+//
+
+void WeightedRoundRobin::WrrSubchannelList::StartWatchingLocked(
+    absl::Status status_for_tf) {
+  // Check current state of each subchannel synchronously, since any
+  // subchannel already used by some other channel may have a non-IDLE
+  // state.
+  for (size_t i = 0; i < num_subchannels(); ++i) {
+    grpc_connectivity_state state =
+        subchannel(i)->CheckConnectivityStateLocked();
+    if (state != GRPC_CHANNEL_IDLE) {
+      subchannel(i)->UpdateLogicalConnectivityStateLocked(state);
+    }
+  }
+  // Start connectivity watch for each subchannel.
+  for (size_t i = 0; i < num_subchannels(); i++) {
+    if (subchannel(i)->subchannel() != nullptr) {
+      subchannel(i)->StartConnectivityWatchLocked();
+      subchannel(i)->subchannel()->RequestConnection();
+    }
+  }
+  // Update the policy's connectivity state if needed.
+  MaybeUpdateWrrConnectivityStateLocked(status_for_tf);
+}
+
+void WeightedRoundRobin::WrrSubchannelList::UpdateStateCountersLocked(
+    grpc_connectivity_state old_state, grpc_connectivity_state new_state) {
+  GPR_ASSERT(old_state != GRPC_CHANNEL_SHUTDOWN);
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (old_state == GRPC_CHANNEL_READY) {
+    GPR_ASSERT(num_ready_ > 0);
+    --num_ready_;
+  } else if (old_state == GRPC_CHANNEL_CONNECTING) {
+    GPR_ASSERT(num_connecting_ > 0);
+    --num_connecting_;
+  } else if (old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    GPR_ASSERT(num_transient_failure_ > 0);
+    --num_transient_failure_;
+  }
+  if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+void WeightedRoundRobin::WrrSubchannelList::
+    MaybeUpdateWrrConnectivityStateLocked(absl::Status status_for_tf) {
+  WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+  // Swap this list in under the same conditions as round_robin does.
+  if (p->latest_pending_subchannel_list_.get() == this &&
+      (p->subchannel_list_ == nullptr || p->subchannel_list_->num_ready_ == 0 ||
+       num_ready_ > 0 ||
+       // Note: num_transient_failure_ and num_subchannels() may both be 0.
+       num_transient_failure_ == num_subchannels())) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      const std::string old_counters_string =
+          p->subchannel_list_ != nullptr ? p->subchannel_list_->CountersString()
+                                         : "";
+      gpr_log(
+          GPR_INFO,
+          "[WRR %p] swapping out subchannel list %p (%s) in favor of %p (%s)",
+          p, p->subchannel_list_.get(), old_counters_string.c_str(), this,
+          CountersString().c_str());
+    }
+    p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+  }
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  // First matching rule wins:
+  // 1) ANY subchannel is READY => policy is READY.
+  // 2) ANY subchannel is CONNECTING => policy is CONNECTING.
+  // 3) ALL subchannels are TRANSIENT_FAILURE => policy is TRANSIENT_FAILURE.
+  if (num_ready_ > 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] reporting READY with subchannel list %p", p,
+              this);
+    }
+    UpdateWeightsLocked();
+  } else if (num_connecting_ > 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] reporting CONNECTING with subchannel list %p",
+              p, this);
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, absl::Status(),
+        absl::make_unique<QueuePicker>(p->Ref(DEBUG_LOCATION, "QueuePicker")));
+  } else if (num_transient_failure_ == num_subchannels()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] reporting TRANSIENT_FAILURE with subchannel list %p: "
+              "%s",
+              p, this, status_for_tf.ToString().c_str());
+    }
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, status_for_tf,
+        absl::make_unique<TransientFailurePicker>(status_for_tf));
+  }
+}
+
+void WeightedRoundRobin::WrrSubchannelList::UpdateWeightsLocked() {
+  if (num_ready_ == 0) return;
+  WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+  p->channel_control_helper()->UpdateState(GRPC_CHANNEL_READY, absl::Status(),
+                                           absl::make_unique<Picker>(p, this));
+  p->StartWeightUpdateTimerLocked();
+}
+
+//
+// WrrSubchannelData
+//
+
+WeightedRoundRobin::WrrSubchannelData::WrrSubchannelData(
+    SubchannelList<WrrSubchannelList, WrrSubchannelData>* subchannel_list,
+    const ServerAddress& address, RefCountedPtr<SubchannelInterface> subchannel)
+    : SubchannelData(subchannel_list, address, std::move(subchannel)) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list->policy());
+  weight_ = p->GetEndpointWeightLocked(address);
+  if (p->config_->enable_oob_load_report()) {
+    this->subchannel()->AddDataWatcher(MakeOobBackendMetricWatcher(
+        p->config_->oob_reporting_period(),
+        absl::make_unique<OobWatcher>(weight_)));
+  }
+}
+
+bool WeightedRoundRobin::WrrSubchannelData::
+    UpdateLogicalConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list()->policy());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(
+        GPR_INFO,
+        "[WRR %p] connectivity changed for subchannel %p, subchannel_list %p "
+        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
+        p, subchannel(), subchannel_list(), Index(),
+        subchannel_list()->num_subchannels(),
+        ConnectivityStateName(logical_connectivity_state_),
+        ConnectivityStateName(connectivity_state));
+  }
+  // If the last logical state was TRANSIENT_FAILURE, then ignore the
+  // state change unless the new state is READY.
+  if (logical_connectivity_state_ == GRPC_CHANNEL_TRANSIENT_FAILURE &&
+      connectivity_state != GRPC_CHANNEL_READY) {
+    return false;
+  }
+  // If the new state is IDLE, treat it as CONNECTING, since it will
+  // immediately transition into CONNECTING anyway.
+  if (connectivity_state == GRPC_CHANNEL_IDLE) {
+    connectivity_state = GRPC_CHANNEL_CONNECTING;
+  }
+  // If no change, return false.
+  if (logical_connectivity_state_ == connectivity_state) return false;
+  // Otherwise, update counters and logical state.
+  subchannel_list()->UpdateStateCountersLocked(logical_connectivity_state_,
+                                               connectivity_state);
+  logical_connectivity_state_ = connectivity_state;
+  return true;
+}
+
+void WeightedRoundRobin::WrrSubchannelData::ProcessConnectivityChangeLocked(
+    grpc_connectivity_state connectivity_state) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list()->policy());
+  GPR_ASSERT(subchannel() != nullptr);
+  // If the new state is TRANSIENT_FAILURE or IDLE, re-resolve and attempt
+  // to reconnect.
+  if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE ||
+      connectivity_state == GRPC_CHANNEL_IDLE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] Subchannel %p reported %s; requesting re-resolution",
+              p, subchannel(), ConnectivityStateName(connectivity_state));
+    }
+    p->channel_control_helper()->RequestReresolution();
+    subchannel()->RequestConnection();
+  }
+  // Update logical connectivity state.
+  // If it changed, update the policy state.
+  if (UpdateLogicalConnectivityStateLocked(connectivity_state)) {
+    subchannel_list()->MaybeUpdateWrrConnectivityStateLocked(
+        absl::UnavailableError("connections to all backends failing"));
+  }
+}
+
+//
+// factory
+//
+
+class WeightedRoundRobinFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<WeightedRoundRobin>(std::move(args));
+  }
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const Json& json, grpc_error_handle* error) const override {
+    bool enable_oob_load_report = false;
+    Duration oob_reporting_period = kDefaultOobReportingPeriod;
+    Duration blackout_period = kDefaultBlackoutPeriod;
+    Duration weight_update_period = kDefaultWeightUpdatePeriod;
+    Duration weight_expiration_period = kDefaultWeightExpirationPeriod;
+    if (json.type() == Json::Type::JSON_NULL) {
+      return MakeRefCounted<WeightedRoundRobinConfig>(
+          enable_oob_load_report, oob_reporting_period, blackout_period,
+          weight_update_period, weight_expiration_period);
+    }
+    if (json.type() != Json::Type::OBJECT) {
+      *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "weighted_round_robin_experimental should be of type object");
+      return nullptr;
+    }
+    std::vector<grpc_error_handle> error_list;
+    const Json::Object& object = json.object_value();
+    ParseJsonObjectField(object, "enableOobLoadReport",
+                         &enable_oob_load_report, &error_list,
+                         /*required=*/false);
+    ParseJsonObjectFieldAsDuration(object, "oobReportingPeriod",
+                                   &oob_reporting_period, &error_list,
+                                   /*required=*/false);
+    ParseJsonObjectFieldAsDuration(object, "blackoutPeriod", &blackout_period,
+                                   &error_list, /*required=*/false);
+    ParseJsonObjectFieldAsDuration(object, "weightUpdatePeriod",
+                                   &weight_update_period, &error_list,
+                                   /*required=*/false);
+    ParseJsonObjectFieldAsDuration(object, "weightExpirationPeriod",
+                                   &weight_expiration_period, &error_list,
+                                   /*required=*/false);
+    if (!error_list.empty()) {
+      *error = GRPC_ERROR_CREATE_FROM_VECTOR(
+          "weighted_round_robin_experimental LB policy config", &error_list);
+      return nullptr;
+    }
+    // Short update periods would mostly churn pickers.
+    weight_update_period =
+        std::max(weight_update_period, kMinWeightUpdatePeriod);
+    return MakeRefCounted<WeightedRoundRobinConfig>(
+        enable_oob_load_report, oob_reporting_period, blackout_period,
+        weight_update_period, weight_expiration_period);
+  }
+};
+
+}  // namespace
+
+}  // namespace grpc_core
+
+void grpc_lb_policy_weighted_round_robin_init() {
+  grpc_core::LoadBalancingPolicyRegistry::Builder::
+      RegisterLoadBalancingPolicyFactory(
+          absl::make_unique<grpc_core::WeightedRoundRobinFactory>());
+}
+
+void grpc_lb_policy_weighted_round_robin_shutdown() {}
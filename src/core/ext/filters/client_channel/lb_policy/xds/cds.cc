@@ -407,6 +407,9 @@ absl::StatusOr<bool> CdsLb::GenerateDiscoveryMechanismForCluster(
     mechanism["lrsLoadReportingServer"] =
         state.update->lrs_load_reporting_server->ToJson();
   }
+  if (state.update->outlier_detection.has_value()) {
+    mechanism["outlierDetection"] = state.update->outlier_detection->ToJson();
+  }
   discovery_mechanisms->emplace_back(std::move(mechanism));
   return true;
 }
@@ -456,6 +459,10 @@ void CdsLb::OnClusterChanged(const std::string& name,
           {"min_ring_size", cluster_data.min_ring_size},
           {"max_ring_size", cluster_data.max_ring_size},
       };
+    } else if (lb_policy == "LEAST_REQUEST") {
+      xds_lb_policy["LEAST_REQUEST"] = Json::Object{
+          {"choiceCount", it->second.update->choice_count},
+      };
     } else {
       xds_lb_policy["ROUND_ROBIN"] = Json::Object();
     }
@@ -16,6 +16,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <limits.h>
 #include <stddef.h>
 
 #include <algorithm>
@@ -43,6 +44,7 @@
 #include "src/core/ext/filters/client_channel/resolver/xds/xds_resolver.h"
 #include "src/core/ext/filters/client_channel/subchannel_interface.h"
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/orphanable.h"
@@ -210,6 +212,15 @@ class XdsClusterManagerLb : public LoadBalancingPolicy {
   void ShutdownLocked() override;
 
   void UpdateStateLocked();
+  // Called when a child reports a new state.  Updates our state right
+  // away or, within the update coalescing window, defers it.
+  void OnChildStateChangedLocked();
+
+  void StartCoalescingTimerLocked();
+  static void OnCoalescingTimer(void* arg, grpc_error_handle error);
+  void OnCoalescingTimerLocked(grpc_error_handle error);
+
+  const Duration update_coalescing_window_;
 
   // Current config from the resolver.
   RefCountedPtr<XdsClusterManagerLbConfig> config_;
@@ -218,6 +229,12 @@ class XdsClusterManagerLb : public LoadBalancingPolicy {
   bool shutting_down_ = false;
   bool update_in_progress_ = false;
 
+  // State for coalescing child state updates.
+  grpc_timer coalescing_timer_;
+  grpc_closure on_coalescing_timer_;
+  bool coalescing_timer_pending_ = false;
+  bool state_update_deferred_ = false;
+
   // Children.
   std::map<std::string, OrphanablePtr<ClusterChild>> children_;
 };
@@ -243,7 +260,13 @@ XdsClusterManagerLb::PickResult XdsClusterManagerLb::ClusterPicker::Pick(
 //
 
 XdsClusterManagerLb::XdsClusterManagerLb(Args args)
-    : LoadBalancingPolicy(std::move(args)) {}
+    : LoadBalancingPolicy(std::move(args)),
+      update_coalescing_window_(
+          Duration::Milliseconds(grpc_channel_args_find_integer(
+              args.args, GRPC_ARG_XDS_UPDATE_COALESCING_WINDOW_MS,
+              {0, 0, INT_MAX}))) {
+  GRPC_CLOSURE_INIT(&on_coalescing_timer_, OnCoalescingTimer, this, nullptr);
+}
 
 XdsClusterManagerLb::~XdsClusterManagerLb() {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_cluster_manager_lb_trace)) {
@@ -259,6 +282,7 @@ void XdsClusterManagerLb::ShutdownLocked() {
     gpr_log(GPR_INFO, "[xds_cluster_manager_lb %p] shutting down", this);
   }
   shutting_down_ = true;
+  if (coalescing_timer_pending_) grpc_timer_cancel(&coalescing_timer_);
   children_.clear();
 }
 
@@ -308,6 +332,8 @@ void XdsClusterManagerLb::UpdateStateLocked() {
   // all children.  This avoids unnecessary picker churn while an update
   // is being propagated to our children.
   if (update_in_progress_) return;
+  // This update also covers any deferred one.
+  state_update_deferred_ = false;
   // Also count the number of children in each state, to determine the
   // overall state.
   size_t num_ready = 0;
@@ -386,6 +412,50 @@ void XdsClusterManagerLb::UpdateStateLocked() {
                                         std::move(picker));
 }
 
+void XdsClusterManagerLb::OnChildStateChangedLocked() {
+  if (update_coalescing_window_ == Duration::Zero()) {
+    UpdateStateLocked();
+    return;
+  }
+  // Within the window, hold the update.  All updates held in one window
+  // are applied together when it ends.
+  if (coalescing_timer_pending_) {
+    if (state_update_deferred_) GRPC_STATS_INC_XDS_COALESCED_UPDATES();
+    state_update_deferred_ = true;
+    return;
+  }
+  UpdateStateLocked();
+  StartCoalescingTimerLocked();
+}
+
+void XdsClusterManagerLb::StartCoalescingTimerLocked() {
+  Ref(DEBUG_LOCATION, "CoalescingTimer").release();
+  coalescing_timer_pending_ = true;
+  grpc_timer_init(&coalescing_timer_,
+                  ExecCtx::Get()->Now() + update_coalescing_window_,
+                  &on_coalescing_timer_);
+}
+
+void XdsClusterManagerLb::OnCoalescingTimer(void* arg,
+                                            grpc_error_handle error) {
+  XdsClusterManagerLb* self = static_cast<XdsClusterManagerLb*>(arg);
+  (void)GRPC_ERROR_REF(error);  // Ref owned by the lambda
+  self->work_serializer()->Run(
+      [self, error]() { self->OnCoalescingTimerLocked(error); },
+      DEBUG_LOCATION);
+}
+
+void XdsClusterManagerLb::OnCoalescingTimerLocked(grpc_error_handle error) {
+  coalescing_timer_pending_ = false;
+  if (error == GRPC_ERROR_NONE && !shutting_down_ && state_update_deferred_) {
+    UpdateStateLocked();
+    // Keep coalescing while updates keep coming.
+    StartCoalescingTimerLocked();
+  }
+  Unref(DEBUG_LOCATION, "CoalescingTimer");
+  GRPC_ERROR_UNREF(error);
+}
+
 //
 // XdsClusterManagerLb::ClusterChild
 //
@@ -588,7 +658,8 @@ void XdsClusterManagerLb::ClusterChild::Helper::UpdateState(
   }
   xds_cluster_manager_child_->connectivity_state_ = state;
   // Notify the LB policy.
-  xds_cluster_manager_child_->xds_cluster_manager_policy_->UpdateStateLocked();
+  xds_cluster_manager_child_->xds_cluster_manager_policy_
+      ->OnChildStateChangedLocked();
 }
 
 void XdsClusterManagerLb::ClusterChild::Helper::RequestReresolution() {
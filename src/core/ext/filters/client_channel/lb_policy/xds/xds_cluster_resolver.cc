@@ -17,6 +17,7 @@
 #include <grpc/support/port_platform.h>
 
 #include <inttypes.h>
+#include <limits.h>
 #include <stddef.h>
 
 #include <algorithm>
@@ -56,6 +57,7 @@
 #include "src/core/ext/xds/xds_resource_type_impl.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/debug_location.h"
@@ -63,6 +65,7 @@
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/iomgr/work_serializer.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/resolver/resolver.h"
@@ -96,6 +99,11 @@ class XdsClusterResolverLbConfig : public LoadBalancingPolicy::Config {
     DiscoveryMechanismType type;
     std::string eds_service_name;
     std::string dns_hostname;
+    // Config of the outlier_detection policy wrapping this mechanism's
+    // priorities, without childPolicy. Null if outlier detection is off.
+    // Not compared by operator==, since changing it only takes a config
+    // update of the existing policies.
+    Json outlier_detection_lb_config;
 
     bool operator==(const DiscoveryMechanism& other) const {
       return (cluster_name == other.cluster_name &&
@@ -337,6 +345,13 @@ class XdsClusterResolverLb : public LoadBalancingPolicy {
 
   void MaybeDestroyChildPolicyLocked();
 
+  // Updates the child policy right away or, within the update coalescing
+  // window, defers the update.
+  void MaybeUpdateChildPolicyLocked();
+  void StartCoalescingTimerLocked();
+  static void OnCoalescingTimer(void* arg, grpc_error_handle error);
+  void OnCoalescingTimerLocked(grpc_error_handle error);
+
   void UpdateChildPolicyLocked();
   OrphanablePtr<LoadBalancingPolicy> CreateChildPolicyLocked(
       const grpc_channel_args* args);
@@ -355,6 +370,13 @@ class XdsClusterResolverLb : public LoadBalancingPolicy {
   // Internal state.
   bool shutting_down_ = false;
 
+  // State for coalescing discovery mechanism updates.
+  const Duration update_coalescing_window_;
+  grpc_timer coalescing_timer_;
+  grpc_closure on_coalescing_timer_;
+  bool coalescing_timer_pending_ = false;
+  bool child_policy_update_deferred_ = false;
+
   // Vector of discovery mechansism entries in priority order.
   std::vector<DiscoveryMechanismEntry> discovery_mechanisms_;
 
@@ -532,7 +554,13 @@ std::string XdsClusterResolverLb::DiscoveryMechanismEntry::GetChildPolicyName(
 
 XdsClusterResolverLb::XdsClusterResolverLb(RefCountedPtr<XdsClient> xds_client,
                                            Args args)
-    : LoadBalancingPolicy(std::move(args)), xds_client_(std::move(xds_client)) {
+    : LoadBalancingPolicy(std::move(args)),
+      xds_client_(std::move(xds_client)),
+      update_coalescing_window_(
+          Duration::Milliseconds(grpc_channel_args_find_integer(
+              args.args, GRPC_ARG_XDS_UPDATE_COALESCING_WINDOW_MS,
+              {0, 0, INT_MAX}))) {
+  GRPC_CLOSURE_INIT(&on_coalescing_timer_, OnCoalescingTimer, this, nullptr);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_xds_cluster_resolver_trace)) {
     gpr_log(GPR_INFO, "[xds_cluster_resolver_lb %p] created -- xds_client=%p",
             this, xds_client_.get());
@@ -553,6 +581,7 @@ void XdsClusterResolverLb::ShutdownLocked() {
     gpr_log(GPR_INFO, "[xds_cluster_resolver_lb %p] shutting down", this);
   }
   shutting_down_ = true;
+  if (coalescing_timer_pending_) grpc_timer_cancel(&coalescing_timer_);
   MaybeDestroyChildPolicyLocked();
   discovery_mechanisms_.clear();
   xds_client_.reset(DEBUG_LOCATION, "XdsClusterResolverLb");
@@ -714,7 +743,7 @@ void XdsClusterResolverLb::OnEndpointChanged(size_t index,
     if (!mechanism.latest_update.has_value()) return;
   }
   // Update child policy.
-  UpdateChildPolicyLocked();
+  MaybeUpdateChildPolicyLocked();
 }
 
 void XdsClusterResolverLb::OnError(size_t index, absl::Status status) {
@@ -804,7 +833,15 @@ XdsClusterResolverLb::CreateChildPolicyConfigLocked() {
             discovery_entry.discovery_mechanism->override_child_policy();
       } else {
         const auto& xds_lb_policy = config_->xds_lb_policy().object_value();
-        if (xds_lb_policy.find("ROUND_ROBIN") != xds_lb_policy.end()) {
+        auto least_request_it = xds_lb_policy.find("LEAST_REQUEST");
+        if (xds_lb_policy.find("ROUND_ROBIN") != xds_lb_policy.end() ||
+            least_request_it != xds_lb_policy.end()) {
+          // Each locality balances its endpoints with the configured policy.
+          Json endpoint_picking_policy =
+              least_request_it != xds_lb_policy.end()
+                  ? Json::Object{{"least_request_experimental",
+                                  least_request_it->second}}
+                  : Json::Object{{"round_robin", Json::Object()}};
           const auto& localities = priority_entry.localities;
           Json::Object weighted_targets;
           for (const auto& p : localities) {
@@ -816,9 +853,7 @@ XdsClusterResolverLb::CreateChildPolicyConfigLocked() {
                     {"weight", locality.lb_weight},
                     {"childPolicy",
                      Json::Array{
-                         Json::Object{
-                             {"round_robin", Json::Object()},
-                         },
+                         endpoint_picking_policy,
                      }},
                 };
           }
@@ -878,6 +913,18 @@ XdsClusterResolverLb::CreateChildPolicyConfigLocked() {
       Json locality_picking_policy = Json::Array{Json::Object{
           {"xds_cluster_impl_experimental", std::move(xds_cluster_impl_config)},
       }};
+      // Wrap it in the outlier_detection policy, if configured.
+      if (discovery_config.outlier_detection_lb_config.type() ==
+          Json::Type::OBJECT) {
+        Json::Object outlier_detection_config =
+            discovery_config.outlier_detection_lb_config.object_value();
+        outlier_detection_config["childPolicy"] =
+            std::move(locality_picking_policy);
+        locality_picking_policy = Json::Array{Json::Object{
+            {"outlier_detection_experimental",
+             std::move(outlier_detection_config)},
+        }};
+      }
       // Add priority entry, with the appropriate child name.
       std::string child_name = discovery_entry.GetChildPolicyName(priority);
       priority_priorities.emplace_back(child_name);
@@ -926,8 +973,56 @@ XdsClusterResolverLb::CreateChildPolicyConfigLocked() {
   return config;
 }
 
+void XdsClusterResolverLb::MaybeUpdateChildPolicyLocked() {
+  // The first update creates the child policy, so it is never deferred.
+  if (update_coalescing_window_ == Duration::Zero() ||
+      child_policy_ == nullptr) {
+    UpdateChildPolicyLocked();
+    return;
+  }
+  // Within the window, hold the update.  The latest update of each
+  // discovery mechanism is applied when the window ends.
+  if (coalescing_timer_pending_) {
+    if (child_policy_update_deferred_) GRPC_STATS_INC_XDS_COALESCED_UPDATES();
+    child_policy_update_deferred_ = true;
+    return;
+  }
+  UpdateChildPolicyLocked();
+  StartCoalescingTimerLocked();
+}
+
+void XdsClusterResolverLb::StartCoalescingTimerLocked() {
+  Ref(DEBUG_LOCATION, "CoalescingTimer").release();
+  coalescing_timer_pending_ = true;
+  grpc_timer_init(&coalescing_timer_,
+                  ExecCtx::Get()->Now() + update_coalescing_window_,
+                  &on_coalescing_timer_);
+}
+
+void XdsClusterResolverLb::OnCoalescingTimer(void* arg,
+                                             grpc_error_handle error) {
+  XdsClusterResolverLb* self = static_cast<XdsClusterResolverLb*>(arg);
+  (void)GRPC_ERROR_REF(error);  // Ref owned by the lambda
+  self->work_serializer()->Run(
+      [self, error]() { self->OnCoalescingTimerLocked(error); },
+      DEBUG_LOCATION);
+}
+
+void XdsClusterResolverLb::OnCoalescingTimerLocked(grpc_error_handle error) {
+  coalescing_timer_pending_ = false;
+  if (error == GRPC_ERROR_NONE && child_policy_update_deferred_) {
+    UpdateChildPolicyLocked();
+    // Keep coalescing while updates keep coming.
+    if (!shutting_down_) StartCoalescingTimerLocked();
+  }
+  Unref(DEBUG_LOCATION, "CoalescingTimer");
+  GRPC_ERROR_UNREF(error);
+}
+
 void XdsClusterResolverLb::UpdateChildPolicyLocked() {
   if (shutting_down_) return;
+  // This update also covers any deferred one.
+  child_policy_update_deferred_ = false;
   UpdateArgs update_args;
   update_args.config = CreateChildPolicyConfigLocked();
   if (update_args.config == nullptr) return;
@@ -1073,6 +1168,16 @@ class XdsClusterResolverLbFactory : public LoadBalancingPolicyFactory {
             }
             break;
           }
+          policy_it = policy.find("LEAST_REQUEST");
+          if (policy_it != policy.end()) {
+            if (policy_it->second.type() != Json::Type::OBJECT) {
+              error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                  "field:LEAST_REQUEST error:type should be object"));
+            } else {
+              xds_lb_policy = array[i];
+            }
+            break;
+          }
           policy_it = policy.find("RING_HASH");
           if (policy_it != policy.end()) {
             xds_lb_policy = array[i];
@@ -1145,6 +1250,16 @@ class XdsClusterResolverLbFactory : public LoadBalancingPolicyFactory {
             gpr_parse_nonnegative_int(it->second.string_value().c_str());
       }
     }
+    // Outlier detection config.
+    it = json.object_value().find("outlierDetection");
+    if (it != json.object_value().end()) {
+      if (it->second.type() != Json::Type::OBJECT) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:outlierDetection error:type should be object"));
+      } else {
+        discovery_mechanism->outlier_detection_lb_config = it->second;
+      }
+    }
     // Discovery Mechanism type
     it = json.object_value().find("type");
     if (it == json.object_value().end()) {
@@ -33,6 +33,7 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/strip.h"
+#include "absl/types/optional.h"
 
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/support/alloc.h>
@@ -50,7 +51,9 @@
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/iomgr_fwd.h"
+#include "src/core/lib/iomgr/pollset_set.h"
 #include "src/core/lib/iomgr/resolved_address.h"
+#include "src/core/lib/resolver/dns_cache.h"
 #include "src/core/lib/resolver/resolver.h"
 #include "src/core/lib/resolver/resolver_factory.h"
 #include "src/core/lib/service_config/service_config.h"
@@ -91,6 +94,102 @@ namespace grpc_core {
 
 namespace {
 
+// The outputs of a lookup, as shared through the DNS cache.
+struct AresResult {
+  absl::optional<ServerAddressList> addresses;
+  absl::optional<ServerAddressList> balancer_addresses;
+  absl::optional<std::string> service_config_json;
+};
+
+DnsCache<AresResult>* SharedDnsCache() {
+  static DnsCache<AresResult>* cache = new DnsCache<AresResult>();
+  return cache;
+}
+
+// The lookups started through the cache do not belong to any channel: they
+// are polled through this set, which the channels waiting for them add to
+// their interested parties.
+grpc_pollset_set* SharedLookupPollsetSet() {
+  static grpc_pollset_set* pollset_set = grpc_pollset_set_create();
+  return pollset_set;
+}
+
+// A lookup started through the cache on behalf of all of the channels
+// resolving the same name. It reports the smallest TTL of the records it
+// got, or zero if it does not know of any.
+class SharedAresRequest : public InternallyRefCounted<SharedAresRequest> {
+ public:
+  SharedAresRequest(const std::string& dns_server, const std::string& name,
+                    bool enable_srv_queries, bool request_service_config,
+                    int query_timeout_ms,
+                    DnsCache<AresResult>::OnLookupDone on_done)
+      : on_done_(std::move(on_done)) {
+    Ref(DEBUG_LOCATION, "OnResolved").release();
+    GRPC_CLOSURE_INIT(&on_resolved_, OnResolved, this, nullptr);
+    MutexLock lock(&mu_);
+    request_.reset(grpc_dns_lookup_ares(
+        dns_server.c_str(), name.c_str(), kDefaultSecurePort,
+        SharedLookupPollsetSet(), &on_resolved_, &addresses_,
+        enable_srv_queries ? &balancer_addresses_ : nullptr,
+        request_service_config ? &service_config_json_ : nullptr,
+        query_timeout_ms));
+  }
+
+  ~SharedAresRequest() override { gpr_free(service_config_json_); }
+
+  void Orphan() override {
+    {
+      MutexLock lock(&mu_);
+      if (request_ != nullptr) grpc_cancel_ares_request(request_.get());
+    }
+    Unref(DEBUG_LOCATION, "Orphan");
+  }
+
+ private:
+  static void OnResolved(void* arg, grpc_error_handle error) {
+    static_cast<SharedAresRequest*>(arg)->OnResolved(error);
+  }
+
+  void OnResolved(grpc_error_handle error) {
+    Duration ttl = Duration::Zero();
+    {
+      MutexLock lock(&mu_);
+      if (request_ != nullptr) {
+        MutexLock request_lock(&request_->mu);
+        if (request_->min_ttl != Duration::Infinity()) {
+          ttl = request_->min_ttl;
+        }
+      }
+    }
+    absl::StatusOr<AresResult> result;
+    if (addresses_ != nullptr || balancer_addresses_ != nullptr) {
+      AresResult outputs;
+      if (addresses_ != nullptr) outputs.addresses = std::move(*addresses_);
+      if (balancer_addresses_ != nullptr) {
+        outputs.balancer_addresses = std::move(*balancer_addresses_);
+      }
+      if (service_config_json_ != nullptr) {
+        outputs.service_config_json = service_config_json_;
+      }
+      result = std::move(outputs);
+    } else {
+      std::string error_message;
+      grpc_error_get_str(error, GRPC_ERROR_STR_DESCRIPTION, &error_message);
+      result = absl::UnavailableError(error_message);
+    }
+    on_done_(std::move(result), ttl);
+    Unref(DEBUG_LOCATION, "OnResolved");
+  }
+
+  const DnsCache<AresResult>::OnLookupDone on_done_;
+  Mutex mu_;
+  std::unique_ptr<grpc_ares_request> request_ ABSL_GUARDED_BY(mu_);
+  grpc_closure on_resolved_;
+  std::unique_ptr<ServerAddressList> addresses_;
+  std::unique_ptr<ServerAddressList> balancer_addresses_;
+  char* service_config_json_ = nullptr;
+};
+
 class AresClientChannelDNSResolver : public PollingResolver {
  public:
   AresClientChannelDNSResolver(ResolverArgs args,
@@ -106,6 +205,10 @@ class AresClientChannelDNSResolver : public PollingResolver {
         : resolver_(std::move(resolver)) {
       Ref(DEBUG_LOCATION, "OnResolved").release();
       GRPC_CLOSURE_INIT(&on_resolved_, OnResolved, this, nullptr);
+      if (resolver_->use_dns_cache_) {
+        StartCachedLookup();
+        return;
+      }
       request_.reset(grpc_dns_lookup_ares(
           resolver_->authority().c_str(), resolver_->name_to_resolve().c_str(),
           kDefaultSecurePort, resolver_->interested_parties(), &on_resolved_,
@@ -123,7 +226,13 @@ class AresClientChannelDNSResolver : public PollingResolver {
     }
 
     void Orphan() override {
-      grpc_cancel_ares_request(request_.get());
+      if (!resolver_->use_dns_cache_) {
+        grpc_cancel_ares_request(request_.get());
+      } else if (SharedDnsCache()->Cancel(cache_key_, cache_waiter_id_)) {
+        grpc_pollset_set_del_pollset_set(resolver_->interested_parties(),
+                                         SharedLookupPollsetSet());
+        Unref(DEBUG_LOCATION, "OnResolved");
+      }
       Unref(DEBUG_LOCATION, "Orphan");
     }
 
@@ -131,6 +240,10 @@ class AresClientChannelDNSResolver : public PollingResolver {
     static void OnResolved(void* arg, grpc_error_handle error);
     void OnResolved(grpc_error_handle error);
 
+    void StartCachedLookup();
+    void OnCachedLookupDone(absl::StatusOr<AresResult> result);
+    void SetOutputs(const AresResult& result);
+
     RefCountedPtr<AresClientChannelDNSResolver> resolver_;
     std::unique_ptr<grpc_ares_request> request_;
     grpc_closure on_resolved_;
@@ -138,6 +251,9 @@ class AresClientChannelDNSResolver : public PollingResolver {
     std::unique_ptr<ServerAddressList> addresses_;
     std::unique_ptr<ServerAddressList> balancer_addresses_;
     char* service_config_json_ = nullptr;
+    // Set when going through the DNS cache.
+    std::string cache_key_;
+    intptr_t cache_waiter_id_ = 0;
   };
 
   ~AresClientChannelDNSResolver() override;
@@ -148,6 +264,8 @@ class AresClientChannelDNSResolver : public PollingResolver {
   const bool enable_srv_queries_;
   // timeout in milliseconds for active DNS queries
   const int query_timeout_ms_;
+  // whether to share lookups and results with the other channels
+  const bool use_dns_cache_;
 };
 
 AresClientChannelDNSResolver::AresClientChannelDNSResolver(
@@ -171,7 +289,8 @@ AresClientChannelDNSResolver::AresClientChannelDNSResolver(
           channel_args, GRPC_ARG_DNS_ENABLE_SRV_QUERIES, false)),
       query_timeout_ms_(grpc_channel_args_find_integer(
           channel_args, GRPC_ARG_DNS_ARES_QUERY_TIMEOUT_MS,
-          {GRPC_DNS_ARES_DEFAULT_QUERY_TIMEOUT_MS, 0, INT_MAX})) {}
+          {GRPC_DNS_ARES_DEFAULT_QUERY_TIMEOUT_MS, 0, INT_MAX})),
+      use_dns_cache_(GPR_GLOBAL_CONFIG_GET(grpc_dns_cache)) {}
 
 AresClientChannelDNSResolver::~AresClientChannelDNSResolver() {
   GRPC_CARES_TRACE_LOG("resolver:%p destroying AresClientChannelDNSResolver",
@@ -271,6 +390,69 @@ std::string ChooseServiceConfig(char* service_config_choice_json,
   return service_config->Dump();
 }
 
+void AresClientChannelDNSResolver::AresRequestWrapper::StartCachedLookup() {
+  const bool enable_srv_queries = resolver_->enable_srv_queries_;
+  const bool request_service_config = resolver_->request_service_config_;
+  cache_key_ = absl::StrCat(resolver_->authority(), "|",
+                            resolver_->name_to_resolve(), "|A,AAAA",
+                            enable_srv_queries ? ",SRV" : "",
+                            request_service_config ? ",TXT" : "");
+  grpc_pollset_set_add_pollset_set(resolver_->interested_parties(),
+                                   SharedLookupPollsetSet());
+  auto start_lookup = [dns_server = resolver_->authority(),
+                       name = resolver_->name_to_resolve(), enable_srv_queries,
+                       request_service_config,
+                       query_timeout_ms = resolver_->query_timeout_ms_](
+                          DnsCache<AresResult>::OnLookupDone on_done) {
+    return OrphanablePtr<Orphanable>(MakeOrphanable<SharedAresRequest>(
+        dns_server, name, enable_srv_queries, request_service_config,
+        query_timeout_ms, std::move(on_done)));
+  };
+  absl::optional<AresResult> cached = SharedDnsCache()->Lookup(
+      cache_key_, start_lookup,
+      [this](absl::StatusOr<AresResult> result) {
+        OnCachedLookupDone(std::move(result));
+      },
+      &cache_waiter_id_);
+  GRPC_CARES_TRACE_LOG("resolver:%p Started resolving %s. cached:%d",
+                       resolver_.get(), cache_key_.c_str(), cached.has_value());
+  if (cached.has_value()) {
+    grpc_pollset_set_del_pollset_set(resolver_->interested_parties(),
+                                     SharedLookupPollsetSet());
+    SetOutputs(*cached);
+    ExecCtx::Run(DEBUG_LOCATION, &on_resolved_, GRPC_ERROR_NONE);
+  }
+}
+
+void AresClientChannelDNSResolver::AresRequestWrapper::OnCachedLookupDone(
+    absl::StatusOr<AresResult> result) {
+  grpc_pollset_set_del_pollset_set(resolver_->interested_parties(),
+                                   SharedLookupPollsetSet());
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  if (result.ok()) {
+    SetOutputs(*result);
+  } else {
+    error = GRPC_ERROR_CREATE_FROM_CPP_STRING(
+        std::string(result.status().message()));
+  }
+  OnResolved(error);
+  GRPC_ERROR_UNREF(error);
+}
+
+void AresClientChannelDNSResolver::AresRequestWrapper::SetOutputs(
+    const AresResult& result) {
+  if (result.addresses.has_value()) {
+    addresses_ = absl::make_unique<ServerAddressList>(*result.addresses);
+  }
+  if (result.balancer_addresses.has_value()) {
+    balancer_addresses_ =
+        absl::make_unique<ServerAddressList>(*result.balancer_addresses);
+  }
+  if (result.service_config_json.has_value()) {
+    service_config_json_ = gpr_strdup(result.service_config_json->c_str());
+  }
+}
+
 void AresClientChannelDNSResolver::AresRequestWrapper::OnResolved(
     void* arg, grpc_error_handle error) {
   auto* self = static_cast<AresRequestWrapper*>(arg);
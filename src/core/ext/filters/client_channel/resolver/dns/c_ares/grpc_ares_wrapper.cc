@@ -27,9 +27,11 @@
 
 #if GRPC_ARES == 1
 
+#include <limits.h>
 #include <string.h>
 #include <sys/types.h>  // IWYU pragma: keep
 
+#include <algorithm>
 #include <string>
 #include <utility>
 
@@ -715,6 +717,115 @@ static void on_hostbyname_done_locked(void* arg, int status, int /*timeouts*/,
   destroy_hostbyname_request_locked(hr);
 }
 
+static void update_min_ttl_locked(grpc_ares_request* r, int ttl_seconds)
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(r->mu) {
+  r->min_ttl = std::min(
+      r->min_ttl, grpc_core::Duration::Seconds(std::max(ttl_seconds, 0)));
+}
+
+/* Skips the name at \a p in the DNS message \a abuf. Returns nullptr if it
+ * is malformed. */
+static const unsigned char* skip_dns_name(const unsigned char* p,
+                                          const unsigned char* abuf,
+                                          int alen) {
+  char* name = nullptr;
+  long len = 0;
+  if (ares_expand_name(p, abuf, alen, &name, &len) != ARES_SUCCESS) {
+    return nullptr;
+  }
+  ares_free_string(name);
+  return p + len;
+}
+
+/* Lowers the request's min_ttl to the smallest TTL of the answers in the DNS
+ * message \a abuf. c-ares does not report the TTLs of SRV and TXT records, so
+ * the message is walked here: a 12 bytes header, the questions (a name, a type
+ * and a class) and then the answers (a name, a type, a class, the TTL and the
+ * length-prefixed data). */
+static void update_min_ttl_from_answers_locked(grpc_ares_request* r,
+                                               const unsigned char* abuf,
+                                               int alen)
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(r->mu) {
+  if (alen < 12) return;
+  const unsigned char* end = abuf + alen;
+  const int qdcount = (abuf[4] << 8) | abuf[5];
+  const int ancount = (abuf[6] << 8) | abuf[7];
+  const unsigned char* p = abuf + 12;
+  for (int i = 0; i < qdcount; ++i) {
+    p = skip_dns_name(p, abuf, alen);
+    if (p == nullptr || end - p < 4) return;
+    p += 4;
+  }
+  for (int i = 0; i < ancount; ++i) {
+    p = skip_dns_name(p, abuf, alen);
+    if (p == nullptr || end - p < 10) return;
+    const uint32_t ttl = (static_cast<uint32_t>(p[4]) << 24) |
+                         (static_cast<uint32_t>(p[5]) << 16) |
+                         (static_cast<uint32_t>(p[6]) << 8) | p[7];
+    const int rdlength = (p[8] << 8) | p[9];
+    p += 10;
+    if (end - p < rdlength) return;
+    p += rdlength;
+    update_min_ttl_locked(
+        r, static_cast<int>(std::min<uint32_t>(ttl, INT_MAX)));
+  }
+}
+
+static void on_address_search_done_locked(void* arg, int status, int timeouts,
+                                          unsigned char* abuf, int alen)
+    ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  // This callback is invoked from the c-ares library, so disable thread safety
+  // analysis. Note that we are guaranteed to be holding r->mu, though.
+  grpc_ares_hostbyname_request* hr =
+      static_cast<grpc_ares_hostbyname_request*>(arg);
+  grpc_ares_request* r = hr->parent_request;
+  struct hostent* hostent = nullptr;
+  if (status == ARES_SUCCESS) {
+    constexpr int kMaxAddrTtls = 64;
+    int naddrttls = kMaxAddrTtls;
+    if (strcmp(hr->qtype, "AAAA") == 0) {
+      struct ares_addr6ttl addrttls[kMaxAddrTtls];
+      status =
+          ares_parse_aaaa_reply(abuf, alen, &hostent, addrttls, &naddrttls);
+      for (int i = 0; status == ARES_SUCCESS && i < naddrttls; ++i) {
+        update_min_ttl_locked(r, addrttls[i].ttl);
+      }
+    } else {
+      struct ares_addrttl addrttls[kMaxAddrTtls];
+      status = ares_parse_a_reply(abuf, alen, &hostent, addrttls, &naddrttls);
+      for (int i = 0; status == ARES_SUCCESS && i < naddrttls; ++i) {
+        update_min_ttl_locked(r, addrttls[i].ttl);
+      }
+    }
+  }
+  on_hostbyname_done_locked(hr, status, timeouts, hostent);
+  if (hostent != nullptr) ares_free_hostent(hostent);
+}
+
+/* Looks up the addresses of \a hr. Unlike ares_gethostbyname(), which it
+ * otherwise mirrors, this keeps track of the TTLs of the records. */
+static void start_hostbyname_request_locked(grpc_ares_hostbyname_request* hr,
+                                            int family)
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(hr->parent_request->mu) {
+  ares_channel channel = hr->parent_request->ev_driver->channel;
+  unsigned char literal[16];  // large enough for an in6_addr
+  if (ares_inet_pton(family, hr->host, literal) == 1) {
+    ares_gethostbyname(channel, hr->host, family, on_hostbyname_done_locked,
+                       hr);
+    return;
+  }
+  struct hostent* hostent = nullptr;
+  if (ares_gethostbyname_file(channel, hr->host, family, &hostent) ==
+      ARES_SUCCESS) {
+    on_hostbyname_done_locked(hr, ARES_SUCCESS, 0, hostent);
+    ares_free_hostent(hostent);
+    return;
+  }
+  ares_search(channel, hr->host, ns_c_in,
+              family == AF_INET6 ? ns_t_aaaa : ns_t_a,
+              on_address_search_done_locked, hr);
+}
+
 static void on_srv_query_done_locked(void* arg, int status, int /*timeouts*/,
                                      unsigned char* abuf,
                                      int alen) ABSL_NO_THREAD_SAFETY_ANALYSIS {
@@ -731,19 +842,18 @@ static void on_srv_query_done_locked(void* arg, int status, int /*timeouts*/,
     GRPC_CARES_TRACE_LOG("request:%p ares_parse_srv_reply: %d", r,
                          parse_status);
     if (parse_status == ARES_SUCCESS) {
+      update_min_ttl_from_answers_locked(r, abuf, alen);
       for (struct ares_srv_reply* srv_it = reply; srv_it != nullptr;
            srv_it = srv_it->next) {
         if (grpc_ares_query_ipv6()) {
           grpc_ares_hostbyname_request* hr = create_hostbyname_request_locked(
               r, srv_it->host, htons(srv_it->port), true /* is_balancer */,
               "AAAA");
-          ares_gethostbyname(r->ev_driver->channel, hr->host, AF_INET6,
-                             on_hostbyname_done_locked, hr);
+          start_hostbyname_request_locked(hr, AF_INET6);
         }
         grpc_ares_hostbyname_request* hr = create_hostbyname_request_locked(
             r, srv_it->host, htons(srv_it->port), true /* is_balancer */, "A");
-        ares_gethostbyname(r->ev_driver->channel, hr->host, AF_INET,
-                           on_hostbyname_done_locked, hr);
+        start_hostbyname_request_locked(hr, AF_INET);
         grpc_ares_notify_on_event_locked(r->ev_driver);
       }
     }
@@ -781,6 +891,7 @@ static void on_txt_done_locked(void* arg, int status, int /*timeouts*/,
                        q->name().c_str());
   status = ares_parse_txt_reply_ext(buf, len, &reply);
   if (status != ARES_SUCCESS) goto fail;
+  update_min_ttl_from_answers_locked(r, buf, len);
   // Find service config in TXT record.
   for (result = reply; result != nullptr; result = result->next) {
     if (result->record_start &&
@@ -888,14 +999,12 @@ void grpc_dns_lookup_ares_continue_after_check_localhost_and_ip_literals_locked(
     hr = create_hostbyname_request_locked(r, host.c_str(),
                                           grpc_strhtons(port.c_str()),
                                           /*is_balancer=*/false, "AAAA");
-    ares_gethostbyname(r->ev_driver->channel, hr->host, AF_INET6,
-                       on_hostbyname_done_locked, hr);
+    start_hostbyname_request_locked(hr, AF_INET6);
   }
   hr = create_hostbyname_request_locked(r, host.c_str(),
                                         grpc_strhtons(port.c_str()),
                                         /*is_balancer=*/false, "A");
-  ares_gethostbyname(r->ev_driver->channel, hr->host, AF_INET,
-                     on_hostbyname_done_locked, hr);
+  start_hostbyname_request_locked(hr, AF_INET);
   if (r->balancer_addresses_out != nullptr) {
     /* Query the SRV record */
     std::string service_name = absl::StrCat("_grpclb._tcp.", host);
@@ -33,6 +33,7 @@
 
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/iomgr_fwd.h"
@@ -76,6 +77,10 @@ struct grpc_ares_request {
   size_t pending_queries ABSL_GUARDED_BY(mu) = 0;
   /** the errors explaining query failures, appended to in query callbacks */
   grpc_error_handle error ABSL_GUARDED_BY(mu) = GRPC_ERROR_NONE;
+  /** the smallest TTL of the records received, or infinity if there were
+   * none (e.g. the name was found in the hosts file) */
+  grpc_core::Duration min_ttl ABSL_GUARDED_BY(mu) =
+      grpc_core::Duration::Infinity();
 };
 
 /* Asynchronously resolve \a name. It will try to resolve grpclb SRV records in
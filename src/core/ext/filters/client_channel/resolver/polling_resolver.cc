@@ -19,6 +19,7 @@
 #include "src/core/ext/filters/client_channel/resolver/polling_resolver.h"
 
 #include <inttypes.h>
+#include <limits.h>
 
 #include <utility>
 
@@ -53,7 +54,11 @@ PollingResolver::PollingResolver(ResolverArgs args,
       tracer_(tracer),
       interested_parties_(args.pollset_set),
       min_time_between_resolutions_(min_time_between_resolutions),
-      backoff_(backoff_options) {
+      backoff_(backoff_options),
+      max_stale_result_age_(Duration::Milliseconds(
+          grpc_channel_args_find_integer(
+              channel_args, GRPC_ARG_RESOLVER_MAX_STALE_RESULT_MS,
+              {5 * 60 * 1000, 0, INT_MAX}))) {
   if (GPR_UNLIKELY(tracer_ != nullptr && tracer_->enabled())) {
     gpr_log(GPR_INFO, "[polling resolver %p] created", this);
   }
@@ -69,6 +74,8 @@ PollingResolver::~PollingResolver() {
 void PollingResolver::StartLocked() { MaybeStartResolvingLocked(); }
 
 void PollingResolver::RequestReresolutionLocked() {
+  // Requests made while a resolution is pending or scheduled are served by
+  // that resolution, so a burst of requests costs a single lookup.
   if (request_ == nullptr) {
     MaybeStartResolvingLocked();
   }
@@ -127,10 +134,13 @@ void PollingResolver::OnRequestCompleteLocked(Result result) {
   }
   request_.reset();
   if (!shutdown_) {
+    bool report_result = true;
     if (result.service_config.ok() && result.addresses.ok()) {
       // Reset backoff state so that we start from the beginning when the
       // next request gets triggered.
       backoff_.Reset();
+      have_good_result_ = true;
+      failing_since_.reset();
     } else {
       if (GPR_UNLIKELY(tracer_ != nullptr && tracer_->enabled())) {
         gpr_log(GPR_INFO,
@@ -159,8 +169,24 @@ void PollingResolver::OnRequestCompleteLocked(Result result) {
       Ref(DEBUG_LOCATION, "next_resolution_timer").release();
       GRPC_CLOSURE_INIT(&on_next_resolution_, OnNextResolution, this, nullptr);
       grpc_timer_init(&next_resolution_timer_, next_try, &on_next_resolution_);
+      // The channel keeps using the last good result until we report
+      // something else, so hold the failure back while that result is not
+      // too stale and let the retry revalidate it.
+      if (have_good_result_) {
+        const Timestamp now = ExecCtx::Get()->Now();
+        if (!failing_since_.has_value()) failing_since_ = now;
+        if (now - *failing_since_ < max_stale_result_age_) {
+          if (GPR_UNLIKELY(tracer_ != nullptr && tracer_->enabled())) {
+            gpr_log(GPR_INFO,
+                    "[polling resolver %p] serving last good result, "
+                    "failing for %" PRId64 " ms",
+                    this, (now - *failing_since_).millis());
+          }
+          report_result = false;
+        }
+      }
     }
-    result_handler_->ReportResult(std::move(result));
+    if (report_result) result_handler_->ReportResult(std::move(result));
   }
   Unref(DEBUG_LOCATION, "OnRequestComplete");
 }
@@ -38,6 +38,13 @@
 #include "src/core/lib/resolver/resolver.h"
 #include "src/core/lib/resolver/resolver_factory.h"
 
+// How long, in milliseconds, a polling resolver keeps serving its last good
+// result after re-resolution starts failing, while it retries in the
+// background. Failures are reported to the channel once this has passed.
+// Defaults to 5 minutes; 0 reports every failure.
+#define GRPC_ARG_RESOLVER_MAX_STALE_RESULT_MS \
+  "grpc.resolver_max_stale_result_ms"
+
 namespace grpc_core {
 
 // A base class for polling-based resolvers.
@@ -106,6 +113,12 @@ class PollingResolver : public Resolver {
   absl::optional<Timestamp> last_resolution_timestamp_;
   /// retry backoff state
   BackOff backoff_;
+  /// how long to keep serving the last good result while resolution fails
+  Duration max_stale_result_age_;
+  /// whether a good result was reported since the resolver started
+  bool have_good_result_ = false;
+  /// when resolution started failing after the last good result
+  absl::optional<Timestamp> failing_since_;
 };
 
 }  // namespace grpc_core
@@ -67,8 +67,10 @@
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/alias_table.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/dual_ref_counted.h"
+#include "src/core/lib/gprpp/fast_random.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/time.h"
@@ -317,7 +319,7 @@ class XdsResolver : public Resolver {
    private:
     struct Route {
       struct ClusterWeightState {
-        uint32_t range_end;
+        uint32_t weight;
         absl::string_view cluster;
         RefCountedPtr<ServiceConfig> method_config;
 
@@ -327,6 +329,8 @@ class XdsResolver : public Resolver {
       XdsRouteConfigResource::Route route;
       RefCountedPtr<ServiceConfig> method_config;
       absl::InlinedVector<ClusterWeightState, 2> weighted_cluster_state;
+      // Picks an index into weighted_cluster_state by weight.
+      AliasTable weighted_cluster_picker;
 
       bool operator==(const Route& other) const;
     };
@@ -343,6 +347,8 @@ class XdsResolver : public Resolver {
 
     RefCountedPtr<XdsResolver> resolver_;
     RouteTable route_table_;
+    // Compiled from route_table_ once it is complete.
+    absl::optional<XdsRouting::RouteIndex> route_index_;
     std::map<absl::string_view, RefCountedPtr<ClusterState>> clusters_;
     std::vector<const grpc_channel_filter*> filters_;
   };
@@ -395,7 +401,7 @@ bool MethodConfigsEqual(const ServiceConfig* sc1, const ServiceConfig* sc2) {
 
 bool XdsResolver::XdsConfigSelector::Route::ClusterWeightState::operator==(
     const ClusterWeightState& other) const {
-  return range_end == other.range_end && cluster == other.cluster &&
+  return weight == other.weight && cluster == other.cluster &&
          MethodConfigsEqual(method_config.get(), other.method_config.get());
 }
 
@@ -480,19 +486,20 @@ XdsResolver::XdsConfigSelector::XdsConfigSelector(
         auto& action_weighted_clusters = absl::get<
             XdsRouteConfigResource::Route::RouteAction::kWeightedClustersIndex>(
             route_action->action);
-        uint32_t end = 0;
+        std::vector<uint32_t> weights;
         for (const auto& weighted_cluster : action_weighted_clusters) {
           Route::ClusterWeightState cluster_weight_state;
           *error = CreateMethodConfig(route_entry.route, &weighted_cluster,
                                       &cluster_weight_state.method_config);
           if (*error != GRPC_ERROR_NONE) return;
-          end += weighted_cluster.weight;
-          cluster_weight_state.range_end = end;
+          cluster_weight_state.weight = weighted_cluster.weight;
           cluster_weight_state.cluster = weighted_cluster.name;
           route_entry.weighted_cluster_state.push_back(
               std::move(cluster_weight_state));
+          weights.push_back(weighted_cluster.weight);
           MaybeAddCluster(absl::StrCat("cluster:", weighted_cluster.name));
         }
+        route_entry.weighted_cluster_picker = AliasTable(weights);
       } else if (route_action->action.index() ==
                  XdsRouteConfigResource::Route::RouteAction::
                      kClusterSpecifierPluginIndex) {
@@ -506,6 +513,7 @@ XdsResolver::XdsConfigSelector::XdsConfigSelector(
       }
     }
   }
+  route_index_.emplace(RouteListIterator(&route_table_));
   // Populate filter list.
   for (const auto& http_filter :
        resolver_->current_listener_.http_connection_manager.http_filters) {
@@ -659,7 +667,7 @@ absl::optional<uint64_t> HeaderHashHelper(
 
 ConfigSelector::CallConfig XdsResolver::XdsConfigSelector::GetCallConfig(
     GetCallConfigArgs args) {
-  auto route_index = XdsRouting::GetRouteForRequest(
+  auto route_index = route_index_->GetRouteForRequest(
       RouteListIterator(&route_table_), StringViewFromSlice(*args.path),
       args.initial_metadata);
   if (!route_index.has_value()) {
@@ -690,28 +698,7 @@ ConfigSelector::CallConfig XdsResolver::XdsConfigSelector::GetCallConfig(
   } else if (route_action->action.index() ==
              XdsRouteConfigResource::Route::RouteAction::
                  kWeightedClustersIndex) {
-    const uint32_t key =
-        rand() %
-        entry.weighted_cluster_state[entry.weighted_cluster_state.size() - 1]
-            .range_end;
-    // Find the index in weighted clusters corresponding to key.
-    size_t mid = 0;
-    size_t start_index = 0;
-    size_t end_index = entry.weighted_cluster_state.size() - 1;
-    size_t index = 0;
-    while (end_index > start_index) {
-      mid = (start_index + end_index) / 2;
-      if (entry.weighted_cluster_state[mid].range_end > key) {
-        end_index = mid;
-      } else if (entry.weighted_cluster_state[mid].range_end < key) {
-        start_index = mid + 1;
-      } else {
-        index = mid + 1;
-        break;
-      }
-    }
-    if (index == 0) index = start_index;
-    GPR_ASSERT(entry.weighted_cluster_state[index].range_end > key);
+    const size_t index = entry.weighted_cluster_picker.Sample(FastRandom64());
     cluster_name =
         absl::StrCat("cluster:", entry.weighted_cluster_state[index].cluster);
     method_config = entry.weighted_cluster_state[index].method_config;
@@ -754,7 +741,7 @@ ConfigSelector::CallConfig XdsResolver::XdsConfigSelector::GetCallConfig(
     }
   }
   if (!hash.has_value()) {
-    hash = absl::Uniform<uint64_t>(absl::BitGen());
+    hash = FastRandom64();
   }
   CallConfig call_config;
   if (method_config != nullptr) {
@@ -0,0 +1,987 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/response_cache_filter.h"
+
+#include <limits.h>
+#include <string.h>
+
+#include <algorithm>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+
+#include <grpc/slice_buffer.h>
+#include <grpc/status.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/context.h"
+#include "src/core/lib/iomgr/call_combiner.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/json/json_util.h"
+#include "src/core/lib/resource_quota/api.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/service_config/service_config_call_data.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/transport/byte_stream.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "src/core/lib/transport/transport.h"
+
+namespace grpc_core {
+
+//
+// ResponseCacheServiceConfigParser
+//
+
+namespace {
+
+constexpr uint32_t kDefaultMaxFanOut = 1000;
+
+}  // namespace
+
+std::unique_ptr<ServiceConfigParser::ParsedConfig>
+ResponseCacheServiceConfigParser::ParseGlobalParams(
+    const grpc_channel_args* /*args*/, const Json& json,
+    grpc_error_handle* error) {
+  GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+  // The method configs themselves are validated by ParsePerMethodParams();
+  // here we only need to know whether any of them enables the cache.
+  auto it = json.object_value().find("methodConfig");
+  if (it == json.object_value().end() ||
+      it->second.type() != Json::Type::ARRAY) {
+    return nullptr;
+  }
+  for (const Json& method_config : it->second.array_value()) {
+    if (method_config.type() == Json::Type::OBJECT &&
+        (method_config.object_value().count("responseCache") > 0 ||
+         method_config.object_value().count("requestCoalescing") > 0)) {
+      return absl::make_unique<ResponseCacheGlobalConfig>();
+    }
+  }
+  return nullptr;
+}
+
+std::unique_ptr<ServiceConfigParser::ParsedConfig>
+ResponseCacheServiceConfigParser::ParsePerMethodParams(
+    const grpc_channel_args* /*args*/, const Json& json,
+    grpc_error_handle* error) {
+  GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+  std::vector<grpc_error_handle> error_list;
+  // responseCache
+  Duration ttl;
+  const Json::Object* cache_json = nullptr;
+  if (ParseJsonObjectField(json.object_value(), "responseCache", &cache_json,
+                           &error_list, false)) {
+    std::vector<grpc_error_handle> cache_errors;
+    if (ParseJsonObjectFieldAsDuration(*cache_json, "ttl", &ttl,
+                                       &cache_errors) &&
+        ttl <= Duration::Zero()) {
+      cache_errors.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:ttl error:must be greater than 0"));
+    }
+    if (!cache_errors.empty()) {
+      error_list.push_back(
+          GRPC_ERROR_CREATE_FROM_VECTOR("responseCache", &cache_errors));
+    }
+  }
+  // requestCoalescing
+  uint32_t max_fan_out = 0;
+  const Json::Object* coalescing_json = nullptr;
+  if (ParseJsonObjectField(json.object_value(), "requestCoalescing",
+                           &coalescing_json, &error_list, false)) {
+    std::vector<grpc_error_handle> coalescing_errors;
+    max_fan_out = kDefaultMaxFanOut;
+    if (ParseJsonObjectField(*coalescing_json, "maxFanOut", &max_fan_out,
+                             &coalescing_errors, false) &&
+        max_fan_out == 0) {
+      coalescing_errors.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:maxFanOut error:must be greater than 0"));
+    }
+    if (!coalescing_errors.empty()) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_VECTOR("requestCoalescing",
+                                                         &coalescing_errors));
+    }
+  }
+  if (cache_json == nullptr && coalescing_json == nullptr) {
+    *error = GRPC_ERROR_CREATE_FROM_VECTOR("response cache", &error_list);
+    return nullptr;
+  }
+  // keyMetadata
+  std::vector<std::string> key_metadata;
+  const Json::Array* key_metadata_json = nullptr;
+  if (ParseJsonObjectField(json.object_value(), "keyMetadata",
+                           &key_metadata_json, &error_list, false)) {
+    for (const Json& key : *key_metadata_json) {
+      if (key.type() != Json::Type::STRING || key.string_value().empty()) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:keyMetadata error:must be non-empty strings"));
+        break;
+      }
+      key_metadata.push_back(absl::AsciiStrToLower(key.string_value()));
+    }
+  }
+  *error = GRPC_ERROR_CREATE_FROM_VECTOR("response cache", &error_list);
+  if (*error != GRPC_ERROR_NONE) return nullptr;
+  return absl::make_unique<ResponseCacheMethodConfig>(ttl, max_fan_out,
+                                                      std::move(key_metadata));
+}
+
+void ResponseCacheServiceConfigParser::Register(
+    CoreConfiguration::Builder* builder) {
+  builder->service_config_parser()->RegisterParser(
+      absl::make_unique<ResponseCacheServiceConfigParser>());
+}
+
+size_t ResponseCacheServiceConfigParser::ParserIndex() {
+  return CoreConfiguration::Get().service_config_parser().GetParserIndex(
+      parser_name());
+}
+
+namespace internal {
+
+//
+// ParseCacheControl
+//
+
+CacheControl ParseCacheControl(absl::string_view value) {
+  CacheControl result;
+  for (absl::string_view directive : absl::StrSplit(value, ',')) {
+    directive = absl::StripAsciiWhitespace(directive);
+    if (absl::EqualsIgnoreCase(directive, "no-store") ||
+        absl::EqualsIgnoreCase(directive, "no-cache")) {
+      result.no_store = true;
+    } else if (absl::StartsWithIgnoreCase(directive, "max-age=")) {
+      int64_t seconds;
+      if (absl::SimpleAtoi(directive.substr(strlen("max-age=")), &seconds) &&
+          seconds >= 0) {
+        result.max_age = Duration::Seconds(seconds);
+      }
+    }
+  }
+  return result;
+}
+
+//
+// ResponseCache
+//
+
+namespace {
+
+// Charged for each entry on top of its key and response, for the list and
+// index nodes.
+constexpr size_t kEntryOverhead = 128;
+
+}  // namespace
+
+ResponseCache::ResponseCache(size_t max_bytes, MemoryOwner memory_owner)
+    : max_bytes_(max_bytes), memory_owner_(std::move(memory_owner)) {}
+
+ResponseCache::~ResponseCache() { Clear(); }
+
+absl::optional<Slice> ResponseCache::Lookup(absl::string_view key,
+                                            Timestamp now) {
+  MutexLock lock(&mu_);
+  auto it = index_.find(key);
+  if (it == index_.end()) return absl::nullopt;
+  if (it->second->expiry <= now) {
+    RemoveLocked(it->second);
+    return absl::nullopt;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->response.Ref();
+}
+
+void ResponseCache::Insert(std::string key, Slice response,
+                           Timestamp expiry) {
+  const size_t size = key.size() + response.size() + kEntryOverhead;
+  if (size > max_bytes_) return;
+  // Reserved before taking the lock, since reserving may start a reclamation
+  // sweep, which would come back to Clear().
+  const size_t reserved = memory_owner_.Reserve(size);
+  MutexLock lock(&mu_);
+  auto it = index_.find(key);
+  if (it != index_.end()) RemoveLocked(it->second);
+  while (!entries_.empty() && size_bytes_ + reserved > max_bytes_) {
+    RemoveLocked(std::prev(entries_.end()));
+  }
+  entries_.push_front(
+      Entry{std::move(key), std::move(response), expiry, reserved});
+  index_.emplace(entries_.front().key, entries_.begin());
+  size_bytes_ += reserved;
+  MaybePostReclaimerLocked();
+}
+
+void ResponseCache::Clear() {
+  MutexLock lock(&mu_);
+  while (!entries_.empty()) RemoveLocked(entries_.begin());
+}
+
+size_t ResponseCache::size_bytes() const {
+  MutexLock lock(&mu_);
+  return size_bytes_;
+}
+
+void ResponseCache::RemoveLocked(EntryList::iterator it) {
+  index_.erase(it->key);
+  size_bytes_ -= it->reserved;
+  memory_owner_.Release(it->reserved);
+  entries_.erase(it);
+}
+
+void ResponseCache::MaybePostReclaimerLocked() {
+  if (reclaimer_posted_) return;
+  reclaimer_posted_ = true;
+  // Cached responses can always be fetched again, so give them up as soon
+  // as the quota runs short.
+  memory_owner_.PostReclaimer(
+      ReclamationPass::kBenign,
+      [this](absl::optional<ReclamationSweep> sweep) {
+        if (!sweep.has_value()) return;
+        MutexLock lock(&mu_);
+        reclaimer_posted_ = false;
+        while (!entries_.empty()) RemoveLocked(entries_.begin());
+      });
+}
+
+//
+// CallCoalescer
+//
+
+CallCoalescer::JoinResult CallCoalescer::Join(const std::string& key,
+                                              uint32_t max_fan_out,
+                                              Follower* follower) {
+  MutexLock lock(&mu_);
+  auto it = in_flight_.find(key);
+  if (it == in_flight_.end()) {
+    in_flight_.emplace(key, std::vector<Follower*>());
+    return JoinResult::kLeader;
+  }
+  if (it->second.size() >= max_fan_out) return JoinResult::kFull;
+  it->second.push_back(follower);
+  return JoinResult::kFollower;
+}
+
+bool CallCoalescer::Leave(const std::string& key, Follower* follower) {
+  MutexLock lock(&mu_);
+  auto it = in_flight_.find(key);
+  if (it == in_flight_.end()) return false;
+  std::vector<Follower*>& followers = it->second;
+  auto follower_it = std::find(followers.begin(), followers.end(), follower);
+  if (follower_it == followers.end()) return false;
+  followers.erase(follower_it);
+  return true;
+}
+
+void CallCoalescer::Finish(const std::string& key,
+                           const absl::optional<Slice>& response) {
+  std::vector<Follower*> followers;
+  {
+    MutexLock lock(&mu_);
+    auto it = in_flight_.find(key);
+    GPR_ASSERT(it != in_flight_.end());
+    followers = std::move(it->second);
+    in_flight_.erase(it);
+  }
+  for (Follower* follower : followers) {
+    follower->OnLeaderFinished(
+        response.has_value() ? absl::make_optional(response->Ref())
+                             : absl::nullopt);
+  }
+}
+
+}  // namespace internal
+
+//
+// ResponseCacheFilter
+//
+
+namespace {
+
+constexpr int kDefaultMaxBytes = 4 * 1024 * 1024;
+
+class ChannelData {
+ public:
+  explicit ChannelData(const grpc_channel_element_args* args)
+      : parser_index_(ResponseCacheServiceConfigParser::ParserIndex()),
+        cache_(MakeRefCounted<internal::ResponseCache>(
+            grpc_channel_args_find_integer(args->channel_args,
+                                           GRPC_ARG_RESPONSE_CACHE_MAX_BYTES,
+                                           {kDefaultMaxBytes, 0, INT_MAX}),
+            ResourceQuotaFromChannelArgs(args->channel_args)
+                ->memory_quota()
+                ->CreateMemoryOwner("response_cache",
+                                    MemoryCategory::kResponseCache))) {}
+
+  size_t parser_index() const { return parser_index_; }
+  internal::ResponseCache* cache() const { return cache_.get(); }
+  internal::CallCoalescer* coalescer() { return &coalescer_; }
+
+ private:
+  const size_t parser_index_;
+  const RefCountedPtr<internal::ResponseCache> cache_;
+  internal::CallCoalescer coalescer_;
+};
+
+class CallData : public internal::CallCoalescer::Follower {
+ public:
+  CallData(grpc_call_element* elem, const grpc_call_element_args& args);
+  ~CallData() override;
+
+  void StartTransportStreamOpBatch(grpc_transport_stream_op_batch* batch);
+
+  void OnLeaderFinished(absl::optional<Slice> response) override;
+
+ private:
+  enum class State {
+    // Waiting for the first batch, which must carry the request.
+    kStart,
+    // Reading the request message of the first batch, to look it up.
+    kReadingRequest,
+    // Not cacheable: batches go straight down.
+    kPassThrough,
+    // Waiting for an identical call in flight to finish: batches are queued.
+    kWaiting,
+    // Not cached: batches go down, and the response is recorded.
+    kMiss,
+    // Served from the cache: batches complete right here.
+    kHit,
+  };
+
+  // Methods for looking up the request of the first batch
+  void StartReadingRequest(grpc_transport_stream_op_batch* batch);
+  bool ContinueReadingRequest();
+  bool PullSliceFromRequest();
+  static void OnRequestNextDone(void* arg, grpc_error_handle error);
+  static void OnRequestRead(void* arg, grpc_error_handle error);
+  void FinishReadingRequest();
+  void ResumeQueuedBatches();
+  static void ResumeQueuedBatch(void* arg, grpc_error_handle error);
+
+  // Methods for following an identical call in flight
+  static void OnLeaderFinishedInCallCombiner(void* arg,
+                                             grpc_error_handle error);
+  void StopFollowing(grpc_transport_stream_op_batch* cancel_batch);
+
+  // Completes the ops of batch from the cached response.
+  void ServeFromCache(grpc_transport_stream_op_batch* batch);
+
+  // Methods for recording the response of a miss
+  void InterceptRecvOps(grpc_transport_stream_op_batch* batch);
+  static void OnRecvInitialMetadataReady(void* arg, grpc_error_handle error);
+  static void OnRecvMessageReady(void* arg, grpc_error_handle error);
+  static void OnRecvMessageNextDone(void* arg, grpc_error_handle error);
+  void ContinueReadingRecvMessage();
+  bool PullSliceFromRecvMessage();
+  void FinishRecvMessage();
+  void ContinueRecvMessageReadyCallback(grpc_error_handle error);
+  static void OnRecvTrailingMetadataReady(void* arg, grpc_error_handle error);
+  void FinishResponse(grpc_error_handle error);
+
+  grpc_call_element* const elem_;
+  grpc_call_stack* const owning_call_;
+  CallCombiner* const call_combiner_;
+  const ResponseCacheMethodConfig* method_config_ = nullptr;
+  State state_;
+  std::string key_;
+  // The response to serve on a hit, or the one recorded on a miss.
+  absl::optional<Slice> response_;
+  std::aligned_storage<sizeof(SliceBufferByteStream),
+                       alignof(SliceBufferByteStream)>::type
+      send_replacement_stream_;
+  std::aligned_storage<sizeof(SliceBufferByteStream),
+                       alignof(SliceBufferByteStream)>::type
+      recv_replacement_stream_;
+  // Fields for reading the request
+  grpc_transport_stream_op_batch* first_batch_ = nullptr;
+  ByteStream* send_message_ = nullptr;
+  grpc_slice_buffer request_slices_;
+  bool request_failed_ = false;
+  grpc_closure on_request_next_done_;
+  grpc_closure on_request_read_;
+  // Batches started while the request was being read asynchronously.
+  absl::InlinedVector<grpc_transport_stream_op_batch*, 2> queued_batches_;
+  // Fields for coalescing
+  // Whether identical calls may be waiting for this one.
+  bool leader_ = false;
+  absl::optional<Slice> leader_response_;
+  grpc_closure on_leader_finished_;
+  // Fields for serving a hit
+  bool served_response_ = false;
+  // Fields for recording a miss
+  bool cacheable_response_ = true;
+  size_t recv_messages_ = 0;
+  internal::CacheControl cache_control_;
+  grpc_closure on_recv_initial_metadata_ready_;
+  grpc_closure* original_recv_initial_metadata_ready_ = nullptr;
+  grpc_metadata_batch* recv_initial_metadata_ = nullptr;
+  grpc_closure on_recv_message_ready_;
+  grpc_closure* original_recv_message_ready_ = nullptr;
+  grpc_closure on_recv_message_next_done_;
+  OrphanablePtr<ByteStream>* recv_message_ = nullptr;
+  grpc_slice_buffer recv_slices_;
+  grpc_closure on_recv_trailing_metadata_ready_;
+  grpc_closure* original_recv_trailing_metadata_ready_ = nullptr;
+  grpc_metadata_batch* recv_trailing_metadata_ = nullptr;
+  bool seen_recv_trailing_metadata_ready_ = false;
+  grpc_error_handle on_recv_trailing_metadata_ready_error_ = GRPC_ERROR_NONE;
+};
+
+CallData::CallData(grpc_call_element* elem, const grpc_call_element_args& args)
+    : elem_(elem),
+      owning_call_(args.call_stack),
+      call_combiner_(args.call_combiner) {
+  auto* chand = static_cast<ChannelData*>(elem->channel_data);
+  auto* svc_cfg_call_data = static_cast<ServiceConfigCallData*>(
+      args.context[GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA].value);
+  if (svc_cfg_call_data != nullptr) {
+    method_config_ = static_cast<const ResponseCacheMethodConfig*>(
+        svc_cfg_call_data->GetMethodParsedConfig(chand->parser_index()));
+  }
+  state_ = method_config_ == nullptr ? State::kPassThrough : State::kStart;
+  grpc_slice_buffer_init(&request_slices_);
+  grpc_slice_buffer_init(&recv_slices_);
+  GRPC_CLOSURE_INIT(&on_request_next_done_, OnRequestNextDone, this,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&on_request_read_, OnRequestRead, this,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&on_leader_finished_, OnLeaderFinishedInCallCombiner,
+                    this, grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&on_recv_initial_metadata_ready_,
+                    OnRecvInitialMetadataReady, this,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&on_recv_message_ready_, OnRecvMessageReady, this,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&on_recv_message_next_done_, OnRecvMessageNextDone, this,
+                    grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&on_recv_trailing_metadata_ready_,
+                    OnRecvTrailingMetadataReady, this,
+                    grpc_schedule_on_exec_ctx);
+}
+
+CallData::~CallData() {
+  // Release the followers of a call that ended without receiving its
+  // trailing metadata.
+  if (leader_) {
+    static_cast<ChannelData*>(elem_->channel_data)
+        ->coalescer()
+        ->Finish(key_, absl::nullopt);
+  }
+  grpc_slice_buffer_destroy_internal(&request_slices_);
+  grpc_slice_buffer_destroy_internal(&recv_slices_);
+  GRPC_ERROR_UNREF(on_recv_trailing_metadata_ready_error_);
+}
+
+void CallData::StartTransportStreamOpBatch(
+    grpc_transport_stream_op_batch* batch) {
+  switch (state_) {
+    case State::kStart:
+      // Only unary calls that send their request with their initial metadata
+      // can be looked up.
+      if (batch->send_initial_metadata && batch->send_message &&
+          batch->payload->send_initial_metadata.send_initial_metadata
+                  ->get_pointer(HttpPathMetadata()) != nullptr) {
+        return StartReadingRequest(batch);
+      }
+      state_ = State::kPassThrough;
+      break;
+    case State::kReadingRequest:
+      queued_batches_.push_back(batch);
+      GRPC_CALL_COMBINER_STOP(call_combiner_,
+                              "response cache: waiting for request message");
+      return;
+    case State::kPassThrough:
+      break;
+    case State::kWaiting:
+      if (batch->cancel_stream) return StopFollowing(batch);
+      queued_batches_.push_back(batch);
+      GRPC_CALL_COMBINER_STOP(call_combiner_,
+                              "response cache: waiting for identical call");
+      return;
+    case State::kMiss:
+      InterceptRecvOps(batch);
+      break;
+    case State::kHit:
+      return ServeFromCache(batch);
+  }
+  grpc_call_next_op(elem_, batch);
+}
+
+void CallData::StartReadingRequest(grpc_transport_stream_op_batch* batch) {
+  state_ = State::kReadingRequest;
+  first_batch_ = batch;
+  send_message_ = batch->payload->send_message.send_message.get();
+  if (ContinueReadingRequest()) {
+    FinishReadingRequest();
+  } else {
+    GRPC_CALL_COMBINER_STOP(call_combiner_,
+                            "response cache: reading request message");
+  }
+}
+
+// Returns false if the request has to be waited for.
+bool CallData::ContinueReadingRequest() {
+  while (!request_failed_ && request_slices_.length < send_message_->length()) {
+    if (!send_message_->Next(send_message_->length() - request_slices_.length,
+                             &on_request_next_done_)) {
+      return false;
+    }
+    PullSliceFromRequest();
+  }
+  return true;
+}
+
+bool CallData::PullSliceFromRequest() {
+  grpc_slice slice;
+  grpc_error_handle error = send_message_->Pull(&slice);
+  if (error != GRPC_ERROR_NONE) {
+    GRPC_ERROR_UNREF(error);
+    request_failed_ = true;
+    return false;
+  }
+  grpc_slice_buffer_add(&request_slices_, slice);
+  return true;
+}
+
+void CallData::OnRequestNextDone(void* arg, grpc_error_handle error) {
+  auto* calld = static_cast<CallData*>(arg);
+  if (error != GRPC_ERROR_NONE) {
+    calld->request_failed_ = true;
+  } else if (calld->PullSliceFromRequest() &&
+             !calld->ContinueReadingRequest()) {
+    return;
+  }
+  GRPC_CALL_COMBINER_START(calld->call_combiner_, &calld->on_request_read_,
+                           GRPC_ERROR_NONE,
+                           "response cache: request message read");
+}
+
+void CallData::OnRequestRead(void* arg, grpc_error_handle /*error*/) {
+  static_cast<CallData*>(arg)->FinishReadingRequest();
+}
+
+void CallData::FinishReadingRequest() {
+  grpc_transport_stream_op_batch* batch = first_batch_;
+  first_batch_ = nullptr;
+  if (request_failed_) {
+    // The stream has been partly consumed, so the batch cannot go down.
+    state_ = State::kPassThrough;
+    grpc_transport_stream_op_batch_finish_with_failure(
+        batch,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "response cache: failed to read request message"),
+        call_combiner_);
+  } else {
+    // The key is the path, the key metadata and the request.  A path cannot
+    // contain NUL, and the metadata values are prefixed with their length.
+    grpc_metadata_batch* send_initial_metadata =
+        batch->payload->send_initial_metadata.send_initial_metadata;
+    const Slice* path = send_initial_metadata->get_pointer(HttpPathMetadata());
+    key_.reserve(path->size() + 1 + request_slices_.length);
+    key_.append(path->as_string_view().data(), path->size());
+    key_.push_back('\0');
+    for (const std::string& key : method_config_->key_metadata()) {
+      std::string buffer;
+      absl::optional<absl::string_view> value =
+          send_initial_metadata->GetStringValue(key, &buffer);
+      if (value.has_value()) {
+        absl::StrAppend(&key_, value->size(), ":", *value);
+      } else {
+        key_.push_back('-');
+      }
+    }
+    for (size_t i = 0; i < request_slices_.count; ++i) {
+      key_.append(reinterpret_cast<const char*>(
+                      GRPC_SLICE_START_PTR(request_slices_.slices[i])),
+                  GRPC_SLICE_LENGTH(request_slices_.slices[i]));
+    }
+    // Hand the request down in a stream of the slices read from the original
+    // one, which has been drained.
+    const uint32_t flags = send_message_->flags();
+    send_message_ = nullptr;
+    new (&send_replacement_stream_)
+        SliceBufferByteStream(&request_slices_, flags);
+    batch->payload->send_message.send_message.reset(
+        reinterpret_cast<SliceBufferByteStream*>(&send_replacement_stream_));
+    auto* chand = static_cast<ChannelData*>(elem_->channel_data);
+    if (method_config_->ttl() > Duration::Zero()) {
+      response_ = chand->cache()->Lookup(key_, ExecCtx::Get()->Now());
+    }
+    state_ = State::kMiss;
+    if (response_.has_value()) {
+      state_ = State::kHit;
+    } else if (method_config_->max_fan_out() > 0) {
+      switch (chand->coalescer()->Join(key_, method_config_->max_fan_out(),
+                                       this)) {
+        case internal::CallCoalescer::JoinResult::kLeader:
+          leader_ = true;
+          break;
+        case internal::CallCoalescer::JoinResult::kFollower:
+          // Held until OnLeaderFinishedInCallCombiner() or StopFollowing().
+          GRPC_CALL_STACK_REF(owning_call_, "response cache: following");
+          state_ = State::kWaiting;
+          break;
+        case internal::CallCoalescer::JoinResult::kFull:
+          break;
+      }
+    }
+  }
+  ResumeQueuedBatches();
+  if (request_failed_) return;
+  StartTransportStreamOpBatch(batch);
+}
+
+void CallData::ResumeQueuedBatches() {
+  for (grpc_transport_stream_op_batch* queued : queued_batches_) {
+    queued->handler_private.extra_arg = this;
+    GRPC_CLOSURE_INIT(&queued->handler_private.closure, ResumeQueuedBatch,
+                      queued, nullptr);
+    GRPC_CALL_COMBINER_START(call_combiner_, &queued->handler_private.closure,
+                             GRPC_ERROR_NONE,
+                             "response cache: resuming queued batch");
+  }
+  queued_batches_.clear();
+}
+
+void CallData::ResumeQueuedBatch(void* arg, grpc_error_handle /*error*/) {
+  auto* batch = static_cast<grpc_transport_stream_op_batch*>(arg);
+  static_cast<CallData*>(batch->handler_private.extra_arg)
+      ->StartTransportStreamOpBatch(batch);
+}
+
+void CallData::OnLeaderFinished(absl::optional<Slice> response) {
+  leader_response_ = std::move(response);
+  GRPC_CALL_COMBINER_START(call_combiner_, &on_leader_finished_,
+                           GRPC_ERROR_NONE,
+                           "response cache: identical call finished");
+}
+
+void CallData::OnLeaderFinishedInCallCombiner(void* arg,
+                                              grpc_error_handle /*error*/) {
+  auto* calld = static_cast<CallData*>(arg);
+  // Unless the call was cancelled meanwhile, serve it the leader's response,
+  // or send it after all if the leader had none.
+  if (calld->state_ == State::kWaiting) {
+    calld->response_ = std::move(calld->leader_response_);
+    calld->state_ = calld->response_.has_value() ? State::kHit : State::kMiss;
+    calld->ResumeQueuedBatches();
+  }
+  calld->leader_response_.reset();
+  GRPC_CALL_COMBINER_STOP(calld->call_combiner_,
+                          "response cache: identical call finished");
+  GRPC_CALL_STACK_UNREF(calld->owning_call_, "response cache: following");
+}
+
+void CallData::StopFollowing(grpc_transport_stream_op_batch* cancel_batch) {
+  auto* chand = static_cast<ChannelData*>(elem_->channel_data);
+  // If the leader has finished already, OnLeaderFinishedInCallCombiner()
+  // drops the ref instead.
+  if (chand->coalescer()->Leave(key_, this)) {
+    GRPC_CALL_STACK_UNREF(owning_call_, "response cache: following");
+  }
+  state_ = State::kPassThrough;
+  grpc_error_handle error = cancel_batch->payload->cancel_stream.cancel_error;
+  CallCombinerClosureList closures;
+  for (grpc_transport_stream_op_batch* queued : queued_batches_) {
+    grpc_transport_stream_op_batch_queue_finish_with_failure(
+        queued, GRPC_ERROR_REF(error), &closures);
+  }
+  queued_batches_.clear();
+  closures.RunClosuresWithoutYielding(call_combiner_);
+  grpc_call_next_op(elem_, cancel_batch);
+}
+
+void CallData::ServeFromCache(grpc_transport_stream_op_batch* batch) {
+  CallCombinerClosureList closures;
+  if (batch->recv_initial_metadata) {
+    if (batch->payload->recv_initial_metadata.trailing_metadata_available !=
+        nullptr) {
+      *batch->payload->recv_initial_metadata.trailing_metadata_available =
+          false;
+    }
+    closures.Add(
+        batch->payload->recv_initial_metadata.recv_initial_metadata_ready,
+        GRPC_ERROR_NONE, "response cache: recv_initial_metadata_ready");
+  }
+  if (batch->recv_message) {
+    if (!served_response_) {
+      served_response_ = true;
+      grpc_slice_buffer slices;
+      grpc_slice_buffer_init(&slices);
+      grpc_slice_buffer_add(&slices, response_->Ref().TakeCSlice());
+      new (&recv_replacement_stream_) SliceBufferByteStream(&slices, 0);
+      grpc_slice_buffer_destroy_internal(&slices);
+      batch->payload->recv_message.recv_message->reset(
+          reinterpret_cast<SliceBufferByteStream*>(&recv_replacement_stream_));
+    } else {
+      batch->payload->recv_message.recv_message->reset();
+    }
+    if (batch->payload->recv_message.call_failed_before_recv_message !=
+        nullptr) {
+      *batch->payload->recv_message.call_failed_before_recv_message = false;
+    }
+    closures.Add(batch->payload->recv_message.recv_message_ready,
+                 GRPC_ERROR_NONE, "response cache: recv_message_ready");
+  }
+  if (batch->recv_trailing_metadata) {
+    batch->payload->recv_trailing_metadata.recv_trailing_metadata->Set(
+        GrpcStatusMetadata(), GRPC_STATUS_OK);
+    closures.Add(
+        batch->payload->recv_trailing_metadata.recv_trailing_metadata_ready,
+        GRPC_ERROR_NONE, "response cache: recv_trailing_metadata_ready");
+  }
+  if (batch->on_complete != nullptr) {
+    closures.Add(batch->on_complete, GRPC_ERROR_NONE,
+                 "response cache: on_complete");
+  }
+  closures.RunClosures(call_combiner_);
+}
+
+void CallData::InterceptRecvOps(grpc_transport_stream_op_batch* batch) {
+  if (batch->recv_initial_metadata) {
+    recv_initial_metadata_ =
+        batch->payload->recv_initial_metadata.recv_initial_metadata;
+    original_recv_initial_metadata_ready_ =
+        batch->payload->recv_initial_metadata.recv_initial_metadata_ready;
+    batch->payload->recv_initial_metadata.recv_initial_metadata_ready =
+        &on_recv_initial_metadata_ready_;
+  }
+  if (batch->recv_message) {
+    recv_message_ = batch->payload->recv_message.recv_message;
+    original_recv_message_ready_ =
+        batch->payload->recv_message.recv_message_ready;
+    batch->payload->recv_message.recv_message_ready = &on_recv_message_ready_;
+  }
+  if (batch->recv_trailing_metadata) {
+    recv_trailing_metadata_ =
+        batch->payload->recv_trailing_metadata.recv_trailing_metadata;
+    original_recv_trailing_metadata_ready_ =
+        batch->payload->recv_trailing_metadata.recv_trailing_metadata_ready;
+    batch->payload->recv_trailing_metadata.recv_trailing_metadata_ready =
+        &on_recv_trailing_metadata_ready_;
+  }
+}
+
+void CallData::OnRecvInitialMetadataReady(void* arg, grpc_error_handle error) {
+  auto* calld = static_cast<CallData*>(arg);
+  if (error == GRPC_ERROR_NONE) {
+    std::string buffer;
+    absl::optional<absl::string_view> cache_control =
+        calld->recv_initial_metadata_->GetStringValue("cache-control",
+                                                      &buffer);
+    if (cache_control.has_value()) {
+      calld->cache_control_ = internal::ParseCacheControl(*cache_control);
+    }
+  }
+  grpc_closure* closure = calld->original_recv_initial_metadata_ready_;
+  calld->original_recv_initial_metadata_ready_ = nullptr;
+  Closure::Run(DEBUG_LOCATION, closure, GRPC_ERROR_REF(error));
+}
+
+void CallData::OnRecvMessageReady(void* arg, grpc_error_handle error) {
+  auto* calld = static_cast<CallData*>(arg);
+  if (error != GRPC_ERROR_NONE || *calld->recv_message_ == nullptr) {
+    return calld->ContinueRecvMessageReadyCallback(GRPC_ERROR_REF(error));
+  }
+  // Streamed responses are not cached.
+  if (++calld->recv_messages_ > 1) calld->cacheable_response_ = false;
+  if (!calld->cacheable_response_) {
+    return calld->ContinueRecvMessageReadyCallback(GRPC_ERROR_NONE);
+  }
+  calld->ContinueReadingRecvMessage();
+}
+
+void CallData::ContinueReadingRecvMessage() {
+  while ((*recv_message_)
+             ->Next((*recv_message_)->length() - recv_slices_.length,
+                    &on_recv_message_next_done_)) {
+    if (!PullSliceFromRecvMessage()) return;
+    if (recv_slices_.length == (*recv_message_)->length()) {
+      return FinishRecvMessage();
+    }
+  }
+}
+
+// On failure, completes the recv_message op and returns false.
+bool CallData::PullSliceFromRecvMessage() {
+  grpc_slice slice;
+  grpc_error_handle error = (*recv_message_)->Pull(&slice);
+  if (error != GRPC_ERROR_NONE) {
+    cacheable_response_ = false;
+    ContinueRecvMessageReadyCallback(error);
+    return false;
+  }
+  grpc_slice_buffer_add(&recv_slices_, slice);
+  return true;
+}
+
+void CallData::OnRecvMessageNextDone(void* arg, grpc_error_handle error) {
+  auto* calld = static_cast<CallData*>(arg);
+  if (error != GRPC_ERROR_NONE) {
+    calld->cacheable_response_ = false;
+    return calld->ContinueRecvMessageReadyCallback(GRPC_ERROR_REF(error));
+  }
+  if (!calld->PullSliceFromRecvMessage()) return;
+  if (calld->recv_slices_.length == (*calld->recv_message_)->length()) {
+    calld->FinishRecvMessage();
+  } else {
+    calld->ContinueReadingRecvMessage();
+  }
+}
+
+void CallData::FinishRecvMessage() {
+  // Keep the response as a single slice, so that hits are served with one
+  // ref.
+  if (recv_slices_.count == 1) {
+    response_ = Slice(grpc_slice_ref_internal(recv_slices_.slices[0]));
+  } else {
+    MutableSlice joined =
+        MutableSlice::CreateUninitialized(recv_slices_.length);
+    uint8_t* out = joined.data();
+    for (size_t i = 0; i < recv_slices_.count; ++i) {
+      const grpc_slice& slice = recv_slices_.slices[i];
+      memcpy(out, GRPC_SLICE_START_PTR(slice), GRPC_SLICE_LENGTH(slice));
+      out += GRPC_SLICE_LENGTH(slice);
+    }
+    response_ = Slice(std::move(joined));
+  }
+  // Swap out the drained stream with one of the slices read from it.
+  const uint32_t flags = (*recv_message_)->flags();
+  new (&recv_replacement_stream_) SliceBufferByteStream(&recv_slices_, flags);
+  recv_message_->reset(
+      reinterpret_cast<SliceBufferByteStream*>(&recv_replacement_stream_));
+  ContinueRecvMessageReadyCallback(GRPC_ERROR_NONE);
+}
+
+void CallData::ContinueRecvMessageReadyCallback(grpc_error_handle error) {
+  recv_message_ = nullptr;
+  grpc_closure* closure = original_recv_message_ready_;
+  original_recv_message_ready_ = nullptr;
+  if (seen_recv_trailing_metadata_ready_) {
+    seen_recv_trailing_metadata_ready_ = false;
+    grpc_error_handle trailing_error = on_recv_trailing_metadata_ready_error_;
+    on_recv_trailing_metadata_ready_error_ = GRPC_ERROR_NONE;
+    GRPC_CALL_COMBINER_START(call_combiner_, &on_recv_trailing_metadata_ready_,
+                             trailing_error,
+                             "response cache: continuing "
+                             "recv_trailing_metadata_ready");
+  }
+  Closure::Run(DEBUG_LOCATION, closure, error);
+}
+
+void CallData::OnRecvTrailingMetadataReady(void* arg,
+                                           grpc_error_handle error) {
+  auto* calld = static_cast<CallData*>(arg);
+  if (calld->original_recv_message_ready_ != nullptr) {
+    calld->seen_recv_trailing_metadata_ready_ = true;
+    calld->on_recv_trailing_metadata_ready_error_ = GRPC_ERROR_REF(error);
+    GRPC_CALL_COMBINER_STOP(calld->call_combiner_,
+                            "response cache: deferring "
+                            "recv_trailing_metadata_ready until after "
+                            "recv_message_ready");
+    return;
+  }
+  calld->FinishResponse(error);
+  grpc_closure* closure = calld->original_recv_trailing_metadata_ready_;
+  calld->original_recv_trailing_metadata_ready_ = nullptr;
+  Closure::Run(DEBUG_LOCATION, closure, GRPC_ERROR_REF(error));
+}
+
+void CallData::FinishResponse(grpc_error_handle error) {
+  const bool ok =
+      error == GRPC_ERROR_NONE && cacheable_response_ &&
+      response_.has_value() &&
+      recv_trailing_metadata_->get(GrpcStatusMetadata()) == GRPC_STATUS_OK;
+  auto* chand = static_cast<ChannelData*>(elem_->channel_data);
+  // Followers get the response even if it must not be cached: it answers
+  // their identical requests just as well as the leader's.  On failure they
+  // are sent on their own instead, since the failure may be the leader's.
+  if (leader_) {
+    leader_ = false;
+    if (ok) {
+      chand->coalescer()->Finish(key_, response_);
+    } else {
+      chand->coalescer()->Finish(key_, absl::nullopt);
+    }
+  }
+  if (!ok || cache_control_.no_store) return;
+  Duration ttl = method_config_->ttl();
+  if (cache_control_.max_age.has_value()) {
+    ttl = std::min(ttl, *cache_control_.max_age);
+  }
+  if (ttl <= Duration::Zero()) return;
+  chand->cache()->Insert(std::move(key_), std::move(*response_),
+                         ExecCtx::Get()->Now() + ttl);
+  response_.reset();
+}
+
+void ResponseCacheStartTransportStreamOpBatch(
+    grpc_call_element* elem, grpc_transport_stream_op_batch* batch) {
+  static_cast<CallData*>(elem->call_data)->StartTransportStreamOpBatch(batch);
+}
+
+grpc_error_handle ResponseCacheInitCallElem(
+    grpc_call_element* elem, const grpc_call_element_args* args) {
+  new (elem->call_data) CallData(elem, *args);
+  return GRPC_ERROR_NONE;
+}
+
+void ResponseCacheDestroyCallElem(grpc_call_element* elem,
+                                  const grpc_call_final_info* /*final_info*/,
+                                  grpc_closure* /*ignored*/) {
+  static_cast<CallData*>(elem->call_data)->~CallData();
+}
+
+grpc_error_handle ResponseCacheInitChannelElem(
+    grpc_channel_element* elem, grpc_channel_element_args* args) {
+  new (elem->channel_data) ChannelData(args);
+  return GRPC_ERROR_NONE;
+}
+
+void ResponseCacheDestroyChannelElem(grpc_channel_element* elem) {
+  static_cast<ChannelData*>(elem->channel_data)->~ChannelData();
+}
+
+}  // namespace
+
+const grpc_channel_filter kResponseCacheFilterVtable = {
+    ResponseCacheStartTransportStreamOpBatch,
+    nullptr,
+    grpc_channel_next_op,
+    sizeof(CallData),
+    ResponseCacheInitCallElem,
+    grpc_call_stack_ignore_set_pollset_or_pollset_set,
+    ResponseCacheDestroyCallElem,
+    sizeof(ChannelData),
+    ResponseCacheInitChannelElem,
+    grpc_channel_stack_no_post_init,
+    ResponseCacheDestroyChannelElem,
+    grpc_channel_next_get_info,
+    "response_cache"};
+
+}  // namespace grpc_core
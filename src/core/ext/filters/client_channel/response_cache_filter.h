@@ -0,0 +1,215 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_RESPONSE_CACHE_FILTER_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_RESPONSE_CACHE_FILTER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include <grpc/impl/codegen/grpc_types.h>
+
+#include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/service_config/service_config_parser.h"
+#include "src/core/lib/slice/slice.h"
+
+// Upper bound on the memory, in bytes, that a channel's response cache may
+// reserve from the channel's resource quota.  Defaults to 4 MiB.
+#define GRPC_ARG_RESPONSE_CACHE_MAX_BYTES \
+  "grpc.experimental.response_cache_max_bytes"
+
+namespace grpc_core {
+
+// Present when at least one method of the service config has a
+// "responseCache" or "requestCoalescing" field, so that only those channels
+// pay for the filter.
+class ResponseCacheGlobalConfig : public ServiceConfigParser::ParsedConfig {};
+
+class ResponseCacheMethodConfig : public ServiceConfigParser::ParsedConfig {
+ public:
+  ResponseCacheMethodConfig(Duration ttl, uint32_t max_fan_out,
+                            std::vector<std::string> key_metadata)
+      : ttl_(ttl),
+        max_fan_out_(max_fan_out),
+        key_metadata_(std::move(key_metadata)) {}
+
+  // How long a response may be served from the cache, unless the server asks
+  // for less with a cache-control header.  Zero if responses are not cached.
+  Duration ttl() const { return ttl_; }
+
+  // How many calls may wait on an identical call in flight for its response,
+  // instead of being sent.  Zero if calls are not coalesced.
+  uint32_t max_fan_out() const { return max_fan_out_; }
+
+  // Metadata keys whose values are part of the key that calls are matched
+  // on, both in the cache and in flight.
+  const std::vector<std::string>& key_metadata() const {
+    return key_metadata_;
+  }
+
+ private:
+  Duration ttl_;
+  uint32_t max_fan_out_;
+  std::vector<std::string> key_metadata_;
+};
+
+class ResponseCacheServiceConfigParser final
+    : public ServiceConfigParser::Parser {
+ public:
+  absl::string_view name() const override { return parser_name(); }
+  std::unique_ptr<ServiceConfigParser::ParsedConfig> ParseGlobalParams(
+      const grpc_channel_args* args, const Json& json,
+      grpc_error_handle* error) override;
+  // Parses the "responseCache" and "requestCoalescing" fields of a method
+  // config.
+  std::unique_ptr<ServiceConfigParser::ParsedConfig> ParsePerMethodParams(
+      const grpc_channel_args* args, const Json& json,
+      grpc_error_handle* error) override;
+  static size_t ParserIndex();
+  static void Register(CoreConfiguration::Builder* builder);
+
+ private:
+  static absl::string_view parser_name() { return "response_cache"; }
+};
+
+namespace internal {
+
+// The directives of a cache-control header that the response cache honors.
+struct CacheControl {
+  // no-store or no-cache: the response must not be served from the cache.
+  bool no_store = false;
+  // max-age, if present and valid.
+  absl::optional<Duration> max_age;
+};
+
+CacheControl ParseCacheControl(absl::string_view value);
+
+// A least recently used cache of serialized responses, keyed by method and
+// serialized request.  The memory of the entries is reserved from a resource
+// quota, and the cache is emptied when the quota reclaims memory.
+class ResponseCache : public RefCounted<ResponseCache> {
+ public:
+  ResponseCache(size_t max_bytes, MemoryOwner memory_owner);
+  ~ResponseCache() override;
+
+  // Returns the response cached under key, if it has not expired by now.
+  absl::optional<Slice> Lookup(absl::string_view key, Timestamp now);
+
+  // Caches response under key until expiry, evicting the least recently used
+  // entries to stay within the budget.  Responses too large for the budget
+  // are not cached.
+  void Insert(std::string key, Slice response, Timestamp expiry);
+
+  void Clear();
+
+  size_t size_bytes() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    Slice response;
+    Timestamp expiry;
+    size_t reserved;
+  };
+  using EntryList = std::list<Entry>;
+
+  void RemoveLocked(EntryList::iterator it) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void MaybePostReclaimerLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  const size_t max_bytes_;
+  MemoryOwner memory_owner_;
+  mutable Mutex mu_;
+  // Most recently used first.
+  EntryList entries_ ABSL_GUARDED_BY(mu_);
+  // Keys point into the keys of entries_.
+  std::map<absl::string_view, EntryList::iterator> index_ ABSL_GUARDED_BY(mu_);
+  size_t size_bytes_ ABSL_GUARDED_BY(mu_) = 0;
+  bool reclaimer_posted_ ABSL_GUARDED_BY(mu_) = false;
+};
+
+// Tracks the calls in flight that other calls with the same key may wait on,
+// instead of being sent.  The first call with a key leads; the calls that
+// follow it wait for the leader to finish and hand them its response.
+class CallCoalescer {
+ public:
+  class Follower {
+   public:
+    virtual ~Follower() = default;
+    // Called without the coalescer's lock held, with the leader's response,
+    // or nullopt if it had none to share.
+    virtual void OnLeaderFinished(absl::optional<Slice> response) = 0;
+  };
+
+  enum class JoinResult {
+    // No call with the key was in flight: the caller leads, and must call
+    // Finish() with the key.
+    kLeader,
+    // The caller follows the call in flight.
+    kFollower,
+    // The call in flight has max_fan_out followers already.
+    kFull,
+  };
+
+  JoinResult Join(const std::string& key, uint32_t max_fan_out,
+                  Follower* follower);
+
+  // Stops follower from waiting.  Returns false if its leader has finished,
+  // in which case OnLeaderFinished() is or will be called regardless.
+  bool Leave(const std::string& key, Follower* follower);
+
+  // Hands response to the followers of the leader of key.
+  void Finish(const std::string& key, const absl::optional<Slice>& response);
+
+ private:
+  Mutex mu_;
+  std::map<std::string, std::vector<Follower*>> in_flight_
+      ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace internal
+
+// Serves the calls of the methods that have a "responseCache" method config
+// from a per-channel cache of their responses, keyed by method, serialized
+// request and the configured metadata.  Only calls that complete with OK and
+// a single response message are cached.  Calls of the methods that have a
+// "requestCoalescing" method config also wait for an identical call in
+// flight, if any, and share its response.  Added to the client channel's
+// dynamic filters when the service config has either field; hits and
+// followers never reach the transport.
+extern const grpc_channel_filter kResponseCacheFilterVtable;
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_RESPONSE_CACHE_FILTER_H
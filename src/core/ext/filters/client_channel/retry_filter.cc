@@ -22,6 +22,7 @@
 #include <limits.h>
 #include <stddef.h>
 
+#include <atomic>
 #include <memory>
 #include <new>
 #include <string>
@@ -64,7 +65,9 @@
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/polling_entity.h"
 #include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/resource_quota/api.h"
 #include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/lib/service_config/service_config.h"
 #include "src/core/lib/service_config/service_config_call_data.h"
 #include "src/core/lib/slice/slice_refcount.h"
@@ -115,9 +118,15 @@
 // When constructing the "child" batches, we compare the state in the
 // CallAttempt object against the state in the CallData object to see
 // which batches need to be sent on the LB call for a given attempt.
-
-// TODO(roth): In subsequent PRs:
-// - implement hedging
+//
+// When the method has a hedging policy, additional call attempts are
+// started every hedging delay while the call is uncommitted.  Hedged
+// attempts are kept in CallData alongside the current attempt and are
+// sent the same ops, except that a hedged attempt does not start a send
+// op until the current attempt has completed it, and it never returns a
+// send op completion to the surface.  The first attempt to receive
+// response headers or a fatal status wins: the call is committed to it
+// and all other attempts are cancelled.
 
 // By default, we buffer 256 KiB per RPC for retries.
 // TODO(roth): Do we have any data to suggest a better value?
@@ -173,10 +182,20 @@ class RetryFilter {
         {DEFAULT_PER_RPC_RETRY_BUFFER_SIZE, 0, INT_MAX}));
   }
 
+  static size_t GetMaxPerChannelRetryBufferSize(
+      const grpc_channel_args* args) {
+    return static_cast<size_t>(grpc_channel_args_find_integer(
+        args, GRPC_ARG_PER_CHANNEL_RETRY_BUFFER_SIZE, {0, 0, INT_MAX}));
+  }
+
   RetryFilter(const grpc_channel_args* args, grpc_error_handle* error)
       : client_channel_(grpc_channel_args_find_pointer<ClientChannel>(
             args, GRPC_ARG_CLIENT_CHANNEL)),
         per_rpc_retry_buffer_size_(GetMaxPerRpcRetryBufferSize(args)),
+        per_channel_retry_buffer_size_(GetMaxPerChannelRetryBufferSize(args)),
+        memory_quota_(ResourceQuotaFromChannelArgs(args)->memory_quota()),
+        memory_owner_(memory_quota_->CreateMemoryOwner(
+            "retry_filter", MemoryCategory::kRetryBuffer)),
         service_config_parser_index_(
             internal::RetryServiceConfigParser::ParserIndex()) {
     // Get retry throttling parameters from service config.
@@ -213,8 +232,37 @@ class RetryFilter {
   const RetryMethodConfig* GetRetryPolicy(
       const grpc_call_context_element* context);
 
+  // Charges bytes of cached send ops to the channel's retry buffer and
+  // memory quota.  Returns false without charging anything if that would
+  // exceed the per-channel limit or if the quota is under memory pressure,
+  // in which case the call should give up on retries instead.
+  bool ChargeRetryBuffer(size_t bytes) {
+    if (bytes == 0) return true;
+    if (memory_quota_->IsMemoryPressureHigh()) return false;
+    size_t prev_bytes =
+        retry_buffer_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    if (per_channel_retry_buffer_size_ > 0 &&
+        prev_bytes + bytes > per_channel_retry_buffer_size_) {
+      retry_buffer_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+      return false;
+    }
+    memory_owner_.Reserve(bytes);
+    return true;
+  }
+  void ReleaseRetryBuffer(size_t bytes) {
+    if (bytes == 0) return;
+    retry_buffer_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+    memory_owner_.Release(bytes);
+  }
+
   ClientChannel* client_channel_;
   size_t per_rpc_retry_buffer_size_;
+  size_t per_channel_retry_buffer_size_;
+  MemoryQuotaRefPtr memory_quota_;
+  // Accounts retry buffers under MemoryCategory::kRetryBuffer.
+  MemoryOwner memory_owner_;
+  // Bytes currently charged by all calls on the channel.
+  std::atomic<size_t> retry_buffer_bytes_{0};
   RefCountedPtr<ServerRetryThrottleData> retry_throttle_data_;
   const size_t service_config_parser_index_;
 };
@@ -252,11 +300,26 @@ class RetryFilter::CallData {
     ~CallAttempt() override;
 
     bool lb_call_committed() const { return lb_call_committed_; }
+    bool completed_recv_trailing_metadata() const {
+      return completed_recv_trailing_metadata_;
+    }
 
     // Constructs and starts whatever batches are needed on this call
     // attempt.
     void StartRetriableBatches();
 
+    // Adds whatever batches are needed on this attempt to closures.
+    void AddRetriableBatches(CallCombinerClosureList* closures);
+
+    // Returns true if this is a hedged attempt that is racing the current
+    // attempt.
+    bool IsHedge() const {
+      return !calld_->retry_committed_ && calld_->call_attempt_.get() != this;
+    }
+
+    // Cancels and abandons a hedged attempt that lost the race.
+    void CancelHedgedAttempt(CallCombinerClosureList* closures);
+
     // Frees cached send ops that have already been completed after
     // committing the call.
     void FreeCachedSendOpDataAfterCommit();
@@ -357,6 +420,10 @@ class RetryFilter::CallData {
       grpc_transport_stream_op_batch batch_;
       // For intercepting on_complete.
       grpc_closure on_complete_;
+      // True if the batch was started while its attempt was a hedged
+      // attempt.  Such a batch starts only send ops whose completions have
+      // already been returned to the surface.
+      const bool started_on_hedge_;
     };
 
     class AttemptDispatchController
@@ -418,9 +485,6 @@ class RetryFilter::CallData {
     // Adds batches for pending batches to closures.
     void AddBatchesForPendingBatches(CallCombinerClosureList* closures);
 
-    // Adds whatever batches are needed on this attempt to closures.
-    void AddRetriableBatches(CallCombinerClosureList* closures);
-
     // Returns true if any send op in the batch was not yet started on this
     // attempt.
     bool PendingBatchContainsUnstartedSendOps(PendingBatch* pending);
@@ -437,6 +501,14 @@ class RetryFilter::CallData {
     bool ShouldRetry(absl::optional<grpc_status_code> status,
                      absl::optional<Duration> server_pushback_ms);
 
+    // Used instead of ShouldRetry() when hedging.  Returns true if this
+    // attempt's result should be dropped because another attempt is still
+    // in flight or will be started.  Sets *start_new_attempt if a new
+    // attempt should be started to replace this one.
+    bool ShouldDropHedgedAttempt(grpc_status_code status,
+                                 absl::optional<Duration> server_pushback,
+                                 bool* start_new_attempt);
+
     // Abandons the call attempt.  Unrefs any deferred batches.
     void Abandon();
 
@@ -445,6 +517,8 @@ class RetryFilter::CallData {
     void MaybeCancelPerAttemptRecvTimer();
 
     CallData* calld_;
+    // Value for the grpc-previous-rpc-attempts header.
+    const int num_previous_attempts_;
     AttemptDispatchController attempt_dispatch_controller_;
     OrphanablePtr<ClientChannel::LoadBalancedCall> lb_call_;
     bool lb_call_committed_ = false;
@@ -542,6 +616,7 @@ class RetryFilter::CallData {
   void FreeAllCachedSendOpData();
 
   // Commits the call so that no further retry attempts will be performed.
+  // When hedging, cancels all attempts other than call_attempt.
   void RetryCommit(CallAttempt* call_attempt);
 
   // Starts a timer to retry after appropriate back-off.
@@ -561,6 +636,38 @@ class RetryFilter::CallData {
 
   void CreateCallAttempt(bool is_transparent_retry);
 
+  bool IsHedging() const {
+    return retry_policy_ != nullptr &&
+           retry_policy_->hedging_delay().has_value();
+  }
+  // Returns true if another hedged attempt may be started.
+  bool CanStartHedgedAttempt();
+  // Returns the number of attempts that have not yet been removed.
+  size_t NumAttemptsInFlight() const {
+    return (call_attempt_ != nullptr ? 1 : 0) + hedged_attempts_.size();
+  }
+  // Starts the hedge timer for deadline, unless it is already pending
+  // or no more hedged attempts may be started.
+  void MaybeStartHedgeTimer(Timestamp deadline);
+  void MaybeCancelHedgeTimer();
+  static void OnHedgeTimer(void* arg, grpc_error_handle error);
+  static void OnHedgeTimerLocked(void* arg, grpc_error_handle error);
+  // Starts a new hedged attempt alongside the current attempt.
+  void StartHedgedAttempt(CallCombinerClosureList* closures);
+  // Stops starting new hedged attempts.  Attempts already in flight are
+  // left to complete.
+  void StopHedging();
+  // Removes a failed attempt.  If it was the current attempt, the oldest
+  // hedged attempt replaces it.
+  void RemoveCallAttempt(CallAttempt* call_attempt,
+                         CallCombinerClosureList* closures);
+  // Starts the next attempt after a hedged attempt failed, honoring
+  // server_pushback if set.
+  void StartNextHedgedAttempt(absl::optional<Duration> server_pushback,
+                              CallCombinerClosureList* closures);
+  // Adds batches for all hedged attempts to closures.
+  void AddRetriableBatchesForHedgedAttempts(CallCombinerClosureList* closures);
+
   RetryFilter* chand_;
   grpc_polling_entity* pollent_;
   RefCountedPtr<ServerRetryThrottleData> retry_throttle_data_;
@@ -578,10 +685,12 @@ class RetryFilter::CallData {
 
   RefCountedPtr<CallStackDestructionBarrier> call_stack_destruction_barrier_;
 
-  // TODO(roth): As part of implementing hedging, we will need to maintain a
-  // list of all pending attempts, so that we can cancel them all if the call
-  // gets cancelled.
+  // The current attempt.  When hedging, this is the oldest attempt in
+  // flight, and it is the only one that returns send op completions to
+  // the surface.
   RefCountedPtr<CallAttempt> call_attempt_;
+  // Other attempts in flight when hedging, in the order they were started.
+  absl::InlinedVector<RefCountedPtr<CallAttempt>, 4> hedged_attempts_;
 
   // LB call used when we've committed to a call attempt and the retry
   // state for that attempt is no longer needed.  This provides a fast
@@ -594,6 +703,10 @@ class RetryFilter::CallData {
   // batches received from above will be added to this list, and they
   // will not be removed until we have invoked their completion callbacks.
   size_t bytes_buffered_for_retry_ = 0;
+  // Bytes charged via chand_->ChargeRetryBuffer().  Released on commit,
+  // after which cached send ops are freed as they complete, or when the
+  // call is destroyed if hedged attempts may still be reading them.
+  size_t bytes_charged_for_retry_ = 0;
   PendingBatch pending_batches_[MAX_PENDING_BATCHES];
   bool pending_send_initial_metadata_ : 1;
   bool pending_send_message_ : 1;
@@ -604,9 +717,22 @@ class RetryFilter::CallData {
   bool retry_timer_pending_ : 1;
   bool retry_codepath_started_ : 1;
   bool sent_transparent_retry_not_seen_by_server_ : 1;
+  bool hedge_timer_pending_ : 1;
+  bool hedging_stopped_ : 1;
+  // Set once a hedged attempt has been started.  From then on, cached send
+  // op data is kept until the call ends, since abandoned attempts may
+  // still be reading it.
+  bool hedged_attempt_started_ : 1;
+  // Number of attempts before the current one.  When hedging, this is the
+  // number of attempts started before the newest one.
   int num_attempts_completed_ = 0;
   grpc_timer retry_timer_;
   grpc_closure retry_closure_;
+  grpc_timer hedge_timer_;
+  grpc_closure hedge_closure_;
+  // Earliest time at which the next hedged attempt may be started, as
+  // set by server pushback.
+  Timestamp next_hedge_time_ = Timestamp::InfPast();
 
   // Cached data for retrying send ops.
   // send_initial_metadata
@@ -629,10 +755,9 @@ class RetryFilter::CallData {
   // Note: We inline the cache for the first 3 send_message ops and use
   // dynamic allocation after that.  This number was essentially picked
   // at random; it could be changed in the future to tune performance.
-  // TODO(roth): As part of implementing hedging, we may need some
-  // synchronization here, since ByteStreamCache does not provide any
-  // synchronization, so it's not safe to have multiple
-  // CachingByteStreams read from the same ByteStreamCache concurrently.
+  // ByteStreamCache is not synchronized, so when hedging, a message is
+  // sent on a hedged attempt only after the current attempt has completed
+  // it, by which time the cache is fully populated and is only read.
   absl::InlinedVector<ByteStreamCache*, 3> send_messages_;
   // send_trailing_metadata
   bool seen_send_trailing_metadata_ = false;
@@ -701,6 +826,7 @@ RetryFilter::CallData::CallAttempt::CallAttempt(CallData* calld,
     : RefCounted(GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace) ? "CallAttempt"
                                                            : nullptr),
       calld_(calld),
+      num_previous_attempts_(calld->num_attempts_completed_),
       attempt_dispatch_controller_(this),
       batch_payload_(calld->call_context_),
       started_send_initial_metadata_(false),
@@ -753,10 +879,9 @@ RetryFilter::CallData::CallAttempt::~CallAttempt() {
 }
 
 void RetryFilter::CallData::CallAttempt::FreeCachedSendOpDataAfterCommit() {
-  // TODO(roth): When we implement hedging, this logic will need to get
-  // a bit more complex, because there may be other (now abandoned) call
-  // attempts still using this data.  We may need to do some sort of
-  // ref-counting instead.
+  // Abandoned hedged attempts may still be using this data, in which case
+  // it is freed when the call is destroyed.
+  if (calld_->hedged_attempt_started_) return;
   if (completed_send_initial_metadata_) {
     calld_->FreeCachedSendInitialMetadata();
   }
@@ -797,11 +922,9 @@ bool RetryFilter::CallData::CallAttempt::HaveSendOpsToReplay() {
 
 void RetryFilter::CallData::CallAttempt::MaybeSwitchToFastPath() {
   // If we're not yet committed, we can't switch yet.
-  // TODO(roth): As part of implementing hedging, this logic needs to
-  // check that *this* call attempt is the one that we've committed to.
-  // Might need to replace abandoned_ with an enum indicating whether we're
-  // in flight, abandoned, or the winning call attempt.
   if (!calld_->retry_committed_) return;
+  // Only the attempt we committed to can switch.
+  if (calld_->call_attempt_.get() != this) return;
   // If we've already switched to fast path, there's nothing to do here.
   if (calld_->committed_call_ != nullptr) return;
   // If the perAttemptRecvTimeout timer is pending, we can't switch yet.
@@ -943,6 +1066,11 @@ void RetryFilter::CallData::CallAttempt::AddBatchesForPendingBatches(
     PendingBatch* pending = &calld_->pending_batches_[i];
     grpc_transport_stream_op_batch* batch = pending->batch;
     if (batch == nullptr) continue;
+    // A hedged attempt does not start a batch until the current attempt
+    // has returned its send op completion to the surface.  This keeps the
+    // send_message cache from being read while it is still being filled,
+    // and the completion is returned only once.
+    if (batch->on_complete != nullptr && IsHedge()) continue;
     bool has_send_ops = false;
     // Skip any batch that either (a) has already been started on this
     // call attempt or (b) we can't start yet because we're still
@@ -1120,6 +1248,22 @@ void RetryFilter::CallData::CallAttempt::StartRetriableBatches() {
   closures.RunClosures(calld_->call_combiner_);
 }
 
+void RetryFilter::CallData::CallAttempt::CancelHedgedAttempt(
+    CallCombinerClosureList* closures) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p attempt=%p: cancelling hedged attempt",
+            calld_->chand_, calld_, this);
+  }
+  MaybeCancelPerAttemptRecvTimer();
+  MaybeAddBatchForCancelOp(
+      grpc_error_set_int(
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING("hedged attempt cancelled"),
+          GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_CANCELLED),
+      closures);
+  Abandon();
+}
+
 void RetryFilter::CallData::CallAttempt::CancelFromSurface(
     grpc_transport_stream_op_batch* cancel_batch) {
   MaybeCancelPerAttemptRecvTimer();
@@ -1229,6 +1373,68 @@ bool RetryFilter::CallData::CallAttempt::ShouldRetry(
   return true;
 }
 
+bool RetryFilter::CallData::CallAttempt::ShouldDropHedgedAttempt(
+    grpc_status_code status, absl::optional<Duration> server_pushback,
+    bool* start_new_attempt) {
+  *start_new_attempt = false;
+  if (status == GRPC_STATUS_OK) {
+    if (calld_->retry_throttle_data_ != nullptr) {
+      calld_->retry_throttle_data_->RecordSuccess();
+    }
+    return false;
+  }
+  // A fatal status code ends the call, regardless of other attempts.
+  if (!calld_->retry_policy_->retryable_status_codes().Contains(status)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p attempt=%p: status %s not configured as "
+              "non-fatal for hedging",
+              calld_->chand_, calld_, this,
+              grpc_status_code_to_string(status));
+    }
+    return false;
+  }
+  // As for retries, record the failure before the remaining checks.
+  // Once throttled, no new hedged attempts are started, but the ones
+  // already in flight may still succeed.
+  if (calld_->retry_throttle_data_ != nullptr &&
+      !calld_->retry_throttle_data_->RecordFailure()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p attempt=%p: hedging throttled",
+              calld_->chand_, calld_, this);
+    }
+    calld_->StopHedging();
+  }
+  if (calld_->retry_committed_) return false;
+  if (server_pushback.has_value() && *server_pushback < Duration::Zero()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO,
+              "chand=%p calld=%p attempt=%p: hedging stopped due to server "
+              "push-back",
+              calld_->chand_, calld_, this);
+    }
+    calld_->StopHedging();
+  }
+  if (calld_->CanStartHedgedAttempt()) {
+    auto* service_config_call_data =
+        static_cast<ClientChannelServiceConfigCallData*>(
+            calld_->call_context_[GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA]
+                .value);
+    if (service_config_call_data->call_dispatch_controller()->ShouldRetry()) {
+      *start_new_attempt = true;
+    } else {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+        gpr_log(GPR_INFO,
+                "chand=%p calld=%p attempt=%p: call dispatch controller "
+                "denied hedged attempt",
+                calld_->chand_, calld_, this);
+      }
+      calld_->StopHedging();
+    }
+  }
+  return *start_new_attempt || calld_->NumAttemptsInFlight() > 1;
+}
+
 void RetryFilter::CallData::CallAttempt::Abandon() {
   abandoned_ = true;
   // Unref batches for deferred completion callbacks that will now never
@@ -1285,9 +1491,8 @@ void RetryFilter::CallData::CallAttempt::OnPerAttemptRecvTimerLocked(
   if (error == GRPC_ERROR_NONE &&
       call_attempt->per_attempt_recv_timer_pending_) {
     call_attempt->per_attempt_recv_timer_pending_ = false;
-    // Cancel this attempt.
-    // TODO(roth): When implementing hedging, we should not cancel the
-    // current attempt.
+    // Cancel this attempt.  perAttemptRecvTimeout is only set for retry
+    // policies, so this is never a hedged attempt.
     call_attempt->MaybeAddBatchForCancelOp(
         grpc_error_set_int(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
                                "retry perAttemptRecvTimeout exceeded"),
@@ -1335,7 +1540,8 @@ RetryFilter::CallData::CallAttempt::BatchData::BatchData(
     : RefCounted(
           GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace) ? "BatchData" : nullptr,
           refcount),
-      call_attempt_(std::move(attempt)) {
+      call_attempt_(std::move(attempt)),
+      started_on_hedge_(call_attempt_->IsHedge()) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
     gpr_log(GPR_INFO, "chand=%p calld=%p attempt=%p: creating batch %p",
             call_attempt_->calld_->chand_, call_attempt_->calld_,
@@ -1369,10 +1575,9 @@ RetryFilter::CallData::CallAttempt::BatchData::~BatchData() {
 void RetryFilter::CallData::CallAttempt::BatchData::
     FreeCachedSendOpDataForCompletedBatch() {
   auto* calld = call_attempt_->calld_;
-  // TODO(roth): When we implement hedging, this logic will need to get
-  // a bit more complex, because there may be other (now abandoned) call
-  // attempts still using this data.  We may need to do some sort of
-  // ref-counting instead.
+  // Abandoned hedged attempts may still be using this data, in which case
+  // it is freed when the call is destroyed.
+  if (calld->hedged_attempt_started_) return;
   if (batch_.send_initial_metadata) {
     calld->FreeCachedSendInitialMetadata();
   }
@@ -1701,6 +1906,28 @@ void RetryFilter::CallData::CallAttempt::BatchData::
       closures->Add(pending->batch->on_complete, GRPC_ERROR_REF(error),
                     "failing on_complete for pending batch");
       pending->batch->on_complete = nullptr;
+      // The batch was never started on this attempt, so neither were its
+      // recv ops.  This happens when a hedged attempt wins before it has
+      // caught up with the surface.
+      grpc_transport_stream_op_batch_payload* payload =
+          pending->batch->payload;
+      if (pending->batch->recv_initial_metadata &&
+          payload->recv_initial_metadata.recv_initial_metadata_ready !=
+              nullptr) {
+        closures->Add(
+            payload->recv_initial_metadata.recv_initial_metadata_ready,
+            GRPC_ERROR_REF(error),
+            "failing recv_initial_metadata_ready for pending batch");
+        payload->recv_initial_metadata.recv_initial_metadata_ready = nullptr;
+      }
+      if (pending->batch->recv_message &&
+          payload->recv_message.recv_message_ready != nullptr) {
+        payload->recv_message.recv_message->reset();
+        closures->Add(payload->recv_message.recv_message_ready,
+                      GRPC_ERROR_REF(error),
+                      "failing recv_message_ready for pending batch");
+        payload->recv_message.recv_message_ready = nullptr;
+      }
       calld->MaybeClearPendingBatch(pending);
     }
   }
@@ -1777,7 +2004,12 @@ void RetryFilter::CallData::CallAttempt::BatchData::RecvTrailingMetadataReady(
   }
   // Check if we should retry.
   if (!is_lb_drop) {  // Never retry on LB drops.
-    enum { kNoRetry, kTransparentRetry, kConfigurableRetry } retry = kNoRetry;
+    enum {
+      kNoRetry,
+      kTransparentRetry,
+      kConfigurableRetry,
+      kHedgedAttemptFailed
+    } retry = kNoRetry;
     // Handle transparent retries.
     if (stream_network_state.has_value() && !calld->retry_committed_) {
       // If not sent on wire, then always retry.
@@ -1791,10 +2023,18 @@ void RetryFilter::CallData::CallAttempt::BatchData::RecvTrailingMetadataReady(
         retry = kTransparentRetry;
       }
     }
-    // If not transparently retrying, check for configurable retry.
-    if (retry == kNoRetry &&
-        call_attempt->ShouldRetry(status, server_pushback)) {
-      retry = kConfigurableRetry;
+    // If not transparently retrying, check for configurable retry or,
+    // when hedging, whether other attempts can still provide the result.
+    bool start_hedged_attempt = false;
+    if (retry == kNoRetry) {
+      if (calld->IsHedging()) {
+        if (call_attempt->ShouldDropHedgedAttempt(status, server_pushback,
+                                                  &start_hedged_attempt)) {
+          retry = kHedgedAttemptFailed;
+        }
+      } else if (call_attempt->ShouldRetry(status, server_pushback)) {
+        retry = kConfigurableRetry;
+      }
     }
     // If we're retrying, do so.
     if (retry != kNoRetry) {
@@ -1808,12 +2048,24 @@ void RetryFilter::CallData::CallAttempt::BatchData::RecvTrailingMetadataReady(
               : GRPC_ERROR_REF(error),
           &closures);
       // For transparent retries, add a closure to immediately start a new
-      // call attempt.
+      // call attempt, unless this is a hedged attempt, which other attempts
+      // are already racing.
       // For configurable retries, start retry timer.
+      // For failed hedged attempts, drop the attempt and start the next
+      // one if needed.
       if (retry == kTransparentRetry) {
-        calld->AddClosureToStartTransparentRetry(&closures);
-      } else {
+        if (call_attempt->IsHedge()) {
+          calld->RemoveCallAttempt(call_attempt, &closures);
+        } else {
+          calld->AddClosureToStartTransparentRetry(&closures);
+        }
+      } else if (retry == kConfigurableRetry) {
         calld->StartRetryTimer(server_pushback);
+      } else {
+        calld->RemoveCallAttempt(call_attempt, &closures);
+        if (start_hedged_attempt) {
+          calld->StartNextHedgedAttempt(server_pushback, &closures);
+        }
       }
       // Record that this attempt has been abandoned.
       call_attempt->Abandon();
@@ -1954,9 +2206,14 @@ void RetryFilter::CallData::CallAttempt::BatchData::OnComplete(
   }
   // Construct list of closures to execute.
   CallCombinerClosureList closures;
-  // Add closure for the completed pending batch, if any.
-  batch_data->AddClosuresForCompletedPendingBatch(GRPC_ERROR_REF(error),
-                                                  &closures);
+  // Add closure for the completed pending batch, if any.  Batches started
+  // on hedged attempts have nothing to return.  Otherwise, the completed
+  // send ops may now be started on hedged attempts.
+  if (!batch_data->started_on_hedge_) {
+    batch_data->AddClosuresForCompletedPendingBatch(GRPC_ERROR_REF(error),
+                                                    &closures);
+    calld->AddRetriableBatchesForHedgedAttempts(&closures);
+  }
   // If needed, add a callback to start any replay or pending send ops on
   // the LB call.
   if (!call_attempt->completed_recv_trailing_metadata_) {
@@ -2003,9 +2260,10 @@ void RetryFilter::CallData::CallAttempt::BatchData::
   // If we've already completed one or more attempts, add the
   // grpc-retry-attempts header.
   call_attempt_->send_initial_metadata_ = calld->send_initial_metadata_.Copy();
-  if (GPR_UNLIKELY(calld->num_attempts_completed_ > 0)) {
-    call_attempt_->send_initial_metadata_.Set(GrpcPreviousRpcAttemptsMetadata(),
-                                              calld->num_attempts_completed_);
+  if (GPR_UNLIKELY(call_attempt_->num_previous_attempts_ > 0)) {
+    call_attempt_->send_initial_metadata_.Set(
+        GrpcPreviousRpcAttemptsMetadata(),
+        call_attempt_->num_previous_attempts_);
   } else {
     call_attempt_->send_initial_metadata_.Remove(
         GrpcPreviousRpcAttemptsMetadata());
@@ -2192,10 +2450,14 @@ RetryFilter::CallData::CallData(RetryFilter* chand,
       retry_committed_(false),
       retry_timer_pending_(false),
       retry_codepath_started_(false),
-      sent_transparent_retry_not_seen_by_server_(false) {}
+      sent_transparent_retry_not_seen_by_server_(false),
+      hedge_timer_pending_(false),
+      hedging_stopped_(false),
+      hedged_attempt_started_(false) {}
 
 RetryFilter::CallData::~CallData() {
   FreeAllCachedSendOpData();
+  chand_->ReleaseRetryBuffer(bytes_charged_for_retry_);
   grpc_slice_unref_internal(path_);
   // Make sure there are no remaining pending batches.
   for (size_t i = 0; i < GPR_ARRAY_SIZE(pending_batches_); ++i) {
@@ -2240,18 +2502,16 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
     // If we have a current call attempt, commit the call, then send
     // the cancellation down to that attempt.  When the call fails, it
     // will not be retried, because we have committed it here.
+    // Committing also cancels any hedged attempts; their cancellations
+    // complete internally, and only this attempt's completion is returned
+    // to the surface.
     if (call_attempt_ != nullptr) {
       RetryCommit(call_attempt_.get());
-      // TODO(roth): When implementing hedging, this will get more
-      // complex, because instead of just passing the batch down to a
-      // single call attempt, we'll need to cancel multiple call
-      // attempts and wait for the cancellation on_complete from each call
-      // attempt before we propagate the on_complete from this batch
-      // back to the surface.
       // Note: This will release the call combiner.
       call_attempt_->CancelFromSurface(batch);
       return;
     }
+    MaybeCancelHedgeTimer();
     // Cancel retry timer if needed.
     if (retry_timer_pending_) {
       if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
@@ -2330,7 +2590,16 @@ void RetryFilter::CallData::StartTransportStreamOpBatch(
     gpr_log(GPR_INFO, "chand=%p calld=%p: starting batch on attempt=%p", chand_,
             this, call_attempt_.get());
   }
-  call_attempt_->StartRetriableBatches();
+  if (hedged_attempts_.empty()) {
+    call_attempt_->StartRetriableBatches();
+    return;
+  }
+  // Also send batches to hedged attempts.
+  CallCombinerClosureList closures;
+  call_attempt_->AddRetriableBatches(&closures);
+  AddRetriableBatchesForHedgedAttempts(&closures);
+  // Note: This will yield the call combiner.
+  closures.RunClosures(call_combiner_);
 }
 
 OrphanablePtr<ClientChannel::LoadBalancedCall>
@@ -2350,9 +2619,165 @@ RetryFilter::CallData::CreateLoadBalancedCall(
 
 void RetryFilter::CallData::CreateCallAttempt(bool is_transparent_retry) {
   call_attempt_ = MakeRefCounted<CallAttempt>(this, is_transparent_retry);
+  if (IsHedging()) {
+    MaybeStartHedgeTimer(ExecCtx::Get()->Now() +
+                         *retry_policy_->hedging_delay());
+  }
   call_attempt_->StartRetriableBatches();
 }
 
+//
+// hedging
+//
+
+bool RetryFilter::CallData::CanStartHedgedAttempt() {
+  return IsHedging() && !hedging_stopped_ && !retry_committed_ &&
+         cancelled_from_surface_ == GRPC_ERROR_NONE &&
+         num_attempts_completed_ + 1 < retry_policy_->max_attempts() &&
+         (retry_throttle_data_ == nullptr ||
+          !retry_throttle_data_->IsThrottled());
+}
+
+void RetryFilter::CallData::MaybeStartHedgeTimer(Timestamp deadline) {
+  if (hedge_timer_pending_ || !CanStartHedgedAttempt()) return;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO,
+            "chand=%p calld=%p: next hedged attempt in %" PRId64 " ms", chand_,
+            this, (deadline - ExecCtx::Get()->Now()).millis());
+  }
+  GRPC_CLOSURE_INIT(&hedge_closure_, OnHedgeTimer, this, nullptr);
+  GRPC_CALL_STACK_REF(owning_call_, "OnHedgeTimer");
+  hedge_timer_pending_ = true;
+  grpc_timer_init(&hedge_timer_, deadline, &hedge_closure_);
+}
+
+void RetryFilter::CallData::MaybeCancelHedgeTimer() {
+  if (hedge_timer_pending_) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+      gpr_log(GPR_INFO, "chand=%p calld=%p: cancelling hedge timer", chand_,
+              this);
+    }
+    hedge_timer_pending_ = false;  // Lame timer callback.
+    grpc_timer_cancel(&hedge_timer_);
+  }
+}
+
+void RetryFilter::CallData::OnHedgeTimer(void* arg, grpc_error_handle error) {
+  auto* calld = static_cast<CallData*>(arg);
+  GRPC_CLOSURE_INIT(&calld->hedge_closure_, OnHedgeTimerLocked, calld,
+                    nullptr);
+  GRPC_CALL_COMBINER_START(calld->call_combiner_, &calld->hedge_closure_,
+                           GRPC_ERROR_REF(error), "hedge timer fired");
+}
+
+void RetryFilter::CallData::OnHedgeTimerLocked(void* arg,
+                                               grpc_error_handle error) {
+  auto* calld = static_cast<CallData*>(arg);
+  CallCombinerClosureList closures;
+  if (error == GRPC_ERROR_NONE && calld->hedge_timer_pending_) {
+    calld->hedge_timer_pending_ = false;
+    // If no attempt is in flight, the retry timer will start the next one.
+    if (calld->call_attempt_ != nullptr && calld->CanStartHedgedAttempt()) {
+      if (ExecCtx::Get()->Now() < calld->next_hedge_time_) {
+        // Server pushback delayed the next hedged attempt.
+        calld->MaybeStartHedgeTimer(calld->next_hedge_time_);
+      } else {
+        auto* service_config_call_data =
+            static_cast<ClientChannelServiceConfigCallData*>(
+                calld->call_context_[GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA]
+                    .value);
+        if (service_config_call_data->call_dispatch_controller()
+                ->ShouldRetry()) {
+          calld->StartHedgedAttempt(&closures);
+        } else {
+          if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+            gpr_log(GPR_INFO,
+                    "chand=%p calld=%p: call dispatch controller denied "
+                    "hedged attempt",
+                    calld->chand_, calld);
+          }
+          calld->StopHedging();
+        }
+      }
+    }
+  }
+  // Note: This yields the call combiner.
+  closures.RunClosures(calld->call_combiner_);
+  GRPC_CALL_STACK_UNREF(calld->owning_call_, "OnHedgeTimer");
+}
+
+void RetryFilter::CallData::StartHedgedAttempt(
+    CallCombinerClosureList* closures) {
+  ++num_attempts_completed_;
+  hedged_attempt_started_ = true;
+  hedged_attempts_.push_back(
+      MakeRefCounted<CallAttempt>(this, /*is_transparent_retry=*/false));
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO, "chand=%p calld=%p: started hedged attempt=%p (%d)",
+            chand_, this, hedged_attempts_.back().get(),
+            num_attempts_completed_ + 1);
+  }
+  hedged_attempts_.back()->AddRetriableBatches(closures);
+  MaybeStartHedgeTimer(ExecCtx::Get()->Now() +
+                       *retry_policy_->hedging_delay());
+}
+
+void RetryFilter::CallData::StopHedging() {
+  hedging_stopped_ = true;
+  MaybeCancelHedgeTimer();
+}
+
+void RetryFilter::CallData::RemoveCallAttempt(
+    CallAttempt* call_attempt, CallCombinerClosureList* closures) {
+  if (call_attempt != call_attempt_.get()) {
+    for (auto it = hedged_attempts_.begin(); it != hedged_attempts_.end();
+         ++it) {
+      if (it->get() == call_attempt) {
+        hedged_attempts_.erase(it);
+        break;
+      }
+    }
+    return;
+  }
+  if (hedged_attempts_.empty()) {
+    call_attempt_.reset(DEBUG_LOCATION, "RemoveCallAttempt");
+    return;
+  }
+  // The oldest hedged attempt becomes the current attempt and takes over
+  // returning send op completions to the surface.
+  call_attempt_ = std::move(hedged_attempts_.front());
+  hedged_attempts_.erase(hedged_attempts_.begin());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+    gpr_log(GPR_INFO, "chand=%p calld=%p: hedged attempt=%p is now current",
+            chand_, this, call_attempt_.get());
+  }
+  call_attempt_->AddRetriableBatches(closures);
+}
+
+void RetryFilter::CallData::StartNextHedgedAttempt(
+    absl::optional<Duration> server_pushback,
+    CallCombinerClosureList* closures) {
+  if (call_attempt_ == nullptr) {
+    // No attempt is left in flight, so start the next one as the current
+    // attempt once any pushback has elapsed.
+    ++num_attempts_completed_;
+    MaybeCancelHedgeTimer();
+    StartRetryTimer(server_pushback);
+  } else if (server_pushback.has_value()) {
+    next_hedge_time_ = ExecCtx::Get()->Now() + *server_pushback;
+    MaybeStartHedgeTimer(next_hedge_time_);
+  } else {
+    StartHedgedAttempt(closures);
+  }
+}
+
+void RetryFilter::CallData::AddRetriableBatchesForHedgedAttempts(
+    CallCombinerClosureList* closures) {
+  for (auto& call_attempt : hedged_attempts_) {
+    call_attempt->AddRetriableBatches(closures);
+  }
+}
+
 //
 // send op data caching
 //
@@ -2458,30 +2883,45 @@ RetryFilter::CallData::PendingBatch* RetryFilter::CallData::PendingBatchesAdd(
   // Also check if the batch takes us over the retry buffer limit.
   // Note: We don't check the size of trailing metadata here, because
   // gRPC clients do not send trailing metadata.
+  size_t bytes = 0;
   if (batch->send_initial_metadata) {
     pending_send_initial_metadata_ = true;
-    bytes_buffered_for_retry_ += batch->payload->send_initial_metadata
-                                     .send_initial_metadata->TransportSize();
+    bytes += batch->payload->send_initial_metadata.send_initial_metadata
+                 ->TransportSize();
   }
   if (batch->send_message) {
     pending_send_message_ = true;
-    bytes_buffered_for_retry_ +=
-        batch->payload->send_message.send_message->length();
+    bytes += batch->payload->send_message.send_message->length();
   }
   if (batch->send_trailing_metadata) {
     pending_send_trailing_metadata_ = true;
   }
-  // TODO(roth): When we implement hedging, if there are currently attempts
-  // in flight, we will need to pick the one on which the max number of send
-  // ops have already been sent, and we commit to that attempt.
-  if (GPR_UNLIKELY(bytes_buffered_for_retry_ >
-                   chand_->per_rpc_retry_buffer_size_)) {
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
-      gpr_log(GPR_INFO,
-              "chand=%p calld=%p: exceeded retry buffer size, committing",
-              chand_, this);
+  bytes_buffered_for_retry_ += bytes;
+  // When hedging, the current attempt is always the one on which the most
+  // send ops have been sent, since hedged attempts only follow it, so we
+  // commit to that attempt.
+  if (!retry_committed_) {
+    if (GPR_UNLIKELY(bytes_buffered_for_retry_ >
+                     chand_->per_rpc_retry_buffer_size_)) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+        gpr_log(GPR_INFO,
+                "chand=%p calld=%p: exceeded retry buffer size, committing",
+                chand_, this);
+      }
+      RetryCommit(call_attempt_.get());
+    } else if (GPR_UNLIKELY(!chand_->ChargeRetryBuffer(bytes))) {
+      // Under memory pressure, we'd rather give up on retrying this call
+      // than keep buffering for it.
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
+        gpr_log(GPR_INFO,
+                "chand=%p calld=%p: channel retry buffer exhausted or memory "
+                "pressure high, committing",
+                chand_, this);
+      }
+      RetryCommit(call_attempt_.get());
+    } else {
+      bytes_charged_for_retry_ += bytes;
     }
-    RetryCommit(call_attempt_.get());
   }
   return pending;
 }
@@ -2589,6 +3029,34 @@ void RetryFilter::CallData::RetryCommit(CallAttempt* call_attempt) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_retry_trace)) {
     gpr_log(GPR_INFO, "chand=%p calld=%p: committing retries", chand_, this);
   }
+  MaybeCancelHedgeTimer();
+  if (call_attempt != nullptr &&
+      (call_attempt != call_attempt_.get() || !hedged_attempts_.empty())) {
+    CallCombinerClosureList closures;
+    bool promoted = false;
+    // If a hedged attempt won, it becomes the current attempt.
+    for (auto it = hedged_attempts_.begin(); it != hedged_attempts_.end();
+         ++it) {
+      if (it->get() == call_attempt) {
+        RefCountedPtr<CallAttempt> previous = std::move(call_attempt_);
+        call_attempt_ = std::move(*it);
+        hedged_attempts_.erase(it);
+        if (previous != nullptr) previous->CancelHedgedAttempt(&closures);
+        promoted = true;
+        break;
+      }
+    }
+    // Cancel all other attempts.
+    for (auto& hedged_attempt : hedged_attempts_) {
+      hedged_attempt->CancelHedgedAttempt(&closures);
+    }
+    hedged_attempts_.clear();
+    // The winner may not yet have started all of the pending batches.
+    if (promoted && !call_attempt->completed_recv_trailing_metadata()) {
+      call_attempt->AddRetriableBatches(&closures);
+    }
+    closures.RunClosuresWithoutYielding(call_combiner_);
+  }
   if (call_attempt != nullptr) {
     // If the call attempt's LB call has been committed, inform the call
     // dispatch controller that the call has been committed.
@@ -2605,6 +3073,10 @@ void RetryFilter::CallData::RetryCommit(CallAttempt* call_attempt) {
     // Free cached send ops.
     call_attempt->FreeCachedSendOpDataAfterCommit();
   }
+  if (!hedged_attempt_started_) {
+    chand_->ReleaseRetryBuffer(bytes_charged_for_retry_);
+    bytes_charged_for_retry_ = 0;
+  }
 }
 
 void RetryFilter::CallData::StartRetryTimer(
@@ -284,6 +284,67 @@ grpc_error_handle ParseRetryPolicy(
   return GRPC_ERROR_CREATE_FROM_VECTOR("retryPolicy", &error_list);
 }
 
+grpc_error_handle ParseHedgingPolicy(const Json& json, int* max_attempts,
+                                     Duration* hedging_delay,
+                                     StatusCodeSet* non_fatal_status_codes) {
+  if (json.type() != Json::Type::OBJECT) {
+    return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "field:hedgingPolicy error:should be of type object");
+  }
+  std::vector<grpc_error_handle> error_list;
+  // Parse maxAttempts.
+  auto it = json.object_value().find("maxAttempts");
+  if (it == json.object_value().end()) {
+    error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "field:maxAttempts error:required field missing"));
+  } else if (it->second.type() != Json::Type::NUMBER) {
+    error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "field:maxAttempts error:should be of type number"));
+  } else {
+    *max_attempts =
+        gpr_parse_nonnegative_int(it->second.string_value().c_str());
+    if (*max_attempts <= 1) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:maxAttempts error:should be at least 2"));
+    } else if (*max_attempts > MAX_MAX_RETRY_ATTEMPTS) {
+      gpr_log(GPR_ERROR,
+              "service config: clamped hedgingPolicy.maxAttempts at %d",
+              MAX_MAX_RETRY_ATTEMPTS);
+      *max_attempts = MAX_MAX_RETRY_ATTEMPTS;
+    }
+  }
+  // Parse hedgingDelay.  If unset, all attempts are sent at once.
+  ParseJsonObjectFieldAsDuration(json.object_value(), "hedgingDelay",
+                                 hedging_delay, &error_list,
+                                 /*required=*/false);
+  // Parse nonFatalStatusCodes.
+  it = json.object_value().find("nonFatalStatusCodes");
+  if (it != json.object_value().end()) {
+    if (it->second.type() != Json::Type::ARRAY) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:nonFatalStatusCodes error:must be of type array"));
+    } else {
+      for (const Json& element : it->second.array_value()) {
+        if (element.type() != Json::Type::STRING) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:nonFatalStatusCodes error:status codes should be of type "
+              "string"));
+          continue;
+        }
+        grpc_status_code status;
+        if (!grpc_status_code_from_string(element.string_value().c_str(),
+                                          &status)) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:nonFatalStatusCodes error:failed to parse status code"));
+          continue;
+        }
+        non_fatal_status_codes->Add(status);
+      }
+    }
+  }
+  return GRPC_ERROR_CREATE_FROM_VECTOR("hedgingPolicy", &error_list);
+}
+
 }  // namespace
 
 std::unique_ptr<ServiceConfigParser::ParsedConfig>
@@ -291,8 +352,28 @@ RetryServiceConfigParser::ParsePerMethodParams(const grpc_channel_args* args,
                                                const Json& json,
                                                grpc_error_handle* error) {
   GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+  // Parse hedging policy, if hedging is enabled.
+  auto it = json.object_value().find("hedgingPolicy");
+  if (it != json.object_value().end() &&
+      grpc_channel_args_find_bool(args, GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING,
+                                  false)) {
+    if (json.object_value().find("retryPolicy") != json.object_value().end()) {
+      *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:hedgingPolicy error:may not be set together with "
+          "retryPolicy");
+      return nullptr;
+    }
+    int max_attempts = 0;
+    Duration hedging_delay;
+    StatusCodeSet non_fatal_status_codes;
+    *error = ParseHedgingPolicy(it->second, &max_attempts, &hedging_delay,
+                                &non_fatal_status_codes);
+    if (*error != GRPC_ERROR_NONE) return nullptr;
+    return absl::make_unique<RetryMethodConfig>(max_attempts, hedging_delay,
+                                                non_fatal_status_codes);
+  }
   // Parse retry policy.
-  auto it = json.object_value().find("retryPolicy");
+  it = json.object_value().find("retryPolicy");
   if (it == json.object_value().end()) return nullptr;
   int max_attempts = 0;
   Duration initial_backoff;
@@ -66,6 +66,14 @@ class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
         retryable_status_codes_(retryable_status_codes),
         per_attempt_recv_timeout_(per_attempt_recv_timeout) {}
 
+  // Constructs a hedging policy.  Hedging policies have no backoff; their
+  // non-fatal status codes are returned by retryable_status_codes().
+  RetryMethodConfig(int max_attempts, Duration hedging_delay,
+                    StatusCodeSet non_fatal_status_codes)
+      : max_attempts_(max_attempts),
+        retryable_status_codes_(non_fatal_status_codes),
+        hedging_delay_(hedging_delay) {}
+
   int max_attempts() const { return max_attempts_; }
   Duration initial_backoff() const { return initial_backoff_; }
   Duration max_backoff() const { return max_backoff_; }
@@ -76,6 +84,8 @@ class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
   absl::optional<Duration> per_attempt_recv_timeout() const {
     return per_attempt_recv_timeout_;
   }
+  // Set only for hedging policies.
+  absl::optional<Duration> hedging_delay() const { return hedging_delay_; }
 
  private:
   int max_attempts_ = 0;
@@ -84,6 +94,7 @@ class RetryMethodConfig : public ServiceConfigParser::ParsedConfig {
   float backoff_multiplier_ = 0;
   StatusCodeSet retryable_status_codes_;
   absl::optional<Duration> per_attempt_recv_timeout_;
+  absl::optional<Duration> hedging_delay_;
 };
 
 class RetryServiceConfigParser : public ServiceConfigParser::Parser {
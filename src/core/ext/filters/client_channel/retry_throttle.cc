@@ -20,12 +20,15 @@
 
 #include "src/core/ext/filters/client_channel/retry_throttle.h"
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <utility>
 
 #include <grpc/support/atm.h>
 
+#include "src/core/lib/gprpp/fast_random.h"
+
 namespace grpc_core {
 namespace internal {
 
@@ -108,6 +111,16 @@ void ServerRetryThrottleData::RecordSuccess() {
       static_cast<gpr_atm>(throttle_data->max_milli_tokens_));
 }
 
+bool ServerRetryThrottleData::IsThrottled() {
+  // First, check if we are stale and need to be replaced.
+  ServerRetryThrottleData* throttle_data = this;
+  GetReplacementThrottleDataIfNeeded(&throttle_data);
+  // Use the same threshold as RecordFailure().
+  const intptr_t value =
+      static_cast<intptr_t>(gpr_atm_acq_load(&throttle_data->milli_tokens_));
+  return value <= throttle_data->max_milli_tokens_ / 2;
+}
+
 //
 // ServerRetryThrottleMap
 //
@@ -137,5 +150,104 @@ RefCountedPtr<ServerRetryThrottleData> ServerRetryThrottleMap::GetDataForServer(
   return throttle_data->Ref();
 }
 
+//
+// ServerAdaptiveThrottleData
+//
+
+ServerAdaptiveThrottleData::ServerAdaptiveThrottleData(
+    double accepts_multiplier, Duration window)
+    : accepts_multiplier_(accepts_multiplier),
+      window_(window),
+      bucket_millis_(std::max<int64_t>(1, window.millis() / kNumBuckets)) {}
+
+int64_t ServerAdaptiveThrottleData::EpochFor(Timestamp now) const {
+  return now.milliseconds_after_process_epoch() / bucket_millis_;
+}
+
+ServerAdaptiveThrottleData::Bucket& ServerAdaptiveThrottleData::BucketFor(
+    Timestamp now) {
+  const int64_t epoch = EpochFor(now);
+  Bucket& bucket = buckets_[epoch % kNumBuckets];
+  int64_t bucket_epoch = bucket.epoch.load(std::memory_order_acquire);
+  // The first thread to get here in a new slice of the window resets the
+  // bucket.  Counts racing with the reset may be lost, which only makes the
+  // estimate slightly less precise.
+  if (bucket_epoch < epoch &&
+      bucket.epoch.compare_exchange_strong(bucket_epoch, epoch,
+                                           std::memory_order_acq_rel)) {
+    bucket.requests.store(0, std::memory_order_relaxed);
+    bucket.accepts.store(0, std::memory_order_relaxed);
+  }
+  return bucket;
+}
+
+void ServerAdaptiveThrottleData::Sum(Timestamp now, uint64_t* requests,
+                                     uint64_t* accepts) {
+  const int64_t epoch = EpochFor(now);
+  *requests = 0;
+  *accepts = 0;
+  for (Bucket& bucket : buckets_) {
+    if (bucket.epoch.load(std::memory_order_acquire) +
+            static_cast<int64_t>(kNumBuckets) <=
+        epoch) {
+      continue;
+    }
+    *requests += bucket.requests.load(std::memory_order_relaxed);
+    *accepts += bucket.accepts.load(std::memory_order_relaxed);
+  }
+}
+
+double ServerAdaptiveThrottleData::RejectProbability(Timestamp now) {
+  uint64_t requests;
+  uint64_t accepts;
+  Sum(now, &requests, &accepts);
+  const double excess = requests - accepts_multiplier_ * accepts;
+  if (excess <= 0) return 0;
+  return excess / (requests + 1);
+}
+
+bool ServerAdaptiveThrottleData::ShouldThrottle(Timestamp now) {
+  // Decide based on the calls before this one, so that a new channel does
+  // not reject its first call.
+  const double probability = RejectProbability(now);
+  BucketFor(now).requests.fetch_add(1, std::memory_order_relaxed);
+  // Only draw a random number while backends are refusing calls.
+  if (probability <= 0) return false;
+  return FastRandomDouble() < probability;
+}
+
+void ServerAdaptiveThrottleData::RecordResult(bool accepted, Timestamp now) {
+  if (!accepted) return;
+  BucketFor(now).accepts.fetch_add(1, std::memory_order_relaxed);
+}
+
+//
+// ServerAdaptiveThrottleMap
+//
+
+ServerAdaptiveThrottleMap* ServerAdaptiveThrottleMap::Get() {
+  static ServerAdaptiveThrottleMap* m = new ServerAdaptiveThrottleMap();
+  return m;
+}
+
+RefCountedPtr<ServerAdaptiveThrottleData>
+ServerAdaptiveThrottleMap::GetDataForServer(const std::string& server_name,
+                                            double accepts_multiplier,
+                                            Duration window) {
+  MutexLock lock(&mu_);
+  RefCountedPtr<ServerAdaptiveThrottleData>& throttle_data =
+      map_[server_name];
+  if (throttle_data == nullptr ||
+      throttle_data->accepts_multiplier() != accepts_multiplier ||
+      throttle_data->window() != window) {
+    // Entry not found, or found with old parameters.  Create a new one.
+    // Channels still holding the old entry keep using it until they get
+    // the new service config.
+    throttle_data = MakeRefCounted<ServerAdaptiveThrottleData>(
+        accepts_multiplier, window);
+  }
+  return throttle_data;
+}
+
 }  // namespace internal
 }  // namespace grpc_core
@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <map>
 #include <string>
 
@@ -33,6 +34,7 @@
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
 
 namespace grpc_core {
 namespace internal {
@@ -50,6 +52,10 @@ class ServerRetryThrottleData : public RefCounted<ServerRetryThrottleData> {
   /// Records a success.
   void RecordSuccess();
 
+  /// Returns true if retries are currently throttled.  Used before sending
+  /// a hedged attempt, which does not itself record a failure.
+  bool IsThrottled();
+
   intptr_t max_milli_tokens() const { return max_milli_tokens_; }
   intptr_t milli_token_ratio() const { return milli_token_ratio_; }
 
@@ -85,6 +91,72 @@ class ServerRetryThrottleMap {
   StringToDataMap map_ ABSL_GUARDED_BY(mu_);
 };
 
+/// Tracks client-side adaptive throttling data for an individual server
+/// name.  Over a sliding window, counts the calls the application made
+/// (requests) and the calls the backends accepted (accepts), and rejects
+/// new calls locally with probability
+/// max(0, (requests - accepts_multiplier * accepts) / (requests + 1)).
+class ServerAdaptiveThrottleData
+    : public RefCounted<ServerAdaptiveThrottleData> {
+ public:
+  ServerAdaptiveThrottleData(double accepts_multiplier, Duration window);
+
+  /// Counts a new call.  Returns true if the call should be rejected
+  /// locally.  Rejected calls still count as requests, so that the
+  /// rejection rate keeps growing while backends keep refusing calls.
+  bool ShouldThrottle(Timestamp now);
+
+  /// Records the result of a call that was not rejected locally.  A call
+  /// failing with RESOURCE_EXHAUSTED or UNAVAILABLE is not accepted.
+  void RecordResult(bool accepted, Timestamp now);
+
+  /// Returns the probability with which a new call would be rejected.
+  double RejectProbability(Timestamp now);
+
+  double accepts_multiplier() const { return accepts_multiplier_; }
+  Duration window() const { return window_; }
+
+ private:
+  static constexpr size_t kNumBuckets = 10;
+
+  // Counts of one slice of the window.  Buckets are reused round-robin;
+  // epoch is the index of the slice they currently count.
+  struct Bucket {
+    std::atomic<int64_t> epoch{-1};
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> accepts{0};
+  };
+
+  int64_t EpochFor(Timestamp now) const;
+  Bucket& BucketFor(Timestamp now);
+  // Sums the buckets that are still within the window.
+  void Sum(Timestamp now, uint64_t* requests, uint64_t* accepts);
+
+  const double accepts_multiplier_;
+  const Duration window_;
+  const int64_t bucket_millis_;
+  Bucket buckets_[kNumBuckets];
+};
+
+/// Global map of server name to adaptive throttling data.
+class ServerAdaptiveThrottleMap {
+ public:
+  static ServerAdaptiveThrottleMap* Get();
+
+  /// Returns the throttling data for \a server_name, creating a new entry
+  /// if needed.
+  RefCountedPtr<ServerAdaptiveThrottleData> GetDataForServer(
+      const std::string& server_name, double accepts_multiplier,
+      Duration window);
+
+ private:
+  using StringToDataMap =
+      std::map<std::string, RefCountedPtr<ServerAdaptiveThrottleData>>;
+
+  Mutex mu_;
+  StringToDataMap map_ ABSL_GUARDED_BY(mu_);
+};
+
 }  // namespace internal
 }  // namespace grpc_core
 
@@ -23,11 +23,14 @@
 
 #include <algorithm>
 #include <cstring>
+#include <map>
 #include <memory>
 #include <new>
 #include <utility>
 
+#include "absl/random/random.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/numbers.h"
 
 #include <grpc/slice.h>
 #include <grpc/status.h>
@@ -50,6 +53,7 @@
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/alloc.h"
 #include "src/core/lib/gprpp/debug_location.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
@@ -59,6 +63,8 @@
 #include "src/core/lib/surface/channel_stack_type.h"
 #include "src/core/lib/transport/connectivity_state.h"
 #include "src/core/lib/transport/error_utils.h"
+#include "src/core/lib/transport/http2_errors.h"
+#include "src/core/lib/transport/transport_impl.h"
 
 // Strong and weak refs.
 #define INTERNAL_REF_BITS 16
@@ -71,6 +77,12 @@
 #define GRPC_SUBCHANNEL_RECONNECT_MAX_BACKOFF_SECONDS 120
 #define GRPC_SUBCHANNEL_RECONNECT_JITTER 0.2
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_client_connect_rate_limit, 0,
+    "Declares the maximum rate, in attempts per second, at which the "
+    "subchannels of the process start connection attempts. Attempts over "
+    "the limit are delayed. Set to 0 for no limit.");
+
 // Conversion between subchannel call and call stack.
 #define SUBCHANNEL_CALL_TO_CALL_STACK(call) \
   (grpc_call_stack*)((char*)(call) +        \
@@ -341,6 +353,7 @@ class Subchannel::ConnectedSubchannelStateWatcher
       // TODO(roth): Consider whether there's a cleaner way to do this.
       c->SetConnectivityStateLocked(GRPC_CHANNEL_IDLE, status);
       c->backoff_.Reset();
+      c->MaybeSpreadReconnectLocked(status);
     }
   }
 
@@ -484,14 +497,21 @@ class Subchannel::HealthWatcherMap::HealthWatcher
   void StartHealthCheckingLocked()
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(subchannel_->mu_) {
     GPR_ASSERT(health_check_client_ == nullptr);
-    health_check_client_ = MakeHealthCheckClient(
-        health_check_service_name_, subchannel_->connected_subchannel_,
-        subchannel_->pollset_set_, subchannel_->channelz_node_, Ref());
+    if (subchannel_->share_health_check_streams_) {
+      health_check_client_ = MakeSharedHealthCheckClient(
+          subchannel_->throttle_address_, health_check_service_name_,
+          subchannel_->connected_subchannel_, subchannel_->pollset_set_,
+          subchannel_->channelz_node_, Ref());
+    } else {
+      health_check_client_ = MakeHealthCheckClient(
+          health_check_service_name_, subchannel_->connected_subchannel_,
+          subchannel_->pollset_set_, subchannel_->channelz_node_, Ref());
+    }
   }
 
   WeakRefCountedPtr<Subchannel> subchannel_;
   std::string health_check_service_name_;
-  OrphanablePtr<SubchannelStreamClient> health_check_client_;
+  OrphanablePtr<Orphanable> health_check_client_;
   grpc_connectivity_state state_;
   absl::Status status_;
   ConnectivityStateWatcherList watcher_list_;
@@ -635,6 +655,90 @@ BackOff::Options ParseArgsForBackoffValues(const grpc_channel_args* args,
       .set_max_backoff(max_backoff);
 }
 
+// Token buckets limiting the rate at which subchannels start connection
+// attempts, both for the whole process and per address.  A bucket holds up
+// to a second's worth of tokens (at least one), and may go into debt: every
+// attempt takes a token, and is delayed until the bucket has refilled it.
+// This spreads a burst of attempts evenly instead of failing them.
+class ConnectionAttemptThrottle {
+ public:
+  static ConnectionAttemptThrottle* Get() {
+    static ConnectionAttemptThrottle* throttle = new ConnectionAttemptThrottle(
+        GPR_GLOBAL_CONFIG_GET(grpc_client_connect_rate_limit));
+    return throttle;
+  }
+
+  // Takes a token for an attempt to connect to \a address, whose subchannel
+  // has a per-address limit of \a per_address_rate attempts per second (0
+  // for none).  Returns how long the attempt must be delayed.
+  Duration Reserve(const std::string& address, double per_address_rate) {
+    if (global_.rate <= 0 && per_address_rate <= 0) return Duration::Zero();
+    const Timestamp now = ExecCtx::Get()->Now();
+    MutexLock lock(&mu_);
+    Duration delay = global_.Take(now);
+    if (per_address_rate > 0) {
+      if (buckets_.size() >= next_sweep_size_) SweepLocked(now);
+      auto it = buckets_.emplace(std::make_pair(address, per_address_rate),
+                                 Bucket(per_address_rate, now));
+      delay = std::max(delay, it.first->second.Take(now));
+    }
+    return delay;
+  }
+
+ private:
+  // Buckets are swept once there are this many of them.
+  static constexpr size_t kMinSweepSize = 64;
+
+  struct Bucket {
+    Bucket(double rate, Timestamp now)
+        : rate(rate), tokens(Capacity()), last_refill(now) {}
+
+    double Capacity() const { return std::max(1.0, rate); }
+
+    void Refill(Timestamp now) {
+      tokens = std::min(Capacity(),
+                        tokens + (now - last_refill).seconds() * rate);
+      last_refill = now;
+    }
+
+    // Takes a token, and returns how long until the bucket is out of debt.
+    Duration Take(Timestamp now) {
+      if (rate <= 0) return Duration::Zero();
+      Refill(now);
+      tokens -= 1;
+      if (tokens >= 0) return Duration::Zero();
+      return Duration::FromSecondsAsDouble(-tokens / rate);
+    }
+
+    double rate;
+    double tokens;
+    Timestamp last_refill;
+  };
+
+  explicit ConnectionAttemptThrottle(int32_t global_rate)
+      : global_(std::max(0, global_rate), ExecCtx::Get()->Now()) {}
+
+  // Removes the buckets that are full, since they behave like new ones.
+  void SweepLocked(Timestamp now) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    for (auto it = buckets_.begin(); it != buckets_.end();) {
+      it->second.Refill(now);
+      if (it->second.tokens >= it->second.Capacity()) {
+        it = buckets_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    next_sweep_size_ = std::max(kMinSweepSize, 2 * buckets_.size());
+  }
+
+  Mutex mu_;
+  Bucket global_ ABSL_GUARDED_BY(mu_);
+  // Keyed by address and per-address rate.
+  std::map<std::pair<std::string, double>, Bucket> buckets_
+      ABSL_GUARDED_BY(mu_);
+  size_t next_sweep_size_ ABSL_GUARDED_BY(mu_) = kMinSweepSize;
+};
+
 }  // namespace
 
 Subchannel::Subchannel(SubchannelKey key,
@@ -651,6 +755,18 @@ Subchannel::Subchannel(SubchannelKey key,
   GRPC_CLOSURE_INIT(&on_connecting_finished_, OnConnectingFinished, this,
                     grpc_schedule_on_exec_ctx);
   GRPC_CLOSURE_INIT(&on_retry_timer_, OnRetryTimer, this, nullptr);
+  GRPC_CLOSURE_INIT(&on_connect_delay_timer_, OnConnectDelayTimer, this,
+                    nullptr);
+  // Connection rate limit and reconnect spread.
+  throttle_address_ =
+      grpc_sockaddr_to_string(&key_.address(), false).value_or("");
+  per_address_connect_rate_ = grpc_channel_args_find_integer(
+      args, GRPC_ARG_PER_ADDRESS_CONNECT_RATE_LIMIT, {0, 0, INT_MAX});
+  goaway_reconnect_spread_ =
+      Duration::Milliseconds(grpc_channel_args_find_integer(
+          args, GRPC_ARG_GOAWAY_RECONNECT_SPREAD_MS, {0, 0, INT_MAX}));
+  share_health_check_streams_ = grpc_channel_args_find_bool(
+      args, GRPC_ARG_SHARE_HEALTH_CHECK_STREAMS, false);
   // Check proxy mapper to determine address to connect to and channel
   // args to use.
   address_for_connect_ = key_.address();
@@ -802,8 +918,11 @@ void Subchannel::RequestConnection() {
 void Subchannel::ResetBackoff() {
   MutexLock lock(&mu_);
   backoff_.Reset();
+  reconnect_not_before_ = Timestamp();
   if (state_ == GRPC_CHANNEL_TRANSIENT_FAILURE) {
     grpc_timer_cancel(&retry_timer_);
+  } else if (connect_delay_timer_pending_) {
+    grpc_timer_cancel(&connect_delay_timer_);
   }
 }
 
@@ -817,6 +936,7 @@ void Subchannel::Orphan() {
   MutexLock lock(&mu_);
   GPR_ASSERT(!shutdown_);
   shutdown_ = true;
+  if (connect_delay_timer_pending_) grpc_timer_cancel(&connect_delay_timer_);
   connector_.reset();
   connected_subchannel_.reset();
   health_watcher_map_.ShutdownLocked();
@@ -912,11 +1032,52 @@ void Subchannel::OnRetryTimerLocked() {
 }
 
 void Subchannel::StartConnectingLocked() {
+  // Report CONNECTING.
+  SetConnectivityStateLocked(GRPC_CHANNEL_CONNECTING, absl::OkStatus());
+  DelayOrConnectLocked();
+}
+
+void Subchannel::OnConnectDelayTimer(void* arg, grpc_error_handle /*error*/) {
+  WeakRefCountedPtr<Subchannel> c(static_cast<Subchannel*>(arg));
+  {
+    MutexLock lock(&c->mu_);
+    c->connect_delay_timer_pending_ = false;
+    if (!c->shutdown_) c->DelayOrConnectLocked();
+  }
+  c.reset(DEBUG_LOCATION, "ConnectDelayTimer");
+}
+
+void Subchannel::DelayOrConnectLocked() {
+  // Wait out the reconnect spread first, and only then take a token from
+  // the rate limits, so that the spread attempts are not also throttled as
+  // a burst.
+  const Timestamp now = ExecCtx::Get()->Now();
+  Timestamp start_time = reconnect_not_before_;
+  if (start_time <= now && !connect_reserved_) {
+    connect_reserved_ = true;
+    start_time = now + ConnectionAttemptThrottle::Get()->Reserve(
+                           throttle_address_, per_address_connect_rate_);
+  }
+  if (start_time <= now) {
+    connect_reserved_ = false;
+    ConnectLocked();
+    return;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+    gpr_log(GPR_INFO,
+            "subchannel %p %s: delaying connection attempt for %" PRId64 " ms",
+            this, key_.ToString().c_str(), (start_time - now).millis());
+  }
+  connect_delay_timer_pending_ = true;
+  // Ref held by callback.
+  WeakRef(DEBUG_LOCATION, "ConnectDelayTimer").release();
+  grpc_timer_init(&connect_delay_timer_, start_time, &on_connect_delay_timer_);
+}
+
+void Subchannel::ConnectLocked() {
   // Set next attempt time.
   const Timestamp min_deadline = min_connect_timeout_ + ExecCtx::Get()->Now();
   next_attempt_time_ = backoff_.NextAttemptTime();
-  // Report CONNECTING.
-  SetConnectivityStateLocked(GRPC_CHANNEL_CONNECTING, absl::OkStatus());
   // Start connection attempt.
   SubchannelConnector::Args args;
   args.address = &address_for_connect_;
@@ -927,6 +1088,34 @@ void Subchannel::StartConnectingLocked() {
   connector_->Connect(args, &connecting_result_, &on_connecting_finished_);
 }
 
+void Subchannel::MaybeSpreadReconnectLocked(const absl::Status& status) {
+  if (goaway_reconnect_spread_ == Duration::Zero()) return;
+  absl::optional<absl::Cord> goaway_error_payload =
+      status.GetPayload(kGoawayErrorKey);
+  uint32_t goaway_error;
+  if (!goaway_error_payload.has_value() ||
+      !absl::SimpleAtoi(std::string(*goaway_error_payload), &goaway_error)) {
+    return;
+  }
+  // A graceful GOAWAY is typically sent to all the clients of a server at
+  // once, when it restarts or drains.  Any other error is specific to the
+  // connection, and is retried right away.
+  Duration window;
+  switch (goaway_error) {
+    case GRPC_HTTP2_NO_ERROR:
+      window = goaway_reconnect_spread_;
+      break;
+    case GRPC_HTTP2_ENHANCE_YOUR_CALM:
+      window = goaway_reconnect_spread_ * 2;
+      break;
+    default:
+      return;
+  }
+  absl::BitGen bitgen;
+  reconnect_not_before_ =
+      ExecCtx::Get()->Now() + window * absl::Uniform(bitgen, 0.0, 1.0);
+}
+
 void Subchannel::OnConnectingFinished(void* arg, grpc_error_handle error) {
   WeakRefCountedPtr<Subchannel> c(static_cast<Subchannel*>(arg));
   const grpc_channel_args* delete_channel_args =
@@ -970,7 +1159,8 @@ bool Subchannel::PublishTransportLocked() {
   ChannelStackBuilderImpl builder("subchannel", GRPC_CLIENT_SUBCHANNEL);
   builder.SetChannelArgs(ChannelArgs::FromC(connecting_result_.channel_args))
       .SetTransport(connecting_result_.transport);
-  if (!CoreConfiguration::Get().channel_init().CreateStack(&builder)) {
+  if (!CoreConfiguration::Get().channel_init().CreateStackCached(
+          &builder, connecting_result_.transport->vtable->name)) {
     return false;
   }
   absl::StatusOr<RefCountedPtr<grpc_channel_stack>> stk = builder.Build();
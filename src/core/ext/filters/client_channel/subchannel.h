@@ -59,6 +59,27 @@
 #include "src/core/lib/transport/metadata_batch.h"
 #include "src/core/lib/transport/transport.h"
 
+// Maximum rate, in attempts per second, at which subchannels with this
+// channel arg start connection attempts to a given address.  Attempts over
+// the limit are delayed, not failed.  The limit is shared by all channels in
+// the process that connect to the address with the same value.  0 (the
+// default) means unlimited.
+#define GRPC_ARG_PER_ADDRESS_CONNECT_RATE_LIMIT \
+  "grpc.experimental.per_address_connect_rate_limit"
+// When a connection is closed by a GOAWAY, delay the next connection attempt
+// by a random amount of up to this many milliseconds (twice this for
+// ENHANCE_YOUR_CALM), so that the clients of a restarting server do not all
+// reconnect at once.  0 (the default) disables the delay.
+#define GRPC_ARG_GOAWAY_RECONNECT_SPREAD_MS \
+  "grpc.experimental.goaway_reconnect_spread_ms"
+// If non-zero, health checks for a service name share a single Watch stream
+// with the health checks of all the other subchannels in the process that
+// connect to the same address with this channel arg set.  Backends then see
+// one health check stream per client process instead of one per channel.
+// Defaults to 0.
+#define GRPC_ARG_SHARE_HEALTH_CHECK_STREAMS \
+  "grpc.experimental.share_health_check_streams"
+
 namespace grpc_core {
 
 class SubchannelCall;
@@ -370,6 +391,12 @@ class Subchannel : public DualRefCounted<Subchannel> {
       ABSL_LOCKS_EXCLUDED(mu_);
   void OnRetryTimerLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   void StartConnectingLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  static void OnConnectDelayTimer(void* arg, grpc_error_handle error)
+      ABSL_LOCKS_EXCLUDED(mu_);
+  void DelayOrConnectLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void ConnectLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void MaybeSpreadReconnectLocked(const absl::Status& status)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   static void OnConnectingFinished(void* arg, grpc_error_handle error)
       ABSL_LOCKS_EXCLUDED(mu_);
   void OnConnectingFinishedLocked(grpc_error_handle error)
@@ -391,6 +418,15 @@ class Subchannel : public DualRefCounted<Subchannel> {
   RefCountedPtr<channelz::SubchannelNode> channelz_node_;
   // Minimum connection timeout.
   Duration min_connect_timeout_;
+  // Address used to key the per-address connection rate limit and the
+  // shared health check streams.
+  std::string throttle_address_;
+  // Per-address connection rate limit, in attempts per second (0 for none).
+  double per_address_connect_rate_;
+  // Maximum random delay before reconnecting after a GOAWAY (0 for none).
+  Duration goaway_reconnect_spread_;
+  // Whether health check streams are shared with other subchannels.
+  bool share_health_check_streams_;
 
   // Connection state.
   OrphanablePtr<SubchannelConnector> connector_;
@@ -428,6 +464,15 @@ class Subchannel : public DualRefCounted<Subchannel> {
   grpc_timer retry_timer_ ABSL_GUARDED_BY(mu_);
   grpc_closure on_retry_timer_ ABSL_GUARDED_BY(mu_);
 
+  // Delay of connection attempts by the reconnect spread and the connection
+  // rate limits.  connect_reserved_ is set once the pending attempt has been
+  // admitted by the rate limits.
+  Timestamp reconnect_not_before_ ABSL_GUARDED_BY(mu_);
+  bool connect_reserved_ ABSL_GUARDED_BY(mu_) = false;
+  bool connect_delay_timer_pending_ ABSL_GUARDED_BY(mu_) = false;
+  grpc_timer connect_delay_timer_ ABSL_GUARDED_BY(mu_);
+  grpc_closure on_connect_delay_timer_ ABSL_GUARDED_BY(mu_);
+
   // Keepalive time period (-1 for unset)
   int keepalive_time_ ABSL_GUARDED_BY(mu_) = -1;
 
@@ -0,0 +1,505 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/concurrency_limit/concurrency_limit_filter.h"
+
+#include <limits.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <tuple>
+
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "upb/upb.h"
+#include "upb/upb.hpp"
+#include "xds/data/orca/v3/orca_load_report.upb.h"
+
+#include <grpc/impl/codegen/grpc_types.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/gprpp/capture.h"
+#include "src/core/lib/json/json_util.h"
+#include "src/core/lib/promise/promise.h"
+#include "src/core/lib/promise/seq.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/service_config/service_config_impl.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/surface/channel_init.h"
+#include "src/core/lib/transport/metadata_batch.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_concurrency_limit_filter_trace(false,
+                                              "concurrency_limit_filter");
+
+//
+// AdaptiveConcurrencyLimit
+//
+
+namespace {
+
+// Number of samples averaged by the short and long term latency estimates.
+constexpr double kShortWindow = 10;
+constexpr double kLongWindow = 600;
+
+}  // namespace
+
+AdaptiveConcurrencyLimit::AdaptiveConcurrencyLimit(const Options& options)
+    : options_(options),
+      limit_(options.initial_limit),
+      estimated_limit_(options.initial_limit),
+      reported_limit_(options.initial_limit) {}
+
+bool AdaptiveConcurrencyLimit::TryAcquire() {
+  uint32_t in_flight = in_flight_.load(std::memory_order_relaxed);
+  do {
+    if (in_flight >= limit()) return false;
+  } while (!in_flight_.compare_exchange_weak(in_flight, in_flight + 1,
+                                             std::memory_order_relaxed));
+  return true;
+}
+
+absl::optional<uint32_t> AdaptiveConcurrencyLimit::Release(
+    absl::optional<double> latency_us) {
+  uint32_t in_flight = in_flight_.fetch_sub(1, std::memory_order_relaxed);
+  if (!latency_us.has_value()) return absl::nullopt;
+  if (!mu_.TryLock()) return absl::nullopt;
+  absl::optional<uint32_t> changed = Update(*latency_us, in_flight);
+  mu_.Unlock();
+  return changed;
+}
+
+absl::optional<uint32_t> AdaptiveConcurrencyLimit::Update(double latency_us,
+                                                          uint32_t in_flight) {
+  latency_us = std::max(latency_us, 1.0);
+  ++num_samples_;
+  if (num_samples_ == 1) {
+    short_rtt_us_ = long_rtt_us_ = latency_us;
+  } else {
+    short_rtt_us_ += (latency_us - short_rtt_us_) * (2 / (kShortWindow + 1));
+    // Plain average until the long window has seen a few samples.
+    double long_weight = num_samples_ <= kShortWindow
+                             ? 1.0 / num_samples_
+                             : 2 / (kLongWindow + 1);
+    long_rtt_us_ += (latency_us - long_rtt_us_) * long_weight;
+  }
+  // Once latency drops well below the long term average, catch up faster so
+  // the limit can grow again.
+  if (long_rtt_us_ > 2 * short_rtt_us_) long_rtt_us_ *= 0.95;
+  // A limit that is not being used says nothing about capacity; don't let it
+  // grow without bounds.
+  if (in_flight < estimated_limit_ / 2) return absl::nullopt;
+  double gradient =
+      std::max(0.5, std::min(1.0, options_.rtt_tolerance * long_rtt_us_ /
+                                      short_rtt_us_));
+  double new_limit = estimated_limit_ * gradient + std::sqrt(estimated_limit_);
+  estimated_limit_ = estimated_limit_ * (1 - options_.smoothing) +
+                     new_limit * options_.smoothing;
+  estimated_limit_ =
+      std::max<double>(options_.min_limit,
+                       std::min<double>(options_.max_limit, estimated_limit_));
+  uint32_t limit = static_cast<uint32_t>(estimated_limit_);
+  limit_.store(limit, std::memory_order_relaxed);
+  if (limit * 5 > reported_limit_ * 6 || limit * 5 < reported_limit_ * 4) {
+    reported_limit_ = limit;
+    return limit;
+  }
+  return absl::nullopt;
+}
+
+//
+// ConcurrencyLimitServiceConfigParser
+//
+
+namespace {
+
+bool ParseJsonObjectFieldAsDouble(const Json::Object& object,
+                                  absl::string_view field_name,
+                                  double* output,
+                                  std::vector<grpc_error_handle>* error_list) {
+  auto it = object.find(std::string(field_name));
+  if (it == object.end()) return false;
+  if (it->second.type() != Json::Type::NUMBER ||
+      !absl::SimpleAtod(it->second.string_value(), output)) {
+    error_list->push_back(GRPC_ERROR_CREATE_FROM_CPP_STRING(
+        absl::StrCat("field:", field_name, " error:should be a number")));
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+std::unique_ptr<ServiceConfigParser::ParsedConfig>
+ConcurrencyLimitServiceConfigParser::ParsePerMethodParams(
+    const grpc_channel_args* /*args*/, const Json& json,
+    grpc_error_handle* error) {
+  GPR_DEBUG_ASSERT(error != nullptr && *error == GRPC_ERROR_NONE);
+  std::vector<grpc_error_handle> error_list;
+  const Json::Object* limit_json;
+  if (!ParseJsonObjectField(json.object_value(), "concurrencyLimit",
+                            &limit_json, &error_list, false)) {
+    *error = GRPC_ERROR_CREATE_FROM_VECTOR("concurrencyLimit", &error_list);
+    return nullptr;
+  }
+  AdaptiveConcurrencyLimit::Options options;
+  ParseJsonObjectField(*limit_json, "initialLimit", &options.initial_limit,
+                       &error_list, false);
+  ParseJsonObjectField(*limit_json, "minLimit", &options.min_limit,
+                       &error_list, false);
+  ParseJsonObjectField(*limit_json, "maxLimit", &options.max_limit,
+                       &error_list, false);
+  if (options.min_limit == 0 || options.min_limit > options.initial_limit ||
+      options.initial_limit > options.max_limit) {
+    error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "field:concurrencyLimit error:must have 0 < minLimit <= initialLimit "
+        "<= maxLimit"));
+  }
+  if (ParseJsonObjectFieldAsDouble(*limit_json, "smoothing", &options.smoothing,
+                                   &error_list) &&
+      (options.smoothing <= 0 || options.smoothing > 1)) {
+    error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "field:smoothing error:must be in (0, 1]"));
+  }
+  if (ParseJsonObjectFieldAsDouble(*limit_json, "rttTolerance",
+                                   &options.rtt_tolerance, &error_list) &&
+      options.rtt_tolerance < 1) {
+    error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "field:rttTolerance error:must be at least 1"));
+  }
+  ParseJsonObjectField(*limit_json, "reportLoad", &options.report_load,
+                       &error_list, false);
+  *error = GRPC_ERROR_CREATE_FROM_VECTOR("concurrencyLimit", &error_list);
+  if (*error != GRPC_ERROR_NONE) return nullptr;
+  return absl::make_unique<ConcurrencyLimitMethodParsedConfig>(options);
+}
+
+void ConcurrencyLimitServiceConfigParser::Register(
+    CoreConfiguration::Builder* builder) {
+  builder->service_config_parser()->RegisterParser(
+      absl::make_unique<ConcurrencyLimitServiceConfigParser>());
+}
+
+size_t ConcurrencyLimitServiceConfigParser::ParserIndex() {
+  return CoreConfiguration::Get().service_config_parser().GetParserIndex(
+      parser_name());
+}
+
+//
+// ConcurrencyLimitFilter::LimitSet
+//
+
+// The limits of all methods of one server. Connections of the same server
+// find the same set through a global registry keyed by the server's channelz
+// node, or by its resource quota when channelz is disabled.
+class ConcurrencyLimitFilter::LimitSet : public RefCounted<LimitSet> {
+ public:
+  static RefCountedPtr<LimitSet> Get(const ChannelArgs& args);
+
+  ~LimitSet() override;
+
+  // Returns the limit governing calls to \a path, or null if they are not
+  // limited.
+  RefCountedPtr<AdaptiveConcurrencyLimit> ForMethod(const Slice& path);
+
+  // Records a significant change of a method's limit in channelz.
+  void ReportLimit(absl::string_view path, uint32_t limit);
+
+ private:
+  using Key = std::tuple<const void*, std::string, int>;
+
+  static constexpr size_t kMaxMethods = 1024;
+
+  LimitSet(Key key, const ChannelArgs& args);
+
+  const Key key_;
+  RefCountedPtr<channelz::ServerNode> channelz_node_;
+  RefCountedPtr<ResourceQuota> resource_quota_;
+  RefCountedPtr<ServiceConfig> service_config_;
+  absl::optional<AdaptiveConcurrencyLimit::Options> default_options_;
+  Mutex mu_;
+  std::map<std::string, RefCountedPtr<AdaptiveConcurrencyLimit>, std::less<>>
+      limits_ ABSL_GUARDED_BY(mu_);
+  RefCountedPtr<AdaptiveConcurrencyLimit> overflow_limit_ ABSL_GUARDED_BY(mu_);
+};
+
+namespace {
+
+Mutex* g_limit_sets_mu = new Mutex();
+std::map<std::tuple<const void*, std::string, int>,
+         ConcurrencyLimitFilter::LimitSet*>* g_limit_sets =
+    new std::map<std::tuple<const void*, std::string, int>,
+                     ConcurrencyLimitFilter::LimitSet*>();
+
+channelz::ServerNode* GetChannelzServerNode(const ChannelArgs& args) {
+  return args.GetPointer<channelz::ServerNode>(GRPC_ARG_CHANNELZ_SERVER_NODE);
+}
+
+}  // namespace
+
+RefCountedPtr<ConcurrencyLimitFilter::LimitSet>
+ConcurrencyLimitFilter::LimitSet::Get(const ChannelArgs& args) {
+  const void* owner = GetChannelzServerNode(args);
+  if (owner == nullptr) {
+    owner = args.GetPointer<ResourceQuota>(ResourceQuota::ChannelArgName());
+  }
+  Key key(owner,
+          std::string(args.GetString(GRPC_ARG_SERVICE_CONFIG).value_or("")),
+          args.GetInt(GRPC_ARG_SERVER_CONCURRENCY_LIMIT).value_or(0));
+  MutexLock lock(g_limit_sets_mu);
+  auto it = g_limit_sets->find(key);
+  if (it != g_limit_sets->end()) {
+    auto limits = it->second->RefIfNonZero();
+    if (limits != nullptr) return limits;
+  }
+  auto* limits = new LimitSet(key, args);
+  (*g_limit_sets)[std::move(key)] = limits;
+  return RefCountedPtr<LimitSet>(limits);
+}
+
+ConcurrencyLimitFilter::LimitSet::LimitSet(Key key, const ChannelArgs& args)
+    : key_(std::move(key)) {
+  ResourceQuota* resource_quota =
+      args.GetPointer<ResourceQuota>(ResourceQuota::ChannelArgName());
+  if (resource_quota != nullptr) resource_quota_ = resource_quota->Ref();
+  channelz::ServerNode* channelz_node = GetChannelzServerNode(args);
+  if (channelz_node != nullptr) {
+    channelz_node_.reset(
+        static_cast<channelz::ServerNode*>(channelz_node->Ref().release()));
+  }
+  const std::string& service_config_json = std::get<1>(key_);
+  if (!service_config_json.empty()) {
+    const grpc_channel_args* c_args = args.ToC();
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    service_config_ =
+        ServiceConfigImpl::Create(c_args, service_config_json, &error);
+    grpc_channel_args_destroy(c_args);
+    if (error != GRPC_ERROR_NONE) {
+      gpr_log(GPR_ERROR,
+              "Ignoring concurrency limits of invalid service config: %s",
+              grpc_error_std_string(error).c_str());
+      GRPC_ERROR_UNREF(error);
+      service_config_.reset();
+    }
+  }
+  const int default_limit = std::get<2>(key_);
+  if (default_limit > 0) {
+    AdaptiveConcurrencyLimit::Options options;
+    options.initial_limit = default_limit;
+    options.max_limit = std::max(options.max_limit, options.initial_limit);
+    default_options_ = options;
+  }
+}
+
+ConcurrencyLimitFilter::LimitSet::~LimitSet() {
+  MutexLock lock(g_limit_sets_mu);
+  auto it = g_limit_sets->find(key_);
+  if (it != g_limit_sets->end() && it->second == this) g_limit_sets->erase(it);
+}
+
+RefCountedPtr<AdaptiveConcurrencyLimit>
+ConcurrencyLimitFilter::LimitSet::ForMethod(const Slice& path) {
+  {
+    MutexLock lock(&mu_);
+    auto it = limits_.find(path.as_string_view());
+    if (it != limits_.end()) return it->second;
+  }
+  const AdaptiveConcurrencyLimit::Options* options =
+      default_options_.has_value() ? &*default_options_ : nullptr;
+  if (service_config_ != nullptr) {
+    const auto* method_configs =
+        service_config_->GetMethodParsedConfigVector(path.c_slice());
+    if (method_configs != nullptr) {
+      const auto* method_config =
+          static_cast<const ConcurrencyLimitMethodParsedConfig*>(
+              (*method_configs)[ConcurrencyLimitServiceConfigParser::
+                                    ParserIndex()]
+                  .get());
+      if (method_config != nullptr) options = &method_config->options();
+    }
+  }
+  if (options == nullptr) return nullptr;
+  MutexLock lock(&mu_);
+  // Paths come from the client: past a sane number of methods, share one
+  // limit rather than growing the map without bounds.
+  if (limits_.size() >= kMaxMethods) {
+    if (overflow_limit_ == nullptr) {
+      overflow_limit_ = MakeRefCounted<AdaptiveConcurrencyLimit>(*options);
+    }
+    return overflow_limit_;
+  }
+  auto it = limits_.emplace(std::string(path.as_string_view()),
+                            MakeRefCounted<AdaptiveConcurrencyLimit>(*options));
+  return it.first->second;
+}
+
+void ConcurrencyLimitFilter::LimitSet::ReportLimit(absl::string_view path,
+                                                   uint32_t limit) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_concurrency_limit_filter_trace)) {
+    gpr_log(GPR_INFO, "concurrency limit of %s is now %u",
+            std::string(path).c_str(), limit);
+  }
+  if (channelz_node_ == nullptr) return;
+  channelz_node_->AddTraceEvent(
+      channelz::ChannelTrace::Severity::Info,
+      grpc_slice_from_cpp_string(
+          absl::StrCat("Concurrency limit of ", path, " is now ", limit)));
+}
+
+//
+// ConcurrencyLimitFilter
+//
+
+namespace {
+
+// Tracks a call admitted by a limit, releasing it if the call is dropped.
+class CallPermit {
+ public:
+  explicit CallPermit(RefCountedPtr<AdaptiveConcurrencyLimit> limit)
+      : limit_(std::move(limit)), start_(gpr_get_cycle_counter()) {}
+  ~CallPermit() {
+    if (limit_ != nullptr) limit_->Release(absl::nullopt);
+  }
+  CallPermit(const CallPermit&) = delete;
+  CallPermit& operator=(const CallPermit&) = delete;
+  CallPermit(CallPermit&& other) noexcept
+      : limit_(std::move(other.limit_)), start_(other.start_) {}
+  CallPermit& operator=(CallPermit&& other) noexcept {
+    std::swap(limit_, other.limit_);
+    start_ = other.start_;
+    return *this;
+  }
+
+  AdaptiveConcurrencyLimit* limit() const { return limit_.get(); }
+
+  // Releases the call, returning the new limit if it changed significantly.
+  absl::optional<uint32_t> Complete(bool sample_latency) {
+    absl::optional<double> latency_us;
+    if (sample_latency) {
+      latency_us = gpr_timespec_to_micros(
+          gpr_cycle_counter_sub(gpr_get_cycle_counter(), start_));
+    }
+    auto limit = std::move(limit_);
+    return limit->Release(latency_us);
+  }
+
+ private:
+  RefCountedPtr<AdaptiveConcurrencyLimit> limit_;
+  gpr_cycle_counter start_;
+};
+
+// Reports how close a method is to its limit in an ORCA load report, unless
+// the application already attached one.
+void MaybeAddLoadReport(const AdaptiveConcurrencyLimit& limit,
+                        uint32_t in_flight, ServerMetadata* md) {
+  if (!limit.options().report_load ||
+      md->get_pointer(XEndpointLoadMetricsBinMetadata()) != nullptr) {
+    return;
+  }
+  upb::Arena arena;
+  xds_data_orca_v3_OrcaLoadReport* report =
+      xds_data_orca_v3_OrcaLoadReport_new(arena.ptr());
+  xds_data_orca_v3_OrcaLoadReport_utilization_set(
+      report, upb_StringView_FromString("grpc.concurrency_limit"),
+      static_cast<double>(in_flight) / std::max(limit.limit(), 1u),
+      arena.ptr());
+  size_t length;
+  char* serialized =
+      xds_data_orca_v3_OrcaLoadReport_serialize(report, arena.ptr(), &length);
+  if (serialized == nullptr) return;
+  md->Set(XEndpointLoadMetricsBinMetadata(),
+          Slice::FromCopiedBuffer(serialized, length));
+}
+
+}  // namespace
+
+absl::StatusOr<ConcurrencyLimitFilter> ConcurrencyLimitFilter::Create(
+    ChannelArgs args, ChannelFilter::Args) {
+  return ConcurrencyLimitFilter(LimitSet::Get(args));
+}
+
+ConcurrencyLimitFilter::ConcurrencyLimitFilter(RefCountedPtr<LimitSet> limits)
+    : limits_(std::move(limits)) {}
+
+ArenaPromise<ServerMetadataHandle> ConcurrencyLimitFilter::MakeCallPromise(
+    CallArgs call_args, NextPromiseFactory next_promise_factory) {
+  const Slice* path =
+      call_args.client_initial_metadata->get_pointer(HttpPathMetadata());
+  RefCountedPtr<AdaptiveConcurrencyLimit> limit;
+  if (path != nullptr) limit = limits_->ForMethod(*path);
+  if (limit == nullptr) return next_promise_factory(std::move(call_args));
+  // Reject before the call goes any further down the stack, and in
+  // particular before it is matched with a request from the application.
+  if (!limit->TryAcquire()) {
+    auto md = ServerMetadataHandle(
+        absl::ResourceExhaustedError("Server concurrency limit reached"));
+    MaybeAddLoadReport(*limit, limit->in_flight(), md.get());
+    return Immediate(std::move(md));
+  }
+  return Seq(
+      next_promise_factory(std::move(call_args)),
+      Capture(
+          [this](Slice* path, CallPermit* permit, ServerMetadataHandle md) {
+            MaybeAddLoadReport(*permit->limit(), permit->limit()->in_flight(),
+                               md.get());
+            // Calls the application sheds itself are not a latency sample.
+            grpc_status_code status =
+                md->get(GrpcStatusMetadata()).value_or(GRPC_STATUS_UNKNOWN);
+            absl::optional<uint32_t> new_limit =
+                permit->Complete(status != GRPC_STATUS_RESOURCE_EXHAUSTED &&
+                                 status != GRPC_STATUS_UNAVAILABLE);
+            if (new_limit.has_value()) {
+              limits_->ReportLimit(path->as_string_view(), *new_limit);
+            }
+            return md;
+          },
+          path->Ref(), CallPermit(std::move(limit))));
+}
+
+const grpc_channel_filter ConcurrencyLimitFilter::kFilter =
+    MakePromiseBasedFilter<ConcurrencyLimitFilter, FilterEndpoint::kServer>(
+        "concurrency_limit");
+
+void RegisterConcurrencyLimitFilter(CoreConfiguration::Builder* builder) {
+  ConcurrencyLimitServiceConfigParser::Register(builder);
+  // Just below the server's top filter, so that rejected calls skip the
+  // rest of the stack.
+  builder->channel_init()->RegisterStage(
+      GRPC_SERVER_CHANNEL, INT_MAX - 1, [](ChannelStackBuilder* builder) {
+        auto channel_args = builder->channel_args();
+        if (channel_args.WantMinimalStack()) return true;
+        if (channel_args.GetInt(GRPC_ARG_SERVER_CONCURRENCY_LIMIT)
+                    .value_or(0) > 0 ||
+            absl::StrContains(
+                channel_args.GetString(GRPC_ARG_SERVICE_CONFIG).value_or(""),
+                "\"concurrencyLimit\"")) {
+          builder->PrependFilter(&ConcurrencyLimitFilter::kFilter);
+        }
+        return true;
+      });
+}
+
+}  // namespace grpc_core
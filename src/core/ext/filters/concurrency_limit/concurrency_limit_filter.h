@@ -0,0 +1,143 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_FILTERS_CONCURRENCY_LIMIT_CONCURRENCY_LIMIT_FILTER_H
+#define GRPC_CORE_EXT_FILTERS_CONCURRENCY_LIMIT_CONCURRENCY_LIMIT_FILTER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include "absl/types/optional.h"
+
+#include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/channel/promise_based_filter.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/service_config/service_config_parser.h"
+
+namespace grpc_core {
+
+// Adaptive limit on the number of concurrent calls to one method, following
+// the Gradient2 algorithm: the limit grows by about sqrt(limit) per sample
+// while the short term latency stays within a tolerance of the long term
+// average, and shrinks proportionally once queueing makes calls slower.
+class AdaptiveConcurrencyLimit : public RefCounted<AdaptiveConcurrencyLimit> {
+ public:
+  struct Options {
+    uint32_t initial_limit = 100;
+    uint32_t min_limit = 1;
+    uint32_t max_limit = 10000;
+    // Weight of each new estimate in the limit.
+    double smoothing = 0.2;
+    // Ratio by which the short term latency may exceed the long term average
+    // before the limit starts shrinking.
+    double rtt_tolerance = 1.5;
+    // Whether to attach an ORCA load report to the trailing metadata.
+    bool report_load = false;
+  };
+
+  explicit AdaptiveConcurrencyLimit(const Options& options);
+
+  // Admits a call unless limit() calls are already in flight.
+  bool TryAcquire();
+  // Ends a call admitted by TryAcquire(). Only calls that ran to completion
+  // pass their latency, cancelled calls say nothing about the method's
+  // capacity. Returns the new limit if it moved by more than a fifth since it
+  // was last returned.
+  absl::optional<uint32_t> Release(absl::optional<double> latency_us);
+
+  uint32_t limit() const { return limit_.load(std::memory_order_relaxed); }
+  uint32_t in_flight() const {
+    return in_flight_.load(std::memory_order_relaxed);
+  }
+  const Options& options() const { return options_; }
+
+ private:
+  absl::optional<uint32_t> Update(double latency_us, uint32_t in_flight)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  const Options options_;
+  std::atomic<uint32_t> limit_;
+  std::atomic<uint32_t> in_flight_{0};
+  // Samples arriving while another thread updates the estimate are dropped.
+  Mutex mu_;
+  double estimated_limit_ ABSL_GUARDED_BY(mu_);
+  double short_rtt_us_ ABSL_GUARDED_BY(mu_) = 0;
+  double long_rtt_us_ ABSL_GUARDED_BY(mu_) = 0;
+  uint64_t num_samples_ ABSL_GUARDED_BY(mu_) = 0;
+  uint32_t reported_limit_ ABSL_GUARDED_BY(mu_);
+};
+
+class ConcurrencyLimitMethodParsedConfig
+    : public ServiceConfigParser::ParsedConfig {
+ public:
+  explicit ConcurrencyLimitMethodParsedConfig(
+      const AdaptiveConcurrencyLimit::Options& options)
+      : options_(options) {}
+
+  const AdaptiveConcurrencyLimit::Options& options() const { return options_; }
+
+ private:
+  AdaptiveConcurrencyLimit::Options options_;
+};
+
+class ConcurrencyLimitServiceConfigParser final
+    : public ServiceConfigParser::Parser {
+ public:
+  absl::string_view name() const override { return parser_name(); }
+  // Parses the "concurrencyLimit" field of a method config.
+  std::unique_ptr<ServiceConfigParser::ParsedConfig> ParsePerMethodParams(
+      const grpc_channel_args* args, const Json& json,
+      grpc_error_handle* error) override;
+  static size_t ParserIndex();
+  static void Register(CoreConfiguration::Builder* builder);
+
+ private:
+  static absl::string_view parser_name() { return "concurrency_limit"; }
+};
+
+// Server filter rejecting calls with RESOURCE_EXHAUSTED while their method
+// is at its concurrency limit. Enabled by GRPC_ARG_SERVER_CONCURRENCY_LIMIT
+// or by a service config passed to the server. Limits are shared by all
+// connections of a server.
+class ConcurrencyLimitFilter : public ChannelFilter {
+ public:
+  static const grpc_channel_filter kFilter;
+
+  static absl::StatusOr<ConcurrencyLimitFilter> Create(
+      ChannelArgs args, ChannelFilter::Args filter_args);
+
+  // Construct a promise for one call.
+  ArenaPromise<ServerMetadataHandle> MakeCallPromise(
+      CallArgs call_args, NextPromiseFactory next_promise_factory) override;
+
+  class LimitSet;
+
+ private:
+  explicit ConcurrencyLimitFilter(RefCountedPtr<LimitSet> limits);
+
+  RefCountedPtr<LimitSet> limits_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CONCURRENCY_LIMIT_CONCURRENCY_LIMIT_FILTER_H
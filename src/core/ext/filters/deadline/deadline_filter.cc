@@ -18,9 +18,12 @@
 
 #include "src/core/ext/filters/deadline/deadline_filter.h"
 
+#include <limits.h>
 #include <stdbool.h>
 #include <string.h>
 
+#include <map>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
@@ -28,25 +31,126 @@
 
 #include "src/core/lib/channel/channel_stack_builder.h"
 #include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/slice/slice_internal.h"
 
 namespace grpc_core {
 
+constexpr size_t DeadlineWheel::kNumShards;
+
+DeadlineWheel* DeadlineWheel::Get() {
+  static DeadlineWheel* wheel = new DeadlineWheel();
+  return wheel;
+}
+
+// The calls sharing one timer. Buckets whose calls were all cancelled are
+// kept until their timer fires.
+class DeadlineWheel::Bucket {
+ public:
+  Bucket(Shard* shard, Timestamp deadline)
+      : shard_(shard), deadline_(deadline) {
+    GRPC_CLOSURE_INIT(&on_timer_, OnTimer, this, nullptr);
+    grpc_timer_init(&timer_, deadline, &on_timer_);
+  }
+
+  Entry* head = nullptr;
+
+ private:
+  // The timer of a bucket is never cancelled, so error is only set if the
+  // timer list is shut down. Calls see it as they would from their own
+  // timer.
+  static void OnTimer(void* arg, grpc_error_handle error) {
+    Bucket* self = static_cast<Bucket*>(arg);
+    {
+      MutexLock lock(&self->shard_->mu);
+      self->shard_->buckets.erase(self->deadline_);
+      for (Entry* entry = self->head; entry != nullptr; entry = entry->next) {
+        entry->bucket = nullptr;
+        ExecCtx::Run(DEBUG_LOCATION, entry->on_done, GRPC_ERROR_REF(error));
+      }
+    }
+    delete self;
+  }
+
+  Shard* const shard_;
+  const Timestamp deadline_;
+  grpc_timer timer_;
+  grpc_closure on_timer_;
+};
+
+void DeadlineWheel::Add(Entry* entry, Timestamp deadline,
+                        Duration granularity, grpc_closure* on_done) {
+  const int64_t millis = deadline.milliseconds_after_process_epoch();
+  const int64_t granularity_millis = granularity.millis();
+  // Round up, so that deadlines are never enforced early.
+  if (millis < INT64_MAX - granularity_millis) {
+    deadline = Timestamp::FromMillisecondsAfterProcessEpoch(
+        (millis + granularity_millis - 1) / granularity_millis *
+        granularity_millis);
+  }
+  entry->on_done = on_done;
+  Shard* shard = ShardFor(entry);
+  MutexLock lock(&shard->mu);
+  Bucket*& bucket = shard->buckets[deadline];
+  if (bucket == nullptr) bucket = new Bucket(shard, deadline);
+  entry->bucket = bucket;
+  entry->prev = nullptr;
+  entry->next = bucket->head;
+  if (bucket->head != nullptr) bucket->head->prev = entry;
+  bucket->head = entry;
+}
+
+void DeadlineWheel::Cancel(Entry* entry) {
+  Shard* shard = ShardFor(entry);
+  {
+    MutexLock lock(&shard->mu);
+    Bucket* bucket = entry->bucket;
+    // Already expired: on_done has been scheduled.
+    if (bucket == nullptr) return;
+    if (entry->prev != nullptr) {
+      entry->prev->next = entry->next;
+    } else {
+      bucket->head = entry->next;
+    }
+    if (entry->next != nullptr) entry->next->prev = entry->prev;
+    entry->bucket = nullptr;
+  }
+  ExecCtx::Run(DEBUG_LOCATION, entry->on_done, GRPC_ERROR_CANCELLED);
+}
+
+DeadlineWheel::Shard* DeadlineWheel::ShardFor(Entry* entry) {
+  return &shards_[HashPointer(entry, kNumShards)];
+}
+
 // A fire-and-forget class representing a pending deadline timer.
 // Allocated on the call arena.
 class TimerState {
  public:
-  TimerState(grpc_call_element* elem, Timestamp deadline) : elem_(elem) {
+  TimerState(grpc_call_element* elem, Timestamp deadline,
+             Duration granularity)
+      : elem_(elem), coarse_(granularity > Duration::Zero()) {
     grpc_deadline_state* deadline_state =
         static_cast<grpc_deadline_state*>(elem_->call_data);
     GRPC_CALL_STACK_REF(deadline_state->call_stack, "DeadlineTimerState");
     GRPC_CLOSURE_INIT(&closure_, TimerCallback, this, nullptr);
-    grpc_timer_init(&timer_, deadline, &closure_);
+    if (coarse_) {
+      DeadlineWheel::Get()->Add(&wheel_entry_, deadline, granularity,
+                                &closure_);
+    } else {
+      grpc_timer_init(&timer_, deadline, &closure_);
+    }
   }
 
-  void Cancel() { grpc_timer_cancel(&timer_); }
+  void Cancel() {
+    if (coarse_) {
+      DeadlineWheel::Get()->Cancel(&wheel_entry_);
+    } else {
+      grpc_timer_cancel(&timer_);
+    }
+  }
 
  private:
   // The on_complete callback used when sending a cancel_error batch down the
@@ -77,9 +181,7 @@ class TimerState {
     grpc_deadline_state* deadline_state =
         static_cast<grpc_deadline_state*>(self->elem_->call_data);
     if (error != GRPC_ERROR_CANCELLED) {
-      error = grpc_error_set_int(
-          GRPC_ERROR_CREATE_FROM_STATIC_STRING("Deadline Exceeded"),
-          GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_DEADLINE_EXCEEDED);
+      error = GRPC_ERROR_DEADLINE_EXCEEDED();
       deadline_state->call_combiner->Cancel(GRPC_ERROR_REF(error));
       GRPC_CLOSURE_INIT(&self->closure_, SendCancelOpInCallCombiner, self,
                         nullptr);
@@ -99,7 +201,9 @@ class TimerState {
   // finishes and (b) the filter sees the call completion and attempts
   // to cancel the timer.
   grpc_call_element* elem_;
+  const bool coarse_;
   grpc_timer timer_;
+  DeadlineWheel::Entry wheel_entry_;
   grpc_closure closure_;
 };
 
@@ -119,7 +223,8 @@ static void start_timer_if_needed(grpc_call_element* elem,
       static_cast<grpc_deadline_state*>(elem->call_data);
   GPR_ASSERT(deadline_state->timer_state == nullptr);
   deadline_state->timer_state =
-      deadline_state->arena->New<grpc_core::TimerState>(elem, deadline);
+      deadline_state->arena->New<grpc_core::TimerState>(
+          elem, deadline, deadline_state->timer_granularity);
 }
 
 // Cancels the deadline timer.
@@ -186,12 +291,13 @@ static void start_timer_after_init(void* arg, grpc_error_handle error) {
                           "done scheduling deadline timer");
 }
 
-grpc_deadline_state::grpc_deadline_state(grpc_call_element* elem,
-                                         const grpc_call_element_args& args,
-                                         grpc_core::Timestamp deadline)
+grpc_deadline_state::grpc_deadline_state(
+    grpc_call_element* elem, const grpc_call_element_args& args,
+    grpc_core::Timestamp deadline, grpc_core::Duration timer_granularity)
     : call_stack(args.call_stack),
       call_combiner(args.call_combiner),
-      arena(args.arena) {
+      arena(args.arena),
+      timer_granularity(timer_granularity) {
   // Deadline will always be infinite on servers, so the timer will only be
   // set on clients with a finite deadline.
   if (deadline != grpc_core::Timestamp::InfFuture()) {
@@ -239,10 +345,18 @@ void grpc_deadline_state_client_start_transport_stream_op_batch(
 // filter code
 //
 
+// Channel data used for both client and server filter.
+typedef struct channel_data {
+  grpc_core::Duration timer_granularity;
+} channel_data;
+
 // Constructor for channel_data.  Used for both client and server filters.
 static grpc_error_handle deadline_init_channel_elem(
-    grpc_channel_element* /*elem*/, grpc_channel_element_args* args) {
+    grpc_channel_element* elem, grpc_channel_element_args* args) {
   GPR_ASSERT(!args->is_last);
+  channel_data* chand = static_cast<channel_data*>(elem->channel_data);
+  chand->timer_granularity =
+      grpc_deadline_timer_granularity(args->channel_args);
   return GRPC_ERROR_NONE;
 }
 
@@ -269,7 +383,9 @@ typedef struct server_call_data {
 // Constructor for call_data.  Used for both client and server filters.
 static grpc_error_handle deadline_init_call_elem(
     grpc_call_element* elem, const grpc_call_element_args* args) {
-  new (elem->call_data) grpc_deadline_state(elem, *args, args->deadline);
+  channel_data* chand = static_cast<channel_data*>(elem->channel_data);
+  new (elem->call_data) grpc_deadline_state(elem, *args, args->deadline,
+                                            chand->timer_granularity);
   return GRPC_ERROR_NONE;
 }
 
@@ -345,7 +461,7 @@ const grpc_channel_filter grpc_client_deadline_filter = {
     deadline_init_call_elem,
     grpc_call_stack_ignore_set_pollset_or_pollset_set,
     deadline_destroy_call_elem,
-    0,  // sizeof(channel_data)
+    sizeof(channel_data),
     deadline_init_channel_elem,
     grpc_channel_stack_no_post_init,
     deadline_destroy_channel_elem,
@@ -361,7 +477,7 @@ const grpc_channel_filter grpc_server_deadline_filter = {
     deadline_init_call_elem,
     grpc_call_stack_ignore_set_pollset_or_pollset_set,
     deadline_destroy_call_elem,
-    0,  // sizeof(channel_data)
+    sizeof(channel_data),
     deadline_init_channel_elem,
     grpc_channel_stack_no_post_init,
     deadline_destroy_channel_elem,
@@ -375,6 +491,13 @@ bool grpc_deadline_checking_enabled(const grpc_channel_args* channel_args) {
       !grpc_channel_args_want_minimal_stack(channel_args));
 }
 
+grpc_core::Duration grpc_deadline_timer_granularity(
+    const grpc_channel_args* channel_args) {
+  return grpc_core::Duration::Milliseconds(grpc_channel_args_find_integer(
+      channel_args, GRPC_ARG_DEADLINE_TIMER_GRANULARITY_MS,
+      {0, 0, INT_MAX}));
+}
+
 namespace grpc_core {
 void RegisterDeadlineFilter(CoreConfiguration::Builder* builder) {
   auto register_filter = [builder](grpc_channel_stack_type type,
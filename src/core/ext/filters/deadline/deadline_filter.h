@@ -19,25 +19,84 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <map>
+
 #include "src/core/lib/channel/channel_stack.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/closure.h"
 #include "src/core/lib/iomgr/timer.h"
 
+// Channel arg (integer, in milliseconds). When positive, call deadlines are
+// enforced by one timer shared by all calls whose deadlines fall in the same
+// interval of this length, instead of a timer per call. Deadlines are then
+// enforced up to this much late. Defaults to 0 (a timer per call).
+#define GRPC_ARG_DEADLINE_TIMER_GRANULARITY_MS \
+  "grpc.experimental.deadline_timer_granularity_ms"
+
 namespace grpc_core {
+
 class TimerState;
+
+// Enforces coarse-grained deadlines with one timer per bucket of calls whose
+// deadlines round up to the same multiple of the granularity. Nearly all
+// calls complete before their deadline, so this replaces a timer insertion
+// and cancellation per call with a list insertion and removal.
+class DeadlineWheel {
+ private:
+  class Bucket;
+
+ public:
+  // A call waiting in the wheel. Owned by the caller, and must stay alive
+  // until on_done runs.
+  struct Entry {
+    grpc_closure* on_done = nullptr;
+    Bucket* bucket = nullptr;
+    Entry* prev = nullptr;
+    Entry* next = nullptr;
+  };
+
+  static DeadlineWheel* Get();
+
+  // Runs on_done exactly once, like grpc_timer: with GRPC_ERROR_NONE once
+  // the deadline (rounded up to granularity) has passed, with
+  // GRPC_ERROR_CANCELLED if Cancel() is called first, or with the error of
+  // the timer list if it is shut down first.
+  void Add(Entry* entry, Timestamp deadline, Duration granularity,
+           grpc_closure* on_done);
+
+  void Cancel(Entry* entry);
+
+ private:
+  static constexpr size_t kNumShards = 16;
+
+  struct Shard {
+    Mutex mu;
+    std::map<Timestamp, Bucket*> buckets ABSL_GUARDED_BY(mu);
+  };
+
+  Shard* ShardFor(Entry* entry);
+
+  Shard shards_[kNumShards];
+};
+
 }  // namespace grpc_core
 
 // State used for filters that enforce call deadlines.
 // Must be the first field in the filter's call_data.
 struct grpc_deadline_state {
-  grpc_deadline_state(grpc_call_element* elem,
-                      const grpc_call_element_args& args,
-                      grpc_core::Timestamp deadline);
+  grpc_deadline_state(
+      grpc_call_element* elem, const grpc_call_element_args& args,
+      grpc_core::Timestamp deadline,
+      grpc_core::Duration timer_granularity = grpc_core::Duration::Zero());
   ~grpc_deadline_state();
 
   // We take a reference to the call stack for the timer callback.
   grpc_call_stack* call_stack;
   grpc_core::CallCombiner* call_combiner;
   grpc_core::Arena* arena;
+  // See GRPC_ARG_DEADLINE_TIMER_GRANULARITY_MS.
+  grpc_core::Duration timer_granularity;
   grpc_core::TimerState* timer_state = nullptr;
   // Closure to invoke when we receive trailing metadata.
   // We use this to cancel the timer.
@@ -78,6 +137,10 @@ void grpc_deadline_state_client_start_transport_stream_op_batch(
 // Should deadline checking be performed (according to channel args)
 bool grpc_deadline_checking_enabled(const grpc_channel_args* args);
 
+// The granularity of deadline timers (according to channel args)
+grpc_core::Duration grpc_deadline_timer_granularity(
+    const grpc_channel_args* args);
+
 // Deadline filters for direct client channels and server channels.
 // Note: Deadlines for non-direct client channels are handled by the
 // client_channel filter.
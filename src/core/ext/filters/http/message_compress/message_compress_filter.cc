@@ -21,8 +21,17 @@
 #include "src/core/ext/filters/http/message_compress/message_compress_filter.h"
 
 #include <assert.h>
+#include <limits.h>
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
 #include <grpc/compression.h>
@@ -34,14 +43,167 @@
 #include "src/core/lib/compression/compression_internal.h"
 #include "src/core/lib/compression/message_compress.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/surface/call.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_compression_cpu_budget_ms, 0,
+    "Milliseconds of CPU time per second that adaptive message compression may "
+    "spend across the process. Messages that would exceed the budget are sent "
+    "uncompressed. 0 means unlimited.");
+
 namespace {
 
+// Process-wide token bucket of time spent in adaptive compression. It holds
+// at most one second's worth of budget, and goes into debt by the cost of
+// the messages that were already being compressed when it ran out.
+class CompressionCpuBudget {
+ public:
+  // Returns nullptr if the budget is unlimited.
+  static CompressionCpuBudget* Get() {
+    static CompressionCpuBudget* budget = []() -> CompressionCpuBudget* {
+      int32_t budget_ms = GPR_GLOBAL_CONFIG_GET(grpc_compression_cpu_budget_ms);
+      if (budget_ms <= 0) return nullptr;
+      return new CompressionCpuBudget(int64_t{std::min(budget_ms, 1000)} *
+                                      GPR_NS_PER_MS);
+    }();
+    return budget;
+  }
+
+  bool HasBudget() {
+    int64_t now_ns = NowNanos();
+    int64_t last_refill_ns = last_refill_ns_.load(std::memory_order_relaxed);
+    if (now_ns - last_refill_ns >= kRefillIntervalNs &&
+        last_refill_ns_.compare_exchange_strong(last_refill_ns, now_ns,
+                                                std::memory_order_relaxed)) {
+      int64_t refill_ns =
+          std::min<int64_t>(now_ns - last_refill_ns, GPR_NS_PER_SEC) *
+          ns_per_second_ / GPR_NS_PER_SEC;
+      int64_t available_ns = available_ns_.load(std::memory_order_relaxed);
+      while (!available_ns_.compare_exchange_weak(
+          available_ns, std::min(available_ns + refill_ns, ns_per_second_),
+          std::memory_order_relaxed)) {
+      }
+    }
+    return available_ns_.load(std::memory_order_relaxed) > 0;
+  }
+
+  void Charge(int64_t ns) {
+    available_ns_.fetch_sub(ns, std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr int64_t kRefillIntervalNs = GPR_NS_PER_MS;
+
+  explicit CompressionCpuBudget(int64_t ns_per_second)
+      : ns_per_second_(ns_per_second),
+        start_(gpr_get_cycle_counter()),
+        available_ns_(ns_per_second) {}
+
+  int64_t NowNanos() const {
+    gpr_timespec elapsed =
+        gpr_cycle_counter_sub(gpr_get_cycle_counter(), start_);
+    return elapsed.tv_sec * GPR_NS_PER_SEC + elapsed.tv_nsec;
+  }
+
+  const int64_t ns_per_second_;
+  const gpr_cycle_counter start_;
+  std::atomic<int64_t> available_ns_;
+  std::atomic<int64_t> last_refill_ns_{0};
+};
+
+// Adaptive compression state of a channel: the compression ratios achieved
+// by each method, from which it decides whether that method's messages are
+// worth compressing.
+class AdaptiveCompression {
+ public:
+  struct MethodStats {
+    // Moving average of compressed over uncompressed size.
+    double ratio = 0;
+    uint32_t samples = 0;
+    // Messages left to send uncompressed, and how many to skip the next
+    // time the ratio is poor.
+    uint32_t skip_messages = 0;
+    uint32_t backoff_messages = kInitialBackoffMessages;
+  };
+
+  explicit AdaptiveCompression(size_t min_message_size)
+      : min_message_size_(min_message_size) {}
+
+  // Returns nullptr once too many methods are tracked; their messages are
+  // then only subject to the size threshold and the CPU budget.
+  MethodStats* GetMethodStats(absl::string_view method) {
+    grpc_core::MutexLock lock(&mu_);
+    auto it = methods_.find(method);
+    if (it != methods_.end()) return &it->second;
+    if (methods_.size() >= kMaxMethods) return nullptr;
+    return &methods_[std::string(method)];
+  }
+
+  bool ShouldCompress(MethodStats* stats, size_t message_size) {
+    if (message_size < min_message_size_) return false;
+    if (stats != nullptr) {
+      grpc_core::MutexLock lock(&mu_);
+      if (stats->skip_messages > 0) {
+        --stats->skip_messages;
+        return false;
+      }
+    }
+    CompressionCpuBudget* budget = CompressionCpuBudget::Get();
+    return budget == nullptr || budget->HasBudget();
+  }
+
+  void RecordCompression(MethodStats* stats, size_t before_size,
+                         size_t after_size, int64_t elapsed_ns) {
+    CompressionCpuBudget* budget = CompressionCpuBudget::Get();
+    if (budget != nullptr) budget->Charge(elapsed_ns);
+    if (stats == nullptr) return;
+    double ratio =
+        static_cast<double>(after_size) / static_cast<double>(before_size);
+    grpc_core::MutexLock lock(&mu_);
+    stats->ratio = stats->samples == 0
+                       ? ratio
+                       : kRatioWeight * ratio +
+                             (1 - kRatioWeight) * stats->ratio;
+    ++stats->samples;
+    if (stats->ratio <= kPoorRatio) {
+      stats->backoff_messages = kInitialBackoffMessages;
+      return;
+    }
+    if (stats->samples < kMinSamples) return;
+    // The method's messages keep compressing poorly: send the next ones
+    // uncompressed, then try again, backing off further each time.
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_compression_trace)) {
+      gpr_log(GPR_INFO,
+              "Compression ratio %.2f is poor: skipping the next %u messages",
+              stats->ratio, stats->backoff_messages);
+    }
+    stats->skip_messages = stats->backoff_messages;
+    stats->backoff_messages =
+        std::min(stats->backoff_messages * 2, uint32_t{kMaxBackoffMessages});
+  }
+
+ private:
+  static constexpr size_t kMaxMethods = 1024;
+  static constexpr double kRatioWeight = 0.25;
+  static constexpr double kPoorRatio = 0.9;
+  static constexpr uint32_t kMinSamples = 4;
+  static constexpr uint32_t kInitialBackoffMessages = 8;
+  static constexpr uint32_t kMaxBackoffMessages = 1024;
+
+  const size_t min_message_size_;
+  grpc_core::Mutex mu_;
+  // The stats themselves are also guarded by mu_.
+  std::map<std::string, MethodStats, std::less<>> methods_
+      ABSL_GUARDED_BY(mu_);
+};
+
 class ChannelData {
  public:
   explicit ChannelData(grpc_channel_element_args* args) {
@@ -65,6 +227,16 @@ class ChannelData {
               name);
       default_compression_algorithm_ = GRPC_COMPRESS_NONE;
     }
+    zstd_dictionaries_ = grpc_core::ZstdCompressionDictionaries::
+        GetFromChannelArgs(args->channel_args);
+    if (grpc_channel_args_find_bool(args->channel_args,
+                                    GRPC_COMPRESSION_CHANNEL_ADAPTIVE, false)) {
+      adaptive_compression_ = absl::make_unique<AdaptiveCompression>(
+          grpc_channel_args_find_integer(
+              args->channel_args,
+              GRPC_COMPRESSION_CHANNEL_ADAPTIVE_MIN_MESSAGE_SIZE,
+              {kDefaultAdaptiveMinMessageSize, 0, INT_MAX}));
+    }
     GPR_ASSERT(!args->is_last);
   }
 
@@ -76,11 +248,27 @@ class ChannelData {
     return enabled_compression_algorithms_;
   }
 
+  const grpc_core::RefCountedPtr<grpc_core::ZstdCompressionDictionaries>&
+  zstd_dictionaries() const {
+    return zstd_dictionaries_;
+  }
+
+  AdaptiveCompression* adaptive_compression() const {
+    return adaptive_compression_.get();
+  }
+
  private:
+  static constexpr int kDefaultAdaptiveMinMessageSize = 256;
+
   /** The default, channel-level, compression algorithm */
   grpc_compression_algorithm default_compression_algorithm_;
   /** Enabled compression algorithms */
   grpc_core::CompressionAlgorithmSet enabled_compression_algorithms_;
+  /** zstd dictionaries, null if none */
+  grpc_core::RefCountedPtr<grpc_core::ZstdCompressionDictionaries>
+      zstd_dictionaries_;
+  /** Adaptive compression state, null unless enabled */
+  std::unique_ptr<AdaptiveCompression> adaptive_compression_;
 };
 
 class CallData {
@@ -96,6 +284,24 @@ class CallData {
     }
     GRPC_CLOSURE_INIT(&start_send_message_batch_in_call_combiner_,
                       StartSendMessageBatch, elem, grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&on_recv_initial_metadata_ready_,
+                      OnRecvInitialMetadataReady, elem,
+                      grpc_schedule_on_exec_ctx);
+    if (channeld->zstd_dictionaries() != nullptr) {
+      compression_context_.set_zstd_dictionaries(
+          channeld->zstd_dictionaries());
+      // Until the peer says which dictionaries it has, assume it has all of
+      // ours. Servers always hear from the client first.
+      zstd_dictionary_id_.store(channeld->zstd_dictionaries()->highest_id(),
+                                std::memory_order_relaxed);
+    }
+    // Servers only learn the method from the client's initial metadata.
+    if (channeld->adaptive_compression() != nullptr &&
+        !GRPC_SLICE_IS_EMPTY(args.path)) {
+      method_stats_.store(channeld->adaptive_compression()->GetMethodStats(
+                              grpc_core::StringViewFromSlice(args.path)),
+                          std::memory_order_relaxed);
+    }
   }
 
   ~CallData() {
@@ -109,11 +315,13 @@ class CallData {
       grpc_call_element* elem, grpc_transport_stream_op_batch* batch);
 
  private:
-  bool SkipMessageCompression();
+  bool SkipMessageCompression(grpc_call_element* elem);
   void InitializeState(grpc_call_element* elem);
 
   void ProcessSendInitialMetadata(grpc_call_element* elem,
                                   grpc_metadata_batch* initial_metadata);
+  static void OnRecvInitialMetadataReady(void* elem_arg,
+                                         grpc_error_handle error);
 
   // Methods for processing a send_message batch
   static void StartSendMessageBatch(void* elem_arg, grpc_error_handle unused);
@@ -135,6 +343,15 @@ class CallData {
   /* Set to true, if the fields below are initialized. */
   bool state_initialized_ = false;
   grpc_closure start_send_message_batch_in_call_combiner_;
+  // The zstd dictionary to compress with, chosen from the peer's initial
+  // metadata, which may arrive while a message is being compressed.
+  std::atomic<uint32_t> zstd_dictionary_id_{0};
+  // The method's adaptive compression stats, set from the client's initial
+  // metadata on servers.
+  std::atomic<AdaptiveCompression::MethodStats*> method_stats_{nullptr};
+  grpc_metadata_batch* recv_initial_metadata_ = nullptr;
+  grpc_closure on_recv_initial_metadata_ready_;
+  grpc_closure* original_recv_initial_metadata_ready_ = nullptr;
   /* The fields below are only initialized when we compress the payload.
    * Keep them at the bottom of the struct, so they don't pollute the
    * cache-lines. */
@@ -146,10 +363,12 @@ class CallData {
   grpc_closure* original_send_message_on_complete_ = nullptr;
   grpc_closure send_message_on_complete_;
   grpc_closure on_send_message_next_done_;
+  // Reused by the messages of the call.
+  grpc_core::MessageCompressionContext compression_context_;
 };
 
 // Returns true if we should skip message compression for the current message.
-bool CallData::SkipMessageCompression() {
+bool CallData::SkipMessageCompression(grpc_call_element* elem) {
   // If the flags of this message indicate that it shouldn't be compressed, we
   // skip message compression.
   uint32_t flags =
@@ -159,7 +378,15 @@ bool CallData::SkipMessageCompression() {
   }
   // If this call doesn't have any message compression algorithm set, skip
   // message compression.
-  return compression_algorithm_ == GRPC_COMPRESS_NONE;
+  if (compression_algorithm_ == GRPC_COMPRESS_NONE) return true;
+  // In adaptive mode, skip messages that are not worth the CPU.
+  AdaptiveCompression* adaptive_compression =
+      static_cast<ChannelData*>(elem->channel_data)->adaptive_compression();
+  return adaptive_compression != nullptr &&
+         !adaptive_compression->ShouldCompress(
+             method_stats_.load(std::memory_order_acquire),
+             send_message_batch_->payload->send_message.send_message
+                 ->length());
 }
 
 void CallData::InitializeState(grpc_call_element* elem) {
@@ -184,6 +411,14 @@ void CallData::ProcessSendInitialMetadata(
       break;
     case GRPC_COMPRESS_DEFLATE:
     case GRPC_COMPRESS_GZIP:
+    case GRPC_COMPRESS_ZSTD:
+      if (!grpc_core::IsCompressionAlgorithmSupported(
+              compression_algorithm_)) {
+        // Send uncompressed rather than claim an encoding this build cannot
+        // produce.
+        compression_algorithm_ = GRPC_COMPRESS_NONE;
+        break;
+      }
       InitializeState(elem);
       initial_metadata->Set(grpc_core::GrpcEncodingMetadata(),
                             compression_algorithm_);
@@ -194,6 +429,46 @@ void CallData::ProcessSendInitialMetadata(
   // Convey supported compression algorithms.
   initial_metadata->Set(grpc_core::GrpcAcceptEncodingMetadata(),
                         channeld->enabled_compression_algorithms());
+  // And zstd dictionaries.
+  if (channeld->zstd_dictionaries() != nullptr) {
+    initial_metadata->Append(
+        grpc_core::ZstdCompressionDictionaries::MetadataKey(),
+        grpc_core::Slice::FromCopiedString(
+            channeld->zstd_dictionaries()->advertisement()),
+        [](absl::string_view, const grpc_core::Slice&) { abort(); });
+  }
+}
+
+void CallData::OnRecvInitialMetadataReady(void* elem_arg,
+                                          grpc_error_handle error) {
+  grpc_call_element* elem = static_cast<grpc_call_element*>(elem_arg);
+  CallData* calld = static_cast<CallData*>(elem->call_data);
+  ChannelData* channeld = static_cast<ChannelData*>(elem->channel_data);
+  if (error == GRPC_ERROR_NONE && channeld->adaptive_compression() != nullptr &&
+      calld->method_stats_.load(std::memory_order_relaxed) == nullptr) {
+    const grpc_core::Slice* path =
+        calld->recv_initial_metadata_->get_pointer(
+            grpc_core::HttpPathMetadata());
+    if (path != nullptr) {
+      calld->method_stats_.store(
+          channeld->adaptive_compression()->GetMethodStats(
+              path->as_string_view()),
+          std::memory_order_release);
+    }
+  }
+  if (error == GRPC_ERROR_NONE && channeld->zstd_dictionaries() != nullptr) {
+    std::string buffer;
+    absl::optional<absl::string_view> peer_advertisement =
+        calld->recv_initial_metadata_->GetStringValue(
+            grpc_core::ZstdCompressionDictionaries::MetadataKey(), &buffer);
+    calld->zstd_dictionary_id_.store(
+        channeld->zstd_dictionaries()->ChooseDictionary(
+            peer_advertisement.value_or("")),
+        std::memory_order_relaxed);
+  }
+  grpc_core::Closure::Run(DEBUG_LOCATION,
+                          calld->original_recv_initial_metadata_ready_,
+                          GRPC_ERROR_REF(error));
 }
 
 void CallData::SendMessageOnComplete(void* calld_arg, grpc_error_handle error) {
@@ -219,7 +494,21 @@ void CallData::FinishSendMessage(grpc_call_element* elem) {
   grpc_slice_buffer_init(&tmp);
   uint32_t send_flags =
       send_message_batch_->payload->send_message.send_message->flags();
-  bool did_compress = grpc_msg_compress(compression_algorithm_, &slices_, &tmp);
+  AdaptiveCompression* adaptive_compression =
+      static_cast<ChannelData*>(elem->channel_data)->adaptive_compression();
+  gpr_cycle_counter start =
+      adaptive_compression != nullptr ? gpr_get_cycle_counter() : 0;
+  bool did_compress = compression_context_.Compress(
+      compression_algorithm_, &slices_, &tmp,
+      zstd_dictionary_id_.load(std::memory_order_relaxed));
+  if (adaptive_compression != nullptr) {
+    gpr_timespec elapsed =
+        gpr_cycle_counter_sub(gpr_get_cycle_counter(), start);
+    adaptive_compression->RecordCompression(
+        method_stats_.load(std::memory_order_acquire), slices_.length,
+        did_compress ? tmp.length : slices_.length,
+        elapsed.tv_sec * GPR_NS_PER_SEC + elapsed.tv_nsec);
+  }
   if (did_compress) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_compression_trace)) {
       const char* algo_name;
@@ -338,7 +627,7 @@ void CallData::StartSendMessageBatch(void* elem_arg,
                                      grpc_error_handle /*unused*/) {
   grpc_call_element* elem = static_cast<grpc_call_element*>(elem_arg);
   CallData* calld = static_cast<CallData*>(elem->call_data);
-  if (calld->SkipMessageCompression()) {
+  if (calld->SkipMessageCompression(elem)) {
     calld->SendMessageBatchContinue(elem);
   } else {
     calld->ContinueReadingSendMessage(elem);
@@ -369,6 +658,19 @@ void CallData::CompressStartTransportStreamOpBatch(
         batch, GRPC_ERROR_REF(cancel_error_), call_combiner_);
     return;
   }
+  // Intercept recv_initial_metadata, for the peer's zstd dictionaries and
+  // the method of server calls.
+  ChannelData* channeld = static_cast<ChannelData*>(elem->channel_data);
+  if (batch->recv_initial_metadata &&
+      (channeld->zstd_dictionaries() != nullptr ||
+       channeld->adaptive_compression() != nullptr)) {
+    recv_initial_metadata_ =
+        batch->payload->recv_initial_metadata.recv_initial_metadata;
+    original_recv_initial_metadata_ready_ =
+        batch->payload->recv_initial_metadata.recv_initial_metadata_ready;
+    batch->payload->recv_initial_metadata.recv_initial_metadata_ready =
+        &on_recv_initial_metadata_ready_;
+  }
   // Handle send_initial_metadata.
   if (batch->send_initial_metadata) {
     GPR_ASSERT(!seen_initial_metadata_);
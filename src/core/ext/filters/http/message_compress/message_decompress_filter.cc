@@ -48,9 +48,15 @@ class ChannelData {
       : max_recv_size_(GetMaxRecvSizeFromChannelArgs(
             ChannelArgs::FromC(args->channel_args))),
         message_size_service_config_parser_index_(
-            MessageSizeParser::ParserIndex()) {}
+            MessageSizeParser::ParserIndex()),
+        zstd_dictionaries_(ZstdCompressionDictionaries::GetFromChannelArgs(
+            args->channel_args)) {}
 
   int max_recv_size() const { return max_recv_size_; }
+  const RefCountedPtr<ZstdCompressionDictionaries>& zstd_dictionaries()
+      const {
+    return zstd_dictionaries_;
+  }
   size_t message_size_service_config_parser_index() const {
     return message_size_service_config_parser_index_;
   }
@@ -58,6 +64,7 @@ class ChannelData {
  private:
   int max_recv_size_;
   const size_t message_size_service_config_parser_index_;
+  const RefCountedPtr<ZstdCompressionDictionaries> zstd_dictionaries_;
 };
 
 class CallData {
@@ -87,6 +94,7 @@ class CallData {
          max_recv_message_length_ < 0)) {
       max_recv_message_length_ = limits->limits().max_recv_size;
     }
+    decompression_context_.set_zstd_dictionaries(chand->zstd_dictionaries());
   }
 
   ~CallData() { grpc_slice_buffer_destroy_internal(&recv_slices_); }
@@ -121,6 +129,8 @@ class CallData {
   bool seen_recv_message_ready_ = false;
   int max_recv_message_length_;
   grpc_compression_algorithm algorithm_ = GRPC_COMPRESS_NONE;
+  // Reused by the messages of the call.
+  MessageCompressionContext decompression_context_;
   grpc_closure on_recv_message_ready_;
   grpc_closure* original_recv_message_ready_ = nullptr;
   grpc_closure on_recv_message_next_done_;
@@ -245,8 +255,8 @@ void CallData::OnRecvMessageNextDone(void* arg, grpc_error_handle error) {
 void CallData::FinishRecvMessage() {
   grpc_slice_buffer decompressed_slices;
   grpc_slice_buffer_init(&decompressed_slices);
-  if (grpc_msg_decompress(algorithm_, &recv_slices_, &decompressed_slices) ==
-      0) {
+  if (decompression_context_.Decompress(algorithm_, &recv_slices_,
+                                       &decompressed_slices) == 0) {
     GPR_DEBUG_ASSERT(error_ == GRPC_ERROR_NONE);
     error_ = GRPC_ERROR_CREATE_FROM_CPP_STRING(
         absl::StrCat("Unexpected error decompressing data for algorithm with "
@@ -207,11 +207,16 @@ class BinderServerListener : public Server::ListenerInterface {
     if (!client_binder) {
       return absl::InvalidArgumentError("NULL binder read from the parcel");
     }
+    // Clients that know of no optional features stop after the binder.
+    int32_t client_features;
+    if (!parcel->ReadInt32(&client_features).ok()) {
+      client_features = 0;
+    }
     client_binder->Initialize();
     // Finish the second half of SETUP_TRANSPORT in
     // grpc_create_binder_transport_server().
     grpc_transport* server_transport = grpc_create_binder_transport_server(
-        std::move(client_binder), security_policy_);
+        std::move(client_binder), security_policy_, client_features);
     GPR_ASSERT(server_transport);
     grpc_channel_args* args = grpc_channel_args_copy(server_->channel_args());
     grpc_error_handle error =
@@ -43,10 +43,13 @@ struct grpc_binder_stream;
 // TODO(mingcl): Decide casing for this class name. Should we use C-style class
 // name here or just go with C++ style?
 struct grpc_binder_transport {
+  // For servers, peer_features holds the optional features the client
+  // advertised in its SETUP_TRANSPORT. Clients learn them from the server's.
   explicit grpc_binder_transport(
       std::unique_ptr<grpc_binder::Binder> binder, bool is_client,
       std::shared_ptr<grpc::experimental::binder::SecurityPolicy>
-          security_policy);
+          security_policy,
+      int32_t peer_features);
   ~grpc_binder_transport();
 
   int NewStreamTxCode() {
@@ -89,6 +92,7 @@ grpc_transport* grpc_create_binder_transport_client(
 grpc_transport* grpc_create_binder_transport_server(
     std::unique_ptr<grpc_binder::Binder> client_binder,
     std::shared_ptr<grpc::experimental::binder::SecurityPolicy>
-        security_policy);
+        security_policy,
+    int32_t client_features);
 
 #endif  // GRPC_CORE_EXT_TRANSPORT_BINDER_TRANSPORT_BINDER_TRANSPORT_H
@@ -97,6 +97,14 @@ binder_status_t AParcel_writeByteArray(AParcel* parcel, const int8_t* arrayData,
                                        int32_t length);
 binder_status_t AIBinder_prepareTransaction(AIBinder* binder, AParcel** in);
 jobject AIBinder_toJavaBinder(JNIEnv* env, AIBinder* binder);
+binder_status_t AParcel_writeParcelFileDescriptor(AParcel* parcel, int fd);
+binder_status_t AParcel_readParcelFileDescriptor(const AParcel* parcel,
+                                                 int* fd);
+
+// These come from libandroid rather than libbinder_ndk.
+int ASharedMemory_create(const char* name, size_t size);
+size_t ASharedMemory_getSize(int fd);
+int ASharedMemory_setProt(int fd, int prot);
 
 }  // namespace ndk_util
 
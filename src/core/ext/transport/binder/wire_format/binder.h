@@ -50,6 +50,9 @@ class WritableParcel {
   virtual absl::Status WriteBinder(HasRawBinder* binder) = 0;
   virtual absl::Status WriteString(absl::string_view s) = 0;
   virtual absl::Status WriteByteArray(const int8_t* buffer, int32_t length) = 0;
+  // Copies data into a new read-only shared memory region, and writes the
+  // region's file descriptor.
+  virtual absl::Status WriteSharedMemory(absl::string_view data) = 0;
 
   absl::Status WriteByteArrayWithLength(absl::string_view buffer) {
     absl::Status status = WriteInt32(buffer.length());
@@ -72,6 +75,9 @@ class ReadableParcel {
   virtual absl::Status ReadBinder(std::unique_ptr<Binder>* data) = 0;
   virtual absl::Status ReadByteArray(std::string* data) = 0;
   virtual absl::Status ReadString(std::string* str) = 0;
+  // Reads a file descriptor written by WriteSharedMemory() and copies the
+  // contents of its region into data.
+  virtual absl::Status ReadSharedMemory(std::string* data) = 0;
 };
 
 class TransactionReceiver : public HasRawBinder {
@@ -18,6 +18,10 @@
 
 #ifdef GPR_SUPPORT_BINDER_TRANSPORT
 
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include <map>
 
 #include "absl/memory/memory.h"
@@ -260,6 +264,32 @@ absl::Status WritableParcelAndroid::WriteByteArray(const int8_t* buffer,
              : absl::InternalError("AParcel_writeByteArray failed");
 }
 
+absl::Status WritableParcelAndroid::WriteSharedMemory(absl::string_view data) {
+  int fd = ndk_util::ASharedMemory_create("grpc-binder-message", data.size());
+  if (fd < 0) {
+    return absl::InternalError("ASharedMemory_create failed");
+  }
+  absl::Status status;
+  void* region =
+      mmap(nullptr, data.size(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (region == MAP_FAILED) {
+    status = absl::InternalError("mmap of shared memory failed");
+  } else {
+    memcpy(region, data.data(), data.size());
+    munmap(region, data.size());
+    // Nothing may write to the region once the other end can see it.
+    if (ndk_util::ASharedMemory_setProt(fd, PROT_READ) != 0) {
+      status = absl::InternalError("ASharedMemory_setProt failed");
+    } else if (ndk_util::AParcel_writeParcelFileDescriptor(parcel_, fd) !=
+               ndk_util::STATUS_OK) {
+      status = absl::InternalError("AParcel_writeParcelFileDescriptor failed");
+    }
+  }
+  // The parcel holds its own copy of the descriptor.
+  close(fd);
+  return status;
+}
+
 int32_t ReadableParcelAndroid::GetDataSize() const {
   return ndk_util::AParcel_getDataSize(parcel_);
 }
@@ -304,6 +334,28 @@ absl::Status ReadableParcelAndroid::ReadString(std::string* str) {
              : absl::InternalError("AParcel_readString failed");
 }
 
+absl::Status ReadableParcelAndroid::ReadSharedMemory(std::string* data) {
+  int fd = -1;
+  if (ndk_util::AParcel_readParcelFileDescriptor(parcel_, &fd) !=
+          ndk_util::STATUS_OK ||
+      fd < 0) {
+    return absl::InternalError("AParcel_readParcelFileDescriptor failed");
+  }
+  absl::Status status;
+  size_t size = ndk_util::ASharedMemory_getSize(fd);
+  void* region = size == 0
+                     ? MAP_FAILED
+                     : mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  if (region == MAP_FAILED) {
+    status = absl::InternalError("mmap of shared memory failed");
+  } else {
+    data->assign(static_cast<const char*>(region), size);
+    munmap(region, size);
+  }
+  close(fd);
+  return status;
+}
+
 }  // namespace grpc_binder
 
 #endif  // GPR_SUPPORT_BINDER_TRANSPORT
@@ -48,6 +48,7 @@ class WritableParcelAndroid final : public WritableParcel {
   absl::Status WriteBinder(HasRawBinder* binder) override;
   absl::Status WriteString(absl::string_view s) override;
   absl::Status WriteByteArray(const int8_t* buffer, int32_t length) override;
+  absl::Status WriteSharedMemory(absl::string_view data) override;
 
  private:
   ndk_util::AParcel* parcel_ = nullptr;
@@ -69,6 +70,7 @@ class ReadableParcelAndroid final : public ReadableParcel {
   absl::Status ReadBinder(std::unique_ptr<Binder>* data) override;
   absl::Status ReadByteArray(std::string* data) override;
   absl::Status ReadString(std::string* str) override;
+  absl::Status ReadSharedMemory(std::string* data) override;
 
  private:
   const ndk_util::AParcel* parcel_ = nullptr;
@@ -25,5 +25,8 @@ namespace grpc_binder {
 
 const int kFirstCallId = FIRST_CALL_TRANSACTION + 1000;
 
+const int32_t kFeatureSharedMemoryMessageData = 0x1;
+const int32_t kSupportedFeatures = kFeatureSharedMemoryMessageData;
+
 }  // namespace grpc_binder
 #endif
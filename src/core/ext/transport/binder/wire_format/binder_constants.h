@@ -38,6 +38,16 @@ enum class BinderTransportTxCode {
 
 ABSL_CONST_INIT extern const int kFirstCallId;
 
+// Optional features, as a bitmask that may follow the binder in
+// SETUP_TRANSPORT. An end that does not send it supports none of them, and
+// none are used towards it.
+//
+// Messages too large for one transaction are sent as a shared memory region,
+// and kFlagMessageDataInSharedMemory is set on their transaction.
+ABSL_CONST_INIT extern const int32_t kFeatureSharedMemoryMessageData;
+// The features this implementation advertises.
+ABSL_CONST_INIT extern const int32_t kSupportedFeatures;
+
 }  // namespace grpc_binder
 
 #endif  // GRPC_CORE_EXT_TRANSPORT_BINDER_WIRE_FORMAT_BINDER_CONSTANTS_H
@@ -28,6 +28,7 @@ const int kFlagExpectSingleMessage = 0x10;
 const int kFlagStatusDescription = 0x20;
 const int kFlagMessageDataIsParcelable = 0x40;
 const int kFlagMessageDataIsPartial = 0x80;
+const int kFlagMessageDataInSharedMemory = 0x100;
 
 }  // namespace grpc_binder
 #endif
@@ -34,6 +34,8 @@ ABSL_CONST_INIT extern const int kFlagExpectSingleMessage;
 ABSL_CONST_INIT extern const int kFlagStatusDescription;
 ABSL_CONST_INIT extern const int kFlagMessageDataIsParcelable;
 ABSL_CONST_INIT extern const int kFlagMessageDataIsPartial;
+// Only sent to ends that advertised kFeatureSharedMemoryMessageData.
+ABSL_CONST_INIT extern const int kFlagMessageDataInSharedMemory;
 
 using Metadata = std::vector<std::pair<std::string, std::string>>;
 
@@ -96,7 +96,8 @@ std::shared_ptr<WireWriter> WireReaderImpl::SetupTransport(
     {
       grpc_core::MutexLock lock(&mu_);
       connected_ = true;
-      wire_writer_ = std::make_shared<WireWriterImpl>(std::move(binder));
+      wire_writer_ =
+          std::make_shared<WireWriterImpl>(std::move(binder), peer_features_);
     }
     return wire_writer_;
   } else {
@@ -105,8 +106,8 @@ std::shared_ptr<WireWriter> WireReaderImpl::SetupTransport(
     {
       grpc_core::MutexLock lock(&mu_);
       connected_ = true;
-      wire_writer_ =
-          std::make_shared<WireWriterImpl>(std::move(other_end_binder));
+      wire_writer_ = std::make_shared<WireWriterImpl>(
+          std::move(other_end_binder), peer_features_);
     }
     return wire_writer_;
   }
@@ -135,10 +136,17 @@ void WireReaderImpl::SendSetupTransport(Binder* binder) {
   gpr_log(GPR_INFO, "tx_receiver = %p", tx_receiver_->GetRawBinder());
   gpr_log(GPR_INFO, "AParcel_writeStrongBinder = %d",
           writable_parcel->WriteBinder(tx_receiver_.get()).ok());
+  gpr_log(GPR_INFO, "write features = %d",
+          writable_parcel->WriteInt32(kSupportedFeatures).ok());
   gpr_log(GPR_INFO, "AIBinder_transact = %d",
           binder->Transact(BinderTransportTxCode::SETUP_TRANSPORT).ok());
 }
 
+void WireReaderImpl::SetPeerFeatures(int32_t features) {
+  grpc_core::MutexLock lock(&mu_);
+  peer_features_ = features;
+}
+
 std::unique_ptr<Binder> WireReaderImpl::RecvSetupTransport() {
   // TODO(b/191941760): avoid blocking, handle wire_writer_noti lifetime
   // better
@@ -210,6 +218,13 @@ absl::Status WireReaderImpl::ProcessTransaction(transaction_code_t code,
       if (!binder) {
         return absl::InternalError("Read NULL binder from the parcel");
       }
+      // Ends that know of no optional features stop after the binder.
+      int32_t features;
+      if (!parcel->ReadInt32(&features).ok()) {
+        features = 0;
+      }
+      gpr_log(GPR_INFO, "The other end supports features = %d", features);
+      peer_features_ = features;
       binder->Initialize();
       other_end_binder_ = std::move(binder);
       connection_noti_.Notify();
@@ -366,12 +381,16 @@ absl::Status WireReaderImpl::ProcessStreamingTransactionImpl(
     *cancellation_flags &= ~kFlagPrefix;
   }
   if (flags & kFlagMessageData) {
-    int count;
-    RETURN_IF_ERROR(parcel->ReadInt32(&count));
-    gpr_log(GPR_INFO, "count = %d", count);
     std::string msg_data{};
-    if (count > 0) {
-      RETURN_IF_ERROR(parcel->ReadByteArray(&msg_data));
+    if (flags & kFlagMessageDataInSharedMemory) {
+      RETURN_IF_ERROR(parcel->ReadSharedMemory(&msg_data));
+    } else {
+      int count;
+      RETURN_IF_ERROR(parcel->ReadInt32(&count));
+      gpr_log(GPR_INFO, "count = %d", count);
+      if (count > 0) {
+        RETURN_IF_ERROR(parcel->ReadByteArray(&msg_data));
+      }
     }
     gpr_log(GPR_INFO, "msg_data = %s", msg_data.c_str());
     message_buffer_[code] += msg_data;
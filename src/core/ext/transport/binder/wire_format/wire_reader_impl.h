@@ -96,6 +96,12 @@ class WireReaderImpl : public WireReader {
   // we can also avoid moving |other_end_binder_| out in the implementation.
   std::unique_ptr<Binder> RecvSetupTransport();
 
+  /// Record the optional features the other end advertised.
+  ///
+  /// Only needed by servers, which receive the client's SETUP_TRANSPORT
+  /// somewhere else: it must be called before SetupTransport().
+  void SetPeerFeatures(int32_t features);
+
  private:
   absl::Status ProcessStreamingTransaction(transaction_code_t code,
                                            ReadableParcel* parcel);
@@ -109,6 +115,7 @@ class WireReaderImpl : public WireReader {
   grpc_core::Mutex mu_;
   bool connected_ ABSL_GUARDED_BY(mu_) = false;
   bool recvd_setup_transport_ ABSL_GUARDED_BY(mu_) = false;
+  int32_t peer_features_ ABSL_GUARDED_BY(mu_) = 0;
   // NOTE: other_end_binder_ will be moved out when RecvSetupTransport() is
   // called. Be cautious not to access it afterward.
   std::unique_ptr<Binder> other_end_binder_;
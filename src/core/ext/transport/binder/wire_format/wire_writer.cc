@@ -29,8 +29,9 @@
   } while (0)
 
 namespace grpc_binder {
-WireWriterImpl::WireWriterImpl(std::unique_ptr<Binder> binder)
-    : binder_(std::move(binder)) {}
+WireWriterImpl::WireWriterImpl(std::unique_ptr<Binder> binder,
+                               int32_t peer_features)
+    : binder_(std::move(binder)), peer_features_(peer_features) {}
 
 absl::Status WireWriterImpl::WriteInitialMetadata(const Transaction& tx,
                                                   WritableParcel* parcel) {
@@ -74,17 +75,24 @@ bool WireWriterImpl::CanBeSentInOneTransaction(const Transaction& tx) const {
          tx.GetMessageData().size() <= kBlockSize;
 }
 
-absl::Status WireWriterImpl::RpcCallFastPath(const Transaction& tx) {
+absl::Status WireWriterImpl::RpcCallFastPath(const Transaction& tx,
+                                             bool data_in_shared_memory) {
   int& seq = seq_num_[tx.GetTxCode()];
   // Fast path: send data in one transaction.
   RETURN_IF_ERROR(binder_->PrepareTransaction());
   WritableParcel* parcel = binder_->GetWritableParcel();
-  RETURN_IF_ERROR(parcel->WriteInt32(tx.GetFlags()));
+  int flags = tx.GetFlags();
+  if (data_in_shared_memory) {
+    flags |= kFlagMessageDataInSharedMemory;
+  }
+  RETURN_IF_ERROR(parcel->WriteInt32(flags));
   RETURN_IF_ERROR(parcel->WriteInt32(seq++));
   if (tx.GetFlags() & kFlagPrefix) {
     RETURN_IF_ERROR(WriteInitialMetadata(tx, parcel));
   }
-  if (tx.GetFlags() & kFlagMessageData) {
+  if (data_in_shared_memory) {
+    RETURN_IF_ERROR(parcel->WriteSharedMemory(tx.GetMessageData()));
+  } else if (tx.GetFlags() & kFlagMessageData) {
     RETURN_IF_ERROR(parcel->WriteByteArrayWithLength(tx.GetMessageData()));
   }
   if (tx.GetFlags() & kFlagSuffix) {
@@ -117,7 +125,10 @@ absl::Status WireWriterImpl::RpcCall(const Transaction& tx) {
   grpc_core::MutexLock lock(&mu_);
   GPR_ASSERT(tx.GetTxCode() >= kFirstCallId);
   if (CanBeSentInOneTransaction(tx)) {
-    return RpcCallFastPath(tx);
+    return RpcCallFastPath(tx, /*data_in_shared_memory=*/false);
+  }
+  if (peer_features_ & kFeatureSharedMemoryMessageData) {
+    return RpcCallFastPath(tx, /*data_in_shared_memory=*/true);
   }
   // Slow path: the message data is too large to fit in one transaction.
   int& seq = seq_num_[tx.GetTxCode()];
@@ -38,7 +38,10 @@ class WireWriter {
 
 class WireWriterImpl : public WireWriter {
  public:
-  explicit WireWriterImpl(std::unique_ptr<Binder> binder);
+  // peer_features is the bitmask the other end advertised in
+  // SETUP_TRANSPORT (see kSupportedFeatures).
+  explicit WireWriterImpl(std::unique_ptr<Binder> binder,
+                          int32_t peer_features = 0);
   absl::Status RpcCall(const Transaction& tx) override;
   absl::Status SendAck(int64_t num_bytes) override;
   void OnAckReceived(int64_t num_bytes) override;
@@ -59,7 +62,11 @@ class WireWriterImpl : public WireWriter {
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   bool CanBeSentInOneTransaction(const Transaction& tx) const;
-  absl::Status RpcCallFastPath(const Transaction& tx)
+  // Sends tx in one transaction. With data_in_shared_memory, the message data
+  // goes in a shared memory region instead of the parcel, so that it does not
+  // have to fit in the transaction.
+  absl::Status RpcCallFastPath(const Transaction& tx,
+                               bool data_in_shared_memory)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   // Wait for acknowledgement from the other side for a while (the timeout is
@@ -77,6 +84,7 @@ class WireWriterImpl : public WireWriter {
   absl::flat_hash_map<int, int> seq_num_ ABSL_GUARDED_BY(mu_);
   int64_t num_outgoing_bytes_ ABSL_GUARDED_BY(mu_) = 0;
   int64_t num_acknowledged_bytes_ ABSL_GUARDED_BY(mu_) = 0;
+  const int32_t peer_features_;
 };
 
 }  // namespace grpc_binder
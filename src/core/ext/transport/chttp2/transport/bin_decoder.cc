@@ -20,11 +20,14 @@
 
 #include "src/core/ext/transport/chttp2/transport/bin_decoder.h"
 
+#include <algorithm>
+
 #include "absl/base/attributes.h"
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/slice/b64_kernels.h"
 #include "src/core/lib/slice/slice_refcount.h"
 
 static uint8_t decode_table[] = {
@@ -61,7 +64,7 @@ static bool input_is_valid(const uint8_t* input_ptr, size_t length) {
       gpr_log(GPR_ERROR,
               "Base64 decoding failed, invalid character '%c' in base64 "
               "input.\n",
-              static_cast<char>(*input_ptr));
+              static_cast<char>(input_ptr[i]));
       return false;
     }
   }
@@ -76,9 +79,6 @@ static bool input_is_valid(const uint8_t* input_ptr, size_t length) {
   (uint8_t)((decode_table[(input_ptr)[1]] << 4) | \
             (decode_table[(input_ptr)[2]] >> 2))
 
-#define COMPOSE_OUTPUT_BYTE_2(input_ptr) \
-  (uint8_t)((decode_table[(input_ptr)[2]] << 6) | decode_table[(input_ptr)[3]])
-
 // By RFC 4648, if the length of the encoded string without padding is 4n+r,
 // the length of decoded string is: 1) 3n if r = 0, 2) 3n + 1 if r = 2, 3, or
 // 3) invalid if r = 1.
@@ -112,15 +112,18 @@ bool grpc_base64_decode_partial(struct grpc_base64_decode_context* ctx) {
     return false;
   }
 
-  // Process a block of 4 input characters and 3 output bytes
-  while (ctx->input_end >= ctx->input_cur + 4 &&
-         ctx->output_end >= ctx->output_cur + 3) {
-    if (!input_is_valid(ctx->input_cur, 4)) return false;
-    ctx->output_cur[0] = COMPOSE_OUTPUT_BYTE_0(ctx->input_cur);
-    ctx->output_cur[1] = COMPOSE_OUTPUT_BYTE_1(ctx->input_cur);
-    ctx->output_cur[2] = COMPOSE_OUTPUT_BYTE_2(ctx->input_cur);
-    ctx->output_cur += 3;
-    ctx->input_cur += 4;
+  // Process blocks of 4 input characters and 3 output bytes
+  size_t blocks =
+      std::min(static_cast<size_t>(ctx->input_end - ctx->input_cur) / 4,
+               static_cast<size_t>(ctx->output_end - ctx->output_cur) / 3);
+  size_t consumed = grpc_core::Base64DecodeGroups(ctx->input_cur, blocks * 4,
+                                                  false, ctx->output_cur);
+  ctx->input_cur += consumed;
+  ctx->output_cur += consumed / 4 * 3;
+  if (consumed != blocks * 4) {
+    // The kernel stopped at a block containing an invalid character.
+    input_is_valid(ctx->input_cur, 4);
+    return false;
   }
 
   // Process the tail of input data
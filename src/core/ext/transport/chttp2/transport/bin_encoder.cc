@@ -23,9 +23,12 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
+
 #include <grpc/support/log.h>
 
 #include "src/core/ext/transport/chttp2/transport/huffsyms.h"
+#include "src/core/lib/slice/b64_kernels.h"
 
 static const char alphabet[] =
     "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
@@ -57,17 +60,10 @@ grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
   grpc_slice output = GRPC_SLICE_MALLOC(output_length);
   const uint8_t* in = GRPC_SLICE_START_PTR(input);
   char* out = reinterpret_cast<char*> GRPC_SLICE_START_PTR(output);
-  size_t i;
 
   /* encode full triplets */
-  for (i = 0; i < input_triplets; i++) {
-    out[0] = alphabet[in[0] >> 2];
-    out[1] = alphabet[((in[0] & 0x3) << 4) | (in[1] >> 4)];
-    out[2] = alphabet[((in[1] & 0xf) << 2) | (in[2] >> 6)];
-    out[3] = alphabet[in[2] & 0x3f];
-    out += 4;
-    in += 3;
-  }
+  in += grpc_core::Base64EncodeGroups(in, input_length, false, out);
+  out += input_triplets * 4;
 
   /* encode the remaining bytes */
   switch (tail_case) {
@@ -93,13 +89,58 @@ grpc_slice grpc_chttp2_base64_encode(const grpc_slice& input) {
   return output;
 }
 
+/* Bit accumulator for the huffman encoders: after a flush fewer than 32 bits
+ * are pending, so up to 32 more can be appended before the next flush. */
+struct huff_out {
+  uint64_t temp;
+  uint32_t temp_length;
+  uint8_t* out;
+};
+
+static void enc_flush_some(huff_out* out) {
+  if (out->temp_length >= 32) {
+    out->temp_length -= 32;
+    uint32_t word = static_cast<uint32_t>(out->temp >> out->temp_length);
+    out->out[0] = static_cast<uint8_t>(word >> 24);
+    out->out[1] = static_cast<uint8_t>(word >> 16);
+    out->out[2] = static_cast<uint8_t>(word >> 8);
+    out->out[3] = static_cast<uint8_t>(word);
+    out->out += 4;
+  }
+}
+
+static void enc_add_bits(huff_out* out, uint32_t bits, uint32_t length) {
+  out->temp = (out->temp << length) | bits;
+  out->temp_length += length;
+}
+
+static uint8_t* enc_finish(huff_out* out) {
+  while (out->temp_length >= 8) {
+    out->temp_length -= 8;
+    *out->out++ = static_cast<uint8_t>(out->temp >> out->temp_length);
+  }
+  if (out->temp_length) {
+    /* NB: the following integer arithmetic operation needs to be in its
+     * expanded form due to the "integral promotion" performed (see section
+     * 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
+     * is then required to avoid the compiler warning */
+    *out->out++ = static_cast<uint8_t>(
+        static_cast<uint8_t>(out->temp << (8u - out->temp_length)) |
+        static_cast<uint8_t>(0xffu >> out->temp_length));
+  }
+  return out->out;
+}
+
+static void enc_add1(huff_out* out, uint8_t a) {
+  b64_huff_sym sa = huff_alphabet[a];
+  enc_add_bits(out, sa.bits, sa.length);
+}
+
 grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input) {
   size_t nbits;
   const uint8_t* in;
-  uint8_t* out;
   grpc_slice output;
-  uint32_t temp = 0;
-  uint32_t temp_length = 0;
+  huff_out out;
 
   nbits = 0;
   for (in = GRPC_SLICE_START_PTR(input); in != GRPC_SLICE_END_PTR(input);
@@ -108,62 +149,36 @@ grpc_slice grpc_chttp2_huffman_compress(const grpc_slice& input) {
   }
 
   output = GRPC_SLICE_MALLOC(nbits / 8 + (nbits % 8 != 0));
-  out = GRPC_SLICE_START_PTR(output);
+  out.temp = 0;
+  out.temp_length = 0;
+  out.out = GRPC_SLICE_START_PTR(output);
   for (in = GRPC_SLICE_START_PTR(input); in != GRPC_SLICE_END_PTR(input);
        ++in) {
-    int sym = *in;
-    temp <<= grpc_chttp2_huffsyms[sym].length;
-    temp |= grpc_chttp2_huffsyms[sym].bits;
-    temp_length += grpc_chttp2_huffsyms[sym].length;
-
-    while (temp_length > 8) {
-      temp_length -= 8;
-      *out++ = static_cast<uint8_t>(temp >> temp_length);
-    }
-  }
-
-  if (temp_length) {
-    /* NB: the following integer arithmetic operation needs to be in its
-     * expanded form due to the "integral promotion" performed (see section
-     * 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
-     * is then required to avoid the compiler warning */
-    *out++ =
-        static_cast<uint8_t>(static_cast<uint8_t>(temp << (8u - temp_length)) |
-                             static_cast<uint8_t>(0xffu >> temp_length));
+    /* codes are at most 30 bits long, so each one can be followed by a flush
+     * without overflowing the accumulator */
+    const grpc_chttp2_huffsym& sym = grpc_chttp2_huffsyms[*in];
+    enc_add_bits(&out, sym.bits, sym.length);
+    enc_flush_some(&out);
   }
 
-  GPR_ASSERT(out == GRPC_SLICE_END_PTR(output));
+  GPR_ASSERT(enc_finish(&out) == GRPC_SLICE_END_PTR(output));
 
   return output;
 }
 
-struct huff_out {
-  uint32_t temp;
-  uint32_t temp_length;
-  uint8_t* out;
-};
-static void enc_flush_some(huff_out* out) {
-  while (out->temp_length > 8) {
-    out->temp_length -= 8;
-    *out->out++ = static_cast<uint8_t>(out->temp >> out->temp_length);
+/* Appends the huffman codes for a run of 6-bit values. Those codes are at most
+ * 11 bits long, so two fit between flushes. */
+static void enc_add_values(huff_out* out, const uint8_t* values, size_t n) {
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    enc_add1(out, values[i]);
+    enc_add1(out, values[i + 1]);
+    enc_flush_some(out);
+  }
+  for (; i < n; i++) {
+    enc_add1(out, values[i]);
+    enc_flush_some(out);
   }
-}
-
-static void enc_add2(huff_out* out, uint8_t a, uint8_t b) {
-  b64_huff_sym sa = huff_alphabet[a];
-  b64_huff_sym sb = huff_alphabet[b];
-  out->temp = (out->temp << (sa.length + sb.length)) |
-              (static_cast<uint32_t>(sa.bits) << sb.length) | sb.bits;
-  out->temp_length +=
-      static_cast<uint32_t>(sa.length) + static_cast<uint32_t>(sb.length);
-  enc_flush_some(out);
-}
-
-static void enc_add1(huff_out* out, uint8_t a) {
-  b64_huff_sym sa = huff_alphabet[a];
-  out->temp = (out->temp << sa.length) | sa.bits;
-  out->temp_length += sa.length;
-  enc_flush_some(out);
 }
 
 grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
@@ -176,24 +191,23 @@ grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
   size_t max_output_length = max_output_bits / 8 + (max_output_bits % 8 != 0);
   grpc_slice output = GRPC_SLICE_MALLOC(max_output_length);
   const uint8_t* in = GRPC_SLICE_START_PTR(input);
+  const uint8_t* in_end = GRPC_SLICE_END_PTR(input);
   uint8_t* start_out = GRPC_SLICE_START_PTR(output);
   huff_out out;
-  size_t i;
 
   out.temp = 0;
   out.temp_length = 0;
   out.out = start_out;
 
-  /* encode full triplets */
-  for (i = 0; i < input_triplets; i++) {
-    const uint8_t low_to_high = static_cast<uint8_t>((in[0] & 0x3) << 4);
-    const uint8_t high_to_low = in[1] >> 4;
-    enc_add2(&out, in[0] >> 2, low_to_high | high_to_low);
-
-    const uint8_t a = static_cast<uint8_t>((in[1] & 0xf) << 2);
-    const uint8_t b = (in[2] >> 6);
-    enc_add2(&out, a | b, in[2] & 0x3f);
-    in += 3;
+  /* split full triplets into 6-bit values a chunk at a time, then huffman
+   * code the chunk */
+  uint8_t values[256];
+  while (in_end - in >= 3) {
+    size_t chunk =
+        std::min(static_cast<size_t>(in_end - in), sizeof(values) / 4 * 3);
+    size_t consumed = grpc_core::Base64SplitGroups(in, chunk, values);
+    enc_add_values(&out, values, consumed / 3 * 4);
+    in += consumed;
   }
 
   /* encode the remaining bytes */
@@ -201,29 +215,21 @@ grpc_slice grpc_chttp2_base64_encode_and_huffman_compress(
     case 0:
       break;
     case 1:
-      enc_add2(&out, in[0] >> 2, static_cast<uint8_t>((in[0] & 0x3) << 4));
+      values[0] = in[0] >> 2;
+      values[1] = static_cast<uint8_t>((in[0] & 0x3) << 4);
+      enc_add_values(&out, values, 2);
       in += 1;
       break;
-    case 2: {
-      const uint8_t low_to_high = static_cast<uint8_t>((in[0] & 0x3) << 4);
-      const uint8_t high_to_low = in[1] >> 4;
-      enc_add2(&out, in[0] >> 2, low_to_high | high_to_low);
-      enc_add1(&out, static_cast<uint8_t>((in[1] & 0xf) << 2));
+    case 2:
+      values[0] = in[0] >> 2;
+      values[1] = static_cast<uint8_t>(((in[0] & 0x3) << 4) | (in[1] >> 4));
+      values[2] = static_cast<uint8_t>((in[1] & 0xf) << 2);
+      enc_add_values(&out, values, 3);
       in += 2;
       break;
-    }
-  }
-
-  if (out.temp_length) {
-    /* NB: the following integer arithmetic operation needs to be in its
-     * expanded form due to the "integral promotion" performed (see section
-     * 3.2.1.1 of the C89 draft standard). A cast to the smaller container type
-     * is then required to avoid the compiler warning */
-    *out.out++ = static_cast<uint8_t>(
-        static_cast<uint8_t>(out.temp << (8u - out.temp_length)) |
-        static_cast<uint8_t>(0xffu >> out.temp_length));
   }
 
+  enc_finish(&out);
   GPR_ASSERT(out.out <= GRPC_SLICE_END_PTR(output));
   GRPC_SLICE_SET_LENGTH(output, out.out - start_out);
 
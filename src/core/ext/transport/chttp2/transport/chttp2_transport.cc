@@ -58,6 +58,8 @@
 #include "src/core/ext/transport/chttp2/transport/varint.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/channel/context.h"
+#include "src/core/lib/channel/tx_latency_reporter.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/bitset.h"
@@ -68,11 +70,13 @@
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/http/parser.h"
+#include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/iomgr_fwd.h"
 #include "src/core/lib/iomgr/pollset.h"
+#include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/resource_quota/api.h"
@@ -93,6 +97,10 @@
 #include "src/core/lib/transport/transport.h"
 #include "src/core/lib/transport/transport_impl.h"
 
+#ifdef GRPC_POSIX_SOCKET_TCP
+#include "src/core/lib/iomgr/tcp_posix.h"
+#endif  // GRPC_POSIX_SOCKET_TCP
+
 GPR_GLOBAL_CONFIG_DEFINE_BOOL(
     grpc_experimental_disable_flow_control, false,
     "If set, flow control will be effectively disabled. Max out all values and "
@@ -102,7 +110,9 @@ GPR_GLOBAL_CONFIG_DEFINE_BOOL(
 #define DEFAULT_CONNECTION_WINDOW_TARGET (1024 * 1024)
 #define MAX_WINDOW 0x7fffffffu
 #define MAX_WRITE_BUFFER_SIZE (64 * 1024 * 1024)
+#define MAX_WRITE_COALESCING_DELAY_US 100000 /* 100 milliseconds */
 #define DEFAULT_MAX_HEADER_LIST_SIZE (8 * 1024)
+#define MAX_AUTO_TUNED_HEADER_TABLE_SIZE (64 * 1024)
 
 #define DEFAULT_CLIENT_KEEPALIVE_TIME_MS INT_MAX
 #define DEFAULT_CLIENT_KEEPALIVE_TIMEOUT_MS 20000 /* 20 seconds */
@@ -110,6 +120,11 @@ GPR_GLOBAL_CONFIG_DEFINE_BOOL(
 #define DEFAULT_SERVER_KEEPALIVE_TIMEOUT_MS 20000 /* 20 seconds */
 #define DEFAULT_KEEPALIVE_PERMIT_WITHOUT_CALLS false
 #define KEEPALIVE_TIME_BACKOFF_MULTIPLIER 2
+/* Keepalive ping timers are rounded up to a multiple of this fraction of the
+   keepalive time (at most one second), so that the pings of many transports
+   are sent in batches. */
+#define KEEPALIVE_BATCH_FRACTION 10
+#define MAX_KEEPALIVE_BATCH_MS 1000
 
 #define DEFAULT_MIN_RECV_PING_INTERVAL_WITHOUT_DATA_MS 300000 /* 5 minutes */
 #define DEFAULT_MAX_PINGS_BETWEEN_DATA 2
@@ -146,6 +161,11 @@ static void write_action_begin_locked(void* t, grpc_error_handle error);
 static void write_action(void* t, grpc_error_handle error);
 static void write_action_end(void* t, grpc_error_handle error);
 static void write_action_end_locked(void* t, grpc_error_handle error);
+static void write_coalescing_timer_fired(void* t, grpc_error_handle error);
+static void write_coalescing_timer_fired_locked(void* t,
+                                                grpc_error_handle error);
+static void write_coalescing_gather_locked(void* t, grpc_error_handle error);
+static void flush_coalesced_write_locked(grpc_chttp2_transport* t);
 
 static void read_action(void* t, grpc_error_handle error);
 static void read_action_locked(void* t, grpc_error_handle error);
@@ -186,6 +206,13 @@ static void finish_bdp_ping_locked(void* tp, grpc_error_handle error);
 static void next_bdp_ping_timer_expired(void* tp, grpc_error_handle error);
 static void next_bdp_ping_timer_expired_locked(void* tp,
                                                grpc_error_handle error);
+static void maybe_grow_header_table_size(grpc_chttp2_transport* t);
+
+static void update_hpack_table_reservation(grpc_chttp2_transport* t);
+static void release_memory_reservations(grpc_chttp2_transport* t);
+static void record_memory_reserved(grpc_chttp2_transport* t,
+                                   grpc_core::MemoryCategory category,
+                                   size_t bytes);
 
 static void cancel_pings(grpc_chttp2_transport* t, grpc_error_handle error);
 static void send_ping_locked(grpc_chttp2_transport* t,
@@ -201,6 +228,7 @@ static void start_keepalive_ping_locked(void* arg, grpc_error_handle error);
 static void finish_keepalive_ping_locked(void* arg, grpc_error_handle error);
 static void keepalive_watchdog_fired(void* arg, grpc_error_handle error);
 static void keepalive_watchdog_fired_locked(void* arg, grpc_error_handle error);
+static void schedule_keepalive_ping_locked(grpc_chttp2_transport* t);
 
 static void reset_byte_stream(void* arg, grpc_error_handle error);
 
@@ -345,9 +373,34 @@ static bool read_channel_args(grpc_chttp2_transport* t,
                            GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE)) {
       t->write_buffer_size = static_cast<uint32_t>(grpc_channel_arg_get_integer(
           &channel_args->args[i], {0, 0, MAX_WRITE_BUFFER_SIZE}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_STREAM_WRITE_QUANTUM)) {
+      t->stream_write_quantum =
+          static_cast<uint32_t>(grpc_channel_arg_get_integer(
+              &channel_args->args[i],
+              {static_cast<int>(t->stream_write_quantum), 0, INT_MAX}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_US)) {
+      t->write_coalescing_delay_us = grpc_channel_arg_get_integer(
+          &channel_args->args[i], {0, 0, MAX_WRITE_COALESCING_DELAY_US});
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_COALESCING_BYTES)) {
+      t->write_coalescing_bytes =
+          static_cast<size_t>(grpc_channel_arg_get_integer(
+              &channel_args->args[i],
+              {static_cast<int>(t->write_coalescing_bytes), 1,
+               MAX_WRITE_BUFFER_SIZE}));
     } else if (0 ==
                strcmp(channel_args->args[i].key, GRPC_ARG_HTTP2_BDP_PROBE)) {
       enable_bdp = grpc_channel_arg_get_bool(&channel_args->args[i], true);
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_BBR_FLOW_CONTROL)) {
+      t->bbr_flow_control =
+          grpc_channel_arg_get_bool(&channel_args->args[i], false);
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_SETTINGS_AUTO_TUNING)) {
+      t->settings_auto_tuning =
+          grpc_channel_arg_get_bool(&channel_args->args[i], false);
     } else if (0 ==
                strcmp(channel_args->args[i].key, GRPC_ARG_KEEPALIVE_TIME_MS)) {
       const int value = grpc_channel_arg_get_integer(
@@ -424,6 +477,10 @@ static bool read_channel_args(grpc_chttp2_transport* t,
             if (value >= 0) {
               queue_setting_update(t, settings_map[j].setting_id,
                                    static_cast<uint32_t>(value));
+              if (settings_map[j].setting_id ==
+                  GRPC_CHTTP2_SETTINGS_HEADER_TABLE_SIZE) {
+                t->header_table_size_configured = true;
+              }
             }
           }
           break;
@@ -432,12 +489,15 @@ static bool read_channel_args(grpc_chttp2_transport* t,
     }
   }
   if (channelz_enabled) {
+    t->channelz_stats =
+        grpc_core::MakeRefCounted<grpc_core::Chttp2TransportStats>(is_client);
     t->channelz_socket =
         grpc_core::MakeRefCounted<grpc_core::channelz::SocketNode>(
             std::string(grpc_endpoint_get_local_address(t->ep)), t->peer_string,
             absl::StrFormat("%s %s", get_vtable()->name, t->peer_string),
             grpc_core::channelz::SocketNode::Security::GetFromChannelArgs(
-                channel_args));
+                channel_args),
+            t->channelz_stats);
   }
   return enable_bdp;
 }
@@ -479,12 +539,8 @@ static void configure_transport_ping_policy(grpc_chttp2_transport* t) {
 static void init_keepalive_pings_if_enabled(grpc_chttp2_transport* t) {
   if (t->keepalive_time != grpc_core::Duration::Infinity()) {
     t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_WAITING;
-    GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-    GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
-                      grpc_schedule_on_exec_ctx);
-    grpc_timer_init(&t->keepalive_ping_timer,
-                    grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
-                    &t->init_keepalive_ping_locked);
+    t->keepalive_last_activity = grpc_core::ExecCtx::Get()->Now();
+    schedule_keepalive_ping_locked(t);
   } else {
     // Use GRPC_CHTTP2_KEEPALIVE_STATE_DISABLED to indicate there are no
     //   inflight keeaplive timers
@@ -501,8 +557,10 @@ grpc_chttp2_transport::grpc_chttp2_transport(
       peer_string(grpc_endpoint_get_peer(ep)),
       memory_owner(grpc_core::ResourceQuotaFromChannelArgs(channel_args)
                        ->memory_quota()
-                       ->CreateMemoryOwner(absl::StrCat(
-                           grpc_endpoint_get_peer(ep), ":client_transport"))),
+                       ->CreateMemoryOwner(
+                           absl::StrCat(grpc_endpoint_get_peer(ep),
+                                        ":client_transport"),
+                           grpc_core::MemoryCategory::kTransport)),
       self_reservation(
           memory_owner.MakeReservation(sizeof(grpc_chttp2_transport))),
       combiner(grpc_combiner_create()),
@@ -547,6 +605,12 @@ grpc_chttp2_transport::grpc_chttp2_transport(
                        DEFAULT_MAX_HEADER_LIST_SIZE);
   queue_setting_update(this,
                        GRPC_CHTTP2_SETTINGS_GRPC_ALLOW_TRUE_BINARY_METADATA, 1);
+#ifdef GRPC_POSIX_SOCKET_TCP
+  if (grpc_tcp_can_receive_fds(ep)) {
+    queue_setting_update(this, GRPC_CHTTP2_SETTINGS_GRPC_ALLOW_UNIX_FD_PASSING,
+                         1);
+  }
+#endif  // GRPC_POSIX_SOCKET_TCP
 
   configure_transport_ping_policy(this);
   init_transport_keepalive_settings(this);
@@ -558,7 +622,10 @@ grpc_chttp2_transport::grpc_chttp2_transport(
 
   static const bool kEnableFlowControl =
       !GPR_GLOBAL_CONFIG_GET(grpc_experimental_disable_flow_control);
-  if (kEnableFlowControl) {
+  if (kEnableFlowControl && bbr_flow_control) {
+    flow_control.Init<grpc_core::chttp2::TransportFlowControlBbr>(this,
+                                                                  enable_bdp);
+  } else if (kEnableFlowControl) {
     flow_control.Init<grpc_core::chttp2::TransportFlowControl>(this,
                                                                enable_bdp);
   } else {
@@ -596,6 +663,7 @@ static void destroy_transport_locked(void* tp, grpc_error_handle /*error*/) {
       t, grpc_error_set_int(
              GRPC_ERROR_CREATE_FROM_STATIC_STRING("Transport destroyed"),
              GRPC_ERROR_INT_OCCURRED_DURING_WRITE, t->write_state));
+  release_memory_reservations(t);
   t->memory_owner.Reset();
   // Must be the last line.
   GRPC_CHTTP2_UNREF_TRANSPORT(t, "destroy");
@@ -617,6 +685,10 @@ static void close_transport_locked(grpc_chttp2_transport* t,
                                  GRPC_STATUS_UNAVAILABLE);
     }
     if (t->write_state != GRPC_CHTTP2_WRITE_STATE_IDLE) {
+      // Don't keep the close waiting on the write coalescing window.
+      if (t->write_coalescing_held) {
+        flush_coalesced_write_locked(t);
+      }
       if (t->close_transport_on_writes_finished == GRPC_ERROR_NONE) {
         t->close_transport_on_writes_finished =
             GRPC_ERROR_CREATE_FROM_STATIC_STRING(
@@ -708,6 +780,7 @@ grpc_chttp2_stream::grpc_chttp2_stream(grpc_chttp2_transport* t,
     id = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(server_data));
     *t->accepting_stream = this;
     grpc_chttp2_stream_map_add(&t->stream_map, id, this);
+    GRPC_USDT_PROBE(stream_open, refcount, t, id);
     post_destructive_reclaimer(t);
   }
   if (t->flow_control->flow_control_enabled()) {
@@ -824,6 +897,9 @@ static const char* write_state_name(grpc_chttp2_write_state st) {
 
 static void set_write_state(grpc_chttp2_transport* t,
                             grpc_chttp2_write_state st, const char* reason) {
+  grpc_core::TraceRing::Record(&grpc_http_trace, "write_state",
+                               reinterpret_cast<intptr_t>(t), t->write_state,
+                               st);
   GRPC_CHTTP2_IF_TRACING(
       gpr_log(GPR_INFO, "W:%p %s [%s] state %s -> %s [%s]", t,
               t->is_client ? "CLIENT" : "SERVER", t->peer_string.c_str(),
@@ -924,6 +1000,7 @@ void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
   switch (t->write_state) {
     case GRPC_CHTTP2_WRITE_STATE_IDLE:
       inc_initiate_write_reason(reason);
+      t->write_initiated_cycle = gpr_get_cycle_counter();
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING,
                       grpc_chttp2_initiate_write_reason_string(reason));
       GRPC_CHTTP2_REF_TRANSPORT(t, "writing");
@@ -951,6 +1028,18 @@ void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
     case GRPC_CHTTP2_WRITE_STATE_WRITING:
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE,
                       grpc_chttp2_initiate_write_reason_string(reason));
+      t->write_initiated_cycle = gpr_get_cycle_counter();
+      // If the current write is being held back by the coalescing window,
+      // append the new frames to it once the combiner has run everything else
+      // (for the same reason as above).
+      if (t->write_coalescing_held && !t->write_coalescing_gather_pending) {
+        t->write_coalescing_gather_pending = true;
+        GRPC_CHTTP2_REF_TRANSPORT(t, "write coalescing gather");
+        t->combiner->FinallyRun(
+            GRPC_CLOSURE_INIT(&t->write_coalescing_gather_locked,
+                              write_coalescing_gather_locked, t, nullptr),
+            GRPC_ERROR_NONE);
+      }
       break;
     case GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE:
       break;
@@ -973,11 +1062,141 @@ static const char* begin_writing_desc(bool partial) {
   }
 }
 
+static void maybe_resume_reading_after_write_locked(
+    grpc_chttp2_transport* t) {
+  if (t->reading_paused_on_pending_induced_frames) {
+    GPR_ASSERT(t->num_pending_induced_frames == 0);
+    // We had paused reading, because we had many induced frames (SETTINGS
+    // ACK, PINGS ACK and RST_STREAMS) pending in t->qbuf. Now that we have
+    // been able to flush qbuf, we can resume reading.
+    GRPC_CHTTP2_IF_TRACING(gpr_log(
+        GPR_INFO,
+        "transport %p : Resuming reading after being paused due to too "
+        "many unwritten SETTINGS ACK, PINGS ACK and RST_STREAM frames",
+        t));
+    t->reading_paused_on_pending_induced_frames = false;
+    continue_read_action_locked(t);
+  }
+}
+
+static int64_t write_coalescing_now_us() {
+  return static_cast<int64_t>(
+      gpr_timespec_to_micros(gpr_now(GPR_CLOCK_MONOTONIC)));
+}
+
+// Records how long the frames just gathered by grpc_chttp2_begin_write waited
+// since the write was initiated. What a partial write left behind keeps
+// waiting from now on.
+static void record_write_queue_time(grpc_chttp2_transport* t,
+                                    const grpc_chttp2_begin_write_result& r) {
+  if (!r.writing) return;
+  GRPC_STATS_INC_HTTP2_WRITE_QUEUE_MICROS(
+      grpc_stats_micros_since(t->write_initiated_cycle));
+  if (r.partial) t->write_initiated_cycle = gpr_get_cycle_counter();
+}
+
+// Adaptive write coalescing (GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_US): a
+// small write is only held back when the previous write started less than one
+// window ago, ie. when writes are arriving in bursts and more frames are likely
+// to follow shortly. A lone write on a quiet connection goes out immediately.
+static bool should_coalesce_write(grpc_chttp2_transport* t, int64_t now_us) {
+  return t->write_coalescing_delay_us > 0 &&
+         !t->write_coalescing_timer_pending &&
+         t->closed_with_error == GRPC_ERROR_NONE &&
+         t->outbuf.length < t->write_coalescing_bytes &&
+         now_us - t->last_write_start_us < t->write_coalescing_delay_us;
+}
+
+// Keeps the gathered write (and the "writing" ref) in outbuf until the
+// coalescing timer fires or enough bytes have been queued.
+static void hold_write_locked(grpc_chttp2_transport* t, int64_t now_us) {
+  GRPC_STATS_INC_HTTP2_COALESCED_WRITES();
+  t->write_coalescing_held = true;
+  t->write_coalescing_timer_pending = true;
+  t->write_coalescing_start_us = now_us;
+  GRPC_CHTTP2_REF_TRANSPORT(t, "write coalescing timer");
+  GRPC_CLOSURE_INIT(&t->write_coalescing_timer_fired_locked,
+                    write_coalescing_timer_fired, t, grpc_schedule_on_exec_ctx);
+  grpc_timer_init(&t->write_coalescing_timer,
+                  grpc_core::ExecCtx::Get()->Now() +
+                      grpc_core::Duration::MicrosecondsRoundUp(
+                          t->write_coalescing_delay_us),
+                  &t->write_coalescing_timer_fired_locked);
+}
+
+// Appends whatever was queued since the write was held back to outbuf.
+// Returns true if the write must not be held any longer.
+static bool gather_coalesced_write_locked(grpc_chttp2_transport* t) {
+  if (t->write_state == GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE &&
+      t->closed_with_error == GRPC_ERROR_NONE) {
+    grpc_chttp2_begin_write_result r = grpc_chttp2_begin_write(t);
+    record_write_queue_time(t, r);
+    if (r.partial) {
+      GRPC_STATS_INC_HTTP2_PARTIAL_WRITES();
+    }
+    set_write_state(t,
+                    r.partial ? GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE
+                              : GRPC_CHTTP2_WRITE_STATE_WRITING,
+                    begin_writing_desc(r.partial));
+    if (r.partial) return true;
+  }
+  return t->closed_with_error != GRPC_ERROR_NONE ||
+         t->outbuf.length >= t->write_coalescing_bytes;
+}
+
+// Ends the coalescing window and hands all of outbuf to the endpoint in a
+// single write.
+static void flush_coalesced_write_locked(grpc_chttp2_transport* t) {
+  GPR_ASSERT(t->write_coalescing_held);
+  gather_coalesced_write_locked(t);
+  t->write_coalescing_held = false;
+  if (t->write_coalescing_timer_pending) {
+    grpc_timer_cancel(&t->write_coalescing_timer);
+  }
+  int64_t now_us = write_coalescing_now_us();
+  GRPC_STATS_INC_HTTP2_WRITE_COALESCING_DELAY_MICROS(
+      now_us - t->write_coalescing_start_us);
+  t->last_write_start_us = now_us;
+  write_action(t, GRPC_ERROR_NONE);
+  maybe_resume_reading_after_write_locked(t);
+}
+
+static void write_coalescing_gather_locked(void* tp,
+                                           grpc_error_handle /*error*/) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  t->write_coalescing_gather_pending = false;
+  // The window may have been closed (and the frames gathered) in the meantime.
+  if (t->write_coalescing_held && gather_coalesced_write_locked(t)) {
+    flush_coalesced_write_locked(t);
+  }
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "write coalescing gather");
+}
+
+static void write_coalescing_timer_fired(void* tp, grpc_error_handle error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  t->combiner->Run(
+      GRPC_CLOSURE_INIT(&t->write_coalescing_timer_fired_locked,
+                        write_coalescing_timer_fired_locked, t, nullptr),
+      GRPC_ERROR_REF(error));
+}
+
+static void write_coalescing_timer_fired_locked(void* tp,
+                                                grpc_error_handle /*error*/) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  t->write_coalescing_timer_pending = false;
+  // If the timer was cancelled the write has already been flushed.
+  if (t->write_coalescing_held) {
+    flush_coalesced_write_locked(t);
+  }
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "write coalescing timer");
+}
+
 static void write_action_begin_locked(void* gt,
                                       grpc_error_handle /*error_ignored*/) {
   GPR_TIMER_SCOPE("write_action_begin_locked", 0);
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
   GPR_ASSERT(t->write_state != GRPC_CHTTP2_WRITE_STATE_IDLE);
+  GPR_ASSERT(!t->write_coalescing_held);
   grpc_chttp2_begin_write_result r;
   if (t->closed_with_error != GRPC_ERROR_NONE) {
     r.writing = false;
@@ -985,6 +1204,7 @@ static void write_action_begin_locked(void* gt,
     r = grpc_chttp2_begin_write(t);
   }
   if (r.writing) {
+    record_write_queue_time(t, r);
     if (r.partial) {
       GRPC_STATS_INC_HTTP2_PARTIAL_WRITES();
     }
@@ -992,20 +1212,15 @@ static void write_action_begin_locked(void* gt,
                     r.partial ? GRPC_CHTTP2_WRITE_STATE_WRITING_WITH_MORE
                               : GRPC_CHTTP2_WRITE_STATE_WRITING,
                     begin_writing_desc(r.partial));
-    write_action(t, GRPC_ERROR_NONE);
-    if (t->reading_paused_on_pending_induced_frames) {
-      GPR_ASSERT(t->num_pending_induced_frames == 0);
-      // We had paused reading, because we had many induced frames (SETTINGS
-      // ACK, PINGS ACK and RST_STREAMS) pending in t->qbuf. Now that we have
-      // been able to flush qbuf, we can resume reading.
-      GRPC_CHTTP2_IF_TRACING(gpr_log(
-          GPR_INFO,
-          "transport %p : Resuming reading after being paused due to too "
-          "many unwritten SETTINGS ACK, PINGS ACK and RST_STREAM frames",
-          t));
-      t->reading_paused_on_pending_induced_frames = false;
-      continue_read_action_locked(t);
+    int64_t now_us =
+        t->write_coalescing_delay_us > 0 ? write_coalescing_now_us() : 0;
+    if (!r.partial && should_coalesce_write(t, now_us)) {
+      hold_write_locked(t, now_us);
+      return;
     }
+    t->last_write_start_us = now_us;
+    write_action(t, GRPC_ERROR_NONE);
+    maybe_resume_reading_after_write_locked(t);
   } else {
     GRPC_STATS_INC_HTTP2_SPURIOUS_WRITES_BEGUN();
     set_write_state(t, GRPC_CHTTP2_WRITE_STATE_IDLE, "begin writing nothing");
@@ -1018,6 +1233,16 @@ static void write_action(void* gt, grpc_error_handle /*error*/) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
   void* cl = t->cl;
   t->cl = nullptr;
+  if (t->channelz_stats != nullptr) {
+    t->channelz_stats->RecordWrite(t->outbuf);
+  }
+  if (t->memory_owner.is_valid()) {
+    GPR_DEBUG_ASSERT(t->pending_write_reserved_bytes == 0);
+    t->pending_write_reserved_bytes = t->memory_owner.Reserve(
+        grpc_core::MemoryCategory::kPendingWrites, t->outbuf.length);
+    record_memory_reserved(t, grpc_core::MemoryCategory::kPendingWrites,
+                           t->pending_write_reserved_bytes);
+  }
   grpc_endpoint_write(
       t->ep, &t->outbuf,
       GRPC_CLOSURE_INIT(&t->write_action_end_locked, write_action_end, t,
@@ -1038,6 +1263,13 @@ static void write_action_end_locked(void* tp, grpc_error_handle error) {
   GPR_TIMER_SCOPE("terminate_writing_with_lock", 0);
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
 
+  if (t->pending_write_reserved_bytes != 0) {
+    t->memory_owner.Release(grpc_core::MemoryCategory::kPendingWrites,
+                            t->pending_write_reserved_bytes);
+    t->pending_write_reserved_bytes = 0;
+    record_memory_reserved(t, grpc_core::MemoryCategory::kPendingWrites, 0);
+  }
+
   bool closed = false;
   if (error != GRPC_ERROR_NONE) {
     close_transport_locked(t, GRPC_ERROR_REF(error));
@@ -1157,6 +1389,8 @@ void grpc_chttp2_add_incoming_goaway(grpc_chttp2_transport* t,
         &last_stream_id);
   }
   absl::Status status = grpc_error_to_absl_status(t->goaway_error);
+  status.SetPayload(grpc_core::kGoawayErrorKey,
+                    absl::Cord(std::to_string(goaway_error)));
   // When a client receives a GOAWAY with error code ENHANCE_YOUR_CALM and debug
   // data equal to "too_many_pings", it should log the occurrence at a log level
   // that is enabled by default and double the configured KEEPALIVE_TIME used
@@ -1217,6 +1451,7 @@ static void maybe_start_some_streams(grpc_chttp2_transport* t) {
     }
 
     grpc_chttp2_stream_map_add(&t->stream_map, s->id, s);
+    GRPC_USDT_PROBE(stream_open, s->refcount, t, s->id);
     post_destructive_reclaimer(t);
     grpc_chttp2_mark_stream_writable(t, s);
     grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_START_NEW_STREAM);
@@ -1631,6 +1866,7 @@ static void perform_stream_op_locked(void* stream_op,
     s->recv_message = op_payload->recv_message.recv_message;
     s->call_failed_before_recv_message =
         op_payload->recv_message.call_failed_before_recv_message;
+    s->max_buffered_bytes = op_payload->recv_message.max_buffered_bytes;
     if (s->id != 0) {
       if (!s->read_closed) {
         before = s->frame_storage.length +
@@ -1688,11 +1924,35 @@ static void perform_stream_op(grpc_transport* gt, grpc_stream* gs,
     }
   }
 
+  grpc_core::TraceRing::Record(
+      &grpc_http_trace, "perform_stream_op", reinterpret_cast<intptr_t>(s),
+      reinterpret_cast<intptr_t>(op),
+      op->send_initial_metadata | op->send_message << 1 |
+          op->send_trailing_metadata << 2 | op->recv_initial_metadata << 3 |
+          op->recv_message << 4 | op->recv_trailing_metadata << 5 |
+          op->cancel_stream << 6);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
     gpr_log(GPR_INFO, "perform_stream_op[s=%p; op=%p]: %s", s, op,
             grpc_transport_stream_op_batch_string(op).c_str());
   }
 
+  if (op->is_traced && s->tx_latency_reporter == nullptr &&
+      op->payload->context != nullptr) {
+    // This runs under the call combiner, while the client channel still owns
+    // the context entry.
+    auto* reporter = static_cast<grpc_core::TxLatencyReporter*>(
+        op->payload->context[GRPC_CONTEXT_TX_LATENCY_REPORTER].value);
+    if (reporter != nullptr) {
+      static const bool kTimestampsCallbackSet = []() {
+        grpc_core::grpc_tcp_set_write_timestamps_callback(
+            grpc_core::ContextList::Execute);
+        return true;
+      }();
+      (void)kTimestampsCallbackSet;
+      s->tx_latency_reporter = reporter->Ref();
+    }
+  }
+
   GRPC_CHTTP2_STREAM_REF(s, "perform_stream_op");
   op->handler_private.extra_arg = gs;
   t->combiner->Run(GRPC_CLOSURE_INIT(&op->handler_private.closure,
@@ -2640,6 +2900,7 @@ static void read_action_locked(void* tp, grpc_error_handle error) {
     for (i = 0; i < GPR_ARRAY_SIZE(errors); i++) {
       GRPC_ERROR_UNREF(errors[i]);
     }
+    update_hpack_table_reservation(t);
 
     GPR_TIMER_SCOPE("post_parse_locked", 0);
     if (t->initial_window_update != 0) {
@@ -2672,10 +2933,9 @@ static void read_action_locked(void* tp, grpc_error_handle error) {
     t->endpoint_reading = 0;
   } else if (t->closed_with_error == GRPC_ERROR_NONE) {
     keep_reading = true;
-    // Since we have read a byte, reset the keepalive timer
-    if (t->keepalive_state == GRPC_CHTTP2_KEEPALIVE_STATE_WAITING) {
-      grpc_timer_cancel(&t->keepalive_ping_timer);
-    }
+    // Since we have read a byte, postpone the keepalive ping. The timer is
+    // left alone: when it fires, it is re-armed from this time.
+    t->keepalive_last_activity = grpc_core::ExecCtx::Get()->Now();
   }
   grpc_slice_buffer_reset_and_unref_internal(&t->read_buffer);
 
@@ -2735,14 +2995,31 @@ static void start_bdp_ping_locked(void* tp, grpc_error_handle error) {
   if (error != GRPC_ERROR_NONE || t->closed_with_error != GRPC_ERROR_NONE) {
     return;
   }
-  // Reset the keepalive ping timer
-  if (t->keepalive_state == GRPC_CHTTP2_KEEPALIVE_STATE_WAITING) {
-    grpc_timer_cancel(&t->keepalive_ping_timer);
-  }
+  // Postpone the keepalive ping
+  t->keepalive_last_activity = grpc_core::ExecCtx::Get()->Now();
   t->flow_control->bdp_estimator()->StartPing();
   t->bdp_ping_started = true;
 }
 
+// Doubles the HEADER_TABLE_SIZE we advertise (up to
+// MAX_AUTO_TUNED_HEADER_TABLE_SIZE) whenever the peer had to evict entries
+// from our HPACK decoder table since the last BDP ping: headers that no longer
+// fit are sent as literals again and again.
+static void maybe_grow_header_table_size(grpc_chttp2_transport* t) {
+  uint64_t evictions = t->hpack_parser.hpack_table()->num_evictions();
+  bool evicted = evictions != t->last_hpack_table_evictions;
+  t->last_hpack_table_evictions = evictions;
+  if (!evicted || t->header_table_size_configured) return;
+  uint32_t size =
+      t->settings[GRPC_LOCAL_SETTINGS][GRPC_CHTTP2_SETTINGS_HEADER_TABLE_SIZE];
+  if (size >= MAX_AUTO_TUNED_HEADER_TABLE_SIZE) return;
+  queue_setting_update(
+      t, GRPC_CHTTP2_SETTINGS_HEADER_TABLE_SIZE,
+      std::min<uint32_t>(std::max<uint32_t>(2 * size, 4096),
+                         MAX_AUTO_TUNED_HEADER_TABLE_SIZE));
+  grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_SEND_SETTINGS);
+}
+
 static void finish_bdp_ping(void* tp, grpc_error_handle error) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
   t->combiner->Run(GRPC_CLOSURE_INIT(&t->finish_bdp_ping_locked,
@@ -2771,8 +3048,15 @@ static void finish_bdp_ping_locked(void* tp, grpc_error_handle error) {
   t->bdp_ping_started = false;
   grpc_core::Timestamp next_ping =
       t->flow_control->bdp_estimator()->CompletePing();
+  if (t->channelz_stats != nullptr) {
+    t->channelz_stats->RecordPingRtt(
+        t->flow_control->bdp_estimator()->last_ping_rtt());
+  }
   grpc_chttp2_act_on_flowctl_action(t->flow_control->PeriodicUpdate(), t,
                                     nullptr);
+  if (t->settings_auto_tuning) {
+    maybe_grow_header_table_size(t);
+  }
   GPR_ASSERT(!t->have_next_bdp_ping_timer);
   t->have_next_bdp_ping_timer = true;
   GRPC_CLOSURE_INIT(&t->next_bdp_ping_timer_expired_locked,
@@ -2866,6 +3150,27 @@ void grpc_chttp2_config_default_keepalive_args(grpc_channel_args* args,
   }
 }
 
+// Arms the keepalive ping timer for keepalive_time after the last activity on
+// the transport, rounded up so that the timers of transports with similar
+// deadlines fire, and their pings are written, together.
+static void schedule_keepalive_ping_locked(grpc_chttp2_transport* t) {
+  const int64_t batch_ms =
+      std::min<int64_t>(MAX_KEEPALIVE_BATCH_MS,
+                        t->keepalive_time.millis() / KEEPALIVE_BATCH_FRACTION);
+  grpc_core::Timestamp deadline =
+      t->keepalive_last_activity + t->keepalive_time;
+  if (batch_ms > 1 && deadline != grpc_core::Timestamp::InfFuture()) {
+    const int64_t millis = deadline.milliseconds_after_process_epoch();
+    deadline = grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+        (millis + batch_ms - 1) / batch_ms * batch_ms);
+  }
+  GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
+  GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
+                    grpc_schedule_on_exec_ctx);
+  grpc_timer_init(&t->keepalive_ping_timer, deadline,
+                  &t->init_keepalive_ping_locked);
+}
+
 static void init_keepalive_ping(void* arg, grpc_error_handle error) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(arg);
   t->combiner->Run(GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked,
@@ -2879,29 +3184,24 @@ static void init_keepalive_ping_locked(void* arg, grpc_error_handle error) {
   if (t->destroying || t->closed_with_error != GRPC_ERROR_NONE) {
     t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_DYING;
   } else if (error == GRPC_ERROR_NONE) {
-    if (t->keepalive_permit_without_calls ||
-        grpc_chttp2_stream_map_size(&t->stream_map) > 0) {
+    if (t->keepalive_last_activity + t->keepalive_time >
+        grpc_core::ExecCtx::Get()->Now()) {
+      // There was a read since the timer was armed: no ping is needed yet.
+      schedule_keepalive_ping_locked(t);
+    } else if (t->keepalive_permit_without_calls ||
+               grpc_chttp2_stream_map_size(&t->stream_map) > 0) {
       t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_PINGING;
       GRPC_CHTTP2_REF_TRANSPORT(t, "keepalive ping end");
       grpc_timer_init_unset(&t->keepalive_watchdog_timer);
       send_keepalive_ping_locked(t);
       grpc_chttp2_initiate_write(t, GRPC_CHTTP2_INITIATE_WRITE_KEEPALIVE_PING);
     } else {
-      GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-      GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
-                        grpc_schedule_on_exec_ctx);
-      grpc_timer_init(&t->keepalive_ping_timer,
-                      grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
-                      &t->init_keepalive_ping_locked);
+      t->keepalive_last_activity = grpc_core::ExecCtx::Get()->Now();
+      schedule_keepalive_ping_locked(t);
     }
   } else if (error == GRPC_ERROR_CANCELLED) {
-    // The keepalive ping timer may be cancelled by bdp
-    GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-    GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
-                      grpc_schedule_on_exec_ctx);
-    grpc_timer_init(&t->keepalive_ping_timer,
-                    grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
-                    &t->init_keepalive_ping_locked);
+    t->keepalive_last_activity = grpc_core::ExecCtx::Get()->Now();
+    schedule_keepalive_ping_locked(t);
   }
   GRPC_CHTTP2_UNREF_TRANSPORT(t, "init keepalive ping");
 }
@@ -2961,12 +3261,8 @@ static void finish_keepalive_ping_locked(void* arg, grpc_error_handle error) {
       t->keepalive_ping_started = false;
       t->keepalive_state = GRPC_CHTTP2_KEEPALIVE_STATE_WAITING;
       grpc_timer_cancel(&t->keepalive_watchdog_timer);
-      GRPC_CHTTP2_REF_TRANSPORT(t, "init keepalive ping");
-      GRPC_CLOSURE_INIT(&t->init_keepalive_ping_locked, init_keepalive_ping, t,
-                        grpc_schedule_on_exec_ctx);
-      grpc_timer_init(&t->keepalive_ping_timer,
-                      grpc_core::ExecCtx::Get()->Now() + t->keepalive_time,
-                      &t->init_keepalive_ping_locked);
+      t->keepalive_last_activity = grpc_core::ExecCtx::Get()->Now();
+      schedule_keepalive_ping_locked(t);
     }
   }
   GRPC_CHTTP2_UNREF_TRANSPORT(t, "keepalive ping end");
@@ -3219,6 +3515,50 @@ void Chttp2IncomingByteStream::Shutdown(grpc_error_handle error) {
 // RESOURCE QUOTAS
 //
 
+// Keep the memory reserved for the HPACK decoder table in line with its size,
+// so that it is charged to the quota (and shows in its usage) like the rest of
+// the transport's memory. The table fluctuates as entries get evicted for new
+// ones: only give memory back once it has shrunk by half.
+static void update_hpack_table_reservation(grpc_chttp2_transport* t) {
+  if (!t->memory_owner.is_valid()) return;
+  const size_t used = t->hpack_parser.hpack_table()->mem_used();
+  if (used > t->hpack_table_reserved_bytes) {
+    t->hpack_table_reserved_bytes +=
+        t->memory_owner.Reserve(grpc_core::MemoryCategory::kHpackTable,
+                                used - t->hpack_table_reserved_bytes);
+  } else if (used < t->hpack_table_reserved_bytes / 2) {
+    t->memory_owner.Release(grpc_core::MemoryCategory::kHpackTable,
+                            t->hpack_table_reserved_bytes - used);
+    t->hpack_table_reserved_bytes = used;
+  } else {
+    return;
+  }
+  record_memory_reserved(t, grpc_core::MemoryCategory::kHpackTable,
+                         t->hpack_table_reserved_bytes);
+}
+
+// Memory reserved under explicit categories must be handed back before the
+// memory owner goes away.
+static void release_memory_reservations(grpc_chttp2_transport* t) {
+  if (!t->memory_owner.is_valid()) return;
+  t->memory_owner.Release(grpc_core::MemoryCategory::kHpackTable,
+                          t->hpack_table_reserved_bytes);
+  t->hpack_table_reserved_bytes = 0;
+  t->memory_owner.Release(grpc_core::MemoryCategory::kPendingWrites,
+                          t->pending_write_reserved_bytes);
+  t->pending_write_reserved_bytes = 0;
+  record_memory_reserved(t, grpc_core::MemoryCategory::kHpackTable, 0);
+  record_memory_reserved(t, grpc_core::MemoryCategory::kPendingWrites, 0);
+}
+
+static void record_memory_reserved(grpc_chttp2_transport* t,
+                                   grpc_core::MemoryCategory category,
+                                   size_t bytes) {
+  if (t->channelz_stats != nullptr) {
+    t->channelz_stats->RecordMemoryReserved(category, bytes);
+  }
+}
+
 static void post_benign_reclaimer(grpc_chttp2_transport* t) {
   if (!t->benign_reclaimer_registered) {
     t->benign_reclaimer_registered = true;
@@ -3323,6 +3663,147 @@ static void destructive_reclaimer_locked(void* arg, grpc_error_handle error) {
 // MONITORING
 //
 
+namespace grpc_core {
+
+Chttp2TransportStats::Chttp2TransportStats(bool is_client)
+    : preface_bytes_to_skip_(is_client ? GRPC_CHTTP2_CLIENT_CONNECT_STRLEN
+                                       : 0) {}
+
+void Chttp2TransportStats::RecordWrite(const grpc_slice_buffer& outbuf) {
+  Bump(&writes_);
+  Bump(&bytes_written_, outbuf.length);
+  if (outbuf.length > max_write_size_.load(std::memory_order_relaxed)) {
+    max_write_size_.store(outbuf.length, std::memory_order_relaxed);
+  }
+  static constexpr size_t kFrameHeaderSize = 9;
+  // Hop from frame header to frame header: only the 9 header bytes of each
+  // frame are looked at, skip counts the payload bytes to step over.
+  size_t skip = preface_bytes_to_skip_;
+  preface_bytes_to_skip_ = 0;
+  uint8_t header[kFrameHeaderSize];
+  size_t header_length = 0;
+  for (size_t i = 0; i < outbuf.count; i++) {
+    const uint8_t* p = GRPC_SLICE_START_PTR(outbuf.slices[i]);
+    const uint8_t* end = GRPC_SLICE_END_PTR(outbuf.slices[i]);
+    while (p != end) {
+      if (skip > 0) {
+        size_t n = std::min(skip, static_cast<size_t>(end - p));
+        p += n;
+        skip -= n;
+        continue;
+      }
+      header[header_length++] = *p++;
+      if (header_length == kFrameHeaderSize) {
+        Bump(&frames_sent_[std::min(header[3], kOtherFrameType)]);
+        skip = (static_cast<size_t>(header[0]) << 16) |
+               (static_cast<size_t>(header[1]) << 8) | header[2];
+        header_length = 0;
+      }
+    }
+  }
+}
+
+void Chttp2TransportStats::RecordTransportStalled(Timestamp now) {
+  if (transport_stall_start_.load(std::memory_order_relaxed) != -1) return;
+  Bump(&transport_stalls_);
+  transport_stall_start_.store(now.milliseconds_after_process_epoch(),
+                               std::memory_order_relaxed);
+}
+
+void Chttp2TransportStats::RecordTransportUnstalled(Timestamp now) {
+  int64_t start = transport_stall_start_.load(std::memory_order_relaxed);
+  if (start == -1) return;
+  transport_stall_millis_.store(
+      transport_stall_millis_.load(std::memory_order_relaxed) +
+          std::max<int64_t>(0, now.milliseconds_after_process_epoch() - start),
+      std::memory_order_relaxed);
+  transport_stall_start_.store(-1, std::memory_order_relaxed);
+}
+
+void Chttp2TransportStats::RecordPingRtt(double rtt_seconds) {
+  int64_t micros = static_cast<int64_t>(rtt_seconds * 1e6);
+  last_ping_rtt_micros_.store(micros, std::memory_order_relaxed);
+  int64_t min = min_ping_rtt_micros_.load(std::memory_order_relaxed);
+  if (min == 0 || micros < min) {
+    min_ping_rtt_micros_.store(micros, std::memory_order_relaxed);
+  }
+}
+
+void Chttp2TransportStats::PopulateOptions(Json::Array* options) {
+  auto add = [options](absl::string_view name, std::string value) {
+    options->push_back(Json::Object{
+        {"name", absl::StrCat("grpc.chttp2.", name)},
+        {"value", std::move(value)},
+    });
+  };
+  static const char* const kFrameTypeNames[kOtherFrameType + 1] = {
+      "data",          "headers",      "priority", "rst_stream",
+      "settings",      "push_promise", "ping",     "goaway",
+      "window_update", "continuation", "other"};
+  for (uint8_t type = 0; type <= kOtherFrameType; type++) {
+    uint64_t sent = frames_sent_[type].load(std::memory_order_relaxed);
+    if (sent != 0) {
+      add(absl::StrCat("frames_sent.", kFrameTypeNames[type]),
+          std::to_string(sent));
+    }
+    uint64_t received = frames_received_[type].load(std::memory_order_relaxed);
+    if (received != 0) {
+      add(absl::StrCat("frames_received.", kFrameTypeNames[type]),
+          std::to_string(received));
+    }
+  }
+  uint64_t indexed = hpack_indexed_fields_sent_.load(std::memory_order_relaxed);
+  uint64_t literal = hpack_literal_fields_sent_.load(std::memory_order_relaxed);
+  if (indexed + literal != 0) {
+    add("hpack_indexed_fields_sent", std::to_string(indexed));
+    add("hpack_literal_fields_sent", std::to_string(literal));
+    add("hpack_hit_ratio",
+        absl::StrFormat("%.3f", static_cast<double>(indexed) /
+                                    static_cast<double>(indexed + literal)));
+  }
+  uint64_t writes = writes_.load(std::memory_order_relaxed);
+  if (writes != 0) {
+    uint64_t bytes = bytes_written_.load(std::memory_order_relaxed);
+    add("writes", std::to_string(writes));
+    add("bytes_written", std::to_string(bytes));
+    add("average_write_size", std::to_string(bytes / writes));
+    add("max_write_size",
+        std::to_string(max_write_size_.load(std::memory_order_relaxed)));
+  }
+  uint64_t stalls = transport_stalls_.load(std::memory_order_relaxed);
+  if (stalls != 0) {
+    int64_t stall_millis =
+        transport_stall_millis_.load(std::memory_order_relaxed);
+    int64_t start = transport_stall_start_.load(std::memory_order_relaxed);
+    if (start != -1) {
+      // Include the stall still in progress.
+      Timestamp now =
+          Timestamp::FromTimespecRoundDown(gpr_now(GPR_CLOCK_MONOTONIC));
+      stall_millis += std::max<int64_t>(
+          0, now.milliseconds_after_process_epoch() - start);
+    }
+    add("flow_control_stalls", std::to_string(stalls));
+    add("flow_control_stall_time_ms", std::to_string(stall_millis));
+    add("flow_control_stalled", start != -1 ? "true" : "false");
+  }
+  int64_t last_rtt = last_ping_rtt_micros_.load(std::memory_order_relaxed);
+  if (last_rtt != 0) {
+    add("last_ping_rtt_us", std::to_string(last_rtt));
+    add("min_ping_rtt_us",
+        std::to_string(min_ping_rtt_micros_.load(std::memory_order_relaxed)));
+  }
+  for (size_t i = 0; i < kNumMemoryCategories; i++) {
+    size_t bytes = memory_reserved_[i].load(std::memory_order_relaxed);
+    if (bytes != 0) {
+      add(absl::StrCat("memory.",
+                       MemoryCategoryName(static_cast<MemoryCategory>(i))),
+          std::to_string(bytes));
+    }
+  }
+}
+
+}  // namespace grpc_core
+
 const char* grpc_chttp2_initiate_write_reason_string(
     grpc_chttp2_initiate_write_reason reason) {
   switch (reason) {
@@ -32,13 +32,18 @@ void* (*get_copied_context_fn_g)(void*) = nullptr;
 
 namespace grpc_core {
 void ContextList::Append(ContextList** head, grpc_chttp2_stream* s) {
-  if (get_copied_context_fn_g == nullptr ||
-      write_timestamps_callback_g == nullptr) {
+  const bool copy_context = get_copied_context_fn_g != nullptr &&
+                            write_timestamps_callback_g != nullptr;
+  if (!copy_context && s->tx_latency_reporter == nullptr) {
     return;
   }
   /* Create a new element in the list and add it at the front */
   ContextList* elem = new ContextList();
-  elem->trace_context_ = get_copied_context_fn_g(s->context);
+  if (copy_context) {
+    elem->trace_context_ = get_copied_context_fn_g(s->context);
+    elem->has_trace_context_ = true;
+  }
+  elem->tx_latency_reporter_ = s->tx_latency_reporter;
   elem->byte_offset_ = s->byte_counter;
   elem->next_ = *head;
   *head = elem;
@@ -48,10 +53,13 @@ void ContextList::Execute(void* arg, Timestamps* ts, grpc_error_handle error) {
   ContextList* head = static_cast<ContextList*>(arg);
   ContextList* to_be_freed;
   while (head != nullptr) {
-    if (write_timestamps_callback_g) {
-      if (ts) {
-        ts->byte_offset = static_cast<uint32_t>(head->byte_offset_);
+    if (ts) {
+      ts->byte_offset = static_cast<uint32_t>(head->byte_offset_);
+      if (head->tx_latency_reporter_ != nullptr) {
+        head->tx_latency_reporter_->Report(*ts);
       }
+    }
+    if (write_timestamps_callback_g && head->has_trace_context_) {
       write_timestamps_callback_g(head->trace_context_, ts, error);
     }
     to_be_freed = head;
@@ -24,6 +24,8 @@
 #include <stddef.h>
 
 #include "src/core/ext/transport/chttp2/transport/frame.h"
+#include "src/core/lib/channel/tx_latency_reporter.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/error.h"
 
@@ -32,16 +34,20 @@ namespace grpc_core {
 class ContextList {
  public:
   /* Creates a new element with \a context as the value and appends it to the
-   * list. */
+   * list. Does nothing unless the hooks below are set or the stream has a
+   * TxLatencyReporter. */
   static void Append(ContextList** head, grpc_chttp2_stream* s);
 
   /* Executes a function \a fn with each context in the list and \a ts. It also
    * frees up the entire list after this operation. It is intended as a callback
-   * and hence does not take a ref on \a error */
+   * and hence does not take a ref on \a error. The timestamps are also passed
+   * to the TxLatencyReporter of each stream that has one. */
   static void Execute(void* arg, Timestamps* ts, grpc_error_handle error);
 
  private:
   void* trace_context_ = nullptr;
+  bool has_trace_context_ = false;
+  RefCountedPtr<TxLatencyReporter> tx_latency_reporter_;
   ContextList* next_ = nullptr;
   size_t byte_offset_ = 0;
 };
@@ -183,8 +183,8 @@ TransportFlowControlDisabled::TransportFlowControlDisabled(
 TransportFlowControl::TransportFlowControl(const grpc_chttp2_transport* t,
                                            bool enable_bdp_probe)
     : t_(t),
-      enable_bdp_probe_(enable_bdp_probe),
       bdp_estimator_(t->peer_string.c_str()),
+      enable_bdp_probe_(enable_bdp_probe),
       pid_controller_(PidController::Args()
                           .set_gain_p(4)
                           .set_gain_i(8)
@@ -320,10 +320,25 @@ void StreamFlowControl::IncomingByteStreamUpdate(size_t max_size_hint,
           tfc_->transport()
               ->settings[GRPC_SENT_SETTINGS]
                         [GRPC_CHTTP2_SETTINGS_INITIAL_WINDOW_SIZE]);
-  if (local_window_delta_ < max_recv_bytes) {
-    uint32_t add_max_recv_bytes =
-        static_cast<uint32_t>(max_recv_bytes - local_window_delta_);
-    local_window_delta_ += add_max_recv_bytes;
+  int64_t target_delta = max_recv_bytes;
+  if (s_->max_buffered_bytes != 0) {
+    // Keep the stream window, on top of what is already buffered, within
+    // the bound set by the application. This can take the delta below
+    // zero, i.e. withhold window updates until the application catches up.
+    const int64_t initial_window = std::max(
+        tfc_->transport()->settings[GRPC_SENT_SETTINGS]
+                                   [GRPC_CHTTP2_SETTINGS_INITIAL_WINDOW_SIZE],
+        tfc_->transport()->settings[GRPC_ACKED_SETTINGS]
+                                   [GRPC_CHTTP2_SETTINGS_INITIAL_WINDOW_SIZE]);
+    const int64_t buffered = s_->frame_storage.length +
+                             s_->unprocessed_incoming_frames_buffer.length;
+    target_delta = std::min(
+        target_delta,
+        std::max<int64_t>(s_->max_buffered_bytes, GRPC_HEADER_SIZE_IN_BYTES) -
+            initial_window - buffered);
+  }
+  if (local_window_delta_ < target_delta) {
+    local_window_delta_ = target_delta;
   }
 }
 
@@ -344,10 +359,37 @@ static double AdjustForMemoryPressure(double memory_pressure, double target) {
   return target;
 }
 
+double MemoryPressureWindowScale(double memory_pressure) {
+  static const double kLowMemPressure = 0.5;
+  static const double kMaxMemPressure = 0.95;
+  const double x = Clamp((memory_pressure - kLowMemPressure) /
+                             (kMaxMemPressure - kLowMemPressure),
+                         0.0, 1.0);
+  // smoothstep, so that the window does not jump as pressure crosses either
+  // end of the range.
+  return 1 - x * x * (3 - 2 * x);
+}
+
+int64_t TransportFlowControl::target_window() const {
+  const int64_t target = static_cast<uint32_t>(
+      std::min(kMaxWindow, announced_stream_total_over_incoming_window_ +
+                               target_initial_window_size_));
+  const double scale = MemoryPressureWindowScale(MemoryPressure());
+  if (scale >= 1) return target;
+  // Keep the default window open even under heavy pressure so that the peer
+  // can still make progress, and so that incoming data keeps triggering
+  // updates through which the window recovers once pressure falls.
+  return std::max(std::min(target, static_cast<int64_t>(kDefaultWindow)),
+                  static_cast<int64_t>(target * scale));
+}
+
+double TransportFlowControl::MemoryPressure() const {
+  return t_->memory_owner.is_valid() ? t_->memory_owner.InstantaneousPressure()
+                                     : 0.0;
+}
+
 double TransportFlowControl::TargetLogBdp() {
-  return AdjustForMemoryPressure(t_->memory_owner.is_valid()
-                                     ? t_->memory_owner.InstantaneousPressure()
-                                     : 0.0,
+  return AdjustForMemoryPressure(MemoryPressure(),
                                  1 + log2(bdp_estimator_.EstimateBdp()));
 }
 
@@ -387,28 +429,150 @@ FlowControlAction TransportFlowControl::PeriodicUpdate() {
                    ->ComputeNextTargetInitialWindowSizeFromPeriodicUpdate(
                        target_initial_window_size_ /* current target */);
     }
-    // Though initial window 'could' drop to 0, we keep the floor at
-    // kMinInitialWindowSize
-    target_initial_window_size_ = static_cast<int32_t>(Clamp(
-        target, double(kMinInitialWindowSize), double(kMaxInitialWindowSize)));
-    action.set_send_initial_window_update(
-        DeltaUrgency(target_initial_window_size_,
-                     GRPC_CHTTP2_SETTINGS_INITIAL_WINDOW_SIZE),
-        static_cast<uint32_t>(target_initial_window_size_));
-
-    // get bandwidth estimate and update max_frame accordingly.
-    double bw_dbl = bdp_estimator_.EstimateBandwidth();
-    // we target the max of BDP or bandwidth in microseconds.
-    int32_t frame_size = static_cast<int32_t>(Clamp(
-        std::max(
-            static_cast<int32_t>(Clamp(bw_dbl, 0.0, double(INT_MAX))) / 1000,
-            static_cast<int32_t>(target_initial_window_size_)),
-        16384, 16777215));
-    action.set_send_max_frame_size_update(
-        DeltaUrgency(static_cast<int64_t>(frame_size),
-                     GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE),
-        frame_size);
+    SetTargetInitialWindowSize(target, &action);
+  }
+  return UpdateAction(action);
+}
+
+void TransportFlowControl::SetTargetInitialWindowSize(
+    double target, FlowControlAction* action) {
+  // Though initial window 'could' drop to 0, we keep the floor at
+  // kMinInitialWindowSize
+  target_initial_window_size_ = static_cast<int32_t>(Clamp(
+      target, double(kMinInitialWindowSize), double(kMaxInitialWindowSize)));
+  action->set_send_initial_window_update(
+      DeltaUrgency(target_initial_window_size_,
+                   GRPC_CHTTP2_SETTINGS_INITIAL_WINDOW_SIZE),
+      static_cast<uint32_t>(target_initial_window_size_));
+
+  // get bandwidth estimate and update max_frame accordingly.
+  double bw_dbl = bdp_estimator_.EstimateBandwidth();
+  // we target the max of BDP or bandwidth in microseconds.
+  int32_t frame_size = static_cast<int32_t>(Clamp(
+      std::max(
+          static_cast<int32_t>(Clamp(bw_dbl, 0.0, double(INT_MAX))) / 1000,
+          static_cast<int32_t>(target_initial_window_size_)),
+      16384, 16777215));
+  if (t_->settings_auto_tuning) {
+    // Frames longer than the messages being received only cost the other
+    // streams interleaving, so bulk transfers get large frames while small
+    // message traffic keeps them short.
+    frame_size = std::min(frame_size, MessageSizeFrameLimit());
+  }
+  action->set_send_max_frame_size_update(
+      DeltaUrgency(static_cast<int64_t>(frame_size),
+                   GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE),
+      frame_size);
+}
+
+void TransportFlowControl::RecvMessageHeader(uint32_t message_size) {
+  // Decay by 1/64 per message: a burst of large messages keeps the estimate
+  // up for a few hundred small ones.
+  large_message_size_ =
+      std::max(static_cast<double>(message_size),
+               large_message_size_ * (1.0 - 1.0 / 64));
+}
+
+int32_t TransportFlowControl::MessageSizeFrameLimit() const {
+  // Round up (including the gRPC message header) to a power of two, so that
+  // the setting is not updated for every small change in message size.
+  double needed = large_message_size_ + GRPC_HEADER_SIZE_IN_BYTES;
+  int32_t limit = 16384;
+  while (limit < 16777215 && limit < needed) {
+    limit = std::min(2 * limit, 16777215);
+  }
+  return limit;
+}
+
+namespace {
+// Gain applied to the modelled BDP while starting up (2/ln2, the smallest
+// gain that still doubles the delivery rate every round trip), and once the
+// pipe is full.
+constexpr double kBbrStartupGain = 2.885;
+constexpr double kBbrSteadyGain = 2;
+// Bandwidth growth below which a sample counts towards leaving startup.
+constexpr double kBbrFullBandwidthGrowth = 1.25;
+constexpr int kBbrFullBandwidthCount = 3;
+// A min RTT sample older than this is replaced by the next sample, so that a
+// path change that increases the RTT is eventually picked up.
+constexpr Duration kBbrMinRttExpiry = Duration::Seconds(10);
+
+// Unlike AdjustForMemoryPressure, the window is never inflated beyond what
+// the model asks for when memory is plentiful: it is only shrunk, down to
+// the floor, as pressure builds.
+double BbrAdjustForMemoryPressure(double memory_pressure, double target) {
+  static const double kHighMemPressure = 0.8;
+  static const double kMaxMemPressure = 0.9;
+  if (memory_pressure > kHighMemPressure) {
+    target *= 1 - std::min(1.0, (memory_pressure - kHighMemPressure) /
+                                    (kMaxMemPressure - kHighMemPressure));
+  }
+  return target;
+}
+}  // namespace
+
+double BbrWindowModel::bottleneck_bandwidth() const {
+  return *std::max_element(bandwidth_samples_,
+                           bandwidth_samples_ + kBandwidthWindow);
+}
+
+void BbrWindowModel::AddSample(double bandwidth, double rtt, Timestamp now) {
+  bandwidth_samples_[next_bandwidth_sample_] = bandwidth;
+  next_bandwidth_sample_ = (next_bandwidth_sample_ + 1) % kBandwidthWindow;
+  if (rtt > 0 && (min_rtt_ == 0 || rtt <= min_rtt_ ||
+                  now - min_rtt_stamp_ > kBbrMinRttExpiry)) {
+    min_rtt_ = rtt;
+    min_rtt_stamp_ = now;
+  }
+  if (!filled_pipe_) {
+    double btl_bw = bottleneck_bandwidth();
+    if (btl_bw >= full_bandwidth_ * kBbrFullBandwidthGrowth) {
+      full_bandwidth_ = btl_bw;
+      full_bandwidth_count_ = 0;
+    } else if (++full_bandwidth_count_ >= kBbrFullBandwidthCount) {
+      filled_pipe_ = true;
+    }
+  }
+}
+
+double BbrWindowModel::TargetWindow(double current_window,
+                                    double memory_pressure) const {
+  double target = current_window;
+  if (min_rtt_ > 0) {
+    const double gain = filled_pipe_ ? kBbrSteadyGain : kBbrStartupGain;
+    // Never aim below the default window: a small sample (eg. an idle
+    // stretch) should not throttle the next burst.
+    target = std::max(gain * bottleneck_bandwidth() * min_rtt_,
+                      static_cast<double>(kDefaultWindow));
+  }
+  return BbrAdjustForMemoryPressure(memory_pressure, target);
+}
+
+TransportFlowControlBbr::TransportFlowControlBbr(
+    const grpc_chttp2_transport* t, bool enable_bdp_probe)
+    : TransportFlowControl(t, enable_bdp_probe),
+      model_(ExecCtx::Get()->Now()) {}
+
+FlowControlAction TransportFlowControlBbr::PeriodicUpdate() {
+  FlowControlAction action;
+  if (!bdp_probe()) return UpdateAction(action);
+  // Only pings that completed since the last update carry new information;
+  // PeriodicUpdate is called once per completed ping, so at most one sample
+  // is ever pending.
+  if (bdp_estimator_.completed_pings() != samples_seen_) {
+    samples_seen_ = bdp_estimator_.completed_pings();
+    model_.AddSample(bdp_estimator_.last_ping_bandwidth(),
+                     bdp_estimator_.last_ping_rtt(), ExecCtx::Get()->Now());
+  }
+  double target = model_.TargetWindow(
+      static_cast<double>(target_initial_window_size_), MemoryPressure());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_flowctl_trace)) {
+    gpr_log(GPR_INFO,
+            "%p[bbr]: btl_bw=%lfMbs min_rtt=%lfms filled_pipe=%d target=%lf",
+            t_, model_.bottleneck_bandwidth() / 125000.0,
+            model_.min_rtt() * 1000.0, model_.filled_pipe(), target);
   }
+  SetTargetInitialWindowSize(target, &action);
   return UpdateAction(action);
 }
 
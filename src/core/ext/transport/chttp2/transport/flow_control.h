@@ -59,6 +59,11 @@ static constexpr const uint32_t kMaxWindowDelta = (1u << 20);
 class TransportFlowControl;
 class StreamFlowControl;
 
+// Fraction of the transport window to keep announcing at the given memory
+// pressure: 1 while pressure is low, falling smoothly to 0 as pressure
+// approaches its maximum, and rising again as it falls.
+double MemoryPressureWindowScale(double memory_pressure);
+
 extern bool g_test_only_transport_flow_control_window_check;
 
 // Encapsulates a collections of actions the transport needs to take with
@@ -183,6 +188,9 @@ class TransportFlowControlBase {
   // Called to do bookkeeping when we receive a WINDOW_UPDATE frame.
   virtual void RecvUpdate(uint32_t /* size */) = 0;
 
+  // Called with the length of each gRPC message as it starts arriving.
+  virtual void RecvMessageHeader(uint32_t /* message_size */) {}
+
   // Returns the BdpEstimator held by this object. Caller is responsible for
   // checking for nullptr. TODO(ncteisen): consider fully encapsulating all
   // bdp estimator actions inside TransportFlowControl
@@ -228,7 +236,7 @@ class TransportFlowControlDisabled final : public TransportFlowControlBase {
 
 // Implementation of flow control that abides to HTTP/2 spec and attempts
 // to be as performant as possible.
-class TransportFlowControl final : public TransportFlowControlBase {
+class TransportFlowControl : public TransportFlowControlBase {
  public:
   TransportFlowControl(const grpc_chttp2_transport* t, bool enable_bdp_probe);
   ~TransportFlowControl() override {}
@@ -275,14 +283,14 @@ class TransportFlowControl final : public TransportFlowControlBase {
     remote_window_ += size;
   }
 
+  void RecvMessageHeader(uint32_t message_size) override;
+
   // See comment above announced_stream_total_over_incoming_window_ for the
   // logic behind this decision.
-  int64_t target_window() const override {
-    return static_cast<uint32_t>(
-        std::min(static_cast<int64_t>((1u << 31) - 1),
-                 announced_stream_total_over_incoming_window_ +
-                     target_initial_window_size_));
-  }
+  // The window is also shrunk by the current memory pressure, so that the
+  // transport window announced to the peer reacts to pressure on every
+  // update rather than only when the BDP estimate is next refreshed.
+  int64_t target_window() const override;
 
   const grpc_chttp2_transport* transport() const { return t_; }
 
@@ -305,12 +313,7 @@ class TransportFlowControl final : public TransportFlowControlBase {
     remote_window_ = 1024 * 1024 * 1024;
   }
 
- private:
-  double TargetLogBdp();
-  double SmoothLogBdp(double value);
-  FlowControlAction::Urgency DeltaUrgency(int64_t value,
-                                          grpc_chttp2_setting_id setting_id);
-
+ protected:
   FlowControlAction UpdateAction(FlowControlAction action) {
     if (announced_window_ < target_window() / 2) {
       action.set_send_transport_update(
@@ -319,8 +322,25 @@ class TransportFlowControl final : public TransportFlowControlBase {
     return action;
   }
 
+  // Clamps target into the initial window range, makes it the new target
+  // initial window size, and derives a max frame size from it and the
+  // bandwidth estimate; both settings updates are recorded in action.
+  void SetTargetInitialWindowSize(double target, FlowControlAction* action);
+  double MemoryPressure() const;
+
   const grpc_chttp2_transport* const t_;
 
+  /* bdp estimation */
+  BdpEstimator bdp_estimator_;
+
+ private:
+  double TargetLogBdp();
+  double SmoothLogBdp(double value);
+  FlowControlAction::Urgency DeltaUrgency(int64_t value,
+                                          grpc_chttp2_setting_id setting_id);
+  // Largest frame size worth announcing for the recently received messages.
+  int32_t MessageSizeFrameLimit() const;
+
   /** calculating what we should give for local window:
       we track the total amount of flow control over initial window size
       across all streams: this is data that we want to receive right now (it
@@ -334,12 +354,69 @@ class TransportFlowControl final : public TransportFlowControlBase {
   /** should we probe bdp? */
   const bool enable_bdp_probe_;
 
-  /* bdp estimation */
-  BdpEstimator bdp_estimator_;
-
   /* pid controller */
   PidController pid_controller_;
   Timestamp last_pid_update_;
+
+  /** max of the recently received message sizes, decaying with each new
+      message so that it tracks the large end of the size distribution */
+  double large_message_size_ = 0;
+};
+
+// The model behind TransportFlowControlBbr, in the spirit of BBR: every
+// completed BDP ping is a sample of the delivery rate and of the round trip
+// time. The window is sized to a gain times the product of the bottleneck
+// bandwidth (windowed max of the delivery rate) and the min RTT (windowed min
+// of the ping RTTs). A high gain is used until the bandwidth stops growing so
+// that long fat pipes ramp up within a few round trips, after which the
+// window tracks the model closely instead of overshooting it.
+class BbrWindowModel {
+ public:
+  explicit BbrWindowModel(Timestamp now) : min_rtt_stamp_(now) {}
+
+  // Adds a sample of the delivery rate, in bytes per second, and of the RTT,
+  // in seconds, taken at now.
+  void AddSample(double bandwidth, double rtt, Timestamp now);
+
+  // The window to aim for at the given memory pressure. Until the first
+  // sample, this is current_window. Memory pressure only ever shrinks it.
+  double TargetWindow(double current_window, double memory_pressure) const;
+
+  double bottleneck_bandwidth() const;
+  double min_rtt() const { return min_rtt_; }
+  // Whether startup is over, and the window uses the steady state gain.
+  bool filled_pipe() const { return filled_pipe_; }
+
+ private:
+  // Number of ping samples over which the max delivery rate is taken.
+  static constexpr int kBandwidthWindow = 10;
+
+  double bandwidth_samples_[kBandwidthWindow] = {};
+  int next_bandwidth_sample_ = 0;
+  double min_rtt_ = 0;
+  Timestamp min_rtt_stamp_;
+  // Startup ends once the bottleneck bandwidth fails to grow by a quarter
+  // for a few samples in a row.
+  bool filled_pipe_ = false;
+  double full_bandwidth_ = 0;
+  int full_bandwidth_count_ = 0;
+};
+
+// Model based variant of TransportFlowControl: rather than growing the BDP
+// estimate in steps and smoothing it through a PID controller, the windows
+// are sized by a BbrWindowModel fed with the completed BDP pings.
+class TransportFlowControlBbr final : public TransportFlowControl {
+ public:
+  TransportFlowControlBbr(const grpc_chttp2_transport* t,
+                          bool enable_bdp_probe);
+
+  FlowControlAction PeriodicUpdate() override;
+
+  const BbrWindowModel& model() const { return model_; }
+
+ private:
+  int64_t samples_seen_ = 0;
+  BbrWindowModel model_;
 };
 
 // Fat interface with all methods a stream flow control implementation needs
@@ -68,6 +68,12 @@ grpc_error_handle grpc_chttp2_data_parser_begin_frame(
   return GRPC_ERROR_NONE;
 }
 
+// DATA frames with at most this many payload bytes are written as one
+// slice holding the frame header and a copy of the payload, which for a
+// small message includes its length prefix. Copying that little costs less
+// than the extra slices and iovecs of the zero-copy path.
+static constexpr uint32_t kMaxCopiedDataFramePayload = 1024;
+
 void grpc_chttp2_encode_data(uint32_t id, grpc_slice_buffer* inbuf,
                              uint32_t write_bytes, int is_eof,
                              grpc_transport_one_way_stats* stats,
@@ -76,7 +82,8 @@ void grpc_chttp2_encode_data(uint32_t id, grpc_slice_buffer* inbuf,
   uint8_t* p;
   static const size_t header_size = 9;
 
-  hdr = GRPC_SLICE_MALLOC(header_size);
+  const bool copy_payload = write_bytes <= kMaxCopiedDataFramePayload;
+  hdr = GRPC_SLICE_MALLOC(header_size + (copy_payload ? write_bytes : 0));
   p = GRPC_SLICE_START_PTR(hdr);
   GPR_ASSERT(write_bytes < (1 << 24));
   *p++ = static_cast<uint8_t>(write_bytes >> 16);
@@ -88,9 +95,13 @@ void grpc_chttp2_encode_data(uint32_t id, grpc_slice_buffer* inbuf,
   *p++ = static_cast<uint8_t>(id >> 16);
   *p++ = static_cast<uint8_t>(id >> 8);
   *p++ = static_cast<uint8_t>(id);
-  grpc_slice_buffer_add(outbuf, hdr);
-
-  grpc_slice_buffer_move_first_no_ref(inbuf, write_bytes, outbuf);
+  if (copy_payload) {
+    grpc_slice_buffer_move_first_into_buffer(inbuf, write_bytes, p);
+    grpc_slice_buffer_add(outbuf, hdr);
+  } else {
+    grpc_slice_buffer_add(outbuf, hdr);
+    grpc_slice_buffer_move_first_no_ref(inbuf, write_bytes, outbuf);
+  }
 
   stats->framing_bytes += header_size;
   stats->data_bytes += write_bytes;
@@ -190,6 +201,7 @@ grpc_error_handle grpc_deframe_unprocessed_incoming_frames(
         if (t->channelz_socket != nullptr) {
           t->channelz_socket->RecordMessageReceived();
         }
+        t->flow_control->RecvMessageHeader(p->frame_size);
         p->state = GRPC_CHTTP2_DATA_FRAME;
         ++cur;
         message_flags = 0;
@@ -41,6 +41,11 @@
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_POSIX_SOCKET_TCP
+#include "src/core/lib/iomgr/tcp_posix.h"
+#endif  // GRPC_POSIX_SOCKET_TCP
 
 static uint8_t* fill_header(uint8_t* out, uint32_t length, uint8_t flags) {
   *out++ = static_cast<uint8_t>(length >> 16);
@@ -269,6 +274,12 @@ grpc_error_handle grpc_chttp2_settings_parser_parse(void* p,
             }
           }
           parser->incoming_settings[id] = parser->value;
+#ifdef GRPC_POSIX_SOCKET_TCP
+          if (id == GRPC_CHTTP2_SETTINGS_GRPC_ALLOW_UNIX_FD_PASSING &&
+              parser->value == 1 && t->ep != nullptr) {
+            grpc_tcp_enable_fd_passing(t->ep);
+          }
+#endif  // GRPC_POSIX_SOCKET_TCP
           if (GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
             gpr_log(GPR_INFO, "CHTTP2:%s:%s: got setting %s = %d",
                     t->is_client ? "CLI" : "SVR", t->peer_string.c_str(),
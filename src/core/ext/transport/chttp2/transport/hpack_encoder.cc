@@ -159,6 +159,7 @@ uint8_t* HPackCompressor::Framer::AddTiny(size_t len) {
 
 void HPackCompressor::Framer::EmitIndexed(uint32_t elem_index) {
   GRPC_STATS_INC_HPACK_SEND_INDEXED();
+  compressor_->indexed_fields_sent_++;
   VarintWriter<1> w(elem_index);
   w.Write(0x80, AddTiny(w.length()));
 }
@@ -270,6 +271,7 @@ class StringKey {
 void HPackCompressor::Framer::EmitLitHdrWithNonBinaryStringKeyIncIdx(
     Slice key_slice, Slice value_slice) {
   GRPC_STATS_INC_HPACK_SEND_LITHDR_INCIDX_V();
+  compressor_->literal_fields_sent_++;
   GRPC_STATS_INC_HPACK_SEND_UNCOMPRESSED();
   StringKey key(std::move(key_slice));
   key.WritePrefix(0x40, AddTiny(key.prefix_length()));
@@ -282,6 +284,7 @@ void HPackCompressor::Framer::EmitLitHdrWithNonBinaryStringKeyIncIdx(
 void HPackCompressor::Framer::EmitLitHdrWithBinaryStringKeyNotIdx(
     Slice key_slice, Slice value_slice) {
   GRPC_STATS_INC_HPACK_SEND_LITHDR_NOTIDX_V();
+  compressor_->literal_fields_sent_++;
   GRPC_STATS_INC_HPACK_SEND_UNCOMPRESSED();
   StringKey key(std::move(key_slice));
   key.WritePrefix(0x00, AddTiny(key.prefix_length()));
@@ -294,6 +297,7 @@ void HPackCompressor::Framer::EmitLitHdrWithBinaryStringKeyNotIdx(
 void HPackCompressor::Framer::EmitLitHdrWithBinaryStringKeyIncIdx(
     Slice key_slice, Slice value_slice) {
   GRPC_STATS_INC_HPACK_SEND_LITHDR_INCIDX_V();
+  compressor_->literal_fields_sent_++;
   GRPC_STATS_INC_HPACK_SEND_UNCOMPRESSED();
   StringKey key(std::move(key_slice));
   key.WritePrefix(0x40, AddTiny(key.prefix_length()));
@@ -306,6 +310,7 @@ void HPackCompressor::Framer::EmitLitHdrWithBinaryStringKeyIncIdx(
 void HPackCompressor::Framer::EmitLitHdrWithBinaryStringKeyNotIdx(
     uint32_t key_index, Slice value_slice) {
   GRPC_STATS_INC_HPACK_SEND_LITHDR_NOTIDX();
+  compressor_->literal_fields_sent_++;
   GRPC_STATS_INC_HPACK_SEND_UNCOMPRESSED();
   BinaryStringValue emit(std::move(value_slice), use_true_binary_metadata_);
   VarintWriter<4> key(key_index);
@@ -318,6 +323,7 @@ void HPackCompressor::Framer::EmitLitHdrWithBinaryStringKeyNotIdx(
 void HPackCompressor::Framer::EmitLitHdrWithNonBinaryStringKeyNotIdx(
     Slice key_slice, Slice value_slice) {
   GRPC_STATS_INC_HPACK_SEND_LITHDR_NOTIDX_V();
+  compressor_->literal_fields_sent_++;
   GRPC_STATS_INC_HPACK_SEND_UNCOMPRESSED();
   StringKey key(std::move(key_slice));
   key.WritePrefix(0x00, AddTiny(key.prefix_length()));
@@ -378,12 +384,76 @@ void HPackCompressor::SliceIndex::EmitTo(absl::string_view key,
   values_.emplace_back(value.Ref(), index);
 }
 
+void HPackCompressor::KeyIndex::EmitTo(const Slice& value, Framer* framer) {
+  auto& table = framer->compressor_->table_;
+  if (encodes_ == kWindow) {
+    const bool track_values = !track_values_ || hits_ * 16 >= encodes_;
+    if (track_values != track_values_ &&
+        GRPC_TRACE_FLAG_ENABLED(grpc_http_trace)) {
+      gpr_log(GPR_INFO, "%s indexing the values of %s: %u hits in %u",
+              track_values ? "resume" : "stop",
+              std::string(key_.as_string_view()).c_str(), hits_, encodes_);
+    }
+    track_values_ = track_values;
+    if (!track_values_) values_.clear();
+    encodes_ = 0;
+    hits_ = 0;
+  }
+  ++encodes_;
+  const uint32_t transport_length =
+      key_.length() + value.length() + hpack_constants::kEntryOverhead;
+  if (!track_values_ || transport_length > HPackEncoderTable::MaxEntrySize()) {
+    framer->EmitLitHdrWithNonBinaryStringKeyNotIdx(key_.Ref(), value.Ref());
+    return;
+  }
+  using It = std::vector<ValueIndex>::iterator;
+  It prev = values_.end();
+  for (It it = values_.begin(); it != values_.end(); ++it) {
+    if (value == it->value) {
+      if (table.ConvertableToDynamicIndex(it->index)) {
+        ++hits_;
+        framer->EmitIndexed(table.DynamicIndex(it->index));
+      } else {
+        // The value repeats: from now on it is worth a table entry.
+        it->index = table.AllocateIndex(transport_length);
+        framer->EmitLitHdrWithNonBinaryStringKeyIncIdx(key_.Ref(),
+                                                       value.Ref());
+      }
+      if (prev != values_.end()) std::swap(*prev, *it);
+      return;
+    }
+    prev = it;
+  }
+  // First sighting: send it as a literal, and remember it in place of the
+  // least recently hit value.
+  framer->EmitLitHdrWithNonBinaryStringKeyNotIdx(key_.Ref(), value.Ref());
+  if (values_.size() == kMaxValues) values_.pop_back();
+  values_.emplace_back(value.Ref(), 0);
+}
+
 void HPackCompressor::Framer::Encode(const Slice& key, const Slice& value) {
+  const PreEncodedMetadata* pre_encoded =
+      PreEncodedMetadata::FromValue(value.c_slice());
+  if (pre_encoded != nullptr && EncodePreEncoded(*pre_encoded, key, value)) {
+    return;
+  }
   if (absl::EndsWith(key.as_string_view(), "-bin")) {
     EmitLitHdrWithBinaryStringKeyNotIdx(key.Ref(), value.Ref());
-  } else {
-    EmitLitHdrWithNonBinaryStringKeyNotIdx(key.Ref(), value.Ref());
+    return;
+  }
+  auto& key_indices = compressor_->key_indices_;
+  for (auto& key_index : key_indices) {
+    if (key_index.key() == key) {
+      key_index.EmitTo(value, this);
+      return;
+    }
+  }
+  if (key_indices.size() < kMaxIndexedKeys) {
+    key_indices.emplace_back(key.Ref());
+    key_indices.back().EmitTo(value, this);
+    return;
   }
+  EmitLitHdrWithNonBinaryStringKeyNotIdx(key.Ref(), value.Ref());
 }
 
 void HPackCompressor::Framer::Encode(HttpPathMetadata, const Slice& value) {
@@ -521,6 +591,31 @@ void HPackCompressor::Framer::EncodeIndexedKeyWithBinaryValue(
   }
 }
 
+bool HPackCompressor::Framer::EncodePreEncoded(const PreEncodedMetadata& md,
+                                               const Slice& key,
+                                               const Slice& value) {
+  // Binary values are sent base64 encoded unless the peer accepts true binary
+  // metadata, so their size in the peer's table is not known up front.
+  if (md.id() >= kMaxCachedPreEncodedMetadataId ||
+      key.as_string_view() != md.key() ||
+      absl::EndsWith(md.key(), "-bin")) {
+    return false;
+  }
+  const uint32_t transport_length =
+      key.length() + value.length() + hpack_constants::kEntryOverhead;
+  if (transport_length > HPackEncoderTable::MaxEntrySize()) return false;
+  auto& cache = compressor_->pre_encoded_index_;
+  if (md.id() >= cache.size()) cache.resize(md.id() + 1);
+  uint32_t* index = &cache[md.id()];
+  if (compressor_->table_.ConvertableToDynamicIndex(*index)) {
+    EmitIndexed(compressor_->table_.DynamicIndex(*index));
+  } else {
+    *index = compressor_->table_.AllocateIndex(transport_length);
+    EmitLitHdrWithNonBinaryStringKeyIncIdx(key.Ref(), value.Ref());
+  }
+  return true;
+}
+
 void HPackCompressor::Framer::Encode(GrpcTimeoutMetadata, Timestamp deadline) {
   Timeout timeout = Timeout::FromDuration(deadline - ExecCtx::Get()->Now());
   for (auto it = compressor_->previous_timeouts_.begin();
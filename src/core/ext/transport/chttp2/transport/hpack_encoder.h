@@ -50,6 +50,7 @@ namespace grpc_core {
 
 class HPackCompressor {
   class SliceIndex;
+  class KeyIndex;
 
  public:
   HPackCompressor() = default;
@@ -65,6 +66,11 @@ class HPackCompressor {
     return table_.test_only_table_size();
   }
 
+  // Header fields sent as (static or dynamic) table indices and as literals
+  // so far.
+  uint64_t indexed_fields_sent() const { return indexed_fields_sent_; }
+  uint64_t literal_fields_sent() const { return literal_fields_sent_; }
+
   struct EncodeHeaderOptions {
     uint32_t stream_id;
     bool is_end_of_stream;
@@ -123,6 +129,7 @@ class HPackCompressor {
 
    private:
     friend class SliceIndex;
+    friend class KeyIndex;
 
     struct FramePrefix {
       // index (in output_) of the header for the frame
@@ -153,6 +160,9 @@ class HPackCompressor {
                              Slice value, uint32_t transport_length);
     void EncodeIndexedKeyWithBinaryValue(uint32_t* index, absl::string_view key,
                                          Slice value);
+    // Returns false if md cannot be cached, leaving it to the caller.
+    bool EncodePreEncoded(const PreEncodedMetadata& md, const Slice& key,
+                          const Slice& value);
 
     size_t CurrentFrameSize() const;
     void Add(Slice slice);
@@ -174,6 +184,13 @@ class HPackCompressor {
  private:
   static constexpr size_t kNumFilterValues = 64;
   static constexpr uint32_t kNumCachedGrpcStatusValues = 16;
+  // Pre-encoded metadata elements with larger ids are sent as plain literals,
+  // bounding the per-connection cache should an application create elements
+  // per call rather than once.
+  static constexpr uint32_t kMaxCachedPreEncodedMetadataId = 4096;
+  // Metadata keys with no dedicated encoding whose values are considered for
+  // the table; the values of other keys are sent as plain literals.
+  static constexpr size_t kMaxIndexedKeys = 16;
 
   // maximum number of bytes we'll use for the decode table (to guard against
   // peers ooming us by setting decode table size high)
@@ -182,21 +199,55 @@ class HPackCompressor {
   // of this size
   bool advertise_table_size_change_ = false;
   HPackEncoderTable table_;
+  uint64_t indexed_fields_sent_ = 0;
+  uint64_t literal_fields_sent_ = 0;
+
+  struct ValueIndex {
+    ValueIndex(Slice value, uint32_t index)
+        : value(std::move(value)), index(index) {}
+    Slice value;
+    uint32_t index;
+  };
 
   class SliceIndex {
    public:
     void EmitTo(absl::string_view key, const Slice& value, Framer* framer);
 
    private:
-    struct ValueIndex {
-      ValueIndex(Slice value, uint32_t index)
-          : value(std::move(value)), index(index) {}
-      Slice value;
-      uint32_t index;
-    };
     std::vector<ValueIndex> values_;
   };
 
+  // Adds the values of a metadata key with no dedicated encoding to the
+  // table only once they repeat, so that values unique to a request, like
+  // request ids, are sent as literals instead of evicting the entries that
+  // are reused.
+  class KeyIndex {
+   public:
+    explicit KeyIndex(Slice key) : key_(std::move(key)) {}
+
+    const Slice& key() const { return key_; }
+    void EmitTo(const Slice& value, Framer* framer);
+
+   private:
+    // Values are remembered over this many encodes of the key at most.
+    static constexpr size_t kMaxValues = 8;
+    // The hit rate of the key is computed over windows of this many encodes.
+    static constexpr uint32_t kWindow = 256;
+
+    Slice key_;
+    // Most recently hit first. The index of a value seen only once is 0,
+    // which never refers to the table.
+    std::vector<ValueIndex> values_;
+    // Encodes of the key in the current window, and how many of them were
+    // sent as an index into the table.
+    uint32_t encodes_ = 0;
+    uint32_t hits_ = 0;
+    // Cleared for the window that follows a window in which less than one
+    // encode in 16 hit, so that keys with a value per request are not
+    // compared against the values seen before.
+    bool track_values_ = true;
+  };
+
   struct PreviousTimeout {
     Timeout timeout;
     uint32_t index;
@@ -224,7 +275,11 @@ class HPackCompressor {
   Slice user_agent_;
   SliceIndex path_index_;
   SliceIndex authority_index_;
+  std::vector<KeyIndex> key_indices_;
   std::vector<PreviousTimeout> previous_timeouts_;
+  // Index into table_ for each pre-encoded metadata element sent on this
+  // connection, by PreEncodedMetadata::id()
+  std::vector<uint32_t> pre_encoded_index_;
 };
 
 }  // namespace grpc_core
@@ -145,6 +145,7 @@ grpc_error_handle HPackTable::Add(Memento md) {
     // empty table.
     while (entries_.num_entries()) {
       EvictOne();
+      ++num_evictions_;
     }
     return GRPC_ERROR_NONE;
   }
@@ -153,6 +154,7 @@ grpc_error_handle HPackTable::Add(Memento md) {
   while (md.transport_size() >
          static_cast<size_t>(current_table_bytes_) - mem_used_) {
     EvictOne();
+    ++num_evictions_;
   }
 
   // copy the finalized entry in
@@ -67,6 +67,13 @@ class HPackTable {
   // Current entry count in the table.
   uint32_t num_entries() const { return entries_.num_entries(); }
 
+  // Memory used by the table, according to the hpack algorithm.
+  uint32_t mem_used() const { return mem_used_; }
+
+  // Number of entries evicted to make room for new ones so far. A table that
+  // keeps evicting is too small for the headers the peer is indexing.
+  uint64_t num_evictions() const { return num_evictions_; }
+
  private:
   struct StaticMementos {
     StaticMementos();
@@ -121,6 +128,8 @@ class HPackTable {
   uint32_t max_bytes_ = hpack_constants::kInitialTableSize;
   // The currently agreed size of the table, according to the hpack algorithm.
   uint32_t current_table_bytes_ = hpack_constants::kInitialTableSize;
+  // Entries evicted by Add.
+  uint64_t num_evictions_ = 0;
   // HPack table entries
   MementoRingBuffer entries_;
   // Mementos for static data
@@ -33,9 +33,10 @@ enum grpc_chttp2_setting_id {
   GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE = 4,                  /* wire id 5 */
   GRPC_CHTTP2_SETTINGS_MAX_HEADER_LIST_SIZE = 5,            /* wire id 6 */
   GRPC_CHTTP2_SETTINGS_GRPC_ALLOW_TRUE_BINARY_METADATA = 6, /* wire id 65027 */
+  GRPC_CHTTP2_SETTINGS_GRPC_ALLOW_UNIX_FD_PASSING = 8,      /* wire id 65029 */
 };
 
-#define GRPC_CHTTP2_NUM_SETTINGS 7
+#define GRPC_CHTTP2_NUM_SETTINGS 9
 
 extern const uint16_t grpc_setting_id_to_wire_id[];
 
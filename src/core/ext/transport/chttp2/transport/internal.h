@@ -45,7 +45,9 @@
 #include "src/core/ext/transport/chttp2/transport/http2_settings.h"
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/channel/tx_latency_reporter.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/bitset.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
@@ -297,6 +299,67 @@ class Chttp2IncomingByteStream : public ByteStream {
   grpc_closure destroy_action_;
 };
 
+// Frame level statistics of a transport, exposed through its channelz socket.
+// Each counter has a single writer at a time (the combiner, or the endpoint
+// write in flight), so they are bumped with relaxed loads and stores instead
+// of read-modify-write atomics; channelz may read them at any time.
+class Chttp2TransportStats final : public channelz::SocketNode::TransportStats {
+ public:
+  // Frame types are indexed by their wire value; anything else (eg. PRIORITY
+  // or unknown extension frames) is counted under kOtherFrameType.
+  static constexpr uint8_t kOtherFrameType = GRPC_CHTTP2_FRAME_CONTINUATION + 1;
+
+  explicit Chttp2TransportStats(bool is_client);
+
+  void RecordFrameReceived(uint8_t type) {
+    Bump(&frames_received_[std::min(type, kOtherFrameType)]);
+  }
+  // Counts the write and the frames in it; outbuf must hold whole frames
+  // (plus, on the client's first write, the connection preface).
+  void RecordWrite(const grpc_slice_buffer& outbuf);
+  void RecordHpackFieldsSent(uint64_t indexed, uint64_t literal) {
+    hpack_indexed_fields_sent_.store(indexed, std::memory_order_relaxed);
+    hpack_literal_fields_sent_.store(literal, std::memory_order_relaxed);
+  }
+  // A stream could not send DATA because the transport window was exhausted.
+  void RecordTransportStalled(Timestamp now);
+  // The transport window opened up again.
+  void RecordTransportUnstalled(Timestamp now);
+  void RecordPingRtt(double rtt_seconds);
+  // Bytes the transport currently has reserved under category.
+  void RecordMemoryReserved(MemoryCategory category, size_t bytes) {
+    memory_reserved_[static_cast<size_t>(category)].store(
+        bytes, std::memory_order_relaxed);
+  }
+
+  void PopulateOptions(Json::Array* options) override;
+
+ private:
+  static void Bump(std::atomic<uint64_t>* counter, uint64_t delta = 1) {
+    counter->store(counter->load(std::memory_order_relaxed) + delta,
+                   std::memory_order_relaxed);
+  }
+
+  // Only accessed by the writer.
+  size_t preface_bytes_to_skip_;
+
+  std::atomic<uint64_t> frames_sent_[kOtherFrameType + 1] = {};
+  std::atomic<uint64_t> frames_received_[kOtherFrameType + 1] = {};
+  std::atomic<uint64_t> hpack_indexed_fields_sent_{0};
+  std::atomic<uint64_t> hpack_literal_fields_sent_{0};
+  std::atomic<uint64_t> writes_{0};
+  std::atomic<uint64_t> bytes_written_{0};
+  std::atomic<uint64_t> max_write_size_{0};
+  std::atomic<uint64_t> transport_stalls_{0};
+  std::atomic<int64_t> transport_stall_millis_{0};
+  std::atomic<size_t> memory_reserved_[kNumMemoryCategories] = {};
+  // Start of the current transport stall in milliseconds after the process
+  // epoch, or -1 if not stalled.
+  std::atomic<int64_t> transport_stall_start_{-1};
+  std::atomic<int64_t> last_ping_rtt_micros_{0};
+  std::atomic<int64_t> min_ping_rtt_micros_{0};
+};
+
 }  // namespace grpc_core
 
 typedef enum {
@@ -318,6 +381,10 @@ struct grpc_chttp2_transport {
 
   grpc_core::MemoryOwner memory_owner;
   const grpc_core::MemoryAllocator::Reservation self_reservation;
+  // Bytes reserved from memory_owner for the HPACK decoder table, and for the
+  // write handed to the endpoint.
+  size_t hpack_table_reserved_bytes = 0;
+  size_t pending_write_reserved_bytes = 0;
   grpc_core::ReclamationSweep active_reclamation;
 
   grpc_core::Combiner* combiner;
@@ -346,6 +413,27 @@ struct grpc_chttp2_transport {
   grpc_closure write_action;
   grpc_closure write_action_end_locked;
 
+  /* write coalescing (GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_US) */
+  /** how long a small write may be held back; 0 disables coalescing */
+  int64_t write_coalescing_delay_us = 0;
+  /** outbuf size at which a held write is flushed right away */
+  size_t write_coalescing_bytes = 16 * 1024;
+  /** is a gathered write sitting in outbuf until the window closes? */
+  bool write_coalescing_held = false;
+  /** has write_coalescing_timer been armed without its callback running? */
+  bool write_coalescing_timer_pending = false;
+  /** is write_coalescing_gather_locked scheduled on the combiner? */
+  bool write_coalescing_gather_pending = false;
+  /** when the current window opened, and when the last write was started
+      (monotonic clock, microseconds) */
+  int64_t write_coalescing_start_us = 0;
+  int64_t last_write_start_us = 0;
+  grpc_timer write_coalescing_timer;
+  grpc_closure write_coalescing_timer_fired_locked;
+  grpc_closure write_coalescing_gather_locked;
+  /** when the frames the next write will gather started waiting for it */
+  gpr_cycle_counter write_initiated_cycle = 0;
+
   grpc_closure read_action_locked;
 
   /** incoming read bytes */
@@ -378,6 +466,23 @@ struct grpc_chttp2_transport {
    */
   uint32_t write_buffer_size = grpc_core::chttp2::kDefaultWindow;
 
+  /** how many DATA bytes a writable stream may write each time its turn comes
+      up, before yielding to the other writable streams (deficit round robin);
+      0 means no limit */
+  uint32_t stream_write_quantum = 16 * 1024;
+
+  /** size the flow control windows from the BBR style bandwidth/RTT model
+      (TransportFlowControlBbr) rather than the default BDP estimator */
+  bool bbr_flow_control = false;
+
+  /** re-tune MAX_FRAME_SIZE and HEADER_TABLE_SIZE from the observed traffic
+      (GRPC_ARG_HTTP2_SETTINGS_AUTO_TUNING) */
+  bool settings_auto_tuning = false;
+  /** was HEADER_TABLE_SIZE set from the channel args, ruling out tuning it */
+  bool header_table_size_configured = false;
+  /** hpack parser table evictions at the last HEADER_TABLE_SIZE tuning step */
+  uint64_t last_hpack_table_evictions = 0;
+
   /** Set to a grpc_error object if a goaway frame is received. By default, set
    * to GRPC_ERROR_NONE */
   grpc_error_handle goaway_error = GRPC_ERROR_NONE;
@@ -430,6 +535,7 @@ struct grpc_chttp2_transport {
   grpc_core::PolymorphicManualConstructor<
       grpc_core::chttp2::TransportFlowControlBase,
       grpc_core::chttp2::TransportFlowControl,
+      grpc_core::chttp2::TransportFlowControlBbr,
       grpc_core::chttp2::TransportFlowControlDisabled>
       flow_control;
   /** initial window change. This is tracked as we parse settings frames from
@@ -501,6 +607,9 @@ struct grpc_chttp2_transport {
   grpc_timer keepalive_watchdog_timer;
   /** time duration in between pings */
   grpc_core::Duration keepalive_time;
+  /** time of the last read (or BDP ping); the next keepalive ping is due
+      keepalive_time after it */
+  grpc_core::Timestamp keepalive_last_activity;
   /** grace period for a ping to complete before watchdog kicks in */
   grpc_core::Duration keepalive_timeout;
   /** if keepalive pings are allowed when there's no outstanding streams */
@@ -511,6 +620,8 @@ struct grpc_chttp2_transport {
   grpc_chttp2_keepalive_state keepalive_state;
   grpc_core::ContextList* cl = nullptr;
   grpc_core::RefCountedPtr<grpc_core::channelz::SocketNode> channelz_socket;
+  /** frame level statistics rendered by channelz_socket; null iff it is */
+  grpc_core::RefCountedPtr<grpc_core::Chttp2TransportStats> channelz_stats;
   uint32_t num_messages_in_next_write = 0;
   /** The number of pending induced frames (SETTINGS_ACK, PINGS_ACK and
    * RST_STREAM) in the outgoing buffer (t->qbuf). If this number goes beyond
@@ -615,6 +726,9 @@ struct grpc_chttp2_stream {
   grpc_metadata_batch trailing_metadata_buffer;
 
   grpc_slice_buffer frame_storage; /* protected by t combiner */
+  /** if nonzero, bound on the bytes the peer may send ahead of the reads of
+      the application, from the last recv_message op */
+  uint32_t max_buffered_bytes = 0; /* protected by t combiner */
 
   grpc_closure* on_next = nullptr;  /* protected by t combiner */
   bool pending_byte_stream = false; /* protected by t combiner */
@@ -661,11 +775,18 @@ struct grpc_chttp2_stream {
   grpc_chttp2_write_cb* on_write_finished_cbs = nullptr;
   grpc_chttp2_write_cb* finish_after_write = nullptr;
   size_t sending_bytes = 0;
+  /** Deficit round robin credit: how many more DATA bytes this stream may
+      write before it has to go to the back of the writable list */
+  uint32_t write_deficit = 0;
 
   /** Whether the bytes needs to be traced using Fathom */
   bool traced = false;
   /** Byte counter for number of bytes written */
   size_t byte_counter = 0;
+  /** Receives the TX timestamps of the writes carrying this stream, if the
+      call asked for them. Only set from perform_stream_op(), before the first
+      traced op reaches the combiner. */
+  grpc_core::RefCountedPtr<grpc_core::TxLatencyReporter> tx_latency_reporter;
 };
 
 /** Transport writing call flow:
@@ -50,6 +50,7 @@
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/transport/bdp_estimator.h"
 #include "src/core/lib/transport/http2_errors.h"
 #include "src/core/lib/transport/metadata_batch.h"
@@ -76,6 +77,7 @@ static grpc_error_handle parse_frame_slice(grpc_chttp2_transport* t,
 
 grpc_error_handle grpc_chttp2_perform_read(grpc_chttp2_transport* t,
                                            const grpc_slice& slice) {
+  GPR_TIMER_SCOPE("grpc_chttp2_perform_read", 0);
   const uint8_t* beg = GRPC_SLICE_START_PTR(slice);
   const uint8_t* end = GRPC_SLICE_END_PTR(slice);
   const uint8_t* cur = beg;
@@ -196,6 +198,9 @@ grpc_error_handle grpc_chttp2_perform_read(grpc_chttp2_transport* t,
       GPR_DEBUG_ASSERT(cur < end);
       t->incoming_stream_id |= (static_cast<uint32_t>(*cur));
       t->deframe_state = GRPC_DTS_FRAME;
+      if (t->channelz_stats != nullptr) {
+        t->channelz_stats->RecordFrameReceived(t->incoming_frame_type);
+      }
       err = init_frame_parser(t);
       if (err != GRPC_ERROR_NONE) {
         return err;
@@ -271,6 +276,9 @@ grpc_error_handle grpc_chttp2_perform_read(grpc_chttp2_transport* t,
 }
 
 static grpc_error_handle init_frame_parser(grpc_chttp2_transport* t) {
+  grpc_core::TraceRing::Record(&grpc_http_trace, "frame_received",
+                               t->incoming_frame_type, t->incoming_stream_id,
+                               t->incoming_frame_size);
   if (t->is_first_frame &&
       t->incoming_frame_type != GRPC_CHTTP2_FRAME_SETTINGS) {
     return GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrCat(
@@ -651,6 +659,7 @@ static grpc_error_handle init_settings_frame_parser(grpc_chttp2_transport* t) {
 static grpc_error_handle parse_frame_slice(grpc_chttp2_transport* t,
                                            const grpc_slice& slice,
                                            int is_last) {
+  GPR_TIMER_SCOPE("parse_frame_slice", 0);
   grpc_chttp2_stream* s = t->incoming_stream;
   grpc_error_handle err = t->parser(t->parser_data, t, s, slice, is_last);
   intptr_t unused;
@@ -21,20 +21,68 @@
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
 
 #include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+/* grow once more than 3/4 of the slots are in use */
+static bool over_max_load(size_t count, size_t capacity) {
+  return count * 4 > capacity * 3;
+}
+
+/* Stream ids are allocated sequentially (with a stride of two), so use
+   Fibonacci hashing: multiply by 2^64 / phi and keep the top bits, which
+   spreads any run of consecutive ids almost evenly over the table. */
+static size_t home_slot(uint32_t key, int shift) {
+  return static_cast<size_t>((key * uint64_t{0x9e3779b97f4a7c15}) >> shift);
+}
+
+static void alloc_slots(grpc_chttp2_stream_map* map, size_t capacity) {
+  map->keys = static_cast<uint32_t*>(gpr_malloc(sizeof(uint32_t) * capacity));
+  map->values = static_cast<void**>(gpr_malloc(sizeof(void*) * capacity));
+  memset(map->keys, 0, sizeof(uint32_t) * capacity);
+  map->capacity = capacity;
+  map->hash_shift = 64;
+  while (capacity > 1) {
+    map->hash_shift--;
+    capacity /= 2;
+  }
+}
+
+/* insert a key known not to be present; the table must have a free slot */
+static void insert(grpc_chttp2_stream_map* map, uint32_t key, void* value) {
+  size_t mask = map->capacity - 1;
+  size_t i = home_slot(key, map->hash_shift);
+  while (map->keys[i] != 0) {
+    i = (i + 1) & mask;
+  }
+  map->keys[i] = key;
+  map->values[i] = value;
+}
+
+static void grow(grpc_chttp2_stream_map* map) {
+  uint32_t* old_keys = map->keys;
+  void** old_values = map->values;
+  size_t old_capacity = map->capacity;
+  alloc_slots(map, 2 * old_capacity);
+  for (size_t i = 0; i < old_capacity; i++) {
+    if (old_keys[i] != 0) insert(map, old_keys[i], old_values[i]);
+  }
+  gpr_free(old_keys);
+  gpr_free(old_values);
+}
+
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity) {
   GPR_DEBUG_ASSERT(initial_capacity > 1);
-  map->keys =
-      static_cast<uint32_t*>(gpr_malloc(sizeof(uint32_t) * initial_capacity));
-  map->values =
-      static_cast<void**>(gpr_malloc(sizeof(void*) * initial_capacity));
+  size_t capacity = 2;
+  while (capacity < initial_capacity) capacity *= 2;
+  alloc_slots(map, capacity);
   map->count = 0;
-  map->free = 0;
-  map->capacity = initial_capacity;
+  map->last_key = 0;
 }
 
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map) {
@@ -42,136 +90,105 @@ void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map) {
   gpr_free(map->values);
 }
 
-static size_t compact(uint32_t* keys, void** values, size_t count) {
-  size_t i, out;
-
-  for (i = 0, out = 0; i < count; i++) {
-    if (values[i]) {
-      keys[out] = keys[i];
-      values[out] = values[i];
-      out++;
-    }
-  }
-
-  return out;
-}
-
 void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
                                 void* value) {
-  size_t count = map->count;
-  size_t capacity = map->capacity;
-  uint32_t* keys = map->keys;
-  void** values = map->values;
-
-  // The first assertion ensures that the table is monotonically increasing.
-  GPR_ASSERT(count == 0 || keys[count - 1] < key);
+  // The first assertion ensures that keys are monotonically increasing, and
+  // since zero marks empty slots it also rejects key 0.
+  GPR_ASSERT(map->last_key < key);
   GPR_DEBUG_ASSERT(value);
   // Asserting that the key is not already in the map can be a debug assertion.
-  // Why: we're already checking that the map elements are monotonically
-  // increasing. If we re-add a key, i.e. if the key is already present, then
-  // either it is the most recently added key in the map (in which case the
-  // first assertion fails due to key == last_key) or there is a more recently
-  // added (larger) key at the end of the map: in which case the first assertion
-  // still fails due to key < last_key.
+  // Why: we're already checking that keys are monotonically increasing. If we
+  // re-add a key, i.e. if the key is already present, then it is at most the
+  // largest key added so far, and the first assertion fails.
   GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
 
-  if (count == capacity) {
-    if (map->free > capacity / 4) {
-      count = compact(keys, values, count);
-      map->free = 0;
-    } else {
-      /* resize when less than 25% of the table is free, because compaction
-         won't help much */
-      map->capacity = capacity = 2 * capacity;
-      map->keys = keys = static_cast<uint32_t*>(
-          gpr_realloc(keys, capacity * sizeof(uint32_t)));
-      map->values = values =
-          static_cast<void**>(gpr_realloc(values, capacity * sizeof(void*)));
-    }
+  if (over_max_load(map->count + 1, map->capacity)) {
+    grow(map);
   }
-
-  keys[count] = key;
-  values[count] = value;
-  map->count = count + 1;
+  insert(map, key, value);
+  map->count++;
+  map->last_key = key;
 }
 
-template <bool strict_find>
-static void** find(grpc_chttp2_stream_map* map, uint32_t key) {
-  size_t min_idx = 0;
-  size_t max_idx = map->count;
-  size_t mid_idx;
+/* returns the slot holding key, or capacity if it is not present */
+static size_t find_slot(grpc_chttp2_stream_map* map, uint32_t key) {
+  size_t mask = map->capacity - 1;
   uint32_t* keys = map->keys;
-  void** values = map->values;
-  uint32_t mid_key;
-
-  GPR_DEBUG_ASSERT(!strict_find || max_idx > 0);
-  if (!strict_find && max_idx == 0) return nullptr;
-
-  while (min_idx < max_idx) {
-    /* find the midpoint, avoiding overflow */
-    mid_idx = min_idx + ((max_idx - min_idx) / 2);
-    mid_key = keys[mid_idx];
-
-    if (mid_key < key) {
-      min_idx = mid_idx + 1;
-    } else if (mid_key > key) {
-      max_idx = mid_idx;
-    } else /* mid_key == key */
-    {
-      return &values[mid_idx];
-    }
+  if (key == 0) return map->capacity;
+  for (size_t i = home_slot(key, map->hash_shift);; i = (i + 1) & mask) {
+    if (keys[i] == key) return i;
+    if (keys[i] == 0) return map->capacity;
   }
-
-  GPR_DEBUG_ASSERT(!strict_find);
-  return nullptr;
 }
 
 void* grpc_chttp2_stream_map_delete(grpc_chttp2_stream_map* map, uint32_t key) {
-  void** pvalue = find<true>(map, key);
-  GPR_DEBUG_ASSERT(pvalue != nullptr);
-  void* out = *pvalue;
+  size_t i = find_slot(map, key);
+  GPR_DEBUG_ASSERT(i != map->capacity);
+  if (i == map->capacity) return nullptr;
+  void* out = map->values[i];
   GPR_DEBUG_ASSERT(out != nullptr);
-  *pvalue = nullptr;
-  map->free++;
-  /* recognize complete emptyness and ensure we can skip
-     defragmentation later */
-  if (map->free == map->count) {
-    map->free = map->count = 0;
+  /* backward shift deletion: pull later entries of the probe sequence into
+     the hole unless that would move them before their home slot */
+  size_t mask = map->capacity - 1;
+  for (size_t j = (i + 1) & mask; map->keys[j] != 0; j = (j + 1) & mask) {
+    size_t home = home_slot(map->keys[j], map->hash_shift);
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      map->keys[i] = map->keys[j];
+      map->values[i] = map->values[j];
+      i = j;
+    }
+  }
+  map->keys[i] = 0;
+  map->count--;
+  /* recognize complete emptyness: any key may be added again */
+  if (map->count == 0) {
+    map->last_key = 0;
   }
   GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
   return out;
 }
 
 void* grpc_chttp2_stream_map_find(grpc_chttp2_stream_map* map, uint32_t key) {
-  void** pvalue = find<false>(map, key);
-  return pvalue != nullptr ? *pvalue : nullptr;
+  size_t i = find_slot(map, key);
+  return i != map->capacity ? map->values[i] : nullptr;
 }
 
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map) {
-  return map->count - map->free;
+  return map->count;
 }
 
 void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map) {
-  if (map->count == map->free) {
+  if (map->count == 0) {
     return nullptr;
   }
-  if (map->free != 0) {
-    map->count = compact(map->keys, map->values, map->count);
-    map->free = 0;
-    GPR_ASSERT(map->count > 0);
+  size_t mask = map->capacity - 1;
+  size_t i = static_cast<size_t>(rand()) & mask;
+  while (map->keys[i] == 0) {
+    i = (i + 1) & mask;
   }
-  return map->values[(static_cast<size_t>(rand())) % map->count];
+  return map->values[i];
 }
 
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void (*f)(void* user_data, uint32_t key,
                                                void* value),
                                      void* user_data) {
-  size_t i;
-
-  for (i = 0; i < map->count; i++) {
-    if (map->values[i]) {
-      f(user_data, map->keys[i], map->values[i]);
+  size_t n = map->count;
+  if (n == 0) return;
+  /* Iterate over a sorted snapshot of the keys: callbacks commonly close (and
+     so delete) streams, which moves entries around in the table. */
+  uint32_t* keys = static_cast<uint32_t*>(gpr_malloc(sizeof(uint32_t) * n));
+  size_t out = 0;
+  for (size_t i = 0; i < map->capacity; i++) {
+    if (map->keys[i] != 0) keys[out++] = map->keys[i];
+  }
+  GPR_DEBUG_ASSERT(out == n);
+  std::sort(keys, keys + n);
+  for (size_t i = 0; i < n; i++) {
+    void* value = grpc_chttp2_stream_map_find(map, keys[i]);
+    if (value != nullptr) {
+      f(user_data, keys[i], value);
     }
   }
+  gpr_free(keys);
 }
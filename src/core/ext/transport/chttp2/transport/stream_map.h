@@ -26,16 +26,25 @@
 
 /* Data structure to map a uint32_t to a data object (represented by a void*)
 
-   Represented as a sorted array of keys, and a corresponding array of values.
-   Lookups are performed with binary search.
+   Represented as an open addressing hash table with linear probing: a dense
+   array of keys (so that a probe sequence touches as few cache lines as
+   possible) and a parallel array of values. Stream id 0 is never used for a
+   stream, so a zero key marks an empty slot. Deletes shift later entries of
+   the probe sequence back instead of leaving tombstones, so the table never
+   needs compacting.
    Adds are restricted to strictly higher keys than previously seen (this is
    guaranteed by http2). */
 struct grpc_chttp2_stream_map {
   uint32_t* keys;
   void** values;
+  /* number of populated entries */
   size_t count;
-  size_t free;
+  /* number of slots; always a power of two */
   size_t capacity;
+  /* 64 - log2(capacity): how far to shift a 64 bit hash to get a slot */
+  int hash_shift;
+  /* largest key added since the map was last empty */
+  uint32_t last_key;
 };
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity);
@@ -59,7 +68,8 @@ void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map);
 /* How many (populated) entries are in the stream map? */
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map);
 
-/* Callback on each stream */
+/* Callback on each stream, in increasing key order. f may delete entries from
+   the map; entries added while iterating are not visited. */
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void (*f)(void* user_data, uint32_t key,
                                                void* value),
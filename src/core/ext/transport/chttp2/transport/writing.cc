@@ -208,6 +208,9 @@ static bool update_list(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
 
 static void report_stall(grpc_chttp2_transport* t, grpc_chttp2_stream* s,
                          const char* staller) {
+  grpc_core::TraceRing::Record(&grpc_flowctl_trace, "stall",
+                               reinterpret_cast<intptr_t>(t), s->id,
+                               t->flow_control->remote_window());
   if (GRPC_TRACE_FLAG_ENABLED(grpc_flowctl_trace)) {
     gpr_log(
         GPR_DEBUG,
@@ -409,7 +412,8 @@ class DataSendContext {
 
   void FlushBytes() {
     uint32_t send_bytes = static_cast<uint32_t>(
-        std::min(size_t(max_outgoing()), s_->flow_controlled_buffer.length));
+        std::min(size_t(std::min(max_outgoing(), s_->write_deficit)),
+                 s_->flow_controlled_buffer.length));
     is_last_frame_ = send_bytes == s_->flow_controlled_buffer.length &&
                      s_->fetching_send_message == nullptr &&
                      s_->send_trailing_metadata != nullptr &&
@@ -418,6 +422,7 @@ class DataSendContext {
                             is_last_frame_, &s_->stats.outgoing, &t_->outbuf);
     s_->flow_control->SentData(send_bytes);
     s_->sending_bytes += send_bytes;
+    s_->write_deficit -= send_bytes;
   }
 
   bool is_last_frame() const { return is_last_frame_; }
@@ -488,6 +493,8 @@ class StreamWriteContext {
 
     s_->send_initial_metadata = nullptr;
     s_->sent_initial_metadata = true;
+    GRPC_USDT_PROBE(stream_first_write, s_->refcount, s_->id,
+                    s_->stats.outgoing.header_bytes);
     write_context_->NoteScheduledResults();
     grpc_chttp2_complete_closure_step(
         t_, s_, &s_->send_initial_metadata_finished, GRPC_ERROR_NONE,
@@ -516,9 +523,14 @@ class StreamWriteContext {
     DataSendContext data_send_context(write_context_, t_, s_);
 
     if (!data_send_context.AnyOutgoing()) {
+      s_->write_deficit = 0;
       if (t_->flow_control->remote_window() <= 0) {
         report_stall(t_, s_, "transport");
         grpc_chttp2_list_add_stalled_by_transport(t_, s_);
+        if (t_->channelz_stats != nullptr) {
+          t_->channelz_stats->RecordTransportStalled(
+              grpc_core::ExecCtx::Get()->Now());
+        }
       } else if (data_send_context.stream_remote_window() <= 0) {
         report_stall(t_, s_, "stream");
         grpc_chttp2_list_add_stalled_by_stream(t_, s_);
@@ -526,10 +538,24 @@ class StreamWriteContext {
       return;  // early out: nothing to do
     }
 
+    // Deficit round robin: every turn adds one quantum of credit, and once
+    // it is spent the stream goes back to the end of the writable list (see
+    // below), so headers, trailers and data of other streams queued in the
+    // meantime are written before its next quantum.
+    if (t_->stream_write_quantum == 0) {
+      s_->write_deficit = UINT32_MAX;
+    } else {
+      s_->write_deficit = static_cast<uint32_t>(
+          std::min(uint64_t(s_->write_deficit) + t_->stream_write_quantum,
+                   uint64_t(2) * t_->stream_write_quantum));
+    }
     while (s_->flow_controlled_buffer.length > 0 &&
-           data_send_context.max_outgoing() > 0) {
+           data_send_context.max_outgoing() > 0 && s_->write_deficit > 0) {
       data_send_context.FlushBytes();
     }
+    if (s_->flow_controlled_buffer.length == 0) {
+      s_->write_deficit = 0;
+    }
     grpc_chttp2_reset_ping_clock(t_);
     if (data_send_context.is_last_frame()) {
       SentLastFrame();
@@ -636,6 +662,10 @@ grpc_chttp2_begin_write_result grpc_chttp2_begin_write(
   ctx.EnactHpackSettings();
 
   if (t->flow_control->remote_window() > 0) {
+    if (t->channelz_stats != nullptr) {
+      t->channelz_stats->RecordTransportUnstalled(
+          grpc_core::ExecCtx::Get()->Now());
+    }
     ctx.UpdateStreamsNoLongerStalled();
   }
 
@@ -680,6 +710,9 @@ void grpc_chttp2_end_write(grpc_chttp2_transport* t, grpc_error_handle error) {
 
   if (t->channelz_socket != nullptr) {
     t->channelz_socket->RecordMessagesSent(t->num_messages_in_next_write);
+    t->channelz_stats->RecordHpackFieldsSent(
+        t->hpack_compressor.indexed_fields_sent(),
+        t->hpack_compressor.literal_fields_sent());
   }
   t->num_messages_in_next_write = 0;
 
@@ -22,6 +22,9 @@
 
 #include <string.h>
 
+#include <atomic>
+#include <vector>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/string_util.h>
 #include <grpc/support/sync.h>
@@ -56,15 +59,24 @@ void fill_in_metadata(inproc_stream* s, const grpc_metadata_batch* metadata,
                       uint32_t flags, grpc_metadata_batch* out_md,
                       uint32_t* outflags, bool* markfilled);
 
+// A lock shared by the two sides of a connection, or of a stream.
 struct shared_mu {
-  shared_mu() {
-    // Share one lock between both sides since both sides get affected
+  explicit shared_mu(int initial_refs) {
     gpr_mu_init(&mu);
-    gpr_ref_init(&refs, 2);
+    gpr_ref_init(&refs, initial_refs);
   }
 
   ~shared_mu() { gpr_mu_destroy(&mu); }
 
+  void ref() { gpr_ref(&refs); }
+
+  void unref() {
+    if (gpr_unref(&refs)) {
+      this->~shared_mu();
+      gpr_free(this);
+    }
+  }
+
   gpr_mu mu;
   gpr_refcount refs;
 };
@@ -82,12 +94,7 @@ struct inproc_transport {
     gpr_ref_init(&refs, 2);
   }
 
-  ~inproc_transport() {
-    if (gpr_unref(&mu->refs)) {
-      mu->~shared_mu();
-      gpr_free(mu);
-    }
-  }
+  ~inproc_transport() { mu->unref(); }
 
   void ref() {
     INPROC_LOG(GPR_INFO, "ref_transport %p", this);
@@ -105,6 +112,9 @@ struct inproc_transport {
   }
 
   grpc_transport base;
+  // Guards the connection state of both sides: the fields below and the
+  // stream lists. Streams have locks of their own (inproc_stream::mu), which
+  // may be held when taking this one but never the other way around.
   shared_mu* mu;
   gpr_refcount refs;
   bool is_client;
@@ -112,7 +122,7 @@ struct inproc_transport {
   void (*accept_stream_cb)(void* user_data, grpc_transport* transport,
                            const void* server_data);
   void* accept_stream_data;
-  bool is_closed = false;
+  std::atomic<bool> is_closed{false};
   struct inproc_transport* other_side;
   struct inproc_stream* stream_list = nullptr;
 };
@@ -135,6 +145,9 @@ struct inproc_stream {
     gpr_mu_unlock(&t->mu->mu);
 
     if (!server_data) {
+      // The client and server sides of the stream share a lock, so that
+      // streams, and the two directions of a connection, do not contend.
+      mu = new (gpr_malloc(sizeof(*mu))) shared_mu(1);
       t->ref();
       inproc_transport* st = t->other_side;
       st->ref();
@@ -150,12 +163,13 @@ struct inproc_stream {
       inproc_stream* cs = const_cast<inproc_stream*>(
           static_cast<const inproc_stream*>(server_data));
       other_side = cs;
+      mu = cs->mu;
+      mu->ref();
       // Ref the server-side stream on behalf of the client now
       ref("inproc_init_stream:srv");
 
-      // Now we are about to affect the other side, so lock the transport
-      // to make sure that it doesn't get destroyed
-      gpr_mu_lock(&t->mu->mu);
+      // Now we are about to affect the other side, so take the stream lock
+      gpr_mu_lock(&mu->mu);
       cs->other_side = this;
       // Now transfer from the other side's write_buffer if any to the to_read
       // buffer
@@ -181,7 +195,7 @@ struct inproc_stream {
         maybe_process_ops_locked(this, cancel_other_error);
       }
 
-      gpr_mu_unlock(&t->mu->mu);
+      gpr_mu_unlock(&mu->mu);
     }
   }
 
@@ -194,6 +208,7 @@ struct inproc_stream {
       grpc_slice_buffer_destroy_internal(&recv_message);
     }
 
+    mu->unref();
     t->unref();
   }
 
@@ -219,6 +234,8 @@ struct inproc_stream {
   inproc_transport* t;
   grpc_stream_refcount* refs;
   grpc_core::Arena* arena;
+  // Guards the state below, of both this stream and its other side.
+  shared_mu* mu = nullptr;
 
   grpc_metadata_batch to_read_initial_md{arena};
   uint32_t to_read_initial_md_flags = 0;
@@ -347,6 +364,7 @@ void close_stream_locked(inproc_stream* s) {
     s->write_buffer_trailing_md.Clear();
 
     if (s->listed) {
+      gpr_mu_lock(&s->t->mu->mu);
       inproc_stream* p = s->stream_list_prev;
       inproc_stream* n = s->stream_list_next;
       if (p != nullptr) {
@@ -358,6 +376,7 @@ void close_stream_locked(inproc_stream* s) {
         n->stream_list_prev = p;
       }
       s->listed = false;
+      gpr_mu_unlock(&s->t->mu->mu);
       s->unref("close_stream:list");
     }
     s->closed = true;
@@ -938,7 +957,7 @@ void perform_stream_op(grpc_transport* gt, grpc_stream* gs,
                        grpc_transport_stream_op_batch* op) {
   INPROC_LOG(GPR_INFO, "perform_stream_op %p %p %p", gt, gs, op);
   inproc_stream* s = reinterpret_cast<inproc_stream*>(gs);
-  gpr_mu* mu = &s->t->mu->mu;  // save aside in case s gets closed
+  gpr_mu* mu = &s->mu->mu;  // save aside in case s gets closed
   gpr_mu_lock(mu);
 
   if (GRPC_TRACE_FLAG_ENABLED(grpc_inproc_trace)) {
@@ -985,7 +1004,7 @@ void perform_stream_op(grpc_transport* gt, grpc_stream* gs,
   inproc_stream* other = s->other_side;
   if (error == GRPC_ERROR_NONE &&
       (op->send_initial_metadata || op->send_trailing_metadata)) {
-    if (s->t->is_closed) {
+    if (s->t->is_closed.load(std::memory_order_acquire)) {
       error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("Endpoint already shutdown");
     }
     if (error == GRPC_ERROR_NONE && op->send_initial_metadata) {
@@ -1120,22 +1139,31 @@ void perform_stream_op(grpc_transport* gt, grpc_stream* gs,
   GRPC_ERROR_UNREF(error);
 }
 
-void close_transport_locked(inproc_transport* t) {
-  INPROC_LOG(GPR_INFO, "close_transport %p %d", t, t->is_closed);
+void close_transport(inproc_transport* t) {
+  std::vector<inproc_stream*> streams;
+  gpr_mu_lock(&t->mu->mu);
+  INPROC_LOG(GPR_INFO, "close_transport %p %d", t, t->is_closed.load());
   t->state_tracker.SetState(GRPC_CHANNEL_SHUTDOWN, absl::Status(),
                             "close transport");
-  if (!t->is_closed) {
-    t->is_closed = true;
-    /* Also end all streams on this transport */
-    while (t->stream_list != nullptr) {
-      // cancel_stream_locked also adjusts stream list
-      cancel_stream_locked(
-          t->stream_list,
-          grpc_error_set_int(
-              GRPC_ERROR_CREATE_FROM_STATIC_STRING("Transport closed"),
-              GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
+  if (!t->is_closed.exchange(true, std::memory_order_acq_rel)) {
+    // Also end all streams on this transport. Streams are cancelled under
+    // their own locks, which cannot be taken while holding the transport's,
+    // so collect them first.
+    for (inproc_stream* s = t->stream_list; s != nullptr;
+         s = s->stream_list_next) {
+      s->ref("close_transport");
+      streams.push_back(s);
     }
   }
+  gpr_mu_unlock(&t->mu->mu);
+  for (inproc_stream* s : streams) {
+    gpr_mu* mu = &s->mu->mu;
+    gpr_mu_lock(mu);
+    // cancel_stream_locked also adjusts stream list
+    cancel_stream_locked(s, GRPC_ERROR_TRANSPORT_CLOSED());
+    gpr_mu_unlock(mu);
+    s->unref("close_transport");
+  }
 }
 
 void perform_transport_op(grpc_transport* gt, grpc_transport_op* op) {
@@ -1167,20 +1195,19 @@ void perform_transport_op(grpc_transport* gt, grpc_transport_op* op) {
     GRPC_ERROR_UNREF(op->disconnect_with_error);
   }
 
+  gpr_mu_unlock(&t->mu->mu);
   if (do_close) {
-    close_transport_locked(t);
+    close_transport(t);
   }
-  gpr_mu_unlock(&t->mu->mu);
 }
 
-void destroy_stream(grpc_transport* gt, grpc_stream* gs,
+void destroy_stream(grpc_transport* /*gt*/, grpc_stream* gs,
                     grpc_closure* then_schedule_closure) {
   INPROC_LOG(GPR_INFO, "destroy_stream %p %p", gs, then_schedule_closure);
-  inproc_transport* t = reinterpret_cast<inproc_transport*>(gt);
   inproc_stream* s = reinterpret_cast<inproc_stream*>(gs);
-  gpr_mu_lock(&t->mu->mu);
+  gpr_mu_lock(&s->mu->mu);
   close_stream_locked(s);
-  gpr_mu_unlock(&t->mu->mu);
+  gpr_mu_unlock(&s->mu->mu);
   s->~inproc_stream();
   grpc_core::ExecCtx::Run(DEBUG_LOCATION, then_schedule_closure,
                           GRPC_ERROR_NONE);
@@ -1189,9 +1216,7 @@ void destroy_stream(grpc_transport* gt, grpc_stream* gs,
 void destroy_transport(grpc_transport* gt) {
   inproc_transport* t = reinterpret_cast<inproc_transport*>(gt);
   INPROC_LOG(GPR_INFO, "destroy_transport %p", t);
-  gpr_mu_lock(&t->mu->mu);
-  close_transport_locked(t);
-  gpr_mu_unlock(&t->mu->mu);
+  close_transport(t);
   t->other_side->unref();
   t->unref();
 }
@@ -1228,7 +1253,8 @@ void inproc_transports_create(grpc_transport** server_transport,
                               grpc_transport** client_transport,
                               const grpc_channel_args* /*client_args*/) {
   INPROC_LOG(GPR_INFO, "inproc_transports_create");
-  shared_mu* mu = new (gpr_malloc(sizeof(*mu))) shared_mu();
+  // Both sides of the connection share one lock.
+  shared_mu* mu = new (gpr_malloc(sizeof(*mu))) shared_mu(2);
   inproc_transport* st = new (gpr_malloc(sizeof(*st)))
       inproc_transport(&inproc_vtable, mu, /*is_client=*/false);
   inproc_transport* ct = new (gpr_malloc(sizeof(*ct)))
@@ -1267,6 +1293,21 @@ grpc_channel* grpc_inproc_channel_create(grpc_server* server,
                                              .PreconditionChannelArgs(args)
                                              .ToC();
   grpc_channel_args_destroy(args);
+  // Both ends of an object passing channel may send message objects to each
+  // other, since they share the address space.
+  if (grpc_channel_args_find_bool(client_args, GRPC_ARG_INPROC_OBJECT_PASSING,
+                                  false)) {
+    grpc_arg object_passing_arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_OBJECT_PASSING_PEER), 1);
+    const grpc_channel_args* old_args = client_args;
+    client_args =
+        grpc_channel_args_copy_and_add(old_args, &object_passing_arg, 1);
+    grpc_channel_args_destroy(old_args);
+    old_args = server_args;
+    server_args =
+        grpc_channel_args_copy_and_add(old_args, &object_passing_arg, 1);
+    grpc_channel_args_destroy(old_args);
+  }
   grpc_transport* server_transport;
   grpc_transport* client_transport;
   inproc_transports_create(&server_transport, server_args, &client_transport,
@@ -0,0 +1,590 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+
+#ifdef GRPC_HAVE_SHM_ENDPOINT
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <string>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/slice_internal.h"
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#ifndef MFD_ALLOW_SEALING
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS 1033
+#define F_GET_SEALS 1034
+#define F_SEAL_SEAL 0x0001
+#define F_SEAL_SHRINK 0x0002
+#define F_SEAL_GROW 0x0004
+#endif
+
+namespace grpc_core {
+
+namespace {
+
+constexpr uint32_t kShmMagic = 0x67726d31;  // "grm1"
+// Bytes of each ring. A power of two, so that positions wrap with a mask.
+constexpr uint64_t kRingSize = 1 << 20;
+constexpr size_t kCacheLineSize = 64;
+
+struct ShmRegionHeader {
+  uint32_t magic;
+  uint32_t reserved;
+  uint64_t ring_size;
+};
+
+// Positions only ever grow; the offset into the ring is position % size. The
+// writer owns write_pos and the reader read_pos; the waiting flags are set by
+// the side about to sleep on its eventfd, and cleared by the side that wakes
+// it up.
+struct ShmRingHeader {
+  alignas(kCacheLineSize) std::atomic<uint64_t> write_pos;
+  std::atomic<uint32_t> reader_waiting;
+  alignas(kCacheLineSize) std::atomic<uint64_t> read_pos;
+  std::atomic<uint32_t> writer_waiting;
+};
+
+constexpr size_t kHeaderSize = kCacheLineSize;
+constexpr size_t kRingStride = sizeof(ShmRingHeader) + kRingSize;
+constexpr size_t kRegionSize = kHeaderSize + 2 * kRingStride;
+constexpr int kRequiredSeals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL;
+
+static_assert(sizeof(ShmRegionHeader) <= kHeaderSize, "header too large");
+static_assert((kRingSize & (kRingSize - 1)) == 0, "ring size not a power of 2");
+
+ShmRingHeader* RingAt(void* region, int index) {
+  return reinterpret_cast<ShmRingHeader*>(static_cast<uint8_t*>(region) +
+                                          kHeaderSize + index * kRingStride);
+}
+
+uint8_t* RingData(ShmRingHeader* ring) {
+  return reinterpret_cast<uint8_t*>(ring) + sizeof(ShmRingHeader);
+}
+
+grpc_error_handle ErrnoError(const char* call) {
+  return GRPC_OS_ERROR(errno, call);
+}
+
+class ShmEndpoint {
+ public:
+  ShmEndpoint(ShmConnectionFds* fds, void* region, bool is_client,
+              absl::string_view peer)
+      : region_(region),
+        peer_wakeup_fd_(fds->peer_wakeup_fd),
+        tx_(RingAt(region, is_client ? 0 : 1)),
+        rx_(RingAt(region, is_client ? 1 : 0)),
+        peer_(absl::StrCat("shm:", peer)) {
+    base_.vtable = &kVtable;
+    std::string name = absl::StrCat(peer_, " wakeup");
+    wakeup_fd_ = grpc_fd_create(fds->wakeup_fd, name.c_str(), false);
+    name = absl::StrCat(peer_, " socket");
+    socket_fd_ = grpc_fd_create(fds->socket, name.c_str(), false);
+    fds->wakeup_fd = fds->peer_wakeup_fd = fds->socket = -1;
+    GRPC_CLOSURE_INIT(&on_wakeup_, OnWakeup, this, grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&on_socket_event_, OnSocketEvent, this,
+                      grpc_schedule_on_exec_ctx);
+    // The socket is watched for the peer going away for as long as the
+    // endpoint is up; the watch holds a ref.
+    refs_.Ref();
+    grpc_fd_notify_on_read(socket_fd_, &on_socket_event_);
+  }
+
+  ~ShmEndpoint() {
+    grpc_fd_orphan(wakeup_fd_, nullptr, nullptr, "shm_endpoint");
+    grpc_fd_orphan(socket_fd_, nullptr, nullptr, "shm_endpoint");
+    close(peer_wakeup_fd_);
+    munmap(region_, kRegionSize);
+    GRPC_ERROR_UNREF(shutdown_error_);
+  }
+
+  grpc_endpoint* base() { return &base_; }
+
+ private:
+  static ShmEndpoint* FromBase(grpc_endpoint* ep) {
+    return reinterpret_cast<ShmEndpoint*>(ep);
+  }
+
+  void Unref() {
+    if (refs_.Unref()) delete this;
+  }
+
+  void SignalPeer() {
+    if (eventfd_write(peer_wakeup_fd_, 1) != 0 && errno != EAGAIN) {
+      gpr_log(GPR_ERROR, "%s: eventfd_write: %s", peer_.c_str(),
+              strerror(errno));
+    }
+  }
+
+  // Waits for the peer to signal this end's eventfd, if it is not already
+  // waited for.
+  void ArmWakeupLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    if (wakeup_armed_ || shutdown_) return;
+    wakeup_armed_ = true;
+    refs_.Ref();
+    grpc_fd_notify_on_read(wakeup_fd_, &on_wakeup_);
+  }
+
+  // Fails pending operations and stops watching the descriptors. Closures
+  // are only scheduled here, so this is safe to call with mu_ held.
+  void ShutdownLocked(grpc_error_handle why)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    if (shutdown_) {
+      GRPC_ERROR_UNREF(why);
+      return;
+    }
+    shutdown_ = true;
+    shutdown_error_ = why;
+    if (read_cb_ != nullptr) {
+      grpc_slice_buffer_reset_and_unref_internal(read_buffer_);
+      ExecCtx::Run(DEBUG_LOCATION, std::exchange(read_cb_, nullptr),
+                   GRPC_ERROR_REF(why));
+    }
+    if (write_cb_ != nullptr) {
+      ExecCtx::Run(DEBUG_LOCATION, std::exchange(write_cb_, nullptr),
+                   GRPC_ERROR_REF(why));
+    }
+    grpc_fd_shutdown(wakeup_fd_, GRPC_ERROR_REF(why));
+    // This also shuts the socket down, which is how the peer learns about it.
+    grpc_fd_shutdown(socket_fd_, GRPC_ERROR_REF(why));
+  }
+
+  // Moves whatever the peer has written into the pending read. Returns false
+  // if there was nothing, in which case the peer will signal once there is.
+  bool TryReadLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    const uint64_t read_pos = rx_->read_pos.load(std::memory_order_relaxed);
+    uint64_t available =
+        rx_->write_pos.load(std::memory_order_acquire) - read_pos;
+    if (available == 0) {
+      rx_->reader_waiting.store(1, std::memory_order_seq_cst);
+      available = rx_->write_pos.load(std::memory_order_seq_cst) - read_pos;
+      if (available == 0) return false;
+      rx_->reader_waiting.store(0, std::memory_order_relaxed);
+    }
+    if (available > kRingSize) {
+      ShutdownLocked(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "Shared-memory ring corrupted by peer"));
+      return true;
+    }
+    grpc_slice slice = GRPC_SLICE_MALLOC(available);
+    uint8_t* dst = GRPC_SLICE_START_PTR(slice);
+    const size_t offset = read_pos & (kRingSize - 1);
+    const size_t first = std::min<uint64_t>(available, kRingSize - offset);
+    memcpy(dst, RingData(rx_) + offset, first);
+    memcpy(dst + first, RingData(rx_), available - first);
+    rx_->read_pos.store(read_pos + available, std::memory_order_seq_cst);
+    if (rx_->writer_waiting.load(std::memory_order_seq_cst) != 0 &&
+        rx_->writer_waiting.exchange(0, std::memory_order_seq_cst) != 0) {
+      SignalPeer();
+    }
+    grpc_slice_buffer_add(read_buffer_, slice);
+    read_buffer_ = nullptr;
+    ExecCtx::Run(DEBUG_LOCATION, std::exchange(read_cb_, nullptr),
+                 GRPC_ERROR_NONE);
+    return true;
+  }
+
+  // Copies as much of the pending write into the ring as fits. Returns false
+  // if some is left, in which case the peer will signal once it frees space.
+  bool TryWriteLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    uint64_t write_pos = tx_->write_pos.load(std::memory_order_relaxed);
+    bool waiting = false;
+    while (write_index_ < write_buffer_->count) {
+      uint64_t used = write_pos - tx_->read_pos.load(std::memory_order_seq_cst);
+      if (used > kRingSize) {
+        ShutdownLocked(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "Shared-memory ring corrupted by peer"));
+        return true;
+      }
+      if (used == kRingSize) {
+        // Publish what was written first, or the reader might never free
+        // any space.
+        PublishLocked(write_pos);
+        if (waiting) return false;
+        tx_->writer_waiting.store(1, std::memory_order_seq_cst);
+        waiting = true;
+        continue;
+      }
+      const grpc_slice& slice = write_buffer_->slices[write_index_];
+      const size_t offset = write_pos & (kRingSize - 1);
+      const size_t n = std::min<uint64_t>(
+          {GRPC_SLICE_LENGTH(slice) - write_offset_, kRingSize - used,
+           kRingSize - offset});
+      memcpy(RingData(tx_) + offset,
+             GRPC_SLICE_START_PTR(slice) + write_offset_, n);
+      write_pos += n;
+      write_offset_ += n;
+      if (write_offset_ == GRPC_SLICE_LENGTH(slice)) {
+        ++write_index_;
+        write_offset_ = 0;
+      }
+    }
+    if (waiting) tx_->writer_waiting.store(0, std::memory_order_relaxed);
+    PublishLocked(write_pos);
+    write_buffer_ = nullptr;
+    ExecCtx::Run(DEBUG_LOCATION, std::exchange(write_cb_, nullptr),
+                 GRPC_ERROR_NONE);
+    return true;
+  }
+
+  // Makes the ring up to write_pos visible to the reader, and wakes it up if
+  // it is waiting.
+  void PublishLocked(uint64_t write_pos) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    if (write_pos == tx_->write_pos.load(std::memory_order_relaxed)) return;
+    tx_->write_pos.store(write_pos, std::memory_order_seq_cst);
+    if (tx_->reader_waiting.load(std::memory_order_seq_cst) != 0 &&
+        tx_->reader_waiting.exchange(0, std::memory_order_seq_cst) != 0) {
+      SignalPeer();
+    }
+  }
+
+  static void OnWakeup(void* arg, grpc_error_handle error) {
+    ShmEndpoint* self = static_cast<ShmEndpoint*>(arg);
+    if (error == GRPC_ERROR_NONE) {
+      eventfd_t value;
+      eventfd_read(grpc_fd_wrapped_fd(self->wakeup_fd_), &value);
+      MutexLock lock(&self->mu_);
+      self->wakeup_armed_ = false;
+      bool pending = false;
+      if (self->read_cb_ != nullptr && !self->TryReadLocked()) pending = true;
+      if (self->write_cb_ != nullptr && !self->TryWriteLocked()) {
+        pending = true;
+      }
+      if (pending) self->ArmWakeupLocked();
+    }
+    self->Unref();
+  }
+
+  static void OnSocketEvent(void* arg, grpc_error_handle error) {
+    ShmEndpoint* self = static_cast<ShmEndpoint*>(arg);
+    if (error == GRPC_ERROR_NONE) {
+      // Nothing is sent on the socket after setup, so anything readable
+      // means the peer closed it or is misbehaving.
+      char buf[64];
+      ssize_t n = recv(grpc_fd_wrapped_fd(self->socket_fd_), buf, sizeof(buf),
+                       MSG_DONTWAIT);
+      if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        grpc_fd_notify_on_read(self->socket_fd_, &self->on_socket_event_);
+        return;
+      }
+      MutexLock lock(&self->mu_);
+      self->ShutdownLocked(
+          n < 0 ? ErrnoError("recv")
+                : GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                      "Shared-memory peer closed the connection"));
+    }
+    self->Unref();
+  }
+
+  static void Read(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                   grpc_closure* cb, bool /*urgent*/,
+                   int /*min_progress_size*/) {
+    ShmEndpoint* self = FromBase(ep);
+    MutexLock lock(&self->mu_);
+    grpc_slice_buffer_reset_and_unref_internal(slices);
+    if (self->shutdown_) {
+      ExecCtx::Run(DEBUG_LOCATION, cb, GRPC_ERROR_REF(self->shutdown_error_));
+      return;
+    }
+    GPR_ASSERT(self->read_cb_ == nullptr);
+    self->read_buffer_ = slices;
+    self->read_cb_ = cb;
+    if (!self->TryReadLocked()) self->ArmWakeupLocked();
+  }
+
+  static void Write(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                    grpc_closure* cb, void* /*arg*/, int /*max_frame_size*/) {
+    ShmEndpoint* self = FromBase(ep);
+    MutexLock lock(&self->mu_);
+    if (self->shutdown_) {
+      ExecCtx::Run(DEBUG_LOCATION, cb, GRPC_ERROR_REF(self->shutdown_error_));
+      return;
+    }
+    GPR_ASSERT(self->write_cb_ == nullptr);
+    self->write_buffer_ = slices;
+    self->write_cb_ = cb;
+    self->write_index_ = 0;
+    self->write_offset_ = 0;
+    if (!self->TryWriteLocked()) self->ArmWakeupLocked();
+  }
+
+  static void AddToPollset(grpc_endpoint* ep, grpc_pollset* pollset) {
+    ShmEndpoint* self = FromBase(ep);
+    grpc_pollset_add_fd(pollset, self->wakeup_fd_);
+    grpc_pollset_add_fd(pollset, self->socket_fd_);
+  }
+
+  static void AddToPollsetSet(grpc_endpoint* ep, grpc_pollset_set* pollset) {
+    ShmEndpoint* self = FromBase(ep);
+    grpc_pollset_set_add_fd(pollset, self->wakeup_fd_);
+    grpc_pollset_set_add_fd(pollset, self->socket_fd_);
+  }
+
+  static void DeleteFromPollsetSet(grpc_endpoint* ep,
+                                   grpc_pollset_set* pollset) {
+    ShmEndpoint* self = FromBase(ep);
+    grpc_pollset_set_del_fd(pollset, self->wakeup_fd_);
+    grpc_pollset_set_del_fd(pollset, self->socket_fd_);
+  }
+
+  static void Shutdown(grpc_endpoint* ep, grpc_error_handle why) {
+    ShmEndpoint* self = FromBase(ep);
+    MutexLock lock(&self->mu_);
+    self->ShutdownLocked(why);
+  }
+
+  static void Destroy(grpc_endpoint* ep) {
+    ShmEndpoint* self = FromBase(ep);
+    {
+      MutexLock lock(&self->mu_);
+      self->ShutdownLocked(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "Shared-memory endpoint destroyed"));
+    }
+    self->Unref();
+  }
+
+  static absl::string_view GetPeer(grpc_endpoint* ep) {
+    return FromBase(ep)->peer_;
+  }
+
+  static absl::string_view GetLocalAddress(grpc_endpoint* ep) {
+    return FromBase(ep)->peer_;
+  }
+
+  static int GetFd(grpc_endpoint* /*ep*/) { return -1; }
+
+  static bool CanTrackErr(grpc_endpoint* /*ep*/) { return false; }
+
+  static const grpc_endpoint_vtable kVtable;
+
+  // Must be the first member, so that FromBase() can cast.
+  grpc_endpoint base_;
+  // One ref for the endpoint's owner, and one for each armed closure.
+  RefCount refs_;
+  void* const region_;
+  const int peer_wakeup_fd_;
+  ShmRingHeader* const tx_;
+  ShmRingHeader* const rx_;
+  const std::string peer_;
+  grpc_fd* wakeup_fd_;
+  grpc_fd* socket_fd_;
+  grpc_closure on_wakeup_;
+  grpc_closure on_socket_event_;
+  Mutex mu_;
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  grpc_error_handle shutdown_error_ ABSL_GUARDED_BY(mu_) = GRPC_ERROR_NONE;
+  bool wakeup_armed_ ABSL_GUARDED_BY(mu_) = false;
+  grpc_slice_buffer* read_buffer_ ABSL_GUARDED_BY(mu_) = nullptr;
+  grpc_closure* read_cb_ ABSL_GUARDED_BY(mu_) = nullptr;
+  grpc_slice_buffer* write_buffer_ ABSL_GUARDED_BY(mu_) = nullptr;
+  grpc_closure* write_cb_ ABSL_GUARDED_BY(mu_) = nullptr;
+  // How far into write_buffer_ the ring has been filled.
+  size_t write_index_ ABSL_GUARDED_BY(mu_) = 0;
+  size_t write_offset_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+const grpc_endpoint_vtable ShmEndpoint::kVtable = {
+    ShmEndpoint::Read,
+    ShmEndpoint::Write,
+    ShmEndpoint::AddToPollset,
+    ShmEndpoint::AddToPollsetSet,
+    ShmEndpoint::DeleteFromPollsetSet,
+    ShmEndpoint::Shutdown,
+    ShmEndpoint::Destroy,
+    ShmEndpoint::GetPeer,
+    ShmEndpoint::GetLocalAddress,
+    ShmEndpoint::GetFd,
+    ShmEndpoint::CanTrackErr,
+};
+
+}  // namespace
+
+grpc_error_handle CreateShmConnection(ShmConnectionFds* client,
+                                      ShmConnectionFds* server) {
+  ShmConnectionFds c;
+  ShmConnectionFds s;
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  void* region = MAP_FAILED;
+  c.memfd = static_cast<int>(syscall(SYS_memfd_create, "grpc-shm",
+                                     MFD_CLOEXEC | MFD_ALLOW_SEALING));
+  if (c.memfd < 0) {
+    error = ErrnoError("memfd_create");
+  } else if (ftruncate(c.memfd, kRegionSize) != 0) {
+    error = ErrnoError("ftruncate");
+  } else if (fcntl(c.memfd, F_ADD_SEALS, kRequiredSeals) != 0) {
+    // Sealed, the server need not fear the client shrinking the region
+    // under it.
+    error = ErrnoError("fcntl(F_ADD_SEALS)");
+  } else if ((region = mmap(nullptr, kRegionSize, PROT_READ | PROT_WRITE,
+                            MAP_SHARED, c.memfd, 0)) == MAP_FAILED) {
+    error = ErrnoError("mmap");
+  } else if ((c.wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0 ||
+             (c.peer_wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0) {
+    error = ErrnoError("eventfd");
+  } else if ((s.memfd = fcntl(c.memfd, F_DUPFD_CLOEXEC, 0)) < 0 ||
+             (s.wakeup_fd = fcntl(c.peer_wakeup_fd, F_DUPFD_CLOEXEC, 0)) < 0 ||
+             (s.peer_wakeup_fd = fcntl(c.wakeup_fd, F_DUPFD_CLOEXEC, 0)) < 0) {
+    error = ErrnoError("fcntl(F_DUPFD_CLOEXEC)");
+  }
+  if (error != GRPC_ERROR_NONE) {
+    if (region != MAP_FAILED) munmap(region, kRegionSize);
+    CloseShmConnectionFds(&c);
+    CloseShmConnectionFds(&s);
+    return error;
+  }
+  ShmRegionHeader* header = static_cast<ShmRegionHeader*>(region);
+  header->magic = kShmMagic;
+  header->reserved = 0;
+  header->ring_size = kRingSize;
+  for (int i = 0; i < 2; ++i) {
+    new (RingAt(region, i)) ShmRingHeader();
+  }
+  munmap(region, kRegionSize);
+  *client = c;
+  *server = s;
+  return GRPC_ERROR_NONE;
+}
+
+void CloseShmConnectionFds(ShmConnectionFds* fds) {
+  for (int* fd :
+       {&fds->memfd, &fds->wakeup_fd, &fds->peer_wakeup_fd, &fds->socket}) {
+    if (*fd >= 0) close(*fd);
+    *fd = -1;
+  }
+}
+
+grpc_error_handle CreateShmEndpoint(ShmConnectionFds* fds, bool is_client,
+                                    absl::string_view peer,
+                                    grpc_endpoint** endpoint) {
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  void* region = MAP_FAILED;
+  struct stat st;
+  if (fds->memfd < 0 || fds->wakeup_fd < 0 || fds->peer_wakeup_fd < 0 ||
+      fds->socket < 0) {
+    error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Incomplete shared-memory connection");
+  } else if (fstat(fds->memfd, &st) != 0) {
+    error = ErrnoError("fstat");
+  } else if (static_cast<size_t>(st.st_size) != kRegionSize ||
+             (fcntl(fds->memfd, F_GET_SEALS) & kRequiredSeals) !=
+                 kRequiredSeals) {
+    error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Shared-memory region has the wrong size or is not sealed");
+  } else if ((region = mmap(nullptr, kRegionSize, PROT_READ | PROT_WRITE,
+                            MAP_SHARED, fds->memfd, 0)) == MAP_FAILED) {
+    error = ErrnoError("mmap");
+  } else {
+    const ShmRegionHeader* header = static_cast<ShmRegionHeader*>(region);
+    if (header->magic != kShmMagic || header->ring_size != kRingSize) {
+      error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "Shared-memory region has an unknown layout");
+    }
+  }
+  if (error != GRPC_ERROR_NONE) {
+    if (region != MAP_FAILED) munmap(region, kRegionSize);
+    CloseShmConnectionFds(fds);
+    return error;
+  }
+  // The mapping keeps the region alive.
+  close(fds->memfd);
+  fds->memfd = -1;
+  *endpoint = (new ShmEndpoint(fds, region, is_client, peer))->base();
+  return GRPC_ERROR_NONE;
+}
+
+grpc_endpoint_pair CreateShmEndpointPair(const char* name) {
+  ShmConnectionFds client;
+  ShmConnectionFds server;
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("CreateShmConnection",
+                               CreateShmConnection(&client, &server)));
+  int sv[2];
+  GPR_ASSERT(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                        0, sv) == 0);
+  client.socket = sv[0];
+  server.socket = sv[1];
+  grpc_endpoint_pair p;
+  GPR_ASSERT(GRPC_LOG_IF_ERROR(
+      "CreateShmEndpoint",
+      CreateShmEndpoint(&client, true, absl::StrCat(name, ":client"),
+                        &p.client)));
+  GPR_ASSERT(GRPC_LOG_IF_ERROR(
+      "CreateShmEndpoint",
+      CreateShmEndpoint(&server, false, absl::StrCat(name, ":server"),
+                        &p.server)));
+  return p;
+}
+
+}  // namespace grpc_core
+
+#else  // !GRPC_HAVE_SHM_ENDPOINT
+
+namespace grpc_core {
+
+grpc_error_handle CreateShmConnection(ShmConnectionFds* /*client*/,
+                                      ShmConnectionFds* /*server*/) {
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "Shared-memory connections are not supported on this platform");
+}
+
+void CloseShmConnectionFds(ShmConnectionFds* /*fds*/) {}
+
+grpc_error_handle CreateShmEndpoint(ShmConnectionFds* /*fds*/,
+                                    bool /*is_client*/,
+                                    absl::string_view /*peer*/,
+                                    grpc_endpoint** /*endpoint*/) {
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "Shared-memory connections are not supported on this platform");
+}
+
+grpc_endpoint_pair CreateShmEndpointPair(const char* /*name*/) {
+  GPR_ASSERT(0);
+  return {nullptr, nullptr};
+}
+
+}  // namespace grpc_core
+
+#endif  // GRPC_HAVE_SHM_ENDPOINT
@@ -0,0 +1,72 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
+#define GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
+
+#include <grpc/support/port_platform.h>
+
+#include "absl/strings/string_view.h"
+
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/endpoint_pair.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/port.h"
+
+// Shared-memory endpoints need memfd, eventfd and unix sockets.
+#if defined(GPR_LINUX) && defined(GRPC_LINUX_EVENTFD) && \
+    defined(GRPC_HAVE_UNIX_SOCKET)
+#define GRPC_HAVE_SHM_ENDPOINT 1
+#endif
+
+namespace grpc_core {
+
+// Descriptors for one end of a shared-memory connection. The memfd holds
+// one ring buffer per direction. This end waits on wakeup_fd, which the peer
+// signals, and signals peer_wakeup_fd. The unix socket carries no data once
+// the connection is set up: it is only watched so that either side sees the
+// other one exit.
+struct ShmConnectionFds {
+  int memfd = -1;
+  int wakeup_fd = -1;
+  int peer_wakeup_fd = -1;
+  int socket = -1;
+};
+
+// Creates the shared region and wakeup eventfds of a new connection. Both
+// ends get their own descriptors, with the sockets left unset: the server's
+// are meant to be passed over a unix socket and closed by the client.
+grpc_error_handle CreateShmConnection(ShmConnectionFds* client,
+                                      ShmConnectionFds* server);
+
+// Closes every descriptor of fds that is set.
+void CloseShmConnectionFds(ShmConnectionFds* fds);
+
+// Creates an endpoint over a connection set up by CreateShmConnection. Takes
+// ownership of every descriptor of fds, including on failure. The client
+// writes the first ring and reads the second, and the server the reverse.
+grpc_error_handle CreateShmEndpoint(ShmConnectionFds* fds, bool is_client,
+                                    absl::string_view peer,
+                                    grpc_endpoint** endpoint);
+
+// Creates a connected pair of shared-memory endpoints in this process.
+grpc_endpoint_pair CreateShmEndpointPair(const char* name);
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H */
@@ -0,0 +1,446 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/shm/shm_transport.h"
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+
+#ifdef GRPC_HAVE_SHM_ENDPOINT
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_args_preconditioning.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/surface/channel.h"
+#include "src/core/lib/surface/lame_client.h"
+#include "src/core/lib/transport/transport.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Sent by the client along with the server's descriptors.
+constexpr char kShmHello[8] = {'g', 'r', 'p', 'c', 's', 'h', 'm', '1'};
+constexpr int kShmHelloFds = 3;
+
+grpc_error_handle ErrnoError(const char* call) {
+  return GRPC_OS_ERROR(errno, call);
+}
+
+grpc_error_handle MakeUnixAddress(const char* path, sockaddr_un* addr) {
+  memset(addr, 0, sizeof(*addr));
+  addr->sun_family = AF_UNIX;
+  if (strlen(path) >= sizeof(addr->sun_path)) {
+    return GRPC_ERROR_CREATE_FROM_CPP_STRING(
+        absl::StrCat("Path name too long for a unix socket: ", path));
+  }
+  strcpy(addr->sun_path, path);
+  return GRPC_ERROR_NONE;
+}
+
+// Connects to the listener at path and hands it the server's half of a new
+// connection. Blocks, like connecting to a unix socket does.
+grpc_error_handle ShmConnect(const char* path, grpc_endpoint** endpoint) {
+  sockaddr_un addr;
+  grpc_error_handle error = MakeUnixAddress(path, &addr);
+  if (error != GRPC_ERROR_NONE) return error;
+  ShmConnectionFds client;
+  ShmConnectionFds server;
+  error = CreateShmConnection(&client, &server);
+  if (error != GRPC_ERROR_NONE) return error;
+  client.socket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (client.socket < 0) {
+    error = ErrnoError("socket");
+  } else if (connect(client.socket, reinterpret_cast<sockaddr*>(&addr),
+                     sizeof(addr)) != 0) {
+    error = ErrnoError("connect");
+  } else {
+    char hello[sizeof(kShmHello)];
+    memcpy(hello, kShmHello, sizeof(hello));
+    iovec iov = {hello, sizeof(hello)};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * kShmHelloFds)];
+    memset(control, 0, sizeof(control));
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * kShmHelloFds);
+    const int fds[kShmHelloFds] = {server.memfd, server.wakeup_fd,
+                                   server.peer_wakeup_fd};
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+    ssize_t sent;
+    do {
+      sent = sendmsg(client.socket, &msg, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    if (sent != static_cast<ssize_t>(sizeof(hello))) {
+      error = ErrnoError("sendmsg");
+    } else if (fcntl(client.socket, F_SETFL,
+                     fcntl(client.socket, F_GETFL) | O_NONBLOCK) != 0) {
+      error = ErrnoError("fcntl(O_NONBLOCK)");
+    }
+  }
+  // The server has its own copies now.
+  CloseShmConnectionFds(&server);
+  if (error != GRPC_ERROR_NONE) {
+    CloseShmConnectionFds(&client);
+    return error;
+  }
+  return CreateShmEndpoint(&client, /*is_client=*/true, path, endpoint);
+}
+
+// Receives the hello of a client. Returns false if it has not arrived yet.
+bool ShmReceiveHello(int socket, ShmConnectionFds* fds,
+                     grpc_error_handle* error) {
+  char hello[sizeof(kShmHello)];
+  iovec iov = {hello, sizeof(hello)};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * kShmHelloFds)];
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  ssize_t received;
+  do {
+    received = recvmsg(socket, &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+  } while (received < 0 && errno == EINTR);
+  if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return false;
+  // Take ownership of whatever descriptors came along before validating.
+  std::vector<int> received_fds;
+  for (cmsghdr* cmsg = received < 0 ? nullptr : CMSG_FIRSTHDR(&msg);
+       cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+      continue;
+    }
+    size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+    for (size_t i = 0; i < count; ++i) {
+      int fd;
+      memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(fd));
+      received_fds.push_back(fd);
+    }
+  }
+  if (received < 0) {
+    *error = ErrnoError("recvmsg");
+  } else if (received != static_cast<ssize_t>(sizeof(hello)) ||
+             memcmp(hello, kShmHello, sizeof(hello)) != 0 ||
+             (msg.msg_flags & MSG_CTRUNC) != 0 ||
+             received_fds.size() != kShmHelloFds) {
+    *error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Bad shared-memory connection request");
+  } else {
+    fds->memfd = received_fds[0];
+    fds->wakeup_fd = received_fds[1];
+    fds->peer_wakeup_fd = received_fds[2];
+    return true;
+  }
+  for (int fd : received_fds) close(fd);
+  return true;
+}
+
+class ShmListener : public Server::ListenerInterface {
+ public:
+  ShmListener(Server* server, int fd, std::string path)
+      : server_(server), path_(std::move(path)) {
+    std::string name = absl::StrCat("shm-listener:", path_);
+    listen_fd_ = grpc_fd_create(fd, name.c_str(), false);
+    GRPC_CLOSURE_INIT(&on_accept_, OnAccept, this, grpc_schedule_on_exec_ctx);
+  }
+
+  ~ShmListener() override {
+    grpc_fd_orphan(listen_fd_, nullptr, nullptr, "shm_listener");
+    unlink(path_.c_str());
+    if (on_destroy_done_ != nullptr) {
+      ExecCtx::Run(DEBUG_LOCATION, on_destroy_done_, GRPC_ERROR_NONE);
+    }
+  }
+
+  void Start(Server* /*server*/,
+             const std::vector<grpc_pollset*>* pollsets) override {
+    MutexLock lock(&mu_);
+    pollsets_ = pollsets;
+    for (grpc_pollset* pollset : *pollsets_) {
+      grpc_pollset_add_fd(pollset, listen_fd_);
+    }
+    refs_.Ref();
+    grpc_fd_notify_on_read(listen_fd_, &on_accept_);
+  }
+
+  channelz::ListenSocketNode* channelz_listen_socket_node() const override {
+    return nullptr;
+  }
+
+  void SetOnDestroyDone(grpc_closure* on_destroy_done) override {
+    on_destroy_done_ = on_destroy_done;
+  }
+
+  void Orphan() override {
+    {
+      MutexLock lock(&mu_);
+      shutdown_ = true;
+      grpc_fd_shutdown(listen_fd_, GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                                       "Shared-memory listener shut down"));
+      for (Connection* connection : connections_) {
+        grpc_fd_shutdown(connection->fd,
+                         GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                             "Shared-memory listener shut down"));
+      }
+    }
+    Unref();
+  }
+
+ private:
+  // An accepted socket whose client has not sent its hello yet.
+  struct Connection {
+    ShmListener* listener;
+    grpc_fd* fd;
+    grpc_closure on_readable;
+  };
+
+  void Unref() {
+    if (refs_.Unref()) delete this;
+  }
+
+  static void OnAccept(void* arg, grpc_error_handle error) {
+    ShmListener* self = static_cast<ShmListener*>(arg);
+    if (error != GRPC_ERROR_NONE) {
+      self->Unref();
+      return;
+    }
+    MutexLock lock(&self->mu_);
+    for (;;) {
+      int fd = accept4(grpc_fd_wrapped_fd(self->listen_fd_), nullptr, nullptr,
+                       SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if (fd < 0) {
+        if (errno == EINTR || errno == ECONNABORTED) continue;
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+          gpr_log(GPR_ERROR, "%s: accept4: %s", self->path_.c_str(),
+                  strerror(errno));
+        }
+        break;
+      }
+      if (self->shutdown_) {
+        close(fd);
+        continue;
+      }
+      Connection* connection = new Connection;
+      connection->listener = self;
+      std::string name = absl::StrCat("shm-connection:", self->path_);
+      connection->fd = grpc_fd_create(fd, name.c_str(), false);
+      GRPC_CLOSURE_INIT(&connection->on_readable, OnHello, connection,
+                        grpc_schedule_on_exec_ctx);
+      for (grpc_pollset* pollset : *self->pollsets_) {
+        grpc_pollset_add_fd(pollset, connection->fd);
+      }
+      self->connections_.insert(connection);
+      self->refs_.Ref();
+      grpc_fd_notify_on_read(connection->fd, &connection->on_readable);
+    }
+    grpc_fd_notify_on_read(self->listen_fd_, &self->on_accept_);
+  }
+
+  static void OnHello(void* arg, grpc_error_handle error) {
+    Connection* connection = static_cast<Connection*>(arg);
+    ShmListener* self = connection->listener;
+    ShmConnectionFds fds;
+    if (error == GRPC_ERROR_NONE) {
+      if (!ShmReceiveHello(grpc_fd_wrapped_fd(connection->fd), &fds,
+                           &error)) {
+        grpc_fd_notify_on_read(connection->fd, &connection->on_readable);
+        return;
+      }
+    } else {
+      error = GRPC_ERROR_REF(error);
+    }
+    {
+      MutexLock lock(&self->mu_);
+      self->connections_.erase(connection);
+      // The socket now belongs to the endpoint, if there is one.
+      grpc_fd_orphan(connection->fd, nullptr,
+                     error == GRPC_ERROR_NONE ? &fds.socket : nullptr,
+                     "shm_hello");
+      if (error == GRPC_ERROR_NONE && self->shutdown_) {
+        error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "Shared-memory listener shut down");
+      }
+      if (error == GRPC_ERROR_NONE) {
+        self->SetupTransportLocked(&fds);
+      } else {
+        CloseShmConnectionFds(&fds);
+        gpr_log(GPR_DEBUG, "%s: dropping connection: %s", self->path_.c_str(),
+                grpc_error_std_string(error).c_str());
+        GRPC_ERROR_UNREF(error);
+      }
+    }
+    delete connection;
+    self->Unref();
+  }
+
+  void SetupTransportLocked(ShmConnectionFds* fds)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    grpc_endpoint* endpoint = nullptr;
+    grpc_error_handle error =
+        CreateShmEndpoint(fds, /*is_client=*/false, path_, &endpoint);
+    if (error != GRPC_ERROR_NONE) {
+      gpr_log(GPR_ERROR, "%s: failed to map connection: %s", path_.c_str(),
+              grpc_error_std_string(error).c_str());
+      GRPC_ERROR_UNREF(error);
+      return;
+    }
+    const grpc_channel_args* args = server_->channel_args();
+    grpc_transport* transport =
+        grpc_create_chttp2_transport(args, endpoint, /*is_client=*/false);
+    error = server_->SetupTransport(transport, nullptr, args, nullptr);
+    if (error != GRPC_ERROR_NONE) {
+      gpr_log(GPR_ERROR, "%s: failed to create channel: %s", path_.c_str(),
+              grpc_error_std_string(error).c_str());
+      GRPC_ERROR_UNREF(error);
+      grpc_transport_destroy(transport);
+      return;
+    }
+    for (grpc_pollset* pollset : *pollsets_) {
+      grpc_endpoint_add_to_pollset(endpoint, pollset);
+    }
+    grpc_chttp2_transport_start_reading(transport, nullptr, nullptr, nullptr);
+  }
+
+  Server* const server_;
+  const std::string path_;
+  grpc_fd* listen_fd_;
+  grpc_closure on_accept_;
+  grpc_closure* on_destroy_done_ = nullptr;
+  // One ref for the server, one while accepting, and one per connection.
+  RefCount refs_;
+  Mutex mu_;
+  const std::vector<grpc_pollset*>* pollsets_ ABSL_GUARDED_BY(mu_) = nullptr;
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  std::set<Connection*> connections_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace
+
+grpc_channel* CreateShmChannel(const char* path,
+                               const grpc_channel_args* args) {
+  ExecCtx exec_ctx;
+  std::string target = absl::StrCat("shm:", path);
+  grpc_endpoint* endpoint = nullptr;
+  grpc_error_handle error = ShmConnect(path, &endpoint);
+  if (error != GRPC_ERROR_NONE) {
+    gpr_log(GPR_ERROR, "Failed to connect to %s: %s", target.c_str(),
+            grpc_error_std_string(error).c_str());
+    GRPC_ERROR_UNREF(error);
+    return grpc_lame_client_channel_create(
+        target.c_str(), GRPC_STATUS_UNAVAILABLE,
+        "Failed to create shared-memory channel");
+  }
+  const grpc_channel_args* final_args =
+      CoreConfiguration::Get()
+          .channel_args_preconditioning()
+          .PreconditionChannelArgs(args)
+          .SetIfUnset(GRPC_ARG_DEFAULT_AUTHORITY, "localhost")
+          .ToC();
+  grpc_transport* transport =
+      grpc_create_chttp2_transport(final_args, endpoint, /*is_client=*/true);
+  auto channel = Channel::Create(target.c_str(), ChannelArgs::FromC(final_args),
+                                 GRPC_CLIENT_DIRECT_CHANNEL, transport);
+  grpc_channel_args_destroy(final_args);
+  if (!channel.ok()) {
+    grpc_transport_destroy(transport);
+    return grpc_lame_client_channel_create(
+        target.c_str(), static_cast<grpc_status_code>(channel.status().code()),
+        "Failed to create shared-memory channel");
+  }
+  grpc_chttp2_transport_start_reading(transport, nullptr, nullptr, nullptr);
+  ExecCtx::Get()->Flush();
+  return channel->release()->c_ptr();
+}
+
+grpc_error_handle AddShmListener(Server* server, const char* path) {
+  sockaddr_un addr;
+  grpc_error_handle error = MakeUnixAddress(path, &addr);
+  if (error != GRPC_ERROR_NONE) return error;
+  // Replace the socket of a previous server, but nothing else.
+  struct stat st;
+  if (lstat(path, &st) == 0 && S_ISSOCK(st.st_mode)) unlink(path);
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) return ErrnoError("socket");
+  if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    error = ErrnoError("bind");
+  } else if (listen(fd, SOMAXCONN) != 0) {
+    error = ErrnoError("listen");
+  }
+  if (error != GRPC_ERROR_NONE) {
+    close(fd);
+    return error;
+  }
+  server->AddListener(MakeOrphanable<ShmListener>(server, fd, path));
+  return GRPC_ERROR_NONE;
+}
+
+}  // namespace grpc_core
+
+#else  // !GRPC_HAVE_SHM_ENDPOINT
+
+#include "src/core/lib/surface/lame_client.h"
+
+namespace grpc_core {
+
+grpc_channel* CreateShmChannel(const char* path,
+                               const grpc_channel_args* /*args*/) {
+  return grpc_lame_client_channel_create(
+      path, GRPC_STATUS_UNIMPLEMENTED,
+      "Shared-memory channels are not supported on this platform");
+}
+
+grpc_error_handle AddShmListener(Server* /*server*/, const char* /*path*/) {
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "Shared-memory listeners are not supported on this platform");
+}
+
+}  // namespace grpc_core
+
+#endif  // GRPC_HAVE_SHM_ENDPOINT
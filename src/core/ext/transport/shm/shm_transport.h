@@ -0,0 +1,48 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_SHM_SHM_TRANSPORT_H
+#define GRPC_CORE_EXT_TRANSPORT_SHM_SHM_TRANSPORT_H
+
+#include <grpc/support/port_platform.h>
+
+#include <grpc/impl/codegen/grpc_types.h>
+
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/surface/server.h"
+
+// Shared-memory transport for processes on the same host. HTTP/2 frames are
+// exchanged through a pair of ring buffers in a sealed memfd, and the reader
+// of each ring sleeps on an eventfd that the writer signals. The descriptors
+// are handed to the server over a unix socket, which then stays open so that
+// each side sees the other one exit.
+
+namespace grpc_core {
+
+// Creates a channel over a shared-memory connection to the server listening
+// on the unix socket at path. Returns a lame channel if that fails.
+grpc_channel* CreateShmChannel(const char* path,
+                               const grpc_channel_args* args);
+
+// Makes server accept shared-memory connections on the unix socket at path.
+// Must be called before the server is started.
+grpc_error_handle AddShmListener(Server* server, const char* path);
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_EXT_TRANSPORT_SHM_SHM_TRANSPORT_H */
@@ -21,6 +21,7 @@
 
 #include <stdint.h>
 
+#include <memory>
 #include <set>
 
 #include "envoy/admin/v3/config_dump.upb.h"
@@ -55,6 +56,8 @@ class XdsApi {
       std::string version;
       std::string nonce;
       size_t num_resources;
+      // Names of the resources removed by a delta ADS response.
+      std::vector<std::string> removed_resources;
     };
 
     virtual ~AdsResponseParserInterface() = default;
@@ -65,8 +68,12 @@ class XdsApi {
     virtual absl::Status ProcessAdsResponseFields(AdsResponseFields fields) = 0;
 
     // Called to parse each individual resource in the ADS response.
+    // resource_name and resource_version are only set for delta ADS
+    // responses, which carry them outside of the resource.
     virtual void ParseResource(const XdsEncodingContext& context, size_t idx,
                                absl::string_view type_url,
+                               absl::string_view resource_name,
+                               absl::string_view resource_version,
                                absl::string_view serialized_resource) = 0;
   };
 
@@ -150,12 +157,30 @@ class XdsApi {
                               const std::vector<std::string>& resource_names,
                               grpc_error_handle error, bool populate_node);
 
+  // Creates a delta ADS request, which carries the changes to the
+  // subscribed resource names since the last request of the type.
+  // initial_resource_versions holds the versions of the resources the
+  // client already has, for the first request of the type on a stream.
+  // Takes ownership of \a error.
+  grpc_slice CreateDeltaAdsRequest(
+      const XdsBootstrap::XdsServer& server, absl::string_view type_url,
+      absl::string_view nonce,
+      const std::vector<std::string>& resource_names_subscribe,
+      const std::vector<std::string>& resource_names_unsubscribe,
+      const std::map<std::string, std::string>& initial_resource_versions,
+      grpc_error_handle error, bool populate_node);
+
   // Returns non-OK when failing to deserialize response message.
   // Otherwise, all events are reported to the parser.
   absl::Status ParseAdsResponse(const XdsBootstrap::XdsServer& server,
                                 const grpc_slice& encoded_response,
                                 AdsResponseParserInterface* parser);
 
+  // Same as ParseAdsResponse() for delta ADS responses.
+  absl::Status ParseDeltaAdsResponse(const XdsBootstrap::XdsServer& server,
+                                     const grpc_slice& encoded_response,
+                                     AdsResponseParserInterface* parser);
+
   // Creates an initial LRS request.
   grpc_slice CreateLrsInitialRequest(const XdsBootstrap::XdsServer& server);
 
@@ -175,6 +200,12 @@ class XdsApi {
       const ResourceTypeMetadataMap& resource_type_metadata_map);
 
  private:
+  // Returns an arena for parsing a response of the given size.  Its
+  // initial block is reused across responses, so that parsing a response
+  // normally allocates nothing but the resources it produces.  Only one
+  // such arena may be alive at a time; callers serialize parsing.
+  upb::Arena CreateResponseArena(size_t encoded_response_size);
+
   XdsClient* client_;
   TraceFlag* tracer_;
   const XdsBootstrap::Node* node_;  // Do not own.
@@ -184,6 +215,8 @@ class XdsApi {
   const std::string build_version_;
   const std::string user_agent_name_;
   const std::string user_agent_version_;
+  std::unique_ptr<char[]> response_arena_block_;
+  size_t response_arena_block_size_ = 0;
 };
 
 }  // namespace grpc_core
@@ -162,6 +162,11 @@ bool XdsBootstrap::XdsServer::ShouldUseV3() const {
   return server_features.find("xds_v3") != server_features.end();
 }
 
+bool XdsBootstrap::XdsServer::ShouldUseDeltaAds() const {
+  return ShouldUseV3() &&
+         server_features.find("xds_delta") != server_features.end();
+}
+
 //
 // XdsBootstrap
 //
@@ -242,6 +247,15 @@ XdsBootstrap::XdsBootstrap(Json json, grpc_error_handle* error) {
           std::move(*it->second.mutable_string_value());
     }
   }
+  it = json.mutable_object()->find("resource_cache_file");
+  if (it != json.mutable_object()->end()) {
+    if (it->second.type() != Json::Type::STRING) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "\"resource_cache_file\" field is not a string"));
+    } else {
+      resource_cache_file_ = std::move(*it->second.mutable_string_value());
+    }
+  }
   it = json.mutable_object()->find("certificate_providers");
   if (it != json.mutable_object()->end()) {
     if (it->second.type() != Json::Type::OBJECT) {
@@ -537,6 +551,10 @@ std::string XdsBootstrap::ToString() const {
         absl::StrFormat("server_listener_resource_name_template=\"%s\",\n",
                         server_listener_resource_name_template_));
   }
+  if (!resource_cache_file_.empty()) {
+    parts.push_back(
+        absl::StrFormat("resource_cache_file=\"%s\",\n", resource_cache_file_));
+  }
   parts.push_back("authorities={\n");
   for (const auto& entry : authorities_) {
     parts.push_back(absl::StrFormat("  %s={\n", entry.first));
@@ -78,6 +78,8 @@ class XdsBootstrap {
     Json::Object ToJson() const;
 
     bool ShouldUseV3() const;
+    // Whether to use the incremental (delta) variant of ADS. Requires v3.
+    bool ShouldUseDeltaAds() const;
   };
 
   struct Authority {
@@ -106,6 +108,12 @@ class XdsBootstrap {
   const std::string& server_listener_resource_name_template() const {
     return server_listener_resource_name_template_;
   }
+  // File in which the XdsClient persists the last valid resources, so
+  // that they can be used at startup before the server responds.  Empty
+  // if not configured.
+  const std::string& resource_cache_file() const {
+    return resource_cache_file_;
+  }
   const std::map<std::string, Authority>& authorities() const {
     return authorities_;
   }
@@ -132,6 +140,7 @@ class XdsBootstrap {
   std::unique_ptr<Node> node_;
   std::string client_default_listener_resource_name_template_;
   std::string server_listener_resource_name_template_;
+  std::string resource_cache_file_;
   std::map<std::string, Authority> authorities_;
   CertificateProviderStore::PluginDefinitionMap certificate_providers_;
 };
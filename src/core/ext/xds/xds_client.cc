@@ -20,9 +20,11 @@
 
 #include <inttypes.h>
 #include <limits.h>
+#include <stdio.h>
 #include <string.h>
 
 #include "absl/container/inlined_vector.h"
+#include "absl/hash/hash.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
@@ -53,9 +55,12 @@
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/load_file.h"
 #include "src/core/lib/iomgr/sockaddr.h"
 #include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/json/json.h"
 #include "src/core/lib/security/credentials/channel_creds_registry.h"
+#include "src/core/lib/slice/b64.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/surface/call.h"
@@ -162,6 +167,8 @@ class XdsClient::ChannelState::AdsCallState
       std::map<std::string /*authority*/, std::set<XdsResourceKey>>
           resources_seen;
       bool have_valid_resources = false;
+      // Only for delta ADS.
+      std::vector<std::string> removed_resources;
     };
 
     explicit AdsResponseParser(AdsCallState* ads_call_state)
@@ -172,6 +179,8 @@ class XdsClient::ChannelState::AdsCallState
 
     void ParseResource(const XdsEncodingContext& context, size_t idx,
                        absl::string_view type_url,
+                       absl::string_view resource_name,
+                       absl::string_view resource_version,
                        absl::string_view serialized_resource) override
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
 
@@ -180,6 +189,16 @@ class XdsClient::ChannelState::AdsCallState
    private:
     XdsClient* xds_client() const { return ads_call_state_->xds_client(); }
 
+    // Handles a resource whose serialized proto is identical to the one
+    // we have, without decoding it.  Returns false if there is no such
+    // resource.
+    bool MaybeSkipUnchangedResource(absl::string_view resource_version,
+                                    absl::string_view serialized_resource)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+    void MaybeCancelResourceTimer(const XdsResourceName& name)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
     AdsCallState* ads_call_state_;
     const Timestamp update_time_ = ExecCtx::Get()->Now();
     Result result_;
@@ -198,9 +217,15 @@ class XdsClient::ChannelState::AdsCallState
       Unref(DEBUG_LOCATION, "Orphan");
     }
 
-    void MaybeStartTimer(RefCountedPtr<AdsCallState> ads_calld) {
+    void MaybeStartTimer(RefCountedPtr<AdsCallState> ads_calld)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_) {
       if (!timer_start_needed_) return;
       timer_start_needed_ = false;
+      // If we already have the resource, because it was loaded from the
+      // resource cache file or received on a previous ADS stream, don't
+      // start the timer: its absence from the server is detected when the
+      // server says so, and until then the resource we have stays usable.
+      if (HaveResourceLocked(ads_calld->xds_client())) return;
       ads_calld_ = std::move(ads_calld);
       Ref(DEBUG_LOCATION, "timer").release();
       timer_pending_ = true;
@@ -230,6 +255,19 @@ class XdsClient::ChannelState::AdsCallState
     }
 
    private:
+    bool HaveResourceLocked(XdsClient* xds_client) const
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_) {
+      auto authority_it =
+          xds_client->authority_state_map_.find(name_.authority);
+      if (authority_it == xds_client->authority_state_map_.end()) {
+        return false;
+      }
+      auto type_it = authority_it->second.resource_map.find(type_);
+      if (type_it == authority_it->second.resource_map.end()) return false;
+      auto it = type_it->second.find(name_.key);
+      return it != type_it->second.end() && it->second.resource != nullptr;
+    }
+
     static void OnTimer(void* arg, grpc_error_handle error) {
       ResourceTimer* self = static_cast<ResourceTimer*>(arg);
       {
@@ -283,6 +321,12 @@ class XdsClient::ChannelState::AdsCallState
     std::string nonce;
     grpc_error_handle error = GRPC_ERROR_NONE;
 
+    // For delta ADS: changes to the subscribed resource names not yet
+    // sent, and whether a request has been sent for this type yet.
+    std::set<std::string> names_to_subscribe;
+    std::set<std::string> names_to_unsubscribe;
+    bool sent_initial_request = false;
+
     // Subscribed resources of this type.
     std::map<std::string /*authority*/,
              std::map<XdsResourceKey, OrphanablePtr<ResourceTimer>>>
@@ -308,9 +352,31 @@ class XdsClient::ChannelState::AdsCallState
   // request.  Also starts the timer for each resource if needed.
   std::vector<std::string> ResourceNamesForRequest(const XdsResourceType* type);
 
+  // Returns the cache entry for a resource, or null if not subscribed.
+  ResourceState* FindResourceStateLocked(const XdsResourceType* type,
+                                         absl::string_view name)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+  ResourceState* FindResourceStateLocked(const XdsResourceType* type,
+                                         const XdsResourceName& name)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+  // Returns the versions of the cached resources of a given type, for the
+  // first delta ADS request of the type.
+  std::map<std::string, std::string> ResourceVersionsForDeltaRequest(
+      const XdsResourceType* type)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+  // Handles the resources removed by a delta ADS response.
+  void RemoveResourcesLocked(const XdsResourceType* type,
+                             const std::vector<std::string>& names)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
   // The owning RetryableCall<>.
   RefCountedPtr<RetryableCall<AdsCallState>> parent_;
 
+  // Whether this call uses the incremental (delta) ADS protocol.
+  const bool delta_;
+
   bool sent_initial_message_ = false;
   bool seen_response_ = false;
 
@@ -752,6 +818,7 @@ absl::Status XdsClient::ChannelState::AdsCallState::AdsResponseParser::
   result_.type_url = std::move(fields.type_url);
   result_.version = std::move(fields.version);
   result_.nonce = std::move(fields.nonce);
+  result_.removed_resources = std::move(fields.removed_resources);
   return absl::OkStatus();
 }
 
@@ -768,6 +835,11 @@ XdsApi::ResourceMetadata CreateResourceMetadataAcked(
   return resource_metadata;
 }
 
+// Key of a serialized resource in XdsClient::resource_hash_index_.
+size_t HashSerializedResource(absl::string_view serialized_resource) {
+  return absl::Hash<absl::string_view>()(serialized_resource);
+}
+
 // Update resource_metadata for NACK.
 void UpdateResourceMetadataNacked(const std::string& version,
                                   const std::string& details,
@@ -783,6 +855,8 @@ void UpdateResourceMetadataNacked(const std::string& version,
 
 void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
     const XdsEncodingContext& context, size_t idx, absl::string_view type_url,
+    absl::string_view delta_resource_name,
+    absl::string_view delta_resource_version,
     absl::string_view serialized_resource) {
   // Check the type_url of the resource.
   bool is_v2 = false;
@@ -792,6 +866,23 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
                      type_url, " (should be ", result_.type_url, ")"));
     return;
   }
+  // Delta ADS carries a version per resource. If we already have this
+  // version of the resource, skip decoding it again.
+  if (ads_call_state_->delta_ && !delta_resource_version.empty()) {
+    ResourceState* resource_state = ads_call_state_->FindResourceStateLocked(
+        result_.type, delta_resource_name);
+    if (resource_state != nullptr && resource_state->resource != nullptr &&
+        resource_state->meta.client_status ==
+            XdsApi::ResourceMetadata::ACKED &&
+        resource_state->meta.version == delta_resource_version) {
+      result_.have_valid_resources = true;
+      return;
+    }
+  }
+  // If the server resent a resource we have, skip decoding it again.
+  if (MaybeSkipUnchangedResource(delta_resource_version, serialized_resource)) {
+    return;
+  }
   // Parse the resource.
   absl::StatusOr<XdsResourceType::DecodeResult> result =
       result_.type->Decode(context, serialized_resource, is_v2);
@@ -810,17 +901,7 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
     return;
   }
   // Cancel resource-does-not-exist timer, if needed.
-  auto timer_it = ads_call_state_->state_map_.find(result_.type);
-  if (timer_it != ads_call_state_->state_map_.end()) {
-    auto it =
-        timer_it->second.subscribed_resources.find(resource_name->authority);
-    if (it != timer_it->second.subscribed_resources.end()) {
-      auto res_it = it->second.find(resource_name->key);
-      if (res_it != it->second.end()) {
-        res_it->second->MaybeCancelTimer();
-      }
-    }
-  }
+  MaybeCancelResourceTimer(*resource_name);
   // Lookup the authority in the cache.
   auto authority_it =
       xds_client()->authority_state_map_.find(resource_name->authority);
@@ -844,6 +925,10 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
   if (result_.type->AllResourcesRequiredInSotW()) {
     result_.resources_seen[resource_name->authority].insert(resource_name->key);
   }
+  // Delta ADS versions resources individually.
+  const std::string& version = ads_call_state_->delta_
+                                   ? std::string(delta_resource_version)
+                                   : result_.version;
   // Update resource state based on whether the resource is valid.
   if (!result->resource.ok()) {
     result_.errors.emplace_back(absl::StrCat(
@@ -853,8 +938,7 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
         resource_state.watchers,
         absl::UnavailableError(absl::StrCat(
             "invalid resource: ", result->resource.status().ToString())));
-    UpdateResourceMetadataNacked(result_.version,
-                                 result->resource.status().ToString(),
+    UpdateResourceMetadataNacked(version, result->resource.status().ToString(),
                                  update_time_, &resource_state.meta);
     return;
   }
@@ -869,12 +953,24 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
               "[xds_client %p] %s resource %s identical to current, ignoring.",
               xds_client(), result_.type_url.c_str(), result->name.c_str());
     }
+    if (ads_call_state_->delta_) {
+      resource_state.meta = CreateResourceMetadataAcked(
+          std::string(serialized_resource), version, update_time_);
+    }
+    xds_client()->resource_hash_index_[result_.type][HashSerializedResource(
+        serialized_resource)] = *resource_name;
     return;
   }
   // Update the resource state.
+  auto& hash_index = xds_client()->resource_hash_index_[result_.type];
+  if (!resource_state.meta.serialized_proto.empty()) {
+    hash_index.erase(
+        HashSerializedResource(resource_state.meta.serialized_proto));
+  }
+  hash_index[HashSerializedResource(serialized_resource)] = *resource_name;
   resource_state.resource = std::move(*result->resource);
   resource_state.meta = CreateResourceMetadataAcked(
-      std::string(serialized_resource), result_.version, update_time_);
+      std::string(serialized_resource), version, update_time_);
   // Notify watchers.
   auto& watchers_list = resource_state.watchers;
   auto* value =
@@ -890,6 +986,59 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
       DEBUG_LOCATION);
 }
 
+bool XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    MaybeSkipUnchangedResource(absl::string_view delta_resource_version,
+                               absl::string_view serialized_resource) {
+  auto index_it = xds_client()->resource_hash_index_.find(result_.type);
+  if (index_it == xds_client()->resource_hash_index_.end()) return false;
+  auto& hash_index = index_it->second;
+  auto it = hash_index.find(HashSerializedResource(serialized_resource));
+  if (it == hash_index.end()) return false;
+  const XdsResourceName resource_name = it->second;
+  ResourceState* resource_state =
+      ads_call_state_->FindResourceStateLocked(result_.type, resource_name);
+  if (resource_state == nullptr || resource_state->resource == nullptr ||
+      resource_state->meta.serialized_proto != serialized_resource) {
+    hash_index.erase(it);
+    return false;
+  }
+  // Same handling as for a decoded resource identical to the current one.
+  MaybeCancelResourceTimer(resource_name);
+  if (result_.type->AllResourcesRequiredInSotW()) {
+    result_.resources_seen[resource_name.authority].insert(resource_name.key);
+  }
+  result_.have_valid_resources = true;
+  if (ads_call_state_->delta_) {
+    resource_state->meta = CreateResourceMetadataAcked(
+        std::string(serialized_resource), std::string(delta_resource_version),
+        update_time_);
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
+    gpr_log(GPR_INFO,
+            "[xds_client %p] %s resource %s unchanged, skipped decoding.",
+            xds_client(), result_.type_url.c_str(),
+            XdsClient::ConstructFullXdsResourceName(resource_name.authority,
+                                                    result_.type->type_url(),
+                                                    resource_name.key)
+                .c_str());
+  }
+  return true;
+}
+
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    MaybeCancelResourceTimer(const XdsResourceName& name) {
+  auto timer_it = ads_call_state_->state_map_.find(result_.type);
+  if (timer_it != ads_call_state_->state_map_.end()) {
+    auto it = timer_it->second.subscribed_resources.find(name.authority);
+    if (it != timer_it->second.subscribed_resources.end()) {
+      auto res_it = it->second.find(name.key);
+      if (res_it != it->second.end()) {
+        res_it->second->MaybeCancelTimer();
+      }
+    }
+  }
+}
+
 //
 // XdsClient::ChannelState::AdsCallState
 //
@@ -900,14 +1049,17 @@ XdsClient::ChannelState::AdsCallState::AdsCallState(
           GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_refcount_trace)
               ? "AdsCallState"
               : nullptr),
-      parent_(std::move(parent)) {
+      parent_(std::move(parent)),
+      delta_(chand()->server_.ShouldUseDeltaAds()) {
   // Init the ADS call. Note that the call will progress every time there's
   // activity in xds_client()->interested_parties_, which is comprised of
   // the polling entities from client_channel.
   GPR_ASSERT(xds_client() != nullptr);
   // Create a call with the specified method name.
   const char* method =
-      chand()->server_.ShouldUseV3()
+      delta_ ? "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
+               "DeltaAggregatedResources"
+      : chand()->server_.ShouldUseV3()
           ? "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
             "StreamAggregatedResources"
           : "/envoy.service.discovery.v2.AggregatedDiscoveryService/"
@@ -1032,12 +1184,33 @@ void XdsClient::ChannelState::AdsCallState::SendMessageLocked(
   }
   auto& state = state_map_[type];
   grpc_slice request_payload_slice;
-  request_payload_slice = xds_client()->api_.CreateAdsRequest(
-      chand()->server_,
-      chand()->server_.ShouldUseV3() ? type->type_url() : type->v2_type_url(),
-      chand()->resource_type_version_map_[type], state.nonce,
-      ResourceNamesForRequest(type), GRPC_ERROR_REF(state.error),
-      !sent_initial_message_);
+  if (delta_) {
+    // Starts the resource timers.
+    ResourceNamesForRequest(type);
+    std::map<std::string, std::string> initial_resource_versions;
+    if (!state.sent_initial_request) {
+      initial_resource_versions = ResourceVersionsForDeltaRequest(type);
+      state.sent_initial_request = true;
+    }
+    request_payload_slice = xds_client()->api_.CreateDeltaAdsRequest(
+        chand()->server_, type->type_url(), state.nonce,
+        std::vector<std::string>(state.names_to_subscribe.begin(),
+                                 state.names_to_subscribe.end()),
+        std::vector<std::string>(state.names_to_unsubscribe.begin(),
+                                 state.names_to_unsubscribe.end()),
+        initial_resource_versions, GRPC_ERROR_REF(state.error),
+        !sent_initial_message_);
+    state.names_to_subscribe.clear();
+    state.names_to_unsubscribe.clear();
+  } else {
+    request_payload_slice = xds_client()->api_.CreateAdsRequest(
+        chand()->server_,
+        chand()->server_.ShouldUseV3() ? type->type_url()
+                                       : type->v2_type_url(),
+        chand()->resource_type_version_map_[type], state.nonce,
+        ResourceNamesForRequest(type), GRPC_ERROR_REF(state.error),
+        !sent_initial_message_);
+  }
   sent_initial_message_ = true;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
     gpr_log(GPR_INFO,
@@ -1076,9 +1249,16 @@ void XdsClient::ChannelState::AdsCallState::SendMessageLocked(
 
 void XdsClient::ChannelState::AdsCallState::SubscribeLocked(
     const XdsResourceType* type, const XdsResourceName& name, bool delay_send) {
-  auto& state = state_map_[type].subscribed_resources[name.authority][name.key];
+  auto& type_state = state_map_[type];
+  auto& state = type_state.subscribed_resources[name.authority][name.key];
   if (state == nullptr) {
     state = MakeOrphanable<ResourceTimer>(type, name);
+    if (delta_) {
+      std::string full_name = XdsClient::ConstructFullXdsResourceName(
+          name.authority, type->type_url(), name.key);
+      type_state.names_to_unsubscribe.erase(full_name);
+      type_state.names_to_subscribe.insert(std::move(full_name));
+    }
     if (!delay_send) SendMessageLocked(type);
   }
 }
@@ -1092,6 +1272,14 @@ void XdsClient::ChannelState::AdsCallState::UnsubscribeLocked(
   if (authority_map.empty()) {
     type_state_map.subscribed_resources.erase(name.authority);
   }
+  if (delta_) {
+    std::string full_name = XdsClient::ConstructFullXdsResourceName(
+        name.authority, type->type_url(), name.key);
+    // Nothing to tell the server if it never heard of the subscription.
+    if (type_state_map.names_to_subscribe.erase(full_name) == 0) {
+      type_state_map.names_to_unsubscribe.insert(std::move(full_name));
+    }
+  }
   if (!delay_unsubscription) SendMessageLocked(type);
 }
 
@@ -1145,6 +1333,7 @@ void XdsClient::ChannelState::AdsCallState::OnResponseReceived(
     done = ads_calld->OnResponseReceivedLocked();
   }
   ads_calld->xds_client()->work_serializer_.DrainQueue();
+  ads_calld->xds_client()->MaybeWriteResourceCache();
   if (done) ads_calld->Unref(DEBUG_LOCATION, "ADS+OnResponseReceivedLocked");
 }
 
@@ -1162,8 +1351,11 @@ bool XdsClient::ChannelState::AdsCallState::OnResponseReceivedLocked() {
   recv_message_payload_ = nullptr;
   // Parse and validate the response.
   AdsResponseParser parser(this);
-  absl::Status status = xds_client()->api_.ParseAdsResponse(
-      chand()->server_, response_slice, &parser);
+  absl::Status status =
+      delta_ ? xds_client()->api_.ParseDeltaAdsResponse(
+                   chand()->server_, response_slice, &parser)
+             : xds_client()->api_.ParseAdsResponse(chand()->server_,
+                                                   response_slice, &parser);
   grpc_slice_unref_internal(response_slice);
   if (!status.ok()) {
     // Ignore unparsable response.
@@ -1193,8 +1385,12 @@ bool XdsClient::ChannelState::AdsCallState::OnResponseReceivedLocked() {
                                        GRPC_ERROR_INT_GRPC_STATUS,
                                        GRPC_STATUS_UNAVAILABLE);
     }
+    bool resources_changed =
+        result.have_valid_resources || !result.removed_resources.empty();
+    // Delete resources removed by a delta update.
+    RemoveResourcesLocked(result.type, result.removed_resources);
     // Delete resources not seen in update if needed.
-    if (result.type->AllResourcesRequiredInSotW()) {
+    if (!delta_ && result.type->AllResourcesRequiredInSotW()) {
       for (auto& a : xds_client()->authority_state_map_) {
         const std::string& authority = a.first;
         AuthorityState& authority_state = a.second;
@@ -1220,6 +1416,7 @@ bool XdsClient::ChannelState::AdsCallState::OnResponseReceivedLocked() {
             // instead.
             if (resource_state.resource == nullptr) continue;
             resource_state.resource.reset();
+            resources_changed = true;
             xds_client()->NotifyWatchersOnResourceDoesNotExist(
                 resource_state.watchers);
           }
@@ -1237,6 +1434,10 @@ bool XdsClient::ChannelState::AdsCallState::OnResponseReceivedLocked() {
         if (lrs_calld != nullptr) lrs_calld->MaybeStartReportingLocked();
       }
     }
+    if (resources_changed &&
+        !xds_client()->bootstrap_->resource_cache_file().empty()) {
+      xds_client()->resource_cache_dirty_ = true;
+    }
     // Send ACK or NACK.
     SendMessageLocked(result.type);
   }
@@ -1321,6 +1522,66 @@ XdsClient::ChannelState::AdsCallState::ResourceNamesForRequest(
   return resource_names;
 }
 
+XdsClient::ResourceState*
+XdsClient::ChannelState::AdsCallState::FindResourceStateLocked(
+    const XdsResourceType* type, absl::string_view name) {
+  auto resource_name = XdsClient::ParseXdsResourceName(name, type);
+  if (!resource_name.ok()) return nullptr;
+  return FindResourceStateLocked(type, *resource_name);
+}
+
+XdsClient::ResourceState*
+XdsClient::ChannelState::AdsCallState::FindResourceStateLocked(
+    const XdsResourceType* type, const XdsResourceName& name) {
+  auto authority_it = xds_client()->authority_state_map_.find(name.authority);
+  if (authority_it == xds_client()->authority_state_map_.end()) {
+    return nullptr;
+  }
+  auto type_it = authority_it->second.resource_map.find(type);
+  if (type_it == authority_it->second.resource_map.end()) return nullptr;
+  auto it = type_it->second.find(name.key);
+  if (it == type_it->second.end()) return nullptr;
+  return &it->second;
+}
+
+std::map<std::string, std::string>
+XdsClient::ChannelState::AdsCallState::ResourceVersionsForDeltaRequest(
+    const XdsResourceType* type) {
+  std::map<std::string, std::string> versions;
+  for (const auto& a : xds_client()->authority_state_map_) {
+    const std::string& authority = a.first;
+    // Skip authorities that are not using this xDS channel.
+    if (a.second.channel_state != chand()) continue;
+    auto type_it = a.second.resource_map.find(type);
+    if (type_it == a.second.resource_map.end()) continue;
+    for (const auto& r : type_it->second) {
+      const ResourceState& resource_state = r.second;
+      if (resource_state.resource == nullptr ||
+          resource_state.meta.version.empty()) {
+        continue;
+      }
+      versions.emplace(XdsClient::ConstructFullXdsResourceName(
+                           authority, type->type_url(), r.first),
+                       resource_state.meta.version);
+    }
+  }
+  return versions;
+}
+
+void XdsClient::ChannelState::AdsCallState::RemoveResourcesLocked(
+    const XdsResourceType* type, const std::vector<std::string>& names) {
+  for (const std::string& name : names) {
+    ResourceState* resource_state = FindResourceStateLocked(type, name);
+    if (resource_state == nullptr) continue;
+    resource_state->meta.client_status =
+        XdsApi::ResourceMetadata::DOES_NOT_EXIST;
+    if (resource_state->resource == nullptr) continue;
+    resource_state->resource.reset();
+    xds_client()->NotifyWatchersOnResourceDoesNotExist(
+        resource_state->watchers);
+  }
+}
+
 //
 // XdsClient::ChannelState::LrsCallState::Reporter
 //
@@ -1813,6 +2074,10 @@ XdsClient::XdsClient(std::unique_ptr<XdsBootstrap> bootstrap,
   // Calling grpc_init to ensure gRPC does not shut down until the XdsClient is
   // destroyed.
   grpc_init();
+  if (!bootstrap_->resource_cache_file().empty()) {
+    MutexLock lock(&mu_);
+    LoadResourceCacheLocked();
+  }
 }
 
 XdsClient::~XdsClient() {
@@ -1839,6 +2104,7 @@ void XdsClient::Orphan() {
     shutting_down_ = true;
     // Clear cache and any remaining watchers that may not have been cancelled.
     authority_state_map_.clear();
+    resource_hash_index_.clear();
     invalid_watchers_.clear();
   }
 }
@@ -1905,6 +2171,13 @@ void XdsClient::WatchResource(const XdsResourceType* type,
     ResourceState& resource_state =
         authority_state.resource_map[type][resource_name->key];
     resource_state.watchers[w] = watcher;
+    if (resource_state.resource == nullptr && !resource_cache_.empty()) {
+      MaybeUseCachedResourceLocked(
+          type, *xds_server,
+          ConstructFullXdsResourceName(resource_name->authority,
+                                       type->type_url(), resource_name->key),
+          &resource_state);
+    }
     // If we already have a cached value for the resource, notify the new
     // watcher immediately.
     if (resource_state.resource != nullptr) {
@@ -1959,6 +2232,13 @@ void XdsClient::CancelResourceWatch(const XdsResourceType* type,
   if (resource_state.watchers.empty()) {
     authority_state.channel_state->UnsubscribeLocked(type, *resource_name,
                                                      delay_unsubscription);
+    if (!resource_state.meta.serialized_proto.empty()) {
+      auto index_it = resource_hash_index_.find(type);
+      if (index_it != resource_hash_index_.end()) {
+        index_it->second.erase(
+            HashSerializedResource(resource_state.meta.serialized_proto));
+      }
+    }
     type_map.erase(resource_it);
     if (type_map.empty()) {
       authority_state.resource_map.erase(type_it);
@@ -1990,6 +2270,169 @@ const XdsResourceType* XdsClient::GetResourceTypeLocked(
   return nullptr;
 }
 
+void XdsClient::LoadResourceCacheLocked() {
+  const std::string& path = bootstrap_->resource_cache_file();
+  grpc_slice contents;
+  grpc_error_handle error = grpc_load_file(path.c_str(), 0, &contents);
+  if (error != GRPC_ERROR_NONE) {
+    // The file does not exist until the first resources are received.
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
+      gpr_log(GPR_INFO, "[xds_client %p] not using resource cache file %s: %s",
+              this, path.c_str(), grpc_error_std_string(error).c_str());
+    }
+    GRPC_ERROR_UNREF(error);
+    return;
+  }
+  Json json = Json::Parse(StringViewFromSlice(contents), &error);
+  grpc_slice_unref_internal(contents);
+  if (error != GRPC_ERROR_NONE || json.type() != Json::Type::OBJECT) {
+    gpr_log(GPR_ERROR,
+            "[xds_client %p] ignoring malformed resource cache file %s: %s",
+            this, path.c_str(), grpc_error_std_string(error).c_str());
+    GRPC_ERROR_UNREF(error);
+    return;
+  }
+  auto it = json.object_value().find("resources");
+  if (it == json.object_value().end() ||
+      it->second.type() != Json::Type::ARRAY) {
+    return;
+  }
+  auto get_string = [](const Json::Object& object, const char* field) {
+    auto it = object.find(field);
+    if (it == object.end() || it->second.type() != Json::Type::STRING) {
+      return std::string();
+    }
+    return it->second.string_value();
+  };
+  for (const Json& entry : it->second.array_value()) {
+    if (entry.type() != Json::Type::OBJECT) continue;
+    const Json::Object& object = entry.object_value();
+    std::string name = get_string(object, "name");
+    std::string resource = get_string(object, "resource");
+    if (name.empty() || resource.empty()) continue;
+    grpc_slice decoded = grpc_base64_decode_with_len(resource.data(),
+                                                     resource.size(), false);
+    CachedResource& cached = resource_cache_[std::move(name)];
+    cached.type_url = get_string(object, "type_url");
+    cached.server_uri = get_string(object, "server_uri");
+    cached.version = get_string(object, "version");
+    cached.serialized_proto = std::string(StringViewFromSlice(decoded));
+    grpc_slice_unref_internal(decoded);
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
+    gpr_log(GPR_INFO,
+            "[xds_client %p] loaded %" PRIuPTR
+            " resources from resource cache file %s",
+            this, resource_cache_.size(), path.c_str());
+  }
+}
+
+void XdsClient::MaybeUseCachedResourceLocked(
+    const XdsResourceType* type, const XdsBootstrap::XdsServer& server,
+    const std::string& name, ResourceState* resource_state) {
+  auto it = resource_cache_.find(name);
+  if (it == resource_cache_.end()) return;
+  // Once watched, the resource is kept in resource_state, so the cached
+  // copy is used at most once.
+  CachedResource cached = std::move(it->second);
+  resource_cache_.erase(it);
+  // Resources from a different server may not be valid for this one.
+  bool is_v2 = false;
+  if (cached.server_uri != server.server_uri ||
+      !type->IsType(cached.type_url, &is_v2)) {
+    return;
+  }
+  upb::Arena arena;
+  const XdsEncodingContext context = {this,
+                                      server,
+                                      &grpc_xds_client_trace,
+                                      symtab_.ptr(),
+                                      arena.ptr(),
+                                      server.ShouldUseV3(),
+                                      &bootstrap_->certificate_providers()};
+  absl::StatusOr<XdsResourceType::DecodeResult> result =
+      type->Decode(context, cached.serialized_proto, is_v2);
+  if (!result.ok() || !result->resource.ok()) {
+    gpr_log(GPR_ERROR,
+            "[xds_client %p] ignoring invalid resource %s from resource cache "
+            "file",
+            this, name.c_str());
+    return;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
+    gpr_log(GPR_INFO,
+            "[xds_client %p] using resource %s version %s from resource cache "
+            "file",
+            this, name.c_str(), cached.version.c_str());
+  }
+  auto resource_name = ParseXdsResourceName(name, type);
+  if (resource_name.ok()) {
+    resource_hash_index_[type][HashSerializedResource(
+        cached.serialized_proto)] = std::move(*resource_name);
+  }
+  resource_state->resource = std::move(*result->resource);
+  resource_state->meta.serialized_proto = std::move(cached.serialized_proto);
+  resource_state->meta.version = std::move(cached.version);
+  resource_state->meta.update_time = ExecCtx::Get()->Now();
+  resource_state->meta.client_status = XdsApi::ResourceMetadata::ACKED;
+}
+
+void XdsClient::MaybeWriteResourceCache() {
+  MutexLock file_lock(&resource_cache_file_mu_);
+  Json::Array resources;
+  {
+    MutexLock lock(&mu_);
+    if (!resource_cache_dirty_) return;
+    resource_cache_dirty_ = false;
+    for (const auto& a : authority_state_map_) {  // authority
+      const std::string& authority = a.first;
+      if (a.second.channel_state == nullptr) continue;
+      const XdsBootstrap::XdsServer& server = a.second.channel_state->server();
+      for (const auto& t : a.second.resource_map) {  // type
+        const XdsResourceType* type = t.first;
+        for (const auto& r : t.second) {  // resource id
+          const ResourceState& resource_state = r.second;
+          if (resource_state.resource == nullptr ||
+              resource_state.meta.serialized_proto.empty()) {
+            continue;
+          }
+          const std::string& serialized = resource_state.meta.serialized_proto;
+          char* encoded = grpc_base64_encode(serialized.data(),
+                                             serialized.size(), false, false);
+          resources.emplace_back(Json::Object{
+              {"name", ConstructFullXdsResourceName(
+                           authority, type->type_url(), r.first)},
+              {"type_url", std::string(server.ShouldUseV3()
+                                           ? type->type_url()
+                                           : type->v2_type_url())},
+              {"server_uri", server.server_uri},
+              {"version", resource_state.meta.version},
+              {"resource", encoded},
+          });
+          gpr_free(encoded);
+        }
+      }
+    }
+  }
+  // Write to a temporary file and rename it, so that a crash while writing
+  // does not leave a truncated cache behind.
+  const std::string& path = bootstrap_->resource_cache_file();
+  const std::string tmp_path = absl::StrCat(path, ".tmp");
+  const std::string contents =
+      Json(Json::Object{{"resources", std::move(resources)}}).Dump();
+  FILE* file = fopen(tmp_path.c_str(), "wb");
+  bool ok = file != nullptr;
+  if (ok) {
+    ok = fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+    ok = fclose(file) == 0 && ok;
+    ok = ok && rename(tmp_path.c_str(), path.c_str()) == 0;
+  }
+  if (!ok) {
+    gpr_log(GPR_ERROR, "[xds_client %p] failed to write resource cache file %s",
+            this, path.c_str());
+  }
+}
+
 absl::StatusOr<XdsClient::XdsResourceName> XdsClient::ParseXdsResourceName(
     absl::string_view name, const XdsResourceType* type) {
   // Old-style names use the empty string for authority.
@@ -22,6 +22,7 @@
 #include <set>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
@@ -184,6 +185,7 @@ class XdsClient : public DualRefCounted<XdsClient> {
     void Orphan() override;
 
     grpc_channel* channel() const { return channel_; }
+    const XdsBootstrap::XdsServer& server() const { return server_; }
     XdsClient* xds_client() const { return xds_client_.get(); }
     AdsCallState* ads_calld() const;
     LrsCallState* lrs_calld() const;
@@ -242,6 +244,14 @@ class XdsClient : public DualRefCounted<XdsClient> {
         resource_map;
   };
 
+  // A resource loaded from the resource cache file.
+  struct CachedResource {
+    std::string type_url;
+    std::string server_uri;
+    std::string version;
+    std::string serialized_proto;
+  };
+
   struct LoadReportState {
     struct LocalityState {
       XdsClusterLocalityStats* locality_stats = nullptr;
@@ -286,6 +296,21 @@ class XdsClient : public DualRefCounted<XdsClient> {
   const XdsResourceType* GetResourceTypeLocked(absl::string_view resource_type)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Reads the resource cache file named in the bootstrap config, if any.
+  void LoadResourceCacheLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // If the resource cache holds the resource, populates resource_state
+  // with it, so that it can be used before the server sends it.
+  void MaybeUseCachedResourceLocked(const XdsResourceType* type,
+                                    const XdsBootstrap::XdsServer& server,
+                                    const std::string& name,
+                                    ResourceState* resource_state)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Rewrites the resource cache file if resources changed since the last
+  // write.
+  void MaybeWriteResourceCache() ABSL_LOCKS_EXCLUDED(mu_);
+
   static absl::StatusOr<XdsResourceName> ParseXdsResourceName(
       absl::string_view name, const XdsResourceType* type);
   static std::string ConstructFullXdsResourceName(
@@ -331,6 +356,22 @@ class XdsClient : public DualRefCounted<XdsClient> {
   std::map<ResourceWatcherInterface*, RefCountedPtr<ResourceWatcherInterface>>
       invalid_watchers_ ABSL_GUARDED_BY(mu_);
 
+  // Accepted resources by type and by a hash of their serialized proto,
+  // so that resources the server resends unchanged are recognized
+  // without being decoded again.  Entries may be stale: a hit counts only
+  // if the resource's serialized proto is still the same.
+  std::map<const XdsResourceType*,
+           absl::flat_hash_map<size_t /*hash*/, XdsResourceName>>
+      resource_hash_index_ ABSL_GUARDED_BY(mu_);
+
+  // Resources read from the resource cache file at startup that have not
+  // yet been watched, keyed by full resource name.
+  std::map<std::string, CachedResource> resource_cache_ ABSL_GUARDED_BY(mu_);
+  // Set when a resource changed since the resource cache file was written.
+  bool resource_cache_dirty_ ABSL_GUARDED_BY(mu_) = false;
+  // Serializes writes of the resource cache file.
+  Mutex resource_cache_file_mu_ ABSL_ACQUIRED_BEFORE(mu_);
+
   bool shutting_down_ ABSL_GUARDED_BY(mu_) = false;
 };
 
@@ -22,7 +22,10 @@
 
 #include <string.h>
 
+#include <algorithm>
+
 #include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/string_util.h>
 
 #include "src/core/ext/xds/xds_client.h"
@@ -105,7 +108,9 @@ XdsClusterLocalityStats::XdsClusterLocalityStats(
       lrs_server_(lrs_server),
       cluster_name_(cluster_name),
       eds_service_name_(eds_service_name),
-      name_(std::move(name)) {
+      name_(std::move(name)),
+      num_call_stats_(std::max(1u, gpr_cpu_num_cores())),
+      call_stats_(new CallStats[num_call_stats_]) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
     gpr_log(GPR_INFO,
             "[xds_client %p] created locality stats %p for {%s, %s, %s, %s}",
@@ -132,29 +137,42 @@ XdsClusterLocalityStats::~XdsClusterLocalityStats() {
 
 XdsClusterLocalityStats::Snapshot
 XdsClusterLocalityStats::GetSnapshotAndReset() {
-  Snapshot snapshot = {
-      GetAndResetCounter(&total_successful_requests_),
-      // Don't reset total_requests_in_progress because it's
-      // not related to a single reporting interval.
-      total_requests_in_progress_.load(std::memory_order_relaxed),
-      GetAndResetCounter(&total_error_requests_),
-      GetAndResetCounter(&total_issued_requests_),
-      {}};
+  Snapshot snapshot = {0, 0, 0, 0, {}};
+  for (size_t i = 0; i < num_call_stats_; ++i) {
+    CallStats& stats = call_stats_[i];
+    snapshot.total_successful_requests +=
+        GetAndResetCounter(&stats.total_successful_requests);
+    // Don't reset total_requests_in_progress because it's
+    // not related to a single reporting interval.
+    snapshot.total_requests_in_progress +=
+        stats.total_requests_in_progress.load(std::memory_order_relaxed);
+    snapshot.total_error_requests +=
+        GetAndResetCounter(&stats.total_error_requests);
+    snapshot.total_issued_requests +=
+        GetAndResetCounter(&stats.total_issued_requests);
+  }
   MutexLock lock(&backend_metrics_mu_);
   snapshot.backend_metrics = std::move(backend_metrics_);
   return snapshot;
 }
 
+XdsClusterLocalityStats::CallStats*
+XdsClusterLocalityStats::CurrentCallStats() {
+  return &call_stats_[gpr_cpu_current_cpu() % num_call_stats_];
+}
+
 void XdsClusterLocalityStats::AddCallStarted() {
-  total_issued_requests_.fetch_add(1, std::memory_order_relaxed);
-  total_requests_in_progress_.fetch_add(1, std::memory_order_relaxed);
+  CallStats* stats = CurrentCallStats();
+  stats->total_issued_requests.fetch_add(1, std::memory_order_relaxed);
+  stats->total_requests_in_progress.fetch_add(1, std::memory_order_relaxed);
 }
 
 void XdsClusterLocalityStats::AddCallFinished(bool fail) {
+  CallStats* stats = CurrentCallStats();
   std::atomic<uint64_t>& to_increment =
-      fail ? total_error_requests_ : total_successful_requests_;
+      fail ? stats->total_error_requests : stats->total_successful_requests;
   to_increment.fetch_add(1, std::memory_order_relaxed);
-  total_requests_in_progress_.fetch_add(-1, std::memory_order_acq_rel);
+  stats->total_requests_in_progress.fetch_add(-1, std::memory_order_acq_rel);
 }
 
 }  // namespace grpc_core
@@ -23,6 +23,7 @@
 
 #include <atomic>
 #include <map>
+#include <memory>
 #include <string>
 
 #include "absl/strings/str_cat.h"
@@ -222,10 +223,23 @@ class XdsClusterLocalityStats : public RefCounted<XdsClusterLocalityStats> {
   absl::string_view eds_service_name_;
   RefCountedPtr<XdsLocalityName> name_;
 
-  std::atomic<uint64_t> total_successful_requests_{0};
-  std::atomic<uint64_t> total_requests_in_progress_{0};
-  std::atomic<uint64_t> total_error_requests_{0};
-  std::atomic<uint64_t> total_issued_requests_{0};
+  // The call counts are kept in per-CPU slots, so that calls on different
+  // CPUs don't contend on the same cache line.  They are summed when the
+  // load report is built.
+  struct CallStats {
+    std::atomic<uint64_t> total_successful_requests{0};
+    // A call may finish on a different CPU than it started on, so this
+    // wraps around in some slots; the sum over all slots is still right.
+    std::atomic<uint64_t> total_requests_in_progress{0};
+    std::atomic<uint64_t> total_error_requests{0};
+    std::atomic<uint64_t> total_issued_requests{0};
+    char padding[GPR_CACHELINE_SIZE - 4 * sizeof(std::atomic<uint64_t>)];
+  };
+
+  CallStats* CurrentCallStats();
+
+  const size_t num_call_stats_;
+  std::unique_ptr<CallStats[]> call_stats_;
 
   // Protects backend_metrics_. A mutex is necessary because the length of
   // backend_metrics_ can be accessed by both the callback intercepting the
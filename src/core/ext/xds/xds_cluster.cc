@@ -25,6 +25,7 @@
 #include "envoy/config/cluster/v3/circuit_breaker.upb.h"
 #include "envoy/config/cluster/v3/cluster.upb.h"
 #include "envoy/config/cluster/v3/cluster.upbdefs.h"
+#include "envoy/config/cluster/v3/outlier_detection.upb.h"
 #include "envoy/config/core/v3/address.upb.h"
 #include "envoy/config/core/v3/base.upb.h"
 #include "envoy/config/core/v3/config_source.upb.h"
@@ -32,6 +33,7 @@
 #include "envoy/config/endpoint/v3/endpoint_components.upb.h"
 #include "envoy/extensions/clusters/aggregate/v3/cluster.upb.h"
 #include "google/protobuf/any.upb.h"
+#include "google/protobuf/duration.upb.h"
 #include "google/protobuf/wrappers.upb.h"
 
 #include <grpc/support/alloc.h>
@@ -78,9 +80,15 @@ std::string XdsClusterResource::ToString() const {
   if (lb_policy == "RING_HASH") {
     contents.push_back(absl::StrCat("min_ring_size=", min_ring_size));
     contents.push_back(absl::StrCat("max_ring_size=", max_ring_size));
+  } else if (lb_policy == "LEAST_REQUEST") {
+    contents.push_back(absl::StrCat("choice_count=", choice_count));
   }
   contents.push_back(
       absl::StrFormat("max_concurrent_requests=%d", max_concurrent_requests));
+  if (outlier_detection.has_value()) {
+    contents.push_back(absl::StrCat("outlier_detection=",
+                                    Json(outlier_detection->ToJson()).Dump()));
+  }
   return absl::StrCat("{", absl::StrJoin(contents, ", "), "}");
 }
 
@@ -216,6 +224,130 @@ bool XdsAggregateAndLogicalDnsClusterEnabled() {
   return parse_succeeded && parsed_value;
 }
 
+// The LEAST_REQUEST LB policy is accepted only when enabled, until it is
+// fully integration-tested.
+bool XdsLeastRequestLbEnabled() {
+  char* value = gpr_getenv("GRPC_XDS_EXPERIMENTAL_ENABLE_LEAST_REQUEST_LB");
+  bool parsed_value;
+  bool parse_succeeded = gpr_parse_bool_value(value, &parsed_value);
+  gpr_free(value);
+  return parse_succeeded && parsed_value;
+}
+
+// Outlier detection is parsed only when enabled, until it is fully
+// integration-tested.
+bool XdsOutlierDetectionEnabled() {
+  char* value = gpr_getenv("GRPC_XDS_EXPERIMENTAL_ENABLE_OUTLIER_DETECTION");
+  bool parsed_value;
+  bool parse_succeeded = gpr_parse_bool_value(value, &parsed_value);
+  gpr_free(value);
+  return parse_succeeded && parsed_value;
+}
+
+// Maps the xDS OutlierDetection message to the outlier_detection LB policy
+// config. Success rate ejection is on unless enforcing_success_rate is 0,
+// failure percentage ejection is on only if enforcing_failure_percentage
+// is positive, and consecutive failure ejection only if consecutive_5xx is
+// set, all as in Envoy.
+void OutlierDetectionParse(
+    const envoy_config_cluster_v3_OutlierDetection* outlier_detection,
+    OutlierDetectionConfig* config, std::vector<grpc_error_handle>* errors) {
+  const google_protobuf_Duration* duration =
+      envoy_config_cluster_v3_OutlierDetection_interval(outlier_detection);
+  if (duration != nullptr) config->interval = ParseDuration(duration);
+  duration = envoy_config_cluster_v3_OutlierDetection_base_ejection_time(
+      outlier_detection);
+  if (duration != nullptr) {
+    config->base_ejection_time = ParseDuration(duration);
+  }
+  duration = envoy_config_cluster_v3_OutlierDetection_max_ejection_time(
+      outlier_detection);
+  if (duration != nullptr) {
+    config->max_ejection_time = ParseDuration(duration);
+  }
+  if (config->interval <= Duration::Zero()) {
+    errors->push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "outlier_detection interval must be positive."));
+  }
+  auto percentage = [&](const google_protobuf_UInt32Value* value,
+                        uint32_t* output, const char* field) {
+    if (value == nullptr) return;
+    *output = google_protobuf_UInt32Value_value(value);
+    if (*output > 100) {
+      errors->push_back(GRPC_ERROR_CREATE_FROM_CPP_STRING(
+          absl::StrCat("outlier_detection ", field, " must be <= 100.")));
+    }
+  };
+  auto uint32_value = [](const google_protobuf_UInt32Value* value,
+                   uint32_t* output) {
+    if (value != nullptr) *output = google_protobuf_UInt32Value_value(value);
+  };
+  percentage(
+      envoy_config_cluster_v3_OutlierDetection_max_ejection_percent(
+          outlier_detection),
+      &config->max_ejection_percent, "max_ejection_percent");
+  OutlierDetectionConfig::SuccessRateEjection success_rate_ejection;
+  percentage(envoy_config_cluster_v3_OutlierDetection_enforcing_success_rate(
+                 outlier_detection),
+             &success_rate_ejection.enforcement_percentage,
+             "enforcing_success_rate");
+  uint32_value(
+      envoy_config_cluster_v3_OutlierDetection_success_rate_stdev_factor(
+          outlier_detection),
+      &success_rate_ejection.stdev_factor);
+  uint32_value(
+      envoy_config_cluster_v3_OutlierDetection_success_rate_minimum_hosts(
+          outlier_detection),
+      &success_rate_ejection.minimum_hosts);
+  uint32_value(
+      envoy_config_cluster_v3_OutlierDetection_success_rate_request_volume(
+          outlier_detection),
+      &success_rate_ejection.request_volume);
+  if (success_rate_ejection.enforcement_percentage > 0) {
+    config->success_rate_ejection = success_rate_ejection;
+  }
+  OutlierDetectionConfig::FailurePercentageEjection failure_percentage_ejection;
+  failure_percentage_ejection.enforcement_percentage = 0;
+  percentage(
+      envoy_config_cluster_v3_OutlierDetection_enforcing_failure_percentage(
+          outlier_detection),
+      &failure_percentage_ejection.enforcement_percentage,
+      "enforcing_failure_percentage");
+  percentage(
+      envoy_config_cluster_v3_OutlierDetection_failure_percentage_threshold(
+          outlier_detection),
+      &failure_percentage_ejection.threshold, "failure_percentage_threshold");
+  uint32_value(
+      envoy_config_cluster_v3_OutlierDetection_failure_percentage_minimum_hosts(
+          outlier_detection),
+      &failure_percentage_ejection.minimum_hosts);
+  uint32_value(
+      envoy_config_cluster_v3_OutlierDetection_failure_percentage_request_volume(
+          outlier_detection),
+      &failure_percentage_ejection.request_volume);
+  if (failure_percentage_ejection.enforcement_percentage > 0) {
+    config->failure_percentage_ejection = failure_percentage_ejection;
+  }
+  const google_protobuf_UInt32Value* consecutive_5xx =
+      envoy_config_cluster_v3_OutlierDetection_consecutive_5xx(
+          outlier_detection);
+  if (consecutive_5xx != nullptr) {
+    OutlierDetectionConfig::ConsecutiveFailureEjection
+        consecutive_failure_ejection;
+    consecutive_failure_ejection.threshold =
+        google_protobuf_UInt32Value_value(consecutive_5xx);
+    percentage(
+        envoy_config_cluster_v3_OutlierDetection_enforcing_consecutive_5xx(
+            outlier_detection),
+        &consecutive_failure_ejection.enforcement_percentage,
+        "enforcing_consecutive_5xx");
+    if (consecutive_failure_ejection.threshold > 0 &&
+        consecutive_failure_ejection.enforcement_percentage > 0) {
+      config->consecutive_failure_ejection = consecutive_failure_ejection;
+    }
+  }
+}
+
 grpc_error_handle CdsResourceParse(
     const XdsEncodingContext& context,
     const envoy_config_cluster_v3_Cluster* cluster, bool /*is_v2*/,
@@ -346,6 +478,26 @@ grpc_error_handle CdsResourceParse(
             "ring hash lb config has invalid hash function."));
       }
     }
+  } else if (envoy_config_cluster_v3_Cluster_lb_policy(cluster) ==
+                 envoy_config_cluster_v3_Cluster_LEAST_REQUEST &&
+             XdsLeastRequestLbEnabled()) {
+    cds_update->lb_policy = "LEAST_REQUEST";
+    const envoy_config_cluster_v3_Cluster_LeastRequestLbConfig*
+        least_request_config =
+            envoy_config_cluster_v3_Cluster_least_request_lb_config(cluster);
+    if (least_request_config != nullptr) {
+      const google_protobuf_UInt32Value* choice_count =
+          envoy_config_cluster_v3_Cluster_LeastRequestLbConfig_choice_count(
+              least_request_config);
+      if (choice_count != nullptr) {
+        cds_update->choice_count =
+            google_protobuf_UInt32Value_value(choice_count);
+        if (cds_update->choice_count < 2) {
+          errors.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "choice_count must be at least 2."));
+        }
+      }
+    }
   } else {
     errors.push_back(
         GRPC_ERROR_CREATE_FROM_STATIC_STRING("LB policy is not supported."));
@@ -398,6 +550,13 @@ grpc_error_handle CdsResourceParse(
       }
     }
   }
+  // Outlier detection.
+  if (envoy_config_cluster_v3_Cluster_has_outlier_detection(cluster) &&
+      XdsOutlierDetectionEnabled()) {
+    OutlierDetectionParse(
+        envoy_config_cluster_v3_Cluster_outlier_detection(cluster),
+        &cds_update->outlier_detection.emplace(), &errors);
+  }
   return GRPC_ERROR_CREATE_FROM_VECTOR("errors parsing CDS resource", &errors);
 }
 
@@ -27,6 +27,7 @@
 #include "envoy/extensions/clusters/aggregate/v3/cluster.upbdefs.h"
 #include "envoy/extensions/transport_sockets/tls/v3/tls.upbdefs.h"
 
+#include "src/core/ext/filters/client_channel/lb_policy/outlier_detection/outlier_detection.h"
 #include "src/core/ext/xds/xds_client.h"
 #include "src/core/ext/xds/xds_common_types.h"
 #include "src/core/ext/xds/xds_resource_type_impl.h"
@@ -54,14 +55,19 @@ struct XdsClusterResource {
   // If not set, load reporting will be disabled.
   absl::optional<XdsBootstrap::XdsServer> lrs_load_reporting_server;
 
-  // The LB policy to use (e.g., "ROUND_ROBIN" or "RING_HASH").
+  // The LB policy to use (e.g., "ROUND_ROBIN", "RING_HASH" or
+  // "LEAST_REQUEST").
   std::string lb_policy;
   // Used for RING_HASH LB policy only.
   uint64_t min_ring_size = 1024;
   uint64_t max_ring_size = 8388608;
+  // Used for LEAST_REQUEST LB policy only.
+  uint32_t choice_count = 2;
   // Maximum number of outstanding requests can be made to the upstream
   // cluster.
   uint32_t max_concurrent_requests = 1024;
+  // Outlier detection config. If not set, no endpoint is ejected.
+  absl::optional<OutlierDetectionConfig> outlier_detection;
 
   bool operator==(const XdsClusterResource& other) const {
     return cluster_type == other.cluster_type &&
@@ -73,7 +79,9 @@ struct XdsClusterResource {
            lb_policy == other.lb_policy &&
            min_ring_size == other.min_ring_size &&
            max_ring_size == other.max_ring_size &&
-           max_concurrent_requests == other.max_concurrent_requests;
+           choice_count == other.choice_count &&
+           max_concurrent_requests == other.max_concurrent_requests &&
+           outlier_detection == other.outlier_detection;
   }
 
   std::string ToString() const;
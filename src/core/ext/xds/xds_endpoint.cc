@@ -36,6 +36,7 @@
 #include "src/core/ext/xds/upb_utils.h"
 #include "src/core/lib/address_utils/parse_address.h"
 #include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/gprpp/fast_random.h"
 
 namespace grpc_core {
 
@@ -79,7 +80,7 @@ bool XdsEndpointResource::DropConfig::ShouldDrop(
   for (size_t i = 0; i < drop_category_list_.size(); ++i) {
     const auto& drop_category = drop_category_list_[i];
     // Generate a random number in [0, 1000000).
-    const uint32_t random = static_cast<uint32_t>(rand()) % 1000000;
+    const uint32_t random = FastRandomUniform(1000000);
     if (random < drop_category.parts_per_million) {
       *category_name = &drop_category.name;
       return true;
@@ -20,8 +20,14 @@
 
 #include "src/core/ext/xds/xds_routing.h"
 
+#include <algorithm>
 #include <cctype>
 
+#include "absl/memory/memory.h"
+#include "absl/strings/ascii.h"
+
+#include "src/core/lib/gprpp/fast_random.h"
+
 namespace grpc_core {
 
 namespace {
@@ -121,6 +127,63 @@ absl::optional<size_t> XdsRouting::FindVirtualHostForDomain(
   return target_index;
 }
 
+XdsRouting::VirtualHostIndex::VirtualHostIndex(
+    const VirtualHostListIterator& vhost_iterator) {
+  for (size_t i = 0; i < vhost_iterator.Size(); ++i) {
+    for (const std::string& domain_pattern :
+         vhost_iterator.GetDomainsForVirtualHost(i)) {
+      const MatchType match_type = DomainPatternMatchType(domain_pattern);
+      // This should be caught by RouteConfigParse().
+      GPR_ASSERT(match_type != INVALID_MATCH);
+      std::string pattern = absl::AsciiStrToLower(domain_pattern);
+      // emplace() keeps the first virtual host with a given pattern.
+      switch (match_type) {
+        case EXACT_MATCH:
+          exact_.emplace(std::move(pattern), i);
+          break;
+        case SUFFIX_MATCH:
+          pattern.erase(0, 1);
+          suffix_lengths_.push_back(pattern.size());
+          suffix_.emplace(std::move(pattern), i);
+          break;
+        case PREFIX_MATCH:
+          pattern.pop_back();
+          prefix_lengths_.push_back(pattern.size());
+          prefix_.emplace(std::move(pattern), i);
+          break;
+        default:
+          if (!universe_.has_value()) universe_ = i;
+      }
+    }
+  }
+  for (std::vector<size_t>* lengths : {&suffix_lengths_, &prefix_lengths_}) {
+    std::sort(lengths->begin(), lengths->end(), std::greater<size_t>());
+    lengths->erase(std::unique(lengths->begin(), lengths->end()),
+                   lengths->end());
+  }
+}
+
+absl::optional<size_t> XdsRouting::VirtualHostIndex::FindVirtualHostForDomain(
+    absl::string_view domain) const {
+  // Same search order as XdsRouting::FindVirtualHostForDomain(). Trying
+  // the longest patterns first makes the first hit the longest match.
+  const std::string host = absl::AsciiStrToLower(domain);
+  auto it = exact_.find(host);
+  if (it != exact_.end()) return it->second;
+  // Asterisks must match at least one char.
+  for (size_t length : suffix_lengths_) {
+    if (length >= host.size()) continue;
+    it = suffix_.find(absl::string_view(host).substr(host.size() - length));
+    if (it != suffix_.end()) return it->second;
+  }
+  for (size_t length : prefix_lengths_) {
+    if (length >= host.size()) continue;
+    it = prefix_.find(absl::string_view(host).substr(0, length));
+    if (it != prefix_.end()) return it->second;
+  }
+  return universe_;
+}
+
 namespace {
 
 bool HeadersMatch(const std::vector<HeaderMatcher>& header_matchers,
@@ -137,7 +200,7 @@ bool HeadersMatch(const std::vector<HeaderMatcher>& header_matchers,
 
 bool UnderFraction(const uint32_t fraction_per_million) {
   // Generate a random number in [0, 1000000).
-  const uint32_t random_number = rand() % 1000000;
+  const uint32_t random_number = FastRandomUniform(1000000);
   return random_number < fraction_per_million;
 }
 
@@ -159,6 +222,142 @@ absl::optional<size_t> XdsRouting::GetRouteForRequest(
   return absl::nullopt;
 }
 
+void XdsRouting::RouteIndex::PathTable::AddExact(absl::string_view path,
+                                                 size_t route) {
+  exact[std::string(path)].push_back(route);
+}
+
+void XdsRouting::RouteIndex::PathTable::AddPrefix(absl::string_view prefix,
+                                                  size_t route) {
+  uint32_t node = 0;
+  for (char c : prefix) {
+    auto& children = trie[node].children;
+    auto it = std::lower_bound(
+        children.begin(), children.end(), c,
+        [](const std::pair<char, uint32_t>& child, char c) {
+          return child.first < c;
+        });
+    if (it != children.end() && it->first == c) {
+      node = it->second;
+      continue;
+    }
+    const uint32_t child = static_cast<uint32_t>(trie.size());
+    children.emplace(it, c, child);
+    // Invalidates children.
+    trie.emplace_back();
+    node = child;
+  }
+  trie[node].routes.push_back(route);
+}
+
+void XdsRouting::RouteIndex::PathTable::Find(absl::string_view path,
+                                             RouteList* routes) const {
+  auto it = exact.find(path);
+  if (it != exact.end()) {
+    routes->insert(routes->end(), it->second.begin(), it->second.end());
+  }
+  uint32_t node = 0;
+  for (size_t i = 0;; ++i) {
+    routes->insert(routes->end(), trie[node].routes.begin(),
+                   trie[node].routes.end());
+    if (i == path.size()) break;
+    const auto& children = trie[node].children;
+    auto child = std::lower_bound(
+        children.begin(), children.end(), path[i],
+        [](const std::pair<char, uint32_t>& child, char c) {
+          return child.first < c;
+        });
+    if (child == children.end() || child->first != path[i]) break;
+    node = child->second;
+  }
+}
+
+XdsRouting::RouteIndex::RouteIndex(
+    const RouteListIterator& route_list_iterator) {
+  for (size_t i = 0; i < route_list_iterator.Size(); ++i) {
+    const StringMatcher& path_matcher =
+        route_list_iterator.GetMatchersForRoute(i).path_matcher;
+    switch (path_matcher.type()) {
+      case StringMatcher::Type::kExact:
+      case StringMatcher::Type::kPrefix: {
+        PathTable* table = &case_sensitive_;
+        std::string value = path_matcher.string_matcher();
+        if (!path_matcher.case_sensitive()) {
+          table = &case_insensitive_;
+          has_case_insensitive_ = true;
+          absl::AsciiStrToLower(&value);
+        }
+        if (path_matcher.type() == StringMatcher::Type::kExact) {
+          table->AddExact(value, i);
+        } else {
+          table->AddPrefix(value, i);
+        }
+        break;
+      }
+      case StringMatcher::Type::kSafeRegex:
+        // Matchers use RE2's default options and full matches.
+        if (regex_set_ == nullptr) {
+          regex_set_ = absl::make_unique<RE2::Set>(RE2::DefaultOptions,
+                                                   RE2::ANCHOR_BOTH);
+        }
+        if (regex_set_->Add(path_matcher.regex_matcher()->pattern(),
+                            nullptr) >= 0) {
+          regex_routes_.push_back(i);
+        } else {
+          other_routes_.push_back(i);
+        }
+        break;
+      default:
+        other_routes_.push_back(i);
+    }
+  }
+  if (regex_set_ != nullptr && !regex_set_->Compile()) {
+    // The set is too large for RE2's memory budget, so fall back to
+    // matching the regexes one by one.
+    other_routes_.insert(other_routes_.end(), regex_routes_.begin(),
+                         regex_routes_.end());
+    std::sort(other_routes_.begin(), other_routes_.end());
+    regex_routes_.clear();
+    regex_set_.reset();
+  }
+}
+
+absl::optional<size_t> XdsRouting::RouteIndex::GetRouteForRequest(
+    const RouteListIterator& route_list_iterator, absl::string_view path,
+    grpc_metadata_batch* initial_metadata) const {
+  // Collect the routes whose path matcher matches, then take the first
+  // one whose other matchers match too.
+  RouteList routes;
+  case_sensitive_.Find(path, &routes);
+  if (has_case_insensitive_) {
+    case_insensitive_.Find(absl::AsciiStrToLower(path), &routes);
+  }
+  if (regex_set_ != nullptr) {
+    std::vector<int> matches;
+    if (regex_set_->Match(re2::StringPiece(path.data(), path.size()),
+                          &matches)) {
+      for (int match : matches) routes.push_back(regex_routes_[match]);
+    }
+  }
+  for (size_t route : other_routes_) {
+    if (route_list_iterator.GetMatchersForRoute(route).path_matcher.Match(
+            path)) {
+      routes.push_back(route);
+    }
+  }
+  std::sort(routes.begin(), routes.end());
+  for (size_t route : routes) {
+    const XdsRouteConfigResource::Route::Matchers& matchers =
+        route_list_iterator.GetMatchersForRoute(route);
+    if (HeadersMatch(matchers.header_matchers, initial_metadata) &&
+        (!matchers.fraction_per_million.has_value() ||
+         UnderFraction(*matchers.fraction_per_million))) {
+      return route;
+    }
+  }
+  return absl::nullopt;
+}
+
 bool XdsRouting::IsValidDomainPattern(absl::string_view domain_pattern) {
   return DomainPatternMatchType(domain_pattern) != INVALID_MATCH;
 }
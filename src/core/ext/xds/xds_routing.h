@@ -21,9 +21,18 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "re2/set.h"
 
 #include <grpc/support/log.h>
 
@@ -66,6 +75,74 @@ class XdsRouting {
       const RouteListIterator& route_list_iterator, absl::string_view path,
       grpc_metadata_batch* initial_metadata);
 
+  // Domain patterns of a virtual host list, hashed when the route config
+  // arrives so that a lookup does not try every pattern.
+  class VirtualHostIndex {
+   public:
+    explicit VirtualHostIndex(const VirtualHostListIterator& vhost_iterator);
+
+    // Same result as XdsRouting::FindVirtualHostForDomain() on the list
+    // the index was built from.
+    absl::optional<size_t> FindVirtualHostForDomain(
+        absl::string_view domain) const;
+
+   private:
+    // Lower-case patterns without the asterisk, mapped to the first
+    // virtual host that has them.
+    absl::flat_hash_map<std::string, size_t> exact_;
+    absl::flat_hash_map<std::string, size_t> suffix_;
+    absl::flat_hash_map<std::string, size_t> prefix_;
+    // Distinct lengths of the keys of suffix_ and prefix_, longest first.
+    std::vector<size_t> suffix_lengths_;
+    std::vector<size_t> prefix_lengths_;
+    absl::optional<size_t> universe_;
+  };
+
+  // Path matchers of a route list, compiled when the route config arrives:
+  // exact paths are hashed, prefixes go in a trie and regexes in an
+  // RE2::Set, so that only the routes whose path matches have their
+  // header matchers evaluated. Suffix and contains matchers are still
+  // evaluated one by one.
+  class RouteIndex {
+   public:
+    explicit RouteIndex(const RouteListIterator& route_list_iterator);
+
+    // Same result as XdsRouting::GetRouteForRequest() on the list the
+    // index was built from, which must be passed in again.
+    absl::optional<size_t> GetRouteForRequest(
+        const RouteListIterator& route_list_iterator, absl::string_view path,
+        grpc_metadata_batch* initial_metadata) const;
+
+   private:
+    using RouteList = absl::InlinedVector<size_t, 8>;
+
+    // Exact and prefix matchers of one case sensitivity.
+    struct PathTable {
+      struct TrieNode {
+        // Sorted by character.
+        std::vector<std::pair<char, uint32_t>> children;
+        std::vector<size_t> routes;
+      };
+
+      void AddExact(absl::string_view path, size_t route);
+      void AddPrefix(absl::string_view prefix, size_t route);
+      // Appends the routes whose matcher matches path.
+      void Find(absl::string_view path, RouteList* routes) const;
+
+      absl::flat_hash_map<std::string, std::vector<size_t>> exact;
+      std::vector<TrieNode> trie{1};
+    };
+
+    PathTable case_sensitive_;
+    PathTable case_insensitive_;
+    bool has_case_insensitive_ = false;
+    std::unique_ptr<RE2::Set> regex_set_;
+    // Route of each pattern of regex_set_.
+    std::vector<size_t> regex_routes_;
+    // Routes whose path matcher is evaluated on every request.
+    std::vector<size_t> other_routes_;
+  };
+
   // Returns true if \a domain_pattern is a valid domain pattern, false
   // otherwise.
   static bool IsValidDomainPattern(absl::string_view domain_pattern);
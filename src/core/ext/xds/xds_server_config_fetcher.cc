@@ -268,6 +268,8 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
       bool unsupported_action;
       XdsRouteConfigResource::Route::Matchers matchers;
       RefCountedPtr<ServiceConfig> method_config;
+      // Looked up in method_config once.
+      const ServiceConfigParser::ParsedConfigVector* method_configs = nullptr;
     };
 
     class RouteListIterator : public XdsRouting::RouteListIterator {
@@ -288,6 +290,8 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
 
     std::vector<std::string> domains;
     std::vector<Route> routes;
+    // Compiled from routes once they are complete.
+    absl::optional<XdsRouting::RouteIndex> route_index;
   };
 
   class VirtualHostListIterator : public XdsRouting::VirtualHostListIterator {
@@ -308,6 +312,7 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
   };
 
   std::vector<VirtualHost> virtual_hosts_;
+  absl::optional<XdsRouting::VirtualHostIndex> virtual_host_index_;
 };
 
 // An XdsServerConfigSelectorProvider implementation for when the
@@ -1121,10 +1126,17 @@ XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
         config_selector_route.method_config =
             ServiceConfigImpl::Create(result.args, json.c_str(), &error);
         GPR_ASSERT(error == GRPC_ERROR_NONE);
+        config_selector_route.method_configs =
+            config_selector_route.method_config->GetMethodParsedConfigVector(
+                grpc_empty_slice());
       }
       grpc_channel_args_destroy(result.args);
     }
+    virtual_host.route_index.emplace(
+        VirtualHost::RouteListIterator(&virtual_host.routes));
   }
+  config_selector->virtual_host_index_.emplace(
+      VirtualHostListIterator(&config_selector->virtual_hosts_));
   return config_selector;
 }
 
@@ -1145,8 +1157,7 @@ ServerConfigSelector::CallConfig XdsServerConfigFetcher::ListenerWatcher::
   }
   absl::string_view authority =
       metadata->get_pointer(HttpAuthorityMetadata())->as_string_view();
-  auto vhost_index = XdsRouting::FindVirtualHostForDomain(
-      VirtualHostListIterator(&virtual_hosts_), authority);
+  auto vhost_index = virtual_host_index_->FindVirtualHostForDomain(authority);
   if (!vhost_index.has_value()) {
     call_config.error =
         grpc_error_set_int(GRPC_ERROR_CREATE_FROM_CPP_STRING(absl::StrCat(
@@ -1156,7 +1167,7 @@ ServerConfigSelector::CallConfig XdsServerConfigFetcher::ListenerWatcher::
     return call_config;
   }
   auto& virtual_host = virtual_hosts_[vhost_index.value()];
-  auto route_index = XdsRouting::GetRouteForRequest(
+  auto route_index = virtual_host.route_index->GetRouteForRequest(
       VirtualHost::RouteListIterator(&virtual_host.routes), path, metadata);
   if (route_index.has_value()) {
     auto& route = virtual_host.routes[route_index.value()];
@@ -1169,8 +1180,7 @@ ServerConfigSelector::CallConfig XdsServerConfigFetcher::ListenerWatcher::
       return call_config;
     }
     if (route.method_config != nullptr) {
-      call_config.method_configs =
-          route.method_config->GetMethodParsedConfigVector(grpc_empty_slice());
+      call_config.method_configs = route.method_configs;
       call_config.service_config = route.method_config;
     }
     return call_config;
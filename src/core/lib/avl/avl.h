@@ -59,6 +59,7 @@ class AVL {
   bool SameIdentity(const AVL& avl) const { return root_ == avl.root_; }
 
   bool operator==(const AVL& other) const {
+    if (SameIdentity(other)) return true;
     Iterator a(root_);
     Iterator b(other.root_);
     for (;;) {
@@ -73,6 +74,7 @@ class AVL {
   }
 
   bool operator<(const AVL& other) const {
+    if (SameIdentity(other)) return false;
     Iterator a(root_);
     Iterator b(other.root_);
     for (;;) {
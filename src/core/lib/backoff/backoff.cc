@@ -22,7 +22,10 @@
 
 #include <algorithm>
 
+#include "absl/random/random.h"
+
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/fast_random.h"
 
 namespace grpc_core {
 
@@ -35,8 +38,9 @@ Timestamp BackOff::NextAttemptTime() {
   }
   current_backoff_ = std::min(current_backoff_ * options_.multiplier(),
                               options_.max_backoff());
+  FastRandomBitGen rand_gen;
   const Duration jitter = Duration::FromSecondsAsDouble(
-      absl::Uniform(rand_gen_, -options_.jitter() * current_backoff_.seconds(),
+      absl::Uniform(rand_gen, -options_.jitter() * current_backoff_.seconds(),
                     options_.jitter() * current_backoff_.seconds()));
   return ExecCtx::Get()->Now() + current_backoff_ + jitter;
 }
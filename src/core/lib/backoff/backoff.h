@@ -21,8 +21,6 @@
 
 #include <grpc/support/port_platform.h>
 
-#include "absl/random/random.h"
-
 #include "src/core/lib/iomgr/exec_ctx.h"
 
 namespace grpc_core {
@@ -79,7 +77,6 @@ class BackOff {
 
  private:
   const Options options_;
-  absl::BitGen rand_gen_;
   bool initial_;
   /// current delay before retries
   Duration current_backoff_;
@@ -24,6 +24,7 @@
 #include <stdint.h>
 
 #include "absl/status/status.h"
+#include "absl/time/time.h"
 
 #include <grpc/impl/codegen/gpr_types.h>
 #include <grpc/support/atm.h>
@@ -72,6 +73,17 @@ class CallTracer {
         absl::Status status, grpc_metadata_batch* recv_trailing_metadata,
         const grpc_transport_stream_stats* transport_stream_stats) = 0;
     virtual void RecordCancel(grpc_error_handle cancel_error) = 0;
+    // Latencies that the kernel reported for a write carrying part of this
+    // attempt, when TX timestamps are enabled on the channel (see
+    // GRPC_ARG_TCP_TX_TIMESTAMPS_ENABLED). \a byte_offset is the offset of the
+    // last byte of the attempt in that write. \a sent_latency is the time from
+    // the sendmsg call until the data left the host, and \a acked_latency the
+    // time from then until the peer acked it; either is
+    // absl::InfiniteDuration() if the kernel did not report it. May be invoked
+    // from any thread, several times per attempt, and never after RecordEnd().
+    virtual void RecordTxLatency(uint32_t /*byte_offset*/,
+                                 absl::Duration /*sent_latency*/,
+                                 absl::Duration /*acked_latency*/) {}
     // Should be the last API call to the object. Once invoked, the tracer
     // library is free to destroy the object.
     virtual void RecordEnd(const gpr_timespec& latency) = 0;
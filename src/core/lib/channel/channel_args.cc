@@ -28,6 +28,7 @@
 #include <map>
 #include <vector>
 
+#include "absl/hash/hash.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
@@ -66,34 +67,61 @@ bool ChannelArgs::Pointer::operator<(const Pointer& rhs) const {
 
 ChannelArgs::ChannelArgs() = default;
 
-ChannelArgs ChannelArgs::Set(grpc_arg arg) const {
+namespace {
+
+ChannelArgs::Value ValueFromC(const grpc_arg& arg) {
   switch (arg.type) {
     case GRPC_ARG_INTEGER:
-      return Set(arg.key, arg.value.integer);
+      return arg.value.integer;
     case GRPC_ARG_STRING:
-      if (arg.value.string != nullptr) return Set(arg.key, arg.value.string);
-      return Set(arg.key, "");
+      if (arg.value.string != nullptr) return std::string(arg.value.string);
+      return std::string();
     case GRPC_ARG_POINTER:
-      return Set(arg.key,
-                 Pointer(arg.value.pointer.vtable->copy(arg.value.pointer.p),
-                         arg.value.pointer.vtable));
+      return ChannelArgs::Pointer(
+          arg.value.pointer.vtable->copy(arg.value.pointer.p),
+          arg.value.pointer.vtable);
   }
-  GPR_UNREACHABLE_CODE(return ChannelArgs());
+  GPR_UNREACHABLE_CODE(return 0);
+}
+
+}  // namespace
+
+ChannelArgs ChannelArgs::Set(grpc_arg arg) const {
+  return Set(arg.key, ValueFromC(arg));
 }
 
 ChannelArgs ChannelArgs::FromC(const grpc_channel_args* args) {
-  ChannelArgs result;
-  if (args != nullptr) {
-    for (size_t i = 0; i < args->num_args; i++) {
-      result = result.Set(args->args[i]);
+  if (args == nullptr || args->num_args == 0) return ChannelArgs();
+  // Sort once rather than inserting one arg at a time.
+  std::vector<const grpc_arg*> sorted;
+  sorted.reserve(args->num_args);
+  for (size_t i = 0; i < args->num_args; i++) {
+    sorted.push_back(&args->args[i]);
+  }
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const grpc_arg* a, const grpc_arg* b) {
+                     return absl::string_view(a->key) <
+                            absl::string_view(b->key);
+                   });
+  auto entries = MakeRefCounted<Entries>();
+  entries->entries.reserve(sorted.size());
+  size_t hash = 0;
+  for (size_t i = 0; i < sorted.size(); i++) {
+    const char* key = sorted[i]->key;
+    // As with Set, the last arg with a given key wins.
+    if (i + 1 < sorted.size() && strcmp(key, sorted[i + 1]->key) == 0) {
+      continue;
     }
+    Value value = ValueFromC(*sorted[i]);
+    hash += EntryHash(key, value);
+    entries->entries.push_back(MakeRefCounted<Entry>(key, std::move(value)));
   }
-  return result;
+  return ChannelArgs(std::move(entries), hash);
 }
 
 const grpc_channel_args* ChannelArgs::ToC() const {
   std::vector<grpc_arg> c_args;
-  args_.ForEach([&c_args](const std::string& key, const Value& value) {
+  ForEach([&c_args](const std::string& key, const Value& value) {
     char* name = const_cast<char*>(key.c_str());
     c_args.push_back(Match(
         value,
@@ -110,8 +138,53 @@ const grpc_channel_args* ChannelArgs::ToC() const {
   return grpc_channel_args_copy_and_add(nullptr, c_args.data(), c_args.size());
 }
 
+size_t ChannelArgs::EntryHash(absl::string_view name, const Value& value) {
+  size_t value_hash = Match(
+      value, [](int i) { return absl::Hash<int>()(i); },
+      [](const std::string& s) { return absl::Hash<absl::string_view>()(s); },
+      [](const Pointer&) { return size_t{0}; });
+  return absl::Hash<std::pair<absl::string_view, size_t>>()(
+      std::make_pair(name, value_hash));
+}
+
+size_t ChannelArgs::LowerBound(absl::string_view name) const {
+  const auto& entries = args_->entries;
+  return std::lower_bound(entries.begin(), entries.end(), name,
+                          [](const RefCountedPtr<Entry>& entry,
+                             absl::string_view name) {
+                            return absl::string_view(entry->key) < name;
+                          }) -
+         entries.begin();
+}
+
+const ChannelArgs::Value* ChannelArgs::Get(absl::string_view name) const {
+  if (args_ == nullptr) return nullptr;
+  size_t i = LowerBound(name);
+  if (i == args_->entries.size() || args_->entries[i]->key != name) {
+    return nullptr;
+  }
+  return &args_->entries[i]->value;
+}
+
 ChannelArgs ChannelArgs::Set(absl::string_view key, Value value) const {
-  return ChannelArgs(args_.Add(std::string(key), std::move(value)));
+  size_t hash = hash_ + EntryHash(key, value);
+  auto entry = MakeRefCounted<Entry>(std::string(key), std::move(value));
+  auto entries = MakeRefCounted<Entries>();
+  if (args_ == nullptr) {
+    entries->entries.push_back(std::move(entry));
+    return ChannelArgs(std::move(entries), hash);
+  }
+  const auto& old = args_->entries;
+  const size_t i = LowerBound(key);
+  const bool replace = i < old.size() && old[i]->key == key;
+  if (replace) hash -= EntryHash(key, old[i]->value);
+  entries->entries.reserve(old.size() + (replace ? 0 : 1));
+  entries->entries.insert(entries->entries.end(), old.begin(),
+                          old.begin() + i);
+  entries->entries.push_back(std::move(entry));
+  entries->entries.insert(entries->entries.end(),
+                          old.begin() + i + (replace ? 1 : 0), old.end());
+  return ChannelArgs(std::move(entries), hash);
 }
 
 ChannelArgs ChannelArgs::Set(absl::string_view key,
@@ -128,7 +201,44 @@ ChannelArgs ChannelArgs::Set(absl::string_view key, std::string value) const {
 }
 
 ChannelArgs ChannelArgs::Remove(absl::string_view key) const {
-  return ChannelArgs(args_.Remove(key));
+  const Value* prev = Get(key);
+  if (prev == nullptr) return *this;
+  const size_t hash = hash_ - EntryHash(key, *prev);
+  const auto& old = args_->entries;
+  if (old.size() == 1) return ChannelArgs(nullptr, hash);
+  const size_t i = LowerBound(key);
+  auto entries = MakeRefCounted<Entries>();
+  entries->entries.reserve(old.size() - 1);
+  entries->entries.insert(entries->entries.end(), old.begin(),
+                          old.begin() + i);
+  entries->entries.insert(entries->entries.end(), old.begin() + i + 1,
+                          old.end());
+  return ChannelArgs(std::move(entries), hash);
+}
+
+bool ChannelArgs::operator<(const ChannelArgs& other) const {
+  if (args_ == other.args_ || other.args_ == nullptr) return false;
+  if (args_ == nullptr) return true;
+  return std::lexicographical_compare(
+      args_->entries.begin(), args_->entries.end(),
+      other.args_->entries.begin(), other.args_->entries.end(),
+      [](const RefCountedPtr<Entry>& a, const RefCountedPtr<Entry>& b) {
+        if (a == b) return false;
+        if (a->key != b->key) return a->key < b->key;
+        return a->value < b->value;
+      });
+}
+
+bool ChannelArgs::operator==(const ChannelArgs& other) const {
+  if (hash_ != other.hash_) return false;
+  if (args_ == other.args_) return true;
+  if (args_ == nullptr || other.args_ == nullptr) return false;
+  return std::equal(
+      args_->entries.begin(), args_->entries.end(),
+      other.args_->entries.begin(), other.args_->entries.end(),
+      [](const RefCountedPtr<Entry>& a, const RefCountedPtr<Entry>& b) {
+        return a == b || (a->key == b->key && a->value == b->value);
+      });
 }
 
 absl::optional<int> ChannelArgs::GetInt(absl::string_view name) const {
@@ -185,7 +295,7 @@ absl::optional<bool> ChannelArgs::GetBool(absl::string_view name) const {
 
 std::string ChannelArgs::ToString() const {
   std::vector<std::string> arg_strings;
-  args_.ForEach([&arg_strings](const std::string& key, const Value& value) {
+  ForEach([&arg_strings](const std::string& key, const Value& value) {
     std::string value_str;
     if (auto* i = absl::get_if<int>(&value)) {
       value_str = std::to_string(*i);
@@ -26,6 +26,7 @@
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "absl/meta/type_traits.h"
 #include "absl/strings/string_view.h"
@@ -34,7 +35,6 @@
 
 #include <grpc/impl/codegen/grpc_types.h>
 
-#include "src/core/lib/avl/avl.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/dual_ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted.h"
@@ -165,7 +165,7 @@ class ChannelArgs {
   // It should be destroyed with grpc_channel_args_destroy.
   const grpc_channel_args* ToC() const;
 
-  const Value* Get(absl::string_view name) const { return args_.Lookup(name); }
+  const Value* Get(absl::string_view name) const;
   GRPC_MUST_USE_RESULT ChannelArgs Set(absl::string_view name,
                                        Value value) const;
   GRPC_MUST_USE_RESULT ChannelArgs Set(absl::string_view name,
@@ -243,9 +243,26 @@ class ChannelArgs {
     return p->Ref();
   }
 
-  bool operator<(const ChannelArgs& other) const { return args_ < other.args_; }
-  bool operator==(const ChannelArgs& other) const {
-    return args_ == other.args_;
+  // Calls f(name, value) for each arg, in name order.
+  template <typename F>
+  void ForEach(F&& f) const {
+    if (args_ == nullptr) return;
+    for (const auto& entry : args_->entries) f(entry->key, entry->value);
+  }
+
+  bool operator<(const ChannelArgs& other) const;
+  // Args with different hashes, or sharing the same entries, are decided
+  // without comparing values.
+  bool operator==(const ChannelArgs& other) const;
+  bool operator!=(const ChannelArgs& other) const { return !(*this == other); }
+
+  // Hash of the contents, maintained incrementally by Set and Remove.
+  // Equal args have equal hashes. Pointer values contribute only their key,
+  // since pointers may compare equal through their vtable.
+  size_t Hash() const { return hash_; }
+  template <typename H>
+  friend H AbslHashValue(H h, const ChannelArgs& args) {
+    return H::combine(std::move(h), args.hash_);
   }
 
   // Helpers for commonly accessed things
@@ -257,9 +274,34 @@ class ChannelArgs {
   std::string ToString() const;
 
  private:
-  explicit ChannelArgs(AVL<std::string, Value> args) : args_(std::move(args)) {}
+  // One arg. Entries are immutable and shared by every ChannelArgs holding
+  // them, so Set and Remove copy a pointer per arg, not keys and values.
+  struct Entry : public RefCounted<Entry, NonPolymorphicRefCount> {
+    Entry(std::string key, Value value)
+        : key(std::move(key)), value(std::move(value)) {}
+    const std::string key;
+    const Value value;
+  };
+  // The args sorted by key. Channels carry a few dozen args at most, so a
+  // sorted array beats a tree: lookups binary search contiguous memory and
+  // an update is one allocation for the array and one for the new entry.
+  struct Entries : public RefCounted<Entries, NonPolymorphicRefCount> {
+    std::vector<RefCountedPtr<Entry>> entries;
+  };
+
+  ChannelArgs(RefCountedPtr<Entries> args, size_t hash)
+      : args_(std::move(args)), hash_(hash) {}
+
+  // Position of the first entry with a key not less than name.
+  size_t LowerBound(absl::string_view name) const;
+
+  // Hash of one entry; the hash of the args is the sum over all entries so
+  // that it does not depend on the order they were set in.
+  static size_t EntryHash(absl::string_view name, const Value& value);
 
-  AVL<std::string, Value> args_;
+  // Null when there are no args.
+  RefCountedPtr<Entries> args_;
+  size_t hash_ = 0;
 };
 
 }  // namespace grpc_core
@@ -57,7 +57,7 @@ namespace channelz {
 
 BaseNode::BaseNode(EntityType type, std::string name)
     : type_(type), uuid_(-1), name_(std::move(name)) {
-  // The registry will set uuid_ under its lock.
+  // The registry assigns uuid_.
   ChannelzRegistry::Register(this);
 }
 
@@ -135,6 +135,61 @@ void CallCountingHelper::PopulateCallCounts(Json::Object* json) {
   }
 }
 
+BaseNode::CallCounts CallCountingHelper::GetCallCounts() {
+  CounterData data;
+  CollectData(&data);
+  BaseNode::CallCounts counts;
+  counts.calls_started = data.calls_started;
+  counts.calls_succeeded = data.calls_succeeded;
+  counts.calls_failed = data.calls_failed;
+  return counts;
+}
+
+//
+// TxLatencyHistograms
+//
+
+void TxLatencyHistograms::Record(absl::Duration sent_latency,
+                                 absl::Duration acked_latency) {
+  Add(sent_latency, &sent_);
+  Add(acked_latency, &acked_);
+}
+
+void TxLatencyHistograms::Add(absl::Duration latency, Histogram* histogram) {
+  if (latency == absl::InfiniteDuration()) return;
+  int64_t micros = absl::ToInt64Microseconds(latency);
+  size_t bucket = 0;
+  while (micros > 0 && bucket < kNumBuckets - 1) {
+    micros >>= 1;
+    ++bucket;
+  }
+  (*histogram)[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+Json::Array TxLatencyHistograms::Render(const Histogram& histogram) {
+  Json::Array buckets;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    uint64_t count = histogram[i].load(std::memory_order_relaxed);
+    if (count == 0) continue;
+    Json::Object bucket = {{"count", std::to_string(count)}};
+    if (i < kNumBuckets - 1) {
+      bucket["upperBoundMicros"] = std::to_string(uint64_t(1) << i);
+    }
+    buckets.emplace_back(std::move(bucket));
+  }
+  return buckets;
+}
+
+void TxLatencyHistograms::PopulateTxLatency(Json::Object* json) {
+  Json::Array sent = Render(sent_);
+  Json::Array acked = Render(acked_);
+  if (sent.empty() && acked.empty()) return;
+  Json::Object tx_latency;
+  if (!sent.empty()) tx_latency["sent"] = std::move(sent);
+  if (!acked.empty()) tx_latency["acked"] = std::move(acked);
+  (*json)["txLatency"] = std::move(tx_latency);
+}
+
 //
 // ChannelNode
 //
@@ -185,6 +240,7 @@ Json ChannelNode::RenderJson() {
   }
   // Ask CallCountingHelper to populate call count data.
   call_counter_.PopulateCallCounts(&data);
+  tx_latency_.PopulateTxLatency(&data);
   // Construct outer object.
   Json::Object json = {
       {"ref",
@@ -464,11 +520,13 @@ void PopulateSocketAddressJson(Json::Object* json, const char* name,
 }  // namespace
 
 SocketNode::SocketNode(std::string local, std::string remote, std::string name,
-                       RefCountedPtr<Security> security)
+                       RefCountedPtr<Security> security,
+                       RefCountedPtr<TransportStats> transport_stats)
     : BaseNode(EntityType::kSocket, std::move(name)),
       local_(std::move(local)),
       remote_(std::move(remote)),
-      security_(std::move(security)) {}
+      security_(std::move(security)),
+      transport_stats_(std::move(transport_stats)) {}
 
 void SocketNode::RecordStreamStartedFromLocal() {
   streams_started_.fetch_add(1, std::memory_order_relaxed);
@@ -550,6 +608,11 @@ Json SocketNode::RenderJson() {
   if (keepalives_sent != 0) {
     data["keepAlivesSent"] = std::to_string(keepalives_sent);
   }
+  if (transport_stats_ != nullptr) {
+    Json::Array options;
+    transport_stats_->PopulateOptions(&options);
+    if (!options.empty()) data["option"] = std::move(options);
+  }
   // Create and fill the parent object.
   Json::Object object = {
       {"ref",
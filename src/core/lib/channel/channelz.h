@@ -32,6 +32,7 @@
 
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "absl/types/optional.h"
 
 #include <grpc/impl/codegen/connectivity_state.h>
@@ -48,6 +49,9 @@
 // Channel arg key for channelz node.
 #define GRPC_ARG_CHANNELZ_CHANNEL_NODE "grpc.internal.channelz_channel_node"
 
+// Channel arg key for the channelz node of the server owning a connection.
+#define GRPC_ARG_CHANNELZ_SERVER_NODE "grpc.internal.channelz_server_node"
+
 // Channel arg key for indicating an internal channel.
 #define GRPC_ARG_CHANNELZ_IS_INTERNAL_CHANNEL \
   "grpc.channelz_is_internal_channel"
@@ -101,12 +105,22 @@ class BaseNode : public RefCounted<BaseNode> {
   // caller.
   std::string RenderJsonString();
 
+  // Call counters of the entity, for metrics exporters.
+  struct CallCounts {
+    int64_t calls_started = 0;
+    int64_t calls_succeeded = 0;
+    int64_t calls_failed = 0;
+  };
+
+  // Only channels, subchannels and servers count calls.
+  virtual absl::optional<CallCounts> GetCallCounts() { return absl::nullopt; }
+
   EntityType type() const { return type_; }
   intptr_t uuid() const { return uuid_; }
   const std::string& name() const { return name_; }
 
  private:
-  // to allow the ChannelzRegistry to set uuid_ under its lock.
+  // to allow the ChannelzRegistry to assign uuid_.
   friend class ChannelzRegistry;
   const EntityType type_;
   intptr_t uuid_;
@@ -130,6 +144,9 @@ class CallCountingHelper {
   // Common rendering of the call count data and last_call_started_timestamp.
   void PopulateCallCounts(Json::Object* json);
 
+  // Sums the per-cpu counters without taking any lock.
+  BaseNode::CallCounts GetCallCounts();
+
  private:
   // testing peer friend.
   friend class testing::CallCountingHelperPeer;
@@ -175,6 +192,32 @@ class CallCountingHelper {
   size_t num_cores_ = 0;
 };
 
+// Aggregates the kernel TX timestamp latencies reported for the calls on a
+// channel into two histograms with power-of-two microsecond buckets: one for
+// the time from sendmsg until the data left the host, and one for the time
+// from then until it was acked.
+class TxLatencyHistograms {
+ public:
+  // Bucket i counts latencies below 2^i microseconds (and at least 2^(i-1)
+  // for i > 0); the last one also counts everything larger.
+  static constexpr size_t kNumBuckets = 32;
+
+  // Infinite durations are not recorded.
+  void Record(absl::Duration sent_latency, absl::Duration acked_latency);
+
+  // Adds a "txLatency" object to \a json, if anything was recorded.
+  void PopulateTxLatency(Json::Object* json);
+
+ private:
+  using Histogram = std::atomic<uint64_t>[kNumBuckets];
+
+  static void Add(absl::Duration latency, Histogram* histogram);
+  static Json::Array Render(const Histogram& histogram);
+
+  Histogram sent_{};
+  Histogram acked_{};
+};
+
 // Handles channelz bookkeeping for channels
 class ChannelNode : public BaseNode {
  public:
@@ -191,6 +234,10 @@ class ChannelNode : public BaseNode {
 
   Json RenderJson() override;
 
+  absl::optional<CallCounts> GetCallCounts() override {
+    return call_counter_.GetCallCounts();
+  }
+
   // proxy methods to composed classes.
   void AddTraceEvent(ChannelTrace::Severity severity, const grpc_slice& data) {
     trace_.AddTraceEvent(severity, data);
@@ -204,6 +251,10 @@ class ChannelNode : public BaseNode {
   void RecordCallStarted() { call_counter_.RecordCallStarted(); }
   void RecordCallFailed() { call_counter_.RecordCallFailed(); }
   void RecordCallSucceeded() { call_counter_.RecordCallSucceeded(); }
+  void RecordTxLatency(absl::Duration sent_latency,
+                       absl::Duration acked_latency) {
+    tx_latency_.Record(sent_latency, acked_latency);
+  }
 
   void SetConnectivityState(grpc_connectivity_state state);
 
@@ -225,6 +276,7 @@ class ChannelNode : public BaseNode {
 
   std::string target_;
   CallCountingHelper call_counter_;
+  TxLatencyHistograms tx_latency_;
   ChannelTrace trace_;
 
   // Least significant bit indicates whether the value is set.  Remaining
@@ -245,6 +297,10 @@ class ServerNode : public BaseNode {
 
   Json RenderJson() override;
 
+  absl::optional<CallCounts> GetCallCounts() override {
+    return call_counter_.GetCallCounts();
+  }
+
   std::string RenderServerSockets(intptr_t start_socket_id,
                                   intptr_t max_results);
 
@@ -310,8 +366,17 @@ class SocketNode : public BaseNode {
         const grpc_channel_args* args);
   };
 
+  // Transport specific statistics of a socket, rendered as SocketOptions in
+  // its SocketData. Rendering may run concurrently with the transport
+  // updating them.
+  class TransportStats : public RefCounted<TransportStats> {
+   public:
+    virtual void PopulateOptions(Json::Array* options) = 0;
+  };
+
   SocketNode(std::string local, std::string remote, std::string name,
-             RefCountedPtr<Security> security);
+             RefCountedPtr<Security> security,
+             RefCountedPtr<TransportStats> transport_stats = nullptr);
   ~SocketNode() override {}
 
   Json RenderJson() override;
@@ -346,6 +411,7 @@ class SocketNode : public BaseNode {
   std::string local_;
   std::string remote_;
   RefCountedPtr<Security> const security_;
+  RefCountedPtr<TransportStats> const transport_stats_;
 };
 
 // Handles channelz bookkeeping for listen sockets
@@ -21,9 +21,11 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -60,12 +62,20 @@ class ChannelzRegistry {
   // This can aid in debugging channelz code.
   static void LogAllEntities() { Default()->InternalLogAllEntities(); }
 
+  // Returns all channels, subchannels and servers (but not sockets), in uuid
+  // order.
+  static std::vector<RefCountedPtr<BaseNode>> GetCallCountingNodes() {
+    return Default()->InternalGetCallCountingNodes();
+  }
+
   // Test only helper function to reset to initial state.
   static void TestOnlyReset() {
     auto* p = Default();
-    MutexLock lock(&p->mu_);
-    p->node_map_.clear();
-    p->uuid_generator_ = 0;
+    for (Shard& shard : p->shards_) {
+      MutexLock lock(&shard.mu);
+      shard.node_map.clear();
+    }
+    p->uuid_generator_.store(0, std::memory_order_relaxed);
   }
 
  private:
@@ -86,12 +96,29 @@ class ChannelzRegistry {
   std::string InternalGetTopChannels(intptr_t start_channel_id);
   std::string InternalGetServers(intptr_t start_server_id);
 
+  std::vector<RefCountedPtr<BaseNode>> InternalGetCallCountingNodes();
+
   void InternalLogAllEntities();
 
-  // protects members
-  Mutex mu_;
-  std::map<intptr_t, BaseNode*> node_map_;
-  intptr_t uuid_generator_ = 0;
+  // Returns refs to up to \a limit live nodes with uuid >= \a start_uuid
+  // for which \a filter returns true, in uuid order.
+  template <typename Filter>
+  std::vector<RefCountedPtr<BaseNode>> CollectNodes(intptr_t start_uuid,
+                                                    size_t limit,
+                                                    Filter filter);
+
+  // Nodes are sharded by uuid, so that registering and unregistering the
+  // nodes of short-lived connections does not serialize on one lock.
+  static constexpr size_t kNumShards = 16;
+  struct Shard {
+    Mutex mu;
+    std::map<intptr_t, BaseNode*> node_map ABSL_GUARDED_BY(mu);
+  };
+
+  Shard& ShardFor(intptr_t uuid) { return shards_[uuid % kNumShards]; }
+
+  Shard shards_[kNumShards];
+  std::atomic<intptr_t> uuid_generator_{0};
 };
 
 }  // namespace channelz
@@ -45,6 +45,12 @@ typedef enum {
   /// Holds a pointer to ServiceConfigCallData associated with this call.
   GRPC_CONTEXT_SERVICE_CONFIG_CALL_DATA,
 
+  /// Holds a pointer to the TxLatencyReporter of the current call attempt.
+  GRPC_CONTEXT_TX_LATENCY_REPORTER,
+
+  /// Holds a pointer to the BackendMetricProvider of a server call.
+  GRPC_CONTEXT_BACKEND_METRIC_PROVIDER,
+
   GRPC_CONTEXT_COUNT
 } grpc_context_index;
 
@@ -0,0 +1,64 @@
+//
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/channel/tx_latency_reporter.h"
+
+#include "absl/time/time.h"
+
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gprpp/time_util.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Returns the time between two kernel timestamps, or an infinite duration if
+// either of them was not reported.
+absl::Duration Elapsed(const gpr_timespec& from, const gpr_timespec& to) {
+  if (gpr_time_cmp(from, gpr_inf_past(from.clock_type)) == 0 ||
+      gpr_time_cmp(to, gpr_inf_past(to.clock_type)) == 0) {
+    return absl::InfiniteDuration();
+  }
+  return ToAbslTime(to) - ToAbslTime(from);
+}
+
+}  // namespace
+
+void TxLatencyReporter::Report(const Timestamps& ts) {
+  const absl::Duration sent_latency =
+      Elapsed(ts.sendmsg_time.time, ts.sent_time.time);
+  const absl::Duration acked_latency =
+      Elapsed(ts.sent_time.time, ts.acked_time.time);
+  if (channelz_node_ != nullptr) {
+    channelz_node_->RecordTxLatency(sent_latency, acked_latency);
+  }
+  MutexLock lock(&mu_);
+  if (tracer_ != nullptr) {
+    tracer_->RecordTxLatency(ts.byte_offset, sent_latency, acked_latency);
+  }
+}
+
+void TxLatencyReporter::Detach() {
+  MutexLock lock(&mu_);
+  tracer_ = nullptr;
+}
+
+}  // namespace grpc_core
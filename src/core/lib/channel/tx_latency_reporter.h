@@ -0,0 +1,63 @@
+//
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#ifndef GRPC_CORE_LIB_CHANNEL_TX_LATENCY_REPORTER_H
+#define GRPC_CORE_LIB_CHANNEL_TX_LATENCY_REPORTER_H
+
+#include <grpc/support/port_platform.h>
+
+#include "absl/base/thread_annotations.h"
+
+#include "src/core/lib/channel/call_tracer.h"
+#include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/buffer_list.h"
+
+namespace grpc_core {
+
+// Forwards the kernel TX timestamps of the writes carrying a call attempt to
+// the attempt's tracer and to the channel's channelz node. The client channel
+// creates one per attempt and passes it down in the call context under
+// GRPC_CONTEXT_TX_LATENCY_REPORTER; the transport takes a ref, since the
+// timestamps may only arrive after the attempt has finished.
+class TxLatencyReporter : public RefCounted<TxLatencyReporter> {
+ public:
+  // Either argument may be null.
+  TxLatencyReporter(CallTracer::CallAttemptTracer* tracer,
+                    RefCountedPtr<channelz::ChannelNode> channelz_node)
+      : tracer_(tracer), channelz_node_(std::move(channelz_node)) {}
+
+  // Records the latencies in \a ts. Timestamps that the kernel did not report
+  // are passed on as absl::InfiniteDuration().
+  void Report(const Timestamps& ts);
+
+  // Stops reporting to the tracer. Must be called before the attempt tracer's
+  // RecordEnd(), after which it may be destroyed.
+  void Detach();
+
+ private:
+  Mutex mu_;
+  CallTracer::CallAttemptTracer* tracer_ ABSL_GUARDED_BY(mu_);
+  const RefCountedPtr<channelz::ChannelNode> channelz_node_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_CHANNEL_TX_LATENCY_REPORTER_H
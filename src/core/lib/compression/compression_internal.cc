@@ -46,6 +46,8 @@ const char* CompressionAlgorithmAsString(grpc_compression_algorithm algorithm) {
       return "deflate";
     case GRPC_COMPRESS_GZIP:
       return "gzip";
+    case GRPC_COMPRESS_ZSTD:
+      return "zstd";
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
     default:
       return nullptr;
@@ -60,11 +62,27 @@ absl::optional<grpc_compression_algorithm> ParseCompressionAlgorithm(
     return GRPC_COMPRESS_DEFLATE;
   } else if (algorithm == "gzip") {
     return GRPC_COMPRESS_GZIP;
+  } else if (algorithm == "zstd") {
+    return GRPC_COMPRESS_ZSTD;
   } else {
     return absl::nullopt;
   }
 }
 
+bool IsCompressionAlgorithmSupported(grpc_compression_algorithm algorithm) {
+  switch (algorithm) {
+    case GRPC_COMPRESS_NONE:
+    case GRPC_COMPRESS_DEFLATE:
+    case GRPC_COMPRESS_GZIP:
+      return true;
+    case GRPC_COMPRESS_ZSTD:
+      return GRPC_ZSTD != 0;
+    case GRPC_COMPRESS_ALGORITHMS_COUNT:
+    default:
+      return false;
+  }
+}
+
 grpc_compression_algorithm
 CompressionAlgorithmSet::CompressionAlgorithmForLevel(
     grpc_compression_level level) const {
@@ -85,12 +103,14 @@ CompressionAlgorithmSet::CompressionAlgorithmForLevel(
   /* Establish a "ranking" or compression algorithms in increasing order of
    * compression.
    * This is simplistic and we will probably want to introduce other dimensions
-   * in the future (cpu/memory cost, etc). */
+   * in the future (cpu/memory cost, etc). zstd compresses better than zlib,
+   * and faster too. The peer may accept algorithms this build lacks. */
   absl::InlinedVector<grpc_compression_algorithm,
                       GRPC_COMPRESS_ALGORITHMS_COUNT>
       algos;
-  for (auto algo : {GRPC_COMPRESS_GZIP, GRPC_COMPRESS_DEFLATE}) {
-    if (set_.is_set(algo)) {
+  for (auto algo :
+       {GRPC_COMPRESS_GZIP, GRPC_COMPRESS_DEFLATE, GRPC_COMPRESS_ZSTD}) {
+    if (set_.is_set(algo) && IsCompressionAlgorithmSupported(algo)) {
       algos.push_back(algo);
     }
   }
@@ -136,6 +156,13 @@ CompressionAlgorithmSet CompressionAlgorithmSet::FromChannelArgs(
   } else {
     set = CompressionAlgorithmSet::FromUint32(kEverything);
   }
+  // Channels can only enable algorithms this build has.
+  for (size_t i = 0; i < GRPC_COMPRESS_ALGORITHMS_COUNT; i++) {
+    if (!IsCompressionAlgorithmSupported(
+            static_cast<grpc_compression_algorithm>(i))) {
+      set.set_.clear(i);
+    }
+  }
   return set;
 }
 
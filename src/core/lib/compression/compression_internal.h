@@ -42,6 +42,9 @@ absl::optional<grpc_compression_algorithm> ParseCompressionAlgorithm(
 // Convert a compression algorithm to a string. Returns nullptr if a name is not
 // known.
 const char* CompressionAlgorithmAsString(grpc_compression_algorithm algorithm);
+// Return true if this build can compress and decompress with algorithm: zstd
+// needs GRPC_ZSTD.
+bool IsCompressionAlgorithmSupported(grpc_compression_algorithm algorithm);
 // Retrieve the default compression algorithm from channel args, return nullopt
 // if not found.
 absl::optional<grpc_compression_algorithm>
@@ -53,7 +56,8 @@ class CompressionAlgorithmSet {
   // Construct from a uint32_t bitmask - bit 0 => algorithm 0, bit 1 =>
   // algorithm 1, etc.
   static CompressionAlgorithmSet FromUint32(uint32_t value);
-  // Locate in channel args and construct from the found value.
+  // Locate in channel args and construct from the found value, leaving out
+  // the algorithms this build does not support.
   static CompressionAlgorithmSet FromChannelArgs(const grpc_channel_args* args);
   // Parse a string of comma-separated compression algorithms.
   static CompressionAlgorithmSet FromString(absl::string_view str);
@@ -22,14 +22,28 @@
 
 #include <string.h>
 
+#include <algorithm>
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/str_split.h"
+
 #include <zlib.h>
+#if GRPC_ZSTD
+#include <zstd.h>
+#endif
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/slice/slice_internal.h"
 
 #define OUTPUT_BLOCK_SIZE 1024
+#define MAX_ZSTD_SIZED_BLOCK_SIZE (4 * 1024 * 1024)
+/* ZSTD_FRAMEHEADERSIZE_MAX, which zstd.h only declares for static linking. */
+#define MAX_ZSTD_FRAME_HEADER_SIZE 18
 
 static int zlib_body(z_stream* zs, grpc_slice_buffer* input,
                      grpc_slice_buffer* output,
@@ -91,54 +105,138 @@ static void* zalloc_gpr(void* /*opaque*/, unsigned int items,
 
 static void zfree_gpr(void* /*opaque*/, void* address) { gpr_free(address); }
 
-static int zlib_compress(grpc_slice_buffer* input, grpc_slice_buffer* output,
-                         int gzip) {
-  z_stream zs;
-  int r;
-  size_t i;
+static void reset_output(grpc_slice_buffer* output, size_t count_before,
+                         size_t length_before) {
+  for (size_t i = count_before; i < output->count; i++) {
+    grpc_slice_unref_internal(output->slices[i]);
+  }
+  output->count = count_before;
+  output->length = length_before;
+}
+
+/* zs must be freshly initialized or reset with deflateInit2. */
+static int zlib_compress(z_stream* zs, grpc_slice_buffer* input,
+                         grpc_slice_buffer* output) {
   size_t count_before = output->count;
   size_t length_before = output->length;
-  memset(&zs, 0, sizeof(zs));
-  zs.zalloc = zalloc_gpr;
-  zs.zfree = zfree_gpr;
-  r = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 | (gzip ? 16 : 0),
-                   8, Z_DEFAULT_STRATEGY);
-  GPR_ASSERT(r == Z_OK);
-  r = zlib_body(&zs, input, output, deflate) && output->length < input->length;
-  if (!r) {
-    for (i = count_before; i < output->count; i++) {
-      grpc_slice_unref_internal(output->slices[i]);
-    }
-    output->count = count_before;
-    output->length = length_before;
-  }
-  deflateEnd(&zs);
+  int r =
+      zlib_body(zs, input, output, deflate) && output->length < input->length;
+  if (!r) reset_output(output, count_before, length_before);
   return r;
 }
 
-static int zlib_decompress(grpc_slice_buffer* input, grpc_slice_buffer* output,
-                           int gzip) {
-  z_stream zs;
-  int r;
-  size_t i;
+/* zs must be freshly initialized or reset with inflateInit2. */
+static int zlib_decompress(z_stream* zs, grpc_slice_buffer* input,
+                           grpc_slice_buffer* output) {
+  size_t count_before = output->count;
+  size_t length_before = output->length;
+  int r = zlib_body(zs, input, output, inflate);
+  if (!r) reset_output(output, count_before, length_before);
+  return r;
+}
+
+#if GRPC_ZSTD
+static int zstd_compress(ZSTD_CCtx* cctx, const ZSTD_CDict* cdict,
+                         grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  if (input->length == 0) return 0;
+  /* Compression only pays off if the result is smaller than the input, so
+     compress into a single slice of the input's size and give up once it is
+     full. */
+  grpc_slice outbuf = GRPC_SLICE_MALLOC(input->length);
+  ZSTD_outBuffer out = {GRPC_SLICE_START_PTR(outbuf), GRPC_SLICE_LENGTH(outbuf),
+                        0};
+  ZSTD_CCtx_reset(cctx, ZSTD_reset_session_only);
+  ZSTD_CCtx_refCDict(cctx, cdict);
+  ZSTD_CCtx_setPledgedSrcSize(cctx, input->length);
+  int r = 1;
+  for (size_t i = 0; r && i < input->count; i++) {
+    const ZSTD_EndDirective mode =
+        i == input->count - 1 ? ZSTD_e_end : ZSTD_e_continue;
+    ZSTD_inBuffer in = {GRPC_SLICE_START_PTR(input->slices[i]),
+                        GRPC_SLICE_LENGTH(input->slices[i]), 0};
+    size_t remaining;
+    do {
+      remaining = ZSTD_compressStream2(cctx, &out, &in, mode);
+      if (ZSTD_isError(remaining)) {
+        gpr_log(GPR_INFO, "zstd error: %s", ZSTD_getErrorName(remaining));
+        r = 0;
+        break;
+      }
+      if (out.pos == out.size && (remaining != 0 || in.pos < in.size)) {
+        /* Not smaller than the input. */
+        r = 0;
+        break;
+      }
+    } while (mode == ZSTD_e_end ? remaining != 0 : in.pos < in.size);
+  }
+  if (!r || out.pos >= input->length) {
+    grpc_slice_unref_internal(outbuf);
+    return 0;
+  }
+  outbuf.data.refcounted.length = out.pos;
+  grpc_slice_buffer_add_indexed(output, outbuf);
+  return 1;
+}
+
+static int zstd_decompress(ZSTD_DCtx* dctx, const ZSTD_DDict* ddict,
+                           grpc_slice_buffer* input,
+                           grpc_slice_buffer* output) {
   size_t count_before = output->count;
   size_t length_before = output->length;
-  memset(&zs, 0, sizeof(zs));
-  zs.zalloc = zalloc_gpr;
-  zs.zfree = zfree_gpr;
-  r = inflateInit2(&zs, 15 | (gzip ? 16 : 0));
-  GPR_ASSERT(r == Z_OK);
-  r = zlib_body(&zs, input, output, inflate);
-  if (!r) {
-    for (i = count_before; i < output->count; i++) {
-      grpc_slice_unref_internal(output->slices[i]);
+  ZSTD_DCtx_reset(dctx, ZSTD_reset_session_only);
+  ZSTD_DCtx_refDDict(dctx, ddict);
+  /* Decompress into a single block if the frame header has the content size,
+     bounded so that a bogus header cannot make us allocate much. Otherwise,
+     output blocks grow from OUTPUT_BLOCK_SIZE up to zstd's recommended size,
+     so that small messages do not allocate large blocks. */
+  size_t block_size = OUTPUT_BLOCK_SIZE;
+  if (input->count > 0) {
+    unsigned long long content_size =
+        ZSTD_getFrameContentSize(GRPC_SLICE_START_PTR(input->slices[0]),
+                                 GRPC_SLICE_LENGTH(input->slices[0]));
+    if (content_size < MAX_ZSTD_SIZED_BLOCK_SIZE) {
+      block_size = std::max(block_size, static_cast<size_t>(content_size) + 1);
     }
-    output->count = count_before;
-    output->length = length_before;
   }
-  inflateEnd(&zs);
-  return r;
+  grpc_slice outbuf = GRPC_SLICE_MALLOC(block_size);
+  ZSTD_outBuffer out = {GRPC_SLICE_START_PTR(outbuf), GRPC_SLICE_LENGTH(outbuf),
+                        0};
+  /* Do not fail on an empty input. */
+  size_t remaining = input->length == 0 ? 0 : 1;
+  int r = 1;
+  for (size_t i = 0; r && i < input->count; i++) {
+    ZSTD_inBuffer in = {GRPC_SLICE_START_PTR(input->slices[i]),
+                        GRPC_SLICE_LENGTH(input->slices[i]), 0};
+    while (in.pos < in.size || out.pos == out.size) {
+      if (out.pos == out.size) {
+        grpc_slice_buffer_add_indexed(output, outbuf);
+        block_size = std::min(block_size * 2, ZSTD_DStreamOutSize());
+        outbuf = GRPC_SLICE_MALLOC(block_size);
+        out = {GRPC_SLICE_START_PTR(outbuf), GRPC_SLICE_LENGTH(outbuf), 0};
+      }
+      remaining = ZSTD_decompressStream(dctx, &out, &in);
+      if (ZSTD_isError(remaining)) {
+        gpr_log(GPR_INFO, "zstd error: %s", ZSTD_getErrorName(remaining));
+        r = 0;
+        break;
+      }
+      if (in.pos == in.size && out.pos < out.size) break;
+    }
+  }
+  if (r && remaining != 0) {
+    gpr_log(GPR_INFO, "zstd: Data error");
+    r = 0;
+  }
+  if (!r || out.pos == 0) {
+    grpc_slice_unref_internal(outbuf);
+    if (!r) reset_output(output, count_before, length_before);
+    return r;
+  }
+  outbuf.data.refcounted.length = out.pos;
+  grpc_slice_buffer_add_indexed(output, outbuf);
+  return 1;
 }
+#endif
 
 static int copy(grpc_slice_buffer* input, grpc_slice_buffer* output) {
   size_t i;
@@ -148,17 +246,248 @@ static int copy(grpc_slice_buffer* input, grpc_slice_buffer* output) {
   return 1;
 }
 
-static int compress_inner(grpc_compression_algorithm algorithm,
-                          grpc_slice_buffer* input, grpc_slice_buffer* output) {
+namespace grpc_core {
+
+//
+// ZstdCompressionDictionaries
+//
+
+namespace {
+
+void* ZstdCompressionDictionariesArgCopy(void* p) {
+  return static_cast<ZstdCompressionDictionaries*>(p)->Ref().release();
+}
+
+void ZstdCompressionDictionariesArgDestroy(void* p) {
+  static_cast<ZstdCompressionDictionaries*>(p)->Unref();
+}
+
+int ZstdCompressionDictionariesArgCmp(void* p, void* q) {
+  return QsortCompare(p, q);
+}
+
+const grpc_arg_pointer_vtable kZstdCompressionDictionariesArgVtable = {
+    ZstdCompressionDictionariesArgCopy, ZstdCompressionDictionariesArgDestroy,
+    ZstdCompressionDictionariesArgCmp};
+
+const char* kZstdCompressionDictionariesChannelArgName =
+    "grpc.internal.zstd_compression_dictionaries";
+
+// Returns the id of a dictionary in the format of zstd's dictionary trainer:
+// a magic number and then the id, both little endian. Returns 0 for other
+// dictionaries.
+uint32_t GetZstdDictionaryId(const std::string& dictionary) {
+  if (dictionary.size() < 8) return 0;
+  auto read_le32 = [&dictionary](size_t offset) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; i++) {
+      value |= static_cast<uint32_t>(
+                   static_cast<uint8_t>(dictionary[offset + i]))
+               << (8 * i);
+    }
+    return value;
+  };
+  if (read_le32(0) != 0xEC30A437) return 0;
+  return read_le32(4);
+}
+
+}  // namespace
+
+RefCountedPtr<ZstdCompressionDictionaries>
+ZstdCompressionDictionaries::Create(
+    const std::vector<std::string>& dictionaries) {
+  RefCountedPtr<ZstdCompressionDictionaries> result(
+      new ZstdCompressionDictionaries());
+  for (const std::string& dictionary : dictionaries) {
+    uint32_t id = GetZstdDictionaryId(dictionary);
+    if (id == 0) {
+      gpr_log(GPR_ERROR,
+              "Ignoring zstd dictionary without an id: not in the format of "
+              "the zstd dictionary trainer");
+      continue;
+    }
+#if GRPC_ZSTD
+    if (result->dictionaries_.count(id) != 0) {
+      gpr_log(GPR_ERROR, "Ignoring duplicate zstd dictionary id %u", id);
+      continue;
+    }
+    Dictionary digested = {
+        ZSTD_createCDict(dictionary.data(), dictionary.size(),
+                         ZSTD_CLEVEL_DEFAULT),
+        ZSTD_createDDict(dictionary.data(), dictionary.size())};
+    if (digested.cdict == nullptr || digested.ddict == nullptr) {
+      gpr_log(GPR_ERROR, "Ignoring invalid zstd dictionary %u", id);
+      ZSTD_freeCDict(digested.cdict);
+      ZSTD_freeDDict(digested.ddict);
+      continue;
+    }
+    result->dictionaries_.emplace(id, digested);
+#else
+    gpr_log(GPR_ERROR,
+            "Ignoring zstd dictionary %u: gRPC is built without zstd", id);
+#endif
+  }
+  std::vector<uint32_t> ids;
+  for (const auto& p : result->dictionaries_) ids.push_back(p.first);
+  result->advertisement_ = absl::StrJoin(ids, ",");
+  return result;
+}
+
+RefCountedPtr<ZstdCompressionDictionaries>
+ZstdCompressionDictionaries::GetFromChannelArgs(const grpc_channel_args* args) {
+  auto* dictionaries = grpc_channel_args_find_pointer<
+      ZstdCompressionDictionaries>(args,
+                                   kZstdCompressionDictionariesChannelArgName);
+  if (dictionaries == nullptr || dictionaries->dictionaries_.empty()) {
+    return nullptr;
+  }
+  return dictionaries->Ref();
+}
+
+absl::string_view ZstdCompressionDictionaries::ChannelArgName() {
+  return kZstdCompressionDictionariesChannelArgName;
+}
+
+const grpc_arg_pointer_vtable*
+ZstdCompressionDictionaries::ChannelArgVtable() {
+  return &kZstdCompressionDictionariesArgVtable;
+}
+
+absl::string_view ZstdCompressionDictionaries::MetadataKey() {
+  return "grpc-zstd-dictionaries";
+}
+
+ZstdCompressionDictionaries::~ZstdCompressionDictionaries() {
+#if GRPC_ZSTD
+  for (auto& p : dictionaries_) {
+    ZSTD_freeCDict(p.second.cdict);
+    ZSTD_freeDDict(p.second.ddict);
+  }
+#endif
+}
+
+uint32_t ZstdCompressionDictionaries::ChooseDictionary(
+    absl::string_view peer_advertisement) const {
+  uint32_t chosen = 0;
+  for (absl::string_view id_string :
+       absl::StrSplit(peer_advertisement, ',', absl::SkipWhitespace())) {
+    uint32_t id;
+    if (absl::SimpleAtoi(id_string, &id) && id > chosen &&
+        dictionaries_.count(id) != 0) {
+      chosen = id;
+    }
+  }
+  return chosen;
+}
+
+//
+// MessageCompressionContext
+//
+
+struct MessageCompressionContext::State {
+  /* zlib streams by whether they are for gzip, valid if initialized. */
+  z_stream deflate[2];
+  bool deflate_initialized[2] = {false, false};
+  z_stream inflate[2];
+  bool inflate_initialized[2] = {false, false};
+#if GRPC_ZSTD
+  ZSTD_CCtx* zstd_cctx = nullptr;
+  ZSTD_DCtx* zstd_dctx = nullptr;
+#endif
+
+  ~State() {
+    for (int gzip = 0; gzip < 2; gzip++) {
+      if (deflate_initialized[gzip]) deflateEnd(&deflate[gzip]);
+      if (inflate_initialized[gzip]) inflateEnd(&inflate[gzip]);
+    }
+#if GRPC_ZSTD
+    ZSTD_freeCCtx(zstd_cctx);
+    ZSTD_freeDCtx(zstd_dctx);
+#endif
+  }
+
+  z_stream* GetDeflate(int gzip) {
+    z_stream* zs = &deflate[gzip];
+    if (deflate_initialized[gzip]) {
+      GPR_ASSERT(deflateReset(zs) == Z_OK);
+      return zs;
+    }
+    memset(zs, 0, sizeof(*zs));
+    zs->zalloc = zalloc_gpr;
+    zs->zfree = zfree_gpr;
+    GPR_ASSERT(deflateInit2(zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                            15 | (gzip ? 16 : 0), 8,
+                            Z_DEFAULT_STRATEGY) == Z_OK);
+    deflate_initialized[gzip] = true;
+    return zs;
+  }
+
+  z_stream* GetInflate(int gzip) {
+    z_stream* zs = &inflate[gzip];
+    if (inflate_initialized[gzip]) {
+      GPR_ASSERT(inflateReset(zs) == Z_OK);
+      return zs;
+    }
+    memset(zs, 0, sizeof(*zs));
+    zs->zalloc = zalloc_gpr;
+    zs->zfree = zfree_gpr;
+    GPR_ASSERT(inflateInit2(zs, 15 | (gzip ? 16 : 0)) == Z_OK);
+    inflate_initialized[gzip] = true;
+    return zs;
+  }
+
+#if GRPC_ZSTD
+  ZSTD_CCtx* GetZstdCCtx() {
+    if (zstd_cctx == nullptr) zstd_cctx = ZSTD_createCCtx();
+    GPR_ASSERT(zstd_cctx != nullptr);
+    return zstd_cctx;
+  }
+
+  ZSTD_DCtx* GetZstdDCtx() {
+    if (zstd_dctx == nullptr) zstd_dctx = ZSTD_createDCtx();
+    GPR_ASSERT(zstd_dctx != nullptr);
+    return zstd_dctx;
+  }
+#endif
+};
+
+MessageCompressionContext::MessageCompressionContext() = default;
+
+MessageCompressionContext::~MessageCompressionContext() { delete state_; }
+
+MessageCompressionContext::State* MessageCompressionContext::state() {
+  if (state_ == nullptr) state_ = new State();
+  return state_;
+}
+
+int MessageCompressionContext::CompressInner(
+    grpc_compression_algorithm algorithm, grpc_slice_buffer* input,
+    grpc_slice_buffer* output, uint32_t zstd_dictionary_id) {
   switch (algorithm) {
     case GRPC_COMPRESS_NONE:
       /* the fallback path always needs to be send uncompressed: we simply
          rely on that here */
       return 0;
     case GRPC_COMPRESS_DEFLATE:
-      return zlib_compress(input, output, 0);
+      return zlib_compress(state()->GetDeflate(0), input, output);
     case GRPC_COMPRESS_GZIP:
-      return zlib_compress(input, output, 1);
+      return zlib_compress(state()->GetDeflate(1), input, output);
+    case GRPC_COMPRESS_ZSTD:
+#if GRPC_ZSTD
+    {
+      const ZSTD_CDict* cdict = nullptr;
+      if (zstd_dictionary_id != 0 && zstd_dictionaries_ != nullptr) {
+        auto it = zstd_dictionaries_->dictionaries_.find(zstd_dictionary_id);
+        if (it != zstd_dictionaries_->dictionaries_.end()) {
+          cdict = it->second.cdict;
+        }
+      }
+      return zstd_compress(state()->GetZstdCCtx(), cdict, input, output);
+    }
+#else
+      (void)zstd_dictionary_id;
+      break;
+#endif
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
       break;
   }
@@ -166,27 +495,77 @@ static int compress_inner(grpc_compression_algorithm algorithm,
   return 0;
 }
 
-int grpc_msg_compress(grpc_compression_algorithm algorithm,
-                      grpc_slice_buffer* input, grpc_slice_buffer* output) {
-  if (!compress_inner(algorithm, input, output)) {
+int MessageCompressionContext::Compress(grpc_compression_algorithm algorithm,
+                                        grpc_slice_buffer* input,
+                                        grpc_slice_buffer* output,
+                                        uint32_t zstd_dictionary_id) {
+  if (!CompressInner(algorithm, input, output, zstd_dictionary_id)) {
     copy(input, output);
     return 0;
   }
   return 1;
 }
 
-int grpc_msg_decompress(grpc_compression_algorithm algorithm,
-                        grpc_slice_buffer* input, grpc_slice_buffer* output) {
+int MessageCompressionContext::Decompress(
+    grpc_compression_algorithm algorithm, grpc_slice_buffer* input,
+    grpc_slice_buffer* output) {
   switch (algorithm) {
     case GRPC_COMPRESS_NONE:
       return copy(input, output);
     case GRPC_COMPRESS_DEFLATE:
-      return zlib_decompress(input, output, 0);
+      return zlib_decompress(state()->GetInflate(0), input, output);
     case GRPC_COMPRESS_GZIP:
-      return zlib_decompress(input, output, 1);
+      return zlib_decompress(state()->GetInflate(1), input, output);
+    case GRPC_COMPRESS_ZSTD:
+#if GRPC_ZSTD
+    {
+      /* Frames compressed with a dictionary hold its id in their header. */
+      uint8_t header[MAX_ZSTD_FRAME_HEADER_SIZE];
+      size_t header_length = 0;
+      for (size_t i = 0; i < input->count && header_length < sizeof(header);
+           i++) {
+        size_t n = std::min(GRPC_SLICE_LENGTH(input->slices[i]),
+                            sizeof(header) - header_length);
+        memcpy(header + header_length, GRPC_SLICE_START_PTR(input->slices[i]),
+               n);
+        header_length += n;
+      }
+      const ZSTD_DDict* ddict = nullptr;
+      uint32_t dictionary_id = ZSTD_getDictID_fromFrame(header, header_length);
+      if (dictionary_id != 0) {
+        if (zstd_dictionaries_ != nullptr) {
+          auto it = zstd_dictionaries_->dictionaries_.find(dictionary_id);
+          if (it != zstd_dictionaries_->dictionaries_.end()) {
+            ddict = it->second.ddict;
+          }
+        }
+        if (ddict == nullptr) {
+          gpr_log(GPR_INFO, "zstd: unknown dictionary %u", dictionary_id);
+          return 0;
+        }
+      }
+      return zstd_decompress(state()->GetZstdDCtx(), ddict, input, output);
+    }
+#else
+      break;
+#endif
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
       break;
   }
   gpr_log(GPR_ERROR, "invalid compression algorithm %d", algorithm);
   return 0;
 }
+
+}  // namespace grpc_core
+
+int grpc_msg_compress(grpc_compression_algorithm algorithm,
+                      grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  return grpc_core::MessageCompressionContext().Compress(algorithm, input,
+                                                         output);
+}
+
+int grpc_msg_decompress(grpc_compression_algorithm algorithm,
+                        grpc_slice_buffer* input, grpc_slice_buffer* output) {
+  return grpc_core::MessageCompressionContext().Decompress(algorithm, input,
+                                                           output);
+}
@@ -21,9 +21,23 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+#include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/slice_buffer.h>
 
 #include "src/core/lib/compression/compression_internal.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
 
 /* compress 'input' to 'output' using 'algorithm'.
    On success, appends compressed slices to output and returns 1.
@@ -37,4 +51,98 @@ int grpc_msg_compress(grpc_compression_algorithm algorithm,
 int grpc_msg_decompress(grpc_compression_algorithm algorithm,
                         grpc_slice_buffer* input, grpc_slice_buffer* output);
 
+namespace grpc_core {
+
+// The zstd dictionaries of a channel, to compress small messages that share
+// content across calls. Each side advertises the ids of its dictionaries in
+// its initial metadata, and compresses zstd messages with the highest-id
+// dictionary both sides have. Clients assume that servers have all their
+// dictionaries until they see the server's initial metadata, so new
+// dictionaries should be rolled out to servers first. zstd frames carry the
+// id of their dictionary, so receivers look it up by that.
+class ZstdCompressionDictionaries
+    : public RefCounted<ZstdCompressionDictionaries> {
+ public:
+  // Dictionaries must be in the format of zstd's dictionary trainer, which
+  // holds their id. Others are ignored, with an error log, as are all of them
+  // if gRPC is built without zstd.
+  static RefCountedPtr<ZstdCompressionDictionaries> Create(
+      const std::vector<std::string>& dictionaries);
+  static RefCountedPtr<ZstdCompressionDictionaries> GetFromChannelArgs(
+      const grpc_channel_args* args);
+  static absl::string_view ChannelArgName();
+  static const grpc_arg_pointer_vtable* ChannelArgVtable();
+  // The initial metadata key advertising the dictionaries.
+  static absl::string_view MetadataKey();
+
+  ~ZstdCompressionDictionaries() override;
+
+  // The value of the advertisement: the ids, comma separated.
+  const std::string& advertisement() const { return advertisement_; }
+  // Returns the id of the dictionary to send with to a peer that advertised
+  // \a peer_advertisement, or 0 for none.
+  uint32_t ChooseDictionary(absl::string_view peer_advertisement) const;
+  // Returns the id of the dictionary to send with before knowing what the
+  // peer has, or 0 for none.
+  uint32_t highest_id() const {
+    return dictionaries_.empty() ? 0 : dictionaries_.rbegin()->first;
+  }
+
+ private:
+  friend class MessageCompressionContext;
+
+  struct Dictionary {
+    ZSTD_CDict_s* cdict;
+    ZSTD_DDict_s* ddict;
+  };
+
+  ZstdCompressionDictionaries() = default;
+
+  std::map<uint32_t, Dictionary> dictionaries_;
+  std::string advertisement_;
+};
+
+// Compression state kept across the messages of a call, so that each message
+// only resets the zlib or zstd state of its algorithm instead of allocating
+// and setting it up again. Each message is still compressed independently.
+// Not thread safe.
+class MessageCompressionContext {
+ public:
+  MessageCompressionContext();
+  ~MessageCompressionContext();
+
+  MessageCompressionContext(const MessageCompressionContext&) = delete;
+  MessageCompressionContext& operator=(const MessageCompressionContext&) =
+      delete;
+
+  // Sets the dictionaries zstd messages may be compressed with.
+  void set_zstd_dictionaries(
+      RefCountedPtr<ZstdCompressionDictionaries> zstd_dictionaries) {
+    zstd_dictionaries_ = std::move(zstd_dictionaries);
+  }
+
+  // Same as grpc_msg_compress(). zstd messages are compressed with the
+  // dictionary \a zstd_dictionary_id, if non-zero and known.
+  int Compress(grpc_compression_algorithm algorithm, grpc_slice_buffer* input,
+               grpc_slice_buffer* output, uint32_t zstd_dictionary_id = 0);
+  // Same as grpc_msg_decompress().
+  int Decompress(grpc_compression_algorithm algorithm,
+                 grpc_slice_buffer* input, grpc_slice_buffer* output);
+
+ private:
+  struct State;
+
+  State* state();
+  int CompressInner(grpc_compression_algorithm algorithm,
+                    grpc_slice_buffer* input, grpc_slice_buffer* output,
+                    uint32_t zstd_dictionary_id);
+
+  // Created on first use, so that calls that never compress a message pay
+  // nothing.
+  State* state_ = nullptr;
+  RefCountedPtr<ZstdCompressionDictionaries> zstd_dictionaries_;
+};
+
+}  // namespace grpc_core
+
 #endif /* GRPC_CORE_LIB_COMPRESSION_MESSAGE_COMPRESS_H */
@@ -26,6 +26,7 @@
 #include <grpc/support/atm.h>
 
 #include "src/core/lib/debug/stats_data.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 
 typedef struct grpc_stats_data {
@@ -68,4 +69,12 @@ double grpc_stats_histo_percentile(const grpc_stats_data* stats,
 size_t grpc_stats_histo_count(const grpc_stats_data* stats,
                               grpc_stats_histograms histogram);
 
+// Microseconds elapsed since \a start, for the *_MICROS latency histograms.
+// Only evaluated when stats are collected, since the GRPC_STATS_INC_* macros
+// drop their argument otherwise.
+inline int64_t grpc_stats_micros_since(gpr_cycle_counter start) {
+  return static_cast<int64_t>(gpr_timespec_to_micros(
+      gpr_cycle_counter_sub(gpr_get_cycle_counter(), start)));
+}
+
 #endif  // GRPC_CORE_LIB_DEBUG_STATS_H
@@ -41,11 +41,15 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "pollset_kick_wakeup_fd",
     "pollset_kick_wakeup_cv",
     "pollset_kick_own_thread",
+    "busy_poll_hits",
+    "busy_poll_misses",
     "histogram_slow_lookups",
     "syscall_write",
     "syscall_read",
     "tcp_backup_pollers_created",
     "tcp_backup_poller_polls",
+    "tcp_zerocopy_read_attempts",
+    "tcp_zerocopy_reads",
     "http2_op_batches",
     "http2_op_cancel",
     "http2_op_send_initial_metadata",
@@ -60,6 +64,7 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "http2_writes_offloaded",
     "http2_writes_continued",
     "http2_partial_writes",
+    "http2_coalesced_writes",
     "http2_initiate_write_due_to_initial_write",
     "http2_initiate_write_due_to_start_new_stream",
     "http2_initiate_write_due_to_send_message",
@@ -121,9 +126,22 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "executor_push_retries",
     "server_requested_calls",
     "server_slowpath_requests_queued",
+    "server_qos_calls_shed",
     "cq_ev_queue_trylock_failures",
     "cq_ev_queue_trylock_successes",
     "cq_ev_queue_transient_pop_failures",
+    "xds_coalesced_updates",
+    "ssl_session_cache_hits",
+    "ssl_session_cache_misses",
+    "ssl_session_cache_evictions",
+    "ssl_client_full_handshakes",
+    "ssl_client_resumed_handshakes",
+    "ssl_server_full_handshakes",
+    "ssl_server_resumed_handshakes",
+    "work_serializer_run_inline",
+    "work_serializer_run_queued",
+    "sync_server_pollers_grown",
+    "sync_server_pollers_shrunk",
 };
 const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of client side calls created by this process",
@@ -146,6 +164,10 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "polling wakeup (only valid for epoll1 right now)",
     "How many times could a polling wakeup be satisfied by keeping the waking "
     "thread awake? (only valid for epoll1 right now)",
+    "How many busy-polling spins found events before giving up and blocking "
+    "(only valid for epoll1 right now)",
+    "How many busy-polling spins ran out of budget and fell back to a "
+    "blocking poll (only valid for epoll1 right now)",
     "Number of times histogram increments went through the slow (binary "
     "search) path",
     "Number of write syscalls (or equivalent - eg sendmsg) made by this "
@@ -153,6 +175,10 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of read syscalls (or equivalent - eg recvmsg) made by this process",
     "Number of times a backup poller has been created (this can be expensive)",
     "Number of polls performed on the backup poller",
+    "Number of reads that tried to map the pending bytes with "
+    "TCP_ZEROCOPY_RECEIVE",
+    "Number of reads served by mapping the pending bytes with "
+    "TCP_ZEROCOPY_RECEIVE",
     "Number of batches received by HTTP2 transport",
     "Number of cancelations received by HTTP2 transport",
     "Number of batches containing send initial metadata",
@@ -169,6 +195,8 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "written",
     "Number of HTTP2 writes that were made knowing there was still more data "
     "to be written (we cap maximum write size to syscall_write)",
+    "Number of HTTP2 writes that were held back by the write coalescing "
+    "window (GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_US)",
     "Number of HTTP2 writes initiated due to 'initial_write'",
     "Number of HTTP2 writes initiated due to 'start_new_stream'",
     "Number of HTTP2 writes initiated due to 'send_message'",
@@ -243,12 +271,32 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "How many calls were requested (not necessarily received) by the server",
     "How many times was the server slow path taken (indicates too few "
     "outstanding requests)",
+    "How many calls waiting to be requested were failed for exceeding the "
+    "server QoS queueing delay target",
     "Number of lock (trylock) acquisition failures on completion queue event "
     "queue. High value here indicates high contention on completion queues",
     "Number of lock (trylock) acquisition successes on completion queue event "
     "queue.",
     "Number of times NULL was popped out of completion queue's event queue "
     "even though the event queue was not empty",
+    "Number of xDS LB tree updates that were folded into a later update by "
+    "the update coalescing window (GRPC_ARG_XDS_UPDATE_COALESCING_WINDOW_MS)",
+    "Number of TLS client sessions found in a session cache for resumption",
+    "Number of TLS client session cache lookups that found no session",
+    "Number of TLS client sessions evicted from a full session cache",
+    "Number of TLS client handshakes that did not resume a session",
+    "Number of TLS client handshakes that resumed a session",
+    "Number of TLS server handshakes that did not resume a session",
+    "Number of TLS server handshakes that resumed a session (accepted a "
+    "session ticket or ID)",
+    "Number of WorkSerializer callbacks run inline by the thread that "
+    "submitted them",
+    "Number of WorkSerializer callbacks queued for the thread that owned the "
+    "serializer",
+    "Number of times an adaptive sync server ThreadManager raised its target "
+    "number of polling threads",
+    "Number of times an adaptive sync server ThreadManager lowered its target "
+    "number of polling threads",
 };
 const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
     "call_initial_size",
@@ -264,6 +312,17 @@ const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
     "http2_send_trailing_metadata_per_write",
     "http2_send_flowctl_per_write",
     "server_cqs_checked",
+    "busy_poll_spin_micros",
+    "http2_write_coalescing_delay_micros",
+    "lb_pick_latency_micros",
+    "http2_write_queue_micros",
+    "pollset_wakeup_micros",
+    "executor_queue_delay_micros",
+    "timer_lateness_millis",
+    "poller_flush_closures",
+    "poller_flush_micros",
+    "work_serializer_queue_depth",
+    "combiner_run_micros",
 };
 const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Initial size of the grpc_call arena created at call start",
@@ -280,6 +339,27 @@ const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Number of flow control updates written per TCP write",
     "How many completion queues were checked looking for a CQ that had "
     "requested the incoming call",
+    "How many microseconds each busy-polling spin lasted (only valid for "
+    "epoll1 right now)",
+    "How many microseconds each coalesced HTTP2 write was held back before "
+    "being handed to the endpoint",
+    "How many microseconds after the start of a call attempt its LB pick "
+    "completed",
+    "How many microseconds HTTP2 frames waited between a write being initiated "
+    "and the frames being gathered for the endpoint",
+    "How many microseconds a polling worker waiting on its condition variable "
+    "took to run after being kicked (only valid for epoll1 right now)",
+    "How many microseconds the oldest closure of each batch run by an executor "
+    "thread waited in its queue",
+    "How many milliseconds after their deadline timers fired",
+    "How many closures (and combiner continuations) a polling thread ran each "
+    "time it flushed its exec_ctx (only valid for epoll1 right now)",
+    "How many microseconds each exec_ctx flush by a polling thread took (only "
+    "valid for epoll1 right now)",
+    "How many WorkSerializer callbacks were running or queued ahead of each "
+    "queued callback",
+    "How many microseconds a combiner ran on one thread before it was released "
+    "or offloaded to the executor",
 };
 const int grpc_stats_table_0[65] = {
     0,      1,      2,      3,      4,     5,     7,     9,     11,    14,
@@ -348,6 +428,76 @@ const uint8_t grpc_stats_table_7[102] = {
     42, 42, 43, 44, 44, 45, 46, 46, 47, 48, 48, 49, 49, 50, 50, 51, 51};
 const int grpc_stats_table_8[9] = {0, 1, 2, 4, 7, 13, 23, 39, 64};
 const uint8_t grpc_stats_table_9[9] = {0, 0, 1, 2, 2, 3, 4, 4, 5};
+const int grpc_stats_table_10[33] = {
+    0,    1,    2,     3,     5,     8,     12,    17,    25,   36,    51,
+    72,   102,  144,   204,   288,   407,   575,   812,   1146, 1617,  2281,
+    3217, 4537, 6398,  9022,  12722, 17939, 25296, 35669, 50296, 70920,
+    100000};
+const uint8_t grpc_stats_table_11[29] = {0,  1,  1,  2,  3,  4,  5,  6,  7,  8,
+                                         9,  10, 11, 12, 13, 14, 15, 16, 17, 18,
+                                         19, 20, 21, 22, 23, 24, 25, 26, 27};
+const int grpc_stats_table_12[132] = {
+    0,      1,      2,      3,      4,      5,      6,      7,      8,
+    9,      10,     11,     13,     15,     17,     19,     21,     24,
+    27,     30,     33,     37,     41,     45,     50,     55,     61,
+    67,     74,     82,     90,     99,     109,    120,    132,    145,
+    159,    175,    192,    211,    232,    255,    280,    307,    337,
+    370,    406,    446,    489,    537,    589,    646,    709,    778,
+    853,    935,    1025,   1124,   1233,   1352,   1482,   1625,   1782,
+    1954,   2142,   2348,   2574,   2822,   3094,   3392,   3718,   4076,
+    4468,   4898,   5369,   5885,   6451,   7071,   7751,   8496,   9312,
+    10207,  11188,  12263,  13441,  14732,  16147,  17698,  19398,  21261,
+    23303,  25541,  27994,  30683,  33630,  36860,  40400,  44280,  48532,
+    53192,  58300,  63898,  70034,  76759,  84130,  92208,  101062, 110766,
+    121402, 133059, 145835, 159838, 175185, 192006, 210442, 230648, 252794,
+    277066, 303668, 332824, 364780, 399804, 438190, 480262, 526373, 576911,
+    632302, 693011, 759548, 832473, 912400, 1000000};
+const uint8_t grpc_stats_table_13[262] = {
+    0,   0,   0,   1,   1,   1,   1,   2,   2,   2,   3,   3,   4,   4,   5,
+    5,   5,   6,   6,   6,   7,   7,   7,   8,   8,   9,   9,   10,  10,  11,
+    11,  12,  12,  12,  13,  13,  14,  14,  14,  15,  15,  16,  16,  17,  17,
+    18,  18,  19,  19,  20,  20,  20,  21,  21,  21,  22,  22,  23,  23,  24,
+    25,  25,  26,  26,  26,  27,  27,  28,  28,  28,  29,  29,  30,  30,  31,
+    31,  32,  32,  33,  33,  34,  34,  35,  35,  36,  36,  36,  37,  37,  38,
+    38,  39,  39,  40,  40,  41,  41,  42,  42,  43,  43,  43,  44,  44,  44,
+    45,  46,  46,  47,  47,  48,  48,  49,  49,  50,  50,  51,  51,  51,  52,
+    52,  53,  53,  54,  54,  55,  55,  56,  56,  57,  57,  58,  58,  58,  59,
+    59,  60,  60,  61,  61,  62,  63,  63,  64,  64,  64,  65,  65,  66,  66,
+    66,  67,  67,  68,  68,  69,  70,  70,  71,  71,  72,  72,  72,  73,  73,
+    74,  74,  74,  75,  75,  76,  77,  77,  78,  78,  79,  79,  80,  80,  80,
+    81,  81,  82,  82,  82,  83,  84,  84,  85,  85,  86,  86,  87,  87,  88,
+    88,  88,  89,  89,  89,  90,  90,  91,  92,  92,  93,  93,  94,  94,  95,
+    95,  95,  96,  96,  97,  97,  97,  98,  99,  99,  100, 100, 101, 101, 102,
+    102, 103, 103, 103, 104, 104, 105, 105, 106, 106, 107, 107, 108, 108, 109,
+    109, 110, 110, 111, 111, 111, 112, 112, 112, 113, 114, 114, 115, 115, 116,
+    116, 117, 117, 118, 118, 119, 119};
+const int grpc_stats_table_14[84] = {
+    0,    1,    2,    3,    4,    5,    6,    7,    8,    9,    10,   11,
+    13,   15,   17,   19,   21,   24,   27,   30,   33,   37,   41,   45,
+    50,   55,   61,   67,   74,   81,   89,   98,   108,  119,  131,  144,
+    158,  173,  189,  207,  227,  248,  271,  296,  324,  354,  387,  423,
+    462,  505,  552,  603,  659,  720,  786,  859,  938,  1024, 1118, 1221,
+    1333, 1456, 1590, 1736, 1895, 2069, 2259, 2466, 2692, 2939, 3208, 3502,
+    3822, 4172, 4554, 4970, 5424, 5920, 6461, 7051, 7695, 8398, 9165, 10000};
+const uint8_t grpc_stats_table_15[155] = {
+    0,  0,  0,  1,  1,  1,  1,  2,  2,  2,  3,  3,  4,  4,  5,  5,  5,  6,
+    6,  6,  7,  7,  7,  8,  8,  9,  9,  10, 10, 11, 11, 12, 12, 12, 13, 13,
+    14, 14, 14, 15, 15, 16, 16, 17, 17, 18, 18, 19, 19, 20, 20, 20, 21, 21,
+    22, 22, 22, 23, 23, 24, 25, 25, 26, 26, 27, 27, 28, 28, 28, 29, 29, 29,
+    30, 31, 31, 32, 32, 33, 33, 34, 34, 35, 35, 36, 36, 37, 37, 37, 38, 38,
+    39, 40, 40, 41, 41, 42, 42, 43, 43, 44, 44, 44, 45, 45, 45, 46, 47, 47,
+    48, 49, 49, 50, 50, 51, 51, 51, 52, 52, 53, 53, 53, 54, 55, 55, 56, 56,
+    57, 58, 58, 58, 59, 59, 60, 60, 61, 61, 61, 62, 63, 63, 64, 64, 65, 65,
+    66, 66, 67, 67, 68, 68, 68, 69, 69, 70, 71};
+const int grpc_stats_table_16[33] = {
+    0,   1,   2,   3,   4,   5,   7,   9,   11,  14,  17,
+    21,  26,  32,  39,  47,  57,  69,  83,  100, 120, 144,
+    173, 207, 248, 297, 355, 424, 506, 604, 721, 860, 1024};
+const uint8_t grpc_stats_table_17[60] = {
+    0,  0,  0,  1,  1,  1,  2,  2,  3,  3,  3,  4,  4,  5,  5,
+    6,  6,  6,  7,  7,  7,  8,  9,  9,  10, 10, 10, 11, 11, 12,
+    12, 13, 13, 14, 14, 14, 15, 15, 16, 17, 17, 18, 18, 18, 19,
+    19, 20, 20, 21, 21, 22, 22, 23, 23, 24, 24, 25, 25, 26, 26};
 void grpc_stats_inc_call_initial_size(int value) {
   value = grpc_core::Clamp(value, 0, 262144);
   if (value < 6) {
@@ -659,17 +809,289 @@ void grpc_stats_inc_server_cqs_checked(int value) {
       GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
       grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_8, 8));
 }
-const int grpc_stats_histo_buckets[13] = {64, 128, 64, 64, 64, 64, 64,
-                                          64, 64,  64, 64, 64, 8};
-const int grpc_stats_histo_start[13] = {0,   64,  192, 256, 320, 384, 448,
-                                        512, 576, 640, 704, 768, 832};
-const int* const grpc_stats_histo_bucket_boundaries[13] = {
-    grpc_stats_table_0, grpc_stats_table_2, grpc_stats_table_4,
-    grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_4,
-    grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_6,
-    grpc_stats_table_6, grpc_stats_table_6, grpc_stats_table_6,
-    grpc_stats_table_8};
-void (*const grpc_stats_inc_histogram[13])(int x) = {
+void grpc_stats_inc_busy_poll_spin_micros(int value) {
+  value = grpc_core::Clamp(value, 0, 100000);
+  if (value < 4) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_BUSY_POLL_SPIN_MICROS, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4676988213024260096ull) {
+    int bucket =
+        grpc_stats_table_11[((_val.uint - 4616189618054758400ull) >> 51)] + 4;
+    _bkt.dbl = grpc_stats_table_10[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_BUSY_POLL_SPIN_MICROS,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_BUSY_POLL_SPIN_MICROS,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_10, 32));
+}
+void grpc_stats_inc_http2_write_coalescing_delay_micros(int value) {
+  value = grpc_core::Clamp(value, 0, 100000);
+  if (value < 4) {
+    GRPC_STATS_INC_HISTOGRAM(
+        GRPC_STATS_HISTOGRAM_HTTP2_WRITE_COALESCING_DELAY_MICROS, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4676988213024260096ull) {
+    int bucket =
+        grpc_stats_table_11[((_val.uint - 4616189618054758400ull) >> 51)] + 4;
+    _bkt.dbl = grpc_stats_table_10[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(
+        GRPC_STATS_HISTOGRAM_HTTP2_WRITE_COALESCING_DELAY_MICROS, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_HTTP2_WRITE_COALESCING_DELAY_MICROS,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_10, 32));
+}
+void grpc_stats_inc_lb_pick_latency_micros(int value) {
+  value = grpc_core::Clamp(value, 0, 1000000);
+  if (value < 12) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_LB_PICK_LATENCY_MICROS,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4656440539724382208ull) {
+    int bucket =
+        grpc_stats_table_13[((_val.uint - 4622945017495814144ull) >> 48)] + 12;
+    _bkt.dbl = grpc_stats_table_12[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_LB_PICK_LATENCY_MICROS,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_LB_PICK_LATENCY_MICROS,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_12, 131));
+}
+void grpc_stats_inc_http2_write_queue_micros(int value) {
+  value = grpc_core::Clamp(value, 0, 1000000);
+  if (value < 12) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_HTTP2_WRITE_QUEUE_MICROS,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4656440539724382208ull) {
+    int bucket =
+        grpc_stats_table_13[((_val.uint - 4622945017495814144ull) >> 48)] + 12;
+    _bkt.dbl = grpc_stats_table_12[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_HTTP2_WRITE_QUEUE_MICROS,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_HTTP2_WRITE_QUEUE_MICROS,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_12, 131));
+}
+void grpc_stats_inc_pollset_wakeup_micros(int value) {
+  value = grpc_core::Clamp(value, 0, 1000000);
+  if (value < 12) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_POLLSET_WAKEUP_MICROS, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4656440539724382208ull) {
+    int bucket =
+        grpc_stats_table_13[((_val.uint - 4622945017495814144ull) >> 48)] + 12;
+    _bkt.dbl = grpc_stats_table_12[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_POLLSET_WAKEUP_MICROS,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_POLLSET_WAKEUP_MICROS,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_12, 131));
+}
+void grpc_stats_inc_executor_queue_delay_micros(int value) {
+  value = grpc_core::Clamp(value, 0, 1000000);
+  if (value < 12) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DELAY_MICROS,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4656440539724382208ull) {
+    int bucket =
+        grpc_stats_table_13[((_val.uint - 4622945017495814144ull) >> 48)] + 12;
+    _bkt.dbl = grpc_stats_table_12[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DELAY_MICROS,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DELAY_MICROS,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_12, 131));
+}
+void grpc_stats_inc_timer_lateness_millis(int value) {
+  value = grpc_core::Clamp(value, 0, 10000);
+  if (value < 12) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_TIMER_LATENESS_MILLIS, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4642929740842270720ull) {
+    int bucket =
+        grpc_stats_table_15[((_val.uint - 4622945017495814144ull) >> 48)] + 12;
+    _bkt.dbl = grpc_stats_table_14[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_TIMER_LATENESS_MILLIS,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_TIMER_LATENESS_MILLIS,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_14, 83));
+}
+void grpc_stats_inc_poller_flush_closures(int value) {
+  value = grpc_core::Clamp(value, 0, 10000);
+  if (value < 12) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_POLLER_FLUSH_CLOSURES, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4642929740842270720ull) {
+    int bucket =
+        grpc_stats_table_15[((_val.uint - 4622945017495814144ull) >> 48)] + 12;
+    _bkt.dbl = grpc_stats_table_14[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_POLLER_FLUSH_CLOSURES,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_POLLER_FLUSH_CLOSURES,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_14, 83));
+}
+void grpc_stats_inc_poller_flush_micros(int value) {
+  value = grpc_core::Clamp(value, 0, 1000000);
+  if (value < 12) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_POLLER_FLUSH_MICROS, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4656440539724382208ull) {
+    int bucket =
+        grpc_stats_table_13[((_val.uint - 4622945017495814144ull) >> 48)] + 12;
+    _bkt.dbl = grpc_stats_table_12[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_POLLER_FLUSH_MICROS, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_POLLER_FLUSH_MICROS,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_12, 131));
+}
+void grpc_stats_inc_work_serializer_queue_depth(int value) {
+  value = grpc_core::Clamp(value, 0, 1024);
+  if (value < 6) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_DEPTH,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4633078116657397760ull) {
+    int bucket =
+        grpc_stats_table_17[((_val.uint - 4618441417868443648ull) >> 49)] + 6;
+    _bkt.dbl = grpc_stats_table_16[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_DEPTH,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_DEPTH,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_16, 32));
+}
+void grpc_stats_inc_combiner_run_micros(int value) {
+  value = grpc_core::Clamp(value, 0, 1000000);
+  if (value < 12) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMBINER_RUN_MICROS, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4656440539724382208ull) {
+    int bucket =
+        grpc_stats_table_13[((_val.uint - 4622945017495814144ull) >> 48)] + 12;
+    _bkt.dbl = grpc_stats_table_12[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMBINER_RUN_MICROS, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_COMBINER_RUN_MICROS,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_12, 131));
+}
+const int grpc_stats_histo_buckets[24] = {64,  128, 64,  64, 64, 64,  64, 64,
+                                          64,  64,  64,  64, 8,  32,  32, 131,
+                                          131, 131, 131, 83, 83, 131, 32, 131};
+const int grpc_stats_histo_start[24] = {
+    0,   64,  192, 256, 320,  384,  448,  512,  576,  640,  704,  768,
+    832, 840, 872, 904, 1035, 1166, 1297, 1428, 1511, 1594, 1725, 1757};
+const int* const grpc_stats_histo_bucket_boundaries[24] = {
+    grpc_stats_table_0,  grpc_stats_table_2,  grpc_stats_table_4,
+    grpc_stats_table_6,  grpc_stats_table_4,  grpc_stats_table_4,
+    grpc_stats_table_6,  grpc_stats_table_4,  grpc_stats_table_6,
+    grpc_stats_table_6,  grpc_stats_table_6,  grpc_stats_table_6,
+    grpc_stats_table_8,  grpc_stats_table_10, grpc_stats_table_10,
+    grpc_stats_table_12, grpc_stats_table_12, grpc_stats_table_12,
+    grpc_stats_table_12, grpc_stats_table_14, grpc_stats_table_14,
+    grpc_stats_table_12, grpc_stats_table_16, grpc_stats_table_12};
+void (*const grpc_stats_inc_histogram[24])(int x) = {
     grpc_stats_inc_call_initial_size,
     grpc_stats_inc_poll_events_returned,
     grpc_stats_inc_tcp_write_size,
@@ -682,4 +1104,15 @@ void (*const grpc_stats_inc_histogram[13])(int x) = {
     grpc_stats_inc_http2_send_message_per_write,
     grpc_stats_inc_http2_send_trailing_metadata_per_write,
     grpc_stats_inc_http2_send_flowctl_per_write,
-    grpc_stats_inc_server_cqs_checked};
+    grpc_stats_inc_server_cqs_checked,
+    grpc_stats_inc_busy_poll_spin_micros,
+    grpc_stats_inc_http2_write_coalescing_delay_micros,
+    grpc_stats_inc_lb_pick_latency_micros,
+    grpc_stats_inc_http2_write_queue_micros,
+    grpc_stats_inc_pollset_wakeup_micros,
+    grpc_stats_inc_executor_queue_delay_micros,
+    grpc_stats_inc_timer_lateness_millis,
+    grpc_stats_inc_poller_flush_closures,
+    grpc_stats_inc_poller_flush_micros,
+    grpc_stats_inc_work_serializer_queue_depth,
+    grpc_stats_inc_combiner_run_micros};
@@ -42,11 +42,15 @@ typedef enum {
   GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_FD,
   GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_CV,
   GRPC_STATS_COUNTER_POLLSET_KICK_OWN_THREAD,
+  GRPC_STATS_COUNTER_BUSY_POLL_HITS,
+  GRPC_STATS_COUNTER_BUSY_POLL_MISSES,
   GRPC_STATS_COUNTER_HISTOGRAM_SLOW_LOOKUPS,
   GRPC_STATS_COUNTER_SYSCALL_WRITE,
   GRPC_STATS_COUNTER_SYSCALL_READ,
   GRPC_STATS_COUNTER_TCP_BACKUP_POLLERS_CREATED,
   GRPC_STATS_COUNTER_TCP_BACKUP_POLLER_POLLS,
+  GRPC_STATS_COUNTER_TCP_ZEROCOPY_READ_ATTEMPTS,
+  GRPC_STATS_COUNTER_TCP_ZEROCOPY_READS,
   GRPC_STATS_COUNTER_HTTP2_OP_BATCHES,
   GRPC_STATS_COUNTER_HTTP2_OP_CANCEL,
   GRPC_STATS_COUNTER_HTTP2_OP_SEND_INITIAL_METADATA,
@@ -61,6 +65,7 @@ typedef enum {
   GRPC_STATS_COUNTER_HTTP2_WRITES_OFFLOADED,
   GRPC_STATS_COUNTER_HTTP2_WRITES_CONTINUED,
   GRPC_STATS_COUNTER_HTTP2_PARTIAL_WRITES,
+  GRPC_STATS_COUNTER_HTTP2_COALESCED_WRITES,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_START_NEW_STREAM,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_SEND_MESSAGE,
@@ -122,9 +127,22 @@ typedef enum {
   GRPC_STATS_COUNTER_EXECUTOR_PUSH_RETRIES,
   GRPC_STATS_COUNTER_SERVER_REQUESTED_CALLS,
   GRPC_STATS_COUNTER_SERVER_SLOWPATH_REQUESTS_QUEUED,
+  GRPC_STATS_COUNTER_SERVER_QOS_CALLS_SHED,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_FAILURES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_SUCCESSES,
   GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES,
+  GRPC_STATS_COUNTER_XDS_COALESCED_UPDATES,
+  GRPC_STATS_COUNTER_SSL_SESSION_CACHE_HITS,
+  GRPC_STATS_COUNTER_SSL_SESSION_CACHE_MISSES,
+  GRPC_STATS_COUNTER_SSL_SESSION_CACHE_EVICTIONS,
+  GRPC_STATS_COUNTER_SSL_CLIENT_FULL_HANDSHAKES,
+  GRPC_STATS_COUNTER_SSL_CLIENT_RESUMED_HANDSHAKES,
+  GRPC_STATS_COUNTER_SSL_SERVER_FULL_HANDSHAKES,
+  GRPC_STATS_COUNTER_SSL_SERVER_RESUMED_HANDSHAKES,
+  GRPC_STATS_COUNTER_WORK_SERIALIZER_RUN_INLINE,
+  GRPC_STATS_COUNTER_WORK_SERIALIZER_RUN_QUEUED,
+  GRPC_STATS_COUNTER_SYNC_SERVER_POLLERS_GROWN,
+  GRPC_STATS_COUNTER_SYNC_SERVER_POLLERS_SHRUNK,
   GRPC_STATS_COUNTER_COUNT
 } grpc_stats_counters;
 extern const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT];
@@ -143,6 +161,17 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
+  GRPC_STATS_HISTOGRAM_BUSY_POLL_SPIN_MICROS,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_COALESCING_DELAY_MICROS,
+  GRPC_STATS_HISTOGRAM_LB_PICK_LATENCY_MICROS,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_QUEUE_MICROS,
+  GRPC_STATS_HISTOGRAM_POLLSET_WAKEUP_MICROS,
+  GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DELAY_MICROS,
+  GRPC_STATS_HISTOGRAM_TIMER_LATENESS_MILLIS,
+  GRPC_STATS_HISTOGRAM_POLLER_FLUSH_CLOSURES,
+  GRPC_STATS_HISTOGRAM_POLLER_FLUSH_MICROS,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_DEPTH,
+  GRPC_STATS_HISTOGRAM_COMBINER_RUN_MICROS,
   GRPC_STATS_HISTOGRAM_COUNT
 } grpc_stats_histograms;
 extern const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT];
@@ -174,7 +203,29 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_BUCKETS = 64,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 832,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_BUCKETS = 8,
-  GRPC_STATS_HISTOGRAM_BUCKETS = 840
+  GRPC_STATS_HISTOGRAM_BUSY_POLL_SPIN_MICROS_FIRST_SLOT = 840,
+  GRPC_STATS_HISTOGRAM_BUSY_POLL_SPIN_MICROS_BUCKETS = 32,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_COALESCING_DELAY_MICROS_FIRST_SLOT = 872,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_COALESCING_DELAY_MICROS_BUCKETS = 32,
+  GRPC_STATS_HISTOGRAM_LB_PICK_LATENCY_MICROS_FIRST_SLOT = 904,
+  GRPC_STATS_HISTOGRAM_LB_PICK_LATENCY_MICROS_BUCKETS = 131,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_QUEUE_MICROS_FIRST_SLOT = 1035,
+  GRPC_STATS_HISTOGRAM_HTTP2_WRITE_QUEUE_MICROS_BUCKETS = 131,
+  GRPC_STATS_HISTOGRAM_POLLSET_WAKEUP_MICROS_FIRST_SLOT = 1166,
+  GRPC_STATS_HISTOGRAM_POLLSET_WAKEUP_MICROS_BUCKETS = 131,
+  GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DELAY_MICROS_FIRST_SLOT = 1297,
+  GRPC_STATS_HISTOGRAM_EXECUTOR_QUEUE_DELAY_MICROS_BUCKETS = 131,
+  GRPC_STATS_HISTOGRAM_TIMER_LATENESS_MILLIS_FIRST_SLOT = 1428,
+  GRPC_STATS_HISTOGRAM_TIMER_LATENESS_MILLIS_BUCKETS = 83,
+  GRPC_STATS_HISTOGRAM_POLLER_FLUSH_CLOSURES_FIRST_SLOT = 1511,
+  GRPC_STATS_HISTOGRAM_POLLER_FLUSH_CLOSURES_BUCKETS = 83,
+  GRPC_STATS_HISTOGRAM_POLLER_FLUSH_MICROS_FIRST_SLOT = 1594,
+  GRPC_STATS_HISTOGRAM_POLLER_FLUSH_MICROS_BUCKETS = 131,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_DEPTH_FIRST_SLOT = 1725,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_QUEUE_DEPTH_BUCKETS = 32,
+  GRPC_STATS_HISTOGRAM_COMBINER_RUN_MICROS_FIRST_SLOT = 1757,
+  GRPC_STATS_HISTOGRAM_COMBINER_RUN_MICROS_BUCKETS = 131,
+  GRPC_STATS_HISTOGRAM_BUCKETS = 1888
 } grpc_stats_histogram_constants;
 #if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED() \
@@ -205,6 +256,10 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_KICK_WAKEUP_CV)
 #define GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_POLLSET_KICK_OWN_THREAD)
+#define GRPC_STATS_INC_BUSY_POLL_HITS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_BUSY_POLL_HITS)
+#define GRPC_STATS_INC_BUSY_POLL_MISSES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_BUSY_POLL_MISSES)
 #define GRPC_STATS_INC_HISTOGRAM_SLOW_LOOKUPS() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HISTOGRAM_SLOW_LOOKUPS)
 #define GRPC_STATS_INC_SYSCALL_WRITE() \
@@ -215,6 +270,10 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_BACKUP_POLLERS_CREATED)
 #define GRPC_STATS_INC_TCP_BACKUP_POLLER_POLLS() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_BACKUP_POLLER_POLLS)
+#define GRPC_STATS_INC_TCP_ZEROCOPY_READ_ATTEMPTS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_ZEROCOPY_READ_ATTEMPTS)
+#define GRPC_STATS_INC_TCP_ZEROCOPY_READS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_ZEROCOPY_READS)
 #define GRPC_STATS_INC_HTTP2_OP_BATCHES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_OP_BATCHES)
 #define GRPC_STATS_INC_HTTP2_OP_CANCEL() \
@@ -243,6 +302,8 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_WRITES_CONTINUED)
 #define GRPC_STATS_INC_HTTP2_PARTIAL_WRITES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_PARTIAL_WRITES)
+#define GRPC_STATS_INC_HTTP2_COALESCED_WRITES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_COALESCED_WRITES)
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE() \
   GRPC_STATS_INC_COUNTER(                                          \
       GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE)
@@ -388,12 +449,38 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_REQUESTED_CALLS)
 #define GRPC_STATS_INC_SERVER_SLOWPATH_REQUESTS_QUEUED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_SLOWPATH_REQUESTS_QUEUED)
+#define GRPC_STATS_INC_SERVER_QOS_CALLS_SHED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_QOS_CALLS_SHED)
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_FAILURES)
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRYLOCK_SUCCESSES)
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES)
+#define GRPC_STATS_INC_XDS_COALESCED_UPDATES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_XDS_COALESCED_UPDATES)
+#define GRPC_STATS_INC_SSL_SESSION_CACHE_HITS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SSL_SESSION_CACHE_HITS)
+#define GRPC_STATS_INC_SSL_SESSION_CACHE_MISSES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SSL_SESSION_CACHE_MISSES)
+#define GRPC_STATS_INC_SSL_SESSION_CACHE_EVICTIONS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SSL_SESSION_CACHE_EVICTIONS)
+#define GRPC_STATS_INC_SSL_CLIENT_FULL_HANDSHAKES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SSL_CLIENT_FULL_HANDSHAKES)
+#define GRPC_STATS_INC_SSL_CLIENT_RESUMED_HANDSHAKES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SSL_CLIENT_RESUMED_HANDSHAKES)
+#define GRPC_STATS_INC_SSL_SERVER_FULL_HANDSHAKES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SSL_SERVER_FULL_HANDSHAKES)
+#define GRPC_STATS_INC_SSL_SERVER_RESUMED_HANDSHAKES() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SSL_SERVER_RESUMED_HANDSHAKES)
+#define GRPC_STATS_INC_WORK_SERIALIZER_RUN_INLINE() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_WORK_SERIALIZER_RUN_INLINE)
+#define GRPC_STATS_INC_WORK_SERIALIZER_RUN_QUEUED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_WORK_SERIALIZER_RUN_QUEUED)
+#define GRPC_STATS_INC_SYNC_SERVER_POLLERS_GROWN() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SYNC_SERVER_POLLERS_GROWN)
+#define GRPC_STATS_INC_SYNC_SERVER_POLLERS_SHRUNK() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SYNC_SERVER_POLLERS_SHRUNK)
 #define GRPC_STATS_INC_CALL_INITIAL_SIZE(value) \
   grpc_stats_inc_call_initial_size((int)(value))
 void grpc_stats_inc_call_initial_size(int x);
@@ -433,6 +520,39 @@ void grpc_stats_inc_http2_send_flowctl_per_write(int x);
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value) \
   grpc_stats_inc_server_cqs_checked((int)(value))
 void grpc_stats_inc_server_cqs_checked(int x);
+#define GRPC_STATS_INC_BUSY_POLL_SPIN_MICROS(value) \
+  grpc_stats_inc_busy_poll_spin_micros((int)(value))
+void grpc_stats_inc_busy_poll_spin_micros(int x);
+#define GRPC_STATS_INC_HTTP2_WRITE_COALESCING_DELAY_MICROS(value) \
+  grpc_stats_inc_http2_write_coalescing_delay_micros((int)(value))
+void grpc_stats_inc_http2_write_coalescing_delay_micros(int x);
+#define GRPC_STATS_INC_LB_PICK_LATENCY_MICROS(value) \
+  grpc_stats_inc_lb_pick_latency_micros((int)(value))
+void grpc_stats_inc_lb_pick_latency_micros(int x);
+#define GRPC_STATS_INC_HTTP2_WRITE_QUEUE_MICROS(value) \
+  grpc_stats_inc_http2_write_queue_micros((int)(value))
+void grpc_stats_inc_http2_write_queue_micros(int x);
+#define GRPC_STATS_INC_POLLSET_WAKEUP_MICROS(value) \
+  grpc_stats_inc_pollset_wakeup_micros((int)(value))
+void grpc_stats_inc_pollset_wakeup_micros(int x);
+#define GRPC_STATS_INC_EXECUTOR_QUEUE_DELAY_MICROS(value) \
+  grpc_stats_inc_executor_queue_delay_micros((int)(value))
+void grpc_stats_inc_executor_queue_delay_micros(int x);
+#define GRPC_STATS_INC_TIMER_LATENESS_MILLIS(value) \
+  grpc_stats_inc_timer_lateness_millis((int)(value))
+void grpc_stats_inc_timer_lateness_millis(int x);
+#define GRPC_STATS_INC_POLLER_FLUSH_CLOSURES(value) \
+  grpc_stats_inc_poller_flush_closures((int)(value))
+void grpc_stats_inc_poller_flush_closures(int x);
+#define GRPC_STATS_INC_POLLER_FLUSH_MICROS(value) \
+  grpc_stats_inc_poller_flush_micros((int)(value))
+void grpc_stats_inc_poller_flush_micros(int x);
+#define GRPC_STATS_INC_WORK_SERIALIZER_QUEUE_DEPTH(value) \
+  grpc_stats_inc_work_serializer_queue_depth((int)(value))
+void grpc_stats_inc_work_serializer_queue_depth(int x);
+#define GRPC_STATS_INC_COMBINER_RUN_MICROS(value) \
+  grpc_stats_inc_combiner_run_micros((int)(value))
+void grpc_stats_inc_combiner_run_micros(int x);
 #else
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED()
 #define GRPC_STATS_INC_SERVER_CALLS_CREATED()
@@ -448,11 +568,15 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_POLLSET_KICK_WAKEUP_FD()
 #define GRPC_STATS_INC_POLLSET_KICK_WAKEUP_CV()
 #define GRPC_STATS_INC_POLLSET_KICK_OWN_THREAD()
+#define GRPC_STATS_INC_BUSY_POLL_HITS()
+#define GRPC_STATS_INC_BUSY_POLL_MISSES()
 #define GRPC_STATS_INC_HISTOGRAM_SLOW_LOOKUPS()
 #define GRPC_STATS_INC_SYSCALL_WRITE()
 #define GRPC_STATS_INC_SYSCALL_READ()
 #define GRPC_STATS_INC_TCP_BACKUP_POLLERS_CREATED()
 #define GRPC_STATS_INC_TCP_BACKUP_POLLER_POLLS()
+#define GRPC_STATS_INC_TCP_ZEROCOPY_READ_ATTEMPTS()
+#define GRPC_STATS_INC_TCP_ZEROCOPY_READS()
 #define GRPC_STATS_INC_HTTP2_OP_BATCHES()
 #define GRPC_STATS_INC_HTTP2_OP_CANCEL()
 #define GRPC_STATS_INC_HTTP2_OP_SEND_INITIAL_METADATA()
@@ -467,6 +591,7 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HTTP2_WRITES_OFFLOADED()
 #define GRPC_STATS_INC_HTTP2_WRITES_CONTINUED()
 #define GRPC_STATS_INC_HTTP2_PARTIAL_WRITES()
+#define GRPC_STATS_INC_HTTP2_COALESCED_WRITES()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_START_NEW_STREAM()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_SEND_MESSAGE()
@@ -528,9 +653,22 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_EXECUTOR_PUSH_RETRIES()
 #define GRPC_STATS_INC_SERVER_REQUESTED_CALLS()
 #define GRPC_STATS_INC_SERVER_SLOWPATH_REQUESTS_QUEUED()
+#define GRPC_STATS_INC_SERVER_QOS_CALLS_SHED()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES()
 #define GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES()
+#define GRPC_STATS_INC_XDS_COALESCED_UPDATES()
+#define GRPC_STATS_INC_SSL_SESSION_CACHE_HITS()
+#define GRPC_STATS_INC_SSL_SESSION_CACHE_MISSES()
+#define GRPC_STATS_INC_SSL_SESSION_CACHE_EVICTIONS()
+#define GRPC_STATS_INC_SSL_CLIENT_FULL_HANDSHAKES()
+#define GRPC_STATS_INC_SSL_CLIENT_RESUMED_HANDSHAKES()
+#define GRPC_STATS_INC_SSL_SERVER_FULL_HANDSHAKES()
+#define GRPC_STATS_INC_SSL_SERVER_RESUMED_HANDSHAKES()
+#define GRPC_STATS_INC_WORK_SERIALIZER_RUN_INLINE()
+#define GRPC_STATS_INC_WORK_SERIALIZER_RUN_QUEUED()
+#define GRPC_STATS_INC_SYNC_SERVER_POLLERS_GROWN()
+#define GRPC_STATS_INC_SYNC_SERVER_POLLERS_SHRUNK()
 #define GRPC_STATS_INC_CALL_INITIAL_SIZE(value)
 #define GRPC_STATS_INC_POLL_EVENTS_RETURNED(value)
 #define GRPC_STATS_INC_TCP_WRITE_SIZE(value)
@@ -544,10 +682,21 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HTTP2_SEND_TRAILING_METADATA_PER_WRITE(value)
 #define GRPC_STATS_INC_HTTP2_SEND_FLOWCTL_PER_WRITE(value)
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value)
+#define GRPC_STATS_INC_BUSY_POLL_SPIN_MICROS(value)
+#define GRPC_STATS_INC_HTTP2_WRITE_COALESCING_DELAY_MICROS(value)
+#define GRPC_STATS_INC_LB_PICK_LATENCY_MICROS(value)
+#define GRPC_STATS_INC_HTTP2_WRITE_QUEUE_MICROS(value)
+#define GRPC_STATS_INC_POLLSET_WAKEUP_MICROS(value)
+#define GRPC_STATS_INC_EXECUTOR_QUEUE_DELAY_MICROS(value)
+#define GRPC_STATS_INC_TIMER_LATENESS_MILLIS(value)
+#define GRPC_STATS_INC_POLLER_FLUSH_CLOSURES(value)
+#define GRPC_STATS_INC_POLLER_FLUSH_MICROS(value)
+#define GRPC_STATS_INC_WORK_SERIALIZER_QUEUE_DEPTH(value)
+#define GRPC_STATS_INC_COMBINER_RUN_MICROS(value)
 #endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
-extern const int grpc_stats_histo_buckets[13];
-extern const int grpc_stats_histo_start[13];
-extern const int* const grpc_stats_histo_bucket_boundaries[13];
-extern void (*const grpc_stats_inc_histogram[13])(int x);
+extern const int grpc_stats_histo_buckets[24];
+extern const int grpc_stats_histo_start[24];
+extern const int* const grpc_stats_histo_bucket_boundaries[24];
+extern void (*const grpc_stats_inc_histogram[24])(int x);
 
 #endif /* GRPC_CORE_LIB_DEBUG_STATS_DATA_H */
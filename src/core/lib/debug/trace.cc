@@ -22,17 +22,33 @@
 
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
 #include <type_traits>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
 
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/thd_id.h>
+
+#include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/time_precise.h"
 
 GPR_GLOBAL_CONFIG_DEFINE_STRING(
     grpc_trace, "",
     "A comma separated list of tracers that provide additional insight into "
     "how gRPC C core is processing requests via debug logs.");
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_trace_ring_size, 1024,
+    "Number of events the binary trace ring keeps per cpu, rounded up to a "
+    "power of two. Set to 0 to disable the trace ring.");
+
 int grpc_tracer_set_enabled(const char* name, int enabled);
 
 namespace grpc_core {
@@ -91,6 +107,116 @@ TraceFlag::TraceFlag(bool default_enabled, const char* name) : name_(name) {
   TraceFlagList::Add(this);
 }
 
+//
+// TraceRing
+//
+
+namespace {
+
+// Written with a seqlock, so that Dump() can skip records that are being
+// overwritten while it reads them.
+struct TraceRecord {
+  // Position of the record in its ring plus one; 0 while being written.
+  std::atomic<uint64_t> seq{0};
+  std::atomic<gpr_cycle_counter> cycle{0};
+  std::atomic<gpr_thd_id> thread{0};
+  std::atomic<const TraceFlag*> tracer{nullptr};
+  std::atomic<const char*> event{nullptr};
+  std::atomic<intptr_t> args[3] = {};
+};
+
+struct CpuTraceRing {
+  std::atomic<uint64_t> next{0};
+  TraceRecord* records = nullptr;
+};
+
+size_t g_trace_ring_mask;
+size_t g_num_trace_rings;
+CpuTraceRing* g_trace_rings;  // nullptr if disabled
+gpr_once g_trace_rings_once = GPR_ONCE_INIT;
+
+void InitTraceRings() {
+  int32_t size = GPR_GLOBAL_CONFIG_GET(grpc_trace_ring_size);
+  if (size <= 0) return;
+  size_t ring_size = 1;
+  while (ring_size < static_cast<size_t>(size)) ring_size <<= 1;
+  g_trace_ring_mask = ring_size - 1;
+  g_num_trace_rings = gpr_cpu_num_cores();
+  g_trace_rings = new CpuTraceRing[g_num_trace_rings];
+  for (size_t i = 0; i < g_num_trace_rings; ++i) {
+    g_trace_rings[i].records = new TraceRecord[ring_size];
+  }
+}
+
+}  // namespace
+
+void TraceRing::Record(const TraceFlag* tracer, const char* event,
+                       intptr_t arg0, intptr_t arg1, intptr_t arg2) {
+  gpr_once_init(&g_trace_rings_once, InitTraceRings);
+  if (g_trace_rings == nullptr) return;
+  CpuTraceRing& ring =
+      g_trace_rings[gpr_cpu_current_cpu() % g_num_trace_rings];
+  uint64_t seq = ring.next.fetch_add(1, std::memory_order_relaxed) + 1;
+  TraceRecord& record = ring.records[seq & g_trace_ring_mask];
+  record.seq.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  record.cycle.store(gpr_get_cycle_counter(), std::memory_order_relaxed);
+  record.thread.store(gpr_thd_currentid(), std::memory_order_relaxed);
+  record.tracer.store(tracer, std::memory_order_relaxed);
+  record.event.store(event, std::memory_order_relaxed);
+  record.args[0].store(arg0, std::memory_order_relaxed);
+  record.args[1].store(arg1, std::memory_order_relaxed);
+  record.args[2].store(arg2, std::memory_order_relaxed);
+  record.seq.store(seq, std::memory_order_release);
+}
+
+std::string TraceRing::Dump() {
+  gpr_once_init(&g_trace_rings_once, InitTraceRings);
+  if (g_trace_rings == nullptr) return "";
+  struct Event {
+    gpr_cycle_counter cycle;
+    size_t cpu;
+    gpr_thd_id thread;
+    const TraceFlag* tracer;
+    const char* event;
+    intptr_t args[3];
+  };
+  std::vector<Event> events;
+  for (size_t cpu = 0; cpu < g_num_trace_rings; ++cpu) {
+    const CpuTraceRing& ring = g_trace_rings[cpu];
+    for (size_t i = 0; i <= g_trace_ring_mask; ++i) {
+      const TraceRecord& record = ring.records[i];
+      uint64_t seq = record.seq.load(std::memory_order_acquire);
+      if (seq == 0) continue;
+      Event event;
+      event.cycle = record.cycle.load(std::memory_order_relaxed);
+      event.cpu = cpu;
+      event.thread = record.thread.load(std::memory_order_relaxed);
+      event.tracer = record.tracer.load(std::memory_order_relaxed);
+      event.event = record.event.load(std::memory_order_relaxed);
+      for (size_t j = 0; j < 3; ++j) {
+        event.args[j] = record.args[j].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (record.seq.load(std::memory_order_relaxed) != seq) continue;
+      events.push_back(event);
+    }
+  }
+  std::sort(events.begin(), events.end(),
+            [](const Event& a, const Event& b) { return a.cycle < b.cycle; });
+  std::string out;
+  for (const Event& event : events) {
+    absl::StrAppend(
+        &out,
+        gpr_format_timespec(gpr_convert_clock_type(
+            gpr_cycle_counter_to_time(event.cycle), GPR_CLOCK_REALTIME)),
+        " cpu=", event.cpu, " thread=", event.thread, " ",
+        event.tracer->name(), " ", event.event, " ", event.args[0], " ",
+        event.args[1], " ", event.args[2], "\n");
+  }
+  return out;
+}
+
 }  // namespace grpc_core
 
 static void add(const char* beg, const char* end, char*** ss, size_t* ns) {
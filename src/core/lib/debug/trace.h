@@ -22,6 +22,9 @@
 #include <grpc/support/port_platform.h>
 
 #include <stdbool.h>
+#include <stdint.h>
+
+#include <string>
 
 #include <grpc/support/atm.h>
 
@@ -127,6 +130,25 @@ class DebugOnlyTraceFlag {
 };
 #endif
 
+// Always-on binary trace ring.
+//
+// Record() appends a fixed-size record (cycle counter, cpu, thread, tracer,
+// event name and up to three integer arguments) to a per-cpu ring buffer,
+// whether or not the tracer is enabled. Nothing is formatted on the hot path,
+// so trace points can stay on in production and the last
+// GRPC_TRACE_RING_SIZE events of each cpu can be examined after the fact with
+// Dump().
+class TraceRing {
+ public:
+  // \a event must be a string literal, since only its address is kept.
+  static void Record(const TraceFlag* tracer, const char* event,
+                     intptr_t arg0 = 0, intptr_t arg1 = 0, intptr_t arg2 = 0);
+
+  // Renders the buffered events of all cpus, oldest first, one per line.
+  // Events recorded while dumping may be left out.
+  static std::string Dump();
+};
+
 }  // namespace grpc_core
 
 #endif /* GRPC_CORE_LIB_DEBUG_TRACE_H */
@@ -0,0 +1,196 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/caching_dns_resolver.h"
+
+#include <stdint.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/types/optional.h"
+
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/resolver/dns_cache.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+namespace {
+
+using LookupTaskHandle = EventEngine::DNSResolver::LookupTaskHandle;
+
+template <typename T>
+grpc_core::DnsCache<T>* SharedDnsCache() {
+  static grpc_core::DnsCache<T>* cache = new grpc_core::DnsCache<T>();
+  return cache;
+}
+
+// A lookup started through the cache, cancelled when orphaned.
+class ResolverLookup : public grpc_core::Orphanable {
+ public:
+  explicit ResolverLookup(std::shared_ptr<EventEngine::DNSResolver> resolver)
+      : resolver_(std::move(resolver)) {}
+
+  void set_handle(LookupTaskHandle handle) { handle_ = handle; }
+
+  void Orphan() override {
+    resolver_->CancelLookup(handle_);
+    delete this;
+  }
+
+ private:
+  const std::shared_ptr<EventEngine::DNSResolver> resolver_;
+  LookupTaskHandle handle_ = {0, 0};
+};
+
+}  // namespace
+
+struct CachingDNSResolver::State {
+  grpc_core::Mutex mu;
+  intptr_t next_id ABSL_GUARDED_BY(mu) = 1;
+  // The lookups waiting for the cache, with how to cancel them.
+  std::map<intptr_t, std::function<bool()>> pending ABSL_GUARDED_BY(mu);
+
+  // Returns false if the lookup is done, or is about to be.
+  bool Remove(intptr_t id) {
+    grpc_core::MutexLock lock(&mu);
+    return pending.erase(id) != 0;
+  }
+};
+
+CachingDNSResolver::CachingDNSResolver(
+    EventEngine* engine, std::shared_ptr<EventEngine::DNSResolver> resolver,
+    std::string dns_server, grpc_core::Duration ttl)
+    : engine_(engine),
+      resolver_(std::move(resolver)),
+      dns_server_(std::move(dns_server)),
+      ttl_(ttl),
+      state_(std::make_shared<State>()) {}
+
+CachingDNSResolver::~CachingDNSResolver() {
+  std::map<intptr_t, std::function<bool()>> pending;
+  {
+    grpc_core::MutexLock lock(&state_->mu);
+    pending = std::move(state_->pending);
+  }
+  for (auto& p : pending) p.second();
+}
+
+template <typename T>
+LookupTaskHandle CachingDNSResolver::Lookup(
+    std::string key, std::function<void(absl::StatusOr<T>)> on_resolve,
+    std::function<LookupTaskHandle(EventEngine::DNSResolver*,
+                                   std::function<void(absl::StatusOr<T>)>)>
+        start) {
+  grpc_core::DnsCache<T>* cache = SharedDnsCache<T>();
+  // Set by the cache before it can invoke the callback.
+  auto waiter_id = std::make_shared<intptr_t>(0);
+  intptr_t id;
+  {
+    grpc_core::MutexLock lock(&state_->mu);
+    id = state_->next_id++;
+    state_->pending.emplace(id, [cache, key, waiter_id]() {
+      return cache->Cancel(key, *waiter_id);
+    });
+  }
+  auto start_lookup =
+      [resolver = resolver_, ttl = ttl_, start = std::move(start)](
+          typename grpc_core::DnsCache<T>::OnLookupDone on_done) {
+        auto* lookup = new ResolverLookup(resolver);
+        lookup->set_handle(start(
+            resolver.get(), [on_done, ttl](absl::StatusOr<T> result) {
+              on_done(std::move(result), ttl);
+            }));
+        return grpc_core::OrphanablePtr<grpc_core::Orphanable>(lookup);
+      };
+  absl::optional<T> cached = cache->Lookup(
+      key, start_lookup,
+      [state = state_, id, on_resolve](absl::StatusOr<T> result) {
+        state->Remove(id);
+        on_resolve(std::move(result));
+      },
+      waiter_id.get());
+  if (cached.has_value()) {
+    state_->Remove(id);
+    engine_->Run([on_resolve = std::move(on_resolve),
+                  value = std::move(*cached)]() mutable {
+      on_resolve(std::move(value));
+    });
+  }
+  return {id, 0};
+}
+
+LookupTaskHandle CachingDNSResolver::LookupHostname(
+    LookupHostnameCallback on_resolve, absl::string_view name,
+    absl::string_view default_port, absl::Time deadline) {
+  using Addresses = std::vector<EventEngine::ResolvedAddress>;
+  std::string name_str(name);
+  std::string default_port_str(default_port);
+  return Lookup<Addresses>(
+      absl::StrCat(dns_server_, "|", name, "|", default_port, "|A,AAAA"),
+      std::move(on_resolve),
+      [name_str, default_port_str, deadline](
+          EventEngine::DNSResolver* resolver,
+          std::function<void(absl::StatusOr<Addresses>)> on_done) {
+        return resolver->LookupHostname(std::move(on_done), name_str,
+                                        default_port_str, deadline);
+      });
+}
+
+LookupTaskHandle CachingDNSResolver::LookupSRV(LookupSRVCallback on_resolve,
+                                               absl::string_view name,
+                                               absl::Time deadline) {
+  using Records = std::vector<SRVRecord>;
+  std::string name_str(name);
+  return Lookup<Records>(
+      absl::StrCat(dns_server_, "|", name, "|SRV"), std::move(on_resolve),
+      [name_str, deadline](
+          EventEngine::DNSResolver* resolver,
+          std::function<void(absl::StatusOr<Records>)> on_done) {
+        return resolver->LookupSRV(std::move(on_done), name_str, deadline);
+      });
+}
+
+LookupTaskHandle CachingDNSResolver::LookupTXT(LookupTXTCallback on_resolve,
+                                               absl::string_view name,
+                                               absl::Time deadline) {
+  std::string name_str(name);
+  return Lookup<std::string>(
+      absl::StrCat(dns_server_, "|", name, "|TXT"), std::move(on_resolve),
+      [name_str, deadline](
+          EventEngine::DNSResolver* resolver,
+          std::function<void(absl::StatusOr<std::string>)> on_done) {
+        return resolver->LookupTXT(std::move(on_done), name_str, deadline);
+      });
+}
+
+bool CachingDNSResolver::CancelLookup(LookupTaskHandle handle) {
+  std::function<bool()> cancel;
+  {
+    grpc_core::MutexLock lock(&state_->mu);
+    auto it = state_->pending.find(handle.keys[0]);
+    if (it == state_->pending.end()) return false;
+    cancel = std::move(it->second);
+    state_->pending.erase(it);
+  }
+  return cancel();
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
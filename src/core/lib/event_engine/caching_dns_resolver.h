@@ -0,0 +1,84 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_CACHING_DNS_RESOLVER_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_CACHING_DNS_RESOLVER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/gprpp/time.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+// A DNSResolver that sends its lookups through the process-wide DnsCaches
+// shared by all of the CachingDNSResolvers, so that concurrent lookups of the
+// same name by different channels are merged and their results reused.
+//
+// The EventEngine resolvers do not report the TTLs of the records, so results
+// are kept for a fixed \a ttl. A merged lookup runs on the resolver of, and
+// with the deadline of, the first caller. Cache hits are delivered through
+// \a engine, which must outlive the resolver.
+class CachingDNSResolver final : public EventEngine::DNSResolver {
+ public:
+  CachingDNSResolver(
+      EventEngine* engine, std::shared_ptr<EventEngine::DNSResolver> resolver,
+      std::string dns_server,
+      grpc_core::Duration ttl = grpc_core::Duration::Seconds(30));
+  // Cancels the lookups that have not completed yet.
+  ~CachingDNSResolver() override;
+
+  LookupTaskHandle LookupHostname(LookupHostnameCallback on_resolve,
+                                  absl::string_view name,
+                                  absl::string_view default_port,
+                                  absl::Time deadline) override;
+  LookupTaskHandle LookupSRV(LookupSRVCallback on_resolve,
+                             absl::string_view name,
+                             absl::Time deadline) override;
+  LookupTaskHandle LookupTXT(LookupTXTCallback on_resolve,
+                             absl::string_view name,
+                             absl::Time deadline) override;
+  bool CancelLookup(LookupTaskHandle handle) override;
+
+ private:
+  struct State;
+
+  template <typename T>
+  LookupTaskHandle Lookup(
+      std::string key, std::function<void(absl::StatusOr<T>)> on_resolve,
+      std::function<LookupTaskHandle(EventEngine::DNSResolver*,
+                                     std::function<void(absl::StatusOr<T>)>)>
+          start);
+
+  EventEngine* const engine_;
+  const std::shared_ptr<EventEngine::DNSResolver> resolver_;
+  const std::string dns_server_;
+  const grpc_core::Duration ttl_;
+  // Shared with the callbacks of the pending lookups.
+  const std::shared_ptr<State> state_;
+};
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_CACHING_DNS_RESOLVER_H
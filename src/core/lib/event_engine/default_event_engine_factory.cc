@@ -18,13 +18,24 @@
 #include <grpc/event_engine/event_engine.h>
 
 #include "src/core/lib/event_engine/event_engine_factory.h"
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_LINUX_EPOLL
+#include "absl/memory/memory.h"
+
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
+#endif
 
 namespace grpc_event_engine {
 namespace experimental {
 
 std::unique_ptr<EventEngine> DefaultEventEngineFactory() {
+#ifdef GRPC_LINUX_EPOLL
+  return absl::make_unique<PosixEventEngine>();
+#else
   // TODO(hork): call LibuvEventEngineFactory
   return nullptr;
+#endif
 }
 
 }  // namespace experimental
@@ -25,8 +25,21 @@
 #include <grpc/event_engine/memory_request.h>
 #include <grpc/slice.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/slice/slice_refcount_base.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_slice_slab, false,
+    "If set, on Linux, slices made by memory allocators come from huge page "
+    "backed slabs instead of malloc.");
+
+#ifdef GPR_LINUX
+#define GRPC_SLICE_SLAB
+#include <sys/mman.h>
+
+#include "src/core/lib/gprpp/sync.h"
+#endif
+
 namespace grpc_event_engine {
 namespace experimental {
 
@@ -36,11 +49,13 @@ namespace {
 // Takes care of releasing memory back when the slice is destroyed.
 class SliceRefCount : public grpc_slice_refcount {
  public:
+  // free_storage is called with this object's storage once it is destroyed.
   SliceRefCount(std::shared_ptr<internal::MemoryAllocatorImpl> allocator,
-                size_t size)
+                size_t size, void (*free_storage)(void*) = free)
       : grpc_slice_refcount(Destroy),
         allocator_(std::move(allocator)),
-        size_(size) {
+        size_(size),
+        free_storage_(free_storage) {
     // Nothing to do here.
   }
   ~SliceRefCount() { allocator_->Release(size_); }
@@ -48,20 +63,217 @@ class SliceRefCount : public grpc_slice_refcount {
  private:
   static void Destroy(grpc_slice_refcount* p) {
     auto* rc = static_cast<SliceRefCount*>(p);
+    auto free_storage = rc->free_storage_;
     rc->~SliceRefCount();
-    free(rc);
+    free_storage(rc);
   }
 
   std::shared_ptr<internal::MemoryAllocatorImpl> allocator_;
   size_t size_;
+  void (*free_storage_)(void*);
+};
+
+#ifdef GRPC_SLICE_SLAB
+
+// Slab allocator for slice storage: slices are read and staging buffers of
+// endpoints, allocated and freed for every read on every connection, so
+// serving them from malloc fragments the heap and keeps faulting in pages.
+// Instead blocks of a few power of two size classes are carved out of 2MB
+// regions, each aligned to its size so that it can be backed by a transparent
+// huge page and so that a block finds its region header by masking its address.
+// A region is unmapped once all of its blocks are free, except for one kept
+// per size class to absorb churn.
+// Resource quotas are only charged for the blocks handed out, not for the
+// regions: up to kMaxRegionsPerSizeClass of them per size class are mapped
+// outside of any quota, which is why the slab is opt-in through the
+// GRPC_SLICE_SLAB environment variable.
+class SliceSlab {
+ public:
+  static constexpr size_t kRegionSize = 2 * 1024 * 1024;
+  static constexpr size_t kMinClassSizeLog2 = 12;
+  static constexpr size_t kMaxClassSizeLog2 = 16;
+  static constexpr size_t kNumSizeClasses =
+      kMaxClassSizeLog2 - kMinClassSizeLog2 + 1;
+  // Beyond this many regions per size class, slices come from malloc again.
+  static constexpr size_t kMaxRegionsPerSizeClass = 64;
+
+  static bool Enabled() {
+    static const bool enabled = GPR_GLOBAL_CONFIG_GET(grpc_slice_slab);
+    return enabled;
+  }
+
+  static SliceSlab* Get() {
+    static SliceSlab* slab = new SliceSlab();
+    return slab;
+  }
+
+  static size_t ClassSize(size_t size_class) {
+    return size_t{1} << (size_class + kMinClassSizeLog2);
+  }
+
+  // Largest size class that fits within size bytes, or kNumSizeClasses if
+  // there is none.
+  static size_t SizeClassAtMost(size_t size) {
+    if (size < ClassSize(0)) return kNumSizeClasses;
+    size_t size_class = 0;
+    while (size_class + 1 < kNumSizeClasses &&
+           ClassSize(size_class + 1) <= size) {
+      size_class++;
+    }
+    return size_class;
+  }
+
+  // Returns a block of the size class, or nullptr if the slab is out of
+  // regions.
+  void* Alloc(size_t size_class) {
+    SizeClass* sc = &size_classes_[size_class];
+    grpc_core::MutexLock lock(&sc->mu);
+    Region* region = sc->partial;
+    if (region == nullptr) {
+      if (sc->num_regions == kMaxRegionsPerSizeClass) return nullptr;
+      region = NewRegion(size_class);
+      if (region == nullptr) return nullptr;
+      sc->num_regions++;
+      sc->num_empty++;
+      LinkLocked(sc, region);
+    }
+    if (region->in_use++ == 0) sc->num_empty--;
+    void* block;
+    if (region->free_list != nullptr) {
+      block = region->free_list;
+      region->free_list = region->free_list->next;
+    } else {
+      // Carve blocks lazily so that pages are only touched once needed.
+      block = reinterpret_cast<char*>(region) +
+              region->next_unused * ClassSize(size_class);
+      region->next_unused++;
+    }
+    if (region->free_list == nullptr &&
+        region->next_unused == BlocksPerRegion(size_class)) {
+      UnlinkLocked(sc, region);
+    }
+    return block;
+  }
+
+  static void Free(void* block) {
+    Region* region = reinterpret_cast<Region*>(
+        reinterpret_cast<uintptr_t>(block) & ~(kRegionSize - 1));
+    Get()->FreeToRegion(region, block);
+  }
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  // Header stored in the first block of each region.
+  struct Region {
+    size_t size_class;
+    // Links in the size class list of regions with free blocks.
+    Region* prev = nullptr;
+    Region* next = nullptr;
+    bool linked = false;
+    FreeBlock* free_list = nullptr;
+    // Blocks below this index have been handed out at least once.
+    size_t next_unused = 1;
+    size_t in_use = 0;
+  };
+
+  struct SizeClass {
+    grpc_core::Mutex mu;
+    Region* partial ABSL_GUARDED_BY(mu) = nullptr;
+    size_t num_regions ABSL_GUARDED_BY(mu) = 0;
+    size_t num_empty ABSL_GUARDED_BY(mu) = 0;
+  };
+
+  static size_t BlocksPerRegion(size_t size_class) {
+    return kRegionSize / ClassSize(size_class);
+  }
+
+  Region* NewRegion(size_t size_class) {
+    // Over-map to be able to align the region, and trim the excess.
+    char* raw = static_cast<char*>(mmap(nullptr, 2 * kRegionSize,
+                                       PROT_READ | PROT_WRITE,
+                                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (raw == MAP_FAILED) return nullptr;
+    char* aligned = reinterpret_cast<char*>(
+        (reinterpret_cast<uintptr_t>(raw) + kRegionSize - 1) &
+        ~(kRegionSize - 1));
+    if (aligned != raw) munmap(raw, aligned - raw);
+    munmap(aligned + kRegionSize, raw + kRegionSize - aligned);
+#ifdef MADV_HUGEPAGE
+    madvise(aligned, kRegionSize, MADV_HUGEPAGE);
+#endif
+    Region* region = new (aligned) Region;
+    region->size_class = size_class;
+    return region;
+  }
+
+  void FreeToRegion(Region* region, void* block) {
+    SizeClass* sc = &size_classes_[region->size_class];
+    grpc_core::MutexLock lock(&sc->mu);
+    region->free_list = new (block) FreeBlock{region->free_list};
+    if (!region->linked) LinkLocked(sc, region);
+    if (--region->in_use != 0) return;
+    if (sc->num_empty == 0) {
+      sc->num_empty++;
+      return;
+    }
+    UnlinkLocked(sc, region);
+    sc->num_regions--;
+    munmap(region, kRegionSize);
+  }
+
+  static void LinkLocked(SizeClass* sc, Region* region)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(sc->mu) {
+    region->linked = true;
+    region->prev = nullptr;
+    region->next = sc->partial;
+    if (sc->partial != nullptr) sc->partial->prev = region;
+    sc->partial = region;
+  }
+
+  static void UnlinkLocked(SizeClass* sc, Region* region)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(sc->mu) {
+    region->linked = false;
+    if (region->prev != nullptr) {
+      region->prev->next = region->next;
+    } else {
+      sc->partial = region->next;
+    }
+    if (region->next != nullptr) region->next->prev = region->prev;
+  }
+
+  SizeClass size_classes_[kNumSizeClasses];
 };
 
+#endif  // GRPC_SLICE_SLAB
+
 }  // namespace
 
 grpc_slice MemoryAllocator::MakeSlice(MemoryRequest request) {
-  auto size = Reserve(request.Increase(sizeof(SliceRefCount)));
-  void* p = malloc(size);
-  new (p) SliceRefCount(allocator_, size);
+  request = request.Increase(sizeof(SliceRefCount));
+  auto size = Reserve(request);
+  void* p = nullptr;
+#ifdef GRPC_SLICE_SLAB
+  // Round the reservation down to a slab size class, as long as that still
+  // satisfies the request.
+  size_t size_class = SliceSlab::SizeClassAtMost(size);
+  if (SliceSlab::Enabled() && size_class != SliceSlab::kNumSizeClasses &&
+      SliceSlab::ClassSize(size_class) >= request.min()) {
+    p = SliceSlab::Get()->Alloc(size_class);
+  }
+  if (p != nullptr) {
+    size_t block_size = SliceSlab::ClassSize(size_class);
+    if (size > block_size) Release(size - block_size);
+    size = block_size;
+    new (p) SliceRefCount(allocator_, size, SliceSlab::Free);
+  }
+#endif
+  if (p == nullptr) {
+    p = malloc(size);
+    new (p) SliceRefCount(allocator_, size);
+  }
   grpc_slice slice;
   slice.refcount = static_cast<SliceRefCount*>(p);
   slice.data.refcounted.bytes =
@@ -0,0 +1,199 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/event_poller.h"
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_LINUX_EPOLL
+
+#include <errno.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <utility>
+
+#include <grpc/support/log.h>
+
+namespace grpc_event_engine {
+namespace experimental {
+
+namespace {
+constexpr int kMaxEpollEvents = 100;
+}  // namespace
+
+//
+// EventHandle
+//
+
+void EventHandle::NotifyOnRead(std::function<void(absl::Status)> on_ready) {
+  NotifyOn(&read_, std::move(on_ready));
+}
+
+void EventHandle::NotifyOnWrite(std::function<void(absl::Status)> on_ready) {
+  NotifyOn(&write_, std::move(on_ready));
+}
+
+void EventHandle::NotifyOn(Notifier* notifier,
+                           std::function<void(absl::Status)> on_ready) {
+  absl::Status status;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    if (shutdown_status_.ok() && !notifier->ready) {
+      GPR_ASSERT(notifier->on_ready == nullptr);
+      notifier->on_ready = std::move(on_ready);
+      return;
+    }
+    notifier->ready = false;
+    status = shutdown_status_;
+  }
+  poller_->executor_->Add(
+      [on_ready, status]() mutable { on_ready(std::move(status)); });
+}
+
+void EventHandle::SetReady(Notifier* notifier) {
+  std::function<void(absl::Status)> on_ready;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    if (notifier->on_ready == nullptr) {
+      notifier->ready = true;
+      return;
+    }
+    on_ready = std::move(notifier->on_ready);
+    notifier->on_ready = nullptr;
+  }
+  poller_->executor_->Add([on_ready]() { on_ready(absl::OkStatus()); });
+}
+
+void EventHandle::ShutdownHandle(absl::Status why) {
+  GPR_ASSERT(!why.ok());
+  std::function<void(absl::Status)> pending[2];
+  {
+    grpc_core::MutexLock lock(&mu_);
+    if (!shutdown_status_.ok()) return;
+    shutdown_status_ = why;
+    pending[0] = std::move(read_.on_ready);
+    read_.on_ready = nullptr;
+    pending[1] = std::move(write_.on_ready);
+    write_.on_ready = nullptr;
+  }
+  shutdown(fd_, SHUT_RDWR);
+  for (auto& on_ready : pending) {
+    if (on_ready != nullptr) {
+      poller_->executor_->Add([on_ready, why]() { on_ready(why); });
+    }
+  }
+}
+
+void EventHandle::OrphanHandle() {
+  ShutdownHandle(absl::CancelledError("Handle orphaned"));
+  poller_->Orphan(this);
+}
+
+//
+// EpollPoller
+//
+
+EpollPoller::EpollPoller(ThreadPool* executor) : executor_(executor) {
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  GPR_ASSERT(epoll_fd_ >= 0);
+  wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  GPR_ASSERT(wakeup_fd_ >= 0);
+  struct epoll_event ev;
+  ev.events = EPOLLIN;
+  // The wakeup fd is the only one registered without a handle.
+  ev.data.ptr = nullptr;
+  GPR_ASSERT(epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &ev) == 0);
+  thd_ = grpc_core::Thread("event_engine_poller", &EpollPoller::ThreadMain,
+                           this);
+  thd_.Start();
+}
+
+EpollPoller::~EpollPoller() {
+  shutdown_.store(true, std::memory_order_release);
+  GPR_ASSERT(eventfd_write(wakeup_fd_, 1) == 0);
+  thd_.Join();
+  ReclaimOrphans();
+  close(wakeup_fd_);
+  close(epoll_fd_);
+}
+
+EventHandle* EpollPoller::CreateHandle(int fd) {
+  EventHandle* handle = new EventHandle(fd, this);
+  struct epoll_event ev;
+  ev.events = static_cast<uint32_t>(EPOLLIN | EPOLLOUT | EPOLLET);
+  ev.data.ptr = handle;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) != 0) {
+    gpr_log(GPR_ERROR, "epoll_ctl failed for fd %d: %s", fd, strerror(errno));
+  }
+  return handle;
+}
+
+void EpollPoller::Orphan(EventHandle* handle) {
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, handle->fd_, nullptr);
+  close(handle->fd_);
+  grpc_core::MutexLock lock(&mu_);
+  orphans_.push_back(handle);
+}
+
+void EpollPoller::ReclaimOrphans() {
+  std::vector<EventHandle*> orphans;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    orphans.swap(orphans_);
+  }
+  for (EventHandle* handle : orphans) {
+    delete handle;
+  }
+}
+
+void EpollPoller::ThreadMain(void* arg) {
+  EpollPoller* poller = static_cast<EpollPoller*>(arg);
+  struct epoll_event events[kMaxEpollEvents];
+  while (!poller->shutdown_.load(std::memory_order_acquire)) {
+    int r;
+    do {
+      r = epoll_wait(poller->epoll_fd_, events, kMaxEpollEvents, -1);
+    } while (r < 0 && errno == EINTR);
+    if (r < 0) {
+      gpr_log(GPR_ERROR, "epoll_wait failed: %s", strerror(errno));
+      continue;
+    }
+    for (int i = 0; i < r; i++) {
+      EventHandle* handle = static_cast<EventHandle*>(events[i].data.ptr);
+      if (handle == nullptr) {
+        eventfd_t value;
+        eventfd_read(poller->wakeup_fd_, &value);
+        continue;
+      }
+      bool is_error = (events[i].events & (EPOLLERR | EPOLLHUP)) != 0;
+      if ((events[i].events & (EPOLLIN | EPOLLPRI)) != 0 || is_error) {
+        handle->SetReady(&handle->read_);
+      }
+      if ((events[i].events & EPOLLOUT) != 0 || is_error) {
+        handle->SetReady(&handle->write_);
+      }
+    }
+    poller->ReclaimOrphans();
+  }
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_LINUX_EPOLL
@@ -0,0 +1,119 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_EVENT_POLLER_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_EVENT_POLLER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+
+#include "src/core/lib/event_engine/posix_engine/thread_pool.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+class EpollPoller;
+
+// A file descriptor registered with an EpollPoller. Readiness is edge
+// triggered: after a notification the owner should do I/O until it would
+// block before asking for the next notification. Notifications run on the
+// poller's ThreadPool.
+class EventHandle {
+ public:
+  EventHandle(const EventHandle&) = delete;
+  EventHandle& operator=(const EventHandle&) = delete;
+
+  int WrappedFd() const { return fd_; }
+
+  // Runs "on_ready" once the fd is readable (or writable). If the handle is
+  // shut down first, "on_ready" gets the shutdown status instead.
+  // There can be at most one pending notification per direction.
+  void NotifyOnRead(std::function<void(absl::Status)> on_ready);
+  void NotifyOnWrite(std::function<void(absl::Status)> on_ready);
+
+  // Fails pending and future notifications with "why" (which must not be OK)
+  // and shuts the socket down in both directions.
+  void ShutdownHandle(absl::Status why);
+
+  // Shuts the handle down if needed, removes the fd from the poller and closes
+  // it. The handle must not be used afterwards.
+  void OrphanHandle();
+
+ private:
+  friend class EpollPoller;
+
+  struct Notifier {
+    // Set when an edge arrived while nobody was waiting for it.
+    bool ready = false;
+    std::function<void(absl::Status)> on_ready;
+  };
+
+  EventHandle(int fd, EpollPoller* poller) : fd_(fd), poller_(poller) {}
+
+  void NotifyOn(Notifier* notifier, std::function<void(absl::Status)> on_ready);
+  // Called by the poller thread.
+  void SetReady(Notifier* notifier);
+
+  const int fd_;
+  EpollPoller* const poller_;
+  grpc_core::Mutex mu_;
+  Notifier read_ ABSL_GUARDED_BY(mu_);
+  Notifier write_ ABSL_GUARDED_BY(mu_);
+  absl::Status shutdown_status_ ABSL_GUARDED_BY(mu_);
+};
+
+// A dedicated thread waiting on an edge triggered epoll set, which hands the
+// notifications of ready handles to a ThreadPool.
+class EpollPoller {
+ public:
+  explicit EpollPoller(ThreadPool* executor);
+  // All handles must have been orphaned.
+  ~EpollPoller();
+
+  EpollPoller(const EpollPoller&) = delete;
+  EpollPoller& operator=(const EpollPoller&) = delete;
+
+  // Registers "fd", which must be non-blocking. The handle owns the fd.
+  EventHandle* CreateHandle(int fd);
+
+ private:
+  friend class EventHandle;
+
+  static void ThreadMain(void* arg);
+  void Orphan(EventHandle* handle);
+  // Frees the handles orphaned so far. Only called by the poller thread
+  // between two epoll_wait calls, so that no event still refers to them.
+  void ReclaimOrphans();
+
+  ThreadPool* const executor_;
+  int epoll_fd_;
+  // An eventfd used to wake up the poller thread on shutdown.
+  int wakeup_fd_;
+  std::atomic<bool> shutdown_{false};
+  grpc_core::Mutex mu_;
+  std::vector<EventHandle*> orphans_ ABSL_GUARDED_BY(mu_);
+  grpc_core::Thread thd_;
+};
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_EVENT_POLLER_H
@@ -0,0 +1,292 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/posix_endpoint.h"
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_LINUX_EPOLL
+
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+#include "absl/types/optional.h"
+
+#include <grpc/slice_buffer.h>
+#include <grpc/support/log.h>
+
+namespace grpc_event_engine {
+namespace experimental {
+
+namespace {
+
+constexpr size_t kMinReadChunk = 256;
+constexpr size_t kDefaultReadChunk = 8192;
+constexpr size_t kMaxReadChunk = 64 * 1024;
+
+#if defined(IOV_MAX) && IOV_MAX < 260
+constexpr size_t kMaxWriteIovec = IOV_MAX;
+#else
+constexpr size_t kMaxWriteIovec = 260;
+#endif
+
+absl::Status ErrnoToStatus(const char* call, int err) {
+  return absl::UnavailableError(absl::StrCat(call, ": ", strerror(err)));
+}
+
+}  // namespace
+
+class PosixEndpoint::Impl : public std::enable_shared_from_this<Impl> {
+ public:
+  Impl(EventHandle* handle, ThreadPool* executor, MemoryAllocator allocator,
+       const EventEngine::ResolvedAddress& peer_address)
+      : handle_(handle),
+        executor_(executor),
+        allocator_(std::move(allocator)),
+        peer_address_(peer_address) {
+    char addr[EventEngine::ResolvedAddress::MAX_SIZE_BYTES];
+    socklen_t len = sizeof(addr);
+    if (getsockname(handle_->WrappedFd(), reinterpret_cast<sockaddr*>(addr),
+                    &len) == 0) {
+      local_address_ =
+          EventEngine::ResolvedAddress(reinterpret_cast<sockaddr*>(addr), len);
+    }
+  }
+
+  ~Impl() { handle_->OrphanHandle(); }
+
+  void Shutdown() {
+    handle_->ShutdownHandle(absl::CancelledError("Endpoint shutdown"));
+  }
+
+  void Read(std::function<void(absl::Status)> on_read, SliceBuffer* buffer,
+            const ReadArgs* args) {
+    GPR_ASSERT(on_read_ == nullptr);
+    read_buffer_ = buffer->RawSliceBuffer();
+    read_hint_ = args != nullptr && args->read_hint_bytes > 0
+                     ? static_cast<size_t>(args->read_hint_bytes)
+                     : 0;
+    absl::optional<absl::Status> status = DoRead();
+    if (status.has_value()) {
+      Complete(std::move(on_read), std::move(*status));
+      return;
+    }
+    on_read_ = std::move(on_read);
+    NotifyOnRead();
+  }
+
+  void Write(std::function<void(absl::Status)> on_writable, SliceBuffer* data,
+             const WriteArgs* /*args*/) {
+    GPR_ASSERT(on_writable_ == nullptr);
+    write_buffer_ = data->RawSliceBuffer();
+    write_index_ = 0;
+    write_offset_ = 0;
+    absl::optional<absl::Status> status = DoWrite();
+    if (status.has_value()) {
+      Complete(std::move(on_writable), std::move(*status));
+      return;
+    }
+    on_writable_ = std::move(on_writable);
+    NotifyOnWrite();
+  }
+
+  const EventEngine::ResolvedAddress& peer_address() const {
+    return peer_address_;
+  }
+  const EventEngine::ResolvedAddress& local_address() const {
+    return local_address_;
+  }
+
+ private:
+  // Operations that finish without waiting still have to call back
+  // asynchronously.
+  void Complete(std::function<void(absl::Status)> cb, absl::Status status) {
+    executor_->Add([cb, status]() { cb(status); });
+  }
+
+  void NotifyOnRead() {
+    std::shared_ptr<Impl> self = shared_from_this();
+    handle_->NotifyOnRead([self](absl::Status status) {
+      if (status.ok()) {
+        absl::optional<absl::Status> result = self->DoRead();
+        if (!result.has_value()) {
+          self->NotifyOnRead();
+          return;
+        }
+        status = std::move(*result);
+      }
+      auto on_read = std::move(self->on_read_);
+      self->on_read_ = nullptr;
+      on_read(std::move(status));
+    });
+  }
+
+  void NotifyOnWrite() {
+    std::shared_ptr<Impl> self = shared_from_this();
+    handle_->NotifyOnWrite([self](absl::Status status) {
+      if (status.ok()) {
+        absl::optional<absl::Status> result = self->DoWrite();
+        if (!result.has_value()) {
+          self->NotifyOnWrite();
+          return;
+        }
+        status = std::move(*result);
+      }
+      auto on_writable = std::move(self->on_writable_);
+      self->on_writable_ = nullptr;
+      on_writable(std::move(status));
+    });
+  }
+
+  // Reads until the hint is met or the socket would block. Returns nullopt if
+  // nothing could be read yet.
+  absl::optional<absl::Status> DoRead() {
+    const int fd = handle_->WrappedFd();
+    size_t total = 0;
+    while (true) {
+      size_t want = read_hint_ > total ? read_hint_ - total : kDefaultReadChunk;
+      want = std::max(kMinReadChunk, std::min(want, kMaxReadChunk));
+      grpc_slice slice =
+          allocator_.MakeSlice(MemoryRequest(kMinReadChunk, want));
+      const size_t len = GRPC_SLICE_LENGTH(slice);
+      ssize_t n;
+      do {
+        n = recv(fd, GRPC_SLICE_START_PTR(slice), len, 0);
+      } while (n < 0 && errno == EINTR);
+      if (n <= 0) {
+        int err = errno;
+        grpc_slice_unref(slice);
+        if (n == 0) {
+          if (total > 0) return absl::OkStatus();
+          return absl::UnavailableError("Socket closed");
+        }
+        if (err == EAGAIN || err == EWOULDBLOCK) {
+          if (total > 0) return absl::OkStatus();
+          return absl::nullopt;
+        }
+        return ErrnoToStatus("recv", err);
+      }
+      grpc_slice_buffer_add(read_buffer_, slice);
+      if (static_cast<size_t>(n) < len) {
+        grpc_slice_buffer_trim_end(read_buffer_, len - n, nullptr);
+      }
+      total += n;
+      // A short read means the socket is drained for now.
+      if (total >= read_hint_ || static_cast<size_t>(n) < len) {
+        return absl::OkStatus();
+      }
+    }
+  }
+
+  // Writes as much of the pending data as the socket accepts. Returns nullopt
+  // if some of it is left.
+  absl::optional<absl::Status> DoWrite() {
+    const int fd = handle_->WrappedFd();
+    while (write_index_ < write_buffer_->count) {
+      struct iovec iov[kMaxWriteIovec];
+      size_t iov_size = 0;
+      size_t offset = write_offset_;
+      for (size_t i = write_index_;
+           i < write_buffer_->count && iov_size < kMaxWriteIovec; i++) {
+        grpc_slice& slice = write_buffer_->slices[i];
+        iov[iov_size].iov_base = GRPC_SLICE_START_PTR(slice) + offset;
+        iov[iov_size].iov_len = GRPC_SLICE_LENGTH(slice) - offset;
+        offset = 0;
+        iov_size++;
+      }
+      struct msghdr msg;
+      memset(&msg, 0, sizeof(msg));
+      msg.msg_iov = iov;
+      msg.msg_iovlen = iov_size;
+      ssize_t n;
+      do {
+        n = sendmsg(fd, &msg, MSG_NOSIGNAL);
+      } while (n < 0 && errno == EINTR);
+      if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) return absl::nullopt;
+        return ErrnoToStatus("sendmsg", errno);
+      }
+      size_t sent = n;
+      while (write_index_ < write_buffer_->count) {
+        size_t remaining =
+            GRPC_SLICE_LENGTH(write_buffer_->slices[write_index_]) -
+            write_offset_;
+        if (sent < remaining) {
+          write_offset_ += sent;
+          break;
+        }
+        sent -= remaining;
+        write_index_++;
+        write_offset_ = 0;
+      }
+    }
+    return absl::OkStatus();
+  }
+
+  EventHandle* const handle_;
+  ThreadPool* const executor_;
+  MemoryAllocator allocator_;
+  const EventEngine::ResolvedAddress peer_address_;
+  EventEngine::ResolvedAddress local_address_;
+
+  // At most one read and one write are pending at a time, and each is only
+  // touched by the thread currently driving it.
+  std::function<void(absl::Status)> on_read_;
+  grpc_slice_buffer* read_buffer_ = nullptr;
+  size_t read_hint_ = 0;
+
+  std::function<void(absl::Status)> on_writable_;
+  grpc_slice_buffer* write_buffer_ = nullptr;
+  size_t write_index_ = 0;
+  size_t write_offset_ = 0;
+};
+
+PosixEndpoint::PosixEndpoint(EventHandle* handle, ThreadPool* executor,
+                             MemoryAllocator allocator,
+                             const EventEngine::ResolvedAddress& peer_address)
+    : impl_(std::make_shared<Impl>(handle, executor, std::move(allocator),
+                                   peer_address)) {}
+
+PosixEndpoint::~PosixEndpoint() { impl_->Shutdown(); }
+
+void PosixEndpoint::Read(std::function<void(absl::Status)> on_read,
+                         SliceBuffer* buffer, const ReadArgs* args) {
+  impl_->Read(std::move(on_read), buffer, args);
+}
+
+void PosixEndpoint::Write(std::function<void(absl::Status)> on_writable,
+                          SliceBuffer* data, const WriteArgs* args) {
+  impl_->Write(std::move(on_writable), data, args);
+}
+
+const EventEngine::ResolvedAddress& PosixEndpoint::GetPeerAddress() const {
+  return impl_->peer_address();
+}
+
+const EventEngine::ResolvedAddress& PosixEndpoint::GetLocalAddress() const {
+  return impl_->local_address();
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_LINUX_EPOLL
@@ -0,0 +1,65 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENDPOINT_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENDPOINT_H
+
+#include <grpc/support/port_platform.h>
+
+#include <functional>
+#include <memory>
+
+#include "absl/status/status.h"
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/event_engine/memory_allocator.h>
+#include <grpc/event_engine/slice_buffer.h>
+
+#include "src/core/lib/event_engine/posix_engine/event_poller.h"
+#include "src/core/lib/event_engine/posix_engine/thread_pool.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+// A TCP (or unix domain socket) endpoint doing non-blocking reads and writes
+// directly on its socket. When the socket would block, the operation is
+// resumed from the poller notification instead of going through a closure
+// and an ExecCtx.
+class PosixEndpoint : public EventEngine::Endpoint {
+ public:
+  // Takes ownership of "handle".
+  PosixEndpoint(EventHandle* handle, ThreadPool* executor,
+                MemoryAllocator allocator,
+                const EventEngine::ResolvedAddress& peer_address);
+  // Fails the pending read and write, if any, with CANCELLED.
+  ~PosixEndpoint() override;
+
+  void Read(std::function<void(absl::Status)> on_read, SliceBuffer* buffer,
+            const ReadArgs* args) override;
+  void Write(std::function<void(absl::Status)> on_writable, SliceBuffer* data,
+             const WriteArgs* args) override;
+  const EventEngine::ResolvedAddress& GetPeerAddress() const override;
+  const EventEngine::ResolvedAddress& GetLocalAddress() const override;
+
+ private:
+  class Impl;
+
+  // Shared with the pending poller notifications, so that they can still run
+  // after the endpoint is destroyed.
+  std::shared_ptr<Impl> impl_;
+};
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENDPOINT_H
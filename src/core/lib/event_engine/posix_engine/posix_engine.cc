@@ -0,0 +1,465 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_LINUX_EPOLL
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/event_engine/caching_dns_resolver.h"
+#include "src/core/lib/event_engine/posix_engine/posix_endpoint.h"
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/host_port.h"
+#include "src/core/lib/resolver/dns_cache.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+namespace {
+
+absl::Status ErrnoToStatus(const char* call, int err) {
+  return absl::UnavailableError(absl::StrCat(call, ": ", strerror(err)));
+}
+
+bool IsInet(int family) { return family == AF_INET || family == AF_INET6; }
+
+void SetNoDelay(int fd) {
+  int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+EventEngine::ResolvedAddress PeerAddress(int fd) {
+  char addr[EventEngine::ResolvedAddress::MAX_SIZE_BYTES];
+  socklen_t len = sizeof(addr);
+  if (getpeername(fd, reinterpret_cast<sockaddr*>(addr), &len) != 0) {
+    return EventEngine::ResolvedAddress();
+  }
+  return EventEngine::ResolvedAddress(reinterpret_cast<sockaddr*>(addr), len);
+}
+
+//
+// PosixListener
+//
+
+class PosixListener : public EventEngine::Listener {
+ public:
+  PosixListener(ThreadPool* executor, EpollPoller* poller,
+                AcceptCallback on_accept,
+                std::function<void(absl::Status)> on_shutdown,
+                std::unique_ptr<MemoryAllocatorFactory> allocator_factory)
+      : state_(std::make_shared<State>(executor, poller, std::move(on_accept),
+                                       std::move(on_shutdown),
+                                       std::move(allocator_factory))) {}
+
+  ~PosixListener() override {
+    // Fails the pending accept notifications, which release their references
+    // to the state. The last one to go calls on_shutdown.
+    for (EventHandle* handle : state_->handles) {
+      handle->ShutdownHandle(absl::CancelledError("Listener shutdown"));
+    }
+  }
+
+  absl::StatusOr<int> Bind(const EventEngine::ResolvedAddress& addr) override {
+    if (!state_->handles.empty()) {
+      return absl::FailedPreconditionError("Listener already started");
+    }
+    const int family = addr.address()->sa_family;
+    int fd = socket(family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return ErrnoToStatus("socket", errno);
+    int one = 1;
+    int zero = 0;
+    if (IsInet(family)) {
+      setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    }
+    if (family == AF_INET6) {
+      setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &zero, sizeof(zero));
+    }
+    if (bind(fd, addr.address(), addr.size()) != 0) {
+      int err = errno;
+      close(fd);
+      return ErrnoToStatus("bind", err);
+    }
+    if (listen(fd, SOMAXCONN) != 0) {
+      int err = errno;
+      close(fd);
+      return ErrnoToStatus("listen", err);
+    }
+    state_->fds.push_back(fd);
+    sockaddr_storage bound;
+    socklen_t len = sizeof(bound);
+    if (getsockname(fd, reinterpret_cast<sockaddr*>(&bound), &len) != 0) {
+      return ErrnoToStatus("getsockname", errno);
+    }
+    switch (bound.ss_family) {
+      case AF_INET:
+        return ntohs(reinterpret_cast<sockaddr_in*>(&bound)->sin_port);
+      case AF_INET6:
+        return ntohs(reinterpret_cast<sockaddr_in6*>(&bound)->sin6_port);
+      default:
+        return 0;
+    }
+  }
+
+  absl::Status Start() override {
+    if (!state_->handles.empty()) {
+      return absl::FailedPreconditionError("Listener already started");
+    }
+    for (int fd : state_->fds) {
+      state_->handles.push_back(state_->poller->CreateHandle(fd));
+    }
+    state_->fds.clear();
+    for (EventHandle* handle : state_->handles) {
+      Accept(state_, handle, absl::OkStatus());
+    }
+    return absl::OkStatus();
+  }
+
+ private:
+  struct State {
+    State(ThreadPool* executor, EpollPoller* poller, AcceptCallback on_accept,
+          std::function<void(absl::Status)> on_shutdown,
+          std::unique_ptr<MemoryAllocatorFactory> allocator_factory)
+        : executor(executor),
+          poller(poller),
+          on_accept(std::move(on_accept)),
+          on_shutdown(std::move(on_shutdown)),
+          allocator_factory(std::move(allocator_factory)) {}
+
+    ~State() {
+      for (int fd : fds) close(fd);
+      for (EventHandle* handle : handles) handle->OrphanHandle();
+      on_shutdown(absl::OkStatus());
+    }
+
+    ThreadPool* const executor;
+    EpollPoller* const poller;
+    const AcceptCallback on_accept;
+    const std::function<void(absl::Status)> on_shutdown;
+    const std::unique_ptr<MemoryAllocatorFactory> allocator_factory;
+    // Bound sockets, until Start() wraps them into handles.
+    std::vector<int> fds;
+    std::vector<EventHandle*> handles;
+  };
+
+  // Accepts connections until the listening socket would block, then waits
+  // for the next one.
+  static void Accept(const std::shared_ptr<State>& state, EventHandle* handle,
+                     absl::Status status) {
+    if (!status.ok()) return;
+    while (true) {
+      sockaddr_storage addr;
+      socklen_t len = sizeof(addr);
+      int fd = accept4(handle->WrappedFd(), reinterpret_cast<sockaddr*>(&addr),
+                       &len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if (fd < 0) {
+        if (errno == EINTR) continue;
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+          gpr_log(GPR_ERROR, "accept4 failed: %s", strerror(errno));
+        }
+        break;
+      }
+      if (IsInet(addr.ss_family)) SetNoDelay(fd);
+      EventEngine::ResolvedAddress peer(reinterpret_cast<sockaddr*>(&addr),
+                                        len);
+      std::unique_ptr<EventEngine::Endpoint> endpoint =
+          absl::make_unique<PosixEndpoint>(
+              state->poller->CreateHandle(fd), state->executor,
+              state->allocator_factory->CreateMemoryAllocator(
+                  "posix_endpoint"),
+              peer);
+      state->on_accept(std::move(endpoint),
+                       state->allocator_factory->CreateMemoryAllocator(
+                           "posix_listener_accept"));
+    }
+    handle->NotifyOnRead([state, handle](absl::Status status) {
+      Accept(state, handle, std::move(status));
+    });
+  }
+
+  std::shared_ptr<State> state_;
+};
+
+//
+// PosixDNSResolver
+//
+
+class PosixDNSResolver : public EventEngine::DNSResolver {
+ public:
+  explicit PosixDNSResolver(ThreadPool* executor) : executor_(executor) {}
+
+  // The deadline is not enforced: getaddrinfo() has no timeout.
+  LookupTaskHandle LookupHostname(LookupHostnameCallback on_resolve,
+                                  absl::string_view name,
+                                  absl::string_view default_port,
+                                  absl::Time /*deadline*/) override {
+    std::string name_str(name);
+    std::string default_port_str(default_port);
+    executor_->Add([on_resolve, name_str, default_port_str]() {
+      on_resolve(Resolve(name_str, default_port_str));
+    });
+    return {0, 0};
+  }
+
+  LookupTaskHandle LookupSRV(LookupSRVCallback on_resolve,
+                             absl::string_view /*name*/,
+                             absl::Time /*deadline*/) override {
+    executor_->Add([on_resolve]() {
+      on_resolve(absl::UnimplementedError("SRV lookups are not supported"));
+    });
+    return {0, 0};
+  }
+
+  LookupTaskHandle LookupTXT(LookupTXTCallback on_resolve,
+                             absl::string_view /*name*/,
+                             absl::Time /*deadline*/) override {
+    executor_->Add([on_resolve]() {
+      on_resolve(absl::UnimplementedError("TXT lookups are not supported"));
+    });
+    return {0, 0};
+  }
+
+  bool CancelLookup(LookupTaskHandle /*handle*/) override { return false; }
+
+ private:
+  static absl::StatusOr<std::vector<EventEngine::ResolvedAddress>> Resolve(
+      const std::string& name, const std::string& default_port) {
+    std::string host;
+    std::string port;
+    if (!grpc_core::SplitHostPort(name, &host, &port) || host.empty()) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Unparseable address: ", name));
+    }
+    if (port.empty()) {
+      if (default_port.empty()) {
+        return absl::InvalidArgumentError(
+            absl::StrCat("No port in address: ", name));
+      }
+      port = default_port;
+    }
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* result = nullptr;
+    int r = getaddrinfo(host.c_str(), port.c_str(), &hints, &result);
+    if (r != 0) {
+      return absl::NotFoundError(
+          absl::StrCat("getaddrinfo(", name, "): ", gai_strerror(r)));
+    }
+    std::vector<EventEngine::ResolvedAddress> addresses;
+    for (struct addrinfo* ai = result; ai != nullptr; ai = ai->ai_next) {
+      addresses.emplace_back(ai->ai_addr, ai->ai_addrlen);
+    }
+    freeaddrinfo(result);
+    return addresses;
+  }
+
+  ThreadPool* const executor_;
+};
+
+}  // namespace
+
+//
+// PosixEventEngine
+//
+
+struct PosixEventEngine::ConnectionState {
+  EventHandle* handle = nullptr;
+  TaskHandle deadline_timer;
+  OnConnectCallback on_connect;
+  MemoryAllocator allocator;
+  ResolvedAddress addr;
+};
+
+PosixEventEngine::PosixEventEngine()
+    : executor_(std::max(2u, gpr_cpu_num_cores())),
+      timer_manager_(&executor_),
+      poller_(&executor_) {}
+
+PosixEventEngine::~PosixEventEngine() {
+  grpc_core::MutexLock lock(&mu_);
+  GPR_ASSERT(connects_.empty());
+}
+
+absl::StatusOr<std::unique_ptr<EventEngine::Listener>>
+PosixEventEngine::CreateListener(
+    Listener::AcceptCallback on_accept,
+    std::function<void(absl::Status)> on_shutdown,
+    const EndpointConfig& /*config*/,
+    std::unique_ptr<MemoryAllocatorFactory> memory_allocator_factory) {
+  return absl::make_unique<PosixListener>(
+      &executor_, &poller_, std::move(on_accept), std::move(on_shutdown),
+      std::move(memory_allocator_factory));
+}
+
+EventEngine::ConnectionHandle PosixEventEngine::Connect(
+    OnConnectCallback on_connect, const ResolvedAddress& addr,
+    const EndpointConfig& /*args*/, MemoryAllocator memory_allocator,
+    absl::Time deadline) {
+  const int family = addr.address()->sa_family;
+  int fd = socket(family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    absl::Status status = ErrnoToStatus("socket", errno);
+    executor_.Add([on_connect, status]() { on_connect(status); });
+    return {0, 0};
+  }
+  if (IsInet(family)) SetNoDelay(fd);
+  int r;
+  do {
+    r = connect(fd, addr.address(), addr.size());
+  } while (r < 0 && errno == EINTR);
+  if (r < 0 && errno != EINPROGRESS) {
+    absl::Status status = ErrnoToStatus("connect", errno);
+    close(fd);
+    executor_.Add([on_connect, status]() { on_connect(status); });
+    return {0, 0};
+  }
+  auto state = std::make_shared<ConnectionState>();
+  state->handle = poller_.CreateHandle(fd);
+  state->on_connect = std::move(on_connect);
+  state->allocator = std::move(memory_allocator);
+  state->addr = addr;
+  if (r == 0) {
+    executor_.Add([this, state]() { FinishConnect(state); });
+    return {0, 0};
+  }
+  intptr_t id;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    id = next_connect_id_++;
+    connects_.emplace(id, state);
+    // Still under the lock, so that the timer cannot fire before
+    // deadline_timer is set.
+    state->deadline_timer = timer_manager_.RunAt(
+        deadline, [this, id]() { OnConnectDeadline(id); });
+  }
+  state->handle->NotifyOnWrite(
+      [this, id](absl::Status status) { OnConnectWritable(id, status); });
+  return {id, 0};
+}
+
+bool PosixEventEngine::CancelConnect(ConnectionHandle handle) {
+  std::shared_ptr<ConnectionState> state = TakeConnection(handle.keys[0]);
+  if (state == nullptr) return false;
+  timer_manager_.Cancel(state->deadline_timer);
+  state->handle->OrphanHandle();
+  return true;
+}
+
+std::shared_ptr<PosixEventEngine::ConnectionState>
+PosixEventEngine::TakeConnection(intptr_t id) {
+  grpc_core::MutexLock lock(&mu_);
+  auto it = connects_.find(id);
+  if (it == connects_.end()) return nullptr;
+  std::shared_ptr<ConnectionState> state = std::move(it->second);
+  connects_.erase(it);
+  return state;
+}
+
+void PosixEventEngine::OnConnectWritable(intptr_t id, absl::Status status) {
+  std::shared_ptr<ConnectionState> state = TakeConnection(id);
+  if (state == nullptr) return;
+  timer_manager_.Cancel(state->deadline_timer);
+  if (status.ok()) {
+    int err = 0;
+    socklen_t len = sizeof(err);
+    if (getsockopt(state->handle->WrappedFd(), SOL_SOCKET, SO_ERROR, &err,
+                   &len) != 0) {
+      err = errno;
+    }
+    if (err != 0) status = ErrnoToStatus("connect", err);
+  }
+  if (!status.ok()) {
+    state->handle->OrphanHandle();
+    state->on_connect(status);
+    return;
+  }
+  FinishConnect(std::move(state));
+}
+
+void PosixEventEngine::OnConnectDeadline(intptr_t id) {
+  std::shared_ptr<ConnectionState> state = TakeConnection(id);
+  if (state == nullptr) return;
+  state->handle->OrphanHandle();
+  state->on_connect(absl::DeadlineExceededError("Connect deadline exceeded"));
+}
+
+void PosixEventEngine::FinishConnect(std::shared_ptr<ConnectionState> state) {
+  ResolvedAddress peer = PeerAddress(state->handle->WrappedFd());
+  if (peer.size() == 0) peer = state->addr;
+  state->on_connect(absl::make_unique<PosixEndpoint>(
+      state->handle, &executor_, std::move(state->allocator), peer));
+}
+
+bool PosixEventEngine::IsWorkerThread() {
+  return executor_.IsThreadPoolThread();
+}
+
+std::unique_ptr<EventEngine::DNSResolver> PosixEventEngine::GetDNSResolver(
+    const DNSResolver::ResolverOptions& options) {
+  auto resolver = absl::make_unique<PosixDNSResolver>(&executor_);
+  if (!GPR_GLOBAL_CONFIG_GET(grpc_dns_cache)) return resolver;
+  return absl::make_unique<CachingDNSResolver>(this, std::move(resolver),
+                                               options.dns_server);
+}
+
+void PosixEventEngine::Run(Closure* closure) {
+  executor_.Add([closure]() { closure->Run(); });
+}
+
+void PosixEventEngine::Run(std::function<void()> closure) {
+  executor_.Add(std::move(closure));
+}
+
+EventEngine::TaskHandle PosixEventEngine::RunAt(absl::Time when,
+                                                Closure* closure) {
+  return timer_manager_.RunAt(when, [closure]() { closure->Run(); });
+}
+
+EventEngine::TaskHandle PosixEventEngine::RunAt(
+    absl::Time when, std::function<void()> closure) {
+  return timer_manager_.RunAt(when, std::move(closure));
+}
+
+bool PosixEventEngine::Cancel(TaskHandle handle) {
+  return timer_manager_.Cancel(handle);
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_LINUX_EPOLL
@@ -0,0 +1,99 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/time/time.h"
+
+#include <grpc/event_engine/endpoint_config.h>
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/event_engine/memory_allocator.h>
+
+#include "src/core/lib/event_engine/posix_engine/event_poller.h"
+#include "src/core/lib/event_engine/posix_engine/thread_pool.h"
+#include "src/core/lib/event_engine/posix_engine/timer_manager.h"
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+// An EventEngine for Linux that owns all of its threads: a pool running
+// callbacks, a thread polling an epoll set and a timer thread. None of them
+// use the iomgr closures or an ExecCtx.
+//
+// DNS lookups run getaddrinfo on the pool; they cannot be cancelled, and SRV
+// and TXT lookups are not supported. When GRPC_DNS_CACHE is set, they go
+// through the process-wide DNS cache.
+class PosixEventEngine final : public EventEngine {
+ public:
+  PosixEventEngine();
+  ~PosixEventEngine() override;
+
+  absl::StatusOr<std::unique_ptr<Listener>> CreateListener(
+      Listener::AcceptCallback on_accept,
+      std::function<void(absl::Status)> on_shutdown,
+      const EndpointConfig& config,
+      std::unique_ptr<MemoryAllocatorFactory> memory_allocator_factory)
+      override;
+  ConnectionHandle Connect(OnConnectCallback on_connect,
+                           const ResolvedAddress& addr,
+                           const EndpointConfig& args,
+                           MemoryAllocator memory_allocator,
+                           absl::Time deadline) override;
+  bool CancelConnect(ConnectionHandle handle) override;
+  bool IsWorkerThread() override;
+  std::unique_ptr<DNSResolver> GetDNSResolver(
+      const DNSResolver::ResolverOptions& options) override;
+  void Run(Closure* closure) override;
+  void Run(std::function<void()> closure) override;
+  TaskHandle RunAt(absl::Time when, Closure* closure) override;
+  TaskHandle RunAt(absl::Time when, std::function<void()> closure) override;
+  bool Cancel(TaskHandle handle) override;
+
+ private:
+  struct ConnectionState;
+
+  void OnConnectWritable(intptr_t id, absl::Status status);
+  void OnConnectDeadline(intptr_t id);
+  // Removes the connection attempt, so that only the first of its outcomes
+  // (connected, deadline, cancelled) is acted upon. Returns nullptr if it is
+  // already gone.
+  std::shared_ptr<ConnectionState> TakeConnection(intptr_t id);
+  void FinishConnect(std::shared_ptr<ConnectionState> state);
+
+  ThreadPool executor_;
+  TimerManager timer_manager_;
+  EpollPoller poller_;
+
+  grpc_core::Mutex mu_;
+  absl::flat_hash_map<intptr_t, std::shared_ptr<ConnectionState>> connects_
+      ABSL_GUARDED_BY(mu_);
+  intptr_t next_connect_id_ ABSL_GUARDED_BY(mu_) = 1;
+};
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_H
@@ -0,0 +1,78 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/thread_pool.h"
+
+#include <utility>
+
+namespace grpc_event_engine {
+namespace experimental {
+
+GPR_THREAD_LOCAL(const ThreadPool*) ThreadPool::current_pool_;
+
+ThreadPool::ThreadPool(int num_threads) {
+  if (num_threads <= 0) num_threads = 1;
+  threads_.reserve(num_threads);
+  for (int i = 0; i < num_threads; i++) {
+    threads_.emplace_back("event_engine", &ThreadPool::ThreadMain, this);
+    threads_.back().Start();
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    grpc_core::MutexLock lock(&mu_);
+    shutdown_ = true;
+    cv_.SignalAll();
+  }
+  for (auto& thd : threads_) {
+    thd.Join();
+  }
+}
+
+void ThreadPool::Add(std::function<void()> callback) {
+  grpc_core::MutexLock lock(&mu_);
+  callbacks_.push_back(std::move(callback));
+  cv_.Signal();
+}
+
+bool ThreadPool::IsThreadPoolThread() const { return current_pool_ == this; }
+
+bool ThreadPool::Step() {
+  std::function<void()> callback;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    while (callbacks_.empty() && !shutdown_) {
+      cv_.Wait(&mu_);
+    }
+    // Keep draining after shutdown, so that all callbacks run.
+    if (callbacks_.empty()) return false;
+    callback = std::move(callbacks_.front());
+    callbacks_.pop_front();
+  }
+  callback();
+  return true;
+}
+
+void ThreadPool::ThreadMain(void* arg) {
+  ThreadPool* pool = static_cast<ThreadPool*>(arg);
+  current_pool_ = pool;
+  while (pool->Step()) {
+  }
+  current_pool_ = nullptr;
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
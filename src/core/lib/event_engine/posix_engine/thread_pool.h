@@ -0,0 +1,67 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_THREAD_POOL_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_THREAD_POOL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+// A fixed size pool of threads running callbacks in FIFO order. Unlike the
+// iomgr thread pools, callbacks run without an ExecCtx.
+class ThreadPool {
+ public:
+  // Creates a pool with "num_threads" threads (at least 1).
+  explicit ThreadPool(int num_threads);
+  // Runs all pending callbacks, including those they add, then joins the
+  // threads.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void Add(std::function<void()> callback);
+
+  // Returns true if called from one of the pool's threads.
+  bool IsThreadPoolThread() const;
+
+ private:
+  static GPR_THREAD_LOCAL(const ThreadPool*) current_pool_;
+
+  static void ThreadMain(void* arg);
+  // Returns false once the pool is shut down and drained.
+  bool Step();
+
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  std::deque<std::function<void()>> callbacks_ ABSL_GUARDED_BY(mu_);
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  std::vector<grpc_core::Thread> threads_;
+};
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_THREAD_POOL_H
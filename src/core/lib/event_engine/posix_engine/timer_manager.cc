@@ -0,0 +1,85 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/timer_manager.h"
+
+#include <vector>
+
+namespace grpc_event_engine {
+namespace experimental {
+
+TimerManager::TimerManager(ThreadPool* executor) : executor_(executor) {
+  thd_ = grpc_core::Thread("event_engine_timer", &TimerManager::ThreadMain,
+                           this);
+  thd_.Start();
+}
+
+TimerManager::~TimerManager() {
+  {
+    grpc_core::MutexLock lock(&mu_);
+    shutdown_ = true;
+    cv_.Signal();
+  }
+  thd_.Join();
+}
+
+EventEngine::TaskHandle TimerManager::RunAt(absl::Time when,
+                                            std::function<void()> fn) {
+  grpc_core::MutexLock lock(&mu_);
+  Key key(absl::ToUnixNanos(when), next_id_++);
+  auto it = timers_.emplace(key, std::move(fn)).first;
+  // Only a new earliest timer changes how long the thread has to sleep.
+  if (it == timers_.begin()) cv_.Signal();
+  return {key.first, key.second};
+}
+
+bool TimerManager::Cancel(EventEngine::TaskHandle handle) {
+  grpc_core::MutexLock lock(&mu_);
+  return timers_.erase(Key(handle.keys[0], handle.keys[1])) == 1;
+}
+
+void TimerManager::ThreadMain(void* arg) {
+  static_cast<TimerManager*>(arg)->Run();
+}
+
+void TimerManager::Run() {
+  std::vector<std::function<void()>> due;
+  grpc_core::LockableAndReleasableMutexLock lock(&mu_);
+  while (!shutdown_) {
+    if (timers_.empty()) {
+      cv_.Wait(&mu_);
+      continue;
+    }
+    int64_t now = absl::ToUnixNanos(absl::Now());
+    int64_t next = timers_.begin()->first.first;
+    if (next > now) {
+      cv_.WaitWithDeadline(&mu_, absl::FromUnixNanos(next));
+      continue;
+    }
+    while (!timers_.empty() && timers_.begin()->first.first <= now) {
+      due.push_back(std::move(timers_.begin()->second));
+      timers_.erase(timers_.begin());
+    }
+    lock.Release();
+    for (auto& fn : due) {
+      executor_->Add(std::move(fn));
+    }
+    due.clear();
+    lock.Lock();
+  }
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
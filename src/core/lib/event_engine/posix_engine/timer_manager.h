@@ -0,0 +1,71 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_MANAGER_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_MANAGER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <functional>
+#include <map>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/time/time.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/posix_engine/thread_pool.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+// Runs callbacks on a ThreadPool at given times. Timers are kept ordered by
+// deadline and a single thread sleeps until the earliest one is due.
+class TimerManager {
+ public:
+  explicit TimerManager(ThreadPool* executor);
+  // Pending timers are dropped without running.
+  ~TimerManager();
+
+  TimerManager(const TimerManager&) = delete;
+  TimerManager& operator=(const TimerManager&) = delete;
+
+  EventEngine::TaskHandle RunAt(absl::Time when, std::function<void()> fn);
+  // Returns true if the timer was cancelled before it started running.
+  bool Cancel(EventEngine::TaskHandle handle);
+
+ private:
+  // Timers with the same deadline are ordered by creation.
+  using Key = std::pair<int64_t, intptr_t>;
+
+  static void ThreadMain(void* arg);
+  void Run();
+
+  ThreadPool* const executor_;
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  std::map<Key, std::function<void()>> timers_ ABSL_GUARDED_BY(mu_);
+  intptr_t next_id_ ABSL_GUARDED_BY(mu_) = 1;
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  grpc_core::Thread thd_;
+};
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_MANAGER_H
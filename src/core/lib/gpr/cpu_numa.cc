@@ -0,0 +1,97 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/gpr/cpu_numa.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/sync.h>
+
+#ifdef GPR_LINUX
+#include <dirent.h>
+#include <stdio.h>
+#endif
+
+static unsigned g_num_nodes = 1;
+/* Node of each CPU, or nullptr if everything is on node 0. */
+static unsigned* g_cpu_nodes = nullptr;
+
+#ifdef GPR_LINUX
+/* Returns the node that sysfs lists CPU \a cpu under, as a "node<N>" entry
+   of its directory, or -1. */
+static int read_cpu_node(unsigned cpu) {
+  char path[64];
+  snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u", cpu);
+  DIR* dir = opendir(path);
+  if (dir == nullptr) return -1;
+  int node = -1;
+  while (struct dirent* entry = readdir(dir)) {
+    if (strncmp(entry->d_name, "node", 4) != 0) continue;
+    char* end;
+    long n = strtol(entry->d_name + 4, &end, 10);
+    if (end != entry->d_name + 4 && *end == '\0' && n >= 0) {
+      node = static_cast<int>(n);
+      break;
+    }
+  }
+  closedir(dir);
+  return node;
+}
+#endif
+
+static void init_numa_topology() {
+#ifdef GPR_LINUX
+  unsigned ncpus = gpr_cpu_num_cores();
+  unsigned* nodes =
+      static_cast<unsigned*>(malloc(sizeof(*nodes) * (ncpus > 0 ? ncpus : 1)));
+  unsigned num_nodes = 1;
+  for (unsigned cpu = 0; cpu < ncpus; cpu++) {
+    int node = read_cpu_node(cpu);
+    nodes[cpu] = node < 0 ? 0 : static_cast<unsigned>(node);
+    if (nodes[cpu] + 1 > num_nodes) num_nodes = nodes[cpu] + 1;
+  }
+  if (num_nodes == 1) {
+    free(nodes);
+    return;
+  }
+  g_num_nodes = num_nodes;
+  g_cpu_nodes = nodes;
+#endif
+}
+
+static gpr_once g_numa_once = GPR_ONCE_INIT;
+
+unsigned gpr_numa_num_nodes(void) {
+  gpr_once_init(&g_numa_once, init_numa_topology);
+  return g_num_nodes;
+}
+
+unsigned gpr_numa_node_of_cpu(unsigned cpu) {
+  gpr_once_init(&g_numa_once, init_numa_topology);
+  if (g_cpu_nodes == nullptr || cpu >= gpr_cpu_num_cores()) return 0;
+  return g_cpu_nodes[cpu];
+}
+
+unsigned gpr_numa_current_node(void) {
+  if (gpr_numa_num_nodes() == 1) return 0;
+  return gpr_numa_node_of_cpu(gpr_cpu_current_cpu());
+}
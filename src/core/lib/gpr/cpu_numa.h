@@ -0,0 +1,38 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_GPR_CPU_NUMA_H
+#define GRPC_CORE_LIB_GPR_CPU_NUMA_H
+
+#include <grpc/support/port_platform.h>
+
+/* NUMA topology of the machine. It is read once, from sysfs on Linux; on
+   other platforms, or if it cannot be read, every CPU is on node 0. */
+
+/* Returns the number of NUMA nodes, at least 1. */
+unsigned gpr_numa_num_nodes(void);
+
+/* Returns the node of \a cpu, in [0, gpr_numa_num_nodes() - 1]. \a cpu is a
+   value returned by gpr_cpu_current_cpu(). */
+unsigned gpr_numa_node_of_cpu(unsigned cpu);
+
+/* Returns the node of the CPU the calling thread is running on. Advisory
+   only, like gpr_cpu_current_cpu(). */
+unsigned gpr_numa_current_node(void);
+
+#endif /* GRPC_CORE_LIB_GPR_CPU_NUMA_H */
@@ -25,6 +25,7 @@
 #include <grpc/support/atm.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/gpr/log_async.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/global_config.h"
 
@@ -38,6 +39,10 @@ GPR_GLOBAL_CONFIG_DEFINE_STRING(grpc_verbosity,
 GPR_GLOBAL_CONFIG_DEFINE_STRING(grpc_stacktrace_minloglevel, "",
                                 "Messages logged at the same or higher level "
                                 "than this will print stacktrace")
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(grpc_async_log, false,
+                              "If set, log messages are written to stderr "
+                              "by a background thread instead of the "
+                              "logging thread")
 
 static constexpr gpr_atm GPR_LOG_SEVERITY_UNSET = GPR_LOG_SEVERITY_ERROR + 10;
 static constexpr gpr_atm GPR_LOG_SEVERITY_NONE = GPR_LOG_SEVERITY_ERROR + 11;
@@ -138,6 +143,12 @@ void gpr_log_verbosity_init() {
     gpr_atm_no_barrier_store(&g_min_severity_to_print_stacktrace,
                              min_severity_to_print_stacktrace);
   }
+  // switch to the asynchronous log unless a log function has been set
+  if (GPR_GLOBAL_CONFIG_GET(grpc_async_log)) {
+    gpr_atm default_log_func = reinterpret_cast<gpr_atm>(gpr_default_log);
+    gpr_atm_no_barrier_cas(&g_log_func, default_log_func,
+                           reinterpret_cast<gpr_atm>(gpr_async_log));
+  }
 }
 
 void gpr_set_log_function(gpr_log_func f) {
@@ -0,0 +1,374 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/gpr/log_async.h"
+
+#if defined(GPR_LINUX_LOG) || defined(GPR_POSIX_LOG)
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef GPR_LINUX_LOG
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <string>
+
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/time/time.h"
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/string_util.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/examine_stack.h"
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_async_log_rate_limit, 100,
+    "Maximum number of messages per second that the asynchronous log writes "
+    "for each log statement. Zero or less means no limit.")
+
+int gpr_should_log_stacktrace(gpr_log_severity severity);
+
+namespace {
+
+// Must be a power of two.
+constexpr size_t kQueueSize = 4096;
+constexpr size_t kRateLimitSlots = 1024;
+
+intptr_t CurrentThreadId() {
+#ifdef GPR_LINUX_LOG
+  static GPR_THREAD_LOCAL(intptr_t) tid(0);
+  if (tid == 0) tid = static_cast<intptr_t>(syscall(__NR_gettid));
+  return tid;
+#else
+  return (intptr_t)pthread_self();
+#endif
+}
+
+// A log message, as captured on the logging thread.
+struct Message {
+  const char* file;
+  int line;
+  gpr_log_severity severity;
+  gpr_timespec time;
+  intptr_t tid;
+  // Owned; freed once written.
+  char* text;
+};
+
+void WriteMessage(const Message& message) {
+  const char* final_slash = strrchr(message.file, '/');
+  const char* display_file =
+      final_slash == nullptr ? message.file : final_slash + 1;
+  char time_buffer[64];
+  time_t timer = static_cast<time_t>(message.time.tv_sec);
+  struct tm tm;
+  if (!localtime_r(&timer, &tm)) {
+    strcpy(time_buffer, "error:localtime");
+  } else if (0 ==
+             strftime(time_buffer, sizeof(time_buffer), "%m%d %H:%M:%S", &tm)) {
+    strcpy(time_buffer, "error:strftime");
+  }
+  std::string prefix = absl::StrFormat(
+      "%s%s.%09d %7" PRIdPTR " %s:%d]",
+      gpr_log_severity_string(message.severity), time_buffer,
+      static_cast<int>(message.time.tv_nsec), message.tid, display_file,
+      message.line);
+  fprintf(stderr, "%-60s %s\n", prefix.c_str(), message.text);
+}
+
+class AsyncLog;
+
+// Set once the log is created, so that flushes need not create it.
+std::atomic<AsyncLog*> g_async_log{nullptr};
+
+class AsyncLog {
+ public:
+  static AsyncLog* Get() {
+    static AsyncLog* log = new AsyncLog();
+    return log;
+  }
+
+  void Log(gpr_log_func_args* args) {
+    Message message;
+    message.file = args->file;
+    message.line = args->line;
+    message.severity = args->severity;
+    message.time = gpr_now(GPR_CLOCK_REALTIME);
+    message.tid = CurrentThreadId();
+    // GPR_ASSERT() and GPR_UNREACHABLE_CODE() abort right after logging, so
+    // their message must be on stderr before we return.
+    if (absl::StartsWith(args->message, "assertion failed: ") ||
+        absl::StartsWith(args->message, "UNREACHABLE CODE: ")) {
+      grpc_core::MutexLock lock(&write_mu_);
+      FlushLocked();
+      message.text = const_cast<char*>(args->message);
+      WriteMessage(message);
+      return;
+    }
+    if (!AllowedByRateLimit(args->file, args->line, message.time.tv_sec)) {
+      dropped_rate_limited_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    absl::optional<std::string> stack_trace =
+        gpr_should_log_stacktrace(args->severity)
+            ? grpc_core::GetCurrentStackTrace()
+            : absl::nullopt;
+    message.text = stack_trace.has_value()
+                       ? gpr_strdup(
+                             absl::StrCat(args->message, "\n", *stack_trace)
+                                 .c_str())
+                       : gpr_strdup(args->message);
+    if (!Push(message)) {
+      gpr_free(message.text);
+      dropped_queue_full_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    if (writer_waiting_.load(std::memory_order_relaxed)) cv_.Signal();
+  }
+
+  // Messages are written by one thread at a time and in queue order, so a
+  // flush waits for the writer thread to finish what it is writing.
+  void Flush() {
+    grpc_core::MutexLock lock(&write_mu_);
+    FlushLocked();
+  }
+
+  gpr_async_log_stats GetStats() {
+    gpr_async_log_stats stats;
+    stats.written = written_.load(std::memory_order_relaxed);
+    stats.dropped_queue_full =
+        dropped_queue_full_.load(std::memory_order_relaxed);
+    stats.dropped_rate_limited =
+        dropped_rate_limited_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+ private:
+  // One slot of the queue. sequence tells producers and consumers whose
+  // turn it is to use the slot.
+  struct Slot {
+    std::atomic<size_t> sequence;
+    Message message;
+  };
+
+  // Counts the messages logged by the log statements hashing to this slot
+  // during the second in which they were last logged.
+  struct RateLimitSlot {
+    std::atomic<int64_t> second{0};
+    std::atomic<int32_t> count{0};
+  };
+
+  AsyncLog()
+      : rate_limit_(GPR_GLOBAL_CONFIG_GET(grpc_async_log_rate_limit)) {
+    for (size_t i = 0; i < kQueueSize; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    writer_ = grpc_core::Thread(
+        "grpc_async_log", Run, this, nullptr,
+        grpc_core::Thread::Options().set_joinable(false).set_tracked(false));
+    writer_.Start();
+    g_async_log.store(this, std::memory_order_release);
+    // The writer thread is detached, so messages still queued at exit would
+    // be lost.
+    atexit([]() { g_async_log.load(std::memory_order_acquire)->Flush(); });
+  }
+
+  // A bounded multi-producer, multi-consumer queue, after Dmitry Vyukov's.
+  // Producers never wait on each other: a full queue fails the push.
+  bool Push(const Message& message) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot* slot = &slots_[pos & (kQueueSize - 1)];
+      size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          slot->message = message;
+          slot->sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool Pop(Message* message) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot* slot = &slots_[pos & (kQueueSize - 1)];
+      size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          *message = slot->message;
+          slot->sequence.store(pos + kQueueSize, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Log statements whose file and line hash to the same slot share their
+  // budget.
+  bool AllowedByRateLimit(const char* file, int line, int64_t second) {
+    if (rate_limit_ <= 0) return true;
+    RateLimitSlot* slot =
+        &rate_limit_slots_[(grpc_core::HashPointer(file, kRateLimitSlots) +
+                            static_cast<size_t>(line)) %
+                           kRateLimitSlots];
+    int64_t last_second = slot->second.load(std::memory_order_relaxed);
+    if (last_second != second &&
+        slot->second.compare_exchange_strong(last_second, second,
+                                             std::memory_order_relaxed)) {
+      slot->count.store(0, std::memory_order_relaxed);
+    }
+    return slot->count.fetch_add(1, std::memory_order_relaxed) < rate_limit_;
+  }
+
+  // Returns whether any message was written.
+  bool FlushLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(write_mu_) {
+    bool wrote = false;
+    Message message;
+    while (Pop(&message)) {
+      Write(message);
+      wrote = true;
+    }
+    return wrote;
+  }
+
+  void Write(const Message& message) {
+    WriteMessage(message);
+    gpr_free(message.text);
+    written_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Writes a line to stderr when messages were dropped since the last one.
+  void ReportDropped() ABSL_EXCLUSIVE_LOCKS_REQUIRED(write_mu_) {
+    uint64_t queue_full = dropped_queue_full_.load(std::memory_order_relaxed);
+    uint64_t rate_limited =
+        dropped_rate_limited_.load(std::memory_order_relaxed);
+    if (queue_full == reported_queue_full_ &&
+        rate_limited == reported_rate_limited_) {
+      return;
+    }
+    Message message;
+    message.file = __FILE__;
+    message.line = __LINE__;
+    message.severity = GPR_LOG_SEVERITY_ERROR;
+    message.time = gpr_now(GPR_CLOCK_REALTIME);
+    message.tid = CurrentThreadId();
+    std::string text = absl::StrCat(
+        "Dropped ", queue_full - reported_queue_full_,
+        " log messages because the queue was full, and ",
+        rate_limited - reported_rate_limited_,
+        " log messages because of GRPC_ASYNC_LOG_RATE_LIMIT");
+    message.text = const_cast<char*>(text.c_str());
+    WriteMessage(message);
+    reported_queue_full_ = queue_full;
+    reported_rate_limited_ = rate_limited;
+  }
+
+  static void Run(void* arg) {
+    AsyncLog* self = static_cast<AsyncLog*>(arg);
+    for (;;) {
+      {
+        grpc_core::MutexLock lock(&self->write_mu_);
+        const bool wrote = self->FlushLocked();
+        self->ReportDropped();
+        if (wrote) continue;
+      }
+      // Producers only signal while we wait; the timeout bounds the delay of
+      // a signal that raced with us going to sleep.
+      grpc_core::MutexLock lock(&self->mu_);
+      self->writer_waiting_.store(true, std::memory_order_relaxed);
+      self->cv_.WaitWithTimeout(&self->mu_, absl::Milliseconds(10));
+      self->writer_waiting_.store(false, std::memory_order_relaxed);
+    }
+  }
+
+  const int32_t rate_limit_;
+  Slot slots_[kQueueSize];
+  std::atomic<size_t> enqueue_pos_{0};
+  std::atomic<size_t> dequeue_pos_{0};
+  RateLimitSlot rate_limit_slots_[kRateLimitSlots];
+  std::atomic<uint64_t> written_{0};
+  std::atomic<uint64_t> dropped_queue_full_{0};
+  std::atomic<uint64_t> dropped_rate_limited_{0};
+  // Held while popping and writing messages.
+  grpc_core::Mutex write_mu_;
+  uint64_t reported_queue_full_ ABSL_GUARDED_BY(write_mu_) = 0;
+  uint64_t reported_rate_limited_ ABSL_GUARDED_BY(write_mu_) = 0;
+  grpc_core::Thread writer_;
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  std::atomic<bool> writer_waiting_{false};
+};
+
+}  // namespace
+
+void gpr_async_log(gpr_log_func_args* args) { AsyncLog::Get()->Log(args); }
+
+void gpr_async_log_flush() {
+  AsyncLog* log = g_async_log.load(std::memory_order_acquire);
+  if (log != nullptr) log->Flush();
+}
+
+gpr_async_log_stats gpr_async_log_get_stats() {
+  return AsyncLog::Get()->GetStats();
+}
+
+#else  // defined(GPR_LINUX_LOG) || defined(GPR_POSIX_LOG)
+
+void gpr_default_log(gpr_log_func_args* args);
+
+void gpr_async_log(gpr_log_func_args* args) { gpr_default_log(args); }
+
+void gpr_async_log_flush() {}
+
+gpr_async_log_stats gpr_async_log_get_stats() {
+  return gpr_async_log_stats{0, 0, 0};
+}
+
+#endif  // defined(GPR_LINUX_LOG) || defined(GPR_POSIX_LOG)
@@ -0,0 +1,56 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_GPR_LOG_ASYNC_H
+#define GRPC_CORE_LIB_GPR_LOG_ASYNC_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <grpc/support/log.h>
+
+/* A log function that queues messages for a background thread, which writes
+   them to stderr in the format of gpr_default_log, so that logging threads
+   (often pollers) never block on a slow stderr.
+
+   Messages are dropped rather than blocking the caller when the queue is
+   full, or when a single log statement logs more than
+   GRPC_ASYNC_LOG_RATE_LIMIT messages in a second. The writer reports how
+   many messages were dropped. Assertion failures are written synchronously,
+   after the queue, since the process is about to abort.
+
+   Installed by grpc_init() when GRPC_ASYNC_LOG is set, or with
+   gpr_set_log_function(gpr_async_log). On platforms without a POSIX log
+   implementation, messages are passed to gpr_default_log. */
+void gpr_async_log(gpr_log_func_args* args);
+
+/* Writes out all messages queued so far, on the calling thread, after any
+   message the background thread is writing. Called by grpc_shutdown() and
+   at process exit. */
+void gpr_async_log_flush();
+
+struct gpr_async_log_stats {
+  uint64_t written;
+  uint64_t dropped_queue_full;
+  uint64_t dropped_rate_limited;
+};
+
+gpr_async_log_stats gpr_async_log_get_stats();
+
+#endif /* GRPC_CORE_LIB_GPR_LOG_ASYNC_H */
@@ -62,7 +62,10 @@ static gpr_timespec gpr_from_timespec(struct timespec ts,
 static const clockid_t clockid_for_gpr_clock[] = {CLOCK_MONOTONIC,
                                                   CLOCK_REALTIME};
 
-void gpr_time_init(void) { gpr_precise_clock_init(); }
+void gpr_time_init(void) {
+  gpr_precise_clock_init();
+  gpr_fast_clock_init();
+}
 
 static gpr_timespec now_impl(gpr_clock_type clock_type) {
   struct timespec now;
@@ -20,16 +20,22 @@
 
 #if GPR_LINUX
 #include <fcntl.h>
+#include <time.h>
 #include <unistd.h>
+#if defined(__x86_64__) || defined(__amd64__)
+#include <cpuid.h>
+#endif
 #endif
 
 #include <algorithm>
+#include <atomic>
 
 #include <grpc/impl/codegen/gpr_types.h>
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
 
 #include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/gprpp/global_config.h"
 
 #ifndef GPR_CYCLE_COUNTER_CUSTOM
 #if GPR_CYCLE_COUNTER_RDTSC_32 || GPR_CYCLE_COUNTER_RDTSC_64
@@ -166,3 +172,156 @@ gpr_timespec gpr_cycle_counter_sub(gpr_cycle_counter a, gpr_cycle_counter b) {
 }
 #endif /* GPR_CYCLE_COUNTER_FALLBACK */
 #endif /* !GPR_CYCLE_COUNTER_CUSTOM */
+
+#if GPR_LINUX && (defined(__x86_64__) || defined(__amd64__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define GPR_FAST_CLOCK_TSC 1
+#endif
+
+#ifdef GPR_FAST_CLOCK_TSC
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(grpc_fast_clock, false,
+                              "If set, the monotonic clock read on hot paths "
+                              "is derived from the TSC when it is invariant");
+
+namespace {
+
+constexpr int64_t kFastClockResyncIntervalNs = GPR_NS_PER_SEC;
+constexpr int64_t kFastClockCalibrationNs = 10 * GPR_NS_PER_MS;
+
+int64_t ReadTsc() {
+  uint64_t low, high;
+  __asm__ volatile("rdtsc" : "=a"(low), "=d"(high));
+  return static_cast<int64_t>((high << 32) | low);
+}
+
+bool HasInvariantTsc() {
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) return false;
+  return (edx & (1u << 8)) != 0;
+}
+
+int64_t MonotonicNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * GPR_NS_PER_SEC + ts.tv_nsec;
+}
+
+// Reads the TSC and CLOCK_MONOTONIC at (nearly) the same instant.
+void ReadAnchor(int64_t* cycles, int64_t* ns) {
+  int64_t start = ReadTsc();
+  *ns = MonotonicNs();
+  *cycles = start + (ReadTsc() - start) / 2;
+}
+
+// The anchor maps TSC values to monotonic time:
+// ns = g_anchor_ns + (cycles - g_anchor_cycles) * g_ns_per_cycle.
+// It is updated under a seqlock, by one resyncing thread at a time.
+std::atomic<bool> g_fast_clock_enabled{false};
+std::atomic<uint32_t> g_anchor_seq{0};
+std::atomic<int64_t> g_anchor_cycles{0};
+std::atomic<int64_t> g_anchor_ns{0};
+std::atomic<double> g_ns_per_cycle{0};
+std::atomic<bool> g_resyncing{false};
+
+void StoreAnchor(int64_t cycles, int64_t ns, double ns_per_cycle) {
+  uint32_t seq = g_anchor_seq.load(std::memory_order_relaxed);
+  g_anchor_seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  g_anchor_cycles.store(cycles, std::memory_order_relaxed);
+  g_anchor_ns.store(ns, std::memory_order_relaxed);
+  g_ns_per_cycle.store(ns_per_cycle, std::memory_order_relaxed);
+  g_anchor_seq.store(seq + 2, std::memory_order_release);
+}
+
+// Re-anchors to CLOCK_MONOTONIC. The new anchor never moves the clock
+// backwards; instead, if the TSC-derived time ran ahead, the rate is slowed
+// so that the difference is absorbed over the next interval.
+void Resync() {
+  if (g_resyncing.exchange(true, std::memory_order_acquire)) return;
+  // Only the resyncing thread writes the anchor.
+  const int64_t anchor_cycles = g_anchor_cycles.load(std::memory_order_relaxed);
+  const int64_t anchor_ns = g_anchor_ns.load(std::memory_order_relaxed);
+  const double ns_per_cycle = g_ns_per_cycle.load(std::memory_order_relaxed);
+  int64_t cycles, ns;
+  ReadAnchor(&cycles, &ns);
+  // Another thread may have just resynced.
+  if ((cycles - anchor_cycles) * ns_per_cycle >= kFastClockResyncIntervalNs) {
+    double measured_ns_per_cycle =
+        static_cast<double>(ns - anchor_ns) / (cycles - anchor_cycles);
+    int64_t extrapolated_ns =
+        anchor_ns + static_cast<int64_t>((cycles - anchor_cycles) *
+                                         ns_per_cycle);
+    int64_t ahead_ns = std::min(extrapolated_ns - ns,
+                                kFastClockResyncIntervalNs / 2);
+    if (ahead_ns > 0) {
+      ns = extrapolated_ns;
+      measured_ns_per_cycle *=
+          static_cast<double>(kFastClockResyncIntervalNs - ahead_ns) /
+          kFastClockResyncIntervalNs;
+    }
+    StoreAnchor(cycles, ns, measured_ns_per_cycle);
+  }
+  g_resyncing.store(false, std::memory_order_release);
+}
+
+}  // namespace
+
+void gpr_fast_clock_init(void) {
+  if (g_fast_clock_enabled.load(std::memory_order_relaxed) ||
+      !GPR_GLOBAL_CONFIG_GET(grpc_fast_clock)) {
+    return;
+  }
+  if (!HasInvariantTsc()) {
+    gpr_log(GPR_INFO, "GRPC_FAST_CLOCK ignored: the TSC is not invariant");
+    return;
+  }
+  int64_t start_cycles, start_ns, end_cycles, end_ns;
+  ReadAnchor(&start_cycles, &start_ns);
+  do {
+    ReadAnchor(&end_cycles, &end_ns);
+  } while (end_ns - start_ns < kFastClockCalibrationNs);
+  if (end_cycles <= start_cycles) return;
+  StoreAnchor(end_cycles, end_ns,
+              static_cast<double>(end_ns - start_ns) /
+                  (end_cycles - start_cycles));
+  g_fast_clock_enabled.store(true, std::memory_order_release);
+}
+
+gpr_timespec gpr_fast_monotonic_now(void) {
+  if (!g_fast_clock_enabled.load(std::memory_order_acquire)) {
+    return gpr_now(GPR_CLOCK_MONOTONIC);
+  }
+  int64_t cycles = ReadTsc();
+  uint32_t seq;
+  int64_t anchor_cycles, anchor_ns;
+  double ns_per_cycle;
+  do {
+    seq = g_anchor_seq.load(std::memory_order_acquire);
+    anchor_cycles = g_anchor_cycles.load(std::memory_order_relaxed);
+    anchor_ns = g_anchor_ns.load(std::memory_order_relaxed);
+    ns_per_cycle = g_ns_per_cycle.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while ((seq & 1) != 0 ||
+           seq != g_anchor_seq.load(std::memory_order_relaxed));
+  // The TSC may have been read just before another thread moved the anchor.
+  int64_t elapsed_ns =
+      cycles > anchor_cycles
+          ? static_cast<int64_t>((cycles - anchor_cycles) * ns_per_cycle)
+          : 0;
+  if (GPR_UNLIKELY(elapsed_ns >= kFastClockResyncIntervalNs)) {
+    Resync();
+  }
+  int64_t ns = anchor_ns + elapsed_ns;
+  gpr_timespec ts;
+  ts.tv_sec = ns / GPR_NS_PER_SEC;
+  ts.tv_nsec = static_cast<int32_t>(ns % GPR_NS_PER_SEC);
+  ts.clock_type = GPR_CLOCK_MONOTONIC;
+  return ts;
+}
+#else  // GPR_FAST_CLOCK_TSC
+void gpr_fast_clock_init(void) {}
+
+gpr_timespec gpr_fast_monotonic_now(void) {
+  return gpr_now(GPR_CLOCK_MONOTONIC);
+}
+#endif  // GPR_FAST_CLOCK_TSC
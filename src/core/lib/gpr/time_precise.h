@@ -67,4 +67,12 @@ void gpr_precise_clock_now(gpr_timespec* clk);
 gpr_timespec gpr_cycle_counter_to_time(gpr_cycle_counter cycles);
 gpr_timespec gpr_cycle_counter_sub(gpr_cycle_counter a, gpr_cycle_counter b);
 
+// A GPR_CLOCK_MONOTONIC clock for code that reads the time very often, such
+// as ExecCtx::Now() and busy polling. With GRPC_FAST_CLOCK set, on x86-64
+// Linux with an invariant TSC, it extrapolates CLOCK_MONOTONIC from the TSC
+// instead of reading it, and resynchronizes with it every second. Otherwise
+// it is gpr_now(GPR_CLOCK_MONOTONIC).
+void gpr_fast_clock_init(void);
+gpr_timespec gpr_fast_monotonic_now(void);
+
 #endif /* GRPC_CORE_LIB_GPR_TIME_PRECISE_H */
@@ -0,0 +1,100 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_GPRPP_ALIAS_TABLE_H
+#define GRPC_CORE_LIB_GPRPP_ALIAS_TABLE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/types/span.h"
+
+namespace grpc_core {
+
+// Picks an index with a probability proportional to its weight in constant
+// time, from a single random number, using Vose's alias method.
+//
+// The table has one column per weight.  Sampling picks a column uniformly
+// with the high 32 bits of the random number, then keeps the column or
+// takes its alias by comparing the low 32 bits to the column's threshold.
+class AliasTable {
+ public:
+  // An empty table, on which Sample() must not be called.
+  AliasTable() = default;
+
+  // Builds the table in O(n).  The weights must not all be zero.
+  explicit AliasTable(absl::Span<const uint32_t> weights) {
+    const size_t n = weights.size();
+    uint64_t total = 0;
+    for (uint32_t weight : weights) total += weight;
+    columns_.resize(n);
+    // Each weight is scaled by n, so that a column of the average weight
+    // holds exactly `total`.
+    std::vector<uint64_t> scaled(n);
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    for (size_t i = 0; i < n; ++i) {
+      scaled[i] = static_cast<uint64_t>(weights[i]) * n;
+      (scaled[i] < total ? small : large).push_back(static_cast<uint32_t>(i));
+    }
+    // Fill each underfull column up with a piece of an overfull one.
+    while (!small.empty() && !large.empty()) {
+      uint32_t s = small.back();
+      small.pop_back();
+      uint32_t l = large.back();
+      columns_[s].threshold = static_cast<uint64_t>(
+          static_cast<double>(scaled[s]) / total * kOne);
+      columns_[s].alias = l;
+      scaled[l] -= total - scaled[s];
+      if (scaled[l] < total) {
+        large.pop_back();
+        small.push_back(l);
+      }
+    }
+    // The scaled weights of the columns left always sum to `total` times
+    // their count, so the columns left are exactly full.
+    for (uint32_t i : large) columns_[i] = {kOne, i};
+    for (uint32_t i : small) columns_[i] = {kOne, i};
+  }
+
+  // Returns an index in [0, size()), given 64 uniformly random bits.
+  size_t Sample(uint64_t random) const {
+    size_t column = static_cast<size_t>(((random >> 32) * columns_.size()) >>
+                                        32);
+    const Column& c = columns_[column];
+    return (random & 0xffffffffu) < c.threshold ? column : c.alias;
+  }
+
+  size_t size() const { return columns_.size(); }
+
+ private:
+  static constexpr uint64_t kOne = uint64_t(1) << 32;
+
+  struct Column {
+    // The column itself is picked when the low 32 bits of the random number
+    // are below this, out of kOne.
+    uint64_t threshold;
+    uint32_t alias;
+  };
+
+  std::vector<Column> columns_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_GPRPP_ALIAS_TABLE_H
@@ -0,0 +1,53 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/gprpp/fast_random.h"
+
+#include "absl/random/random.h"
+
+#include "src/core/lib/gpr/tls.h"
+
+namespace grpc_core {
+
+namespace {
+
+// The two words of the xoroshiro128+ state.  A thread's state is all zero
+// until it is seeded, and never again afterwards.
+GPR_THREAD_LOCAL(uint64_t) g_state0;
+GPR_THREAD_LOCAL(uint64_t) g_state1;
+
+uint64_t RotateLeft(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+}  // namespace
+
+uint64_t FastRandom64() {
+  uint64_t s0 = g_state0;
+  uint64_t s1 = g_state1;
+  if (GPR_UNLIKELY(s0 == 0 && s1 == 0)) {
+    absl::BitGen seed_gen;
+    do {
+      s0 = absl::Uniform<uint64_t>(seed_gen);
+      s1 = absl::Uniform<uint64_t>(seed_gen);
+    } while (s0 == 0 && s1 == 0);
+  }
+  const uint64_t result = s0 + s1;
+  s1 ^= s0;
+  g_state0 = RotateLeft(s0, 24) ^ s1 ^ (s1 << 16);
+  g_state1 = RotateLeft(s1, 37);
+  return result;
+}
+
+}  // namespace grpc_core
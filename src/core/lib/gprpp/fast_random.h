@@ -0,0 +1,63 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_GPRPP_FAST_RANDOM_H
+#define GRPC_CORE_LIB_GPRPP_FAST_RANDOM_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <limits>
+
+namespace grpc_core {
+
+// Returns 64 random bits from a per-thread xoroshiro128+ generator, seeded
+// from absl::BitGen the first time each thread uses it.  Much cheaper than
+// rand(), which may take a lock, or than constructing an absl::BitGen, and
+// safe to call from any thread without synchronization.
+//
+// Not suitable for anything security sensitive.
+uint64_t FastRandom64();
+
+// Returns a number uniformly distributed in [0, n).  \a n must not be zero.
+inline uint32_t FastRandomUniform(uint32_t n) {
+  // Lemire's multiply-shift; the bias is at most n / 2^32.
+  return static_cast<uint32_t>(((FastRandom64() >> 32) * n) >> 32);
+}
+
+// Returns a double uniformly distributed in [0, 1).
+inline double FastRandomDouble() {
+  return static_cast<double>(FastRandom64() >> 11) /
+         static_cast<double>(uint64_t(1) << 53);
+}
+
+// A uniform random bit generator over FastRandom64(), for use with the
+// absl::Uniform() family of distributions.  It has no state of its own.
+struct FastRandomBitGen {
+  using result_type = uint64_t;
+
+  static constexpr result_type(min)() {
+    return (std::numeric_limits<result_type>::min)();
+  }
+  static constexpr result_type(max)() {
+    return (std::numeric_limits<result_type>::max)();
+  }
+
+  result_type operator()() { return FastRandom64(); }
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_GPRPP_FAST_RANDOM_H
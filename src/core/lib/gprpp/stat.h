@@ -19,6 +19,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
 #include <time.h>
 
 #include "absl/status/status.h"
@@ -31,6 +32,28 @@ namespace grpc_core {
 // StatusCode::kInternal will be returned.
 absl::Status GetFileModificationTime(const char* filename, time_t* timestamp);
 
+// Identifies the contents of a file without reading them: writing to the file
+// or replacing it changes its version.
+struct FileVersion {
+  uint64_t device = 0;
+  uint64_t inode = 0;
+  int64_t size = 0;
+  int64_t mtime_ns = 0;
+  int64_t ctime_ns = 0;
+
+  bool operator==(const FileVersion& other) const {
+    return device == other.device && inode == other.inode &&
+           size == other.size && mtime_ns == other.mtime_ns &&
+           ctime_ns == other.ctime_ns;
+  }
+  bool operator!=(const FileVersion& other) const { return !(*this == other); }
+};
+
+// Gets the version of a file. Returns StatusCode::kUnimplemented where file
+// times are too coarse to tell versions apart, and StatusCode::kInternal if
+// the file cannot be stat'ed.
+absl::Status GetFileVersion(const char* filename, FileVersion* version);
+
 }  // namespace grpc_core
 
 #endif  // GRPC_CORE_LIB_GPRPP_STAT_H
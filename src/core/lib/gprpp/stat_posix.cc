@@ -49,6 +49,31 @@ absl::Status GetFileModificationTime(const char* filename, time_t* timestamp) {
   return absl::OkStatus();
 }
 
+absl::Status GetFileVersion(const char* filename, FileVersion* version) {
+  GPR_ASSERT(filename != nullptr);
+  GPR_ASSERT(version != nullptr);
+  struct stat buf;
+  if (stat(filename, &buf) != 0) {
+    const char* error_msg = strerror(errno);
+    return absl::Status(absl::StatusCode::kInternal, error_msg);
+  }
+#ifdef GPR_APPLE
+  const struct timespec& mtime = buf.st_mtimespec;
+  const struct timespec& ctime = buf.st_ctimespec;
+#else
+  const struct timespec& mtime = buf.st_mtim;
+  const struct timespec& ctime = buf.st_ctim;
+#endif
+  version->device = static_cast<uint64_t>(buf.st_dev);
+  version->inode = static_cast<uint64_t>(buf.st_ino);
+  version->size = static_cast<int64_t>(buf.st_size);
+  version->mtime_ns = static_cast<int64_t>(mtime.tv_sec) * 1000000000 +
+                      static_cast<int64_t>(mtime.tv_nsec);
+  version->ctime_ns = static_cast<int64_t>(ctime.tv_sec) * 1000000000 +
+                      static_cast<int64_t>(ctime.tv_nsec);
+  return absl::OkStatus();
+}
+
 }  // namespace grpc_core
 
 #endif  // GPR_POSIX_STAT
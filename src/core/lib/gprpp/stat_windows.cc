@@ -43,6 +43,13 @@ absl::Status GetFileModificationTime(const char* filename, time_t* timestamp) {
   return absl::OkStatus();
 }
 
+absl::Status GetFileVersion(const char* /*filename*/,
+                            FileVersion* /*version*/) {
+  // _stat only has second resolution, so a file rewritten within a second
+  // would keep its version.
+  return absl::UnimplementedError("file versions are not supported");
+}
+
 }  // namespace grpc_core
 
 #endif  // GPR_WINDOWS_STAT
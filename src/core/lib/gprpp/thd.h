@@ -44,7 +44,12 @@ class Thread {
  public:
   class Options {
    public:
-    Options() : joinable_(true), tracked_(true), stack_size_(0) {}
+    Options()
+        : joinable_(true),
+          tracked_(true),
+          stack_size_(0),
+          cpu_(-1),
+          numa_node_(-1) {}
     /// Set whether the thread is joinable or detached.
     Options& set_joinable(bool joinable) {
       joinable_ = joinable;
@@ -67,10 +72,29 @@ class Thread {
     }
     size_t stack_size() const { return stack_size_; }
 
+    /// Sets the CPU the thread runs on. -1, the default, leaves the thread
+    /// free to run on any CPU. Only honored on Linux, and best effort.
+    Options& set_cpu(int cpu) {
+      cpu_ = cpu;
+      return *this;
+    }
+    int cpu() const { return cpu_; }
+
+    /// Restricts the thread to the CPUs of NUMA node \a node, unless a CPU
+    /// is set. -1, the default, leaves it free. Only honored on Linux, and
+    /// best effort.
+    Options& set_numa_node(int node) {
+      numa_node_ = node;
+      return *this;
+    }
+    int numa_node() const { return numa_node_; }
+
    private:
     bool joinable_;
     bool tracked_;
     size_t stack_size_;
+    int cpu_;
+    int numa_node_;
   };
   /// Default constructor only to allow use in structs that lack constructors
   /// Does not produce a validly-constructed thread; must later
@@ -26,14 +26,21 @@
 #ifdef GPR_POSIX_SYNC
 
 #include <pthread.h>
+#ifdef GPR_LINUX
+#include <sched.h>
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
+#include <algorithm>
+
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/thd_id.h>
 
+#include "src/core/lib/gpr/cpu_numa.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/fork.h"
 #include "src/core/lib/gprpp/thd.h"
@@ -49,8 +56,39 @@ struct thd_arg {
   const char* name;        /* name of thread. Can be nullptr. */
   bool joinable;
   bool tracked;
+  int cpu;       /* CPU to pin the thread to, or -1 */
+  int numa_node; /* NUMA node to restrict the thread to, or -1 */
 };
 
+// Restricts the calling thread to \a cpu, or else to the CPUs of
+// \a numa_node. Best effort: they may be outside of the process' allowed set.
+void SetAffinity(int cpu, int numa_node) {
+#ifdef GPR_LINUX
+  if (cpu < 0 && numa_node < 0) return;
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  if (cpu >= 0) {
+    if (cpu >= CPU_SETSIZE) return;
+    CPU_SET(cpu, &cpus);
+  } else {
+    unsigned ncpus = std::min<unsigned>(gpr_cpu_num_cores(), CPU_SETSIZE);
+    for (unsigned i = 0; i < ncpus; i++) {
+      if (gpr_numa_node_of_cpu(i) == static_cast<unsigned>(numa_node)) {
+        CPU_SET(i, &cpus);
+      }
+    }
+  }
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+    gpr_log(GPR_ERROR,
+            "Could not set the affinity of a thread (cpu %d, node %d)", cpu,
+            numa_node);
+  }
+#else
+  (void)cpu;
+  (void)numa_node;
+#endif  // GPR_LINUX
+}
+
 size_t RoundUpToPageSize(size_t size) {
   // TODO(yunjiaw): Change this variable (page_size) to a function-level static
   // when possible
@@ -89,6 +127,8 @@ class ThreadInternalsPosix : public internal::ThreadInternalsInterface {
     info->name = thd_name;
     info->joinable = options.joinable();
     info->tracked = options.tracked();
+    info->cpu = options.cpu();
+    info->numa_node = options.numa_node();
     if (options.tracked()) {
       Fork::IncThreadCount();
     }
@@ -127,6 +167,7 @@ class ThreadInternalsPosix : public internal::ThreadInternalsInterface {
                         pthread_setname_np(pthread_self(), buf);
 #endif  // GPR_APPLE_PTHREAD_NAME
                       }
+                      SetAffinity(arg.cpu, arg.numa_node);
 
                       gpr_mu_lock(&arg.thread->mu_);
                       while (!arg.thread->started_) {
@@ -157,9 +157,10 @@ class HttpRequestSSLCredentials : public grpc_channel_credentials {
       RefCountedPtr<grpc_call_credentials> /*call_creds*/, const char* target,
       const grpc_channel_args* args,
       grpc_channel_args** /*new_args*/) override {
-    const char* pem_root_certs = DefaultSslRootStore::GetPemRootCerts();
-    const tsi_ssl_root_certs_store* root_store =
-        DefaultSslRootStore::GetRootStore();
+    RefCountedPtr<DefaultSslRootStore::Roots> default_roots =
+        DefaultSslRootStore::Get();
+    const char* pem_root_certs = default_roots->pem_root_certs();
+    const tsi_ssl_root_certs_store* root_store = default_roots->root_store();
     if (root_store == nullptr) {
       gpr_log(GPR_ERROR, "Could not get default pem root certs.");
       return nullptr;
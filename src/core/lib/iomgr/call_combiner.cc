@@ -160,6 +160,25 @@ void CallCombiner::Start(grpc_closure* closure, grpc_error_handle error,
   }
 }
 
+bool CallCombiner::TryStartInline(const char* reason) {
+#ifdef GRPC_TSAN_ENABLED
+  // Actions must go through TsanClosure() for TSAN to see the lock.
+  (void)reason;
+  return false;
+#else
+  if (!gpr_atm_full_cas(&size_, 0, 1)) return false;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_call_combiner_trace)) {
+    gpr_log(GPR_INFO,
+            "==> CallCombiner::TryStartInline() [%p] [%s]: size: 0 -> 1, "
+            "EXECUTING INLINE",
+            this, reason);
+  }
+  GRPC_STATS_INC_CALL_COMBINER_LOCKS_SCHEDULED_ITEMS();
+  GRPC_STATS_INC_CALL_COMBINER_LOCKS_INITIATED();
+  return true;
+#endif
+}
+
 void CallCombiner::Stop(DEBUG_ARGS const char* reason) {
   GPR_TIMER_SCOPE("CallCombiner::Stop", 0);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_call_combiner_trace)) {
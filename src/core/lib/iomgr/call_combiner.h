@@ -74,6 +74,17 @@ class CallCombiner {
   void Stop(const char* reason);
 #endif
 
+  /// Takes the call combiner if nothing is running or queued on it, in which
+  /// case the caller must run its action inline, as if it were a closure
+  /// passed to Start(), and yield with GRPC_CALL_COMBINER_STOP() when done.
+  /// Returns false without doing anything if the call combiner is busy: the
+  /// caller must then use GRPC_CALL_COMBINER_START() instead.
+  ///
+  /// This saves scheduling a closure when an action is known not to race
+  /// with anything in the common case. It must only be used where running
+  /// the action inline is safe, i.e. where the caller holds no locks.
+  bool TryStartInline(const char* reason);
+
   /// Registers \a closure to be invoked when Cancel() is called.
   ///
   /// Once a closure is registered, it will always be scheduled exactly
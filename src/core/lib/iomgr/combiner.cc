@@ -27,9 +27,12 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/mpscq.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
+#include "src/core/lib/profiling/timers.h"
 
 grpc_core::DebugOnlyTraceFlag grpc_combiner_trace(false, "combiner");
 
@@ -43,6 +46,29 @@ grpc_core::DebugOnlyTraceFlag grpc_combiner_trace(false, "combiner");
 #define STATE_UNORPHANED 1
 #define STATE_ELEM_COUNT_LOW_BIT 2
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_combiner_offload_run_us, 1000,
+    "Declares how long, in microseconds, a combiner may run on a thread other "
+    "than an executor thread before the rest of its work is offloaded to the "
+    "executor. Set to 0 to never offload because of run time.");
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_combiner_offload_queue_depth, 256,
+    "Declares how many items may be queued on a combiner running on a thread "
+    "other than an executor thread before the rest of its work is offloaded "
+    "to the executor. Set to 0 to never offload because of queue depth.");
+
+// Set only once in grpc_combiner_global_init().
+static int64_t g_offload_run_us;
+static intptr_t g_offload_queue_depth;
+
+void grpc_combiner_global_init() {
+  int32_t run_us = GPR_GLOBAL_CONFIG_GET(grpc_combiner_offload_run_us);
+  int32_t queue_depth =
+      GPR_GLOBAL_CONFIG_GET(grpc_combiner_offload_queue_depth);
+  g_offload_run_us = run_us > 0 ? run_us : 0;
+  g_offload_queue_depth = queue_depth > 0 ? queue_depth : 0;
+}
+
 static void combiner_exec(grpc_core::Combiner* lock, grpc_closure* closure,
                           grpc_error_handle error);
 static void combiner_finally_exec(grpc_core::Combiner* lock,
@@ -126,11 +152,13 @@ static void push_first_on_exec_ctx(grpc_core::Combiner* lock) {
 
 static void combiner_exec(grpc_core::Combiner* lock, grpc_closure* cl,
                           grpc_error_handle error) {
+  GPR_TIMER_SCOPE("combiner.execute", 0);
   gpr_atm last = gpr_atm_full_fetch_add(&lock->state, STATE_ELEM_COUNT_LOW_BIT);
   GRPC_COMBINER_TRACE(gpr_log(GPR_INFO,
                               "C:%p grpc_combiner_execute c=%p last=%" PRIdPTR,
                               lock, cl, last));
   if (last == 1) {
+    lock->run_start = gpr_get_cycle_counter();
     gpr_atm_no_barrier_store(
         &lock->initiating_exec_ctx_or_null,
         reinterpret_cast<gpr_atm>(grpc_core::ExecCtx::Get()));
@@ -169,16 +197,36 @@ static void move_next() {
 
 static void offload(void* arg, grpc_error_handle /*error*/) {
   grpc_core::Combiner* lock = static_cast<grpc_core::Combiner*>(arg);
+  lock->run_start = gpr_get_cycle_counter();
   push_last_on_exec_ctx(lock);
 }
 
+// Returns true if the combiner has run on the current thread, or has had work
+// queued, for longer than allowed. Executor threads are where overrunning
+// combiners are offloaded to, so they always run the combiner to completion.
+static bool overran(grpc_core::Combiner* lock) {
+  if (grpc_core::ExecCtx::Get()->flags() &
+      GRPC_EXEC_CTX_FLAG_IS_INTERNAL_THREAD) {
+    return false;
+  }
+  if (g_offload_queue_depth > 0 &&
+      (gpr_atm_no_barrier_load(&lock->state) >> 1) > g_offload_queue_depth) {
+    return true;
+  }
+  return g_offload_run_us > 0 &&
+         grpc_stats_micros_since(lock->run_start) > g_offload_run_us;
+}
+
 static void queue_offload(grpc_core::Combiner* lock) {
+  GRPC_STATS_INC_COMBINER_RUN_MICROS(grpc_stats_micros_since(lock->run_start));
+  GRPC_STATS_INC_COMBINER_LOCKS_OFFLOADED();
   move_next();
   GRPC_COMBINER_TRACE(gpr_log(GPR_INFO, "C:%p queue_offload", lock));
   grpc_core::Executor::Run(&lock->offload, GRPC_ERROR_NONE);
 }
 
 bool grpc_combiner_continue_exec_ctx() {
+  GPR_TIMER_SCOPE("combiner.continue_exec_ctx", 0);
   grpc_core::Combiner* lock =
       grpc_core::ExecCtx::Get()->combiner_data()->active_combiner;
   if (lock == nullptr) {
@@ -198,11 +246,14 @@ bool grpc_combiner_continue_exec_ctx() {
                               lock->time_to_execute_final_list));
 
   // offload only if all the following conditions are true:
-  // 1. the combiner is contended and has more than one closure to execute
-  // 2. the current execution context needs to finish as soon as possible
-  // 3. the current thread is not a worker for any background poller
-  // 4. the DEFAULT executor is threaded
-  if (contended && grpc_core::ExecCtx::Get()->IsReadyToFinish() &&
+  // 1. either the combiner is contended and has more than one closure to
+  //    execute, and the current execution context needs to finish as soon as
+  //    possible; or the combiner has overrun its time or queue depth budget
+  //    on a thread that is not an executor thread
+  // 2. the current thread is not a worker for any background poller
+  // 3. the DEFAULT executor is threaded
+  if (((contended && grpc_core::ExecCtx::Get()->IsReadyToFinish()) ||
+       overran(lock)) &&
       !grpc_iomgr_platform_is_any_background_poller_thread() &&
       grpc_core::Executor::IsThreadedDefault()) {
     // this execution context wants to move on: schedule remaining work to be
@@ -270,6 +321,8 @@ bool grpc_combiner_continue_exec_ctx() {
 
   move_next();
   lock->time_to_execute_final_list = false;
+  // read before releasing the lock, after which another thread may acquire it
+  gpr_cycle_counter run_start = lock->run_start;
   gpr_atm old_state =
       gpr_atm_full_fetch_add(&lock->state, -STATE_ELEM_COUNT_LOW_BIT);
   GRPC_COMBINER_TRACE(
@@ -293,9 +346,11 @@ bool grpc_combiner_continue_exec_ctx() {
       break;
     case OLD_STATE_WAS(false, 1):
       // had one count, one unorphaned --> unlocked unorphaned
+      GRPC_STATS_INC_COMBINER_RUN_MICROS(grpc_stats_micros_since(run_start));
       return true;
     case OLD_STATE_WAS(true, 1):
       // and one count, one orphaned --> unlocked and orphaned
+      GRPC_STATS_INC_COMBINER_RUN_MICROS(grpc_stats_micros_since(run_start));
       really_destroy(lock);
       return true;
     case OLD_STATE_WAS(false, 0):
@@ -313,6 +368,7 @@ static void enqueue_finally(void* closure, grpc_error_handle error);
 static void combiner_finally_exec(grpc_core::Combiner* lock,
                                   grpc_closure* closure,
                                   grpc_error_handle error) {
+  GPR_TIMER_SCOPE("combiner.execute_finally", 0);
   GPR_ASSERT(lock != nullptr);
   GRPC_COMBINER_TRACE(gpr_log(
       GPR_INFO, "C:%p grpc_combiner_execute_finally c=%p; ac=%p", lock, closure,
@@ -26,6 +26,7 @@
 #include <grpc/support/atm.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 
 namespace grpc_core {
@@ -48,6 +49,9 @@ class Combiner {
   // other bits - number of items queued on the lock (STATE_ELEM_COUNT_LOW_BIT)
   gpr_atm state;
   bool time_to_execute_final_list = false;
+  // when the thread currently running the combiner acquired it, or picked it
+  // up from the executor
+  gpr_cycle_counter run_start;
   grpc_closure_list final_list;
   grpc_closure offload;
   gpr_refcount refs;
@@ -84,6 +88,9 @@ void grpc_combiner_unref(grpc_core::Combiner* lock GRPC_COMBINER_DEBUG_ARGS);
 
 bool grpc_combiner_continue_exec_ctx();
 
+// Reads the combiner offload thresholds from the environment.
+void grpc_combiner_global_init();
+
 extern grpc_core::DebugOnlyTraceFlag grpc_combiner_trace;
 
 #endif /* GRPC_CORE_LIB_IOMGR_COMBINER_H */
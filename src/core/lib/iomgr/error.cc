@@ -39,6 +39,7 @@
 grpc_core::DebugOnlyTraceFlag grpc_trace_error_refcount(false,
                                                         "error_refcount");
 grpc_core::DebugOnlyTraceFlag grpc_trace_closure(false, "closure");
+grpc_core::TraceFlag grpc_trace_error_details(false, "error_details");
 
 static gpr_atm g_error_creation_allowed = true;
 
@@ -986,3 +987,56 @@ bool grpc_log_error(const char* what, grpc_error_handle error, const char* file,
 }
 
 #endif  // GRPC_ERROR_IS_ABSEIL_STATUS
+
+namespace {
+
+grpc_error_handle CreateStatusError(const char* file, int line,
+                                    const char* desc,
+                                    grpc_status_code status) {
+#ifdef GRPC_ERROR_IS_ABSEIL_STATUS
+  absl::Status error =
+      grpc_core::StatusCreate(absl::StatusCode::kUnknown, desc,
+                              grpc_core::DebugLocation(file, line), {});
+#else
+  grpc_error_handle error =
+      grpc_error_create(file, line, grpc_slice_from_static_string(desc),
+                        nullptr, 0);
+#endif
+  return grpc_error_set_int(error, GRPC_ERROR_INT_GRPC_STATUS, status);
+}
+
+// The returned error is never released, and callers hand out references to
+// it. In legacy mode, grpc_error_set_int() and friends copy it on write since
+// it is never uniquely referenced.
+grpc_error_handle* NewSharedStatusError(const char* desc,
+                                        grpc_status_code status) {
+#ifdef GRPC_ERROR_IS_ABSEIL_STATUS
+  absl::Status error(absl::StatusCode::kUnknown, desc);
+#else
+  grpc_error_handle error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(desc);
+#endif
+  return new grpc_error_handle(
+      grpc_error_set_int(error, GRPC_ERROR_INT_GRPC_STATUS, status));
+}
+
+}  // namespace
+
+grpc_error_handle grpc_error_deadline_exceeded(const char* file, int line) {
+  if (GPR_UNLIKELY(grpc_trace_error_details.enabled())) {
+    return CreateStatusError(file, line, "Deadline Exceeded",
+                             GRPC_STATUS_DEADLINE_EXCEEDED);
+  }
+  static const grpc_error_handle* shared = NewSharedStatusError(
+      "Deadline Exceeded", GRPC_STATUS_DEADLINE_EXCEEDED);
+  return GRPC_ERROR_REF(*shared);
+}
+
+grpc_error_handle grpc_error_transport_closed(const char* file, int line) {
+  if (GPR_UNLIKELY(grpc_trace_error_details.enabled())) {
+    return CreateStatusError(file, line, "Transport closed",
+                             GRPC_STATUS_UNAVAILABLE);
+  }
+  static const grpc_error_handle* shared =
+      NewSharedStatusError("Transport closed", GRPC_STATUS_UNAVAILABLE);
+  return GRPC_ERROR_REF(*shared);
+}
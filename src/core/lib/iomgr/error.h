@@ -394,6 +394,21 @@ inline bool grpc_log_if_error(const char* what, grpc_error_handle error,
 #define GRPC_LOG_IF_ERROR(what, error) \
   (grpc_log_if_error((what), (error), __FILE__, __LINE__))
 
+extern grpc_core::TraceFlag grpc_trace_error_details;
+
+/// Errors for the failures that end many calls at once. Each carries only a
+/// static description and a grpc status, and is created once and shared by
+/// reference, so that failing a call this way does not allocate. With the
+/// error_details trace enabled, a new error recording \a file and \a line is
+/// created for every call instead.
+grpc_error_handle grpc_error_deadline_exceeded(const char* file, int line);
+grpc_error_handle grpc_error_transport_closed(const char* file, int line);
+
+#define GRPC_ERROR_DEADLINE_EXCEEDED() \
+  grpc_error_deadline_exceeded(__FILE__, __LINE__)
+#define GRPC_ERROR_TRANSPORT_CLOSED() \
+  grpc_error_transport_closed(__FILE__, __LINE__)
+
 /// Helper class to get & set grpc_error_handle in a thread-safe fashion.
 /// This could be considered as atomic<grpc_error_handle>.
 class AtomicError {
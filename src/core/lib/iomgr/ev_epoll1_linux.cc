@@ -36,6 +36,8 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -48,14 +50,17 @@
 
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/iomgr/block_annotate.h"
 #include "src/core/lib/iomgr/ev_epoll1_linux.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 #include "src/core/lib/iomgr/lockfree_event.h"
+#include "src/core/lib/iomgr/socket_utils_posix.h"
 #include "src/core/lib/iomgr/wakeup_fd_posix.h"
 #include "src/core/lib/profiling/timers.h"
 
@@ -93,6 +98,49 @@ typedef struct epoll_set {
 /* The global singleton epoll set */
 static epoll_set g_epoll_set;
 
+/*******************************************************************************
+ * Busy polling related fields
+ */
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_epoll1_busy_poll_us, 0,
+    "Declares the longest time, in microseconds, that the epoll1 polling "
+    "engine spins on non-blocking epoll_wait calls before it blocks. The time "
+    "actually spent spinning adapts to how soon events arrive. Also requests "
+    "busy polling on sockets (SO_BUSY_POLL, SO_PREFER_BUSY_POLL). Set to 0 to "
+    "disable busy polling.");
+
+/* NOTE ON SYNCHRONIZATION: As with g_epoll_set, budget_us is only read and
+   updated by the designated poller; it is atomic for memory visibility only.
+   max_us is fixed when the engine is initialized. */
+typedef struct busy_poll_state {
+  /* The longest allowed spin. Zero if busy polling is disabled */
+  int64_t max_us;
+
+  /* The length of the next spin, between 0 and max_us */
+  gpr_atm budget_us;
+
+  /* Set once a failure to mark sockets for busy polling has been logged */
+  gpr_atm logged_sockopt_failure;
+} busy_poll_state;
+
+static busy_poll_state g_busy_poll;
+
+/*******************************************************************************
+ * Exec ctx flush budget
+ */
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_epoll1_flush_budget, 0,
+    "Declares the most closures that an epoll1 polling thread runs each time "
+    "it finishes a poll; the rest run after its next poll, which does not "
+    "block. Bounds how long the callbacks of one busy connection can delay "
+    "events on the other connections of the poller. Set to 0 for no limit.");
+
+/* The most closures run by each flush in end_worker(), or 0 for no limit.
+   Fixed when the engine is initialized. */
+static size_t g_flush_budget;
+
 static int epoll_create_and_cloexec() {
 #ifdef GRPC_LINUX_EPOLL_CREATE1
   int fd = epoll_create1(EPOLL_CLOEXEC);
@@ -182,6 +230,7 @@ static const char* kick_state_string(kick_state st) {
 struct grpc_pollset_worker {
   kick_state state;
   int kick_state_mutator;  // which line of code last changed kick state
+  gpr_cycle_counter kick_state_cycle;  // when kick state last changed
   bool initialized_cv;
   grpc_pollset_worker* next;
   grpc_pollset_worker* prev;
@@ -189,10 +238,11 @@ struct grpc_pollset_worker {
   grpc_closure_list schedule_on_end_work;
 };
 
-#define SET_KICK_STATE(worker, kick_state)   \
-  do {                                       \
-    (worker)->state = (kick_state);          \
-    (worker)->kick_state_mutator = __LINE__; \
+#define SET_KICK_STATE(worker, kick_state)                \
+  do {                                                    \
+    (worker)->state = (kick_state);                       \
+    (worker)->kick_state_mutator = __LINE__;              \
+    (worker)->kick_state_cycle = gpr_get_cycle_counter(); \
   } while (false)
 
 #define MAX_NEIGHBORHOODS 1024u
@@ -373,6 +423,19 @@ static grpc_fd* fd_create(int fd, const char* name, bool track_err) {
     gpr_log(GPR_ERROR, "epoll_ctl failed: %s", strerror(errno));
   }
 
+  if (g_busy_poll.max_us > 0) {
+    grpc_error_handle err = grpc_set_socket_busy_poll(
+        fd, static_cast<int>(g_busy_poll.max_us));
+    if (err != GRPC_ERROR_NONE &&
+        gpr_atm_no_barrier_cas(&g_busy_poll.logged_sockopt_failure, 0, 1)) {
+      gpr_log(GPR_INFO,
+              "Could not enable socket busy polling, epoll1 will spin "
+              "without it: %s",
+              grpc_error_std_string(err).c_str());
+    }
+    GRPC_ERROR_UNREF(err);
+  }
+
   return new_fd;
 }
 
@@ -704,6 +767,53 @@ static grpc_error_handle process_epoll_events(grpc_pollset* /*pollset*/) {
   return error;
 }
 
+static int64_t busy_poll_now_us() {
+  gpr_timespec now = gpr_fast_monotonic_now();
+  return now.tv_sec * GPR_US_PER_SEC + now.tv_nsec / GPR_NS_PER_US;
+}
+
+/* Spins on non-blocking epoll_wait calls, starting at start_us, until events
+   arrive or the busy-poll budget (capped by timeout, in milliseconds) runs out.
+   Returns the result of the last epoll_wait call: the number of events, 0 if
+   the budget ran out, or -1 on error. */
+static int busy_poll_spin(int64_t start_us, int timeout) {
+  int64_t budget_us = gpr_atm_no_barrier_load(&g_busy_poll.budget_us);
+  if (timeout > 0) {
+    budget_us = std::min(budget_us, int64_t{timeout} * GPR_US_PER_MS);
+  }
+  int64_t now_us;
+  int r;
+  for (;;) {
+    GRPC_STATS_INC_SYSCALL_POLL();
+    r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS, 0);
+    if (r < 0 && errno != EINTR) return r;
+    now_us = busy_poll_now_us();
+    if (r > 0 || now_us - start_us >= budget_us) break;
+  }
+  GRPC_STATS_INC_BUSY_POLL_SPIN_MICROS(now_us - start_us);
+  if (r > 0) {
+    GRPC_STATS_INC_BUSY_POLL_HITS();
+    return r;
+  }
+  GRPC_STATS_INC_BUSY_POLL_MISSES();
+  return 0;
+}
+
+/* Adapts the busy-poll budget to how long the poller waited for its last
+   batch of events. While events keep arriving within max_us, the budget
+   moves towards twice the recent wait; once they don't, it halves, so that
+   idle pollers quickly go back to blocking straight away. */
+static void busy_poll_update_budget(int64_t waited_us, bool got_events) {
+  int64_t budget_us = gpr_atm_no_barrier_load(&g_busy_poll.budget_us);
+  if (got_events && waited_us <= g_busy_poll.max_us) {
+    int64_t target_us = std::min(g_busy_poll.max_us, 2 * waited_us + 1);
+    budget_us = (3 * budget_us + target_us + 3) / 4;
+  } else {
+    budget_us /= 2;
+  }
+  gpr_atm_no_barrier_store(&g_busy_poll.budget_us, budget_us);
+}
+
 /* Do epoll_wait and store the events in g_epoll_set.events field. This does not
    "process" any of the events yet; that is done in process_epoll_events().
    *See process_epoll_events() function for more details.
@@ -715,18 +825,34 @@ static grpc_error_handle do_epoll_wait(grpc_pollset* ps,
                                        grpc_core::Timestamp deadline) {
   GPR_TIMER_SCOPE("do_epoll_wait", 0);
 
-  int r;
+  int r = 0;
   int timeout = poll_deadline_to_millis_timeout(deadline);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_START_BLOCKING_REGION;
+  int64_t busy_poll_start_us = 0;
+  bool busy_poll = timeout != 0 && g_busy_poll.max_us > 0;
+  if (busy_poll) {
+    busy_poll_start_us = busy_poll_now_us();
+    if (gpr_atm_no_barrier_load(&g_busy_poll.budget_us) > 0) {
+      r = busy_poll_spin(busy_poll_start_us, timeout);
+    }
   }
-  do {
-    GRPC_STATS_INC_SYSCALL_POLL();
-    r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
-                   timeout);
-  } while (r < 0 && errno == EINTR);
-  if (timeout != 0) {
-    GRPC_SCHEDULING_END_BLOCKING_REGION;
+  if (r == 0) {
+    if (timeout != 0) {
+      GRPC_SCHEDULING_START_BLOCKING_REGION;
+    }
+    do {
+      GRPC_STATS_INC_SYSCALL_POLL();
+      if (timeout != 0) {
+        GRPC_STATS_INC_SYSCALL_WAIT();
+      }
+      r = epoll_wait(g_epoll_set.epfd, g_epoll_set.events, MAX_EPOLL_EVENTS,
+                     timeout);
+    } while (r < 0 && errno == EINTR);
+    if (timeout != 0) {
+      GRPC_SCHEDULING_END_BLOCKING_REGION;
+    }
+  }
+  if (busy_poll && r >= 0) {
+    busy_poll_update_budget(busy_poll_now_us() - busy_poll_start_us, r > 0);
   }
 
   if (r < 0) return GRPC_OS_ERROR(errno, "epoll_wait");
@@ -824,6 +950,7 @@ static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
     GPR_ASSERT(gpr_atm_no_barrier_load(&g_active_poller) != (gpr_atm)worker);
     worker->initialized_cv = true;
     gpr_cv_init(&worker->cv);
+    bool timed_out = false;
     while (worker->state == UNKICKED && !pollset->shutting_down) {
       if (GRPC_TRACE_FLAG_ENABLED(grpc_polling_trace)) {
         gpr_log(GPR_INFO, "PS:%p BEGIN_WAIT:%p kick_state=%s shutdown=%d",
@@ -837,8 +964,13 @@ static bool begin_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
         /* If gpr_cv_wait returns true (i.e a timeout), pretend that the worker
            received a kick */
         SET_KICK_STATE(worker, KICKED);
+        timed_out = true;
       }
     }
+    if (!timed_out && worker->state != UNKICKED) {
+      GRPC_STATS_INC_POLLSET_WAKEUP_MICROS(
+          grpc_stats_micros_since(worker->kick_state_cycle));
+    }
     grpc_core::ExecCtx::Get()->InvalidateNow();
   }
 
@@ -932,6 +1064,19 @@ static bool check_neighborhood_for_available_poller(
   return found_worker;
 }
 
+/* Runs the closures queued on the exec_ctx of a polling thread, leaving any
+   beyond g_flush_budget queued for the thread's next poll. */
+static void flush_exec_ctx() {
+  gpr_cycle_counter start = gpr_get_cycle_counter();
+  size_t ran = grpc_core::ExecCtx::Get()->FlushWithBudget(
+      g_flush_budget > 0 ? g_flush_budget
+                         : std::numeric_limits<size_t>::max());
+  if (ran > 0) {
+    GRPC_STATS_INC_POLLER_FLUSH_CLOSURES(ran);
+    GRPC_STATS_INC_POLLER_FLUSH_MICROS(grpc_stats_micros_since(start));
+  }
+}
+
 static void end_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
                        grpc_pollset_worker** worker_hdl) {
   GPR_TIMER_SCOPE("end_worker", 0);
@@ -956,7 +1101,7 @@ static void end_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
       gpr_cv_signal(&worker->next->cv);
       if (grpc_core::ExecCtx::Get()->HasWork()) {
         gpr_mu_unlock(&pollset->mu);
-        grpc_core::ExecCtx::Get()->Flush();
+        flush_exec_ctx();
         gpr_mu_lock(&pollset->mu);
       }
     } else {
@@ -987,12 +1132,12 @@ static void end_worker(grpc_pollset* pollset, grpc_pollset_worker* worker,
         found_worker = check_neighborhood_for_available_poller(neighborhood);
         gpr_mu_unlock(&neighborhood->mu);
       }
-      grpc_core::ExecCtx::Get()->Flush();
+      flush_exec_ctx();
       gpr_mu_lock(&pollset->mu);
     }
   } else if (grpc_core::ExecCtx::Get()->HasWork()) {
     gpr_mu_unlock(&pollset->mu);
-    grpc_core::ExecCtx::Get()->Flush();
+    flush_exec_ctx();
     gpr_mu_lock(&pollset->mu);
   }
   if (worker->initialized_cv) {
@@ -1022,6 +1167,12 @@ static grpc_error_handle pollset_work(grpc_pollset* ps,
     ps->kicked_without_poller = false;
     return GRPC_ERROR_NONE;
   }
+  if (g_flush_budget > 0 && grpc_core::ExecCtx::Get()->HasWork()) {
+    /* Closures left over by the flush budget of a previous call: pick up the
+       events that are ready without blocking, then run them (after the
+       leftovers) in end_worker() */
+    deadline = grpc_core::ExecCtx::Get()->Now();
+  }
 
   if (begin_worker(ps, &worker, worker_hdl, deadline)) {
     g_current_thread_pollset = ps;
@@ -1272,6 +1423,7 @@ static const grpc_event_engine_vtable vtable = {
     sizeof(grpc_pollset),
     true,
     false,
+    true,
 
     fd_create,
     fd_wrapped_fd,
@@ -1336,6 +1488,26 @@ const grpc_event_engine_vtable* grpc_init_epoll1_linux(
     return nullptr;
   }
 
+  int32_t busy_poll_us = GPR_GLOBAL_CONFIG_GET(grpc_epoll1_busy_poll_us);
+  if (busy_poll_us < 0) {
+    gpr_log(GPR_ERROR,
+            "Invalid GRPC_EPOLL1_BUSY_POLL_US: %d, busy polling disabled.",
+            busy_poll_us);
+    busy_poll_us = 0;
+  }
+  g_busy_poll.max_us = busy_poll_us;
+
+  int32_t flush_budget = GPR_GLOBAL_CONFIG_GET(grpc_epoll1_flush_budget);
+  if (flush_budget < 0) {
+    gpr_log(GPR_ERROR,
+            "Invalid GRPC_EPOLL1_FLUSH_BUDGET: %d, flushes are not limited.",
+            flush_budget);
+    flush_budget = 0;
+  }
+  g_flush_budget = static_cast<size_t>(flush_budget);
+  gpr_atm_no_barrier_store(&g_busy_poll.budget_us, busy_poll_us);
+  gpr_atm_no_barrier_store(&g_busy_poll.logged_sockopt_failure, 0);
+
   fd_global_init();
 
   if (!GRPC_LOG_IF_ERROR("pollset_global_init", pollset_global_init())) {
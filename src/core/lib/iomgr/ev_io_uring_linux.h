@@ -0,0 +1,36 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_IOMGR_EV_IO_URING_LINUX_H
+#define GRPC_CORE_LIB_IOMGR_EV_IO_URING_LINUX_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/port.h"
+
+// a polling engine that utilizes a singleton io_uring instance for readiness
+// notifications and the same turnstile polling scheme as epoll1
+
+const grpc_event_engine_vtable* grpc_init_io_uring_linux(bool explicit_request);
+
+// Whether the running kernel supports the io_uring features the engine needs,
+// without setting the engine up.
+bool grpc_is_io_uring_supported();
+
+#endif /* GRPC_CORE_LIB_IOMGR_EV_IO_URING_LINUX_H */
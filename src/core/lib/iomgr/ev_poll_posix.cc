@@ -1352,6 +1352,7 @@ static const grpc_event_engine_vtable vtable = {
     sizeof(grpc_pollset),
     false,
     false,
+    false,
 
     fd_create,
     fd_wrapped_fd,
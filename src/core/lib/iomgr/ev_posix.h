@@ -47,6 +47,9 @@ typedef struct grpc_event_engine_vtable {
   size_t pollset_size;
   bool can_track_err;
   bool run_in_background;
+  // True if the engine's pollset_set operations do nothing, because every
+  // pollset already polls every fd.
+  bool pollset_sets_are_noops;
 
   grpc_fd* (*fd_create)(int fd, const char* name, bool track_err);
   int (*fd_wrapped_fd)(grpc_fd* fd);
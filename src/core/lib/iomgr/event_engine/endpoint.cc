@@ -41,18 +41,24 @@ using ::grpc_event_engine::experimental::EventEngine;
 using ::grpc_event_engine::experimental::ResolvedAddressToURI;
 using ::grpc_event_engine::experimental::SliceBuffer;
 
+// The grpc_slice_buffer of an operation is handed to the EventEngine as a
+// SliceBuffer and handed back when the operation completes. Both transfers
+// only exchange the slice arrays, so no data is copied by the shim.
 void endpoint_read(grpc_endpoint* ep, grpc_slice_buffer* slices,
                    grpc_closure* cb, bool /* urgent */,
-                   int /* min_progress_size */) {
+                   int min_progress_size) {
   auto* eeep = reinterpret_cast<grpc_event_engine_endpoint*>(ep);
   if (eeep->endpoint == nullptr) {
     grpc_core::ExecCtx::Run(DEBUG_LOCATION, cb, GRPC_ERROR_CANCELLED);
     return;
   }
-  SliceBuffer* read_buffer = new (&eeep->read_buffer) SliceBuffer(slices);
+  SliceBuffer* read_buffer = new (&eeep->read_buffer)
+      SliceBuffer(SliceBuffer::TakeCSliceBuffer(*slices));
+  EventEngine::Endpoint::ReadArgs args = {min_progress_size};
   eeep->endpoint->Read(
-      [eeep, cb](absl::Status status) {
+      [eeep, slices, cb](absl::Status status) {
         auto* read_buffer = reinterpret_cast<SliceBuffer*>(&eeep->read_buffer);
+        read_buffer->MoveIntoCSliceBuffer(*slices);
         read_buffer->~SliceBuffer();
         grpc_core::ExecCtx exec_ctx;
         grpc_core::Closure::Run(DEBUG_LOCATION, cb,
@@ -60,11 +66,11 @@ void endpoint_read(grpc_endpoint* ep, grpc_slice_buffer* slices,
         exec_ctx.Flush();
         grpc_pollset_ee_broadcast_event();
       },
-      read_buffer);
+      read_buffer, &args);
 }
 
 void endpoint_write(grpc_endpoint* ep, grpc_slice_buffer* slices,
-                    grpc_closure* cb, void* arg, int /*max_frame_size*/) {
+                    grpc_closure* cb, void* arg, int max_frame_size) {
   // TODO(hork): adapt arg to some metrics collection mechanism.
   (void)arg;
   auto* eeep = reinterpret_cast<grpc_event_engine_endpoint*>(ep);
@@ -72,11 +78,17 @@ void endpoint_write(grpc_endpoint* ep, grpc_slice_buffer* slices,
     grpc_core::ExecCtx::Run(DEBUG_LOCATION, cb, GRPC_ERROR_CANCELLED);
     return;
   }
-  SliceBuffer* write_buffer = new (&eeep->write_buffer) SliceBuffer(slices);
+  SliceBuffer* write_buffer = new (&eeep->write_buffer)
+      SliceBuffer(SliceBuffer::TakeCSliceBuffer(*slices));
+  EventEngine::Endpoint::WriteArgs args;
+  args.max_frame_size = max_frame_size;
   eeep->endpoint->Write(
-      [eeep, cb](absl::Status status) {
+      [eeep, slices, cb](absl::Status status) {
         auto* write_buffer =
             reinterpret_cast<SliceBuffer*>(&eeep->write_buffer);
+        // Hand the slices back for the caller to release, as an iomgr
+        // endpoint would.
+        write_buffer->MoveIntoCSliceBuffer(*slices);
         write_buffer->~SliceBuffer();
         grpc_core::ExecCtx exec_ctx;
         grpc_core::Closure::Run(DEBUG_LOCATION, cb,
@@ -84,7 +96,7 @@ void endpoint_write(grpc_endpoint* ep, grpc_slice_buffer* slices,
         exec_ctx.Flush();
         grpc_pollset_ee_broadcast_event();
       },
-      write_buffer);
+      write_buffer, &args);
 }
 void endpoint_add_to_pollset(grpc_endpoint* /* ep */,
                              grpc_pollset* /* pollset */) {}
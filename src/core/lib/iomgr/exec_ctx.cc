@@ -23,11 +23,13 @@
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/iomgr/combiner.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/profiling/timers.h"
 
 static void exec_ctx_run(grpc_closure* closure) {
+  GPR_TIMER_SCOPE("exec_ctx_run", 0);
 #ifndef NDEBUG
   closure->scheduled = false;
   if (grpc_trace_closure.enabled()) {
@@ -87,9 +89,30 @@ bool ExecCtx::Flush() {
   return did_something;
 }
 
+size_t ExecCtx::FlushWithBudget(size_t budget) {
+  size_t ran = 0;
+  GPR_TIMER_SCOPE("grpc_exec_ctx_flush_with_budget", 0);
+  for (;;) {
+    if (ran < budget && !grpc_closure_list_empty(closure_list_)) {
+      // Pop one closure at a time: anything it schedules is appended behind
+      // the closures already queued, so order is the same as in Flush().
+      grpc_closure* c = closure_list_.head;
+      closure_list_.head = c->next_data.next;
+      if (closure_list_.head == nullptr) closure_list_.tail = nullptr;
+      exec_ctx_run(c);
+    } else if (ran >= budget && combiner_data_.active_combiner == nullptr) {
+      break;
+    } else if (!grpc_combiner_continue_exec_ctx()) {
+      break;
+    }
+    ++ran;
+  }
+  return ran;
+}
+
 Timestamp ExecCtx::Now() {
   if (!now_is_valid_) {
-    now_ = Timestamp::FromTimespecRoundDown(gpr_now(GPR_CLOCK_MONOTONIC));
+    now_ = Timestamp::FromTimespecRoundDown(gpr_fast_monotonic_now());
     now_is_valid_ = true;
   }
   return now_;
@@ -160,6 +160,14 @@ class ExecCtx {
    */
   bool Flush();
 
+  /** Like Flush(), but runs at most \a budget closures and combiner
+   *  continuations, leaving the rest queued in order for a later flush.
+   *  A combiner that is active when the budget runs out is still run until it
+   *  is released, since other threads cannot make progress on it meanwhile.
+   *  Returns the number of closures and combiner continuations run.
+   */
+  size_t FlushWithBudget(size_t budget);
+
   /** Returns true if we'd like to leave this execution context as soon as
    *  possible: useful for deciding whether to do something more or not
    *  depending on outside context.
@@ -347,8 +355,20 @@ class ApplicationCallbackExecCtx {
 
   static bool Available() { return Get() != nullptr; }
 
+  /** Accounts for a callback that is being run on this context only because
+      its completion queue asked for inline callbacks. Returns false, without
+      counting it, once max_inlined such callbacks have been run here.
+      Requires Available(). */
+  static bool TryInline(int max_inlined) {
+    ApplicationCallbackExecCtx* ctx = Get();
+    if (ctx->num_inlined_ >= max_inlined) return false;
+    ctx->num_inlined_++;
+    return true;
+  }
+
  private:
   uintptr_t flags_{0u};
+  int num_inlined_{0};
   grpc_completion_queue_functor* head_{nullptr};
   grpc_completion_queue_functor* tail_{nullptr};
   static GPR_THREAD_LOCAL(ApplicationCallbackExecCtx*) callback_exec_ctx_;
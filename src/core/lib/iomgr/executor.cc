@@ -27,14 +27,29 @@
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gpr/cpu_numa.h"
 #include "src/core/lib/gpr/tls.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
 
 #define MAX_DEPTH 2
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_executor_work_stealing, false,
+    "If set, executors run their closures on a work-stealing thread pool "
+    "instead of per-thread closure lists.");
+
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_executor_numa_aware, false,
+    "If set, executor threads are spread over the NUMA nodes of the machine "
+    "and closures are queued to a thread on the node they were scheduled "
+    "from.");
+
 #define EXECUTOR_TRACE(format, ...)                       \
   do {                                                    \
     if (GRPC_TRACE_FLAG_ENABLED(executor_trace)) {        \
@@ -141,6 +156,46 @@ size_t Executor::RunClosures(const char* executor_name,
   return n;
 }
 
+void Executor::StartThread(size_t idx) {
+  Thread::Options options;
+  if (num_nodes_ > 1) {
+    options.set_numa_node(static_cast<int>(idx % num_nodes_));
+  }
+  thd_state_[idx].thd = Thread(name_, &Executor::ThreadMain, &thd_state_[idx],
+                               nullptr, options);
+  thd_state_[idx].thd.Start();
+}
+
+void Executor::StartFirstThread() {
+  gpr_spinlock_lock(&adding_thread_lock_);
+  if (!gpr_atm_no_barrier_load(&first_thread_started_)) {
+    gpr_mu_lock(&thd_state_[0].mu);
+    bool shutdown = thd_state_[0].shutdown;
+    gpr_mu_unlock(&thd_state_[0].mu);
+    if (!shutdown) {
+      // The first thread is started regardless of the thread quota; the
+      // others only when it allows.
+      ResourceQuota::Default()->thread_quota()->ForceReserve(1);
+      StartThread(0);
+      gpr_atm_rel_store(&first_thread_started_, 1);
+    }
+  }
+  gpr_spinlock_unlock(&adding_thread_lock_);
+}
+
+size_t Executor::PickThread(size_t cur_thread_count) const {
+  if (num_nodes_ > 1) {
+    // Threads idx, idx + num_nodes_, ... run on the caller's node.
+    size_t node = gpr_numa_current_node() % num_nodes_;
+    if (node < cur_thread_count) {
+      size_t local_threads =
+          (cur_thread_count - node + num_nodes_ - 1) / num_nodes_;
+      return node + num_nodes_ * HashPointer(ExecCtx::Get(), local_threads);
+    }
+  }
+  return HashPointer(ExecCtx::Get(), cur_thread_count);
+}
+
 bool Executor::IsThreaded() const {
   return gpr_atm_acq_load(&num_threads_) > 0;
 }
@@ -156,6 +211,26 @@ void Executor::SetThreading(bool threading) {
     }
 
     GPR_ASSERT(num_threads_ == 0);
+    if (GPR_GLOBAL_CONFIG_GET(grpc_executor_work_stealing)) {
+      // Idle workers of the pool sleep, so there is no need to grow it
+      // lazily.
+      // The pool cannot grow later, so it takes as many threads as the
+      // thread quota allows right away.
+      ThreadQuotaPtr thread_quota = ResourceQuota::Default()->thread_quota();
+      thread_quota->ForceReserve(1);
+      size_t num_threads = 1;
+      while (num_threads < max_threads_ && thread_quota->Reserve(1)) {
+        ++num_threads;
+      }
+      pool_ = new WorkStealingThreadPool(static_cast<int>(num_threads), name_);
+      gpr_atm_rel_store(&num_threads_, num_threads);
+      EXECUTOR_TRACE("(%s) SetThreading(%d) done (work stealing)", name_,
+                     threading);
+      return;
+    }
+    num_nodes_ = GPR_GLOBAL_CONFIG_GET(grpc_executor_numa_aware)
+                     ? std::min<size_t>(gpr_numa_num_nodes(), max_threads_)
+                     : 1;
     gpr_atm_rel_store(&num_threads_, 1);
     thd_state_ = static_cast<ThreadState*>(
         gpr_zalloc(sizeof(ThreadState) * max_threads_));
@@ -167,16 +242,31 @@ void Executor::SetThreading(bool threading) {
       thd_state_[i].name = name_;
       thd_state_[i].thd = Thread();
       thd_state_[i].elems = GRPC_CLOSURE_LIST_INIT;
+      thd_state_[i].first_enqueued = 0;
     }
 
-    thd_state_[0].thd = Thread(name_, &Executor::ThreadMain, &thd_state_[0]);
-    thd_state_[0].thd.Start();
+    // The first thread is started by the first closure enqueued, so that
+    // processes that never use the executor never pay for its threads.
+    gpr_atm_rel_store(&first_thread_started_, 0);
   } else {  // !threading
     if (curr_num_threads == 0) {
       EXECUTOR_TRACE("(%s) SetThreading(false). curr_num_threads == 0", name_);
       return;
     }
 
+    if (pool_ != nullptr) {
+      // Runs all pending closures, including the ones they enqueue onto this
+      // executor while the pool shuts down.
+      delete pool_;
+      ResourceQuota::Default()->thread_quota()->Release(
+          static_cast<size_t>(curr_num_threads));
+      gpr_atm_rel_store(&num_threads_, 0);
+      pool_ = nullptr;
+      grpc_iomgr_platform_shutdown_background_closure();
+      EXECUTOR_TRACE("(%s) SetThreading(%d) done", name_, threading);
+      return;
+    }
+
     for (size_t i = 0; i < max_threads_; i++) {
       gpr_mu_lock(&thd_state_[i].mu);
       thd_state_[i].shutdown = true;
@@ -190,11 +280,17 @@ void Executor::SetThreading(bool threading) {
     gpr_spinlock_unlock(&adding_thread_lock_);
 
     curr_num_threads = gpr_atm_no_barrier_load(&num_threads_);
+    if (!gpr_atm_no_barrier_load(&first_thread_started_)) {
+      // No closure was ever enqueued, so no thread was started.
+      curr_num_threads = 0;
+    }
     for (gpr_atm i = 0; i < curr_num_threads; i++) {
       thd_state_[i].thd.Join();
       EXECUTOR_TRACE("(%s) Thread %" PRIdPTR " of %" PRIdPTR " joined", name_,
                      i + 1, curr_num_threads);
     }
+    ResourceQuota::Default()->thread_quota()->Release(
+        static_cast<size_t>(curr_num_threads));
 
     gpr_atm_rel_store(&num_threads_, 0);
     for (size_t i = 0; i < max_threads_; i++) {
@@ -244,6 +340,8 @@ void Executor::ThreadMain(void* arg) {
       break;
     }
 
+    GRPC_STATS_INC_EXECUTOR_QUEUE_DELAY_MICROS(
+        grpc_stats_micros_since(ts->first_enqueued));
     grpc_closure_list closures = ts->elems;
     ts->elems = GRPC_CLOSURE_LIST_INIT;
     gpr_mu_unlock(&ts->mu);
@@ -283,9 +381,28 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error_handle error,
       return;
     }
 
+    if (pool_ != nullptr) {
+      // Long jobs need no special treatment: idle workers steal the closures
+      // queued behind them.
+#ifndef NDEBUG
+      EXECUTOR_TRACE("(%s) schedule %p (%s) (created %s:%d) on pool", name_,
+                     closure, is_short ? "short" : "long",
+                     closure->file_created, closure->line_created);
+#else
+      EXECUTOR_TRACE("(%s) schedule %p (%s) on pool", name_, closure,
+                     is_short ? "short" : "long");
+#endif
+      pool_->Run(closure, error);
+      return;
+    }
+
+    if (!gpr_atm_acq_load(&first_thread_started_)) {
+      StartFirstThread();
+    }
+
     ThreadState* ts = g_this_thread_state;
     if (ts == nullptr) {
-      ts = &thd_state_[HashPointer(ExecCtx::Get(), cur_thread_count)];
+      ts = &thd_state_[PickThread(cur_thread_count)];
     }
 
     ThreadState* orig_ts = ts;
@@ -318,7 +435,7 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error_handle error,
           // TODO (sreek): There is a potential issue here. We are
           // unconditionally setting try_new_thread to true here. What if the
           // executor is shutdown OR if cur_thread_count is already equal to
-          // max_threads ?
+          // max_threads OR if the thread quota is exhausted?
           // (Fortunately, this is not an issue yet (as of july 2018) because
           // there is only one instance of long job in gRPC and hence we will
           // not hit this code path)
@@ -337,8 +454,9 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error_handle error,
       //   shutdown, it means that the thread must be waiting in ThreadMain()
       // - Note that gpr_cv_signal() won't immediately wakeup the thread. That
       //   happens after we release the mutex &ts->mu a few lines below
-      if (grpc_closure_list_empty(ts->elems) && !ts->shutdown) {
-        gpr_cv_signal(&ts->cv);
+      if (grpc_closure_list_empty(ts->elems)) {
+        ts->first_enqueued = gpr_get_cycle_counter();
+        if (!ts->shutdown) gpr_cv_signal(&ts->cv);
       }
 
       grpc_closure_list_append(&ts->elems, closure, error);
@@ -357,14 +475,15 @@ void Executor::Enqueue(grpc_closure* closure, grpc_error_handle error,
 
     if (try_new_thread && gpr_spinlock_trylock(&adding_thread_lock_)) {
       cur_thread_count = static_cast<size_t>(gpr_atm_acq_load(&num_threads_));
-      if (cur_thread_count < max_threads_) {
+      // Without room in the thread quota, the closure waits on the threads
+      // already running.
+      if (cur_thread_count < max_threads_ &&
+          ResourceQuota::Default()->thread_quota()->Reserve(1)) {
         // Increment num_threads (safe to do a store instead of a cas because we
         // always increment num_threads under the 'adding_thread_lock')
         gpr_atm_rel_store(&num_threads_, cur_thread_count + 1);
 
-        thd_state_[cur_thread_count].thd =
-            Thread(name_, &Executor::ThreadMain, &thd_state_[cur_thread_count]);
-        thd_state_[cur_thread_count].thd.Start();
+        StartThread(cur_thread_count);
       }
       gpr_spinlock_unlock(&adding_thread_lock_);
     }
@@ -22,8 +22,10 @@
 #include <grpc/support/port_platform.h>
 
 #include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/executor/work_stealing_threadpool.h"
 
 namespace grpc_core {
 
@@ -33,6 +35,7 @@ struct ThreadState {
   const char* name;  // Thread state name
   gpr_cv cv;
   grpc_closure_list elems;
+  gpr_cycle_counter first_enqueued;  // When elems last became non-empty
   size_t depth;  // Number of closures in the closure list
   bool shutdown;
   bool queued_long_job;
@@ -107,11 +110,29 @@ class Executor {
   static size_t RunClosures(const char* executor_name, grpc_closure_list list);
   static void ThreadMain(void* arg);
 
+  // Starts the thread of thd_state_[idx].
+  void StartThread(size_t idx);
+  // Starts the thread of thd_state_[0], unless it runs already or the
+  // executor is shutting down.
+  void StartFirstThread();
+  // Returns the index of the thread that a closure enqueued from outside of
+  // the executor goes to first.
+  size_t PickThread(size_t cur_thread_count) const;
+
   const char* name_;
   ThreadState* thd_state_;
   size_t max_threads_;
   gpr_atm num_threads_;
   gpr_spinlock adding_thread_lock_;
+  // Set once the first closure enqueued has started the first thread.
+  gpr_atm first_thread_started_ = 0;
+  // The number of NUMA nodes that threads are spread over when the
+  // grpc_executor_numa_aware config is on, or 1. Thread i runs on node
+  // i % num_nodes_.
+  size_t num_nodes_ = 1;
+  // Set instead of thd_state_ when the grpc_executor_work_stealing config is
+  // on.
+  WorkStealingThreadPool* pool_ = nullptr;
 };
 
 // Global initializer for executor
@@ -0,0 +1,334 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/executor/work_stealing_threadpool.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+namespace grpc_core {
+
+namespace {
+
+// The initial number of slots in each worker's deque (a power of two).
+constexpr size_t kInitialDequeCapacity = 256;
+
+// How often (in closures found) a worker looks at the global queue before its
+// own deque, so that a worker feeding its own deque cannot starve closures
+// scheduled from outside the pool.
+constexpr uint32_t kGlobalQueueInterval = 61;
+
+struct FunctionClosure {
+  grpc_closure closure;
+  std::function<void()> fn;
+};
+
+void RunFunctionClosure(void* arg, grpc_error_handle /*error*/) {
+  FunctionClosure* fc = static_cast<FunctionClosure*>(arg);
+  fc->fn();
+  delete fc;
+}
+
+uint32_t NextRandom(uint32_t* state) {
+  // xorshift32
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+}  // namespace
+
+//
+// WorkStealingDeque
+//
+
+WorkStealingDeque::WorkStealingDeque()
+    : buffer_(new Buffer(kInitialDequeCapacity)) {}
+
+WorkStealingDeque::~WorkStealingDeque() {
+  delete buffer_.load(std::memory_order_relaxed);
+  for (Buffer* buffer : retired_) delete buffer;
+}
+
+WorkStealingDeque::Buffer* WorkStealingDeque::Grow(Buffer* buffer,
+                                                   int64_t bottom,
+                                                   int64_t top) {
+  Buffer* bigger = new Buffer(buffer->capacity() * 2);
+  for (int64_t i = top; i < bottom; i++) {
+    bigger->Put(i, buffer->Get(i));
+  }
+  retired_.push_back(buffer);
+  buffer_.store(bigger, std::memory_order_release);
+  return bigger;
+}
+
+void WorkStealingDeque::Push(grpc_closure* closure) {
+  int64_t bottom = bottom_.load(std::memory_order_relaxed);
+  int64_t top = top_.load(std::memory_order_acquire);
+  Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+  if (bottom - top > static_cast<int64_t>(buffer->capacity()) - 1) {
+    buffer = Grow(buffer, bottom, top);
+  }
+  buffer->Put(bottom, closure);
+  std::atomic_thread_fence(std::memory_order_release);
+  bottom_.store(bottom + 1, std::memory_order_relaxed);
+}
+
+grpc_closure* WorkStealingDeque::Pop() {
+  int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+  Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+  bottom_.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t top = top_.load(std::memory_order_relaxed);
+  if (top > bottom) {
+    // Empty
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  grpc_closure* closure = buffer->Get(bottom);
+  if (top == bottom) {
+    // Last closure: race stealers for it.
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      closure = nullptr;
+    }
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+  return closure;
+}
+
+grpc_closure* WorkStealingDeque::Steal() {
+  int64_t top = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t bottom = bottom_.load(std::memory_order_acquire);
+  if (top >= bottom) return nullptr;
+  grpc_closure* closure = buffer_.load(std::memory_order_acquire)->Get(top);
+  if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                    std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  return closure;
+}
+
+bool WorkStealingDeque::Empty() const {
+  int64_t top = top_.load(std::memory_order_acquire);
+  int64_t bottom = bottom_.load(std::memory_order_acquire);
+  return top >= bottom;
+}
+
+//
+// WorkStealingThreadPool
+//
+
+GPR_THREAD_LOCAL(WorkStealingThreadPool::Worker*)
+WorkStealingThreadPool::current_worker_;
+
+WorkStealingThreadPool::WorkStealingThreadPool(
+    int num_threads, const char* thd_name,
+    const Thread::Options& thread_options)
+    : thd_name_(thd_name) {
+  if (num_threads <= 0) num_threads = 1;
+  Thread::Options options = thread_options;
+  options.set_joinable(true);
+  workers_.reserve(num_threads);
+  for (int i = 0; i < num_threads; i++) {
+    Worker* worker = new Worker();
+    worker->pool = this;
+    worker->index = i;
+    worker->rng_state = 2654435761u * (i + 1);
+    worker->tick = 0;
+    workers_.push_back(worker);
+  }
+  // Start the threads only once workers_ is complete, since they steal from
+  // each other.
+  for (Worker* worker : workers_) {
+    worker->thd = Thread(thd_name_, &WorkStealingThreadPool::ThreadMain, worker,
+                         nullptr, options);
+    worker->thd.Start();
+  }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  {
+    MutexLock lock(&mu_);
+    shutdown_.store(true, std::memory_order_release);
+    epoch_.fetch_add(1, std::memory_order_relaxed);
+    cv_.SignalAll();
+  }
+  for (Worker* worker : workers_) {
+    worker->thd.Join();
+  }
+  // Closures that were scheduled after the workers stopped looking, or that
+  // lost a steal race with a worker on its way out, are run here.
+  ExecCtx exec_ctx;
+  bool ran;
+  do {
+    ran = false;
+    grpc_closure* closure;
+    while ((closure = PopGlobal(true)) != nullptr) {
+      RunClosure(closure);
+      ran = true;
+    }
+    for (Worker* worker : workers_) {
+      while ((closure = worker->deque.Steal()) != nullptr) {
+        RunClosure(closure);
+        ran = true;
+      }
+    }
+  } while (ran);
+  for (Worker* worker : workers_) {
+    delete worker;
+  }
+}
+
+void WorkStealingThreadPool::Run(grpc_closure* closure,
+                                 grpc_error_handle error) {
+#ifdef GRPC_ERROR_IS_ABSEIL_STATUS
+  closure->error_data.error = internal::StatusAllocHeapPtr(error);
+#else
+  closure->error_data.error = reinterpret_cast<intptr_t>(error);
+#endif
+  Worker* worker = current_worker_;
+  if (worker != nullptr && worker->pool == this) {
+    worker->deque.Push(closure);
+  } else {
+    global_queue_.Push(closure->next_data.mpscq_node.get());
+  }
+  WakeOne();
+}
+
+void WorkStealingThreadPool::Run(std::function<void()> fn) {
+  FunctionClosure* fc = new FunctionClosure();
+  fc->fn = std::move(fn);
+  GRPC_CLOSURE_INIT(&fc->closure, RunFunctionClosure, fc, nullptr);
+  Run(&fc->closure, GRPC_ERROR_NONE);
+}
+
+bool WorkStealingThreadPool::IsWorkerThread() const {
+  Worker* worker = current_worker_;
+  return worker != nullptr && worker->pool == this;
+}
+
+void WorkStealingThreadPool::WakeOne() {
+  // Pairs with the fence in WaitForWork(): either this thread sees the
+  // sleeper, or the sleeper sees the closure that was just published.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_sleepers_.load(std::memory_order_relaxed) == 0) return;
+  epoch_.fetch_add(1, std::memory_order_relaxed);
+  MutexLock lock(&mu_);
+  cv_.Signal();
+}
+
+void WorkStealingThreadPool::RunClosure(grpc_closure* closure) {
+#ifndef NDEBUG
+  closure->scheduled = false;
+#endif
+#ifdef GRPC_ERROR_IS_ABSEIL_STATUS
+  grpc_error_handle error =
+      internal::StatusMoveFromHeapPtr(closure->error_data.error);
+  closure->error_data.error = 0;
+  closure->cb(closure->cb_arg, std::move(error));
+#else
+  grpc_error_handle error =
+      reinterpret_cast<grpc_error_handle>(closure->error_data.error);
+  closure->error_data.error = 0;
+  closure->cb(closure->cb_arg, error);
+  GRPC_ERROR_UNREF(error);
+#endif
+  ExecCtx::Get()->Flush();
+}
+
+grpc_closure* WorkStealingThreadPool::PopGlobal(bool block) {
+  // The queue node is the first member of grpc_closure.
+  return reinterpret_cast<grpc_closure*>(block ? global_queue_.Pop()
+                                               : global_queue_.TryPop());
+}
+
+grpc_closure* WorkStealingThreadPool::StealFromPeers(Worker* worker) {
+  const size_t n = workers_.size();
+  const size_t start = NextRandom(&worker->rng_state) % n;
+  for (size_t i = 0; i < n; i++) {
+    Worker* victim = workers_[(start + i) % n];
+    if (victim == worker) continue;
+    grpc_closure* closure = victim->deque.Steal();
+    if (closure != nullptr) return closure;
+  }
+  return nullptr;
+}
+
+grpc_closure* WorkStealingThreadPool::FindWork(Worker* worker, bool block) {
+  grpc_closure* closure;
+  if (++worker->tick % kGlobalQueueInterval == 0) {
+    closure = PopGlobal(false);
+    if (closure != nullptr) return closure;
+  }
+  closure = worker->deque.Pop();
+  if (closure != nullptr) return closure;
+  closure = PopGlobal(block);
+  if (closure != nullptr) return closure;
+  return StealFromPeers(worker);
+}
+
+bool WorkStealingThreadPool::WaitForWork(Worker* worker,
+                                         grpc_closure** closure) {
+  num_sleepers_.fetch_add(1, std::memory_order_relaxed);
+  // Pairs with the fence in WakeOne().
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  uint64_t epoch = epoch_.load(std::memory_order_relaxed);
+  *closure = FindWork(worker, true);
+  if (*closure == nullptr) {
+    MutexLock lock(&mu_);
+    while (epoch_.load(std::memory_order_relaxed) == epoch &&
+           !shutdown_.load(std::memory_order_relaxed)) {
+      cv_.Wait(&mu_);
+    }
+  }
+  num_sleepers_.fetch_sub(1, std::memory_order_relaxed);
+  return *closure != nullptr || !shutdown_.load(std::memory_order_acquire);
+}
+
+void WorkStealingThreadPool::ThreadMain(void* arg) {
+  Worker* worker = static_cast<Worker*>(arg);
+  WorkStealingThreadPool* pool = worker->pool;
+  current_worker_ = worker;
+
+  ExecCtx exec_ctx(GRPC_EXEC_CTX_FLAG_IS_INTERNAL_THREAD);
+  grpc_closure* closure = nullptr;
+  do {
+    // Application callbacks queued by the closures run when this goes out of
+    // scope, before the worker goes to sleep.
+    ApplicationCallbackExecCtx callback_exec_ctx(
+        GRPC_APP_CALLBACK_EXEC_CTX_FLAG_IS_INTERNAL_THREAD);
+    ExecCtx::Get()->InvalidateNow();
+    if (closure == nullptr) closure = pool->FindWork(worker, false);
+    while (closure != nullptr) {
+      RunClosure(closure);
+      closure = pool->FindWork(worker, false);
+    }
+  } while (pool->WaitForWork(worker, &closure));
+
+  current_worker_ = nullptr;
+}
+
+}  // namespace grpc_core
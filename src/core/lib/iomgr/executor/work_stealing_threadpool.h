@@ -0,0 +1,181 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_THREADPOOL_H
+#define GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_THREADPOOL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gprpp/mpscq.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/closure.h"
+
+namespace grpc_core {
+
+// A Chase-Lev work-stealing deque of closures ("Dynamic Circular
+// Work-Stealing Deque", with the memory orderings of Le et al., "Correct and
+// Efficient Work-Stealing for Weak Memory Models").
+// Only the owning thread may call Push() and Pop(), which operate on the
+// bottom of the deque in LIFO order. Any thread may call Steal(), which takes
+// the oldest closure from the top. The buffer grows on demand; retired
+// buffers are kept until the deque is destroyed since a concurrent Steal()
+// may still be reading from them.
+class WorkStealingDeque {
+ public:
+  WorkStealingDeque();
+  ~WorkStealingDeque();
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  // Owner only.
+  void Push(grpc_closure* closure);
+  // Owner only. Returns nullptr if the deque is empty.
+  grpc_closure* Pop();
+  // Thread safe. Returns nullptr if the deque is empty or if another thread
+  // took the closure first.
+  grpc_closure* Steal();
+
+  // Thread safe, but only a snapshot.
+  bool Empty() const;
+
+ private:
+  struct Buffer {
+    explicit Buffer(size_t capacity)
+        : mask(capacity - 1),
+          slots(new std::atomic<grpc_closure*>[capacity]) {}
+    ~Buffer() { delete[] slots; }
+    size_t capacity() const { return mask + 1; }
+    grpc_closure* Get(int64_t i) const {
+      return slots[static_cast<size_t>(i) & mask].load(
+          std::memory_order_relaxed);
+    }
+    void Put(int64_t i, grpc_closure* closure) {
+      slots[static_cast<size_t>(i) & mask].store(closure,
+                                                 std::memory_order_relaxed);
+    }
+
+    const size_t mask;
+    std::atomic<grpc_closure*>* const slots;
+  };
+
+  // Replaces the buffer with one twice as large holding [top, bottom).
+  Buffer* Grow(Buffer* buffer, int64_t bottom, int64_t top);
+
+  // Stealers write top_ while the owner writes bottom_: make sure they don't
+  // share a cacheline.
+  std::atomic<int64_t> top_{0};
+  char padding_[GPR_CACHELINE_SIZE];
+  std::atomic<int64_t> bottom_{0};
+  std::atomic<Buffer*> buffer_;
+  std::vector<Buffer*> retired_;  // Owner only
+};
+
+// A fixed size thread pool of closures where every worker owns a
+// WorkStealingDeque. Closures scheduled from a worker thread go onto that
+// worker's deque, so a chain of closures stays on one (cache-warm) thread;
+// closures scheduled from any other thread go onto a global injection queue
+// whose producer side is lock free. Idle workers take work from the global
+// queue or steal the oldest closure from a random peer before going to sleep.
+//
+// Because peers steal from a busy worker's deque, a long running or blocking
+// closure does not starve the closures queued behind it.
+//
+// Closures are run with an ExecCtx and an ApplicationCallbackExecCtx in
+// place, which are flushed the same way as in the Executor.
+class WorkStealingThreadPool {
+ public:
+  // Creates a pool with "num_threads" workers (at least 1) named "thd_name".
+  // Workers are always joinable, whatever "thread_options" says.
+  explicit WorkStealingThreadPool(
+      int num_threads, const char* thd_name = "WorkStealingWorker",
+      const Thread::Options& thread_options = Thread::Options());
+
+  // Runs all pending closures (including those scheduled while shutting
+  // down), then joins the worker threads.
+  ~WorkStealingThreadPool();
+
+  WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+  WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+  // Schedules "closure" to run on the pool with "error". Never blocks.
+  void Run(grpc_closure* closure, grpc_error_handle error);
+
+  // Schedules "fn" to run on the pool. This has the shape of
+  // EventEngine::Run() so that the pool can back an EventEngine.
+  void Run(std::function<void()> fn);
+
+  // Returns the number of worker threads in the pool.
+  int pool_capacity() const { return static_cast<int>(workers_.size()); }
+
+  const char* thread_name() const { return thd_name_; }
+
+  // Returns true if the calling thread is a worker of this pool.
+  bool IsWorkerThread() const;
+
+ private:
+  struct Worker {
+    WorkStealingThreadPool* pool;
+    size_t index;
+    WorkStealingDeque deque;
+    // Only used by the worker itself: the seed for picking steal victims and
+    // the number of closures found so far.
+    uint32_t rng_state;
+    uint32_t tick;
+    Thread thd;
+  };
+
+  static GPR_THREAD_LOCAL(Worker*) current_worker_;
+
+  static void ThreadMain(void* arg);
+  static void RunClosure(grpc_closure* closure);
+
+  // Returns the next closure for "worker" to run, or nullptr if none was
+  // found. If "block" is true, contended or partially pushed global work is
+  // waited for rather than skipped.
+  grpc_closure* FindWork(Worker* worker, bool block);
+  grpc_closure* PopGlobal(bool block);
+  grpc_closure* StealFromPeers(Worker* worker);
+  // Sleeps until new work may be available. Returns false on shutdown.
+  bool WaitForWork(Worker* worker, grpc_closure** closure);
+  // Wakes a sleeping worker, if any, after work was published.
+  void WakeOne();
+
+  const char* thd_name_;
+  std::vector<Worker*> workers_;
+  LockedMultiProducerSingleConsumerQueue global_queue_;
+
+  // Sleeping protocol: a sleeper registers in num_sleepers_, samples epoch_,
+  // makes one last search for work and then waits for epoch_ to move.
+  // Producers publish their work before checking num_sleepers_.
+  std::atomic<int> num_sleepers_{0};
+  std::atomic<uint64_t> epoch_{0};
+  Mutex mu_;
+  CondVar cv_;
+  std::atomic<bool> shutdown_{false};
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_THREADPOOL_H */
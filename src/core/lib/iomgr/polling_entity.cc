@@ -60,6 +60,7 @@ bool grpc_polling_entity_is_empty(const grpc_polling_entity* pollent) {
 
 void grpc_polling_entity_add_to_pollset_set(grpc_polling_entity* pollent,
                                             grpc_pollset_set* pss_dst) {
+  if (grpc_pollset_set_is_noop()) return;
   if (pollent->tag == GRPC_POLLS_POLLSET) {
     // CFStream does not use file destriptors. When CFStream is used, the fd
     // pollset is possible to be null.
@@ -77,6 +78,7 @@ void grpc_polling_entity_add_to_pollset_set(grpc_polling_entity* pollent,
 
 void grpc_polling_entity_del_from_pollset_set(grpc_polling_entity* pollent,
                                               grpc_pollset_set* pss_dst) {
+  if (grpc_pollset_set_is_noop()) return;
   if (pollent->tag == GRPC_POLLS_POLLSET) {
 #ifdef GRPC_CFSTREAM
     if (pollent->pollent.pollset != nullptr) {
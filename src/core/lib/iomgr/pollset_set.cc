@@ -53,3 +53,5 @@ void grpc_pollset_set_del_pollset_set(grpc_pollset_set* bag,
                                       grpc_pollset_set* item) {
   grpc_pollset_set_impl->del_pollset_set(bag, item);
 }
+
+bool grpc_pollset_set_is_noop(void) { return grpc_pollset_set_impl->is_noop(); }
@@ -36,6 +36,7 @@ typedef struct grpc_pollset_set_vtable {
   void (*del_pollset)(grpc_pollset_set* pollset_set, grpc_pollset* pollset);
   void (*add_pollset_set)(grpc_pollset_set* bag, grpc_pollset_set* item);
   void (*del_pollset_set)(grpc_pollset_set* bag, grpc_pollset_set* item);
+  bool (*is_noop)(void);
 } grpc_pollset_set_vtable;
 
 void grpc_set_pollset_set_vtable(grpc_pollset_set_vtable* vtable);
@@ -51,4 +52,9 @@ void grpc_pollset_set_add_pollset_set(grpc_pollset_set* bag,
 void grpc_pollset_set_del_pollset_set(grpc_pollset_set* bag,
                                       grpc_pollset_set* item);
 
+/* Returns true if the active polling engine ignores pollset_sets, because
+   every pollset already polls every fd. Callers on hot paths may then skip
+   maintaining interested-parties sets entirely. */
+bool grpc_pollset_set_is_noop(void);
+
 #endif /* GRPC_CORE_LIB_IOMGR_POLLSET_SET_H */
@@ -44,9 +44,12 @@ static void pollset_set_add_pollset_set(grpc_pollset_set* bag,
 static void pollset_set_del_pollset_set(grpc_pollset_set* bag,
                                         grpc_pollset_set* item) {}
 
+static bool pollset_set_is_noop(void) { return true; }
+
 grpc_pollset_set_vtable grpc_windows_pollset_set_vtable = {
     pollset_set_create,          pollset_set_destroy,
     pollset_set_add_pollset,     pollset_set_del_pollset,
-    pollset_set_add_pollset_set, pollset_set_del_pollset_set};
+    pollset_set_add_pollset_set, pollset_set_del_pollset_set,
+    pollset_set_is_noop};
 
 #endif /* GRPC_WINSOCK_SOCKET */
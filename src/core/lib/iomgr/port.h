@@ -71,6 +71,10 @@
 #if __GLIBC_PREREQ(2, 10)
 #define GRPC_LINUX_SOCKETUTILS 1
 #endif
+#if __GLIBC_PREREQ(2, 34)
+/* getaddrinfo_a is part of libc itself, rather than libanl, since 2.34. */
+#define GRPC_LINUX_GETADDRINFO_A 1
+#endif
 #if !(__GLIBC_PREREQ(2, 18))
 /*
  * TCP_USER_TIMEOUT wasn't imported to glibc until 2.18. Use Linux system
@@ -21,6 +21,8 @@
 #include "src/core/lib/iomgr/port.h"
 #ifdef GRPC_POSIX_SOCKET_RESOLVE_ADDRESS
 
+#include <netdb.h>
+#include <signal.h>
 #include <string.h>
 #include <sys/types.h>
 
@@ -45,6 +47,65 @@
 namespace grpc_core {
 namespace {
 
+absl::Status ErrorToStatus(grpc_error_handle error) {
+  absl::Status status = grpc_error_to_absl_status(error);
+  GRPC_ERROR_UNREF(error);
+  return status;
+}
+
+// Splits name into the host and port to look up.
+absl::Status ParseHostPort(absl::string_view name,
+                           absl::string_view default_port, std::string* host,
+                           std::string* port) {
+  SplitHostPort(name, host, port);
+  if (host->empty()) {
+    return ErrorToStatus(grpc_error_set_str(
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("unparseable host:port"),
+        GRPC_ERROR_STR_TARGET_ADDRESS, name));
+  }
+  if (port->empty()) {
+    if (default_port.empty()) {
+      return ErrorToStatus(grpc_error_set_str(
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING("no port in name"),
+          GRPC_ERROR_STR_TARGET_ADDRESS, name));
+    }
+    *port = std::string(default_port);
+  }
+  return absl::OkStatus();
+}
+
+void InitHints(struct addrinfo* hints) {
+  memset(hints, 0, sizeof(*hints));
+  hints->ai_family = AF_UNSPEC;     /* ipv4 or ipv6 */
+  hints->ai_socktype = SOCK_STREAM; /* stream socket */
+  hints->ai_flags = AI_PASSIVE;     /* for wildcard IP address */
+}
+
+absl::Status GetaddrinfoError(int s, absl::string_view name) {
+  return ErrorToStatus(grpc_error_set_str(
+      grpc_error_set_str(
+          grpc_error_set_str(
+              grpc_error_set_int(
+                  GRPC_ERROR_CREATE_FROM_STATIC_STRING(gai_strerror(s)),
+                  GRPC_ERROR_INT_ERRNO, s),
+              GRPC_ERROR_STR_OS_ERROR, gai_strerror(s)),
+          GRPC_ERROR_STR_SYSCALL, "getaddrinfo"),
+      GRPC_ERROR_STR_TARGET_ADDRESS, name));
+}
+
+std::vector<grpc_resolved_address> AddressesFromAddrinfo(
+    const struct addrinfo* result) {
+  std::vector<grpc_resolved_address> addresses;
+  for (const struct addrinfo* resp = result; resp != nullptr;
+       resp = resp->ai_next) {
+    grpc_resolved_address addr;
+    memcpy(&addr.addr, resp->ai_addr, resp->ai_addrlen);
+    addr.len = resp->ai_addrlen;
+    addresses.push_back(addr);
+  }
+  return addresses;
+}
+
 class NativeDNSRequest : public DNSResolver::Request {
  public:
   NativeDNSRequest(
@@ -58,6 +119,9 @@ class NativeDNSRequest : public DNSResolver::Request {
   // Starts the resolution
   void Start() override {
     Ref().release();  // ref held by callback
+#ifdef GRPC_LINUX_GETADDRINFO_A
+    if (StartAsync()) return;
+#endif
     Executor::Run(&request_closure_, GRPC_ERROR_NONE, ExecutorType::RESOLVER);
   }
 
@@ -77,11 +141,73 @@ class NativeDNSRequest : public DNSResolver::Request {
     r->Unref();
   }
 
+#ifdef GRPC_LINUX_GETADDRINFO_A
+  // Queues the lookup with getaddrinfo_a, so that it does not hold an
+  // executor thread while waiting for the DNS server. Returns false if the
+  // name does not parse or the lookup could not be queued, in which case
+  // the blocking path runs and reports any error.
+  bool StartAsync() {
+    if (!ParseHostPort(name_, default_port_, &host_, &port_).ok()) {
+      return false;
+    }
+    // The blocking path falls back to these ports if getaddrinfo does not
+    // know the service names.
+    if (port_ == "http") {
+      port_ = "80";
+    } else if (port_ == "https") {
+      port_ = "443";
+    }
+    InitHints(&hints_);
+    memset(&gaicb_, 0, sizeof(gaicb_));
+    gaicb_.ar_name = host_.c_str();
+    gaicb_.ar_service = port_.c_str();
+    gaicb_.ar_request = &hints_;
+    struct sigevent sev;
+    memset(&sev, 0, sizeof(sev));
+    sev.sigev_notify = SIGEV_THREAD;
+    sev.sigev_value.sival_ptr = this;
+    sev.sigev_notify_function = OnAsyncDone;
+    struct gaicb* list[] = {&gaicb_};
+    // Registered so that iomgr shutdown waits for the lookup to finish.
+    grpc_iomgr_register_object(&iomgr_object_, "getaddrinfo_a");
+    if (getaddrinfo_a(GAI_NOWAIT, list, 1, &sev) != 0) {
+      grpc_iomgr_unregister_object(&iomgr_object_);
+      return false;
+    }
+    return true;
+  }
+
+  // Called by glibc on a thread of its own once the lookup is done.
+  static void OnAsyncDone(union sigval sv) {
+    NativeDNSRequest* r = static_cast<NativeDNSRequest*>(sv.sival_ptr);
+    ApplicationCallbackExecCtx callback_exec_ctx;
+    ExecCtx exec_ctx;
+    const int s = gai_error(&r->gaicb_);
+    absl::StatusOr<std::vector<grpc_resolved_address>> result;
+    if (s == 0) {
+      result = AddressesFromAddrinfo(r->gaicb_.ar_result);
+    } else {
+      result = GetaddrinfoError(s, r->name_);
+    }
+    if (r->gaicb_.ar_result != nullptr) freeaddrinfo(r->gaicb_.ar_result);
+    r->on_done_(std::move(result));
+    grpc_iomgr_unregister_object(&r->iomgr_object_);
+    r->Unref();
+  }
+#endif
+
   const std::string name_;
   const std::string default_port_;
   const std::function<void(absl::StatusOr<std::vector<grpc_resolved_address>>)>
       on_done_;
   grpc_closure request_closure_;
+#ifdef GRPC_LINUX_GETADDRINFO_A
+  std::string host_;
+  std::string port_;
+  struct addrinfo hints_;
+  struct gaicb gaicb_;
+  grpc_iomgr_object iomgr_object_;
+#endif
 };
 
 }  // namespace
@@ -104,43 +230,21 @@ absl::StatusOr<std::vector<grpc_resolved_address>>
 NativeDNSResolver::ResolveNameBlocking(absl::string_view name,
                                        absl::string_view default_port) {
   ExecCtx exec_ctx;
-  struct addrinfo hints;
-  struct addrinfo *result = nullptr, *resp;
-  int s;
-  size_t i;
-  grpc_error_handle err;
-  std::vector<grpc_resolved_address> addresses;
   std::string host;
   std::string port;
-  // parse name, splitting it into host and port parts
-  SplitHostPort(name, &host, &port);
-  if (host.empty()) {
-    err = grpc_error_set_str(
-        GRPC_ERROR_CREATE_FROM_STATIC_STRING("unparseable host:port"),
-        GRPC_ERROR_STR_TARGET_ADDRESS, name);
-    goto done;
-  }
-  if (port.empty()) {
-    if (default_port.empty()) {
-      err = grpc_error_set_str(
-          GRPC_ERROR_CREATE_FROM_STATIC_STRING("no port in name"),
-          GRPC_ERROR_STR_TARGET_ADDRESS, name);
-      goto done;
-    }
-    port = std::string(default_port);
-  }
+  absl::Status status = ParseHostPort(name, default_port, &host, &port);
+  if (!status.ok()) return status;
   // Call getaddrinfo
-  memset(&hints, 0, sizeof(hints));
-  hints.ai_family = AF_UNSPEC;     /* ipv4 or ipv6 */
-  hints.ai_socktype = SOCK_STREAM; /* stream socket */
-  hints.ai_flags = AI_PASSIVE;     /* for wildcard IP address */
+  struct addrinfo hints;
+  InitHints(&hints);
+  struct addrinfo* result = nullptr;
   GRPC_SCHEDULING_START_BLOCKING_REGION;
-  s = getaddrinfo(host.c_str(), port.c_str(), &hints, &result);
+  int s = getaddrinfo(host.c_str(), port.c_str(), &hints, &result);
   GRPC_SCHEDULING_END_BLOCKING_REGION;
   if (s != 0) {
     // Retry if well-known service name is recognized
     const char* svc[][2] = {{"http", "80"}, {"https", "443"}};
-    for (i = 0; i < GPR_ARRAY_SIZE(svc); i++) {
+    for (size_t i = 0; i < GPR_ARRAY_SIZE(svc); i++) {
       if (port == svc[i][0]) {
         GRPC_SCHEDULING_START_BLOCKING_REGION;
         s = getaddrinfo(host.c_str(), svc[i][1], &hints, &result);
@@ -149,36 +253,11 @@ NativeDNSResolver::ResolveNameBlocking(absl::string_view name,
       }
     }
   }
-  if (s != 0) {
-    err = grpc_error_set_str(
-        grpc_error_set_str(
-            grpc_error_set_str(
-                grpc_error_set_int(
-                    GRPC_ERROR_CREATE_FROM_STATIC_STRING(gai_strerror(s)),
-                    GRPC_ERROR_INT_ERRNO, s),
-                GRPC_ERROR_STR_OS_ERROR, gai_strerror(s)),
-            GRPC_ERROR_STR_SYSCALL, "getaddrinfo"),
-        GRPC_ERROR_STR_TARGET_ADDRESS, name);
-    goto done;
-  }
-  // Success path: fill in addrs
-  for (resp = result; resp != nullptr; resp = resp->ai_next) {
-    grpc_resolved_address addr;
-    memcpy(&addr.addr, resp->ai_addr, resp->ai_addrlen);
-    addr.len = resp->ai_addrlen;
-    addresses.push_back(addr);
-  }
-  err = GRPC_ERROR_NONE;
-done:
-  if (result) {
-    freeaddrinfo(result);
-  }
-  if (err == GRPC_ERROR_NONE) {
-    return addresses;
-  }
-  auto error_result = grpc_error_to_absl_status(err);
-  GRPC_ERROR_UNREF(err);
-  return error_result;
+  if (s != 0) return GetaddrinfoError(s, name);
+  std::vector<grpc_resolved_address> addresses =
+      AddressesFromAddrinfo(result);
+  freeaddrinfo(result);
+  return addresses;
 }
 
 }  // namespace grpc_core
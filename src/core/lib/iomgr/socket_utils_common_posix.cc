@@ -35,6 +35,9 @@
 #else
 #include <netinet/tcp.h>
 #endif
+#ifdef GPR_LINUX
+#include <linux/filter.h>
+#endif
 #include <stdio.h>
 #include <string.h>
 #include <sys/socket.h>
@@ -209,6 +212,104 @@ grpc_error_handle grpc_set_socket_reuse_port(int fd, int reuse) {
 #endif
 }
 
+/* set SO_BUSY_POLL and SO_PREFER_BUSY_POLL */
+grpc_error_handle grpc_set_socket_busy_poll(int fd, int usec) {
+#ifndef SO_BUSY_POLL
+  (void)fd;
+  (void)usec;
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "SO_BUSY_POLL unavailable on compiling system");
+#else
+  if (0 != setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &usec, sizeof(usec))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(SO_BUSY_POLL)");
+  }
+#ifdef SO_PREFER_BUSY_POLL
+  int prefer = 1;
+  if (0 != setsockopt(fd, SOL_SOCKET, SO_PREFER_BUSY_POLL, &prefer,
+                      sizeof(prefer))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(SO_PREFER_BUSY_POLL)");
+  }
+#endif
+  return GRPC_ERROR_NONE;
+#endif
+}
+
+/* set SO_INCOMING_CPU */
+grpc_error_handle grpc_set_socket_incoming_cpu(int fd, int cpu) {
+#ifndef SO_INCOMING_CPU
+  (void)fd;
+  (void)cpu;
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "SO_INCOMING_CPU unavailable on compiling system");
+#else
+  if (0 != setsockopt(fd, SOL_SOCKET, SO_INCOMING_CPU, &cpu, sizeof(cpu))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(SO_INCOMING_CPU)");
+  }
+  return GRPC_ERROR_NONE;
+#endif
+}
+
+grpc_error_handle grpc_set_socket_reuse_port_cpu_steering(
+    int fd, unsigned num_sockets) {
+#if !defined(GPR_LINUX) || !defined(SO_ATTACH_REUSEPORT_CBPF)
+  (void)fd;
+  (void)num_sockets;
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "SO_ATTACH_REUSEPORT_CBPF unavailable on compiling system");
+#else
+  GPR_ASSERT(num_sockets > 0);
+  struct sock_filter code[] = {
+      /* A = the CPU that received the connection */
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0,
+       static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+      /* A = A % num_sockets */
+      {BPF_ALU | BPF_MOD | BPF_K, 0, 0, num_sockets},
+      /* the socket with index A in the group takes the connection */
+      {BPF_RET | BPF_A, 0, 0, 0},
+  };
+  struct sock_fprog prog;
+  prog.len = static_cast<unsigned short>(GPR_ARRAY_SIZE(code));
+  prog.filter = code;
+  if (0 != setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog,
+                      sizeof(prog))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(SO_ATTACH_REUSEPORT_CBPF)");
+  }
+  return GRPC_ERROR_NONE;
+#endif
+}
+
+/* set TCP_FASTOPEN_CONNECT */
+grpc_error_handle grpc_set_socket_tcp_fastopen_connect(int fd) {
+#ifndef TCP_FASTOPEN_CONNECT
+  (void)fd;
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "TCP_FASTOPEN_CONNECT unavailable on compiling system");
+#else
+  int val = 1;
+  if (0 != setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &val,
+                      sizeof(val))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(TCP_FASTOPEN_CONNECT)");
+  }
+  return GRPC_ERROR_NONE;
+#endif
+}
+
+/* set TCP_FASTOPEN */
+grpc_error_handle grpc_set_socket_tcp_fastopen(int fd, int queue_len) {
+#ifndef TCP_FASTOPEN
+  (void)fd;
+  (void)queue_len;
+  return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+      "TCP_FASTOPEN unavailable on compiling system");
+#else
+  if (0 != setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN, &queue_len,
+                      sizeof(queue_len))) {
+    return GRPC_OS_ERROR(errno, "setsockopt(TCP_FASTOPEN)");
+  }
+  return GRPC_ERROR_NONE;
+#endif
+}
+
 static gpr_once g_probe_so_reuesport_once = GPR_ONCE_INIT;
 static int g_support_so_reuseport = false;
 
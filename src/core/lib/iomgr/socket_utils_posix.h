@@ -65,6 +65,25 @@ grpc_error_handle grpc_set_socket_low_latency(int fd, int low_latency);
 /* set SO_REUSEPORT */
 grpc_error_handle grpc_set_socket_reuse_port(int fd, int reuse);
 
+/* set SO_BUSY_POLL to usec and, where available, SO_PREFER_BUSY_POLL */
+grpc_error_handle grpc_set_socket_busy_poll(int fd, int usec);
+
+/* set SO_INCOMING_CPU */
+grpc_error_handle grpc_set_socket_incoming_cpu(int fd, int cpu);
+
+/* attach a BPF program to the SO_REUSEPORT group of fd that picks the socket
+   with index (cpu % num_sockets) for a connection received on cpu */
+grpc_error_handle grpc_set_socket_reuse_port_cpu_steering(int fd,
+                                                          unsigned num_sockets);
+
+/* set TCP_FASTOPEN_CONNECT, so that the first write on a client socket is
+   sent with its SYN */
+grpc_error_handle grpc_set_socket_tcp_fastopen_connect(int fd);
+
+/* set TCP_FASTOPEN on a listening socket, accepting data in the SYN of up to
+   queue_len connections pending their handshake */
+grpc_error_handle grpc_set_socket_tcp_fastopen(int fd, int queue_len);
+
 /* Configure the default values for TCP_USER_TIMEOUT */
 void config_default_tcp_user_timeout(bool enable, int timeout, bool is_client);
 
@@ -23,6 +23,7 @@
 #ifdef GRPC_POSIX_SOCKET_TCP_CLIENT
 
 #include <errno.h>
+#include <limits.h>
 #include <netinet/in.h>
 #include <string.h>
 #include <unistd.h>
@@ -83,6 +84,17 @@ static grpc_error_handle prepare_socket(const grpc_resolved_address* addr,
     err = grpc_set_socket_tcp_user_timeout(fd, channel_args,
                                            true /* is_client */);
     if (err != GRPC_ERROR_NONE) goto error;
+    if (grpc_channel_args_find_integer(channel_args, GRPC_ARG_TCP_FASTOPEN,
+                                       {0, 0, INT_MAX}) != 0) {
+      err = grpc_set_socket_tcp_fastopen_connect(fd);
+      if (err != GRPC_ERROR_NONE) {
+        /* it's not fatal, so just log it. */
+        gpr_log(GPR_DEBUG, "TCP Fast Open unavailable, continuing: %s",
+                grpc_error_std_string(err).c_str());
+        GRPC_ERROR_UNREF(err);
+        err = GRPC_ERROR_NONE;
+      }
+    }
   }
   err = grpc_set_socket_no_sigpipe_if_possible(fd);
   if (err != GRPC_ERROR_NONE) goto error;
@@ -32,11 +32,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
 
 #include <algorithm>
+#include <atomic>
 #include <unordered_map>
 
 #include <grpc/slice.h>
@@ -89,6 +91,35 @@
 #define MSG_ZEROCOPY 0x4000000
 #endif
 
+// TCP zero copy receive socket option, with the same fallback rationale as
+// MSG_ZEROCOPY above.
+#ifndef TCP_ZEROCOPY_RECEIVE
+#define TCP_ZEROCOPY_RECEIVE 35
+#endif
+
+// Large writes over unix sockets can be passed to the peer as sealed memfds.
+#if defined(GPR_LINUX) && defined(GRPC_HAVE_UNIX_SOCKET)
+#define GRPC_HAVE_UNIX_FD_PASSING 1
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#ifndef MFD_ALLOW_SEALING
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS 1033
+#define F_GET_SEALS 1034
+#define F_SEAL_SEAL 0x0001
+#define F_SEAL_SHRINK 0x0002
+#define F_SEAL_GROW 0x0004
+#define F_SEAL_WRITE 0x0008
+#endif
+#endif /* GPR_LINUX && GRPC_HAVE_UNIX_SOCKET */
+
 #ifdef GRPC_MSG_IOVLEN_TYPE
 typedef GRPC_MSG_IOVLEN_TYPE msg_iovlen_type;
 #else
@@ -351,15 +382,142 @@ class TcpZerocopySendCtx {
   bool memory_limited_ = false;
 };
 
+// Receive-side counterpart of TcpZerocopySendCtx. Large reads are served by
+// mapping the pages of the socket's receive queue into user space with
+// getsockopt(TCP_ZEROCOPY_RECEIVE) instead of copying them with recvmsg().
+class TcpZerocopyReceiveCtx {
+ public:
+  static constexpr size_t kDefaultRecvBytesThreshold = 64 * 1024;  // 64KB
+
+  explicit TcpZerocopyReceiveCtx(
+      size_t recv_bytes_threshold = kDefaultRecvBytesThreshold)
+      : threshold_bytes_(recv_bytes_threshold) {}
+
+  bool enabled() const { return enabled_; }
+
+  void set_enabled(bool enabled) { enabled_ = enabled; }
+
+  // Only use zerocopy if at least this many bytes are pending on the socket.
+  // Mapping and unmapping pages (and the TLB shootdowns that come with it) is
+  // more expensive than copying small reads.
+  size_t threshold_bytes() const { return threshold_bytes_; }
+
+  // Maps up to max_bytes (rounded down to a whole number of pages) of the data
+  // pending on fd, and returns them in *slice. The mapped bytes are reserved
+  // from memory_owner until the slice is destroyed. Returns false if nothing
+  // could be mapped (eg. because the pending data is not page aligned), in
+  // which case the caller should fall back to recvmsg(). Permanently disables
+  // the context if the kernel does not support receive zerocopy.
+  bool Receive(int fd, size_t max_bytes, MemoryOwner* memory_owner,
+               grpc_slice* slice);
+
+ private:
+  bool enabled_ = false;
+  size_t threshold_bytes_ = kDefaultRecvBytesThreshold;
+};
+
+#ifdef GRPC_LINUX_ERRQUEUE
+namespace {
+
+// The leading fields of struct tcp_zerocopy_receive from <linux/tcp.h>. The
+// kernel accepts this layout from callers built against older headers.
+struct tcp_zerocopy_receive_args {
+  uint64_t address;
+  uint32_t length;
+  uint32_t recv_skip_hint;
+};
+
+// Reference count for a slice pointing into pages mapped by
+// TCP_ZEROCOPY_RECEIVE. Unmaps the pages, and releases the memory reserved
+// for them, when the slice is destroyed.
+class ZerocopyReceiveRefCount : public grpc_slice_refcount {
+ public:
+  ZerocopyReceiveRefCount(void* address, size_t length,
+                          MemoryAllocator::Reservation reservation)
+      : grpc_slice_refcount(Destroy),
+        address_(address),
+        length_(length),
+        reservation_(std::move(reservation)) {}
+  ~ZerocopyReceiveRefCount() { munmap(address_, length_); }
+
+ private:
+  static void Destroy(grpc_slice_refcount* p) {
+    delete static_cast<ZerocopyReceiveRefCount*>(p);
+  }
+
+  void* address_;
+  size_t length_;
+  MemoryAllocator::Reservation reservation_;
+};
+
+}  // namespace
+
+bool TcpZerocopyReceiveCtx::Receive(int fd, size_t max_bytes,
+                                    MemoryOwner* memory_owner,
+                                    grpc_slice* slice) {
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t map_length = std::min<size_t>(max_bytes, UINT32_MAX);
+  map_length -= map_length % page_size;
+  if (map_length == 0) return false;
+  void* address = mmap(nullptr, map_length, PROT_READ, MAP_SHARED, fd, 0);
+  if (address == MAP_FAILED) {
+    gpr_log(GPR_INFO, "Disabling TCP receive zerocopy: mmap failed: %s",
+            strerror(errno));
+    enabled_ = false;
+    return false;
+  }
+  tcp_zerocopy_receive_args zc;
+  memset(&zc, 0, sizeof(zc));
+  zc.address = reinterpret_cast<uintptr_t>(address);
+  zc.length = static_cast<uint32_t>(map_length);
+  socklen_t zc_len = sizeof(zc);
+  int err;
+  do {
+    err = getsockopt(fd, IPPROTO_TCP, TCP_ZEROCOPY_RECEIVE, &zc, &zc_len);
+  } while (err < 0 && errno == EINTR);
+  if (err < 0) {
+    if (errno != EAGAIN) {
+      gpr_log(GPR_INFO,
+              "Disabling TCP receive zerocopy: getsockopt failed: %s",
+              strerror(errno));
+      enabled_ = false;
+    }
+    munmap(address, map_length);
+    return false;
+  }
+  if (zc.length == 0) {
+    munmap(address, map_length);
+    return false;
+  }
+  if (zc.length < map_length) {
+    munmap(static_cast<char*>(address) + zc.length, map_length - zc.length);
+  }
+  slice->refcount = new ZerocopyReceiveRefCount(
+      address, zc.length, memory_owner->MakeReservation(zc.length));
+  slice->data.refcounted.bytes = static_cast<uint8_t*>(address);
+  slice->data.refcounted.length = zc.length;
+  return true;
+}
+#else  /* GRPC_LINUX_ERRQUEUE */
+bool TcpZerocopyReceiveCtx::Receive(int /*fd*/, size_t /*max_bytes*/,
+                                    MemoryOwner* /*memory_owner*/,
+                                    grpc_slice* /*slice*/) {
+  return false;
+}
+#endif /* GRPC_LINUX_ERRQUEUE */
+
 }  // namespace grpc_core
 
+using grpc_core::TcpZerocopyReceiveCtx;
 using grpc_core::TcpZerocopySendCtx;
 using grpc_core::TcpZerocopySendRecord;
 
 namespace {
 struct grpc_tcp {
-  grpc_tcp(int max_sends, size_t send_bytes_threshold)
-      : tcp_zerocopy_send_ctx(max_sends, send_bytes_threshold) {}
+  grpc_tcp(int max_sends, size_t send_bytes_threshold,
+           size_t recv_bytes_threshold)
+      : tcp_zerocopy_send_ctx(max_sends, send_bytes_threshold),
+        tcp_zerocopy_receive_ctx(recv_bytes_threshold) {}
   grpc_endpoint base;
   grpc_fd* em_fd;
   int fd;
@@ -369,6 +527,13 @@ struct grpc_tcp {
   bool has_posted_reclaimer;
   double target_length;
   double bytes_read_this_round;
+  /* target_length that reads start from, and go back to after being idle */
+  double initial_target_length;
+  /* Whether read buffers are freed while waiting for data */
+  bool release_idle_read_buffers;
+  /* When the endpoint last started waiting for data, or InfFuture() if it is
+   * not waiting */
+  grpc_core::Timestamp read_wait_start = grpc_core::Timestamp::InfFuture();
   grpc_core::RefCount refcount;
   gpr_atm shutdown_count;
 
@@ -387,6 +552,15 @@ struct grpc_tcp {
   /* byte within outgoing_buffer->slices[0] to write next */
   size_t outgoing_byte_idx;
 
+  /* Unix sockets only: writes of at least this many bytes are passed to the
+   * peer as a sealed memfd once it has said that it accepts them, which is
+   * what peer_accepts_fds records. Zero disables both directions. */
+  size_t fd_passing_threshold = 0;
+  std::atomic<bool> peer_accepts_fds{false};
+  /* memfd holding the rest of outgoing_buffer, kept when sending it hit
+   * EAGAIN. */
+  int pending_memfd = -1;
+
   grpc_closure* read_cb;
   grpc_closure* write_cb;
   grpc_closure* release_fd_cb;
@@ -426,6 +600,7 @@ struct grpc_tcp {
                                       on errors anymore */
   TcpZerocopySendCtx tcp_zerocopy_send_ctx;
   TcpZerocopySendRecord* current_zerocopy_send = nullptr;
+  TcpZerocopyReceiveCtx tcp_zerocopy_receive_ctx ABSL_GUARDED_BY(read_mu);
 };
 
 struct backup_poller {
@@ -592,6 +767,35 @@ static void finish_estimate(grpc_tcp* tcp) {
   tcp->bytes_read_this_round = 0;
 }
 
+/* A read that waited this long for data starts over from the initial
+ * target_length, rather than decaying from the size of the last burst. */
+static constexpr grpc_core::Duration kReadBufferIdleShrinkTime =
+    grpc_core::Duration::Seconds(1);
+
+/* Called when a read has to wait for the socket to become readable, because
+ * TCP_INQ or EAGAIN said that it has no pending data. Frees the read buffers
+ * so that idle connections hold no read memory; they are allocated again
+ * when data arrives. */
+static void release_read_buffers_while_waiting(grpc_tcp* tcp)
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(tcp->read_mu) {
+  if (!tcp->release_idle_read_buffers) return;
+  tcp->read_wait_start = grpc_core::ExecCtx::Get()->Now();
+  grpc_slice_buffer_reset_and_unref_internal(tcp->incoming_buffer);
+  grpc_slice_buffer_reset_and_unref_internal(&tcp->last_read_buffer);
+}
+
+/* Called when data arrives, before the read buffers are allocated. */
+static void maybe_shrink_after_idle(grpc_tcp* tcp)
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(tcp->read_mu) {
+  if (tcp->read_wait_start == grpc_core::Timestamp::InfFuture()) return;
+  if (grpc_core::ExecCtx::Get()->Now() - tcp->read_wait_start >=
+      kReadBufferIdleShrinkTime) {
+    tcp->target_length =
+        std::min(tcp->target_length, tcp->initial_target_length);
+  }
+  tcp->read_wait_start = grpc_core::Timestamp::InfFuture();
+}
+
 static grpc_error_handle tcp_annotate_error(grpc_error_handle src_error,
                                             grpc_tcp* tcp) {
   return grpc_error_set_str(
@@ -615,6 +819,9 @@ static void tcp_shutdown(grpc_endpoint* ep, grpc_error_handle why) {
 static void tcp_free(grpc_tcp* tcp) {
   grpc_fd_orphan(tcp->em_fd, tcp->release_fd_cb, tcp->release_fd,
                  "tcp_unref_orphan");
+  if (tcp->pending_memfd >= 0) {
+    close(tcp->pending_memfd);
+  }
   grpc_slice_buffer_destroy_internal(&tcp->last_read_buffer);
   /* The lock is not really necessary here, since all refs have been released */
   gpr_mu_lock(&tcp->tb_mu);
@@ -709,6 +916,97 @@ static void tcp_trace_read(grpc_tcp* tcp, grpc_error_handle error)
   }
 }
 
+/* Tries to serve the read by mapping the pending bytes with
+ * TCP_ZEROCOPY_RECEIVE. Returns false if the caller should copy them with
+ * recvmsg() instead. */
+static bool tcp_do_read_zerocopy(grpc_tcp* tcp)
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(tcp->read_mu) {
+  GPR_TIMER_SCOPE("tcp_do_read_zerocopy", 0);
+  GRPC_STATS_INC_TCP_ZEROCOPY_READ_ATTEMPTS();
+  grpc_slice slice;
+  size_t max_bytes = std::min(static_cast<size_t>(tcp->inq),
+                              static_cast<size_t>(tcp->max_read_chunk_size));
+  if (!tcp->tcp_zerocopy_receive_ctx.Receive(tcp->fd, max_bytes,
+                                             &tcp->memory_owner, &slice)) {
+    return false;
+  }
+  /* The slices allocated for copying are kept around for the next read */
+  grpc_slice_buffer_move_into(tcp->incoming_buffer, &tcp->last_read_buffer);
+  grpc_slice_buffer_add(tcp->incoming_buffer, slice);
+  GRPC_STATS_INC_TCP_ZEROCOPY_READS();
+  GRPC_STATS_INC_TCP_READ_SIZE(GRPC_SLICE_LENGTH(slice));
+  add_to_estimate(tcp, GRPC_SLICE_LENGTH(slice));
+  /* Whatever could not be mapped (at least any unaligned tail) is still
+   * pending on the socket. */
+  tcp->inq = 1;
+  return true;
+}
+
+#ifdef GRPC_HAVE_UNIX_FD_PASSING
+/* Takes the memfd passed with the bytes just read, if any. Any other
+ * descriptor, or more than one, breaks the protocol: they are all closed and
+ * an error is returned. */
+static grpc_error_handle tcp_take_received_fd(struct msghdr* msg, int* memfd) {
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  if (msg->msg_flags & MSG_CTRUNC) {
+    error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("Too many fds received");
+  }
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(msg, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+      continue;
+    }
+    size_t num_fds = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+    for (size_t i = 0; i < num_fds; i++) {
+      int fd;
+      memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+      if (error == GRPC_ERROR_NONE && *memfd < 0) {
+        *memfd = fd;
+        continue;
+      }
+      close(fd);
+      if (error == GRPC_ERROR_NONE) {
+        error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("Too many fds received");
+      }
+    }
+  }
+  if (error != GRPC_ERROR_NONE && *memfd >= 0) {
+    close(*memfd);
+    *memfd = -1;
+  }
+  return error;
+}
+
+static void tcp_unmap_memfd(void* p, size_t length) { munmap(p, length); }
+
+/* Maps a memfd received from the peer as a slice, and closes it. The memfd
+ * must be sealed, so that the peer cannot change it under the reader. */
+static grpc_error_handle tcp_map_memfd(int memfd, grpc_slice* slice) {
+  constexpr int kRequiredSeals = F_SEAL_SHRINK | F_SEAL_WRITE;
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  struct stat st;
+  int seals = fcntl(memfd, F_GET_SEALS);
+  if (seals < 0 || (seals & kRequiredSeals) != kRequiredSeals) {
+    error = GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+        "Received fd is not a sealed memfd");
+  } else if (fstat(memfd, &st) != 0) {
+    error = GRPC_OS_ERROR(errno, "fstat");
+  } else if (st.st_size <= 0) {
+    error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("Received memfd is empty");
+  } else {
+    size_t length = static_cast<size_t>(st.st_size);
+    void* p = mmap(nullptr, length, PROT_READ, MAP_SHARED, memfd, 0);
+    if (p == MAP_FAILED) {
+      error = GRPC_OS_ERROR(errno, "mmap");
+    } else {
+      *slice = grpc_slice_new_with_len(p, length, tcp_unmap_memfd);
+    }
+  }
+  close(memfd);
+  return error;
+}
+#endif /* GRPC_HAVE_UNIX_FD_PASSING */
+
 /* Returns true if data available to read or error other than EAGAIN. */
 #define MAX_READ_IOVEC 4
 static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
@@ -717,6 +1015,15 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
   if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
     gpr_log(GPR_INFO, "TCP:%p do_read", tcp);
   }
+  /* tcp->inq is only accurate when the kernel reports it with TCP_INQ, which
+   * is a precondition for enabling receive zerocopy. */
+  if (tcp->tcp_zerocopy_receive_ctx.enabled() &&
+      static_cast<size_t>(tcp->inq) >=
+          tcp->tcp_zerocopy_receive_ctx.threshold_bytes() &&
+      tcp_do_read_zerocopy(tcp)) {
+    *error = GRPC_ERROR_NONE;
+    return true;
+  }
   struct msghdr msg;
   struct iovec iov[MAX_READ_IOVEC];
   ssize_t read_bytes;
@@ -730,6 +1037,14 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
   constexpr size_t cmsg_alloc_space = 24 /* CMSG_SPACE(sizeof(int)) */;
 #endif /* GRPC_LINUX_ERRQUEUE */
   char cmsgbuf[cmsg_alloc_space];
+#ifdef GRPC_HAVE_UNIX_FD_PASSING
+  union {
+    char buf[CMSG_SPACE(sizeof(int))];
+    struct cmsghdr align;
+  } fd_cmsgbuf;
+  int received_memfd = -1;
+#endif /* GRPC_HAVE_UNIX_FD_PASSING */
+  int recv_flags = 0;
   for (size_t i = 0; i < iov_len; i++) {
     iov[i].iov_base = GRPC_SLICE_START_PTR(tcp->incoming_buffer->slices[i]);
     iov[i].iov_len = GRPC_SLICE_LENGTH(tcp->incoming_buffer->slices[i]);
@@ -754,6 +1069,13 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
       msg.msg_control = nullptr;
       msg.msg_controllen = 0;
     }
+#ifdef GRPC_HAVE_UNIX_FD_PASSING
+    if (tcp->fd_passing_threshold > 0) {
+      msg.msg_control = fd_cmsgbuf.buf;
+      msg.msg_controllen = sizeof(fd_cmsgbuf.buf);
+      recv_flags = MSG_CMSG_CLOEXEC;
+    }
+#endif /* GRPC_HAVE_UNIX_FD_PASSING */
     msg.msg_flags = 0;
 
     GRPC_STATS_INC_TCP_READ_OFFER(tcp->incoming_buffer->length);
@@ -762,7 +1084,7 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
     do {
       GPR_TIMER_SCOPE("recvmsg", 0);
       GRPC_STATS_INC_SYSCALL_READ();
-      read_bytes = recvmsg(tcp->fd, &msg, 0);
+      read_bytes = recvmsg(tcp->fd, &msg, recv_flags);
     } while (read_bytes < 0 && errno == EINTR);
 
     /* We have read something in previous reads. We need to deliver those
@@ -798,6 +1120,7 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
     }
 
     GRPC_STATS_INC_TCP_READ_SIZE(read_bytes);
+    GRPC_USDT_PROBE(tcp_read, tcp->fd, read_bytes);
     add_to_estimate(tcp, static_cast<size_t>(read_bytes));
     GPR_DEBUG_ASSERT((size_t)read_bytes <=
                      tcp->incoming_buffer->length - total_read_bytes);
@@ -816,6 +1139,23 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
     }
 #endif /* GRPC_HAVE_TCP_INQ */
 
+#ifdef GRPC_HAVE_UNIX_FD_PASSING
+    if (tcp->fd_passing_threshold > 0 && msg.msg_controllen > 0) {
+      grpc_error_handle fd_error = tcp_take_received_fd(&msg, &received_memfd);
+      if (fd_error != GRPC_ERROR_NONE) {
+        grpc_slice_buffer_reset_and_unref_internal(tcp->incoming_buffer);
+        *error = tcp_annotate_error(fd_error, tcp);
+        return true;
+      }
+    }
+    /* The kernel ends a read after bytes that came with descriptors, so the
+     * memfd belongs right after the bytes read so far. */
+    if (received_memfd >= 0) {
+      total_read_bytes += read_bytes;
+      break;
+    }
+#endif /* GRPC_HAVE_UNIX_FD_PASSING */
+
     total_read_bytes += read_bytes;
     if (tcp->inq == 0 || total_read_bytes == tcp->incoming_buffer->length) {
       break;
@@ -853,6 +1193,22 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
                                tcp->incoming_buffer->length - total_read_bytes,
                                &tcp->last_read_buffer);
   }
+#ifdef GRPC_HAVE_UNIX_FD_PASSING
+  if (received_memfd >= 0) {
+    /* The last byte read is the token the memfd was sent with, which is not
+     * part of the stream: the memfd contents take its place. */
+    grpc_slice_buffer_trim_end(tcp->incoming_buffer, 1,
+                               &tcp->last_read_buffer);
+    grpc_slice slice;
+    grpc_error_handle map_error = tcp_map_memfd(received_memfd, &slice);
+    if (map_error != GRPC_ERROR_NONE) {
+      grpc_slice_buffer_reset_and_unref_internal(tcp->incoming_buffer);
+      *error = tcp_annotate_error(map_error, tcp);
+      return true;
+    }
+    grpc_slice_buffer_add(tcp->incoming_buffer, slice);
+  }
+#endif /* GRPC_HAVE_UNIX_FD_PASSING */
   *error = GRPC_ERROR_NONE;
   return true;
 }
@@ -890,9 +1246,11 @@ static void tcp_handle_read(void* arg /* grpc_tcp */, grpc_error_handle error) {
   tcp->read_mu.Lock();
   grpc_error_handle tcp_read_error;
   if (GPR_LIKELY(error == GRPC_ERROR_NONE)) {
+    maybe_shrink_after_idle(tcp);
     maybe_make_read_slices(tcp);
     if (!tcp_do_read(tcp, &tcp_read_error)) {
       /* We've consumed the edge, request a new one */
+      release_read_buffers_while_waiting(tcp);
       tcp->read_mu.Unlock();
       notify_on_read(tcp);
       return;
@@ -920,6 +1278,9 @@ static void tcp_read(grpc_endpoint* ep, grpc_slice_buffer* incoming_buffer,
   tcp->incoming_buffer = incoming_buffer;
   grpc_slice_buffer_reset_and_unref_internal(incoming_buffer);
   grpc_slice_buffer_swap(incoming_buffer, &tcp->last_read_buffer);
+  if (!tcp->is_first_read && !urgent && tcp->inq == 0) {
+    release_read_buffers_while_waiting(tcp);
+  }
   tcp->read_mu.Unlock();
   TCP_REF(tcp, "read");
   if (tcp->is_first_read) {
@@ -953,6 +1314,11 @@ ssize_t tcp_send(int fd, const struct msghdr* msg, int additional_flags = 0) {
     GRPC_STATS_INC_SYSCALL_WRITE();
     sent_length = sendmsg(fd, msg, SENDMSG_FLAGS | additional_flags);
   } while (sent_length < 0 && errno == EINTR);
+  /* With TCP Fast Open, the first write on a socket that could not send data
+     in its SYN (no cookie from the server yet) only starts the handshake, and
+     fails with EINPROGRESS: wait for the socket to become writable. */
+  if (sent_length < 0 && errno == EINPROGRESS) errno = EAGAIN;
+  GRPC_USDT_PROBE(tcp_write, fd, sent_length);
   return sent_length;
 }
 
@@ -1425,6 +1791,87 @@ static bool tcp_flush_zerocopy(grpc_tcp* tcp, TcpZerocopySendRecord* record,
   return done;
 }
 
+#ifdef GRPC_HAVE_UNIX_FD_PASSING
+/* Returns how many bytes of outgoing_buffer are left to write, starting at
+ * slice outgoing_slice_idx. */
+static size_t tcp_unwritten_length(grpc_tcp* tcp, size_t outgoing_slice_idx) {
+  size_t written = tcp->outgoing_byte_idx;
+  for (size_t i = 0; i < outgoing_slice_idx; i++) {
+    written += GRPC_SLICE_LENGTH(tcp->outgoing_buffer->slices[i]);
+  }
+  return tcp->outgoing_buffer->length - written;
+}
+
+/* Copies the length unwritten bytes of outgoing_buffer into a new memfd,
+ * which is then sealed so that the peer can map it without fearing later
+ * changes. */
+static grpc_error_handle tcp_make_memfd(grpc_tcp* tcp,
+                                        size_t outgoing_slice_idx,
+                                        size_t length, int* memfd) {
+  int fd = static_cast<int>(
+      syscall(SYS_memfd_create, "grpc-tcp", MFD_CLOEXEC | MFD_ALLOW_SEALING));
+  if (fd < 0) {
+    return GRPC_OS_ERROR(errno, "memfd_create");
+  }
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  void* p = MAP_FAILED;
+  if (ftruncate(fd, static_cast<off_t>(length)) != 0) {
+    error = GRPC_OS_ERROR(errno, "ftruncate");
+  } else if ((p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                       fd, 0)) == MAP_FAILED) {
+    error = GRPC_OS_ERROR(errno, "mmap");
+  } else {
+    uint8_t* dst = static_cast<uint8_t*>(p);
+    size_t byte_idx = tcp->outgoing_byte_idx;
+    for (size_t i = outgoing_slice_idx; i < tcp->outgoing_buffer->count; i++) {
+      const grpc_slice& slice = tcp->outgoing_buffer->slices[i];
+      size_t n = GRPC_SLICE_LENGTH(slice) - byte_idx;
+      memcpy(dst, GRPC_SLICE_START_PTR(slice) + byte_idx, n);
+      dst += n;
+      byte_idx = 0;
+    }
+    /* Write seals are refused while writable mappings exist. */
+    munmap(p, length);
+    if (fcntl(fd, F_ADD_SEALS,
+              F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0) {
+      error = GRPC_OS_ERROR(errno, "fcntl(F_ADD_SEALS)");
+    }
+  }
+  if (error != GRPC_ERROR_NONE) {
+    close(fd);
+    return error;
+  }
+  *memfd = fd;
+  return GRPC_ERROR_NONE;
+}
+
+/* Sends memfd with a one byte token, which the peer drops from the stream
+ * and replaces with the memfd contents. */
+static ssize_t tcp_send_memfd(int fd, int memfd) {
+  char token = 0;
+  struct iovec iov;
+  iov.iov_base = &token;
+  iov.iov_len = 1;
+  union {
+    char buf[CMSG_SPACE(sizeof(int))];
+    struct cmsghdr align;
+  } control;
+  memset(&control, 0, sizeof(control));
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+  memcpy(CMSG_DATA(cmsg), &memfd, sizeof(int));
+  return tcp_send(fd, &msg);
+}
+#endif /* GRPC_HAVE_UNIX_FD_PASSING */
+
 static bool tcp_flush(grpc_tcp* tcp, grpc_error_handle* error) {
   struct msghdr msg;
   struct iovec iov[MAX_WRITE_IOVEC];
@@ -1440,6 +1887,38 @@ static bool tcp_flush(grpc_tcp* tcp, grpc_error_handle* error) {
   size_t outgoing_slice_idx = 0;
 
   while (true) {
+#ifdef GRPC_HAVE_UNIX_FD_PASSING
+    if (tcp->pending_memfd < 0 &&
+        tcp->peer_accepts_fds.load(std::memory_order_acquire)) {
+      size_t unwritten = tcp_unwritten_length(tcp, outgoing_slice_idx);
+      if (unwritten >= tcp->fd_passing_threshold) {
+        grpc_error_handle memfd_error = tcp_make_memfd(
+            tcp, outgoing_slice_idx, unwritten, &tcp->pending_memfd);
+        if (memfd_error != GRPC_ERROR_NONE) {
+          *error = tcp_annotate_error(memfd_error, tcp);
+          grpc_slice_buffer_reset_and_unref_internal(tcp->outgoing_buffer);
+          return true;
+        }
+      }
+    }
+    if (tcp->pending_memfd >= 0) {
+      /* The memfd holds everything left in outgoing_buffer, so there is
+       * nothing to unwind if the socket is full. */
+      if (tcp_send_memfd(tcp->fd, tcp->pending_memfd) < 0) {
+        if (errno == EAGAIN) {
+          return false;
+        }
+        *error = tcp_annotate_error(GRPC_OS_ERROR(errno, "sendmsg"), tcp);
+      } else {
+        *error = GRPC_ERROR_NONE;
+      }
+      close(tcp->pending_memfd);
+      tcp->pending_memfd = -1;
+      tcp->outgoing_byte_idx = 0;
+      grpc_slice_buffer_reset_and_unref_internal(tcp->outgoing_buffer);
+      return true;
+    }
+#endif /* GRPC_HAVE_UNIX_FD_PASSING */
     sending_length = 0;
     unwind_slice_idx = outgoing_slice_idx;
     unwind_byte_idx = tcp->outgoing_byte_idx;
@@ -1703,6 +2182,7 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
                                const grpc_channel_args* channel_args,
                                absl::string_view peer_string) {
   static constexpr bool kZerocpTxEnabledDefault = false;
+  static constexpr bool kZerocpRxEnabledDefault = false;
   int tcp_read_chunk_size = GRPC_TCP_DEFAULT_READ_SLICE_SIZE;
   int tcp_max_read_chunk_size = 4 * 1024 * 1024;
   int tcp_min_read_chunk_size = 256;
@@ -1711,6 +2191,11 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
       grpc_core::TcpZerocopySendCtx::kDefaultSendBytesThreshold;
   int tcp_tx_zerocopy_max_simult_sends =
       grpc_core::TcpZerocopySendCtx::kDefaultMaxSends;
+  bool tcp_rx_zerocopy_enabled = kZerocpRxEnabledDefault;
+  int tcp_rx_zerocopy_recv_bytes_thresh =
+      grpc_core::TcpZerocopyReceiveCtx::kDefaultRecvBytesThreshold;
+  int fd_passing_threshold = 0;
+  bool release_idle_read_buffers = true;
   if (channel_args != nullptr) {
     for (size_t i = 0; i < channel_args->num_args; i++) {
       if (0 ==
@@ -1745,6 +2230,26 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
             grpc_core::TcpZerocopySendCtx::kDefaultMaxSends, 0, INT_MAX};
         tcp_tx_zerocopy_max_simult_sends =
             grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED)) {
+        tcp_rx_zerocopy_enabled = grpc_channel_arg_get_bool(
+            &channel_args->args[i], kZerocpRxEnabledDefault);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_RX_ZEROCOPY_RECV_BYTES_THRESHOLD)) {
+        grpc_integer_options options = {
+            grpc_core::TcpZerocopyReceiveCtx::kDefaultRecvBytesThreshold, 0,
+            INT_MAX};
+        tcp_rx_zerocopy_recv_bytes_thresh =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_UNIX_FD_PASSING_THRESHOLD)) {
+        grpc_integer_options options = {0, 0, INT_MAX};
+        fd_passing_threshold =
+            grpc_channel_arg_get_integer(&channel_args->args[i], options);
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_TCP_RELEASE_IDLE_READ_BUFFERS)) {
+        release_idle_read_buffers =
+            grpc_channel_arg_get_bool(&channel_args->args[i], true);
       }
     }
   }
@@ -1756,13 +2261,16 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
       tcp_read_chunk_size, tcp_min_read_chunk_size, tcp_max_read_chunk_size);
 
   grpc_tcp* tcp = new grpc_tcp(tcp_tx_zerocopy_max_simult_sends,
-                               tcp_tx_zerocopy_send_bytes_thresh);
+                               tcp_tx_zerocopy_send_bytes_thresh,
+                               tcp_rx_zerocopy_recv_bytes_thresh);
   tcp->base.vtable = &vtable;
   tcp->peer_string = std::string(peer_string);
   tcp->fd = grpc_fd_wrapped_fd(em_fd);
-  tcp->memory_owner = grpc_core::ResourceQuotaFromChannelArgs(channel_args)
-                          ->memory_quota()
-                          ->CreateMemoryOwner(peer_string);
+  tcp->memory_owner =
+      grpc_core::ResourceQuotaFromChannelArgs(channel_args)
+          ->memory_quota()
+          ->CreateMemoryOwner(peer_string,
+                              grpc_core::MemoryCategory::kReadBuffer);
   tcp->self_reservation = tcp->memory_owner.MakeReservation(sizeof(grpc_tcp));
   grpc_resolved_address resolved_local_addr;
   memset(&resolved_local_addr, 0, sizeof(resolved_local_addr));
@@ -1776,12 +2284,18 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
   } else {
     tcp->local_address = addr_uri.value();
   }
+  if (reinterpret_cast<sockaddr*>(resolved_local_addr.addr)->sa_family ==
+      AF_UNIX) {
+    tcp->fd_passing_threshold = static_cast<size_t>(fd_passing_threshold);
+  }
   tcp->read_cb = nullptr;
   tcp->write_cb = nullptr;
   tcp->current_zerocopy_send = nullptr;
   tcp->release_fd_cb = nullptr;
   tcp->release_fd = nullptr;
   tcp->target_length = static_cast<double>(tcp_read_chunk_size);
+  tcp->initial_target_length = tcp->target_length;
+  tcp->release_idle_read_buffers = release_idle_read_buffers;
   tcp->min_read_chunk_size = tcp_min_read_chunk_size;
   tcp->max_read_chunk_size = tcp_max_read_chunk_size;
   tcp->bytes_read_this_round = 0;
@@ -1837,6 +2351,14 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
 #else
   tcp->inq_capable = false;
 #endif /* GRPC_HAVE_TCP_INQ */
+#ifdef GRPC_LINUX_ERRQUEUE
+  /* Receive zerocopy needs TCP_INQ to size the mappings. Whether the kernel
+   * supports it is only known after the first attempt. */
+  if (tcp_rx_zerocopy_enabled && tcp->inq_capable) {
+    grpc_core::MutexLock lock(&tcp->read_mu);
+    tcp->tcp_zerocopy_receive_ctx.set_enabled(true);
+  }
+#endif
   /* Start being notified on errors if event engine can track errors. */
   if (grpc_event_engine_can_track_errors()) {
     /* Grab a ref to tcp so that we can safely access the tcp struct when
@@ -1874,6 +2396,23 @@ void grpc_tcp_destroy_and_release_fd(grpc_endpoint* ep, int* fd,
   TCP_UNREF(tcp, "destroy");
 }
 
+bool grpc_tcp_can_receive_fds(grpc_endpoint* ep) {
+#ifdef GRPC_HAVE_UNIX_FD_PASSING
+  return ep->vtable == &vtable &&
+         reinterpret_cast<grpc_tcp*>(ep)->fd_passing_threshold > 0;
+#else
+  (void)ep;
+  return false;
+#endif /* GRPC_HAVE_UNIX_FD_PASSING */
+}
+
+void grpc_tcp_enable_fd_passing(grpc_endpoint* ep) {
+  if (grpc_tcp_can_receive_fds(ep)) {
+    reinterpret_cast<grpc_tcp*>(ep)->peer_accepts_fds.store(
+        true, std::memory_order_release);
+  }
+}
+
 void grpc_tcp_posix_init() { g_backup_poller_mu = new grpc_core::Mutex; }
 
 void grpc_tcp_posix_shutdown() {
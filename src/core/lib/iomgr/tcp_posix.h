@@ -54,6 +54,15 @@ int grpc_tcp_fd(grpc_endpoint* ep);
 void grpc_tcp_destroy_and_release_fd(grpc_endpoint* ep, int* fd,
                                      grpc_closure* done);
 
+/// Return true if \a ep is a tcp endpoint over a unix socket that accepts
+/// payloads passed as memfds (see GRPC_ARG_UNIX_FD_PASSING_THRESHOLD).
+bool grpc_tcp_can_receive_fds(grpc_endpoint* ep);
+
+/// Let \a ep pass large payloads as memfds, once the peer has said that it
+/// can receive them. Does nothing unless \a ep is a tcp endpoint over a unix
+/// socket with GRPC_ARG_UNIX_FD_PASSING_THRESHOLD set.
+void grpc_tcp_enable_fd_passing(grpc_endpoint* ep);
+
 #ifdef GRPC_POSIX_SOCKET_TCP
 
 void grpc_tcp_posix_init();
@@ -56,9 +56,23 @@ namespace grpc_core {
 // connection.
 class TcpServerFdHandler {
  public:
+  struct Connection {
+    int listener_fd;
+    int fd;
+    grpc_byte_buffer* pending_read;
+  };
+
   virtual ~TcpServerFdHandler() = default;
   virtual void Handle(int listener_fd, int fd,
                       grpc_byte_buffer* pending_read) = 0;
+  // Takes several connections at once. By default they are handled one at a
+  // time.
+  virtual void HandleBatch(const Connection* connections, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      Handle(connections[i].listener_fd, connections[i].fd,
+             connections[i].pending_read);
+    }
+  }
 };
 }  // namespace grpc_core
 
@@ -88,6 +88,12 @@ static grpc_error_handle tcp_server_create(grpc_closure* shutdown_complete,
         return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
             GRPC_ARG_EXPAND_WILDCARD_ADDRS " must be an integer");
       }
+    } else if (0 == strcmp(GRPC_ARG_TCP_SERVER_PER_CPU_LISTENERS,
+                           args->args[i].key)) {
+      s->per_cpu_listeners = grpc_channel_arg_get_bool(&args->args[i], false);
+    } else if (0 == strcmp(GRPC_ARG_TCP_SERVER_CPU_STEERING_BPF,
+                           args->args[i].key)) {
+      s->cpu_steering_bpf = grpc_channel_arg_get_bool(&args->args[i], false);
     }
   }
   gpr_ref_init(&s->refs, 1);
@@ -271,10 +277,14 @@ static void on_read(void* arg, grpc_error_handle err) {
     std::string name = absl::StrCat("tcp-server-connection:", addr_uri.value());
     grpc_fd* fdobj = grpc_fd_create(fd, name.c_str(), true);
 
-    read_notifier_pollset = (*(sp->server->pollsets))
-        [static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
-             &sp->server->next_pollset_to_assign, 1)) %
-         sp->server->pollsets->size()];
+    if (sp->pollset != nullptr) {
+      read_notifier_pollset = sp->pollset;
+    } else {
+      read_notifier_pollset = (*(sp->server->pollsets))
+          [static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
+               &sp->server->next_pollset_to_assign, 1)) %
+           sp->server->pollsets->size()];
+    }
 
     grpc_pollset_add_fd(read_notifier_pollset, fdobj);
 
@@ -372,6 +382,7 @@ static grpc_error_handle add_wildcard_addrs_to_server(grpc_tcp_server* s,
 static grpc_error_handle clone_port(grpc_tcp_listener* listener,
                                     unsigned count) {
   grpc_tcp_listener* sp = nullptr;
+  grpc_tcp_listener* prev = listener;
   absl::StatusOr<std::string> addr_str;
   grpc_error_handle err;
 
@@ -395,13 +406,16 @@ static grpc_error_handle clone_port(grpc_tcp_listener* listener,
       return GRPC_ERROR_CREATE_FROM_CPP_STRING(addr_str.status().ToString());
     }
     sp = static_cast<grpc_tcp_listener*>(gpr_malloc(sizeof(grpc_tcp_listener)));
-    sp->next = listener->next;
-    listener->next = sp;
+    /* Clones are kept in bind order after 'listener', which is also their
+       order in the kernel's SO_REUSEPORT group. */
+    sp->next = prev->next;
+    prev->next = sp;
     /* sp (the new listener) is a sibling of 'listener' (the original
        listener). */
     sp->is_sibling = 1;
-    sp->sibling = listener->sibling;
-    listener->sibling = sp;
+    sp->sibling = prev->sibling;
+    prev->sibling = sp;
+    prev = sp;
     sp->server = listener->server;
     sp->fd = fd;
     sp->emfd = grpc_fd_create(
@@ -412,7 +426,8 @@ static grpc_error_handle clone_port(grpc_tcp_listener* listener,
     memcpy(&sp->addr, &listener->addr, sizeof(grpc_resolved_address));
     sp->port = port;
     sp->port_index = listener->port_index;
-    sp->fd_index = listener->fd_index + count - i;
+    sp->fd_index = listener->fd_index + 1 + i;
+    sp->pollset = nullptr;
     GPR_ASSERT(sp->emfd);
     while (listener->server->tail->next != nullptr) {
       listener->server->tail = listener->server->tail->next;
@@ -515,6 +530,24 @@ static int tcp_server_port_fd(grpc_tcp_server* s, unsigned port_index,
   return -1;
 }
 
+/* Ties the 'count' listeners of the SO_REUSEPORT group starting at 'sp' to
+   CPUs 0..count-1, so that a connection tends to be accepted by the listener
+   of the CPU that received it. Best effort: the kernel falls back to hashing
+   across the group. */
+static void steer_listeners_by_cpu(grpc_tcp_listener* sp, size_t count) {
+  if (sp->server->cpu_steering_bpf) {
+    GRPC_LOG_IF_ERROR(
+        "cpu_steering_bpf",
+        grpc_set_socket_reuse_port_cpu_steering(sp->fd,
+                                                static_cast<unsigned>(count)));
+  }
+  for (size_t i = 0; i < count; i++, sp = sp->next) {
+    GRPC_LOG_IF_ERROR(
+        "incoming_cpu",
+        grpc_set_socket_incoming_cpu(sp->fd, static_cast<int>(i)));
+  }
+}
+
 static void tcp_server_start(grpc_tcp_server* s,
                              const std::vector<grpc_pollset*>* pollsets,
                              grpc_tcp_server_cb on_accept_cb,
@@ -534,8 +567,10 @@ static void tcp_server_start(grpc_tcp_server* s,
         pollsets->size() > 1) {
       GPR_ASSERT(GRPC_LOG_IF_ERROR(
           "clone_port", clone_port(sp, (unsigned)(pollsets->size() - 1))));
+      if (s->per_cpu_listeners) steer_listeners_by_cpu(sp, pollsets->size());
       for (i = 0; i < pollsets->size(); i++) {
         grpc_pollset_add_fd((*pollsets)[i], sp->emfd);
+        if (s->per_cpu_listeners) sp->pollset = (*pollsets)[i];
         GRPC_CLOSURE_INIT(&sp->read_closure, on_read, sp,
                           grpc_schedule_on_exec_ctx);
         grpc_fd_notify_on_read(sp->emfd, &sp->read_closure);
@@ -598,13 +633,39 @@ class ExternalConnectionHandler : public grpc_core::TcpServerFdHandler {
  public:
   explicit ExternalConnectionHandler(grpc_tcp_server* s) : s_(s) {}
 
-  // TODO(yangg) resolve duplicate code with on_read
   void Handle(int listener_fd, int fd, grpc_byte_buffer* buf) override {
+    grpc_core::ExecCtx exec_ctx;
+    HandleConnection(listener_fd, fd, buf, ClaimPollsets(1));
+  }
+
+  // All the connections share one ExecCtx, and claim their pollsets with a
+  // single atomic add.
+  void HandleBatch(const Connection* connections, size_t count) override {
+    if (count == 0) return;
+    grpc_core::ExecCtx exec_ctx;
+    size_t pollset_index = ClaimPollsets(count);
+    for (size_t i = 0; i < count; ++i) {
+      HandleConnection(connections[i].listener_fd, connections[i].fd,
+                       connections[i].pending_read, pollset_index + i);
+    }
+  }
+
+ private:
+  // Returns the first of count consecutive pollset indexes, to be taken
+  // modulo the number of pollsets.
+  size_t ClaimPollsets(size_t count) {
+    return static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
+        &s_->next_pollset_to_assign, static_cast<gpr_atm>(count)));
+  }
+
+  // Hands fd, accepted on listener_fd outside of this server, to the accept
+  // callback, polled by the pollset at pollset_index.
+  void HandleConnection(int listener_fd, int fd, grpc_byte_buffer* buf,
+                        size_t pollset_index) {
     grpc_pollset* read_notifier_pollset;
     grpc_resolved_address addr;
     memset(&addr, 0, sizeof(addr));
     addr.len = static_cast<socklen_t>(sizeof(struct sockaddr_storage));
-    grpc_core::ExecCtx exec_ctx;
 
     if (getpeername(fd, reinterpret_cast<struct sockaddr*>(addr.addr),
                     &(addr.len)) < 0) {
@@ -626,9 +687,7 @@ class ExternalConnectionHandler : public grpc_core::TcpServerFdHandler {
     std::string name = absl::StrCat("tcp-server-connection:", addr_uri.value());
     grpc_fd* fdobj = grpc_fd_create(fd, name.c_str(), true);
     read_notifier_pollset =
-        (*(s_->pollsets))[static_cast<size_t>(gpr_atm_no_barrier_fetch_add(
-                              &s_->next_pollset_to_assign, 1)) %
-                          s_->pollsets->size()];
+        (*(s_->pollsets))[pollset_index % s_->pollsets->size()];
     grpc_pollset_add_fd(read_notifier_pollset, fdobj);
     grpc_tcp_server_acceptor* acceptor =
         static_cast<grpc_tcp_server_acceptor*>(gpr_malloc(sizeof(*acceptor)));
@@ -643,7 +702,6 @@ class ExternalConnectionHandler : public grpc_core::TcpServerFdHandler {
                      read_notifier_pollset, acceptor);
   }
 
- private:
   grpc_tcp_server* s_;
 };
 }  // namespace
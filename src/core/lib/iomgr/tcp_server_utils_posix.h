@@ -47,6 +47,9 @@ typedef struct grpc_tcp_listener {
      identified while iterating through 'next'. */
   struct grpc_tcp_listener* sibling;
   int is_sibling;
+  /* the pollset accepted connections are bound to, or NULL to spread them over
+     all of the server's pollsets */
+  grpc_pollset* pollset;
 } grpc_tcp_listener;
 
 /* the overall server */
@@ -71,6 +74,11 @@ struct grpc_tcp_server {
   bool so_reuseport = false;
   /* expand wildcard addresses to a list of all local addresses */
   bool expand_wildcard_addrs = false;
+  /* give each pollset its own SO_REUSEPORT listener and keep the connections
+     it accepts on that pollset */
+  bool per_cpu_listeners = false;
+  /* steer connections to per_cpu_listeners by CPU with a BPF program */
+  bool cpu_steering_bpf = false;
 
   /* linked list of server ports */
   grpc_tcp_listener* head = nullptr;
@@ -37,6 +37,7 @@
 #include <grpc/support/sync.h>
 
 #include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/sockaddr.h"
 #include "src/core/lib/iomgr/tcp_server_utils_posix.h"
@@ -118,6 +119,7 @@ static grpc_error_handle add_socket_to_server(grpc_tcp_server* s, int fd,
   sp->fd_index = fd_index;
   sp->is_sibling = 0;
   sp->sibling = nullptr;
+  sp->pollset = nullptr;
   GPR_ASSERT(sp->emfd);
   gpr_mu_unlock(&s->mu);
 
@@ -181,6 +183,18 @@ grpc_error_handle grpc_tcp_server_prepare_socket(
     err = grpc_set_socket_tcp_user_timeout(fd, s->channel_args,
                                            false /* is_client */);
     if (err != GRPC_ERROR_NONE) goto error;
+    const int fastopen_queue_len = grpc_channel_args_find_integer(
+        s->channel_args, GRPC_ARG_TCP_FASTOPEN, {0, 0, INT_MAX});
+    if (fastopen_queue_len > 0) {
+      err = grpc_set_socket_tcp_fastopen(fd, fastopen_queue_len);
+      if (err != GRPC_ERROR_NONE) {
+        /* it's not fatal, so just log it. */
+        gpr_log(GPR_DEBUG, "TCP Fast Open unavailable, continuing: %s",
+                grpc_error_std_string(err).c_str());
+        GRPC_ERROR_UNREF(err);
+        err = GRPC_ERROR_NONE;
+      }
+    }
   }
   err = grpc_set_socket_no_sigpipe_if_possible(fd);
   if (err != GRPC_ERROR_NONE) goto error;
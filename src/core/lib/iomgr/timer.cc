@@ -20,16 +20,42 @@
 
 #include "src/core/lib/iomgr/timer.h"
 
+#include <string.h>
+
+#include <grpc/support/log.h>
+
 #include "src/core/lib/iomgr/timer_manager.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_STRING(
+    grpc_timer_strategy, "generic",
+    "Declares which timer implementation to use: generic (sharded heaps) or "
+    "wheel (hierarchical timing wheel).")
+
+extern grpc_timer_vtable grpc_generic_timer_vtable;
+extern grpc_timer_vtable grpc_wheel_timer_vtable;
+
 grpc_timer_vtable* grpc_timer_impl;
 
 void grpc_set_timer_impl(grpc_timer_vtable* vtable) {
   grpc_timer_impl = vtable;
 }
 
+void grpc_set_default_timer_impl() {
+  grpc_core::UniquePtr<char> value = GPR_GLOBAL_CONFIG_GET(grpc_timer_strategy);
+  if (strcmp(value.get(), "wheel") == 0) {
+    grpc_set_timer_impl(&grpc_wheel_timer_vtable);
+    return;
+  }
+  if (strcmp(value.get(), "generic") != 0) {
+    gpr_log(GPR_ERROR, "Unknown timer strategy '%s', using 'generic'",
+            value.get());
+  }
+  grpc_set_timer_impl(&grpc_generic_timer_vtable);
+}
+
 void grpc_timer_init(grpc_timer* timer, grpc_core::Timestamp deadline,
                      grpc_closure* closure) {
+  grpc_timer_manager_on_timer_armed();
   grpc_timer_impl->init(timer, deadline, closure);
 }
 
@@ -26,13 +26,17 @@
 #include <grpc/event_engine/event_engine.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/port.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_STRING(grpc_timer_strategy);
+
 typedef struct grpc_timer {
   int64_t deadline;
   // Uninitialized if not using heap, or INVALID_HEAP_INDEX if not in heap.
+  // The timing wheel keeps the index of the slot holding the timer here.
   uint32_t heap_index;
   bool pending;
   struct grpc_timer* next;
@@ -133,4 +137,8 @@ void grpc_kick_poller(void);
 /* Sets the timer implementation */
 void grpc_set_timer_impl(grpc_timer_vtable* vtable);
 
+/* Sets the timer implementation named by the grpc_timer_strategy config:
+   grpc_generic_timer_vtable by default, grpc_wheel_timer_vtable for "wheel" */
+void grpc_set_default_timer_impl();
+
 #endif /* GRPC_CORE_LIB_IOMGR_TIMER_H */
@@ -29,6 +29,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gpr/spinlock.h"
 #include "src/core/lib/gpr/tls.h"
@@ -538,6 +539,10 @@ static grpc_timer* pop_one(timer_shard* shard, grpc_core::Timestamp now) {
       gpr_log(GPR_INFO, "TIMER %p: FIRE %" PRId64 "ms late", timer,
               (now - timer_deadline).millis());
     }
+    GRPC_STATS_INC_TIMER_LATENESS_MILLIS((now - timer_deadline).millis());
+    grpc_core::TraceRing::Record(&grpc_timer_trace, "fire",
+                                 reinterpret_cast<intptr_t>(timer),
+                                 (now - timer_deadline).millis());
     timer->pending = false;
     grpc_timer_heap_pop(&shard->heap);
     return timer;
@@ -22,12 +22,15 @@
 
 #include <inttypes.h>
 
+#include <atomic>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
 
 struct completed_thread {
   grpc_core::Thread thd;
@@ -61,6 +64,8 @@ static grpc_core::Timestamp g_timed_waiter_deadline;
 static uint64_t g_timed_waiter_generation;
 // number of timer wakeups
 static uint64_t g_wakeups;
+// is the first thread waiting for the first timer to be armed?
+static std::atomic<bool> g_first_thread_deferred{false};
 
 static void timer_thread(void* completed_thread_ptr);
 
@@ -111,10 +116,12 @@ static void run_some_timers() {
   gpr_mu_lock(&g_mu);
   // remove a waiter from the pool, and start another thread if necessary
   --g_waiter_count;
-  if (g_waiter_count == 0 && g_threaded) {
+  if (g_waiter_count == 0 && g_threaded &&
+      grpc_core::ResourceQuota::Default()->thread_quota()->Reserve(1)) {
     // The number of timer threads is always increasing until all the threads
     // are stopped. In rare cases, if a large number of timers fire
-    // simultaneously, we may end up using a large number of threads.
+    // simultaneously, we may end up using a large number of threads, unless
+    // the thread quota stops us: the timers then wait for a busy thread.
     start_timer_thread_and_unlock();
   } else {
     // if there's no thread waiting with a timeout, kick an existing untimed
@@ -273,6 +280,7 @@ static void timer_thread_cleanup(completed_thread* ct) {
   ct->next = g_completed_threads;
   g_completed_threads = ct;
   gpr_mu_unlock(&g_mu);
+  grpc_core::ResourceQuota::Default()->thread_quota()->Release(1);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
     gpr_log(GPR_INFO, "End timer thread");
   }
@@ -287,10 +295,30 @@ static void timer_thread(void* completed_thread_ptr) {
   timer_thread_cleanup(static_cast<completed_thread*>(completed_thread_ptr));
 }
 
-static void start_threads(void) {
+static void start_threads(bool deferred) {
   gpr_mu_lock(&g_mu);
   if (!g_threaded) {
     g_threaded = true;
+    if (deferred) {
+      g_first_thread_deferred.store(true, std::memory_order_release);
+      gpr_mu_unlock(&g_mu);
+      return;
+    }
+    // Timers cannot fire without a thread, so the first one is started
+    // regardless of the thread quota.
+    grpc_core::ResourceQuota::Default()->thread_quota()->ForceReserve(1);
+    start_timer_thread_and_unlock();
+  } else {
+    gpr_mu_unlock(&g_mu);
+  }
+}
+
+void grpc_timer_manager_on_timer_armed(void) {
+  if (!g_first_thread_deferred.load(std::memory_order_acquire)) return;
+  gpr_mu_lock(&g_mu);
+  if (g_first_thread_deferred.exchange(false, std::memory_order_relaxed) &&
+      g_threaded) {
+    grpc_core::ResourceQuota::Default()->thread_quota()->ForceReserve(1);
     start_timer_thread_and_unlock();
   } else {
     gpr_mu_unlock(&g_mu);
@@ -309,7 +337,8 @@ void grpc_timer_manager_init(void) {
   g_has_timed_waiter = false;
   g_timed_waiter_deadline = grpc_core::Timestamp::InfFuture();
 
-  start_threads();
+  // Processes that never arm a timer never pay for the thread.
+  start_threads(/*deferred=*/true);
 }
 
 static void stop_threads(void) {
@@ -317,6 +346,7 @@ static void stop_threads(void) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
     gpr_log(GPR_INFO, "stop timer threads: threaded=%d", g_threaded);
   }
+  g_first_thread_deferred.store(false, std::memory_order_relaxed);
   if (g_threaded) {
     g_threaded = false;
     gpr_cv_broadcast(&g_cv_wait);
@@ -345,7 +375,9 @@ void grpc_timer_manager_shutdown(void) {
 
 void grpc_timer_manager_set_threading(bool enabled) {
   if (enabled) {
-    start_threads();
+    // Timers may be pending already, so the thread cannot wait for the next
+    // one to be armed.
+    start_threads(/*deferred=*/false);
   } else {
     stop_threads();
   }
@@ -32,6 +32,9 @@ void grpc_timer_manager_shutdown(void);
 /* enable/disable threading - must be called after grpc_timer_manager_init and
  * before grpc_timer_manager_shutdown */
 void grpc_timer_manager_set_threading(bool enabled);
+/* starts the first timer thread, if grpc_timer_manager_init deferred it -
+ * called whenever a timer is armed */
+void grpc_timer_manager_on_timer_armed(void);
 /* explicitly perform one tick of the timer system - for when threading is
  * disabled */
 void grpc_timer_manager_tick(void);
@@ -0,0 +1,507 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpc/support/port_platform.h>
+
+#include <inttypes.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+
+/* A hierarchical timing wheel with a tick of one millisecond.
+ *
+ * Each of the WHEEL_LEVELS levels has WHEEL_SLOTS slots, and a slot of level L
+ * spans WHEEL_SLOTS^L ticks. A timer lives in level L when its deadline agrees
+ * with the wheel's current time ('base') on every digit above level L but not
+ * on digit L itself, in the slot selected by that digit. Timers too far out for
+ * the top level live in an unordered overflow list. Adding and cancelling a
+ * timer is therefore O(1), which matters since most timers (deadlines,
+ * keepalives) are cancelled long before they fire.
+ *
+ * When 'base' reaches the start of an occupied slot of level L > 0, that slot's
+ * timers are re-added to the wheel, landing in lower levels ("cascading"), so a
+ * timer is moved at most once per level before it fires. A bitmap of occupied
+ * slots lets the wheel jump over idle time instead of visiting every tick.
+ *
+ * Like timer_generic.cc, timers are spread over shards by address so that
+ * adding and cancelling rarely contend on the same lock.
+ */
+
+#define WHEEL_LEVELS 4
+#define WHEEL_SLOT_BITS 8
+#define WHEEL_SLOTS (1 << WHEEL_SLOT_BITS)
+#define WHEEL_SLOT_MASK (WHEEL_SLOTS - 1)
+/* Index of the overflow list; lists [0, OVERFLOW_LIST) are wheel slots */
+#define OVERFLOW_LIST (WHEEL_LEVELS * WHEEL_SLOTS)
+#define NUM_LISTS (OVERFLOW_LIST + 1)
+
+extern grpc_core::TraceFlag grpc_timer_trace;
+extern grpc_core::TraceFlag grpc_timer_check_trace;
+
+struct wheel_shard {
+  gpr_mu mu;
+  /* Every timer with a deadline earlier than this has been popped */
+  int64_t base;
+  /* Lower bound on the deadline of the next timer due in this shard */
+  int64_t min_deadline;
+  /* Doubly linked lists (without a sentinel) of the timers in each slot. A
+     timer's heap_index holds the index of the list it is on. */
+  grpc_timer* lists[NUM_LISTS];
+  /* One bit per wheel slot, set iff the slot's list is non-empty */
+  uint64_t occupied[OVERFLOW_LIST / 64];
+};
+
+static size_t g_num_shards;
+static wheel_shard* g_shards;
+
+/* The minimum of the shards' min_deadline: no timer fires before this.
+   Written under g_mu, read without it. */
+static std::atomic<int64_t> g_min_timer;
+/* Protects lowering g_min_timer against a concurrent recomputation */
+static gpr_mu g_mu;
+/* Allow only one run_some_expired_timers at once */
+static gpr_spinlock g_checker_mu;
+static bool g_initialized;
+
+/* Thread local copy of the last g_min_timer seen, to avoid touching the shared
+ * cacheline in the common case */
+static GPR_THREAD_LOCAL(int64_t) g_last_seen_min_timer;
+
+static int count_trailing_zeros(uint64_t x) {
+  return static_cast<int>(grpc_core::BitCount((x & (~x + 1)) - 1));
+}
+
+/* Returns the list the timer with this deadline goes on.
+   REQUIRES: deadline >= base */
+static uint32_t list_for_deadline(int64_t base, int64_t deadline) {
+  for (int level = 0; level < WHEEL_LEVELS; level++) {
+    int higher_digits_shift = (level + 1) * WHEEL_SLOT_BITS;
+    if ((deadline >> higher_digits_shift) == (base >> higher_digits_shift)) {
+      return level * WHEEL_SLOTS +
+             ((deadline >> (level * WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK);
+    }
+  }
+  return OVERFLOW_LIST;
+}
+
+/* REQUIRES: shard->mu locked */
+static void add_timer(wheel_shard* shard, grpc_timer* timer) {
+  uint32_t index =
+      list_for_deadline(shard->base, std::max(timer->deadline, shard->base));
+  timer->heap_index = index;
+  timer->prev = nullptr;
+  timer->next = shard->lists[index];
+  if (timer->next != nullptr) timer->next->prev = timer;
+  shard->lists[index] = timer;
+  if (index != OVERFLOW_LIST) {
+    shard->occupied[index / 64] |= uint64_t{1} << (index % 64);
+  }
+}
+
+/* REQUIRES: shard->mu locked */
+static void remove_timer(wheel_shard* shard, grpc_timer* timer) {
+  uint32_t index = timer->heap_index;
+  if (timer->prev != nullptr) {
+    timer->prev->next = timer->next;
+  } else {
+    shard->lists[index] = timer->next;
+  }
+  if (timer->next != nullptr) timer->next->prev = timer->prev;
+  if (shard->lists[index] == nullptr && index != OVERFLOW_LIST) {
+    shard->occupied[index / 64] &= ~(uint64_t{1} << (index % 64));
+  }
+}
+
+/* Detaches and returns the whole of list 'index'.
+   REQUIRES: shard->mu locked */
+static grpc_timer* take_list(wheel_shard* shard, uint32_t index) {
+  grpc_timer* head = shard->lists[index];
+  shard->lists[index] = nullptr;
+  if (index != OVERFLOW_LIST) {
+    shard->occupied[index / 64] &= ~(uint64_t{1} << (index % 64));
+  }
+  return head;
+}
+
+/* Returns the first occupied slot of 'level' at or after 'slot', or -1.
+   REQUIRES: shard->mu locked */
+static int next_occupied_slot(wheel_shard* shard, int level, int slot) {
+  while (slot < WHEEL_SLOTS) {
+    uint32_t bit = level * WHEEL_SLOTS + slot;
+    uint64_t word = shard->occupied[bit / 64] >> (bit % 64);
+    if (word != 0) return slot + count_trailing_zeros(word);
+    slot += 64 - bit % 64;
+  }
+  return -1;
+}
+
+/* Returns the earliest time at which a slot above level 0 (or the overflow
+   list) must be cascaded, and stores that list's index in *index. Returns
+   INT64_MAX if there is nothing above level 0.
+   REQUIRES: shard->mu locked */
+static int64_t next_cascade(wheel_shard* shard, uint32_t* index) {
+  for (int level = 1; level < WHEEL_LEVELS; level++) {
+    int shift = level * WHEEL_SLOT_BITS;
+    int current = static_cast<int>((shard->base >> shift) & WHEEL_SLOT_MASK);
+    int slot = next_occupied_slot(shard, level, current + 1);
+    if (slot != -1) {
+      *index = level * WHEEL_SLOTS + slot;
+      int64_t higher_digits = shard->base >> (shift + WHEEL_SLOT_BITS);
+      return ((higher_digits << WHEEL_SLOT_BITS) + slot) << shift;
+    }
+  }
+  if (shard->lists[OVERFLOW_LIST] != nullptr) {
+    *index = OVERFLOW_LIST;
+    int shift = WHEEL_LEVELS * WHEEL_SLOT_BITS;
+    return ((shard->base >> shift) + 1) << shift;
+  }
+  return std::numeric_limits<int64_t>::max();
+}
+
+/* Schedules the closures of all timers on the list with 'error'.
+   REQUIRES: shard->mu locked */
+static size_t pop_list(grpc_timer* timer, grpc_core::Timestamp now,
+                       grpc_error_handle error) {
+  size_t n = 0;
+  while (timer != nullptr) {
+    grpc_timer* next = timer->next;
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+      gpr_log(GPR_INFO, "TIMER %p: FIRE %" PRId64 "ms late", timer,
+              now.milliseconds_after_process_epoch() - timer->deadline);
+    }
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            GRPC_ERROR_REF(error));
+    timer = next;
+    n++;
+  }
+  return n;
+}
+
+/* Moves the wheel forward past 'now', popping every timer due by then.
+   REQUIRES: shard->mu locked */
+static size_t advance_wheel(wheel_shard* shard, grpc_core::Timestamp now,
+                            grpc_error_handle error) {
+  size_t n = 0;
+  if (now == grpc_core::Timestamp::InfFuture()) {
+    for (uint32_t i = 0; i < NUM_LISTS; i++) {
+      n += pop_list(take_list(shard, i), now, error);
+    }
+    return n;
+  }
+  int64_t target = now.milliseconds_after_process_epoch() + 1;
+  while (shard->base < target) {
+    /* Pop what is due in the current run of level 0 slots */
+    int64_t run_start = shard->base & ~int64_t{WHEEL_SLOT_MASK};
+    int64_t last = std::min<int64_t>(target - 1 - run_start, WHEEL_SLOT_MASK);
+    for (int slot = next_occupied_slot(
+             shard, 0, static_cast<int>(shard->base - run_start));
+         slot != -1 && slot <= last;
+         slot = next_occupied_slot(shard, 0, slot + 1)) {
+      n += pop_list(take_list(shard, slot), now, error);
+    }
+    if (target < run_start + WHEEL_SLOTS) {
+      shard->base = target;
+      break;
+    }
+    /* Level 0 is now empty: jump to the next slot that needs cascading, or
+       straight to the target if that comes first */
+    uint32_t index;
+    int64_t cascade_time = next_cascade(shard, &index);
+    if (cascade_time > target) {
+      shard->base = target;
+      break;
+    }
+    shard->base = cascade_time;
+    grpc_timer* timer = take_list(shard, index);
+    while (timer != nullptr) {
+      grpc_timer* next = timer->next;
+      add_timer(shard, timer);
+      timer = next;
+    }
+  }
+  return n;
+}
+
+/* REQUIRES: shard->mu locked */
+static int64_t compute_min_deadline(wheel_shard* shard) {
+  int64_t run_start = shard->base & ~int64_t{WHEEL_SLOT_MASK};
+  int slot = next_occupied_slot(shard, 0,
+                                static_cast<int>(shard->base - run_start));
+  if (slot != -1) return run_start + slot;
+  uint32_t index;
+  return next_cascade(shard, &index);
+}
+
+static void timer_list_init() {
+  g_num_shards = grpc_core::Clamp(2 * gpr_cpu_num_cores(), 1u, 32u);
+  g_shards =
+      static_cast<wheel_shard*>(gpr_zalloc(g_num_shards * sizeof(*g_shards)));
+
+  g_initialized = true;
+  g_checker_mu = GPR_SPINLOCK_INITIALIZER;
+  gpr_mu_init(&g_mu);
+  g_min_timer.store(std::numeric_limits<int64_t>::max(),
+                    std::memory_order_relaxed);
+  g_last_seen_min_timer = 0;
+
+  int64_t now =
+      grpc_core::ExecCtx::Get()->Now().milliseconds_after_process_epoch();
+  for (size_t i = 0; i < g_num_shards; i++) {
+    wheel_shard* shard = &g_shards[i];
+    gpr_mu_init(&shard->mu);
+    shard->base = now;
+    shard->min_deadline = std::numeric_limits<int64_t>::max();
+  }
+}
+
+static grpc_timer_check_result run_some_expired_timers(
+    grpc_core::Timestamp now, grpc_core::Timestamp* next,
+    grpc_error_handle error);
+
+static void timer_list_shutdown() {
+  run_some_expired_timers(
+      grpc_core::Timestamp::InfFuture(), nullptr,
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Timer list shutdown"));
+  for (size_t i = 0; i < g_num_shards; i++) {
+    gpr_mu_destroy(&g_shards[i].mu);
+  }
+  gpr_mu_destroy(&g_mu);
+  gpr_free(g_shards);
+  g_initialized = false;
+}
+
+static void timer_init(grpc_timer* timer, grpc_core::Timestamp deadline,
+                       grpc_closure* closure) {
+  wheel_shard* shard = &g_shards[grpc_core::HashPointer(timer, g_num_shards)];
+  int64_t deadline_ms = deadline.milliseconds_after_process_epoch();
+  timer->closure = closure;
+  timer->deadline = deadline_ms;
+
+#ifndef NDEBUG
+  timer->hash_table_next = nullptr;
+#endif
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: SET %" PRId64 " now %" PRId64 " call %p[%p]",
+            timer, deadline_ms,
+            grpc_core::ExecCtx::Get()->Now().milliseconds_after_process_epoch(),
+            closure, closure->cb);
+  }
+
+  if (!g_initialized) {
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(
+        DEBUG_LOCATION, timer->closure,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "Attempt to create timer before initialization"));
+    return;
+  }
+
+  gpr_mu_lock(&shard->mu);
+  timer->pending = true;
+  if (deadline <= grpc_core::ExecCtx::Get()->Now()) {
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure, GRPC_ERROR_NONE);
+    gpr_mu_unlock(&shard->mu);
+    /* early out */
+    return;
+  }
+  add_timer(shard, timer);
+  bool is_first_timer = deadline_ms < shard->min_deadline;
+  if (is_first_timer) shard->min_deadline = deadline_ms;
+  gpr_mu_unlock(&shard->mu);
+
+  /* A concurrent run_some_expired_timers either saw this timer when it
+     recomputed the shard's min_deadline, or recomputed it before we lowered it
+     and so stores a g_min_timer that we lower again here. */
+  if (is_first_timer) {
+    gpr_mu_lock(&g_mu);
+    if (deadline_ms < g_min_timer.load(std::memory_order_relaxed)) {
+      g_min_timer.store(deadline_ms, std::memory_order_relaxed);
+      grpc_kick_poller();
+    }
+    gpr_mu_unlock(&g_mu);
+  }
+}
+
+static void timer_consume_kick(void) {
+  /* Force re-evaluation of last seen min */
+  g_last_seen_min_timer = 0;
+}
+
+static void timer_cancel(grpc_timer* timer) {
+  if (!g_initialized) {
+    /* must have already been cancelled, also the shard mutex is invalid */
+    return;
+  }
+
+  wheel_shard* shard = &g_shards[grpc_core::HashPointer(timer, g_num_shards)];
+  gpr_mu_lock(&shard->mu);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: CANCEL pending=%s", timer,
+            timer->pending ? "true" : "false");
+  }
+
+  /* The shard's min_deadline is left alone: it only needs to be a lower
+     bound, and is recomputed the next time it is reached. */
+  if (timer->pending) {
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            GRPC_ERROR_CANCELLED);
+    timer->pending = false;
+    remove_timer(shard, timer);
+  }
+  gpr_mu_unlock(&shard->mu);
+}
+
+static grpc_timer_check_result run_some_expired_timers(
+    grpc_core::Timestamp now, grpc_core::Timestamp* next,
+    grpc_error_handle error) {
+  grpc_timer_check_result result = GRPC_TIMERS_NOT_CHECKED;
+
+  int64_t min_timer = g_min_timer.load(std::memory_order_relaxed);
+  g_last_seen_min_timer = min_timer;
+
+  if (now < grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+                min_timer)) {
+    if (next != nullptr) {
+      *next = std::min(
+          *next,
+          grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(min_timer));
+    }
+    GRPC_ERROR_UNREF(error);
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  if (gpr_spinlock_trylock(&g_checker_mu)) {
+    gpr_mu_lock(&g_mu);
+    result = GRPC_TIMERS_CHECKED_AND_EMPTY;
+
+    int64_t now_ms = now.milliseconds_after_process_epoch();
+    int64_t new_min_timer = std::numeric_limits<int64_t>::max();
+    for (size_t i = 0; i < g_num_shards; i++) {
+      wheel_shard* shard = &g_shards[i];
+      gpr_mu_lock(&shard->mu);
+      if (shard->min_deadline <= now_ms) {
+        size_t n = advance_wheel(shard, now, error);
+        if (n > 0) result = GRPC_TIMERS_FIRED;
+        shard->min_deadline = compute_min_deadline(shard);
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+          gpr_log(GPR_INFO,
+                  "  .. shard[%d] popped %" PRIdPTR
+                  ", min_deadline --> %" PRId64,
+                  static_cast<int>(i), n, shard->min_deadline);
+        }
+      }
+      new_min_timer = std::min(new_min_timer, shard->min_deadline);
+      gpr_mu_unlock(&shard->mu);
+    }
+
+    g_min_timer.store(new_min_timer, std::memory_order_relaxed);
+    if (next != nullptr) {
+      *next = std::min(
+          *next, grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+                     new_min_timer));
+    }
+    gpr_mu_unlock(&g_mu);
+    gpr_spinlock_unlock(&g_checker_mu);
+  }
+
+  GRPC_ERROR_UNREF(error);
+
+  return result;
+}
+
+static grpc_timer_check_result timer_check(grpc_core::Timestamp* next) {
+  // prelude
+  grpc_core::Timestamp now = grpc_core::ExecCtx::Get()->Now();
+
+  /* fetch from a thread-local first: this avoids contention on a globally
+     mutable cacheline in the common case */
+  grpc_core::Timestamp min_timer =
+      grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+          g_last_seen_min_timer);
+
+  if (now < min_timer) {
+    if (next != nullptr) {
+      *next = std::min(*next, min_timer);
+    }
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+      gpr_log(GPR_INFO, "TIMER CHECK SKIP: now=%" PRId64 " min_timer=%" PRId64,
+              now.milliseconds_after_process_epoch(),
+              min_timer.milliseconds_after_process_epoch());
+    }
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  grpc_error_handle shutdown_error =
+      now != grpc_core::Timestamp::InfFuture()
+          ? GRPC_ERROR_NONE
+          : GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shutting down timer system");
+
+  // tracing
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    std::string next_str;
+    if (next == nullptr) {
+      next_str = "NULL";
+    } else {
+      next_str = absl::StrCat(next->milliseconds_after_process_epoch());
+    }
+    gpr_log(GPR_INFO,
+            "TIMER CHECK BEGIN: now=%" PRId64 " next=%s tls_min=%" PRId64
+            " glob_min=%" PRId64,
+            now.milliseconds_after_process_epoch(), next_str.c_str(),
+            min_timer.milliseconds_after_process_epoch(),
+            g_min_timer.load(std::memory_order_relaxed));
+  }
+  // actual code
+  grpc_timer_check_result r =
+      run_some_expired_timers(now, next, shutdown_error);
+  // tracing
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    std::string next_str;
+    if (next == nullptr) {
+      next_str = "NULL";
+    } else {
+      next_str = absl::StrCat(next->milliseconds_after_process_epoch());
+    }
+    gpr_log(GPR_INFO, "TIMER CHECK END: r=%d; next=%s", r, next_str.c_str());
+  }
+  return r;
+}
+
+grpc_timer_vtable grpc_wheel_timer_vtable = {
+    timer_init,      timer_cancel,        timer_check,
+    timer_list_init, timer_list_shutdown, timer_consume_kick};
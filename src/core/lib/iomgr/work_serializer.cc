@@ -20,27 +20,20 @@
 
 #include "src/core/lib/iomgr/work_serializer.h"
 
+#include "src/core/lib/debug/stats.h"
+
 namespace grpc_core {
 
 DebugOnlyTraceFlag grpc_work_serializer_trace(false, "work_serializer");
 
 class WorkSerializer::WorkSerializerImpl : public Orphanable {
  public:
-  void Run(std::function<void()> callback, const DebugLocation& location);
-  void Schedule(std::function<void()> callback, const DebugLocation& location);
+  bool TryRunInline(const DebugLocation& location);
+  void Enqueue(Callback* callback);
+  void Schedule(Callback* callback);
   void DrainQueue();
   void Orphan() override;
 
- private:
-  struct CallbackWrapper {
-    CallbackWrapper(std::function<void()> cb, const DebugLocation& loc)
-        : callback(std::move(cb)), location(loc) {}
-
-    MultiProducerSingleConsumerQueue::Node mpscq_node;
-    const std::function<void()> callback;
-    const DebugLocation location;
-  };
-
   // Callers of DrainQueueOwned should make sure to grab the lock on the
   // workserializer with
   //
@@ -53,6 +46,7 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
   // the lock to the work serializer.
   void DrainQueueOwned();
 
+ private:
   // First 16 bits indicate ownership of the WorkSerializer, next 48 bits are
   // queue size (i.e., refs).
   static uint64_t MakeRefPair(uint16_t owners, uint64_t size) {
@@ -72,8 +66,8 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
   MultiProducerSingleConsumerQueue queue_;
 };
 
-void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
-                                             const DebugLocation& location) {
+bool WorkSerializer::WorkSerializerImpl::TryRunInline(
+    const DebugLocation& location) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
     gpr_log(GPR_INFO, "WorkSerializer::Run() %p Scheduling callback [%s:%d]",
             this, location.file(), location.line());
@@ -85,36 +79,41 @@ void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
   // The work serializer should not have been orphaned.
   GPR_DEBUG_ASSERT(GetSize(prev_ref_pair) > 0);
   if (GetOwners(prev_ref_pair) == 0) {
-    // We took ownership of the WorkSerializer. Invoke callback and drain queue.
+    // We took ownership of the WorkSerializer. The caller invokes the callback
+    // and drains the queue.
     if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
       gpr_log(GPR_INFO, "  Executing immediately");
     }
-    callback();
-    DrainQueueOwned();
-  } else {
-    // Another thread is holding the WorkSerializer, so decrement the ownership
-    // count we just added and queue the callback.
-    refs_.fetch_sub(MakeRefPair(1, 0), std::memory_order_acq_rel);
-    CallbackWrapper* cb_wrapper =
-        new CallbackWrapper(std::move(callback), location);
-    if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
-      gpr_log(GPR_INFO, "  Scheduling on queue : item %p", cb_wrapper);
-    }
-    queue_.Push(&cb_wrapper->mpscq_node);
+    GRPC_STATS_INC_WORK_SERIALIZER_RUN_INLINE();
+    return true;
   }
+  // Another thread is holding the WorkSerializer, so decrement the ownership
+  // count we just added. The caller queues the callback.
+  refs_.fetch_sub(MakeRefPair(1, 0), std::memory_order_acq_rel);
+  GRPC_STATS_INC_WORK_SERIALIZER_RUN_QUEUED();
+  GRPC_STATS_INC_WORK_SERIALIZER_QUEUE_DEPTH(GetSize(prev_ref_pair) - 1);
+  return false;
 }
 
-void WorkSerializer::WorkSerializerImpl::Schedule(
-    std::function<void()> callback, const DebugLocation& location) {
-  CallbackWrapper* cb_wrapper =
-      new CallbackWrapper(std::move(callback), location);
+void WorkSerializer::WorkSerializerImpl::Enqueue(Callback* callback) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
+    gpr_log(GPR_INFO, "  Scheduling on queue : item %p", callback);
+  }
+  queue_.Push(callback);
+}
+
+void WorkSerializer::WorkSerializerImpl::Schedule(Callback* callback) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
     gpr_log(GPR_INFO,
             "WorkSerializer::Schedule() %p Scheduling callback %p [%s:%d]",
-            this, cb_wrapper, location.file(), location.line());
+            this, callback, callback->location().file(),
+            callback->location().line());
   }
-  refs_.fetch_add(MakeRefPair(0, 1), std::memory_order_acq_rel);
-  queue_.Push(&cb_wrapper->mpscq_node);
+  const uint64_t prev_ref_pair =
+      refs_.fetch_add(MakeRefPair(0, 1), std::memory_order_acq_rel);
+  GRPC_STATS_INC_WORK_SERIALIZER_RUN_QUEUED();
+  GRPC_STATS_INC_WORK_SERIALIZER_QUEUE_DEPTH(GetSize(prev_ref_pair) - 1);
+  queue_.Push(callback);
 }
 
 void WorkSerializer::WorkSerializerImpl::Orphan() {
@@ -148,8 +147,8 @@ void WorkSerializer::WorkSerializerImpl::DrainQueue() {
     // Another thread is holding the WorkSerializer, so decrement the ownership
     // count we just added and queue a no-op callback.
     refs_.fetch_sub(MakeRefPair(1, 0), std::memory_order_acq_rel);
-    CallbackWrapper* cb_wrapper = new CallbackWrapper([]() {}, DEBUG_LOCATION);
-    queue_.Push(&cb_wrapper->mpscq_node);
+    auto no_op = []() {};
+    queue_.Push(new CallbackImpl<decltype(no_op)>(no_op, DEBUG_LOCATION));
   }
 }
 
@@ -158,6 +157,13 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
     gpr_log(GPR_INFO, "WorkSerializer::DrainQueueOwned() %p", this);
   }
   while (true) {
+    // Fast path: if nothing was queued behind the callback that just ran, give
+    // up ownership with a single atomic operation.
+    uint64_t expected = MakeRefPair(1, 2);
+    if (refs_.compare_exchange_strong(expected, MakeRefPair(0, 1),
+                                      std::memory_order_acq_rel)) {
+      return;
+    }
     auto prev_ref_pair = refs_.fetch_sub(MakeRefPair(0, 1));
     // It is possible that while draining the queue, the last callback ended
     // up orphaning the work serializer. In that case, delete the object.
@@ -170,7 +176,7 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
     }
     if (GetSize(prev_ref_pair) == 2) {
       // Queue drained. Give up ownership but only if queue remains empty.
-      uint64_t expected = MakeRefPair(1, 1);
+      expected = MakeRefPair(1, 1);
       if (refs_.compare_exchange_strong(expected, MakeRefPair(0, 1),
                                         std::memory_order_acq_rel)) {
         // Queue is drained.
@@ -187,9 +193,9 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
     }
     // There is at least one callback on the queue. Pop the callback from the
     // queue and execute it.
-    CallbackWrapper* cb_wrapper = nullptr;
+    Callback* callback = nullptr;
     bool empty_unused;
-    while ((cb_wrapper = reinterpret_cast<CallbackWrapper*>(
+    while ((callback = static_cast<Callback*>(
                 queue_.PopAndCheckEnd(&empty_unused))) == nullptr) {
       // This can happen due to a race condition within the mpscq
       // implementation or because of a race with Run()/Schedule().
@@ -199,11 +205,11 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
     }
     if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
       gpr_log(GPR_INFO, "  Running item %p : callback scheduled at [%s:%d]",
-              cb_wrapper, cb_wrapper->location.file(),
-              cb_wrapper->location.line());
+              callback, callback->location().file(),
+              callback->location().line());
     }
-    cb_wrapper->callback();
-    delete cb_wrapper;
+    callback->Run();
+    delete callback;
   }
 }
 
@@ -216,14 +222,21 @@ WorkSerializer::WorkSerializer()
 
 WorkSerializer::~WorkSerializer() {}
 
-void WorkSerializer::Run(std::function<void()> callback,
-                         const DebugLocation& location) {
-  impl_->Run(std::move(callback), location);
+bool WorkSerializer::TryRunInline(WorkSerializerImpl* impl,
+                                  const DebugLocation& location) {
+  return impl->TryRunInline(location);
+}
+
+void WorkSerializer::DrainQueueOwned(WorkSerializerImpl* impl) {
+  impl->DrainQueueOwned();
+}
+
+void WorkSerializer::Enqueue(WorkSerializerImpl* impl, Callback* callback) {
+  impl->Enqueue(callback);
 }
 
-void WorkSerializer::Schedule(std::function<void()> callback,
-                              const DebugLocation& location) {
-  impl_->Schedule(std::move(callback), location);
+void WorkSerializer::ScheduleCallback(Callback* callback) {
+  impl_->Schedule(callback);
 }
 
 void WorkSerializer::DrainQueue() { impl_->DrainQueue(); }
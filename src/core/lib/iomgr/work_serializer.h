@@ -20,6 +20,7 @@
 
 #include <atomic>
 #include <functional>
+#include <utility>
 
 #include "absl/synchronization/mutex.h"
 
@@ -72,19 +73,75 @@ class ABSL_LOCKABLE WorkSerializer {
   //   }
   //   void callback() ABSL_EXCLUSIVE_LOCKS_REQUIRED(work_serializer) { ... }
   //
+  // The callback may be any callable taking no arguments. A callback that runs
+  // inline is invoked directly, without being copied or allocated; a queued
+  // callback is moved into its queue node, so it costs one allocation.
+  //
   // TODO(yashkt): Replace DebugLocation with absl::SourceLocation
   // once we can start using it directly.
-  void Run(std::function<void()> callback, const DebugLocation& location);
+  template <typename F>
+  void Run(F callback, const DebugLocation& location)
+      ABSL_NO_THREAD_SAFETY_ANALYSIS {
+    // The callback may destroy this WorkSerializer, but the impl lives on
+    // until its queue is drained.
+    WorkSerializerImpl* impl = impl_.get();
+    if (TryRunInline(impl, location)) {
+      callback();
+      DrainQueueOwned(impl);
+    } else {
+      Enqueue(impl, new CallbackImpl<F>(std::move(callback), location));
+    }
+  }
 
   // Schedule \a callback to be run later when the queue of callbacks is
   // drained.
-  void Schedule(std::function<void()> callback, const DebugLocation& location);
+  template <typename F>
+  void Schedule(F callback, const DebugLocation& location) {
+    ScheduleCallback(new CallbackImpl<F>(std::move(callback), location));
+  }
   // Drains the queue of callbacks.
   void DrainQueue();
 
  private:
   class WorkSerializerImpl;
 
+  // A queued callback. The callable is stored in the queue node itself.
+  class Callback : public MultiProducerSingleConsumerQueue::Node {
+   public:
+    explicit Callback(const DebugLocation& location) : location_(location) {}
+    virtual ~Callback() = default;
+
+    virtual void Run() = 0;
+
+    const DebugLocation& location() const { return location_; }
+
+   private:
+    const DebugLocation location_;
+  };
+
+  template <typename F>
+  class CallbackImpl final : public Callback {
+   public:
+    CallbackImpl(F callback, const DebugLocation& location)
+        : Callback(location), callback_(std::move(callback)) {}
+
+    void Run() override ABSL_NO_THREAD_SAFETY_ANALYSIS { callback_(); }
+
+   private:
+    F callback_;
+  };
+
+  // Takes ownership of the serializer for a callback that is about to be run
+  // inline, if no other thread owns it. Otherwise, reserves a place in the
+  // queue for the callback, which must then be passed to Enqueue().
+  static bool TryRunInline(WorkSerializerImpl* impl,
+                           const DebugLocation& location);
+  // Runs the callbacks queued while the inline callback ran, then gives up
+  // ownership.
+  static void DrainQueueOwned(WorkSerializerImpl* impl);
+  static void Enqueue(WorkSerializerImpl* impl, Callback* callback);
+  void ScheduleCallback(Callback* callback);
+
   OrphanablePtr<WorkSerializerImpl> impl_;
 };
 
@@ -21,6 +21,10 @@
 #include <inttypes.h>
 #include <stdlib.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include <algorithm>
 #include <map>
 #include <string>
@@ -105,6 +109,7 @@ class JsonReader {
 
   GRPC_MUST_USE_RESULT bool StringAddChar(uint32_t c);
   GRPC_MUST_USE_RESULT bool StringAddUtf32(uint32_t c);
+  void StringAddPlainChars();
 
   Json* CreateAndLinkValue();
   bool StartContainer(Json::Type type);
@@ -188,6 +193,42 @@ bool JsonReader::StringAddUtf32(uint32_t c) {
   }
 }
 
+// Appends the run of plain characters at the start of the remaining input in
+// one go: printable ASCII other than '"' and '\\' needs neither escape nor
+// UTF-8 handling, and makes up most of the strings in configs.
+void JsonReader::StringAddPlainChars() {
+  size_t n = 0;
+#ifdef __SSE2__
+  // 16 bytes at a time. The comparison is signed, so bytes >= 0x80 count as
+  // less than 0x20 along with control characters.
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i space = _mm_set1_epi8(' ');
+  while (remaining_input_ - n >= 16) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input_ + n));
+    __m128i special = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                     _mm_cmpeq_epi8(chunk, backslash)),
+        _mm_cmplt_epi8(chunk, space));
+    int mask = _mm_movemask_epi8(special);
+    if (mask != 0) {
+      n += __builtin_ctz(mask);
+      break;
+    }
+    n += 16;
+  }
+#endif
+  while (n < remaining_input_) {
+    uint8_t c = input_[n];
+    if (c < ' ' || c >= 0x80 || c == '"' || c == '\\') break;
+    ++n;
+  }
+  string_.append(reinterpret_cast<const char*>(input_), n);
+  input_ += n;
+  remaining_input_ -= n;
+}
+
 uint32_t JsonReader::ReadChar() {
   if (remaining_input_ == 0) return GRPC_JSON_READ_CHAR_EOF;
   const uint32_t r = *input_++;
@@ -206,7 +247,10 @@ Json* JsonReader::CreateAndLinkValue() {
   } else {
     Json* parent = stack_.back();
     if (parent->type() == Json::Type::OBJECT) {
-      if (parent->object_value().find(key_) != parent->object_value().end()) {
+      // One lookup for both the duplicate check and the insertion.
+      Json::Object* object = parent->mutable_object();
+      auto it = object->lower_bound(key_);
+      if (it != object->end() && it->first == key_) {
         if (errors_.size() == GRPC_JSON_MAX_ERRORS) {
           truncated_errors_ = true;
         } else {
@@ -214,8 +258,10 @@ Json* JsonReader::CreateAndLinkValue() {
               absl::StrFormat("duplicate key \"%s\" at index %" PRIuPTR, key_,
                               CurrentIndex())));
         }
+      } else {
+        it = object->emplace_hint(it, std::move(key_), Json());
       }
-      value = &(*parent->mutable_object())[std::move(key_)];
+      value = &it->second;
     } else {
       GPR_ASSERT(parent->type() == Json::Type::ARRAY);
       parent->mutable_array()->emplace_back();
@@ -301,6 +347,11 @@ JsonReader::Status JsonReader::Run() {
 
   /* This state-machine is a strict implementation of ECMA-404 */
   while (true) {
+    if ((state_ == State::GRPC_JSON_STATE_OBJECT_KEY_STRING ||
+         state_ == State::GRPC_JSON_STATE_VALUE_STRING) &&
+        unicode_high_surrogate_ == 0 && utf8_bytes_remaining_ == 0) {
+      StringAddPlainChars();
+    }
     c = ReadChar();
     switch (c) {
       /* Let's process the error case first. */
@@ -20,14 +20,16 @@
 
 #include "src/core/lib/profiling/timers.h"
 
-#ifdef GRPC_BASIC_PROFILER
+#if defined(GRPC_BASIC_PROFILER) || defined(GRPC_PERFETTO_PROFILER)
 
 #include <inttypes.h>
 #include <pthread.h>
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
@@ -75,9 +77,17 @@ static int g_shutdown;
 static pthread_t g_writing_thread;
 static GPR_THREAD_LOCAL(int) g_thread_id;
 static int g_next_thread_id;
-static int g_writing_enabled = 1;
+static gpr_atm g_writing_enabled = 1;
 
-GPR_GLOBAL_CONFIG_DEFINE_STRING(grpc_latency_trace, "latency_trace.txt",
+#ifdef GRPC_PERFETTO_PROFILER
+#define DEFAULT_OUTPUT_FILENAME "latency_trace.json"
+/* Whether an event was written, and so the next one needs a separator. */
+static int g_wrote_event;
+#else
+#define DEFAULT_OUTPUT_FILENAME "latency_trace.txt"
+#endif
+
+GPR_GLOBAL_CONFIG_DEFINE_STRING(grpc_latency_trace, DEFAULT_OUTPUT_FILENAME,
                                 "Output file name for latency trace")
 
 static const char* output_filename() {
@@ -87,7 +97,7 @@ static const char* output_filename() {
     if (strlen(value.get()) > 0) {
       output_filename_or_null = value.release();
     } else {
-      output_filename_or_null = "latency_trace.txt";
+      output_filename_or_null = DEFAULT_OUTPUT_FILENAME;
     }
   }
   return output_filename_or_null;
@@ -139,22 +149,55 @@ static void timer_log_remove(gpr_timer_log_list* list, gpr_timer_log* log) {
   }
 }
 
+#ifdef GRPC_PERFETTO_PROFILER
+/* Chrome JSON trace event format ("JSON Array Format"). */
+static void write_entry(const gpr_timer_entry* entry) {
+  const char* phase = entry->type == BEGIN ? "B"
+                      : entry->type == END ? "E"
+                                           : "i";
+  fprintf(output_file,
+          "%s{\"name\": \"%s\", \"cat\": \"grpc\", \"ph\": \"%s\", "
+          "\"ts\": %" PRId64 ".%03d, \"pid\": %d, \"tid\": %d",
+          g_wrote_event ? ",\n" : "", entry->tagstr, phase,
+          entry->tm.tv_sec * 1000000 + entry->tm.tv_nsec / 1000,
+          entry->tm.tv_nsec % 1000, static_cast<int>(getpid()), entry->thd);
+  g_wrote_event = 1;
+  if (entry->type == MARK) {
+    fprintf(output_file, ", \"s\": \"t\"");
+  }
+  if (entry->type != END) {
+    fprintf(output_file,
+            ", \"args\": {\"file\": \"%s\", \"line\": %d, "
+            "\"important\": %d}",
+            entry->file, entry->line, entry->important);
+  }
+  fprintf(output_file, "}");
+}
+#endif /* GRPC_PERFETTO_PROFILER */
+
 static void write_log(gpr_timer_log* log) {
   size_t i;
   if (output_file == NULL) {
     output_file = fopen(output_filename(), "w");
+#ifdef GRPC_PERFETTO_PROFILER
+    fprintf(output_file, "[\n");
+#endif
   }
   for (i = 0; i < log->num_entries; i++) {
     gpr_timer_entry* entry = &(log->log[i]);
     if (gpr_time_cmp(entry->tm, gpr_time_0(entry->tm.clock_type)) < 0) {
       entry->tm = gpr_time_0(entry->tm.clock_type);
     }
+#ifdef GRPC_PERFETTO_PROFILER
+    write_entry(entry);
+#else
     fprintf(output_file,
             "{\"t\": %" PRId64
             ".%09d, \"thd\": \"%d\", \"type\": \"%c\", \"tag\": "
             "\"%s\", \"file\": \"%s\", \"line\": %d, \"imp\": %d}\n",
             entry->tm.tv_sec, entry->tm.tv_nsec, entry->thd, entry->type,
             entry->tagstr, entry->file, entry->line, entry->important);
+#endif
   }
 }
 
@@ -201,6 +244,9 @@ static void finish_writing(void) {
   pthread_mutex_unlock(&g_mu);
 
   if (output_file) {
+#ifdef GRPC_PERFETTO_PROFILER
+    fprintf(output_file, "\n]\n");
+#endif
     fclose(output_file);
   }
 }
@@ -242,7 +288,7 @@ static void gpr_timers_log_add(const char* tagstr, marker_type type,
                                int important, const char* file, int line) {
   gpr_timer_entry* entry;
 
-  if (!g_writing_enabled) {
+  if (!gpr_atm_no_barrier_load(&g_writing_enabled)) {
     return;
   }
 
@@ -277,14 +323,16 @@ void gpr_timer_end(const char* tagstr, int important, const char* file,
   gpr_timers_log_add(tagstr, END, important, file, line);
 }
 
-void gpr_timer_set_enabled(int enabled) { g_writing_enabled = enabled; }
+void gpr_timer_set_enabled(int enabled) {
+  gpr_atm_no_barrier_store(&g_writing_enabled, enabled);
+}
 
 /* Basic profiler specific API functions. */
 void gpr_timers_global_init(void) {}
 
 void gpr_timers_global_destroy(void) {}
 
-#else  /* !GRPC_BASIC_PROFILER */
+#else  /* !GRPC_BASIC_PROFILER && !GRPC_PERFETTO_PROFILER */
 void gpr_timers_global_init(void) {}
 
 void gpr_timers_global_destroy(void) {}
@@ -292,4 +340,4 @@ void gpr_timers_global_destroy(void) {}
 void gpr_timers_set_log_filename(const char* /*filename*/) {}
 
 void gpr_timer_set_enabled(int /*enabled*/) {}
-#endif /* GRPC_BASIC_PROFILER */
+#endif /* GRPC_BASIC_PROFILER || GRPC_PERFETTO_PROFILER */
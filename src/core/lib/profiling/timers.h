@@ -33,8 +33,25 @@ void gpr_timers_set_log_filename(const char* filename);
 
 void gpr_timer_set_enabled(int enabled);
 
+/* USDT probes at points of interest in the call lifecycle, for eBPF and
+   SystemTap tools; see provider grpc in stap_probes.d for their arguments.
+   They are compiled in with GRPC_USDT_PROBES (implied by GRPC_STAP_PROFILER)
+   and cost a single nop per site until a tracer attaches. */
+#if defined(GRPC_STAP_PROFILER) && !defined(GRPC_USDT_PROBES)
+#define GRPC_USDT_PROBES
+#endif
+
+#ifdef GRPC_USDT_PROBES
+#include <sys/sdt.h>
+#define GRPC_USDT_PROBE(name, ...) STAP_PROBEV(grpc, name, __VA_ARGS__)
+#else
+#define GRPC_USDT_PROBE(name, ...) \
+  do {                             \
+  } while (0)
+#endif
+
 #if !(defined(GRPC_STAP_PROFILER) + defined(GRPC_BASIC_PROFILER) + \
-      defined(GRPC_CUSTOM_PROFILER))
+      defined(GRPC_PERFETTO_PROFILER) + defined(GRPC_CUSTOM_PROFILER))
 /* No profiling. No-op all the things. */
 #define GPR_TIMER_MARK(tag, important) \
   do {                                 \
@@ -55,6 +72,11 @@ void gpr_timer_set_enabled(int enabled);
 #if defined(GRPC_CUSTOM_PROFILER) && defined(GRPC_BASIC_PROFILER)
 #error "GRPC_CUSTOM_PROFILER and GRPC_BASIC_PROFILER are mutually exclusive."
 #endif
+#if defined(GRPC_PERFETTO_PROFILER) &&                              \
+    (defined(GRPC_STAP_PROFILER) || defined(GRPC_BASIC_PROFILER) || \
+     defined(GRPC_CUSTOM_PROFILER))
+#error "GRPC_PERFETTO_PROFILER excludes all other profilers."
+#endif
 
 /* Generic profiling interface. */
 #define GPR_TIMER_MARK(tag, important) \
@@ -68,6 +90,10 @@ void gpr_timer_set_enabled(int enabled);
 /* Empty placeholder for now. */
 #endif /* GRPC_BASIC_PROFILER */
 
+/* GRPC_PERFETTO_PROFILER shares the per-thread buffers of the basic profiler,
+   but writes the Chrome JSON trace event format, which Perfetto and
+   chrome://tracing load directly. */
+
 namespace grpc {
 class ProfileScope {
  public:
@@ -17,8 +17,10 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
 #include <stdlib.h>
 
+#include <new>
 #include <type_traits>
 #include <utility>
 
@@ -30,6 +32,11 @@
 
 namespace grpc_core {
 
+// Bytes of storage in an ArenaPromise for promises that are stored inline
+// rather than in the arena. Enough for a promise holding one pointer, as the
+// leaf promises of filters often do.
+constexpr size_t kArenaPromiseDefaultInlineSize = 2 * sizeof(void*);
+
 namespace arena_promise_detail {
 
 // Type erased promise stored in the arena.
@@ -42,6 +49,9 @@ class ImplInterface {
   // Since we don't delete (the arena owns the memory) but we may need to call a
   // destructor, we expose this for when the ArenaPromise object is destroyed.
   virtual void Destroy() = 0;
+  // Move to the inline storage of another ArenaPromise, returning the moved
+  // object. Only promises stored inline move: the others stay where they are.
+  virtual ImplInterface* MoveTo(void* /*storage*/) { return this; }
 
  protected:
   ~ImplInterface() = default;
@@ -86,6 +96,47 @@ class CallableImpl final : public ImplInterface<T> {
   Callable callable_;
 };
 
+// Implementation of ImplInterface for a callable object stored inline in the
+// ArenaPromise.
+template <typename T, typename Callable>
+class InlineImpl final : public ImplInterface<T> {
+ public:
+  explicit InlineImpl(Callable&& callable) : callable_(std::move(callable)) {}
+  // Forward polls to the callable object.
+  Poll<T> PollOnce() override { return poll_cast<T>(callable_()); }
+  // Destroy destructs the callable object.
+  void Destroy() override { this->~InlineImpl(); }
+  ImplInterface<T>* MoveTo(void* storage) override {
+    auto* moved = new (storage) InlineImpl(std::move(callable_));
+    this->~InlineImpl();
+    return moved;
+  }
+
+ private:
+  // Should only be called by Destroy() and MoveTo().
+  ~InlineImpl() = default;
+
+  Callable callable_;
+};
+
+// Whether a callable is stored inline in an ArenaPromise with kInlineSize
+// bytes of storage. Moves of ArenaPromise cannot fail, so neither may moves
+// of the callables stored inline.
+template <typename T, typename Callable, size_t kInlineSize>
+struct FitsInline
+    : std::integral_constant<
+          bool, sizeof(InlineImpl<T, Callable>) <= kInlineSize &&
+                    alignof(InlineImpl<T, Callable>) <= alignof(void*) &&
+                    std::is_nothrow_move_constructible<Callable>::value> {};
+
+#ifdef GRPC_ARENA_PROMISE_REPORT_SPILLS
+// Build with GRPC_ARENA_PROMISE_REPORT_SPILLS defined to get a warning,
+// naming the callable type, for every promise that is allocated in the arena.
+template <typename T, typename Callable>
+[[deprecated("ArenaPromise allocates this promise in the arena")]] inline void
+ReportSpill() {}
+#endif
+
 // If a callable object is empty we can substitute any instance of that callable
 // for the one we call (for how could we tell the difference)?
 // Since this corresponds to a lambda with no fields, and we expect these to be
@@ -117,38 +168,58 @@ class SharedImpl final : public ImplInterface<T>, private Callable {
 };
 
 // Redirector type: given a callable type, expose a Make() function that creates
-// the appropriate underlying implementation.
-template <typename T, typename Callable, typename Ignored = void>
+// the appropriate underlying implementation, using storage if it is stored
+// inline.
+template <typename T, typename Callable, size_t kInlineSize,
+          typename Ignored = void>
 struct ChooseImplForCallable;
 
-template <typename T, typename Callable>
+template <typename T, typename Callable, size_t kInlineSize>
 struct ChooseImplForCallable<
-    T, Callable, absl::enable_if_t<!std::is_empty<Callable>::value>> {
-  static ImplInterface<T>* Make(Callable&& callable) {
+    T, Callable, kInlineSize,
+    absl::enable_if_t<!std::is_empty<Callable>::value &&
+                      !FitsInline<T, Callable, kInlineSize>::value>> {
+  static ImplInterface<T>* Make(Callable&& callable, void* /*storage*/) {
+#ifdef GRPC_ARENA_PROMISE_REPORT_SPILLS
+    ReportSpill<T, Callable>();
+#endif
     return GetContext<Arena>()->template New<CallableImpl<T, Callable>>(
         std::forward<Callable>(callable));
   }
 };
 
-template <typename T, typename Callable>
+template <typename T, typename Callable, size_t kInlineSize>
+struct ChooseImplForCallable<
+    T, Callable, kInlineSize,
+    absl::enable_if_t<!std::is_empty<Callable>::value &&
+                      FitsInline<T, Callable, kInlineSize>::value>> {
+  static ImplInterface<T>* Make(Callable&& callable, void* storage) {
+    return new (storage) InlineImpl<T, Callable>(
+        std::forward<Callable>(callable));
+  }
+};
+
+template <typename T, typename Callable, size_t kInlineSize>
 struct ChooseImplForCallable<
-    T, Callable, absl::enable_if_t<std::is_empty<Callable>::value>> {
-  static ImplInterface<T>* Make(Callable&& callable) {
+    T, Callable, kInlineSize,
+    absl::enable_if_t<std::is_empty<Callable>::value>> {
+  static ImplInterface<T>* Make(Callable&& callable, void* /*storage*/) {
     return SharedImpl<T, Callable>::Get(std::forward<Callable>(callable));
   }
 };
 
 // Wrap ChooseImplForCallable with a friend approachable syntax.
-template <typename T, typename Callable>
-ImplInterface<T>* MakeImplForCallable(Callable&& callable) {
-  return ChooseImplForCallable<T, Callable>::Make(
-      std::forward<Callable>(callable));
+template <typename T, size_t kInlineSize, typename Callable>
+ImplInterface<T>* MakeImplForCallable(Callable&& callable, void* storage) {
+  return ChooseImplForCallable<T, Callable, kInlineSize>::Make(
+      std::forward<Callable>(callable), storage);
 }
 
 }  // namespace arena_promise_detail
 
-// A promise for which the state memory is allocated from an arena.
-template <typename T>
+// A promise for which the state memory is allocated from an arena, unless
+// it fits in the kInlineSize bytes of storage of the ArenaPromise itself.
+template <typename T, size_t kInlineSize = kArenaPromiseDefaultInlineSize>
 class ArenaPromise {
  public:
   // Construct an empty, uncallable, invalid ArenaPromise.
@@ -160,19 +231,20 @@ class ArenaPromise {
                 absl::enable_if_t<!std::is_same<Callable, ArenaPromise>::value>>
   // NOLINTNEXTLINE(google-explicit-constructor)
   ArenaPromise(Callable&& callable)
-      : impl_(arena_promise_detail::MakeImplForCallable<T>(
-            std::forward<Callable>(callable))) {}
+      : impl_(arena_promise_detail::MakeImplForCallable<T, kInlineSize>(
+            std::forward<Callable>(callable), storage_)) {}
 
   // ArenaPromise is not copyable.
   ArenaPromise(const ArenaPromise&) = delete;
   ArenaPromise& operator=(const ArenaPromise&) = delete;
   // ArenaPromise is movable.
-  ArenaPromise(ArenaPromise&& other) noexcept : impl_(other.impl_) {
+  ArenaPromise(ArenaPromise&& other) noexcept
+      : impl_(other.impl_->MoveTo(storage_)) {
     other.impl_ = arena_promise_detail::NullImpl<T>::Get();
   }
   ArenaPromise& operator=(ArenaPromise&& other) noexcept {
     impl_->Destroy();
-    impl_ = other.impl_;
+    impl_ = other.impl_->MoveTo(storage_);
     other.impl_ = arena_promise_detail::NullImpl<T>::Get();
     return *this;
   }
@@ -191,6 +263,8 @@ class ArenaPromise {
   // Underlying impl object.
   arena_promise_detail::ImplInterface<T>* impl_ =
       arena_promise_detail::NullImpl<T>::Get();
+  // Holds the promise if it is stored inline.
+  alignas(void*) char storage_[kInlineSize == 0 ? 1 : kInlineSize];
 };
 
 }  // namespace grpc_core
@@ -17,10 +17,13 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+
 #include <type_traits>
 #include <utility>
 
 #include "absl/status/status.h"
+#include "absl/types/optional.h"
 #include "absl/types/variant.h"
 
 #include "src/core/lib/promise/detail/promise_factory.h"
@@ -28,6 +31,9 @@
 
 namespace grpc_core {
 
+template <typename T>
+class BatchedPipeReceiver;
+
 namespace for_each_detail {
 
 // Helper function: at the end of each iteration of a for-each loop, this is
@@ -126,6 +132,68 @@ class ForEach {
   };
 };
 
+// ForEach over a reader whose Next resolves to batches of items: runs the
+// action for each item of a batch in turn, and only polls the reader again
+// once the batch is exhausted.
+template <typename Reader, typename Action>
+class ForEachInBatch {
+ private:
+  using ReaderNext = decltype(std::declval<Reader>().Next());
+  using Batch = typename PollTraits<
+      decltype(std::declval<ReaderNext>()())>::Type::value_type;
+  using ActionFactory =
+      promise_detail::PromiseFactory<typename Batch::value_type, Action>;
+  using ActionPromise = typename ActionFactory::Promise;
+
+ public:
+  using Result =
+      typename PollTraits<decltype(std::declval<ActionPromise>()())>::Type;
+  ForEachInBatch(Reader reader, Action action)
+      : reader_(std::move(reader)), action_factory_(std::move(action)) {}
+
+  ForEachInBatch(const ForEachInBatch&) = delete;
+  ForEachInBatch& operator=(const ForEachInBatch&) = delete;
+  // noexcept causes compiler errors on older gcc's
+  // NOLINTNEXTLINE(performance-noexcept-move-constructor)
+  ForEachInBatch(ForEachInBatch&&) = default;
+  // noexcept causes compiler errors on older gcc's
+  // NOLINTNEXTLINE(performance-noexcept-move-constructor)
+  ForEachInBatch& operator=(ForEachInBatch&&) = default;
+
+  Poll<Result> operator()() {
+    while (true) {
+      if (action_.has_value()) {
+        auto r = (*action_)();
+        auto* p = absl::get_if<kPollReadyIdx>(&r);
+        if (p == nullptr) return Pending();
+        action_.reset();
+        if (!p->ok()) return std::move(*p);
+      }
+      if (next_item_ < batch_.size()) {
+        action_.emplace(
+            action_factory_.Repeated(std::move(batch_[next_item_++])));
+        continue;
+      }
+      if (!reader_next_.has_value()) reader_next_.emplace(reader_.Next());
+      auto r = (*reader_next_)();
+      auto* p = absl::get_if<kPollReadyIdx>(&r);
+      if (p == nullptr) return Pending();
+      reader_next_.reset();
+      if (!p->has_value()) return Done<Result>::Make();
+      batch_ = std::move(**p);
+      next_item_ = 0;
+    }
+  }
+
+ private:
+  Reader reader_;
+  ActionFactory action_factory_;
+  absl::optional<ReaderNext> reader_next_;
+  Batch batch_;
+  size_t next_item_ = 0;
+  absl::optional<ActionPromise> action_;
+};
+
 }  // namespace for_each_detail
 
 /// For each item acquired by calling Reader::Next, run the promise Action.
@@ -135,6 +203,15 @@ for_each_detail::ForEach<Reader, Action> ForEach(Reader reader, Action action) {
                                                   std::move(action));
 }
 
+/// For each item received from a BatchedPipe, run the promise Action.
+/// A whole batch is drained before the pipe is polled again.
+template <typename T, typename Action>
+for_each_detail::ForEachInBatch<BatchedPipeReceiver<T>, Action> ForEach(
+    BatchedPipeReceiver<T> reader, Action action) {
+  return for_each_detail::ForEachInBatch<BatchedPipeReceiver<T>, Action>(
+      std::move(reader), std::move(action));
+}
+
 }  // namespace grpc_core
 
 #endif  // GRPC_CORE_LIB_PROMISE_FOR_EACH_H
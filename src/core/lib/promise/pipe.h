@@ -17,8 +17,12 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <utility>
+#include <vector>
+
 #include "absl/types/optional.h"
 
 #include <grpc/support/log.h>
@@ -32,6 +36,8 @@ namespace grpc_core {
 
 template <typename T>
 struct Pipe;
+template <typename T>
+struct BatchedPipe;
 
 namespace pipe_detail {
 
@@ -39,6 +45,10 @@ template <typename T>
 class Push;
 template <typename T>
 class Next;
+template <typename T>
+class BatchedPush;
+template <typename T>
+class BatchedNext;
 
 // Center sits between a sender and a receiver to provide a one-deep buffer of
 // Ts
@@ -319,6 +329,281 @@ struct Pipe {
       : sender(center), receiver(center) {}
 };
 
+namespace pipe_detail {
+
+// BatchedCenter sits between a batched sender and receiver to provide a buffer
+// of up to max_batch_size Ts, all of which are handed to the receiver at once.
+template <typename T>
+class BatchedCenter {
+ public:
+  // Initialize with one send ref (held by BatchedPipeSender) and one recv ref
+  // (held by BatchedPipeReceiver)
+  explicit BatchedCenter(size_t max_batch_size)
+      : max_batch_size_(max_batch_size) {
+    GPR_DEBUG_ASSERT(max_batch_size > 0);
+  }
+
+  // Add one ref to the send side of this object, and return this.
+  BatchedCenter* RefSend() {
+    send_refs_++;
+    return this;
+  }
+
+  // Add one ref to the recv side of this object, and return this.
+  BatchedCenter* RefRecv() {
+    recv_refs_++;
+    return this;
+  }
+
+  // Drop a send side ref
+  // If no send refs remain, wake due to send closure
+  // If no refs remain, destroy this object
+  void UnrefSend() {
+    GPR_DEBUG_ASSERT(send_refs_ > 0);
+    send_refs_--;
+    if (0 == send_refs_) {
+      on_full_.Wake();
+      on_empty_.Wake();
+      if (0 == recv_refs_) {
+        this->~BatchedCenter();
+      }
+    }
+  }
+
+  // Drop a recv side ref
+  // If no recv refs remain, wake due to recv closure
+  // If no refs remain, destroy this object
+  void UnrefRecv() {
+    GPR_DEBUG_ASSERT(recv_refs_ > 0);
+    recv_refs_--;
+    if (0 == recv_refs_) {
+      on_full_.Wake();
+      on_empty_.Wake();
+      if (0 == send_refs_) {
+        this->~BatchedCenter();
+      } else {
+        std::vector<T>().swap(values_);
+      }
+    }
+  }
+
+  // Try to push *value into the pipe.
+  // Return Pending if the buffer is full.
+  // Return true if the value was pushed.
+  // Return false if the recv end is closed.
+  // Only the first value of a batch finds the receiver waiting, so a burst of
+  // values costs one repoll.
+  Poll<bool> Push(T* value) {
+    GPR_DEBUG_ASSERT(send_refs_ != 0);
+    if (recv_refs_ == 0) return false;
+    if (values_.size() >= max_batch_size_) return on_empty_.pending();
+    values_.push_back(std::move(*value));
+    on_full_.Wake();
+    return true;
+  }
+
+  // Try to receive all buffered values from the pipe.
+  // Return Pending if there are none.
+  // Return the values if any were retrieved.
+  // Return nullopt if the send end is closed and no values remain.
+  Poll<absl::optional<std::vector<T>>> Next() {
+    GPR_DEBUG_ASSERT(recv_refs_ != 0);
+    if (values_.empty()) {
+      if (send_refs_ == 0) return absl::nullopt;
+      return on_full_.pending();
+    }
+    std::vector<T> batch;
+    batch.swap(values_);
+    on_empty_.Wake();
+    return absl::optional<std::vector<T>>(std::move(batch));
+  }
+
+ private:
+  const size_t max_batch_size_;
+  std::vector<T> values_;
+  // Number of sending objects.
+  // 0 => send is closed.
+  // 1 ref each for BatchedPipeSender and BatchedPush.
+  uint8_t send_refs_ = 1;
+  // Number of receiving objects.
+  // 0 => recv is closed.
+  // 1 ref each for BatchedPipeReceiver and BatchedNext.
+  uint8_t recv_refs_ = 1;
+  IntraActivityWaiter on_empty_;
+  IntraActivityWaiter on_full_;
+};
+
+}  // namespace pipe_detail
+
+// Send end of a BatchedPipe.
+template <typename T>
+class BatchedPipeSender {
+ public:
+  BatchedPipeSender(const BatchedPipeSender&) = delete;
+  BatchedPipeSender& operator=(const BatchedPipeSender&) = delete;
+
+  BatchedPipeSender(BatchedPipeSender&& other) noexcept
+      : center_(other.center_) {
+    other.center_ = nullptr;
+  }
+  BatchedPipeSender& operator=(BatchedPipeSender&& other) noexcept {
+    if (center_ != nullptr) center_->UnrefSend();
+    center_ = other.center_;
+    other.center_ = nullptr;
+    return *this;
+  }
+
+  ~BatchedPipeSender() {
+    if (center_ != nullptr) center_->UnrefSend();
+  }
+
+  // Send a single message along the pipe.
+  // Returns a promise that will resolve to a bool - true if the message was
+  // sent, false if it could never be sent. Blocks the promise only while the
+  // pipe's buffer is full.
+  pipe_detail::BatchedPush<T> Push(T value);
+
+ private:
+  friend struct BatchedPipe<T>;
+  explicit BatchedPipeSender(pipe_detail::BatchedCenter<T>* center)
+      : center_(center) {}
+  pipe_detail::BatchedCenter<T>* center_;
+};
+
+// Receive end of a BatchedPipe.
+template <typename T>
+class BatchedPipeReceiver {
+ public:
+  BatchedPipeReceiver(const BatchedPipeReceiver&) = delete;
+  BatchedPipeReceiver& operator=(const BatchedPipeReceiver&) = delete;
+
+  BatchedPipeReceiver(BatchedPipeReceiver&& other) noexcept
+      : center_(other.center_) {
+    other.center_ = nullptr;
+  }
+  BatchedPipeReceiver& operator=(BatchedPipeReceiver&& other) noexcept {
+    if (center_ != nullptr) center_->UnrefRecv();
+    center_ = other.center_;
+    other.center_ = nullptr;
+    return *this;
+  }
+  ~BatchedPipeReceiver() {
+    if (center_ != nullptr) center_->UnrefRecv();
+  }
+
+  // Receive every buffered message from the pipe.
+  // Returns a promise that will resolve to an optional<vector<T>> - with the
+  // messages in the order they were sent, or no value if the other end of
+  // the pipe was closed. Blocks the promise until the receiver is either
+  // closed or at least one message is available.
+  pipe_detail::BatchedNext<T> Next();
+
+ private:
+  friend struct BatchedPipe<T>;
+  explicit BatchedPipeReceiver(pipe_detail::BatchedCenter<T>* center)
+      : center_(center) {}
+  pipe_detail::BatchedCenter<T>* center_;
+};
+
+namespace pipe_detail {
+
+// Implementation of BatchedPipeSender::Push promise.
+template <typename T>
+class BatchedPush {
+ public:
+  BatchedPush(const BatchedPush&) = delete;
+  BatchedPush& operator=(const BatchedPush&) = delete;
+  BatchedPush(BatchedPush&& other) noexcept
+      : center_(other.center_), push_(std::move(other.push_)) {
+    other.center_ = nullptr;
+  }
+  BatchedPush& operator=(BatchedPush&& other) noexcept {
+    if (center_ != nullptr) center_->UnrefSend();
+    center_ = other.center_;
+    other.center_ = nullptr;
+    push_ = std::move(other.push_);
+    return *this;
+  }
+
+  ~BatchedPush() {
+    if (center_ != nullptr) center_->UnrefSend();
+  }
+
+  Poll<bool> operator()() { return center_->Push(&push_); }
+
+ private:
+  friend class BatchedPipeSender<T>;
+  explicit BatchedPush(BatchedCenter<T>* center, T push)
+      : center_(center), push_(std::move(push)) {}
+  BatchedCenter<T>* center_;
+  T push_;
+};
+
+// Implementation of BatchedPipeReceiver::Next promise.
+template <typename T>
+class BatchedNext {
+ public:
+  BatchedNext(const BatchedNext&) = delete;
+  BatchedNext& operator=(const BatchedNext&) = delete;
+  BatchedNext(BatchedNext&& other) noexcept : center_(other.center_) {
+    other.center_ = nullptr;
+  }
+  BatchedNext& operator=(BatchedNext&& other) noexcept {
+    if (center_ != nullptr) center_->UnrefRecv();
+    center_ = other.center_;
+    other.center_ = nullptr;
+    return *this;
+  }
+
+  ~BatchedNext() {
+    if (center_ != nullptr) center_->UnrefRecv();
+  }
+
+  Poll<absl::optional<std::vector<T>>> operator()() { return center_->Next(); }
+
+ private:
+  friend class BatchedPipeReceiver<T>;
+  explicit BatchedNext(BatchedCenter<T>* center) : center_(center) {}
+  BatchedCenter<T>* center_;
+};
+
+}  // namespace pipe_detail
+
+template <typename T>
+pipe_detail::BatchedPush<T> BatchedPipeSender<T>::Push(T value) {
+  return pipe_detail::BatchedPush<T>(center_->RefSend(), std::move(value));
+}
+
+template <typename T>
+pipe_detail::BatchedNext<T> BatchedPipeReceiver<T>::Next() {
+  return pipe_detail::BatchedNext<T>(center_->RefRecv());
+}
+
+// A BatchedPipe is a Pipe that buffers up to max_batch_size T's, which the
+// receiver drains all at once.
+// A Pipe holds one T, so a sender producing a burst of messages waits for
+// the receiver to poll after each one. A BatchedPipe lets the sender run
+// ahead until the buffer is full, and the receiver then handles the whole
+// burst in one poll: one wakeup per burst instead of one per message.
+// The same single-Activity restrictions as Pipe apply.
+template <typename T>
+struct BatchedPipe {
+  explicit BatchedPipe(size_t max_batch_size)
+      : BatchedPipe(GetContext<Arena>()->New<pipe_detail::BatchedCenter<T>>(
+            max_batch_size)) {}
+  BatchedPipe(const BatchedPipe&) = delete;
+  BatchedPipe& operator=(const BatchedPipe&) = delete;
+  BatchedPipe(BatchedPipe&&) noexcept = default;
+  BatchedPipe& operator=(BatchedPipe&&) noexcept = default;
+
+  BatchedPipeSender<T> sender;
+  BatchedPipeReceiver<T> receiver;
+
+ private:
+  explicit BatchedPipe(pipe_detail::BatchedCenter<T>* center)
+      : sender(center), receiver(center) {}
+};
+
 }  // namespace grpc_core
 
 #endif  // GRPC_CORE_LIB_PROMISE_PIPE_H
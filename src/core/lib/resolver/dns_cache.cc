@@ -0,0 +1,24 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/resolver/dns_cache.h"
+
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_dns_cache, false,
+    "If true, the DNS resolvers of all the channels in the process share "
+    "their lookups and cache the results for the TTL of the DNS records.");
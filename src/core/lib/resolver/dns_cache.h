@@ -0,0 +1,247 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_LIB_RESOLVER_DNS_CACHE_H
+#define GRPC_CORE_LIB_RESOLVER_DNS_CACHE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/statusor.h"
+#include "absl/types/optional.h"
+
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+
+// If true, the DNS resolvers of all the channels in the process share their
+// lookups through a DnsCache.
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_dns_cache);
+
+namespace grpc_core {
+
+// A cache of DNS results, meant to be shared by all the resolvers of a
+// process. Entries are keyed by a string naming both the record types and
+// the name looked up, and are kept for the TTL reported by the lookup that
+// produced them.
+//
+// Concurrent lookups of the same key are merged into a single one, whose
+// result is delivered to every waiter. A hit in the last part of an entry's
+// lifetime starts a refresh in the background, so that names in steady use
+// do not see the latency of a lookup when their entry expires.
+//
+// Failures and results without a positive TTL are delivered but not cached.
+//
+// The cache must outlive the lookups it starts; in practice it is a
+// process-wide singleton.
+template <typename T>
+class DnsCache {
+ public:
+  using OnDone = std::function<void(absl::StatusOr<T>)>;
+  // Invoked by a lookup with its result and how long the result may be
+  // cached.
+  using OnLookupDone = std::function<void(absl::StatusOr<T>, Duration)>;
+  // Starts a lookup that eventually invokes its argument, possibly before
+  // returning. Orphaning the returned object cancels the lookup; it may
+  // still invoke its callback afterwards, and must tolerate being orphaned
+  // after it is done.
+  using StartLookup = std::function<OrphanablePtr<Orphanable>(OnLookupDone)>;
+
+  struct Options {
+    // Expired entries are purged when the cache reaches this size; if all
+    // of them are live, new results are not cached.
+    size_t max_entries = 4096;
+    // Upper bound for the TTLs reported by lookups.
+    Duration max_ttl = Duration::Hours(1);
+    // A hit in this last fraction of an entry's lifetime triggers a refresh.
+    double prefetch_fraction = 0.1;
+    // For tests.
+    std::function<Timestamp()> now;
+  };
+
+  DnsCache() : DnsCache(Options()) {}
+  explicit DnsCache(Options options) : options_(std::move(options)) {}
+
+  DnsCache(const DnsCache&) = delete;
+  DnsCache& operator=(const DnsCache&) = delete;
+
+  // Returns the cached value for \a key if it has not expired. Otherwise,
+  // \a on_done is queued for the result of the pending lookup of \a key,
+  // starting one with \a start if there is none, and \a waiter_id is set to
+  // an id that can be passed to Cancel().
+  absl::optional<T> Lookup(const std::string& key, const StartLookup& start,
+                           OnDone on_done, intptr_t* waiter_id) {
+    const Timestamp now = Now();
+    absl::optional<T> value;
+    intptr_t lookup_id = 0;
+    {
+      MutexLock lock(&mu_);
+      auto it = entries_.find(key);
+      if (it != entries_.end() && now >= it->second.expiry) {
+        entries_.erase(it);
+        it = entries_.end();
+      }
+      if (it != entries_.end()) {
+        value = it->second.value;
+        if (now >= it->second.refresh_at &&
+            in_flight_.find(key) == in_flight_.end()) {
+          lookup_id = AddInFlightLocked(key, /*prefetch=*/true);
+        }
+      } else {
+        auto in_flight = in_flight_.find(key);
+        if (in_flight == in_flight_.end()) {
+          lookup_id = AddInFlightLocked(key, /*prefetch=*/false);
+          in_flight = in_flight_.find(key);
+        }
+        *waiter_id = next_id_++;
+        in_flight->second.waiters.emplace(*waiter_id, std::move(on_done));
+      }
+    }
+    if (lookup_id != 0) Launch(key, lookup_id, start);
+    return value;
+  }
+
+  // Drops the waiter \a waiter_id for \a key, cancelling the pending lookup
+  // if it was the last one. Returns false if \a waiter_id has already been
+  // handed the result, or is about to be.
+  bool Cancel(const std::string& key, intptr_t waiter_id) {
+    // Destroyed outside of the lock.
+    OrphanablePtr<Orphanable> lookup;
+    OnDone on_done;
+    {
+      MutexLock lock(&mu_);
+      auto it = in_flight_.find(key);
+      if (it == in_flight_.end()) return false;
+      auto waiter = it->second.waiters.find(waiter_id);
+      if (waiter == it->second.waiters.end()) return false;
+      on_done = std::move(waiter->second);
+      it->second.waiters.erase(waiter);
+      if (it->second.waiters.empty() && !it->second.prefetch) {
+        lookup = std::move(it->second.lookup);
+        in_flight_.erase(it);
+      }
+    }
+    return true;
+  }
+
+  size_t size() {
+    MutexLock lock(&mu_);
+    return entries_.size();
+  }
+
+ private:
+  struct Entry {
+    T value;
+    Timestamp expiry;
+    Timestamp refresh_at;
+  };
+
+  struct InFlight {
+    intptr_t id;
+    // A prefetch is not cancelled when the waiters that joined it are gone.
+    bool prefetch;
+    OrphanablePtr<Orphanable> lookup;
+    std::map<intptr_t, OnDone> waiters;
+  };
+
+  Timestamp Now() const {
+    if (options_.now != nullptr) return options_.now();
+    return Timestamp::FromTimespecRoundDown(gpr_now(GPR_CLOCK_MONOTONIC));
+  }
+
+  intptr_t AddInFlightLocked(const std::string& key, bool prefetch)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    InFlight& in_flight = in_flight_[key];
+    in_flight.id = next_id_++;
+    in_flight.prefetch = prefetch;
+    return in_flight.id;
+  }
+
+  void Launch(const std::string& key, intptr_t lookup_id,
+              const StartLookup& start) {
+    OrphanablePtr<Orphanable> lookup =
+        start([this, key, lookup_id](absl::StatusOr<T> result, Duration ttl) {
+          FinishLookup(key, lookup_id, std::move(result), ttl);
+        });
+    MutexLock lock(&mu_);
+    auto it = in_flight_.find(key);
+    // Otherwise the lookup is already done, or nobody wants it anymore, and
+    // it is orphaned when going out of scope.
+    if (it != in_flight_.end() && it->second.id == lookup_id) {
+      it->second.lookup = std::move(lookup);
+    }
+  }
+
+  void FinishLookup(const std::string& key, intptr_t lookup_id,
+                    absl::StatusOr<T> result, Duration ttl) {
+    std::map<intptr_t, OnDone> waiters;
+    OrphanablePtr<Orphanable> lookup;
+    {
+      MutexLock lock(&mu_);
+      auto it = in_flight_.find(key);
+      if (it == in_flight_.end() || it->second.id != lookup_id) return;
+      waiters = std::move(it->second.waiters);
+      lookup = std::move(it->second.lookup);
+      in_flight_.erase(it);
+      if (result.ok() && ttl > Duration::Zero()) {
+        StoreLocked(key, *result, std::min(ttl, options_.max_ttl));
+      }
+    }
+    for (auto& waiter : waiters) waiter.second(result);
+  }
+
+  void StoreLocked(const std::string& key, const T& value, Duration ttl)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    const Timestamp now = Now();
+    if (entries_.size() >= options_.max_entries &&
+        entries_.find(key) == entries_.end()) {
+      for (auto it = entries_.begin(); it != entries_.end();) {
+        if (now >= it->second.expiry) {
+          it = entries_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      if (entries_.size() >= options_.max_entries) return;
+    }
+    Entry& entry = entries_[key];
+    entry.value = value;
+    entry.expiry = now + ttl;
+    entry.refresh_at = now + ttl * (1 - options_.prefetch_fraction);
+  }
+
+  const Options options_;
+  Mutex mu_;
+  std::map<std::string, Entry> entries_ ABSL_GUARDED_BY(mu_);
+  std::map<std::string, InFlight> in_flight_ ABSL_GUARDED_BY(mu_);
+  intptr_t next_id_ ABSL_GUARDED_BY(mu_) = 1;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_RESOLVER_DNS_CACHE_H
@@ -20,25 +20,143 @@
 
 #include "src/core/lib/resource_quota/arena.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <new>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 
 #include "src/core/lib/gpr/alloc.h"
+#include "src/core/lib/gprpp/sync.h"
 
 namespace {
 
-void* ArenaStorage(size_t initial_size) {
-  static constexpr size_t base_size =
-      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(grpc_core::Arena));
-  initial_size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_size);
-  size_t alloc_size = base_size + initial_size;
-  static constexpr size_t alignment =
-      (GPR_CACHELINE_SIZE > GPR_MAX_ALIGNMENT &&
-       GPR_CACHELINE_SIZE % GPR_MAX_ALIGNMENT == 0)
-          ? GPR_CACHELINE_SIZE
-          : GPR_MAX_ALIGNMENT;
-  return gpr_malloc_aligned(alloc_size, alignment);
+constexpr size_t kArenaBaseSize =
+    GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(grpc_core::Arena));
+constexpr size_t kArenaAlignment =
+    (GPR_CACHELINE_SIZE > GPR_MAX_ALIGNMENT &&
+     GPR_CACHELINE_SIZE % GPR_MAX_ALIGNMENT == 0)
+        ? GPR_CACHELINE_SIZE
+        : GPR_MAX_ALIGNMENT;
+
+std::atomic<bool> g_block_pool_enabled{true};
+
+// Arena blocks (the arena object plus its initial zone) are recycled through
+// this pool instead of going back to malloc, as every call creates and
+// destroys an arena. Blocks come in power of two size classes covering the
+// range of call size estimates (see the call_initial_size histogram); larger
+// arenas are not pooled. The pool is sharded by CPU and each shard keeps at
+// most kMaxBytesPerShard. Since pooled blocks are not charged to any memory
+// quota, a shard drops all its blocks once it sees a quota under pressure.
+class ArenaBlockPool {
+ public:
+  static constexpr size_t kMinBlockSizeLog2 = 10;
+  static constexpr size_t kMaxBlockSizeLog2 = 16;
+  static constexpr size_t kNumSizeClasses =
+      kMaxBlockSizeLog2 - kMinBlockSizeLog2 + 1;
+  static constexpr size_t kMaxBytesPerShard = 128 * 1024;
+
+  static ArenaBlockPool* Get() {
+    static ArenaBlockPool* pool = new ArenaBlockPool();
+    return pool;
+  }
+
+  // Size class of the smallest block holding size bytes, or kNumSizeClasses
+  // if there is none.
+  static size_t SizeClass(size_t size) {
+    size_t size_class = 0;
+    while (size_class < kNumSizeClasses && ClassSize(size_class) < size) {
+      size_class++;
+    }
+    return size_class;
+  }
+  static size_t ClassSize(size_t size_class) {
+    return size_t{1} << (size_class + kMinBlockSizeLog2);
+  }
+
+  // Returns a pooled block of the size class, or nullptr if there is none.
+  void* Pop(size_t size_class) {
+    Shard* shard = CurrentShard();
+    grpc_core::MutexLock lock(&shard->mu);
+    MaybeTrimLocked(shard);
+    FreeBlock* block = shard->blocks[size_class];
+    if (block == nullptr) return nullptr;
+    shard->blocks[size_class] = block->next;
+    shard->bytes -= ClassSize(size_class);
+    return block;
+  }
+
+  // Takes block into the pool; returns false if it is full and the caller
+  // needs to free block instead.
+  bool Push(size_t size_class, void* block) {
+    Shard* shard = CurrentShard();
+    grpc_core::MutexLock lock(&shard->mu);
+    MaybeTrimLocked(shard);
+    if (shard->bytes + ClassSize(size_class) > kMaxBytesPerShard) return false;
+    shard->blocks[size_class] = new (block) FreeBlock{shard->blocks[size_class]};
+    shard->bytes += ClassSize(size_class);
+    return true;
+  }
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  struct Shard {
+    grpc_core::Mutex mu;
+    FreeBlock* blocks[kNumSizeClasses] ABSL_GUARDED_BY(mu) = {};
+    size_t bytes ABSL_GUARDED_BY(mu) = 0;
+    uint64_t memory_pressure_epoch ABSL_GUARDED_BY(mu) = 0;
+  };
+
+  ArenaBlockPool()
+      : num_shards_(std::max(1u, gpr_cpu_num_cores())),
+        shards_(new Shard[num_shards_]) {}
+
+  Shard* CurrentShard() {
+    return &shards_[gpr_cpu_current_cpu() % num_shards_];
+  }
+
+  static void MaybeTrimLocked(Shard* shard)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard->mu) {
+    uint64_t epoch = grpc_core::MemoryPressureEpoch();
+    if (GPR_LIKELY(shard->memory_pressure_epoch == epoch)) return;
+    shard->memory_pressure_epoch = epoch;
+    for (FreeBlock*& head : shard->blocks) {
+      while (head != nullptr) {
+        FreeBlock* next = head->next;
+        gpr_free_aligned(head);
+        head = next;
+      }
+    }
+    shard->bytes = 0;
+  }
+
+  const size_t num_shards_;
+  const std::unique_ptr<Shard[]> shards_;
+};
+
+// Returns storage for an arena with an initial zone of at least initial_size
+// bytes; *initial_size is raised to the size of the zone actually available,
+// and *size_class set to the pool size class of the block.
+void* ArenaStorage(size_t* initial_size, size_t* size_class) {
+  size_t alloc_size =
+      kArenaBaseSize + GPR_ROUND_UP_TO_ALIGNMENT_SIZE(*initial_size);
+  *size_class = ArenaBlockPool::kNumSizeClasses;
+  if (g_block_pool_enabled.load(std::memory_order_relaxed)) {
+    *size_class = ArenaBlockPool::SizeClass(alloc_size);
+  }
+  if (*size_class == ArenaBlockPool::kNumSizeClasses) {
+    return gpr_malloc_aligned(alloc_size, kArenaAlignment);
+  }
+  *initial_size = ArenaBlockPool::ClassSize(*size_class) - kArenaBaseSize;
+  void* block = ArenaBlockPool::Get()->Pop(*size_class);
+  if (block != nullptr) return block;
+  return gpr_malloc_aligned(ArenaBlockPool::ClassSize(*size_class),
+                            kArenaAlignment);
 }
 
 }  // namespace
@@ -56,28 +174,37 @@ Arena::~Arena() {
 }
 
 Arena* Arena::Create(size_t initial_size, MemoryAllocator* memory_allocator) {
-  return new (ArenaStorage(initial_size))
-      Arena(initial_size, 0, memory_allocator);
+  size_t size_class;
+  void* storage = ArenaStorage(&initial_size, &size_class);
+  return new (storage) Arena(initial_size, 0, memory_allocator, size_class);
 }
 
 std::pair<Arena*, void*> Arena::CreateWithAlloc(
     size_t initial_size, size_t alloc_size, MemoryAllocator* memory_allocator) {
-  static constexpr size_t base_size =
-      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Arena));
-  auto* new_arena = new (ArenaStorage(initial_size))
-      Arena(initial_size, alloc_size, memory_allocator);
-  void* first_alloc = reinterpret_cast<char*>(new_arena) + base_size;
+  size_t size_class;
+  void* storage = ArenaStorage(&initial_size, &size_class);
+  auto* new_arena = new (storage)
+      Arena(initial_size, alloc_size, memory_allocator, size_class);
+  void* first_alloc = reinterpret_cast<char*>(new_arena) + kArenaBaseSize;
   return std::make_pair(new_arena, first_alloc);
 }
 
 size_t Arena::Destroy() {
   size_t size = total_used_.load(std::memory_order_relaxed);
   memory_allocator_->Release(total_allocated_.load(std::memory_order_relaxed));
+  const size_t size_class = size_class_;
   this->~Arena();
-  gpr_free_aligned(this);
+  if (size_class == ArenaBlockPool::kNumSizeClasses ||
+      !ArenaBlockPool::Get()->Push(size_class, this)) {
+    gpr_free_aligned(this);
+  }
   return size;
 }
 
+void Arena::TestOnlySetBlockPoolEnabled(bool enabled) {
+  g_block_pool_enabled.store(enabled, std::memory_order_relaxed);
+}
+
 void* Arena::AllocZone(size_t size) {
   // If the allocation isn't able to end in the initial zone, create a new
   // zone for this allocation, and any unused space in the initial zone is
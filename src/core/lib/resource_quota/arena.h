@@ -44,7 +44,9 @@ namespace grpc_core {
 
 class Arena {
  public:
-  // Create an arena, with \a initial_size bytes in the first allocated buffer.
+  // Create an arena, with at least \a initial_size bytes in the first
+  // allocated buffer. Small enough buffers are recycled through a pool shared
+  // by all arenas, rounding initial_size up to the pooled buffer size.
   static Arena* Create(size_t initial_size, MemoryAllocator* memory_allocator);
 
   // Create an arena, with \a initial_size bytes in the first allocated buffer,
@@ -56,6 +58,11 @@ class Arena {
 
   // Destroy an arena, returning the total number of bytes allocated.
   size_t Destroy();
+
+  // Turns recycling of arena buffers on or off (it is on by default), so that
+  // benchmarks can compare both.
+  static void TestOnlySetBlockPoolEnabled(bool enabled);
+
   // Allocate \a size bytes from the arena.
   void* Alloc(size_t size) {
     static constexpr size_t base_size =
@@ -97,10 +104,14 @@ class Arena {
   //   quick optimization (avoiding an atomic fetch-add) for the common case
   //   where we wish to create an arena and then perform an immediate
   //   allocation.
+  //
+  //   size_class: The pool size class of the arena's buffer, or the number
+  //   of size classes if it is not to be returned to the pool.
   explicit Arena(size_t initial_size, size_t initial_alloc,
-                 MemoryAllocator* memory_allocator)
+                 MemoryAllocator* memory_allocator, size_t size_class)
       : total_used_(GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_alloc)),
         initial_zone_size_(initial_size),
+        size_class_(size_class),
         memory_allocator_(memory_allocator) {}
 
   ~Arena();
@@ -112,6 +123,7 @@ class Arena {
   std::atomic<size_t> total_used_{0};
   std::atomic<size_t> total_allocated_{0};
   const size_t initial_zone_size_;
+  const size_t size_class_;
   // If the initial arena allocation wasn't enough, we allocate additional zones
   // in a reverse linked list. Each additional zone consists of (1) a pointer to
   // the zone added before this zone (null if this is the first additional zone)
@@ -46,6 +46,14 @@ static constexpr size_t kMaxReplenishBytes = 1024 * 1024;
 // Minimum number of bytes an allocator will request from a quota in one step.
 static constexpr size_t kMinReplenishBytes = 4096;
 
+namespace {
+std::atomic<uint64_t> g_memory_pressure_epoch{0};
+}  // namespace
+
+uint64_t MemoryPressureEpoch() {
+  return g_memory_pressure_epoch.load(std::memory_order_relaxed);
+}
+
 //
 // Reclaimer
 //
@@ -157,18 +165,42 @@ Poll<RefCountedPtr<ReclaimerQueue::Handle>> ReclaimerQueue::PollNext() {
 //
 
 GrpcMemoryAllocatorImpl::GrpcMemoryAllocatorImpl(
-    std::shared_ptr<BasicMemoryQuota> memory_quota, std::string name)
-    : memory_quota_(memory_quota), name_(std::move(name)) {
+    std::shared_ptr<BasicMemoryQuota> memory_quota, std::string name,
+    MemoryCategory category)
+    : category_(category), memory_quota_(memory_quota), name_(std::move(name)) {
   memory_quota_->Take(taken_bytes_);
+  memory_quota_->AddAllocator(this);
 }
 
 GrpcMemoryAllocatorImpl::~GrpcMemoryAllocatorImpl() {
-  GPR_ASSERT(free_bytes_.load(std::memory_order_acquire) +
-                 sizeof(GrpcMemoryAllocatorImpl) ==
+  memory_quota_->RemoveAllocator(this);
+  GPR_ASSERT(TotalFreeBytes() + sizeof(GrpcMemoryAllocatorImpl) ==
              taken_bytes_);
   memory_quota_->Return(taken_bytes_);
 }
 
+MemoryUsage GrpcMemoryAllocatorImpl::GetUsage() const {
+  size_t taken;
+  {
+    MutexLock lock(&memory_quota_mu_);
+    taken = taken_bytes_;
+  }
+  // Counters are read one after the other while allocations go on, so clamp
+  // whatever does not add up to zero.
+  size_t free = TotalFreeBytes();
+  size_t in_use = taken > free ? taken - free : 0;
+  MemoryUsage usage{};
+  size_t categorized = 0;
+  for (size_t i = 0; i < kNumMemoryCategories; i++) {
+    usage[i] = category_bytes_[i].load(std::memory_order_relaxed);
+    categorized += usage[i];
+  }
+  if (in_use > categorized) {
+    usage[static_cast<size_t>(category_)] += in_use - categorized;
+  }
+  return usage;
+}
+
 void GrpcMemoryAllocatorImpl::Shutdown() {
   std::shared_ptr<BasicMemoryQuota> memory_quota;
   OrphanablePtr<ReclaimerQueue::Handle>
@@ -189,19 +221,57 @@ size_t GrpcMemoryAllocatorImpl::Reserve(MemoryRequest request) {
   // inlined asserts.
   GPR_ASSERT(request.min() <= request.max());
   GPR_ASSERT(request.max() <= MemoryRequest::max_allowed_size());
+  FreeBytesShard* shard = CurrentShard();
+  bool stole = false;
   while (true) {
     // Attempt to reserve memory from our pool.
-    auto reservation = TryReserve(request);
+    auto reservation = TryReserve(request, shard);
     if (reservation.has_value()) {
       return *reservation;
     }
-    // If that failed, grab more from the quota and retry.
-    Replenish();
+    // If that failed, first gather whatever other CPUs left cached (once, so
+    // that two threads cannot keep stealing back and forth), then grab more
+    // from the quota and retry.
+    if (!stole) {
+      stole = true;
+      if (StealFreeBytes(shard)) continue;
+    }
+    Replenish(shard);
+  }
+}
+
+size_t GrpcMemoryAllocatorImpl::TotalFreeBytes() const {
+  size_t total = 0;
+  for (const FreeBytesShard& shard : free_bytes_) {
+    total += shard.free_bytes.load(std::memory_order_acquire);
+  }
+  return total;
+}
+
+size_t GrpcMemoryAllocatorImpl::TakeAllFreeBytes() {
+  size_t total = 0;
+  for (FreeBytesShard& shard : free_bytes_) {
+    total += shard.free_bytes.exchange(0, std::memory_order_acq_rel);
+  }
+  return total;
+}
+
+bool GrpcMemoryAllocatorImpl::StealFreeBytes(FreeBytesShard* shard) {
+  size_t stolen = 0;
+  for (FreeBytesShard& other : free_bytes_) {
+    if (&other == shard) continue;
+    // Skip the atomic exchange (and the cache line invalidation it implies)
+    // for shards with nothing to take.
+    if (other.free_bytes.load(std::memory_order_relaxed) == 0) continue;
+    stolen += other.free_bytes.exchange(0, std::memory_order_acq_rel);
   }
+  if (stolen == 0) return false;
+  shard->free_bytes.fetch_add(stolen, std::memory_order_acq_rel);
+  return true;
 }
 
 absl::optional<size_t> GrpcMemoryAllocatorImpl::TryReserve(
-    MemoryRequest request) {
+    MemoryRequest request, FreeBytesShard* shard) {
   // How much memory should we request? (see the scaling below)
   size_t scaled_size_over_min = request.max() - request.min();
   // Scale the request down according to memory pressure if we have that
@@ -235,7 +305,7 @@ absl::optional<size_t> GrpcMemoryAllocatorImpl::TryReserve(
   // How much do we want to reserve?
   const size_t reserve = request.min() + scaled_size_over_min;
   // See how many bytes are available.
-  size_t available = free_bytes_.load(std::memory_order_acquire);
+  size_t available = shard->free_bytes.load(std::memory_order_acquire);
   while (true) {
     // Does the current free pool satisfy the request?
     if (available < reserve) {
@@ -244,23 +314,23 @@ absl::optional<size_t> GrpcMemoryAllocatorImpl::TryReserve(
     // Try to reserve the requested amount.
     // If the amount of free memory changed through this loop, then available
     // will be set to the new value and we'll repeat.
-    if (free_bytes_.compare_exchange_weak(available, available - reserve,
-                                          std::memory_order_acq_rel,
-                                          std::memory_order_acquire)) {
+    if (shard->free_bytes.compare_exchange_weak(available, available - reserve,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire)) {
       return reserve;
     }
   }
 }
 
-void GrpcMemoryAllocatorImpl::MaybeDonateBack() {
-  size_t free = free_bytes_.load(std::memory_order_relaxed);
-  const size_t kReduceToSize = kMaxQuotaBufferSize / 2;
+void GrpcMemoryAllocatorImpl::MaybeDonateBack(FreeBytesShard* shard) {
+  size_t free = shard->free_bytes.load(std::memory_order_relaxed);
+  const size_t kReduceToSize = kMaxShardBufferSize / 2;
   while (true) {
     if (free <= kReduceToSize) return;
     size_t ret = free - kReduceToSize;
-    if (free_bytes_.compare_exchange_weak(free, kReduceToSize,
-                                          std::memory_order_acq_rel,
-                                          std::memory_order_acquire)) {
+    if (shard->free_bytes.compare_exchange_weak(free, kReduceToSize,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire)) {
       if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
         gpr_log(GPR_INFO, "[%p|%s] Early return %" PRIdPTR " bytes", this,
                 name_.c_str(), ret);
@@ -274,7 +344,7 @@ void GrpcMemoryAllocatorImpl::MaybeDonateBack() {
   }
 }
 
-void GrpcMemoryAllocatorImpl::Replenish() {
+void GrpcMemoryAllocatorImpl::Replenish(FreeBytesShard* shard) {
   MutexLock lock(&memory_quota_mu_);
   GPR_ASSERT(!shutdown_);
   // Attempt a fairly low rate exponential growth request size, bounded between
@@ -285,7 +355,7 @@ void GrpcMemoryAllocatorImpl::Replenish() {
   // Record that we've taken it.
   taken_bytes_ += amount;
   // Add the taken amount to the free pool.
-  free_bytes_.fetch_add(amount, std::memory_order_acq_rel);
+  shard->free_bytes.fetch_add(amount, std::memory_order_acq_rel);
   // See if we can add ourselves as a reclaimer.
   MaybeRegisterReclaimerLocked();
 }
@@ -311,7 +381,7 @@ void GrpcMemoryAllocatorImpl::MaybeRegisterReclaimerLocked() {
     MutexLock lock(&p->memory_quota_mu_);
     p->registered_reclaimer_ = false;
     // Figure out how many bytes we can return to the quota.
-    size_t return_bytes = p->free_bytes_.exchange(0, std::memory_order_acq_rel);
+    size_t return_bytes = p->TakeAllFreeBytes();
     if (return_bytes == 0) return;
     // Subtract that from our outstanding balance.
     p->taken_bytes_ -= return_bytes;
@@ -322,25 +392,31 @@ void GrpcMemoryAllocatorImpl::MaybeRegisterReclaimerLocked() {
 
 void GrpcMemoryAllocatorImpl::Rebind(
     std::shared_ptr<BasicMemoryQuota> memory_quota) {
-  MutexLock lock(&memory_quota_mu_);
-  GPR_ASSERT(!shutdown_);
-  if (memory_quota_ == memory_quota) return;
-  // Return memory to the original memory quota.
-  memory_quota_->Return(taken_bytes_);
-  // Reassign any queued reclaimers
-  for (size_t i = 0; i < kNumReclamationPasses; i++) {
-    if (reclamation_handles_[i] != nullptr) {
-      reclamation_handles_[i]->Requeue(memory_quota->reclaimer_queue(i));
+  {
+    MutexLock lock(&memory_quota_mu_);
+    GPR_ASSERT(!shutdown_);
+    if (memory_quota_ == memory_quota) return;
+    // Return memory to the original memory quota.
+    memory_quota_->Return(taken_bytes_);
+    // Reassign any queued reclaimers
+    for (size_t i = 0; i < kNumReclamationPasses; i++) {
+      if (reclamation_handles_[i] != nullptr) {
+        reclamation_handles_[i]->Requeue(memory_quota->reclaimer_queue(i));
+      }
     }
+    // Switch to the new memory quota, leaving the old one in memory_quota so
+    // that when we unref it, we are outside of lock.
+    memory_quota_.swap(memory_quota);
+    // Drop our freed memory down to zero, to avoid needing to ask the new
+    // quota for memory we're not currently using.
+    taken_bytes_ -= TakeAllFreeBytes();
+    // And let the new quota know how much we're already using.
+    memory_quota_->Take(taken_bytes_);
+    memory_quota_->AddAllocator(this);
   }
-  // Switch to the new memory quota, leaving the old one in memory_quota so that
-  // when we unref it, we are outside of lock.
-  memory_quota_.swap(memory_quota);
-  // Drop our freed memory down to zero, to avoid needing to ask the new
-  // quota for memory we're not currently using.
-  taken_bytes_ -= free_bytes_.exchange(0, std::memory_order_acq_rel);
-  // And let the new quota know how much we're already using.
-  memory_quota_->Take(taken_bytes_);
+  // Quotas lock their allocators to compute usage, so this must happen
+  // outside of our lock.
+  memory_quota->RemoveAllocator(this);
 }
 
 //
@@ -389,6 +465,7 @@ void BasicMemoryQuota::Start() {
         if (self->free_bytes_.load(std::memory_order_acquire) > 0) {
           return Pending{};
         }
+        g_memory_pressure_epoch.fetch_add(1, std::memory_order_relaxed);
         return 0;
       },
       [self]() {
@@ -488,6 +565,28 @@ void BasicMemoryQuota::Return(size_t amount) {
   free_bytes_.fetch_add(amount, std::memory_order_relaxed);
 }
 
+void BasicMemoryQuota::AddAllocator(GrpcMemoryAllocatorImpl* allocator) {
+  MutexLock lock(&allocators_mu_);
+  allocators_.insert(allocator);
+}
+
+void BasicMemoryQuota::RemoveAllocator(GrpcMemoryAllocatorImpl* allocator) {
+  MutexLock lock(&allocators_mu_);
+  allocators_.erase(allocator);
+}
+
+MemoryUsage BasicMemoryQuota::GetUsage() const {
+  MemoryUsage usage{};
+  MutexLock lock(&allocators_mu_);
+  for (const GrpcMemoryAllocatorImpl* allocator : allocators_) {
+    MemoryUsage allocator_usage = allocator->GetUsage();
+    for (size_t i = 0; i < kNumMemoryCategories; i++) {
+      usage[i] += allocator_usage[i];
+    }
+  }
+  return usage;
+}
+
 std::pair<double, size_t>
 BasicMemoryQuota::InstantaneousPressureAndMaxRecommendedAllocationSize() const {
   double free = free_bytes_.load();
@@ -511,10 +610,34 @@ MemoryAllocator MemoryQuota::CreateMemoryAllocator(absl::string_view name) {
   return MemoryAllocator(std::move(impl));
 }
 
-MemoryOwner MemoryQuota::CreateMemoryOwner(absl::string_view name) {
+MemoryOwner MemoryQuota::CreateMemoryOwner(absl::string_view name,
+                                           MemoryCategory category) {
   auto impl = std::make_shared<GrpcMemoryAllocatorImpl>(
-      memory_quota_, absl::StrCat(memory_quota_->name(), "/owner/", name));
+      memory_quota_, absl::StrCat(memory_quota_->name(), "/owner/", name),
+      category);
   return MemoryOwner(std::move(impl));
 }
 
+const char* MemoryCategoryName(MemoryCategory category) {
+  switch (category) {
+    case MemoryCategory::kOther:
+      return "other";
+    case MemoryCategory::kCallArena:
+      return "call_arena";
+    case MemoryCategory::kReadBuffer:
+      return "read_buffer";
+    case MemoryCategory::kHpackTable:
+      return "hpack_table";
+    case MemoryCategory::kPendingWrites:
+      return "pending_writes";
+    case MemoryCategory::kTransport:
+      return "transport";
+    case MemoryCategory::kRetryBuffer:
+      return "retry_buffer";
+    case MemoryCategory::kResponseCache:
+      return "response_cache";
+  }
+  GPR_UNREACHABLE_CODE(return "unknown");
+}
+
 }  // namespace grpc_core
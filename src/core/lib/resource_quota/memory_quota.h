@@ -19,6 +19,7 @@
 
 #include <stdint.h>
 
+#include <array>
 #include <atomic>
 #include <cstddef>
 #include <limits>
@@ -27,11 +28,13 @@
 #include <utility>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
 #include <grpc/event_engine/memory_allocator.h>
 #include <grpc/event_engine/memory_request.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gprpp/orphanable.h"
@@ -43,6 +46,7 @@
 namespace grpc_core {
 
 class BasicMemoryQuota;
+class GrpcMemoryAllocatorImpl;
 class MemoryQuota;
 
 using grpc_event_engine::experimental::MemoryRequest;
@@ -82,6 +86,36 @@ enum class ReclamationPass {
 static constexpr size_t kNumReclamationPasses = 4;
 static constexpr size_t kMaxQuotaBufferSize = 1024 * 1024;
 
+// What memory reserved from a quota is used for, so that usage can be broken
+// down when looking for what fills up a quota.
+// Each allocator has a default category for everything reserved through it,
+// and allocation sites that share an allocator can reserve under a more
+// specific category.
+enum class MemoryCategory : uint8_t {
+  kOther = 0,
+  // Call arenas, including everything filters keep in them.
+  kCallArena,
+  // Endpoint read and staging buffers.
+  kReadBuffer,
+  // HPACK dynamic tables.
+  kHpackTable,
+  // Bytes handed to the endpoint and not yet written out.
+  kPendingWrites,
+  // Per connection transport state.
+  kTransport,
+  // Send ops cached by the retry filter so that they can be replayed.
+  kRetryBuffer,
+  // Responses kept by the client channel's response cache.
+  kResponseCache,
+};
+static constexpr size_t kNumMemoryCategories = 8;
+
+// Name of category, for use in stats and debug output.
+const char* MemoryCategoryName(MemoryCategory category);
+
+// Bytes in use, indexed by MemoryCategory.
+using MemoryUsage = std::array<size_t, kNumMemoryCategories>;
+
 // For each reclamation function run we construct a ReclamationSweep.
 // When this object is finally destroyed (it may be moved several times first),
 // then that reclamation is complete and we may continue the reclamation loop.
@@ -248,6 +282,14 @@ class BasicMemoryQuota final
   // Get a reclamation queue
   ReclaimerQueue* reclaimer_queue(size_t i) { return &reclaimers_[i]; }
 
+  // Track the allocators taking memory from this quota, for GetUsage().
+  void AddAllocator(GrpcMemoryAllocatorImpl* allocator)
+      ABSL_LOCKS_EXCLUDED(allocators_mu_);
+  void RemoveAllocator(GrpcMemoryAllocatorImpl* allocator)
+      ABSL_LOCKS_EXCLUDED(allocators_mu_);
+  // Memory currently in use by all allocators of this quota, by category.
+  MemoryUsage GetUsage() const ABSL_LOCKS_EXCLUDED(allocators_mu_);
+
   // The name of this quota
   absl::string_view name() const { return name_; }
 
@@ -276,6 +318,11 @@ class BasicMemoryQuota final
   // We also increment this counter on completion of a sweep, as an indicator
   // that the wait has ended.
   std::atomic<uint64_t> reclamation_counter_{0};
+  // Allocators currently bound to this quota. Only used to compute usage
+  // stats, so this is kept apart from the allocation paths.
+  mutable Mutex allocators_mu_;
+  absl::flat_hash_set<GrpcMemoryAllocatorImpl*> allocators_
+      ABSL_GUARDED_BY(allocators_mu_);
   // The name of this quota - used for debugging/tracing/etc..
   std::string name_;
 };
@@ -285,7 +332,8 @@ class BasicMemoryQuota final
 class GrpcMemoryAllocatorImpl final : public EventEngineMemoryAllocatorImpl {
  public:
   explicit GrpcMemoryAllocatorImpl(
-      std::shared_ptr<BasicMemoryQuota> memory_quota, std::string name);
+      std::shared_ptr<BasicMemoryQuota> memory_quota, std::string name,
+      MemoryCategory category = MemoryCategory::kOther);
   ~GrpcMemoryAllocatorImpl() override;
 
   // Rebind - Swaps the underlying quota for this allocator, taking care to
@@ -298,15 +346,33 @@ class GrpcMemoryAllocatorImpl final : public EventEngineMemoryAllocatorImpl {
   // Returns the number of bytes reserved.
   size_t Reserve(MemoryRequest request) override;
 
+  // Reserve bytes, accounting for them under category rather than the
+  // allocator's default category. They must be released the same way.
+  size_t Reserve(MemoryCategory category, MemoryRequest request) {
+    size_t n = Reserve(request);
+    category_bytes_[static_cast<size_t>(category)].fetch_add(
+        n, std::memory_order_relaxed);
+    return n;
+  }
+  void Release(MemoryCategory category, size_t n) {
+    category_bytes_[static_cast<size_t>(category)].fetch_sub(
+        n, std::memory_order_relaxed);
+    Release(n);
+  }
+
+  // Memory currently reserved through this allocator, by category.
+  MemoryUsage GetUsage() const ABSL_LOCKS_EXCLUDED(memory_quota_mu_);
+
   // Release some bytes that were previously reserved.
   void Release(size_t n) override {
     // Add the released memory to our free bytes counter... if this increases
     // from  0 to non-zero, then we have more to do, otherwise, we're actually
     // done.
-    size_t prev_free = free_bytes_.fetch_add(n, std::memory_order_release);
-    if (prev_free + n > kMaxQuotaBufferSize) {
+    FreeBytesShard* shard = CurrentShard();
+    size_t prev_free = shard->free_bytes.fetch_add(n, std::memory_order_release);
+    if (prev_free + n > kMaxShardBufferSize) {
       // Try to immediately return some free'ed memory back to the total quota.
-      MaybeDonateBack();
+      MaybeDonateBack(shard);
     }
     if (prev_free != 0) return;
     MaybeRegisterReclaimer();
@@ -334,17 +400,41 @@ class GrpcMemoryAllocatorImpl final : public EventEngineMemoryAllocatorImpl {
   absl::string_view name() const { return name_; }
 
  private:
+  // Free bytes are spread over this many shards, picked by the current CPU, so
+  // that threads sharing an allocator do not all contend on one cache line.
+  static constexpr size_t kNumFreeBytesShards = 16;
+  // Most free bytes a shard keeps before donating back to the quota: this
+  // bounds the memory cached by an allocator to kMaxQuotaBufferSize overall.
+  static constexpr size_t kMaxShardBufferSize =
+      kMaxQuotaBufferSize / kNumFreeBytesShards;
+
+  struct FreeBytesShard {
+    std::atomic<size_t> free_bytes{0};
+    char padding[GPR_CACHELINE_SIZE - sizeof(std::atomic<size_t>)];
+  };
+
+  FreeBytesShard* CurrentShard() {
+    return &free_bytes_[gpr_cpu_current_cpu() % kNumFreeBytesShards];
+  }
+  // Total free bytes over all shards.
+  size_t TotalFreeBytes() const;
+  // Take all free bytes out of all shards, returning how many there were.
+  size_t TakeAllFreeBytes();
+
   // Primitive reservation function.
-  absl::optional<size_t> TryReserve(MemoryRequest request) GRPC_MUST_USE_RESULT;
+  absl::optional<size_t> TryReserve(MemoryRequest request,
+                                    FreeBytesShard* shard) GRPC_MUST_USE_RESULT;
+  // Move the free bytes cached by other shards into shard, returning false if
+  // there were none.
+  bool StealFreeBytes(FreeBytesShard* shard);
   // This function may be invoked during a memory release operation. If the
-  // total free_bytes in this allocator/local cache exceeds
-  // kMaxQuotaBufferSize / 2, donate the excess free_bytes in this cache back
-  // to the total quota immediately. This helps prevent free bytes in any
-  // particular allocator from growing too large.
-  void MaybeDonateBack();
-  // Replenish bytes from the quota, without blocking, possibly entering
-  // overcommit.
-  void Replenish() ABSL_LOCKS_EXCLUDED(memory_quota_mu_);
+  // free bytes in shard exceed kMaxShardBufferSize, donate the excess over
+  // half of that back to the total quota immediately. This helps prevent free
+  // bytes in any particular allocator from growing too large.
+  void MaybeDonateBack(FreeBytesShard* shard);
+  // Replenish bytes from the quota into shard, without blocking, possibly
+  // entering overcommit.
+  void Replenish(FreeBytesShard* shard) ABSL_LOCKS_EXCLUDED(memory_quota_mu_);
   // If we have not already, register a reclamation function against the quota
   // to sweep any free memory back to that quota.
   void MaybeRegisterReclaimer() ABSL_LOCKS_EXCLUDED(memory_quota_mu_);
@@ -357,11 +447,15 @@ class GrpcMemoryAllocatorImpl final : public EventEngineMemoryAllocatorImpl {
         memory_quota_->reclaimer_queue(pass)->Insert(std::move(fn));
   }
 
+  // Category of memory not reserved under an explicit category.
+  const MemoryCategory category_;
+  // Bytes reserved under each explicit category.
+  std::atomic<size_t> category_bytes_[kNumMemoryCategories] = {};
   // Amount of memory this allocator has cached for its own use: to avoid quota
   // contention, each MemoryAllocator can keep some memory in addition to what
   // it is immediately using, and the quota can pull it back under memory
   // pressure.
-  std::atomic<size_t> free_bytes_{0};
+  FreeBytesShard free_bytes_[kNumFreeBytesShards];
   // Mutex guarding the backing resource quota.
   mutable Mutex memory_quota_mu_;
   // Backing resource quota.
@@ -410,6 +504,19 @@ class MemoryOwner final : public MemoryAllocator {
     return impl()->InstantaneousPressure();
   }
 
+  using MemoryAllocator::Release;
+  using MemoryAllocator::Reserve;
+  // Reserve (and later release) memory under a specific category.
+  size_t Reserve(MemoryCategory category, MemoryRequest request) {
+    return impl()->Reserve(category, request);
+  }
+  void Release(MemoryCategory category, size_t n) {
+    impl()->Release(category, n);
+  }
+
+  // Memory currently reserved through this owner, by category.
+  MemoryUsage GetUsage() const { return impl()->GetUsage(); }
+
   template <typename T, typename... Args>
   OrphanablePtr<T> MakeOrphanable(Args&&... args) {
     return OrphanablePtr<T>(New<T>(std::forward<Args>(args)...));
@@ -449,16 +556,27 @@ class MemoryQuota final
   MemoryQuota& operator=(MemoryQuota&&) = default;
 
   MemoryAllocator CreateMemoryAllocator(absl::string_view name) override;
-  MemoryOwner CreateMemoryOwner(absl::string_view name);
+  // Memory reserved through the owner is accounted for under category, unless
+  // reserved with another category explicitly.
+  MemoryOwner CreateMemoryOwner(
+      absl::string_view name, MemoryCategory category = MemoryCategory::kOther);
+
+  // Memory currently in use from this quota, by category.
+  MemoryUsage GetUsage() const { return memory_quota_->GetUsage(); }
 
   // Resize the quota to new_size.
   void SetSize(size_t new_size) { memory_quota_->SetSize(new_size); }
 
+  // Instantaneous memory pressure approximation, between 0 and 1.
+  double InstantaneousPressure() const {
+    return memory_quota_->InstantaneousPressureAndMaxRecommendedAllocationSize()
+        .first;
+  }
+
   // Return true if the instantaneous memory pressure is high.
   bool IsMemoryPressureHigh() const {
     static constexpr double kMemoryPressureHighThreshold = 0.9;
-    return memory_quota_->InstantaneousPressureAndMaxRecommendedAllocationSize()
-               .first > kMemoryPressureHighThreshold;
+    return InstantaneousPressure() > kMemoryPressureHighThreshold;
   }
 
  private:
@@ -466,6 +584,11 @@ class MemoryQuota final
   std::shared_ptr<BasicMemoryQuota> memory_quota_;
 };
 
+// Incremented whenever a memory quota runs out of free memory and starts
+// reclaiming. Caches of memory that is not charged to any quota (such as the
+// arena buffer pool) drop their contents when they observe a new value.
+uint64_t MemoryPressureEpoch();
+
 using MemoryQuotaRefPtr = std::shared_ptr<MemoryQuota>;
 inline MemoryQuotaRefPtr MakeMemoryQuota(std::string name) {
   return std::make_shared<MemoryQuota>(std::move(name));
@@ -16,6 +16,13 @@
 
 #include "src/core/lib/resource_quota/resource_quota.h"
 
+#include "src/core/lib/gprpp/global_config.h"
+
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_default_resource_quota_max_threads, 0,
+    "If positive, the maximum number of threads of the default resource "
+    "quota, which the process wide thread pools of gRPC draw from.");
+
 namespace grpc_core {
 
 ResourceQuota::ResourceQuota(std::string name)
@@ -25,8 +32,13 @@ ResourceQuota::ResourceQuota(std::string name)
 ResourceQuota::~ResourceQuota() = default;
 
 ResourceQuotaRefPtr ResourceQuota::Default() {
-  static auto default_resource_quota =
-      MakeResourceQuota("default_resource_quota").release();
+  static auto default_resource_quota = []() {
+    auto quota = MakeResourceQuota("default_resource_quota");
+    int32_t max_threads =
+        GPR_GLOBAL_CONFIG_GET(grpc_default_resource_quota_max_threads);
+    if (max_threads > 0) quota->thread_quota()->SetMax(max_threads);
+    return quota.release();
+  }();
   return default_resource_quota->Ref();
 }
 
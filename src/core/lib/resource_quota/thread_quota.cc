@@ -36,10 +36,20 @@ bool ThreadQuota::Reserve(size_t num_threads) {
   return true;
 }
 
+void ThreadQuota::ForceReserve(size_t num_threads) {
+  MutexLock lock(&mu_);
+  allocated_ += num_threads;
+}
+
 void ThreadQuota::Release(size_t num_threads) {
   MutexLock lock(&mu_);
   GPR_ASSERT(num_threads <= allocated_);
   allocated_ -= num_threads;
 }
 
+size_t ThreadQuota::allocated() {
+  MutexLock lock(&mu_);
+  return allocated_;
+}
+
 }  // namespace grpc_core
@@ -43,11 +43,21 @@ class ThreadQuota : public RefCounted<ThreadQuota> {
 
   // Try to allocate some number of threads.
   // Returns true if the allocation succeeded, false otherwise.
+  // Components that can do with fewer threads call this before starting each
+  // optional thread, and queue their work on the threads they have if it
+  // fails.
   bool Reserve(size_t num_threads);
 
+  // Allocate some number of threads that a component cannot do without, even
+  // past the maximum.  They count against later reservations all the same.
+  void ForceReserve(size_t num_threads);
+
   // Release some number of threads.
   void Release(size_t num_threads);
 
+  // The number of threads currently allocated.
+  size_t allocated();
+
  private:
   Mutex mu_;
   size_t allocated_ ABSL_GUARDED_BY(mu_) = 0;
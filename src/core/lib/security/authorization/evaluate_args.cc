@@ -16,6 +16,7 @@
 
 #include "src/core/lib/security/authorization/evaluate_args.h"
 
+#include "absl/memory/memory.h"
 #include "absl/strings/numbers.h"
 
 #include "src/core/lib/address_utils/parse_address.h"
@@ -61,7 +62,8 @@ EvaluateArgs::PerChannelArgs::Address ParseEndpointUri(
 }  // namespace
 
 EvaluateArgs::PerChannelArgs::PerChannelArgs(grpc_auth_context* auth_context,
-                                             grpc_endpoint* endpoint) {
+                                             grpc_endpoint* endpoint)
+    : match_cache(absl::make_unique<MatchCache>()) {
   if (auth_context != nullptr) {
     transport_security_type = GetAuthPropertyValue(
         auth_context, GRPC_TRANSPORT_SECURITY_TYPE_PROPERTY_NAME);
@@ -209,4 +211,30 @@ absl::string_view EvaluateArgs::GetSubject() const {
   return channel_args_->subject;
 }
 
+std::shared_ptr<const std::vector<bool>> EvaluateArgs::GetConnectionMatches(
+    uint64_t engine_id, absl::FunctionRef<std::vector<bool>()> compute) const {
+  if (channel_args_ == nullptr) {
+    return std::make_shared<const std::vector<bool>>(compute());
+  }
+  PerChannelArgs::MatchCache* cache = channel_args_->match_cache.get();
+  {
+    MutexLock lock(&cache->mu);
+    for (const auto& entry : cache->entries) {
+      if (entry.first == engine_id) return entry.second;
+    }
+  }
+  // Computed without the lock held. If concurrent calls race here, they
+  // compute the same results and the first one to finish is kept.
+  auto matches = std::make_shared<const std::vector<bool>>(compute());
+  MutexLock lock(&cache->mu);
+  for (const auto& entry : cache->entries) {
+    if (entry.first == engine_id) return entry.second;
+  }
+  if (cache->entries.size() == PerChannelArgs::MatchCache::kMaxEntries) {
+    cache->entries.erase(cache->entries.begin());
+  }
+  cache->entries.emplace_back(engine_id, matches);
+  return matches;
+}
+
 }  // namespace grpc_core
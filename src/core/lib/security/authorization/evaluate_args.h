@@ -17,10 +17,18 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
 #include <map>
+#include <memory>
+#include <utility>
+#include <vector>
 
+#include "absl/container/inlined_vector.h"
+#include "absl/functional/function_ref.h"
 #include "absl/types/optional.h"
 
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/security/context/security_context.h"
@@ -41,6 +49,19 @@ class EvaluateArgs {
       int port = 0;
     };
 
+    // Results of the connection-level rules of the authorization engines
+    // that evaluated calls on this channel, by engine id. Only the most
+    // recent engines are kept, since policy updates replace them.
+    struct MatchCache {
+      static constexpr size_t kMaxEntries = 4;
+
+      Mutex mu;
+      absl::InlinedVector<
+          std::pair<uint64_t, std::shared_ptr<const std::vector<bool>>>,
+          kMaxEntries>
+          entries ABSL_GUARDED_BY(mu);
+    };
+
     PerChannelArgs(grpc_auth_context* auth_context, grpc_endpoint* endpoint);
 
     absl::string_view transport_security_type;
@@ -51,6 +72,7 @@ class EvaluateArgs {
     absl::string_view subject;
     Address local_address;
     Address peer_address;
+    std::unique_ptr<MatchCache> match_cache;
   };
 
   EvaluateArgs(grpc_metadata_batch* metadata, PerChannelArgs* channel_args)
@@ -82,6 +104,13 @@ class EvaluateArgs {
   absl::string_view GetCommonName() const;
   absl::string_view GetSubject() const;
 
+  // Returns the results of the connection-level rules of the engine
+  // identified by engine_id. These only depend on the channel args, so
+  // compute() is called once per channel and the results are cached.
+  std::shared_ptr<const std::vector<bool>> GetConnectionMatches(
+      uint64_t engine_id,
+      absl::FunctionRef<std::vector<bool>()> compute) const;
+
  private:
   grpc_metadata_batch* metadata_;
   PerChannelArgs* channel_args_;
@@ -16,36 +16,262 @@
 
 #include "src/core/lib/security/authorization/grpc_authorization_engine.h"
 
+#include <algorithm>
+#include <atomic>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/types/optional.h"
+
 namespace grpc_core {
 
+namespace {
+
+std::atomic<uint64_t> g_next_engine_id{1};
+
+// Exact paths and path prefixes, one of which the path of a call must
+// match for a rule to match.
+struct PathRequirement {
+  std::vector<std::string> exact_paths;
+  std::vector<std::string> path_prefixes;
+};
+
+absl::optional<PathRequirement> GetPathRequirement(
+    const StringMatcher& matcher) {
+  if (!matcher.case_sensitive()) return absl::nullopt;
+  PathRequirement requirement;
+  if (matcher.type() == StringMatcher::Type::kExact) {
+    requirement.exact_paths.push_back(matcher.string_matcher());
+  } else if (matcher.type() == StringMatcher::Type::kPrefix) {
+    requirement.path_prefixes.push_back(matcher.string_matcher());
+  } else {
+    return absl::nullopt;
+  }
+  return requirement;
+}
+
+absl::optional<PathRequirement> GetPathRequirement(
+    const Rbac::Permission& permission);
+absl::optional<PathRequirement> GetPathRequirement(
+    const Rbac::Principal& principal);
+
+// Permission and Principal have the same AND/OR structure.
+template <typename Rule>
+absl::optional<PathRequirement> GetPathRequirement(
+    const std::vector<std::unique_ptr<Rule>>& rules, bool is_and) {
+  if (is_and) {
+    // Any of the rules' requirements applies.
+    for (const auto& rule : rules) {
+      auto requirement = GetPathRequirement(*rule);
+      if (requirement.has_value()) return requirement;
+    }
+    return absl::nullopt;
+  }
+  // All of the rules need one.
+  PathRequirement requirement;
+  for (const auto& rule : rules) {
+    auto rule_requirement = GetPathRequirement(*rule);
+    if (!rule_requirement.has_value()) return absl::nullopt;
+    for (std::string& path : rule_requirement->exact_paths) {
+      requirement.exact_paths.push_back(std::move(path));
+    }
+    for (std::string& prefix : rule_requirement->path_prefixes) {
+      requirement.path_prefixes.push_back(std::move(prefix));
+    }
+  }
+  return requirement;
+}
+
+absl::optional<PathRequirement> GetPathRequirement(
+    const Rbac::Permission& permission) {
+  switch (permission.type) {
+    case Rbac::Permission::RuleType::kAnd:
+    case Rbac::Permission::RuleType::kOr:
+      return GetPathRequirement(
+          permission.permissions,
+          permission.type == Rbac::Permission::RuleType::kAnd);
+    case Rbac::Permission::RuleType::kPath:
+      return GetPathRequirement(permission.string_matcher);
+    default:
+      return absl::nullopt;
+  }
+}
+
+absl::optional<PathRequirement> GetPathRequirement(
+    const Rbac::Principal& principal) {
+  switch (principal.type) {
+    case Rbac::Principal::RuleType::kAnd:
+    case Rbac::Principal::RuleType::kOr:
+      return GetPathRequirement(
+          principal.principals,
+          principal.type == Rbac::Principal::RuleType::kAnd);
+    case Rbac::Principal::RuleType::kPath:
+      return GetPathRequirement(principal.string_matcher.value());
+    default:
+      return absl::nullopt;
+  }
+}
+
+// Whether the rule only depends on the connection and not on the call.
+bool IsConnectionLevel(const Rbac::Permission& permission) {
+  switch (permission.type) {
+    case Rbac::Permission::RuleType::kAnd:
+    case Rbac::Permission::RuleType::kOr:
+    case Rbac::Permission::RuleType::kNot:
+      for (const auto& rule : permission.permissions) {
+        if (!IsConnectionLevel(*rule)) return false;
+      }
+      return true;
+    case Rbac::Permission::RuleType::kHeader:
+    case Rbac::Permission::RuleType::kPath:
+      return false;
+    default:
+      return true;
+  }
+}
+
+bool IsConnectionLevel(const Rbac::Principal& principal) {
+  switch (principal.type) {
+    case Rbac::Principal::RuleType::kAnd:
+    case Rbac::Principal::RuleType::kOr:
+    case Rbac::Principal::RuleType::kNot:
+      for (const auto& id : principal.principals) {
+        if (!IsConnectionLevel(*id)) return false;
+      }
+      return true;
+    case Rbac::Principal::RuleType::kHeader:
+    case Rbac::Principal::RuleType::kPath:
+      return false;
+    default:
+      return true;
+  }
+}
+
+}  // namespace
+
+GrpcAuthorizationEngine::GrpcAuthorizationEngine(Rbac::Action action)
+    : id_(g_next_engine_id.fetch_add(1, std::memory_order_relaxed)),
+      action_(action) {}
+
 GrpcAuthorizationEngine::GrpcAuthorizationEngine(Rbac policy)
-    : action_(policy.action) {
+    : GrpcAuthorizationEngine(policy.action) {
   for (auto& sub_policy : policy.policies) {
-    Policy policy;
-    policy.name = sub_policy.first;
-    policy.matcher = absl::make_unique<PolicyAuthorizationMatcher>(
-        std::move(sub_policy.second));
-    policies_.push_back(std::move(policy));
+    const size_t index = policies_.size();
+    Rbac::Policy& rules = sub_policy.second;
+    // A policy matches iff both its permissions and principals match, so
+    // either one's path requirement applies.
+    absl::optional<PathRequirement> path_requirement =
+        GetPathRequirement(rules.permissions);
+    if (!path_requirement.has_value()) {
+      path_requirement = GetPathRequirement(rules.principals);
+    }
+    if (path_requirement.has_value()) {
+      for (std::string& path : path_requirement->exact_paths) {
+        exact_path_policies_[std::move(path)].push_back(index);
+      }
+      for (std::string& prefix : path_requirement->path_prefixes) {
+        path_prefix_lengths_.push_back(prefix.size());
+        path_prefix_policies_[std::move(prefix)].push_back(index);
+      }
+    } else {
+      unindexed_policies_.push_back(index);
+    }
+    Policy compiled_policy;
+    compiled_policy.name = sub_policy.first;
+    const bool permissions_connection_level =
+        IsConnectionLevel(rules.permissions);
+    const bool principals_connection_level =
+        IsConnectionLevel(rules.principals);
+    compiled_policy.permissions =
+        AuthorizationMatcher::Create(std::move(rules.permissions));
+    compiled_policy.principals =
+        AuthorizationMatcher::Create(std::move(rules.principals));
+    if (permissions_connection_level) {
+      compiled_policy.permissions_slot = connection_matchers_.size();
+      connection_matchers_.push_back(compiled_policy.permissions.get());
+    }
+    if (principals_connection_level) {
+      compiled_policy.principals_slot = connection_matchers_.size();
+      connection_matchers_.push_back(compiled_policy.principals.get());
+    }
+    policies_.push_back(std::move(compiled_policy));
   }
+  std::sort(path_prefix_lengths_.begin(), path_prefix_lengths_.end());
+  path_prefix_lengths_.erase(
+      std::unique(path_prefix_lengths_.begin(), path_prefix_lengths_.end()),
+      path_prefix_lengths_.end());
 }
 
 GrpcAuthorizationEngine::GrpcAuthorizationEngine(
     GrpcAuthorizationEngine&& other) noexcept
-    : action_(other.action_), policies_(std::move(other.policies_)) {}
+    : id_(other.id_),
+      action_(other.action_),
+      policies_(std::move(other.policies_)),
+      connection_matchers_(std::move(other.connection_matchers_)),
+      exact_path_policies_(std::move(other.exact_path_policies_)),
+      path_prefix_policies_(std::move(other.path_prefix_policies_)),
+      path_prefix_lengths_(std::move(other.path_prefix_lengths_)),
+      unindexed_policies_(std::move(other.unindexed_policies_)) {}
 
 GrpcAuthorizationEngine& GrpcAuthorizationEngine::operator=(
     GrpcAuthorizationEngine&& other) noexcept {
+  id_ = other.id_;
   action_ = other.action_;
   policies_ = std::move(other.policies_);
+  connection_matchers_ = std::move(other.connection_matchers_);
+  exact_path_policies_ = std::move(other.exact_path_policies_);
+  path_prefix_policies_ = std::move(other.path_prefix_policies_);
+  path_prefix_lengths_ = std::move(other.path_prefix_lengths_);
+  unindexed_policies_ = std::move(other.unindexed_policies_);
   return *this;
 }
 
+bool GrpcAuthorizationEngine::Matches(
+    const AuthorizationMatcher& matcher, int slot, const EvaluateArgs& args,
+    const std::vector<bool>* connection_matches) {
+  if (slot >= 0) return (*connection_matches)[slot];
+  return matcher.Matches(args);
+}
+
 AuthorizationEngine::Decision GrpcAuthorizationEngine::Evaluate(
     const EvaluateArgs& args) const {
+  std::shared_ptr<const std::vector<bool>> connection_matches;
+  if (!connection_matchers_.empty()) {
+    connection_matches = args.GetConnectionMatches(id_, [&]() {
+      std::vector<bool> matches;
+      matches.reserve(connection_matchers_.size());
+      for (const AuthorizationMatcher* matcher : connection_matchers_) {
+        matches.push_back(matcher->Matches(args));
+      }
+      return matches;
+    });
+  }
+  // Policies are tried in order, and only the ones that can match the path.
+  absl::InlinedVector<size_t, 8> candidates(unindexed_policies_.begin(),
+                                            unindexed_policies_.end());
+  const absl::string_view path = args.GetPath();
+  auto it = exact_path_policies_.find(path);
+  if (it != exact_path_policies_.end()) {
+    candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+  }
+  for (size_t length : path_prefix_lengths_) {
+    if (length > path.size()) break;
+    it = path_prefix_policies_.find(path.substr(0, length));
+    if (it != path_prefix_policies_.end()) {
+      candidates.insert(candidates.end(), it->second.begin(),
+                        it->second.end());
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                   candidates.end());
   Decision decision;
   bool matches = false;
-  for (const auto& policy : policies_) {
-    if (policy.matcher->Matches(args)) {
+  for (size_t index : candidates) {
+    const Policy& policy = policies_[index];
+    if (Matches(*policy.permissions, policy.permissions_slot, args,
+                connection_matches.get()) &&
+        Matches(*policy.principals, policy.principals_slot, args,
+                connection_matches.get())) {
       matches = true;
       decision.matching_policy_name = policy.name;
       break;
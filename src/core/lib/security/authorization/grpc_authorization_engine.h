@@ -17,6 +17,14 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+
 #include "src/core/lib/security/authorization/authorization_engine.h"
 #include "src/core/lib/security/authorization/matchers.h"
 #include "src/core/lib/security/authorization/rbac_policy.h"
@@ -29,10 +37,17 @@ namespace grpc_core {
 // engine type. This engine ignores condition field in RBAC config. It is the
 // caller's responsibility to provide RBAC policies that are compatible with
 // this engine.
+//
+// Policies are compiled when the engine is built. Policies that can only
+// match some exact paths or path prefixes are indexed by them, so a call
+// only evaluates the policies that can match its path. Permissions and
+// principals that only depend on the connection (peer identity and
+// addresses) are evaluated once per connection and cached in the
+// EvaluateArgs::PerChannelArgs.
 class GrpcAuthorizationEngine : public AuthorizationEngine {
  public:
   // Builds GrpcAuthorizationEngine without any policies.
-  explicit GrpcAuthorizationEngine(Rbac::Action action) : action_(action) {}
+  explicit GrpcAuthorizationEngine(Rbac::Action action);
   // Builds GrpcAuthorizationEngine with allow/deny RBAC policy.
   explicit GrpcAuthorizationEngine(Rbac policy);
 
@@ -51,10 +66,33 @@ class GrpcAuthorizationEngine : public AuthorizationEngine {
  private:
   struct Policy {
     std::string name;
-    std::unique_ptr<AuthorizationMatcher> matcher;
+    std::unique_ptr<AuthorizationMatcher> permissions;
+    std::unique_ptr<AuthorizationMatcher> principals;
+    // Index of permissions/principals in connection_matchers_, or -1 if
+    // they depend on the call.
+    int permissions_slot = -1;
+    int principals_slot = -1;
   };
+
+  // Whether the matcher in slot matches, using the cached connection-level
+  // results when there is one.
+  static bool Matches(const AuthorizationMatcher& matcher, int slot,
+                      const EvaluateArgs& args,
+                      const std::vector<bool>* connection_matches);
+
+  // Unique among engines, so that connections can cache results per engine.
+  uint64_t id_;
   Rbac::Action action_;
   std::vector<Policy> policies_;
+  // Matchers that only depend on the connection.
+  std::vector<const AuthorizationMatcher*> connection_matchers_;
+  // Indices of the policies that can only match the given exact paths or
+  // paths with the given prefixes, and of the other policies.
+  absl::flat_hash_map<std::string, std::vector<size_t>> exact_path_policies_;
+  absl::flat_hash_map<std::string, std::vector<size_t>> path_prefix_policies_;
+  // Distinct lengths of the keys of path_prefix_policies_.
+  std::vector<size_t> path_prefix_lengths_;
+  std::vector<size_t> unindexed_policies_;
 };
 
 }  // namespace grpc_core
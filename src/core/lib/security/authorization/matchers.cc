@@ -16,13 +16,89 @@
 
 #include "src/core/lib/security/authorization/matchers.h"
 
+#include <algorithm>
+#include <map>
+
 #include <grpc/grpc_security_constants.h>
 
 #include "src/core/lib/address_utils/parse_address.h"
 #include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/iomgr/sockaddr.h"
 
 namespace grpc_core {
 
+namespace {
+
+absl::optional<IpAuthorizationMatcher::Type> GetIpRuleType(
+    const Rbac::Permission& permission) {
+  if (permission.type == Rbac::Permission::RuleType::kDestIp) {
+    return IpAuthorizationMatcher::Type::kDestIp;
+  }
+  return absl::nullopt;
+}
+
+absl::optional<IpAuthorizationMatcher::Type> GetIpRuleType(
+    const Rbac::Principal& principal) {
+  switch (principal.type) {
+    case Rbac::Principal::RuleType::kSourceIp:
+      return IpAuthorizationMatcher::Type::kSourceIp;
+    case Rbac::Principal::RuleType::kDirectRemoteIp:
+      return IpAuthorizationMatcher::Type::kDirectRemoteIp;
+    case Rbac::Principal::RuleType::kRemoteIp:
+      return IpAuthorizationMatcher::Type::kRemoteIp;
+    default:
+      return absl::nullopt;
+  }
+}
+
+// Creates the matchers of the rules of an OR. IP rules of the same type
+// are merged into an IpSetAuthorizationMatcher when there are several.
+template <typename Rule>
+std::vector<std::unique_ptr<AuthorizationMatcher>> CreateOrMatchers(
+    const std::vector<std::unique_ptr<Rule>>& rules) {
+  std::map<IpAuthorizationMatcher::Type, size_t> ip_rule_counts;
+  for (const auto& rule : rules) {
+    auto ip_type = GetIpRuleType(*rule);
+    if (ip_type.has_value()) ++ip_rule_counts[*ip_type];
+  }
+  std::vector<std::unique_ptr<AuthorizationMatcher>> matchers;
+  std::map<IpAuthorizationMatcher::Type, IpSetAuthorizationMatcher*> ip_sets;
+  for (const auto& rule : rules) {
+    auto ip_type = GetIpRuleType(*rule);
+    if (ip_type.has_value() && ip_rule_counts[*ip_type] > 1) {
+      IpSetAuthorizationMatcher*& ip_set = ip_sets[*ip_type];
+      if (ip_set == nullptr) {
+        auto matcher = absl::make_unique<IpSetAuthorizationMatcher>(*ip_type);
+        ip_set = matcher.get();
+        matchers.push_back(std::move(matcher));
+      }
+      if (ip_set->AddRange(rule->ip)) continue;
+    }
+    matchers.push_back(AuthorizationMatcher::Create(std::move(*rule)));
+  }
+  return matchers;
+}
+
+// Returns the address bytes and their number for IPv4/IPv6 addresses.
+const uint8_t* GetAddressBytes(const grpc_resolved_address& address,
+                               size_t* size) {
+  const grpc_sockaddr* addr =
+      reinterpret_cast<const grpc_sockaddr*>(address.addr);
+  if (addr->sa_family == GRPC_AF_INET) {
+    *size = 4;
+    return reinterpret_cast<const uint8_t*>(
+        &reinterpret_cast<const grpc_sockaddr_in*>(addr)->sin_addr);
+  }
+  if (addr->sa_family == GRPC_AF_INET6) {
+    *size = 16;
+    return reinterpret_cast<const uint8_t*>(
+        &reinterpret_cast<const grpc_sockaddr_in6*>(addr)->sin6_addr);
+  }
+  return nullptr;
+}
+
+}  // namespace
+
 std::unique_ptr<AuthorizationMatcher> AuthorizationMatcher::Create(
     Rbac::Permission permission) {
   switch (permission.type) {
@@ -33,13 +109,9 @@ std::unique_ptr<AuthorizationMatcher> AuthorizationMatcher::Create(
       }
       return absl::make_unique<AndAuthorizationMatcher>(std::move(matchers));
     }
-    case Rbac::Permission::RuleType::kOr: {
-      std::vector<std::unique_ptr<AuthorizationMatcher>> matchers;
-      for (const auto& rule : permission.permissions) {
-        matchers.push_back(AuthorizationMatcher::Create(std::move(*rule)));
-      }
-      return absl::make_unique<OrAuthorizationMatcher>(std::move(matchers));
-    }
+    case Rbac::Permission::RuleType::kOr:
+      return absl::make_unique<OrAuthorizationMatcher>(
+          CreateOrMatchers(permission.permissions));
     case Rbac::Permission::RuleType::kNot:
       return absl::make_unique<NotAuthorizationMatcher>(
           AuthorizationMatcher::Create(std::move(*permission.permissions[0])));
@@ -75,13 +147,9 @@ std::unique_ptr<AuthorizationMatcher> AuthorizationMatcher::Create(
       }
       return absl::make_unique<AndAuthorizationMatcher>(std::move(matchers));
     }
-    case Rbac::Principal::RuleType::kOr: {
-      std::vector<std::unique_ptr<AuthorizationMatcher>> matchers;
-      for (const auto& id : principal.principals) {
-        matchers.push_back(AuthorizationMatcher::Create(std::move(*id)));
-      }
-      return absl::make_unique<OrAuthorizationMatcher>(std::move(matchers));
-    }
+    case Rbac::Principal::RuleType::kOr:
+      return absl::make_unique<OrAuthorizationMatcher>(
+          CreateOrMatchers(principal.principals));
     case Rbac::Principal::RuleType::kNot:
       return absl::make_unique<NotAuthorizationMatcher>(
           AuthorizationMatcher::Create(std::move(*principal.principals[0])));
@@ -173,6 +241,49 @@ bool IpAuthorizationMatcher::Matches(const EvaluateArgs& args) const {
   return grpc_sockaddr_match_subnet(&address, &subnet_address_, prefix_len_);
 }
 
+bool IpSetAuthorizationMatcher::AddRange(const Rbac::CidrRange& range) {
+  grpc_resolved_address address;
+  grpc_error_handle error = grpc_string_to_sockaddr(
+      &address, range.address_prefix.c_str(), /*port does not matter here*/ 0);
+  if (error != GRPC_ERROR_NONE) {
+    GRPC_ERROR_UNREF(error);
+    return false;
+  }
+  size_t size;
+  const uint8_t* bytes = GetAddressBytes(address, &size);
+  if (bytes == nullptr) return false;
+  std::vector<Node>& trie = size == 4 ? ipv4_trie_ : ipv6_trie_;
+  const size_t prefix_len = std::min<size_t>(range.prefix_len, size * 8);
+  uint32_t node = 0;
+  for (size_t i = 0; i < prefix_len; ++i) {
+    const int bit = (bytes[i / 8] >> (7 - i % 8)) & 1;
+    if (trie[node].children[bit] == 0) {
+      trie[node].children[bit] = static_cast<uint32_t>(trie.size());
+      trie.emplace_back();
+    }
+    node = trie[node].children[bit];
+  }
+  trie[node].terminal = true;
+  return true;
+}
+
+bool IpSetAuthorizationMatcher::Matches(const EvaluateArgs& args) const {
+  grpc_resolved_address address = type_ == IpAuthorizationMatcher::Type::kDestIp
+                                      ? args.GetLocalAddress()
+                                      : args.GetPeerAddress();
+  size_t size;
+  const uint8_t* bytes = GetAddressBytes(address, &size);
+  if (bytes == nullptr) return false;
+  const std::vector<Node>& trie = size == 4 ? ipv4_trie_ : ipv6_trie_;
+  uint32_t node = 0;
+  for (size_t i = 0;; ++i) {
+    if (trie[node].terminal) return true;
+    if (i == size * 8) return false;
+    node = trie[node].children[(bytes[i / 8] >> (7 - i % 8)) & 1];
+    if (node == 0) return false;
+  }
+}
+
 bool PortAuthorizationMatcher::Matches(const EvaluateArgs& args) const {
   return port_ == args.GetLocalPort();
 }
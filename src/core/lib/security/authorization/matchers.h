@@ -138,6 +138,34 @@ class IpAuthorizationMatcher : public AuthorizationMatcher {
   const uint32_t prefix_len_;
 };
 
+// Matches if the address falls in any of a set of CIDR ranges. Same as an
+// OrAuthorizationMatcher of IpAuthorizationMatchers of one type, but looks
+// the address up in a binary trie instead of trying every range.
+class IpSetAuthorizationMatcher : public AuthorizationMatcher {
+ public:
+  explicit IpSetAuthorizationMatcher(IpAuthorizationMatcher::Type type)
+      : type_(type) {}
+
+  // Returns false if range is not an IPv4/IPv6 range, in which case it is
+  // not added.
+  bool AddRange(const Rbac::CidrRange& range);
+
+  bool Matches(const EvaluateArgs& args) const override;
+
+ private:
+  struct Node {
+    // Index of the node for the next bit being 0 and 1, or 0 if none.
+    uint32_t children[2] = {0, 0};
+    // Whether a range ends at this node.
+    bool terminal = false;
+  };
+
+  const IpAuthorizationMatcher::Type type_;
+  // Node 0 is the root of each trie.
+  std::vector<Node> ipv4_trie_{1};
+  std::vector<Node> ipv6_trie_{1};
+};
+
 // Perform a match against port number of the destination (local) address.
 class PortAuthorizationMatcher : public AuthorizationMatcher {
  public:
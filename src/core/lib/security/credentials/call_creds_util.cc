@@ -23,10 +23,32 @@
 
 #include <grpc/support/string_util.h>
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_shared_call_credentials, false,
+    "If true, OAuth2 and JWT call credentials that are created for the same "
+    "identity share their tokens and token fetches across the process.");
+
 namespace grpc_core {
 
 namespace {
 
+// Returns the authority of the call, without the port if it is the default
+// one of \a url_scheme.
+absl::string_view GetAuthority(const ClientMetadataHandle& initial_metadata,
+                               absl::string_view url_scheme) {
+  auto host_and_port =
+      initial_metadata->get_pointer(HttpAuthorityMetadata())->as_string_view();
+  if (url_scheme == GRPC_SSL_URL_SCHEME) {
+    // Remove the port if it is 443.
+    auto port_delimiter = host_and_port.find_last_of(':');
+    if (port_delimiter != absl::string_view::npos &&
+        host_and_port.substr(port_delimiter + 1) == "443") {
+      host_and_port = host_and_port.substr(0, port_delimiter);
+    }
+  }
+  return host_and_port;
+}
+
 struct ServiceUrlAndMethod {
   std::string service_url;
   absl::string_view method_name;
@@ -49,17 +71,8 @@ ServiceUrlAndMethod MakeServiceUrlAndMethod(
     method_name = service.substr(last_slash + 1);
     service = service.substr(0, last_slash);
   }
-  auto host_and_port =
-      initial_metadata->get_pointer(HttpAuthorityMetadata())->as_string_view();
   absl::string_view url_scheme = args->security_connector->url_scheme();
-  if (url_scheme == GRPC_SSL_URL_SCHEME) {
-    // Remove the port if it is 443.
-    auto port_delimiter = host_and_port.find_last_of(':');
-    if (port_delimiter != absl::string_view::npos &&
-        host_and_port.substr(port_delimiter + 1) == "443") {
-      host_and_port = host_and_port.substr(0, port_delimiter);
-    }
-  }
+  auto host_and_port = GetAuthority(initial_metadata, url_scheme);
   return ServiceUrlAndMethod{
       absl::StrCat(url_scheme, "://", host_and_port, service), method_name};
 }
@@ -86,4 +99,49 @@ grpc_auth_metadata_context MakePluginAuthMetadataContext(
   return ctx;
 }
 
+std::string JwtAudience::ToString() const {
+  return absl::StrCat(url_scheme, "://", authority, "/");
+}
+
+JwtAudience MakeJwtAudience(
+    const ClientMetadataHandle& initial_metadata,
+    const grpc_call_credentials::GetRequestMetadataArgs* args) {
+  absl::string_view url_scheme = args->security_connector->url_scheme();
+  return JwtAudience{url_scheme, GetAuthority(initial_metadata, url_scheme)};
+}
+
+//
+// CallCredentialsRegistry
+//
+
+CallCredentialsRegistry* CallCredentialsRegistry::Get() {
+  static CallCredentialsRegistry* registry = new CallCredentialsRegistry();
+  return registry;
+}
+
+RefCountedPtr<grpc_call_credentials> CallCredentialsRegistry::Find(
+    const std::string& key) {
+  MutexLock lock(&mu_);
+  auto it = creds_by_key_.find(key);
+  if (it == creds_by_key_.end()) return nullptr;
+  // Credentials unregister themselves from their destructor, under mu_, so
+  // they are not freed yet even if their last ref is gone.
+  return it->second->RefIfNonZero();
+}
+
+void CallCredentialsRegistry::Register(const std::string& key,
+                                       grpc_call_credentials* creds) {
+  MutexLock lock(&mu_);
+  creds_by_key_[key] = creds;
+}
+
+void CallCredentialsRegistry::Unregister(const std::string& key,
+                                         grpc_call_credentials* creds) {
+  MutexLock lock(&mu_);
+  auto it = creds_by_key_.find(key);
+  if (it != creds_by_key_.end() && it->second == creds) {
+    creds_by_key_.erase(it);
+  }
+}
+
 }  // namespace grpc_core
@@ -19,12 +19,20 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <map>
 #include <string>
 
+#include "absl/strings/string_view.h"
+
 #include <grpc/grpc_security.h>
 
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/security/credentials/credentials.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_shared_call_credentials);
+
 namespace grpc_core {
 
 // Helper function to construct service URL for jwt call creds.
@@ -37,6 +45,47 @@ grpc_auth_metadata_context MakePluginAuthMetadataContext(
     const ClientMetadataHandle& initial_metadata,
     const grpc_call_credentials::GetRequestMetadataArgs* args);
 
+// The audience of the JWTs of jwt call creds, "<url_scheme>://<authority>/".
+// The fields point into the call's metadata and security connector, so that
+// the audience can be matched against cached JWTs without formatting a
+// string per call.
+struct JwtAudience {
+  absl::string_view url_scheme;
+  // Without the port if it is the default one of the url scheme.
+  absl::string_view authority;
+
+  std::string ToString() const;
+};
+
+// Helper function to get the JWT audience for jwt call creds.
+JwtAudience MakeJwtAudience(
+    const ClientMetadataHandle& initial_metadata,
+    const grpc_call_credentials::GetRequestMetadataArgs* args);
+
+// Process-wide registry of call credentials by identity, used when
+// grpc_shared_call_credentials is set. Credentials created separately for the
+// same identity then share one object, and so one token cache and one token
+// fetch. Keys must start with the type of the credentials. Registered
+// credentials must unregister themselves on destruction.
+class CallCredentialsRegistry {
+ public:
+  static CallCredentialsRegistry* Get();
+
+  // Returns the credentials registered for \a key, unless there are none or
+  // they are being destroyed.
+  RefCountedPtr<grpc_call_credentials> Find(const std::string& key);
+  // Registers \a creds for \a key, replacing any credentials registered
+  // for it.
+  void Register(const std::string& key, grpc_call_credentials* creds);
+  // Removes \a creds from the registry, if they are registered for \a key.
+  void Unregister(const std::string& key, grpc_call_credentials* creds);
+
+ private:
+  Mutex mu_;
+  std::map<std::string, grpc_call_credentials*> creds_by_key_
+      ABSL_GUARDED_BY(mu_);
+};
+
 }  // namespace grpc_core
 
 #endif /* GRPC_CORE_LIB_SECURITY_CREDENTIALS_CALL_CREDS_UTIL_H */
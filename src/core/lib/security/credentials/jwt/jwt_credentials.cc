@@ -45,10 +45,15 @@ using grpc_core::Json;
 
 grpc_service_account_jwt_access_credentials::
     ~grpc_service_account_jwt_access_credentials() {
+  if (!registry_key_.empty()) {
+    grpc_core::CallCredentialsRegistry::Get()->Unregister(registry_key_, this);
+  }
   grpc_auth_json_key_destruct(&key_);
   gpr_mu_destroy(&cache_mu_);
 }
 
+constexpr size_t grpc_service_account_jwt_access_credentials::kMaxCachedJwts;
+
 grpc_core::ArenaPromise<absl::StatusOr<grpc_core::ClientMetadataHandle>>
 grpc_service_account_jwt_access_credentials::GetRequestMetadata(
     grpc_core::ClientMetadataHandle initial_metadata,
@@ -56,38 +61,45 @@ grpc_service_account_jwt_access_credentials::GetRequestMetadata(
   gpr_timespec refresh_threshold = gpr_time_from_seconds(
       GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS, GPR_TIMESPAN);
 
-  // Remove service name from service_url to follow the audience format
-  // dictated in https://google.aip.dev/auth/4111.
-  absl::StatusOr<std::string> uri = grpc_core::RemoveServiceNameFromJwtUri(
-      grpc_core::MakeJwtServiceUrl(initial_metadata, args));
-  if (!uri.ok()) {
-    return grpc_core::Immediate(uri.status());
-  }
+  // The audience follows the format dictated in
+  // https://google.aip.dev/auth/4111: the service URL without the service
+  // name.
+  grpc_core::JwtAudience audience =
+      grpc_core::MakeJwtAudience(initial_metadata, args);
   // See if we can return a cached jwt.
   absl::optional<grpc_core::Slice> jwt_value;
   {
     gpr_mu_lock(&cache_mu_);
-    if (cached_.has_value() && cached_->service_url == *uri &&
-        (gpr_time_cmp(
-             gpr_time_sub(cached_->jwt_expiration, gpr_now(GPR_CLOCK_REALTIME)),
-             refresh_threshold) > 0)) {
-      jwt_value = cached_->jwt_value.Ref();
+    auto it = cached_.find(audience.authority);
+    if (it != cached_.end() && it->second.url_scheme == audience.url_scheme &&
+        (gpr_time_cmp(gpr_time_sub(it->second.jwt_expiration,
+                                   gpr_now(GPR_CLOCK_REALTIME)),
+                      refresh_threshold) > 0)) {
+      jwt_value = it->second.jwt_value.Ref();
     }
     gpr_mu_unlock(&cache_mu_);
   }
 
   if (!jwt_value.has_value()) {
+    absl::StatusOr<std::string> uri =
+        grpc_core::RemoveServiceNameFromJwtUri(audience.ToString());
+    if (!uri.ok()) {
+      return grpc_core::Immediate(uri.status());
+    }
     char* jwt = nullptr;
     // Generate a new jwt.
     gpr_mu_lock(&cache_mu_);
-    cached_.reset();
+    cached_.erase(std::string(audience.authority));
     jwt = grpc_jwt_encode_and_sign(&key_, uri->c_str(), jwt_lifetime_, nullptr);
     if (jwt != nullptr) {
       std::string md_value = absl::StrCat("Bearer ", jwt);
       gpr_free(jwt);
       jwt_value = grpc_core::Slice::FromCopiedString(md_value);
-      cached_ = {jwt_value->Ref(), std::move(*uri),
-                 gpr_time_add(gpr_now(GPR_CLOCK_REALTIME), jwt_lifetime_)};
+      if (cached_.size() >= kMaxCachedJwts) cached_.clear();
+      cached_.emplace(
+          std::string(audience.authority),
+          Cache{std::string(audience.url_scheme), jwt_value->Ref(),
+                gpr_time_add(gpr_now(GPR_CLOCK_REALTIME), jwt_lifetime_)});
     }
     gpr_mu_unlock(&cache_mu_);
   }
@@ -129,8 +141,29 @@ grpc_service_account_jwt_access_credentials_create_from_auth_json_key(
     gpr_log(GPR_ERROR, "Invalid input for jwt credentials creation");
     return nullptr;
   }
-  return grpc_core::MakeRefCounted<grpc_service_account_jwt_access_credentials>(
-      key, token_lifetime);
+  if (!GPR_GLOBAL_CONFIG_GET(grpc_shared_call_credentials)) {
+    return grpc_core::MakeRefCounted<
+        grpc_service_account_jwt_access_credentials>(key, token_lifetime);
+  }
+  // The private key ID identifies the key, and so the service account.
+  std::string registry_key = absl::StrCat(
+      grpc_service_account_jwt_access_credentials::Type(), "/",
+      key.private_key_id, "/", key.client_email, "/", token_lifetime.tv_sec,
+      ".", token_lifetime.tv_nsec);
+  grpc_core::CallCredentialsRegistry* registry =
+      grpc_core::CallCredentialsRegistry::Get();
+  grpc_core::RefCountedPtr<grpc_call_credentials> creds =
+      registry->Find(registry_key);
+  if (creds != nullptr) {
+    grpc_auth_json_key_destruct(&key);
+    return creds;
+  }
+  auto jwt_creds =
+      grpc_core::MakeRefCounted<grpc_service_account_jwt_access_credentials>(
+          key, token_lifetime);
+  jwt_creds->registry_key_ = registry_key;
+  registry->Register(registry_key, jwt_creds.get());
+  return jwt_creds;
 }
 
 static char* redact_private_key(const char* json_key) {
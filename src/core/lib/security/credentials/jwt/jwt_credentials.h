@@ -21,6 +21,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <functional>
+#include <map>
 #include <string>
 
 #include "absl/strings/str_format.h"
@@ -63,18 +65,28 @@ class grpc_service_account_jwt_access_credentials
         static_cast<const grpc_call_credentials*>(this), other);
   }
 
-  // Have a simple cache for now with just 1 entry. We could have a map based on
-  // the service_url for a more sophisticated one.
+  friend grpc_core::RefCountedPtr<grpc_call_credentials>
+  grpc_service_account_jwt_access_credentials_create_from_auth_json_key(
+      grpc_auth_json_key key, gpr_timespec token_lifetime);
+
+  // Upper bound on the number of cached JWTs.
+  static constexpr size_t kMaxCachedJwts = 64;
+
   gpr_mu cache_mu_;
   struct Cache {
+    std::string url_scheme;
+    // The ready-made value of the authorization header.
     grpc_core::Slice jwt_value;
-    std::string service_url;
     gpr_timespec jwt_expiration;
   };
-  absl::optional<Cache> cached_;
+  // JWTs by the authority of their audience. The comparator allows lookups
+  // by string_view, without building the audience for every call.
+  std::map<std::string, Cache, std::less<>> cached_;
 
   grpc_auth_json_key key_;
   gpr_timespec jwt_lifetime_;
+  // Set if registered in the grpc_core::CallCredentialsRegistry.
+  std::string registry_key_;
 };
 
 // Private constructor for jwt credentials from an already parsed json key.
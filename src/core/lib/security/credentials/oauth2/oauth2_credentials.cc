@@ -45,6 +45,7 @@
 #include "src/core/lib/iomgr/load_file.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/promise/promise.h"
+#include "src/core/lib/security/credentials/call_creds_util.h"
 #include "src/core/lib/security/util/json_util.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/surface/api_trace.h"
@@ -54,6 +55,12 @@
 
 using grpc_core::Json;
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_proactive_token_refresh, false,
+    "If set, OAuth2 call credentials refresh their token in the background "
+    "before it expires, as long as it is being used, instead of blocking the "
+    "calls that find it expired.");
+
 //
 // Auth Refresh Token.
 //
@@ -135,6 +142,9 @@ void grpc_auth_refresh_token_destruct(grpc_auth_refresh_token* refresh_token) {
 
 grpc_oauth2_token_fetcher_credentials::
     ~grpc_oauth2_token_fetcher_credentials() {
+  if (!registry_key_.empty()) {
+    grpc_core::CallCredentialsRegistry::Get()->Unregister(registry_key_, this);
+  }
   gpr_mu_destroy(&mu_);
   grpc_pollset_set_destroy(grpc_polling_entity_pollset_set(&pollent_));
 }
@@ -245,15 +255,26 @@ void grpc_oauth2_token_fetcher_credentials::on_http_response(
   // Update cache and grab list of pending requests.
   gpr_mu_lock(&mu_);
   token_fetch_pending_ = false;
-  if (access_token_value.has_value()) {
-    access_token_value_ = access_token_value->Ref();
-  } else {
-    access_token_value_ = absl::nullopt;
+  // A failed background refresh keeps the current token, which is still
+  // valid, and leaves it to the calls to fetch a new one once it expires.
+  const bool keep_token =
+      status != GRPC_CREDENTIALS_OK && refreshing_in_background_;
+  refreshing_in_background_ = false;
+  if (!keep_token) {
+    if (access_token_value.has_value()) {
+      access_token_value_ = access_token_value->Ref();
+    } else {
+      access_token_value_ = absl::nullopt;
+    }
+    token_expiration_ = status == GRPC_CREDENTIALS_OK
+                            ? gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
+                                           token_lifetime.as_timespec())
+                            : gpr_inf_past(GPR_CLOCK_MONOTONIC);
+  }
+  if (status == GRPC_CREDENTIALS_OK) {
+    token_used_ = false;
+    MaybeScheduleRefreshLocked(token_lifetime);
   }
-  token_expiration_ = status == GRPC_CREDENTIALS_OK
-                          ? gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
-                                         token_lifetime.as_timespec())
-                          : gpr_inf_past(GPR_CLOCK_MONOTONIC);
   grpc_oauth2_pending_get_request_metadata* pending_request = pending_requests_;
   pending_requests_ = nullptr;
   gpr_mu_unlock(&mu_);
@@ -281,6 +302,51 @@ void grpc_oauth2_token_fetcher_credentials::on_http_response(
   delete r;
 }
 
+void grpc_oauth2_token_fetcher_credentials::MaybeScheduleRefreshLocked(
+    grpc_core::Duration token_lifetime) {
+  if (!proactive_refresh_ || refresh_timer_pending_) return;
+  // Refresh before the calls would find the token expired, with up to 10% of
+  // its lifetime of jitter, so that many processes started together do not
+  // all refresh at once.
+  grpc_core::Duration lead =
+      grpc_core::Duration::Seconds(GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS) +
+      token_lifetime * absl::Uniform(bit_gen_, 0.0, 0.1);
+  if (token_lifetime <= lead) return;
+  refresh_timer_pending_ = true;
+  // The timer holds a ref, so unused credentials live on until it fires.
+  GRPC_CLOSURE_INIT(&on_refresh_timer_, OnRefreshTimer,
+                    Ref().release(), nullptr);
+  grpc_timer_init(&refresh_timer_,
+                  grpc_core::ExecCtx::Get()->Now() + token_lifetime - lead,
+                  &on_refresh_timer_);
+}
+
+void grpc_oauth2_token_fetcher_credentials::OnRefreshTimer(
+    void* arg, grpc_error_handle error) {
+  auto* self = static_cast<grpc_oauth2_token_fetcher_credentials*>(arg);
+  gpr_mu_lock(&self->mu_);
+  self->refresh_timer_pending_ = false;
+  // Tokens not used since they were fetched are left to expire.
+  bool start_fetch = error == GRPC_ERROR_NONE && self->token_used_ &&
+                     !self->token_fetch_pending_;
+  if (start_fetch) {
+    self->token_fetch_pending_ = true;
+    self->refreshing_in_background_ = true;
+  }
+  gpr_mu_unlock(&self->mu_);
+  if (start_fetch) {
+    // The fetch makes progress as long as the pollset_set is polled by
+    // pending calls or other work of the process.
+    self->fetch_oauth2(
+        new grpc_credentials_metadata_request(self->Ref()), &self->pollent_,
+        on_oauth2_token_fetcher_http_response,
+        grpc_core::ExecCtx::Get()->Now() +
+            grpc_core::Duration::Seconds(
+                GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS));
+  }
+  self->Unref();
+}
+
 grpc_core::ArenaPromise<absl::StatusOr<grpc_core::ClientMetadataHandle>>
 grpc_oauth2_token_fetcher_credentials::GetRequestMetadata(
     grpc_core::ClientMetadataHandle initial_metadata,
@@ -294,6 +360,7 @@ grpc_oauth2_token_fetcher_credentials::GetRequestMetadata(
           gpr_time_from_seconds(GRPC_SECURE_TOKEN_REFRESH_THRESHOLD_SECS,
                                 GPR_TIMESPAN)) > 0) {
     cached_access_token_value = access_token_value_->Ref();
+    token_used_ = true;
   }
   if (cached_access_token_value.has_value()) {
     gpr_mu_unlock(&mu_);
@@ -339,7 +406,8 @@ grpc_oauth2_token_fetcher_credentials::GetRequestMetadata(
 grpc_oauth2_token_fetcher_credentials::grpc_oauth2_token_fetcher_credentials()
     : token_expiration_(gpr_inf_past(GPR_CLOCK_MONOTONIC)),
       pollent_(grpc_polling_entity_create_from_pollset_set(
-          grpc_pollset_set_create())) {
+          grpc_pollset_set_create())),
+      proactive_refresh_(GPR_GLOBAL_CONFIG_GET(grpc_proactive_token_refresh)) {
   gpr_mu_init(&mu_);
 }
 
@@ -351,6 +419,27 @@ const char* grpc_oauth2_token_fetcher_credentials::type() const {
   return "Oauth2";
 }
 
+// Returns the credentials registered for \a registry_key if
+// grpc_shared_call_credentials is set, or else the result of \a create,
+// registering it. \a create may return null.
+template <typename F>
+static grpc_core::RefCountedPtr<grpc_call_credentials>
+get_or_create_shared_token_fetcher_credentials(std::string registry_key,
+                                               F create) {
+  if (!GPR_GLOBAL_CONFIG_GET(grpc_shared_call_credentials)) return create();
+  grpc_core::CallCredentialsRegistry* registry =
+      grpc_core::CallCredentialsRegistry::Get();
+  grpc_core::RefCountedPtr<grpc_call_credentials> creds =
+      registry->Find(registry_key);
+  if (creds != nullptr) return creds;
+  grpc_core::RefCountedPtr<grpc_oauth2_token_fetcher_credentials>
+      fetcher_creds = create();
+  if (fetcher_creds == nullptr) return nullptr;
+  registry->Register(registry_key, fetcher_creds.get());
+  fetcher_creds->set_registry_key(std::move(registry_key));
+  return fetcher_creds;
+}
+
 //
 //  Google Compute Engine credentials.
 //
@@ -410,8 +499,12 @@ grpc_call_credentials* grpc_google_compute_engine_credentials_create(
   GRPC_API_TRACE("grpc_compute_engine_credentials_create(reserved=%p)", 1,
                  (reserved));
   GPR_ASSERT(reserved == nullptr);
-  return grpc_core::MakeRefCounted<
-             grpc_compute_engine_token_fetcher_credentials>()
+  return get_or_create_shared_token_fetcher_credentials(
+             "Oauth2/compute_engine",
+             []() {
+               return grpc_core::MakeRefCounted<
+                   grpc_compute_engine_token_fetcher_credentials>();
+             })
       .release();
 }
 
@@ -466,8 +559,19 @@ grpc_refresh_token_credentials_create_from_auth_refresh_token(
     gpr_log(GPR_ERROR, "Invalid input for refresh token credentials creation");
     return nullptr;
   }
-  return grpc_core::MakeRefCounted<grpc_google_refresh_token_credentials>(
-      refresh_token);
+  bool created = false;
+  grpc_core::RefCountedPtr<grpc_call_credentials> creds =
+      get_or_create_shared_token_fetcher_credentials(
+          absl::StrCat("GoogleRefreshToken/", refresh_token.client_id, "/",
+                       refresh_token.refresh_token),
+          [&]() {
+            created = true;
+            return grpc_core::MakeRefCounted<
+                grpc_google_refresh_token_credentials>(refresh_token);
+          });
+  // The credentials own the refresh token only if they were just created.
+  if (!created) grpc_auth_refresh_token_destruct(&refresh_token);
+  return creds;
 }
 
 std::string grpc_google_refresh_token_credentials::debug_string() {
@@ -694,8 +798,25 @@ grpc_call_credentials* grpc_sts_credentials_create(
             sts_url.status().ToString().c_str());
     return nullptr;
   }
-  return grpc_core::MakeRefCounted<grpc_core::StsTokenFetcherCredentials>(
-             std::move(*sts_url), options)
+  auto or_empty = [](const char* field) {
+    return field == nullptr ? "" : field;
+  };
+  std::string registry_key = absl::StrJoin(
+      {"Oauth2/sts", or_empty(options->token_exchange_service_uri),
+       or_empty(options->resource), or_empty(options->audience),
+       or_empty(options->scope), or_empty(options->requested_token_type),
+       or_empty(options->subject_token_path),
+       or_empty(options->subject_token_type),
+       or_empty(options->actor_token_path),
+       or_empty(options->actor_token_type)},
+      "\n");
+  return get_or_create_shared_token_fetcher_credentials(
+             std::move(registry_key),
+             [&]() {
+               return grpc_core::MakeRefCounted<
+                   grpc_core::StsTokenFetcherCredentials>(std::move(*sts_url),
+                                                          options);
+             })
       .release();
 }
 
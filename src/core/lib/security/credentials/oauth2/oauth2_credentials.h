@@ -23,14 +23,20 @@
 
 #include <string>
 
+#include "absl/random/random.h"
+
 #include <grpc/grpc_security.h>
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/http/httpcli.h"
+#include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/security/credentials/credentials.h"
 #include "src/core/lib/uri/uri_parser.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_proactive_token_refresh);
+
 // Constants.
 #define GRPC_STS_POST_MINIMAL_BODY_FORMAT_STRING                               \
   "grant_type=urn:ietf:params:oauth:grant-type:token-exchange&subject_token=%" \
@@ -104,6 +110,12 @@ class grpc_oauth2_token_fetcher_credentials : public grpc_call_credentials {
 
   const char* type() const override;
 
+  // Sets the key these credentials are registered under in the
+  // grpc_core::CallCredentialsRegistry, to unregister on destruction.
+  void set_registry_key(std::string registry_key) {
+    registry_key_ = std::move(registry_key);
+  }
+
  protected:
   virtual void fetch_oauth2(grpc_credentials_metadata_request* req,
                             grpc_polling_entity* pollent, grpc_iomgr_cb_func cb,
@@ -116,12 +128,29 @@ class grpc_oauth2_token_fetcher_credentials : public grpc_call_credentials {
         static_cast<const grpc_call_credentials*>(this), other);
   }
 
+  // Schedules the background refresh of a token that was just fetched, if
+  // enabled.
+  void MaybeScheduleRefreshLocked(grpc_core::Duration token_lifetime);
+  static void OnRefreshTimer(void* arg, grpc_error_handle error);
+
   gpr_mu mu_;
   absl::optional<grpc_core::Slice> access_token_value_;
   gpr_timespec token_expiration_;
   bool token_fetch_pending_ = false;
   grpc_oauth2_pending_get_request_metadata* pending_requests_ = nullptr;
   grpc_polling_entity pollent_;
+  std::string registry_key_;
+  // Background refresh, guarded by mu_.
+  const bool proactive_refresh_;
+  // Whether the token was used since it was fetched. Unused tokens are not
+  // refreshed, so that idle credentials stop refreshing and can go away.
+  bool token_used_ = false;
+  bool refresh_timer_pending_ = false;
+  // Whether the pending fetch is a background refresh.
+  bool refreshing_in_background_ = false;
+  grpc_timer refresh_timer_;
+  grpc_closure on_refresh_timer_;
+  absl::BitGen bit_gen_;
 };
 
 // Google refresh token credentials.
@@ -57,6 +57,7 @@ grpc_ssl_credentials::create_security_connector(
     grpc_channel_args** new_args) {
   const char* overridden_target_name = nullptr;
   tsi_ssl_session_cache* ssl_session_cache = nullptr;
+  bool enable_kernel_tls_tx = false;
   for (size_t i = 0; args && i < args->num_args; i++) {
     grpc_arg* arg = &args->args[i];
     if (strcmp(arg->key, GRPC_SSL_TARGET_NAME_OVERRIDE_ARG) == 0 &&
@@ -68,11 +69,14 @@ grpc_ssl_credentials::create_security_connector(
       ssl_session_cache =
           static_cast<tsi_ssl_session_cache*>(arg->value.pointer.p);
     }
+    if (strcmp(arg->key, GRPC_ARG_SSL_KERNEL_TLS_TX) == 0) {
+      enable_kernel_tls_tx = grpc_channel_arg_get_bool(arg, false);
+    }
   }
   grpc_core::RefCountedPtr<grpc_channel_security_connector> sc =
       grpc_ssl_channel_security_connector_create(
           this->Ref(), std::move(call_creds), &config_, target,
-          overridden_target_name, ssl_session_cache);
+          overridden_target_name, ssl_session_cache, enable_kernel_tls_tx);
   if (sc == nullptr) {
     return sc;
   }
@@ -182,8 +186,10 @@ grpc_ssl_server_credentials::~grpc_ssl_server_credentials() {
 }
 grpc_core::RefCountedPtr<grpc_server_security_connector>
 grpc_ssl_server_credentials::create_security_connector(
-    const grpc_channel_args* /* args */) {
-  return grpc_ssl_server_security_connector_create(this->Ref());
+    const grpc_channel_args* args) {
+  return grpc_ssl_server_security_connector_create(
+      this->Ref(),
+      grpc_channel_args_find_bool(args, GRPC_ARG_SSL_KERNEL_TLS_TX, false));
 }
 
 const char* grpc_ssl_server_credentials::Type() { return "Ssl"; }
@@ -92,6 +92,78 @@ gpr_timespec TimeoutSecondsToDeadline(int64_t seconds) {
                       gpr_time_from_seconds(seconds, GPR_TIMESPAN));
 }
 
+// The contents of the files watched by FileWatcherCertificateProviders, so
+// that providers watching the same files read each version of them once. A
+// file's contents are kept while a provider watches it.
+class WatchedFiles {
+ public:
+  static WatchedFiles* Get() {
+    static WatchedFiles* watched_files = new WatchedFiles();
+    return watched_files;
+  }
+
+  void Watch(const std::string& path) {
+    if (path.empty()) return;
+    MutexLock lock(&mu_);
+    ++files_[path].watchers;
+  }
+
+  void Unwatch(const std::string& path) {
+    if (path.empty()) return;
+    MutexLock lock(&mu_);
+    auto it = files_.find(path);
+    GPR_ASSERT(it != files_.end());
+    if (--it->second.watchers == 0) files_.erase(it);
+  }
+
+  // Reads the file, unless its current version was already read.
+  grpc_error_handle Read(const std::string& path, std::string* contents) {
+    FileVersion version;
+    const bool has_version = GetFileVersion(path.c_str(), &version).ok();
+    if (has_version) {
+      MutexLock lock(&mu_);
+      auto it = files_.find(path);
+      if (it != files_.end() && it->second.version == version) {
+        *contents = it->second.contents;
+        return GRPC_ERROR_NONE;
+      }
+    }
+    grpc_slice slice = grpc_empty_slice();
+    grpc_error_handle error = grpc_load_file(path.c_str(), 0, &slice);
+    if (error != GRPC_ERROR_NONE) return error;
+    *contents = std::string(StringViewFromSlice(slice));
+    grpc_slice_unref_internal(slice);
+    // The file may have changed since it was stat'ed, in which case the
+    // cached contents are newer than their version. That only costs another
+    // read once the new version is seen.
+    if (has_version) {
+      MutexLock lock(&mu_);
+      auto it = files_.find(path);
+      if (it != files_.end()) {
+        it->second.version = version;
+        it->second.contents = *contents;
+      }
+    }
+    return GRPC_ERROR_NONE;
+  }
+
+ private:
+  struct File {
+    int watchers = 0;
+    absl::optional<FileVersion> version;
+    std::string contents;
+  };
+
+  Mutex mu_;
+  std::map<std::string, File> files_ ABSL_GUARDED_BY(mu_);
+};
+
+// Whether a file is known to be at the version it was last read at.
+bool IsUnchanged(const absl::optional<FileVersion>& current,
+                 const absl::optional<FileVersion>& read) {
+  return current.has_value() && read.has_value() && *current == *read;
+}
+
 }  // namespace
 
 FileWatcherCertificateProvider::FileWatcherCertificateProvider(
@@ -107,6 +179,10 @@ FileWatcherCertificateProvider::FileWatcherCertificateProvider(
   // Must be watching either root or identity certs.
   GPR_ASSERT(!private_key_path_.empty() || !root_cert_path_.empty());
   gpr_event_init(&shutdown_event_);
+  for (const std::string* path :
+       {&private_key_path_, &identity_certificate_path_, &root_cert_path_}) {
+    WatchedFiles::Get()->Watch(*path);
+  }
   ForceUpdate();
   auto thread_lambda = [](void* arg) {
     FileWatcherCertificateProvider* provider =
@@ -119,7 +195,7 @@ FileWatcherCertificateProvider::FileWatcherCertificateProvider(
       if (value != nullptr) {
         return;
       };
-      provider->ForceUpdate();
+      provider->UpdateIfChanged();
     }
   };
   refresh_thread_ = Thread("FileWatcherCertificateProvider_refreshing_thread",
@@ -175,18 +251,60 @@ FileWatcherCertificateProvider::~FileWatcherCertificateProvider() {
   distributor_->SetWatchStatusCallback(nullptr);
   gpr_event_set(&shutdown_event_, reinterpret_cast<void*>(1));
   refresh_thread_.Join();
+  for (const std::string* path :
+       {&private_key_path_, &identity_certificate_path_, &root_cert_path_}) {
+    WatchedFiles::Get()->Unwatch(*path);
+  }
+}
+
+FileWatcherCertificateProvider::FileVersions
+FileWatcherCertificateProvider::GetFileVersions() const {
+  FileVersions versions;
+  auto get_version = [](const std::string& path,
+                        absl::optional<FileVersion>* version) {
+    if (path.empty()) return;
+    FileVersion v;
+    if (GetFileVersion(path.c_str(), &v).ok()) *version = v;
+  };
+  get_version(root_cert_path_, &versions.root_cert);
+  get_version(private_key_path_, &versions.private_key);
+  get_version(identity_certificate_path_, &versions.identity_certificate);
+  return versions;
+}
+
+void FileWatcherCertificateProvider::UpdateIfChanged() {
+  const FileVersions versions = GetFileVersions();
+  const bool root_unchanged =
+      root_cert_path_.empty() ||
+      IsUnchanged(versions.root_cert, read_versions_.root_cert);
+  const bool identity_unchanged =
+      private_key_path_.empty() ||
+      (IsUnchanged(versions.private_key, read_versions_.private_key) &&
+       IsUnchanged(versions.identity_certificate,
+                   read_versions_.identity_certificate));
+  if (root_unchanged && identity_unchanged) return;
+  ForceUpdate();
 }
 
 void FileWatcherCertificateProvider::ForceUpdate() {
+  // Taken before reading, so that changes made while reading are seen on the
+  // next refresh.
+  FileVersions versions = GetFileVersions();
   absl::optional<std::string> root_certificate;
   absl::optional<PemKeyCertPairList> pem_key_cert_pairs;
   if (!root_cert_path_.empty()) {
     root_certificate = ReadRootCertificatesFromFile(root_cert_path_);
+    if (!root_certificate.has_value()) versions.root_cert.reset();
   }
   if (!private_key_path_.empty()) {
     pem_key_cert_pairs = ReadIdentityKeyCertPairFromFiles(
         private_key_path_, identity_certificate_path_);
+    if (!pem_key_cert_pairs.has_value()) {
+      versions.private_key.reset();
+      versions.identity_certificate.reset();
+    }
   }
+  read_versions_ = versions;
   MutexLock lock(&mu_);
   const bool root_cert_changed =
       (!root_certificate.has_value() && !root_certificate_.empty()) ||
@@ -257,9 +375,9 @@ absl::optional<std::string>
 FileWatcherCertificateProvider::ReadRootCertificatesFromFile(
     const std::string& root_cert_full_path) {
   // Read the root file.
-  grpc_slice root_slice = grpc_empty_slice();
+  std::string root_cert;
   grpc_error_handle root_error =
-      grpc_load_file(root_cert_full_path.c_str(), 0, &root_slice);
+      WatchedFiles::Get()->Read(root_cert_full_path, &root_cert);
   if (root_error != GRPC_ERROR_NONE) {
     gpr_log(GPR_ERROR, "Reading file %s failed: %s",
             root_cert_full_path.c_str(),
@@ -267,8 +385,6 @@ FileWatcherCertificateProvider::ReadRootCertificatesFromFile(
     GRPC_ERROR_UNREF(root_error);
     return absl::nullopt;
   }
-  std::string root_cert(StringViewFromSlice(root_slice));
-  grpc_slice_unref_internal(root_slice);
   return root_cert;
 }
 
@@ -288,10 +404,6 @@ absl::optional<PemKeyCertPairList>
 FileWatcherCertificateProvider::ReadIdentityKeyCertPairFromFiles(
     const std::string& private_key_path,
     const std::string& identity_certificate_path) {
-  struct SliceWrapper {
-    grpc_slice slice = grpc_empty_slice();
-    ~SliceWrapper() { grpc_slice_unref_internal(slice); }
-  };
   const int kNumRetryAttempts = 3;
   for (int i = 0; i < kNumRetryAttempts; ++i) {
     // TODO(ZhenLian): replace the timestamp approach with key-match approach
@@ -316,9 +428,10 @@ FileWatcherCertificateProvider::ReadIdentityKeyCertPairFromFiles(
       continue;
     }
     // Read the identity files.
-    SliceWrapper key_slice, cert_slice;
+    std::string private_key;
+    std::string cert_chain;
     grpc_error_handle key_error =
-        grpc_load_file(private_key_path.c_str(), 0, &key_slice.slice);
+        WatchedFiles::Get()->Read(private_key_path, &private_key);
     if (key_error != GRPC_ERROR_NONE) {
       gpr_log(GPR_ERROR, "Reading file %s failed: %s. Start retrying...",
               private_key_path.c_str(),
@@ -327,7 +440,7 @@ FileWatcherCertificateProvider::ReadIdentityKeyCertPairFromFiles(
       continue;
     }
     grpc_error_handle cert_error =
-        grpc_load_file(identity_certificate_path.c_str(), 0, &cert_slice.slice);
+        WatchedFiles::Get()->Read(identity_certificate_path, &cert_chain);
     if (cert_error != GRPC_ERROR_NONE) {
       gpr_log(GPR_ERROR, "Reading file %s failed: %s. Start retrying...",
               identity_certificate_path.c_str(),
@@ -335,8 +448,6 @@ FileWatcherCertificateProvider::ReadIdentityKeyCertPairFromFiles(
       GRPC_ERROR_UNREF(cert_error);
       continue;
     }
-    std::string private_key(StringViewFromSlice(key_slice.slice));
-    std::string cert_chain(StringViewFromSlice(cert_slice.slice));
     PemKeyCertPairList identity_pairs;
     identity_pairs.emplace_back(private_key, cert_chain);
     // Checking the last modification of identity files before reading.
@@ -23,12 +23,14 @@
 
 #include "absl/container/inlined_vector.h"
 #include "absl/status/statusor.h"
+#include "absl/types/optional.h"
 
 #include <grpc/grpc_security.h>
 
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/stat.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/load_file.h"
 #include "src/core/lib/iomgr/pollset_set.h"
@@ -152,8 +154,20 @@ class FileWatcherCertificateProvider final
                         other);
   }
 
+  // Versions of the watched files. Unset for files that are not watched or
+  // whose version is unknown.
+  struct FileVersions {
+    absl::optional<FileVersion> root_cert;
+    absl::optional<FileVersion> private_key;
+    absl::optional<FileVersion> identity_certificate;
+  };
+
   // Force an update from the file system regardless of the interval.
   void ForceUpdate();
+  // Updates from the file system unless the watched files are known to be
+  // unchanged since they were last read.
+  void UpdateIfChanged();
+  FileVersions GetFileVersions() const;
   // Read the root certificates from files and update the distributor.
   absl::optional<std::string> ReadRootCertificatesFromFile(
       const std::string& root_cert_full_path);
@@ -172,6 +186,9 @@ class FileWatcherCertificateProvider final
   RefCountedPtr<grpc_tls_certificate_distributor> distributor_;
   Thread refresh_thread_;
   gpr_event shutdown_event_;
+  // Versions of the files as of their last successful read. Only used by
+  // ForceUpdate() and UpdateIfChanged(), which do not run concurrently.
+  FileVersions read_versions_;
 
   // Guards members below.
   Mutex mu_;
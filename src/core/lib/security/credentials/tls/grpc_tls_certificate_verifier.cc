@@ -18,12 +18,15 @@
 
 #include "src/core/lib/security/credentials/tls/grpc_tls_certificate_verifier.h"
 
+#include <openssl/sha.h>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
 #include "src/core/lib/gprpp/host_port.h"
 #include "src/core/lib/gprpp/stat.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/security/credentials/tls/tls_utils.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/surface/api_trace.h"
@@ -152,6 +155,72 @@ bool HostNameCertificateVerifier::Verify(
   return true;  // synchronous check
 }
 
+//
+// CertificateVerificationCache
+//
+
+constexpr size_t CertificateVerificationCache::kMaxEntries;
+
+std::string CertificateVerificationCache::Key(
+    const grpc_tls_custom_verification_check_request* request) {
+  const char* chain = request->peer_info.peer_cert_full_chain != nullptr
+                          ? request->peer_info.peer_cert_full_chain
+                          : request->peer_info.peer_cert;
+  if (chain == nullptr) return "";
+  unsigned char digest[SHA256_DIGEST_LENGTH];
+  SHA256(reinterpret_cast<const unsigned char*>(chain), strlen(chain), digest);
+  // The digest has a fixed size, so the target name can simply follow it.
+  std::string key(reinterpret_cast<const char*>(digest), sizeof(digest));
+  if (request->target_name != nullptr) key.append(request->target_name);
+  return key;
+}
+
+bool CertificateVerificationCache::Lookup(
+    const grpc_tls_custom_verification_check_request* request,
+    uint64_t* generation) {
+  std::string key = Key(request);
+  MutexLock lock(&mu_);
+  *generation = generation_;
+  if (key.empty()) return false;
+  auto it = expiration_by_key_.find(key);
+  if (it == expiration_by_key_.end()) return false;
+  if (it->second <= ExecCtx::Get()->Now()) {
+    expiration_by_key_.erase(it);
+    return false;
+  }
+  return true;
+}
+
+void CertificateVerificationCache::Insert(
+    const grpc_tls_custom_verification_check_request* request,
+    uint64_t generation) {
+  std::string key = Key(request);
+  if (key.empty()) return;
+  const Timestamp now = ExecCtx::Get()->Now();
+  MutexLock lock(&mu_);
+  // Results verified against replaced root certificates are stale.
+  if (generation != generation_) return;
+  if (expiration_by_key_.size() >= kMaxEntries) {
+    // Make room by dropping expired results, or everything if none expired.
+    for (auto it = expiration_by_key_.begin();
+         it != expiration_by_key_.end();) {
+      if (it->second <= now) {
+        it = expiration_by_key_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (expiration_by_key_.size() >= kMaxEntries) expiration_by_key_.clear();
+  }
+  expiration_by_key_[std::move(key)] = now + ttl_;
+}
+
+void CertificateVerificationCache::Clear() {
+  MutexLock lock(&mu_);
+  ++generation_;
+  expiration_by_key_.clear();
+}
+
 }  // namespace grpc_core
 
 //
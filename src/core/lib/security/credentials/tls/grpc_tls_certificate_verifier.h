@@ -21,6 +21,9 @@
 
 #include <string.h>
 
+#include <map>
+#include <string>
+
 #include "absl/status/status.h"
 
 #include <grpc/grpc_security.h>
@@ -28,7 +31,9 @@
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/load_file.h"
 #include "src/core/lib/iomgr/pollset_set.h"
 #include "src/core/lib/security/credentials/tls/grpc_tls_certificate_distributor.h"
@@ -163,6 +168,44 @@ class HostNameCertificateVerifier : public grpc_tls_certificate_verifier {
   }
 };
 
+// Caches successful results of a verifier, keyed by the SHA-256 fingerprint
+// of the certificate chain the peer presented and the target name, so that
+// handshakes with a peer that was recently verified skip the verifier.
+// Results are dropped when they expire, and all at once by Clear() when the
+// root certificates change.
+class CertificateVerificationCache
+    : public RefCounted<CertificateVerificationCache> {
+ public:
+  // Upper bound on the number of cached results.
+  static constexpr size_t kMaxEntries = 4096;
+
+  explicit CertificateVerificationCache(Duration ttl) : ttl_(ttl) {}
+
+  Duration ttl() const { return ttl_; }
+
+  // Returns true if \a request has a cached successful result. Otherwise
+  // returns false and sets \a generation, which must then be passed to
+  // Insert() once \a request is verified.
+  bool Lookup(const grpc_tls_custom_verification_check_request* request,
+              uint64_t* generation);
+  // Caches the successful verification of \a request, unless the cache was
+  // cleared since the Lookup() that returned \a generation.
+  void Insert(const grpc_tls_custom_verification_check_request* request,
+              uint64_t generation);
+  // Drops all cached results.
+  void Clear();
+
+ private:
+  // Returns an empty key if the peer presented no certificate.
+  static std::string Key(
+      const grpc_tls_custom_verification_check_request* request);
+
+  const Duration ttl_;
+  Mutex mu_;
+  uint64_t generation_ ABSL_GUARDED_BY(mu_) = 0;
+  std::map<std::string, Timestamp> expiration_by_key_ ABSL_GUARDED_BY(mu_);
+};
+
 }  // namespace grpc_core
 
 #endif  // GRPC_CORE_LIB_SECURITY_CREDENTIALS_TLS_GRPC_TLS_CERTIFICATE_VERIFIER_H
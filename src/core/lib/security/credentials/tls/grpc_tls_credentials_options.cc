@@ -91,12 +91,34 @@ void grpc_tls_credentials_options_set_certificate_verifier(
   options->set_certificate_verifier(verifier->Ref());
 }
 
+void grpc_tls_credentials_options_set_verification_cache_ttl(
+    grpc_tls_credentials_options* options, int ttl_ms) {
+  GPR_ASSERT(options != nullptr);
+  if (ttl_ms <= 0) {
+    options->set_verification_cache(nullptr);
+    return;
+  }
+  options->set_verification_cache(
+      grpc_core::MakeRefCounted<grpc_core::CertificateVerificationCache>(
+          grpc_core::Duration::Milliseconds(ttl_ms)));
+}
+
 void grpc_tls_credentials_options_set_crl_directory(
     grpc_tls_credentials_options* options, const char* crl_directory) {
   GPR_ASSERT(options != nullptr);
   options->set_crl_directory(crl_directory);
 }
 
+void grpc_tls_credentials_options_set_private_key_signer(
+    grpc_tls_credentials_options* options,
+    const grpc_tls_private_key_signer* signer) {
+  GPR_ASSERT(options != nullptr);
+  GPR_ASSERT(signer != nullptr);
+  GPR_ASSERT(signer->sign != nullptr);
+  options->set_private_key_signer(
+      grpc_core::MakeRefCounted<tsi::SslPrivateKeySigner>(*signer));
+}
+
 void grpc_tls_credentials_options_set_check_call_host(
     grpc_tls_credentials_options* options, int check_call_host) {
   GPR_ASSERT(options != nullptr);
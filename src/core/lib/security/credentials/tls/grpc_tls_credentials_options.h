@@ -61,6 +61,12 @@ struct grpc_tls_credentials_options
   const std::string& identity_cert_name() const { return identity_cert_name_; }
   const std::string& tls_session_key_log_file_path() const { return tls_session_key_log_file_path_; }
   const std::string& crl_directory() const { return crl_directory_; }
+  tsi::SslPrivateKeySigner* private_key_signer() {
+    return private_key_signer_.get();
+  }
+  grpc_core::CertificateVerificationCache* verification_cache() {
+    return verification_cache_.get();
+  }
 
   // Setters for member fields.
   void set_cert_request_type(grpc_ssl_client_certificate_request_type cert_request_type) { cert_request_type_ = cert_request_type; }
@@ -81,6 +87,10 @@ struct grpc_tls_credentials_options
   void set_tls_session_key_log_file_path(std::string tls_session_key_log_file_path) { tls_session_key_log_file_path_ = std::move(tls_session_key_log_file_path); }
   //  gRPC will enforce CRLs on all handshakes from all hashed CRL files inside of the crl_directory. If not set, an empty string will be used, which will not enable CRL checking. Only supported for OpenSSL version > 1.1.
   void set_crl_directory(std::string crl_directory) { crl_directory_ = std::move(crl_directory); }
+  // If set, handshakes sign with the private_key_signer instead of the private key of the identity key-cert pair. Only supported with BoringSSL.
+  void set_private_key_signer(grpc_core::RefCountedPtr<tsi::SslPrivateKeySigner> private_key_signer) { private_key_signer_ = std::move(private_key_signer); }
+  // If set, successful results of the certificate verifier are cached and shared by all handshakes using these options.
+  void set_verification_cache(grpc_core::RefCountedPtr<grpc_core::CertificateVerificationCache> verification_cache) { verification_cache_ = std::move(verification_cache); }
 
   bool operator==(const grpc_tls_credentials_options& other) const {
     return cert_request_type_ == other.cert_request_type_ &&
@@ -95,7 +105,9 @@ struct grpc_tls_credentials_options
       watch_identity_pair_ == other.watch_identity_pair_ &&
       identity_cert_name_ == other.identity_cert_name_ &&
       tls_session_key_log_file_path_ == other.tls_session_key_log_file_path_ &&
-      crl_directory_ == other.crl_directory_;
+      crl_directory_ == other.crl_directory_ &&
+      private_key_signer_ == other.private_key_signer_ &&
+      (verification_cache_ == other.verification_cache_ || (verification_cache_ != nullptr && other.verification_cache_ != nullptr && verification_cache_->ttl() == other.verification_cache_->ttl()));
   }
 
  private:
@@ -112,6 +124,8 @@ struct grpc_tls_credentials_options
   std::string identity_cert_name_;
   std::string tls_session_key_log_file_path_;
   std::string crl_directory_;
+  grpc_core::RefCountedPtr<tsi::SslPrivateKeySigner> private_key_signer_;
+  grpc_core::RefCountedPtr<grpc_core::CertificateVerificationCache> verification_cache_;
 };
 
 #endif  // GRPC_CORE_LIB_SECURITY_CREDENTIALS_TLS_GRPC_TLS_CREDENTIALS_OPTIONS_H
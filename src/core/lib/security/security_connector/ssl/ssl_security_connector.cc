@@ -90,7 +90,7 @@ class grpc_ssl_channel_security_connector final
   grpc_security_status InitializeHandshakerFactory(
       const grpc_ssl_config* config, const char* pem_root_certs,
       const tsi_ssl_root_certs_store* root_store,
-      tsi_ssl_session_cache* ssl_session_cache) {
+      tsi_ssl_session_cache* ssl_session_cache, bool enable_kernel_tls_tx) {
     bool has_key_cert_pair =
         config->pem_key_cert_pair != nullptr &&
         config->pem_key_cert_pair->private_key != nullptr &&
@@ -108,6 +108,7 @@ class grpc_ssl_channel_security_connector final
     options.session_cache = ssl_session_cache;
     options.min_tls_version = grpc_get_tsi_tls_version(config->min_tls_version);
     options.max_tls_version = grpc_get_tsi_tls_version(config->max_tls_version);
+    options.enable_kernel_tls_tx = enable_kernel_tls_tx;
     const tsi_result result =
         tsi_create_ssl_client_handshaker_factory_with_options(
             &options, &client_handshaker_factory_);
@@ -204,10 +205,12 @@ class grpc_ssl_channel_security_connector final
 class grpc_ssl_server_security_connector
     : public grpc_server_security_connector {
  public:
-  explicit grpc_ssl_server_security_connector(
-      grpc_core::RefCountedPtr<grpc_server_credentials> server_creds)
+  grpc_ssl_server_security_connector(
+      grpc_core::RefCountedPtr<grpc_server_credentials> server_creds,
+      bool enable_kernel_tls_tx)
       : grpc_server_security_connector(GRPC_SSL_URL_SCHEME,
-                                       std::move(server_creds)) {}
+                                       std::move(server_creds)),
+        enable_kernel_tls_tx_(enable_kernel_tls_tx) {}
 
   ~grpc_ssl_server_security_connector() override {
     tsi_ssl_server_handshaker_factory_unref(server_handshaker_factory_);
@@ -253,6 +256,7 @@ class grpc_ssl_server_security_connector
           server_credentials->config().min_tls_version);
       options.max_tls_version = grpc_get_tsi_tls_version(
           server_credentials->config().max_tls_version);
+      options.enable_kernel_tls_tx = enable_kernel_tls_tx_;
       const tsi_result result =
           tsi_create_ssl_server_handshaker_factory_with_options(
               &options, &server_handshaker_factory_);
@@ -367,6 +371,7 @@ class grpc_ssl_server_security_connector
     options.cipher_suites = grpc_get_ssl_cipher_suites();
     options.alpn_protocols = alpn_protocol_strings;
     options.num_alpn_protocols = static_cast<uint16_t>(num_alpn_protocols);
+    options.enable_kernel_tls_tx = enable_kernel_tls_tx_;
     tsi_result result = tsi_create_ssl_server_handshaker_factory_with_options(
         &options, &new_handshaker_factory);
     grpc_tsi_ssl_pem_key_cert_pairs_destroy(
@@ -391,6 +396,7 @@ class grpc_ssl_server_security_connector
     server_handshaker_factory_ = new_factory;
   }
 
+  const bool enable_kernel_tls_tx_;
   grpc_core::Mutex mu_;
   tsi_ssl_server_handshaker_factory* server_handshaker_factory_ = nullptr;
 };
@@ -402,7 +408,7 @@ grpc_ssl_channel_security_connector_create(
     grpc_core::RefCountedPtr<grpc_call_credentials> request_metadata_creds,
     const grpc_ssl_config* config, const char* target_name,
     const char* overridden_target_name,
-    tsi_ssl_session_cache* ssl_session_cache) {
+    tsi_ssl_session_cache* ssl_session_cache, bool enable_kernel_tls_tx) {
   if (config == nullptr || target_name == nullptr) {
     gpr_log(GPR_ERROR, "An ssl channel needs a config and a target name.");
     return nullptr;
@@ -410,14 +416,18 @@ grpc_ssl_channel_security_connector_create(
 
   const char* pem_root_certs;
   const tsi_ssl_root_certs_store* root_store;
+  // Keeps the default roots alive until the factory has taken what it needs.
+  grpc_core::RefCountedPtr<grpc_core::DefaultSslRootStore::Roots>
+      default_roots;
   if (config->pem_root_certs == nullptr) {
     // Use default root certificates.
-    pem_root_certs = grpc_core::DefaultSslRootStore::GetPemRootCerts();
+    default_roots = grpc_core::DefaultSslRootStore::Get();
+    pem_root_certs = default_roots->pem_root_certs();
     if (pem_root_certs == nullptr) {
       gpr_log(GPR_ERROR, "Could not get default pem root certs.");
       return nullptr;
     }
-    root_store = grpc_core::DefaultSslRootStore::GetRootStore();
+    root_store = default_roots->root_store();
   } else {
     pem_root_certs = config->pem_root_certs;
     root_store = nullptr;
@@ -428,7 +438,8 @@ grpc_ssl_channel_security_connector_create(
           std::move(channel_creds), std::move(request_metadata_creds), config,
           target_name, overridden_target_name);
   const grpc_security_status result = c->InitializeHandshakerFactory(
-      config, pem_root_certs, root_store, ssl_session_cache);
+      config, pem_root_certs, root_store, ssl_session_cache,
+      enable_kernel_tls_tx);
   if (result != GRPC_SECURITY_OK) {
     return nullptr;
   }
@@ -437,11 +448,12 @@ grpc_ssl_channel_security_connector_create(
 
 grpc_core::RefCountedPtr<grpc_server_security_connector>
 grpc_ssl_server_security_connector_create(
-    grpc_core::RefCountedPtr<grpc_server_credentials> server_credentials) {
+    grpc_core::RefCountedPtr<grpc_server_credentials> server_credentials,
+    bool enable_kernel_tls_tx) {
   GPR_ASSERT(server_credentials != nullptr);
   grpc_core::RefCountedPtr<grpc_ssl_server_security_connector> c =
       grpc_core::MakeRefCounted<grpc_ssl_server_security_connector>(
-          std::move(server_credentials));
+          std::move(server_credentials), enable_kernel_tls_tx);
   const grpc_security_status retval = c->InitializeHandshakerFactory();
   if (retval != GRPC_SECURITY_OK) {
     return nullptr;
@@ -45,6 +45,8 @@ struct grpc_ssl_config {
      grpc_channel_security_connector_check_peer. This parameter may be NULL in
      which case the peer name will not be checked. Note that if this parameter
      is not NULL, then, pem_root_certs should not be NULL either.
+   - enable_kernel_tls_tx lets connections move TLS encryption of writes to
+     the kernel (see GRPC_ARG_SSL_KERNEL_TLS_TX).
    - sc is a pointer on the connector to be created.
   This function returns GRPC_SECURITY_OK in case of success or a
   specific error code otherwise.
@@ -55,7 +57,8 @@ grpc_ssl_channel_security_connector_create(
     grpc_core::RefCountedPtr<grpc_call_credentials> request_metadata_creds,
     const grpc_ssl_config* config, const char* target_name,
     const char* overridden_target_name,
-    tsi_ssl_session_cache* ssl_session_cache);
+    tsi_ssl_session_cache* ssl_session_cache,
+    bool enable_kernel_tls_tx = false);
 
 /* Config for ssl servers. */
 struct grpc_ssl_server_config {
@@ -69,13 +72,15 @@ struct grpc_ssl_server_config {
 };
 /* Creates an SSL server_security_connector.
    - config is the SSL config to be used for the SSL channel establishment.
+   - enable_kernel_tls_tx is the same as for channel security connectors.
    - sc is a pointer on the connector to be created.
   This function returns GRPC_SECURITY_OK in case of success or a
   specific error code otherwise.
 */
 grpc_core::RefCountedPtr<grpc_server_security_connector>
 grpc_ssl_server_security_connector_create(
-    grpc_core::RefCountedPtr<grpc_server_credentials> server_credentials);
+    grpc_core::RefCountedPtr<grpc_server_credentials> server_credentials,
+    bool enable_kernel_tls_tx = false);
 
 #endif /* GRPC_CORE_LIB_SECURITY_SECURITY_CONNECTOR_SSL_SSL_SECURITY_CONNECTOR_H \
         */
@@ -22,21 +22,28 @@
 
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/strings/str_cat.h"
 
 #include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
 
 #include "src/core/ext/transport/chttp2/alpn/alpn.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/host_port.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/load_file.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
 #include "src/core/lib/security/context/security_context.h"
 #include "src/core/lib/security/security_connector/load_system_roots.h"
 #include "src/core/lib/security/security_connector/ssl_utils_config.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
 #include "src/core/tsi/ssl_transport_security.h"
 
 /* -- Constants. -- */
@@ -414,21 +421,25 @@ grpc_security_status grpc_ssl_tsi_client_handshaker_factory_init(
     bool skip_server_certificate_verification, tsi_tls_version min_tls_version,
     tsi_tls_version max_tls_version, tsi_ssl_session_cache* ssl_session_cache,
     tsi::TlsSessionKeyLoggerCache::TlsSessionKeyLogger* tls_session_key_logger,
-    const char* crl_directory,
+    const char* crl_directory, tsi::SslPrivateKeySigner* private_key_signer,
     tsi_ssl_client_handshaker_factory** handshaker_factory) {
   const char* root_certs;
   const tsi_ssl_root_certs_store* root_store;
+  // Keeps the default roots alive until the factory has taken what it needs.
+  grpc_core::RefCountedPtr<grpc_core::DefaultSslRootStore::Roots>
+      default_roots;
   if (pem_root_certs == nullptr) {
     gpr_log(GPR_INFO,
             "No root certificates specified; use ones stored in system default "
             "locations instead");
     // Use default root certificates.
-    root_certs = grpc_core::DefaultSslRootStore::GetPemRootCerts();
+    default_roots = grpc_core::DefaultSslRootStore::Get();
+    root_certs = default_roots->pem_root_certs();
     if (root_certs == nullptr) {
       gpr_log(GPR_ERROR, "Could not get default pem root certs.");
       return GRPC_SECURITY_ERROR;
     }
-    root_store = grpc_core::DefaultSslRootStore::GetRootStore();
+    root_store = default_roots->root_store();
   } else {
     root_certs = pem_root_certs;
     root_store = nullptr;
@@ -453,6 +464,7 @@ grpc_security_status grpc_ssl_tsi_client_handshaker_factory_init(
   options.min_tls_version = min_tls_version;
   options.max_tls_version = max_tls_version;
   options.crl_directory = crl_directory;
+  options.private_key_signer = private_key_signer;
   const tsi_result result =
       tsi_create_ssl_client_handshaker_factory_with_options(&options,
                                                             handshaker_factory);
@@ -471,7 +483,7 @@ grpc_security_status grpc_ssl_tsi_server_handshaker_factory_init(
     grpc_ssl_client_certificate_request_type client_certificate_request,
     tsi_tls_version min_tls_version, tsi_tls_version max_tls_version,
     tsi::TlsSessionKeyLoggerCache::TlsSessionKeyLogger* tls_session_key_logger,
-    const char* crl_directory,
+    const char* crl_directory, tsi::SslPrivateKeySigner* private_key_signer,
     tsi_ssl_server_handshaker_factory** handshaker_factory) {
   size_t num_alpn_protocols = 0;
   const char** alpn_protocol_strings =
@@ -489,6 +501,7 @@ grpc_security_status grpc_ssl_tsi_server_handshaker_factory_init(
   options.max_tls_version = max_tls_version;
   options.key_logger = tls_session_key_logger;
   options.crl_directory = crl_directory;
+  options.private_key_signer = private_key_signer;
   const tsi_result result =
       tsi_create_ssl_server_handshaker_factory_with_options(&options,
                                                             handshaker_factory);
@@ -504,11 +517,17 @@ grpc_security_status grpc_ssl_tsi_server_handshaker_factory_init(
 /* --- Ssl cache implementation. --- */
 
 grpc_ssl_session_cache* grpc_ssl_session_cache_create_lru(size_t capacity) {
-  tsi_ssl_session_cache* cache = tsi_ssl_session_cache_create_lru(capacity);
+  grpc_core::ExecCtx exec_ctx;
+  // Charged to the default quota, which drops the sessions under pressure.
+  tsi::SslSessionLRUCache* cache =
+      tsi::SslSessionLRUCache::Create(
+          capacity, grpc_core::ResourceQuota::Default()->memory_quota())
+          .release();
   return reinterpret_cast<grpc_ssl_session_cache*>(cache);
 }
 
 void grpc_ssl_session_cache_destroy(grpc_ssl_session_cache* cache) {
+  grpc_core::ExecCtx exec_ctx;
   tsi_ssl_session_cache* tsi_cache =
       reinterpret_cast<tsi_ssl_session_cache*>(cache);
   tsi_ssl_session_cache_unref(tsi_cache);
@@ -547,20 +566,66 @@ grpc_arg grpc_ssl_session_cache_create_channel_arg(
 
 namespace grpc_core {
 
-tsi_ssl_root_certs_store* DefaultSslRootStore::default_root_store_;
-grpc_slice DefaultSslRootStore::default_pem_root_certs_;
+namespace {
 
-const tsi_ssl_root_certs_store* DefaultSslRootStore::GetRootStore() {
-  InitRootStore();
-  return default_root_store_;
+struct DefaultRoots {
+  Mutex mu;
+  RefCountedPtr<DefaultSslRootStore::Roots> roots ABSL_GUARDED_BY(mu);
+  // When to load the roots again to check them for changes.
+  gpr_timespec next_refresh ABSL_GUARDED_BY(mu);
+};
+
+DefaultRoots* GetDefaultRoots() {
+  static DefaultRoots* default_roots = new DefaultRoots();
+  return default_roots;
+}
+
+}  // namespace
+
+DefaultSslRootStore::Roots::Roots(grpc_slice pem_root_certs)
+    : pem_root_certs_(pem_root_certs) {
+  if (!GRPC_SLICE_IS_EMPTY(pem_root_certs_)) {
+    root_store_ = tsi_ssl_root_certs_store_create(
+        reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(pem_root_certs_)));
+  }
 }
 
-const char* DefaultSslRootStore::GetPemRootCerts() {
-  InitRootStore();
-  return GRPC_SLICE_IS_EMPTY(default_pem_root_certs_)
+DefaultSslRootStore::Roots::~Roots() {
+  if (root_store_ != nullptr) tsi_ssl_root_certs_store_destroy(root_store_);
+  grpc_slice_unref_internal(pem_root_certs_);
+}
+
+const char* DefaultSslRootStore::Roots::pem_root_certs() const {
+  return GRPC_SLICE_IS_EMPTY(pem_root_certs_)
              ? nullptr
-             : reinterpret_cast<const char*>
-                   GRPC_SLICE_START_PTR(default_pem_root_certs_);
+             : reinterpret_cast<const char*>(
+                   GRPC_SLICE_START_PTR(pem_root_certs_));
+}
+
+RefCountedPtr<DefaultSslRootStore::Roots> DefaultSslRootStore::Get() {
+  DefaultRoots* default_roots = GetDefaultRoots();
+  MutexLock lock(&default_roots->mu);
+  const int32_t refresh_interval_seconds =
+      GPR_GLOBAL_CONFIG_GET(grpc_default_ssl_roots_refresh_interval_seconds);
+  const gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  if (default_roots->roots == nullptr) {
+    default_roots->roots = MakeRefCounted<Roots>(ComputePemRootCerts());
+  } else if (refresh_interval_seconds > 0 &&
+             gpr_time_cmp(now, default_roots->next_refresh) >= 0) {
+    // Reading the files is cheap next to parsing the certificates, which
+    // is only done again if they changed.
+    grpc_slice pem_root_certs = ComputePemRootCerts();
+    if (grpc_slice_eq(pem_root_certs, default_roots->roots->pem_root_certs_)) {
+      grpc_slice_unref_internal(pem_root_certs);
+    } else {
+      gpr_log(GPR_INFO, "Default SSL roots changed, reloading them");
+      // Contexts created from the previous roots keep using them.
+      default_roots->roots = MakeRefCounted<Roots>(pem_root_certs);
+    }
+  }
+  default_roots->next_refresh = gpr_time_add(
+      now, gpr_time_from_seconds(refresh_interval_seconds, GPR_TIMESPAN));
+  return default_roots->roots;
 }
 
 grpc_slice DefaultSslRootStore::ComputePemRootCerts() {
@@ -600,18 +665,4 @@ grpc_slice DefaultSslRootStore::ComputePemRootCerts() {
   return result;
 }
 
-void DefaultSslRootStore::InitRootStore() {
-  static gpr_once once = GPR_ONCE_INIT;
-  gpr_once_init(&once, DefaultSslRootStore::InitRootStoreOnce);
-}
-
-void DefaultSslRootStore::InitRootStoreOnce() {
-  default_pem_root_certs_ = ComputePemRootCerts();
-  if (!GRPC_SLICE_IS_EMPTY(default_pem_root_certs_)) {
-    default_root_store_ =
-        tsi_ssl_root_certs_store_create(reinterpret_cast<const char*>(
-            GRPC_SLICE_START_PTR(default_pem_root_certs_)));
-  }
-}
-
 }  // namespace grpc_core
@@ -30,6 +30,7 @@
 #include <grpc/slice_buffer.h>
 
 #include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/security/security_connector/security_connector.h"
@@ -81,7 +82,7 @@ grpc_security_status grpc_ssl_tsi_client_handshaker_factory_init(
     bool skip_server_certificate_verification, tsi_tls_version min_tls_version,
     tsi_tls_version max_tls_version, tsi_ssl_session_cache* ssl_session_cache,
     tsi::TlsSessionKeyLoggerCache::TlsSessionKeyLogger* tls_session_key_logger,
-    const char* crl_directory,
+    const char* crl_directory, tsi::SslPrivateKeySigner* private_key_signer,
     tsi_ssl_client_handshaker_factory** handshaker_factory);
 
 grpc_security_status grpc_ssl_tsi_server_handshaker_factory_init(
@@ -90,7 +91,7 @@ grpc_security_status grpc_ssl_tsi_server_handshaker_factory_init(
     grpc_ssl_client_certificate_request_type client_certificate_request,
     tsi_tls_version min_tls_version, tsi_tls_version max_tls_version,
     tsi::TlsSessionKeyLoggerCache::TlsSessionKeyLogger* tls_session_key_logger,
-    const char* crl_directory,
+    const char* crl_directory, tsi::SslPrivateKeySigner* private_key_signer,
     tsi_ssl_server_handshaker_factory** handshaker_factory);
 
 /* Free the memory occupied by key cert pairs. */
@@ -111,11 +112,31 @@ namespace grpc_core {
 // The class implements default SSL root store.
 class DefaultSslRootStore {
  public:
-  // Gets the default SSL root store. Returns nullptr if not found.
-  static const tsi_ssl_root_certs_store* GetRootStore();
-
-  // Gets the default PEM root certificate.
-  static const char* GetPemRootCerts();
+  // A version of the default roots: the PEM root certificates, and the root
+  // store parsed from them once and shared by all the SSL contexts that use
+  // them.
+  class Roots : public RefCounted<Roots> {
+   public:
+    // Takes ownership of pem_root_certs.
+    explicit Roots(grpc_slice pem_root_certs);
+    ~Roots() override;
+
+    // Returns nullptr if there are no default roots.
+    const char* pem_root_certs() const;
+    // Returns nullptr if there are no default roots.
+    const tsi_ssl_root_certs_store* root_store() const { return root_store_; }
+
+   private:
+    friend class DefaultSslRootStore;
+
+    grpc_slice pem_root_certs_;
+    tsi_ssl_root_certs_store* root_store_ = nullptr;
+  };
+
+  // Gets the default roots, loading them on first use.  After each
+  // grpc_default_ssl_roots_refresh_interval_seconds, the next call loads
+  // them again, and parses them into a new root store if they changed.
+  static RefCountedPtr<Roots> Get();
 
  protected:
   // Returns default PEM root certificates in nullptr terminated grpc_slice.
@@ -125,18 +146,6 @@ class DefaultSslRootStore {
  private:
   // Construct me not!
   DefaultSslRootStore();
-
-  // Initialization of default SSL root store.
-  static void InitRootStore();
-
-  // One-time initialization of default SSL root store.
-  static void InitRootStoreOnce();
-
-  // SSL root store in tsi_ssl_root_certs_store object.
-  static tsi_ssl_root_certs_store* default_root_store_;
-
-  // Default PEM root certificates.
-  static grpc_slice default_pem_root_certs_;
 };
 
 class PemKeyCertPair {
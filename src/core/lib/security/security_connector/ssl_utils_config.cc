@@ -30,3 +30,11 @@ GPR_GLOBAL_CONFIG_DEFINE_STRING(grpc_default_ssl_roots_file_path, "",
     certificates from the OS trust store. */
 GPR_GLOBAL_CONFIG_DEFINE_BOOL(grpc_not_use_system_ssl_roots, false,
                               "Disable loading system root certificates.");
+
+/** Config variable that sets how often, in seconds, the default SSL roots
+    are loaded again to pick up changes to the files they come from. Zero
+    loads them once per process. */
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_default_ssl_roots_refresh_interval_seconds, 60,
+    "How often, in seconds, to check the default SSL roots for changes. "
+    "0 disables the checks.");
@@ -427,6 +427,10 @@ void TlsChannelSecurityConnector::TlsChannelCertificateWatcher::
   MutexLock lock(&security_connector_->mu_);
   if (root_certs.has_value()) {
     security_connector_->pem_root_certs_ = root_certs;
+    // Peers verified against the old root certificates must be verified again.
+    CertificateVerificationCache* cache =
+        security_connector_->options_->verification_cache();
+    if (cache != nullptr) cache->Clear();
   }
   if (key_cert_pairs.has_value()) {
     security_connector_->pem_key_cert_pair_list_ = std::move(key_cert_pairs);
@@ -478,6 +482,16 @@ TlsChannelSecurityConnector::ChannelPendingVerifierRequest::
 }
 
 void TlsChannelSecurityConnector::ChannelPendingVerifierRequest::Start() {
+  CertificateVerificationCache* cache =
+      security_connector_->options_->verification_cache();
+  if (cache != nullptr) {
+    uint64_t generation;
+    if (cache->Lookup(&request_, &generation)) {
+      OnVerifyDone(false, absl::OkStatus());
+      return;
+    }
+    verification_cache_generation_ = generation;
+  }
   absl::Status sync_status;
   grpc_tls_certificate_verifier* verifier =
       security_connector_->options_->certificate_verifier();
@@ -498,6 +512,10 @@ void TlsChannelSecurityConnector::ChannelPendingVerifierRequest::OnVerifyDone(
     security_connector_->pending_verifier_requests_.erase(on_peer_checked_);
   }
   grpc_error_handle error = GRPC_ERROR_NONE;
+  if (status.ok() && verification_cache_generation_.has_value()) {
+    security_connector_->options_->verification_cache()->Insert(
+        &request_, *verification_cache_generation_);
+  }
   if (!status.ok()) {
     error = GRPC_ERROR_CREATE_FROM_COPIED_STRING(
         absl::StrCat("Custom verification check failed with error: ",
@@ -540,7 +558,7 @@ TlsChannelSecurityConnector::UpdateHandshakerFactoryLocked() {
       grpc_get_tsi_tls_version(options_->min_tls_version()),
       grpc_get_tsi_tls_version(options_->max_tls_version()), ssl_session_cache_,
       tls_session_key_logger_.get(), options_->crl_directory().c_str(),
-      &client_handshaker_factory_);
+      options_->private_key_signer(), &client_handshaker_factory_);
   /* Free memory. */
   if (pem_key_cert_pair != nullptr) {
     grpc_tsi_ssl_pem_key_cert_pairs_destroy(pem_key_cert_pair, 1);
@@ -701,6 +719,10 @@ void TlsServerSecurityConnector::TlsServerCertificateWatcher::
   MutexLock lock(&security_connector_->mu_);
   if (root_certs.has_value()) {
     security_connector_->pem_root_certs_ = root_certs;
+    // Peers verified against the old root certificates must be verified again.
+    CertificateVerificationCache* cache =
+        security_connector_->options_->verification_cache();
+    if (cache != nullptr) cache->Clear();
   }
   if (key_cert_pairs.has_value()) {
     security_connector_->pem_key_cert_pair_list_ = std::move(key_cert_pairs);
@@ -756,6 +778,16 @@ TlsServerSecurityConnector::ServerPendingVerifierRequest::
 }
 
 void TlsServerSecurityConnector::ServerPendingVerifierRequest::Start() {
+  CertificateVerificationCache* cache =
+      security_connector_->options_->verification_cache();
+  if (cache != nullptr) {
+    uint64_t generation;
+    if (cache->Lookup(&request_, &generation)) {
+      OnVerifyDone(false, absl::OkStatus());
+      return;
+    }
+    verification_cache_generation_ = generation;
+  }
   absl::Status sync_status;
   grpc_tls_certificate_verifier* verifier =
       security_connector_->options_->certificate_verifier();
@@ -775,6 +807,10 @@ void TlsServerSecurityConnector::ServerPendingVerifierRequest::OnVerifyDone(
     security_connector_->pending_verifier_requests_.erase(on_peer_checked_);
   }
   grpc_error_handle error = GRPC_ERROR_NONE;
+  if (status.ok() && verification_cache_generation_.has_value()) {
+    security_connector_->options_->verification_cache()->Insert(
+        &request_, *verification_cache_generation_);
+  }
   if (!status.ok()) {
     error = GRPC_ERROR_CREATE_FROM_COPIED_STRING(
         absl::StrCat("Custom verification check failed with error: ",
@@ -816,7 +852,7 @@ TlsServerSecurityConnector::UpdateHandshakerFactoryLocked() {
       grpc_get_tsi_tls_version(options_->min_tls_version()),
       grpc_get_tsi_tls_version(options_->max_tls_version()),
       tls_session_key_logger_.get(), options_->crl_directory().c_str(),
-      &server_handshaker_factory_);
+      options_->private_key_signer(), &server_handshaker_factory_);
   /* Free memory. */
   grpc_tsi_ssl_pem_key_cert_pairs_destroy(pem_key_cert_pairs,
                                           num_key_cert_pairs);
@@ -22,6 +22,7 @@
 #include <grpc/support/port_platform.h>
 
 #include "absl/status/status.h"
+#include "absl/types/optional.h"
 
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/security/context/security_context.h"
@@ -126,6 +127,8 @@ class TlsChannelSecurityConnector final
     RefCountedPtr<TlsChannelSecurityConnector> security_connector_;
     grpc_tls_custom_verification_check_request request_;
     grpc_closure* on_peer_checked_;
+    // Set if the verification result is to be cached.
+    absl::optional<uint64_t> verification_cache_generation_;
   };
 
   // Updates |client_handshaker_factory_| when the certificates that
@@ -237,6 +240,8 @@ class TlsServerSecurityConnector final : public grpc_server_security_connector {
     RefCountedPtr<TlsServerSecurityConnector> security_connector_;
     grpc_tls_custom_verification_check_request request_;
     grpc_closure* on_peer_checked_;
+    // Set if the verification result is to be cached.
+    absl::optional<uint64_t> verification_cache_generation_;
   };
 
   // Updates |server_handshaker_factory_| when the certificates that
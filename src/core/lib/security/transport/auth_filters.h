@@ -29,8 +29,6 @@
 #include "src/core/lib/security/security_connector/security_connector.h"
 #include "src/core/lib/transport/transport.h"
 
-extern const grpc_channel_filter grpc_server_auth_filter;
-
 namespace grpc_core {
 
 // Handles calling out to credentials to fill in metadata per call.
@@ -57,6 +55,32 @@ class ClientAuthFilter final : public ChannelFilter {
   grpc_call_credentials::GetRequestMetadataArgs args_;
 };
 
+// Creates the server security context of each call, and runs the server
+// credentials' auth metadata processor, if any, on the client's initial
+// metadata.
+class ServerAuthFilter final : public ChannelFilter {
+ public:
+  static const grpc_channel_filter kFilter;
+
+  static absl::StatusOr<ServerAuthFilter> Create(ChannelArgs args,
+                                                 ChannelFilter::Args);
+
+  // Construct a promise for one call.
+  ArenaPromise<ServerMetadataHandle> MakeCallPromise(
+      CallArgs call_args, NextPromiseFactory next_promise_factory) override;
+
+ private:
+  class RunApplicationCode;
+
+  ServerAuthFilter(RefCountedPtr<grpc_server_credentials> server_credentials,
+                   RefCountedPtr<grpc_auth_context> auth_context);
+
+  bool IsMdProcessingNeeded() const;
+
+  RefCountedPtr<grpc_server_credentials> server_credentials_;
+  RefCountedPtr<grpc_auth_context> auth_context_;
+};
+
 }  // namespace grpc_core
 
 // Exposed for testing purposes only.
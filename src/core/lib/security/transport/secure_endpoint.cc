@@ -54,10 +54,11 @@ struct secure_endpoint {
                   tsi_zero_copy_grpc_protector* zero_copy_protector,
                   grpc_endpoint* transport, grpc_slice* leftover_slices,
                   const grpc_channel_args* channel_args,
-                  size_t leftover_nslices)
+                  size_t leftover_nslices, bool kernel_tx)
       : wrapped_ep(transport),
         protector(protector),
-        zero_copy_protector(zero_copy_protector) {
+        zero_copy_protector(zero_copy_protector),
+        kernel_tx(kernel_tx) {
     base.vtable = vtable;
     gpr_mu_init(&protector_mu);
     GRPC_CLOSURE_INIT(&on_read, ::on_read, this, grpc_schedule_on_exec_ctx);
@@ -72,7 +73,8 @@ struct secure_endpoint {
         grpc_core::ResourceQuotaFromChannelArgs(channel_args)
             ->memory_quota()
             ->CreateMemoryOwner(absl::StrCat(grpc_endpoint_get_peer(transport),
-                                             ":secure_endpoint"));
+                                             ":secure_endpoint"),
+                                grpc_core::MemoryCategory::kReadBuffer);
     self_reservation = memory_owner.MakeReservation(sizeof(*this));
     if (zero_copy_protector) {
       read_staging_buffer = grpc_empty_slice();
@@ -81,7 +83,9 @@ struct secure_endpoint {
       read_staging_buffer =
           memory_owner.MakeSlice(grpc_core::MemoryRequest(STAGING_BUFFER_SIZE));
       write_staging_buffer =
-          memory_owner.MakeSlice(grpc_core::MemoryRequest(STAGING_BUFFER_SIZE));
+          kernel_tx ? grpc_empty_slice()
+                    : memory_owner.MakeSlice(
+                          grpc_core::MemoryRequest(STAGING_BUFFER_SIZE));
     }
     has_posted_reclaimer.store(false, std::memory_order_relaxed);
     gpr_ref_init(&ref, 1);
@@ -103,6 +107,9 @@ struct secure_endpoint {
   grpc_endpoint* wrapped_ep;
   struct tsi_frame_protector* protector;
   struct tsi_zero_copy_grpc_protector* zero_copy_protector;
+  /* true if the kernel encrypts writes on wrapped_ep (kernel TLS), in which
+     case writes skip the protector. */
+  const bool kernel_tx;
   gpr_mu protector_mu;
   grpc_core::Mutex read_mu;
   grpc_core::Mutex write_mu;
@@ -351,14 +358,26 @@ static void flush_write_staging_buffer(secure_endpoint* ep, uint8_t** cur,
 }
 
 static void endpoint_write(grpc_endpoint* secure_ep, grpc_slice_buffer* slices,
-                           grpc_closure* cb, void* arg,
-                           int /*max_frame_size*/) {
+                           grpc_closure* cb, void* arg, int max_frame_size) {
   GPR_TIMER_SCOPE("secure_endpoint.endpoint_write", 0);
 
   unsigned i;
   tsi_result result = TSI_OK;
   secure_endpoint* ep = reinterpret_cast<secure_endpoint*>(secure_ep);
 
+  if (ep->kernel_tx) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_secure_endpoint)) {
+      for (i = 0; i < slices->count; i++) {
+        char* data =
+            grpc_dump_slice(slices->slices[i], GPR_DUMP_HEX | GPR_DUMP_ASCII);
+        gpr_log(GPR_INFO, "WRITE %p (kernel TLS): %s", ep, data);
+        gpr_free(data);
+      }
+    }
+    grpc_endpoint_write(ep->wrapped_ep, slices, cb, arg, max_frame_size);
+    return;
+  }
+
   {
     grpc_core::MutexLock l(&ep->write_mu);
     uint8_t* cur = GRPC_SLICE_START_PTR(ep->write_staging_buffer);
@@ -515,8 +534,19 @@ grpc_endpoint* grpc_secure_endpoint_create(
     struct tsi_zero_copy_grpc_protector* zero_copy_protector,
     grpc_endpoint* to_wrap, grpc_slice* leftover_slices,
     const grpc_channel_args* channel_args, size_t leftover_nslices) {
-  secure_endpoint* ep =
-      new secure_endpoint(&vtable, protector, zero_copy_protector, to_wrap,
-                          leftover_slices, channel_args, leftover_nslices);
+  secure_endpoint* ep = new secure_endpoint(
+      &vtable, protector, zero_copy_protector, to_wrap, leftover_slices,
+      channel_args, leftover_nslices, /*kernel_tx=*/false);
+  return &ep->base;
+}
+
+grpc_endpoint* grpc_secure_endpoint_create_with_kernel_tx(
+    struct tsi_frame_protector* protector,
+    struct tsi_zero_copy_grpc_protector* zero_copy_protector,
+    grpc_endpoint* to_wrap, grpc_slice* leftover_slices,
+    const grpc_channel_args* channel_args, size_t leftover_nslices) {
+  secure_endpoint* ep = new secure_endpoint(
+      &vtable, protector, zero_copy_protector, to_wrap, leftover_slices,
+      channel_args, leftover_nslices, /*kernel_tx=*/true);
   return &ep->base;
 }
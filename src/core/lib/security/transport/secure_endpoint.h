@@ -39,4 +39,14 @@ grpc_endpoint* grpc_secure_endpoint_create(
     grpc_endpoint* to_wrap, grpc_slice* leftover_slices,
     const grpc_channel_args* channel_args, size_t leftover_nslices);
 
+/* Like grpc_secure_endpoint_create, for a to_wrap whose socket already
+ * encrypts outgoing data in the kernel (see
+ * tsi_handshaker_result_enable_kernel_tx_protection): writes go to to_wrap
+ * unchanged and the protectors are only used to unprotect reads. */
+grpc_endpoint* grpc_secure_endpoint_create_with_kernel_tx(
+    struct tsi_frame_protector* protector,
+    struct tsi_zero_copy_grpc_protector* zero_copy_protector,
+    grpc_endpoint* to_wrap, grpc_slice* leftover_slices,
+    const grpc_channel_args* channel_args, size_t leftover_nslices);
+
 #endif /* GRPC_CORE_LIB_SECURITY_TRANSPORT_SECURE_ENDPOINT_H */
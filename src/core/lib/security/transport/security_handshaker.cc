@@ -23,16 +23,19 @@
 #include <stdbool.h>
 #include <string.h>
 
+#include <algorithm>
 #include <limits>
 
 #include <grpc/slice_buffer.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/executor/work_stealing_threadpool.h"
 #include "src/core/lib/security/context/security_context.h"
 #include "src/core/lib/security/transport/secure_endpoint.h"
 #include "src/core/lib/security/transport/tsi_error.h"
@@ -46,6 +49,15 @@ namespace grpc_core {
 
 namespace {
 
+// Runs the TSI handshakers of connections with
+// GRPC_ARG_SECURITY_HANDSHAKE_OFFLOAD set. Created on first use and never
+// destroyed.
+WorkStealingThreadPool* HandshakeOffloadPool() {
+  static WorkStealingThreadPool* pool = new WorkStealingThreadPool(
+      static_cast<int>(std::max(1u, gpr_cpu_num_cores())), "grpc_handshake");
+  return pool;
+}
+
 class SecurityHandshaker : public Handshaker {
  public:
   SecurityHandshaker(tsi_handshaker* handshaker,
@@ -78,6 +90,7 @@ class SecurityHandshaker : public Handshaker {
   static void OnHandshakeNextDoneGrpcWrapper(
       tsi_result result, void* user_data, const unsigned char* bytes_to_send,
       size_t bytes_to_send_size, tsi_handshaker_result* handshaker_result);
+  static void OnOffloadedHandshakerNextFn(void* arg, grpc_error_handle error);
   static void OnPeerCheckedFn(void* arg, grpc_error_handle error);
   void OnPeerCheckedInner(grpc_error_handle error);
   size_t MoveReadBufferIntoHandshakeBuffer();
@@ -107,6 +120,10 @@ class SecurityHandshaker : public Handshaker {
   RefCountedPtr<grpc_auth_context> auth_context_;
   tsi_handshaker_result* handshaker_result_ = nullptr;
   size_t max_frame_size_ = 0;
+  // Whether tsi_handshaker_next() runs on HandshakeOffloadPool().
+  const bool offload_handshaker_next_;
+  grpc_closure on_offloaded_handshaker_next_;
+  size_t offloaded_bytes_received_size_ = 0;
 };
 
 SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
@@ -119,7 +136,9 @@ SecurityHandshaker::SecurityHandshaker(tsi_handshaker* handshaker,
           static_cast<uint8_t*>(gpr_malloc(handshake_buffer_size_))),
       max_frame_size_(grpc_channel_args_find_integer(
           args, GRPC_ARG_TSI_MAX_FRAME_SIZE,
-          {0, 0, std::numeric_limits<int>::max()})) {
+          {0, 0, std::numeric_limits<int>::max()})),
+      offload_handshaker_next_(grpc_channel_args_find_bool(
+          args, GRPC_ARG_SECURITY_HANDSHAKE_OFFLOAD, false)) {
   grpc_slice_buffer_init(&outgoing_);
   GRPC_CLOSURE_INIT(&on_peer_checked_, &SecurityHandshaker::OnPeerCheckedFn,
                     this, grpc_schedule_on_exec_ctx);
@@ -255,6 +274,15 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error_handle error) {
   }
   tsi_zero_copy_grpc_protector* zero_copy_protector = nullptr;
   tsi_frame_protector* protector = nullptr;
+  // Let the kernel encrypt writes if the handshaker result supports it.
+  // This must happen before a frame protector takes over the result's
+  // state. Kernel TLS does not accept MSG_ZEROCOPY writes.
+  bool kernel_tx =
+      frame_protector_type != TSI_FRAME_PROTECTOR_NONE &&
+      !grpc_channel_args_find_bool(args_->args,
+                                   GRPC_ARG_TCP_TX_ZEROCOPY_ENABLED, false) &&
+      tsi_handshaker_result_enable_kernel_tx_protection(
+          handshaker_result_, grpc_endpoint_get_fd(args_->endpoint)) == TSI_OK;
   switch (frame_protector_type) {
     case TSI_FRAME_PROTECTOR_ZERO_COPY:
       ABSL_FALLTHROUGH_INTENDED;
@@ -295,13 +323,23 @@ void SecurityHandshaker::OnPeerCheckedInner(grpc_error_handle error) {
       grpc_slice slice = grpc_slice_from_copied_buffer(
           reinterpret_cast<const char*>(unused_bytes), unused_bytes_size);
       args_->endpoint =
-          grpc_secure_endpoint_create(protector, zero_copy_protector,
-                                      args_->endpoint, &slice, args_->args, 1);
+          kernel_tx
+              ? grpc_secure_endpoint_create_with_kernel_tx(
+                    protector, zero_copy_protector, args_->endpoint, &slice,
+                    args_->args, 1)
+              : grpc_secure_endpoint_create(protector, zero_copy_protector,
+                                            args_->endpoint, &slice,
+                                            args_->args, 1);
       grpc_slice_unref_internal(slice);
     } else {
       args_->endpoint =
-          grpc_secure_endpoint_create(protector, zero_copy_protector,
-                                      args_->endpoint, nullptr, args_->args, 0);
+          kernel_tx
+              ? grpc_secure_endpoint_create_with_kernel_tx(
+                    protector, zero_copy_protector, args_->endpoint, nullptr,
+                    args_->args, 0)
+              : grpc_secure_endpoint_create(protector, zero_copy_protector,
+                                            args_->endpoint, nullptr,
+                                            args_->args, 0);
     }
   } else if (unused_bytes_size > 0) {
     // Not wrapping the endpoint, so just pass along unused bytes.
@@ -425,8 +463,36 @@ void SecurityHandshaker::OnHandshakeNextDoneGrpcWrapper(
   }
 }
 
+void SecurityHandshaker::OnOffloadedHandshakerNextFn(
+    void* arg, grpc_error_handle /*error*/) {
+  RefCountedPtr<SecurityHandshaker> h(static_cast<SecurityHandshaker*>(arg));
+  MutexLock lock(&h->mu_);
+  grpc_error_handle error =
+      h->is_shutdown_
+          ? GRPC_ERROR_CREATE_FROM_STATIC_STRING("Handshaker shutdown")
+          : h->DoHandshakerNextLocked(h->handshake_buffer_,
+                                      h->offloaded_bytes_received_size_);
+  if (error != GRPC_ERROR_NONE) {
+    h->HandshakeFailedLocked(error);
+  } else {
+    h.release();  // Avoid unref
+  }
+}
+
 grpc_error_handle SecurityHandshaker::DoHandshakerNextLocked(
     const unsigned char* bytes_received, size_t bytes_received_size) {
+  if (offload_handshaker_next_ && !HandshakeOffloadPool()->IsWorkerThread()) {
+    // Continue on the offload pool. The received bytes are always in
+    // handshake_buffer_, which is not touched again until then.
+    GPR_DEBUG_ASSERT(bytes_received == handshake_buffer_);
+    offloaded_bytes_received_size_ = bytes_received_size;
+    HandshakeOffloadPool()->Run(
+        GRPC_CLOSURE_INIT(&on_offloaded_handshaker_next_,
+                          &SecurityHandshaker::OnOffloadedHandshakerNextFn,
+                          this, nullptr),
+        GRPC_ERROR_NONE);
+    return GRPC_ERROR_NONE;
+  }
   // Invoke TSI handshaker.
   const unsigned char* bytes_to_send = nullptr;
   size_t bytes_to_send_size = 0;
@@ -18,27 +18,87 @@
 
 #include "src/core/lib/service_config/service_config_impl.h"
 
+#include <algorithm>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 
 #include <grpc/support/log.h>
 
 #include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/json/json.h"
 #include "src/core/lib/service_config/service_config_parser.h"
 #include "src/core/lib/slice/slice_internal.h"
 
 namespace grpc_core {
 
+namespace {
+
+// Service configs that parsed successfully and are still in use, so that
+// channels and resolver updates delivering the same config share one.
+// Entries are weak: a config removes itself when destroyed.
+Mutex* g_service_config_cache_mu = new Mutex();
+std::unordered_map<std::string, ServiceConfigImpl*>* g_service_config_cache
+    ABSL_GUARDED_BY(g_service_config_cache_mu) =
+        new std::unordered_map<std::string, ServiceConfigImpl*>();
+
+// Parsers may depend on the integer and string channel args, so those are
+// part of the key along with the JSON. Pointer args identify objects of a
+// single channel, and would prevent sharing between channels.
+std::string MakeCacheKey(const grpc_channel_args* args,
+                         absl::string_view json_string) {
+  std::vector<std::string> arg_strings;
+  for (size_t i = 0; args != nullptr && i < args->num_args; ++i) {
+    const grpc_arg& arg = args->args[i];
+    switch (arg.type) {
+      case GRPC_ARG_STRING:
+        arg_strings.push_back(
+            absl::StrCat(arg.key, absl::string_view("\0s", 2),
+                         arg.value.string));
+        break;
+      case GRPC_ARG_INTEGER:
+        arg_strings.push_back(absl::StrCat(
+            arg.key, absl::string_view("\0i", 2), arg.value.integer));
+        break;
+      case GRPC_ARG_POINTER:
+        break;
+    }
+  }
+  std::sort(arg_strings.begin(), arg_strings.end());
+  return absl::StrCat(absl::StrJoin(arg_strings, absl::string_view("\0", 1)),
+                      absl::string_view("\0\0", 2), json_string);
+}
+
+}  // namespace
+
 RefCountedPtr<ServiceConfig> ServiceConfigImpl::Create(
     const grpc_channel_args* args, absl::string_view json_string,
     grpc_error_handle* error) {
   GPR_DEBUG_ASSERT(error != nullptr);
+  std::string cache_key = MakeCacheKey(args, json_string);
+  {
+    MutexLock lock(g_service_config_cache_mu);
+    auto it = g_service_config_cache->find(cache_key);
+    if (it != g_service_config_cache->end()) {
+      RefCountedPtr<ServiceConfig> service_config = it->second->RefIfNonZero();
+      if (service_config != nullptr) return service_config;
+    }
+  }
   Json json = Json::Parse(json_string, error);
   if (*error != GRPC_ERROR_NONE) return nullptr;
-  return MakeRefCounted<ServiceConfigImpl>(args, std::string(json_string),
-                                           std::move(json), error);
+  auto service_config = MakeRefCounted<ServiceConfigImpl>(
+      args, std::string(json_string), std::move(json), error);
+  if (*error == GRPC_ERROR_NONE) {
+    MutexLock lock(g_service_config_cache_mu);
+    service_config->cache_key_ = std::move(cache_key);
+    (*g_service_config_cache)[service_config->cache_key_] =
+        service_config.get();
+  }
+  return service_config;
 }
 
 ServiceConfigImpl::ServiceConfigImpl(const grpc_channel_args* args,
@@ -66,6 +126,15 @@ ServiceConfigImpl::ServiceConfigImpl(const grpc_channel_args* args,
 }
 
 ServiceConfigImpl::~ServiceConfigImpl() {
+  if (!cache_key_.empty()) {
+    MutexLock lock(g_service_config_cache_mu);
+    // Another config may have replaced this one if it was looked up after
+    // the last ref was dropped.
+    auto it = g_service_config_cache->find(cache_key_);
+    if (it != g_service_config_cache->end() && it->second == this) {
+      g_service_config_cache->erase(it);
+    }
+  }
   for (auto& p : parsed_method_configs_map_) {
     grpc_slice_unref_internal(p.first);
   }
@@ -215,13 +284,13 @@ ServiceConfigImpl::GetMethodParsedConfigVector(const grpc_slice& path) const {
   auto it = parsed_method_configs_map_.find(path);
   if (it != parsed_method_configs_map_.end()) return it->second;
   // If we didn't find a match for the path, try looking for a wildcard
-  // entry (i.e., change "/service/method" to "/service/").
-  UniquePtr<char> path_str(grpc_slice_to_c_string(path));
-  char* sep = strrchr(path_str.get(), '/');
-  if (sep == nullptr) return nullptr;  // Shouldn't ever happen.
-  sep[1] = '\0';
-  grpc_slice wildcard_path = grpc_slice_from_static_string(path_str.get());
-  it = parsed_method_configs_map_.find(wildcard_path);
+  // entry (i.e., change "/service/method" to "/service/"). The wildcard is
+  // a prefix of the path, so look it up without copying.
+  absl::string_view path_view = StringViewFromSlice(path);
+  size_t sep = path_view.rfind('/');
+  if (sep == absl::string_view::npos) return nullptr;  // Shouldn't happen.
+  it = parsed_method_configs_map_.find(
+      grpc_slice_sub_no_ref(path, 0, sep + 1));
   if (it != parsed_method_configs_map_.end()) return it->second;
   // Try default method config, if set.
   return default_method_config_vector_;
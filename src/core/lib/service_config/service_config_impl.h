@@ -63,6 +63,9 @@ class ServiceConfigImpl final : public ServiceConfig {
  public:
   /// Creates a new service config from parsing \a json_string.
   /// Returns null on parse error.
+  /// A config created from the same JSON and the same integer and string
+  /// args is returned instead of parsing again, as long as it is still
+  /// referenced.
   static RefCountedPtr<ServiceConfig> Create(const grpc_channel_args* args,
                                              absl::string_view json_string,
                                              grpc_error_handle* error);
@@ -101,6 +104,8 @@ class ServiceConfigImpl final : public ServiceConfig {
 
   std::string json_string_;
   Json json_;
+  // Key in the cache of parsed configs, empty if not cached.
+  std::string cache_key_;
 
   std::vector<std::unique_ptr<ServiceConfigParser::ParsedConfig>>
       parsed_global_configs_;
@@ -41,6 +41,8 @@ class ServiceConfigParser {
   };
 
   /// This is the base class that all service config parsers should derive from.
+  /// Parsed configs are shared between channels whose integer and string
+  /// channel args match, so parsers must not depend on pointer args.
   class Parser {
    public:
     virtual ~Parser() = default;
@@ -23,10 +23,13 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/slice/b64_kernels.h"
 #include "src/core/lib/slice/slice_refcount.h"
 
 /* --- Constants. --- */
@@ -83,24 +86,20 @@ void grpc_base64_encode_core(char* result, const void* vdata, size_t data_size,
       grpc_base64_estimate_encoded_size(data_size, multiline);
 
   char* current = result;
-  size_t num_blocks = 0;
   size_t i = 0;
 
-  /* Encode each block. */
+  /* Encode each block, a line at a time when multiline. */
+  const size_t line_size =
+      multiline ? 3 * GRPC_BASE64_MULTILINE_NUM_BLOCKS : data_size;
   while (data_size >= 3) {
-    *current++ = base64_chars[(data[i] >> 2) & 0x3F];
-    *current++ =
-        base64_chars[((data[i] & 0x03) << 4) | ((data[i + 1] >> 4) & 0x0F)];
-    *current++ =
-        base64_chars[((data[i + 1] & 0x0F) << 2) | ((data[i + 2] >> 6) & 0x03)];
-    *current++ = base64_chars[data[i + 2] & 0x3F];
-
-    data_size -= 3;
-    i += 3;
-    if (multiline && (++num_blocks == GRPC_BASE64_MULTILINE_NUM_BLOCKS)) {
+    size_t consumed = grpc_core::Base64EncodeGroups(
+        data + i, std::min(data_size, line_size), url_safe != 0, current);
+    current += consumed / 3 * 4;
+    data_size -= consumed;
+    i += consumed;
+    if (multiline && consumed == line_size) {
       *current++ = '\r';
       *current++ = '\n';
-      num_blocks = 0;
     }
   }
 
@@ -196,7 +195,19 @@ grpc_slice grpc_base64_decode_with_len(const char* b64, size_t b64_len,
   unsigned char codes[4];
   size_t num_codes = 0;
 
-  while (b64_len--) {
+  while (b64_len > 0) {
+    /* Decode runs of complete groups in bulk; anything unusual (padding, line
+     * breaks, invalid characters) is left to the per character loop below. */
+    if (num_codes == 0) {
+      size_t consumed = grpc_core::Base64DecodeGroups(
+          reinterpret_cast<const uint8_t*>(b64), b64_len, url_safe != 0,
+          current + result_size);
+      b64 += consumed;
+      b64_len -= consumed;
+      result_size += consumed / 4 * 3;
+      if (b64_len == 0) break;
+    }
+    b64_len--;
     unsigned char c = static_cast<unsigned char>(*b64++);
     signed char code;
     if (c >= GPR_ARRAY_SIZE(base64_bytes)) continue;
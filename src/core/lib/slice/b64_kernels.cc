@@ -0,0 +1,268 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/slice/b64_kernels.h"
+
+#include <string.h>
+
+#include <atomic>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define GRPC_B64_KERNELS_SSSE3
+#include <tmmintrin.h>
+#endif
+
+namespace grpc_core {
+
+namespace {
+
+constexpr char kStandardAlphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char kUrlSafeAlphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// Maps each input character to its 6-bit value, or to 0xff if the character
+// is not part of the alphabet.
+struct DecodeTable {
+  uint8_t table[256];
+  explicit DecodeTable(const char* alphabet) {
+    memset(table, 0xff, sizeof(table));
+    for (uint8_t i = 0; i < 64; i++) {
+      table[static_cast<uint8_t>(alphabet[i])] = i;
+    }
+  }
+};
+
+const DecodeTable& GetDecodeTable(bool url_safe) {
+  static const DecodeTable standard(kStandardAlphabet);
+  static const DecodeTable url(kUrlSafeAlphabet);
+  return url_safe ? url : standard;
+}
+
+std::atomic<bool> g_force_scalar{false};
+
+/* --- Scalar kernels. --- */
+
+size_t SplitScalar(const uint8_t* in, size_t len, uint8_t* out) {
+  size_t groups = len / 3;
+  for (size_t i = 0; i < groups; i++) {
+    out[0] = in[0] >> 2;
+    out[1] = static_cast<uint8_t>(((in[0] & 0x3) << 4) | (in[1] >> 4));
+    out[2] = static_cast<uint8_t>(((in[1] & 0xf) << 2) | (in[2] >> 6));
+    out[3] = in[2] & 0x3f;
+    in += 3;
+    out += 4;
+  }
+  return groups * 3;
+}
+
+size_t EncodeScalar(const uint8_t* in, size_t len, bool url_safe, char* out) {
+  const char* alphabet = url_safe ? kUrlSafeAlphabet : kStandardAlphabet;
+  size_t groups = len / 3;
+  for (size_t i = 0; i < groups; i++) {
+    out[0] = alphabet[in[0] >> 2];
+    out[1] = alphabet[((in[0] & 0x3) << 4) | (in[1] >> 4)];
+    out[2] = alphabet[((in[1] & 0xf) << 2) | (in[2] >> 6)];
+    out[3] = alphabet[in[2] & 0x3f];
+    in += 3;
+    out += 4;
+  }
+  return groups * 3;
+}
+
+size_t DecodeScalar(const uint8_t* in, size_t len, bool url_safe,
+                    uint8_t* out) {
+  const uint8_t* table = GetDecodeTable(url_safe).table;
+  size_t consumed = 0;
+  while (len - consumed >= 4) {
+    uint32_t a = table[in[0]];
+    uint32_t b = table[in[1]];
+    uint32_t c = table[in[2]];
+    uint32_t d = table[in[3]];
+    // Invalid characters map to 0xff, which is the only way to set bits above
+    // the low six.
+    if (GPR_UNLIKELY(((a | b | c | d) & 0xc0) != 0)) break;
+    uint32_t packed = (a << 18) | (b << 12) | (c << 6) | d;
+    out[0] = static_cast<uint8_t>(packed >> 16);
+    out[1] = static_cast<uint8_t>(packed >> 8);
+    out[2] = static_cast<uint8_t>(packed);
+    in += 4;
+    out += 3;
+    consumed += 4;
+  }
+  return consumed;
+}
+
+#ifdef GRPC_B64_KERNELS_SSSE3
+
+/* --- SSSE3 kernels. ---
+ * Each iteration handles 12 raw bytes <-> 16 characters. 16 byte loads are
+ * only issued while at least 16 input bytes remain, decoded blocks are stored
+ * through a temporary, and the rest is finished by the scalar kernels, so the
+ * vector code never touches memory beyond what the scalar kernels would. */
+
+bool CpuHasSsse3() {
+  static const bool has_ssse3 = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3") != 0;
+  }();
+  return has_ssse3;
+}
+
+// Spreads the first 12 bytes loaded from `in` to 16 lanes of 6-bit values.
+__attribute__((target("ssse3"))) inline __m128i SplitBlockSsse3(
+    const uint8_t* in) {
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+  // Duplicate each 3 byte group as bytes [b1, b0, b2, b1] so that every
+  // 16-bit lane holds the bits of two output values.
+  v = _mm_shuffle_epi8(
+      v, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  // Values 0 and 2 of each group: shift right by 10 and 6 within each lane.
+  __m128i hi = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)),
+                               _mm_set1_epi32(0x04000040));
+  // Values 1 and 3: shift left by 4 and 8.
+  __m128i lo = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)),
+                               _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(hi, lo);
+}
+
+__attribute__((target("ssse3"))) size_t SplitSsse3(const uint8_t* in,
+                                                   size_t len, uint8_t* out) {
+  size_t consumed = 0;
+  while (len - consumed >= 16) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), SplitBlockSsse3(in));
+    in += 12;
+    out += 16;
+    consumed += 12;
+  }
+  return consumed + SplitScalar(in, len - consumed, out);
+}
+
+__attribute__((target("ssse3"))) size_t EncodeSsse3(const uint8_t* in,
+                                                    size_t len, bool url_safe,
+                                                    char* out) {
+  // Offsets to add to each 6-bit value to reach its character, indexed by the
+  // value's range: 0 for 26..51, 1..10 for 52..61, 11 for 62, 12 for 63 and
+  // 13 for 0..25.
+  const __m128i offsets = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      static_cast<char>((url_safe ? '-' : '+') - 62),
+      static_cast<char>((url_safe ? '_' : '/') - 63), 'A', 0, 0);
+  size_t consumed = 0;
+  while (len - consumed >= 16) {
+    __m128i values = SplitBlockSsse3(in);
+    __m128i range = _mm_subs_epu8(values, _mm_set1_epi8(51));
+    __m128i below_26 = _mm_cmpgt_epi8(_mm_set1_epi8(26), values);
+    range = _mm_or_si128(range, _mm_and_si128(below_26, _mm_set1_epi8(13)));
+    __m128i chars = _mm_add_epi8(values, _mm_shuffle_epi8(offsets, range));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), chars);
+    in += 12;
+    out += 16;
+    consumed += 12;
+  }
+  return consumed + EncodeScalar(in, len - consumed, url_safe, out);
+}
+
+// Returns a mask of the lanes of `v` that lie within [lo, hi].
+__attribute__((target("ssse3"))) inline __m128i InRange(__m128i v, char lo,
+                                                        char hi) {
+  return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(lo - 1)),
+                       _mm_cmpgt_epi8(_mm_set1_epi8(hi + 1), v));
+}
+
+__attribute__((target("ssse3"))) size_t DecodeSsse3(const uint8_t* in,
+                                                    size_t len, bool url_safe,
+                                                    uint8_t* out) {
+  const char c62 = url_safe ? '-' : '+';
+  const char c63 = url_safe ? '_' : '/';
+  size_t consumed = 0;
+  while (len - consumed >= 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    // Bytes >= 0x80 compare as negative and so fall outside of every range.
+    __m128i upper = InRange(v, 'A', 'Z');
+    __m128i lower = InRange(v, 'a', 'z');
+    __m128i digit = InRange(v, '0', '9');
+    __m128i is62 = _mm_cmpeq_epi8(v, _mm_set1_epi8(c62));
+    __m128i is63 = _mm_cmpeq_epi8(v, _mm_set1_epi8(c63));
+    __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower),
+                                 _mm_or_si128(digit, _mm_or_si128(is62, is63)));
+    // Leave the block (and everything after it) to the scalar loop, which
+    // will stop at the offending group.
+    if (GPR_UNLIKELY(_mm_movemask_epi8(valid) != 0xffff)) break;
+    __m128i delta = _mm_or_si128(
+        _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')),
+                     _mm_and_si128(lower, _mm_set1_epi8(26 - 'a'))),
+        _mm_or_si128(
+            _mm_and_si128(digit, _mm_set1_epi8(52 - '0')),
+            _mm_or_si128(_mm_and_si128(is62, _mm_set1_epi8(62 - c62)),
+                         _mm_and_si128(is63, _mm_set1_epi8(63 - c63)))));
+    __m128i values = _mm_add_epi8(v, delta);
+    // Merge pairs of 6-bit values into 12-bit lanes, then pairs of those into
+    // 24-bit lanes, and finally drop the high byte of every 32-bit lane.
+    __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+    merged = _mm_shuffle_epi8(
+        merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1,
+                              -1, -1));
+    uint8_t buf[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(buf), merged);
+    memcpy(out, buf, 12);
+    in += 16;
+    out += 12;
+    consumed += 16;
+  }
+  return consumed + DecodeScalar(in, len - consumed, url_safe, out);
+}
+
+bool UseSsse3() {
+  return !g_force_scalar.load(std::memory_order_relaxed) && CpuHasSsse3();
+}
+
+#endif  // GRPC_B64_KERNELS_SSSE3
+
+}  // namespace
+
+size_t Base64EncodeGroups(const uint8_t* in, size_t len, bool url_safe,
+                          char* out) {
+#ifdef GRPC_B64_KERNELS_SSSE3
+  if (UseSsse3()) return EncodeSsse3(in, len, url_safe, out);
+#endif
+  return EncodeScalar(in, len, url_safe, out);
+}
+
+size_t Base64SplitGroups(const uint8_t* in, size_t len, uint8_t* out) {
+#ifdef GRPC_B64_KERNELS_SSSE3
+  if (UseSsse3()) return SplitSsse3(in, len, out);
+#endif
+  return SplitScalar(in, len, out);
+}
+
+size_t Base64DecodeGroups(const uint8_t* in, size_t len, bool url_safe,
+                          uint8_t* out) {
+#ifdef GRPC_B64_KERNELS_SSSE3
+  if (UseSsse3()) return DecodeSsse3(in, len, url_safe, out);
+#endif
+  return DecodeScalar(in, len, url_safe, out);
+}
+
+void TestOnlySetBase64KernelsScalar(bool scalar) {
+  g_force_scalar.store(scalar, std::memory_order_relaxed);
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,60 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_LIB_SLICE_B64_KERNELS_H
+#define GRPC_CORE_LIB_SLICE_B64_KERNELS_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace grpc_core {
+
+// Bulk base64 kernels shared by the chttp2 -bin metadata codecs and
+// src/core/lib/slice/b64.cc.
+//
+// Each kernel only handles whole groups (3 raw bytes <-> 4 base64 chars) and
+// returns the number of input bytes it consumed; callers deal with the tail,
+// padding and error reporting exactly as before. A vectorized implementation
+// is selected at runtime when the CPU supports it (currently SSSE3 on x86-64),
+// otherwise a portable scalar loop is used. Kernels never read or write
+// outside of the ranges they report as consumed/produced.
+
+// Encodes floor(len / 3) groups of `in` into `out` (4 chars per group) using
+// the standard or the url-safe alphabet. Does not write a terminator.
+size_t Base64EncodeGroups(const uint8_t* in, size_t len, bool url_safe,
+                          char* out);
+
+// Splits floor(len / 3) groups of `in` into their 6-bit values, one value
+// (0..63) per byte of `out`. This is the first half of base64 encoding, used
+// when the alphabet lookup is fused with another step (eg. huffman coding).
+size_t Base64SplitGroups(const uint8_t* in, size_t len, uint8_t* out);
+
+// Decodes groups of 4 characters from `in` into `out` (3 bytes per group),
+// stopping before the first group that contains anything outside of the
+// selected alphabet (including '=' padding and whitespace). Returns the number
+// of characters consumed, which is always a multiple of 4.
+size_t Base64DecodeGroups(const uint8_t* in, size_t len, bool url_safe,
+                          uint8_t* out);
+
+// Forces the scalar kernels regardless of CPU support, so that tests can check
+// that both implementations agree.
+void TestOnlySetBase64KernelsScalar(bool scalar);
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_SLICE_B64_KERNELS_H
@@ -21,6 +21,7 @@
 #include "src/core/lib/slice/percent_encoding.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 #include <cstdint>
 #include <type_traits>
@@ -30,6 +31,10 @@
 
 #include "src/core/lib/gprpp/bitset.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #if __cplusplus > 201103l
 #define GRPC_PCTENCODE_CONSTEXPR_FN constexpr
 #define GRPC_PCTENCODE_CONSTEXPR_VALUE constexpr
@@ -79,6 +84,55 @@ const BitSet<256>& LookupTableForPercentEncodingType(PercentEncodingType type) {
   // Crash if a bad PercentEncodingType was passed in.
   GPR_UNREACHABLE_CODE(abort());
 }
+
+#ifdef __SSE2__
+// Returns a mask of the bytes of chunk in [lo, hi]. The comparisons are
+// signed, so bytes >= 0x80 are never in a range of ASCII characters.
+__m128i InRange(__m128i chunk, char lo, char hi) {
+  return _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8(lo - 1)),
+                       _mm_cmplt_epi8(chunk, _mm_set1_epi8(hi + 1)));
+}
+
+// Returns a mask of the bytes of chunk that need no encoding.
+__m128i Unreserved(__m128i chunk, PercentEncodingType type) {
+  switch (type) {
+    case PercentEncodingType::URL: {
+      // Setting 0x20 folds upper case letters onto lower case ones.
+      __m128i lower = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+      __m128i mask = _mm_or_si128(InRange(lower, 'a', 'z'),
+                                  InRange(chunk, '0', '9'));
+      mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('-')));
+      mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('_')));
+      mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('.')));
+      return _mm_or_si128(mask, _mm_cmpeq_epi8(chunk, _mm_set1_epi8('~')));
+    }
+    case PercentEncodingType::Compatible:
+      return _mm_andnot_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('%')),
+                              InRange(chunk, 32, 126));
+  }
+  GPR_UNREACHABLE_CODE(abort());
+}
+#endif
+
+// Returns the length of the run of bytes at the start of [p, end) that need
+// no encoding.
+size_t UnreservedRunLength(const uint8_t* p, const uint8_t* end,
+                           PercentEncodingType type, const BitSet<256>& lut) {
+  const uint8_t* start = p;
+#ifdef __SSE2__
+  // 16 bytes at a time.
+  while (end - p >= 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    int reserved = ~_mm_movemask_epi8(Unreserved(chunk, type)) & 0xffff;
+    if (reserved != 0) return p - start + __builtin_ctz(reserved);
+    p += 16;
+  }
+#else
+  (void)type;
+#endif
+  while (p != end && lut.is_set(*p)) ++p;
+  return p - start;
+}
 }  // namespace
 
 Slice PercentEncodeSlice(Slice slice, PercentEncodingType type) {
@@ -86,29 +140,34 @@ Slice PercentEncodeSlice(Slice slice, PercentEncodingType type) {
 
   const BitSet<256>& lut = LookupTableForPercentEncodingType(type);
 
-  // first pass: count the number of bytes needed to output this string
-  size_t output_length = 0;
-  bool any_reserved_bytes = false;
-  for (uint8_t c : slice) {
-    bool unres = lut.is_set(c);
-    output_length += unres ? 1 : 3;
-    any_reserved_bytes |= !unres;
-  }
-  // no unreserved bytes: return the string unmodified
-  if (!any_reserved_bytes) {
+  const uint8_t* begin = slice.begin();
+  const uint8_t* end = slice.end();
+  // no reserved bytes: return the string unmodified
+  size_t run = UnreservedRunLength(begin, end, type, lut);
+  if (run == slice.size()) {
     return slice;
   }
-  // second pass: actually encode
+  // first pass: count the number of bytes needed to output this string
+  size_t output_length = slice.size();
+  for (const uint8_t* p = begin + run; p != end;
+       p += UnreservedRunLength(p, end, type, lut)) {
+    output_length += 2;
+    ++p;
+  }
+  // second pass: actually encode, copying the runs of unreserved bytes
+  // between the reserved ones whole
   auto out = MutableSlice::CreateUninitialized(output_length);
   uint8_t* q = out.begin();
-  for (uint8_t c : slice) {
-    if (lut.is_set(c)) {
-      *q++ = c;
-    } else {
-      *q++ = '%';
-      *q++ = hex[c >> 4];
-      *q++ = hex[c & 15];
-    }
+  for (const uint8_t* p = begin; p != end;) {
+    run = UnreservedRunLength(p, end, type, lut);
+    memcpy(q, p, run);
+    q += run;
+    p += run;
+    if (p == end) break;
+    const uint8_t c = *p++;
+    *q++ = '%';
+    *q++ = hex[c >> 4];
+    *q++ = hex[c & 15];
   }
   GPR_ASSERT(q == out.end());
   return Slice(std::move(out));
@@ -128,29 +187,30 @@ static uint8_t DeHex(uint8_t c) {
 }
 
 Slice PermissivePercentDecodeSlice(Slice slice_in) {
-  bool any_percent_encoded_stuff = false;
-  for (uint8_t c : slice_in) {
-    if (c == '%') {
-      any_percent_encoded_stuff = true;
-      break;
-    }
+  // memchr is vectorized by the C library.
+  if (slice_in.empty() ||
+      memchr(slice_in.begin(), '%', slice_in.size()) == nullptr) {
+    return slice_in;
   }
-  if (!any_percent_encoded_stuff) return slice_in;
 
   MutableSlice out = slice_in.TakeMutable();
   uint8_t* q = out.begin();
   const uint8_t* p = out.begin();
   const uint8_t* end = out.end();
   while (p != end) {
-    if (*p == '%') {
-      if (!ValidHex(p + 1, end) || !ValidHex(p + 2, end)) {
-        *q++ = *p++;
-      } else {
-        *q++ = static_cast<uint8_t>(DeHex(p[1]) << 4) | (DeHex(p[2]));
-        p += 3;
-      }
-    } else {
+    // Move the run of bytes up to the next '%' whole.
+    const uint8_t* percent =
+        static_cast<const uint8_t*>(memchr(p, '%', end - p));
+    const uint8_t* run_end = percent == nullptr ? end : percent;
+    if (q != p) memmove(q, p, run_end - p);
+    q += run_end - p;
+    p = run_end;
+    if (p == end) break;
+    if (!ValidHex(p + 1, end) || !ValidHex(p + 2, end)) {
       *q++ = *p++;
+    } else {
+      *q++ = static_cast<uint8_t>(DeHex(p[1]) << 4) | (DeHex(p[2]));
+      p += 3;
     }
   }
   return Slice(out.TakeSubSlice(0, q - out.begin()));
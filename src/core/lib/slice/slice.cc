@@ -214,6 +214,63 @@ grpc_slice grpc_slice_from_cpp_string(std::string str) {
   return slice;
 }
 
+namespace grpc_core {
+// grpc_slice_from_object() ref count: owns the object in place of bytes.
+class ObjectSliceRefCount : public grpc_slice_refcount {
+ public:
+  ObjectSliceRefCount(void* object, const void* type, void (*destroy)(void*))
+      : grpc_slice_refcount(Destroy),
+        object_(object),
+        type_(type),
+        destroy_(destroy) {}
+  ~ObjectSliceRefCount() { destroy_(object_); }
+
+  static void Destroy(grpc_slice_refcount* arg) {
+    delete static_cast<ObjectSliceRefCount*>(arg);
+  }
+
+  void* object() const { return object_; }
+  const void* type() const { return type_; }
+
+ private:
+  void* object_;
+  const void* type_;
+  void (*destroy_)(void*);
+};
+
+// The bytes of an object slice: a lone zero byte is not a valid protobuf
+// encoding, so a receiver that does not know about object slices fails to
+// parse the message instead of silently reading an empty one.
+const uint8_t kObjectSliceBytes[1] = {0};
+}  // namespace grpc_core
+
+grpc_slice grpc_slice_from_object(void* object, const void* type,
+                                  void (*destroy)(void*)) {
+  grpc_slice slice;
+  slice.refcount =
+      new grpc_core::ObjectSliceRefCount(object, type, destroy);
+  slice.data.refcounted.bytes =
+      const_cast<uint8_t*>(grpc_core::kObjectSliceBytes);
+  slice.data.refcounted.length = sizeof(grpc_core::kObjectSliceBytes);
+  return slice;
+}
+
+bool grpc_slice_is_object(const grpc_slice& slice) {
+  return slice.refcount != nullptr &&
+         slice.refcount != grpc_slice_refcount::NoopRefcount() &&
+         slice.refcount->HasDestroyer(grpc_core::ObjectSliceRefCount::Destroy);
+}
+
+void* grpc_slice_get_object(const grpc_slice& slice, const void** type,
+                            bool* unique) {
+  if (!grpc_slice_is_object(slice)) return nullptr;
+  auto* refcount =
+      static_cast<grpc_core::ObjectSliceRefCount*>(slice.refcount);
+  *type = refcount->type();
+  *unique = refcount->IsUnique();
+  return refcount->object();
+}
+
 grpc_slice grpc_slice_malloc_large(size_t length) {
   grpc_slice slice;
   uint8_t* memory = new uint8_t[sizeof(grpc_slice_refcount) + length];
@@ -22,7 +22,10 @@
 
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <new>
 #include <utility>
 
 #include <grpc/slice.h>
@@ -57,6 +60,83 @@ Slice SliceBuffer::RefSlice(size_t index) {
 
 }  // namespace grpc_core
 
+namespace {
+
+// Refcounted slices up to this long that are added after another small
+// slice are copied into a shared chunk, and the small slices added after
+// them are appended to it. A stream of small slices then takes a few
+// allocations and a few entries in the buffer rather than one of each per
+// slice.
+constexpr size_t kMaxCoalescedSliceLength = 128;
+// Chunks start small, so that a short run of small slices does not hold on
+// to much memory, and double while the run goes on.
+constexpr size_t kMinChunkCapacity = 512;
+constexpr size_t kMaxChunkCapacity = 4096;
+
+// The backing store of coalesced slices, followed by its bytes.
+struct SliceChunk {
+  explicit SliceChunk(size_t capacity)
+      : refcount(Destroy), capacity(capacity) {}
+
+  static void Destroy(grpc_slice_refcount* refcount) {
+    SliceChunk* chunk = reinterpret_cast<SliceChunk*>(refcount);
+    chunk->~SliceChunk();
+    gpr_free(chunk);
+  }
+
+  // Returns a slice of a new chunk holding a copy of s.
+  static grpc_slice Create(size_t capacity, const grpc_slice& s) {
+    SliceChunk* chunk = new (gpr_malloc(sizeof(SliceChunk) + capacity))
+        SliceChunk(capacity);
+    const size_t length = GRPC_SLICE_LENGTH(s);
+    memcpy(chunk->bytes(), GRPC_SLICE_START_PTR(s), length);
+    chunk->used.store(length, std::memory_order_relaxed);
+    grpc_slice slice;
+    slice.refcount = &chunk->refcount;
+    slice.data.refcounted.bytes = chunk->bytes();
+    slice.data.refcounted.length = length;
+    return slice;
+  }
+
+  // Returns the chunk that slice is backed by, or null if it is not backed
+  // by one.
+  static SliceChunk* FromSlice(const grpc_slice& slice) {
+    if (slice.refcount == nullptr ||
+        slice.refcount == grpc_slice_refcount::NoopRefcount() ||
+        !slice.refcount->HasDestroyer(Destroy)) {
+      return nullptr;
+    }
+    return reinterpret_cast<SliceChunk*>(slice.refcount);
+  }
+
+  // Appends a copy of s to back, a slice of this chunk, if back ends where
+  // the free bytes start and s fits in them.
+  bool TryAppend(grpc_slice* back, const grpc_slice& s) {
+    const size_t offset =
+        static_cast<size_t>(GRPC_SLICE_END_PTR(*back) - bytes());
+    const size_t length = GRPC_SLICE_LENGTH(s);
+    if (offset + length > capacity) return false;
+    // Slices of the chunk can be in several buffers, and each may end where
+    // the free bytes start: only one of them gets to claim the bytes.
+    size_t expected = offset;
+    if (!used.compare_exchange_strong(expected, offset + length,
+                                      std::memory_order_relaxed)) {
+      return false;
+    }
+    memcpy(bytes() + offset, GRPC_SLICE_START_PTR(s), length);
+    back->data.refcounted.length += length;
+    return true;
+  }
+
+  uint8_t* bytes() { return reinterpret_cast<uint8_t*>(this + 1); }
+
+  grpc_slice_refcount refcount;
+  std::atomic<size_t> used{0};
+  const size_t capacity;
+};
+
+}  // namespace
+
 /* grow a buffer; requires GRPC_SLICE_BUFFER_INLINE_ELEMENTS > 1 */
 #define GROW(x) (3 * (x) / 2)
 
@@ -156,6 +236,29 @@ size_t grpc_slice_buffer_add_indexed(grpc_slice_buffer* sb, grpc_slice s) {
   return out;
 }
 
+/* Copies s, a small refcounted slice, into a chunk, if back is a slice of
+   one or is small itself. Returns false if s should be added as it is. */
+static bool coalesce_small_slice(grpc_slice_buffer* sb, grpc_slice* back,
+                                 grpc_slice s) {
+  const size_t length = GRPC_SLICE_LENGTH(s);
+  if (length == 0) return false;
+  size_t capacity = kMinChunkCapacity;
+  SliceChunk* chunk = SliceChunk::FromSlice(*back);
+  if (chunk != nullptr) {
+    if (chunk->TryAppend(back, s)) {
+      sb->length += length;
+      grpc_slice_unref_internal(s);
+      return true;
+    }
+    capacity = std::min(2 * chunk->capacity, kMaxChunkCapacity);
+  } else if (GRPC_SLICE_LENGTH(*back) > kMaxCoalescedSliceLength) {
+    return false;
+  }
+  grpc_slice_buffer_add_indexed(sb, SliceChunk::Create(capacity, s));
+  grpc_slice_unref_internal(s);
+  return true;
+}
+
 void grpc_slice_buffer_add(grpc_slice_buffer* sb, grpc_slice s) {
   size_t n = sb->count;
   grpc_slice* back = nullptr;
@@ -175,6 +278,12 @@ void grpc_slice_buffer_add(grpc_slice_buffer* sb, grpc_slice s) {
     return;
   }
 
+  if (s.refcount != nullptr && back != nullptr &&
+      GRPC_SLICE_LENGTH(s) <= kMaxCoalescedSliceLength &&
+      coalesce_small_slice(sb, back, s)) {
+    return;
+  }
+
   if (!s.refcount && n) {
     /* if both the last slice in the slice buffer and the slice being added
      are inlined (that is, that they carry their data inside the slice data
@@ -74,6 +74,21 @@ grpc_slice grpc_slice_from_moved_buffer(grpc_core::UniquePtr<char> p,
 grpc_slice grpc_slice_from_moved_string(grpc_core::UniquePtr<char> p);
 grpc_slice grpc_slice_from_cpp_string(std::string str);
 
+// Object slices carry an in-memory message object in place of its serialized
+// bytes, for transports whose two ends share an address space (see
+// GRPC_ARG_INPROC_OBJECT_PASSING). The slice takes ownership of \a object and
+// passes it to \a destroy with the last ref; \a type identifies the kind of
+// object to whoever unwraps it.
+grpc_slice grpc_slice_from_object(void* object, const void* type,
+                                  void (*destroy)(void*));
+// Is \a slice an object slice?
+bool grpc_slice_is_object(const grpc_slice& slice);
+// Returns the object carried by \a slice, or nullptr if it is not an object
+// slice. Sets *type to its type and *unique to whether \a slice holds the
+// only ref to it, in which case the caller may take the object's contents.
+void* grpc_slice_get_object(const grpc_slice& slice, const void** type,
+                            bool* unique);
+
 // Returns the memory used by this slice, not counting the slice structure
 // itself. This means that inlined and slices from static strings will return
 // 0. All other slices will return the size of the allocated chars.
@@ -52,6 +52,12 @@ struct grpc_slice_refcount {
   // instance, no other instance could be created during this call.
   bool IsUnique() const { return ref_.load(std::memory_order_relaxed) == 1; }
 
+  // Was this refcount constructed with destroyer_fn? Lets the owner of a
+  // particular kind of refcount recognize slices backed by it.
+  bool HasDestroyer(DestroyerFn destroyer_fn) const {
+    return destroyer_fn_ == destroyer_fn;
+  }
+
  private:
   std::atomic<size_t> ref_{1};
   DestroyerFn destroyer_fn_ = nullptr;
@@ -105,6 +105,7 @@ class Call : public CppImplOf<Call, grpc_call> {
                                      bool is_notify_tag_closure) = 0;
   virtual bool failed_before_recv_message() const = 0;
   virtual bool is_trailers_only() const = 0;
+  virtual bool object_passing() const = 0;
   virtual void ExternalRef() = 0;
   virtual void ExternalUnref() = 0;
   virtual void InternalRef(const char* reason) = 0;
@@ -115,6 +116,14 @@ class Call : public CppImplOf<Call, grpc_call> {
   virtual uint32_t test_only_encodings_accepted_by_peer() = 0;
   virtual grpc_compression_algorithm compression_for_level(
       grpc_compression_level level) = 0;
+  virtual bool AddPreEncodedInitialMetadata(PreEncodedMetadata* md) = 0;
+
+  void set_max_buffered_receive_bytes(uint32_t max_bytes) {
+    max_buffered_receive_bytes_ = max_bytes;
+  }
+  uint32_t max_buffered_receive_bytes() const {
+    return max_buffered_receive_bytes_;
+  }
 
   // This should return nullptr for the promise stack (and alternative means
   // for that functionality be invented)
@@ -163,6 +172,9 @@ class Call : public CppImplOf<Call, grpc_call> {
   const bool is_client_;
   // flag indicating that cancellation is inherited
   bool cancellation_is_inherited_ = false;
+  // passed down with every recv_message op, see
+  // grpc_call_set_max_buffered_receive_bytes()
+  uint32_t max_buffered_receive_bytes_ = 0;
 };
 
 class FilterStackCall final : public Call {
@@ -225,6 +237,8 @@ class FilterStackCall final : public Call {
     return encodings_accepted_by_peer_.CompressionAlgorithmForLevel(level);
   }
 
+  bool AddPreEncodedInitialMetadata(PreEncodedMetadata* md) override;
+
   bool is_trailers_only() const override {
     bool result = is_trailers_only_;
     GPR_DEBUG_ASSERT(!result || recv_initial_metadata_.TransportSize() == 0);
@@ -235,6 +249,8 @@ class FilterStackCall final : public Call {
     return call_failed_before_recv_message_;
   }
 
+  bool object_passing() const override { return channel_->object_passing(); }
+
   grpc_compression_algorithm test_only_compression_algorithm() override {
     return incoming_compression_algorithm_;
   }
@@ -291,6 +307,9 @@ class FilterStackCall final : public Call {
     } completion_data_;
     grpc_closure start_batch_;
     grpc_closure finish_batch_;
+    // Does this batch continue a message partly delivered in chunks (rather
+    // than passing a recv_message op down to the transport)?
+    bool continues_recv_message_ = false;
     std::atomic<intptr_t> steps_to_complete_{0};
     AtomicError batch_error_;
     void set_num_steps_to_complete(uintptr_t steps) {
@@ -302,7 +321,9 @@ class FilterStackCall final : public Call {
 
     void PostCompletion();
     void FinishStep();
+    void StartReceivingSlices();
     void ContinueReceivingSlices();
+    void FinishReceivingMessage(bool message_complete);
     void ReceivingSliceReady(grpc_error_handle error);
     void ProcessDataAfterMetadata();
     void ReceivingStreamReady(grpc_error_handle error);
@@ -328,7 +349,8 @@ class FilterStackCall final : public Call {
   }
 
   void ExecuteBatch(grpc_transport_stream_op_batch* batch,
-                    grpc_closure* start_batch_closure);
+                    grpc_closure* start_batch_closure,
+                    bool inline_if_idle = false);
   void SetFinalStatus(grpc_error_handle error);
   BatchControl* ReuseOrAllocateBatchControl(const grpc_op* ops);
   void HandleCompressionAlgorithmDisabled(
@@ -395,9 +417,20 @@ class FilterStackCall final : public Call {
 
   ManualConstructor<SliceBufferByteStream> sending_stream_;
 
+  // A chunk of a message received with GRPC_RECV_MESSAGE_CHUNKED is delivered
+  // once at least this many bytes of it have arrived.
+  static constexpr size_t kRecvMessageChunkSize = 64 * 1024;
+
   OrphanablePtr<ByteStream> receiving_stream_;
   bool call_failed_before_recv_message_ = false;
   grpc_byte_buffer** receiving_buffer_ = nullptr;
+  // Is the pending recv_message op chunked, and where to report whether the
+  // chunk it returns ends the message.
+  bool receiving_chunked_ = false;
+  int* receiving_message_complete_ = nullptr;
+  // Bytes of the message in receiving_stream_ delivered by earlier chunks;
+  // non-zero exactly while a message is partly delivered.
+  size_t receiving_message_offset_ = 0;
   grpc_slice receiving_slice_ = grpc_empty_slice();
   grpc_closure receiving_slice_ready_;
   grpc_closure receiving_stream_ready_;
@@ -563,6 +596,8 @@ grpc_error_handle FilterStackCall::Create(grpc_call_create_args* args,
     call->final_op_.server.cancelled = nullptr;
     call->final_op_.server.core_server = args->server;
   }
+  GRPC_USDT_PROBE(call_create, call->call_stack(), call->is_client(),
+                  GRPC_SLICE_START_PTR(path), GRPC_SLICE_LENGTH(path));
 
   Call* parent = Call::FromC(args->parent);
   if (parent != nullptr) {
@@ -662,6 +697,9 @@ void FilterStackCall::DestroyCall(void* call, grpc_error_handle /*error*/) {
   c->status_error_.set(GRPC_ERROR_NONE);
   c->final_info_.stats.latency =
       gpr_cycle_counter_sub(gpr_get_cycle_counter(), c->start_time_);
+  GRPC_USDT_PROBE(call_end, c->call_stack(), c->final_info_.final_status,
+                  static_cast<int64_t>(
+                      gpr_timespec_to_micros(c->final_info_.stats.latency)));
   grpc_call_stack_destroy(c->call_stack(), &c->final_info_,
                           GRPC_CLOSURE_INIT(&c->release_call_, ReleaseCall, c,
                                             grpc_schedule_on_exec_ctx));
@@ -723,9 +761,11 @@ char* FilterStackCall::GetPeer() {
 }
 
 // start_batch_closure points to a caller-allocated closure to be used
-// for entering the call combiner.
+// for entering the call combiner. If inline_if_idle is true and the call
+// combiner is idle, the batch is started inline instead.
 void FilterStackCall::ExecuteBatch(grpc_transport_stream_op_batch* batch,
-                                   grpc_closure* start_batch_closure) {
+                                   grpc_closure* start_batch_closure,
+                                   bool inline_if_idle) {
   // This is called via the call combiner to start sending a batch down
   // the filter stack.
   auto execute_batch_in_call_combiner = [](void* arg, grpc_error_handle) {
@@ -739,6 +779,11 @@ void FilterStackCall::ExecuteBatch(grpc_transport_stream_op_batch* batch,
     elem->filter->start_transport_stream_op_batch(elem, batch);
   };
   batch->handler_private.extra_arg = this;
+  if (inline_if_idle &&
+      call_combiner()->TryStartInline("executing batch inline")) {
+    execute_batch_in_call_combiner(batch, GRPC_ERROR_NONE);
+    return;
+  }
   GRPC_CLOSURE_INIT(start_batch_closure, execute_batch_in_call_combiner, batch,
                     grpc_schedule_on_exec_ctx);
   GRPC_CALL_COMBINER_START(call_combiner(), start_batch_closure,
@@ -868,6 +913,30 @@ bool FilterStackCall::PrepareApplicationMetadata(size_t count,
   return true;
 }
 
+bool FilterStackCall::AddPreEncodedInitialMetadata(PreEncodedMetadata* md) {
+  GPR_ASSERT(is_client() && !sent_initial_metadata_);
+  grpc_slice key = md->RefKeySlice();
+  grpc_slice value = md->RefValueSlice();
+  bool ok = GRPC_LOG_IF_ERROR("validate_metadata",
+                              grpc_validate_header_key_is_legal(key)) &&
+            (grpc_is_binary_header_internal(key) ||
+             GRPC_LOG_IF_ERROR(
+                 "validate_metadata",
+                 grpc_validate_header_nonbin_value_is_legal(value))) &&
+            GRPC_SLICE_LENGTH(value) < UINT32_MAX;
+  grpc_slice_unref_internal(key);
+  if (!ok) {
+    grpc_slice_unref_internal(value);
+    return false;
+  }
+  send_initial_metadata_.Append(
+      md->key(), Slice(value), [md](absl::string_view error, const Slice&) {
+        gpr_log(GPR_DEBUG, "Append error: %s",
+                absl::StrCat("key=", md->key(), " error=", error).c_str());
+      });
+  return true;
+}
+
 namespace {
 class PublishToAppEncoder {
  public:
@@ -1094,7 +1163,8 @@ void FilterStackCall::BatchControl::PostCompletion() {
     GRPC_ERROR_UNREF(error);
     error = GRPC_ERROR_NONE;
   }
-  if (error != GRPC_ERROR_NONE && op_.recv_message &&
+  if (error != GRPC_ERROR_NONE &&
+      (op_.recv_message || continues_recv_message_) &&
       *call->receiving_buffer_ != nullptr) {
     grpc_byte_buffer_destroy(*call->receiving_buffer_);
     *call->receiving_buffer_ = nullptr;
@@ -1128,16 +1198,29 @@ void FilterStackCall::BatchControl::FinishStep() {
   }
 }
 
+void FilterStackCall::BatchControl::StartReceivingSlices() {
+  GRPC_CLOSURE_INIT(
+      &call_->receiving_slice_ready_,
+      [](void* bctl, grpc_error_handle error) {
+        static_cast<BatchControl*>(bctl)->ReceivingSliceReady(error);
+      },
+      this, grpc_schedule_on_exec_ctx);
+  ContinueReceivingSlices();
+}
+
 void FilterStackCall::BatchControl::ContinueReceivingSlices() {
   grpc_error_handle error;
   FilterStackCall* call = call_;
   for (;;) {
+    size_t received = (*call->receiving_buffer_)->data.raw.slice_buffer.length;
     size_t remaining = call->receiving_stream_->length() -
-                       (*call->receiving_buffer_)->data.raw.slice_buffer.length;
+                       call->receiving_message_offset_ - received;
     if (remaining == 0) {
-      call->receiving_message_ = false;
-      call->receiving_stream_.reset();
-      FinishStep();
+      FinishReceivingMessage(true);
+      return;
+    }
+    if (call->receiving_chunked_ && received >= kRecvMessageChunkSize) {
+      FinishReceivingMessage(false);
       return;
     }
     if (call->receiving_stream_->Next(remaining,
@@ -1148,11 +1231,9 @@ void FilterStackCall::BatchControl::ContinueReceivingSlices() {
             &(*call->receiving_buffer_)->data.raw.slice_buffer,
             call->receiving_slice_);
       } else {
-        call->receiving_stream_.reset();
         grpc_byte_buffer_destroy(*call->receiving_buffer_);
         *call->receiving_buffer_ = nullptr;
-        call->receiving_message_ = false;
-        FinishStep();
+        FinishReceivingMessage(true);
         GRPC_ERROR_UNREF(error);
         return;
       }
@@ -1162,6 +1243,26 @@ void FilterStackCall::BatchControl::ContinueReceivingSlices() {
   }
 }
 
+// Completes the pending recv_message op with the buffer received so far. If
+// the message is not complete, receiving_stream_ is kept for the next
+// recv_message op to continue from.
+void FilterStackCall::BatchControl::FinishReceivingMessage(
+    bool message_complete) {
+  FilterStackCall* call = call_;
+  if (message_complete) {
+    call->receiving_stream_.reset();
+    call->receiving_message_offset_ = 0;
+  } else {
+    call->receiving_message_offset_ +=
+        (*call->receiving_buffer_)->data.raw.slice_buffer.length;
+  }
+  if (call->receiving_message_complete_ != nullptr) {
+    *call->receiving_message_complete_ = message_complete;
+  }
+  call->receiving_message_ = false;
+  FinishStep();
+}
+
 void FilterStackCall::BatchControl::ReceivingSliceReady(
     grpc_error_handle error) {
   FilterStackCall* call = call_;
@@ -1184,11 +1285,9 @@ void FilterStackCall::BatchControl::ReceivingSliceReady(
     if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_operation_failures)) {
       GRPC_LOG_IF_ERROR("receiving_slice_ready", GRPC_ERROR_REF(error));
     }
-    call->receiving_stream_.reset();
     grpc_byte_buffer_destroy(*call->receiving_buffer_);
     *call->receiving_buffer_ = nullptr;
-    call->receiving_message_ = false;
-    FinishStep();
+    FinishReceivingMessage(true);
     if (release_error) {
       GRPC_ERROR_UNREF(error);
     }
@@ -1199,24 +1298,22 @@ void FilterStackCall::BatchControl::ProcessDataAfterMetadata() {
   FilterStackCall* call = call_;
   if (call->receiving_stream_ == nullptr) {
     *call->receiving_buffer_ = nullptr;
-    call->receiving_message_ = false;
-    FinishStep();
+    FinishReceivingMessage(true);
   } else {
+    GRPC_USDT_PROBE(message_received, call->call_stack(),
+                    call->receiving_stream_->length(),
+                    call->receiving_stream_->flags());
     call->test_only_last_message_flags_ = call->receiving_stream_->flags();
     if ((call->receiving_stream_->flags() & GRPC_WRITE_INTERNAL_COMPRESS) &&
         (call->incoming_compression_algorithm_ != GRPC_COMPRESS_NONE)) {
       *call->receiving_buffer_ = grpc_raw_compressed_byte_buffer_create(
           nullptr, 0, call->incoming_compression_algorithm_);
+      // A compressed message can only be decompressed as a whole.
+      call->receiving_chunked_ = false;
     } else {
       *call->receiving_buffer_ = grpc_raw_byte_buffer_create(nullptr, 0);
     }
-    GRPC_CLOSURE_INIT(
-        &call->receiving_slice_ready_,
-        [](void* bctl, grpc_error_handle error) {
-          static_cast<BatchControl*>(bctl)->ReceivingSliceReady(error);
-        },
-        this, grpc_schedule_on_exec_ctx);
-    ContinueReceivingSlices();
+    StartReceivingSlices();
   }
 }
 
@@ -1376,6 +1473,7 @@ grpc_call_error FilterStackCall::StartBatch(const grpc_op* ops, size_t nops,
   grpc_transport_stream_op_batch* stream_op;
   grpc_transport_stream_op_batch_payload* stream_op_payload;
   uint32_t seen_ops = 0;
+  bool continue_recv_message = false;
 
   for (i = 0; i < nops; i++) {
     if (seen_ops & (1u << ops[i].op)) {
@@ -1642,8 +1740,8 @@ grpc_call_error FilterStackCall::StartBatch(const grpc_op* ops, size_t nops,
         break;
       }
       case GRPC_OP_RECV_MESSAGE: {
-        /* Flag validation: currently allow no flags */
-        if (op->flags != 0) {
+        /* Flag validation: check that only valid flags were set */
+        if ((op->flags & ~GRPC_RECV_MESSAGE_USED_MASK) != 0) {
           error = GRPC_CALL_ERROR_INVALID_FLAGS;
           goto done_with_error;
         }
@@ -1652,8 +1750,19 @@ grpc_call_error FilterStackCall::StartBatch(const grpc_op* ops, size_t nops,
           goto done_with_error;
         }
         receiving_message_ = true;
-        stream_op->recv_message = true;
         receiving_buffer_ = op->data.recv_message.recv_message;
+        receiving_chunked_ = (op->flags & GRPC_RECV_MESSAGE_CHUNKED) != 0;
+        receiving_message_complete_ =
+            receiving_chunked_ ? op->data.recv_message.message_complete
+                               : nullptr;
+        if (receiving_message_offset_ != 0) {
+          // The rest of a partly delivered message: keep reading it from
+          // receiving_stream_ instead of asking the transport for a message.
+          continue_recv_message = true;
+          ++num_recv_ops;
+          break;
+        }
+        stream_op->recv_message = true;
         stream_op_payload->recv_message.recv_message = &receiving_stream_;
         stream_op_payload->recv_message.call_failed_before_recv_message =
             &call_failed_before_recv_message_;
@@ -1671,6 +1780,8 @@ grpc_call_error FilterStackCall::StartBatch(const grpc_op* ops, size_t nops,
             bctl, grpc_schedule_on_exec_ctx);
         stream_op_payload->recv_message.recv_message_ready =
             &receiving_stream_ready_;
+        stream_op_payload->recv_message.max_buffered_bytes =
+            max_buffered_receive_bytes();
         ++num_recv_ops;
         break;
       }
@@ -1765,8 +1876,24 @@ grpc_call_error FilterStackCall::StartBatch(const grpc_op* ops, size_t nops,
     stream_op->on_complete = &bctl->finish_batch_;
   }
 
+  bctl->continues_recv_message_ = continue_recv_message;
+
   gpr_atm_rel_store(&any_ops_sent_atm_, 1);
-  ExecuteBatch(stream_op, &bctl->start_batch_);
+  if (has_send_ops || num_recv_ops > (continue_recv_message ? 1 : 0)) {
+    // A client batch that carries the whole of a unary call, from the initial
+    // metadata to the trailing metadata, normally only contends for the call
+    // combiner with a racing cancellation: start it inline when nothing else
+    // holds the call combiner, rather than by scheduling a closure.
+    const bool whole_unary_call = is_client() && !continue_recv_message &&
+                                  stream_op->send_initial_metadata &&
+                                  stream_op->send_trailing_metadata &&
+                                  stream_op->recv_trailing_metadata;
+    ExecuteBatch(stream_op, &bctl->start_batch_, whole_unary_call);
+  }
+  if (continue_recv_message) {
+    *receiving_buffer_ = grpc_raw_byte_buffer_create(nullptr, 0);
+    bctl->StartReceivingSlices();
+  }
 
 done:
   return error;
@@ -1791,7 +1918,7 @@ done_with_error:
   if (stream_op->recv_initial_metadata) {
     received_initial_metadata_ = false;
   }
-  if (stream_op->recv_message) {
+  if (stream_op->recv_message || continue_recv_message) {
     receiving_message_ = false;
   }
   if (stream_op->recv_trailing_metadata) {
@@ -1938,6 +2065,20 @@ bool grpc_call_is_trailers_only(const grpc_call* call) {
   return grpc_core::Call::FromC(call)->is_trailers_only();
 }
 
+bool grpc_call_add_pre_encoded_initial_metadata(
+    grpc_call* call, grpc_core::PreEncodedMetadata* md) {
+  return grpc_core::Call::FromC(call)->AddPreEncodedInitialMetadata(md);
+}
+
+bool grpc_call_object_passing(grpc_call* call) {
+  return grpc_core::Call::FromC(call)->object_passing();
+}
+
+void grpc_call_set_max_buffered_receive_bytes(grpc_call* call,
+                                              uint32_t max_bytes) {
+  grpc_core::Call::FromC(call)->set_max_buffered_receive_bytes(max_bytes);
+}
+
 int grpc_call_failed_before_recv_message(const grpc_call* c) {
   return grpc_core::Call::FromC(c)->failed_before_recv_message();
 }
@@ -43,6 +43,7 @@
 #include "src/core/lib/surface/api_trace.h"
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/surface/server.h"
+#include "src/core/lib/transport/metadata_batch.h"
 
 typedef void (*grpc_ioreq_completion_func)(grpc_call* call, int success,
                                            void* user_data);
@@ -125,6 +126,36 @@ grpc_compression_algorithm grpc_call_compression_for_level(
                     Move to surface API if requested by other languages. */
 bool grpc_call_is_trailers_only(const grpc_call* call);
 
+/* Append the pre-encoded metadata element \a md to the initial metadata a
+   client \a call will send. Must be called before the send_initial_metadata op
+   is started. Returns false, leaving the call untouched, if \a md is not valid
+   custom metadata. The call takes its own refs on \a md's slices, so the
+   caller may drop \a md once this returns. This backs
+   grpc::ClientContext::AddMetadata(const grpc::PreEncodedMetadata&), and is
+   not in grpc.h since grpc_core::PreEncodedMetadata is a C++ type. */
+bool grpc_call_add_pre_encoded_initial_metadata(
+    grpc_call* call, grpc_core::PreEncodedMetadata* md);
+
+/* May messages sent on \a call be wrapped as object slices (see
+   grpc_slice_from_object()) rather than serialized? True on channels created
+   with GRPC_ARG_INPROC_OBJECT_PASSING, for both the client and the server end
+   of a call, unless the channel sets a default compression level or
+   algorithm. The C++ API asks this through CoreCodegenInterface before
+   sending a message that no interceptor will see. */
+bool grpc_call_object_passing(grpc_call* call);
+
+/* Bound the number of bytes of \a call's incoming stream that the transport
+   lets the peer send ahead of the application's reads to \a max_bytes, or
+   remove the bound if \a max_bytes is 0. Applies to the recv_message ops
+   started after this call. The peer may still send up to the connection's
+   initial window size before the bound first takes effect. The bound rides
+   on each recv_message op as max_buffered_bytes; chttp2 turns it into the
+   stream's flow control window, and other transports ignore it. Backs the
+   set_max_buffered_receive_bytes() of grpc::ClientContext and
+   grpc::ServerContext. */
+void grpc_call_set_max_buffered_receive_bytes(grpc_call* call,
+                                              uint32_t max_bytes);
+
 extern grpc_core::TraceFlag grpc_call_error_trace;
 extern grpc_core::TraceFlag grpc_compression_trace;
 
@@ -67,12 +67,18 @@ Channel::Channel(bool is_client, std::string target, ChannelArgs channel_args,
                  RefCountedPtr<grpc_channel_stack> channel_stack)
     : is_client_(is_client),
       compression_options_(compression_options),
+      inline_callback_reactions_(
+          channel_args.GetInt(GRPC_ARG_INLINE_CALLBACK_REACTIONS).value_or(0)),
+      object_passing_(
+          channel_args.GetBool(GRPC_ARG_OBJECT_PASSING_PEER).value_or(false) &&
+          !compression_options.default_level.is_set &&
+          !compression_options.default_algorithm.is_set),
       call_size_estimate_(channel_stack->call_stack_size +
                           grpc_call_get_initial_size_estimate()),
       channelz_node_(channel_args.GetObjectRef<channelz::ChannelNode>()),
       allocator_(channel_args.GetObject<ResourceQuota>()
                      ->memory_quota()
-                     ->CreateMemoryOwner(target)),
+                     ->CreateMemoryOwner(target, MemoryCategory::kCallArena)),
       target_(std::move(target)),
       channel_stack_(std::move(channel_stack)) {
   // We need to make sure that grpc_shutdown() does not shut things down
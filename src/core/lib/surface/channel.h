@@ -54,6 +54,10 @@
 #include "src/core/lib/slice/slice.h"
 #include "src/core/lib/surface/channel_stack_type.h"
 
+/// Set by transports whose peer is in the same address space and can take
+/// message objects in place of their bytes (see grpc_slice_from_object()).
+#define GRPC_ARG_OBJECT_PASSING_PEER "grpc.internal.object_passing_peer"
+
 /** The same as grpc_channel_destroy, but doesn't create an ExecCtx, and so
  * is safe to use from within core. */
 void grpc_channel_destroy_internal(grpc_channel* channel);
@@ -139,6 +143,12 @@ class Channel : public RefCounted<Channel>,
   absl::string_view target() const { return target_; }
   MemoryAllocator* allocator() { return &allocator_; }
   bool is_client() const { return is_client_; }
+  // Value of GRPC_ARG_INLINE_CALLBACK_REACTIONS, for the C++ callback API.
+  int inline_callback_reactions() const { return inline_callback_reactions_; }
+  // Can calls on this channel send message objects to their peer? Only when
+  // the transport set GRPC_ARG_OBJECT_PASSING_PEER and the channel does not
+  // compress by default.
+  bool object_passing() const { return object_passing_; }
   RegisteredCall* RegisterCall(const char* method, const char* host);
 
   int TestOnlyRegisteredCalls() {
@@ -158,6 +168,8 @@ class Channel : public RefCounted<Channel>,
 
   const bool is_client_;
   const grpc_compression_options compression_options_;
+  const int inline_callback_reactions_;
+  const bool object_passing_;
   std::atomic<size_t> call_size_estimate_;
   CallRegistrationTable registration_table_;
   RefCountedPtr<channelz::ChannelNode> channelz_node_;
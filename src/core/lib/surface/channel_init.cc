@@ -22,8 +22,43 @@
 
 #include <algorithm>
 
+#include "absl/strings/str_cat.h"
+#include "absl/types/variant.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/channel/channel_args.h"
+
 namespace grpc_core {
 
+namespace {
+
+// Bounds the memory held by the cache when channel args keep changing, e.g.
+// because of a per-connection arg.
+constexpr size_t kMaxCachedStacks = 256;
+
+// Identifies the filter list that the subchannel stages build. Values are
+// length-prefixed so that no two keys collide. Pointer args only count by
+// name: stages may not depend on what they point to.
+std::string StackCacheKey(absl::string_view transport_name,
+                          const ChannelArgs& args) {
+  std::string key = absl::StrCat(transport_name.size(), ":", transport_name);
+  args.ForEach([&key](const std::string& name,
+                      const ChannelArgs::Value& value) {
+    absl::StrAppend(&key, name.size(), ":", name);
+    if (const int* i = absl::get_if<int>(&value)) {
+      absl::StrAppend(&key, "i", *i, ";");
+    } else if (const std::string* s = absl::get_if<std::string>(&value)) {
+      absl::StrAppend(&key, "s", s->size(), ":", *s);
+    } else {
+      key.push_back('p');
+    }
+  });
+  return key;
+}
+
+}  // namespace
+
 void ChannelInit::Builder::RegisterStage(grpc_channel_stack_type type,
                                          int priority, Stage stage) {
   slots_[type].emplace_back(std::move(stage), priority);
@@ -52,4 +87,27 @@ bool ChannelInit::CreateStack(ChannelStackBuilder* builder) const {
   return true;
 }
 
+bool ChannelInit::CreateStackCached(ChannelStackBuilder* builder,
+                                    absl::string_view transport_name) const {
+  GPR_ASSERT(builder->channel_stack_type() == GRPC_CLIENT_SUBCHANNEL);
+  // Stages that find filters in the builder already may build on them.
+  if (!builder->mutable_stack()->empty()) return CreateStack(builder);
+  std::string key = StackCacheKey(transport_name, builder->channel_args());
+  {
+    MutexLock lock(&stack_cache_->mu);
+    auto it = stack_cache_->stacks.find(key);
+    if (it != stack_cache_->stacks.end()) {
+      *builder->mutable_stack() = it->second;
+      return true;
+    }
+  }
+  if (!CreateStack(builder)) return false;
+  MutexLock lock(&stack_cache_->mu);
+  if (stack_cache_->stacks.size() >= kMaxCachedStacks) {
+    stack_cache_->stacks.clear();
+  }
+  stack_cache_->stacks.emplace(std::move(key), *builder->mutable_stack());
+  return true;
+}
+
 }  // namespace grpc_core
@@ -22,10 +22,18 @@
 #include <grpc/support/port_platform.h>
 
 #include <functional>
+#include <map>
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+
 #include "src/core/lib/channel/channel_stack_builder.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/surface/channel_stack_type.h"
 
 #define GRPC_CHANNEL_INIT_BUILTIN_PRIORITY 10000
@@ -54,7 +62,10 @@ class ChannelInit {
     /// ensure that subchannels with different filter lists will always have
     /// different channel args. This requires setting a channel arg in case the
     /// registration function relies on some condition other than channel args
-    /// to decide whether to add a filter or not.
+    /// to decide whether to add a filter or not. Such stages may look at the
+    /// kind of transport and at the presence of pointer args, but not at the
+    /// objects that pointer args point to: the filter lists they build are
+    /// cached by CreateStackCached().
     void RegisterStage(grpc_channel_stack_type type, int priority, Stage stage);
 
     /// Finalize registration. No more calls to grpc_channel_init_register_stage
@@ -75,8 +86,24 @@ class ChannelInit {
   /// \a builder is the channel stack builder to build into.
   bool CreateStack(ChannelStackBuilder* builder) const;
 
+  /// Same as CreateStack(), for GRPC_CLIENT_SUBCHANNEL stacks, whose filter
+  /// lists only depend on the channel args and on the kind of transport,
+  /// named by \a transport_name. The stages run once per distinct args and
+  /// transport; later builds copy the filter list they produced.
+  bool CreateStackCached(ChannelStackBuilder* builder,
+                         absl::string_view transport_name) const;
+
  private:
+  // Filter lists built by CreateStackCached(), by stack type, transport and
+  // channel args.
+  struct StackCache {
+    Mutex mu;
+    std::map<std::string, std::vector<const grpc_channel_filter*>> stacks
+        ABSL_GUARDED_BY(mu);
+  };
+
   std::vector<Stage> slots_[GRPC_NUM_CHANNEL_STACK_TYPES];
+  std::unique_ptr<StackCache> stack_cache_ = absl::make_unique<StackCache>();
 };
 
 }  // namespace grpc_core
@@ -338,6 +338,10 @@ struct cq_callback_data {
 
   /** A callback that gets invoked when the CQ completes shutdown */
   grpc_completion_queue_functor* shutdown_callback;
+
+  /** If > 0, every callback is treated as inlineable, up to this many per
+      ApplicationCallbackExecCtx (see grpc_cq_set_inline_callbacks) */
+  std::atomic<int> inline_callback_max_depth{0};
 };
 
 }  // namespace
@@ -581,6 +585,12 @@ grpc_cq_completion_type grpc_get_cq_completion_type(grpc_completion_queue* cq) {
   return cq->vtable->cq_completion_type;
 }
 
+void grpc_cq_set_inline_callbacks(grpc_completion_queue* cq, int max_depth) {
+  GPR_ASSERT(cq->vtable->cq_completion_type == GRPC_CQ_CALLBACK);
+  cq_callback_data* cqd = static_cast<cq_callback_data*> DATA_FROM_CQ(cq);
+  cqd->inline_callback_max_depth.store(max_depth, std::memory_order_relaxed);
+}
+
 int grpc_get_cq_poll_num(grpc_completion_queue* cq) {
   int cur_num_polls;
   gpr_mu_lock(cq->mu);
@@ -835,6 +845,13 @@ static void functor_callback(void* arg, grpc_error_handle error) {
 }
 
 /* Complete an event on a completion queue of type GRPC_CQ_CALLBACK */
+static bool cq_try_inline_callback(cq_callback_data* cqd) {
+  int max_depth =
+      cqd->inline_callback_max_depth.load(std::memory_order_relaxed);
+  return max_depth > 0 && grpc_core::ApplicationCallbackExecCtx::Available() &&
+         grpc_core::ApplicationCallbackExecCtx::TryInline(max_depth);
+}
+
 static void cq_end_op_for_callback(
     grpc_completion_queue* cq, void* tag, grpc_error_handle error,
     void (*done)(void* done_arg, grpc_cq_completion* storage), void* done_arg,
@@ -874,10 +891,13 @@ static void cq_end_op_for_callback(
   // 2. The callback is marked inlineable and there is an ACEC available
   // 3. We are already running in a background poller thread (which always has
   //    an ACEC available at the base of the stack).
+  // 4. The CQ runs all callbacks inline, there is an ACEC available and it
+  //    has not yet run its share of such callbacks.
   auto* functor = static_cast<grpc_completion_queue_functor*>(tag);
   if (((internal || functor->inlineable) &&
        grpc_core::ApplicationCallbackExecCtx::Available()) ||
-      grpc_iomgr_is_any_background_poller_thread()) {
+      grpc_iomgr_is_any_background_poller_thread() ||
+      cq_try_inline_callback(cqd)) {
     grpc_core::ApplicationCallbackExecCtx::Enqueue(functor,
                                                    (error == GRPC_ERROR_NONE));
     GRPC_ERROR_UNREF(error);
@@ -959,24 +979,23 @@ static void dump_pending_tags(grpc_completion_queue* cq) {
 static void dump_pending_tags(grpc_completion_queue* /*cq*/) {}
 #endif
 
-static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
-                          void* reserved) {
-  GPR_TIMER_SCOPE("grpc_completion_queue_next", 0);
+static void cq_fill_next_event(grpc_cq_completion* c, grpc_event* ev) {
+  ev->type = GRPC_OP_COMPLETE;
+  ev->success = c->next & 1u;
+  ev->tag = c->tag;
+  c->done(c->done_arg, c);
+}
 
-  grpc_event ret;
+/* Shared body of cq_next and grpc_completion_queue_next_batch: blocks like
+   grpc_completion_queue_next until the first event is available, then drains
+   up to max_events - 1 more completions that are already queued without
+   polling again. Returns the number of events written to events (at least
+   one). */
+static size_t cq_next_events(grpc_completion_queue* cq, grpc_event* events,
+                             size_t max_events, gpr_timespec deadline) {
+  size_t num_events = 0;
   cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
 
-  GRPC_API_TRACE(
-      "grpc_completion_queue_next("
-      "cq=%p, "
-      "deadline=gpr_timespec { tv_sec: %" PRId64
-      ", tv_nsec: %d, clock_type: %d }, "
-      "reserved=%p)",
-      5,
-      (cq, deadline.tv_sec, deadline.tv_nsec, (int)deadline.clock_type,
-       reserved));
-  GPR_ASSERT(!reserved);
-
   dump_pending_tags(cq);
 
   GRPC_CQ_INTERNAL_REF(cq, "next");
@@ -997,20 +1016,14 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
     if (is_finished_arg.stolen_completion != nullptr) {
       grpc_cq_completion* c = is_finished_arg.stolen_completion;
       is_finished_arg.stolen_completion = nullptr;
-      ret.type = GRPC_OP_COMPLETE;
-      ret.success = c->next & 1u;
-      ret.tag = c->tag;
-      c->done(c->done_arg, c);
+      cq_fill_next_event(c, &events[num_events++]);
       break;
     }
 
     grpc_cq_completion* c = cqd->queue.Pop();
 
     if (c != nullptr) {
-      ret.type = GRPC_OP_COMPLETE;
-      ret.success = c->next & 1u;
-      ret.tag = c->tag;
-      c->done(c->done_arg, c);
+      cq_fill_next_event(c, &events[num_events++]);
       break;
     } else {
       /* If c == NULL it means either the queue is empty OR in an transient
@@ -1036,15 +1049,17 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
         continue;
       }
 
-      ret.type = GRPC_QUEUE_SHUTDOWN;
-      ret.success = 0;
+      events[num_events].type = GRPC_QUEUE_SHUTDOWN;
+      events[num_events].success = 0;
+      num_events++;
       break;
     }
 
     if (!is_finished_arg.first_loop &&
         grpc_core::ExecCtx::Get()->Now() >= deadline_millis) {
-      ret.type = GRPC_QUEUE_TIMEOUT;
-      ret.success = 0;
+      events[num_events].type = GRPC_QUEUE_TIMEOUT;
+      events[num_events].success = 0;
+      num_events++;
       dump_pending_tags(cq);
       break;
     }
@@ -1061,17 +1076,29 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
               grpc_error_std_string(err).c_str());
       GRPC_ERROR_UNREF(err);
       if (err == GRPC_ERROR_CANCELLED) {
-        ret.type = GRPC_QUEUE_SHUTDOWN;
+        events[num_events].type = GRPC_QUEUE_SHUTDOWN;
       } else {
-        ret.type = GRPC_QUEUE_TIMEOUT;
+        events[num_events].type = GRPC_QUEUE_TIMEOUT;
       }
-      ret.success = 0;
+      events[num_events].success = 0;
+      num_events++;
       dump_pending_tags(cq);
       break;
     }
     is_finished_arg.first_loop = false;
   }
 
+  /* Once an operation completed, hand back whatever else is already queued
+     rather than making the caller come back (and possibly poll) for each of
+     them. Pop() may spuriously return NULL; the kick below covers that. */
+  if (events[0].type == GRPC_OP_COMPLETE) {
+    while (num_events < max_events) {
+      grpc_cq_completion* c = cqd->queue.Pop();
+      if (c == nullptr) break;
+      cq_fill_next_event(c, &events[num_events++]);
+    }
+  }
+
   if (cqd->queue.num_items() > 0 &&
       cqd->pending_events.load(std::memory_order_acquire) > 0) {
     gpr_mu_lock(cq->mu);
@@ -1079,11 +1106,33 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
     gpr_mu_unlock(cq->mu);
   }
 
-  GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &ret);
+  for (size_t i = 0; i < num_events; i++) {
+    GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &events[i]);
+  }
   GRPC_CQ_INTERNAL_UNREF(cq, "next");
 
   GPR_ASSERT(is_finished_arg.stolen_completion == nullptr);
 
+  return num_events;
+}
+
+static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
+                          void* reserved) {
+  GPR_TIMER_SCOPE("grpc_completion_queue_next", 0);
+
+  GRPC_API_TRACE(
+      "grpc_completion_queue_next("
+      "cq=%p, "
+      "deadline=gpr_timespec { tv_sec: %" PRId64
+      ", tv_nsec: %d, clock_type: %d }, "
+      "reserved=%p)",
+      5,
+      (cq, deadline.tv_sec, deadline.tv_nsec, (int)deadline.clock_type,
+       reserved));
+  GPR_ASSERT(!reserved);
+
+  grpc_event ret;
+  cq_next_events(cq, &ret, 1, deadline);
   return ret;
 }
 
@@ -1134,6 +1183,28 @@ grpc_event grpc_completion_queue_next(grpc_completion_queue* cq,
   return cq->vtable->next(cq, deadline, reserved);
 }
 
+size_t grpc_completion_queue_next_batch(grpc_completion_queue* cq,
+                                        grpc_event* events, size_t max_events,
+                                        gpr_timespec deadline,
+                                        void* reserved) {
+  GPR_TIMER_SCOPE("grpc_completion_queue_next_batch", 0);
+
+  GRPC_API_TRACE(
+      "grpc_completion_queue_next_batch("
+      "cq=%p, events=%p, max_events=%" PRIuPTR ", "
+      "deadline=gpr_timespec { tv_sec: %" PRId64
+      ", tv_nsec: %d, clock_type: %d }, "
+      "reserved=%p)",
+      7,
+      (cq, events, max_events, deadline.tv_sec, deadline.tv_nsec,
+       (int)deadline.clock_type, reserved));
+  GPR_ASSERT(!reserved);
+  GPR_ASSERT(max_events > 0);
+  GPR_ASSERT(cq->vtable->cq_completion_type == GRPC_CQ_NEXT);
+
+  return cq_next_events(cq, events, max_events, deadline);
+}
+
 static int add_plucker(grpc_completion_queue* cq, void* tag,
                        grpc_pollset_worker** worker) {
   cq_pluck_data* cqd = static_cast<cq_pluck_data*> DATA_FROM_CQ(cq);
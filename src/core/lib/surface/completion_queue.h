@@ -95,6 +95,14 @@ grpc_cq_completion_type grpc_get_cq_completion_type(grpc_completion_queue* cq);
 
 int grpc_get_cq_poll_num(grpc_completion_queue* cq);
 
+/* Makes a GRPC_CQ_CALLBACK completion queue run all of its callbacks on the
+   thread that completed the operation (through that thread's
+   ApplicationCallbackExecCtx) rather than handing them to the executor, as if
+   they were all inlineable. At most max_depth callbacks are run this way per
+   ApplicationCallbackExecCtx, bounding how long a chain of reactions can hold
+   on to one thread; the rest go to the executor. 0 disables. */
+void grpc_cq_set_inline_callbacks(grpc_completion_queue* cq, int max_depth);
+
 grpc_completion_queue* grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type,
     grpc_completion_queue_functor* shutdown_callback);
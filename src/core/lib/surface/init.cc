@@ -38,6 +38,7 @@
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/log_async.h"
 #include "src/core/lib/gprpp/fork.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/thd.h"
@@ -81,7 +82,7 @@ static bool maybe_prepend_client_auth_filter(
 static bool maybe_prepend_server_auth_filter(
     grpc_core::ChannelStackBuilder* builder) {
   if (builder->channel_args().Contains(GRPC_SERVER_CREDENTIALS_ARG)) {
-    builder->PrependFilter(&grpc_server_auth_filter);
+    builder->PrependFilter(&grpc_core::ServerAuthFilter::kFilter);
   }
   return true;
 }
@@ -190,6 +191,7 @@ void grpc_shutdown_internal_locked(void)
     grpc_core::Fork::GlobalShutdown();
   }
   grpc_core::ApplicationCallbackExecCtx::GlobalShutdown();
+  gpr_async_log_flush();
   g_shutting_down = false;
   g_shutting_down_cv->SignalAll();
 }
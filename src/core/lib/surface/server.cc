@@ -27,11 +27,17 @@
 #include <list>
 #include <new>
 #include <queue>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
 #include <grpc/byte_buffer.h>
@@ -141,6 +147,230 @@ struct Server::RegisteredMethod {
   std::unique_ptr<RequestMatcherInterface> matcher;
 };
 
+//
+// Server::RegisteredMethodTable
+//
+
+// Maps the (host, path) of an incoming call to its registered method. Built
+// by Start(), once the set of methods is fixed, as two perfect hash tables
+// (methods registered for a specific host, and for any host) using hash and
+// displace: keys are grouped into buckets by their hash, and each bucket gets
+// a displacement that sends all of its keys to distinct free slots. A lookup
+// then checks exactly one slot per table.
+class Server::RegisteredMethodTable {
+ public:
+  explicit RegisteredMethodTable(
+      const std::vector<std::unique_ptr<RegisteredMethod>>& methods) {
+    std::vector<Entry> with_host;
+    std::vector<Entry> without_host;
+    for (const std::unique_ptr<RegisteredMethod>& rm : methods) {
+      Entry entry;
+      entry.method.server_registered_method = rm.get();
+      entry.method.flags = rm->flags;
+      entry.method.has_host = !rm->host.empty();
+      entry.method.method = Slice::FromExternalString(rm->method);
+      if (entry.method.has_host) {
+        entry.method.host = Slice::FromExternalString(rm->host.c_str());
+        entry.hash = MixHash32(entry.method.host.Hash(),
+                               entry.method.method.Hash());
+        with_host.push_back(std::move(entry));
+      } else {
+        entry.hash = MixHash32(0, entry.method.method.Hash());
+        without_host.push_back(std::move(entry));
+      }
+    }
+    with_host_.Build(std::move(with_host));
+    without_host_.Build(std::move(without_host));
+  }
+
+  ChannelRegisteredMethod* Find(const grpc_slice& host,
+                                const grpc_slice& path) {
+    uint32_t path_hash = grpc_slice_hash_internal(path);
+    /* check for an exact match with host */
+    ChannelRegisteredMethod* rm = with_host_.Find(
+        MixHash32(grpc_slice_hash_internal(host), path_hash), &host, path);
+    if (rm != nullptr) return rm;
+    /* check for a wildcard method definition (no host set) */
+    return without_host_.Find(MixHash32(0, path_hash), nullptr, path);
+  }
+
+ private:
+  struct Entry {
+    uint32_t hash = 0;
+    ChannelRegisteredMethod method;
+  };
+
+  class PerfectHashTable {
+   public:
+    void Build(std::vector<Entry> entries) {
+      if (entries.empty()) return;
+      const size_t num_slots = entries.size();
+      std::vector<std::vector<Entry*>> buckets(num_slots);
+      for (Entry& entry : entries) {
+        buckets[entry.hash % num_slots].push_back(&entry);
+      }
+      // Place the largest buckets first, while most slots are still free.
+      std::vector<size_t> order(num_slots);
+      for (size_t i = 0; i < num_slots; i++) order[i] = i;
+      std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return buckets[a].size() > buckets[b].size();
+      });
+      displacements_.assign(num_slots, 0);
+      slots_.resize(num_slots);
+      std::vector<bool> used(num_slots, false);
+      std::vector<size_t> candidate;
+      for (size_t b : order) {
+        if (buckets[b].empty()) break;
+        bool placed = false;
+        // Keys whose hashes collide entirely can never be separated; give up
+        // on a bucket after a bounded search and keep its keys aside.
+        for (uint32_t d = 0; d < 64 * num_slots + 64 && !placed; d++) {
+          candidate.clear();
+          placed = true;
+          for (Entry* entry : buckets[b]) {
+            size_t slot = Slot(entry->hash, d);
+            if (used[slot] || std::find(candidate.begin(), candidate.end(),
+                                        slot) != candidate.end()) {
+              placed = false;
+              break;
+            }
+            candidate.push_back(slot);
+          }
+          if (placed) {
+            displacements_[b] = d;
+            for (size_t i = 0; i < candidate.size(); i++) {
+              used[candidate[i]] = true;
+              slots_[candidate[i]] = std::move(*buckets[b][i]);
+            }
+          }
+        }
+        if (!placed) {
+          for (Entry* entry : buckets[b]) {
+            overflow_.push_back(std::move(*entry));
+          }
+        }
+      }
+    }
+
+    ChannelRegisteredMethod* Find(uint32_t hash, const grpc_slice* host,
+                                  const grpc_slice& path) {
+      if (slots_.empty()) return nullptr;
+      Entry* entry =
+          &slots_[Slot(hash, displacements_[hash % displacements_.size()])];
+      if (Matches(*entry, hash, host, path)) return &entry->method;
+      for (Entry& e : overflow_) {
+        if (Matches(e, hash, host, path)) return &e.method;
+      }
+      return nullptr;
+    }
+
+   private:
+    size_t Slot(uint32_t hash, uint32_t displacement) const {
+      // murmur3's finalizer, so that every displacement gives an unrelated
+      // slot assignment.
+      uint32_t x = hash ^ (displacement * 0x9e3779b9u);
+      x ^= x >> 16;
+      x *= 0x85ebca6bu;
+      x ^= x >> 13;
+      x *= 0xc2b2ae35u;
+      x ^= x >> 16;
+      return x % slots_.size();
+    }
+
+    static bool Matches(const Entry& entry, uint32_t hash,
+                        const grpc_slice* host, const grpc_slice& path) {
+      return entry.method.server_registered_method != nullptr &&
+             entry.hash == hash && entry.method.method == path &&
+             (host == nullptr || entry.method.host == *host);
+    }
+
+    std::vector<uint32_t> displacements_;
+    std::vector<Entry> slots_;
+    std::vector<Entry> overflow_;
+  };
+
+  PerfectHashTable with_host_;
+  PerfectHashTable without_host_;
+};
+
+//
+// Server::QosPolicy
+//
+
+constexpr size_t Server::QosPolicy::kNumClasses;
+constexpr size_t Server::QosPolicy::kDefaultClass;
+
+Server::QosPolicy::QosPolicy(const ChannelArgs& args)
+    : queueing_delay_target_(
+          args.GetDurationFromIntMillis(
+                  GRPC_ARG_SERVER_QOS_QUEUEING_DELAY_TARGET_MS)
+              .value_or(Duration::Zero())) {
+  absl::optional<absl::string_view> metadata_key =
+      args.GetString(GRPC_ARG_SERVER_QOS_CLASS_METADATA_KEY);
+  if (metadata_key.has_value() && !metadata_key->empty()) {
+    metadata_key_ = std::string(*metadata_key);
+  }
+  absl::optional<absl::string_view> classes =
+      args.GetString(GRPC_ARG_SERVER_QOS_CLASSES);
+  if (!classes.has_value()) return;
+  for (absl::string_view entry :
+       absl::StrSplit(*classes, ',', absl::SkipWhitespace())) {
+    std::pair<absl::string_view, absl::string_view> path_and_class =
+        absl::StrSplit(entry, absl::MaxSplits('=', 1));
+    absl::string_view path = absl::StripAsciiWhitespace(path_and_class.first);
+    absl::optional<size_t> qos_class = ParseClass(path_and_class.second);
+    if (path.empty() || !qos_class.has_value()) {
+      gpr_log(GPR_ERROR, "Ignoring invalid %s entry \"%s\"",
+              GRPC_ARG_SERVER_QOS_CLASSES, std::string(entry).c_str());
+      continue;
+    }
+    if (path == "*") {
+      default_class_ = *qos_class;
+    } else if (absl::EndsWith(path, "/*")) {
+      service_classes_[std::string(path.substr(0, path.size() - 2))] =
+          *qos_class;
+    } else {
+      method_classes_[std::string(path)] = *qos_class;
+    }
+  }
+}
+
+absl::optional<size_t> Server::QosPolicy::ParseClass(
+    absl::string_view value) {
+  size_t qos_class;
+  if (!absl::SimpleAtoi(absl::StripAsciiWhitespace(value), &qos_class) ||
+      qos_class >= kNumClasses) {
+    return absl::nullopt;
+  }
+  return qos_class;
+}
+
+size_t Server::QosPolicy::ClassForCall(
+    absl::string_view path, const grpc_metadata_array& metadata) const {
+  if (metadata_key_.has_value()) {
+    for (size_t i = 0; i < metadata.count; ++i) {
+      if (StringViewFromSlice(metadata.metadata[i].key) != *metadata_key_) {
+        continue;
+      }
+      absl::optional<size_t> qos_class =
+          ParseClass(StringViewFromSlice(metadata.metadata[i].value));
+      if (qos_class.has_value()) return *qos_class;
+      break;
+    }
+  }
+  if (method_classes_.empty() && service_classes_.empty()) {
+    return default_class_;
+  }
+  auto it = method_classes_.find(path);
+  if (it != method_classes_.end()) return it->second;
+  size_t slash = path.rfind('/');
+  if (slash != absl::string_view::npos && slash > 0) {
+    it = service_classes_.find(path.substr(0, slash));
+    if (it != service_classes_.end()) return it->second;
+  }
+  return default_class_;
+}
+
 //
 // Server::RequestMatcherInterface
 //
@@ -197,6 +427,7 @@ class Server::RequestMatcherInterface {
 // application to explicitly request RPCs and then matching those to incoming
 // RPCs, along with a slow path by which incoming RPCs are put on a locked
 // pending list if they aren't able to be matched to an application request.
+// Pending RPCs are matched by QoS class, then in arrival order.
 class Server::RealRequestMatcher : public RequestMatcherInterface {
  public:
   explicit RealRequestMatcher(Server* server)
@@ -209,11 +440,14 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
   }
 
   void ZombifyPending() override {
-    while (!pending_.empty()) {
-      CallData* calld = pending_.front();
-      calld->SetState(CallData::CallState::ZOMBIED);
-      calld->KillZombie();
-      pending_.pop();
+    for (std::queue<PendingCall>& pending : pending_) {
+      while (!pending.empty()) {
+        CallData* calld = pending.front().calld;
+        calld->SetState(CallData::CallState::ZOMBIED);
+        calld->KillZombie();
+        pending.pop();
+        num_pending_.fetch_sub(1, std::memory_order_relaxed);
+      }
     }
   }
 
@@ -235,29 +469,37 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
   void RequestCallWithPossiblePublish(size_t request_queue_index,
                                       RequestedCall* call) override {
     if (requests_per_cq_[request_queue_index].Push(&call->mpscq_node)) {
-      /* this was the first queued request: we need to lock and start
-         matching calls */
-      struct PendingCall {
+      /* this was the first queued request: if calls are waiting we need to
+         lock and start matching them. Pairs with the fence in MatchOrQueue:
+         either we see its pending call here, or it sees our request when it
+         rescans the queues under the lock. */
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (num_pending_.load(std::memory_order_relaxed) == 0) return;
+      struct MatchedCall {
         RequestedCall* rc = nullptr;
         CallData* calld;
       };
       auto pop_next_pending = [this, request_queue_index] {
-        PendingCall pending_call;
+        MatchedCall pending_call;
+        std::vector<CallData*> shed;
         {
           MutexLock lock(&server_->mu_call_);
-          if (!pending_.empty()) {
+          ShedExpiredLocked(&shed);
+          CallData** front = FrontPendingLocked();
+          if (front != nullptr) {
             pending_call.rc = reinterpret_cast<RequestedCall*>(
                 requests_per_cq_[request_queue_index].Pop());
             if (pending_call.rc != nullptr) {
-              pending_call.calld = pending_.front();
-              pending_.pop();
+              pending_call.calld = *front;
+              PopFrontPendingLocked();
             }
           }
         }
+        ShedCalls(shed);
         return pending_call;
       };
       while (true) {
-        PendingCall next_pending = pop_next_pending();
+        MatchedCall next_pending = pop_next_pending();
         if (next_pending.rc == nullptr) break;
         if (!next_pending.calld->MaybeActivate()) {
           // Zombied Call
@@ -287,12 +529,17 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
     // We need to ensure that all the queues are empty.  We do this under
     // the server mu_call_ lock to ensure that if something is added to
     // an empty request queue, it will block until the call is actually
-    // added to the pending list.
+    // added to the pending list. Requesters only take that lock when they
+    // see num_pending_ != 0, so announce the call before rescanning.
     RequestedCall* rc = nullptr;
     size_t cq_idx = 0;
     size_t loop_count;
+    const size_t qos_class = calld->QosClass();
+    std::vector<CallData*> shed;
     {
       MutexLock lock(&server_->mu_call_);
+      num_pending_.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
       for (loop_count = 0; loop_count < requests_per_cq_.size(); loop_count++) {
         cq_idx =
             (start_request_queue_index + loop_count) % requests_per_cq_.size();
@@ -302,11 +549,17 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
         }
       }
       if (rc == nullptr) {
+        ShedExpiredLocked(&shed);
         calld->SetState(CallData::CallState::PENDING);
-        pending_.push(calld);
-        return;
+        pending_[qos_class].push({calld, ExecCtx::Get()->Now()});
+      } else {
+        num_pending_.fetch_sub(1, std::memory_order_relaxed);
       }
     }
+    if (rc == nullptr) {
+      ShedCalls(shed);
+      return;
+    }
     GRPC_STATS_INC_SERVER_CQS_CHECKED(loop_count + requests_per_cq_.size());
     calld->SetState(CallData::CallState::ACTIVATED);
     calld->Publish(cq_idx, rc);
@@ -315,8 +568,70 @@ class Server::RealRequestMatcher : public RequestMatcherInterface {
   Server* server() const override { return server_; }
 
  private:
+  struct PendingCall {
+    CallData* calld;
+    Timestamp queued_at;
+  };
+
+  // Returns the pending call to match next, or null if there is none.
+  CallData** FrontPendingLocked()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(server_->mu_call_) {
+    for (std::queue<PendingCall>& pending : pending_) {
+      if (!pending.empty()) return &pending.front().calld;
+    }
+    return nullptr;
+  }
+
+  void PopFrontPendingLocked()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(server_->mu_call_) {
+    for (std::queue<PendingCall>& pending : pending_) {
+      if (!pending.empty()) {
+        pending.pop();
+        num_pending_.fetch_sub(1, std::memory_order_relaxed);
+        return;
+      }
+    }
+  }
+
+  // Removes the pending calls of classes other than 0 that have waited
+  // longer than the queueing delay target, and adds them to shed. Since
+  // lower classes are matched last, their calls are the first to expire.
+  void ShedExpiredLocked(std::vector<CallData*>* shed)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(server_->mu_call_) {
+    const Duration target = server_->qos_policy_.queueing_delay_target();
+    if (target == Duration::Zero()) return;
+    const Timestamp expired = ExecCtx::Get()->Now() - target;
+    for (size_t qos_class = QosPolicy::kNumClasses - 1; qos_class > 0;
+         --qos_class) {
+      std::queue<PendingCall>& pending = pending_[qos_class];
+      while (!pending.empty() && pending.front().queued_at < expired) {
+        shed->push_back(pending.front().calld);
+        pending.pop();
+        num_pending_.fetch_sub(1, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  static void ShedCalls(const std::vector<CallData*>& shed) {
+    for (CallData* calld : shed) {
+      if (!calld->MaybeActivate()) {
+        // Zombied Call
+        calld->KillZombie();
+      } else {
+        GRPC_STATS_INC_SERVER_QOS_CALLS_SHED();
+        calld->Shed();
+      }
+    }
+  }
+
   Server* const server_;
-  std::queue<CallData*> pending_;
+  // Pending calls by QoS class.
+  std::queue<PendingCall> pending_[QosPolicy::kNumClasses];
+  // Number of pending_ calls plus calls that are about to check whether they
+  // need to join them. Only changed under server_->mu_call_, but read
+  // without it so that requests need not take the lock while no calls are
+  // waiting.
+  std::atomic<size_t> num_pending_{0};
   std::vector<LockedMultiProducerSingleConsumerQueue> requests_per_cq_;
 };
 
@@ -536,10 +851,27 @@ RefCountedPtr<channelz::ServerNode> CreateChannelzNode(ChannelArgs args) {
   return channelz_node;
 }
 
+void* channelz_node_copy(void* p) {
+  static_cast<channelz::ServerNode*>(p)->Ref().release();
+  return p;
+}
+void channelz_node_destroy(void* p) {
+  static_cast<channelz::ServerNode*>(p)->Unref();
+}
+int channelz_node_cmp(void* p1, void* p2) { return QsortCompare(p1, p2); }
+const grpc_arg_pointer_vtable channelz_node_arg_vtable = {
+    channelz_node_copy, channelz_node_destroy, channelz_node_cmp};
+
 }  // namespace
 
 Server::Server(ChannelArgs args)
-    : channel_args_(args.ToC()), channelz_node_(CreateChannelzNode(args)) {}
+    : channel_args_(args.ToC()),
+      channelz_node_(CreateChannelzNode(args)),
+      assign_least_loaded_cq_(args.GetString(GRPC_ARG_SERVER_CQ_ASSIGNMENT) ==
+                              "least_loaded"),
+      migrate_from_hot_cqs_(
+          args.GetBool(GRPC_ARG_SERVER_CQ_MIGRATION).value_or(false)),
+      qos_policy_(args) {}
 
 Server::~Server() {
   grpc_channel_args_destroy(channel_args_);
@@ -567,11 +899,18 @@ void Server::AddListener(OrphanablePtr<ListenerInterface> listener) {
 
 void Server::Start() {
   started_ = true;
-  for (grpc_completion_queue* cq : cqs_) {
-    if (grpc_cq_can_listen(cq)) {
-      pollsets_.push_back(grpc_cq_pollset(cq));
+  for (size_t i = 0; i < cqs_.size(); i++) {
+    if (grpc_cq_can_listen(cqs_[i])) {
+      pollsets_.push_back(grpc_cq_pollset(cqs_[i]));
+      listening_cq_idxs_.push_back(i);
     }
   }
+  if (listening_cq_idxs_.empty()) {
+    for (size_t i = 0; i < cqs_.size(); i++) listening_cq_idxs_.push_back(i);
+  }
+  if (assign_least_loaded_cq_ || migrate_from_hot_cqs_) {
+    cq_loads_ = absl::make_unique<CqLoad[]>(cqs_.size());
+  }
   if (unregistered_request_matcher_ == nullptr) {
     unregistered_request_matcher_ = absl::make_unique<RealRequestMatcher>(this);
   }
@@ -580,6 +919,10 @@ void Server::Start() {
       rm->matcher = absl::make_unique<RealRequestMatcher>(this);
     }
   }
+  if (!registered_methods_.empty()) {
+    registered_method_table_ =
+        absl::make_unique<RegisteredMethodTable>(registered_methods_);
+  }
   {
     MutexLock lock(&mu_global_);
     starting_ = true;
@@ -607,8 +950,16 @@ grpc_error_handle Server::SetupTransport(
     const grpc_channel_args* args,
     const RefCountedPtr<channelz::SocketNode>& socket_node) {
   // Create channel.
+  ChannelArgs channel_args = ChannelArgs::FromC(args);
+  if (channelz_node_ != nullptr) {
+    channel_args = channel_args.Set(
+        GRPC_ARG_CHANNELZ_SERVER_NODE,
+        ChannelArgs::Pointer(static_cast<channelz::ServerNode*>(
+                                 channelz_node_->Ref().release()),
+                             &channelz_node_arg_vtable));
+  }
   absl::StatusOr<RefCountedPtr<Channel>> channel = Channel::Create(
-      nullptr, ChannelArgs::FromC(args), GRPC_SERVER_CHANNEL, transport);
+      nullptr, std::move(channel_args), GRPC_SERVER_CHANNEL, transport);
   if (!channel.ok()) {
     return absl_status_to_grpc_error(channel.status());
   }
@@ -616,12 +967,17 @@ grpc_error_handle Server::SetupTransport(
       grpc_channel_stack_element((*channel)->channel_stack(), 0)->channel_data);
   // Set up CQs.
   size_t cq_idx;
-  for (cq_idx = 0; cq_idx < cqs_.size(); cq_idx++) {
-    if (grpc_cq_pollset(cqs_[cq_idx]) == accepting_pollset) break;
-  }
-  if (cq_idx == cqs_.size()) {
-    // Completion queue not found.  Pick a random one to publish new calls to.
-    cq_idx = static_cast<size_t>(rand()) % cqs_.size();
+  if (assign_least_loaded_cq_) {
+    cq_idx = LeastLoadedCq();
+  } else {
+    for (cq_idx = 0; cq_idx < cqs_.size(); cq_idx++) {
+      if (grpc_cq_pollset(cqs_[cq_idx]) == accepting_pollset) break;
+    }
+    if (cq_idx == cqs_.size()) {
+      // Completion queue not found.  Pick a random one to publish new calls
+      // to.
+      cq_idx = static_cast<size_t>(rand()) % cqs_.size();
+    }
   }
   // Set up channelz node.
   intptr_t channelz_socket_uuid = 0;
@@ -635,6 +991,45 @@ grpc_error_handle Server::SetupTransport(
   return GRPC_ERROR_NONE;
 }
 
+size_t Server::LeastLoadedCq() const {
+  size_t best = 0;
+  size_t best_calls = SIZE_MAX;
+  size_t best_channels = SIZE_MAX;
+  for (size_t idx : listening_cq_idxs_) {
+    const CqLoad& load = cq_loads_[idx];
+    size_t calls = load.active_calls.load(std::memory_order_relaxed);
+    size_t channels = load.channels.load(std::memory_order_relaxed);
+    if (calls < best_calls ||
+        (calls == best_calls && channels < best_channels)) {
+      best = idx;
+      best_calls = calls;
+      best_channels = channels;
+    }
+  }
+  return best;
+}
+
+size_t Server::CqForNewCall(ChannelData* chand) {
+  size_t cq_idx = chand->cq_idx();
+  if (!migrate_from_hot_cqs_) return cq_idx;
+  // A CQ is hot when it has twice the calls of the least loaded one, and
+  // enough more that moving does not just trade places with it.
+  constexpr size_t kMinCallsGap = 8;
+  size_t least_loaded = LeastLoadedCq();
+  size_t calls = cq_loads_[cq_idx].active_calls.load(std::memory_order_relaxed);
+  size_t least_loaded_calls =
+      cq_loads_[least_loaded].active_calls.load(std::memory_order_relaxed);
+  if (calls < kMinCallsGap + least_loaded_calls ||
+      calls < 2 * least_loaded_calls) {
+    return cq_idx;
+  }
+  if (chand->MoveToCq(cq_idx, least_loaded)) {
+    cq_loads_[cq_idx].channels.fetch_sub(1, std::memory_order_relaxed);
+    cq_loads_[least_loaded].channels.fetch_add(1, std::memory_order_relaxed);
+  }
+  return chand->cq_idx();
+}
+
 bool Server::HasOpenConnections() {
   MutexLock lock(&mu_global_);
   return !channels_.empty();
@@ -991,7 +1386,6 @@ class Server::ChannelData::ConnectivityWatcher
 //
 
 Server::ChannelData::~ChannelData() {
-  registered_methods_.reset();
   if (server_ != nullptr) {
     if (server_->channelz_node_ != nullptr && channelz_socket_uuid_ != 0) {
       server_->channelz_node_->RemoveChildSocket(channelz_socket_uuid_);
@@ -1004,6 +1398,10 @@ Server::ChannelData::~ChannelData() {
       }
       server_->MaybeFinishShutdown();
     }
+    if (server_->cq_loads_ != nullptr) {
+      server_->cq_loads_[cq_idx()].channels.fetch_sub(
+          1, std::memory_order_relaxed);
+    }
   }
 }
 
@@ -1014,42 +1412,10 @@ void Server::ChannelData::InitTransport(RefCountedPtr<Server> server,
                                         intptr_t channelz_socket_uuid) {
   server_ = std::move(server);
   channel_ = channel;
-  cq_idx_ = cq_idx;
+  cq_idx_.store(cq_idx, std::memory_order_relaxed);
   channelz_socket_uuid_ = channelz_socket_uuid;
-  // Build a lookup table phrased in terms of mdstr's in this channels context
-  // to quickly find registered methods.
-  size_t num_registered_methods = server_->registered_methods_.size();
-  if (num_registered_methods > 0) {
-    uint32_t max_probes = 0;
-    size_t slots = 2 * num_registered_methods;
-    registered_methods_ =
-        absl::make_unique<std::vector<ChannelRegisteredMethod>>(slots);
-    for (std::unique_ptr<RegisteredMethod>& rm : server_->registered_methods_) {
-      Slice host;
-      Slice method = Slice::FromExternalString(rm->method);
-      const bool has_host = !rm->host.empty();
-      if (has_host) {
-        host = Slice::FromExternalString(rm->host.c_str());
-      }
-      uint32_t hash = MixHash32(has_host ? host.Hash() : 0, method.Hash());
-      uint32_t probes = 0;
-      for (probes = 0; (*registered_methods_)[(hash + probes) % slots]
-                           .server_registered_method != nullptr;
-           probes++) {
-      }
-      if (probes > max_probes) max_probes = probes;
-      ChannelRegisteredMethod* crm =
-          &(*registered_methods_)[(hash + probes) % slots];
-      crm->server_registered_method = rm.get();
-      crm->flags = rm->flags;
-      crm->has_host = has_host;
-      if (has_host) {
-        crm->host = std::move(host);
-      }
-      crm->method = std::move(method);
-    }
-    GPR_ASSERT(slots <= UINT32_MAX);
-    registered_method_max_probes_ = max_probes;
+  if (server_->cq_loads_ != nullptr) {
+    server_->cq_loads_[cq_idx].channels.fetch_add(1, std::memory_order_relaxed);
   }
   // Publish channel.
   {
@@ -1070,33 +1436,15 @@ void Server::ChannelData::InitTransport(RefCountedPtr<Server> server,
   grpc_transport_perform_op(transport, op);
 }
 
+bool Server::ChannelData::MoveToCq(size_t expected_cq_idx, size_t new_cq_idx) {
+  return cq_idx_.compare_exchange_strong(expected_cq_idx, new_cq_idx,
+                                         std::memory_order_relaxed);
+}
+
 Server::ChannelRegisteredMethod* Server::ChannelData::GetRegisteredMethod(
     const grpc_slice& host, const grpc_slice& path) {
-  if (registered_methods_ == nullptr) return nullptr;
-  /* TODO(ctiller): unify these two searches */
-  /* check for an exact match with host */
-  uint32_t hash =
-      MixHash32(grpc_slice_hash_internal(host), grpc_slice_hash_internal(path));
-  for (size_t i = 0; i <= registered_method_max_probes_; i++) {
-    ChannelRegisteredMethod* rm =
-        &(*registered_methods_)[(hash + i) % registered_methods_->size()];
-    if (rm->server_registered_method == nullptr) break;
-    if (!rm->has_host) continue;
-    if (rm->host != host) continue;
-    if (rm->method != path) continue;
-    return rm;
-  }
-  /* check for a wildcard method definition (no host set) */
-  hash = MixHash32(0, grpc_slice_hash_internal(path));
-  for (size_t i = 0; i <= registered_method_max_probes_; i++) {
-    ChannelRegisteredMethod* rm =
-        &(*registered_methods_)[(hash + i) % registered_methods_->size()];
-    if (rm->server_registered_method == nullptr) break;
-    if (rm->has_host) continue;
-    if (rm->method != path) continue;
-    return rm;
-  }
-  return nullptr;
+  if (server_->registered_method_table_ == nullptr) return nullptr;
+  return server_->registered_method_table_->Find(host, path);
 }
 
 void Server::ChannelData::AcceptStream(void* arg, grpc_transport* /*transport*/,
@@ -1188,6 +1536,10 @@ Server::CallData::CallData(grpc_call_element* elem,
 
 Server::CallData::~CallData() {
   GPR_ASSERT(state_.load(std::memory_order_relaxed) != CallState::PENDING);
+  if (loaded_cq_idx_.has_value()) {
+    server_->cq_loads_[*loaded_cq_idx_].active_calls.fetch_sub(
+        1, std::memory_order_relaxed);
+  }
   GRPC_ERROR_UNREF(recv_initial_metadata_error_);
   grpc_metadata_array_destroy(&initial_metadata_);
   grpc_byte_buffer_destroy(payload_);
@@ -1219,6 +1571,19 @@ void Server::CallData::FailCallCreation() {
   }
 }
 
+void Server::CallData::Shed() {
+  grpc_call_cancel_with_status(call_, GRPC_STATUS_RESOURCE_EXHAUSTED,
+                               "Server queueing delay target exceeded",
+                               nullptr);
+  KillZombie();
+}
+
+size_t Server::CallData::QosClass() const {
+  return server_->qos_policy_.ClassForCall(
+      path_.has_value() ? path_->as_string_view() : absl::string_view(),
+      initial_metadata_);
+}
+
 void Server::CallData::Start(grpc_call_element* elem) {
   grpc_op op;
   op.op = GRPC_OP_RECV_INITIAL_METADATA;
@@ -1236,6 +1601,11 @@ void Server::CallData::Publish(size_t cq_idx, RequestedCall* rc) {
   grpc_call_set_completion_queue(call_, rc->cq_bound_to_call);
   *rc->call = call_;
   cq_new_ = server_->cqs_[cq_idx];
+  if (server_->cq_loads_ != nullptr) {
+    server_->cq_loads_[cq_idx].active_calls.fetch_add(
+        1, std::memory_order_relaxed);
+    loaded_cq_idx_ = cq_idx;
+  }
   std::swap(*rc->initial_metadata, initial_metadata_);
   switch (rc->type) {
     case RequestedCall::Type::BATCH_CALL:
@@ -1274,7 +1644,7 @@ void Server::CallData::PublishNewRpc(void* arg, grpc_error_handle error) {
     calld->KillZombie();
     return;
   }
-  rm->MatchOrQueue(chand->cq_idx(), calld);
+  rm->MatchOrQueue(server->CqForNewCall(chand), calld);
 }
 
 namespace {
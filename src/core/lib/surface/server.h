@@ -31,8 +31,10 @@
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/memory/memory.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 #include "absl/synchronization/notification.h"
 #include "absl/types/optional.h"
 
@@ -123,6 +125,37 @@ class Server : public InternallyRefCounted<Server>,
     virtual void SetOnDestroyDone(grpc_closure* on_destroy_done) = 0;
   };
 
+  // Assigns the calls waiting to be requested by the application to QoS
+  // classes, per the GRPC_ARG_SERVER_QOS_* channel args. Waiting calls of
+  // class 0 are matched first, then class 1, etc.
+  class QosPolicy {
+   public:
+    static constexpr size_t kNumClasses = 4;
+    // The class of calls not assigned one.
+    static constexpr size_t kDefaultClass = 1;
+
+    explicit QosPolicy(const ChannelArgs& args);
+
+    size_t ClassForCall(absl::string_view path,
+                        const grpc_metadata_array& metadata) const;
+
+    // How long a call of a class other than 0 may wait before it is shed,
+    // or zero if calls wait indefinitely.
+    Duration queueing_delay_target() const { return queueing_delay_target_; }
+
+   private:
+    // Parses a class number, returning nullopt if it is not a valid one.
+    static absl::optional<size_t> ParseClass(absl::string_view value);
+
+    // Keyed by full method name ("/pkg.Service/Method").
+    absl::flat_hash_map<std::string, size_t> method_classes_;
+    // Keyed by service ("/pkg.Service").
+    absl::flat_hash_map<std::string, size_t> service_classes_;
+    size_t default_class_ = kDefaultClass;
+    absl::optional<std::string> metadata_key_;
+    Duration queueing_delay_target_;
+  };
+
   explicit Server(ChannelArgs args);
   ~Server() override;
 
@@ -209,6 +242,7 @@ class Server : public InternallyRefCounted<Server>,
     Slice host;
   };
 
+  class RegisteredMethodTable;
   class RequestMatcherInterface;
   class RealRequestMatcher;
   class AllocatingRequestMatcherBase;
@@ -227,7 +261,11 @@ class Server : public InternallyRefCounted<Server>,
 
     RefCountedPtr<Server> server() const { return server_; }
     Channel* channel() const { return channel_.get(); }
-    size_t cq_idx() const { return cq_idx_; }
+    size_t cq_idx() const { return cq_idx_.load(std::memory_order_relaxed); }
+
+    // Points later calls at new_cq_idx if the CQ is still expected_cq_idx.
+    // Returns false if another call moved the channel first.
+    bool MoveToCq(size_t expected_cq_idx, size_t new_cq_idx);
 
     ChannelRegisteredMethod* GetRegisteredMethod(const grpc_slice& host,
                                                  const grpc_slice& path);
@@ -250,15 +288,10 @@ class Server : public InternallyRefCounted<Server>,
     RefCountedPtr<Server> server_;
     RefCountedPtr<Channel> channel_;
     // The index into Server::cqs_ of the CQ used as a starting point for
-    // where to publish new incoming calls.
-    size_t cq_idx_;
+    // where to publish new incoming calls. Only changes with
+    // GRPC_ARG_SERVER_CQ_MIGRATION.
+    std::atomic<size_t> cq_idx_{0};
     absl::optional<std::list<ChannelData*>::iterator> list_position_;
-    // A hash-table of the methods and hosts of the registered methods.
-    // TODO(vjpai): Convert this to an STL map type as opposed to a direct
-    // bucket implementation. (Consider performance impact, hash function to
-    // use, etc.)
-    std::unique_ptr<std::vector<ChannelRegisteredMethod>> registered_methods_;
-    uint32_t registered_method_max_probes_;
     grpc_closure finish_destroy_channel_closure_;
     intptr_t channelz_socket_uuid_;
   };
@@ -292,8 +325,15 @@ class Server : public InternallyRefCounted<Server>,
 
     void KillZombie();
 
+    // Fails a call that waited too long to be requested by the application
+    // with RESOURCE_EXHAUSTED. Must be ACTIVATED and not published.
+    void Shed();
+
     void FailCallCreation();
 
+    // The QoS class of the call, once initial metadata is read.
+    size_t QosClass() const;
+
     // Filter vtable functions.
     static grpc_error_handle InitCallElement(
         grpc_call_element* elem, const grpc_call_element_args* args);
@@ -327,6 +367,9 @@ class Server : public InternallyRefCounted<Server>,
     Timestamp deadline_ = Timestamp::InfFuture();
 
     grpc_completion_queue* cq_new_ = nullptr;
+    // The index of cq_new_ in Server::cqs_, if the call counts towards its
+    // load.
+    absl::optional<size_t> loaded_cq_idx_;
 
     RequestMatcherInterface* matcher_ = nullptr;
     grpc_byte_buffer* payload_ = nullptr;
@@ -395,6 +438,14 @@ class Server : public InternallyRefCounted<Server>,
 
   std::vector<RefCountedPtr<Channel>> GetChannelsLocked() const;
 
+  // Returns the index of the listening CQ with the fewest active calls, then
+  // the fewest channels. Requires cq_loads_.
+  size_t LeastLoadedCq() const;
+  // Returns the index of the CQ from which to start matching a new call on
+  // chand, moving chand off its CQ first if that one is much busier than
+  // the least loaded one.
+  size_t CqForNewCall(ChannelData* chand);
+
   // Take a shutdown ref for a request (increment by 2) and return if shutdown
   // has not been called.
   bool ShutdownRefOnRequest() {
@@ -446,6 +497,22 @@ class Server : public InternallyRefCounted<Server>,
 
   std::vector<grpc_completion_queue*> cqs_;
   std::vector<grpc_pollset*> pollsets_;
+
+  // Load on each of cqs_, tracked from Start() when either
+  // GRPC_ARG_SERVER_CQ_ASSIGNMENT is "least_loaded" or
+  // GRPC_ARG_SERVER_CQ_MIGRATION is set.
+  struct CqLoad {
+    // Calls published to the CQ and not yet destroyed.
+    std::atomic<size_t> active_calls{0};
+    // Channels that publish their calls to the CQ first.
+    std::atomic<size_t> channels{0};
+  };
+  const bool assign_least_loaded_cq_;
+  const bool migrate_from_hot_cqs_;
+  const QosPolicy qos_policy_;
+  std::unique_ptr<CqLoad[]> cq_loads_;
+  // Indexes into cqs_ of the listening CQs, which channels are spread over.
+  std::vector<size_t> listening_cq_idxs_;
   bool started_ = false;
 
   // The two following mutexes control access to server-state.
@@ -464,6 +531,8 @@ class Server : public InternallyRefCounted<Server>,
   CondVar starting_cv_;
 
   std::vector<std::unique_ptr<RegisteredMethod>> registered_methods_;
+  // Lookup table over registered_methods_, built by Start().
+  std::unique_ptr<RegisteredMethodTable> registered_method_table_;
 
   // Request matcher for unregistered methods.
   std::unique_ptr<RequestMatcherInterface> unregistered_request_matcher_;
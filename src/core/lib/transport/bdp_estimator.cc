@@ -56,6 +56,9 @@ Timestamp BdpEstimator::CompletePing() {
             bw_est_ / 125000.0);
   }
   GPR_ASSERT(ping_state_ == PingState::STARTED);
+  last_ping_rtt_ = dt;
+  last_ping_bw_ = bw;
+  completed_pings_++;
   if (accumulator_ > 2 * estimate_ / 3 && bw > bw_est_) {
     estimate_ = std::max(accumulator_, estimate_ * 2);
     bw_est_ = bw;
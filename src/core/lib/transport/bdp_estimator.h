@@ -75,6 +75,13 @@ class BdpEstimator {
 
   int64_t accumulator() { return accumulator_; }
 
+  // Round trip time (seconds) and delivery rate (bytes/second) measured by the
+  // most recently completed ping. completed_pings() counts the samples taken
+  // so far, letting callers tell a fresh sample from one already consumed.
+  double last_ping_rtt() const { return last_ping_rtt_; }
+  double last_ping_bandwidth() const { return last_ping_bw_; }
+  int64_t completed_pings() const { return completed_pings_; }
+
  private:
   enum class PingState { UNSCHEDULED, SCHEDULED, STARTED };
 
@@ -86,6 +93,9 @@ class BdpEstimator {
   Duration inter_ping_delay_;
   int stable_estimate_count_;
   double bw_est_;
+  double last_ping_rtt_ = 0;
+  double last_ping_bw_ = 0;
+  int64_t completed_pings_ = 0;
   const char* name_;
 };
 
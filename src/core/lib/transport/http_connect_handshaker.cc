@@ -24,7 +24,9 @@
 #include <string.h>
 
 #include <memory>
+#include <set>
 #include <string>
+#include <utility>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/memory/memory.h"
@@ -60,6 +62,237 @@ namespace grpc_core {
 
 namespace {
 
+//
+// optimistic mode
+//
+
+// Proxies that failed a connection before their response was read while in
+// optimistic mode, by address.  Connections through them are not optimistic.
+struct NonOptimisticProxies {
+  Mutex mu;
+  std::set<std::string> addresses ABSL_GUARDED_BY(mu);
+};
+
+NonOptimisticProxies* GetNonOptimisticProxies() {
+  static NonOptimisticProxies* proxies = new NonOptimisticProxies();
+  return proxies;
+}
+
+bool IsOptimisticProxy(absl::string_view address) {
+  NonOptimisticProxies* proxies = GetNonOptimisticProxies();
+  MutexLock lock(&proxies->mu);
+  return proxies->addresses.find(std::string(address)) ==
+         proxies->addresses.end();
+}
+
+// Wraps the endpoint of a connection whose HTTP CONNECT request was followed
+// by other data without waiting for the proxy's response.  Removes the
+// response from the data read, and fails the read that completes it if it
+// is not a 2xx.
+struct ProxyResponseEndpoint {
+  ProxyResponseEndpoint(const grpc_endpoint_vtable* vtable,
+                        grpc_endpoint* wrapped)
+      : wrapped(wrapped), proxy(grpc_endpoint_get_peer(wrapped)) {
+    base.vtable = vtable;
+    grpc_slice_buffer_init(&read_buffer);
+    grpc_http_parser_init(&http_parser, GRPC_HTTP_RESPONSE, &http_response);
+  }
+
+  ~ProxyResponseEndpoint() {
+    grpc_endpoint_destroy(wrapped);
+    grpc_slice_buffer_destroy_internal(&read_buffer);
+    grpc_http_parser_destroy(&http_parser);
+    grpc_http_response_destroy(&http_response);
+  }
+
+  grpc_endpoint base;
+  grpc_endpoint* wrapped;
+  const std::string proxy;
+
+  // Reads are done into read_buffer until the response has been read.
+  bool response_done = false;
+  grpc_slice_buffer read_buffer;
+  grpc_http_parser http_parser;
+  grpc_http_response http_response = {};
+  // The read in progress.
+  grpc_slice_buffer* slices = nullptr;
+  grpc_closure* cb = nullptr;
+  bool urgent = false;
+  int min_progress_size = 0;
+  grpc_closure on_read;
+};
+
+// Feeds read_buffer to the parser.  Once the response has been read, leaves
+// only the bytes that follow it in read_buffer.
+grpc_error_handle ParseProxyResponse(ProxyResponseEndpoint* ep) {
+  for (size_t i = 0; i < ep->read_buffer.count; ++i) {
+    grpc_slice* slice = &ep->read_buffer.slices[i];
+    if (GRPC_SLICE_LENGTH(*slice) == 0) continue;
+    size_t body_start_offset = 0;
+    grpc_error_handle error =
+        grpc_http_parser_parse(&ep->http_parser, *slice, &body_start_offset);
+    if (error != GRPC_ERROR_NONE) return error;
+    if (ep->http_parser.state != GRPC_HTTP_BODY) continue;
+    if (ep->http_response.status < 200 || ep->http_response.status >= 300) {
+      return GRPC_ERROR_CREATE_FROM_CPP_STRING(
+          absl::StrCat("HTTP proxy returned response code ",
+                       ep->http_response.status));
+    }
+    grpc_slice_buffer tmp_buffer;
+    grpc_slice_buffer_init(&tmp_buffer);
+    if (body_start_offset < GRPC_SLICE_LENGTH(*slice)) {
+      grpc_slice_buffer_add(&tmp_buffer,
+                            grpc_slice_split_tail(slice, body_start_offset));
+    }
+    grpc_slice_buffer_addn(&tmp_buffer, &ep->read_buffer.slices[i + 1],
+                           ep->read_buffer.count - i - 1);
+    grpc_slice_buffer_swap(&ep->read_buffer, &tmp_buffer);
+    grpc_slice_buffer_destroy_internal(&tmp_buffer);
+    ep->response_done = true;
+    return GRPC_ERROR_NONE;
+  }
+  grpc_slice_buffer_reset_and_unref_internal(&ep->read_buffer);
+  return GRPC_ERROR_NONE;
+}
+
+void ProxyResponseEndpointReadResponse(ProxyResponseEndpoint* ep);
+
+void ProxyResponseEndpointOnRead(void* arg, grpc_error_handle error) {
+  auto* ep = static_cast<ProxyResponseEndpoint*>(arg);
+  if (error == GRPC_ERROR_NONE) {
+    error = ParseProxyResponse(ep);
+  } else {
+    GRPC_ERROR_REF(error);
+  }
+  if (error != GRPC_ERROR_NONE) {
+    gpr_log(GPR_INFO,
+            "HTTP proxy %s failed an optimistic connection, not starting "
+            "handshakes before its response from now on: %s",
+            ep->proxy.c_str(), grpc_error_std_string(error).c_str());
+    NonOptimisticProxies* proxies = GetNonOptimisticProxies();
+    {
+      MutexLock lock(&proxies->mu);
+      proxies->addresses.insert(ep->proxy);
+    }
+    grpc_slice_buffer_reset_and_unref_internal(&ep->read_buffer);
+    ExecCtx::Run(DEBUG_LOCATION, std::exchange(ep->cb, nullptr), error);
+    return;
+  }
+  if (!ep->response_done) {
+    ProxyResponseEndpointReadResponse(ep);
+    return;
+  }
+  grpc_closure* cb = std::exchange(ep->cb, nullptr);
+  if (ep->read_buffer.length == 0) {
+    // Nothing followed the response yet.
+    grpc_endpoint_read(ep->wrapped, ep->slices, cb, ep->urgent,
+                       ep->min_progress_size);
+    return;
+  }
+  grpc_slice_buffer_move_into(&ep->read_buffer, ep->slices);
+  ExecCtx::Run(DEBUG_LOCATION, cb, GRPC_ERROR_NONE);
+}
+
+void ProxyResponseEndpointReadResponse(ProxyResponseEndpoint* ep) {
+  grpc_endpoint_read(ep->wrapped, &ep->read_buffer,
+                     GRPC_CLOSURE_INIT(&ep->on_read,
+                                       ProxyResponseEndpointOnRead, ep,
+                                       grpc_schedule_on_exec_ctx),
+                     /*urgent=*/true, /*min_progress_size=*/1);
+}
+
+void ProxyResponseEndpointRead(grpc_endpoint* base, grpc_slice_buffer* slices,
+                               grpc_closure* cb, bool urgent,
+                               int min_progress_size) {
+  auto* ep = reinterpret_cast<ProxyResponseEndpoint*>(base);
+  if (ep->response_done) {
+    grpc_endpoint_read(ep->wrapped, slices, cb, urgent, min_progress_size);
+    return;
+  }
+  ep->slices = slices;
+  ep->cb = cb;
+  ep->urgent = urgent;
+  ep->min_progress_size = min_progress_size;
+  ProxyResponseEndpointReadResponse(ep);
+}
+
+void ProxyResponseEndpointWrite(grpc_endpoint* base, grpc_slice_buffer* slices,
+                                grpc_closure* cb, void* arg,
+                                int max_frame_size) {
+  auto* ep = reinterpret_cast<ProxyResponseEndpoint*>(base);
+  grpc_endpoint_write(ep->wrapped, slices, cb, arg, max_frame_size);
+}
+
+void ProxyResponseEndpointAddToPollset(grpc_endpoint* base,
+                                       grpc_pollset* pollset) {
+  auto* ep = reinterpret_cast<ProxyResponseEndpoint*>(base);
+  grpc_endpoint_add_to_pollset(ep->wrapped, pollset);
+}
+
+void ProxyResponseEndpointAddToPollsetSet(grpc_endpoint* base,
+                                          grpc_pollset_set* pollset_set) {
+  auto* ep = reinterpret_cast<ProxyResponseEndpoint*>(base);
+  grpc_endpoint_add_to_pollset_set(ep->wrapped, pollset_set);
+}
+
+void ProxyResponseEndpointDeleteFromPollsetSet(grpc_endpoint* base,
+                                               grpc_pollset_set* pollset_set) {
+  auto* ep = reinterpret_cast<ProxyResponseEndpoint*>(base);
+  grpc_endpoint_delete_from_pollset_set(ep->wrapped, pollset_set);
+}
+
+void ProxyResponseEndpointShutdown(grpc_endpoint* base,
+                                   grpc_error_handle why) {
+  auto* ep = reinterpret_cast<ProxyResponseEndpoint*>(base);
+  grpc_endpoint_shutdown(ep->wrapped, why);
+}
+
+void ProxyResponseEndpointDestroy(grpc_endpoint* base) {
+  delete reinterpret_cast<ProxyResponseEndpoint*>(base);
+}
+
+absl::string_view ProxyResponseEndpointGetPeer(grpc_endpoint* base) {
+  auto* ep = reinterpret_cast<ProxyResponseEndpoint*>(base);
+  return grpc_endpoint_get_peer(ep->wrapped);
+}
+
+absl::string_view ProxyResponseEndpointGetLocalAddress(grpc_endpoint* base) {
+  auto* ep = reinterpret_cast<ProxyResponseEndpoint*>(base);
+  return grpc_endpoint_get_local_address(ep->wrapped);
+}
+
+int ProxyResponseEndpointGetFd(grpc_endpoint* base) {
+  auto* ep = reinterpret_cast<ProxyResponseEndpoint*>(base);
+  return grpc_endpoint_get_fd(ep->wrapped);
+}
+
+bool ProxyResponseEndpointCanTrackErr(grpc_endpoint* base) {
+  auto* ep = reinterpret_cast<ProxyResponseEndpoint*>(base);
+  return grpc_endpoint_can_track_err(ep->wrapped);
+}
+
+const grpc_endpoint_vtable kProxyResponseEndpointVtable = {
+    ProxyResponseEndpointRead,
+    ProxyResponseEndpointWrite,
+    ProxyResponseEndpointAddToPollset,
+    ProxyResponseEndpointAddToPollsetSet,
+    ProxyResponseEndpointDeleteFromPollsetSet,
+    ProxyResponseEndpointShutdown,
+    ProxyResponseEndpointDestroy,
+    ProxyResponseEndpointGetPeer,
+    ProxyResponseEndpointGetLocalAddress,
+    ProxyResponseEndpointGetFd,
+    ProxyResponseEndpointCanTrackErr};
+
+grpc_endpoint* CreateProxyResponseEndpoint(grpc_endpoint* wrapped) {
+  auto* ep = new ProxyResponseEndpoint(&kProxyResponseEndpointVtable, wrapped);
+  return &ep->base;
+}
+
+//
+// HttpConnectHandshaker
+//
+
 class HttpConnectHandshaker : public Handshaker {
  public:
   HttpConnectHandshaker();
@@ -89,6 +322,9 @@ class HttpConnectHandshaker : public Handshaker {
   // State saved while performing the handshake.
   HandshakerArgs* args_ = nullptr;
   grpc_closure* on_handshake_done_ = nullptr;
+  // Whether the handshake completes once the request is written, leaving
+  // the response to be read by a ProxyResponseEndpoint.
+  bool optimistic_ = false;
 
   // Objects for processing the HTTP CONNECT request and response.
   grpc_slice_buffer write_buffer_ ABSL_GUARDED_BY(mu_);
@@ -170,6 +406,18 @@ void HttpConnectHandshaker::OnWriteDone(void* arg, grpc_error_handle error) {
     handshaker->HandshakeFailedLocked(GRPC_ERROR_REF(error));
     lock.Release();
     handshaker->Unref();
+  } else if (handshaker->optimistic_) {
+    // Let the next handshaker start now; the response is read by the
+    // endpoint it gets.
+    handshaker->args_->endpoint =
+        CreateProxyResponseEndpoint(handshaker->args_->endpoint);
+    ExecCtx::Run(DEBUG_LOCATION, handshaker->on_handshake_done_,
+                 GRPC_ERROR_NONE);
+    // Set shutdown to true so that subsequent calls to
+    // http_connect_handshaker_shutdown() do nothing.
+    handshaker->is_shutdown_ = true;
+    lock.Release();
+    handshaker->Unref();
   } else {
     // Otherwise, read the response.
     // The read callback inherits our ref to the handshaker.
@@ -344,6 +592,11 @@ void HttpConnectHandshaker::DoHandshake(grpc_tcp_server_acceptor* /*acceptor*/,
   std::string proxy_name(grpc_endpoint_get_peer(args->endpoint));
   gpr_log(GPR_INFO, "Connecting to server %s via HTTP proxy %s", server_name,
           proxy_name.c_str());
+  // Bytes already read could only be part of the response.
+  optimistic_ = grpc_channel_args_find_bool(
+                    args->args, GRPC_ARG_HTTP_CONNECT_OPTIMISTIC, false) &&
+                args->read_buffer->length == 0 &&
+                IsOptimisticProxy(proxy_name);
   // Construct HTTP CONNECT request.
   grpc_http_request request;
   request.method = const_cast<char*>("CONNECT");
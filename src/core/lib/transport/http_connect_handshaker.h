@@ -32,6 +32,15 @@
 /// separated by colons.
 #define GRPC_ARG_HTTP_CONNECT_HEADERS "grpc.http_connect_headers"
 
+/// Channel arg indicating whether the handshakers that follow HTTP CONNECT,
+/// like TLS, start right after the request is written instead of after the
+/// proxy's response is read (boolean, default false).  Saves a round trip
+/// per connection, but is only safe with proxies that buffer what they
+/// receive ahead of their response.  Once a connection fails before the
+/// response of a proxy is read, later connections through that proxy wait
+/// for its response again.
+#define GRPC_ARG_HTTP_CONNECT_OPTIMISTIC "grpc.http_connect_optimistic"
+
 namespace grpc_core {
 
 // Register the HTTP Connect handshaker into the configuration builder.
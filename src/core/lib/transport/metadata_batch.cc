@@ -19,7 +19,9 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 
+#include "absl/hash/hash.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -28,6 +30,26 @@
 #include "src/core/lib/transport/timeout_encoding.h"
 
 namespace grpc_core {
+
+PreEncodedMetadata* PreEncodedMetadata::Create(absl::string_view key,
+                                               absl::string_view value) {
+  // Ids start at 1 and are never reused: a per-connection cache entry for an
+  // id can then never be mistaken for a different element.
+  static std::atomic<uint32_t> next_id{1};
+  return new PreEncodedMetadata(
+      key, value, next_id.fetch_add(1, std::memory_order_relaxed));
+}
+
+grpc_slice PreEncodedMetadata::RefSliceOver(const std::string& s) {
+  Ref();
+  grpc_slice slice;
+  slice.refcount = this;
+  slice.data.refcounted.bytes =
+      reinterpret_cast<uint8_t*>(const_cast<char*>(s.data()));
+  slice.data.refcounted.length = s.length();
+  return slice;
+}
+
 namespace metadata_detail {
 
 void DebugStringBuilder::Add(absl::string_view key, absl::string_view value) {
@@ -35,11 +57,36 @@ void DebugStringBuilder::Add(absl::string_view key, absl::string_view value) {
   absl::StrAppend(&out_, absl::CEscape(key), ": ", absl::CEscape(value));
 }
 
+namespace {
+size_t HashKey(absl::string_view key) {
+  return absl::Hash<absl::string_view>()(key);
+}
+}  // namespace
+
 void UnknownMap::Append(absl::string_view key, Slice value) {
-  unknown_.EmplaceBack(Slice::FromCopiedString(key), value.Ref());
+  const auto* entry =
+      unknown_.EmplaceBack(Slice::FromCopiedString(key), value.Ref());
+  if (index_ != nullptr) AddToIndex(HashKey(key), entry);
 }
 
 void UnknownMap::Remove(absl::string_view key) {
+  if (MaybeBuildIndex()) {
+    // Most removals are of keys that are not there: skip compacting then.
+    const size_t hash = HashKey(key);
+    const size_t mask = index_capacity_ - 1;
+    bool found = false;
+    for (size_t i = hash & mask; index_[i].entry != nullptr;
+         i = (i + 1) & mask) {
+      if (index_[i].hash == hash &&
+          index_[i].entry->first.as_string_view() == key) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) return;
+    // Compacting moves the entries the index points to.
+    DropIndex();
+  }
   unknown_.SetEnd(std::remove_if(unknown_.begin(), unknown_.end(),
                                  [key](const std::pair<Slice, Slice>& p) {
                                    return p.first.as_string_view() == key;
@@ -49,18 +96,71 @@ void UnknownMap::Remove(absl::string_view key) {
 absl::optional<absl::string_view> UnknownMap::GetStringValue(
     absl::string_view key, std::string* backing) const {
   absl::optional<absl::string_view> out;
-  for (const auto& p : unknown_) {
-    if (p.first.as_string_view() == key) {
-      if (!out.has_value()) {
-        out = p.second.as_string_view();
-      } else {
-        out = *backing = absl::StrCat(*out, ",", p.second.as_string_view());
+  auto add_value = [&out, backing](const std::pair<Slice, Slice>& p) {
+    if (!out.has_value()) {
+      out = p.second.as_string_view();
+    } else {
+      out = *backing = absl::StrCat(*out, ",", p.second.as_string_view());
+    }
+  };
+  if (MaybeBuildIndex()) {
+    const size_t hash = HashKey(key);
+    const size_t mask = index_capacity_ - 1;
+    for (size_t i = hash & mask; index_[i].entry != nullptr;
+         i = (i + 1) & mask) {
+      if (index_[i].hash == hash &&
+          index_[i].entry->first.as_string_view() == key) {
+        add_value(*index_[i].entry);
       }
     }
+    return out;
+  }
+  for (const auto& p : unknown_) {
+    if (p.first.as_string_view() == key) add_value(p);
   }
   return out;
 }
 
+bool UnknownMap::MaybeBuildIndex() const {
+  if (index_ != nullptr) return true;
+  const size_t entries = unknown_.size();
+  if (entries <= kIndexThreshold) return false;
+  BuildIndex(entries);
+  return true;
+}
+
+void UnknownMap::BuildIndex(size_t min_entries) const {
+  // Keep the load factor at or below one half, so that probe sequences stay
+  // short and always end at an empty slot.
+  size_t capacity = 32;
+  while (capacity < 2 * min_entries) capacity *= 2;
+  index_ = static_cast<IndexSlot*>(
+      unknown_.arena()->Alloc(capacity * sizeof(IndexSlot)));
+  memset(index_, 0, capacity * sizeof(IndexSlot));
+  index_capacity_ = capacity;
+  index_size_ = 0;
+  // Adding the entries in order keeps duplicates of a key in order.
+  for (const auto& p : unknown_) {
+    AddToIndex(HashKey(p.first.as_string_view()), &p);
+  }
+}
+
+void UnknownMap::AddToIndex(size_t hash,
+                            const std::pair<Slice, Slice>* entry) const {
+  if (2 * (index_size_ + 1) > index_capacity_) {
+    // The entry is already in unknown_, so rebuilding picks it up. The old
+    // index stays in the arena until the call ends.
+    BuildIndex(index_size_ + 1);
+    return;
+  }
+  const size_t mask = index_capacity_ - 1;
+  size_t i = hash & mask;
+  while (index_[i].entry != nullptr) i = (i + 1) & mask;
+  index_[i].hash = hash;
+  index_[i].entry = entry;
+  ++index_size_;
+}
+
 }  // namespace metadata_detail
 
 ContentTypeMetadata::MementoType ContentTypeMetadata::ParseMemento(
@@ -34,6 +34,7 @@
 #include "absl/strings/numbers.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "absl/utility/utility.h"
 
 #include <grpc/impl/codegen/compression_types.h>
 #include <grpc/status.h>
@@ -388,6 +389,55 @@ struct GrpcStatusContext {
   static const std::string& DisplayValue(const std::string& x);
 };
 
+// A custom metadata element whose key and value are fixed for the lifetime of
+// the object (see grpc::PreEncodedMetadata). The slices handed out for the key
+// and value are backed by this object, so an encoder can recognize the element
+// from its value slice alone and cache per-connection state (eg. a HPACK
+// dynamic table index) against id(), which is never reused in the process.
+class PreEncodedMetadata final : public grpc_slice_refcount {
+ public:
+  // Returns a new element holding a single ref, owned by the caller.
+  static PreEncodedMetadata* Create(absl::string_view key,
+                                    absl::string_view value);
+
+  // Returns the element value is the value slice of, or nullptr.
+  static const PreEncodedMetadata* FromValue(const grpc_slice& value) {
+    if (value.refcount <= grpc_slice_refcount::NoopRefcount() ||
+        !value.refcount->HasDestroyer(Destroy)) {
+      return nullptr;
+    }
+    auto* md = static_cast<const PreEncodedMetadata*>(value.refcount);
+    if (value.data.refcounted.bytes !=
+        reinterpret_cast<const uint8_t*>(md->value_.data())) {
+      return nullptr;
+    }
+    return md;
+  }
+
+  uint32_t id() const { return id_; }
+  absl::string_view key() const { return key_; }
+  absl::string_view value() const { return value_; }
+
+  // New slices over the key and value, each holding a ref to this object.
+  grpc_slice RefKeySlice() { return RefSliceOver(key_); }
+  grpc_slice RefValueSlice() { return RefSliceOver(value_); }
+
+ private:
+  PreEncodedMetadata(absl::string_view key, absl::string_view value,
+                     uint32_t id)
+      : grpc_slice_refcount(Destroy), key_(key), value_(value), id_(id) {}
+
+  static void Destroy(grpc_slice_refcount* p) {
+    delete static_cast<PreEncodedMetadata*>(p);
+  }
+
+  grpc_slice RefSliceOver(const std::string& s);
+
+  const std::string key_;
+  const std::string value_;
+  const uint32_t id_;
+};
+
 namespace metadata_detail {
 
 // Build a key/value formatted debug string.
@@ -845,9 +895,24 @@ class TransportSizeEncoder {
 };
 
 // Handle unknown (non-trait-based) fields in the metadata map.
+// Small maps are searched linearly. Once a map holds more than
+// kIndexThreshold entries, lookups build a hash index over them in the arena,
+// which is kept up to date by Append() and dropped by Remove() and Clear().
 class UnknownMap {
  public:
   explicit UnknownMap(Arena* arena) : unknown_(arena) {}
+  UnknownMap(UnknownMap&& other) noexcept
+      : unknown_(std::move(other.unknown_)),
+        index_(absl::exchange(other.index_, nullptr)),
+        index_capacity_(absl::exchange(other.index_capacity_, 0)),
+        index_size_(absl::exchange(other.index_size_, 0)) {}
+  UnknownMap& operator=(UnknownMap&& other) noexcept {
+    unknown_ = std::move(other.unknown_);
+    std::swap(index_, other.index_);
+    std::swap(index_capacity_, other.index_capacity_);
+    std::swap(index_size_, other.index_size_);
+    return *this;
+  }
 
   using BackingType = ChunkedVector<std::pair<Slice, Slice>, 10>;
 
@@ -861,12 +926,41 @@ class UnknownMap {
 
   bool empty() const { return unknown_.empty(); }
   size_t size() const { return unknown_.size(); }
-  void Clear() { unknown_.Clear(); }
+  void Clear() {
+    unknown_.Clear();
+    DropIndex();
+  }
   Arena* arena() const { return unknown_.arena(); }
 
  private:
+  static constexpr size_t kIndexThreshold = 8;
+
+  // One slot of the open-addressing index. Entries with the same key are
+  // found along the probe sequence in the order they were appended.
+  struct IndexSlot {
+    size_t hash;
+    const std::pair<Slice, Slice>* entry;
+  };
+
+  // Returns true if there is an index, building it first if the map is large
+  // enough for one.
+  bool MaybeBuildIndex() const;
+  void BuildIndex(size_t min_entries) const;
+  void AddToIndex(size_t hash, const std::pair<Slice, Slice>* entry) const;
+  void DropIndex() {
+    index_ = nullptr;
+    index_capacity_ = 0;
+    index_size_ = 0;
+  }
+
   // Backing store for added metadata.
   ChunkedVector<std::pair<Slice, Slice>, 10> unknown_;
+  // The index over unknown_, allocated in the arena; null when there is none.
+  // Lookups build it, hence mutable.
+  mutable IndexSlot* index_ = nullptr;
+  // A power of two.
+  mutable size_t index_capacity_ = 0;
+  mutable size_t index_size_ = 0;
 };
 
 }  // namespace metadata_detail
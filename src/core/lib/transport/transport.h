@@ -413,6 +413,9 @@ struct grpc_transport_stream_op_batch_payload {
     bool* call_failed_before_recv_message = nullptr;
     /** Should be enqueued when one message is ready to be processed. */
     grpc_closure* recv_message_ready = nullptr;
+    // If nonzero, the transport should not let the peer send more than this
+    // many bytes of the stream ahead of the application's reads.
+    uint32_t max_buffered_bytes = 0;
   } recv_message;
 
   struct {
@@ -591,6 +594,9 @@ namespace grpc_core {
 // absl::Status object.
 constexpr const char* kKeepaliveThrottlingKey =
     "grpc.internal.keepalive_throttling";
+// This is the key to be used for loading/storing the HTTP/2 error code of a
+// received GOAWAY in the absl::Status object.
+constexpr const char* kGoawayErrorKey = "grpc.internal.goaway_error";
 }  // namespace grpc_core
 
 #endif /* GRPC_CORE_LIB_TRANSPORT_TRANSPORT_H */
@@ -113,6 +113,54 @@ grpc_status_code gsec_aead_crypter_decrypt_iovec(
   return GRPC_STATUS_INVALID_ARGUMENT;
 }
 
+grpc_status_code gsec_aead_crypter_encrypt_iovec_batch(
+    gsec_aead_crypter* crypter, size_t nonce_length, gsec_aead_frame* frames,
+    size_t num_frames, char** error_details) {
+  if (crypter == nullptr || crypter->vtable == nullptr ||
+      crypter->vtable->encrypt_iovec == nullptr) {
+    maybe_copy_error_msg(vtable_error_msg, error_details);
+    return GRPC_STATUS_INVALID_ARGUMENT;
+  }
+  if (num_frames > 0 && frames == nullptr) {
+    maybe_copy_error_msg("frames is nullptr.", error_details);
+    return GRPC_STATUS_INVALID_ARGUMENT;
+  }
+  auto encrypt_iovec = crypter->vtable->encrypt_iovec;
+  for (size_t i = 0; i < num_frames; ++i) {
+    gsec_aead_frame* frame = &frames[i];
+    grpc_status_code status = encrypt_iovec(
+        crypter, frame->nonce, nonce_length, frame->aad_vec,
+        frame->aad_vec_length, frame->input_vec, frame->input_vec_length,
+        frame->output_vec, &frame->output_bytes_written, error_details);
+    if (status != GRPC_STATUS_OK) return status;
+  }
+  return GRPC_STATUS_OK;
+}
+
+grpc_status_code gsec_aead_crypter_decrypt_iovec_batch(
+    gsec_aead_crypter* crypter, size_t nonce_length, gsec_aead_frame* frames,
+    size_t num_frames, char** error_details) {
+  if (crypter == nullptr || crypter->vtable == nullptr ||
+      crypter->vtable->decrypt_iovec == nullptr) {
+    maybe_copy_error_msg(vtable_error_msg, error_details);
+    return GRPC_STATUS_INVALID_ARGUMENT;
+  }
+  if (num_frames > 0 && frames == nullptr) {
+    maybe_copy_error_msg("frames is nullptr.", error_details);
+    return GRPC_STATUS_INVALID_ARGUMENT;
+  }
+  auto decrypt_iovec = crypter->vtable->decrypt_iovec;
+  for (size_t i = 0; i < num_frames; ++i) {
+    gsec_aead_frame* frame = &frames[i];
+    grpc_status_code status = decrypt_iovec(
+        crypter, frame->nonce, nonce_length, frame->aad_vec,
+        frame->aad_vec_length, frame->input_vec, frame->input_vec_length,
+        frame->output_vec, &frame->output_bytes_written, error_details);
+    if (status != GRPC_STATUS_OK) return status;
+  }
+  return GRPC_STATUS_OK;
+}
+
 grpc_status_code gsec_aead_crypter_max_ciphertext_and_tag_length(
     const gsec_aead_crypter* crypter, size_t plaintext_length,
     size_t* max_ciphertext_and_tag_length_to_return, char** error_details) {
@@ -320,6 +320,46 @@ grpc_status_code gsec_aead_crypter_decrypt_iovec(
     struct iovec plaintext_vec, size_t* plaintext_bytes_written,
     char** error_details);
 
+/* One frame of a batched AEAD operation. */
+typedef struct gsec_aead_frame {
+  /* Nonce of the frame, of the length passed to the batch call. */
+  const uint8_t* nonce;
+  const struct iovec* aad_vec;
+  size_t aad_vec_length;
+  /* Plaintext when encrypting, ciphertext and tag when decrypting. */
+  const struct iovec* input_vec;
+  size_t input_vec_length;
+  /* Buffer for the ciphertext and tag when encrypting, plaintext when
+     decrypting. It must not overlap the input of any frame. */
+  struct iovec output_vec;
+  /* Set to the number of bytes written to output_vec. */
+  size_t output_bytes_written;
+} gsec_aead_frame;
+
+/**
+ * These methods perform AEAD encrypt (decrypt) operations on num_frames
+ * frames with one call, each as gsec_aead_crypter_encrypt_iovec
+ * (gsec_aead_crypter_decrypt_iovec) would, in order, reusing the crypter's
+ * cipher context and checking the crypter once per batch. Record protocols
+ * that produce many frames for one large write can seal them with one call.
+ *
+ * - crypter: AEAD crypter instance.
+ * - nonce_length: size of the nonce of every frame.
+ * - frames: array of num_frames frames.
+ * - error_details: as for gsec_aead_crypter_encrypt_iovec.
+ *
+ * On success, the methods return GRPC_STATUS_OK. Otherwise, they stop at the
+ * first frame that fails and return its error status; the frames before it
+ * have been processed.
+ */
+grpc_status_code gsec_aead_crypter_encrypt_iovec_batch(
+    gsec_aead_crypter* crypter, size_t nonce_length, gsec_aead_frame* frames,
+    size_t num_frames, char** error_details);
+
+grpc_status_code gsec_aead_crypter_decrypt_iovec_batch(
+    gsec_aead_crypter* crypter, size_t nonce_length, gsec_aead_frame* frames,
+    size_t num_frames, char** error_details);
+
 /**
  * This method computes the size of ciphertext+tag buffer that must be passed to
  * gsec_aead_crypter_encrypt function to ensure correct encryption of a
@@ -23,6 +23,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
 #include "src/core/tsi/alts/handshaker/alts_handshaker_client.h"
 
 static alts_shared_resource_dedicated g_alts_resource_dedicated;
@@ -67,6 +68,9 @@ void grpc_alts_shared_resource_dedicated_start(
     grpc_channel_credentials_release(creds);
     g_alts_resource_dedicated.cq =
         grpc_completion_queue_create_for_next(nullptr);
+    // Handshakes cannot complete without the thread, so it is started
+    // regardless of the thread quota.
+    grpc_core::ResourceQuota::Default()->thread_quota()->ForceReserve(1);
     g_alts_resource_dedicated.thread =
         grpc_core::Thread("alts_tsi_handshaker", &thread_worker, nullptr);
     g_alts_resource_dedicated.interested_parties = grpc_pollset_set_create();
@@ -83,6 +87,7 @@ void grpc_alts_shared_resource_dedicated_shutdown() {
                                  grpc_cq_pollset(g_alts_resource_dedicated.cq));
     grpc_completion_queue_shutdown(g_alts_resource_dedicated.cq);
     g_alts_resource_dedicated.thread.Join();
+    grpc_core::ResourceQuota::Default()->thread_quota()->Release(1);
     grpc_pollset_set_destroy(g_alts_resource_dedicated.interested_parties);
     grpc_completion_queue_destroy(g_alts_resource_dedicated.cq);
     grpc_channel_destroy(g_alts_resource_dedicated.channel);
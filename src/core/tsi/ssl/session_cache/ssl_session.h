@@ -62,8 +62,15 @@ class SslCachedSession {
   /// Returns a copy of previously cached session.
   virtual SslSessionPtr CopySession() const = 0;
 
+  /// Returns true if the session should be used for a single connection
+  /// only, as TLS 1.3 tickets should.
+  bool single_use() const { return single_use_; }
+
  protected:
-  SslCachedSession() = default;
+  explicit SslCachedSession(bool single_use) : single_use_(single_use) {}
+
+ private:
+  const bool single_use_;
 };
 
 }  // namespace tsi
@@ -35,7 +35,8 @@ namespace {
 class BoringSslCachedSession : public SslCachedSession {
  public:
   explicit BoringSslCachedSession(SslSessionPtr session)
-      : session_(std::move(session)) {}
+      : SslCachedSession(SSL_SESSION_should_be_single_use(session.get())),
+        session_(std::move(session)) {}
 
   SslSessionPtr CopySession() const override {
     // SslSessionPtr will dereference on destruction.
@@ -20,20 +20,45 @@
 
 #include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
 
+#include <inttypes.h>
+
+#include <deque>
+#include <functional>
+#include <map>
+
+#include "absl/memory/memory.h"
+#include "absl/types/optional.h"
+
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/trace.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/tsi/ssl/session_cache/ssl_session.h"
 
 namespace tsi {
 
-/// Node for single cached session.
+namespace {
+
+// Caches smaller than this are not sharded, so that small caches keep exact
+// LRU order.
+constexpr size_t kMinShardCapacity = 64;
+constexpr size_t kMaxShards = 16;
+
+// Estimated size of a cached session charged to the memory quota. Sessions
+// hold the peer's certificate chain and a ticket, a couple of KB is typical.
+constexpr size_t kSessionSizeEstimate = 2048;
+
+}  // namespace
+
+/// Node for sessions cached for a single key.
 class SslSessionLRUCache::Node {
  public:
   Node(const std::string& key, SslSessionPtr session) : key_(key) {
-    SetSession(std::move(session));
+    AddSession(std::move(session));
   }
 
   // Not copyable nor movable.
@@ -42,43 +67,236 @@ class SslSessionLRUCache::Node {
 
   const std::string& key() const { return key_; }
 
-  /// Returns a copy of the node's cache session.
-  SslSessionPtr CopySession() const { return session_->CopySession(); }
+  /// Estimate of the memory used by the node and its sessions.
+  size_t MemoryUsage() const {
+    return sizeof(Node) + key_.size() +
+           sessions_.size() * kSessionSizeEstimate;
+  }
+
+  /// Returns a copy of a cached session. Single-use sessions are removed
+  /// from the node, except for the last one.
+  SslSessionPtr TakeSession() {
+    if (sessions_.size() > 1 && sessions_.front()->single_use()) {
+      SslSessionPtr session = sessions_.front()->CopySession();
+      sessions_.pop_front();
+      return session;
+    }
+    return sessions_.back()->CopySession();
+  }
 
-  /// Set the \a session (which is moved) for the node.
-  void SetSession(SslSessionPtr session) {
-    session_ = SslCachedSession::Create(std::move(session));
+  /// Add the \a session (which is moved) to the node. Single-use sessions
+  /// are kept along with the node's other single-use sessions, any other
+  /// session replaces them all.
+  void AddSession(SslSessionPtr session) {
+    std::unique_ptr<SslCachedSession> cached =
+        SslCachedSession::Create(std::move(session));
+    if (!cached->single_use() ||
+        (!sessions_.empty() && !sessions_.back()->single_use())) {
+      sessions_.clear();
+    }
+    sessions_.push_back(std::move(cached));
+    if (sessions_.size() > kMaxSessionsPerKey) sessions_.pop_front();
   }
 
  private:
-  friend class SslSessionLRUCache;
+  friend class SslSessionLRUCache::Shard;
 
   std::string key_;
-  std::unique_ptr<SslCachedSession> session_;
+  // Oldest first.
+  std::deque<std::unique_ptr<SslCachedSession>> sessions_;
 
   Node* next_ = nullptr;
   Node* prev_ = nullptr;
+  // Bytes reserved from the memory quota for the node.
+  size_t reserved_ = 0;
 };
 
-SslSessionLRUCache::SslSessionLRUCache(size_t capacity) : capacity_(capacity) {
-  GPR_ASSERT(capacity > 0);
-}
+/// LRU cache for the keys of one shard.
+class SslSessionLRUCache::Shard {
+ public:
+  // Nodes are charged to \a memory_owner, unless it is null.
+  Shard(size_t capacity, grpc_core::MemoryOwner* memory_owner)
+      : capacity_(capacity), memory_owner_(memory_owner) {}
+
+  ~Shard() { Clear(); }
+
+  /// Removes all the sessions, returning the number of bytes released to
+  /// the memory quota.
+  size_t Clear() {
+    grpc_core::MutexLock lock(&lock_);
+    size_t released = 0;
+    Node* node = use_order_list_head_;
+    while (node) {
+      Node* next = node->next_;
+      released += node->reserved_;
+      DeleteLocked(node);
+      node = next;
+    }
+    use_order_list_head_ = nullptr;
+    use_order_list_tail_ = nullptr;
+    use_order_list_size_ = 0;
+    entry_by_key_.clear();
+    return released;
+  }
 
-SslSessionLRUCache::~SslSessionLRUCache() {
-  Node* node = use_order_list_head_;
-  while (node) {
-    Node* next = node->next_;
+  size_t Size() {
+    grpc_core::MutexLock lock(&lock_);
+    return use_order_list_size_;
+  }
+
+  void Put(const std::string& key, SslSessionPtr session) {
+    bool evicted = false;
+    {
+      grpc_core::MutexLock lock(&lock_);
+      Node* node = FindLocked(key);
+      if (node != nullptr) {
+        node->AddSession(std::move(session));
+        ChargeLocked(node);
+        return;
+      }
+      node = new Node(key, std::move(session));
+      ChargeLocked(node);
+      PushFront(node);
+      entry_by_key_.emplace(key, node);
+      AssertInvariants();
+      if (use_order_list_size_ > capacity_) {
+        GPR_ASSERT(use_order_list_tail_);
+        node = use_order_list_tail_;
+        Remove(node);
+        // Order matters, key is destroyed after deleting node.
+        entry_by_key_.erase(node->key());
+        DeleteLocked(node);
+        AssertInvariants();
+        evicted = true;
+      }
+    }
+    // TSI may be driven without an ExecCtx, e.g. by its own tests.
+    if (evicted && grpc_core::ExecCtx::Get() != nullptr) {
+      GRPC_STATS_INC_SSL_SESSION_CACHE_EVICTIONS();
+    }
+  }
+
+  SslSessionPtr Get(const std::string& key) {
+    SslSessionPtr session;
+    {
+      grpc_core::MutexLock lock(&lock_);
+      // Key is only used for lookups.
+      Node* node = FindLocked(key);
+      if (node != nullptr) {
+        session = node->TakeSession();
+        ChargeLocked(node);
+      }
+    }
+    if (grpc_core::ExecCtx::Get() != nullptr) {
+      if (session != nullptr) {
+        GRPC_STATS_INC_SSL_SESSION_CACHE_HITS();
+      } else {
+        GRPC_STATS_INC_SSL_SESSION_CACHE_MISSES();
+      }
+    }
+    return session;
+  }
+
+ private:
+  Node* FindLocked(const std::string& key);
+  void Remove(Node* node);
+  void PushFront(Node* node);
+  void AssertInvariants();
+
+  // Brings the bytes reserved for \a node in line with its memory usage.
+  void ChargeLocked(Node* node) {
+    if (memory_owner_ == nullptr) return;
+    size_t usage = node->MemoryUsage();
+    if (usage > node->reserved_) {
+      memory_owner_->Reserve(usage - node->reserved_);
+    } else if (usage < node->reserved_) {
+      memory_owner_->Release(node->reserved_ - usage);
+    }
+    node->reserved_ = usage;
+  }
+
+  void DeleteLocked(Node* node) {
+    if (node->reserved_ > 0) memory_owner_->Release(node->reserved_);
     delete node;
-    node = next;
   }
+
+  grpc_core::Mutex lock_;
+  const size_t capacity_;
+  grpc_core::MemoryOwner* const memory_owner_;
+
+  Node* use_order_list_head_ = nullptr;
+  Node* use_order_list_tail_ = nullptr;
+  size_t use_order_list_size_ = 0;
+  std::map<std::string, Node*> entry_by_key_;
+};
+
+SslSessionLRUCache::SslSessionLRUCache(
+    size_t capacity, grpc_core::MemoryQuotaRefPtr memory_quota) {
+  GPR_ASSERT(capacity > 0);
+  if (memory_quota != nullptr) {
+    memory_owner_ = memory_quota->CreateMemoryOwner("ssl_session_cache");
+  }
+  size_t num_shards = capacity / kMinShardCapacity;
+  if (num_shards < 1) num_shards = 1;
+  if (num_shards > kMaxShards) num_shards = kMaxShards;
+  // Spread the capacity so that the shards add up to exactly \a capacity.
+  shards_.reserve(num_shards);
+  for (size_t i = 0; i < num_shards; ++i) {
+    shards_.push_back(absl::make_unique<Shard>(
+        capacity / num_shards + (i < capacity % num_shards ? 1 : 0),
+        memory_owner_.is_valid() ? &memory_owner_ : nullptr));
+  }
+}
+
+SslSessionLRUCache::~SslSessionLRUCache() = default;
+
+SslSessionLRUCache::Shard* SslSessionLRUCache::ShardForKey(
+    const std::string& key) {
+  if (shards_.size() == 1) return shards_[0].get();
+  return shards_[std::hash<std::string>()(key) % shards_.size()].get();
 }
 
 size_t SslSessionLRUCache::Size() {
-  grpc_core::MutexLock lock(&lock_);
-  return use_order_list_size_;
+  size_t size = 0;
+  for (const auto& shard : shards_) size += shard->Size();
+  return size;
+}
+
+void SslSessionLRUCache::Put(const char* key, SslSessionPtr session) {
+  std::string key_str(key);
+  ShardForKey(key_str)->Put(key_str, std::move(session));
+  if (memory_owner_.is_valid()) MaybePostReclaimer();
+}
+
+SslSessionPtr SslSessionLRUCache::Get(const char* key) {
+  std::string key_str(key);
+  return ShardForKey(key_str)->Get(key_str);
 }
 
-SslSessionLRUCache::Node* SslSessionLRUCache::FindLocked(
+void SslSessionLRUCache::MaybePostReclaimer() {
+  // Checked first so that puts do not all write the flag.
+  if (reclaimer_posted_.load(std::memory_order_acquire) ||
+      reclaimer_posted_.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+  // Sessions only save round trips on later handshakes, so give them up as
+  // soon as the quota runs short.
+  memory_owner_.PostReclaimer(
+      grpc_core::ReclamationPass::kBenign,
+      [this](absl::optional<grpc_core::ReclamationSweep> sweep) {
+        if (!sweep.has_value()) return;
+        reclaimer_posted_.store(false, std::memory_order_release);
+        size_t released = 0;
+        for (const auto& shard : shards_) released += shard->Clear();
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
+          gpr_log(GPR_INFO,
+                  "ssl session cache %p: reclaimed %" PRIuPTR " bytes", this,
+                  released);
+        }
+      });
+}
+
+SslSessionLRUCache::Node* SslSessionLRUCache::Shard::FindLocked(
     const std::string& key) {
   auto it = entry_by_key_.find(key);
   if (it == entry_by_key_.end()) {
@@ -92,39 +310,7 @@ SslSessionLRUCache::Node* SslSessionLRUCache::FindLocked(
   return node;
 }
 
-void SslSessionLRUCache::Put(const char* key, SslSessionPtr session) {
-  grpc_core::MutexLock lock(&lock_);
-  Node* node = FindLocked(key);
-  if (node != nullptr) {
-    node->SetSession(std::move(session));
-    return;
-  }
-  node = new Node(key, std::move(session));
-  PushFront(node);
-  entry_by_key_.emplace(key, node);
-  AssertInvariants();
-  if (use_order_list_size_ > capacity_) {
-    GPR_ASSERT(use_order_list_tail_);
-    node = use_order_list_tail_;
-    Remove(node);
-    // Order matters, key is destroyed after deleting node.
-    entry_by_key_.erase(node->key());
-    delete node;
-    AssertInvariants();
-  }
-}
-
-SslSessionPtr SslSessionLRUCache::Get(const char* key) {
-  grpc_core::MutexLock lock(&lock_);
-  // Key is only used for lookups.
-  Node* node = FindLocked(key);
-  if (node == nullptr) {
-    return nullptr;
-  }
-  return node->CopySession();
-}
-
-void SslSessionLRUCache::Remove(SslSessionLRUCache::Node* node) {
+void SslSessionLRUCache::Shard::Remove(SslSessionLRUCache::Node* node) {
   if (node->prev_ == nullptr) {
     use_order_list_head_ = node->next_;
   } else {
@@ -139,7 +325,7 @@ void SslSessionLRUCache::Remove(SslSessionLRUCache::Node* node) {
   use_order_list_size_--;
 }
 
-void SslSessionLRUCache::PushFront(SslSessionLRUCache::Node* node) {
+void SslSessionLRUCache::Shard::PushFront(SslSessionLRUCache::Node* node) {
   if (use_order_list_head_ == nullptr) {
     use_order_list_head_ = node;
     use_order_list_tail_ = node;
@@ -155,7 +341,7 @@ void SslSessionLRUCache::PushFront(SslSessionLRUCache::Node* node) {
 }
 
 #ifndef NDEBUG
-void SslSessionLRUCache::AssertInvariants() {
+void SslSessionLRUCache::Shard::AssertInvariants() {
   size_t size = 0;
   Node* prev = nullptr;
   Node* current = use_order_list_head_;
@@ -173,7 +359,7 @@ void SslSessionLRUCache::AssertInvariants() {
   GPR_ASSERT(entry_by_key_.size() == use_order_list_size_);
 }
 #else
-void SslSessionLRUCache::AssertInvariants() {}
+void SslSessionLRUCache::Shard::AssertInvariants() {}
 #endif
 
 }  // namespace tsi
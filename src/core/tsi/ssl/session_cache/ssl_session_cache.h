@@ -21,7 +21,10 @@
 
 #include <grpc/support/port_platform.h>
 
-#include <map>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include <openssl/ssl.h>
 
@@ -31,6 +34,7 @@
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
 #include "src/core/tsi/ssl/session_cache/ssl_session.h"
 
 /// Cache for SSL sessions for sessions resumption.
@@ -40,19 +44,35 @@
 /// name. Note that servers are required to share session ticket encryption keys
 /// in order for cache to be effective.
 ///
+/// Large caches are split into shards by key, each with its own lock and LRU
+/// list, so that channels connecting to different servers do not contend.
+/// LRU order is then only maintained within a shard.
+///
+/// TLS 1.3 servers issue several single-use tickets per connection. Up to
+/// kMaxSessionsPerKey of them are kept per key and handed out to different
+/// connections; the last one is reused once the others are taken.
+///
+/// A cache created with a memory quota charges an estimate of the size of
+/// its sessions to it, and drops all of them in the quota's benign
+/// reclamation pass: losing them only costs full handshakes.
+///
 /// This class is thread safe.
 
 namespace tsi {
 
 class SslSessionLRUCache : public grpc_core::RefCounted<SslSessionLRUCache> {
  public:
-  /// Create new LRU cache with the given capacity.
-  static grpc_core::RefCountedPtr<SslSessionLRUCache> Create(size_t capacity) {
-    return grpc_core::MakeRefCounted<SslSessionLRUCache>(capacity);
+  /// Create new LRU cache with the given capacity, charged to \a memory_quota
+  /// if not null.
+  static grpc_core::RefCountedPtr<SslSessionLRUCache> Create(
+      size_t capacity, grpc_core::MemoryQuotaRefPtr memory_quota = nullptr) {
+    return grpc_core::MakeRefCounted<SslSessionLRUCache>(
+        capacity, std::move(memory_quota));
   }
 
   // Use Create function instead of using this directly.
-  explicit SslSessionLRUCache(size_t capacity);
+  explicit SslSessionLRUCache(
+      size_t capacity, grpc_core::MemoryQuotaRefPtr memory_quota = nullptr);
   ~SslSessionLRUCache() override;
 
   // Not copyable nor movable.
@@ -68,21 +88,21 @@ class SslSessionLRUCache : public grpc_core::RefCounted<SslSessionLRUCache> {
   /// found.
   SslSessionPtr Get(const char* key);
 
+  /// Maximum number of single-use (TLS 1.3) sessions kept per key.
+  static constexpr size_t kMaxSessionsPerKey = 4;
+
  private:
   class Node;
+  class Shard;
 
-  Node* FindLocked(const std::string& key);
-  void Remove(Node* node);
-  void PushFront(Node* node);
-  void AssertInvariants();
-
-  grpc_core::Mutex lock_;
-  size_t capacity_;
+  Shard* ShardForKey(const std::string& key);
+  void MaybePostReclaimer();
 
-  Node* use_order_list_head_ = nullptr;
-  Node* use_order_list_tail_ = nullptr;
-  size_t use_order_list_size_ = 0;
-  std::map<std::string, Node*> entry_by_key_;
+  // Invalid if the cache is not charged to a quota. Declared before the
+  // shards so that they release their memory before it is destroyed.
+  grpc_core::MemoryOwner memory_owner_;
+  std::atomic<bool> reclaimer_posted_{false};
+  std::vector<std::unique_ptr<Shard>> shards_;
 };
 
 }  // namespace tsi
@@ -37,9 +37,19 @@
 namespace tsi {
 namespace {
 
+bool IsSingleUse(const SSL_SESSION* session) {
+#if OPENSSL_VERSION_NUMBER >= 0x10101000 && !defined(LIBRESSL_VERSION_NUMBER)
+  return SSL_SESSION_get_protocol_version(session) >= TLS1_3_VERSION;
+#else
+  (void)session;
+  return false;
+#endif
+}
+
 class OpenSslCachedSession : public SslCachedSession {
  public:
-  OpenSslCachedSession(SslSessionPtr session) {
+  OpenSslCachedSession(SslSessionPtr session)
+      : SslCachedSession(IsSingleUse(session.get())) {
     int size = i2d_SSL_SESSION(session.get(), nullptr);
     GPR_ASSERT(size > 0);
     grpc_slice slice = grpc_slice_malloc(size_t(size));
@@ -20,6 +20,7 @@
 
 #include "src/core/tsi/ssl_transport_security.h"
 
+#include <errno.h>
 #include <limits.h>
 #include <string.h>
 
@@ -33,19 +34,31 @@
 #include <sys/socket.h>
 #endif
 
+#if defined(GPR_LINUX) && defined(__has_include)
+#if __has_include(<linux/tls.h>)
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+#endif
+#endif
+
+#include <algorithm>
 #include <string>
 
 #include <openssl/bio.h>
 #include <openssl/crypto.h> /* For OPENSSL_free */
 #include <openssl/engine.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
 #include <openssl/ssl.h>
 #include <openssl/tls1.h>
 #include <openssl/x509.h>
 #include <openssl/x509v3.h>
 
+#include "absl/strings/escaping.h"
 #include "absl/strings/match.h"
 #include "absl/strings/string_view.h"
+#include "absl/strings/strip.h"
 
 #include <grpc/grpc_security.h>
 #include <grpc/support/alloc.h>
@@ -54,11 +67,15 @@
 #include <grpc/support/sync.h>
 #include <grpc/support/thd_id.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/slice_internal.h"
 #include "src/core/tsi/ssl/key_logging/ssl_key_logging.h"
 #include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
 #include "src/core/tsi/ssl_types.h"
 #include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 
 /* --- Constants. ---*/
 
@@ -77,6 +94,24 @@
    SSL structure. This is what we would ultimately want though... */
 #define TSI_SSL_MAX_PROTECTION_OVERHEAD 100
 
+/* Runs of unprotected data at least this long are passed to SSL_write
+   straight from the caller's slices by the zero-copy protector; shorter ones
+   are first coalesced so that they do not each become a record. */
+#define TSI_SSL_ZERO_COPY_MIN_DIRECT_WRITE_SIZE 1024
+
+/* Kernel TLS needs TLS 1.3 support in the kernel headers (Linux 5.1) and the
+   key log callback of OpenSSL 1.1.1 to get the traffic secrets. */
+#if defined(TLS_1_3_VERSION) && OPENSSL_VERSION_NUMBER >= 0x10101000 && \
+    !defined(LIBRESSL_VERSION_NUMBER)
+#define TSI_SSL_KERNEL_TLS_SUPPORTED 1
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif
+
 using TlsSessionKeyLogger = tsi::TlsSessionKeyLoggerCache::TlsSessionKeyLogger;
 
 /* --- Structure definitions. ---*/
@@ -97,6 +132,8 @@ struct tsi_ssl_client_handshaker_factory {
   size_t alpn_protocol_list_length;
   grpc_core::RefCountedPtr<tsi::SslSessionLRUCache> session_cache;
   grpc_core::RefCountedPtr<TlsSessionKeyLogger> key_logger;
+  bool enable_kernel_tls_tx;
+  grpc_core::RefCountedPtr<tsi::SslPrivateKeySigner> private_key_signer;
 };
 
 struct tsi_ssl_server_handshaker_factory {
@@ -110,6 +147,19 @@ struct tsi_ssl_server_handshaker_factory {
   unsigned char* alpn_protocol_list;
   size_t alpn_protocol_list_length;
   grpc_core::RefCountedPtr<TlsSessionKeyLogger> key_logger;
+  bool enable_kernel_tls_tx;
+  grpc_core::RefCountedPtr<tsi::SslPrivateKeySigner> private_key_signer;
+};
+
+/* Progress of a signature requested from a tsi::SslPrivateKeySigner. */
+enum tsi_ssl_private_key_op_state {
+  TSI_SSL_PRIVATE_KEY_OP_NONE,
+  /* The signer has not called back yet. */
+  TSI_SSL_PRIVATE_KEY_OP_PENDING,
+  /* Same, and tsi_handshaker_next has returned TSI_ASYNC. */
+  TSI_SSL_PRIVATE_KEY_OP_ASYNC,
+  /* The signer has called back. */
+  TSI_SSL_PRIVATE_KEY_OP_DONE,
 };
 
 struct tsi_ssl_handshaker {
@@ -120,6 +170,21 @@ struct tsi_ssl_handshaker {
   unsigned char* outgoing_bytes_buffer;
   size_t outgoing_bytes_buffer_size;
   tsi_ssl_handshaker_factory* factory_ref;
+  /* Owned by the factory. Null unless the factory has a signer. */
+  tsi::SslPrivateKeySigner* private_key_signer;
+  /* Arguments and progress of the current tsi_handshaker_next call, kept
+     while it waits for private_key_signer. */
+  size_t received_bytes_size;
+  size_t bytes_written;
+  tsi_handshaker_on_next_done_cb cb;
+  void* user_data;
+  /* Guards the private key operation, which the signer completes from any
+     thread. */
+  gpr_mu mu;
+  tsi_ssl_private_key_op_state private_key_op_state;
+  bool private_key_op_ok;
+  unsigned char* signature;
+  size_t signature_size;
 };
 struct tsi_ssl_handshaker_result {
   tsi_handshaker_result base;
@@ -136,10 +201,32 @@ struct tsi_ssl_frame_protector {
   size_t buffer_size;
   size_t buffer_offset;
 };
+struct tsi_ssl_zero_copy_grpc_protector {
+  tsi_zero_copy_grpc_protector base;
+  SSL* ssl;
+  BIO* network_io;
+  /* Serializes protect and unprotect, which share ssl. */
+  gpr_mu mu;
+  /* Coalesces unprotected data too short to be written on its own. */
+  unsigned char* buffer;
+  size_t buffer_size;
+  /* Unused tail of the last slice SSL_read decrypted into. */
+  grpc_slice read_slice;
+};
 /* --- Library Initialization. ---*/
 
 static gpr_once g_init_openssl_once = GPR_ONCE_INIT;
 static int g_ssl_ctx_ex_factory_index = -1;
+#ifdef TSI_SSL_KERNEL_TLS_SUPPORTED
+/* Index of the write traffic secret (a std::string) kept in SSL objects for
+   kernel TLS. */
+static int g_ssl_ex_kernel_tls_secret_index = -1;
+#endif
+#ifdef OPENSSL_IS_BORINGSSL
+/* Index of the tsi_ssl_handshaker of SSL objects whose private key operations
+   are done by a tsi::SslPrivateKeySigner. */
+static int g_ssl_ex_handshaker_index = -1;
+#endif
 static const unsigned char kSslSessionIdContext[] = {'g', 'r', 'p', 'c'};
 #if !defined(OPENSSL_IS_BORINGSSL) && !defined(OPENSSL_NO_ENGINE)
 static const char kSslEnginePrefix[] = "engine:";
@@ -164,6 +251,17 @@ static unsigned long openssl_thread_id_cb(void) {
 }
 #endif
 
+#ifdef TSI_SSL_KERNEL_TLS_SUPPORTED
+static void ssl_kernel_tls_secret_free(void* /*parent*/, void* ptr,
+                                       CRYPTO_EX_DATA* /*ad*/, int /*index*/,
+                                       long /*argl*/, void* /*argp*/) {
+  std::string* secret = static_cast<std::string*>(ptr);
+  if (secret == nullptr) return;
+  OPENSSL_cleanse(&(*secret)[0], secret->size());
+  delete secret;
+}
+#endif
+
 static void init_openssl(void) {
 #if OPENSSL_VERSION_NUMBER >= 0x10100000
   OPENSSL_init_ssl(0, nullptr);
@@ -190,6 +288,16 @@ static void init_openssl(void) {
   g_ssl_ctx_ex_factory_index =
       SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
   GPR_ASSERT(g_ssl_ctx_ex_factory_index != -1);
+#ifdef TSI_SSL_KERNEL_TLS_SUPPORTED
+  g_ssl_ex_kernel_tls_secret_index = SSL_get_ex_new_index(
+      0, nullptr, nullptr, nullptr, ssl_kernel_tls_secret_free);
+  GPR_ASSERT(g_ssl_ex_kernel_tls_secret_index != -1);
+#endif
+#ifdef OPENSSL_IS_BORINGSSL
+  g_ssl_ex_handshaker_index =
+      SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  GPR_ASSERT(g_ssl_ex_handshaker_index != -1);
+#endif
 }
 
 /* --- Ssl utils. ---*/
@@ -831,12 +939,82 @@ static tsi_result ssl_ctx_load_verification_certs(SSL_CTX* context,
                                root_name);
 }
 
-/* Populates the SSL context with a private key and a cert chain, and sets the
-   cipher list and the ephemeral ECDH key. */
+#ifdef OPENSSL_IS_BORINGSSL
+static void ssl_private_key_sign_done(void* done_arg, grpc_status_code status,
+                                      const unsigned char* signature,
+                                      size_t signature_size);
+
+static enum ssl_private_key_result_t ssl_private_key_sign(
+    SSL* ssl, uint8_t* /*out*/, size_t* /*out_len*/, size_t /*max_out*/,
+    uint16_t signature_algorithm, const uint8_t* in, size_t in_len) {
+  tsi_ssl_handshaker* impl = static_cast<tsi_ssl_handshaker*>(
+      SSL_get_ex_data(ssl, g_ssl_ex_handshaker_index));
+  if (impl == nullptr) return ssl_private_key_failure;
+  gpr_mu_lock(&impl->mu);
+  GPR_ASSERT(impl->private_key_op_state == TSI_SSL_PRIVATE_KEY_OP_NONE);
+  impl->private_key_op_state = TSI_SSL_PRIVATE_KEY_OP_PENDING;
+  gpr_mu_unlock(&impl->mu);
+  /* The signature is always handed to SSL by ssl_private_key_complete, even
+     if the signer calls back before returning. */
+  impl->private_key_signer->Sign(signature_algorithm, in, in_len,
+                                 ssl_private_key_sign_done, impl);
+  return ssl_private_key_retry;
+}
+
+static enum ssl_private_key_result_t ssl_private_key_decrypt(
+    SSL* /*ssl*/, uint8_t* /*out*/, size_t* /*out_len*/, size_t /*max_out*/,
+    const uint8_t* /*in*/, size_t /*in_len*/) {
+  /* Only needed for RSA key exchange, which gRPC does not negotiate. */
+  return ssl_private_key_failure;
+}
+
+static enum ssl_private_key_result_t ssl_private_key_complete(
+    SSL* ssl, uint8_t* out, size_t* out_len, size_t max_out) {
+  tsi_ssl_handshaker* impl = static_cast<tsi_ssl_handshaker*>(
+      SSL_get_ex_data(ssl, g_ssl_ex_handshaker_index));
+  if (impl == nullptr) return ssl_private_key_failure;
+  gpr_mu_lock(&impl->mu);
+  if (impl->private_key_op_state != TSI_SSL_PRIVATE_KEY_OP_DONE) {
+    gpr_mu_unlock(&impl->mu);
+    return ssl_private_key_retry;
+  }
+  enum ssl_private_key_result_t result = ssl_private_key_failure;
+  if (!impl->private_key_op_ok) {
+    gpr_log(GPR_ERROR, "Private key signer failed.");
+  } else if (impl->signature_size > max_out) {
+    gpr_log(GPR_ERROR, "Private key signer returned a too long signature.");
+  } else {
+    memcpy(out, impl->signature, impl->signature_size);
+    *out_len = impl->signature_size;
+    result = ssl_private_key_success;
+  }
+  gpr_free(impl->signature);
+  impl->signature = nullptr;
+  impl->signature_size = 0;
+  impl->private_key_op_state = TSI_SSL_PRIVATE_KEY_OP_NONE;
+  gpr_mu_unlock(&impl->mu);
+  return result;
+}
+
+static const SSL_PRIVATE_KEY_METHOD g_ssl_private_key_method = {
+    ssl_private_key_sign, ssl_private_key_decrypt, ssl_private_key_complete};
+#endif /* OPENSSL_IS_BORINGSSL */
+
+/* Populates the SSL context with a private key (or the private key method of
+   a signer) and a cert chain, and sets the cipher list and the ephemeral ECDH
+   key. */
 static tsi_result populate_ssl_context(
     SSL_CTX* context, const tsi_ssl_pem_key_cert_pair* key_cert_pair,
-    const char* cipher_list) {
+    const char* cipher_list, bool use_private_key_signer) {
   tsi_result result = TSI_OK;
+  if (use_private_key_signer) {
+#ifdef OPENSSL_IS_BORINGSSL
+    SSL_CTX_set_private_key_method(context, &g_ssl_private_key_method);
+#else
+    gpr_log(GPR_ERROR, "Private key signers are only supported by BoringSSL.");
+    return TSI_UNIMPLEMENTED;
+#endif
+  }
   if (key_cert_pair != nullptr) {
     if (key_cert_pair->cert_chain != nullptr) {
       result = ssl_ctx_use_certificate_chain(context, key_cert_pair->cert_chain,
@@ -846,7 +1024,7 @@ static tsi_result populate_ssl_context(
         return result;
       }
     }
-    if (key_cert_pair->private_key != nullptr) {
+    if (key_cert_pair->private_key != nullptr && !use_private_key_signer) {
       result = ssl_ctx_use_private_key(context, key_cert_pair->private_key,
                                        strlen(key_cert_pair->private_key));
       if (result != TSI_OK || !SSL_CTX_check_private_key(context)) {
@@ -1200,6 +1378,159 @@ static const tsi_frame_protector_vtable frame_protector_vtable = {
     ssl_protector_destroy,
 };
 
+/* --- tsi_zero_copy_grpc_protector methods implementation. ---*/
+
+/* Encrypts bytes into records and moves them from the network BIO into a
+   single slice of protected_slices. size must fit in one record so that the
+   records fit in the BIO. */
+static tsi_result ssl_zero_copy_grpc_protector_write(
+    tsi_ssl_zero_copy_grpc_protector* impl, unsigned char* bytes, size_t size,
+    grpc_slice_buffer* protected_slices) {
+  tsi_result result = do_ssl_write(impl->ssl, bytes, size);
+  if (result != TSI_OK) return result;
+  int pending = static_cast<int>(BIO_pending(impl->network_io));
+  if (pending <= 0) return TSI_OK;
+  grpc_slice slice = GRPC_SLICE_MALLOC(static_cast<size_t>(pending));
+  int read_from_ssl =
+      BIO_read(impl->network_io, GRPC_SLICE_START_PTR(slice), pending);
+  if (read_from_ssl != pending) {
+    gpr_log(GPR_ERROR, "Could not read from BIO after SSL_write.");
+    grpc_slice_unref_internal(slice);
+    return TSI_INTERNAL_ERROR;
+  }
+  grpc_slice_buffer_add(protected_slices, slice);
+  return TSI_OK;
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_protect(
+    tsi_zero_copy_grpc_protector* self, grpc_slice_buffer* unprotected_slices,
+    grpc_slice_buffer* protected_slices) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  tsi_result result = TSI_OK;
+  size_t buffer_offset = 0;
+  gpr_mu_lock(&impl->mu);
+  for (size_t i = 0; i < unprotected_slices->count && result == TSI_OK; i++) {
+    unsigned char* bytes = GRPC_SLICE_START_PTR(unprotected_slices->slices[i]);
+    size_t size = GRPC_SLICE_LENGTH(unprotected_slices->slices[i]);
+    while (size > 0 && result == TSI_OK) {
+      size_t written;
+      if (size >= TSI_SSL_ZERO_COPY_MIN_DIRECT_WRITE_SIZE) {
+        /* Flush what was coalesced so far, then encrypt straight from the
+           slice. */
+        if (buffer_offset > 0) {
+          result = ssl_zero_copy_grpc_protector_write(
+              impl, impl->buffer, buffer_offset, protected_slices);
+          buffer_offset = 0;
+          if (result != TSI_OK) break;
+        }
+        written = std::min(size, impl->buffer_size);
+        result = ssl_zero_copy_grpc_protector_write(impl, bytes, written,
+                                                    protected_slices);
+      } else {
+        written = std::min(size, impl->buffer_size - buffer_offset);
+        memcpy(impl->buffer + buffer_offset, bytes, written);
+        buffer_offset += written;
+        if (buffer_offset == impl->buffer_size) {
+          result = ssl_zero_copy_grpc_protector_write(
+              impl, impl->buffer, buffer_offset, protected_slices);
+          buffer_offset = 0;
+        }
+      }
+      bytes += written;
+      size -= written;
+    }
+  }
+  if (result == TSI_OK && buffer_offset > 0) {
+    result = ssl_zero_copy_grpc_protector_write(impl, impl->buffer,
+                                                buffer_offset, protected_slices);
+  }
+  gpr_mu_unlock(&impl->mu);
+  grpc_slice_buffer_reset_and_unref_internal(unprotected_slices);
+  return result;
+}
+
+/* Decrypts whatever complete records SSL has into slices of
+   unprotected_slices. */
+static tsi_result ssl_zero_copy_grpc_protector_read(
+    tsi_ssl_zero_copy_grpc_protector* impl,
+    grpc_slice_buffer* unprotected_slices) {
+  while (true) {
+    if (GRPC_SLICE_LENGTH(impl->read_slice) <
+        TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND) {
+      grpc_slice_unref_internal(impl->read_slice);
+      impl->read_slice = GRPC_SLICE_MALLOC(impl->buffer_size);
+    }
+    size_t read_size = GRPC_SLICE_LENGTH(impl->read_slice);
+    tsi_result result = do_ssl_read(
+        impl->ssl, GRPC_SLICE_START_PTR(impl->read_slice), &read_size);
+    if (result != TSI_OK || read_size == 0) return result;
+    grpc_slice_buffer_add(unprotected_slices,
+                          grpc_slice_split_head(&impl->read_slice, read_size));
+  }
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_unprotect(
+    tsi_zero_copy_grpc_protector* self, grpc_slice_buffer* protected_slices,
+    grpc_slice_buffer* unprotected_slices) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  tsi_result result = TSI_OK;
+  gpr_mu_lock(&impl->mu);
+  for (size_t i = 0; i < protected_slices->count && result == TSI_OK; i++) {
+    const unsigned char* bytes =
+        GRPC_SLICE_START_PTR(protected_slices->slices[i]);
+    size_t size = GRPC_SLICE_LENGTH(protected_slices->slices[i]);
+    while (size > 0) {
+      /* The BIO may not take all of it; decrypting makes room for more. */
+      GPR_ASSERT(size <= INT_MAX);
+      int written_into_ssl =
+          BIO_write(impl->network_io, bytes, static_cast<int>(size));
+      if (written_into_ssl < 0) {
+        gpr_log(GPR_ERROR, "Sending protected frame to ssl failed with %d",
+                written_into_ssl);
+        result = TSI_INTERNAL_ERROR;
+        break;
+      }
+      bytes += written_into_ssl;
+      size -= static_cast<size_t>(written_into_ssl);
+      result = ssl_zero_copy_grpc_protector_read(impl, unprotected_slices);
+      if (result != TSI_OK) break;
+    }
+  }
+  gpr_mu_unlock(&impl->mu);
+  grpc_slice_buffer_reset_and_unref_internal(protected_slices);
+  return result;
+}
+
+static void ssl_zero_copy_grpc_protector_destroy(
+    tsi_zero_copy_grpc_protector* self) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  gpr_free(impl->buffer);
+  grpc_slice_unref_internal(impl->read_slice);
+  if (impl->ssl != nullptr) SSL_free(impl->ssl);
+  if (impl->network_io != nullptr) BIO_free(impl->network_io);
+  gpr_mu_destroy(&impl->mu);
+  gpr_free(impl);
+}
+
+static tsi_result ssl_zero_copy_grpc_protector_max_frame_size(
+    tsi_zero_copy_grpc_protector* self, size_t* max_frame_size) {
+  tsi_ssl_zero_copy_grpc_protector* impl =
+      reinterpret_cast<tsi_ssl_zero_copy_grpc_protector*>(self);
+  *max_frame_size = impl->buffer_size + TSI_SSL_MAX_PROTECTION_OVERHEAD;
+  return TSI_OK;
+}
+
+static const tsi_zero_copy_grpc_protector_vtable
+    zero_copy_grpc_protector_vtable = {
+        ssl_zero_copy_grpc_protector_protect,
+        ssl_zero_copy_grpc_protector_unprotect,
+        ssl_zero_copy_grpc_protector_destroy,
+        ssl_zero_copy_grpc_protector_max_frame_size,
+};
+
 /* --- tsi_server_handshaker_factory methods implementation. --- */
 
 static void tsi_ssl_handshaker_factory_destroy(
@@ -1337,15 +1668,57 @@ static tsi_result ssl_handshaker_result_extract_peer(
 static tsi_result ssl_handshaker_result_get_frame_protector_type(
     const tsi_handshaker_result* /*self*/,
     tsi_frame_protector_type* frame_protector_type) {
-  *frame_protector_type = TSI_FRAME_PROTECTOR_NORMAL;
+  *frame_protector_type = TSI_FRAME_PROTECTOR_NORMAL_OR_ZERO_COPY;
+  return TSI_OK;
+}
+
+/* Clamps the requested max protected frame size and returns it. */
+static size_t ssl_max_output_protected_frame_size(
+    size_t* max_output_protected_frame_size) {
+  if (max_output_protected_frame_size == nullptr) {
+    return TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
+  }
+  if (*max_output_protected_frame_size >
+      TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND) {
+    *max_output_protected_frame_size =
+        TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
+  } else if (*max_output_protected_frame_size <
+             TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND) {
+    *max_output_protected_frame_size =
+        TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND;
+  }
+  return *max_output_protected_frame_size;
+}
+
+static tsi_result ssl_handshaker_result_create_zero_copy_grpc_protector(
+    const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
+    tsi_zero_copy_grpc_protector** protector) {
+  tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<tsi_ssl_handshaker_result*>(
+          const_cast<tsi_handshaker_result*>(self));
+  tsi_ssl_zero_copy_grpc_protector* protector_impl =
+      static_cast<tsi_ssl_zero_copy_grpc_protector*>(
+          gpr_zalloc(sizeof(*protector_impl)));
+  protector_impl->buffer_size =
+      ssl_max_output_protected_frame_size(max_output_protected_frame_size) -
+      TSI_SSL_MAX_PROTECTION_OVERHEAD;
+  protector_impl->buffer =
+      static_cast<unsigned char*>(gpr_malloc(protector_impl->buffer_size));
+  protector_impl->read_slice = grpc_empty_slice();
+  gpr_mu_init(&protector_impl->mu);
+  /* Transfer ownership of ssl and network_io to the protector. */
+  protector_impl->ssl = impl->ssl;
+  impl->ssl = nullptr;
+  protector_impl->network_io = impl->network_io;
+  impl->network_io = nullptr;
+  protector_impl->base.vtable = &zero_copy_grpc_protector_vtable;
+  *protector = &protector_impl->base;
   return TSI_OK;
 }
 
 static tsi_result ssl_handshaker_result_create_frame_protector(
     const tsi_handshaker_result* self, size_t* max_output_protected_frame_size,
     tsi_frame_protector** protector) {
-  size_t actual_max_output_protected_frame_size =
-      TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
   tsi_ssl_handshaker_result* impl =
       reinterpret_cast<tsi_ssl_handshaker_result*>(
           const_cast<tsi_handshaker_result*>(self));
@@ -1353,20 +1726,9 @@ static tsi_result ssl_handshaker_result_create_frame_protector(
       static_cast<tsi_ssl_frame_protector*>(
           gpr_zalloc(sizeof(*protector_impl)));
 
-  if (max_output_protected_frame_size != nullptr) {
-    if (*max_output_protected_frame_size >
-        TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND) {
-      *max_output_protected_frame_size =
-          TSI_SSL_MAX_PROTECTED_FRAME_SIZE_UPPER_BOUND;
-    } else if (*max_output_protected_frame_size <
-               TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND) {
-      *max_output_protected_frame_size =
-          TSI_SSL_MAX_PROTECTED_FRAME_SIZE_LOWER_BOUND;
-    }
-    actual_max_output_protected_frame_size = *max_output_protected_frame_size;
-  }
   protector_impl->buffer_size =
-      actual_max_output_protected_frame_size - TSI_SSL_MAX_PROTECTION_OVERHEAD;
+      ssl_max_output_protected_frame_size(max_output_protected_frame_size) -
+      TSI_SSL_MAX_PROTECTION_OVERHEAD;
   protector_impl->buffer =
       static_cast<unsigned char*>(gpr_malloc(protector_impl->buffer_size));
   if (protector_impl->buffer == nullptr) {
@@ -1396,6 +1758,145 @@ static tsi_result ssl_handshaker_result_get_unused_bytes(
   return TSI_OK;
 }
 
+#ifdef TSI_SSL_KERNEL_TLS_SUPPORTED
+/* HKDF-Expand-Label of TLS 1.3 (RFC 8446, section 7.1) with an empty
+   context. out_size must not exceed the hash size, so that one HMAC
+   suffices. */
+static bool tls13_hkdf_expand_label(const EVP_MD* md,
+                                    const std::string& secret,
+                                    absl::string_view label, uint8_t* out,
+                                    size_t out_size) {
+  if (out_size > static_cast<size_t>(EVP_MD_size(md))) return false;
+  const absl::string_view kLabelPrefix = "tls13 ";
+  std::string info;
+  info.push_back(static_cast<char>(out_size >> 8));
+  info.push_back(static_cast<char>(out_size & 0xff));
+  info.push_back(static_cast<char>(kLabelPrefix.size() + label.size()));
+  info.append(kLabelPrefix.data(), kLabelPrefix.size());
+  info.append(label.data(), label.size());
+  info.push_back(0); /* Context length. */
+  info.push_back(1); /* HKDF-Expand counter of the first block. */
+  uint8_t block[EVP_MAX_MD_SIZE];
+  unsigned int block_size = 0;
+  if (HMAC(md, secret.data(), static_cast<int>(secret.size()),
+           reinterpret_cast<const uint8_t*>(info.data()), info.size(), block,
+           &block_size) == nullptr) {
+    return false;
+  }
+  memcpy(out, block, out_size);
+  OPENSSL_cleanse(block, sizeof(block));
+  return true;
+}
+
+/* Fills the kernel crypto info of a TLS 1.3 AEAD cipher from the traffic
+   secret. The 12 byte IV of TLS 1.3 is split into salt and iv. */
+template <typename CryptoInfo>
+static bool ssl_fill_kernel_tls_crypto_info(const EVP_MD* md,
+                                            const std::string& secret,
+                                            uint16_t cipher_type,
+                                            uint64_t sequence,
+                                            CryptoInfo* crypto_info) {
+  static_assert(sizeof(crypto_info->salt) + sizeof(crypto_info->iv) == 12,
+                "TLS 1.3 IVs are 12 bytes");
+  memset(crypto_info, 0, sizeof(*crypto_info));
+  crypto_info->info.version = TLS_1_3_VERSION;
+  crypto_info->info.cipher_type = cipher_type;
+  uint8_t iv[12];
+  if (!tls13_hkdf_expand_label(md, secret, "key", crypto_info->key,
+                               sizeof(crypto_info->key)) ||
+      !tls13_hkdf_expand_label(md, secret, "iv", iv, sizeof(iv))) {
+    return false;
+  }
+  memcpy(crypto_info->salt, iv, sizeof(crypto_info->salt));
+  memcpy(crypto_info->iv, iv + sizeof(crypto_info->salt),
+         sizeof(crypto_info->iv));
+  OPENSSL_cleanse(iv, sizeof(iv));
+  for (size_t i = 0; i < sizeof(crypto_info->rec_seq); ++i) {
+    crypto_info->rec_seq[i] = static_cast<unsigned char>(
+        sequence >> (8 * (sizeof(crypto_info->rec_seq) - 1 - i)));
+  }
+  return true;
+}
+#endif
+
+static tsi_result ssl_handshaker_result_enable_kernel_tx_protection(
+    tsi_handshaker_result* self, int fd) {
+#ifdef TSI_SSL_KERNEL_TLS_SUPPORTED
+  tsi_ssl_handshaker_result* impl =
+      reinterpret_cast<tsi_ssl_handshaker_result*>(self);
+  /* The secret is only kept if the factory enabled kernel TLS and TLS 1.3
+     was negotiated. */
+  std::string* secret = impl->ssl == nullptr
+                            ? nullptr
+                            : static_cast<std::string*>(SSL_get_ex_data(
+                                  impl->ssl, g_ssl_ex_kernel_tls_secret_index));
+  if (fd < 0 || secret == nullptr || SSL_version(impl->ssl) != TLS1_3_VERSION) {
+    return TSI_UNIMPLEMENTED;
+  }
+  /* Records written with the application traffic keys so far, i.e. session
+     tickets sent by a server. Without BoringSSL, servers do not send any when
+     kernel TLS is enabled. */
+  uint64_t sequence = 0;
+#ifdef OPENSSL_IS_BORINGSSL
+  sequence = SSL_get_write_sequence(impl->ssl);
+#endif
+  union {
+    tls12_crypto_info_aes_gcm_128 aes_gcm_128;
+    tls12_crypto_info_aes_gcm_256 aes_gcm_256;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    tls12_crypto_info_chacha20_poly1305 chacha20_poly1305;
+#endif
+  } crypto_info;
+  size_t crypto_info_size = 0;
+  bool filled = false;
+  switch (SSL_CIPHER_get_id(SSL_get_current_cipher(impl->ssl)) & 0xffff) {
+    case 0x1301: /* TLS_AES_128_GCM_SHA256 */
+      filled = ssl_fill_kernel_tls_crypto_info(
+          EVP_sha256(), *secret, TLS_CIPHER_AES_GCM_128, sequence,
+          &crypto_info.aes_gcm_128);
+      crypto_info_size = sizeof(crypto_info.aes_gcm_128);
+      break;
+    case 0x1302: /* TLS_AES_256_GCM_SHA384 */
+      filled = ssl_fill_kernel_tls_crypto_info(
+          EVP_sha384(), *secret, TLS_CIPHER_AES_GCM_256, sequence,
+          &crypto_info.aes_gcm_256);
+      crypto_info_size = sizeof(crypto_info.aes_gcm_256);
+      break;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case 0x1303: /* TLS_CHACHA20_POLY1305_SHA256 */
+      filled = ssl_fill_kernel_tls_crypto_info(
+          EVP_sha256(), *secret, TLS_CIPHER_CHACHA20_POLY1305, sequence,
+          &crypto_info.chacha20_poly1305);
+      crypto_info_size = sizeof(crypto_info.chacha20_poly1305);
+      break;
+#endif
+    default:
+      break;
+  }
+  tsi_result result = TSI_UNIMPLEMENTED;
+  /* Until TLS_TX is set, the tls ULP passes writes through unchanged, so
+     failing after attaching it leaves the socket usable. */
+  if (filled &&
+      setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) == 0 &&
+      setsockopt(fd, SOL_TLS, TLS_TX, &crypto_info,
+                 static_cast<socklen_t>(crypto_info_size)) == 0) {
+    result = TSI_OK;
+  } else if (filled) {
+    gpr_log(GPR_DEBUG, "Kernel TLS not available on fd %d: %s", fd,
+            strerror(errno));
+  }
+  OPENSSL_cleanse(&crypto_info, sizeof(crypto_info));
+  /* The secret is not needed anymore either way. */
+  SSL_set_ex_data(impl->ssl, g_ssl_ex_kernel_tls_secret_index, nullptr);
+  ssl_kernel_tls_secret_free(nullptr, secret, nullptr, 0, 0, nullptr);
+  return result;
+#else
+  (void)self;
+  (void)fd;
+  return TSI_UNIMPLEMENTED;
+#endif
+}
+
 static void ssl_handshaker_result_destroy(tsi_handshaker_result* self) {
   tsi_ssl_handshaker_result* impl =
       reinterpret_cast<tsi_ssl_handshaker_result*>(self);
@@ -1408,10 +1909,11 @@ static void ssl_handshaker_result_destroy(tsi_handshaker_result* self) {
 static const tsi_handshaker_result_vtable handshaker_result_vtable = {
     ssl_handshaker_result_extract_peer,
     ssl_handshaker_result_get_frame_protector_type,
-    nullptr, /* create_zero_copy_grpc_protector */
+    ssl_handshaker_result_create_zero_copy_grpc_protector,
     ssl_handshaker_result_create_frame_protector,
     ssl_handshaker_result_get_unused_bytes,
     ssl_handshaker_result_destroy,
+    ssl_handshaker_result_enable_kernel_tx_protection,
 };
 
 static tsi_result ssl_handshaker_result_create(
@@ -1427,6 +1929,9 @@ static tsi_result ssl_handshaker_result_create(
   /* Transfer ownership of ssl and network_io to the handshaker result. */
   result->ssl = handshaker->ssl;
   handshaker->ssl = nullptr;
+#ifdef OPENSSL_IS_BORINGSSL
+  SSL_set_ex_data(result->ssl, g_ssl_ex_handshaker_index, nullptr);
+#endif
   result->network_io = handshaker->network_io;
   handshaker->network_io = nullptr;
   /* Transfer ownership of |unused_bytes| to the handshaker result. */
@@ -1489,6 +1994,11 @@ static tsi_result ssl_handshaker_do_handshake(tsi_ssl_handshaker* impl) {
         return TSI_OK;
       case SSL_ERROR_WANT_WRITE:
         return TSI_DRAIN_BUFFER;
+#ifdef OPENSSL_IS_BORINGSSL
+      case SSL_ERROR_WANT_PRIVATE_KEY_OPERATION:
+        /* Waiting for private_key_signer. */
+        return TSI_ASYNC;
+#endif
       default: {
         char err_str[256];
         ERR_error_string_n(ERR_get_error(), err_str, sizeof(err_str));
@@ -1524,6 +2034,8 @@ static void ssl_handshaker_destroy(tsi_handshaker* self) {
   SSL_free(impl->ssl);
   BIO_free(impl->network_io);
   gpr_free(impl->outgoing_bytes_buffer);
+  gpr_mu_destroy(&impl->mu);
+  gpr_free(impl->signature);
   tsi_ssl_handshaker_factory_unref(impl->factory_ref);
   gpr_free(impl);
 }
@@ -1582,37 +2094,62 @@ static tsi_result ssl_handshaker_write_output_buffer(tsi_handshaker* self,
   return status;
 }
 
-static tsi_result ssl_handshaker_next(
-    tsi_handshaker* self, const unsigned char* received_bytes,
-    size_t received_bytes_size, const unsigned char** bytes_to_send,
-    size_t* bytes_to_send_size, tsi_handshaker_result** handshaker_result,
-    tsi_handshaker_on_next_done_cb /*cb*/, void* /*user_data*/) {
-  /* Input sanity check.  */
-  if ((received_bytes_size > 0 && received_bytes == nullptr) ||
-      bytes_to_send == nullptr || bytes_to_send_size == nullptr ||
-      handshaker_result == nullptr) {
-    return TSI_INVALID_ARGUMENT;
+/* Returns true if the signature that the handshake returned TSI_ASYNC for is
+   available already. Otherwise, ssl_private_key_sign_done resumes the
+   handshake once it is. */
+static bool ssl_handshaker_private_key_op_done(tsi_ssl_handshaker* impl) {
+  gpr_mu_lock(&impl->mu);
+  const bool done =
+      impl->private_key_op_state == TSI_SSL_PRIVATE_KEY_OP_DONE;
+  if (!done) {
+    GPR_ASSERT(impl->private_key_op_state == TSI_SSL_PRIVATE_KEY_OP_PENDING);
+    impl->private_key_op_state = TSI_SSL_PRIVATE_KEY_OP_ASYNC;
+  }
+  gpr_mu_unlock(&impl->mu);
+  return done;
+}
+
+/* Runs the part of tsi_handshaker_next that follows giving the received bytes
+   to SSL, |status| being the result of the last handshake step. Returns
+   TSI_ASYNC if the handshake has to wait for private_key_signer. */
+/* Counts a completed handshake as full or resumed in the stats. */
+static void ssl_handshaker_count_completed_handshake(SSL* ssl) {
+  // TSI may be driven without an ExecCtx, e.g. by its own tests.
+  if (grpc_core::ExecCtx::Get() == nullptr) return;
+  const bool resumed = SSL_session_reused(ssl) != 0;
+  if (SSL_is_server(ssl)) {
+    if (resumed) {
+      GRPC_STATS_INC_SSL_SERVER_RESUMED_HANDSHAKES();
+    } else {
+      GRPC_STATS_INC_SSL_SERVER_FULL_HANDSHAKES();
+    }
+  } else if (resumed) {
+    GRPC_STATS_INC_SSL_CLIENT_RESUMED_HANDSHAKES();
+  } else {
+    GRPC_STATS_INC_SSL_CLIENT_FULL_HANDSHAKES();
   }
-  /* If there are received bytes, process them first.  */
-  tsi_ssl_handshaker* impl = reinterpret_cast<tsi_ssl_handshaker*>(self);
-  tsi_result status = TSI_OK;
-  size_t bytes_consumed = received_bytes_size;
-  size_t bytes_written = 0;
-  if (received_bytes_size > 0) {
-    status = ssl_handshaker_process_bytes_from_peer(impl, received_bytes,
-                                                    &bytes_consumed);
-    while (status == TSI_DRAIN_BUFFER) {
-      status = ssl_handshaker_write_output_buffer(self, &bytes_written);
+}
+
+static tsi_result ssl_handshaker_next_continue(
+    tsi_ssl_handshaker* impl, tsi_result status,
+    const unsigned char** bytes_to_send, size_t* bytes_to_send_size,
+    tsi_handshaker_result** handshaker_result) {
+  tsi_handshaker* self = &impl->base;
+  while (status == TSI_DRAIN_BUFFER || status == TSI_ASYNC) {
+    if (status == TSI_DRAIN_BUFFER) {
+      status = ssl_handshaker_write_output_buffer(self, &impl->bytes_written);
       if (status != TSI_OK) return status;
-      status = ssl_handshaker_do_handshake(impl);
+    } else if (!ssl_handshaker_private_key_op_done(impl)) {
+      return TSI_ASYNC;
     }
+    status = ssl_handshaker_do_handshake(impl);
   }
   if (status != TSI_OK) return status;
   /* Get bytes to send to the peer, if available.  */
-  status = ssl_handshaker_write_output_buffer(self, &bytes_written);
+  status = ssl_handshaker_write_output_buffer(self, &impl->bytes_written);
   if (status != TSI_OK) return status;
   *bytes_to_send = impl->outgoing_bytes_buffer;
-  *bytes_to_send_size = bytes_written;
+  *bytes_to_send_size = impl->bytes_written;
   /* If handshake completes, create tsi_handshaker_result.  */
   if (ssl_handshaker_get_result(impl) == TSI_HANDSHAKE_IN_PROGRESS) {
     *handshaker_result = nullptr;
@@ -1625,11 +2162,12 @@ static tsi_result ssl_handshaker_next(
     size_t unused_bytes_size = 0;
     status = ssl_bytes_remaining(impl, &unused_bytes, &unused_bytes_size);
     if (status != TSI_OK) return status;
-    if (unused_bytes_size > received_bytes_size) {
+    if (unused_bytes_size > impl->received_bytes_size) {
       gpr_log(GPR_ERROR, "More unused bytes than received bytes.");
       gpr_free(unused_bytes);
       return TSI_INTERNAL_ERROR;
     }
+    ssl_handshaker_count_completed_handshake(impl->ssl);
     status = ssl_handshaker_result_create(impl, unused_bytes, unused_bytes_size,
                                           handshaker_result);
     if (status == TSI_OK) {
@@ -1641,6 +2179,67 @@ static tsi_result ssl_handshaker_next(
   return status;
 }
 
+static tsi_result ssl_handshaker_next(
+    tsi_handshaker* self, const unsigned char* received_bytes,
+    size_t received_bytes_size, const unsigned char** bytes_to_send,
+    size_t* bytes_to_send_size, tsi_handshaker_result** handshaker_result,
+    tsi_handshaker_on_next_done_cb cb, void* user_data) {
+  /* Input sanity check.  */
+  if ((received_bytes_size > 0 && received_bytes == nullptr) ||
+      bytes_to_send == nullptr || bytes_to_send_size == nullptr ||
+      handshaker_result == nullptr) {
+    return TSI_INVALID_ARGUMENT;
+  }
+  /* If there are received bytes, process them first.  */
+  tsi_ssl_handshaker* impl = reinterpret_cast<tsi_ssl_handshaker*>(self);
+  tsi_result status = TSI_OK;
+  size_t bytes_consumed = received_bytes_size;
+  impl->received_bytes_size = received_bytes_size;
+  impl->bytes_written = 0;
+  impl->cb = cb;
+  impl->user_data = user_data;
+  if (received_bytes_size > 0) {
+    status = ssl_handshaker_process_bytes_from_peer(impl, received_bytes,
+                                                    &bytes_consumed);
+  }
+  return ssl_handshaker_next_continue(impl, status, bytes_to_send,
+                                      bytes_to_send_size, handshaker_result);
+}
+
+#ifdef OPENSSL_IS_BORINGSSL
+/* Called by private_key_signer, from any thread. Finishes the
+   tsi_handshaker_next call that returned TSI_ASYNC, if any. */
+static void ssl_private_key_sign_done(void* done_arg, grpc_status_code status,
+                                      const unsigned char* signature,
+                                      size_t signature_size) {
+  tsi_ssl_handshaker* impl = static_cast<tsi_ssl_handshaker*>(done_arg);
+  gpr_mu_lock(&impl->mu);
+  GPR_ASSERT(impl->private_key_op_state == TSI_SSL_PRIVATE_KEY_OP_PENDING ||
+             impl->private_key_op_state == TSI_SSL_PRIVATE_KEY_OP_ASYNC);
+  const bool resume =
+      impl->private_key_op_state == TSI_SSL_PRIVATE_KEY_OP_ASYNC;
+  impl->private_key_op_ok = status == GRPC_STATUS_OK;
+  if (impl->private_key_op_ok && signature_size > 0) {
+    impl->signature = static_cast<unsigned char*>(gpr_malloc(signature_size));
+    memcpy(impl->signature, signature, signature_size);
+    impl->signature_size = signature_size;
+  }
+  impl->private_key_op_state = TSI_SSL_PRIVATE_KEY_OP_DONE;
+  gpr_mu_unlock(&impl->mu);
+  if (!resume) return;
+  grpc_core::ExecCtx exec_ctx;
+  const unsigned char* bytes_to_send = nullptr;
+  size_t bytes_to_send_size = 0;
+  tsi_handshaker_result* handshaker_result = nullptr;
+  tsi_result result = ssl_handshaker_next_continue(
+      impl, ssl_handshaker_do_handshake(impl), &bytes_to_send,
+      &bytes_to_send_size, &handshaker_result);
+  if (result == TSI_ASYNC) return;
+  impl->cb(result, impl->user_data, bytes_to_send, bytes_to_send_size,
+           handshaker_result);
+}
+#endif /* OPENSSL_IS_BORINGSSL */
+
 static const tsi_handshaker_vtable handshaker_vtable = {
     nullptr, /* get_bytes_to_send_to_peer -- deprecated */
     nullptr, /* process_bytes_from_peer   -- deprecated */
@@ -1667,12 +2266,11 @@ static void tsi_ssl_handshaker_resume_session(
   }
 }
 
-static tsi_result create_tsi_ssl_handshaker(SSL_CTX* ctx, int is_client,
-                                            const char* server_name_indication,
-                                            size_t network_bio_buf_size,
-                                            size_t ssl_bio_buf_size,
-                                            tsi_ssl_handshaker_factory* factory,
-                                            tsi_handshaker** handshaker) {
+static tsi_result create_tsi_ssl_handshaker(
+    SSL_CTX* ctx, int is_client, const char* server_name_indication,
+    size_t network_bio_buf_size, size_t ssl_bio_buf_size,
+    tsi_ssl_handshaker_factory* factory,
+    tsi::SslPrivateKeySigner* private_key_signer, tsi_handshaker** handshaker) {
   SSL* ssl = SSL_new(ctx);
   BIO* network_io = nullptr;
   BIO* ssl_io = nullptr;
@@ -1737,6 +2335,13 @@ static tsi_result create_tsi_ssl_handshaker(SSL_CTX* ctx, int is_client,
       static_cast<unsigned char*>(gpr_zalloc(impl->outgoing_bytes_buffer_size));
   impl->base.vtable = &handshaker_vtable;
   impl->factory_ref = tsi_ssl_handshaker_factory_ref(factory);
+  impl->private_key_signer = private_key_signer;
+  gpr_mu_init(&impl->mu);
+#ifdef OPENSSL_IS_BORINGSSL
+  if (private_key_signer != nullptr) {
+    SSL_set_ex_data(ssl, g_ssl_ex_handshaker_index, impl);
+  }
+#endif
   *handshaker = &impl->base;
   return TSI_OK;
 }
@@ -1777,7 +2382,8 @@ tsi_result tsi_ssl_client_handshaker_factory_create_handshaker(
     size_t ssl_bio_buf_size, tsi_handshaker** handshaker) {
   return create_tsi_ssl_handshaker(
       factory->ssl_context, 1, server_name_indication, network_bio_buf_size,
-      ssl_bio_buf_size, &factory->base, handshaker);
+      ssl_bio_buf_size, &factory->base, factory->private_key_signer.get(),
+      handshaker);
 }
 
 void tsi_ssl_client_handshaker_factory_unref(
@@ -1795,6 +2401,7 @@ static void tsi_ssl_client_handshaker_factory_destroy(
   if (self->alpn_protocol_list != nullptr) gpr_free(self->alpn_protocol_list);
   self->session_cache.reset();
   self->key_logger.reset();
+  self->private_key_signer.reset();
   gpr_free(self);
 }
 
@@ -1816,9 +2423,10 @@ tsi_result tsi_ssl_server_handshaker_factory_create_handshaker(
   if (factory->ssl_context_count == 0) return TSI_INVALID_ARGUMENT;
   /* Create the handshaker with the first context. We will switch if needed
      because of SNI in ssl_server_handshaker_factory_servername_callback.  */
-  return create_tsi_ssl_handshaker(factory->ssl_contexts[0], 0, nullptr,
-                                   network_bio_buf_size, ssl_bio_buf_size,
-                                   &factory->base, handshaker);
+  return create_tsi_ssl_handshaker(
+      factory->ssl_contexts[0], 0, nullptr, network_bio_buf_size,
+      ssl_bio_buf_size, &factory->base, factory->private_key_signer.get(),
+      handshaker);
 }
 
 void tsi_ssl_server_handshaker_factory_unref(
@@ -1845,6 +2453,7 @@ static void tsi_ssl_server_handshaker_factory_destroy(
   }
   if (self->alpn_protocol_list != nullptr) gpr_free(self->alpn_protocol_list);
   self->key_logger.reset();
+  self->private_key_signer.reset();
   gpr_free(self);
 }
 
@@ -1957,15 +2566,43 @@ static int server_handshaker_factory_new_session_callback(
   return 1;
 }
 
+#ifdef TSI_SSL_KERNEL_TLS_SUPPORTED
+/// Keeps the traffic secret of the data written by this end of the
+/// connection, from a key log line, for kernel TLS.
+static void ssl_keep_kernel_tls_secret(const SSL* ssl, const char* info) {
+  absl::string_view line = info;
+  if (!absl::ConsumePrefix(&line, SSL_is_server(ssl)
+                                      ? "SERVER_TRAFFIC_SECRET_0 "
+                                      : "CLIENT_TRAFFIC_SECRET_0 ")) {
+    return;
+  }
+  // The label is followed by the client random and the secret, in hex.
+  const size_t space = line.find(' ');
+  if (space == absl::string_view::npos) return;
+  SSL* mutable_ssl = const_cast<SSL*>(ssl);
+  ssl_kernel_tls_secret_free(
+      nullptr, SSL_get_ex_data(mutable_ssl, g_ssl_ex_kernel_tls_secret_index),
+      nullptr, 0, 0, nullptr);
+  SSL_set_ex_data(
+      mutable_ssl, g_ssl_ex_kernel_tls_secret_index,
+      new std::string(absl::HexStringToBytes(line.substr(space + 1))));
+}
+#endif
+
 /// This callback is invoked at client or server when ssl/tls handshakes
-/// complete and keylogging is enabled.
+/// complete and keylogging or kernel TLS is enabled.
 template <typename T>
 static void ssl_keylogging_callback(const SSL* ssl, const char* info) {
   SSL_CTX* ssl_context = SSL_get_SSL_CTX(ssl);
   GPR_ASSERT(ssl_context != nullptr);
   void* arg = SSL_CTX_get_ex_data(ssl_context, g_ssl_ctx_ex_factory_index);
   T* factory = static_cast<T*>(arg);
-  factory->key_logger->LogSessionKeys(ssl_context, info);
+  if (factory->key_logger != nullptr) {
+    factory->key_logger->LogSessionKeys(ssl_context, info);
+  }
+#ifdef TSI_SSL_KERNEL_TLS_SUPPORTED
+  if (factory->enable_kernel_tls_tx) ssl_keep_kernel_tls_secret(ssl, info);
+#endif
 }
 
 // This callback is invoked when the CRL has been verified and will soft-fail
@@ -2048,10 +2685,18 @@ tsi_result tsi_create_ssl_client_handshaker_factory_with_options(
                             server_handshaker_factory_new_session_callback);
     SSL_CTX_set_session_cache_mode(ssl_context, SSL_SESS_CACHE_CLIENT);
   }
+  if (options->private_key_signer != nullptr) {
+    impl->private_key_signer = options->private_key_signer->Ref();
+  }
 
+#ifdef TSI_SSL_KERNEL_TLS_SUPPORTED
+  impl->enable_kernel_tls_tx = options->enable_kernel_tls_tx;
+#endif
 #if OPENSSL_VERSION_NUMBER >= 0x10101000 && !defined(LIBRESSL_VERSION_NUMBER)
   if (options->key_logger != nullptr) {
     impl->key_logger = options->key_logger->Ref();
+  }
+  if (impl->key_logger != nullptr || impl->enable_kernel_tls_tx) {
     // SSL_CTX_set_keylog_callback is set here to register callback
     // when ssl/tls handshakes complete.
     SSL_CTX_set_keylog_callback(
@@ -2060,14 +2705,16 @@ tsi_result tsi_create_ssl_client_handshaker_factory_with_options(
   }
 #endif
 
-  if (options->session_cache != nullptr || options->key_logger != nullptr) {
+  if (options->session_cache != nullptr || options->key_logger != nullptr ||
+      impl->enable_kernel_tls_tx) {
     // Need to set factory at g_ssl_ctx_ex_factory_index
     SSL_CTX_set_ex_data(ssl_context, g_ssl_ctx_ex_factory_index, impl);
   }
 
   do {
     result = populate_ssl_context(ssl_context, options->pem_key_cert_pair,
-                                  options->cipher_suites);
+                                  options->cipher_suites,
+                                  impl->private_key_signer != nullptr);
     if (result != TSI_OK) break;
 
 #if OPENSSL_VERSION_NUMBER >= 0x10100000
@@ -2221,6 +2868,12 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
   if (options->key_logger != nullptr) {
     impl->key_logger = options->key_logger->Ref();
   }
+#ifdef TSI_SSL_KERNEL_TLS_SUPPORTED
+  impl->enable_kernel_tls_tx = options->enable_kernel_tls_tx;
+#endif
+  if (options->private_key_signer != nullptr) {
+    impl->private_key_signer = options->private_key_signer->Ref();
+  }
 
   for (i = 0; i < options->num_key_cert_pairs; i++) {
     do {
@@ -2241,9 +2894,9 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
                                                 options->max_tls_version);
       if (result != TSI_OK) return result;
 
-      result = populate_ssl_context(impl->ssl_contexts[i],
-                                    &options->pem_key_cert_pairs[i],
-                                    options->cipher_suites);
+      result = populate_ssl_context(
+          impl->ssl_contexts[i], &options->pem_key_cert_pairs[i],
+          options->cipher_suites, impl->private_key_signer != nullptr);
       if (result != TSI_OK) break;
 
       // TODO(elessar): Provide ability to disable session ticket keys.
@@ -2340,7 +2993,7 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
 
 #if OPENSSL_VERSION_NUMBER >= 0x10101000 && !defined(LIBRESSL_VERSION_NUMBER)
       /* Register factory at index */
-      if (options->key_logger != nullptr) {
+      if (impl->key_logger != nullptr || impl->enable_kernel_tls_tx) {
         // Need to set factory at g_ssl_ctx_ex_factory_index
         SSL_CTX_set_ex_data(impl->ssl_contexts[i], g_ssl_ctx_ex_factory_index,
                             impl);
@@ -2350,6 +3003,14 @@ tsi_result tsi_create_ssl_server_handshaker_factory_with_options(
             impl->ssl_contexts[i],
             ssl_keylogging_callback<tsi_ssl_server_handshaker_factory>);
       }
+#if !defined(OPENSSL_IS_BORINGSSL)
+      // Tickets sent after the handshake would be written with the
+      // application traffic keys, and OpenSSL has no API to tell how many
+      // records that took, which kernel TLS needs to know.
+      if (impl->enable_kernel_tls_tx) {
+        SSL_CTX_set_num_tickets(impl->ssl_contexts[i], 0);
+      }
+#endif
 #endif
     } while (false);
 
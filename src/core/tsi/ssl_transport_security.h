@@ -25,8 +25,10 @@
 
 #include "absl/strings/string_view.h"
 
+#include <grpc/grpc_security.h>
 #include <grpc/grpc_security_constants.h>
 
+#include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/tsi/ssl/key_logging/ssl_key_logging.h"
 #include "src/core/tsi/transport_security_interface.h"
 
@@ -89,6 +91,43 @@ static constexpr bool tsi_tls_session_key_logging_supported() {
 #endif
 }
 
+/* --- tsi_ssl_private_key_signer object ---
+
+   Signs handshakes with a private key held by the application, e.g. in a
+   hardware security module, rather than by the SSL library. Signing may
+   complete asynchronously, in which case tsi_handshaker_next returns
+   TSI_ASYNC and calls its callback once the signature is available.  */
+static constexpr bool tsi_ssl_private_key_signer_supported() {
+#if defined(OPENSSL_IS_BORINGSSL)
+  return true;
+#else
+  return false;
+#endif
+}
+
+namespace tsi {
+
+class SslPrivateKeySigner : public grpc_core::RefCounted<SslPrivateKeySigner> {
+ public:
+  explicit SslPrivateKeySigner(const grpc_tls_private_key_signer& signer)
+      : signer_(signer) {}
+  ~SslPrivateKeySigner() override {
+    if (signer_.destroy != nullptr) signer_.destroy(signer_.user_data);
+  }
+
+  void Sign(uint16_t signature_algorithm, const unsigned char* in,
+            size_t in_len, grpc_tls_private_key_sign_done_cb done_cb,
+            void* done_arg) const {
+    signer_.sign(signer_.user_data, signature_algorithm, in, in_len, done_cb,
+                 done_arg);
+  }
+
+ private:
+  grpc_tls_private_key_signer signer_;
+};
+
+}  // namespace tsi
+
 /* --- tsi_ssl_client_handshaker_factory object ---
 
    This object creates a client tsi_handshaker objects implemented in terms of
@@ -179,6 +218,15 @@ struct tsi_ssl_client_handshaker_options {
      > 1.1 is supported for CRL checking*/
   const char* crl_directory;
 
+  /* Keep what is needed for handshaker results to support
+     tsi_handshaker_result_enable_kernel_tx_protection(). Only TLS 1.3 with
+     OpenSSL >= 1.1.1 or BoringSSL on Linux is supported. */
+  bool enable_kernel_tls_tx;
+  /* If not null, signs with this instead of the private key of
+     pem_key_cert_pair, which may then be null. Only supported with
+     BoringSSL. */
+  tsi::SslPrivateKeySigner* private_key_signer;
+
   tsi_ssl_client_handshaker_options()
       : pem_key_cert_pair(nullptr),
         pem_root_certs(nullptr),
@@ -191,7 +239,9 @@ struct tsi_ssl_client_handshaker_options {
         skip_server_certificate_verification(false),
         min_tls_version(tsi_tls_version::TSI_TLS1_2),
         max_tls_version(tsi_tls_version::TSI_TLS1_3),
-        crl_directory(nullptr) {}
+        crl_directory(nullptr),
+        enable_kernel_tls_tx(false),
+        private_key_signer(nullptr) {}
 };
 
 /* Creates a client handshaker factory.
@@ -322,6 +372,14 @@ struct tsi_ssl_server_handshaker_options {
    * crl checking. Only OpenSSL version > 1.1 is supported for CRL checking */
   const char* crl_directory;
 
+  /* Same as in tsi_ssl_client_handshaker_options. Except with BoringSSL, this
+     disables TLS 1.3 session tickets. */
+  bool enable_kernel_tls_tx;
+  /* If not null, signs with this instead of the private keys of
+     pem_key_cert_pairs, which may then be null. Only supported with
+     BoringSSL. */
+  tsi::SslPrivateKeySigner* private_key_signer;
+
   tsi_ssl_server_handshaker_options()
       : pem_key_cert_pairs(nullptr),
         num_key_cert_pairs(0),
@@ -335,7 +393,9 @@ struct tsi_ssl_server_handshaker_options {
         min_tls_version(tsi_tls_version::TSI_TLS1_2),
         max_tls_version(tsi_tls_version::TSI_TLS1_3),
         key_logger(nullptr),
-        crl_directory(nullptr) {}
+        crl_directory(nullptr),
+        enable_kernel_tls_tx(false),
+        private_key_signer(nullptr) {}
 };
 
 /* Creates a server handshaker factory.
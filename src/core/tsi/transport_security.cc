@@ -285,6 +285,15 @@ tsi_result tsi_handshaker_result_get_unused_bytes(
   return self->vtable->get_unused_bytes(self, bytes, bytes_size);
 }
 
+tsi_result tsi_handshaker_result_enable_kernel_tx_protection(
+    tsi_handshaker_result* self, int fd) {
+  if (self == nullptr || self->vtable == nullptr) return TSI_INVALID_ARGUMENT;
+  if (self->vtable->enable_kernel_tx_protection == nullptr) {
+    return TSI_UNIMPLEMENTED;
+  }
+  return self->vtable->enable_kernel_tx_protection(self, fd);
+}
+
 void tsi_handshaker_result_destroy(tsi_handshaker_result* self) {
   if (self == nullptr) return;
   self->vtable->destroy(self);
@@ -277,6 +277,17 @@ tsi_result tsi_handshaker_result_get_unused_bytes(
     const tsi_handshaker_result* self, const unsigned char** bytes,
     size_t* bytes_size);
 
+/* This method moves the protection of the data written to the connection to
+   the kernel, e.g. kernel TLS on Linux. fd is the socket the handshake was
+   done on, to which the handshake bytes have all been written. On success,
+   the kernel protects everything subsequently written to fd, and frame
+   protectors created from this result must only be used to unprotect.
+   Returns TSI_UNIMPLEMENTED, leaving the result unchanged, if this is not
+   supported by the implementation, the negotiated parameters or the
+   platform.  */
+tsi_result tsi_handshaker_result_enable_kernel_tx_protection(
+    tsi_handshaker_result* self, int fd);
+
 /* This method releases the tsi_handshaker_handshaker object. After this method
    is called, no other method can be called on the object.  */
 void tsi_handshaker_result_destroy(tsi_handshaker_result* self);
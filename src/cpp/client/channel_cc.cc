@@ -40,6 +40,7 @@
 
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/iomgr/iomgr.h"
+#include "src/core/lib/surface/channel.h"
 #include "src/core/lib/surface/completion_queue.h"
 
 namespace grpc {
@@ -261,6 +262,11 @@ class ShutdownCallback : public grpc_completion_queue_functor {
       callback_cq = new grpc::CompletionQueue(grpc_completion_queue_attributes{
           GRPC_CQ_CURRENT_VERSION, GRPC_CQ_CALLBACK, GRPC_CQ_DEFAULT_POLLING,
           shutdown_callback});
+      int inline_reactions =
+          grpc_core::Channel::FromC(c_channel_)->inline_callback_reactions();
+      if (inline_reactions > 0) {
+        grpc_cq_set_inline_callbacks(callback_cq->cq(), inline_reactions);
+      }
 
       // Transfer ownership of the new cq to its own shutdown callback
       shutdown_callback->TakeCQ(callback_cq);
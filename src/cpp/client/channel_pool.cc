@@ -0,0 +1,267 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/impl/codegen/call.h>
+#include <grpcpp/impl/codegen/channel_interface.h>
+#include <grpcpp/impl/codegen/client_interceptor.h>
+#include <grpcpp/impl/codegen/rpc_method.h>
+#include <grpcpp/impl/codegen/sync.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/support/channel_arguments.h>
+
+namespace grpc {
+namespace experimental {
+
+namespace {
+
+// Counts the calls in flight on one channel of the pool: one interceptor is
+// created when a call starts and destroyed with its ClientContext.
+class CallCountingInterceptor : public Interceptor {
+ public:
+  explicit CallCountingInterceptor(std::shared_ptr<std::atomic<int>> calls)
+      : calls_(std::move(calls)) {
+    calls_->fetch_add(1, std::memory_order_relaxed);
+  }
+  ~CallCountingInterceptor() override {
+    calls_->fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  void Intercept(InterceptorBatchMethods* methods) override {
+    methods->Proceed();
+  }
+
+ private:
+  const std::shared_ptr<std::atomic<int>> calls_;
+};
+
+class CallCountingInterceptorFactory
+    : public ClientInterceptorFactoryInterface {
+ public:
+  explicit CallCountingInterceptorFactory(
+      std::shared_ptr<std::atomic<int>> calls)
+      : calls_(std::move(calls)) {}
+
+  Interceptor* CreateClientInterceptor(ClientRpcInfo* /*info*/) override {
+    return new CallCountingInterceptor(calls_);
+  }
+
+ private:
+  const std::shared_ptr<std::atomic<int>> calls_;
+};
+
+// Lets every channel of the pool use the interceptor factories passed to
+// CreateChannelPool.
+class SharedInterceptorFactory : public ClientInterceptorFactoryInterface {
+ public:
+  explicit SharedInterceptorFactory(
+      std::shared_ptr<ClientInterceptorFactoryInterface> factory)
+      : factory_(std::move(factory)) {}
+
+  Interceptor* CreateClientInterceptor(ClientRpcInfo* info) override {
+    return factory_->CreateClientInterceptor(info);
+  }
+
+ private:
+  const std::shared_ptr<ClientInterceptorFactoryInterface> factory_;
+};
+
+}  // namespace
+
+class ChannelPool final : public grpc::ChannelInterface {
+ public:
+  ChannelPool(
+      const std::string& target,
+      const std::shared_ptr<grpc::ChannelCredentials>& creds,
+      const grpc::ChannelArguments& args, const ChannelPoolOptions& options,
+      std::vector<std::unique_ptr<ClientInterceptorFactoryInterface>>
+          interceptor_creators)
+      : target_(target),
+        creds_(creds),
+        args_(args),
+        max_channels_(std::max(options.max_channels, 1)),
+        max_calls_per_channel_(std::max(options.max_calls_per_channel, 1)) {
+    // Channels sharing the global subchannel pool would share connections.
+    args_.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    for (auto& creator : interceptor_creators) {
+      interceptor_creators_.emplace_back(std::move(creator));
+    }
+    grpc::internal::MutexLock lock(&mu_);
+    AddChannelLocked();
+  }
+
+  grpc_connectivity_state GetState(bool try_to_connect) override {
+    grpc::internal::MutexLock lock(&mu_);
+    grpc_connectivity_state state = GRPC_CHANNEL_SHUTDOWN;
+    for (auto& entry : channels_) {
+      grpc_connectivity_state channel_state =
+          entry.channel->GetState(try_to_connect);
+      if (channel_state == GRPC_CHANNEL_READY) return channel_state;
+      if (&entry == &channels_.front()) state = channel_state;
+    }
+    return state;
+  }
+
+ private:
+  struct PooledChannel {
+    std::shared_ptr<grpc::ChannelInterface> channel;
+    std::shared_ptr<std::atomic<int>> calls;
+  };
+
+  // What RegisterMethod returns: the registration of one method on each
+  // channel of the pool, indexed like channels_.
+  struct RegisteredMethod {
+    const char* name;
+    std::vector<void*> channel_tags;
+  };
+
+  grpc::internal::Call CreateCall(const grpc::internal::RpcMethod& method,
+                                  grpc::ClientContext* context,
+                                  grpc::CompletionQueue* cq) override {
+    return CreateCallInternal(method, context, cq, 0);
+  }
+
+  grpc::internal::Call CreateCallInternal(
+      const grpc::internal::RpcMethod& method, grpc::ClientContext* context,
+      grpc::CompletionQueue* cq, size_t interceptor_pos) override {
+    grpc::ChannelInterface* channel;
+    void* channel_tag = nullptr;
+    {
+      grpc::internal::MutexLock lock(&mu_);
+      size_t index = PickChannelLocked();
+      channel = channels_[index].channel.get();
+      if (method.channel_tag() != nullptr) {
+        channel_tag = static_cast<RegisteredMethod*>(method.channel_tag())
+                          ->channel_tags[index];
+      }
+    }
+    // Channels are never removed from the pool, and the call keeps its
+    // channel alive from here on.
+    return channel->CreateCallInternal(
+        grpc::internal::RpcMethod(method, channel_tag), context, cq,
+        interceptor_pos);
+  }
+
+  void PerformOpsOnCall(grpc::internal::CallOpSetInterface* ops,
+                        grpc::internal::Call* call) override {
+    // Calls are created by, and hooked to, one of the pooled channels.
+    call->PerformOps(ops);
+  }
+
+  void* RegisterMethod(const char* method) override {
+    grpc::internal::MutexLock lock(&mu_);
+    methods_.push_back(RegisteredMethod{method, {}});
+    RegisteredMethod* registered = &methods_.back();
+    for (auto& entry : channels_) {
+      registered->channel_tags.push_back(entry.channel->RegisterMethod(method));
+    }
+    return registered;
+  }
+
+  // Connectivity is followed on the first channel, which the pool always
+  // has.
+  void NotifyOnStateChangeImpl(grpc_connectivity_state last_observed,
+                               gpr_timespec deadline, grpc::CompletionQueue* cq,
+                               void* tag) override {
+    FirstChannel()->NotifyOnStateChangeImpl(last_observed, deadline, cq, tag);
+  }
+
+  bool WaitForStateChangeImpl(grpc_connectivity_state last_observed,
+                              gpr_timespec deadline) override {
+    return FirstChannel()->WaitForStateChangeImpl(last_observed, deadline);
+  }
+
+  grpc::CompletionQueue* CallbackCQ() override {
+    return FirstChannel()->CallbackCQ();
+  }
+
+  grpc::ChannelInterface* FirstChannel() {
+    grpc::internal::MutexLock lock(&mu_);
+    return channels_.front().channel.get();
+  }
+
+  // Returns the index of the channel with the fewest calls in flight, after
+  // opening a new one if all of them are above the threshold.
+  size_t PickChannelLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    size_t best = 0;
+    int best_calls = channels_[0].calls->load(std::memory_order_relaxed);
+    for (size_t i = 1; i < channels_.size() && best_calls > 0; ++i) {
+      int calls = channels_[i].calls->load(std::memory_order_relaxed);
+      if (calls < best_calls) {
+        best = i;
+        best_calls = calls;
+      }
+    }
+    if (best_calls >= max_calls_per_channel_ &&
+        channels_.size() < static_cast<size_t>(max_channels_)) {
+      best = AddChannelLocked();
+    }
+    return best;
+  }
+
+  size_t AddChannelLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    auto calls = std::make_shared<std::atomic<int>>(0);
+    std::vector<std::unique_ptr<ClientInterceptorFactoryInterface>> creators;
+    for (const auto& creator : interceptor_creators_) {
+      creators.emplace_back(new SharedInterceptorFactory(creator));
+    }
+    creators.emplace_back(new CallCountingInterceptorFactory(calls));
+    std::shared_ptr<grpc::ChannelInterface> channel =
+        CreateCustomChannelWithInterceptors(target_, creds_, args_,
+                                            std::move(creators));
+    for (auto& method : methods_) {
+      method.channel_tags.push_back(channel->RegisterMethod(method.name));
+    }
+    channels_.push_back(PooledChannel{std::move(channel), std::move(calls)});
+    return channels_.size() - 1;
+  }
+
+  const std::string target_;
+  const std::shared_ptr<grpc::ChannelCredentials> creds_;
+  grpc::ChannelArguments args_;
+  const int max_channels_;
+  const int max_calls_per_channel_;
+  std::vector<std::shared_ptr<ClientInterceptorFactoryInterface>>
+      interceptor_creators_;
+  grpc::internal::Mutex mu_;
+  std::vector<PooledChannel> channels_ ABSL_GUARDED_BY(mu_);
+  // Stable addresses, handed out by RegisterMethod.
+  std::list<RegisteredMethod> methods_ ABSL_GUARDED_BY(mu_);
+};
+
+std::shared_ptr<grpc::ChannelInterface> CreateChannelPool(
+    const std::string& target,
+    const std::shared_ptr<grpc::ChannelCredentials>& creds,
+    const grpc::ChannelArguments& args, const ChannelPoolOptions& options,
+    std::vector<std::unique_ptr<ClientInterceptorFactoryInterface>>
+        interceptor_creators) {
+  return std::make_shared<ChannelPool>(target, creds, args, options,
+                                       std::move(interceptor_creators));
+}
+
+}  // namespace experimental
+}  // namespace grpc
@@ -0,0 +1,196 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpcpp/channel_set.h>
+
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/time/time.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/filters/client_channel/client_channel.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time_util.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/surface/channel.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc {
+namespace experimental {
+namespace {
+
+// The state changes of the channels of a set that were not read yet.
+// Shared with the watchers, which may be notified after the set is gone.
+class StateQueue : public grpc_core::RefCounted<StateQueue> {
+ public:
+  // Makes room for count more channels.
+  void AddChannels(size_t count) {
+    grpc_core::MutexLock lock(&mu_);
+    slots_.resize(slots_.size() + count);
+  }
+
+  void Push(size_t index, grpc_connectivity_state state) {
+    grpc_core::MutexLock lock(&mu_);
+    if (shutdown_) return;
+    Slot& slot = slots_[index];
+    slot.state = state;
+    if (slot.pending) return;
+    slot.pending = true;
+    // Readers drain the whole queue, so only the first push wakes one up.
+    if (pending_.empty()) cv_.Signal();
+    pending_.push_back(index);
+  }
+
+  bool Pop(std::vector<ChannelSet::StateChange>* changes,
+           absl::Time deadline) {
+    grpc_core::MutexLock lock(&mu_);
+    while (pending_.empty() && !shutdown_) {
+      if (cv_.WaitWithDeadline(&mu_, deadline)) break;
+    }
+    if (shutdown_ || pending_.empty()) return false;
+    for (size_t index : pending_) {
+      Slot& slot = slots_[index];
+      slot.pending = false;
+      changes->push_back({index, slot.state});
+    }
+    pending_.clear();
+    return true;
+  }
+
+  void Shutdown() {
+    grpc_core::MutexLock lock(&mu_);
+    shutdown_ = true;
+    cv_.SignalAll();
+  }
+
+ private:
+  struct Slot {
+    grpc_connectivity_state state = GRPC_CHANNEL_IDLE;
+    // Whether the index is in pending_.
+    bool pending = false;
+  };
+
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  std::vector<Slot> slots_ ABSL_GUARDED_BY(mu_);
+  // Indexes of the channels with unread changes, in order of their first
+  // change.
+  std::vector<size_t> pending_ ABSL_GUARDED_BY(mu_);
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+};
+
+// Watches one channel for as long as the set does, so it is never re-armed.
+class Watcher : public grpc_core::AsyncConnectivityStateWatcherInterface {
+ public:
+  Watcher(grpc_core::RefCountedPtr<StateQueue> queue, size_t index)
+      : queue_(std::move(queue)), index_(index) {}
+
+ private:
+  void OnConnectivityStateChange(grpc_connectivity_state new_state,
+                                 const absl::Status& /*status*/) override {
+    queue_->Push(index_, new_state);
+  }
+
+  grpc_core::RefCountedPtr<StateQueue> queue_;
+  const size_t index_;
+};
+
+}  // namespace
+
+class ChannelSet::Impl {
+ public:
+  struct Watch {
+    std::shared_ptr<Channel> channel;
+    // Null if the channel is not a client channel, which is not watched.
+    grpc_core::ClientChannel* client_channel;
+    // Owned by the client channel.
+    grpc_core::AsyncConnectivityStateWatcherInterface* watcher;
+  };
+
+  const grpc_core::RefCountedPtr<StateQueue> queue =
+      grpc_core::MakeRefCounted<StateQueue>();
+
+  grpc_core::Mutex mu;
+  std::vector<Watch> watches ABSL_GUARDED_BY(mu);
+  bool shutdown ABSL_GUARDED_BY(mu) = false;
+};
+
+ChannelSet::ChannelSet() : impl_(new Impl()) {}
+
+ChannelSet::~ChannelSet() { Shutdown(); }
+
+size_t ChannelSet::WatchAll(
+    const std::vector<std::shared_ptr<Channel>>& channels) {
+  grpc_core::ApplicationCallbackExecCtx callback_exec_ctx;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::MutexLock lock(&impl_->mu);
+  const size_t first = impl_->watches.size();
+  if (impl_->shutdown) return first;
+  impl_->queue->AddChannels(channels.size());
+  for (const std::shared_ptr<Channel>& channel : channels) {
+    const size_t index = impl_->watches.size();
+    Impl::Watch watch{channel,
+                      grpc_core::ClientChannel::GetFromChannel(
+                          grpc_core::Channel::FromC(channel->c_channel_)),
+                      nullptr};
+    if (watch.client_channel == nullptr) {
+      // A lame channel stays in TRANSIENT_FAILURE, so report its state once
+      // as grpc_channel_check_connectivity_state() does.
+      impl_->queue->Push(index, grpc_channel_check_connectivity_state(
+                                    channel->c_channel_, 0));
+    } else {
+      grpc_connectivity_state state =
+          watch.client_channel->CheckConnectivityState(
+              /*try_to_connect=*/false);
+      impl_->queue->Push(index, state);
+      auto watcher = grpc_core::MakeOrphanable<Watcher>(impl_->queue, index);
+      watch.watcher = watcher.get();
+      watch.client_channel->AddConnectivityWatcher(state, std::move(watcher));
+    }
+    impl_->watches.push_back(std::move(watch));
+  }
+  return first;
+}
+
+bool ChannelSet::NextInternal(std::vector<StateChange>* changes,
+                              gpr_timespec deadline) {
+  return impl_->queue->Pop(changes, grpc_core::ToAbslTime(deadline));
+}
+
+void ChannelSet::Shutdown() {
+  grpc_core::ApplicationCallbackExecCtx callback_exec_ctx;
+  grpc_core::ExecCtx exec_ctx;
+  impl_->queue->Shutdown();
+  grpc_core::MutexLock lock(&impl_->mu);
+  if (impl_->shutdown) return;
+  impl_->shutdown = true;
+  for (const Impl::Watch& watch : impl_->watches) {
+    if (watch.watcher != nullptr) {
+      watch.client_channel->RemoveConnectivityWatcher(watch.watcher);
+    }
+  }
+}
+
+}  // namespace experimental
+}  // namespace grpc
@@ -29,6 +29,9 @@
 #include <grpcpp/server_context.h>
 #include <grpcpp/support/time.h>
 
+#include "src/core/lib/surface/call.h"
+#include "src/core/lib/transport/metadata_batch.h"
+
 namespace grpc {
 
 class Channel;
@@ -57,7 +60,8 @@ ClientContext::ClientContext()
       census_context_(nullptr),
       propagate_from_call_(nullptr),
       compression_algorithm_(GRPC_COMPRESS_NONE),
-      initial_metadata_corked_(false) {
+      initial_metadata_corked_(false),
+      max_buffered_receive_bytes_(0) {
   g_gli_initializer.summon();
   g_client_callbacks->DefaultConstructor(this);
 }
@@ -69,6 +73,36 @@ ClientContext::~ClientContext() {
   g_client_callbacks->Destructor(this);
 }
 
+void ClientContext::Reset() {
+  if (call_ != nullptr) {
+    grpc_call_unref(call_);
+    call_ = nullptr;
+  }
+  g_client_callbacks->Destructor(this);
+  initial_metadata_received_ = false;
+  wait_for_ready_ = false;
+  wait_for_ready_explicitly_set_ = false;
+  channel_.reset();
+  call_canceled_ = false;
+  deadline_ = gpr_inf_future(GPR_CLOCK_REALTIME);
+  authority_.clear();
+  creds_.reset();
+  auth_context_.reset();
+  census_context_ = nullptr;
+  send_initial_metadata_.clear();
+  send_pre_encoded_metadata_.clear();
+  recv_initial_metadata_.Reset();
+  trailing_metadata_.Reset();
+  propagate_from_call_ = nullptr;
+  propagation_options_ = PropagationOptions();
+  compression_algorithm_ = GRPC_COMPRESS_NONE;
+  initial_metadata_corked_ = false;
+  max_buffered_receive_bytes_ = 0;
+  debug_error_string_.clear();
+  rpc_info_ = experimental::ClientRpcInfo();
+  g_client_callbacks->DefaultConstructor(this);
+}
+
 void ClientContext::set_credentials(
     const std::shared_ptr<CallCredentials>& creds) {
   creds_ = creds;
@@ -109,24 +143,77 @@ void ClientContext::AddMetadata(const std::string& meta_key,
   send_initial_metadata_.insert(std::make_pair(meta_key, meta_value));
 }
 
+void ClientContext::AddMetadata(const PreEncodedMetadata& metadata) {
+  send_pre_encoded_metadata_.push_back(metadata);
+}
+
 void ClientContext::set_call(grpc_call* call,
                              const std::shared_ptr<Channel>& channel) {
   internal::MutexLock lock(&mu_);
   GPR_ASSERT(call_ == nullptr);
   call_ = call;
   channel_ = channel;
+  if (max_buffered_receive_bytes_ != 0) {
+    grpc_call_set_max_buffered_receive_bytes(call_,
+                                             max_buffered_receive_bytes_);
+  }
   if (creds_ && !creds_->ApplyToCall(call_)) {
     // TODO(yashykt): should interceptors also see this status?
     SendCancelToInterceptors();
     grpc_call_cancel_with_status(call, GRPC_STATUS_CANCELLED,
                                  "Failed to set credentials to rpc.", nullptr);
   }
+  for (const PreEncodedMetadata& metadata : send_pre_encoded_metadata_) {
+    if (!grpc_call_add_pre_encoded_initial_metadata(
+            call_, const_cast<grpc_core::PreEncodedMetadata*>(
+                       grpc_core::PreEncodedMetadata::FromValue(
+                           metadata.value_)))) {
+      SendCancelToInterceptors();
+      grpc_call_cancel_with_status(call, GRPC_STATUS_INTERNAL,
+                                   "Invalid pre-encoded metadata.", nullptr);
+      break;
+    }
+  }
   if (call_canceled_) {
     SendCancelToInterceptors();
     grpc_call_cancel(call_, nullptr);
   }
 }
 
+PreEncodedMetadata::PreEncodedMetadata(const std::string& key,
+                                       const std::string& value) {
+  grpc_core::PreEncodedMetadata* md =
+      grpc_core::PreEncodedMetadata::Create(key, value);
+  value_ = md->RefValueSlice();
+  // Drop the creation ref: value_ now holds the element alive.
+  md->Unref();
+}
+
+PreEncodedMetadata::PreEncodedMetadata(const PreEncodedMetadata& other)
+    : value_(grpc_slice_ref(other.value_)) {}
+
+PreEncodedMetadata& PreEncodedMetadata::operator=(
+    const PreEncodedMetadata& other) {
+  grpc_slice value = grpc_slice_ref(other.value_);
+  grpc_slice_unref(value_);
+  value_ = value;
+  return *this;
+}
+
+PreEncodedMetadata::~PreEncodedMetadata() { grpc_slice_unref(value_); }
+
+grpc::string_ref PreEncodedMetadata::key() const {
+  absl::string_view key =
+      grpc_core::PreEncodedMetadata::FromValue(value_)->key();
+  return grpc::string_ref(key.data(), key.size());
+}
+
+grpc::string_ref PreEncodedMetadata::value() const {
+  return grpc::string_ref(
+      reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(value_)),
+      GRPC_SLICE_LENGTH(value_));
+}
+
 void ClientContext::set_compression_algorithm(
     grpc_compression_algorithm algorithm) {
   compression_algorithm_ = algorithm;
@@ -174,4 +261,36 @@ void ClientContext::SetGlobalCallbacks(GlobalCallbacks* client_callbacks) {
   g_client_callbacks = client_callbacks;
 }
 
+namespace experimental {
+
+ClientContextPool::~ClientContextPool() {
+  for (ClientContext* context : contexts_) delete context;
+}
+
+ClientContextPool::Ptr ClientContextPool::Get() {
+  ClientContext* context = nullptr;
+  {
+    internal::MutexLock lock(&mu_);
+    if (!contexts_.empty()) {
+      context = contexts_.back();
+      contexts_.pop_back();
+    }
+  }
+  if (context == nullptr) context = new ClientContext();
+  return Ptr(context, Returner(this));
+}
+
+void ClientContextPool::Return(ClientContext* context) {
+  context->Reset();
+  {
+    internal::MutexLock lock(&mu_);
+    if (contexts_.size() < max_size_) {
+      contexts_.push_back(context);
+      return;
+    }
+  }
+  delete context;
+}
+
+}  // namespace experimental
 }  // namespace grpc
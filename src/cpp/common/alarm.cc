@@ -18,6 +18,7 @@
 #include <grpc/support/port_platform.h>
 
 #include <memory>
+#include <vector>
 
 #include <grpc/support/log.h>
 #include <grpcpp/alarm.h>
@@ -26,6 +27,7 @@
 #include <grpcpp/support/time.h>
 
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/timer.h"
@@ -36,10 +38,22 @@ namespace grpc {
 namespace internal {
 class AlarmImpl : public grpc::internal::CompletionQueueTag {
  public:
-  AlarmImpl() : cq_(nullptr), tag_(nullptr) {
-    gpr_ref_init(&refs_, 1);
-    grpc_timer_init_unset(&timer_);
+  // Servers that use alarms for per-request timeouts create and destroy
+  // them at a high rate, so released alarms are kept for reuse.
+  static AlarmImpl* New() {
+    AlarmPool* pool = AlarmPool::Get();
+    {
+      grpc_core::MutexLock lock(&pool->mu);
+      if (!pool->alarms.empty()) {
+        AlarmImpl* alarm = pool->alarms.back();
+        pool->alarms.pop_back();
+        alarm->Reset();
+        return alarm;
+      }
+    }
+    return new AlarmImpl();
   }
+
   ~AlarmImpl() override {}
   bool FinalizeResult(void** tag, bool* /*status*/) override {
     *tag = tag_;
@@ -47,6 +61,7 @@ class AlarmImpl : public grpc::internal::CompletionQueueTag {
     return true;
   }
   void Set(grpc::CompletionQueue* cq, gpr_timespec deadline, void* tag) {
+    set_ = true;
     grpc_core::ApplicationCallbackExecCtx callback_exec_ctx;
     grpc_core::ExecCtx exec_ctx;
     GRPC_CQ_INTERNAL_REF(cq->cq(), "alarm");
@@ -78,6 +93,7 @@ class AlarmImpl : public grpc::internal::CompletionQueueTag {
     grpc_core::ApplicationCallbackExecCtx callback_exec_ctx;
     grpc_core::ExecCtx exec_ctx;
     // Don't use any CQ at all. Instead just use the timer to fire the function
+    set_ = true;
     callback_ = std::move(f);
     Ref();
     GRPC_CLOSURE_INIT(
@@ -104,14 +120,47 @@ class AlarmImpl : public grpc::internal::CompletionQueueTag {
     grpc_timer_cancel(&timer_);
   }
   void Destroy() {
-    Cancel();
+    // An alarm that was never set has no timer to cancel.
+    if (set_) Cancel();
     Unref();
   }
 
  private:
+  struct AlarmPool {
+    static constexpr size_t kMaxAlarms = 1024;
+
+    static AlarmPool* Get() {
+      static AlarmPool* pool = new AlarmPool();
+      return pool;
+    }
+
+    grpc_core::Mutex mu;
+    std::vector<AlarmImpl*> alarms ABSL_GUARDED_BY(mu);
+  };
+
+  AlarmImpl() : cq_(nullptr), tag_(nullptr) { Reset(); }
+
+  void Reset() {
+    gpr_ref_init(&refs_, 1);
+    grpc_timer_init_unset(&timer_);
+    cq_ = nullptr;
+    tag_ = nullptr;
+    set_ = false;
+  }
+
   void Ref() { gpr_ref(&refs_); }
   void Unref() {
     if (gpr_unref(&refs_)) {
+      // Release what the callback holds now rather than on reuse.
+      callback_ = nullptr;
+      AlarmPool* pool = AlarmPool::Get();
+      {
+        grpc_core::MutexLock lock(&pool->mu);
+        if (pool->alarms.size() < AlarmPool::kMaxAlarms) {
+          pool->alarms.push_back(this);
+          return;
+        }
+      }
       delete this;
     }
   }
@@ -124,12 +173,14 @@ class AlarmImpl : public grpc::internal::CompletionQueueTag {
   grpc_completion_queue* cq_;
   void* tag_;
   std::function<void(bool)> callback_;
+  // Whether Set() was called since the alarm was created or reused.
+  bool set_;
 };
 }  // namespace internal
 
 static grpc::internal::GrpcLibraryInitializer g_gli_initializer;
 
-Alarm::Alarm() : alarm_(new internal::AlarmImpl()) {
+Alarm::Alarm() : alarm_(internal::AlarmImpl::New()) {
   g_gli_initializer.summon();
 }
 
@@ -24,6 +24,7 @@
 #include <grpcpp/support/channel_arguments.h>
 
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/compression/message_compress.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/socket_mutator.h"
 
@@ -84,6 +85,16 @@ void ChannelArguments::SetCompressionAlgorithm(
   SetInt(GRPC_COMPRESSION_CHANNEL_DEFAULT_ALGORITHM, algorithm);
 }
 
+void ChannelArguments::SetZstdCompressionDictionaries(
+    const std::vector<std::string>& dictionaries) {
+  auto zstd_dictionaries =
+      grpc_core::ZstdCompressionDictionaries::Create(dictionaries);
+  SetPointerWithVtable(
+      std::string(grpc_core::ZstdCompressionDictionaries::ChannelArgName()),
+      zstd_dictionaries.get(),
+      grpc_core::ZstdCompressionDictionaries::ChannelArgVtable());
+}
+
 void ChannelArguments::SetGrpclbFallbackTimeout(int fallback_timeout) {
   SetInt(GRPC_ARG_GRPCLB_FALLBACK_TIMEOUT_MS, fallback_timeout);
 }
@@ -15,6 +15,7 @@
  *
  */
 
+#include <algorithm>
 #include <memory>
 
 #include <grpc/grpc.h>
@@ -28,6 +29,7 @@
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
 
 namespace grpc {
 namespace {
@@ -54,6 +56,17 @@ struct CallbackAlternativeCQ {
       cq = new CompletionQueue;
       int num_nexting_threads =
           grpc_core::Clamp(gpr_cpu_num_cores() / 2, 2u, 16u);
+      // The first thread is started regardless of the thread quota; the
+      // others only when it allows.
+      grpc_core::ThreadQuotaPtr thread_quota =
+          grpc_core::ResourceQuota::Default()->thread_quota();
+      thread_quota->ForceReserve(1);
+      for (int i = 1; i < num_nexting_threads; i++) {
+        if (!thread_quota->Reserve(1)) {
+          num_nexting_threads = i;
+          break;
+        }
+      }
       nexting_threads = new std::vector<grpc_core::Thread>;
       for (int i = 0; i < num_nexting_threads; i++) {
         nexting_threads->emplace_back(
@@ -110,6 +123,8 @@ struct CallbackAlternativeCQ {
       for (auto& th : *nexting_threads) {
         th.Join();
       }
+      grpc_core::ResourceQuota::Default()->thread_quota()->Release(
+          nexting_threads->size());
       delete nexting_threads;
       delete cq;
     }
@@ -178,6 +193,36 @@ CompletionQueue::NextStatus CompletionQueue::AsyncNextInternal(
   }
 }
 
+size_t CompletionQueue::NextBatchInternal(void** tags, bool* oks,
+                                          size_t max_events,
+                                          gpr_timespec deadline) {
+  GPR_ASSERT(max_events > 0);
+  // Bound the number of events taken from the core queue per call so that
+  // they fit on the stack; callers simply get a partial batch.
+  constexpr size_t kMaxEventsPerCall = 64;
+  grpc_event events[kMaxEventsPerCall];
+  size_t num_core_events = std::min(max_events, kMaxEventsPerCall);
+  for (;;) {
+    size_t n = grpc_completion_queue_next_batch(cq_, events, num_core_events,
+                                                deadline, nullptr);
+    size_t num_out = 0;
+    for (size_t i = 0; i < n; i++) {
+      // Timeout and shutdown are only ever reported on their own.
+      if (events[i].type != GRPC_OP_COMPLETE) return 0;
+      auto core_cq_tag =
+          static_cast<grpc::internal::CompletionQueueTag*>(events[i].tag);
+      void* tag = core_cq_tag;
+      bool ok = events[i].success != 0;
+      if (core_cq_tag->FinalizeResult(&tag, &ok)) {
+        tags[num_out] = tag;
+        oks[num_out] = ok;
+        num_out++;
+      }
+    }
+    if (num_out > 0) return num_out;
+  }
+}
+
 CompletionQueue::CompletionQueueTLSCache::CompletionQueueTLSCache(
     CompletionQueue* cq)
     : cq_(cq), flushed_(false) {
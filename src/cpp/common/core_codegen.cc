@@ -32,6 +32,8 @@
 #include <grpcpp/support/config.h>
 
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/surface/call.h"
 
 struct grpc_byte_buffer;
 
@@ -239,6 +241,20 @@ gpr_timespec CoreCodegen::gpr_time_0(gpr_clock_type type) {
   return ::gpr_time_0(type);
 }
 
+bool CoreCodegen::grpc_call_object_passing(grpc_call* call) {
+  return ::grpc_call_object_passing(call);
+}
+
+grpc_slice CoreCodegen::grpc_slice_from_object(void* object, const void* type,
+                                               void (*destroy)(void*)) {
+  return ::grpc_slice_from_object(object, type, destroy);
+}
+
+void* CoreCodegen::grpc_slice_get_object(grpc_slice slice, const void** type,
+                                         bool* unique) {
+  return ::grpc_slice_get_object(slice, type, unique);
+}
+
 void CoreCodegen::assert_fail(const char* failed_assertion, const char* file,
                               int line) {
   gpr_log(file, line, GPR_LOG_SEVERITY_ERROR, "assertion failed: %s",
@@ -20,6 +20,9 @@
 #include <grpcpp/impl/grpc_library.h>
 #include <grpcpp/resource_quota.h>
 
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+
 namespace grpc {
 
 static grpc::internal::GrpcLibraryInitializer g_gli_initializer;
@@ -45,4 +48,22 @@ ResourceQuota& ResourceQuota::SetMaxThreads(int new_max_threads) {
   return *this;
 }
 
+ResourceQuota::MemoryUsage ResourceQuota::GetMemoryUsage() const {
+  grpc_core::MemoryUsage usage =
+      grpc_core::ResourceQuota::FromC(impl_)->memory_quota()->GetUsage();
+  auto get = [&usage](grpc_core::MemoryCategory category) {
+    return usage[static_cast<size_t>(category)];
+  };
+  MemoryUsage result;
+  result.call_arenas = get(grpc_core::MemoryCategory::kCallArena);
+  result.read_buffers = get(grpc_core::MemoryCategory::kReadBuffer);
+  result.hpack_tables = get(grpc_core::MemoryCategory::kHpackTable);
+  result.pending_writes = get(grpc_core::MemoryCategory::kPendingWrites);
+  result.transports = get(grpc_core::MemoryCategory::kTransport);
+  result.retry_buffers = get(grpc_core::MemoryCategory::kRetryBuffer);
+  result.response_caches = get(grpc_core::MemoryCategory::kResponseCache);
+  result.other = get(grpc_core::MemoryCategory::kOther);
+  return result;
+}
+
 }  // namespace grpc
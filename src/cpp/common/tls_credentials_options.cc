@@ -79,6 +79,11 @@ void TlsCredentialsOptions::set_certificate_verifier(
   }
 }
 
+void TlsCredentialsOptions::set_verification_cache_ttl(int ttl_ms) {
+  grpc_tls_credentials_options_set_verification_cache_ttl(
+      c_credentials_options_, ttl_ms);
+}
+
 void TlsCredentialsOptions::set_check_call_host(bool check_call_host) {
   grpc_tls_credentials_options* options = c_credentials_options();
   GPR_ASSERT(options != nullptr);
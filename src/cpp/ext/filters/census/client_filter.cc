@@ -207,6 +207,7 @@ OpenCensusCallTracer::OpenCensusCallTracer(const grpc_call_element_args* args)
       arena_(args->arena) {}
 
 OpenCensusCallTracer::~OpenCensusCallTracer() {
+  if (!sampled_) return;
   std::vector<std::pair<opencensus::tags::TagKey, std::string>> tags =
       context_.tags().tags();
   tags.emplace_back(ClientMethodTagKey(), std::string(method_));
@@ -220,12 +221,23 @@ OpenCensusCallTracer::~OpenCensusCallTracer() {
 void OpenCensusCallTracer::GenerateContext() {
   auto* parent_context = reinterpret_cast<CensusContext*>(
       call_context_[GRPC_CONTEXT_TRACING].value);
+  // Calls made within a sampled trace are always sampled, so that the trace
+  // stays complete.
+  if ((parent_context == nullptr ||
+       !parent_context->Context().trace_options().IsSampled()) &&
+      !OpenCensusShouldSample(method_)) {
+    sampled_ = false;
+    ::opencensus::stats::Record({{RpcClientUnsampledRpcs(), 1}});
+    return;
+  }
   GenerateClientContext(absl::StrCat("Sent.", method_), &context_,
                         (parent_context == nullptr) ? nullptr : parent_context);
 }
 
 OpenCensusCallTracer::OpenCensusCallAttemptTracer*
 OpenCensusCallTracer::StartNewAttempt(bool is_transparent_retry) {
+  // Unsampled calls record nothing per attempt.
+  if (!sampled_) return nullptr;
   // We allocate the first attempt on the arena and all subsequent attempts on
   // the heap, so that in the common case we don't require a heap allocation,
   // nor do we unnecessarily grow the arena.
@@ -20,11 +20,16 @@
 
 #include "src/cpp/ext/filters/census/grpc_plugin.h"
 
+#include <atomic>
+#include <map>
+#include <string>
+
 #include "opencensus/tags/tag_key.h"
 #include "opencensus/trace/span.h"
 
 #include <grpcpp/server_context.h>
 
+#include "src/core/lib/gpr/useful.h"
 #include "src/cpp/ext/filters/census/channel_filter.h"
 #include "src/cpp/ext/filters/census/client_filter.h"
 #include "src/cpp/ext/filters/census/measures.h"
@@ -51,17 +56,66 @@ void RegisterOpenCensusPlugin() {
   RpcClientRetriesPerCall();
   RpcClientTransparentRetriesPerCall();
   RpcClientRetryDelayPerCall();
+  RpcClientUnsampledRpcs();
 
   RpcServerSentBytesPerRpc();
   RpcServerReceivedBytesPerRpc();
   RpcServerServerLatency();
   RpcServerSentMessagesPerRpc();
   RpcServerReceivedMessagesPerRpc();
+  RpcServerUnsampledRpcs();
+}
+
+namespace {
+
+struct SamplingConfig {
+  double default_rate = 1;
+  std::map<std::string, double, std::less<>> method_rates;
+};
+
+SamplingConfig* GetSamplingConfig() {
+  static SamplingConfig* config = new SamplingConfig();
+  return config;
+}
+
+std::atomic<uint64_t> g_sampling_sequence{0};
+
+}  // namespace
+
+void SetOpenCensusSamplingRate(double rate) {
+  GetSamplingConfig()->default_rate = grpc_core::Clamp(rate, 0.0, 1.0);
+}
+
+void SetOpenCensusMethodSamplingRate(absl::string_view method, double rate) {
+  GetSamplingConfig()->method_rates[std::string(method)] =
+      grpc_core::Clamp(rate, 0.0, 1.0);
+}
+
+bool OpenCensusShouldSample(absl::string_view method) {
+  const SamplingConfig* config = GetSamplingConfig();
+  double rate = config->default_rate;
+  if (!config->method_rates.empty()) {
+    auto it = config->method_rates.find(method);
+    if (it != config->method_rates.end()) rate = it->second;
+  }
+  if (rate >= 1) return true;
+  if (rate <= 0) return false;
+  // SplitMix64 over a shared sequence: uniform enough for sampling, and
+  // cheaper than a random number generator.
+  uint64_t x = g_sampling_sequence.fetch_add(0x9e3779b97f4a7c15,
+                                             std::memory_order_relaxed);
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+  x ^= x >> 31;
+  return (x >> 11) < static_cast<uint64_t>(rate * (uint64_t{1} << 53));
 }
 
 ::opencensus::trace::Span GetSpanFromServerContext(
     grpc::ServerContext* context) {
-  if (context == nullptr) return opencensus::trace::Span::BlankSpan();
+  if (context == nullptr || context->census_context() == nullptr) {
+    // Unsampled calls have no census context.
+    return opencensus::trace::Span::BlankSpan();
+  }
 
   return reinterpret_cast<const grpc::CensusContext*>(context->census_context())
       ->Span();
@@ -126,6 +180,9 @@ ABSL_CONST_INIT const absl::string_view
 ABSL_CONST_INIT const absl::string_view kRpcClientRetryDelayPerCallMeasureName =
     "grpc.io/client/retry_delay_per_call";
 
+ABSL_CONST_INIT const absl::string_view kRpcClientUnsampledRpcsMeasureName =
+    "grpc.io/client/unsampled_rpcs";
+
 // Server
 ABSL_CONST_INIT const absl::string_view
     kRpcServerSentMessagesPerRpcMeasureName =
@@ -144,4 +201,7 @@ ABSL_CONST_INIT const absl::string_view
 
 ABSL_CONST_INIT const absl::string_view kRpcServerServerLatencyMeasureName =
     "grpc.io/server/server_latency";
+
+ABSL_CONST_INIT const absl::string_view kRpcServerUnsampledRpcsMeasureName =
+    "grpc.io/server/unsampled_rpcs";
 }  // namespace grpc
@@ -29,6 +29,11 @@
 
 namespace grpc {
 
+// Returns whether a call to \a method that is not part of an upstream trace
+// should be traced and recorded, as configured by SetOpenCensusSamplingRate()
+// and SetOpenCensusMethodSamplingRate().
+bool OpenCensusShouldSample(absl::string_view method);
+
 // The tag keys set when recording RPC stats.
 ::opencensus::tags::TagKey ClientMethodTagKey();
 ::opencensus::tags::TagKey ClientStatusTagKey();
@@ -46,12 +51,14 @@ extern const absl::string_view kRpcClientServerLatencyMeasureName;
 extern const absl::string_view kRpcClientRetriesPerCallMeasureName;
 extern const absl::string_view kRpcClientTransparentRetriesPerCallMeasureName;
 extern const absl::string_view kRpcClientRetryDelayPerCallMeasureName;
+extern const absl::string_view kRpcClientUnsampledRpcsMeasureName;
 
 extern const absl::string_view kRpcServerSentMessagesPerRpcMeasureName;
 extern const absl::string_view kRpcServerSentBytesPerRpcMeasureName;
 extern const absl::string_view kRpcServerReceivedMessagesPerRpcMeasureName;
 extern const absl::string_view kRpcServerReceivedBytesPerRpcMeasureName;
 extern const absl::string_view kRpcServerServerLatencyMeasureName;
+extern const absl::string_view kRpcServerUnsampledRpcsMeasureName;
 
 // Canonical gRPC view definitions.
 const ::opencensus::stats::ViewDescriptor& ClientSentMessagesPerRpcCumulative();
@@ -69,6 +76,7 @@ const ::opencensus::stats::ViewDescriptor&
 ClientTransparentRetriesPerCallCumulative();
 const ::opencensus::stats::ViewDescriptor& ClientTransparentRetriesCumulative();
 const ::opencensus::stats::ViewDescriptor& ClientRetryDelayPerCallCumulative();
+const ::opencensus::stats::ViewDescriptor& ClientUnsampledRpcsCumulative();
 
 const ::opencensus::stats::ViewDescriptor& ServerSentBytesPerRpcCumulative();
 const ::opencensus::stats::ViewDescriptor&
@@ -79,6 +87,7 @@ const ::opencensus::stats::ViewDescriptor& ServerCompletedRpcsCumulative();
 const ::opencensus::stats::ViewDescriptor& ServerSentMessagesPerRpcCumulative();
 const ::opencensus::stats::ViewDescriptor&
 ServerReceivedMessagesPerRpcCumulative();
+const ::opencensus::stats::ViewDescriptor& ServerUnsampledRpcsCumulative();
 
 const ::opencensus::stats::ViewDescriptor& ClientSentMessagesPerRpcMinute();
 const ::opencensus::stats::ViewDescriptor& ClientSentBytesPerRpcMinute();
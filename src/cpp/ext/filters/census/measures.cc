@@ -115,6 +115,14 @@ MeasureDouble RpcClientRetryDelayPerCall() {
   return measure;
 }
 
+MeasureInt64 RpcClientUnsampledRpcs() {
+  static const auto measure = MeasureInt64::Register(
+      kRpcClientUnsampledRpcsMeasureName,
+      "Number of client calls not sampled for tracing and per-call stats",
+      kCount);
+  return measure;
+}
+
 // Server
 MeasureDouble RpcServerSentBytesPerRpc() {
   static const auto measure = MeasureDouble::Register(
@@ -153,4 +161,12 @@ MeasureInt64 RpcServerReceivedMessagesPerRpc() {
   return measure;
 }
 
+MeasureInt64 RpcServerUnsampledRpcs() {
+  static const auto measure = MeasureInt64::Register(
+      kRpcServerUnsampledRpcsMeasureName,
+      "Number of server calls not sampled for tracing and per-call stats",
+      kCount);
+  return measure;
+}
+
 }  // namespace grpc
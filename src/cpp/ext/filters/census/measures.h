@@ -37,6 +37,7 @@ namespace grpc {
 ::opencensus::stats::MeasureInt64 RpcClientRetriesPerCall();
 ::opencensus::stats::MeasureInt64 RpcClientTransparentRetriesPerCall();
 ::opencensus::stats::MeasureDouble RpcClientRetryDelayPerCall();
+::opencensus::stats::MeasureInt64 RpcClientUnsampledRpcs();
 
 ::opencensus::stats::MeasureInt64 RpcServerSentMessagesPerRpc();
 ::opencensus::stats::MeasureDouble RpcServerSentBytesPerRpc();
@@ -44,6 +45,7 @@ namespace grpc {
 ::opencensus::stats::MeasureDouble RpcServerReceivedBytesPerRpc();
 ::opencensus::stats::MeasureDouble RpcServerServerLatency();
 ::opencensus::stats::MeasureInt64 RpcServerCompletedRpcs();
+::opencensus::stats::MeasureInt64 RpcServerUnsampledRpcs();
 
 }  // namespace grpc
 
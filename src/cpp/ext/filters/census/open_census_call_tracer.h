@@ -84,6 +84,9 @@ class OpenCensusCallTracer : public grpc_core::CallTracer {
   absl::string_view method_;
   CensusContext context_;
   grpc_core::Arena* arena_;
+  // Whether the call is traced and recorded in full, decided when the
+  // context is generated.
+  bool sampled_ = true;
   grpc_core::Mutex mu_;
   // Non-transparent attempts per call
   uint64_t retries_ ABSL_GUARDED_BY(&mu_) = 0;
@@ -25,6 +25,7 @@
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "opencensus/stats/stats.h"
+#include "opencensus/trace/propagation/grpc_trace_bin.h"
 
 #include "src/core/lib/surface/call.h"
 #include "src/cpp/ext/filters/census/grpc_plugin.h"
@@ -91,11 +92,22 @@ void CensusServerCallData::OnDoneRecvInitialMetadataCb(
     FilterInitialMetadata(initial_metadata, &sml);
     calld->path_ = std::move(sml.path);
     calld->method_ = GetMethod(calld->path_);
-    calld->qualified_method_ = absl::StrCat("Recv.", calld->method_);
-    GenerateServerContext(sml.tracing_slice.as_string_view(),
-                          calld->qualified_method_, &calld->context_);
-    grpc_census_call_set_context(
-        calld->gc_, reinterpret_cast<census_context*>(&calld->context_));
+    // Follow the sampling decision of an upstream trace, if there is one.
+    opencensus::trace::SpanContext parent_ctx =
+        opencensus::trace::propagation::FromGrpcTraceBinHeader(
+            sml.tracing_slice.as_string_view());
+    calld->sampled_ = parent_ctx.IsValid()
+                          ? parent_ctx.trace_options().IsSampled()
+                          : OpenCensusShouldSample(calld->method_);
+    if (calld->sampled_) {
+      calld->qualified_method_ = absl::StrCat("Recv.", calld->method_);
+      GenerateServerContext(sml.tracing_slice.as_string_view(),
+                            calld->qualified_method_, &calld->context_);
+      grpc_census_call_set_context(
+          calld->gc_, reinterpret_cast<census_context*>(&calld->context_));
+    } else {
+      ::opencensus::stats::Record({{RpcServerUnsampledRpcs(), 1}});
+    }
   }
   grpc_core::Closure::Run(DEBUG_LOCATION,
                           calld->initial_on_done_recv_initial_metadata_,
@@ -121,7 +133,7 @@ void CensusServerCallData::StartTransportStreamOpBatch(
   }
   // We need to record the time when the trailing metadata was sent to mark the
   // completeness of the request.
-  if (op->send_trailing_metadata() != nullptr) {
+  if (op->send_trailing_metadata() != nullptr && sampled_) {
     elapsed_time_ = absl::Now() - start_time_;
     size_t len = ServerStatsSerialize(absl::ToInt64Nanoseconds(elapsed_time_),
                                       stats_buf_, kMaxServerStatsLen);
@@ -152,10 +164,11 @@ grpc_error_handle CensusServerCallData::Init(
 void CensusServerCallData::Destroy(grpc_call_element* /*elem*/,
                                    const grpc_call_final_info* final_info,
                                    grpc_closure* /*then_call_closure*/) {
+  grpc_auth_context_release(auth_context_);
+  if (!sampled_) return;
   const uint64_t request_size = GetOutgoingDataSize(final_info);
   const uint64_t response_size = GetIncomingDataSize(final_info);
   double elapsed_time_ms = absl::ToDoubleMilliseconds(elapsed_time_);
-  grpc_auth_context_release(auth_context_);
   ::opencensus::stats::Record(
       {{RpcServerSentBytesPerRpc(), static_cast<double>(response_size)},
        {RpcServerReceivedBytesPerRpc(), static_cast<double>(request_size)},
@@ -49,7 +49,8 @@ class CensusServerCallData : public CallData {
         initial_on_done_recv_message_(nullptr),
         recv_message_(nullptr),
         recv_message_count_(0),
-        sent_message_count_(0) {
+        sent_message_count_(0),
+        sampled_(true) {
     memset(&on_done_recv_initial_metadata_, 0, sizeof(grpc_closure));
     memset(&on_done_recv_message_, 0, sizeof(grpc_closure));
   }
@@ -90,6 +91,9 @@ class CensusServerCallData : public CallData {
   grpc_core::OrphanablePtr<grpc_core::ByteStream>* recv_message_;
   uint64_t recv_message_count_;
   uint64_t sent_message_count_;
+  // Whether the call is traced and recorded in full, decided once the
+  // initial metadata is received.
+  bool sampled_;
   // Buffer needed for grpc_slice to reference it when adding metatdata to
   // response.
   char stats_buf_[kMaxServerStatsLen];
@@ -78,12 +78,14 @@ void RegisterOpenCensusViewsForExport() {
   ClientReceivedBytesPerRpcCumulative().RegisterForExport();
   ClientRoundtripLatencyCumulative().RegisterForExport();
   ClientServerLatencyCumulative().RegisterForExport();
+  ClientUnsampledRpcsCumulative().RegisterForExport();
 
   ServerSentMessagesPerRpcCumulative().RegisterForExport();
   ServerSentBytesPerRpcCumulative().RegisterForExport();
   ServerReceivedMessagesPerRpcCumulative().RegisterForExport();
   ServerReceivedBytesPerRpcCumulative().RegisterForExport();
   ServerServerLatencyCumulative().RegisterForExport();
+  ServerUnsampledRpcsCumulative().RegisterForExport();
 }
 
 // client cumulative
@@ -208,6 +210,16 @@ const ViewDescriptor& ClientRetryDelayPerCallCumulative() {
   return descriptor;
 }
 
+// Unsampled calls are recorded without tags.
+const ViewDescriptor& ClientUnsampledRpcsCumulative() {
+  const static ViewDescriptor descriptor =
+      ViewDescriptor()
+          .set_name("grpc.io/client/unsampled_rpcs/cumulative")
+          .set_measure(kRpcClientUnsampledRpcsMeasureName)
+          .set_aggregation(Aggregation::Count());
+  return descriptor;
+}
+
 // server cumulative
 const ViewDescriptor& ServerSentBytesPerRpcCumulative() {
   const static ViewDescriptor descriptor =
@@ -270,6 +282,15 @@ const ViewDescriptor& ServerReceivedMessagesPerRpcCumulative() {
   return descriptor;
 }
 
+const ViewDescriptor& ServerUnsampledRpcsCumulative() {
+  const static ViewDescriptor descriptor =
+      ViewDescriptor()
+          .set_name("grpc.io/server/unsampled_rpcs/cumulative")
+          .set_measure(kRpcServerUnsampledRpcsMeasureName)
+          .set_aggregation(Aggregation::Count());
+  return descriptor;
+}
+
 // client minute
 const ViewDescriptor& ClientSentBytesPerRpcMinute() {
   const static ViewDescriptor descriptor =
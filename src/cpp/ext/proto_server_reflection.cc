@@ -18,6 +18,8 @@
 
 #include "src/cpp/ext/proto_server_reflection.h"
 
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -120,8 +122,7 @@ Status ProtoServerReflection::GetFileByName(
   if (file_desc == nullptr) {
     return Status(StatusCode::NOT_FOUND, "File not found.");
   }
-  std::unordered_set<std::string> seen_files;
-  FillFileDescriptorResponse(file_desc, response, &seen_files);
+  FillFileDescriptorResponse(file_desc, response);
   return Status::OK;
 }
 
@@ -137,8 +138,7 @@ Status ProtoServerReflection::GetFileContainingSymbol(
   if (file_desc == nullptr) {
     return Status(StatusCode::NOT_FOUND, "Symbol not found.");
   }
-  std::unordered_set<std::string> seen_files;
-  FillFileDescriptorResponse(file_desc, response, &seen_files);
+  FillFileDescriptorResponse(file_desc, response);
   return Status::OK;
 }
 
@@ -161,8 +161,7 @@ Status ProtoServerReflection::GetFileContainingExtension(
   if (field_desc == nullptr) {
     return Status(StatusCode::NOT_FOUND, "Extension not found.");
   }
-  std::unordered_set<std::string> seen_files;
-  FillFileDescriptorResponse(field_desc->file(), response, &seen_files);
+  FillFileDescriptorResponse(field_desc->file(), response);
   return Status::OK;
 }
 
@@ -190,21 +189,42 @@ Status ProtoServerReflection::GetAllExtensionNumbers(
 
 void ProtoServerReflection::FillFileDescriptorResponse(
     const protobuf::FileDescriptor* file_desc,
-    ServerReflectionResponse* response,
-    std::unordered_set<std::string>* seen_files) {
-  if (seen_files->find(file_desc->name()) != seen_files->end()) {
-    return;
+    ServerReflectionResponse* response) {
+  for (const std::string* data : GetFileDescriptorClosure(file_desc)) {
+    response->mutable_file_descriptor_response()->add_file_descriptor_proto(
+        *data);
   }
-  seen_files->insert(file_desc->name());
+}
+
+const std::vector<const std::string*>&
+ProtoServerReflection::GetFileDescriptorClosure(
+    const protobuf::FileDescriptor* file_desc) {
+  grpc::internal::MutexLock lock(&cache_mu_);
+  auto it = file_closures_.find(file_desc);
+  if (it != file_closures_.end()) return it->second;
+  std::vector<const std::string*> closure;
+  std::unordered_set<const protobuf::FileDescriptor*> seen_files;
+  AddFileDescriptorClosureLocked(file_desc, &closure, &seen_files);
+  return file_closures_.emplace(file_desc, std::move(closure)).first->second;
+}
 
-  protobuf::FileDescriptorProto file_desc_proto;
-  std::string data;
-  file_desc->CopyTo(&file_desc_proto);
-  file_desc_proto.SerializeToString(&data);
-  response->mutable_file_descriptor_response()->add_file_descriptor_proto(data);
+void ProtoServerReflection::AddFileDescriptorClosureLocked(
+    const protobuf::FileDescriptor* file_desc,
+    std::vector<const std::string*>* closure,
+    std::unordered_set<const protobuf::FileDescriptor*>* seen_files) {
+  if (!seen_files->insert(file_desc).second) return;
+  auto it = serialized_files_.find(file_desc);
+  if (it == serialized_files_.end()) {
+    protobuf::FileDescriptorProto file_desc_proto;
+    file_desc->CopyTo(&file_desc_proto);
+    it = serialized_files_.emplace(file_desc, std::string()).first;
+    file_desc_proto.SerializeToString(&it->second);
+  }
+  closure->push_back(&it->second);
 
   for (int i = 0; i < file_desc->dependency_count(); ++i) {
-    FillFileDescriptorResponse(file_desc->dependency(i), response, seen_files);
+    AddFileDescriptorClosureLocked(file_desc->dependency(i), closure,
+                                   seen_files);
   }
 }
 
@@ -19,10 +19,13 @@
 #ifndef GRPC_INTERNAL_CPP_EXT_PROTO_SERVER_REFLECTION_H
 #define GRPC_INTERNAL_CPP_EXT_PROTO_SERVER_REFLECTION_H
 
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include <grpcpp/grpcpp.h>
+#include <grpcpp/impl/codegen/sync.h>
 
 #include "src/proto/grpc/reflection/v1alpha/reflection.grpc.pb.h"
 
@@ -66,14 +69,35 @@ class ProtoServerReflection final
 
   void FillFileDescriptorResponse(
       const protobuf::FileDescriptor* file_desc,
-      reflection::v1alpha::ServerReflectionResponse* response,
-      std::unordered_set<std::string>* seen_files);
+      reflection::v1alpha::ServerReflectionResponse* response);
+
+  // Returns the serialized FileDescriptorProtos of file_desc and its
+  // transitive dependencies, in the order they are sent. Computed on first
+  // use; the returned vector stays valid for the lifetime of this service.
+  const std::vector<const std::string*>& GetFileDescriptorClosure(
+      const protobuf::FileDescriptor* file_desc);
+
+  void AddFileDescriptorClosureLocked(
+      const protobuf::FileDescriptor* file_desc,
+      std::vector<const std::string*>* closure,
+      std::unordered_set<const protobuf::FileDescriptor*>* seen_files)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(cache_mu_);
 
   void FillErrorResponse(const Status& status,
                          reflection::v1alpha::ErrorResponse* error_response);
 
   const protobuf::DescriptorPool* descriptor_pool_;
   const std::vector<string>* services_;
+
+  // Descriptors of the pool are immutable, so their serialized forms are
+  // cached forever. Entries are never erased, so references to them stay
+  // valid after the lock is released.
+  grpc::internal::Mutex cache_mu_;
+  std::unordered_map<const protobuf::FileDescriptor*, std::string>
+      serialized_files_ ABSL_GUARDED_BY(cache_mu_);
+  std::unordered_map<const protobuf::FileDescriptor*,
+                     std::vector<const std::string*>>
+      file_closures_ ABSL_GUARDED_BY(cache_mu_);
 };
 
 }  // namespace grpc
@@ -18,12 +18,25 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <vector>
+
 #include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 
+#include <grpc/grpc.h>
 #include <grpcpp/ext/admin_services.h>
 #include <grpcpp/impl/server_builder_plugin.h>
 #include <grpcpp/server_builder.h>
 
+#include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/channel/channelz_registry.h"
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+
 // TODO(lidiz) build a real registration system that can pull in services
 // automatically with minimum amount of code.
 #include "src/cpp/server/channelz/channelz_service.h"
@@ -39,6 +52,138 @@ auto* g_channelz_service = new ChannelzService();
 auto* g_csds = new xds::experimental::ClientStatusDiscoveryService();
 #endif  // GRPC_NO_XDS or DISABLED_XDS_PROTO_IN_CC
 
+using grpc_core::channelz::BaseNode;
+
+// Escapes label values and HELP texts.
+std::string EscapeOpenMetrics(absl::string_view text) {
+  std::string escaped;
+  for (char c : text) {
+    switch (c) {
+      case '\\':
+        escaped += "\\\\";
+        break;
+      case '"':
+        escaped += "\\\"";
+        break;
+      case '\n':
+        escaped += "\\n";
+        break;
+      default:
+        escaped += c;
+    }
+  }
+  return escaped;
+}
+
+void AppendMetricFamily(absl::string_view name, absl::string_view type,
+                        absl::string_view help, std::string* out) {
+  absl::StrAppend(out, "# TYPE ", name, " ", type, "\n", "# HELP ", name, " ",
+                  EscapeOpenMetrics(help), "\n");
+}
+
+void AppendCoreStats(std::string* out) {
+  grpc_stats_data data;
+  grpc_stats_collect(&data);
+  for (int i = 0; i < GRPC_STATS_COUNTER_COUNT; ++i) {
+    std::string name = absl::StrCat("grpc_core_", grpc_stats_counter_name[i]);
+    AppendMetricFamily(name, "counter", grpc_stats_counter_doc[i], out);
+    absl::StrAppend(out, name, "_total ", data.counters[i], "\n");
+  }
+  for (int i = 0; i < GRPC_STATS_HISTOGRAM_COUNT; ++i) {
+    std::string name =
+        absl::StrCat("grpc_core_", grpc_stats_histogram_name[i]);
+    AppendMetricFamily(name, "histogram", grpc_stats_histogram_doc[i], out);
+    const gpr_atm* buckets = &data.histograms[grpc_stats_histo_start[i]];
+    const int* bounds = grpc_stats_histo_bucket_boundaries[i];
+    int64_t cumulative = 0;
+    for (int j = 0; j < grpc_stats_histo_buckets[i]; ++j) {
+      cumulative += buckets[j];
+      // Recorded values are integers, so a bucket holds the values up to the
+      // start of the next one, exclusive.
+      std::string le = j + 1 < grpc_stats_histo_buckets[i]
+                           ? std::to_string(bounds[j + 1] - 1)
+                           : "+Inf";
+      absl::StrAppend(out, name, "_bucket{le=\"", le, "\"} ", cumulative,
+                      "\n");
+    }
+  }
+}
+
+const char* EntityKind(BaseNode::EntityType type) {
+  switch (type) {
+    case BaseNode::EntityType::kTopLevelChannel:
+      return "channel";
+    case BaseNode::EntityType::kInternalChannel:
+      return "internal_channel";
+    case BaseNode::EntityType::kSubchannel:
+      return "subchannel";
+    case BaseNode::EntityType::kServer:
+      return "server";
+    case BaseNode::EntityType::kSocket:
+      return "socket";
+  }
+  GPR_UNREACHABLE_CODE(return "unknown");
+}
+
+void AppendCallCounts(std::string* out) {
+  struct Sample {
+    std::string labels;
+    BaseNode::CallCounts counts;
+  };
+  std::vector<Sample> samples;
+  for (const auto& node :
+       grpc_core::channelz::ChannelzRegistry::GetCallCountingNodes()) {
+    absl::optional<BaseNode::CallCounts> counts = node->GetCallCounts();
+    if (!counts.has_value()) continue;
+    samples.push_back(
+        {absl::StrCat("{kind=\"", EntityKind(node->type()), "\",uuid=\"",
+                      node->uuid(), "\",target=\"",
+                      EscapeOpenMetrics(node->name()), "\"}"),
+         *counts});
+  }
+  static const struct {
+    const char* name;
+    const char* help;
+    int64_t BaseNode::CallCounts::*count;
+  } kFamilies[] = {
+      {"grpc_channelz_calls_started", "Calls started on the entity",
+       &BaseNode::CallCounts::calls_started},
+      {"grpc_channelz_calls_succeeded",
+       "Calls on the entity that completed with an OK status",
+       &BaseNode::CallCounts::calls_succeeded},
+      {"grpc_channelz_calls_failed",
+       "Calls on the entity that completed with a non-OK status",
+       &BaseNode::CallCounts::calls_failed},
+  };
+  for (const auto& family : kFamilies) {
+    AppendMetricFamily(family.name, "counter", family.help, out);
+    for (const Sample& sample : samples) {
+      absl::StrAppend(out, family.name, "_total", sample.labels, " ",
+                      sample.counts.*family.count, "\n");
+    }
+  }
+}
+
+void AppendMemoryQuota(std::string* out) {
+  grpc_core::MemoryQuotaRefPtr quota =
+      grpc_core::ResourceQuota::Default()->memory_quota();
+  AppendMetricFamily("grpc_memory_quota_pressure", "gauge",
+                     "Memory pressure of the default resource quota, from 0 "
+                     "to 1",
+                     out);
+  absl::StrAppend(out, "grpc_memory_quota_pressure ",
+                  quota->InstantaneousPressure(), "\n");
+  AppendMetricFamily("grpc_memory_quota_usage_bytes", "gauge",
+                     "Bytes in use from the default resource quota", out);
+  grpc_core::MemoryUsage usage = quota->GetUsage();
+  for (size_t i = 0; i < usage.size(); ++i) {
+    absl::StrAppend(out, "grpc_memory_quota_usage_bytes{category=\"",
+                    grpc_core::MemoryCategoryName(
+                        static_cast<grpc_core::MemoryCategory>(i)),
+                    "\"} ", usage[i], "\n");
+  }
+}
+
 }  // namespace
 
 void AddAdminServices(ServerBuilder* builder) {
@@ -48,4 +193,24 @@ void AddAdminServices(ServerBuilder* builder) {
 #endif  // GRPC_NO_XDS or DISABLED_XDS_PROTO_IN_CC
 }
 
+namespace experimental {
+
+std::string ExportOpenMetrics() {
+  grpc_init();
+  std::string out;
+  {
+    grpc_core::ExecCtx exec_ctx;
+    AppendCoreStats(&out);
+    AppendCallCounts(&out);
+    AppendMemoryQuota(&out);
+  }
+  grpc_shutdown();
+  absl::StrAppend(&out, "# EOF\n");
+  return out;
+}
+
+std::string DumpTraceRing() { return grpc_core::TraceRing::Dump(); }
+
+}  // namespace experimental
+
 }  // namespace grpc
@@ -0,0 +1,136 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/cpp/server/backend_metric_recorder.h"
+
+#include <utility>
+
+#include "absl/strings/string_view.h"
+
+#include <grpcpp/ext/server_metric_recorder.h>
+
+namespace grpc {
+namespace experimental {
+
+namespace {
+
+bool IsUtilizationValid(double value) { return value >= 0 && value <= 1; }
+
+}  // namespace
+
+//
+// ServerMetricRecorder
+//
+
+void ServerMetricRecorder::SetCpuUtilization(double value) {
+  if (!IsUtilizationValid(value)) return;
+  cpu_utilization_.store(value, std::memory_order_relaxed);
+  sequence_number_.fetch_add(1, std::memory_order_release);
+}
+
+void ServerMetricRecorder::ClearCpuUtilization() {
+  cpu_utilization_.store(-1, std::memory_order_relaxed);
+  sequence_number_.fetch_add(1, std::memory_order_release);
+}
+
+void ServerMetricRecorder::SetMemoryUtilization(double value) {
+  if (!IsUtilizationValid(value)) return;
+  memory_utilization_.store(value, std::memory_order_relaxed);
+  sequence_number_.fetch_add(1, std::memory_order_release);
+}
+
+void ServerMetricRecorder::ClearMemoryUtilization() {
+  memory_utilization_.store(-1, std::memory_order_relaxed);
+  sequence_number_.fetch_add(1, std::memory_order_release);
+}
+
+void ServerMetricRecorder::SetNamedUtilization(std::string name,
+                                               double value) {
+  if (!IsUtilizationValid(value)) return;
+  grpc::internal::MutexLock lock(&named_mu_);
+  named_utilization_[std::move(name)] = value;
+  sequence_number_.fetch_add(1, std::memory_order_release);
+}
+
+void ServerMetricRecorder::ClearNamedUtilization(const std::string& name) {
+  grpc::internal::MutexLock lock(&named_mu_);
+  named_utilization_.erase(name);
+  sequence_number_.fetch_add(1, std::memory_order_release);
+}
+
+void ServerMetricRecorder::SetAllNamedUtilization(
+    std::map<std::string, double> named_utilization) {
+  grpc::internal::MutexLock lock(&named_mu_);
+  named_utilization_ = std::move(named_utilization);
+  sequence_number_.fetch_add(1, std::memory_order_release);
+}
+
+std::map<std::string, double> ServerMetricRecorder::named_utilization() const {
+  grpc::internal::MutexLock lock(&named_mu_);
+  return named_utilization_;
+}
+
+//
+// BackendMetricState
+//
+
+CallMetricRecorder& BackendMetricState::RecordCpuUtilizationMetric(
+    double value) {
+  if (IsUtilizationValid(value)) {
+    cpu_utilization_.store(value, std::memory_order_relaxed);
+  }
+  return *this;
+}
+
+CallMetricRecorder& BackendMetricState::RecordMemoryUtilizationMetric(
+    double value) {
+  if (IsUtilizationValid(value)) {
+    mem_utilization_.store(value, std::memory_order_relaxed);
+  }
+  return *this;
+}
+
+CallMetricRecorder& BackendMetricState::RecordUtilizationMetric(
+    string_ref name, double value) {
+  if (!IsUtilizationValid(value)) return *this;
+  grpc_core::MutexLock lock(&mu_);
+  utilization_[std::string(name.data(), name.size())] = value;
+  return *this;
+}
+
+CallMetricRecorder& BackendMetricState::RecordRequestCostMetric(
+    string_ref name, double value) {
+  grpc_core::MutexLock lock(&mu_);
+  request_cost_[std::string(name.data(), name.size())] = value;
+  return *this;
+}
+
+grpc_core::BackendMetricData BackendMetricState::GetBackendMetricData() {
+  grpc_core::BackendMetricData data;
+  data.cpu_utilization = cpu_utilization_.load(std::memory_order_relaxed);
+  data.mem_utilization = mem_utilization_.load(std::memory_order_relaxed);
+  grpc_core::MutexLock lock(&mu_);
+  for (const auto& p : utilization_) {
+    data.utilization.emplace(p.first, p.second);
+  }
+  for (const auto& p : request_cost_) {
+    data.request_cost.emplace(p.first, p.second);
+  }
+  return data;
+}
+
+}  // namespace experimental
+}  // namespace grpc
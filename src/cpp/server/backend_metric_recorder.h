@@ -0,0 +1,60 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_INTERNAL_CPP_SERVER_BACKEND_METRIC_RECORDER_H
+#define GRPC_INTERNAL_CPP_SERVER_BACKEND_METRIC_RECORDER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <atomic>
+#include <map>
+#include <string>
+
+#include <grpcpp/ext/call_metric_recorder.h>
+#include <grpcpp/support/string_ref.h>
+
+#include "src/core/ext/filters/backend_metrics/backend_metric_provider.h"
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc {
+namespace experimental {
+
+// The CallMetricRecorder of a call, which hands the recorded metrics to the
+// backend metric filter when the call sends its trailing metadata.
+class BackendMetricState : public CallMetricRecorder,
+                           public grpc_core::BackendMetricProvider {
+ public:
+  CallMetricRecorder& RecordCpuUtilizationMetric(double value) override;
+  CallMetricRecorder& RecordMemoryUtilizationMetric(double value) override;
+  CallMetricRecorder& RecordUtilizationMetric(string_ref name,
+                                              double value) override;
+  CallMetricRecorder& RecordRequestCostMetric(string_ref name,
+                                              double value) override;
+
+  grpc_core::BackendMetricData GetBackendMetricData() override;
+
+ private:
+  std::atomic<double> cpu_utilization_{-1};
+  std::atomic<double> mem_utilization_{-1};
+  grpc_core::Mutex mu_;
+  std::map<std::string, double> utilization_ ABSL_GUARDED_BY(mu_);
+  std::map<std::string, double> request_cost_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace experimental
+}  // namespace grpc
+
+#endif  // GRPC_INTERNAL_CPP_SERVER_BACKEND_METRIC_RECORDER_H
@@ -31,6 +31,9 @@ grpc::protobuf::util::Status ParseJson(const char* json_str,
                                        grpc::protobuf::Message* message) {
   grpc::protobuf::json::JsonParseOptions options;
   options.case_insensitive_enum_parsing = true;
+  // Core may render fields that channelz.proto does not define yet, such as
+  // the channel's TX latency histograms.
+  options.ignore_unknown_fields = true;
   return grpc::protobuf::json::JsonStringToMessage(json_str, message, options);
 }
 
@@ -19,6 +19,7 @@
 #include "src/cpp/server/external_connection_acceptor_impl.h"
 
 #include <memory>
+#include <vector>
 
 #include <grpcpp/server_builder.h>
 #include <grpcpp/support/channel_arguments.h>
@@ -35,6 +36,10 @@ class AcceptorWrapper : public experimental::ExternalConnectionAcceptor {
   void HandleNewConnection(NewConnectionParameters* p) override {
     impl_->HandleNewConnection(p);
   }
+  void HandleNewConnections(NewConnectionParameters* connections,
+                            size_t count) override {
+    impl_->HandleNewConnections(connections, count);
+  }
 
  private:
   std::shared_ptr<ExternalConnectionAcceptorImpl> impl_;
@@ -75,6 +80,27 @@ void ExternalConnectionAcceptorImpl::HandleNewConnection(
   }
 }
 
+void ExternalConnectionAcceptorImpl::HandleNewConnections(
+    experimental::ExternalConnectionAcceptor::NewConnectionParameters*
+        connections,
+    size_t count) {
+  grpc_core::MutexLock lock(&mu_);
+  if (shutdown_ || !started_) {
+    gpr_log(GPR_ERROR,
+            "NOT handling %zu external connections, started %d, shutdown %d",
+            count, started_, shutdown_);
+    return;
+  }
+  if (handler_ == nullptr || count == 0) return;
+  std::vector<grpc_core::TcpServerFdHandler::Connection> handoff;
+  handoff.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    handoff.push_back({connections[i].listener_fd, connections[i].fd,
+                       connections[i].read_buffer.c_buffer()});
+  }
+  handler_->HandleBatch(handoff.data(), handoff.size());
+}
+
 void ExternalConnectionAcceptorImpl::Shutdown() {
   grpc_core::MutexLock lock(&mu_);
   shutdown_ = true;
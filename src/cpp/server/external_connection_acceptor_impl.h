@@ -45,6 +45,11 @@ class ExternalConnectionAcceptorImpl
   void HandleNewConnection(
       experimental::ExternalConnectionAcceptor::NewConnectionParameters* p);
 
+  void HandleNewConnections(
+      experimental::ExternalConnectionAcceptor::NewConnectionParameters*
+          connections,
+      size_t count);
+
   void Shutdown();
 
   void Start();
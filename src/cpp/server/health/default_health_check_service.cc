@@ -115,6 +115,7 @@ DefaultHealthCheckService::GetHealthCheckService() {
 
 void DefaultHealthCheckService::ServiceData::SetServingStatus(
     ServingStatus status) {
+  if (status_ == status) return;
   status_ = status;
   for (const auto& p : watchers_) {
     p.first->SendHealth(status);
@@ -143,14 +144,17 @@ const char kHealthWatchMethodName[] = "/grpc.health.v1.Health/Watch";
 DefaultHealthCheckService::HealthCheckServiceImpl::HealthCheckServiceImpl(
     DefaultHealthCheckService* database)
     : database_(database) {
+  for (ServingStatus status : {NOT_FOUND, SERVING, NOT_SERVING}) {
+    EncodeResponse(status, &responses_[status]);
+  }
   // Add Check() method.
   AddMethod(new internal::RpcServiceMethod(
       kHealthCheckMethodName, internal::RpcMethod::NORMAL_RPC, nullptr));
   MarkMethodCallback(
       0, new internal::CallbackUnaryHandler<ByteBuffer, ByteBuffer>(
-             [database](CallbackServerContext* context,
-                        const ByteBuffer* request, ByteBuffer* response) {
-               return HandleCheckRequest(database, context, request, response);
+             [this](CallbackServerContext* context, const ByteBuffer* request,
+                    ByteBuffer* response) {
+               return HandleCheckRequest(context, request, response);
              }));
   // Add Watch() method.
   AddMethod(new internal::RpcServiceMethod(
@@ -172,8 +176,8 @@ DefaultHealthCheckService::HealthCheckServiceImpl::~HealthCheckServiceImpl() {
 
 ServerUnaryReactor*
 DefaultHealthCheckService::HealthCheckServiceImpl::HandleCheckRequest(
-    DefaultHealthCheckService* database, CallbackServerContext* context,
-    const ByteBuffer* request, ByteBuffer* response) {
+    CallbackServerContext* context, const ByteBuffer* request,
+    ByteBuffer* response) {
   auto* reactor = context->DefaultReactor();
   std::string service_name;
   if (!DecodeRequest(*request, &service_name)) {
@@ -181,15 +185,17 @@ DefaultHealthCheckService::HealthCheckServiceImpl::HandleCheckRequest(
         Status(StatusCode::INVALID_ARGUMENT, "could not parse request"));
     return reactor;
   }
-  ServingStatus serving_status = database->GetServingStatus(service_name);
+  ServingStatus serving_status = database_->GetServingStatus(service_name);
   if (serving_status == NOT_FOUND) {
     reactor->Finish(Status(StatusCode::NOT_FOUND, "service name unknown"));
     return reactor;
   }
-  if (!EncodeResponse(serving_status, response)) {
+  if (!responses_[serving_status].Valid()) {
     reactor->Finish(Status(StatusCode::INTERNAL, "could not encode response"));
     return reactor;
   }
+  // Copying only takes a ref on the shared slice.
+  *response = responses_[serving_status];
   reactor->Finish(Status::OK);
   return reactor;
 }
@@ -294,9 +300,10 @@ void DefaultHealthCheckService::HealthCheckServiceImpl::WatchReactor::
       return;
     }
   }
-  // Send response.
-  bool success = EncodeResponse(status, &response_);
-  if (!success) {
+  // Send response. The service outlives its watchers, so they can all write
+  // the same pre-encoded response.
+  const ByteBuffer& response = service_->responses_[status];
+  if (!response.Valid()) {
     MaybeFinishLocked(
         Status(StatusCode::INTERNAL, "could not encode response"));
     return;
@@ -305,14 +312,13 @@ void DefaultHealthCheckService::HealthCheckServiceImpl::WatchReactor::
           "[HCS %p] watcher %p \"%s\": starting write for ServingStatus %d",
           service_, this, service_name_.c_str(), status);
   write_pending_ = true;
-  StartWrite(&response_);
+  StartWrite(&response);
 }
 
 void DefaultHealthCheckService::HealthCheckServiceImpl::WatchReactor::
     OnWriteDone(bool ok) {
   gpr_log(GPR_DEBUG, "[HCS %p] watcher %p \"%s\": OnWriteDone(): ok=%d",
           service_, this, service_name_.c_str(), ok);
-  response_.Clear();
   grpc::internal::MutexLock lock(&mu_);
   if (!ok) {
     MaybeFinishLocked(Status(StatusCode::CANCELLED, "OnWriteDone() ok=false"));
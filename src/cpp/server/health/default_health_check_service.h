@@ -63,7 +63,6 @@ class DefaultHealthCheckService final : public HealthCheckServiceInterface {
 
       HealthCheckServiceImpl* service_;
       std::string service_name_;
-      ByteBuffer response_;
 
       grpc::internal::Mutex mu_;
       bool write_pending_ ABSL_GUARDED_BY(mu_) = false;
@@ -77,9 +76,9 @@ class DefaultHealthCheckService final : public HealthCheckServiceInterface {
 
    private:
     // Request handler for Check method.
-    static ServerUnaryReactor* HandleCheckRequest(
-        DefaultHealthCheckService* database, CallbackServerContext* context,
-        const ByteBuffer* request, ByteBuffer* response);
+    ServerUnaryReactor* HandleCheckRequest(CallbackServerContext* context,
+                                           const ByteBuffer* request,
+                                           ByteBuffer* response);
 
     // Returns true on success.
     static bool DecodeRequest(const ByteBuffer& request,
@@ -88,6 +87,10 @@ class DefaultHealthCheckService final : public HealthCheckServiceInterface {
 
     DefaultHealthCheckService* database_;
 
+    // The serialized response for each ServingStatus, encoded once and shared
+    // by all the Check and Watch calls. Invalid if encoding failed.
+    ByteBuffer responses_[3];
+
     grpc::internal::Mutex mu_;
     grpc::internal::CondVar shutdown_condition_;
     bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
@@ -110,6 +113,7 @@ class DefaultHealthCheckService final : public HealthCheckServiceInterface {
   // handlers registered for updates when the service's status changes.
   class ServiceData {
    public:
+    // Notifies the watchers only if the status changes.
     void SetServingStatus(ServingStatus status);
     ServingStatus GetServingStatus() const { return status_; }
     void AddWatch(
@@ -35,6 +35,8 @@ constexpr uint32_t kVersion = 15853;
 // fetching interval configurable.
 constexpr uint32_t kFeedbackSampleWindowSeconds = 10;
 constexpr uint32_t kFetchAndSampleIntervalSeconds = 1;
+// Stores of closed report streams that saw no calls for this long are evicted.
+constexpr uint32_t kIdleStoreEvictionIntervalSeconds = 300;
 
 constexpr size_t kLbIdLength = 8;
 constexpr size_t kIpv4AddressLength = 8;
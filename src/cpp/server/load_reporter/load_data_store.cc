@@ -142,6 +142,7 @@ LoadRecordValue::LoadRecordValue(std::string metric_name, uint64_t num_calls,
 
 void PerBalancerStore::MergeRow(const LoadRecordKey& key,
                                 const LoadRecordValue& value) {
+  merged_since_idle_check_ = true;
   // During suspension, the load data received will be dropped.
   if (!suspended_) {
     load_record_map_[key].MergeFrom(value);
@@ -179,6 +180,13 @@ uint64_t PerBalancerStore::GetNumCallsInProgressForReport() {
   return num_calls_in_progress_;
 }
 
+bool PerBalancerStore::CheckIdle() {
+  bool merged = merged_since_idle_check_;
+  merged_since_idle_check_ = false;
+  return !merged && num_calls_in_progress_ == 0 && load_record_map_.empty() &&
+         (suspended_ || last_reported_num_calls_in_progress_ == 0);
+}
+
 void PerHostStore::ReportStreamCreated(const std::string& lb_id,
                                        const std::string& load_key) {
   GPR_ASSERT(lb_id != kInvalidLbId);
@@ -250,6 +258,33 @@ const std::set<PerBalancerStore*>* PerHostStore::GetAssignedStores(
   return &(it->second);
 }
 
+void PerHostStore::EvictIdleStores() {
+  bool invalid_lb_id_store_idle = false;
+  for (auto it = per_balancer_stores_.begin();
+       it != per_balancer_stores_.end();) {
+    const std::string& lb_id = it->first;
+    PerBalancerStore* store = it->second.get();
+    // Check every store once per eviction, since checking resets its idleness.
+    const bool idle = store->CheckIdle();
+    if (lb_id == kInvalidLbId) invalid_lb_id_store_idle = idle;
+    if (!idle || lb_id == kInvalidLbId ||
+        assigned_stores_.find(lb_id) != assigned_stores_.end()) {
+      ++it;
+      continue;
+    }
+    for (auto& p : assigned_stores_) {
+      if (p.second.erase(store) > 0) break;
+    }
+    gpr_log(GPR_DEBUG, "[PerHostStore %p] Evicted idle store (%p) of LB ID %s.",
+            this, store, lb_id.c_str());
+    it = per_balancer_stores_.erase(it);
+  }
+  if (assigned_stores_.empty() && per_balancer_stores_.size() == 1 &&
+      invalid_lb_id_store_idle) {
+    per_balancer_stores_.clear();
+  }
+}
+
 void PerHostStore::AssignOrphanedStore(PerBalancerStore* orphaned_store,
                                        const std::string& new_receiver) {
   auto it = assigned_stores_.find(new_receiver);
@@ -336,5 +371,18 @@ void LoadDataStore::ReportStreamClosed(const std::string& hostname,
   it_per_host_store->second.ReportStreamClosed(lb_id);
 }
 
+void LoadDataStore::EvictIdleStores() {
+  for (auto it = per_host_stores_.begin(); it != per_host_stores_.end();) {
+    it->second.EvictIdleStores();
+    if (it->second.IsEmpty()) {
+      gpr_log(GPR_DEBUG, "[LoadDataStore %p] Evicted idle host %s.", this,
+              it->first.c_str());
+      it = per_host_stores_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 }  // namespace load_reporter
 }  // namespace grpc
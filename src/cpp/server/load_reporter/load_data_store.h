@@ -223,6 +223,11 @@ class PerBalancerStore {
 
   void ClearLoadRecordMap() { load_record_map_.clear(); }
 
+  // Returns true if no load data has been merged into this store since the
+  // last check, and it has neither calls in progress nor load data left to
+  // report. Each check starts a new idle period.
+  bool CheckIdle();
+
   // Getters.
   const std::string& lb_id() const { return lb_id_; }
   const std::string& load_key() const { return load_key_; }
@@ -236,6 +241,7 @@ class PerBalancerStore {
   uint64_t num_calls_in_progress_ = 0;
   uint64_t last_reported_num_calls_in_progress_ = 0;
   bool suspended_ = false;
+  bool merged_since_idle_check_ = false;
 };
 
 // Stores the data associated with a particular host.
@@ -263,6 +269,15 @@ class PerHostStore {
   const std::set<PerBalancerStore*>* GetAssignedStores(
       const std::string& lb_id) const;
 
+  // Removes the stores of the balancers that are no longer receiving reports
+  // once they have been idle since the last eviction. The store of
+  // kInvalidLbId is only removed together with all the other stores, when no
+  // balancer is receiving reports, so that the next balancer can adopt it.
+  void EvictIdleStores();
+
+  // Whether all the stores of this host have been evicted.
+  bool IsEmpty() const { return per_balancer_stores_.empty(); }
+
  private:
   // Creates a PerBalancerStore for the given LB ID, assigns the store to
   // itself, and records the LB ID to the load key.
@@ -289,14 +304,13 @@ class PerHostStore {
 };
 
 // Thread-unsafe two-level bookkeeper of all the load data.
-// Note: We never remove any store objects from this class, as per the
-// current spec. That's because premature removal of the store objects
-// may lead to loss of critical information, e.g., mapping from lb_id to
-// load_key, and the number of in-progress calls. Such loss will cause
-// information inconsistency when the balancer is re-connected. Keeping
-// all the stores should be fine for PerHostStore, since we assume there
-// should only be a few hostnames. But it's a potential problem for
-// PerBalancerStore.
+// Note: Store objects are only removed by EvictIdleStores(), after they have
+// stayed idle for a whole eviction period. That's because premature removal
+// of the store objects may lead to loss of critical information, e.g.,
+// mapping from lb_id to load_key, and the number of in-progress calls. Such
+// loss will cause information inconsistency when the balancer is
+// re-connected. A store without calls in progress or unreported load data
+// that saw no calls for a whole period has nothing left to lose.
 class LoadDataStore {
  public:
   // Returns null if not found. Caller doesn't own the returned store.
@@ -330,6 +344,10 @@ class LoadDataStore {
   void ReportStreamClosed(const std::string& hostname,
                           const std::string& lb_id);
 
+  // Evicts the stores that have been idle since the last eviction (see
+  // PerHostStore::EvictIdleStores()), and the hosts left without any store.
+  void EvictIdleStores();
+
  private:
   // Buffered data that was fetched from Census but hasn't been sent to
   // balancer. We need to keep this data ourselves because Census will
@@ -235,6 +235,7 @@ std::string LoadReporter::GenerateLbId() {
     // The client may send requests with LB ID that has never been allocated
     // by this load reporter. Those IDs are tracked and will be skipped when
     // we generate a new ID.
+    grpc_core::MutexLock lock(&store_mu_);
     if (!load_data_store_.IsTrackedUnknownBalancerId(lb_id_str)) {
       return lb_id_str;
     }
@@ -399,7 +400,8 @@ void LoadReporter::ReportStreamClosed(const std::string& hostname,
 }
 
 void LoadReporter::ProcessViewDataCallStart(
-    const CensusViewProvider::ViewDataMap& view_data_map) {
+    const CensusViewProvider::ViewDataMap& view_data_map,
+    std::vector<PendingRow>* rows) {
   auto it = view_data_map.find(kViewStartCount);
   if (it != view_data_map.end()) {
     for (const auto& p : it->second.int_data()) {
@@ -410,16 +412,14 @@ void LoadReporter::ProcessViewDataCallStart(
       const std::string& user_id = tag_values[2];
       LoadRecordKey key(client_ip_and_token, user_id);
       LoadRecordValue value = LoadRecordValue(start_count);
-      {
-        grpc_core::MutexLock lock(&store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      rows->emplace_back(host, std::move(key), std::move(value));
     }
   }
 }
 
 void LoadReporter::ProcessViewDataCallEnd(
-    const CensusViewProvider::ViewDataMap& view_data_map) {
+    const CensusViewProvider::ViewDataMap& view_data_map,
+    std::vector<PendingRow>* rows) {
   uint64_t total_end_count = 0;
   uint64_t total_error_count = 0;
   auto it = view_data_map.find(kViewEndCount);
@@ -462,17 +462,15 @@ void LoadReporter::ProcessViewDataCallEnd(
       }
       LoadRecordValue value = LoadRecordValue(
           0, ok_count, error_count, bytes_sent, bytes_received, latency_ms);
-      {
-        grpc_core::MutexLock lock(&store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      rows->emplace_back(host, std::move(key), std::move(value));
     }
   }
   AppendNewFeedbackRecord(total_end_count, total_error_count);
 }
 
 void LoadReporter::ProcessViewDataOtherCallMetrics(
-    const CensusViewProvider::ViewDataMap& view_data_map) {
+    const CensusViewProvider::ViewDataMap& view_data_map,
+    std::vector<PendingRow>* rows) {
   auto it = view_data_map.find(kViewOtherCallMetricCount);
   if (it != view_data_map.end()) {
     for (const auto& p : it->second.int_data()) {
@@ -489,10 +487,7 @@ void LoadReporter::ProcessViewDataOtherCallMetrics(
               sizeof(kViewOtherCallMetricValue) - 1, tag_values);
       LoadRecordValue value = LoadRecordValue(
           metric_name, static_cast<uint64_t>(num_calls), total_metric_value);
-      {
-        grpc_core::MutexLock lock(&store_mu_);
-        load_data_store_.MergeRow(host, key, value);
-      }
+      rows->emplace_back(host, std::move(key), std::move(value));
     }
   }
 }
@@ -504,9 +499,22 @@ void LoadReporter::FetchAndSample() {
           this);
   CensusViewProvider::ViewDataMap view_data_map =
       census_view_provider_->FetchViewData();
-  ProcessViewDataCallStart(view_data_map);
-  ProcessViewDataCallEnd(view_data_map);
-  ProcessViewDataOtherCallMetrics(view_data_map);
+  std::vector<PendingRow> rows;
+  ProcessViewDataCallStart(view_data_map, &rows);
+  ProcessViewDataCallEnd(view_data_map, &rows);
+  ProcessViewDataOtherCallMetrics(view_data_map, &rows);
+  const auto now = std::chrono::steady_clock::now();
+  const bool evict =
+      now - last_eviction_time_ >=
+      std::chrono::seconds(kIdleStoreEvictionIntervalSeconds);
+  grpc_core::MutexLock lock(&store_mu_);
+  for (const PendingRow& row : rows) {
+    load_data_store_.MergeRow(row.host, row.key, row.value);
+  }
+  if (evict) {
+    load_data_store_.EvictIdleStores();
+    last_eviction_time_ = now;
+  }
 }
 
 }  // namespace load_reporter
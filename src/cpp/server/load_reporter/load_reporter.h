@@ -187,18 +187,34 @@ class LoadReporter {
           cpu_limit(cpu_limit) {}
   };
 
-  // Finds the view data about starting call from the view_data_map and merges
-  // the data to the load data store.
+  // A load record fetched from Census, waiting to be merged to the load data
+  // store.
+  struct PendingRow {
+    std::string host;
+    LoadRecordKey key;
+    LoadRecordValue value;
+
+    PendingRow(std::string host, LoadRecordKey key, LoadRecordValue value)
+        : host(std::move(host)),
+          key(std::move(key)),
+          value(std::move(value)) {}
+  };
+
+  // Finds the view data about starting call from the view_data_map and
+  // appends the rows to be merged to the load data store.
   void ProcessViewDataCallStart(
-      const CensusViewProvider::ViewDataMap& view_data_map);
-  // Finds the view data about ending call from the view_data_map and merges the
-  // data to the load data store.
+      const CensusViewProvider::ViewDataMap& view_data_map,
+      std::vector<PendingRow>* rows);
+  // Finds the view data about ending call from the view_data_map and appends
+  // the rows to be merged to the load data store.
   void ProcessViewDataCallEnd(
-      const CensusViewProvider::ViewDataMap& view_data_map);
+      const CensusViewProvider::ViewDataMap& view_data_map,
+      std::vector<PendingRow>* rows);
   // Finds the view data about the customized call metrics from the
-  // view_data_map and merges the data to the load data store.
+  // view_data_map and appends the rows to be merged to the load data store.
   void ProcessViewDataOtherCallMetrics(
-      const CensusViewProvider::ViewDataMap& view_data_map);
+      const CensusViewProvider::ViewDataMap& view_data_map,
+      std::vector<PendingRow>* rows);
 
   bool IsRecordInWindow(const LoadBalancingFeedbackRecord& record,
                         std::chrono::system_clock::time_point now) {
@@ -216,10 +232,13 @@ class LoadReporter {
   const std::chrono::seconds feedback_sample_window_seconds_;
   grpc_core::Mutex feedback_mu_;
   std::deque<LoadBalancingFeedbackRecord> feedback_records_;
-  // TODO(juanlishen): Lock in finer grain. Locking the whole store may be
-  // too expensive.
+  // The rows of each fetch are merged in one critical section, so that
+  // generating reports only ever waits for one fetch.
   grpc_core::Mutex store_mu_;
-  LoadDataStore load_data_store_;
+  LoadDataStore load_data_store_ ABSL_GUARDED_BY(store_mu_);
+  // Only accessed by FetchAndSample().
+  std::chrono::steady_clock::time_point last_eviction_time_ =
+      std::chrono::steady_clock::now();
   std::unique_ptr<CensusViewProvider> census_view_provider_;
   std::unique_ptr<CpuStatsProvider> cpu_stats_provider_;
 };
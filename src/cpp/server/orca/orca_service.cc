@@ -14,6 +14,7 @@
 // limitations under the License.
 //
 
+#include "absl/memory/memory.h"
 #include "google/protobuf/duration.upb.h"
 #include "upb/upb.hpp"
 #include "xds/data/orca/v3/orca_load_report.upb.h"
@@ -139,7 +140,13 @@ class OrcaService::Reactor : public ServerWriteReactor<ByteBuffer>,
 //
 
 OrcaService::OrcaService(OrcaService::Options options)
-    : min_report_duration_(options.min_report_duration) {
+    : min_report_duration_(options.min_report_duration),
+      owned_recorder_(options.server_metric_recorder == nullptr
+                          ? absl::make_unique<ServerMetricRecorder>()
+                          : nullptr),
+      recorder_(options.server_metric_recorder == nullptr
+                    ? owned_recorder_.get()
+                    : options.server_metric_recorder) {
   AddMethod(new internal::RpcServiceMethod(
       "/xds.service.orca.v3.OpenRcaService/StreamCoreMetrics",
       internal::RpcMethod::SERVER_STREAMING, /*handler=*/nullptr));
@@ -151,63 +158,55 @@ OrcaService::OrcaService(OrcaService::Options options)
 }
 
 void OrcaService::SetCpuUtilization(double cpu_utilization) {
-  grpc::internal::MutexLock lock(&mu_);
-  cpu_utilization_ = cpu_utilization;
-  response_slice_.reset();
+  recorder_->SetCpuUtilization(cpu_utilization);
 }
 
-void OrcaService::DeleteCpuUtilization() {
-  grpc::internal::MutexLock lock(&mu_);
-  cpu_utilization_ = -1;
-  response_slice_.reset();
-}
+void OrcaService::DeleteCpuUtilization() { recorder_->ClearCpuUtilization(); }
 
 void OrcaService::SetMemoryUtilization(double memory_utilization) {
-  grpc::internal::MutexLock lock(&mu_);
-  memory_utilization_ = memory_utilization;
-  response_slice_.reset();
+  recorder_->SetMemoryUtilization(memory_utilization);
 }
 
 void OrcaService::DeleteMemoryUtilization() {
-  grpc::internal::MutexLock lock(&mu_);
-  memory_utilization_ = -1;
-  response_slice_.reset();
+  recorder_->ClearMemoryUtilization();
 }
 
 void OrcaService::SetNamedUtilization(std::string name, double utilization) {
-  grpc::internal::MutexLock lock(&mu_);
-  named_utilization_[std::move(name)] = utilization;
-  response_slice_.reset();
+  recorder_->SetNamedUtilization(std::move(name), utilization);
 }
 
 void OrcaService::DeleteNamedUtilization(const std::string& name) {
-  grpc::internal::MutexLock lock(&mu_);
-  named_utilization_.erase(name);
-  response_slice_.reset();
+  recorder_->ClearNamedUtilization(name);
 }
 
 void OrcaService::SetAllNamedUtilization(
     std::map<std::string, double> named_utilization) {
-  grpc::internal::MutexLock lock(&mu_);
-  named_utilization_ = std::move(named_utilization);
-  response_slice_.reset();
+  recorder_->SetAllNamedUtilization(std::move(named_utilization));
 }
 
 Slice OrcaService::GetOrCreateSerializedResponse() {
+  // Read before the metrics, so that a concurrent update at worst makes the
+  // next report rebuild a report that is already current.
+  uint64_t sequence_number = recorder_->sequence_number();
   grpc::internal::MutexLock lock(&mu_);
-  if (!response_slice_.has_value()) {
+  if (!response_slice_.has_value() ||
+      response_sequence_number_ != sequence_number) {
     upb::Arena arena;
     xds_data_orca_v3_OrcaLoadReport* response =
         xds_data_orca_v3_OrcaLoadReport_new(arena.ptr());
-    if (cpu_utilization_ != -1) {
+    double cpu_utilization = recorder_->cpu_utilization();
+    if (cpu_utilization >= 0) {
       xds_data_orca_v3_OrcaLoadReport_set_cpu_utilization(response,
-                                                          cpu_utilization_);
+                                                          cpu_utilization);
     }
-    if (memory_utilization_ != -1) {
+    double memory_utilization = recorder_->memory_utilization();
+    if (memory_utilization >= 0) {
       xds_data_orca_v3_OrcaLoadReport_set_mem_utilization(response,
-                                                          memory_utilization_);
+                                                          memory_utilization);
     }
-    for (const auto& p : named_utilization_) {
+    std::map<std::string, double> named_utilization =
+        recorder_->named_utilization();
+    for (const auto& p : named_utilization) {
       xds_data_orca_v3_OrcaLoadReport_utilization_set(
           response,
           upb_StringView_FromDataAndSize(p.first.data(), p.first.size()),
@@ -217,6 +216,7 @@ Slice OrcaService::GetOrCreateSerializedResponse() {
     char* buf = xds_data_orca_v3_OrcaLoadReport_serialize(response, arena.ptr(),
                                                           &buf_length);
     response_slice_.emplace(buf, buf_length);
+    response_sequence_number_ = sequence_number;
   }
   return Slice(*response_slice_);
 }
@@ -139,6 +139,28 @@ void ServerBuilder::experimental_type::SetAuthorizationPolicyProvider(
   builder_->authorization_provider_ = std::move(provider);
 }
 
+void ServerBuilder::experimental_type::SetAdaptiveConcurrencyLimit(
+    int initial_limit, const std::string& service_config_json) {
+  builder_->AddChannelArgument(GRPC_ARG_SERVER_CONCURRENCY_LIMIT,
+                               initial_limit);
+  if (!service_config_json.empty()) {
+    builder_->AddChannelArgument(GRPC_ARG_SERVICE_CONFIG, service_config_json);
+  }
+}
+
+void ServerBuilder::experimental_type::EnableCallMetricRecording() {
+  builder_->AddChannelArgument(GRPC_ARG_SERVER_CALL_METRIC_RECORDING, 1);
+}
+
+void ServerBuilder::experimental_type::EnableThreadPerCoreShards(int shards) {
+  if (shards <= 0) shards = static_cast<int>(gpr_cpu_num_cores());
+  builder_->SetSyncServerOption(NUM_CQS, shards);
+  builder_->SetSyncServerOption(MIN_POLLERS, 1);
+  builder_->SetSyncServerOption(MAX_POLLERS, 1);
+  builder_->AddChannelArgument(GRPC_ARG_TCP_SERVER_PER_CPU_LISTENERS, 1);
+  builder_->AddChannelArgument(GRPC_ARG_SYNC_SERVER_PIN_THREADS, 1);
+}
+
 ServerBuilder& ServerBuilder::SetOption(
     std::unique_ptr<ServerBuilderOption> option) {
   options_.push_back(std::move(option));
@@ -188,6 +210,12 @@ ServerBuilder& ServerBuilder::SetDefaultCompressionAlgorithm(
   return *this;
 }
 
+ServerBuilder& ServerBuilder::SetZstdCompressionDictionaries(
+    std::vector<std::string> dictionaries) {
+  zstd_compression_dictionaries_ = std::move(dictionaries);
+  return *this;
+}
+
 ServerBuilder& ServerBuilder::SetResourceQuota(
     const grpc::ResourceQuota& resource_quota) {
   if (resource_quota_ != nullptr) {
@@ -235,6 +263,9 @@ ChannelArguments ServerBuilder::BuildChannelArgs() {
     args.SetInt(GRPC_COMPRESSION_CHANNEL_DEFAULT_ALGORITHM,
                 maybe_default_compression_algorithm_.algorithm);
   }
+  if (!zstd_compression_dictionaries_.empty()) {
+    args.SetZstdCompressionDictionaries(zstd_compression_dictionaries_);
+  }
   if (resource_quota_ != nullptr) {
     args.SetPointerWithVtable(GRPC_ARG_RESOURCE_QUOTA, resource_quota_,
                               grpc_resource_quota_arg_vtable());
@@ -25,6 +25,7 @@
 #include <grpc/grpc.h>
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/generic/async_generic_service.h>
@@ -918,6 +919,20 @@ Server::Server(
         strcmp(channel_args.args[i].key, GRPC_ARG_MAX_RECEIVE_MESSAGE_LENGTH)) {
       max_receive_message_size_ = channel_args.args[i].value.integer;
     }
+    if (0 ==
+        strcmp(channel_args.args[i].key, GRPC_ARG_INLINE_CALLBACK_REACTIONS)) {
+      inline_callback_reactions_ = channel_args.args[i].value.integer;
+    }
+    if (0 == strcmp(channel_args.args[i].key,
+                    GRPC_ARG_SYNC_SERVER_PIN_THREADS) &&
+        channel_args.args[i].value.integer != 0) {
+      // Sync server CQ i is registered i-th, so it owns the pollset that
+      // per-CPU listener i hands its connections to.
+      const int num_cpus = static_cast<int>(gpr_cpu_num_cores());
+      for (size_t j = 0; j < sync_req_mgrs_.size(); j++) {
+        sync_req_mgrs_[j]->SetThreadCpu(static_cast<int>(j) % num_cpus);
+      }
+    }
   }
   server_ = grpc_server_create(&channel_args, nullptr);
   grpc_server_set_config_fetcher(server_, server_config_fetcher);
@@ -1338,6 +1353,10 @@ grpc::CompletionQueue* Server::CallbackCQ() {
     callback_cq = new grpc::CompletionQueue(grpc_completion_queue_attributes{
         GRPC_CQ_CURRENT_VERSION, GRPC_CQ_CALLBACK, GRPC_CQ_DEFAULT_POLLING,
         shutdown_callback});
+    if (inline_callback_reactions_ > 0) {
+      grpc_cq_set_inline_callbacks(callback_cq->cq(),
+                                   inline_callback_reactions_);
+    }
 
     // Transfer ownership of the new cq to its own shutdown callback
     shutdown_callback->TakeCQ(callback_cq);
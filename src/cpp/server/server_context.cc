@@ -25,6 +25,7 @@
 #include <grpc/load_reporting.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpcpp/ext/call_metric_recorder.h>
 #include <grpcpp/impl/call.h>
 #include <grpcpp/impl/codegen/completion_queue.h>
 #include <grpcpp/impl/codegen/server_context.h>
@@ -32,9 +33,13 @@
 #include <grpcpp/support/server_callback.h>
 #include <grpcpp/support/time.h>
 
+#include "src/core/ext/filters/backend_metrics/backend_metric_provider.h"
+#include "src/core/lib/channel/context.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/surface/call.h"
+#include "src/cpp/server/backend_metric_recorder.h"
 
 namespace grpc {
 
@@ -340,6 +345,12 @@ bool ServerContextBase::IsCancelled() const {
   }
 }
 
+void ServerContextBase::set_max_buffered_receive_bytes(uint32_t max_bytes) {
+  if (call_.call != nullptr) {
+    grpc_call_set_max_buffered_receive_bytes(call_.call, max_bytes);
+  }
+}
+
 void ServerContextBase::set_compression_algorithm(
     grpc_compression_algorithm algorithm) {
   compression_algorithm_ = algorithm;
@@ -368,6 +379,24 @@ const struct census_context* ServerContextBase::census_context() const {
                                : grpc_census_call_get_context(call_.call);
 }
 
+experimental::CallMetricRecorder*
+ServerContextBase::ExperimentalGetCallMetricRecorder() {
+  if (call_.call == nullptr) return nullptr;
+  if (call_metric_recorder_ == nullptr) {
+    auto* state = grpc_call_get_arena(call_.call)
+                      ->New<experimental::BackendMetricState>();
+    grpc_call_context_set(
+        call_.call, GRPC_CONTEXT_BACKEND_METRIC_PROVIDER,
+        static_cast<grpc_core::BackendMetricProvider*>(state),
+        [](void* provider) {
+          static_cast<grpc_core::BackendMetricProvider*>(provider)
+              ->~BackendMetricProvider();
+        });
+    call_metric_recorder_ = state;
+  }
+  return call_metric_recorder_;
+}
+
 void ServerContextBase::SetLoadReportingCosts(
     const std::vector<std::string>& cost_data) {
   if (call_.call == nullptr) return;
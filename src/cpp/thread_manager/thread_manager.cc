@@ -18,15 +18,35 @@
 
 #include "src/cpp/thread_manager/thread_manager.h"
 
+#include <algorithm>
 #include <climits>
 
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_sync_server_adaptive_pollers, false,
+    "If set, sync server ThreadManagers size their poller threads from the "
+    "observed load, between the configured minimum and maximum pollers, "
+    "instead of keeping the minimum and letting the maximum be reached.");
+
 namespace grpc {
 
+namespace {
+
+// The length of one observation window of the adaptive poller count.
+constexpr int kAdaptWindowMillis = 100;
+// How many windows in a row without requests waiting for a poller it takes
+// to lower the target by one.
+constexpr int kQuietWindowsToShrink = 50;
+
+}  // namespace
+
 ThreadManager::WorkerThread::WorkerThread(ThreadManager* thd_mgr)
     : thd_mgr_(thd_mgr) {
   // Make thread creation exclusive with respect to its join happening in
@@ -34,7 +54,7 @@ ThreadManager::WorkerThread::WorkerThread(ThreadManager* thd_mgr)
   thd_ = grpc_core::Thread(
       "grpcpp_sync_server",
       [](void* th) { static_cast<ThreadManager::WorkerThread*>(th)->Run(); },
-      this, &created_);
+      this, &created_, grpc_core::Thread::Options().set_cpu(thd_mgr->cpu_));
   if (!created_) {
     gpr_log(GPR_ERROR, "Could not create grpc_sync_server worker-thread");
   }
@@ -58,6 +78,15 @@ ThreadManager::ThreadManager(const char*, grpc_resource_quota* resource_quota,
       num_pollers_(0),
       min_pollers_(min_pollers),
       max_pollers_(max_pollers == -1 ? INT_MAX : max_pollers),
+      adaptive_(GPR_GLOBAL_CONFIG_GET(grpc_sync_server_adaptive_pollers)),
+      target_pollers_(min_pollers_),
+      // More pollers than cores only contend on the completion queue.
+      max_target_pollers_(std::max(
+          min_pollers_,
+          std::min(max_pollers_, static_cast<int>(gpr_cpu_num_cores())))),
+      window_start_(gpr_now(GPR_CLOCK_MONOTONIC)),
+      window_starved_(false),
+      quiet_windows_(0),
       num_threads_(0),
       max_active_threads_sofar_(0) {}
 
@@ -121,6 +150,53 @@ void ThreadManager::CleanupCompletedThreads() {
   for (auto thd : completed_threads) delete thd;
 }
 
+int ThreadManager::LowPollersLocked() const {
+  return adaptive_ ? target_pollers_ : min_pollers_;
+}
+
+int ThreadManager::HighPollersLocked() const {
+  // Twice the target leaves room for a burst to pass without threads exiting
+  // and being created again.
+  return adaptive_ ? std::min(max_pollers_, 2 * target_pollers_)
+                   : max_pollers_;
+}
+
+void ThreadManager::AdaptPollersLocked(WorkStatus work_status) {
+  if (work_status == WORK_FOUND && num_pollers_ == 0) window_starved_ = true;
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  if (gpr_time_cmp(gpr_time_sub(now, window_start_),
+                   gpr_time_from_millis(kAdaptWindowMillis, GPR_TIMESPAN)) <
+      0) {
+    return;
+  }
+  window_start_ = now;
+  bool grew = false;
+  bool shrunk = false;
+  if (window_starved_) {
+    quiet_windows_ = 0;
+    if (target_pollers_ < max_target_pollers_) {
+      target_pollers_ =
+          std::min(max_target_pollers_, std::max(1, 2 * target_pollers_));
+      grew = true;
+    }
+  } else if (++quiet_windows_ >= kQuietWindowsToShrink) {
+    quiet_windows_ = 0;
+    if (target_pollers_ > min_pollers_) {
+      --target_pollers_;
+      shrunk = true;
+    }
+  }
+  window_starved_ = false;
+  if (grew || shrunk) {
+    grpc_core::ExecCtx exec_ctx;
+    if (grew) {
+      GRPC_STATS_INC_SYNC_SERVER_POLLERS_GROWN();
+    } else {
+      GRPC_STATS_INC_SYNC_SERVER_POLLERS_SHRUNK();
+    }
+  }
+}
+
 void ThreadManager::Initialize() {
   if (!thread_quota_->Reserve(min_pollers_)) {
     gpr_log(GPR_ERROR,
@@ -153,12 +229,13 @@ void ThreadManager::MainWorkLoop() {
     grpc_core::LockableAndReleasableMutexLock lock(&mu_);
     // Reduce the number of pollers by 1 and check what happened with the poll
     num_pollers_--;
+    if (adaptive_) AdaptPollersLocked(work_status);
     bool done = false;
     switch (work_status) {
       case TIMEOUT:
         // If we timed out and we have more pollers than we need (or we are
         // shutdown), finish this thread
-        if (shutdown_ || num_pollers_ > max_pollers_) done = true;
+        if (shutdown_ || num_pollers_ > HighPollersLocked()) done = true;
         break;
       case SHUTDOWN:
         // If the thread manager is shutdown, finish this thread
@@ -168,7 +245,7 @@ void ThreadManager::MainWorkLoop() {
         // If we got work and there are now insufficient pollers and there is
         // quota available to create a new thread, start a new poller thread
         bool resource_exhausted = false;
-        if (!shutdown_ && num_pollers_ < min_pollers_) {
+        if (!shutdown_ && num_pollers_ < LowPollersLocked()) {
           if (thread_quota_->Reserve(1)) {
             // We can allocate a new poller thread
             num_pollers_++;
@@ -192,7 +269,7 @@ void ThreadManager::MainWorkLoop() {
           } else if (num_pollers_ > 0) {
             // There is still at least some thread polling, so we can go on
             // even though we are below the number of pollers that we would
-            // like to have (min_pollers_)
+            // like to have (min_pollers_, or the adaptive target)
             lock.Release();
           } else {
             // There are no pollers to spare and we couldn't allocate
@@ -245,7 +322,7 @@ void ThreadManager::MainWorkLoop() {
     // pollset mutex) that makes DoWork() take longer to finish thereby causing
     // new poller threads to be created even faster. This results in a thread
     // avalanche.
-    if (num_pollers_ < max_pollers_) {
+    if (num_pollers_ < HighPollersLocked()) {
       num_pollers_++;
     } else {
       break;
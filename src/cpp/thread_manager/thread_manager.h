@@ -23,6 +23,7 @@
 #include <memory>
 
 #include <grpc/grpc.h>
+#include <grpc/support/time.h>
 #include <grpcpp/support/config.h>
 
 #include "src/core/lib/gprpp/sync.h"
@@ -40,6 +41,10 @@ class ThreadManager {
   // Initializes and Starts the Rpc Manager threads
   void Initialize();
 
+  // Pins the threads created from now on to CPU \a cpu (Linux only). Must be
+  // called before Initialize().
+  void SetThreadCpu(int cpu) { cpu_ = cpu; }
+
   // The return type of PollForWork() function
   enum WorkStatus { WORK_FOUND, SHUTDOWN, TIMEOUT };
 
@@ -142,6 +147,19 @@ class ThreadManager {
   void MarkAsCompleted(WorkerThread* thd);
   void CleanupCompletedThreads();
 
+  // The number of pollers below which a thread that found work starts a new
+  // poller, and the number above which a poller thread exits. These are
+  // min_pollers_ and max_pollers_ unless the poller count is adaptive.
+  int LowPollersLocked() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  int HighPollersLocked() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Called with each PollForWork() result when the poller count is adaptive.
+  // Work found while no other thread was polling means that requests waited
+  // for a thread: the target grows right away. It shrinks by one only after
+  // a run of windows without such waits.
+  void AdaptPollersLocked(WorkStatus work_status)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   // Protects shutdown_, num_pollers_, num_threads_ and
   // max_active_threads_sofar_
   grpc_core::Mutex mu_;
@@ -164,6 +182,17 @@ class ThreadManager {
   int min_pollers_;
   int max_pollers_;
 
+  // Whether the number of pollers follows the load between min_pollers_ and
+  // max_pollers_ (GRPC_SYNC_SERVER_ADAPTIVE_POLLERS).
+  const bool adaptive_;
+  // The number of pollers wanted right now, and what the current observation
+  // window has seen so far. Only used when adaptive_.
+  int target_pollers_;
+  int max_target_pollers_;
+  gpr_timespec window_start_;
+  bool window_starved_;
+  int quiet_windows_;
+
   // The total number of threads currently active (includes threads includes the
   // threads that are currently polling i.e num_pollers_)
   int num_threads_;
@@ -175,6 +204,9 @@ class ThreadManager {
 
   grpc_core::Mutex list_mu_;
   std::list<WorkerThread*> completed_threads_;
+
+  // The CPU to pin threads to, or -1. See SetThreadCpu().
+  int cpu_ = -1;
 };
 
 }  // namespace grpc
@@ -87,4 +87,17 @@ void ProtoToCoreStats(const grpc::core::Stats& proto, grpc_stats_data* core) {
   }
 }
 
+CoreStatsSnapshot CoreStatsSnapshot::Now() {
+  CoreStatsSnapshot snapshot;
+  grpc_stats_collect(&snapshot.data_);
+  return snapshot;
+}
+
+CoreStatsSnapshot CoreStatsSnapshot::Since(
+    const CoreStatsSnapshot& earlier) const {
+  CoreStatsSnapshot delta;
+  grpc_stats_diff(&data_, &earlier.data_, &delta.data_);
+  return delta;
+}
+
 }  // namespace grpc
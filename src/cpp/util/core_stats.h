@@ -19,6 +19,8 @@
 #ifndef GRPC_INTERNAL_CPP_UTIL_CORE_STATS_H
 #define GRPC_INTERNAL_CPP_UTIL_CORE_STATS_H
 
+#include <string.h>
+
 #include "src/core/lib/debug/stats.h"
 #include "src/proto/grpc/core/stats.pb.h"
 
@@ -27,6 +29,25 @@ namespace grpc {
 void CoreStatsToProto(const grpc_stats_data& core, grpc::core::Stats* proto);
 void ProtoToCoreStats(const grpc::core::Stats& proto, grpc_stats_data* core);
 
+// A copy of the process-wide core stats, so that what happened over an
+// interval (eg. a benchmark run after its warmup) can be reported on its own.
+// Default-constructed snapshots are all zero.
+class CoreStatsSnapshot {
+ public:
+  CoreStatsSnapshot() { memset(&data_, 0, sizeof(data_)); }
+
+  // Collects the stats accumulated since the process started.
+  static CoreStatsSnapshot Now();
+
+  // Returns the stats accumulated between \a earlier and this snapshot.
+  CoreStatsSnapshot Since(const CoreStatsSnapshot& earlier) const;
+
+  const grpc_stats_data& data() const { return data_; }
+
+ private:
+  grpc_stats_data data_;
+};
+
 }  // namespace grpc
 
 #endif  // GRPC_INTERNAL_CPP_UTIL_CORE_STATS_H
@@ -71,6 +71,21 @@ TEST(ChannelArgsTest, SetGetRemove) {
   gpr_free(ptr);
 }
 
+TEST(ChannelArgsTest, EqualityAndHash) {
+  ChannelArgs a = ChannelArgs().Set("answer", 42).Set("foo", "bar");
+  ChannelArgs b = ChannelArgs().Set("foo", "bar").Set("answer", 42);
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(a.Hash(), b.Hash());
+  EXPECT_EQ(a, a.Set("foo", "bar"));
+  EXPECT_NE(a, a.Set("foo", "baz"));
+  EXPECT_NE(a, a.Remove("foo"));
+  EXPECT_EQ(a.Set("x", 1).Remove("x"), a);
+  EXPECT_EQ(a.Set("x", 1).Remove("x").Hash(), a.Hash());
+  EXPECT_EQ(a.Remove("absent").Hash(), a.Hash());
+  EXPECT_EQ(ChannelArgs().Hash(),
+            a.Remove("answer").Remove("foo").Hash());
+}
+
 TEST(ChannelArgsTest, StoreRefCountedPtr) {
   struct Test : public RefCounted<Test> {
     explicit Test(int n) : n(n) {}
@@ -120,6 +120,36 @@ TEST(ChannelStackBuilder, UnknownTarget) {
   EXPECT_EQ(builder.target(), "unknown");
 }
 
+TEST(ChannelStackBuilder, CreateStackCachedRunsStagesOncePerArgs) {
+  static int stage_runs;
+  stage_runs = 0;
+  ChannelInit::Builder init_builder;
+  init_builder.RegisterStage(
+      GRPC_CLIENT_SUBCHANNEL, INT_MAX, [](ChannelStackBuilder* builder) {
+        ++stage_runs;
+        if (builder->channel_args().GetBool("test.add").value_or(false)) {
+          builder->PrependFilter(&original_filter);
+        }
+        return true;
+      });
+  ChannelInit channel_init = init_builder.Build();
+  auto create_stack = [&channel_init](const ChannelArgs& args,
+                                      absl::string_view transport_name) {
+    ChannelStackBuilderImpl builder("subchannel", GRPC_CLIENT_SUBCHANNEL);
+    builder.SetChannelArgs(args);
+    EXPECT_TRUE(channel_init.CreateStackCached(&builder, transport_name));
+    return *builder.mutable_stack();
+  };
+  const ChannelArgs add = ChannelArgs().Set("test.add", true);
+  EXPECT_EQ(create_stack(add, "chttp2").size(), 1);
+  EXPECT_EQ(create_stack(add, "chttp2").size(), 1);
+  EXPECT_EQ(stage_runs, 1);
+  // Other args or transports get their own filter lists.
+  EXPECT_EQ(create_stack(ChannelArgs(), "chttp2").size(), 0);
+  EXPECT_EQ(create_stack(add, "inproc").size(), 1);
+  EXPECT_EQ(stage_runs, 3);
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc_core
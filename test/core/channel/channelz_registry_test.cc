@@ -21,6 +21,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <grpc/grpc.h>
@@ -137,6 +139,48 @@ TEST_F(ChannelzRegistryTest, TestUnregistration) {
   }
 }
 
+TEST_F(ChannelzRegistryTest, ServersArePaginatedInUuidOrder) {
+  ExecCtx exec_ctx;
+  std::vector<RefCountedPtr<BaseNode>> nodes;
+  for (int i = 0; i < 150; i++) {
+    nodes.push_back(MakeRefCounted<ServerNode>(0));
+    nodes.push_back(CreateTestNode());
+  }
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  Json json = Json::Parse(ChannelzRegistry::GetServers(0), &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE);
+  EXPECT_EQ(json.object_value().count("end"), 0);
+  const Json::Array& servers = json.object_value().at("server").array_value();
+  ASSERT_EQ(servers.size(), 100);
+  for (size_t i = 0; i < servers.size(); ++i) {
+    EXPECT_EQ(servers[i]
+                  .object_value()
+                  .at("ref")
+                  .object_value()
+                  .at("serverId")
+                  .string_value(),
+              std::to_string(nodes[2 * i]->uuid()));
+  }
+  json = Json::Parse(ChannelzRegistry::GetServers(nodes[200]->uuid()), &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE);
+  EXPECT_EQ(json.object_value().count("end"), 1);
+  EXPECT_EQ(json.object_value().at("server").array_value().size(), 50);
+}
+
+TEST_F(ChannelzRegistryTest, ConcurrentRegistration) {
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([] {
+      for (int i = 0; i < 1000; ++i) {
+        RefCountedPtr<BaseNode> node = CreateTestNode();
+        EXPECT_EQ(ChannelzRegistry::Get(node->uuid()), node);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_TRUE(ChannelzRegistry::GetCallCountingNodes().empty());
+}
+
 }  // namespace testing
 }  // namespace channelz
 }  // namespace grpc_core
@@ -531,6 +531,34 @@ TEST(ChannelzServerTest, BasicServerAPIFunctionality) {
   ValidateServer(channelz_server, {3, 3, 3});
 }
 
+class FakeTransportStats : public SocketNode::TransportStats {
+ public:
+  void PopulateOptions(Json::Array* options) override {
+    options->push_back(Json::Object{{"name", "fake.frames_sent"},
+                                    {"value", std::to_string(frames_sent)}});
+  }
+
+  int frames_sent = 0;
+};
+
+TEST(ChannelzSocketTest, TransportStatsRenderedAsOptions) {
+  ExecCtx exec_ctx;
+  auto stats = MakeRefCounted<FakeTransportStats>();
+  auto socket = MakeRefCounted<SocketNode>("ipv4:127.0.0.1:1",
+                                           "ipv4:127.0.0.1:2", "test socket",
+                                           nullptr, stats);
+  stats->frames_sent = 3;
+  Json json = socket->RenderJson();
+  const Json::Object& data =
+      json.object_value().find("data")->second.object_value();
+  auto it = data.find("option");
+  ASSERT_NE(it, data.end());
+  ASSERT_EQ(it->second.array_value().size(), 1);
+  const Json::Object& option = it->second.array_value()[0].object_value();
+  EXPECT_EQ(option.find("name")->second.string_value(), "fake.frames_sent");
+  EXPECT_EQ(option.find("value")->second.string_value(), "3");
+}
+
 TEST_F(ChannelzRegistryBasedTest, BasicGetServersTest) {
   ExecCtx exec_ctx;
   ServerFixture server;
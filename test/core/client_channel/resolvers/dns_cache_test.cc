@@ -0,0 +1,147 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/resolver/dns_cache.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+class DnsCacheTest : public ::testing::Test {
+ protected:
+  // A lookup that is completed by the test, through on_dones_.
+  class FakeLookup : public Orphanable {
+   public:
+    explicit FakeLookup(int* orphaned) : orphaned_(orphaned) {}
+    void Orphan() override {
+      ++*orphaned_;
+      delete this;
+    }
+
+   private:
+    int* orphaned_;
+  };
+
+  DnsCacheTest() : cache_(MakeOptions()) {}
+
+  DnsCache<int>::Options MakeOptions() {
+    DnsCache<int>::Options options;
+    options.now = [this]() { return now_; };
+    return options;
+  }
+
+  absl::optional<int> Lookup(const std::string& key, intptr_t* waiter_id) {
+    return cache_.Lookup(
+        key,
+        [this](DnsCache<int>::OnLookupDone on_done) {
+          on_dones_.push_back(std::move(on_done));
+          return OrphanablePtr<Orphanable>(new FakeLookup(&orphaned_));
+        },
+        [this](absl::StatusOr<int> result) { results_.push_back(result); },
+        waiter_id);
+  }
+
+  absl::optional<int> Lookup(const std::string& key) {
+    intptr_t waiter_id;
+    return Lookup(key, &waiter_id);
+  }
+
+  Timestamp now_ = Timestamp::FromMillisecondsAfterProcessEpoch(1000000);
+  DnsCache<int> cache_;
+  std::vector<DnsCache<int>::OnLookupDone> on_dones_;
+  std::vector<absl::StatusOr<int>> results_;
+  int orphaned_ = 0;
+};
+
+TEST_F(DnsCacheTest, MergesConcurrentLookups) {
+  EXPECT_FALSE(Lookup("a").has_value());
+  EXPECT_FALSE(Lookup("a").has_value());
+  EXPECT_FALSE(Lookup("b").has_value());
+  ASSERT_EQ(on_dones_.size(), 2u);
+  on_dones_[0](42, Duration::Seconds(10));
+  ASSERT_EQ(results_.size(), 2u);
+  EXPECT_EQ(*results_[0], 42);
+  EXPECT_EQ(*results_[1], 42);
+  EXPECT_EQ(orphaned_, 1);
+}
+
+TEST_F(DnsCacheTest, CachesForTtl) {
+  Lookup("a");
+  on_dones_[0](42, Duration::Seconds(10));
+  now_ += Duration::Seconds(5);
+  EXPECT_EQ(Lookup("a"), 42);
+  EXPECT_EQ(on_dones_.size(), 1u);
+  now_ += Duration::Seconds(5);
+  EXPECT_FALSE(Lookup("a").has_value());
+  EXPECT_EQ(on_dones_.size(), 2u);
+}
+
+TEST_F(DnsCacheTest, PrefetchesBeforeExpiry) {
+  Lookup("a");
+  on_dones_[0](42, Duration::Seconds(10));
+  now_ += Duration::Milliseconds(9500);
+  EXPECT_EQ(Lookup("a"), 42);
+  ASSERT_EQ(on_dones_.size(), 2u);
+  // Only one refresh at a time.
+  EXPECT_EQ(Lookup("a"), 42);
+  EXPECT_EQ(on_dones_.size(), 2u);
+  on_dones_[1](43, Duration::Seconds(10));
+  now_ += Duration::Seconds(5);
+  EXPECT_EQ(Lookup("a"), 43);
+  EXPECT_EQ(results_.size(), 1u);
+}
+
+TEST_F(DnsCacheTest, DoesNotCacheFailuresOrZeroTtls) {
+  Lookup("a");
+  on_dones_[0](absl::UnavailableError("oops"), Duration::Seconds(10));
+  ASSERT_EQ(results_.size(), 1u);
+  EXPECT_FALSE(results_[0].ok());
+  EXPECT_FALSE(Lookup("a").has_value());
+  on_dones_[1](42, Duration::Zero());
+  EXPECT_FALSE(Lookup("a").has_value());
+  EXPECT_EQ(on_dones_.size(), 3u);
+}
+
+TEST_F(DnsCacheTest, CancelsLookupWithoutWaiters) {
+  intptr_t first;
+  intptr_t second;
+  Lookup("a", &first);
+  Lookup("a", &second);
+  EXPECT_TRUE(cache_.Cancel("a", first));
+  EXPECT_EQ(orphaned_, 0);
+  EXPECT_TRUE(cache_.Cancel("a", second));
+  EXPECT_EQ(orphaned_, 1);
+  EXPECT_FALSE(cache_.Cancel("a", second));
+  // A late result is dropped.
+  on_dones_[0](42, Duration::Seconds(10));
+  EXPECT_TRUE(results_.empty());
+  EXPECT_EQ(cache_.size(), 0u);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
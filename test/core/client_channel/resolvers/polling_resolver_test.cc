@@ -0,0 +1,258 @@
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/filters/client_channel/resolver/polling_resolver.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/memory/memory.h"
+#include "absl/synchronization/notification.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/backoff/backoff.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/work_serializer.h"
+#include "src/core/lib/uri/uri_parser.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Interval between retries of failed resolutions.
+constexpr Duration kRetryInterval = Duration::Milliseconds(100);
+
+Timestamp MonotonicNow() {
+  return Timestamp::FromTimespecRoundDown(gpr_now(GPR_CLOCK_MONOTONIC));
+}
+
+class PollingResolverTest : public ::testing::Test {
+ protected:
+  struct ReportedResult {
+    bool ok;
+    Timestamp at;
+    // Requests started by the time the result was reported.
+    int num_requests;
+  };
+
+  // Resolves to an empty address list, or fails while fail_ is set.
+  class TestResolver : public PollingResolver {
+   public:
+    TestResolver(ResolverArgs args, const grpc_channel_args* channel_args,
+                 PollingResolverTest* test)
+        : PollingResolver(std::move(args), channel_args, Duration::Zero(),
+                          BackOff::Options()
+                              .set_initial_backoff(kRetryInterval)
+                              .set_multiplier(1)
+                              .set_jitter(0)
+                              .set_max_backoff(kRetryInterval),
+                          nullptr),
+          test_(test) {}
+
+   private:
+    class Request : public Orphanable {
+     public:
+      void Orphan() override { delete this; }
+    };
+
+    OrphanablePtr<Orphanable> StartRequest() override {
+      const bool fail = test_->fail_.load();
+      test_->OnRequestStarted(fail);
+      Result result;
+      if (fail) {
+        result.addresses = absl::UnavailableError("resolution failed");
+      } else {
+        result.addresses = ServerAddressList();
+      }
+      OnRequestComplete(std::move(result));
+      return MakeOrphanable<Request>();
+    }
+
+    PollingResolverTest* test_;
+  };
+
+  class ResultHandler : public Resolver::ResultHandler {
+   public:
+    explicit ResultHandler(PollingResolverTest* test) : test_(test) {}
+
+    void ReportResult(Resolver::Result result) override {
+      test_->OnResult(result.addresses.ok() && result.service_config.ok());
+    }
+
+   private:
+    PollingResolverTest* test_;
+  };
+
+  void TearDown() override {
+    absl::Notification shutdown;
+    {
+      ExecCtx exec_ctx;
+      work_serializer_->Run(
+          [this, &shutdown]() {
+            resolver_.reset();
+            shutdown.Notify();
+          },
+          DEBUG_LOCATION);
+    }
+    shutdown.WaitForNotification();
+  }
+
+  void StartResolver(int max_stale_result_ms) {
+    ExecCtx exec_ctx;
+    ResolverArgs args;
+    args.uri = *URI::Parse("test:///server.example.com");
+    args.work_serializer = work_serializer_;
+    args.result_handler = absl::make_unique<ResultHandler>(this);
+    grpc_arg arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_RESOLVER_MAX_STALE_RESULT_MS),
+        max_stale_result_ms);
+    grpc_channel_args channel_args = {1, &arg};
+    resolver_ =
+        MakeOrphanable<TestResolver>(std::move(args), &channel_args, this);
+    work_serializer_->Run([this]() { resolver_->StartLocked(); },
+                          DEBUG_LOCATION);
+  }
+
+  void RequestReresolution() {
+    ExecCtx exec_ctx;
+    work_serializer_->Run([this]() { resolver_->RequestReresolutionLocked(); },
+                          DEBUG_LOCATION);
+  }
+
+  // Waits until at least count results were reported, and returns them.
+  std::vector<ReportedResult> WaitForResults(size_t count) {
+    MutexLock lock(&mu_);
+    while (results_.size() < count) {
+      if (cv_.WaitWithTimeout(&mu_, absl::Seconds(10))) break;
+    }
+    return results_;
+  }
+
+  // Waits until at least count requests were started.
+  void WaitForRequests(int count) {
+    MutexLock lock(&mu_);
+    while (num_requests_ < count) {
+      if (cv_.WaitWithTimeout(&mu_, absl::Seconds(10))) break;
+    }
+    ASSERT_GE(num_requests_, count);
+  }
+
+  std::vector<ReportedResult> results() {
+    MutexLock lock(&mu_);
+    return results_;
+  }
+
+  Timestamp first_failed_request_at() {
+    MutexLock lock(&mu_);
+    return first_failed_request_at_;
+  }
+
+  std::atomic<bool> fail_{false};
+
+ private:
+  void OnRequestStarted(bool fail) {
+    MutexLock lock(&mu_);
+    ++num_requests_;
+    if (fail && first_failed_request_at_ == Timestamp()) {
+      first_failed_request_at_ = MonotonicNow();
+    }
+    cv_.SignalAll();
+  }
+
+  void OnResult(bool ok) {
+    MutexLock lock(&mu_);
+    results_.push_back({ok, MonotonicNow(), num_requests_});
+    cv_.SignalAll();
+  }
+
+  std::shared_ptr<WorkSerializer> work_serializer_ =
+      std::make_shared<WorkSerializer>();
+  OrphanablePtr<Resolver> resolver_;
+  Mutex mu_;
+  CondVar cv_;
+  int num_requests_ ABSL_GUARDED_BY(mu_) = 0;
+  Timestamp first_failed_request_at_ ABSL_GUARDED_BY(mu_);
+  std::vector<ReportedResult> results_ ABSL_GUARDED_BY(mu_);
+};
+
+TEST_F(PollingResolverTest, FailureWithoutGoodResultIsReported) {
+  fail_ = true;
+  StartResolver(/*max_stale_result_ms=*/10000);
+  std::vector<ReportedResult> results = WaitForResults(1);
+  ASSERT_EQ(results.size(), 1u);
+  EXPECT_FALSE(results[0].ok);
+}
+
+TEST_F(PollingResolverTest, FailureSuppressedWithinWindow) {
+  StartResolver(/*max_stale_result_ms=*/10000);
+  ASSERT_EQ(WaitForResults(1).size(), 1u);
+  fail_ = true;
+  RequestReresolution();
+  // The re-resolution and two retries fail, with the last good result
+  // still being served.
+  WaitForRequests(4);
+  std::vector<ReportedResult> results = this->results();
+  ASSERT_EQ(results.size(), 1u);
+  EXPECT_TRUE(results[0].ok);
+  // The next retry that succeeds is reported.
+  fail_ = false;
+  results = WaitForResults(2);
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_TRUE(results[1].ok);
+}
+
+TEST_F(PollingResolverTest, FailureReportedAfterWindow) {
+  const Duration window = Duration::Milliseconds(500);
+  StartResolver(window.millis());
+  ASSERT_EQ(WaitForResults(1).size(), 1u);
+  fail_ = true;
+  RequestReresolution();
+  std::vector<ReportedResult> results = WaitForResults(2);
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_FALSE(results[1].ok);
+  EXPECT_GE(results[1].at - first_failed_request_at(), window);
+}
+
+TEST_F(PollingResolverTest, FailureReportedImmediatelyWithZeroWindow) {
+  StartResolver(/*max_stale_result_ms=*/0);
+  ASSERT_EQ(WaitForResults(1).size(), 1u);
+  fail_ = true;
+  RequestReresolution();
+  std::vector<ReportedResult> results = WaitForResults(2);
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_FALSE(results[1].ok);
+  // Reported by the re-resolution itself rather than by a retry.
+  EXPECT_EQ(results[1].num_requests, 2);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
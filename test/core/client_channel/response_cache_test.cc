@@ -0,0 +1,186 @@
+//
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/filters/client_channel/response_cache_filter.h"
+
+#include <gtest/gtest.h>
+
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace internal {
+namespace {
+
+const Timestamp kNow = Timestamp::FromMillisecondsAfterProcessEpoch(1000);
+const Timestamp kLater = kNow + Duration::Seconds(10);
+
+class ResponseCacheTest : public ::testing::Test {
+ protected:
+  RefCountedPtr<ResponseCache> MakeCache(size_t max_bytes) {
+    return MakeRefCounted<ResponseCache>(
+        max_bytes, memory_quota_.CreateMemoryOwner(
+                       "test", MemoryCategory::kResponseCache));
+  }
+
+  size_t quota_usage() {
+    return memory_quota_.GetUsage()[static_cast<size_t>(
+        MemoryCategory::kResponseCache)];
+  }
+
+  MemoryQuota memory_quota_{"response_cache_test"};
+};
+
+TEST_F(ResponseCacheTest, HitUntilExpiry) {
+  auto cache = MakeCache(4096);
+  EXPECT_FALSE(cache->Lookup("key", kNow).has_value());
+  cache->Insert("key", Slice::FromCopiedString("response"), kLater);
+  absl::optional<Slice> response = cache->Lookup("key", kNow);
+  ASSERT_TRUE(response.has_value());
+  EXPECT_EQ(response->as_string_view(), "response");
+  EXPECT_FALSE(cache->Lookup("key", kLater).has_value());
+  // The expired entry is dropped on lookup.
+  EXPECT_EQ(cache->size_bytes(), 0);
+}
+
+TEST_F(ResponseCacheTest, EvictsLeastRecentlyUsed) {
+  const std::string response(600, 'r');
+  // Room for two entries only.
+  auto cache = MakeCache(2 * (response.size() + 200));
+  cache->Insert("a", Slice::FromCopiedString(response), kLater);
+  cache->Insert("b", Slice::FromCopiedString(response), kLater);
+  EXPECT_TRUE(cache->Lookup("a", kNow).has_value());
+  cache->Insert("c", Slice::FromCopiedString(response), kLater);
+  EXPECT_TRUE(cache->Lookup("a", kNow).has_value());
+  EXPECT_FALSE(cache->Lookup("b", kNow).has_value());
+  EXPECT_TRUE(cache->Lookup("c", kNow).has_value());
+}
+
+TEST_F(ResponseCacheTest, SkipsResponsesLargerThanTheBudget) {
+  auto cache = MakeCache(1024);
+  cache->Insert("key", Slice::FromCopiedString(std::string(2048, 'r')),
+                kLater);
+  EXPECT_FALSE(cache->Lookup("key", kNow).has_value());
+  EXPECT_EQ(cache->size_bytes(), 0);
+}
+
+TEST_F(ResponseCacheTest, ReservesFromTheQuota) {
+  auto cache = MakeCache(1 << 20);
+  const size_t before = quota_usage();
+  cache->Insert("key", Slice::FromCopiedString(std::string(4096, 'r')),
+                kLater);
+  EXPECT_GE(quota_usage(), before + 4096);
+  EXPECT_EQ(cache->size_bytes(), quota_usage() - before);
+  cache->Clear();
+  EXPECT_EQ(cache->size_bytes(), 0);
+  EXPECT_EQ(quota_usage(), before);
+}
+
+TEST(ParseCacheControlTest, Directives) {
+  CacheControl cache_control = ParseCacheControl("max-age=30");
+  EXPECT_FALSE(cache_control.no_store);
+  EXPECT_EQ(cache_control.max_age, Duration::Seconds(30));
+  cache_control = ParseCacheControl("private, Max-Age=5 ,no-transform");
+  EXPECT_FALSE(cache_control.no_store);
+  EXPECT_EQ(cache_control.max_age, Duration::Seconds(5));
+  EXPECT_TRUE(ParseCacheControl("no-store").no_store);
+  EXPECT_TRUE(ParseCacheControl("max-age=10, no-cache").no_store);
+  EXPECT_FALSE(ParseCacheControl("max-age=-1").max_age.has_value());
+  EXPECT_FALSE(ParseCacheControl("max-age=soon").max_age.has_value());
+  EXPECT_FALSE(ParseCacheControl("").max_age.has_value());
+}
+
+class TestFollower : public CallCoalescer::Follower {
+ public:
+  void OnLeaderFinished(absl::optional<Slice> response) override {
+    finished_ = true;
+    response_ = std::move(response);
+  }
+
+  bool finished() const { return finished_; }
+  const absl::optional<Slice>& response() const { return response_; }
+
+ private:
+  bool finished_ = false;
+  absl::optional<Slice> response_;
+};
+
+TEST(CallCoalescerTest, FollowersGetTheLeadersResponse) {
+  CallCoalescer coalescer;
+  TestFollower followers[3];
+  EXPECT_EQ(coalescer.Join("key", 2, nullptr),
+            CallCoalescer::JoinResult::kLeader);
+  EXPECT_EQ(coalescer.Join("key", 2, &followers[0]),
+            CallCoalescer::JoinResult::kFollower);
+  EXPECT_EQ(coalescer.Join("key", 2, &followers[1]),
+            CallCoalescer::JoinResult::kFollower);
+  EXPECT_EQ(coalescer.Join("key", 2, &followers[2]),
+            CallCoalescer::JoinResult::kFull);
+  coalescer.Finish("key", Slice::FromCopiedString("response"));
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_TRUE(followers[i].finished());
+    ASSERT_TRUE(followers[i].response().has_value());
+    EXPECT_EQ(followers[i].response()->as_string_view(), "response");
+  }
+  EXPECT_FALSE(followers[2].finished());
+  // The next call with the key leads again.
+  EXPECT_EQ(coalescer.Join("key", 2, nullptr),
+            CallCoalescer::JoinResult::kLeader);
+}
+
+TEST(CallCoalescerTest, KeysAreCoalescedSeparately) {
+  CallCoalescer coalescer;
+  TestFollower follower;
+  EXPECT_EQ(coalescer.Join("a", 1, nullptr),
+            CallCoalescer::JoinResult::kLeader);
+  EXPECT_EQ(coalescer.Join("b", 1, nullptr),
+            CallCoalescer::JoinResult::kLeader);
+  EXPECT_EQ(coalescer.Join("a", 1, &follower),
+            CallCoalescer::JoinResult::kFollower);
+  coalescer.Finish("b", absl::nullopt);
+  EXPECT_FALSE(follower.finished());
+  coalescer.Finish("a", absl::nullopt);
+  EXPECT_TRUE(follower.finished());
+  EXPECT_FALSE(follower.response().has_value());
+}
+
+TEST(CallCoalescerTest, FollowersCanLeave) {
+  CallCoalescer coalescer;
+  TestFollower followers[2];
+  EXPECT_EQ(coalescer.Join("key", 1, nullptr),
+            CallCoalescer::JoinResult::kLeader);
+  EXPECT_EQ(coalescer.Join("key", 1, &followers[0]),
+            CallCoalescer::JoinResult::kFollower);
+  EXPECT_TRUE(coalescer.Leave("key", &followers[0]));
+  // Leaving makes room for another follower.
+  EXPECT_EQ(coalescer.Join("key", 1, &followers[1]),
+            CallCoalescer::JoinResult::kFollower);
+  coalescer.Finish("key", Slice::FromCopiedString("response"));
+  EXPECT_FALSE(followers[0].finished());
+  EXPECT_TRUE(followers[1].finished());
+  // Too late to leave once the leader has finished.
+  EXPECT_FALSE(coalescer.Leave("key", &followers[1]));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
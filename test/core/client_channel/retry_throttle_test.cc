@@ -65,6 +65,25 @@ TEST(ServerRetryThrottleData, Basic) {
   EXPECT_TRUE(throttle_data->RecordFailure());
 }
 
+TEST(ServerRetryThrottleData, IsThrottled) {
+  // Max token count is 4, so threshold for retrying is 2.
+  // Token count starts at 4.
+  // Each failure decrements by 1.  Each success increments by 1.
+  auto throttle_data =
+      MakeRefCounted<ServerRetryThrottleData>(4000, 1000, nullptr);
+  EXPECT_FALSE(throttle_data->IsThrottled());
+  // Failure: token_count=3.  Above threshold.
+  EXPECT_TRUE(throttle_data->RecordFailure());
+  EXPECT_FALSE(throttle_data->IsThrottled());
+  // Failure: token_count=2.  At threshold, so throttled.
+  EXPECT_FALSE(throttle_data->RecordFailure());
+  EXPECT_TRUE(throttle_data->IsThrottled());
+  // Success: token_count=3.  Checking does not consume tokens.
+  throttle_data->RecordSuccess();
+  EXPECT_FALSE(throttle_data->IsThrottled());
+  EXPECT_FALSE(throttle_data->IsThrottled());
+}
+
 TEST(ServerRetryThrottleData, Replacement) {
   // Create old throttle data.
   // Max token count is 4, so threshold for retrying is 2.
@@ -128,6 +147,73 @@ TEST(ServerRetryThrottleMap, Replacement) {
   EXPECT_FALSE(throttle_data->RecordFailure());
 }
 
+TEST(ServerAdaptiveThrottleData, Basic) {
+  auto throttle_data =
+      MakeRefCounted<ServerAdaptiveThrottleData>(2, Duration::Seconds(10));
+  Timestamp now = Timestamp::FromMillisecondsAfterProcessEpoch(100000);
+  // Nothing is rejected while backends accept every call.
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_FALSE(throttle_data->ShouldThrottle(now));
+    throttle_data->RecordResult(true, now);
+  }
+  EXPECT_EQ(throttle_data->RejectProbability(now), 0);
+  // Refused calls are fine until they exceed half of the calls.
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_FALSE(throttle_data->ShouldThrottle(now));
+    throttle_data->RecordResult(false, now);
+  }
+  EXPECT_EQ(throttle_data->RejectProbability(now), 0);
+  // requests=30, accepts=10.  Calls rejected locally count as requests.
+  for (int i = 0; i < 10; ++i) {
+    if (!throttle_data->ShouldThrottle(now)) {
+      throttle_data->RecordResult(false, now);
+    }
+  }
+  EXPECT_DOUBLE_EQ(throttle_data->RejectProbability(now), 10.0 / 31);
+  // The counts expire with the window.
+  now += Duration::Seconds(10);
+  EXPECT_EQ(throttle_data->RejectProbability(now), 0);
+}
+
+TEST(ServerAdaptiveThrottleData, SlidingWindow) {
+  auto throttle_data =
+      MakeRefCounted<ServerAdaptiveThrottleData>(1, Duration::Seconds(10));
+  Timestamp now = Timestamp::FromMillisecondsAfterProcessEpoch(100000);
+  // Refused calls in the first second of the window.
+  for (int i = 0; i < 4; ++i) {
+    throttle_data->ShouldThrottle(now);
+    throttle_data->RecordResult(false, now);
+  }
+  // Accepted calls five seconds later.
+  Timestamp later = now + Duration::Seconds(5);
+  for (int i = 0; i < 2; ++i) {
+    throttle_data->ShouldThrottle(later);
+    throttle_data->RecordResult(true, later);
+  }
+  // requests=6, accepts=2.
+  EXPECT_DOUBLE_EQ(throttle_data->RejectProbability(later), 4.0 / 7);
+  // Only the accepted calls remain in the window.
+  EXPECT_EQ(throttle_data->RejectProbability(now + Duration::Seconds(10)), 0);
+  EXPECT_EQ(throttle_data->RejectProbability(now + Duration::Seconds(15)), 0);
+}
+
+TEST(ServerAdaptiveThrottleMap, Replacement) {
+  const std::string kServerName = "adaptive_server_name";
+  auto throttle_data = ServerAdaptiveThrottleMap::Get()->GetDataForServer(
+      kServerName, 2, Duration::Minutes(2));
+  // Same parameters share the same data.
+  EXPECT_EQ(throttle_data, ServerAdaptiveThrottleMap::Get()->GetDataForServer(
+                               kServerName, 2, Duration::Minutes(2)));
+  // New parameters replace it.
+  auto new_throttle_data = ServerAdaptiveThrottleMap::Get()->GetDataForServer(
+      kServerName, 1.5, Duration::Minutes(2));
+  EXPECT_NE(throttle_data, new_throttle_data);
+  EXPECT_EQ(new_throttle_data->accepts_multiplier(), 1.5);
+  EXPECT_EQ(new_throttle_data,
+            ServerAdaptiveThrottleMap::Get()->GetDataForServer(
+                kServerName, 1.5, Duration::Minutes(2)));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace grpc_core
@@ -25,7 +25,9 @@
 
 #include <grpc/grpc.h>
 
+#include "src/core/ext/filters/client_channel/adaptive_throttle_filter.h"
 #include "src/core/ext/filters/client_channel/resolver_result_parsing.h"
+#include "src/core/ext/filters/client_channel/response_cache_filter.h"
 #include "src/core/ext/filters/client_channel/retry_service_config.h"
 #include "src/core/ext/filters/message_size/message_size_filter.h"
 #include "src/core/lib/gpr/string.h"
@@ -360,6 +362,24 @@ TEST_F(ServiceConfigTest, Parser1DisabledViaChannelArg) {
   EXPECT_EQ(svc_cfg->GetGlobalParsedConfig(0), nullptr);
 }
 
+TEST_F(ServiceConfigTest, SharedWhileReferenced) {
+  const char* test_json = "{\"global_param\":5}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg1 = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  auto svc_cfg2 = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  EXPECT_EQ(svc_cfg1.get(), svc_cfg2.get());
+  // Different channel args parse separately.
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_DISABLE_PARSING), 1);
+  grpc_channel_args args = {1, &arg};
+  auto svc_cfg3 = ServiceConfigImpl::Create(&args, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  EXPECT_NE(svc_cfg1.get(), svc_cfg3.get());
+  EXPECT_EQ(svc_cfg3->GetGlobalParsedConfig(0), nullptr);
+}
+
 TEST_F(ServiceConfigTest, Parser1ErrorInvalidType) {
   const char* test_json = "{\"global_param\":\"5\"}";
   grpc_error_handle error = GRPC_ERROR_NONE;
@@ -1483,6 +1503,358 @@ TEST_F(RetryParserTest, InvalidRetryPolicyPerAttemptRecvTimeoutBadValue) {
   GRPC_ERROR_UNREF(error);
 }
 
+TEST_F(RetryParserTest, ValidHedgingPolicy) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 3,\n"
+      "      \"hedgingDelay\": \"0.5s\",\n"
+      "      \"nonFatalStatusCodes\": [\"UNAVAILABLE\"]\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING), 1);
+  grpc_channel_args args = {1, &arg};
+  auto svc_cfg = ServiceConfigImpl::Create(&args, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  const auto* vector_ptr = svc_cfg->GetMethodParsedConfigVector(
+      grpc_slice_from_static_string("/TestServ/TestMethod"));
+  ASSERT_NE(vector_ptr, nullptr);
+  const auto* parsed_config =
+      static_cast<internal::RetryMethodConfig*>(((*vector_ptr)[0]).get());
+  ASSERT_NE(parsed_config, nullptr);
+  EXPECT_EQ(parsed_config->max_attempts(), 3);
+  EXPECT_EQ(parsed_config->hedging_delay(), Duration::Milliseconds(500));
+  EXPECT_EQ(parsed_config->per_attempt_recv_timeout(), absl::nullopt);
+  EXPECT_TRUE(parsed_config->retryable_status_codes().Contains(
+      GRPC_STATUS_UNAVAILABLE));
+}
+
+TEST_F(RetryParserTest, HedgingPolicyIgnoredWhenHedgingDisabled) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 3,\n"
+      "      \"hedgingDelay\": \"0.5s\"\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  const auto* vector_ptr = svc_cfg->GetMethodParsedConfigVector(
+      grpc_slice_from_static_string("/TestServ/TestMethod"));
+  ASSERT_NE(vector_ptr, nullptr);
+  EXPECT_EQ(((*vector_ptr)[0]).get(), nullptr);
+}
+
+TEST_F(RetryParserTest, InvalidHedgingPolicyWithRetryPolicy) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"retryPolicy\": {\n"
+      "      \"maxAttempts\": 2,\n"
+      "      \"initialBackoff\": \"1s\",\n"
+      "      \"maxBackoff\": \"120s\",\n"
+      "      \"backoffMultiplier\": 1.6,\n"
+      "      \"retryableStatusCodes\": [\"ABORTED\"]\n"
+      "    },\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 3\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING), 1);
+  grpc_channel_args args = {1, &arg};
+  auto svc_cfg = ServiceConfigImpl::Create(&args, test_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "Service config parsing error" CHILD_ERROR_TAG
+                  "Method Params" CHILD_ERROR_TAG "methodConfig" CHILD_ERROR_TAG
+                  "field:hedgingPolicy error:may not be set together with "
+                  "retryPolicy"));
+  GRPC_ERROR_UNREF(error);
+}
+
+TEST_F(RetryParserTest, InvalidHedgingPolicyMaxAttemptsBadValue) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 1,\n"
+      "      \"hedgingDelay\": \"0.5s\"\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING), 1);
+  grpc_channel_args args = {1, &arg};
+  auto svc_cfg = ServiceConfigImpl::Create(&args, test_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "Service config parsing error" CHILD_ERROR_TAG
+                  "Method Params" CHILD_ERROR_TAG "methodConfig" CHILD_ERROR_TAG
+                  "hedgingPolicy" CHILD_ERROR_TAG
+                  "field:maxAttempts error:should be at least 2"));
+  GRPC_ERROR_UNREF(error);
+}
+
+TEST_F(RetryParserTest, InvalidHedgingPolicyNonFatalStatusCodesWrongType) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"hedgingPolicy\": {\n"
+      "      \"maxAttempts\": 3,\n"
+      "      \"nonFatalStatusCodes\": 0\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_EXPERIMENTAL_ENABLE_HEDGING), 1);
+  grpc_channel_args args = {1, &arg};
+  auto svc_cfg = ServiceConfigImpl::Create(&args, test_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "Service config parsing error" CHILD_ERROR_TAG
+                  "Method Params" CHILD_ERROR_TAG "methodConfig" CHILD_ERROR_TAG
+                  "hedgingPolicy" CHILD_ERROR_TAG
+                  "field:nonFatalStatusCodes error:must be of type array"));
+  GRPC_ERROR_UNREF(error);
+}
+
+//
+// adaptive_throttle parser tests
+//
+
+class AdaptiveThrottleParserTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    CoreConfiguration::Reset();
+    CoreConfiguration::BuildSpecialConfiguration(
+        [](CoreConfiguration::Builder* builder) {
+          builder->service_config_parser()->RegisterParser(
+              absl::make_unique<AdaptiveThrottleServiceConfigParser>());
+        });
+    EXPECT_EQ(CoreConfiguration::Get().service_config_parser().GetParserIndex(
+                  "adaptive_throttle"),
+              0);
+  }
+};
+
+TEST_F(AdaptiveThrottleParserTest, ValidAdaptiveThrottling) {
+  const char* test_json =
+      "{\n"
+      "  \"adaptiveThrottling\": {\n"
+      "    \"acceptsMultiplier\": 1.5,\n"
+      "    \"window\": \"30s\"\n"
+      "  }\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  const auto* parsed_config = static_cast<AdaptiveThrottleGlobalConfig*>(
+      svc_cfg->GetGlobalParsedConfig(0));
+  ASSERT_NE(parsed_config, nullptr);
+  EXPECT_EQ(parsed_config->accepts_multiplier(), 1.5);
+  EXPECT_EQ(parsed_config->window(), Duration::Seconds(30));
+}
+
+TEST_F(AdaptiveThrottleParserTest, AdaptiveThrottlingDefaults) {
+  const char* test_json = "{\"adaptiveThrottling\": {}}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  const auto* parsed_config = static_cast<AdaptiveThrottleGlobalConfig*>(
+      svc_cfg->GetGlobalParsedConfig(0));
+  ASSERT_NE(parsed_config, nullptr);
+  EXPECT_EQ(parsed_config->accepts_multiplier(), 2);
+  EXPECT_EQ(parsed_config->window(), Duration::Minutes(2));
+}
+
+TEST_F(AdaptiveThrottleParserTest, NoAdaptiveThrottling) {
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, "{}", &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  EXPECT_EQ(svc_cfg->GetGlobalParsedConfig(0), nullptr);
+}
+
+TEST_F(AdaptiveThrottleParserTest, InvalidAdaptiveThrottling) {
+  const char* test_json =
+      "{\n"
+      "  \"adaptiveThrottling\": {\n"
+      "    \"acceptsMultiplier\": 0.5,\n"
+      "    \"window\": \"0s\"\n"
+      "  }\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "Service config parsing error" CHILD_ERROR_TAG
+                  "Global Params" CHILD_ERROR_TAG
+                  "adaptiveThrottling" CHILD_ERROR_TAG
+                  "field:acceptsMultiplier error:must be at least 1"
+                  ".*field:window error:must be greater than 0"));
+  GRPC_ERROR_UNREF(error);
+}
+
+//
+// response_cache parser tests
+//
+
+class ResponseCacheParserTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    CoreConfiguration::Reset();
+    CoreConfiguration::BuildSpecialConfiguration(
+        [](CoreConfiguration::Builder* builder) {
+          builder->service_config_parser()->RegisterParser(
+              absl::make_unique<ResponseCacheServiceConfigParser>());
+        });
+    EXPECT_EQ(CoreConfiguration::Get().service_config_parser().GetParserIndex(
+                  "response_cache"),
+              0);
+  }
+};
+
+TEST_F(ResponseCacheParserTest, ValidResponseCache) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"responseCache\": {\n"
+      "      \"ttl\": \"5s\"\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  EXPECT_NE(svc_cfg->GetGlobalParsedConfig(0), nullptr);
+  const auto* vector_ptr = svc_cfg->GetMethodParsedConfigVector(
+      grpc_slice_from_static_string("/TestServ/TestMethod"));
+  ASSERT_NE(vector_ptr, nullptr);
+  auto parsed_config = ((*vector_ptr)[0]).get();
+  ASSERT_NE(parsed_config, nullptr);
+  EXPECT_EQ(static_cast<ResponseCacheMethodConfig*>(parsed_config)->ttl(),
+            Duration::Seconds(5));
+}
+
+TEST_F(ResponseCacheParserTest, ValidRequestCoalescing) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"requestCoalescing\": {\n"
+      "      \"maxFanOut\": 50\n"
+      "    },\n"
+      "    \"keyMetadata\": [ \"X-Tenant\" ]\n"
+      "  } ]\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  EXPECT_NE(svc_cfg->GetGlobalParsedConfig(0), nullptr);
+  const auto* vector_ptr = svc_cfg->GetMethodParsedConfigVector(
+      grpc_slice_from_static_string("/TestServ/TestMethod"));
+  ASSERT_NE(vector_ptr, nullptr);
+  const auto* parsed_config =
+      static_cast<ResponseCacheMethodConfig*>(((*vector_ptr)[0]).get());
+  ASSERT_NE(parsed_config, nullptr);
+  EXPECT_EQ(parsed_config->ttl(), Duration::Zero());
+  EXPECT_EQ(parsed_config->max_fan_out(), 50);
+  EXPECT_THAT(parsed_config->key_metadata(),
+              ::testing::ElementsAre("x-tenant"));
+}
+
+TEST_F(ResponseCacheParserTest, InvalidMaxFanOut) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"requestCoalescing\": {\n"
+      "      \"maxFanOut\": 0\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "Service config parsing error" CHILD_ERROR_TAG
+                  "Method Params" CHILD_ERROR_TAG "methodConfig" CHILD_ERROR_TAG
+                  "requestCoalescing" CHILD_ERROR_TAG
+                  "field:maxFanOut error:must be greater than 0"));
+  GRPC_ERROR_UNREF(error);
+}
+
+TEST_F(ResponseCacheParserTest, NoResponseCache) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ]\n"
+      "  } ]\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  EXPECT_EQ(svc_cfg->GetGlobalParsedConfig(0), nullptr);
+}
+
+TEST_F(ResponseCacheParserTest, InvalidTtl) {
+  const char* test_json =
+      "{\n"
+      "  \"methodConfig\": [ {\n"
+      "    \"name\": [\n"
+      "      { \"service\": \"TestServ\", \"method\": \"TestMethod\" }\n"
+      "    ],\n"
+      "    \"responseCache\": {\n"
+      "      \"ttl\": \"0s\"\n"
+      "    }\n"
+      "  } ]\n"
+      "}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "Service config parsing error" CHILD_ERROR_TAG
+                  "Method Params" CHILD_ERROR_TAG "methodConfig" CHILD_ERROR_TAG
+                  "responseCache" CHILD_ERROR_TAG
+                  "field:ttl error:must be greater than 0"));
+  GRPC_ERROR_UNREF(error);
+}
+
 //
 // message_size parser tests
 //
@@ -0,0 +1,171 @@
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/filters/client_channel/subchannel.h"
+
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/filters/client_channel/connector.h"
+#include "src/core/ext/filters/client_channel/subchannel_pool_interface.h"
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+using ::testing::ElementsAre;
+
+class SubchannelConnectRateLimitTest : public ::testing::Test {
+ protected:
+  // Records its connection attempts in the test, and leaves them pending
+  // until it is shut down.
+  class FakeConnector : public SubchannelConnector {
+   public:
+    FakeConnector(int id, SubchannelConnectRateLimitTest* test)
+        : id_(id), test_(test) {}
+
+    void Connect(const Args& /*args*/, Result* /*result*/,
+                 grpc_closure* notify) override {
+      GPR_ASSERT(notify_ == nullptr);
+      notify_ = notify;
+      test_->OnConnect(id_);
+    }
+
+    void Shutdown(grpc_error_handle error) override {
+      if (notify_ != nullptr) {
+        ExecCtx::Run(DEBUG_LOCATION, std::exchange(notify_, nullptr), error);
+      } else {
+        (void)GRPC_ERROR_UNREF(error);
+      }
+    }
+
+   private:
+    const int id_;
+    SubchannelConnectRateLimitTest* test_;
+    grpc_closure* notify_ = nullptr;
+  };
+
+  void TearDown() override {
+    ExecCtx exec_ctx;
+    subchannels_.clear();
+  }
+
+  // Creates a subchannel to \a address, limited to \a rate connection
+  // attempts per second to that address.  Its attempts are recorded under
+  // its index in subchannels_.
+  Subchannel* CreateSubchannel(absl::string_view address, int rate) {
+    grpc_resolved_address resolved_address;
+    GPR_ASSERT(grpc_parse_ipv4_hostport(address, &resolved_address,
+                                        /*log_errors=*/true));
+    grpc_arg arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_PER_ADDRESS_CONNECT_RATE_LIMIT), rate);
+    grpc_channel_args args = {1, &arg};
+    const int id = static_cast<int>(subchannels_.size());
+    subchannels_.push_back(MakeRefCounted<Subchannel>(
+        SubchannelKey(resolved_address, &args),
+        MakeOrphanable<FakeConnector>(id, this), &args));
+    return subchannels_.back().get();
+  }
+
+  // Waits until at least count connection attempts were started, and
+  // returns the indexes of their subchannels in order.
+  std::vector<int> WaitForAttempts(size_t count) {
+    MutexLock lock(&mu_);
+    while (attempts_.size() < count) {
+      if (cv_.WaitWithTimeout(&mu_, absl::Seconds(10))) break;
+    }
+    return attempts_;
+  }
+
+ private:
+  void OnConnect(int id) {
+    MutexLock lock(&mu_);
+    attempts_.push_back(id);
+    cv_.SignalAll();
+  }
+
+  std::vector<RefCountedPtr<Subchannel>> subchannels_;
+  Mutex mu_;
+  CondVar cv_;
+  std::vector<int> attempts_ ABSL_GUARDED_BY(mu_);
+};
+
+// The per-address buckets are shared by the whole process, so each test
+// connects to its own address.
+
+TEST_F(SubchannelConnectRateLimitTest, AttemptsOverLimitAreDelayed) {
+  const absl::Time start = absl::Now();
+  Subchannel* delayed = nullptr;
+  {
+    ExecCtx exec_ctx;
+    CreateSubchannel("127.0.0.1:10001", 1)->RequestConnection();
+    delayed = CreateSubchannel("127.0.0.1:10001", 1);
+    delayed->RequestConnection();
+    // Other addresses have their own limit.
+    CreateSubchannel("127.0.0.1:10002", 1)->RequestConnection();
+  }
+  EXPECT_THAT(WaitForAttempts(2), ElementsAre(0, 2));
+  // The delayed subchannel reports CONNECTING while it waits.
+  EXPECT_EQ(delayed->CheckConnectivityState(absl::nullopt),
+            GRPC_CHANNEL_CONNECTING);
+  EXPECT_THAT(WaitForAttempts(3), ElementsAre(0, 2, 1));
+  // One attempt per second, less the granularity of the cached time.
+  EXPECT_GE(absl::Now() - start, absl::Milliseconds(900));
+}
+
+TEST_F(SubchannelConnectRateLimitTest, ResetBackoffCancelsDelay) {
+  Subchannel* last = nullptr;
+  {
+    ExecCtx exec_ctx;
+    // One attempt now, then one after one and two seconds.
+    for (int i = 0; i < 3; ++i) {
+      last = CreateSubchannel("127.0.0.1:10003", 1);
+      last->RequestConnection();
+    }
+  }
+  EXPECT_THAT(WaitForAttempts(1), ElementsAre(0));
+  {
+    ExecCtx exec_ctx;
+    last->ResetBackoff();
+  }
+  // The last attempt no longer waits for the one before it.
+  EXPECT_THAT(WaitForAttempts(2), ElementsAre(0, 2));
+  EXPECT_THAT(WaitForAttempts(3), ElementsAre(0, 2, 1));
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
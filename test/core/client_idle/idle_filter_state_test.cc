@@ -19,21 +19,22 @@
 #include <chrono>
 #include <random>
 #include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 namespace grpc_core {
 namespace testing {
 
-TEST(IdleFilterStateTest, IdlenessStartsTimer) {
+TEST(IdleFilterStateTest, ActivityStartsTimer) {
   IdleFilterState s(false);
-  s.IncreaseCallCount();
-  // First idle should start the timer
-  EXPECT_TRUE(s.DecreaseCallCount());
+  // First call should start the timer
+  EXPECT_TRUE(s.IncreaseCallCount());
+  s.DecreaseCallCount();
   for (int i = 0; i < 10; i++) {
-    // Next idle should not!
-    s.IncreaseCallCount();
-    EXPECT_FALSE(s.DecreaseCallCount());
+    // Next calls should not!
+    EXPECT_FALSE(s.IncreaseCallCount());
+    s.DecreaseCallCount();
   }
 }
 
@@ -45,59 +46,71 @@ TEST(IdleFilterStateTest, TimerStopsAfterIdle) {
 TEST(IdleFilterStateTest, TimerKeepsGoingWithActivity) {
   IdleFilterState s(true);
   for (int i = 0; i < 10; i++) {
-    s.IncreaseCallCount();
-    (void)s.DecreaseCallCount();
+    EXPECT_FALSE(s.IncreaseCallCount());
+    s.DecreaseCallCount();
     EXPECT_TRUE(s.CheckTimer());
   }
   EXPECT_FALSE(s.CheckTimer());
 }
 
+TEST(IdleFilterStateTest, TimerKeepsGoingWithCallInProgress) {
+  IdleFilterState s(false);
+  EXPECT_TRUE(s.IncreaseCallCount());
+  for (int i = 0; i < 10; i++) {
+    EXPECT_TRUE(s.CheckTimer());
+  }
+  s.DecreaseCallCount();
+  // Finishing the call counts as activity for one more cycle.
+  EXPECT_TRUE(s.CheckTimer());
+  EXPECT_FALSE(s.CheckTimer());
+  // Once idle, the next call starts the timer again.
+  EXPECT_TRUE(s.IncreaseCallCount());
+  s.DecreaseCallCount();
+}
+
 TEST(IdleFilterStateTest, StressTest) {
   IdleFilterState s(false);
+  // Hold one call for the duration of the test: however the other calls
+  // start and finish across CPUs, the timer must never see the channel idle.
+  EXPECT_TRUE(s.IncreaseCallCount());
   std::atomic<bool> done{false};
-  int idle_polls = 0;
-  int thread_jumps = 0;
+  std::thread timer([&] {
+    while (!done.load(std::memory_order_relaxed)) {
+      EXPECT_TRUE(s.CheckTimer());
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
   std::vector<std::thread> threads;
   for (int idx = 0; idx < 100; idx++) {
     std::thread t([&] {
       int ctr = 0;
-      auto increase = [&] {
-        s.IncreaseCallCount();
-        ctr++;
-      };
-      auto decrease = [&] {
-        ctr--;
-        if (s.DecreaseCallCount()) {
-          thread_jumps++;
-          if (thread_jumps == 10) done.store(true, std::memory_order_relaxed);
-          EXPECT_EQ(ctr, 0);
-          do {
-            idle_polls++;
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-          } while (s.CheckTimer());
-        }
-      };
       std::mt19937 g{std::random_device()()};
-      while (!done.load(std::memory_order_relaxed)) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+      for (int round = 0; round < 10; round++) {
         for (int i = 0; i < 100; i++) {
           if (g() & 1) {
-            increase();
+            EXPECT_FALSE(s.IncreaseCallCount());
+            ctr++;
           } else if (ctr > 0) {
-            decrease();
+            s.DecreaseCallCount();
+            ctr--;
           }
         }
+        // Let the thread migrate before finishing its calls.
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
         while (ctr > 0) {
-          decrease();
+          s.DecreaseCallCount();
+          ctr--;
         }
       }
-      while (ctr > 0) {
-        decrease();
-      }
     });
     threads.emplace_back(std::move(t));
   }
   for (auto& thread : threads) thread.join();
+  done.store(true, std::memory_order_relaxed);
+  timer.join();
+  s.DecreaseCallCount();
+  EXPECT_TRUE(s.CheckTimer());
+  EXPECT_FALSE(s.CheckTimer());
 }
 
 }  // namespace testing
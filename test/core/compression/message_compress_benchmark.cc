@@ -0,0 +1,162 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark message compression and decompression with each supported
+   algorithm over structured payloads of typical RPC sizes. */
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/compression/compression_internal.h"
+#include "src/core/lib/compression/message_compress.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+
+namespace {
+
+// A payload of \a size bytes resembling serialized structured records:
+// repeated field names and enum-like values, with random ids, counters and
+// free text mixed in.
+std::string MakeCorpus(size_t size) {
+  static const char* const kStates[] = {"ACTIVE", "PENDING", "SUSPENDED",
+                                        "DELETED"};
+  static const char* const kWords[] = {
+      "alpha", "bravo", "charlie", "delta",  "echo",   "foxtrot",
+      "golf",  "hotel", "india",   "juliet", "kilo",   "lima",
+      "mike",  "oscar", "papa",    "quebec", "romeo",  "sierra",
+  };
+  std::mt19937 rng(size);
+  std::string corpus;
+  for (uint64_t record = 0; corpus.size() < size; ++record) {
+    absl::StrAppend(&corpus, "{id:", rng(), ",sequence:", record, ",state:",
+                    kStates[rng() % GPR_ARRAY_SIZE(kStates)],
+                    ",owner:\"user-", rng() % 1000,
+                    "@example.com\",created_ms:",
+                    1640995200000 + record * 1000 + rng() % 1000, ",tags:[");
+    for (uint32_t i = rng() % 4; i > 0; --i) {
+      absl::StrAppend(&corpus, "\"", kWords[rng() % GPR_ARRAY_SIZE(kWords)],
+                      "\",");
+    }
+    absl::StrAppend(&corpus, "],description:\"");
+    for (uint32_t i = 4 + rng() % 12; i > 0; --i) {
+      absl::StrAppend(&corpus, kWords[rng() % GPR_ARRAY_SIZE(kWords)], " ");
+    }
+    absl::StrAppend(&corpus, "\"}\n");
+  }
+  corpus.resize(size);
+  return corpus;
+}
+
+// Input slices are 16KiB, like the messages the transport receives.
+void FillBuffer(const std::string& data, grpc_slice_buffer* buffer) {
+  constexpr size_t kSliceSize = 16 * 1024;
+  for (size_t i = 0; i < data.size(); i += kSliceSize) {
+    grpc_slice_buffer_add(buffer,
+                          grpc_slice_from_copied_buffer(
+                              data.data() + i,
+                              std::min(kSliceSize, data.size() - i)));
+  }
+}
+
+// Args: algorithm, payload size.
+void BM_MessageCompress(benchmark::State& state) {
+  auto algorithm = static_cast<grpc_compression_algorithm>(state.range(0));
+  if (!grpc_core::IsCompressionAlgorithmSupported(algorithm)) {
+    state.SkipWithError("algorithm not supported by this build");
+    return;
+  }
+  grpc_core::ExecCtx exec_ctx;
+  grpc_slice_buffer input;
+  grpc_slice_buffer output;
+  grpc_slice_buffer_init(&input);
+  grpc_slice_buffer_init(&output);
+  FillBuffer(MakeCorpus(state.range(1)), &input);
+  for (auto _ : state) {
+    GPR_ASSERT(grpc_msg_compress(algorithm, &input, &output));
+    state.counters["ratio"] =
+        static_cast<double>(input.length) / output.length;
+    grpc_slice_buffer_reset_and_unref(&output);
+  }
+  state.SetBytesProcessed(state.iterations() * input.length);
+  grpc_slice_buffer_destroy(&input);
+  grpc_slice_buffer_destroy(&output);
+}
+BENCHMARK(BM_MessageCompress)
+    ->ArgNames({"algorithm", "size"})
+    ->ArgsProduct({{GRPC_COMPRESS_DEFLATE, GRPC_COMPRESS_GZIP,
+                    GRPC_COMPRESS_ZSTD},
+                   {1024, 64 * 1024, 512 * 1024}});
+
+// Args: algorithm, payload size.
+void BM_MessageDecompress(benchmark::State& state) {
+  auto algorithm = static_cast<grpc_compression_algorithm>(state.range(0));
+  if (!grpc_core::IsCompressionAlgorithmSupported(algorithm)) {
+    state.SkipWithError("algorithm not supported by this build");
+    return;
+  }
+  grpc_core::ExecCtx exec_ctx;
+  grpc_slice_buffer input;
+  grpc_slice_buffer compressed;
+  grpc_slice_buffer output;
+  grpc_slice_buffer_init(&input);
+  grpc_slice_buffer_init(&compressed);
+  grpc_slice_buffer_init(&output);
+  FillBuffer(MakeCorpus(state.range(1)), &input);
+  GPR_ASSERT(grpc_msg_compress(algorithm, &input, &compressed));
+  for (auto _ : state) {
+    GPR_ASSERT(grpc_msg_decompress(algorithm, &compressed, &output));
+    GPR_ASSERT(output.length == input.length);
+    grpc_slice_buffer_reset_and_unref(&output);
+  }
+  state.SetBytesProcessed(state.iterations() * input.length);
+  grpc_slice_buffer_destroy(&input);
+  grpc_slice_buffer_destroy(&compressed);
+  grpc_slice_buffer_destroy(&output);
+}
+BENCHMARK(BM_MessageDecompress)
+    ->ArgNames({"algorithm", "size"})
+    ->ArgsProduct({{GRPC_COMPRESS_DEFLATE, GRPC_COMPRESS_GZIP,
+                    GRPC_COMPRESS_ZSTD},
+                   {1024, 64 * 1024, 512 * 1024}});
+
+}  // namespace
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  ::benchmark::Initialize(&argc, argv);
+  benchmark::RunTheBenchmarksNamespaced();
+  grpc_shutdown();
+  return 0;
+}
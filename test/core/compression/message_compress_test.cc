@@ -21,9 +21,19 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+
+#if GRPC_ZSTD
+#include <zdict.h>
+#endif
+
 #include <grpc/grpc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/compression/compression_internal.h"
 #include "src/core/lib/gpr/murmur_hash.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
@@ -149,7 +159,11 @@ static void test_tiny_data_compress(void) {
   grpc_slice_buffer_add(&input, create_test_value(ONE_A));
 
   for (int i = 0; i < GRPC_COMPRESS_ALGORITHMS_COUNT; i++) {
-    if (i == GRPC_COMPRESS_NONE) continue;
+    if (i == GRPC_COMPRESS_NONE ||
+        !grpc_core::IsCompressionAlgorithmSupported(
+            static_cast<grpc_compression_algorithm>(i))) {
+      continue;
+    }
     grpc_core::ExecCtx exec_ctx;
     GPR_ASSERT(0 ==
                grpc_msg_compress(static_cast<grpc_compression_algorithm>(i),
@@ -218,6 +232,36 @@ static void test_bad_decompression_data_missing_trailer(void) {
   grpc_slice_buffer_destroy(&output);
 }
 
+static void test_bad_decompression_data_truncated_zstd(void) {
+  if (!grpc_core::IsCompressionAlgorithmSupported(GRPC_COMPRESS_ZSTD)) return;
+  grpc_slice_buffer input;
+  grpc_slice_buffer compressed;
+  grpc_slice_buffer garbage;
+  grpc_slice_buffer output;
+
+  grpc_slice_buffer_init(&input);
+  grpc_slice_buffer_init(&compressed);
+  grpc_slice_buffer_init(&garbage);
+  grpc_slice_buffer_init(&output);
+  grpc_slice_buffer_add(&input, create_test_value(ONE_MB_A));
+
+  grpc_core::ExecCtx exec_ctx;
+  /* compress it */
+  GPR_ASSERT(grpc_msg_compress(GRPC_COMPRESS_ZSTD, &input, &compressed));
+  GPR_ASSERT(compressed.length > 4);
+  /* Cut the end of the frame off */
+  grpc_slice_buffer_trim_end(&compressed, 4, &garbage);
+  /* try (and fail) to decompress the truncated frame */
+  GPR_ASSERT(0 ==
+             grpc_msg_decompress(GRPC_COMPRESS_ZSTD, &compressed, &output));
+  GPR_ASSERT(output.length == 0);
+
+  grpc_slice_buffer_destroy(&input);
+  grpc_slice_buffer_destroy(&compressed);
+  grpc_slice_buffer_destroy(&garbage);
+  grpc_slice_buffer_destroy(&output);
+}
+
 static void test_bad_decompression_data_trailing_garbage(void) {
   grpc_slice_buffer input;
   grpc_slice_buffer output;
@@ -254,6 +298,108 @@ static void test_bad_decompression_data_stream(void) {
   grpc_slice_buffer_destroy(&output);
 }
 
+static void test_context_reuse(void) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::MessageCompressionContext context;
+  for (int i = 0; i < GRPC_COMPRESS_ALGORITHMS_COUNT; i++) {
+    auto algorithm = static_cast<grpc_compression_algorithm>(i);
+    if (i == GRPC_COMPRESS_NONE ||
+        !grpc_core::IsCompressionAlgorithmSupported(algorithm)) {
+      continue;
+    }
+    /* several messages, with a failed decompression in between, all go
+       through the same context */
+    for (int message = 0; message < 3; message++) {
+      grpc_slice_buffer input;
+      grpc_slice_buffer compressed;
+      grpc_slice_buffer output;
+      grpc_slice_buffer_init(&input);
+      grpc_slice_buffer_init(&compressed);
+      grpc_slice_buffer_init(&output);
+      grpc_slice_buffer_add(&input, repeated('a' + message, 1024));
+      GPR_ASSERT(context.Compress(algorithm, &input, &compressed));
+      if (message == 1) {
+        grpc_slice_buffer garbage;
+        grpc_slice_buffer_init(&garbage);
+        grpc_slice_buffer_trim_end(&compressed, 4, &garbage);
+        GPR_ASSERT(0 == context.Decompress(algorithm, &compressed, &output));
+        GPR_ASSERT(output.length == 0);
+        grpc_slice_buffer_destroy(&garbage);
+      } else {
+        GPR_ASSERT(context.Decompress(algorithm, &compressed, &output));
+        grpc_slice merged = grpc_slice_merge(input.slices, input.count);
+        grpc_slice final = grpc_slice_merge(output.slices, output.count);
+        GPR_ASSERT(grpc_slice_eq(merged, final));
+        grpc_slice_unref(merged);
+        grpc_slice_unref(final);
+      }
+      grpc_slice_buffer_destroy(&input);
+      grpc_slice_buffer_destroy(&compressed);
+      grpc_slice_buffer_destroy(&output);
+    }
+  }
+}
+
+static void test_zstd_dictionaries(void) {
+  grpc_core::ExecCtx exec_ctx;
+  /* dictionaries not from the zstd trainer are ignored */
+  GPR_ASSERT(grpc_core::ZstdCompressionDictionaries::Create({"not a dict"})
+                 ->advertisement()
+                 .empty());
+#if GRPC_ZSTD
+  /* train a dictionary on small, similar records */
+  std::string samples;
+  std::vector<size_t> sample_sizes;
+  for (int i = 0; i < 1000; i++) {
+    std::string sample =
+        absl::StrCat("{\"id\":", i * 7919, ",\"state\":\"ACTIVE\",\"owner\":",
+                     "\"user-", i % 13, "@example.com\",\"tags\":[\"alpha\"]}");
+    samples += sample;
+    sample_sizes.push_back(sample.size());
+  }
+  std::string dictionary(4096, '\0');
+  size_t dictionary_size = ZDICT_trainFromBuffer(
+      &dictionary[0], dictionary.size(), samples.data(), sample_sizes.data(),
+      static_cast<unsigned>(sample_sizes.size()));
+  GPR_ASSERT(!ZDICT_isError(dictionary_size));
+  dictionary.resize(dictionary_size);
+  uint32_t id = ZDICT_getDictID(dictionary.data(), dictionary.size());
+  auto dictionaries =
+      grpc_core::ZstdCompressionDictionaries::Create({dictionary});
+  GPR_ASSERT(dictionaries->advertisement() == std::to_string(id));
+  GPR_ASSERT(dictionaries->highest_id() == id);
+  GPR_ASSERT(dictionaries->ChooseDictionary(absl::StrCat("1, ", id)) == id);
+  GPR_ASSERT(dictionaries->ChooseDictionary("1,2") == 0);
+  GPR_ASSERT(dictionaries->ChooseDictionary("") == 0);
+  /* a message compresses with the dictionary, and only decompresses with it */
+  grpc_core::MessageCompressionContext sender;
+  sender.set_zstd_dictionaries(dictionaries);
+  grpc_core::MessageCompressionContext receiver;
+  receiver.set_zstd_dictionaries(dictionaries);
+  grpc_core::MessageCompressionContext receiver_without_dictionary;
+  grpc_slice_buffer input;
+  grpc_slice_buffer compressed;
+  grpc_slice_buffer output;
+  grpc_slice_buffer_init(&input);
+  grpc_slice_buffer_init(&compressed);
+  grpc_slice_buffer_init(&output);
+  grpc_slice_buffer_add(
+      &input,
+      grpc_slice_from_copied_string(
+          "{\"id\":12345,\"state\":\"ACTIVE\",\"owner\":\"user-5@example.com\","
+          "\"tags\":[\"alpha\"]}"));
+  GPR_ASSERT(
+      sender.Compress(GRPC_COMPRESS_ZSTD, &input, &compressed, id) == 1);
+  GPR_ASSERT(receiver_without_dictionary.Decompress(
+                 GRPC_COMPRESS_ZSTD, &compressed, &output) == 0);
+  GPR_ASSERT(receiver.Decompress(GRPC_COMPRESS_ZSTD, &compressed, &output));
+  GPR_ASSERT(output.length == input.length);
+  grpc_slice_buffer_destroy(&input);
+  grpc_slice_buffer_destroy(&compressed);
+  grpc_slice_buffer_destroy(&output);
+#endif
+}
+
 static void test_bad_compression_algorithm(void) {
   grpc_slice_buffer input;
   grpc_slice_buffer output;
@@ -315,6 +461,10 @@ int main(int argc, char** argv) {
   grpc_init();
 
   for (i = 0; i < GRPC_COMPRESS_ALGORITHMS_COUNT; i++) {
+    if (!grpc_core::IsCompressionAlgorithmSupported(
+            static_cast<grpc_compression_algorithm>(i))) {
+      continue;
+    }
     for (j = 0; j < GPR_ARRAY_SIZE(uncompressed_split_modes); j++) {
       for (k = 0; k < GPR_ARRAY_SIZE(compressed_split_modes); k++) {
         for (m = 0; m < TEST_VALUE_COUNT; m++) {
@@ -334,8 +484,11 @@ int main(int argc, char** argv) {
   test_tiny_data_compress();
   test_bad_decompression_data_crc();
   test_bad_decompression_data_missing_trailer();
+  test_bad_decompression_data_truncated_zstd();
   test_bad_decompression_data_stream();
   test_bad_decompression_data_trailing_garbage();
+  test_context_reuse();
+  test_zstd_dictionaries();
   test_bad_compression_algorithm();
   test_bad_decompression_algorithm();
   grpc_shutdown();
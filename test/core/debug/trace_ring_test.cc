@@ -0,0 +1,77 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/debug/trace.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+TraceFlag trace_ring_test_trace(false, "trace_ring_test");
+
+TEST(TraceRingTest, RecordsWhileTracerDisabled) {
+  TraceRing::Record(&trace_ring_test_trace, "first", 1, 2, 3);
+  TraceRing::Record(&trace_ring_test_trace, "second", -4);
+  std::string dump = TraceRing::Dump();
+  size_t first = dump.find(" trace_ring_test first 1 2 3\n");
+  size_t second = dump.find(" trace_ring_test second -4 0 0\n");
+  ASSERT_NE(first, std::string::npos) << dump;
+  ASSERT_NE(second, std::string::npos) << dump;
+  EXPECT_LT(first, second);
+}
+
+TEST(TraceRingTest, KeepsMostRecentEvents) {
+  // More than fit in the ring of any one cpu.
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([] {
+      for (int i = 0; i < 100000; ++i) {
+        TraceRing::Record(&trace_ring_test_trace, "overflow", i);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  TraceRing::Record(&trace_ring_test_trace, "last");
+  std::string dump = TraceRing::Dump();
+  EXPECT_THAT(dump, ::testing::HasSubstr(" trace_ring_test last 0 0 0\n"));
+  EXPECT_THAT(dump, ::testing::HasSubstr(" trace_ring_test overflow 99999 "));
+  EXPECT_THAT(dump, ::testing::Not(::testing::HasSubstr(
+                        " trace_ring_test overflow 0 0 0\n")));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
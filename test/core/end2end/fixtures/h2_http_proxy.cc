@@ -30,11 +30,13 @@
 #include "src/core/ext/filters/client_channel/client_channel.h"
 #include "src/core/ext/filters/http/server/http_server_filter.h"
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/connected_channel.h"
 #include "src/core/lib/gpr/env.h"
 #include "src/core/lib/gprpp/host_port.h"
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/surface/server.h"
+#include "src/core/lib/transport/http_connect_handshaker.h"
 #include "test/core/end2end/end2end_tests.h"
 #include "test/core/end2end/fixtures/http_proxy_fixture.h"
 #include "test/core/util/port.h"
@@ -88,6 +90,17 @@ void chttp2_init_client_fullstack(grpc_end2end_test_fixture* f,
   GPR_ASSERT(f->client);
 }
 
+// Starts the HTTP/2 handshake without waiting for the proxy's response.
+void chttp2_init_client_optimistic(grpc_end2end_test_fixture* f,
+                                   const grpc_channel_args* client_args) {
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_HTTP_CONNECT_OPTIMISTIC), 1);
+  const grpc_channel_args* args =
+      grpc_channel_args_copy_and_add(client_args, &arg, 1);
+  chttp2_init_client_fullstack(f, args);
+  grpc_channel_args_destroy(args);
+}
+
 void chttp2_init_server_fullstack(grpc_end2end_test_fixture* f,
                                   const grpc_channel_args* server_args) {
   fullstack_fixture_data* ffd =
@@ -119,6 +132,12 @@ static grpc_end2end_test_config configs[] = {
          FEATURE_MASK_SUPPORTS_AUTHORITY_HEADER,
      nullptr, chttp2_create_fixture_fullstack, chttp2_init_client_fullstack,
      chttp2_init_server_fullstack, chttp2_tear_down_fullstack},
+    {"chttp2/fullstack_optimistic_connect",
+     FEATURE_MASK_SUPPORTS_DELAYED_CONNECTION |
+         FEATURE_MASK_SUPPORTS_CLIENT_CHANNEL |
+         FEATURE_MASK_SUPPORTS_AUTHORITY_HEADER,
+     nullptr, chttp2_create_fixture_fullstack, chttp2_init_client_optimistic,
+     chttp2_init_server_fullstack, chttp2_tear_down_fullstack},
 };
 
 int main(int argc, char** argv) {
@@ -0,0 +1,135 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+
+// This test won't work except where shared-memory endpoints are available
+#ifdef GRPC_HAVE_SHM_ENDPOINT
+
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "absl/strings/str_format.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/transport/shm/shm_transport.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/surface/server.h"
+#include "test/core/end2end/end2end_tests.h"
+#include "test/core/util/test_config.h"
+
+struct shm_fixture_data {
+  std::string path;
+  // Set when the client was asked for before the server: it cannot connect
+  // until the server listens, so it is created right after.
+  bool client_pending = false;
+  const grpc_channel_args* client_args = nullptr;
+};
+
+static int unique = 1;
+
+static grpc_end2end_test_fixture chttp2_create_fixture_shm(
+    const grpc_channel_args* /*client_args*/,
+    const grpc_channel_args* /*server_args*/) {
+  shm_fixture_data* fixture_data = new shm_fixture_data;
+  gpr_timespec now = gpr_now(GPR_CLOCK_REALTIME);
+  fixture_data->path = absl::StrFormat(
+      "/tmp/grpc_shm_test.%d.%" PRId64 ".%" PRId32 ".%d", getpid(), now.tv_sec,
+      now.tv_nsec, unique++);
+
+  grpc_end2end_test_fixture f;
+  memset(&f, 0, sizeof(f));
+  f.fixture_data = fixture_data;
+  f.cq = grpc_completion_queue_create_for_next(nullptr);
+
+  return f;
+}
+
+static void chttp2_init_client_shm(grpc_end2end_test_fixture* f,
+                                   const grpc_channel_args* client_args) {
+  shm_fixture_data* sfd = static_cast<shm_fixture_data*>(f->fixture_data);
+  GPR_ASSERT(!f->client);
+  if (f->server == nullptr) {
+    sfd->client_pending = true;
+    sfd->client_args = grpc_channel_args_copy(client_args);
+    return;
+  }
+  f->client = grpc_core::CreateShmChannel(sfd->path.c_str(), client_args);
+  GPR_ASSERT(f->client);
+}
+
+static void chttp2_init_server_shm(grpc_end2end_test_fixture* f,
+                                   const grpc_channel_args* server_args) {
+  grpc_core::ExecCtx exec_ctx;
+  shm_fixture_data* sfd = static_cast<shm_fixture_data*>(f->fixture_data);
+  if (f->server) {
+    grpc_server_destroy(f->server);
+  }
+  f->server = grpc_server_create(server_args, nullptr);
+  grpc_server_register_completion_queue(f->server, f->cq, nullptr);
+  GPR_ASSERT(GRPC_LOG_IF_ERROR(
+      "AddShmListener",
+      grpc_core::AddShmListener(grpc_core::Server::FromC(f->server),
+                                sfd->path.c_str())));
+  grpc_server_start(f->server);
+  if (sfd->client_pending) {
+    sfd->client_pending = false;
+    chttp2_init_client_shm(f, sfd->client_args);
+    grpc_channel_args_destroy(sfd->client_args);
+    sfd->client_args = nullptr;
+  }
+}
+
+static void chttp2_tear_down_shm(grpc_end2end_test_fixture* f) {
+  delete static_cast<shm_fixture_data*>(f->fixture_data);
+}
+
+/* All test configurations */
+static grpc_end2end_test_config configs[] = {
+    {"chttp2/shm", FEATURE_MASK_SUPPORTS_AUTHORITY_HEADER, nullptr,
+     chttp2_create_fixture_shm, chttp2_init_client_shm, chttp2_init_server_shm,
+     chttp2_tear_down_shm},
+};
+
+int main(int argc, char** argv) {
+  size_t i;
+
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_end2end_tests_pre_init();
+  grpc_init();
+
+  for (i = 0; i < sizeof(configs) / sizeof(*configs); i++) {
+    grpc_end2end_tests(argc, argv, configs[i]);
+  }
+
+  grpc_shutdown();
+
+  return 0;
+}
+
+#else /* GRPC_HAVE_SHM_ENDPOINT */
+
+int main(int /* argc */, char** /* argv */) { return 1; }
+
+#endif /* GRPC_HAVE_SHM_ENDPOINT */
@@ -379,6 +379,21 @@ static void on_write_response_done_locked(void* arg, grpc_error_handle error) {
   }
   // Clear write buffer.
   grpc_slice_buffer_reset_and_unref(&conn->client_write_buffer);
+  // The parser stores anything the client sent after the request, without
+  // waiting for the response, as the request body.  Forward it first.
+  if (conn->http_request.body_length > 0) {
+    grpc_slice_buffer_add(
+        &conn->server_write_buffer,
+        grpc_slice_from_copied_buffer(conn->http_request.body,
+                                      conn->http_request.body_length));
+    proxy_connection_ref(conn, "server_write");
+    conn->server_is_writing = true;
+    GRPC_CLOSURE_INIT(&conn->on_server_write_done, on_server_write_done, conn,
+                      grpc_schedule_on_exec_ctx);
+    grpc_endpoint_write(conn->server_endpoint, &conn->server_write_buffer,
+                        &conn->on_server_write_done, nullptr,
+                        /*max_frame_size=*/INT_MAX);
+  }
   // Start reading from both client and server.  One of the read
   // requests inherits our ref to conn, but we need to take a new ref
   // for the other one.
@@ -37,7 +37,8 @@ def _fixture_options(
         client_channel = True,
         supports_msvc = True,
         flaky_tests = [],
-        tags = []):
+        tags = [],
+        deps = []):
     return struct(
         fullstack = fullstack,
         includes_proxy = includes_proxy,
@@ -55,6 +56,7 @@ def _fixture_options(
         _platforms = _platforms,
         flaky_tests = flaky_tests,
         tags = tags,
+        deps = deps,
     )
 
 # maps fixture name to whether it requires the security library
@@ -126,6 +128,13 @@ END2END_FIXTURES = {
         _platforms = ["linux", "mac", "posix"],
     ),
     "h2_ssl_proxy": _fixture_options(includes_proxy = True, secure = True),
+    "h2_shm": _fixture_options(
+        dns_resolver = False,
+        fullstack = False,
+        client_channel = False,
+        _platforms = ["linux"],
+        deps = ["//:grpc_transport_shm"],
+    ),
     "h2_uds": _fixture_options(
         dns_resolver = False,
         _platforms = ["linux", "mac", "posix"],
@@ -429,7 +438,7 @@ def grpc_end2end_tests():
                 "//:grpc",
                 "//:gpr",
                 "//test/core/compression:args_utils",
-            ],
+            ] + fopt.deps,
             tags = _platform_support_tags(fopt) + fopt.tags,
         )
         for t, topt in END2END_TESTS.items():
@@ -397,9 +397,10 @@ static void request_with_payload_template_inner(
   CQ_EXPECT_COMPLETION(cqv, tag(100), true);
   cq_verify(cqv);
 
+  /* All algorithms but zstd, unless this build supports it. */
   GPR_ASSERT(grpc_core::BitCount(
                  grpc_call_test_only_get_encodings_accepted_by_peer(s)) ==
-             GRPC_COMPRESS_ALGORITHMS_COUNT);
+             GRPC_COMPRESS_ALGORITHMS_COUNT - (GRPC_ZSTD ? 0 : 1));
   GPR_ASSERT(
       grpc_core::GetBit(grpc_call_test_only_get_encodings_accepted_by_peer(s),
                         GRPC_COMPRESS_NONE) != 0);
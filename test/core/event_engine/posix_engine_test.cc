@@ -0,0 +1,417 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+// This test won't work except with epoll
+#ifdef GRPC_LINUX_EPOLL
+
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "absl/memory/memory.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/time.h"
+
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/event_engine/slice_buffer.h>
+#include <grpc/grpc.h>
+
+#include "src/core/lib/event_engine/channel_args_endpoint_config.h"
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+namespace {
+
+using ::testing::ElementsAre;
+
+EventEngine::ResolvedAddress LoopbackAddress(int port) {
+  sockaddr_in6 addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin6_family = AF_INET6;
+  addr.sin6_addr = in6addr_loopback;
+  addr.sin6_port = htons(port);
+  return EventEngine::ResolvedAddress(reinterpret_cast<sockaddr*>(&addr),
+                                      sizeof(addr));
+}
+
+std::string SliceBufferToString(SliceBuffer* buffer) {
+  std::string out(buffer->Length(), '\0');
+  buffer->MoveFirstNBytesIntoBuffer(buffer->Length(), &out[0]);
+  return out;
+}
+
+class PosixEventEngineTest : public ::testing::Test {
+ protected:
+  PosixEventEngineTest()
+      : quota_(std::make_shared<grpc_core::MemoryQuota>("posix_engine_test")) {}
+
+  MemoryAllocator NewAllocator() {
+    return quota_->CreateMemoryAllocator("posix_engine_test");
+  }
+
+  std::unique_ptr<MemoryAllocatorFactory> NewAllocatorFactory() {
+    class Factory : public MemoryAllocatorFactory {
+     public:
+      explicit Factory(std::shared_ptr<grpc_core::MemoryQuota> quota)
+          : quota_(std::move(quota)) {}
+      MemoryAllocator CreateMemoryAllocator(absl::string_view name) override {
+        return quota_->CreateMemoryAllocator(name);
+      }
+
+     private:
+      std::shared_ptr<grpc_core::MemoryQuota> quota_;
+    };
+    return absl::make_unique<Factory>(quota_);
+  }
+
+  // Starts a listener on an ephemeral loopback port, handing accepted
+  // endpoints to "accepted".
+  std::unique_ptr<EventEngine::Listener> StartListener(
+      EventEngine* engine, int* port,
+      std::unique_ptr<EventEngine::Endpoint>* accepted,
+      absl::Notification* on_accept, absl::Notification* on_shutdown) {
+    auto listener = engine->CreateListener(
+        [accepted, on_accept](std::unique_ptr<EventEngine::Endpoint> ep,
+                              MemoryAllocator /*allocator*/) {
+          *accepted = std::move(ep);
+          on_accept->Notify();
+        },
+        [on_shutdown](absl::Status status) {
+          EXPECT_TRUE(status.ok());
+          on_shutdown->Notify();
+        },
+        config_, NewAllocatorFactory());
+    EXPECT_TRUE(listener.ok());
+    auto bound = (*listener)->Bind(LoopbackAddress(0));
+    EXPECT_TRUE(bound.ok()) << bound.status();
+    *port = *bound;
+    EXPECT_TRUE((*listener)->Start().ok());
+    return std::move(*listener);
+  }
+
+  std::unique_ptr<EventEngine::Endpoint> Connect(EventEngine* engine,
+                                                 int port) {
+    absl::Notification connected;
+    std::unique_ptr<EventEngine::Endpoint> endpoint;
+    engine->Connect(
+        [&](absl::StatusOr<std::unique_ptr<EventEngine::Endpoint>> ep) {
+          EXPECT_TRUE(ep.ok()) << ep.status();
+          if (ep.ok()) endpoint = std::move(*ep);
+          connected.Notify();
+        },
+        LoopbackAddress(port), config_, NewAllocator(),
+        absl::Now() + absl::Seconds(10));
+    EXPECT_TRUE(connected.WaitForNotificationWithTimeout(absl::Seconds(10)));
+    return endpoint;
+  }
+
+  // Reads from "endpoint" until "size" bytes arrived or a read fails.
+  absl::Status ReadExactly(EventEngine::Endpoint* endpoint, size_t size,
+                           std::string* out) {
+    while (out->size() < size) {
+      absl::Notification done;
+      absl::Status result;
+      SliceBuffer buffer;
+      EventEngine::Endpoint::ReadArgs args = {
+          static_cast<int64_t>(size - out->size())};
+      endpoint->Read(
+          [&](absl::Status status) {
+            result = status;
+            done.Notify();
+          },
+          &buffer, &args);
+      EXPECT_TRUE(done.WaitForNotificationWithTimeout(absl::Seconds(10)));
+      if (!result.ok()) return result;
+      *out += SliceBufferToString(&buffer);
+    }
+    return absl::OkStatus();
+  }
+
+  absl::Status WriteString(EventEngine::Endpoint* endpoint,
+                           const std::string& data) {
+    absl::Notification done;
+    absl::Status result;
+    SliceBuffer buffer;
+    // Several slices, to exercise the iovec bookkeeping.
+    constexpr size_t kChunk = 1000;
+    for (size_t i = 0; i < data.size(); i += kChunk) {
+      buffer.Append(Slice::FromCopiedString(data.substr(i, kChunk)));
+    }
+    EventEngine::Endpoint::WriteArgs args;
+    endpoint->Write(
+        [&](absl::Status status) {
+          result = status;
+          done.Notify();
+        },
+        &buffer, &args);
+    EXPECT_TRUE(done.WaitForNotificationWithTimeout(absl::Seconds(10)));
+    return result;
+  }
+
+  std::shared_ptr<grpc_core::MemoryQuota> quota_;
+  ChannelArgsEndpointConfig config_{nullptr};
+};
+
+TEST_F(PosixEventEngineTest, RunExecutesOnWorkerThread) {
+  PosixEventEngine engine;
+  absl::Notification done;
+  bool on_worker = false;
+  engine.Run([&]() {
+    on_worker = engine.IsWorkerThread();
+    done.Notify();
+  });
+  ASSERT_TRUE(done.WaitForNotificationWithTimeout(absl::Seconds(5)));
+  EXPECT_TRUE(on_worker);
+  EXPECT_FALSE(engine.IsWorkerThread());
+}
+
+TEST_F(PosixEventEngineTest, TimersRunInDeadlineOrder) {
+  std::vector<int> ordered;
+  grpc_core::Mutex mu;
+  absl::Notification done;
+  {
+    PosixEventEngine engine;
+    absl::Time now = absl::Now();
+    engine.RunAt(now + absl::Milliseconds(300), [&]() {
+      grpc_core::MutexLock lock(&mu);
+      ordered.push_back(3);
+      done.Notify();
+    });
+    engine.RunAt(now + absl::Milliseconds(100), [&]() {
+      grpc_core::MutexLock lock(&mu);
+      ordered.push_back(1);
+    });
+    engine.RunAt(now + absl::Milliseconds(200), [&]() {
+      grpc_core::MutexLock lock(&mu);
+      ordered.push_back(2);
+    });
+    ASSERT_TRUE(done.WaitForNotificationWithTimeout(absl::Seconds(5)));
+  }
+  EXPECT_THAT(ordered, ElementsAre(1, 2, 3));
+}
+
+TEST_F(PosixEventEngineTest, CancelledTimerDoesNotRun) {
+  bool ran = false;
+  {
+    PosixEventEngine engine;
+    auto handle = engine.RunAt(absl::Now() + absl::Milliseconds(200),
+                               [&ran]() { ran = true; });
+    EXPECT_TRUE(engine.Cancel(handle));
+    EXPECT_FALSE(engine.Cancel(handle));
+    absl::SleepFor(absl::Milliseconds(400));
+  }
+  EXPECT_FALSE(ran);
+}
+
+TEST_F(PosixEventEngineTest, EchoOverLoopback) {
+  PosixEventEngine engine;
+  std::unique_ptr<EventEngine::Endpoint> server_endpoint;
+  absl::Notification accepted;
+  absl::Notification listener_shutdown;
+  int port;
+  auto listener = StartListener(&engine, &port, &server_endpoint, &accepted,
+                                &listener_shutdown);
+  std::unique_ptr<EventEngine::Endpoint> client_endpoint =
+      Connect(&engine, port);
+  ASSERT_NE(client_endpoint, nullptr);
+  ASSERT_TRUE(accepted.WaitForNotificationWithTimeout(absl::Seconds(10)));
+  ASSERT_NE(server_endpoint, nullptr);
+  // Large enough to fill the socket buffers, so that writes have to wait.
+  std::string request(4 * 1024 * 1024, 'a');
+  for (size_t i = 0; i < request.size(); i++) {
+    request[i] = static_cast<char>('a' + i % 26);
+  }
+  absl::Notification written;
+  engine.Run([&]() {
+    EXPECT_TRUE(WriteString(client_endpoint.get(), request).ok());
+    written.Notify();
+  });
+  std::string received;
+  ASSERT_TRUE(
+      ReadExactly(server_endpoint.get(), request.size(), &received).ok());
+  ASSERT_TRUE(written.WaitForNotificationWithTimeout(absl::Seconds(10)));
+  EXPECT_EQ(received, request);
+  // And back.
+  ASSERT_TRUE(WriteString(server_endpoint.get(), "pong").ok());
+  std::string reply;
+  ASSERT_TRUE(ReadExactly(client_endpoint.get(), 4, &reply).ok());
+  EXPECT_EQ(reply, "pong");
+  // Closing one side fails the read on the other.
+  server_endpoint.reset();
+  std::string rest;
+  EXPECT_FALSE(ReadExactly(client_endpoint.get(), 1, &rest).ok());
+  client_endpoint.reset();
+  listener.reset();
+  EXPECT_TRUE(
+      listener_shutdown.WaitForNotificationWithTimeout(absl::Seconds(10)));
+}
+
+TEST_F(PosixEventEngineTest, PendingReadFailsOnEndpointDestruction) {
+  PosixEventEngine engine;
+  std::unique_ptr<EventEngine::Endpoint> server_endpoint;
+  absl::Notification accepted;
+  absl::Notification listener_shutdown;
+  int port;
+  auto listener = StartListener(&engine, &port, &server_endpoint, &accepted,
+                                &listener_shutdown);
+  std::unique_ptr<EventEngine::Endpoint> client_endpoint =
+      Connect(&engine, port);
+  ASSERT_NE(client_endpoint, nullptr);
+  ASSERT_TRUE(accepted.WaitForNotificationWithTimeout(absl::Seconds(10)));
+  absl::Notification read_done;
+  absl::Status read_status;
+  SliceBuffer buffer;
+  client_endpoint->Read(
+      [&](absl::Status status) {
+        read_status = status;
+        read_done.Notify();
+      },
+      &buffer, nullptr);
+  client_endpoint.reset();
+  ASSERT_TRUE(read_done.WaitForNotificationWithTimeout(absl::Seconds(10)));
+  EXPECT_EQ(read_status.code(), absl::StatusCode::kCancelled);
+  server_endpoint.reset();
+  listener.reset();
+  EXPECT_TRUE(
+      listener_shutdown.WaitForNotificationWithTimeout(absl::Seconds(10)));
+}
+
+TEST_F(PosixEventEngineTest, ConnectToClosedPortFails) {
+  PosixEventEngine engine;
+  // Bind a port, then close the listener so that nothing accepts on it.
+  int port;
+  {
+    std::unique_ptr<EventEngine::Endpoint> unused;
+    absl::Notification accepted;
+    absl::Notification listener_shutdown;
+    auto listener = StartListener(&engine, &port, &unused, &accepted,
+                                  &listener_shutdown);
+    listener.reset();
+    ASSERT_TRUE(
+        listener_shutdown.WaitForNotificationWithTimeout(absl::Seconds(10)));
+  }
+  absl::Notification connected;
+  absl::Status status;
+  engine.Connect(
+      [&](absl::StatusOr<std::unique_ptr<EventEngine::Endpoint>> ep) {
+        status = ep.status();
+        connected.Notify();
+      },
+      LoopbackAddress(port), config_, NewAllocator(),
+      absl::Now() + absl::Seconds(10));
+  ASSERT_TRUE(connected.WaitForNotificationWithTimeout(absl::Seconds(10)));
+  EXPECT_FALSE(status.ok());
+}
+
+TEST_F(PosixEventEngineTest, CancelConnectAfterCompletionReturnsFalse) {
+  PosixEventEngine engine;
+  std::unique_ptr<EventEngine::Endpoint> server_endpoint;
+  absl::Notification accepted;
+  absl::Notification listener_shutdown;
+  int port;
+  auto listener = StartListener(&engine, &port, &server_endpoint, &accepted,
+                                &listener_shutdown);
+  absl::Notification connected;
+  std::unique_ptr<EventEngine::Endpoint> client_endpoint;
+  EventEngine::ConnectionHandle handle = engine.Connect(
+      [&](absl::StatusOr<std::unique_ptr<EventEngine::Endpoint>> ep) {
+        ASSERT_TRUE(ep.ok()) << ep.status();
+        client_endpoint = std::move(*ep);
+        connected.Notify();
+      },
+      LoopbackAddress(port), config_, NewAllocator(),
+      absl::Now() + absl::Seconds(10));
+  ASSERT_TRUE(connected.WaitForNotificationWithTimeout(absl::Seconds(10)));
+  EXPECT_FALSE(engine.CancelConnect(handle));
+  ASSERT_TRUE(accepted.WaitForNotificationWithTimeout(absl::Seconds(10)));
+  client_endpoint.reset();
+  server_endpoint.reset();
+  listener.reset();
+  EXPECT_TRUE(
+      listener_shutdown.WaitForNotificationWithTimeout(absl::Seconds(10)));
+}
+
+TEST_F(PosixEventEngineTest, LookupLocalhost) {
+  PosixEventEngine engine;
+  auto resolver = engine.GetDNSResolver({});
+  absl::Notification done;
+  absl::StatusOr<std::vector<EventEngine::ResolvedAddress>> result;
+  resolver->LookupHostname(
+      [&](absl::StatusOr<std::vector<EventEngine::ResolvedAddress>> addrs) {
+        result = std::move(addrs);
+        done.Notify();
+      },
+      "localhost", "443", absl::InfiniteFuture());
+  ASSERT_TRUE(done.WaitForNotificationWithTimeout(absl::Seconds(30)));
+  ASSERT_TRUE(result.ok()) << result.status();
+  ASSERT_FALSE(result->empty());
+  for (const auto& addr : *result) {
+    int port = 0;
+    if (addr.address()->sa_family == AF_INET) {
+      port = ntohs(
+          reinterpret_cast<const sockaddr_in*>(addr.address())->sin_port);
+    } else if (addr.address()->sa_family == AF_INET6) {
+      port = ntohs(
+          reinterpret_cast<const sockaddr_in6*>(addr.address())->sin6_port);
+    }
+    EXPECT_EQ(port, 443);
+  }
+}
+
+TEST_F(PosixEventEngineTest, LookupWithoutPortFails) {
+  PosixEventEngine engine;
+  auto resolver = engine.GetDNSResolver({});
+  absl::Notification done;
+  absl::Status status;
+  resolver->LookupHostname(
+      [&](absl::StatusOr<std::vector<EventEngine::ResolvedAddress>> addrs) {
+        status = addrs.status();
+        done.Notify();
+      },
+      "localhost", "", absl::InfiniteFuture());
+  ASSERT_TRUE(done.WaitForNotificationWithTimeout(absl::Seconds(10)));
+  EXPECT_EQ(status.code(), absl::StatusCode::kInvalidArgument);
+}
+
+}  // namespace
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  auto result = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return result;
+}
+
+#else  // GRPC_LINUX_EPOLL
+
+int main(int /*argc*/, char** /*argv*/) { return 0; }
+
+#endif  // GRPC_LINUX_EPOLL
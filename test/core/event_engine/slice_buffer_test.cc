@@ -14,6 +14,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -73,6 +75,36 @@ TEST(SliceBufferTest, SliceRefTest) {
   sb.Clear();
 }
 
+TEST(SliceBufferTest, CSliceBufferTransferTest) {
+  // More slices than a grpc_slice_buffer holds inline, and fewer.
+  for (size_t count : {2, 2 * GRPC_SLICE_BUFFER_INLINE_ELEMENTS}) {
+    grpc_slice_buffer c_slice_buffer;
+    grpc_slice_buffer_init(&c_slice_buffer);
+    std::vector<const uint8_t*> data;
+    for (size_t i = 0; i < count; ++i) {
+      Slice slice = MakeSlice(kNewSliceLength);
+      data.push_back(slice.begin());
+      grpc_slice_buffer_add_indexed(&c_slice_buffer, slice.TakeCSlice());
+    }
+    SliceBuffer sb = SliceBuffer::TakeCSliceBuffer(c_slice_buffer);
+    ASSERT_EQ(c_slice_buffer.count, 0);
+    ASSERT_EQ(c_slice_buffer.length, 0);
+    ASSERT_EQ(sb.Count(), count);
+    ASSERT_EQ(sb.Length(), count * kNewSliceLength);
+    // The slices were not copied.
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(sb.RefSlice(i).begin(), data[i]);
+    }
+    sb.MoveIntoCSliceBuffer(c_slice_buffer);
+    ASSERT_EQ(sb.Count(), 0);
+    ASSERT_EQ(c_slice_buffer.count, count);
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(GRPC_SLICE_START_PTR(c_slice_buffer.slices[i]), data[i]);
+    }
+    grpc_slice_buffer_destroy(&c_slice_buffer);
+  }
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
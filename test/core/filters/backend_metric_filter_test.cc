@@ -0,0 +1,73 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/filters/backend_metrics/backend_metric_filter.h"
+
+#include <gtest/gtest.h>
+
+#include "upb/upb.hpp"
+#include "xds/data/orca/v3/orca_load_report.upb.h"
+
+namespace grpc_core {
+namespace {
+
+TEST(SerializeBackendMetricDataTest, EmptyDataIsNotSerialized) {
+  EXPECT_FALSE(SerializeBackendMetricData(BackendMetricData()).has_value());
+}
+
+TEST(SerializeBackendMetricDataTest, SerializesAllMetrics) {
+  BackendMetricData data;
+  data.cpu_utilization = 0.5;
+  data.mem_utilization = 0.25;
+  data.utilization["foo"] = 0.75;
+  data.request_cost["bar"] = 3;
+  absl::optional<std::string> serialized = SerializeBackendMetricData(data);
+  ASSERT_TRUE(serialized.has_value());
+  upb::Arena arena;
+  xds_data_orca_v3_OrcaLoadReport* report =
+      xds_data_orca_v3_OrcaLoadReport_parse(serialized->data(),
+                                            serialized->size(), arena.ptr());
+  ASSERT_NE(report, nullptr);
+  EXPECT_EQ(xds_data_orca_v3_OrcaLoadReport_cpu_utilization(report), 0.5);
+  EXPECT_EQ(xds_data_orca_v3_OrcaLoadReport_mem_utilization(report), 0.25);
+  double value = 0;
+  EXPECT_TRUE(xds_data_orca_v3_OrcaLoadReport_utilization_get(
+      report, upb_StringView_FromString("foo"), &value));
+  EXPECT_EQ(value, 0.75);
+  EXPECT_TRUE(xds_data_orca_v3_OrcaLoadReport_request_cost_get(
+      report, upb_StringView_FromString("bar"), &value));
+  EXPECT_EQ(value, 3);
+}
+
+TEST(SerializeBackendMetricDataTest, OmitsUnsetUtilization) {
+  BackendMetricData data;
+  data.request_cost["bar"] = 1;
+  absl::optional<std::string> serialized = SerializeBackendMetricData(data);
+  ASSERT_TRUE(serialized.has_value());
+  upb::Arena arena;
+  xds_data_orca_v3_OrcaLoadReport* report =
+      xds_data_orca_v3_OrcaLoadReport_parse(serialized->data(),
+                                            serialized->size(), arena.ptr());
+  ASSERT_NE(report, nullptr);
+  EXPECT_EQ(xds_data_orca_v3_OrcaLoadReport_cpu_utilization(report), 0);
+  EXPECT_EQ(xds_data_orca_v3_OrcaLoadReport_mem_utilization(report), 0);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
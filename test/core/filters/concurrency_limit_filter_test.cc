@@ -0,0 +1,98 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/filters/concurrency_limit/concurrency_limit_filter.h"
+
+#include <gtest/gtest.h>
+
+namespace grpc_core {
+namespace {
+
+AdaptiveConcurrencyLimit::Options TestOptions() {
+  AdaptiveConcurrencyLimit::Options options;
+  options.initial_limit = 20;
+  options.min_limit = 5;
+  options.max_limit = 200;
+  return options;
+}
+
+// Keeps the limit saturated: fills every slot, then completes them all with
+// the given latency.
+void RunRound(AdaptiveConcurrencyLimit* limit, double latency_us) {
+  uint32_t admitted = 0;
+  while (limit->TryAcquire()) admitted++;
+  for (uint32_t i = 0; i < admitted; i++) limit->Release(latency_us);
+}
+
+TEST(AdaptiveConcurrencyLimitTest, RejectsAtLimit) {
+  auto limit = MakeRefCounted<AdaptiveConcurrencyLimit>(TestOptions());
+  for (int i = 0; i < 20; i++) EXPECT_TRUE(limit->TryAcquire());
+  EXPECT_FALSE(limit->TryAcquire());
+  EXPECT_EQ(limit->in_flight(), 20);
+  limit->Release(absl::nullopt);
+  EXPECT_TRUE(limit->TryAcquire());
+  for (int i = 0; i < 20; i++) limit->Release(absl::nullopt);
+  EXPECT_EQ(limit->in_flight(), 0);
+  // Dropped calls leave the limit alone.
+  EXPECT_EQ(limit->limit(), 20);
+}
+
+TEST(AdaptiveConcurrencyLimitTest, GrowsWhileLatencyIsSteady) {
+  auto limit = MakeRefCounted<AdaptiveConcurrencyLimit>(TestOptions());
+  for (int i = 0; i < 50; i++) RunRound(limit.get(), 1000);
+  EXPECT_GT(limit->limit(), 20);
+  EXPECT_LE(limit->limit(), 200);
+}
+
+TEST(AdaptiveConcurrencyLimitTest, ShrinksWhenLatencyRises) {
+  auto limit = MakeRefCounted<AdaptiveConcurrencyLimit>(TestOptions());
+  for (int i = 0; i < 20; i++) RunRound(limit.get(), 1000);
+  uint32_t grown = limit->limit();
+  RunRound(limit.get(), 10000);
+  RunRound(limit.get(), 10000);
+  EXPECT_LT(limit->limit(), grown);
+  EXPECT_GE(limit->limit(), 5);
+}
+
+TEST(AdaptiveConcurrencyLimitTest, DoesNotGrowWhenIdle) {
+  auto limit = MakeRefCounted<AdaptiveConcurrencyLimit>(TestOptions());
+  for (int i = 0; i < 1000; i++) {
+    ASSERT_TRUE(limit->TryAcquire());
+    limit->Release(1000);
+  }
+  EXPECT_EQ(limit->limit(), 20);
+}
+
+TEST(AdaptiveConcurrencyLimitTest, ReportsSignificantChanges) {
+  auto limit = MakeRefCounted<AdaptiveConcurrencyLimit>(TestOptions());
+  absl::optional<uint32_t> reported;
+  while (!reported.has_value()) {
+    uint32_t admitted = 0;
+    while (limit->TryAcquire()) admitted++;
+    for (uint32_t i = 0; i < admitted; i++) {
+      auto changed = limit->Release(1000);
+      if (changed.has_value()) reported = changed;
+    }
+  }
+  EXPECT_GT(*reported, 24);
+  EXPECT_GE(limit->limit(), *reported);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
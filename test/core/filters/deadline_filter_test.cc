@@ -0,0 +1,275 @@
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/filters/deadline/deadline_filter.h"
+
+#include <string.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+#include <grpc/grpc_security.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/host_port.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+Timestamp MonotonicNow() {
+  return Timestamp::FromTimespecRoundDown(gpr_now(GPR_CLOCK_MONOTONIC));
+}
+
+// How late a timer may run beyond its deadline because of scheduling.
+Duration TimerSlack() {
+  return Duration::Milliseconds(100 * grpc_test_slowdown_factor());
+}
+
+// A call waiting in the wheel, recording how its on_done ran.
+class WheelCall {
+ public:
+  WheelCall() {
+    gpr_event_init(&done_);
+    GRPC_CLOSURE_INIT(&on_done_, OnDone, this, nullptr);
+  }
+
+  void Add(Timestamp deadline, Duration granularity) {
+    deadline_ = deadline;
+    DeadlineWheel::Get()->Add(&entry_, deadline, granularity, &on_done_);
+  }
+
+  void Cancel() { DeadlineWheel::Get()->Cancel(&entry_); }
+
+  bool WaitForDone(Duration timeout) {
+    return gpr_event_wait(&done_, grpc_timeout_milliseconds_to_deadline(
+                                      timeout.millis())) != nullptr;
+  }
+
+  Timestamp deadline() const { return deadline_; }
+  Timestamp done_at() const { return done_at_; }
+  bool cancelled() const { return cancelled_; }
+  int runs() const { return runs_.load(); }
+
+ private:
+  static void OnDone(void* arg, grpc_error_handle error) {
+    WheelCall* self = static_cast<WheelCall*>(arg);
+    self->done_at_ = MonotonicNow();
+    self->cancelled_ = error == GRPC_ERROR_CANCELLED;
+    self->runs_.fetch_add(1);
+    gpr_event_set(&self->done_, reinterpret_cast<void*>(1));
+  }
+
+  DeadlineWheel::Entry entry_;
+  grpc_closure on_done_;
+  gpr_event done_;
+  Timestamp deadline_;
+  Timestamp done_at_;
+  bool cancelled_ = false;
+  std::atomic<int> runs_{0};
+};
+
+TEST(DeadlineWheelTest, ExpiresNeverEarlyAndAtMostOneGranularityLate) {
+  const Duration granularity = Duration::Milliseconds(100);
+  std::vector<WheelCall> calls(8);
+  {
+    ExecCtx exec_ctx;
+    const Timestamp now = MonotonicNow();
+    for (size_t i = 0; i < calls.size(); ++i) {
+      // Deadlines at various offsets within and across granules.
+      calls[i].Add(now + Duration::Milliseconds(50 + 37 * i), granularity);
+    }
+  }
+  for (WheelCall& call : calls) {
+    ASSERT_TRUE(call.WaitForDone(Duration::Seconds(10)));
+    EXPECT_FALSE(call.cancelled());
+    EXPECT_GE(call.done_at(), call.deadline());
+    EXPECT_LE(call.done_at(), call.deadline() + granularity + TimerSlack());
+  }
+}
+
+TEST(DeadlineWheelTest, CancelBeforeExpiry) {
+  WheelCall call;
+  {
+    ExecCtx exec_ctx;
+    call.Add(MonotonicNow() + Duration::Milliseconds(200),
+             Duration::Milliseconds(100));
+    call.Cancel();
+  }
+  ASSERT_TRUE(call.WaitForDone(Duration::Zero()));
+  EXPECT_TRUE(call.cancelled());
+  EXPECT_LT(call.done_at(), call.deadline());
+  // The timer of the bucket still fires, but must not run on_done again.
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(
+      (Duration::Milliseconds(300) + TimerSlack()).millis()));
+  EXPECT_EQ(call.runs(), 1);
+}
+
+TEST(DeadlineWheelTest, CancelAfterExpiryIsNoop) {
+  WheelCall call;
+  {
+    ExecCtx exec_ctx;
+    call.Add(MonotonicNow() + Duration::Milliseconds(10),
+             Duration::Milliseconds(10));
+  }
+  ASSERT_TRUE(call.WaitForDone(Duration::Seconds(10)));
+  {
+    ExecCtx exec_ctx;
+    call.Cancel();
+  }
+  EXPECT_FALSE(call.cancelled());
+  EXPECT_EQ(call.runs(), 1);
+}
+
+TEST(DeadlineWheelTest, ManyCallsShareOneBucket) {
+  const Duration granularity = Duration::Milliseconds(200);
+  std::vector<WheelCall> calls(256);
+  {
+    ExecCtx exec_ctx;
+    // All the deadlines round up to the same multiple of the granularity.
+    const int64_t granule = (MonotonicNow() + Duration::Milliseconds(300))
+                                .milliseconds_after_process_epoch() /
+                            granularity.millis();
+    const Timestamp start = Timestamp::FromMillisecondsAfterProcessEpoch(
+                                granule * granularity.millis()) +
+                            Duration::Milliseconds(1);
+    for (size_t i = 0; i < calls.size(); ++i) {
+      calls[i].Add(start + Duration::Milliseconds(i % 150), granularity);
+    }
+    // Cancel calls at the head, in the middle and at the tail of the lists
+    // of the buckets.
+    for (size_t i = 0; i < calls.size(); i += 3) calls[i].Cancel();
+  }
+  for (size_t i = 0; i < calls.size(); ++i) {
+    ASSERT_TRUE(calls[i].WaitForDone(Duration::Seconds(10)));
+    EXPECT_EQ(calls[i].cancelled(), i % 3 == 0) << i;
+    if (i % 3 != 0) {
+      EXPECT_GE(calls[i].done_at(), calls[i].deadline()) << i;
+    }
+  }
+  for (WheelCall& call : calls) EXPECT_EQ(call.runs(), 1);
+}
+
+// Deadlines of calls on a client channel are enforced by the client_channel
+// filter, which must honor the granularity too.
+class ClientChannelDeadlineTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    cq_ = grpc_completion_queue_create_for_next(nullptr);
+    address_ = JoinHostPort("localhost", grpc_pick_unused_port_or_die());
+    // Only the client enforces the deadline.
+    grpc_arg arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_ENABLE_DEADLINE_CHECKS), 0);
+    grpc_channel_args args = {1, &arg};
+    server_ = grpc_server_create(&args, nullptr);
+    grpc_server_register_completion_queue(server_, cq_, nullptr);
+    grpc_server_credentials* server_creds =
+        grpc_insecure_server_credentials_create();
+    ASSERT_TRUE(
+        grpc_server_add_http2_port(server_, address_.c_str(), server_creds));
+    grpc_server_credentials_release(server_creds);
+    grpc_server_start(server_);
+  }
+
+  void TearDown() override {
+    grpc_server_shutdown_and_notify(server_, cq_, nullptr);
+    grpc_server_cancel_all_calls(server_);
+    grpc_event ev = grpc_completion_queue_next(
+        cq_, grpc_timeout_seconds_to_deadline(10), nullptr);
+    EXPECT_EQ(ev.type, GRPC_OP_COMPLETE);
+    EXPECT_EQ(ev.tag, nullptr);
+    grpc_server_destroy(server_);
+    grpc_completion_queue_shutdown(cq_);
+    while (grpc_completion_queue_next(cq_, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(cq_);
+  }
+
+  // Runs a call that the server never answers, and returns its status and
+  // how long after the call's deadline it completed.
+  grpc_status_code RunCallToDeadline(Duration timeout, Duration granularity,
+                                     Duration* late) {
+    grpc_arg arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_DEADLINE_TIMER_GRANULARITY_MS),
+        granularity.millis());
+    grpc_channel_args args = {1, &arg};
+    grpc_channel_credentials* creds = grpc_insecure_credentials_create();
+    grpc_channel* channel = grpc_channel_create(address_.c_str(), creds, &args);
+    grpc_channel_credentials_release(creds);
+    const Timestamp deadline = MonotonicNow() + timeout;
+    grpc_call* call = grpc_channel_create_call(
+        channel, nullptr, GRPC_PROPAGATE_DEFAULTS, cq_,
+        grpc_slice_from_static_string("/foo"), nullptr,
+        deadline.as_timespec(GPR_CLOCK_MONOTONIC), nullptr);
+    grpc_metadata_array trailing_metadata;
+    grpc_metadata_array_init(&trailing_metadata);
+    grpc_status_code status;
+    grpc_slice details;
+    grpc_op ops[2];
+    memset(ops, 0, sizeof(ops));
+    ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+    ops[1].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+    ops[1].data.recv_status_on_client.trailing_metadata = &trailing_metadata;
+    ops[1].data.recv_status_on_client.status = &status;
+    ops[1].data.recv_status_on_client.status_details = &details;
+    EXPECT_EQ(GRPC_CALL_OK, grpc_call_start_batch(call, ops, 2,
+                                                  reinterpret_cast<void*>(1),
+                                                  nullptr));
+    grpc_event ev = grpc_completion_queue_next(
+        cq_, grpc_timeout_seconds_to_deadline(10), nullptr);
+    *late = MonotonicNow() - deadline;
+    EXPECT_EQ(ev.type, GRPC_OP_COMPLETE);
+    EXPECT_EQ(ev.tag, reinterpret_cast<void*>(1));
+    grpc_slice_unref(details);
+    grpc_metadata_array_destroy(&trailing_metadata);
+    grpc_call_unref(call);
+    grpc_channel_destroy(channel);
+    return status;
+  }
+
+  std::string address_;
+  grpc_server* server_ = nullptr;
+  grpc_completion_queue* cq_ = nullptr;
+};
+
+TEST_F(ClientChannelDeadlineTest, EnforcesDeadlineWithinGranularity) {
+  const Duration granularity = Duration::Milliseconds(200);
+  Duration late;
+  EXPECT_EQ(RunCallToDeadline(Duration::Milliseconds(500), granularity, &late),
+            GRPC_STATUS_DEADLINE_EXCEEDED);
+  EXPECT_GE(late, Duration::Zero());
+  EXPECT_LE(late, granularity + TimerSlack());
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -120,6 +120,24 @@ static void concurrent_test(void) {
   args.arena->Destroy();
 }
 
+static void test_pooled_reuse(void) {
+  gpr_log(GPR_INFO, "test_pooled_reuse");
+  // The whole initial zone of a recycled buffer must be usable, whatever size
+  // the arena that previously owned it asked for.
+  for (size_t initial_size : {1, 100, 1000, 5000, 1000, 100, 1}) {
+    for (int i = 0; i < 10; i++) {
+      Arena* a = Arena::Create(initial_size, g_memory_allocator);
+      memset(a->Alloc(initial_size), 0xab, initial_size);
+      a->Destroy();
+    }
+  }
+  Arena::TestOnlySetBlockPoolEnabled(false);
+  Arena* a = Arena::Create(100, g_memory_allocator);
+  Arena::TestOnlySetBlockPoolEnabled(true);
+  memset(a->Alloc(100), 0xab, 100);
+  a->Destroy();
+}
+
 int main(int argc, char* argv[]) {
   grpc::testing::TestEnvironment env(&argc, argv);
 
@@ -131,6 +149,7 @@ int main(int argc, char* argv[]) {
   TEST(1_inc, 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11);
   TEST(6_123, 6, 1, 2, 3);
   concurrent_test();
+  test_pooled_reuse();
 
   return 0;
 }
@@ -22,7 +22,9 @@
 #include <gtest/gtest.h>
 
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
 
+#include "src/core/lib/gpr/log_async.h"
 #include "src/core/lib/gprpp/global_config.h"
 #include "test/core/util/test_config.h"
 
@@ -88,6 +90,36 @@ TEST(LogTest, LogVerbosity) {
   test_log_function_unreached(GPR_DEBUG);
 }
 
+// Waits for the asynchronous log to have written `count` messages in all.
+static void wait_for_async_log_written(uint64_t count) {
+  gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+  while (gpr_async_log_get_stats().written < count) {
+    GPR_ASSERT(gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0);
+    gpr_async_log_flush();
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+  }
+}
+
+TEST(LogTest, AsyncLog) {
+  gpr_set_log_verbosity(GPR_LOG_SEVERITY_INFO);
+  gpr_set_log_function(gpr_async_log);
+  gpr_async_log_stats before = gpr_async_log_get_stats();
+  for (int i = 0; i < 10; ++i) {
+    gpr_log(GPR_INFO, "async %d", i);
+  }
+  wait_for_async_log_written(before.written + 10);
+  // A single log statement is limited to GRPC_ASYNC_LOG_RATE_LIMIT (100 by
+  // default) messages per second, so at most 200 of these are written even
+  // if they straddle two seconds.
+  for (int i = 0; i < 1000; ++i) {
+    gpr_log(GPR_INFO, "rate limited %d", i);
+  }
+  gpr_async_log_stats after = gpr_async_log_get_stats();
+  EXPECT_GE(after.dropped_rate_limited - before.dropped_rate_limited, 800);
+  EXPECT_EQ(after.dropped_queue_full, before.dropped_queue_full);
+  gpr_set_log_function(nullptr);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
@@ -28,6 +28,8 @@
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/gpr/env.h"
+#include "src/core/lib/gpr/time_precise.h"
 #include "test/core/util/test_config.h"
 
 static void to_fp(void* arg, const char* buf, size_t len) {
@@ -254,6 +256,21 @@ static void test_cmp_extreme(void) {
   GPR_ASSERT(gpr_time_cmp(t1, t2) == 0);
 }
 
+static void test_fast_monotonic_now(void) {
+  gpr_setenv("GRPC_FAST_CLOCK", "true");
+  gpr_fast_clock_init();
+  gpr_timespec tolerance = gpr_time_from_millis(100, GPR_TIMESPAN);
+  gpr_timespec last = gpr_fast_monotonic_now();
+  for (int i = 0; i < 1000; ++i) {
+    gpr_timespec fast = gpr_fast_monotonic_now();
+    GPR_ASSERT(fast.clock_type == GPR_CLOCK_MONOTONIC);
+    GPR_ASSERT(gpr_time_cmp(fast, last) >= 0);
+    GPR_ASSERT(gpr_time_similar(fast, gpr_now(GPR_CLOCK_MONOTONIC), tolerance));
+    last = fast;
+  }
+  gpr_unsetenv("GRPC_FAST_CLOCK");
+}
+
 int main(int argc, char* argv[]) {
   grpc::testing::TestEnvironment env(&argc, argv);
 
@@ -264,5 +281,6 @@ int main(int argc, char* argv[]) {
   test_similar();
   test_convert_extreme();
   test_cmp_extreme();
+  test_fast_monotonic_now();
   return 0;
 }
@@ -0,0 +1,92 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/gprpp/alias_table.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+constexpr uint64_t kStepsPerColumn = 1000;
+
+// Samples the table on an even grid: kStepsPerColumn random numbers for
+// each column.  Returns how often each index was picked.
+std::vector<uint64_t> SampleGrid(const AliasTable& table) {
+  std::vector<uint64_t> counts(table.size());
+  const uint64_t n = table.size();
+  for (uint64_t column = 0; column < n; ++column) {
+    // The smallest high half that maps to this column.
+    uint64_t high = ((column << 32) + n - 1) / n;
+    for (uint64_t step = 0; step < kStepsPerColumn; ++step) {
+      uint64_t low = (step << 32) / kStepsPerColumn;
+      ++counts[table.Sample((high << 32) | low)];
+    }
+  }
+  return counts;
+}
+
+void ExpectProportional(const std::vector<uint32_t>& weights) {
+  AliasTable table(weights);
+  ASSERT_EQ(table.size(), weights.size());
+  std::vector<uint64_t> counts = SampleGrid(table);
+  uint64_t total_weight = 0;
+  for (uint32_t weight : weights) total_weight += weight;
+  const double total_samples =
+      static_cast<double>(kStepsPerColumn * weights.size());
+  for (size_t i = 0; i < weights.size(); ++i) {
+    EXPECT_NEAR(counts[i] / total_samples,
+                static_cast<double>(weights[i]) / total_weight, 0.002)
+        << "index " << i;
+    if (weights[i] == 0) {
+      EXPECT_EQ(counts[i], 0) << "index " << i;
+    }
+  }
+}
+
+TEST(AliasTableTest, SingleWeight) {
+  AliasTable table(std::vector<uint32_t>{7});
+  EXPECT_EQ(table.Sample(0), 0);
+  EXPECT_EQ(table.Sample(~uint64_t(0)), 0);
+}
+
+TEST(AliasTableTest, EqualWeights) { ExpectProportional({5, 5, 5, 5, 5}); }
+
+TEST(AliasTableTest, UnequalWeights) { ExpectProportional({1, 2, 3, 4}); }
+
+TEST(AliasTableTest, ZeroWeightsAreNeverPicked) {
+  ExpectProportional({0, 1, 0, 3, 0});
+}
+
+TEST(AliasTableTest, SkewedWeights) {
+  ExpectProportional({1000000, 1, 1, 1, 1, 1, 1, 1});
+}
+
+TEST(AliasTableTest, ManyWeights) {
+  std::vector<uint32_t> weights;
+  for (uint32_t i = 1; i <= 100; ++i) weights.push_back(i * i);
+  ExpectProportional(weights);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
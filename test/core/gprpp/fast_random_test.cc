@@ -0,0 +1,89 @@
+// Copyright 2022 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/gprpp/fast_random.h"
+
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/random/random.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+TEST(FastRandomTest, DoesNotRepeat) {
+  std::set<uint64_t> seen;
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(seen.insert(FastRandom64()).second);
+  }
+}
+
+TEST(FastRandomTest, ThreadsGetDifferentSequences) {
+  uint64_t values[2];
+  std::thread t0([&values] { values[0] = FastRandom64(); });
+  std::thread t1([&values] { values[1] = FastRandom64(); });
+  t0.join();
+  t1.join();
+  EXPECT_NE(values[0], values[1]);
+}
+
+TEST(FastRandomTest, UniformIsInRangeAndCoversIt) {
+  constexpr uint32_t kRange = 10;
+  constexpr int kSamples = 100000;
+  std::vector<int> counts(kRange);
+  for (int i = 0; i < kSamples; ++i) {
+    uint32_t value = FastRandomUniform(kRange);
+    ASSERT_LT(value, kRange);
+    ++counts[value];
+  }
+  // Each count is binomial with mean 10000 and a standard deviation of 95.
+  for (int count : counts) {
+    EXPECT_GT(count, kSamples / kRange - 1000);
+    EXPECT_LT(count, kSamples / kRange + 1000);
+  }
+}
+
+TEST(FastRandomTest, DoubleIsInUnitInterval) {
+  double sum = 0;
+  constexpr int kSamples = 100000;
+  for (int i = 0; i < kSamples; ++i) {
+    double value = FastRandomDouble();
+    ASSERT_GE(value, 0);
+    ASSERT_LT(value, 1);
+    sum += value;
+  }
+  EXPECT_NEAR(sum / kSamples, 0.5, 0.01);
+}
+
+TEST(FastRandomTest, WorksWithAbslDistributions) {
+  FastRandomBitGen bit_gen;
+  for (int i = 0; i < 1000; ++i) {
+    double value = absl::Uniform(bit_gen, -1.0, 1.0);
+    EXPECT_GE(value, -1.0);
+    EXPECT_LT(value, 1.0);
+  }
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
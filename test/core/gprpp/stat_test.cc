@@ -62,6 +62,40 @@ TEST(STAT, GetTimestampOnFailure) {
   EXPECT_EQ(timestamp, 0);
 }
 
+TEST(STAT, GetFileVersionChangesOnWrite) {
+  FILE* tmp = nullptr;
+  char* tmp_name;
+  tmp = gpr_tmpfile("prefix", &tmp_name);
+  ASSERT_NE(tmp_name, nullptr);
+  ASSERT_NE(tmp, nullptr);
+  fclose(tmp);
+  FileVersion before;
+  absl::Status status = GetFileVersion(tmp_name, &before);
+  if (status.code() != absl::StatusCode::kUnimplemented) {
+    EXPECT_EQ(status.code(), absl::StatusCode::kOk);
+    FileVersion unchanged;
+    EXPECT_EQ(GetFileVersion(tmp_name, &unchanged).code(),
+              absl::StatusCode::kOk);
+    EXPECT_EQ(before, unchanged);
+    tmp = fopen(tmp_name, "a");
+    ASSERT_NE(tmp, nullptr);
+    fputs("data", tmp);
+    fclose(tmp);
+    FileVersion after;
+    EXPECT_EQ(GetFileVersion(tmp_name, &after).code(), absl::StatusCode::kOk);
+    EXPECT_NE(before, after);
+  }
+  // Clean up.
+  remove(tmp_name);
+  gpr_free(tmp_name);
+}
+
+TEST(STAT, GetFileVersionOnFailure) {
+  FileVersion version;
+  absl::Status status = GetFileVersion("/DOES_NOT_EXIST", &version);
+  EXPECT_NE(status.code(), absl::StatusCode::kOk);
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc_core
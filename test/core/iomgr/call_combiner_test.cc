@@ -0,0 +1,230 @@
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/iomgr/call_combiner.h"
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "absl/synchronization/barrier.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// An action that must run with the call combiner held, and which checks
+// that no other action holds it at the same time.
+class Action {
+ public:
+  Action(CallCombiner* call_combiner, std::atomic<int>* holders)
+      : call_combiner_(call_combiner), holders_(holders) {
+    GRPC_CLOSURE_INIT(&closure_, Run, this, nullptr);
+  }
+
+  // Runs the action inline if the call combiner is idle, or queues it
+  // otherwise, like FilterStackCall::ExecuteBatch() does.
+  void StartInlineIfIdle() {
+    if (call_combiner_->TryStartInline("inline action")) {
+      RunLocked();
+    } else {
+      GRPC_CALL_COMBINER_START(call_combiner_, &closure_, GRPC_ERROR_NONE,
+                               "queued action");
+    }
+  }
+
+  void Start() {
+    GRPC_CALL_COMBINER_START(call_combiner_, &closure_, GRPC_ERROR_NONE,
+                             "queued action");
+  }
+
+  // Runs before the action yields the call combiner, if set.
+  void set_while_held(std::function<void()> while_held) {
+    while_held_ = std::move(while_held);
+  }
+
+  int runs() const { return runs_.load(); }
+  bool overlapped() const { return overlapped_.load(); }
+
+ private:
+  static void Run(void* arg, grpc_error_handle /*error*/) {
+    static_cast<Action*>(arg)->RunLocked();
+  }
+
+  void RunLocked() {
+    if (holders_->fetch_add(1) != 0) overlapped_.store(true);
+    if (while_held_ != nullptr) while_held_();
+    runs_.fetch_add(1);
+    holders_->fetch_sub(1);
+    GRPC_CALL_COMBINER_STOP(call_combiner_, "action done");
+  }
+
+  CallCombiner* call_combiner_;
+  std::atomic<int>* holders_;
+  grpc_closure closure_;
+  std::function<void()> while_held_;
+  std::atomic<int> runs_{0};
+  std::atomic<bool> overlapped_{false};
+};
+
+// Records how a notify-on-cancel closure ran.
+class CancelNotification {
+ public:
+  CancelNotification() {
+    GRPC_CLOSURE_INIT(&closure_, Run, this, nullptr);
+  }
+
+  grpc_closure* closure() { return &closure_; }
+  int runs() const { return runs_.load(); }
+  bool cancelled() const { return cancelled_.load(); }
+
+ private:
+  static void Run(void* arg, grpc_error_handle error) {
+    CancelNotification* self = static_cast<CancelNotification*>(arg);
+    self->cancelled_.store(error != GRPC_ERROR_NONE);
+    self->runs_.fetch_add(1);
+  }
+
+  grpc_closure closure_;
+  std::atomic<int> runs_{0};
+  std::atomic<bool> cancelled_{false};
+};
+
+bool InlineStartSupported() {
+#ifdef GRPC_TSAN_ENABLED
+  return false;
+#else
+  return true;
+#endif
+}
+
+TEST(CallCombinerTest, TryStartInlineTakesIdleCombiner) {
+  if (!InlineStartSupported()) return;
+  ExecCtx exec_ctx;
+  CallCombiner call_combiner;
+  std::atomic<int> holders{0};
+  Action queued(&call_combiner, &holders);
+  ASSERT_TRUE(call_combiner.TryStartInline("test"));
+  // Work started while the combiner is held inline waits for it.
+  queued.Start();
+  ExecCtx::Get()->Flush();
+  EXPECT_EQ(queued.runs(), 0);
+  GRPC_CALL_COMBINER_STOP(&call_combiner, "test done");
+  ExecCtx::Get()->Flush();
+  EXPECT_EQ(queued.runs(), 1);
+  // The combiner is idle again.
+  ASSERT_TRUE(call_combiner.TryStartInline("test"));
+  GRPC_CALL_COMBINER_STOP(&call_combiner, "test done");
+}
+
+TEST(CallCombinerTest, TryStartInlineFailsWhenBusy) {
+  ExecCtx exec_ctx;
+  CallCombiner call_combiner;
+  std::atomic<int> holders{0};
+  Action running(&call_combiner, &holders);
+  running.set_while_held(
+      [&]() { EXPECT_FALSE(call_combiner.TryStartInline("test")); });
+  running.Start();
+  ExecCtx::Get()->Flush();
+  EXPECT_EQ(running.runs(), 1);
+  // A closure that is queued but has not run yet keeps the combiner busy.
+  Action first(&call_combiner, &holders);
+  Action second(&call_combiner, &holders);
+  first.Start();
+  second.StartInlineIfIdle();
+  ExecCtx::Get()->Flush();
+  EXPECT_EQ(first.runs(), 1);
+  EXPECT_EQ(second.runs(), 1);
+  EXPECT_FALSE(first.overlapped());
+  EXPECT_FALSE(second.overlapped());
+}
+
+TEST(CallCombinerTest, CancelWhileHeldInline) {
+  if (!InlineStartSupported()) return;
+  ExecCtx exec_ctx;
+  CallCombiner call_combiner;
+  std::atomic<int> holders{0};
+  CancelNotification notification;
+  ASSERT_TRUE(call_combiner.TryStartInline("test"));
+  call_combiner.SetNotifyOnCancel(notification.closure());
+  // As in cancel_with_error(): the cancellation is signalled right away, and
+  // the cancel batch waits for the combiner.
+  Action cancel_batch(&call_combiner, &holders);
+  std::thread canceller([&]() {
+    ExecCtx exec_ctx;
+    call_combiner.Cancel(GRPC_ERROR_CANCELLED);
+    cancel_batch.Start();
+  });
+  canceller.join();
+  EXPECT_EQ(notification.runs(), 1);
+  EXPECT_TRUE(notification.cancelled());
+  EXPECT_EQ(cancel_batch.runs(), 0);
+  GRPC_CALL_COMBINER_STOP(&call_combiner, "test done");
+  ExecCtx::Get()->Flush();
+  EXPECT_EQ(cancel_batch.runs(), 1);
+}
+
+// A batch started inline if possible races with a cancellation, which first
+// cancels the combiner and then queues its own batch. Whichever wins, the
+// batches never hold the combiner together, both run exactly once, and the
+// batch's notify-on-cancel closure sees the cancellation.
+TEST(CallCombinerTest, InlineStartRacesWithCancellation) {
+  for (int i = 0; i < 1000; ++i) {
+    CallCombiner call_combiner;
+    std::atomic<int> holders{0};
+    CancelNotification notification;
+    Action batch(&call_combiner, &holders);
+    batch.set_while_held(
+        [&]() { call_combiner.SetNotifyOnCancel(notification.closure()); });
+    Action cancel_batch(&call_combiner, &holders);
+    absl::Barrier* barrier = new absl::Barrier(2);
+    std::thread starter([&]() {
+      ExecCtx exec_ctx;
+      if (barrier->Block()) delete barrier;
+      batch.StartInlineIfIdle();
+    });
+    std::thread canceller([&]() {
+      ExecCtx exec_ctx;
+      if (barrier->Block()) delete barrier;
+      call_combiner.Cancel(GRPC_ERROR_CANCELLED);
+      cancel_batch.Start();
+    });
+    starter.join();
+    canceller.join();
+    ASSERT_EQ(batch.runs(), 1);
+    ASSERT_EQ(cancel_batch.runs(), 1);
+    ASSERT_FALSE(batch.overlapped());
+    ASSERT_FALSE(cancel_batch.overlapped());
+    ASSERT_EQ(notification.runs(), 1);
+    ASSERT_TRUE(notification.cancelled());
+  }
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -21,11 +21,17 @@
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/thd_id.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "test/core/util/test_config.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_combiner_offload_run_us);
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_combiner_offload_queue_depth);
+
 static void test_no_op(void) {
   gpr_log(GPR_DEBUG, "test_no_op");
   grpc_core::ExecCtx exec_ctx;
@@ -136,12 +142,174 @@ static void test_execute_finally(void) {
   GRPC_COMBINER_UNREF(lock, "test_execute_finally");
 }
 
+typedef struct {
+  size_t* ctr;
+  size_t value;
+  grpc_closure closure;
+} ordered_args;
+
+static void check_order(void* a, grpc_error_handle /*error*/) {
+  ordered_args* args = static_cast<ordered_args*>(a);
+  GPR_ASSERT(*args->ctr == args->value - 1);
+  *args->ctr = args->value;
+}
+
+static void test_flush_with_budget(void) {
+  gpr_log(GPR_DEBUG, "test_flush_with_budget");
+
+  grpc_core::ExecCtx exec_ctx;
+  size_t ctr = 0;
+  ordered_args args[10];
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(args); i++) {
+    args[i].ctr = &ctr;
+    args[i].value = i + 1;
+    grpc_core::ExecCtx::Run(
+        DEBUG_LOCATION,
+        GRPC_CLOSURE_INIT(&args[i].closure, check_order, &args[i], nullptr),
+        GRPC_ERROR_NONE);
+  }
+  // The closures beyond the budget stay queued, in order.
+  GPR_ASSERT(grpc_core::ExecCtx::Get()->FlushWithBudget(3) == 3);
+  GPR_ASSERT(ctr == 3);
+  GPR_ASSERT(grpc_core::ExecCtx::Get()->HasWork());
+  GPR_ASSERT(grpc_core::ExecCtx::Get()->FlushWithBudget(100) == 7);
+  GPR_ASSERT(ctr == 10);
+  GPR_ASSERT(!grpc_core::ExecCtx::Get()->HasWork());
+
+  // An active combiner is run until it is released, even without budget.
+  grpc_core::Combiner* lock = grpc_combiner_create();
+  gpr_event done;
+  gpr_event_init(&done);
+  lock->Run(GRPC_CLOSURE_CREATE(set_event_to_true, &done, nullptr),
+            GRPC_ERROR_NONE);
+  GPR_ASSERT(grpc_core::ExecCtx::Get()->FlushWithBudget(0) > 0);
+  GPR_ASSERT(gpr_event_get(&done) != nullptr);
+  GPR_ASSERT(!grpc_core::ExecCtx::Get()->HasWork());
+  GRPC_COMBINER_UNREF(lock, "test_flush_with_budget");
+}
+
+static void set_offload_thresholds(int32_t run_us, int32_t queue_depth) {
+  GPR_GLOBAL_CONFIG_SET(grpc_combiner_offload_run_us, run_us);
+  GPR_GLOBAL_CONFIG_SET(grpc_combiner_offload_queue_depth, queue_depth);
+  grpc_combiner_global_init();
+}
+
+typedef struct {
+  int sleep_ms;
+  gpr_thd_id thread;
+  gpr_event done;
+  grpc_closure closure;
+} offload_args;
+
+static void record_thread(void* a, grpc_error_handle /*error*/) {
+  offload_args* args = static_cast<offload_args*>(a);
+  if (args->sleep_ms > 0) {
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(args->sleep_ms));
+  }
+  args->thread = gpr_thd_currentid();
+  gpr_event_set(&args->done, reinterpret_cast<void*>(1));
+}
+
+// Queues the closures on a new combiner from this thread, and waits for them
+// all to run. Returns how many times the combiner was offloaded.
+static int64_t run_on_combiner(offload_args* args, size_t count) {
+  grpc_stats_data before;
+  grpc_stats_data after;
+  grpc_stats_data diff;
+  grpc_stats_collect(&before);
+  grpc_core::Combiner* lock = grpc_combiner_create();
+  {
+    grpc_core::ExecCtx exec_ctx;
+    for (size_t i = 0; i < count; i++) {
+      gpr_event_init(&args[i].done);
+      lock->Run(
+          GRPC_CLOSURE_INIT(&args[i].closure, record_thread, &args[i], nullptr),
+          GRPC_ERROR_NONE);
+    }
+    grpc_core::ExecCtx::Get()->Flush();
+    for (size_t i = 0; i < count; i++) {
+      GPR_ASSERT(gpr_event_wait(&args[i].done,
+                                grpc_timeout_seconds_to_deadline(5)) !=
+                 nullptr);
+    }
+    GRPC_COMBINER_UNREF(lock, "run_on_combiner");
+  }
+  grpc_stats_collect(&after);
+  grpc_stats_diff(&after, &before, &diff);
+  return diff.counters[GRPC_STATS_COUNTER_COMBINER_LOCKS_OFFLOADED];
+}
+
+static void test_offload_after_run_time(void) {
+  gpr_log(GPR_DEBUG, "test_offload_after_run_time");
+  set_offload_thresholds(/*run_us=*/1000, /*queue_depth=*/0);
+  offload_args args[10];
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(args); i++) args[i].sleep_ms = 2;
+  int64_t offloads = run_on_combiner(args, GPR_ARRAY_SIZE(args));
+  // The first closure uses up the budget of this thread, and the executor
+  // thread runs all the others without offloading again.
+  gpr_thd_id self = gpr_thd_currentid();
+  GPR_ASSERT(args[0].thread == self);
+  for (size_t i = 1; i < GPR_ARRAY_SIZE(args); i++) {
+    GPR_ASSERT(args[i].thread != self);
+    GPR_ASSERT(args[i].thread == args[1].thread);
+  }
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  GPR_ASSERT(offloads == 1);
+#else
+  (void)offloads;
+#endif
+}
+
+static void test_offload_after_queue_depth(void) {
+  gpr_log(GPR_DEBUG, "test_offload_after_queue_depth");
+  set_offload_thresholds(/*run_us=*/0, /*queue_depth=*/4);
+  offload_args args[20];
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(args); i++) args[i].sleep_ms = 0;
+  int64_t offloads = run_on_combiner(args, GPR_ARRAY_SIZE(args));
+  // More than 4 closures are queued before any runs, so they all run on the
+  // executor, which keeps running them while more than 4 are queued.
+  gpr_thd_id self = gpr_thd_currentid();
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(args); i++) {
+    GPR_ASSERT(args[i].thread != self);
+    GPR_ASSERT(args[i].thread == args[0].thread);
+  }
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  GPR_ASSERT(offloads == 1);
+#else
+  (void)offloads;
+#endif
+}
+
+static void test_offload_disabled(void) {
+  gpr_log(GPR_DEBUG, "test_offload_disabled");
+  set_offload_thresholds(/*run_us=*/0, /*queue_depth=*/0);
+  offload_args args[20];
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(args); i++) {
+    args[i].sleep_ms = i < 2 ? 2 : 0;
+  }
+  int64_t offloads = run_on_combiner(args, GPR_ARRAY_SIZE(args));
+  gpr_thd_id self = gpr_thd_currentid();
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(args); i++) {
+    GPR_ASSERT(args[i].thread == self);
+  }
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  GPR_ASSERT(offloads == 0);
+#else
+  (void)offloads;
+#endif
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   grpc_init();
   test_no_op();
   test_execute_one();
   test_execute_finally();
+  test_flush_with_budget();
+  test_offload_after_run_time();
+  test_offload_after_queue_depth();
+  test_offload_disabled();
+  set_offload_thresholds(/*run_us=*/1000, /*queue_depth=*/256);
   test_execute_many();
   grpc_shutdown();
 
@@ -212,6 +212,27 @@ TEST(ErrorTest, Overflow) {
 #endif
 }
 
+TEST(ErrorTest, SharedErrors) {
+  grpc_error_handle error1 = GRPC_ERROR_DEADLINE_EXCEEDED();
+  grpc_error_handle error2 = GRPC_ERROR_DEADLINE_EXCEEDED();
+  EXPECT_NE(error1, GRPC_ERROR_NONE);
+  EXPECT_EQ(error1, error2);
+  intptr_t i;
+  EXPECT_TRUE(grpc_error_get_int(error1, GRPC_ERROR_INT_GRPC_STATUS, &i));
+  EXPECT_EQ(i, GRPC_STATUS_DEADLINE_EXCEEDED);
+  // Modifying a reference to a shared error leaves the others untouched.
+  error2 = grpc_error_set_int(error2, GRPC_ERROR_INT_HTTP2_ERROR, 8);
+  EXPECT_TRUE(grpc_error_get_int(error2, GRPC_ERROR_INT_HTTP2_ERROR, &i));
+  EXPECT_TRUE(!grpc_error_get_int(error1, GRPC_ERROR_INT_HTTP2_ERROR, &i));
+  GRPC_ERROR_UNREF(error1);
+  GRPC_ERROR_UNREF(error2);
+
+  grpc_error_handle error = GRPC_ERROR_TRANSPORT_CLOSED();
+  EXPECT_TRUE(grpc_error_get_int(error, GRPC_ERROR_INT_GRPC_STATUS, &i));
+  EXPECT_EQ(i, GRPC_STATUS_UNAVAILABLE);
+  GRPC_ERROR_UNREF(error);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
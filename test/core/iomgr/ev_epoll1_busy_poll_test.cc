@@ -0,0 +1,158 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/iomgr/port.h"
+
+// This test only exercises the epoll1 polling engine
+#ifdef GRPC_LINUX_EPOLL
+
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/iomgr.h"
+#include "test/core/util/test_config.h"
+
+GPR_GLOBAL_CONFIG_DECLARE_INT32(grpc_epoll1_busy_poll_us);
+
+static gpr_mu* g_mu;
+static grpc_pollset* g_pollset;
+
+typedef struct {
+  int write_fd;
+  int delay_ms;
+} delayed_write;
+
+static void do_delayed_write(void* arg) {
+  delayed_write* w = static_cast<delayed_write*>(arg);
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(w->delay_ms));
+  GPR_ASSERT(write(w->write_fd, "x", 1) == 1);
+}
+
+static void on_readable(void* arg, grpc_error_handle error) {
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+  gpr_mu_lock(g_mu);
+  *static_cast<bool*>(arg) = true;
+  GPR_ASSERT(
+      GRPC_LOG_IF_ERROR("pollset_kick", grpc_pollset_kick(g_pollset, nullptr)));
+  gpr_mu_unlock(g_mu);
+}
+
+static void destroy_pollset(void* p, grpc_error_handle /*error*/) {
+  grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
+}
+
+/* Waits for a socketpair to become readable after a byte is written
+   delay_ms from now. The byte must be seen whether it arrives while the
+   poller is spinning or after it has given up and blocked. */
+static void test_read_after_delay(int delay_ms) {
+  grpc_core::ExecCtx exec_ctx;
+  int sv[2];
+  GPR_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+  grpc_fd* fd = grpc_fd_create(sv[0], "busy_poll_test", false);
+  grpc_pollset_add_fd(g_pollset, fd);
+
+  bool readable = false;
+  grpc_closure on_readable_closure;
+  GRPC_CLOSURE_INIT(&on_readable_closure, on_readable, &readable,
+                    grpc_schedule_on_exec_ctx);
+  grpc_fd_notify_on_read(fd, &on_readable_closure);
+
+  delayed_write w = {sv[1], delay_ms};
+  grpc_core::Thread writer("busy_poll_test_writer", do_delayed_write, &w);
+  writer.Start();
+
+  grpc_core::Timestamp deadline = grpc_core::Timestamp::FromTimespecRoundUp(
+      grpc_timeout_seconds_to_deadline(10));
+  gpr_mu_lock(g_mu);
+  while (!readable) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(g_mu);
+    GPR_ASSERT(deadline > grpc_core::ExecCtx::Get()->Now());
+  }
+  gpr_mu_unlock(g_mu);
+  writer.Join();
+
+  int release_fd;
+  grpc_fd_orphan(fd, nullptr, &release_fd, "busy_poll_test");
+  grpc_core::ExecCtx::Get()->Flush();
+  close(release_fd);
+  close(sv[1]);
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  GPR_GLOBAL_CONFIG_SET(grpc_poll_strategy, "epoll1");
+  GPR_GLOBAL_CONFIG_SET(grpc_epoll1_busy_poll_us, 1000);
+  grpc_init();
+  if (strcmp(grpc_get_poll_strategy_name(), "epoll1") != 0) {
+    gpr_log(GPR_INFO, "epoll1 unavailable, skipping test");
+    grpc_shutdown();
+    return 0;
+  }
+  {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_closure destroyed;
+    g_pollset = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+    grpc_pollset_init(g_pollset, &g_mu);
+
+    grpc_stats_data before;
+    grpc_stats_data after;
+    grpc_stats_data diff;
+    grpc_stats_collect(&before);
+    /* Arrives within the first spin. */
+    test_read_after_delay(0);
+    /* Arrives long after the spin budget is spent. */
+    test_read_after_delay(50);
+    grpc_stats_collect(&after);
+    grpc_stats_diff(&after, &before, &diff);
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+    GPR_ASSERT(diff.counters[GRPC_STATS_COUNTER_BUSY_POLL_MISSES] > 0);
+    GPR_ASSERT(diff.counters[GRPC_STATS_COUNTER_SYSCALL_WAIT] > 0);
+    GPR_ASSERT(diff.counters[GRPC_STATS_COUNTER_SYSCALL_POLL] >
+               diff.counters[GRPC_STATS_COUNTER_SYSCALL_WAIT]);
+#endif
+
+    GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
+                      grpc_schedule_on_exec_ctx);
+    grpc_pollset_shutdown(g_pollset, &destroyed);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_free(g_pollset);
+  }
+  grpc_shutdown();
+  return 0;
+}
+
+#else /* GRPC_LINUX_EPOLL */
+
+int main(int /*argc*/, char** /*argv*/) { return 0; }
+
+#endif /* GRPC_LINUX_EPOLL */
@@ -0,0 +1,265 @@
+/*
+ *
+ * Copyright 2026 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/iomgr/port.h"
+
+// This test only exercises the io_uring polling engine
+#ifdef GRPC_LINUX_EPOLL
+
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/thd.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/iomgr.h"
+#include "test/core/util/test_config.h"
+
+static gpr_mu* g_mu;
+static grpc_pollset* g_pollset;
+
+typedef struct {
+  int write_fd;
+  int delay_ms;
+} delayed_write;
+
+static void do_delayed_write(void* arg) {
+  delayed_write* w = static_cast<delayed_write*>(arg);
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(w->delay_ms));
+  GPR_ASSERT(write(w->write_fd, "x", 1) == 1);
+}
+
+static void do_delayed_kick(void* /*arg*/) {
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(50));
+  gpr_mu_lock(g_mu);
+  GPR_ASSERT(
+      GRPC_LOG_IF_ERROR("pollset_kick", grpc_pollset_kick(g_pollset, nullptr)));
+  gpr_mu_unlock(g_mu);
+}
+
+typedef struct {
+  int done;
+  int errors;
+} readiness;
+
+static void on_ready(void* arg, grpc_error_handle error) {
+  readiness* r = static_cast<readiness*>(arg);
+  gpr_mu_lock(g_mu);
+  ++r->done;
+  if (error != GRPC_ERROR_NONE) ++r->errors;
+  GPR_ASSERT(
+      GRPC_LOG_IF_ERROR("pollset_kick", grpc_pollset_kick(g_pollset, nullptr)));
+  gpr_mu_unlock(g_mu);
+}
+
+static void destroy_pollset(void* p, grpc_error_handle /*error*/) {
+  grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
+}
+
+/* Polls until count closures of r have run, failing after 10 seconds. */
+static void poll_until_done(readiness* r, int count) {
+  grpc_core::Timestamp deadline = grpc_core::Timestamp::FromTimespecRoundUp(
+      grpc_timeout_seconds_to_deadline(10));
+  gpr_mu_lock(g_mu);
+  while (r->done < count) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(g_mu);
+    GPR_ASSERT(deadline > grpc_core::ExecCtx::Get()->Now());
+  }
+  gpr_mu_unlock(g_mu);
+}
+
+static void orphan_fd(grpc_fd* fd, int peer_fd) {
+  int release_fd;
+  grpc_fd_orphan(fd, nullptr, &release_fd, "io_uring_test");
+  grpc_core::ExecCtx::Get()->Flush();
+  close(release_fd);
+  close(peer_fd);
+}
+
+/* Waits for a socketpair to become readable after a byte is written
+   delay_ms from now, with the worker either about to block or already
+   blocked on the ring. */
+static void test_read_after_delay(int delay_ms) {
+  grpc_core::ExecCtx exec_ctx;
+  int sv[2];
+  GPR_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+  grpc_fd* fd = grpc_fd_create(sv[0], "io_uring_test", false);
+  grpc_pollset_add_fd(g_pollset, fd);
+
+  readiness r = {0, 0};
+  grpc_closure on_ready_closure;
+  GRPC_CLOSURE_INIT(&on_ready_closure, on_ready, &r,
+                    grpc_schedule_on_exec_ctx);
+  grpc_fd_notify_on_read(fd, &on_ready_closure);
+
+  delayed_write w = {sv[1], delay_ms};
+  grpc_core::Thread writer("io_uring_test_writer", do_delayed_write, &w);
+  writer.Start();
+  poll_until_done(&r, 1);
+  writer.Join();
+  GPR_ASSERT(r.errors == 0);
+
+  orphan_fd(fd, sv[1]);
+}
+
+/* The multishot poll request of an fd keeps reporting readiness: each
+   new byte written after the previous one was consumed is seen. */
+static void test_repeated_reads() {
+  grpc_core::ExecCtx exec_ctx;
+  int sv[2];
+  GPR_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+  grpc_fd* fd = grpc_fd_create(sv[0], "io_uring_test", false);
+  grpc_pollset_add_fd(g_pollset, fd);
+
+  readiness r = {0, 0};
+  grpc_closure on_ready_closure;
+  GRPC_CLOSURE_INIT(&on_ready_closure, on_ready, &r,
+                    grpc_schedule_on_exec_ctx);
+  for (int i = 1; i <= 5; ++i) {
+    grpc_fd_notify_on_read(fd, &on_ready_closure);
+    GPR_ASSERT(write(sv[1], "x", 1) == 1);
+    poll_until_done(&r, i);
+    char byte;
+    GPR_ASSERT(read(sv[0], &byte, 1) == 1);
+  }
+  GPR_ASSERT(r.errors == 0);
+
+  orphan_fd(fd, sv[1]);
+}
+
+/* Readiness of many fds sharing the ring is reported for each of them. */
+static void test_many_fds() {
+  constexpr int kNumFds = 32;
+  grpc_core::ExecCtx exec_ctx;
+  int sv[kNumFds][2];
+  grpc_fd* fds[kNumFds];
+  grpc_closure closures[kNumFds];
+  readiness r = {0, 0};
+  for (int i = 0; i < kNumFds; ++i) {
+    GPR_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv[i]) == 0);
+    fds[i] = grpc_fd_create(sv[i][0], "io_uring_test", false);
+    grpc_pollset_add_fd(g_pollset, fds[i]);
+    GRPC_CLOSURE_INIT(&closures[i], on_ready, &r, grpc_schedule_on_exec_ctx);
+    grpc_fd_notify_on_read(fds[i], &closures[i]);
+  }
+  for (int i = 0; i < kNumFds; ++i) {
+    GPR_ASSERT(write(sv[i][1], "x", 1) == 1);
+  }
+  poll_until_done(&r, kNumFds);
+  GPR_ASSERT(r.done == kNumFds);
+  GPR_ASSERT(r.errors == 0);
+  for (int i = 0; i < kNumFds; ++i) {
+    orphan_fd(fds[i], sv[i][1]);
+  }
+}
+
+/* Shutting an fd down fails its pending notification. */
+static void test_shutdown() {
+  grpc_core::ExecCtx exec_ctx;
+  int sv[2];
+  GPR_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+  grpc_fd* fd = grpc_fd_create(sv[0], "io_uring_test", false);
+  grpc_pollset_add_fd(g_pollset, fd);
+
+  readiness r = {0, 0};
+  grpc_closure on_ready_closure;
+  GRPC_CLOSURE_INIT(&on_ready_closure, on_ready, &r,
+                    grpc_schedule_on_exec_ctx);
+  grpc_fd_notify_on_read(fd, &on_ready_closure);
+  grpc_fd_shutdown(fd, GRPC_ERROR_CREATE_FROM_STATIC_STRING("test shutdown"));
+  grpc_core::ExecCtx::Get()->Flush();
+  gpr_mu_lock(g_mu);
+  GPR_ASSERT(r.done == 1);
+  GPR_ASSERT(r.errors == 1);
+  gpr_mu_unlock(g_mu);
+  GPR_ASSERT(grpc_fd_is_shutdown(fd));
+
+  orphan_fd(fd, sv[1]);
+}
+
+/* A kick from another thread wakes a worker blocked on the ring long
+   before its deadline. */
+static void test_kick() {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::Timestamp deadline = grpc_core::Timestamp::FromTimespecRoundUp(
+      grpc_timeout_seconds_to_deadline(30));
+  grpc_core::Thread kicker("io_uring_test_kicker", do_delayed_kick, nullptr);
+  kicker.Start();
+  gpr_mu_lock(g_mu);
+  grpc_pollset_worker* worker = nullptr;
+  GPR_ASSERT(GRPC_LOG_IF_ERROR(
+      "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+  gpr_mu_unlock(g_mu);
+  kicker.Join();
+  grpc_core::ExecCtx::Get()->InvalidateNow();
+  GPR_ASSERT(deadline - grpc_core::ExecCtx::Get()->Now() >
+             grpc_core::Duration::Seconds(20));
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  /* Fall back to other engines rather than abort where the kernel lacks
+     io_uring support. */
+  GPR_GLOBAL_CONFIG_SET(grpc_poll_strategy, "io_uring,epoll1,poll");
+  grpc_init();
+  if (strcmp(grpc_get_poll_strategy_name(), "io_uring") != 0) {
+    gpr_log(GPR_INFO, "io_uring unavailable, skipping test");
+    grpc_shutdown();
+    return 0;
+  }
+  {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_closure destroyed;
+    g_pollset = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
+    grpc_pollset_init(g_pollset, &g_mu);
+
+    /* Arrives before the worker blocks. */
+    test_read_after_delay(0);
+    /* Arrives while the worker is blocked on the ring. */
+    test_read_after_delay(50);
+    test_repeated_reads();
+    test_many_fds();
+    test_shutdown();
+    test_kick();
+
+    GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
+                      grpc_schedule_on_exec_ctx);
+    grpc_pollset_shutdown(g_pollset, &destroyed);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_free(g_pollset);
+  }
+  grpc_shutdown();
+  return 0;
+}
+
+#else /* GRPC_LINUX_EPOLL */
+
+int main(int /*argc*/, char** /*argv*/) { return 0; }
+
+#endif /* GRPC_LINUX_EPOLL */
@@ -20,6 +20,10 @@
 
 #include <string.h>
 
+#include <atomic>
+#include <string>
+#include <vector>
+
 #include <address_sorting/address_sorting.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -374,6 +378,50 @@ TEST_F(ResolveAddressTest, ImmediateCancel) {
   PollPollsetUntilRequestDone();
 }
 
+// Start more resolutions than there are executor threads for the native
+// resolver, which with getaddrinfo_a does not hold one per lookup.
+TEST_F(ResolveAddressTest, ManyConcurrentResolutions) {
+  constexpr int kNumRequests = 64;
+  std::atomic<int> remaining{kNumRequests};
+  grpc_core::ExecCtx exec_ctx;
+  std::vector<grpc_core::OrphanablePtr<grpc_core::DNSResolver::Request>>
+      requests;
+  for (int i = 0; i < kNumRequests; ++i) {
+    requests.push_back(grpc_core::GetDNSResolver()->ResolveName(
+        "localhost:1", "", pollset_set(),
+        [this, &remaining](
+            absl::StatusOr<std::vector<grpc_resolved_address>> result) {
+          EXPECT_EQ(result.status(), absl::OkStatus());
+          if (remaining.fetch_sub(1) == 1) MustSucceed(std::move(result));
+        }));
+  }
+  for (auto& r : requests) r->Start();
+  grpc_core::ExecCtx::Get()->Flush();
+  PollPollsetUntilRequestDone();
+}
+
+// A native resolution that is still pending when gRPC shuts down completes
+// before shutdown returns.
+TEST(ResolveAddressShutdownTest, ShutdownWaitsForNativeResolution) {
+  if (std::string(g_resolver_type) != "native") {
+    GTEST_SKIP() << "this test is only valid with the native resolver";
+  }
+  grpc_init();
+  std::atomic<bool> done{false};
+  {
+    grpc_core::ExecCtx exec_ctx;
+    auto r = grpc_core::GetDNSResolver()->ResolveName(
+        "localhost:1", "", nullptr,
+        [&done](absl::StatusOr<std::vector<grpc_resolved_address>> result) {
+          EXPECT_EQ(result.status(), absl::OkStatus());
+          done.store(true);
+        });
+    r->Start();
+  }
+  grpc_shutdown_blocking();
+  EXPECT_TRUE(done.load());
+}
+
 namespace {
 
 int g_fake_non_responsive_dns_server_port;
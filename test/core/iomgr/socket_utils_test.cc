@@ -24,6 +24,7 @@
 #include <errno.h>
 #include <netinet/in.h>
 #include <netinet/ip.h>
+#include <netinet/tcp.h>
 #include <string.h>
 
 #include <grpc/support/alloc.h>
@@ -133,6 +134,41 @@ static void test_with_vtable(const grpc_socket_mutator_vtable* vtable) {
   GRPC_ERROR_UNREF(err);
 }
 
+/* Where the kernel supports it, the option reads back as set. Elsewhere the
+   setter fails, and callers carry on without Fast Open. */
+static void test_tcp_fastopen(int sock) {
+  grpc_error_handle err = grpc_set_socket_tcp_fastopen_connect(sock);
+#ifdef TCP_FASTOPEN_CONNECT
+  if (err == GRPC_ERROR_NONE) {
+    int val = 0;
+    socklen_t len = sizeof(val);
+    GPR_ASSERT(0 == getsockopt(sock, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &val,
+                               &len));
+    GPR_ASSERT(val == 1);
+  }
+#else
+  GPR_ASSERT(err != GRPC_ERROR_NONE);
+#endif
+  GRPC_ERROR_UNREF(err);
+
+  int listener = socket(PF_INET, SOCK_STREAM, 0);
+  GPR_ASSERT(listener > 0);
+  err = grpc_set_socket_tcp_fastopen(listener, 16);
+#ifdef TCP_FASTOPEN
+  if (err == GRPC_ERROR_NONE) {
+    int val = 0;
+    socklen_t len = sizeof(val);
+    GPR_ASSERT(0 ==
+               getsockopt(listener, IPPROTO_TCP, TCP_FASTOPEN, &val, &len));
+    GPR_ASSERT(val == 16);
+  }
+#else
+  GPR_ASSERT(err != GRPC_ERROR_NONE);
+#endif
+  GRPC_ERROR_UNREF(err);
+  close(listener);
+}
+
 int main(int argc, char** argv) {
   int sock;
   grpc::testing::TestEnvironment env(&argc, argv);
@@ -159,6 +195,7 @@ int main(int argc, char** argv) {
 
   test_with_vtable(&mutator_vtable);
   test_with_vtable(&mutator_vtable2);
+  test_tcp_fastopen(sock);
 
   close(sock);
 
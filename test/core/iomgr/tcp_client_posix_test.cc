@@ -23,6 +23,7 @@
 #ifdef GRPC_POSIX_SOCKET_TCP_CLIENT
 
 #include <errno.h>
+#include <limits.h>
 #include <netinet/in.h>
 #include <string.h>
 #include <sys/socket.h>
@@ -33,6 +34,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/pollset_set.h"
 #include "src/core/lib/iomgr/socket_utils_posix.h"
@@ -72,6 +74,28 @@ static void must_succeed(void* /*arg*/, grpc_error_handle error) {
   finish_connection();
 }
 
+static grpc_slice_buffer g_write_buffer;
+static grpc_closure g_write_done;
+
+static void write_done(void* /*arg*/, grpc_error_handle error) {
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+  grpc_endpoint_shutdown(g_connecting, GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+                                           "write_done called"));
+  grpc_endpoint_destroy(g_connecting);
+  g_connecting = nullptr;
+  finish_connection();
+}
+
+static void must_succeed_and_write(void* /*arg*/, grpc_error_handle error) {
+  GPR_ASSERT(g_connecting != nullptr);
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+  grpc_endpoint_add_to_pollset_set(g_connecting, g_pollset_set);
+  GRPC_CLOSURE_INIT(&g_write_done, write_done, nullptr,
+                    grpc_schedule_on_exec_ctx);
+  grpc_endpoint_write(g_connecting, &g_write_buffer, &g_write_done, nullptr,
+                      /*max_frame_size=*/INT_MAX);
+}
+
 static void must_fail(void* /*arg*/, grpc_error_handle error) {
   GPR_ASSERT(g_connecting == nullptr);
   GPR_ASSERT(error != GRPC_ERROR_NONE);
@@ -142,6 +166,92 @@ void test_succeeds(void) {
   gpr_log(GPR_ERROR, "---- finished test_succeeds() ----");
 }
 
+void test_succeeds_with_fastopen(void) {
+  gpr_log(GPR_ERROR, "---- starting test_succeeds_with_fastopen() ----");
+  grpc_resolved_address resolved_addr;
+  struct sockaddr_in* addr =
+      reinterpret_cast<struct sockaddr_in*>(resolved_addr.addr);
+  int svr_fd;
+  int r;
+  int connections_complete_before;
+  grpc_closure done;
+  grpc_core::ExecCtx exec_ctx;
+  const char kMessage[] = "first write";
+
+  memset(&resolved_addr, 0, sizeof(resolved_addr));
+  resolved_addr.len = static_cast<socklen_t>(sizeof(struct sockaddr_in));
+  addr->sin_family = AF_INET;
+
+  /* create a phony server, with Fast Open if the kernel supports it */
+  svr_fd = socket(AF_INET, SOCK_STREAM, 0);
+  GPR_ASSERT(svr_fd >= 0);
+  GRPC_ERROR_UNREF(grpc_set_socket_tcp_fastopen(svr_fd, 1));
+  GPR_ASSERT(
+      0 == bind(svr_fd, (struct sockaddr*)addr, (socklen_t)resolved_addr.len));
+  GPR_ASSERT(0 == listen(svr_fd, 1));
+
+  gpr_mu_lock(g_mu);
+  connections_complete_before = g_connections_complete;
+  gpr_mu_unlock(g_mu);
+
+  /* connect to it. With Fast Open, connect() returns at once and the SYN is
+     only sent with the first write, which without a cookie from the server
+     first waits for the handshake. Without Fast Open, the connection is set
+     up as usual. */
+  GPR_ASSERT(getsockname(svr_fd, (struct sockaddr*)addr,
+                         (socklen_t*)&resolved_addr.len) == 0);
+  grpc_slice_buffer_init(&g_write_buffer);
+  grpc_slice_buffer_add(&g_write_buffer,
+                        grpc_slice_from_static_string(kMessage));
+  GRPC_CLOSURE_INIT(&done, must_succeed_and_write, nullptr,
+                    grpc_schedule_on_exec_ctx);
+  grpc_arg fastopen_arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_TCP_FASTOPEN), 1);
+  grpc_channel_args fastopen_args = {1, &fastopen_arg};
+  const grpc_channel_args* args = grpc_core::CoreConfiguration::Get()
+                                      .channel_args_preconditioning()
+                                      .PreconditionChannelArgs(&fastopen_args)
+                                      .ToC();
+  grpc_tcp_client_connect(&done, &g_connecting, g_pollset_set, args,
+                          &resolved_addr, grpc_core::Timestamp::InfFuture());
+  grpc_channel_args_destroy(args);
+
+  /* await the connection and the write, which do not need the server to
+     accept the connection */
+  gpr_mu_lock(g_mu);
+  while (g_connections_complete == connections_complete_before) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work",
+        grpc_pollset_work(g_pollset, &worker,
+                          grpc_core::Timestamp::FromTimespecRoundUp(
+                              grpc_timeout_seconds_to_deadline(5)))));
+    gpr_mu_unlock(g_mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(g_mu);
+  }
+  gpr_mu_unlock(g_mu);
+
+  /* check that the server got the write */
+  do {
+    r = accept(svr_fd, nullptr, nullptr);
+  } while (r == -1 && errno == EINTR);
+  GPR_ASSERT(r >= 0);
+  char received[sizeof(kMessage)];
+  size_t received_size = 0;
+  while (received_size < sizeof(kMessage) - 1) {
+    ssize_t n = read(r, received + received_size,
+                     sizeof(kMessage) - 1 - received_size);
+    GPR_ASSERT(n > 0);
+    received_size += static_cast<size_t>(n);
+  }
+  GPR_ASSERT(memcmp(received, kMessage, sizeof(kMessage) - 1) == 0);
+  close(r);
+  close(svr_fd);
+  grpc_slice_buffer_destroy(&g_write_buffer);
+  gpr_log(GPR_ERROR, "---- finished test_succeeds_with_fastopen() ----");
+}
+
 void test_fails(void) {
   gpr_log(GPR_ERROR, "---- starting test_fails() ----");
   grpc_resolved_address resolved_addr;
@@ -250,6 +360,7 @@ int main(int argc, char** argv) {
     grpc_pollset_set_add_pollset(g_pollset_set, g_pollset);
 
     test_succeeds();
+    test_succeeds_with_fastopen();
     test_fails();
     test_fails_bad_addr_no_leak();
     grpc_pollset_set_destroy(g_pollset_set);
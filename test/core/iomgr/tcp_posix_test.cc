@@ -25,6 +25,8 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <limits.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <string.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -35,11 +37,13 @@
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/debug/stats.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/sockaddr_posix.h"
 #include "src/core/lib/iomgr/tcp_posix.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "test/core/iomgr/endpoint_tests.h"
 #include "test/core/util/test_config.h"
@@ -110,6 +114,21 @@ static void create_inet_sockets(int sv[2]) {
   GPR_ASSERT(fcntl(sv[1], F_SETFL, flags | O_NONBLOCK) == 0);
 }
 
+/* Whether an endpoint on fd turns on receive zerocopy when asked to, which
+   needs the kernel to report TCP_INQ. */
+static bool rx_zerocopy_supported(int fd) {
+#if defined(GRPC_LINUX_ERRQUEUE) && defined(GRPC_HAVE_TCP_INQ)
+#ifndef TCP_INQ
+#define TCP_INQ 36
+#endif
+  int one = 1;
+  return setsockopt(fd, SOL_TCP, TCP_INQ, &one, sizeof(one)) == 0;
+#else
+  (void)fd;
+  return false;
+#endif
+}
+
 static ssize_t fill_socket(int fd) {
   ssize_t write_bytes;
   ssize_t total_bytes = 0;
@@ -257,9 +276,109 @@ static void read_test(size_t num_bytes, size_t slice_size) {
       static_cast<grpc_resource_quota*>(a[1].value.pointer.p));
 }
 
+/* Returns the bytes allocated from resource_quota and not yet freed. */
+static size_t memory_in_use(grpc_resource_quota* resource_quota) {
+  size_t in_use = 0;
+  for (size_t bytes : grpc_core::ResourceQuota::FromC(resource_quota)
+                          ->memory_quota()
+                          ->GetUsage()) {
+    in_use += bytes;
+  }
+  return in_use;
+}
+
+/* Waits until state has read target_read_bytes. */
+static void wait_for_read(struct read_socket_state* state,
+                          grpc_core::Timestamp deadline) {
+  gpr_mu_lock(g_mu);
+  while (state->read_bytes < state->target_read_bytes) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+
+    gpr_mu_lock(g_mu);
+  }
+  GPR_ASSERT(state->read_bytes == state->target_read_bytes);
+  gpr_mu_unlock(g_mu);
+}
+
+/* Starts a read with no data on the socket, and checks that the endpoint
+   holds no read memory while it waits, unless release_idle_read_buffers is
+   off. Then writes data, and checks that the read gets it into freshly
+   allocated buffers. */
+static void release_idle_read_buffers_test(bool release_idle_read_buffers,
+                                           bool inet_sockets) {
+  int sv[2];
+  grpc_endpoint* ep;
+  struct read_socket_state state;
+  grpc_core::Timestamp deadline = grpc_core::Timestamp::FromTimespecRoundUp(
+      grpc_timeout_seconds_to_deadline(20));
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO,
+          "Release idle read buffers test, release=%d, inet_sockets=%d",
+          release_idle_read_buffers, inet_sockets);
+
+  if (inet_sockets) {
+    create_inet_sockets(sv);
+  } else {
+    create_sockets(sv);
+  }
+
+  grpc_resource_quota* resource_quota = grpc_resource_quota_create("test");
+  grpc_arg a[2];
+  a[0].key = const_cast<char*>(GRPC_ARG_TCP_RELEASE_IDLE_READ_BUFFERS);
+  a[0].type = GRPC_ARG_INTEGER;
+  a[0].value.integer = release_idle_read_buffers;
+  a[1].key = const_cast<char*>(GRPC_ARG_RESOURCE_QUOTA);
+  a[1].type = GRPC_ARG_POINTER;
+  a[1].value.pointer.p = resource_quota;
+  a[1].value.pointer.vtable = grpc_resource_quota_arg_vtable();
+  grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
+  ep = grpc_tcp_create(grpc_fd_create(sv[1], "release_idle_read_buffers_test",
+                                      false),
+                       &args, "test");
+  grpc_endpoint_add_to_pollset(ep, g_pollset);
+
+  /* A first read leaves the endpoint with the unused tail of its read
+     buffer. 256 bytes keep the data pattern of the next write aligned. */
+  state.ep = ep;
+  state.read_bytes = 0;
+  state.target_read_bytes = fill_socket_partial(sv[0], 256);
+  grpc_slice_buffer_init(&state.incoming);
+  GRPC_CLOSURE_INIT(&state.read_cb, read_cb, &state, grpc_schedule_on_exec_ctx);
+  grpc_endpoint_read(ep, &state.incoming, &state.read_cb, /*urgent=*/false,
+                     /*min_progress_size=*/1);
+  wait_for_read(&state, deadline);
+
+  /* Once the caller drops what it read, nothing else is in use unless the
+     endpoint keeps its buffers. */
+  grpc_slice_buffer_reset_and_unref_internal(&state.incoming);
+  state.target_read_bytes += 256;
+  grpc_endpoint_read(ep, &state.incoming, &state.read_cb, /*urgent=*/false,
+                     /*min_progress_size=*/1);
+  grpc_core::ExecCtx::Get()->Flush();
+  const size_t idle_in_use = memory_in_use(resource_quota);
+  gpr_log(GPR_INFO, "%" PRIuPTR " bytes in use while idle", idle_in_use);
+  if (release_idle_read_buffers) {
+    GPR_ASSERT(idle_in_use == 0);
+  } else {
+    GPR_ASSERT(idle_in_use > 0);
+  }
+
+  GPR_ASSERT(fill_socket_partial(sv[0], 256) == 256);
+  wait_for_read(&state, deadline);
+  GPR_ASSERT(memory_in_use(resource_quota) > 0);
+
+  grpc_slice_buffer_destroy_internal(&state.incoming);
+  grpc_endpoint_destroy(ep);
+  grpc_resource_quota_unref(resource_quota);
+}
+
 /* Write to a socket until it fills up, then read from it using the grpc_tcp
    API. */
-static void large_read_test(size_t slice_size) {
+static void large_read_test(size_t slice_size, bool rx_zerocopy) {
   int sv[2];
   grpc_endpoint* ep;
   struct read_socket_state state;
@@ -268,11 +387,19 @@ static void large_read_test(size_t slice_size) {
       grpc_timeout_seconds_to_deadline(20));
   grpc_core::ExecCtx exec_ctx;
 
-  gpr_log(GPR_INFO, "Start large read test, slice size %" PRIuPTR, slice_size);
+  gpr_log(GPR_INFO,
+          "Start large read test, slice size %" PRIuPTR ", rx zerocopy %d",
+          slice_size, rx_zerocopy);
 
-  create_sockets(sv);
+  if (rx_zerocopy) {
+    /* TCP_ZEROCOPY_RECEIVE needs a TCP socket; the endpoint falls back to
+       copying when the kernel does not support it. */
+    create_inet_sockets(sv);
+  } else {
+    create_sockets(sv);
+  }
 
-  grpc_arg a[2];
+  grpc_arg a[4];
   a[0].key = const_cast<char*>(GRPC_ARG_TCP_READ_CHUNK_SIZE);
   a[0].type = GRPC_ARG_INTEGER;
   a[0].value.integer = static_cast<int>(slice_size);
@@ -280,7 +407,16 @@ static void large_read_test(size_t slice_size) {
   a[1].type = GRPC_ARG_POINTER;
   a[1].value.pointer.p = grpc_resource_quota_create("test");
   a[1].value.pointer.vtable = grpc_resource_quota_arg_vtable();
+  a[2].key = const_cast<char*>(GRPC_ARG_TCP_RX_ZEROCOPY_ENABLED);
+  a[2].type = GRPC_ARG_INTEGER;
+  a[2].value.integer = rx_zerocopy;
+  a[3].key = const_cast<char*>(GRPC_ARG_TCP_RX_ZEROCOPY_RECV_BYTES_THRESHOLD);
+  a[3].type = GRPC_ARG_INTEGER;
+  a[3].value.integer = 4096;
   grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
+  const bool expect_rx_zerocopy = rx_zerocopy && rx_zerocopy_supported(sv[1]);
+  grpc_stats_data stats_before;
+  grpc_stats_collect(&stats_before);
   ep = grpc_tcp_create(grpc_fd_create(sv[1], "large_read_test", false), &args,
                        "test");
   grpc_endpoint_add_to_pollset(ep, g_pollset);
@@ -309,6 +445,29 @@ static void large_read_test(size_t slice_size) {
   GPR_ASSERT(state.read_bytes == state.target_read_bytes);
   gpr_mu_unlock(g_mu);
 
+  grpc_stats_data stats_after;
+  grpc_stats_data stats_diff;
+  grpc_stats_collect(&stats_after);
+  grpc_stats_diff(&stats_after, &stats_before, &stats_diff);
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  /* Whether any pages can be mapped depends on how the kernel queued the
+     bytes, and reads that map none fall back to recvmsg(). The endpoint must
+     try the zerocopy path whenever it is enabled, and only then. */
+  gpr_log(GPR_INFO, "Zerocopy reads: %" PRIdPTR " of %" PRIdPTR " attempts",
+          stats_diff.counters[GRPC_STATS_COUNTER_TCP_ZEROCOPY_READS],
+          stats_diff.counters[GRPC_STATS_COUNTER_TCP_ZEROCOPY_READ_ATTEMPTS]);
+  if (expect_rx_zerocopy) {
+    GPR_ASSERT(
+        stats_diff.counters[GRPC_STATS_COUNTER_TCP_ZEROCOPY_READ_ATTEMPTS] > 0);
+  } else {
+    GPR_ASSERT(
+        stats_diff.counters[GRPC_STATS_COUNTER_TCP_ZEROCOPY_READ_ATTEMPTS] ==
+        0);
+  }
+#else
+  (void)expect_rx_zerocopy;
+#endif
+
   grpc_slice_buffer_destroy_internal(&state.incoming);
   grpc_endpoint_destroy(ep);
   grpc_resource_quota_unref(
@@ -594,8 +753,13 @@ void run_tests(void) {
   read_test(10000, 8192);
   read_test(10000, 137);
   read_test(10000, 1);
-  large_read_test(8192);
-  large_read_test(1);
+  large_read_test(8192, false);
+  large_read_test(1, false);
+  large_read_test(128 * 1024, true);
+  release_idle_read_buffers_test(true, false);
+  release_idle_read_buffers_test(true, true);
+  release_idle_read_buffers_test(false, false);
+  release_idle_read_buffers_test(false, true);
 
   write_test(100, 8192, false);
   write_test(100, 1, false);
@@ -619,14 +783,14 @@ void run_tests(void) {
 
 static void clean_up(void) {}
 
-static grpc_endpoint_test_fixture create_fixture_tcp_socketpair(
-    size_t slice_size) {
+static grpc_endpoint_test_fixture create_fixture_socketpair_endpoints(
+    size_t slice_size, int fd_passing_threshold) {
   int sv[2];
   grpc_endpoint_test_fixture f;
   grpc_core::ExecCtx exec_ctx;
 
   create_sockets(sv);
-  grpc_arg a[2];
+  grpc_arg a[3];
   a[0].key = const_cast<char*>(GRPC_ARG_TCP_READ_CHUNK_SIZE);
   a[0].type = GRPC_ARG_INTEGER;
   a[0].value.integer = static_cast<int>(slice_size);
@@ -634,11 +798,17 @@ static grpc_endpoint_test_fixture create_fixture_tcp_socketpair(
   a[1].type = GRPC_ARG_POINTER;
   a[1].value.pointer.p = grpc_resource_quota_create("test");
   a[1].value.pointer.vtable = grpc_resource_quota_arg_vtable();
+  a[2].key = const_cast<char*>(GRPC_ARG_UNIX_FD_PASSING_THRESHOLD);
+  a[2].type = GRPC_ARG_INTEGER;
+  a[2].value.integer = fd_passing_threshold;
   grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
   f.client_ep = grpc_tcp_create(grpc_fd_create(sv[0], "fixture:client", false),
                                 &args, "test");
   f.server_ep = grpc_tcp_create(grpc_fd_create(sv[1], "fixture:server", false),
                                 &args, "test");
+  /* Stands in for the settings exchange of a transport. */
+  grpc_tcp_enable_fd_passing(f.client_ep);
+  grpc_tcp_enable_fd_passing(f.server_ep);
   grpc_endpoint_add_to_pollset(f.client_ep, g_pollset);
   grpc_endpoint_add_to_pollset(f.server_ep, g_pollset);
   grpc_resource_quota_unref(
@@ -647,8 +817,21 @@ static grpc_endpoint_test_fixture create_fixture_tcp_socketpair(
   return f;
 }
 
+static grpc_endpoint_test_fixture create_fixture_tcp_socketpair(
+    size_t slice_size) {
+  return create_fixture_socketpair_endpoints(slice_size, 0);
+}
+
+/* Writes of 1KB or more are passed as memfds. */
+static grpc_endpoint_test_fixture create_fixture_tcp_socketpair_fd_passing(
+    size_t slice_size) {
+  return create_fixture_socketpair_endpoints(slice_size, 1024);
+}
+
 static grpc_endpoint_test_config configs[] = {
     {"tcp/tcp_socketpair", create_fixture_tcp_socketpair, clean_up},
+    {"tcp/tcp_socketpair_fd_passing", create_fixture_tcp_socketpair_fd_passing,
+     clean_up},
 };
 
 static void destroy_pollset(void* p, grpc_error_handle /*error*/) {
@@ -664,7 +847,9 @@ int main(int argc, char** argv) {
     grpc_core::ExecCtx exec_ctx;
     g_pollset = static_cast<grpc_pollset*>(gpr_zalloc(grpc_pollset_size()));
     grpc_pollset_init(g_pollset, &g_mu);
-    grpc_endpoint_tests(configs[0], g_pollset, g_mu);
+    for (const grpc_endpoint_test_config& config : configs) {
+      grpc_endpoint_tests(config, g_pollset, g_mu);
+    }
     run_tests();
     GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
                       grpc_schedule_on_exec_ctx);
@@ -40,10 +40,12 @@
 #include <grpc/support/time.h>
 
 #include "src/core/lib/address_utils/sockaddr_utils.h"
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/core/lib/iomgr/resolve_address.h"
+#include "src/core/lib/iomgr/socket_utils_posix.h"
 #include "src/core/lib/iomgr/tcp_server.h"
 #include "src/core/lib/resource_quota/api.h"
 #include "test/core/util/port.h"
@@ -451,6 +453,66 @@ static void test_connect(size_t num_connects,
   GPR_ASSERT(weak_ref.server == nullptr);
 }
 
+/* Tests a tcp server with per-CPU listeners on a loopback port. Every
+   connection must be accepted by one of the port's SO_REUSEPORT clones. */
+static void test_per_cpu_listeners(size_t num_connects) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_resolved_address resolved_addr;
+  struct sockaddr_in* addr =
+      reinterpret_cast<struct sockaddr_in*>(resolved_addr.addr);
+  grpc_tcp_server* s;
+  int svr_port;
+  grpc_arg chan_args[2];
+  chan_args[0] = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_TCP_SERVER_PER_CPU_LISTENERS), 1);
+  chan_args[1] = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_TCP_SERVER_CPU_STEERING_BPF), 1);
+  const grpc_channel_args channel_args = {GPR_ARRAY_SIZE(chan_args),
+                                          chan_args};
+  const grpc_channel_args* new_channel_args =
+      grpc_core::CoreConfiguration::Get()
+          .channel_args_preconditioning()
+          .PreconditionChannelArgs(&channel_args)
+          .ToC();
+  GPR_ASSERT(GRPC_ERROR_NONE ==
+             grpc_tcp_server_create(nullptr, new_channel_args, &s));
+  grpc_channel_args_destroy(new_channel_args);
+  LOG_TEST("test_per_cpu_listeners");
+
+  memset(&resolved_addr, 0, sizeof(resolved_addr));
+  resolved_addr.len = static_cast<socklen_t>(sizeof(struct sockaddr_in));
+  addr->sin_family = AF_INET;
+  addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  GPR_ASSERT(GRPC_LOG_IF_ERROR(
+      "grpc_tcp_server_add_port",
+      grpc_tcp_server_add_port(s, &resolved_addr, &svr_port)));
+  GPR_ASSERT(svr_port > 0);
+
+  /* Two pollsets give the port two listeners when SO_REUSEPORT is
+     supported; both may be the same pollset. */
+  std::vector<grpc_pollset*> test_pollsets = {g_pollset, g_pollset};
+  grpc_tcp_server_start(s, &test_pollsets, on_connect, nullptr);
+  const unsigned num_fds = grpc_tcp_server_port_fd_count(s, 0);
+  GPR_ASSERT(num_fds == (grpc_is_socket_reuse_port_supported() ? 2u : 1u));
+
+  test_addr dst;
+  dst.addr = resolved_addr;
+  GPR_ASSERT(grpc_sockaddr_set_port(&dst.addr, svr_port));
+  test_addr_init_str(&dst);
+  for (size_t connect_num = 0; connect_num < num_connects; ++connect_num) {
+    on_connect_result result;
+    on_connect_result_init(&result);
+    GPR_ASSERT(GRPC_LOG_IF_ERROR("tcp_connect", tcp_connect(&dst, &result)));
+    GPR_ASSERT(result.server == s);
+    GPR_ASSERT(result.port_index == 0);
+    GPR_ASSERT(result.fd_index < num_fds);
+    GPR_ASSERT(result.server_fd ==
+               grpc_tcp_server_port_fd(s, 0, result.fd_index));
+  }
+
+  grpc_tcp_server_unref(s);
+}
+
 static void destroy_pollset(void* p, grpc_error_handle /*error*/) {
   grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
 }
@@ -524,6 +586,8 @@ int main(int argc, char** argv) {
     /* Test connect(2) with dst_addrs. */
     test_connect(10, &channel_args, dst_addrs, false);
 
+    test_per_cpu_listeners(10);
+
     GRPC_CLOSURE_INIT(&destroyed, destroy_pollset, g_pollset,
                       grpc_schedule_on_exec_ctx);
     grpc_pollset_shutdown(g_pollset, &destroyed);
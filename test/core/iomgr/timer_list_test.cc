@@ -228,6 +228,51 @@ void long_running_service_cleanup_test(void) {
   GPR_ASSERT(1 == cb_called[3][0]);
 }
 
+/* Timers with deadlines at various distances fire no earlier than their
+   deadline, and on the first check at or after it. */
+void long_deadlines_test(void) {
+  const int64_t kDeadlinesMs[] = {1,        255,      256,
+                                  300,      65535,    65536,
+                                  70000,    16777216, 18000000,
+                                  k25Days.millis(), int64_t{1} << 32};
+  const int kNumTimers = GPR_ARRAY_SIZE(kDeadlinesMs);
+  const int kCancelled = 6;
+  grpc_timer timers[GPR_ARRAY_SIZE(kDeadlinesMs)];
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO, "long_deadlines_test");
+
+  grpc_timer_list_init();
+  memset(cb_called, 0, sizeof(cb_called));
+
+  grpc_core::Timestamp start = grpc_core::ExecCtx::Get()->Now();
+  for (int i = 0; i < kNumTimers; i++) {
+    grpc_timer_init(
+        &timers[i],
+        start + grpc_core::Duration::Milliseconds(kDeadlinesMs[i]),
+        GRPC_CLOSURE_CREATE(cb, (void*)(intptr_t)i, grpc_schedule_on_exec_ctx));
+  }
+  grpc_timer_cancel(&timers[kCancelled]);
+  grpc_core::ExecCtx::Get()->Flush();
+  GPR_ASSERT(1 == cb_called[kCancelled][0]);
+
+  for (int i = 0; i < kNumTimers; i++) {
+    grpc_core::ExecCtx::Get()->TestOnlySetNow(
+        start + grpc_core::Duration::Milliseconds(kDeadlinesMs[i] - 1));
+    grpc_timer_check(nullptr);
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT(0 == cb_called[i][1]);
+    grpc_core::ExecCtx::Get()->TestOnlySetNow(
+        start + grpc_core::Duration::Milliseconds(kDeadlinesMs[i]));
+    grpc_timer_check(nullptr);
+    grpc_core::ExecCtx::Get()->Flush();
+    GPR_ASSERT((i == kCancelled ? 0 : 1) == cb_called[i][1]);
+    GPR_ASSERT((i == kCancelled ? 1 : 0) == cb_called[i][0]);
+  }
+
+  grpc_timer_list_shutdown();
+}
+
 int main(int argc, char** argv) {
   gpr_time_init();
 
@@ -260,6 +305,22 @@ int main(int argc, char** argv) {
     long_running_service_cleanup_test();
     add_test();
     destruction_test();
+    long_deadlines_test();
+    grpc_iomgr_platform_shutdown();
+  }
+
+  /* Repeat the tests against the timing wheel */
+  {
+    grpc::testing::TestEnvironment env(&argc, argv);
+    GPR_GLOBAL_CONFIG_SET(grpc_timer_strategy, "wheel");
+    grpc_core::ExecCtx exec_ctx;
+    grpc_set_default_iomgr_platform();
+    grpc_iomgr_platform_init();
+    gpr_set_log_verbosity(GPR_LOG_SEVERITY_DEBUG);
+    long_running_service_cleanup_test();
+    add_test();
+    destruction_test();
+    long_deadlines_test();
     grpc_iomgr_platform_shutdown();
   }
 
@@ -20,6 +20,7 @@
 
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -61,6 +62,27 @@ TEST(WorkSerializerTest, ExecuteOneScheduleAndDrain) {
               nullptr);
 }
 
+TEST(WorkSerializerTest, MoveOnlyCallbacks) {
+  grpc_core::WorkSerializer lock;
+  std::vector<int> values;
+  lock.Run(
+      [&lock, &values]() {
+        // Queued behind the running callback.
+        auto value = absl::make_unique<int>(2);
+        lock.Run(
+            [&values, value = std::move(value)]() { values.push_back(*value); },
+            DEBUG_LOCATION);
+        values.push_back(1);
+      },
+      DEBUG_LOCATION);
+  auto value = absl::make_unique<int>(3);
+  lock.Schedule(
+      [&values, value = std::move(value)]() { values.push_back(*value); },
+      DEBUG_LOCATION);
+  lock.DrainQueue();
+  EXPECT_EQ(values, std::vector<int>({1, 2, 3}));
+}
+
 class TestThread {
  public:
   explicit TestThread(grpc_core::WorkSerializer* lock)
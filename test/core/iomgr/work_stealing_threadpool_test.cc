@@ -0,0 +1,319 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "src/core/lib/iomgr/executor/work_stealing_threadpool.h"
+
+#include <atomic>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/executor.h"
+#include "test/core/util/test_config.h"
+
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_executor_work_stealing);
+
+static const int kSmallThreadPoolSize = 4;
+static const int kThreadSmallIter = 100;
+static const int kThreadLargeIter = 10000;
+
+static void count_closure(void* arg, grpc_error_handle error) {
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+  static_cast<std::atomic<int>*>(arg)->fetch_add(1, std::memory_order_relaxed);
+}
+
+static void test_size_zero(void) {
+  gpr_log(GPR_INFO, "test_size_zero");
+  grpc_core::WorkStealingThreadPool* pool =
+      new grpc_core::WorkStealingThreadPool(0);
+  GPR_ASSERT(pool->pool_capacity() == 1);
+  GPR_ASSERT(!pool->IsWorkerThread());
+  delete pool;
+}
+
+static void test_deque_single_thread(void) {
+  gpr_log(GPR_INFO, "test_deque_single_thread");
+  // More than the initial capacity, so that the deque has to grow.
+  const int n = 1000;
+  std::vector<grpc_closure> closures(n);
+  grpc_core::WorkStealingDeque deque;
+  GPR_ASSERT(deque.Empty());
+  GPR_ASSERT(deque.Pop() == nullptr);
+  GPR_ASSERT(deque.Steal() == nullptr);
+  for (int i = 0; i < n; i++) {
+    deque.Push(&closures[i]);
+  }
+  GPR_ASSERT(!deque.Empty());
+  // The owner takes the newest closure, thieves take the oldest one.
+  GPR_ASSERT(deque.Pop() == &closures[n - 1]);
+  GPR_ASSERT(deque.Steal() == &closures[0]);
+  for (int i = n - 2; i >= 1; i--) {
+    GPR_ASSERT(deque.Pop() == &closures[i]);
+  }
+  GPR_ASSERT(deque.Pop() == nullptr);
+  GPR_ASSERT(deque.Empty());
+}
+
+// Thread that steals closures from a deque until told to stop, marking each
+// closure it got.
+class StealThread {
+ public:
+  StealThread(grpc_core::WorkStealingDeque* deque,
+              std::vector<std::atomic<int>>* taken, grpc_closure* base,
+              std::atomic<bool>* done)
+      : deque_(deque), taken_(taken), base_(base), done_(done) {
+    thd_ = grpc_core::Thread(
+        "work_stealing_test_steal_thd",
+        [](void* th) { static_cast<StealThread*>(th)->Run(); }, this);
+  }
+
+  void Start() { thd_.Start(); }
+  void Join() { thd_.Join(); }
+
+ private:
+  void Run() {
+    while (!done_->load(std::memory_order_acquire)) {
+      grpc_closure* closure = deque_->Steal();
+      if (closure != nullptr) {
+        (*taken_)[closure - base_].fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  grpc_core::WorkStealingDeque* deque_;
+  std::vector<std::atomic<int>>* taken_;
+  grpc_closure* base_;
+  std::atomic<bool>* done_;
+  grpc_core::Thread thd_;
+};
+
+static void test_deque_concurrent_steal(void) {
+  gpr_log(GPR_INFO, "test_deque_concurrent_steal");
+  const int num_steal_thds = 4;
+  std::vector<grpc_closure> closures(kThreadLargeIter);
+  std::vector<std::atomic<int>> taken(kThreadLargeIter);
+  for (auto& t : taken) t.store(0);
+  std::atomic<bool> done{false};
+  grpc_core::WorkStealingDeque deque;
+  std::vector<StealThread*> steal_thds;
+  for (int i = 0; i < num_steal_thds; i++) {
+    steal_thds.push_back(
+        new StealThread(&deque, &taken, closures.data(), &done));
+    steal_thds.back()->Start();
+  }
+  // The owner interleaves pushes with pops, racing the thieves for the last
+  // closures of the deque.
+  for (int i = 0; i < kThreadLargeIter; i++) {
+    deque.Push(&closures[i]);
+    if (i % 3 == 0) {
+      grpc_closure* closure = deque.Pop();
+      if (closure != nullptr) {
+        taken[closure - closures.data()].fetch_add(1,
+                                                   std::memory_order_relaxed);
+      }
+    }
+  }
+  while (grpc_closure* closure = deque.Pop()) {
+    taken[closure - closures.data()].fetch_add(1, std::memory_order_relaxed);
+  }
+  done.store(true, std::memory_order_release);
+  for (StealThread* thd : steal_thds) {
+    thd->Join();
+    delete thd;
+  }
+  // Every closure is taken exactly once.
+  for (auto& t : taken) {
+    GPR_ASSERT(t.load() == 1);
+  }
+}
+
+// Thread that schedules closures onto the pool from outside of it.
+class RunThread {
+ public:
+  RunThread(grpc_core::WorkStealingThreadPool* pool, std::atomic<int>* count,
+            int num_run)
+      : pool_(pool), count_(count), closures_(num_run) {
+    thd_ = grpc_core::Thread(
+        "work_stealing_test_run_thd",
+        [](void* th) { static_cast<RunThread*>(th)->Run(); }, this);
+  }
+
+  void Start() { thd_.Start(); }
+  void Join() { thd_.Join(); }
+
+ private:
+  void Run() {
+    for (grpc_closure& closure : closures_) {
+      GRPC_CLOSURE_INIT(&closure, count_closure, count_, nullptr);
+      pool_->Run(&closure, GRPC_ERROR_NONE);
+    }
+  }
+
+  grpc_core::WorkStealingThreadPool* pool_;
+  std::atomic<int>* count_;
+  std::vector<grpc_closure> closures_;
+  grpc_core::Thread thd_;
+};
+
+static void test_multi_run(void) {
+  gpr_log(GPR_INFO, "test_multi_run");
+  const int num_run_thds = 10;
+  std::atomic<int> count{0};
+  grpc_core::WorkStealingThreadPool* pool =
+      new grpc_core::WorkStealingThreadPool(kSmallThreadPoolSize,
+                                            "test_multi_run");
+  std::vector<RunThread*> run_thds;
+  for (int i = 0; i < num_run_thds; i++) {
+    run_thds.push_back(new RunThread(pool, &count, kThreadLargeIter));
+    run_thds.back()->Start();
+  }
+  for (RunThread* thd : run_thds) {
+    thd->Join();
+  }
+  // Destructor of the pool runs all pending closures.
+  delete pool;
+  GPR_ASSERT(count.load() == kThreadLargeIter * num_run_thds);
+  for (RunThread* thd : run_thds) {
+    delete thd;
+  }
+}
+
+// A closure that schedules two children until "depth" reaches 0, all from
+// within the pool, so that they go onto the workers' own deques.
+struct FanOutArg {
+  grpc_core::WorkStealingThreadPool* pool;
+  std::atomic<int>* count;
+  int depth;
+  grpc_closure closure;
+};
+
+static void fan_out(void* arg, grpc_error_handle /*error*/) {
+  FanOutArg* a = static_cast<FanOutArg*>(arg);
+  GPR_ASSERT(a->pool->IsWorkerThread());
+  a->count->fetch_add(1, std::memory_order_relaxed);
+  if (a->depth > 0) {
+    for (int i = 0; i < 2; i++) {
+      FanOutArg* child = new FanOutArg{a->pool, a->count, a->depth - 1, {}};
+      GRPC_CLOSURE_INIT(&child->closure, fan_out, child, nullptr);
+      a->pool->Run(&child->closure, GRPC_ERROR_NONE);
+    }
+  }
+  delete a;
+}
+
+static void test_fan_out(void) {
+  gpr_log(GPR_INFO, "test_fan_out");
+  const int depth = 12;
+  std::atomic<int> count{0};
+  grpc_core::WorkStealingThreadPool* pool =
+      new grpc_core::WorkStealingThreadPool(kSmallThreadPoolSize,
+                                            "test_fan_out");
+  FanOutArg* root = new FanOutArg{pool, &count, depth, {}};
+  GRPC_CLOSURE_INIT(&root->closure, fan_out, root, nullptr);
+  pool->Run(&root->closure, GRPC_ERROR_NONE);
+  delete pool;
+  GPR_ASSERT(count.load() == (1 << (depth + 1)) - 1);
+}
+
+struct BlockedArg {
+  grpc_core::WorkStealingThreadPool* pool;
+  gpr_event unblocked;
+  grpc_closure blocker;
+  grpc_closure unblocker;
+};
+
+static void unblock(void* arg, grpc_error_handle /*error*/) {
+  gpr_event_set(&static_cast<BlockedArg*>(arg)->unblocked,
+                reinterpret_cast<void*>(1));
+}
+
+static void block(void* arg, grpc_error_handle /*error*/) {
+  BlockedArg* a = static_cast<BlockedArg*>(arg);
+  // Queued on this worker's own deque, behind the closure that is blocking
+  // the worker: only another worker stealing it can unblock us.
+  a->pool->Run(&a->unblocker, GRPC_ERROR_NONE);
+  GPR_ASSERT(gpr_event_wait(&a->unblocked,
+                            grpc_timeout_seconds_to_deadline(10)) != nullptr);
+}
+
+static void test_steal_from_blocked_worker(void) {
+  gpr_log(GPR_INFO, "test_steal_from_blocked_worker");
+  BlockedArg arg;
+  arg.pool = new grpc_core::WorkStealingThreadPool(
+      2, "test_steal_from_blocked_worker");
+  gpr_event_init(&arg.unblocked);
+  GRPC_CLOSURE_INIT(&arg.blocker, block, &arg, nullptr);
+  GRPC_CLOSURE_INIT(&arg.unblocker, unblock, &arg, nullptr);
+  arg.pool->Run(&arg.blocker, GRPC_ERROR_NONE);
+  delete arg.pool;
+  GPR_ASSERT(gpr_event_get(&arg.unblocked) != nullptr);
+}
+
+static void test_run_function(void) {
+  gpr_log(GPR_INFO, "test_run_function");
+  std::atomic<int> count{0};
+  grpc_core::WorkStealingThreadPool* pool =
+      new grpc_core::WorkStealingThreadPool(kSmallThreadPoolSize,
+                                            "test_run_function");
+  for (int i = 0; i < kThreadSmallIter; i++) {
+    pool->Run([&count]() { count.fetch_add(1, std::memory_order_relaxed); });
+  }
+  delete pool;
+  GPR_ASSERT(count.load() == kThreadSmallIter);
+}
+
+static void test_executor(void) {
+  gpr_log(GPR_INFO, "test_executor");
+  std::atomic<int> count{0};
+  std::vector<grpc_closure> closures(kThreadSmallIter);
+  {
+    grpc_core::ExecCtx exec_ctx;
+    GPR_ASSERT(grpc_core::Executor::IsThreadedDefault());
+    for (int i = 0; i < kThreadSmallIter; i++) {
+      GRPC_CLOSURE_INIT(&closures[i], count_closure, &count, nullptr);
+      grpc_core::Executor::Run(&closures[i], GRPC_ERROR_NONE,
+                               grpc_core::ExecutorType::DEFAULT,
+                               i % 2 == 0 ? grpc_core::ExecutorJobType::SHORT
+                                          : grpc_core::ExecutorJobType::LONG);
+    }
+  }
+  // Shutting the executors down runs all pending closures.
+  grpc_core::Executor::SetThreadingAll(false);
+  GPR_ASSERT(count.load() == kThreadSmallIter);
+  grpc_core::Executor::SetThreadingAll(true);
+}
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  GPR_GLOBAL_CONFIG_SET(grpc_executor_work_stealing, true);
+  grpc_init();
+  test_size_zero();
+  test_deque_single_thread();
+  test_deque_concurrent_steal();
+  test_multi_run();
+  test_fan_out();
+  test_steal_from_blocked_worker();
+  test_run_function();
+  test_executor();
+  grpc_shutdown();
+  return 0;
+}
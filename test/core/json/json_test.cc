@@ -111,6 +111,22 @@ TEST(Json, Utf8) {
                  "{\"\\ud834\\udd1e\":0}");
 }
 
+TEST(Json, LongStrings) {
+  // Runs of plain characters longer than the parser's 16-byte scan, broken
+  // by escapes, UTF-8 and the closing quote at varying offsets.
+  RunSuccessTest("\"abcdefghijklmnopqrstuvwxyz0123456789\"",
+                 "abcdefghijklmnopqrstuvwxyz0123456789",
+                 "\"abcdefghijklmnopqrstuvwxyz0123456789\"");
+  RunSuccessTest("{\"abcdefghijklmnop\\nqrstuvwxyz\":\"0123456789abcdef\"}",
+                 Json::Object{{"abcdefghijklmnop\nqrstuvwxyz",
+                               "0123456789abcdef"}},
+                 "{\"abcdefghijklmnop\\nqrstuvwxyz\":\"0123456789abcdef\"}");
+  RunSuccessTest("\"abcdefghijklmnoßâñć௵⇒pqrstuvwxyz\"",
+                 "abcdefghijklmnoßâñć௵⇒pqrstuvwxyz",
+                 "\"abcdefghijklmno\\u00df\\u00e2\\u00f1\\u0107\\u0bf5\\u21d2"
+                 "pqrstuvwxyz\"");
+}
+
 TEST(Json, NestedEmptyContainers) {
   RunSuccessTest(" [ [ ] , { } , [ ] ] ",
                  Json::Array{
@@ -184,6 +200,10 @@ TEST(Json, InvalidInput) {
 
 TEST(Json, UnterminatedString) { RunParseFailureTest("\"\\x"); }
 
+TEST(Json, ControlCharacterAfterLongRun) {
+  RunParseFailureTest("\"abcdefghijklmnopqrstuvwxyz\n\"");
+}
+
 TEST(Json, InvalidUtf16) {
   RunParseFailureTest("\"\\u123x");
   RunParseFailureTest("{\"\\u123x");
@@ -0,0 +1,371 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Measures what mostly-idle server connections cost.
+
+   The test process runs a server and starts itself again as a client
+   (--role=client), which opens --idle_connections connections that make one
+   RPC and then stay idle, and --low_rate_connections connections that keep
+   making one RPC every --low_rate_interval_ms. Once every connection has made
+   its first RPC, the server reports its memory per connection: the total
+   resident set growth and the part of it accounted to the resource quota,
+   broken down by memory category. The rest (channelz nodes, pollsets,
+   allocator overhead) is reported as untracked.
+
+   The test fails if the resident set grows by more than
+   --max_bytes_per_connection per connection. */
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+#include <grpc/grpc_security.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/host_port.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "test/core/memory_usage/memstats.h"
+#include "test/core/util/port.h"
+#include "test/core/util/subprocess.h"
+#include "test/core/util/test_config.h"
+
+ABSL_FLAG(std::string, role, "server", "server or client");
+ABSL_FLAG(int, port, 0, "Server port, for the client");
+ABSL_FLAG(int, idle_connections, 1000,
+          "Connections that make one RPC and then stay idle");
+ABSL_FLAG(int, low_rate_connections, 100,
+          "Connections that keep making one RPC per interval");
+ABSL_FLAG(int, low_rate_interval_ms, 1000,
+          "Interval between the RPCs of low-rate connections");
+ABSL_FLAG(int, settle_ms, 3000,
+          "How long to keep serving once all connections are up, before "
+          "measuring");
+ABSL_FLAG(bool, channelz, true, "Enable channelz on the server");
+ABSL_FLAG(int, max_bytes_per_connection, 128 * 1024,
+          "Fail if the server's resident set grows by more than this per "
+          "connection; 0 disables the check");
+
+namespace {
+
+// Connection attempts in flight at once on the client.
+constexpr int kMaxConnectsInFlight = 256;
+// Linux limits the connections from one source address to one destination
+// address and port to the ephemeral port range, so connections are spread
+// over this many loopback addresses.
+constexpr int kConnectionsPerAddress = 20000;
+
+const char kConnectMethod[] = "/Idle/Connect";
+const char kPingMethod[] = "/Idle/Ping";
+
+void* tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+void RaiseFileLimit() {
+  struct rlimit limit;
+  if (getrlimit(RLIMIT_NOFILE, &limit) != 0) return;
+  limit.rlim_cur = limit.rlim_max;
+  setrlimit(RLIMIT_NOFILE, &limit);
+}
+
+int TotalConnections() {
+  return absl::GetFlag(FLAGS_idle_connections) +
+         absl::GetFlag(FLAGS_low_rate_connections);
+}
+
+//
+// client
+//
+
+struct ClientConnection {
+  grpc_channel* channel = nullptr;
+  grpc_call* call = nullptr;
+  grpc_metadata_array initial_metadata_recv;
+  grpc_metadata_array trailing_metadata_recv;
+  grpc_status_code status;
+  grpc_slice details;
+  bool connected = false;
+  bool low_rate = false;
+  gpr_timespec next_ping;
+};
+
+void StartCall(grpc_completion_queue* cq, ClientConnection* conn,
+               const char* method, intptr_t call_tag) {
+  grpc_metadata_array_init(&conn->initial_metadata_recv);
+  grpc_metadata_array_init(&conn->trailing_metadata_recv);
+  conn->call = grpc_channel_create_call(
+      conn->channel, nullptr, GRPC_PROPAGATE_DEFAULTS, cq,
+      grpc_slice_from_static_string(method), nullptr,
+      gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+  grpc_op ops[4];
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  ops[0].flags = GRPC_INITIAL_METADATA_WAIT_FOR_READY;
+  ops[1].op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+  ops[2].op = GRPC_OP_RECV_INITIAL_METADATA;
+  ops[2].data.recv_initial_metadata.recv_initial_metadata =
+      &conn->initial_metadata_recv;
+  ops[3].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  ops[3].data.recv_status_on_client.trailing_metadata =
+      &conn->trailing_metadata_recv;
+  ops[3].data.recv_status_on_client.status = &conn->status;
+  ops[3].data.recv_status_on_client.status_details = &conn->details;
+  GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(conn->call, ops, 4,
+                                                   tag(call_tag), nullptr));
+}
+
+void FinishCall(ClientConnection* conn) {
+  GPR_ASSERT(conn->status == GRPC_STATUS_OK);
+  grpc_metadata_array_destroy(&conn->initial_metadata_recv);
+  grpc_metadata_array_destroy(&conn->trailing_metadata_recv);
+  grpc_slice_unref(conn->details);
+  grpc_call_unref(conn->call);
+  conn->call = nullptr;
+}
+
+// Runs until the server interrupts it.
+int RunClient() {
+  RaiseFileLimit();
+  grpc_init();
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  const int num_connections = TotalConnections();
+  const int port = absl::GetFlag(FLAGS_port);
+  const gpr_timespec interval = gpr_time_from_millis(
+      absl::GetFlag(FLAGS_low_rate_interval_ms), GPR_TIMESPAN);
+  // Without a local subchannel pool, channels to the same address would
+  // share one connection.
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL), 1);
+  grpc_channel_args args = {1, &arg};
+  grpc_channel_credentials* creds = grpc_insecure_credentials_create();
+  std::vector<ClientConnection> conns(num_connections);
+  int next_to_connect = 0;
+  int in_flight = 0;
+  while (true) {
+    while (next_to_connect < num_connections &&
+           in_flight < kMaxConnectsInFlight) {
+      ClientConnection* conn = &conns[next_to_connect];
+      const std::string target = grpc_core::JoinHostPort(
+          absl::StrCat("127.0.0.",
+                       1 + next_to_connect / kConnectionsPerAddress),
+          port);
+      conn->channel = grpc_channel_create(target.c_str(), creds, &args);
+      conn->low_rate =
+          next_to_connect >= absl::GetFlag(FLAGS_idle_connections);
+      StartCall(cq, conn, kConnectMethod, next_to_connect);
+      ++next_to_connect;
+      ++in_flight;
+    }
+    const gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+    for (ClientConnection& conn : conns) {
+      if (conn.low_rate && conn.connected && conn.call == nullptr &&
+          gpr_time_cmp(conn.next_ping, now) <= 0) {
+        conn.next_ping = gpr_time_add(now, interval);
+        StartCall(cq, &conn, kPingMethod, &conn - conns.data());
+      }
+    }
+    grpc_event ev = grpc_completion_queue_next(
+        cq, grpc_timeout_milliseconds_to_deadline(10), nullptr);
+    while (ev.type == GRPC_OP_COMPLETE) {
+      GPR_ASSERT(ev.success);
+      ClientConnection* conn =
+          &conns[static_cast<int>(reinterpret_cast<intptr_t>(ev.tag))];
+      FinishCall(conn);
+      if (!conn->connected) {
+        conn->connected = true;
+        conn->next_ping = gpr_time_add(now, interval);
+        --in_flight;
+      }
+      ev = grpc_completion_queue_next(cq, gpr_inf_past(GPR_CLOCK_MONOTONIC),
+                                      nullptr);
+    }
+  }
+}
+
+//
+// server
+//
+
+struct ServerCall {
+  grpc_call* call = nullptr;
+  grpc_call_details details;
+  grpc_metadata_array request_metadata;
+  int was_cancelled;
+};
+
+enum ServerTag : intptr_t { kNewCall = 1, kCallDone };
+
+void RequestCall(grpc_server* server, grpc_completion_queue* cq,
+                 ServerCall* call) {
+  grpc_call_details_init(&call->details);
+  grpc_metadata_array_init(&call->request_metadata);
+  GPR_ASSERT(GRPC_CALL_OK ==
+             grpc_server_request_call(server, &call->call, &call->details,
+                                      &call->request_metadata, cq, cq,
+                                      tag(kNewCall)));
+}
+
+// Completes \a call with an empty OK response, and returns whether it was the
+// first RPC of its connection.
+bool RespondToCall(grpc_completion_queue* cq, ServerCall* call) {
+  const bool is_connect = grpc_slice_str_cmp(call->details.method,
+                                             kConnectMethod) == 0;
+  grpc_op ops[3];
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  ops[1].op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+  ops[1].data.recv_close_on_server.cancelled = &call->was_cancelled;
+  ops[2].op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+  ops[2].data.send_status_from_server.status = GRPC_STATUS_OK;
+  GPR_ASSERT(GRPC_CALL_OK ==
+             grpc_call_start_batch(call->call, ops, 3, tag(kCallDone),
+                                   nullptr));
+  grpc_event ev = grpc_completion_queue_pluck(
+      cq, tag(kCallDone), gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+  GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+  grpc_call_unref(call->call);
+  grpc_call_details_destroy(&call->details);
+  grpc_metadata_array_destroy(&call->request_metadata);
+  return is_connect;
+}
+
+grpc_core::MemoryUsage QuotaUsage() {
+  return grpc_core::ResourceQuota::Default()->memory_quota()->GetUsage();
+}
+
+int RunServer(const char* self) {
+  RaiseFileLimit();
+  grpc_init();
+  const int port = grpc_pick_unused_port_or_die();
+  const int num_connections = TotalConnections();
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_pluck(nullptr);
+  grpc_arg arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_ENABLE_CHANNELZ),
+      absl::GetFlag(FLAGS_channelz));
+  grpc_channel_args args = {1, &arg};
+  grpc_server* server = grpc_server_create(&args, nullptr);
+  grpc_server_register_completion_queue(server, cq, nullptr);
+  grpc_server_credentials* creds = grpc_insecure_server_credentials_create();
+  GPR_ASSERT(grpc_server_add_http2_port(
+      server, grpc_core::JoinHostPort("::", port).c_str(), creds));
+  grpc_server_credentials_release(creds);
+  grpc_server_start(server);
+
+  const MemStats rss_before = MemStats::Snapshot();
+  const grpc_core::MemoryUsage quota_before = QuotaUsage();
+
+  std::vector<std::string> client_args = {
+      self,
+      "--role=client",
+      absl::StrCat("--port=", port),
+      absl::StrCat("--idle_connections=",
+                   absl::GetFlag(FLAGS_idle_connections)),
+      absl::StrCat("--low_rate_connections=",
+                   absl::GetFlag(FLAGS_low_rate_connections)),
+      absl::StrCat("--low_rate_interval_ms=",
+                   absl::GetFlag(FLAGS_low_rate_interval_ms))};
+  std::vector<const char*> client_args_c;
+  for (const auto& a : client_args) client_args_c.push_back(a.c_str());
+  gpr_subprocess* client =
+      gpr_subprocess_create(client_args_c.size(), client_args_c.data());
+
+  ServerCall call;
+  RequestCall(server, cq, &call);
+  int connected = 0;
+  gpr_timespec measure_at = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  while (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), measure_at) < 0) {
+    grpc_event ev = grpc_completion_queue_pluck(
+        cq, tag(kNewCall), grpc_timeout_milliseconds_to_deadline(100),
+        nullptr);
+    if (ev.type != GRPC_OP_COMPLETE) continue;
+    GPR_ASSERT(ev.success);
+    if (RespondToCall(cq, &call) && ++connected == num_connections) {
+      gpr_log(GPR_INFO, "All %d connections up", num_connections);
+      measure_at = grpc_timeout_milliseconds_to_deadline(
+          absl::GetFlag(FLAGS_settle_ms));
+    }
+    RequestCall(server, cq, &call);
+  }
+
+  const MemStats rss_after = MemStats::Snapshot();
+  const grpc_core::MemoryUsage quota_after = QuotaUsage();
+  const double rss_per_connection =
+      1024.0 * (rss_after.rss - rss_before.rss) / num_connections;
+  double tracked_per_connection = 0;
+  printf("---------server memory per connection--------\n");
+  printf("connections: %d idle, %d low-rate, channelz %s\n",
+         absl::GetFlag(FLAGS_idle_connections),
+         absl::GetFlag(FLAGS_low_rate_connections),
+         absl::GetFlag(FLAGS_channelz) ? "on" : "off");
+  printf("resident set: %.0f bytes\n", rss_per_connection);
+  for (size_t i = 0; i < grpc_core::kNumMemoryCategories; i++) {
+    const double bytes = (static_cast<double>(quota_after[i]) -
+                          static_cast<double>(quota_before[i])) /
+                         num_connections;
+    tracked_per_connection += bytes;
+    printf("  %s: %.0f bytes\n",
+           grpc_core::MemoryCategoryName(
+               static_cast<grpc_core::MemoryCategory>(i)),
+           bytes);
+  }
+  printf("  untracked: %.0f bytes\n",
+         rss_per_connection - tracked_per_connection);
+
+  gpr_subprocess_interrupt(client);
+  gpr_subprocess_join(client);
+  gpr_subprocess_destroy(client);
+  grpc_server_shutdown_and_notify(server, cq, tag(kCallDone));
+  grpc_server_cancel_all_calls(server);
+  grpc_completion_queue_pluck(cq, tag(kCallDone),
+                              gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+  // Drop the call requested last, which fails on shutdown.
+  grpc_completion_queue_pluck(cq, tag(kNewCall),
+                              gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+  grpc_call_details_destroy(&call.details);
+  grpc_metadata_array_destroy(&call.request_metadata);
+  grpc_server_destroy(server);
+  grpc_completion_queue_shutdown(cq);
+  grpc_completion_queue_destroy(cq);
+  grpc_shutdown();
+
+  const int max_bytes = absl::GetFlag(FLAGS_max_bytes_per_connection);
+  if (max_bytes > 0 && rss_per_connection > max_bytes) {
+    gpr_log(GPR_ERROR,
+            "Server memory per connection %.0f exceeds the limit of %d bytes",
+            rss_per_connection, max_bytes);
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  if (absl::GetFlag(FLAGS_role) == "client") return RunClient();
+  return RunServer(argv[0]);
+}
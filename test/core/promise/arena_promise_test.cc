@@ -53,6 +53,47 @@ TEST(ArenaPromiseTest, MoveAssignmentWorks) {
   p = ArenaPromise<int>();
 }
 
+TEST(ArenaPromiseTest, SmallPromisesAreInline) {
+  // No arena in context: promises that fit must not be allocated there.
+  int x = 42;
+  ArenaPromise<int> p([x] { return Poll<int>(x); });
+  ArenaPromise<int> q(std::move(p));
+  EXPECT_EQ(q(), Poll<int>(42));
+  p = std::move(q);
+  EXPECT_EQ(p(), Poll<int>(42));
+}
+
+TEST(ArenaPromiseTest, InlineMovesAndDestroysCallable) {
+  auto x = std::make_shared<int>(42);
+  {
+    ArenaPromise<int, 4 * sizeof(void*)> p([x] { return Poll<int>(*x); });
+    ArenaPromise<int, 4 * sizeof(void*)> q(std::move(p));
+    EXPECT_EQ(x.use_count(), 2);
+    EXPECT_EQ(q(), Poll<int>(42));
+    q = ArenaPromise<int, 4 * sizeof(void*)>();
+    EXPECT_EQ(x.use_count(), 1);
+    p = ArenaPromise<int, 4 * sizeof(void*)>([x] { return Poll<int>(*x); });
+  }
+  EXPECT_EQ(x.use_count(), 1);
+}
+
+TEST(ArenaPromiseTest, LargePromisesAreInArena) {
+  auto arena = MakeScopedArena(1024, g_memory_allocator);
+  TestContext<Arena> context(arena.get());
+  int a = 1, b = 2, c = 3;
+  auto small = [a] { return Poll<int>(a); };
+  auto large = [a, b, c] { return Poll<int>(a + b + c); };
+  static_assert(arena_promise_detail::FitsInline<
+                    int, decltype(small), kArenaPromiseDefaultInlineSize>(),
+                "");
+  static_assert(!arena_promise_detail::FitsInline<
+                    int, decltype(large), kArenaPromiseDefaultInlineSize>(),
+                "");
+  ArenaPromise<int> p(std::move(large));
+  ArenaPromise<int> q(std::move(p));
+  EXPECT_EQ(q(), Poll<int>(6));
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
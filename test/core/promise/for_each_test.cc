@@ -69,6 +69,45 @@ TEST(ForEachTest, SendThriceWithPipe) {
   EXPECT_EQ(num_received, 3);
 }
 
+TEST(ForEachTest, SendFiveWithBatchedPipe) {
+  int num_received = 0;
+  StrictMock<MockFunction<void(absl::Status)>> on_done;
+  EXPECT_CALL(on_done, Call(absl::OkStatus()));
+  MakeActivity(
+      [&num_received] {
+        BatchedPipe<int> pipe(2);
+        auto sender =
+            std::make_shared<std::unique_ptr<BatchedPipeSender<int>>>(
+                absl::make_unique<BatchedPipeSender<int>>(
+                    std::move(pipe.sender)));
+        return Map(
+            Join(
+                // Push 1 to 5 into a pipe holding two at a time, then close.
+                Seq((*sender)->Push(1), [sender] { return (*sender)->Push(2); },
+                    [sender] { return (*sender)->Push(3); },
+                    [sender] { return (*sender)->Push(4); },
+                    [sender] { return (*sender)->Push(5); },
+                    [sender] {
+                      sender->reset();
+                      return absl::OkStatus();
+                    }),
+                // Use a ForEach loop to read them out one at a time and
+                // verify all values are seen, in order.
+                ForEach(std::move(pipe.receiver),
+                        [&num_received](int i) {
+                          num_received++;
+                          EXPECT_EQ(num_received, i);
+                          return absl::OkStatus();
+                        })),
+            JustElem<1>());
+      },
+      NoWakeupScheduler(),
+      [&on_done](absl::Status status) { on_done.Call(std::move(status)); },
+      MakeScopedArena(1024, g_memory_allocator));
+  Mock::VerifyAndClearExpectations(&on_done);
+  EXPECT_EQ(num_received, 5);
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
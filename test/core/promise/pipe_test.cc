@@ -139,6 +139,98 @@ TEST(PipeTest, CanSeeClosedOnReceive) {
       MakeScopedArena(1024, g_memory_allocator));
 }
 
+TEST(BatchedPipeTest, ReceivesBufferedValuesInOneBatch) {
+  StrictMock<MockFunction<void(absl::Status)>> on_done;
+  EXPECT_CALL(on_done, Call(absl::OkStatus()));
+  MakeActivity(
+      [] {
+        BatchedPipe<int> pipe(4);
+        auto sender = std::make_shared<BatchedPipeSender<int>>(
+            std::move(pipe.sender));
+        auto receiver = std::make_shared<BatchedPipeReceiver<int>>(
+            std::move(pipe.receiver));
+        return Seq(
+            // Push three values: none of them waits for the receiver.
+            sender->Push(1), [sender] { return sender->Push(2); },
+            [sender] { return sender->Push(3); },
+            // Then receive them all at once.
+            [receiver] { return receiver->Next(); },
+            [](absl::optional<std::vector<int>> batch) {
+              EXPECT_EQ(batch, absl::make_optional(std::vector<int>{1, 2, 3}));
+              return absl::OkStatus();
+            });
+      },
+      NoWakeupScheduler(),
+      [&on_done](absl::Status status) { on_done.Call(std::move(status)); },
+      MakeScopedArena(1024, g_memory_allocator));
+}
+
+TEST(BatchedPipeTest, SenderWaitsWhileBufferIsFull) {
+  StrictMock<MockFunction<void(absl::Status)>> on_done;
+  EXPECT_CALL(on_done, Call(absl::OkStatus()));
+  MakeActivity(
+      [] {
+        BatchedPipe<int> pipe(2);
+        auto sender = std::make_shared<BatchedPipeSender<int>>(
+            std::move(pipe.sender));
+        auto receiver = std::make_shared<BatchedPipeReceiver<int>>(
+            std::move(pipe.receiver));
+        return Seq(
+            // Concurrently: push three values into a pipe holding two, and
+            // receive twice.
+            Join(Seq(sender->Push(1), [sender] { return sender->Push(2); },
+                     [sender] { return sender->Push(3); }),
+                 Seq(receiver->Next(),
+                     [receiver](absl::optional<std::vector<int>> batch) {
+                       EXPECT_EQ(batch,
+                                 absl::make_optional(std::vector<int>{1, 2}));
+                       return receiver->Next();
+                     })),
+            // The third value only fit once the first batch was received.
+            [](std::tuple<bool, absl::optional<std::vector<int>>> result) {
+              EXPECT_EQ(result,
+                        std::make_tuple(
+                            true, absl::make_optional(std::vector<int>{3})));
+              return absl::OkStatus();
+            });
+      },
+      NoWakeupScheduler(),
+      [&on_done](absl::Status status) { on_done.Call(std::move(status)); },
+      MakeScopedArena(1024, g_memory_allocator));
+}
+
+TEST(BatchedPipeTest, CanSeeClosedOnReceive) {
+  StrictMock<MockFunction<void(absl::Status)>> on_done;
+  EXPECT_CALL(on_done, Call(absl::OkStatus()));
+  MakeActivity(
+      [] {
+        BatchedPipe<int> pipe(4);
+        auto sender = std::make_shared<std::unique_ptr<BatchedPipeSender<int>>>(
+            absl::make_unique<BatchedPipeSender<int>>(std::move(pipe.sender)));
+        auto receiver = std::make_shared<BatchedPipeReceiver<int>>(
+            std::move(pipe.receiver));
+        return Seq(
+            // Values pushed before the sender closes are still received.
+            (*sender)->Push(1),
+            [sender] {
+              sender->reset();
+              return absl::OkStatus();
+            },
+            [receiver] { return receiver->Next(); },
+            [receiver](absl::optional<std::vector<int>> batch) {
+              EXPECT_EQ(batch, absl::make_optional(std::vector<int>{1}));
+              return receiver->Next();
+            },
+            [](absl::optional<std::vector<int>> batch) {
+              EXPECT_EQ(batch, absl::nullopt);
+              return absl::OkStatus();
+            });
+      },
+      NoWakeupScheduler(),
+      [&on_done](absl::Status status) { on_done.Call(std::move(status)); },
+      MakeScopedArena(1024, g_memory_allocator));
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
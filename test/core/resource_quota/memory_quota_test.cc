@@ -14,10 +14,16 @@
 
 #include "src/core/lib/resource_quota/memory_quota.h"
 
+#include <string.h>
+
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "absl/synchronization/notification.h"
 
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/slice/slice_refcount.h"
 #include "test/core/resource_quota/call_checker.h"
@@ -155,6 +161,71 @@ TEST(MemoryQuotaTest, ReserveRangeNoPressure) {
   memory_allocator.Release(total);
 }
 
+TEST(MemoryQuotaTest, ConcurrentReserveRelease) {
+  // Threads are spread over CPUs, and so over the allocator's free byte
+  // shards: memory released on one must still be accounted for exactly (the
+  // allocator checks its balance on destruction).
+  MemoryQuota memory_quota("foo");
+  auto memory_allocator = memory_quota.CreateMemoryAllocator("bar");
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&memory_allocator] {
+      std::vector<size_t> reserved;
+      for (int i = 0; i < 10000; i++) {
+        reserved.push_back(memory_allocator.Reserve(MemoryRequest(100, 1000)));
+        if (reserved.size() == 16) {
+          for (size_t n : reserved) memory_allocator.Release(n);
+          reserved.clear();
+        }
+      }
+      for (size_t n : reserved) memory_allocator.Release(n);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+TEST(MemoryQuotaTest, UsageByCategory) {
+  MemoryQuota memory_quota("foo");
+  auto arena_owner =
+      memory_quota.CreateMemoryOwner("arenas", MemoryCategory::kCallArena);
+  auto transport_owner =
+      memory_quota.CreateMemoryOwner("transport", MemoryCategory::kTransport);
+  auto index = [](MemoryCategory category) {
+    return static_cast<size_t>(category);
+  };
+  size_t arena_bytes = arena_owner.Reserve(10000);
+  size_t hpack_bytes =
+      transport_owner.Reserve(MemoryCategory::kHpackTable, 4096);
+  MemoryUsage usage = arena_owner.GetUsage();
+  EXPECT_GE(usage[index(MemoryCategory::kCallArena)], arena_bytes);
+  EXPECT_EQ(usage[index(MemoryCategory::kHpackTable)], 0);
+  usage = transport_owner.GetUsage();
+  EXPECT_EQ(usage[index(MemoryCategory::kHpackTable)], hpack_bytes);
+  EXPECT_EQ(usage[index(MemoryCategory::kCallArena)], 0);
+  usage = memory_quota.GetUsage();
+  EXPECT_GE(usage[index(MemoryCategory::kCallArena)], arena_bytes);
+  EXPECT_EQ(usage[index(MemoryCategory::kHpackTable)], hpack_bytes);
+  EXPECT_GT(usage[index(MemoryCategory::kTransport)], 0);
+  arena_owner.Release(arena_bytes);
+  transport_owner.Release(MemoryCategory::kHpackTable, hpack_bytes);
+  usage = memory_quota.GetUsage();
+  EXPECT_LT(usage[index(MemoryCategory::kCallArena)], arena_bytes);
+  EXPECT_EQ(usage[index(MemoryCategory::kHpackTable)], 0);
+}
+
+TEST(MemoryQuotaTest, RetryBufferUsage) {
+  MemoryQuota memory_quota("foo");
+  auto retry_owner =
+      memory_quota.CreateMemoryOwner("retry", MemoryCategory::kRetryBuffer);
+  const size_t retry_index = static_cast<size_t>(MemoryCategory::kRetryBuffer);
+  size_t retry_bytes = retry_owner.Reserve(4096);
+  EXPECT_GE(memory_quota.GetUsage()[retry_index], retry_bytes);
+  retry_owner.Release(retry_bytes);
+  EXPECT_LT(memory_quota.GetUsage()[retry_index], retry_bytes);
+  EXPECT_STREQ(MemoryCategoryName(MemoryCategory::kRetryBuffer),
+               "retry_buffer");
+}
+
 TEST(MemoryQuotaTest, MakeSlice) {
   MemoryQuota memory_quota("foo");
   auto memory_allocator = memory_quota.CreateMemoryAllocator("bar");
@@ -169,6 +240,60 @@ TEST(MemoryQuotaTest, MakeSlice) {
   }
 }
 
+TEST(MemoryQuotaTest, MakeSliceLengthsWithinRequest) {
+  // Read sized slices may come from a slab of fixed size classes: the length
+  // handed out must still honour the request, and the memory be usable.
+  MemoryQuota memory_quota("foo");
+  auto memory_allocator = memory_quota.CreateMemoryAllocator("bar");
+  std::vector<grpc_slice> slices;
+  for (size_t min : {1, 256, 4000, 4096, 8192, 60000, 65536, 100000}) {
+    for (size_t max : {min, 2 * min, 8 * min}) {
+      for (int i = 0; i < 10; i++) {
+        grpc_slice slice = memory_allocator.MakeSlice(MemoryRequest(min, max));
+        EXPECT_GE(GRPC_SLICE_LENGTH(slice), min);
+        EXPECT_LE(GRPC_SLICE_LENGTH(slice), max);
+        memset(GRPC_SLICE_START_PTR(slice), i, GRPC_SLICE_LENGTH(slice));
+        slices.push_back(slice);
+      }
+    }
+  }
+  for (grpc_slice slice : slices) {
+    grpc_slice_unref_internal(slice);
+  }
+}
+
+TEST(MemoryQuotaTest, MakeSliceChargesWhatItHandsOut) {
+  // Whether a slice comes from the slab or from malloc, the quota is charged
+  // for its storage (the slice and its refcount header) until it is freed,
+  // and nothing else.
+  MemoryQuota memory_quota("foo");
+  auto memory_allocator = memory_quota.CreateMemoryAllocator("bar");
+  auto in_use = [&memory_quota]() {
+    size_t total = 0;
+    for (size_t bytes : memory_quota.GetUsage()) total += bytes;
+    return total;
+  };
+  const size_t initial = in_use();
+  grpc_slice first = memory_allocator.MakeSlice(MemoryRequest(5000, 10000));
+  const size_t overhead = in_use() - initial - GRPC_SLICE_LENGTH(first);
+  EXPECT_LT(overhead, 64u);
+  std::vector<grpc_slice> slices;
+  size_t lengths = 0;
+  for (size_t min : {1, 4000, 8192, 60000, 100000}) {
+    grpc_slice slice = memory_allocator.MakeSlice(MemoryRequest(min, 2 * min));
+    lengths += GRPC_SLICE_LENGTH(slice);
+    slices.push_back(slice);
+    EXPECT_EQ(in_use() - initial,
+              GRPC_SLICE_LENGTH(first) + lengths +
+                  (slices.size() + 1) * overhead);
+  }
+  for (grpc_slice slice : slices) {
+    grpc_slice_unref_internal(slice);
+  }
+  grpc_slice_unref_internal(first);
+  EXPECT_EQ(in_use(), initial);
+}
+
 TEST(MemoryQuotaTest, ContainerAllocator) {
   MemoryQuota memory_quota("foo");
   auto memory_allocator = memory_quota.CreateMemoryAllocator("bar");
@@ -202,11 +327,15 @@ TEST(MemoryQuotaTest, NoBunchingIfIdle) {
 }  // namespace testing
 }  // namespace grpc_core
 
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_slice_slab);
+
 // Hook needed to run ExecCtx outside of iomgr.
 void grpc_set_default_iomgr_platform() {}
 
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   gpr_log_verbosity_init();
+  // Cover the slab slices are made from where there is one.
+  GPR_GLOBAL_CONFIG_SET(grpc_slice_slab, true);
   return RUN_ALL_TESTS();
 }
@@ -33,6 +33,21 @@ TEST(ThreadQuotaTest, Works) {
   q->Release(10);
 }
 
+TEST(ThreadQuotaTest, ForceReserveCountsAgainstMax) {
+  auto q = MakeRefCounted<ThreadQuota>();
+  q->SetMax(2);
+  EXPECT_TRUE(q->Reserve(1));
+  q->ForceReserve(2);
+  EXPECT_EQ(q->allocated(), 3);
+  EXPECT_FALSE(q->Reserve(1));
+  q->Release(2);
+  EXPECT_FALSE(q->Reserve(1));
+  q->Release(1);
+  EXPECT_TRUE(q->Reserve(1));
+  EXPECT_EQ(q->allocated(), 1);
+  q->Release(1);
+}
+
 }  // namespace testing
 }  // namespace grpc_core
 
@@ -426,6 +426,47 @@ TEST_F(AuthorizationMatchersTest,
   EXPECT_FALSE(matcher.Matches(args));
 }
 
+TEST_F(AuthorizationMatchersTest,
+       IpSetAuthorizationMatcherSourceIpSuccessfulMatch) {
+  args_.SetPeerEndpoint("ipv4:1.2.3.4:123");
+  EvaluateArgs args = args_.MakeEvaluateArgs();
+  IpSetAuthorizationMatcher matcher(IpAuthorizationMatcher::Type::kSourceIp);
+  EXPECT_TRUE(matcher.AddRange(
+      Rbac::CidrRange(/*address_prefix=*/"10.0.0.0", /*prefix_len=*/8)));
+  EXPECT_TRUE(matcher.AddRange(
+      Rbac::CidrRange(/*address_prefix=*/"1:2:3::", /*prefix_len=*/48)));
+  EXPECT_TRUE(matcher.AddRange(
+      Rbac::CidrRange(/*address_prefix=*/"1.2.0.0", /*prefix_len=*/16)));
+  EXPECT_TRUE(matcher.Matches(args));
+}
+
+TEST_F(AuthorizationMatchersTest,
+       IpSetAuthorizationMatcherSourceIpFailedMatch) {
+  args_.SetPeerEndpoint("ipv4:1.2.3.4:123");
+  EvaluateArgs args = args_.MakeEvaluateArgs();
+  IpSetAuthorizationMatcher matcher(IpAuthorizationMatcher::Type::kSourceIp);
+  EXPECT_TRUE(matcher.AddRange(
+      Rbac::CidrRange(/*address_prefix=*/"1.2.3.5", /*prefix_len=*/32)));
+  EXPECT_TRUE(matcher.AddRange(
+      Rbac::CidrRange(/*address_prefix=*/"1.3.0.0", /*prefix_len=*/16)));
+  // IPv6 ranges do not match IPv4 addresses.
+  EXPECT_TRUE(matcher.AddRange(
+      Rbac::CidrRange(/*address_prefix=*/"::", /*prefix_len=*/0)));
+  EXPECT_FALSE(matcher.Matches(args));
+}
+
+TEST_F(AuthorizationMatchersTest, IpSetAuthorizationMatcherDestIpMatch) {
+  args_.SetLocalEndpoint("ipv6:[1:2:3::]:456");
+  EvaluateArgs args = args_.MakeEvaluateArgs();
+  IpSetAuthorizationMatcher matcher(IpAuthorizationMatcher::Type::kDestIp);
+  EXPECT_FALSE(matcher.AddRange(
+      Rbac::CidrRange(/*address_prefix=*/"not-an-ip", /*prefix_len=*/8)));
+  EXPECT_FALSE(matcher.Matches(args));
+  EXPECT_TRUE(matcher.AddRange(
+      Rbac::CidrRange(/*address_prefix=*/"1:2:4::", /*prefix_len=*/32)));
+  EXPECT_TRUE(matcher.Matches(args));
+}
+
 TEST_F(AuthorizationMatchersTest, PortAuthorizationMatcherSuccessfulMatch) {
   args_.SetLocalEndpoint("ipv4:255.255.255.255:123");
   EvaluateArgs args = args_.MakeEvaluateArgs();
@@ -19,6 +19,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "test/core/util/evaluate_args_test_util.h"
+
 namespace grpc_core {
 
 TEST(GrpcAuthorizationEngineTest, AllowEngineWithMatchingPolicy) {
@@ -103,6 +105,106 @@ TEST(GrpcAuthorizationEngineTest, DenyEngineWithEmptyPolicies) {
   EXPECT_TRUE(decision.matching_policy_name.empty());
 }
 
+TEST(GrpcAuthorizationEngineTest, PathIndexedPolicies) {
+  std::map<std::string, Rbac::Policy> policies;
+  // Only matches /pkg.Foo/Get.
+  policies["policy1"] = Rbac::Policy(
+      Rbac::Permission::MakePathPermission(
+          StringMatcher::Create(StringMatcher::Type::kExact, "/pkg.Foo/Get")
+              .value()),
+      Rbac::Principal::MakeAnyPrincipal());
+  // Matches /pkg.Bar/*, but only when the x-user header is present.
+  std::vector<std::unique_ptr<Rbac::Permission>> bar_rules;
+  bar_rules.push_back(
+      absl::make_unique<Rbac::Permission>(Rbac::Permission::MakePathPermission(
+          StringMatcher::Create(StringMatcher::Type::kPrefix, "/pkg.Bar/")
+              .value())));
+  bar_rules.push_back(absl::make_unique<Rbac::Permission>(
+      Rbac::Permission::MakeHeaderPermission(
+          HeaderMatcher::Create("x-user", HeaderMatcher::Type::kPresent, "",
+                                0, 0, /*present_match=*/true)
+              .value())));
+  policies["policy2"] =
+      Rbac::Policy(Rbac::Permission::MakeAndPermission(std::move(bar_rules)),
+                   Rbac::Principal::MakeAnyPrincipal());
+  // Matches /pkg.Bar/* and /pkg.Baz/*.
+  std::vector<std::unique_ptr<Rbac::Principal>> service_rules;
+  for (const char* prefix : {"/pkg.Bar/", "/pkg.Baz/"}) {
+    service_rules.push_back(
+        absl::make_unique<Rbac::Principal>(Rbac::Principal::MakePathPrincipal(
+            StringMatcher::Create(StringMatcher::Type::kPrefix, prefix)
+                .value())));
+  }
+  policies["policy3"] = Rbac::Policy(
+      Rbac::Permission::MakeAnyPermission(),
+      Rbac::Principal::MakeOrPrincipal(std::move(service_rules)));
+  GrpcAuthorizationEngine engine(
+      Rbac(Rbac::Action::kAllow, std::move(policies)));
+  {
+    EvaluateArgsTestUtil util;
+    util.AddPairToMetadata(":path", "/pkg.Foo/Get");
+    AuthorizationEngine::Decision decision =
+        engine.Evaluate(util.MakeEvaluateArgs());
+    EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kAllow);
+    EXPECT_EQ(decision.matching_policy_name, "policy1");
+  }
+  {
+    EvaluateArgsTestUtil util;
+    util.AddPairToMetadata(":path", "/pkg.Foo/List");
+    AuthorizationEngine::Decision decision =
+        engine.Evaluate(util.MakeEvaluateArgs());
+    EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kDeny);
+  }
+  {
+    EvaluateArgsTestUtil util;
+    util.AddPairToMetadata(":path", "/pkg.Bar/List");
+    util.AddPairToMetadata("x-user", "alice");
+    AuthorizationEngine::Decision decision =
+        engine.Evaluate(util.MakeEvaluateArgs());
+    EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kAllow);
+    EXPECT_EQ(decision.matching_policy_name, "policy2");
+  }
+  {
+    EvaluateArgsTestUtil util;
+    util.AddPairToMetadata(":path", "/pkg.Bar/List");
+    AuthorizationEngine::Decision decision =
+        engine.Evaluate(util.MakeEvaluateArgs());
+    EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kAllow);
+    EXPECT_EQ(decision.matching_policy_name, "policy3");
+  }
+  {
+    EvaluateArgsTestUtil util;
+    util.AddPairToMetadata(":path", "/pkg.Baz/List");
+    AuthorizationEngine::Decision decision =
+        engine.Evaluate(util.MakeEvaluateArgs());
+    EXPECT_EQ(decision.type, AuthorizationEngine::Decision::Type::kAllow);
+    EXPECT_EQ(decision.matching_policy_name, "policy3");
+  }
+}
+
+TEST(GrpcAuthorizationEngineTest, ConnectionLevelRulesCachedPerEngine) {
+  auto make_rbac = [](const char* address_prefix) {
+    std::map<std::string, Rbac::Policy> policies;
+    policies["policy"] =
+        Rbac::Policy(Rbac::Permission::MakeAnyPermission(),
+                     Rbac::Principal::MakeSourceIpPrincipal(Rbac::CidrRange(
+                         address_prefix, /*prefix_len=*/16)));
+    return Rbac(Rbac::Action::kAllow, std::move(policies));
+  };
+  GrpcAuthorizationEngine engine1(make_rbac("1.2.0.0"));
+  GrpcAuthorizationEngine engine2(make_rbac("1.3.0.0"));
+  EvaluateArgsTestUtil util;
+  util.SetPeerEndpoint("ipv4:1.2.3.4:123");
+  EvaluateArgs args = util.MakeEvaluateArgs();
+  // The same channel args give each engine its own results.
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(engine1.Evaluate(args).type,
+              AuthorizationEngine::Decision::Type::kAllow);
+    EXPECT_EQ(engine2.Evaluate(args).type,
+              AuthorizationEngine::Decision::Type::kDeny);
+  }
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
@@ -300,6 +300,61 @@ TEST_F(GrpcTlsCertificateVerifierTest, ExternalCertificateVerifierFailure) {
   EXPECT_NE(external_verifier_2.Compare(&external_verifier_1), 0);
 }
 
+TEST_F(GrpcTlsCertificateVerifierTest, VerificationCacheHitAndMiss) {
+  ExecCtx exec_ctx;
+  auto cache = MakeRefCounted<CertificateVerificationCache>(Duration::Hours(1));
+  uint64_t generation;
+  // Peers without a certificate are never cached.
+  EXPECT_FALSE(cache->Lookup(&request_, &generation));
+  cache->Insert(&request_, generation);
+  EXPECT_FALSE(cache->Lookup(&request_, &generation));
+  char chain[] = "chain";
+  request_.peer_info.peer_cert_full_chain = chain;
+  request_.target_name = "foo.bar.com";
+  EXPECT_FALSE(cache->Lookup(&request_, &generation));
+  cache->Insert(&request_, generation);
+  EXPECT_TRUE(cache->Lookup(&request_, &generation));
+  // The target name is part of the key.
+  request_.target_name = "bar.foo.com";
+  EXPECT_FALSE(cache->Lookup(&request_, &generation));
+  // So is the certificate chain.
+  request_.target_name = "foo.bar.com";
+  char other_chain[] = "other chain";
+  request_.peer_info.peer_cert_full_chain = other_chain;
+  EXPECT_FALSE(cache->Lookup(&request_, &generation));
+}
+
+TEST_F(GrpcTlsCertificateVerifierTest, VerificationCacheClear) {
+  ExecCtx exec_ctx;
+  auto cache = MakeRefCounted<CertificateVerificationCache>(Duration::Hours(1));
+  char chain[] = "chain";
+  request_.peer_info.peer_cert_full_chain = chain;
+  uint64_t generation;
+  EXPECT_FALSE(cache->Lookup(&request_, &generation));
+  cache->Insert(&request_, generation);
+  EXPECT_TRUE(cache->Lookup(&request_, &generation));
+  cache->Clear();
+  EXPECT_FALSE(cache->Lookup(&request_, &generation));
+  // A verification that was started before a Clear() is not cached.
+  cache->Clear();
+  cache->Insert(&request_, generation);
+  EXPECT_FALSE(cache->Lookup(&request_, &generation));
+}
+
+TEST_F(GrpcTlsCertificateVerifierTest, VerificationCacheExpiration) {
+  ExecCtx exec_ctx;
+  auto cache =
+      MakeRefCounted<CertificateVerificationCache>(Duration::Milliseconds(1));
+  char chain[] = "chain";
+  request_.peer_info.peer_cert_full_chain = chain;
+  uint64_t generation;
+  EXPECT_FALSE(cache->Lookup(&request_, &generation));
+  cache->Insert(&request_, generation);
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+  ExecCtx::Get()->InvalidateNow();
+  EXPECT_FALSE(cache->Lookup(&request_, &generation));
+}
+
 }  // namespace testing
 
 }  // namespace grpc_core
@@ -161,6 +161,26 @@ TEST(TlsCredentialsOptionsComparatorTest, DifferentCrlDirectory) {
   delete options_1;
   delete options_2;
 }
+TEST(TlsCredentialsOptionsComparatorTest, DifferentPrivateKeySigner) {
+  auto* options_1 = grpc_tls_credentials_options_create();
+  auto* options_2 = grpc_tls_credentials_options_create();
+  options_1->set_private_key_signer(MakeRefCounted<tsi::SslPrivateKeySigner>(grpc_tls_private_key_signer()));
+  options_2->set_private_key_signer(MakeRefCounted<tsi::SslPrivateKeySigner>(grpc_tls_private_key_signer()));
+  EXPECT_FALSE(*options_1 == *options_2);
+  EXPECT_FALSE(*options_2 == *options_1);
+  delete options_1;
+  delete options_2;
+}
+TEST(TlsCredentialsOptionsComparatorTest, DifferentVerificationCache) {
+  auto* options_1 = grpc_tls_credentials_options_create();
+  auto* options_2 = grpc_tls_credentials_options_create();
+  options_1->set_verification_cache(MakeRefCounted<CertificateVerificationCache>(Duration::Seconds(1)));
+  options_2->set_verification_cache(MakeRefCounted<CertificateVerificationCache>(Duration::Seconds(2)));
+  EXPECT_FALSE(*options_1 == *options_2);
+  EXPECT_FALSE(*options_2 == *options_1);
+  delete options_1;
+  delete options_2;
+}
 
 } // namespace
 } // namespace grpc_core
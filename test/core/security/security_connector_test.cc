@@ -661,15 +661,54 @@ static void test_default_ssl_roots(void) {
   grpc_set_ssl_roots_override_callback(override_roots_permanent_failure);
   roots = grpc_core::TestDefaultSslRootStore::ComputePemRootCertsForTesting();
   GPR_ASSERT(GRPC_SLICE_IS_EMPTY(roots));
-  const tsi_ssl_root_certs_store* root_store =
-      grpc_core::TestDefaultSslRootStore::GetRootStore();
-  GPR_ASSERT(root_store == nullptr);
+  grpc_core::RefCountedPtr<grpc_core::DefaultSslRootStore::Roots>
+      default_roots = grpc_core::TestDefaultSslRootStore::Get();
+  GPR_ASSERT(default_roots->root_store() == nullptr);
 
   /* Cleanup. */
   remove(roots_env_var_file_path);
   gpr_free(roots_env_var_file_path);
 }
 
+static void write_roots_file(const char* path, const char* roots) {
+  FILE* roots_file = fopen(path, "w");
+  GPR_ASSERT(roots_file != nullptr);
+  fwrite(roots, 1, strlen(roots), roots_file);
+  fclose(roots_file);
+}
+
+static void test_default_ssl_roots_reload(void) {
+  char* roots_file_path;
+  fclose(gpr_tmpfile("test_roots_reload", &roots_file_path));
+  write_roots_file(roots_file_path, "old roots");
+  GPR_GLOBAL_CONFIG_SET(grpc_default_ssl_roots_file_path, roots_file_path);
+  GPR_GLOBAL_CONFIG_SET(grpc_default_ssl_roots_refresh_interval_seconds, 1);
+  const gpr_timespec refresh_interval =
+      gpr_time_from_millis(1100, GPR_TIMESPAN);
+  /* Wait for the roots loaded by the previous test to be checked again. */
+  gpr_sleep_until(gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC), refresh_interval));
+  grpc_core::RefCountedPtr<grpc_core::DefaultSslRootStore::Roots> old_roots =
+      grpc_core::DefaultSslRootStore::Get();
+  GPR_ASSERT(strcmp(old_roots->pem_root_certs(), "old roots") == 0);
+  /* Until the roots change, the same version is shared. */
+  gpr_sleep_until(gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC), refresh_interval));
+  GPR_ASSERT(grpc_core::DefaultSslRootStore::Get() == old_roots);
+  write_roots_file(roots_file_path, "new roots");
+  /* Not checked again before the refresh interval. */
+  GPR_ASSERT(grpc_core::DefaultSslRootStore::Get() == old_roots);
+  gpr_sleep_until(gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC), refresh_interval));
+  grpc_core::RefCountedPtr<grpc_core::DefaultSslRootStore::Roots> new_roots =
+      grpc_core::DefaultSslRootStore::Get();
+  GPR_ASSERT(strcmp(new_roots->pem_root_certs(), "new roots") == 0);
+  /* The old version stays valid for the contexts that use it. */
+  GPR_ASSERT(strcmp(old_roots->pem_root_certs(), "old roots") == 0);
+
+  /* Cleanup. */
+  GPR_GLOBAL_CONFIG_SET(grpc_default_ssl_roots_file_path, "");
+  remove(roots_file_path);
+  gpr_free(roots_file_path);
+}
+
 static void test_peer_alpn_check(void) {
 #if TSI_OPENSSL_ALPN_SUPPORT
   tsi_peer peer;
@@ -723,6 +762,7 @@ int main(int argc, char** argv) {
   test_subject_to_auth_context();
   test_ipv6_address_san();
   test_default_ssl_roots();
+  test_default_ssl_roots_reload();
   test_peer_alpn_check();
   grpc_shutdown();
   return 0;
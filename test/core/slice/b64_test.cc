@@ -26,6 +26,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/b64_kernels.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "test/core/util/test_config.h"
 
@@ -201,6 +202,69 @@ static void test_unpadded_decode(void) {
   GPR_ASSERT(GRPC_SLICE_IS_EMPTY(decoded));
 }
 
+static void test_kernels_agree(int url_safe, int multiline) {
+  unsigned char orig[200];
+  size_t i;
+  for (i = 0; i < sizeof(orig); i++) {
+    orig[i] = static_cast<unsigned char>(i * 37 + 11);
+  }
+  for (size_t len = 0; len <= sizeof(orig); len++) {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_core::TestOnlySetBase64KernelsScalar(true);
+    char* scalar_b64 = grpc_base64_encode(orig, len, url_safe, multiline);
+    grpc_slice scalar_decoded = grpc_base64_decode(scalar_b64, url_safe);
+    grpc_core::TestOnlySetBase64KernelsScalar(false);
+    char* b64 = grpc_base64_encode(orig, len, url_safe, multiline);
+    grpc_slice decoded = grpc_base64_decode(b64, url_safe);
+    GPR_ASSERT(strcmp(scalar_b64, b64) == 0);
+    GPR_ASSERT(GRPC_SLICE_LENGTH(decoded) == len);
+    GPR_ASSERT(grpc_slice_eq(scalar_decoded, decoded));
+    GPR_ASSERT(buffers_are_equal(orig, GRPC_SLICE_START_PTR(decoded), len));
+    grpc_slice_unref_internal(scalar_decoded);
+    grpc_slice_unref_internal(decoded);
+    gpr_free(scalar_b64);
+    gpr_free(b64);
+  }
+}
+
+static void test_kernels_agree_no_multiline(void) {
+  test_kernels_agree(0, 0);
+}
+
+static void test_kernels_agree_multiline(void) { test_kernels_agree(0, 1); }
+
+static void test_kernels_agree_urlsafe_no_multiline(void) {
+  test_kernels_agree(1, 0);
+}
+
+static void test_kernels_agree_urlsafe_multiline(void) {
+  test_kernels_agree(1, 1);
+}
+
+static void test_decode_with_line_break_anywhere(void) {
+  unsigned char orig[120];
+  size_t i;
+  for (i = 0; i < sizeof(orig); i++) orig[i] = static_cast<unsigned char>(i);
+  char* b64 = grpc_base64_encode(orig, sizeof(orig), 0, 0);
+  size_t b64_len = strlen(b64);
+  /* Line breaks are skipped wherever they appear, including in the middle of
+     a block the bulk decoder would otherwise consume. */
+  for (i = 0; i <= b64_len; i++) {
+    grpc_core::ExecCtx exec_ctx;
+    char* broken = static_cast<char*>(gpr_malloc(b64_len + 3));
+    memcpy(broken, b64, i);
+    memcpy(broken + i, "\r\n", 2);
+    memcpy(broken + i + 2, b64 + i, b64_len - i + 1);
+    grpc_slice decoded = grpc_base64_decode(broken, 0);
+    GPR_ASSERT(GRPC_SLICE_LENGTH(decoded) == sizeof(orig));
+    GPR_ASSERT(
+        buffers_are_equal(orig, GRPC_SLICE_START_PTR(decoded), sizeof(orig)));
+    grpc_slice_unref_internal(decoded);
+    gpr_free(broken);
+  }
+  gpr_free(b64);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   grpc_init();
@@ -215,6 +279,11 @@ int main(int argc, char** argv) {
   test_url_safe_unsafe_mismatch_failure();
   test_rfc4648_test_vectors();
   test_unpadded_decode();
+  test_kernels_agree_no_multiline();
+  test_kernels_agree_multiline();
+  test_kernels_agree_urlsafe_no_multiline();
+  test_kernels_agree_urlsafe_multiline();
+  test_decode_with_line_break_anywhere();
   grpc_shutdown();
   return 0;
 }
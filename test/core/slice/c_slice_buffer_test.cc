@@ -16,6 +16,8 @@
  *
  */
 
+#include <string.h>
+
 #include <grpc/grpc.h>
 #include <grpc/slice_buffer.h>
 #include <grpc/support/log.h>
@@ -179,6 +181,49 @@ void test_slice_buffer_first() {
   GPR_ASSERT(buf.length == 0);
 }
 
+void test_slice_buffer_coalesce_small_slices() {
+  constexpr size_t kNumSlices = 100;
+  constexpr size_t kSliceSize = 40;
+  grpc_slice_buffer buf;
+  grpc_slice_buffer_init(&buf);
+  for (size_t i = 0; i < kNumSlices; ++i) {
+    grpc_slice slice = grpc_slice_malloc_large(kSliceSize);
+    memset(GRPC_SLICE_START_PTR(slice), static_cast<int>(i), kSliceSize);
+    grpc_slice_buffer_add(&buf, slice);
+  }
+  GPR_ASSERT(buf.length == kNumSlices * kSliceSize);
+  GPR_ASSERT(buf.count < kNumSlices / 10);
+  // Large slices are added as they are.
+  const size_t count = buf.count;
+  grpc_slice_buffer_add(&buf, grpc_slice_malloc_large(kTotalDataLength));
+  GPR_ASSERT(buf.count == count + 1);
+  grpc_slice_buffer_trim_end(&buf, kTotalDataLength, nullptr);
+  // A copy of the last slice ends where the chunk's free bytes start too:
+  // appending to one buffer must not change what the other holds.
+  grpc_slice_buffer copy;
+  grpc_slice_buffer_init(&copy);
+  grpc_slice_buffer_add(&copy, grpc_slice_malloc_large(kTotalDataLength));
+  grpc_slice_buffer_add(&copy, grpc_slice_ref(buf.slices[buf.count - 1]));
+  grpc_slice extra = grpc_slice_malloc_large(kSliceSize);
+  memset(GRPC_SLICE_START_PTR(extra), 0xff, kSliceSize);
+  grpc_slice_buffer_add(&buf, grpc_slice_ref(extra));
+  grpc_slice_buffer_add(&copy, extra);
+  GPR_ASSERT(buf.length == (kNumSlices + 1) * kSliceSize);
+  char data[(kNumSlices + 1) * kSliceSize];
+  grpc_slice_buffer_move_first_into_buffer(&buf, buf.length, data);
+  for (size_t i = 0; i < kNumSlices; ++i) {
+    for (size_t j = 0; j < kSliceSize; ++j) {
+      GPR_ASSERT(static_cast<unsigned char>(data[i * kSliceSize + j]) == i);
+    }
+  }
+  for (size_t j = 0; j < kSliceSize; ++j) {
+    GPR_ASSERT(static_cast<unsigned char>(data[kNumSlices * kSliceSize + j]) ==
+               0xff);
+  }
+  grpc_slice_buffer_destroy(&buf);
+  grpc_slice_buffer_destroy(&copy);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   grpc_init();
@@ -187,6 +232,7 @@ int main(int argc, char** argv) {
   test_slice_buffer_add_contiguous_slices();
   test_slice_buffer_move_first();
   test_slice_buffer_first();
+  test_slice_buffer_coalesce_small_slices();
 
   grpc_shutdown();
   return 0;
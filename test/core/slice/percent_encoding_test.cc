@@ -96,6 +96,17 @@ static void test_nonconformant_vector(const char* encoded,
   GPR_ASSERT(permissive_unencoded_slice == encoded2raw_permissive_slice);
 }
 
+static void test_unmodified_slice_is_shared(void) {
+  auto slice = grpc_core::Slice::FromCopiedString(
+      "a status message that needs no percent encoding at all");
+  const uint8_t* data = slice.begin();
+  auto encoded = grpc_core::PercentEncodeSlice(
+      std::move(slice), grpc_core::PercentEncodingType::Compatible);
+  GPR_ASSERT(encoded.begin() == data);
+  auto decoded = grpc_core::PermissivePercentDecodeSlice(std::move(encoded));
+  GPR_ASSERT(decoded.begin() == data);
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   grpc_init();
@@ -113,6 +124,17 @@ int main(int argc, char** argv) {
   TEST_VECTOR("\xff", "%FF", grpc_core::PercentEncodingType::URL);
   TEST_VECTOR("\xee", "%EE", grpc_core::PercentEncodingType::URL);
   TEST_VECTOR("%2", "%252", grpc_core::PercentEncodingType::URL);
+  // Longer than a vector, with reserved bytes at either end of a block.
+  TEST_VECTOR("0123456789abcde/0123456789abcdef/0123456789",
+              "0123456789abcde%2F0123456789abcdef%2F0123456789",
+              grpc_core::PercentEncodingType::URL);
+  TEST_VECTOR("grpc-message: something went wrong\x7f, 100% of the time",
+              "grpc-message: something went wrong%7F, 100%25 of the time",
+              grpc_core::PercentEncodingType::Compatible);
+  TEST_VECTOR("\xe2\x80\x94 long dash in the middle of a line \xe2\x80\x94",
+              "%E2%80%94 long dash in the middle of a line %E2%80%94",
+              grpc_core::PercentEncodingType::Compatible);
+  test_unmodified_slice_is_shared();
   TEST_NONCONFORMANT_VECTOR("%", "%");
   TEST_NONCONFORMANT_VECTOR("%A", "%A");
   TEST_NONCONFORMANT_VECTOR("%AG", "%AG");
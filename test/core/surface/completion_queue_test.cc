@@ -167,6 +167,56 @@ static void test_cq_end_op(void) {
   }
 }
 
+static void test_next_batch(void) {
+  grpc_event events[4];
+  grpc_completion_queue* cc;
+  grpc_cq_completion completions[6];
+  void* tags[GPR_ARRAY_SIZE(completions)];
+  size_t n;
+
+  LOG_TEST("test_next_batch");
+
+  grpc_core::ExecCtx exec_ctx;
+  cc = grpc_completion_queue_create_for_next(nullptr);
+
+  /* Nothing queued: a single timeout event. */
+  n = grpc_completion_queue_next_batch(cc, events, GPR_ARRAY_SIZE(events),
+                                       gpr_inf_past(GPR_CLOCK_REALTIME),
+                                       nullptr);
+  GPR_ASSERT(n == 1);
+  GPR_ASSERT(events[0].type == GRPC_QUEUE_TIMEOUT);
+
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(completions); i++) {
+    tags[i] = create_test_tag();
+    GPR_ASSERT(grpc_cq_begin_op(cc, tags[i]));
+    grpc_cq_end_op(cc, tags[i], GRPC_ERROR_NONE, do_nothing_end_completion,
+                   nullptr, &completions[i]);
+  }
+
+  /* Events come back in order, at most max_events per call. */
+  size_t next_tag = 0;
+  while (next_tag < GPR_ARRAY_SIZE(completions)) {
+    n = grpc_completion_queue_next_batch(cc, events, GPR_ARRAY_SIZE(events),
+                                         gpr_inf_past(GPR_CLOCK_REALTIME),
+                                         nullptr);
+    GPR_ASSERT(n >= 1 && n <= GPR_ARRAY_SIZE(events));
+    for (size_t i = 0; i < n; i++) {
+      GPR_ASSERT(events[i].type == GRPC_OP_COMPLETE);
+      GPR_ASSERT(events[i].success);
+      GPR_ASSERT(events[i].tag == tags[next_tag++]);
+    }
+  }
+  GPR_ASSERT(next_tag == GPR_ARRAY_SIZE(completions));
+
+  grpc_completion_queue_shutdown(cc);
+  n = grpc_completion_queue_next_batch(cc, events, GPR_ARRAY_SIZE(events),
+                                       gpr_inf_past(GPR_CLOCK_REALTIME),
+                                       nullptr);
+  GPR_ASSERT(n == 1);
+  GPR_ASSERT(events[0].type == GRPC_QUEUE_SHUTDOWN);
+  grpc_completion_queue_destroy(cc);
+}
+
 static void test_cq_tls_cache_full(void) {
   grpc_event ev;
   grpc_completion_queue* cc;
@@ -496,6 +546,7 @@ int main(int argc, char** argv) {
   test_shutdown_then_next_polling();
   test_shutdown_then_next_with_timeout();
   test_cq_end_op();
+  test_next_batch();
   test_pluck();
   test_pluck_after_shutdown();
   test_cq_tls_cache_full();
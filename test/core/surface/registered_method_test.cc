@@ -0,0 +1,245 @@
+//
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <string.h>
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/transport/inproc/inproc_transport.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "test/core/util/test_config.h"
+
+// Checks how the server matches incoming calls to registered methods: a
+// method registered for the call's host wins over one registered for any
+// host, methods whose keys collide entirely are still told apart, and calls
+// that match nothing go to grpc_server_request_call.
+
+namespace grpc_core {
+namespace {
+
+void* Tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+gpr_timespec FiveSecondsFromNow() {
+  return grpc_timeout_seconds_to_deadline(5);
+}
+
+// Tag of the unregistered call request.
+constexpr intptr_t kUnregistered = 1000;
+
+class RegisteredMethodTest : public ::testing::Test {
+ protected:
+  struct ClientCall {
+    grpc_call* call = nullptr;
+    grpc_metadata_array trailing_metadata;
+    grpc_status_code status = GRPC_STATUS_OK;
+    grpc_slice details;
+  };
+
+  struct ServerCall {
+    grpc_call* call = nullptr;
+    gpr_timespec deadline;
+    grpc_call_details details;
+    grpc_metadata_array request_metadata;
+  };
+
+  RegisteredMethodTest() {
+    server_cq_ = grpc_completion_queue_create_for_next(nullptr);
+    client_cq_ = grpc_completion_queue_create_for_next(nullptr);
+    server_ = grpc_server_create(nullptr, nullptr);
+    grpc_server_register_completion_queue(server_, server_cq_, nullptr);
+  }
+
+  // Registers method for host, or for any host if host is null. Returns the
+  // tag its call is requested with.
+  intptr_t Register(const char* method, const char* host) {
+    registered_.push_back(grpc_server_register_method(
+        server_, method, host, GRPC_SRM_PAYLOAD_NONE, 0));
+    return registered_.size() - 1;
+  }
+
+  // Starts the server, and requests one call of each registered method and
+  // one unregistered call.
+  void Start() {
+    grpc_server_start(server_);
+    channel_ = grpc_inproc_channel_create(server_, nullptr, nullptr);
+    for (size_t i = 0; i < registered_.size(); ++i) {
+      ServerCall& call = NewServerCall();
+      EXPECT_EQ(GRPC_CALL_OK, grpc_server_request_registered_call(
+                                  server_, registered_[i], &call.call,
+                                  &call.deadline, &call.request_metadata,
+                                  nullptr, server_cq_, server_cq_, Tag(i)));
+    }
+    ServerCall& call = NewServerCall();
+    EXPECT_EQ(GRPC_CALL_OK,
+              grpc_server_request_call(server_, &call.call, &call.details,
+                                       &call.request_metadata, server_cq_,
+                                       server_cq_, Tag(kUnregistered)));
+  }
+
+  // Starts a call of method to host, and returns the tag of the call
+  // request it was matched to.
+  intptr_t Call(const char* method, const char* host) {
+    client_calls_.emplace_back();
+    ClientCall& call = client_calls_.back();
+    grpc_slice method_slice = grpc_slice_from_static_string(method);
+    grpc_slice host_slice = grpc_slice_from_static_string(host);
+    call.call = grpc_channel_create_call(
+        channel_, nullptr, GRPC_PROPAGATE_DEFAULTS, client_cq_, method_slice,
+        &host_slice, FiveSecondsFromNow(), nullptr);
+    grpc_metadata_array_init(&call.trailing_metadata);
+    call.details = grpc_empty_slice();
+    grpc_op ops[3];
+    memset(ops, 0, sizeof(ops));
+    ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+    ops[1].op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+    ops[2].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+    ops[2].data.recv_status_on_client.trailing_metadata =
+        &call.trailing_metadata;
+    ops[2].data.recv_status_on_client.status = &call.status;
+    ops[2].data.recv_status_on_client.status_details = &call.details;
+    EXPECT_EQ(GRPC_CALL_OK,
+              grpc_call_start_batch(call.call, ops, 3, nullptr, nullptr));
+    grpc_event ev =
+        grpc_completion_queue_next(server_cq_, FiveSecondsFromNow(), nullptr);
+    EXPECT_EQ(ev.type, GRPC_OP_COMPLETE);
+    EXPECT_TRUE(ev.success);
+    return reinterpret_cast<intptr_t>(ev.tag);
+  }
+
+  void TearDown() override {
+    grpc_server_shutdown_and_notify(server_, server_cq_, Tag(2000));
+    grpc_server_cancel_all_calls(server_);
+    // The call requests that were not matched fail along with the shutdown.
+    while (true) {
+      grpc_event ev = grpc_completion_queue_next(
+          server_cq_, FiveSecondsFromNow(), nullptr);
+      ASSERT_EQ(ev.type, GRPC_OP_COMPLETE);
+      if (ev.tag == Tag(2000)) break;
+      EXPECT_FALSE(ev.success);
+    }
+    for (ServerCall& call : server_calls_) {
+      if (call.call != nullptr) grpc_call_unref(call.call);
+      grpc_call_details_destroy(&call.details);
+      grpc_metadata_array_destroy(&call.request_metadata);
+    }
+    for (ClientCall& call : client_calls_) {
+      grpc_metadata_array_destroy(&call.trailing_metadata);
+      grpc_slice_unref(call.details);
+      grpc_call_unref(call.call);
+    }
+    grpc_channel_destroy(channel_);
+    grpc_server_destroy(server_);
+    Drain(server_cq_);
+    Drain(client_cq_);
+  }
+
+  static void Drain(grpc_completion_queue* cq) {
+    grpc_completion_queue_shutdown(cq);
+    while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(cq);
+  }
+
+ private:
+  ServerCall& NewServerCall() {
+    server_calls_.emplace_back();
+    ServerCall& call = server_calls_.back();
+    grpc_call_details_init(&call.details);
+    grpc_metadata_array_init(&call.request_metadata);
+    return call;
+  }
+
+  grpc_server* server_ = nullptr;
+  grpc_channel* channel_ = nullptr;
+  grpc_completion_queue* server_cq_ = nullptr;
+  grpc_completion_queue* client_cq_ = nullptr;
+  std::vector<void*> registered_;
+  // Deques, since the requests and batches point into their elements.
+  std::deque<ServerCall> server_calls_;
+  std::deque<ClientCall> client_calls_;
+};
+
+TEST_F(RegisteredMethodTest, HostSpecificMethodWinsOverAnyHost) {
+  const intptr_t any_host = Register("/pkg.Svc/Method", nullptr);
+  const intptr_t foo = Register("/pkg.Svc/Method", "foo.test.google.fr");
+  Start();
+  EXPECT_EQ(Call("/pkg.Svc/Method", "foo.test.google.fr"), foo);
+  EXPECT_EQ(Call("/pkg.Svc/Method", "bar.test.google.fr"), any_host);
+}
+
+TEST_F(RegisteredMethodTest, MethodsWithCollidingKeys) {
+  // Find two methods whose keys in the table of methods for any host have
+  // the same hash. They can never be given distinct slots, so they are kept
+  // aside and looked up there.
+  std::unordered_map<uint32_t, std::string> methods_by_hash;
+  std::pair<std::string, std::string> colliding;
+  for (int i = 0; colliding.first.empty(); ++i) {
+    ASSERT_LT(i, 4 * 1024 * 1024);
+    std::string method = absl::StrCat("/pkg.Svc/Method", i);
+    grpc_slice slice = grpc_slice_from_static_buffer(method.data(),
+                                                     method.size());
+    uint32_t hash = MixHash32(0, grpc_slice_hash_internal(slice));
+    auto it = methods_by_hash.emplace(hash, method).first;
+    if (it->second != method) colliding = {it->second, method};
+  }
+  const intptr_t other = Register("/pkg.Svc/Other", nullptr);
+  const intptr_t first = Register(colliding.first.c_str(), nullptr);
+  const intptr_t second = Register(colliding.second.c_str(), nullptr);
+  Start();
+  EXPECT_EQ(Call(colliding.second.c_str(), "foo.test.google.fr"), second);
+  EXPECT_EQ(Call(colliding.first.c_str(), "foo.test.google.fr"), first);
+  EXPECT_EQ(Call("/pkg.Svc/Other", "foo.test.google.fr"), other);
+}
+
+TEST_F(RegisteredMethodTest, UnknownMethodIsNotMatched) {
+  Register("/pkg.Svc/Method", nullptr);
+  Register("/pkg.Svc/ForFoo", "foo.test.google.fr");
+  Start();
+  // Neither the path, nor the path for this host, is registered.
+  EXPECT_EQ(Call("/pkg.Svc/Unknown", "foo.test.google.fr"), kUnregistered);
+}
+
+TEST_F(RegisteredMethodTest, MethodForOtherHostIsNotMatched) {
+  Register("/pkg.Svc/ForFoo", "foo.test.google.fr");
+  Start();
+  EXPECT_EQ(Call("/pkg.Svc/ForFoo", "bar.test.google.fr"), kUnregistered);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
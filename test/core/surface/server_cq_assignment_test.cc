@@ -0,0 +1,233 @@
+//
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <string.h>
+
+#include <deque>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/transport/inproc/inproc_transport.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "test/core/util/test_config.h"
+
+// Checks which of two server completion queues the calls of a connection
+// are published to, with GRPC_ARG_SERVER_CQ_ASSIGNMENT set to
+// "least_loaded" and with GRPC_ARG_SERVER_CQ_MIGRATION. Inproc connections
+// are not accepted by any queue's poller, so by default they are assigned a
+// random one.
+
+namespace grpc_core {
+namespace {
+
+void* Tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+gpr_timespec FiveSecondsFromNow() {
+  return grpc_timeout_seconds_to_deadline(5);
+}
+
+constexpr size_t kNumCqs = 2;
+
+class ServerCqAssignmentTest : public ::testing::Test {
+ protected:
+  struct ClientCall {
+    grpc_call* call = nullptr;
+    grpc_metadata_array trailing_metadata;
+    grpc_status_code status = GRPC_STATUS_OK;
+    grpc_slice details;
+  };
+
+  struct ServerCall {
+    grpc_call* call = nullptr;
+    grpc_call_details details;
+    grpc_metadata_array request_metadata;
+  };
+
+  void Start(grpc_arg arg) {
+    grpc_channel_args args = {1, &arg};
+    Start(&args);
+  }
+
+  // Starts a server with kNumCqs completion queues, and requests a call on
+  // each of them.
+  void Start(const grpc_channel_args* args = nullptr) {
+    server_ = grpc_server_create(args, nullptr);
+    for (size_t i = 0; i < kNumCqs; ++i) {
+      cqs_.push_back(grpc_completion_queue_create_for_next(nullptr));
+      grpc_server_register_completion_queue(server_, cqs_[i], nullptr);
+    }
+    client_cq_ = grpc_completion_queue_create_for_next(nullptr);
+    grpc_server_start(server_);
+    for (size_t i = 0; i < kNumCqs; ++i) RequestCall(i);
+  }
+
+  grpc_channel* Connect() {
+    channels_.push_back(grpc_inproc_channel_create(server_, nullptr, nullptr));
+    return channels_.back();
+  }
+
+  // Starts a call on channel and leaves it open, so that it counts towards
+  // the load of its queue. Returns the index of the queue it was published
+  // to. Since a call is requested on every queue, the call is published to
+  // the queue of its connection.
+  size_t StartCall(grpc_channel* channel) {
+    client_calls_.emplace_back();
+    ClientCall& call = client_calls_.back();
+    call.call = grpc_channel_create_call(
+        channel, nullptr, GRPC_PROPAGATE_DEFAULTS, client_cq_,
+        grpc_slice_from_static_string("/pkg.Svc/Method"), nullptr,
+        FiveSecondsFromNow(), nullptr);
+    grpc_metadata_array_init(&call.trailing_metadata);
+    call.details = grpc_empty_slice();
+    grpc_op ops[2];
+    memset(ops, 0, sizeof(ops));
+    ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+    ops[1].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+    ops[1].data.recv_status_on_client.trailing_metadata =
+        &call.trailing_metadata;
+    ops[1].data.recv_status_on_client.status = &call.status;
+    ops[1].data.recv_status_on_client.status_details = &call.details;
+    EXPECT_EQ(GRPC_CALL_OK,
+              grpc_call_start_batch(call.call, ops, 2, Tag(1), nullptr));
+    const gpr_timespec deadline = FiveSecondsFromNow();
+    while (gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline) < 0) {
+      for (size_t i = 0; i < kNumCqs; ++i) {
+        grpc_event ev = grpc_completion_queue_next(
+            cqs_[i], grpc_timeout_milliseconds_to_deadline(10), nullptr);
+        if (ev.type == GRPC_QUEUE_TIMEOUT) continue;
+        EXPECT_EQ(ev.type, GRPC_OP_COMPLETE);
+        EXPECT_TRUE(ev.success);
+        EXPECT_EQ(ev.tag, Tag(i));
+        RequestCall(i);
+        return i;
+      }
+    }
+    ADD_FAILURE() << "call not published";
+    return kNumCqs;
+  }
+
+  void TearDown() override {
+    grpc_server_shutdown_and_notify(server_, cqs_[0], Tag(1000));
+    grpc_server_cancel_all_calls(server_);
+    // The call requests that were not matched fail along with the shutdown.
+    while (true) {
+      grpc_event ev =
+          grpc_completion_queue_next(cqs_[0], FiveSecondsFromNow(), nullptr);
+      ASSERT_EQ(ev.type, GRPC_OP_COMPLETE);
+      if (ev.tag == Tag(1000)) break;
+      EXPECT_FALSE(ev.success);
+    }
+    for (ServerCall& call : server_calls_) {
+      if (call.call != nullptr) grpc_call_unref(call.call);
+      grpc_call_details_destroy(&call.details);
+      grpc_metadata_array_destroy(&call.request_metadata);
+    }
+    for (ClientCall& call : client_calls_) {
+      grpc_metadata_array_destroy(&call.trailing_metadata);
+      grpc_slice_unref(call.details);
+      grpc_call_unref(call.call);
+    }
+    for (grpc_channel* channel : channels_) grpc_channel_destroy(channel);
+    grpc_server_destroy(server_);
+    for (grpc_completion_queue* cq : cqs_) Drain(cq);
+    Drain(client_cq_);
+  }
+
+ private:
+  void RequestCall(size_t cq_idx) {
+    server_calls_.emplace_back();
+    ServerCall& call = server_calls_.back();
+    grpc_call_details_init(&call.details);
+    grpc_metadata_array_init(&call.request_metadata);
+    EXPECT_EQ(GRPC_CALL_OK,
+              grpc_server_request_call(server_, &call.call, &call.details,
+                                       &call.request_metadata, cqs_[cq_idx],
+                                       cqs_[cq_idx], Tag(cq_idx)));
+  }
+
+  static void Drain(grpc_completion_queue* cq) {
+    grpc_completion_queue_shutdown(cq);
+    while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(cq);
+  }
+
+  grpc_server* server_ = nullptr;
+  std::vector<grpc_completion_queue*> cqs_;
+  grpc_completion_queue* client_cq_ = nullptr;
+  std::vector<grpc_channel*> channels_;
+  // Deques, since the requests and batches point into their elements.
+  std::deque<ServerCall> server_calls_;
+  std::deque<ClientCall> client_calls_;
+};
+
+TEST_F(ServerCqAssignmentTest, LeastLoadedSpreadsConnections) {
+  Start(grpc_channel_arg_string_create(
+      const_cast<char*>(GRPC_ARG_SERVER_CQ_ASSIGNMENT),
+      const_cast<char*>("least_loaded")));
+  // With no calls anywhere, the second connection goes to the queue with no
+  // connection.
+  grpc_channel* first = Connect();
+  grpc_channel* second = Connect();
+  const size_t first_cq = StartCall(first);
+  const size_t second_cq = StartCall(second);
+  EXPECT_NE(first_cq, second_cq);
+  // Once the first queue has more calls, a new connection goes to the
+  // second one even though each has a connection.
+  EXPECT_EQ(StartCall(first), first_cq);
+  EXPECT_EQ(StartCall(first), first_cq);
+  EXPECT_EQ(StartCall(Connect()), second_cq);
+}
+
+TEST_F(ServerCqAssignmentTest, MigratesFromHotCq) {
+  Start(grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_SERVER_CQ_MIGRATION), 1));
+  grpc_channel* channel = Connect();
+  const size_t hot_cq = StartCall(channel);
+  // The connection stays put until its queue has 8 more calls than the
+  // other one.
+  for (int i = 1; i < 8; ++i) EXPECT_EQ(StartCall(channel), hot_cq);
+  const size_t new_cq = StartCall(channel);
+  EXPECT_NE(new_cq, hot_cq);
+  // Having moved, the connection stays on its new queue.
+  EXPECT_EQ(StartCall(channel), new_cq);
+  EXPECT_EQ(StartCall(channel), new_cq);
+}
+
+TEST_F(ServerCqAssignmentTest, StaysOnHotCqWithoutMigration) {
+  Start();
+  grpc_channel* channel = Connect();
+  const size_t cq = StartCall(channel);
+  for (int i = 1; i < 16; ++i) EXPECT_EQ(StartCall(channel), cq);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -0,0 +1,347 @@
+//
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <string.h>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/transport/inproc/inproc_transport.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/surface/server.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+//
+// QosPolicy
+//
+
+class QosPolicyTest : public ::testing::Test {
+ protected:
+  QosPolicyTest() { grpc_metadata_array_init(&metadata_); }
+  ~QosPolicyTest() override { grpc_metadata_array_destroy(&metadata_); }
+
+  // Returns the class policy assigns to a call of path, with the metadata
+  // added by AddMetadata().
+  size_t ClassForCall(const Server::QosPolicy& policy, const char* path) {
+    return policy.ClassForCall(path, metadata_);
+  }
+
+  void AddMetadata(const char* key, const char* value) {
+    grpc_metadata md;
+    memset(&md, 0, sizeof(md));
+    md.key = grpc_slice_from_static_string(key);
+    md.value = grpc_slice_from_static_string(value);
+    metadata_storage_.push_back(md);
+    metadata_.metadata = metadata_storage_.data();
+    metadata_.count = metadata_storage_.size();
+    metadata_.capacity = metadata_storage_.size();
+  }
+
+ private:
+  std::vector<grpc_metadata> metadata_storage_;
+  grpc_metadata_array metadata_;
+};
+
+TEST_F(QosPolicyTest, DefaultsToClassOne) {
+  Server::QosPolicy policy((ChannelArgs()));
+  EXPECT_EQ(ClassForCall(policy, "/pkg.Svc/Method"),
+            Server::QosPolicy::kDefaultClass);
+  EXPECT_EQ(policy.queueing_delay_target(), Duration::Zero());
+}
+
+TEST_F(QosPolicyTest, MethodEntry) {
+  Server::QosPolicy policy(
+      ChannelArgs().Set(GRPC_ARG_SERVER_QOS_CLASSES, "/pkg.Svc/Method=3"));
+  EXPECT_EQ(ClassForCall(policy, "/pkg.Svc/Method"), 3);
+  EXPECT_EQ(ClassForCall(policy, "/pkg.Svc/Other"), 1);
+  EXPECT_EQ(ClassForCall(policy, "/pkg.Other/Method"), 1);
+}
+
+TEST_F(QosPolicyTest, ServiceWildcardEntry) {
+  Server::QosPolicy policy(ChannelArgs().Set(
+      GRPC_ARG_SERVER_QOS_CLASSES, "/pkg.Svc/*=2, /pkg.Svc/Urgent=0"));
+  EXPECT_EQ(ClassForCall(policy, "/pkg.Svc/Method"), 2);
+  // A method entry takes precedence over the entry of its service.
+  EXPECT_EQ(ClassForCall(policy, "/pkg.Svc/Urgent"), 0);
+  EXPECT_EQ(ClassForCall(policy, "/pkg.SvcOther/Method"), 1);
+}
+
+TEST_F(QosPolicyTest, DefaultEntry) {
+  Server::QosPolicy policy(ChannelArgs().Set(GRPC_ARG_SERVER_QOS_CLASSES,
+                                             "*=3,/pkg.Svc/Method=0"));
+  EXPECT_EQ(ClassForCall(policy, "/pkg.Svc/Method"), 0);
+  EXPECT_EQ(ClassForCall(policy, "/pkg.Svc/Other"), 3);
+  Server::QosPolicy default_only(
+      ChannelArgs().Set(GRPC_ARG_SERVER_QOS_CLASSES, "*=2"));
+  EXPECT_EQ(ClassForCall(default_only, "/pkg.Svc/Method"), 2);
+}
+
+TEST_F(QosPolicyTest, InvalidEntriesAreIgnored) {
+  Server::QosPolicy policy(ChannelArgs().Set(
+      GRPC_ARG_SERVER_QOS_CLASSES,
+      "bogus,/pkg.A/M=7,=0,/pkg.B/M=high,/pkg.C/M=-1,/pkg.D/M=2"));
+  EXPECT_EQ(ClassForCall(policy, "/pkg.A/M"), 1);
+  EXPECT_EQ(ClassForCall(policy, "/pkg.B/M"), 1);
+  EXPECT_EQ(ClassForCall(policy, "/pkg.C/M"), 1);
+  EXPECT_EQ(ClassForCall(policy, "bogus"), 1);
+  // The valid entry after the invalid ones still applies.
+  EXPECT_EQ(ClassForCall(policy, "/pkg.D/M"), 2);
+}
+
+TEST_F(QosPolicyTest, MetadataOverridesClass) {
+  Server::QosPolicy policy(
+      ChannelArgs()
+          .Set(GRPC_ARG_SERVER_QOS_CLASSES, "/pkg.Svc/*=3")
+          .Set(GRPC_ARG_SERVER_QOS_CLASS_METADATA_KEY, "x-qos-class"));
+  EXPECT_EQ(ClassForCall(policy, "/pkg.Svc/Method"), 3);
+  AddMetadata("other-key", "0");
+  EXPECT_EQ(ClassForCall(policy, "/pkg.Svc/Method"), 3);
+  AddMetadata("x-qos-class", "0");
+  EXPECT_EQ(ClassForCall(policy, "/pkg.Svc/Method"), 0);
+}
+
+TEST_F(QosPolicyTest, InvalidMetadataValueFallsBack) {
+  Server::QosPolicy policy(
+      ChannelArgs()
+          .Set(GRPC_ARG_SERVER_QOS_CLASSES, "/pkg.Svc/*=3")
+          .Set(GRPC_ARG_SERVER_QOS_CLASS_METADATA_KEY, "x-qos-class"));
+  AddMetadata("x-qos-class", "9");
+  EXPECT_EQ(ClassForCall(policy, "/pkg.Svc/Method"), 3);
+}
+
+TEST_F(QosPolicyTest, MetadataIgnoredWithoutKey) {
+  Server::QosPolicy policy(
+      ChannelArgs().Set(GRPC_ARG_SERVER_QOS_CLASSES, "/pkg.Svc/*=3"));
+  AddMetadata("x-qos-class", "0");
+  EXPECT_EQ(ClassForCall(policy, "/pkg.Svc/Method"), 3);
+}
+
+TEST_F(QosPolicyTest, QueueingDelayTarget) {
+  Server::QosPolicy policy(ChannelArgs().Set(
+      GRPC_ARG_SERVER_QOS_QUEUEING_DELAY_TARGET_MS, 250));
+  EXPECT_EQ(policy.queueing_delay_target(), Duration::Milliseconds(250));
+}
+
+//
+// Matching of the calls waiting to be requested
+//
+
+void* Tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+gpr_timespec FiveSecondsFromNow() {
+  return grpc_timeout_seconds_to_deadline(5);
+}
+
+// Waits for the completion of tag on cq.
+void ExpectCompletion(grpc_completion_queue* cq, void* tag) {
+  grpc_event ev =
+      grpc_completion_queue_next(cq, FiveSecondsFromNow(), nullptr);
+  ASSERT_EQ(ev.type, GRPC_OP_COMPLETE);
+  EXPECT_EQ(ev.tag, tag);
+  EXPECT_TRUE(ev.success);
+}
+
+class ServerQosTest : public ::testing::Test {
+ protected:
+  struct ClientCall {
+    grpc_call* call = nullptr;
+    grpc_metadata_array trailing_metadata;
+    grpc_status_code status = GRPC_STATUS_OK;
+    grpc_slice details;
+  };
+
+  struct ServerCall {
+    grpc_call* call = nullptr;
+    grpc_call_details details;
+    grpc_metadata_array request_metadata;
+  };
+
+  void StartServer(const ChannelArgs& args) {
+    server_cq_ = grpc_completion_queue_create_for_next(nullptr);
+    client_cq_ = grpc_completion_queue_create_for_next(nullptr);
+    const grpc_channel_args* c_args = args.ToC();
+    server_ = grpc_server_create(c_args, nullptr);
+    grpc_channel_args_destroy(c_args);
+    grpc_server_register_completion_queue(server_, server_cq_, nullptr);
+    grpc_server_start(server_);
+    channel_ = grpc_inproc_channel_create(server_, nullptr, nullptr);
+  }
+
+  void TearDown() override {
+    for (ClientCall& call : client_calls_) {
+      grpc_metadata_array_destroy(&call.trailing_metadata);
+      grpc_slice_unref(call.details);
+      grpc_call_unref(call.call);
+    }
+    grpc_channel_destroy(channel_);
+    grpc_server_shutdown_and_notify(server_, server_cq_, Tag(1000));
+    grpc_server_cancel_all_calls(server_);
+    ExpectCompletion(server_cq_, Tag(1000));
+    grpc_server_destroy(server_);
+    Drain(server_cq_);
+    Drain(client_cq_);
+  }
+
+  static void Drain(grpc_completion_queue* cq) {
+    grpc_completion_queue_shutdown(cq);
+    while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(cq);
+  }
+
+  // Starts a call of method, that the client half-closes right away. Its
+  // status is reported on client_cq_ with the index of the call as tag.
+  size_t StartCall(const char* method, const char* qos_class = nullptr) {
+    const size_t index = client_calls_.size();
+    client_calls_.emplace_back();
+    ClientCall& call = client_calls_.back();
+    grpc_slice method_slice = grpc_slice_from_static_string(method);
+    call.call = grpc_channel_create_call(
+        channel_, nullptr, GRPC_PROPAGATE_DEFAULTS, client_cq_, method_slice,
+        nullptr, FiveSecondsFromNow(), nullptr);
+    grpc_metadata_array_init(&call.trailing_metadata);
+    call.details = grpc_empty_slice();
+    grpc_metadata metadata;
+    memset(&metadata, 0, sizeof(metadata));
+    metadata.key = grpc_slice_from_static_string("x-qos-class");
+    metadata.value = grpc_slice_from_static_string(
+        qos_class == nullptr ? "" : qos_class);
+    grpc_op ops[3];
+    memset(ops, 0, sizeof(ops));
+    ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+    ops[0].data.send_initial_metadata.count = qos_class == nullptr ? 0 : 1;
+    ops[0].data.send_initial_metadata.metadata = &metadata;
+    ops[1].op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+    ops[2].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+    ops[2].data.recv_status_on_client.trailing_metadata =
+        &call.trailing_metadata;
+    ops[2].data.recv_status_on_client.status = &call.status;
+    ops[2].data.recv_status_on_client.status_details = &call.details;
+    EXPECT_EQ(GRPC_CALL_OK,
+              grpc_call_start_batch(call.call, ops, 3, Tag(index), nullptr));
+    return index;
+  }
+
+  // Requests the next call from the server, and returns its method.
+  std::string RequestCall() {
+    ServerCall call;
+    grpc_call_details_init(&call.details);
+    grpc_metadata_array_init(&call.request_metadata);
+    EXPECT_EQ(GRPC_CALL_OK,
+              grpc_server_request_call(server_, &call.call, &call.details,
+                                       &call.request_metadata, server_cq_,
+                                       server_cq_, Tag(2000)));
+    ExpectCompletion(server_cq_, Tag(2000));
+    std::string method(StringViewFromSlice(call.details.method));
+    if (call.call != nullptr) {
+      grpc_call_cancel(call.call, nullptr);
+      grpc_call_unref(call.call);
+    }
+    grpc_call_details_destroy(&call.details);
+    grpc_metadata_array_destroy(&call.request_metadata);
+    return method;
+  }
+
+  // Waits for the status of the client call of the given index.
+  grpc_status_code AwaitStatus(size_t index) {
+    ExpectCompletion(client_cq_, Tag(index));
+    return client_calls_[index].status;
+  }
+
+  // Gives the calls started time to reach the server and wait there to be
+  // requested.
+  static void LetCallsArrive() {
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(200));
+  }
+
+  grpc_server* server_ = nullptr;
+  grpc_channel* channel_ = nullptr;
+  grpc_completion_queue* server_cq_ = nullptr;
+  grpc_completion_queue* client_cq_ = nullptr;
+  // A deque, since the batches of the calls point into their elements.
+  std::deque<ClientCall> client_calls_;
+};
+
+TEST_F(ServerQosTest, LowestClassIsMatchedFirst) {
+  StartServer(ChannelArgs().Set(GRPC_ARG_SERVER_QOS_CLASSES,
+                                "/pkg.Bulk/*=2,/pkg.Api/Urgent=0"));
+  StartCall("/pkg.Bulk/Put");
+  StartCall("/pkg.Api/Get");
+  StartCall("/pkg.Bulk/Get");
+  StartCall("/pkg.Api/Urgent");
+  LetCallsArrive();
+  EXPECT_EQ(RequestCall(), "/pkg.Api/Urgent");
+  EXPECT_EQ(RequestCall(), "/pkg.Api/Get");
+  // Calls of the same class are matched in order of arrival.
+  EXPECT_EQ(RequestCall(), "/pkg.Bulk/Put");
+  EXPECT_EQ(RequestCall(), "/pkg.Bulk/Get");
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(AwaitStatus(i), GRPC_STATUS_CANCELLED);
+  }
+}
+
+TEST_F(ServerQosTest, ShedsCallsWaitingPastDelayTarget) {
+  StartServer(
+      ChannelArgs()
+          .Set(GRPC_ARG_SERVER_QOS_CLASSES, "/pkg.Bulk/*=2")
+          .Set(GRPC_ARG_SERVER_QOS_CLASS_METADATA_KEY, "x-qos-class")
+          .Set(GRPC_ARG_SERVER_QOS_QUEUEING_DELAY_TARGET_MS, 100));
+  size_t bulk = StartCall("/pkg.Bulk/Put");
+  size_t urgent = StartCall("/pkg.Bulk/Sync", /*qos_class=*/"0");
+  LetCallsArrive();
+  // Both calls waited longer than the target, but only the one of class 0
+  // is exempt from shedding.
+  EXPECT_EQ(RequestCall(), "/pkg.Bulk/Sync");
+  EXPECT_EQ(AwaitStatus(bulk), GRPC_STATUS_RESOURCE_EXHAUSTED);
+  EXPECT_EQ(StringViewFromSlice(client_calls_[bulk].details),
+            "Server queueing delay target exceeded");
+  EXPECT_EQ(AwaitStatus(urgent), GRPC_STATUS_CANCELLED);
+}
+
+TEST_F(ServerQosTest, CallsWithinDelayTargetAreNotShed) {
+  StartServer(
+      ChannelArgs()
+          .Set(GRPC_ARG_SERVER_QOS_CLASSES, "/pkg.Bulk/*=3")
+          .Set(GRPC_ARG_SERVER_QOS_QUEUEING_DELAY_TARGET_MS, 60000));
+  size_t bulk = StartCall("/pkg.Bulk/Put");
+  LetCallsArrive();
+  EXPECT_EQ(RequestCall(), "/pkg.Bulk/Put");
+  EXPECT_EQ(AwaitStatus(bulk), GRPC_STATUS_CANCELLED);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
@@ -57,6 +57,12 @@ absl::Status FakeWritableParcel::WriteByteArray(const int8_t* buffer,
   return absl::OkStatus();
 }
 
+absl::Status FakeWritableParcel::WriteSharedMemory(absl::string_view data) {
+  data_.push_back(FakeSharedMemory{std::string(data)});
+  data_size_ += sizeof(int32_t);
+  return absl::OkStatus();
+}
+
 int32_t FakeReadableParcel::GetDataSize() const { return data_size_; }
 
 absl::Status FakeReadableParcel::ReadInt32(int32_t* data) {
@@ -111,6 +117,15 @@ absl::Status FakeReadableParcel::ReadByteArray(std::string* data) {
   return absl::OkStatus();
 }
 
+absl::Status FakeReadableParcel::ReadSharedMemory(std::string* data) {
+  if (data_position_ >= data_.size() ||
+      !absl::holds_alternative<FakeSharedMemory>(data_[data_position_])) {
+    return absl::InternalError("ReadSharedMemory failed");
+  }
+  *data = absl::get<FakeSharedMemory>(data_[data_position_++]).data;
+  return absl::OkStatus();
+}
+
 absl::Status FakeBinder::Transact(BinderTransportTxCode tx_code) {
   endpoint_->tunnel->EnQueueTransaction(endpoint_->other_end, tx_code,
                                         input_->MoveData());
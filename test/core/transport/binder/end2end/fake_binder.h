@@ -72,8 +72,15 @@
 namespace grpc_binder {
 namespace end2end_testing {
 
-using FakeData = std::vector<
-    absl::variant<int32_t, int64_t, void*, std::string, std::vector<int8_t>>>;
+// A shared memory region sent over a parcel. Only its file descriptor counts
+// towards the size of the parcel.
+struct FakeSharedMemory {
+  std::string data;
+};
+
+using FakeData = std::vector<absl::variant<int32_t, int64_t, void*, std::string,
+                                           std::vector<int8_t>,
+                                           FakeSharedMemory>>;
 
 // A fake writable parcel.
 //
@@ -88,6 +95,7 @@ class FakeWritableParcel final : public WritableParcel {
   absl::Status WriteBinder(HasRawBinder* binder) override;
   absl::Status WriteString(absl::string_view s) override;
   absl::Status WriteByteArray(const int8_t* buffer, int32_t length) override;
+  absl::Status WriteSharedMemory(absl::string_view data) override;
 
   FakeData MoveData() { return std::move(data_); }
 
@@ -112,6 +120,8 @@ class FakeReadableParcel final : public ReadableParcel {
         data_size_ += sizeof(void*);
       } else if (absl::holds_alternative<std::string>(d)) {
         data_size_ += absl::get<std::string>(d).size();
+      } else if (absl::holds_alternative<FakeSharedMemory>(d)) {
+        data_size_ += sizeof(int32_t);
       } else {
         data_size_ += absl::get<std::vector<int8_t>>(d).size();
       }
@@ -124,6 +134,7 @@ class FakeReadableParcel final : public ReadableParcel {
   absl::Status ReadBinder(std::unique_ptr<Binder>* data) override;
   absl::Status ReadByteArray(std::string* data) override;
   absl::Status ReadString(std::string* str) override;
+  absl::Status ReadSharedMemory(std::string* data) override;
 
  private:
   const FakeData data_;
@@ -94,6 +94,11 @@ absl::Status ReadableParcelForFuzzing::ReadByteArray(std::string* data) {
   return absl::OkStatus();
 }
 
+absl::Status ReadableParcelForFuzzing::ReadSharedMemory(std::string* data) {
+  // Fuzzer inputs carry the contents of the region as a byte array.
+  return ReadByteArray(data);
+}
+
 absl::Status ReadableParcelForFuzzing::ReadString(std::string* data) {
   if (consumed_data_size_ >= kParcelDataSizeLimit) {
     return absl::InternalError("Parcel size limit exceeds");
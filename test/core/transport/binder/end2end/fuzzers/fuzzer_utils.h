@@ -54,6 +54,9 @@ class NoOpWritableParcel : public WritableParcel {
                               int32_t /*length*/) override {
     return absl::OkStatus();
   }
+  absl::Status WriteSharedMemory(absl::string_view /*data*/) override {
+    return absl::OkStatus();
+  }
 };
 
 // Binder implementation used in fuzzing.
@@ -120,6 +123,7 @@ class ReadableParcelForFuzzing : public ReadableParcel {
   absl::Status ReadBinder(std::unique_ptr<Binder>* binder) override;
   absl::Status ReadByteArray(std::string* data) override;
   absl::Status ReadString(std::string* data) override;
+  absl::Status ReadSharedMemory(std::string* data) override;
 
  private:
   // Stores data/objects in binder in their order. Since we don't support random
@@ -49,7 +49,8 @@ DEFINE_PROTO_FUZZER(const binder_transport_fuzzer::Input& input) {
         absl::make_unique<grpc_binder::fuzzing::BinderForFuzzing>(
             input.incoming_parcels()),
         std::make_shared<
-            grpc::experimental::binder::UntrustedSecurityPolicy>());
+            grpc::experimental::binder::UntrustedSecurityPolicy>(),
+        /*client_features=*/0);
     const grpc_channel_args* channel_args =
         grpc_core::CoreConfiguration::Get()
             .channel_args_preconditioning()
@@ -89,7 +89,8 @@ CreateClientServerBindersPairForTesting() {
   client_thread.Start();
   grpc_transport* server_transport = grpc_create_binder_transport_server(
       helper.WaitForClientBinder(),
-      std::make_shared<grpc::experimental::binder::UntrustedSecurityPolicy>());
+      std::make_shared<grpc::experimental::binder::UntrustedSecurityPolicy>(),
+      /*client_features=*/0);
   client_thread.Join();
   return std::make_pair(client_transport, server_transport);
 }
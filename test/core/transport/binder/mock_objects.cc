@@ -30,6 +30,7 @@ MockReadableParcel::MockReadableParcel() {
   ON_CALL(*this, ReadInt32).WillByDefault(Return(absl::OkStatus()));
   ON_CALL(*this, ReadByteArray).WillByDefault(Return(absl::OkStatus()));
   ON_CALL(*this, ReadString).WillByDefault(Return(absl::OkStatus()));
+  ON_CALL(*this, ReadSharedMemory).WillByDefault(Return(absl::OkStatus()));
 }
 
 MockWritableParcel::MockWritableParcel() {
@@ -37,6 +38,7 @@ MockWritableParcel::MockWritableParcel() {
   ON_CALL(*this, WriteBinder).WillByDefault(Return(absl::OkStatus()));
   ON_CALL(*this, WriteString).WillByDefault(Return(absl::OkStatus()));
   ON_CALL(*this, WriteByteArray).WillByDefault(Return(absl::OkStatus()));
+  ON_CALL(*this, WriteSharedMemory).WillByDefault(Return(absl::OkStatus()));
 }
 
 MockBinder::MockBinder() {
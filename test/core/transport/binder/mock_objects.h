@@ -33,6 +33,8 @@ class MockWritableParcel : public WritableParcel {
   MOCK_METHOD(absl::Status, WriteString, (absl::string_view), (override));
   MOCK_METHOD(absl::Status, WriteByteArray, (const int8_t*, int32_t),
               (override));
+  MOCK_METHOD(absl::Status, WriteSharedMemory, (absl::string_view),
+              (override));
 
   MockWritableParcel();
 };
@@ -45,6 +47,7 @@ class MockReadableParcel : public ReadableParcel {
   MOCK_METHOD(absl::Status, ReadBinder, (std::unique_ptr<Binder>*), (override));
   MOCK_METHOD(absl::Status, ReadByteArray, (std::string*), (override));
   MOCK_METHOD(absl::Status, ReadString, (std::string*), (override));
+  MOCK_METHOD(absl::Status, ReadSharedMemory, (std::string*), (override));
 
   MockReadableParcel();
 };
@@ -78,10 +81,15 @@ class MockTransactionReceiver : public TransactionReceiver {
                                    BinderTransportTxCode code,
                                    MockReadableParcel* output) {
     if (code == BinderTransportTxCode::SETUP_TRANSPORT) {
-      EXPECT_CALL(*output, ReadInt32).WillOnce([](int32_t* version) {
-        *version = 1;
-        return absl::OkStatus();
-      });
+      EXPECT_CALL(*output, ReadInt32)
+          .WillOnce([](int32_t* version) {
+            *version = 1;
+            return absl::OkStatus();
+          })
+          .WillOnce([](int32_t* features) {
+            *features = 0;
+            return absl::OkStatus();
+          });
     }
     transact_cb(static_cast<transaction_code_t>(code), output, /*uid=*/0)
         .IgnoreError();
@@ -124,6 +124,8 @@ TEST_F(WireReaderTest, SetupTransport) {
 
   // Write version.
   EXPECT_CALL(mock_binder_ref.GetWriter(), WriteInt32(1));
+  // Write the optional features after the binder.
+  EXPECT_CALL(mock_binder_ref.GetWriter(), WriteInt32(kSupportedFeatures));
 
   wire_reader_->SetupTransport(std::move(mock_binder));
 }
@@ -241,6 +243,29 @@ TEST_F(WireReaderTest, ProcessTransactionServerRpcDataFlagMessageDataEmpty) {
   EXPECT_TRUE(CallProcessTransaction(kFirstCallId).ok());
 }
 
+TEST_F(WireReaderTest,
+       ProcessTransactionServerRpcDataFlagMessageDataInSharedMemory) {
+  ::testing::InSequence sequence;
+  UnblockSetupTransport();
+
+  // flag
+  ExpectReadInt32(kFlagMessageData | kFlagMessageDataInSharedMemory);
+  // sequence number
+  ExpectReadInt32(0);
+
+  // message data, without a length in front
+  const std::string kMessageData(1 << 20, 'a');
+  EXPECT_CALL(mock_readable_parcel_, ReadSharedMemory)
+      .WillOnce([kMessageData](std::string* data) {
+        *data = kMessageData;
+        return absl::OkStatus();
+      });
+  EXPECT_CALL(*transport_stream_receiver_,
+              NotifyRecvMessage(kFirstCallId, StatusOrStrEq(kMessageData)));
+
+  EXPECT_TRUE(CallProcessTransaction(kFirstCallId).ok());
+}
+
 TEST_F(WireReaderTest, ProcessTransactionServerRpcDataFlagSuffixWithStatus) {
   ::testing::InSequence sequence;
   UnblockSetupTransport();
@@ -242,6 +242,30 @@ TEST(WireWriterTest, RpcCall) {
   }
 }
 
+TEST(WireWriterTest, RpcCallLargeMessageInSharedMemory) {
+  auto mock_binder = absl::make_unique<MockBinder>();
+  MockBinder& mock_binder_ref = *mock_binder;
+  MockWritableParcel mock_writable_parcel;
+  ON_CALL(mock_binder_ref, GetWritableParcel)
+      .WillByDefault(Return(&mock_writable_parcel));
+  WireWriterImpl wire_writer(std::move(mock_binder),
+                             kFeatureSharedMemoryMessageData);
+
+  ::testing::InSequence sequence;
+  const std::string kMessageData(2 * WireWriterImpl::kBlockSize + 1, 'a');
+  // The whole message goes in a single transaction.
+  EXPECT_CALL(mock_writable_parcel,
+              WriteInt32(kFlagMessageData | kFlagMessageDataInSharedMemory));
+  EXPECT_CALL(mock_writable_parcel, WriteInt32(0));
+  EXPECT_CALL(mock_writable_parcel,
+              WriteSharedMemory(absl::string_view(kMessageData)));
+  EXPECT_CALL(mock_binder_ref, Transact(BinderTransportTxCode(kFirstCallId)));
+
+  Transaction tx(kFirstCallId, /*is_client=*/true);
+  tx.SetData(kMessageData);
+  EXPECT_TRUE(wire_writer.RpcCall(tx).ok());
+}
+
 }  // namespace grpc_binder
 
 int main(int argc, char** argv) {
@@ -28,6 +28,7 @@
 #include <grpc/support/log.h>
 
 #include "src/core/lib/gpr/string.h"
+#include "src/core/lib/slice/b64_kernels.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "test/core/util/test_config.h"
 
@@ -92,6 +93,30 @@ static void expect_combined_equiv(const char* s, size_t len, int line) {
 #define EXPECT_COMBINED_EQUIV(x) \
   expect_combined_equiv(x, sizeof(x) - 1, __LINE__)
 
+/* The vectorized and scalar base64 kernels must produce identical output for
+ * every input length, including lengths that leave partial vector blocks. */
+static void expect_kernels_agree(void) {
+  uint8_t data[200];
+  for (size_t i = 0; i < sizeof(data); i++) {
+    data[i] = static_cast<uint8_t>(i * 37 + 11);
+  }
+  for (size_t len = 0; len <= sizeof(data); len++) {
+    grpc_slice input = grpc_slice_from_copied_buffer(
+        reinterpret_cast<const char*>(data), len);
+    grpc_core::TestOnlySetBase64KernelsScalar(true);
+    grpc_slice scalar_b64 = grpc_chttp2_base64_encode(input);
+    grpc_slice scalar_huff =
+        grpc_chttp2_base64_encode_and_huffman_compress(input);
+    grpc_core::TestOnlySetBase64KernelsScalar(false);
+    expect_slice_eq(scalar_b64, grpc_chttp2_base64_encode(input),
+                    "grpc_chttp2_base64_encode", __LINE__);
+    expect_slice_eq(scalar_huff,
+                    grpc_chttp2_base64_encode_and_huffman_compress(input),
+                    "grpc_chttp2_base64_encode_and_huffman_compress", __LINE__);
+    grpc_slice_unref(input);
+  }
+}
+
 static void expect_binary_header(const char* hdr, int binary) {
   if (grpc_is_binary_header(grpc_slice_from_static_string(hdr)) != binary) {
     gpr_log(GPR_ERROR, "FAILED: expected header '%s' to be %s", hdr,
@@ -136,6 +161,9 @@ int main(int argc, char** argv) {
   EXPECT_SLICE_EQ(
       "\x9d\x29\xad\x17\x18\x63\xc7\x8f\x0b\x97\xc8\xe9\xae\x82\xae\x43\xd3",
       HUFF("https://www.example.com"));
+  /* Codes longer than 24 bits following partially flushed output */
+  EXPECT_SLICE_EQ("\xff\xff\xfe\x2f\xff\xff\xe2\xff\xff\xfe\x2f",
+                  HUFF("\x02\x02\x02"));
 
   /* Various test vectors for combined encoding */
   EXPECT_COMBINED_EQUIV("");
@@ -170,6 +198,8 @@ int main(int argc, char** argv) {
       "\xe0\xe1\xe2\xe3\xe4\xe5\xe6\xe7\xe8\xe9\xea\xeb\xec\xed\xee\xef"
       "\xf0\xf1\xf2\xf3\xf4\xf5\xf6\xf7\xf8\xf9\xfa\xfb\xfc\xfd\xfe\xff");
 
+  expect_kernels_agree();
+
   expect_binary_header("foo-bin", 1);
   expect_binary_header("foo-bar", 0);
   expect_binary_header("-bin", 0);
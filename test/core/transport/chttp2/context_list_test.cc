@@ -27,6 +27,9 @@
 
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
 #include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/lib/channel/call_tracer.h"
+#include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/channel/tx_latency_reporter.h"
 #include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/resource_quota/api.h"
 #include "src/core/lib/transport/transport.h"
@@ -54,6 +57,38 @@ void TestExecuteFlushesListVerifier(void* arg, Timestamps* ts,
 
 void discard_write(grpc_slice /*slice*/) {}
 
+class FakeCallAttemptTracer : public CallTracer::CallAttemptTracer {
+ public:
+  struct TxLatency {
+    uint32_t byte_offset;
+    absl::Duration sent_latency;
+    absl::Duration acked_latency;
+  };
+
+  void RecordSendInitialMetadata(grpc_metadata_batch* /*metadata*/,
+                                 uint32_t /*flags*/) override {}
+  void RecordOnDoneSendInitialMetadata(gpr_atm* /*peer_string*/) override {}
+  void RecordSendTrailingMetadata(grpc_metadata_batch* /*metadata*/) override {
+  }
+  void RecordSendMessage(const ByteStream& /*send_message*/) override {}
+  void RecordReceivedInitialMetadata(grpc_metadata_batch* /*metadata*/,
+                                     uint32_t /*flags*/) override {}
+  void RecordReceivedMessage(const ByteStream& /*recv_message*/) override {}
+  void RecordReceivedTrailingMetadata(
+      absl::Status /*status*/, grpc_metadata_batch* /*metadata*/,
+      const grpc_transport_stream_stats* /*stats*/) override {}
+  void RecordCancel(grpc_error_handle cancel_error) override {
+    GRPC_ERROR_UNREF(cancel_error);
+  }
+  void RecordEnd(const gpr_timespec& /*latency*/) override {}
+  void RecordTxLatency(uint32_t byte_offset, absl::Duration sent_latency,
+                       absl::Duration acked_latency) override {
+    latencies.push_back({byte_offset, sent_latency, acked_latency});
+  }
+
+  std::vector<TxLatency> latencies;
+};
+
 class ContextListTest : public ::testing::Test {
  protected:
   void SetUp() override {
@@ -162,6 +197,65 @@ TEST_F(ContextListTest, NonEmptyListEmptyTimestamp) {
   exec_ctx.Flush();
 }
 
+TEST_F(ContextListTest, ExecuteReportsTxLatency) {
+  // Only the TxLatencyReporter path is exercised here.
+  grpc_http2_set_write_timestamps_callback(nullptr);
+  grpc_http2_set_fn_get_copied_context(nullptr);
+  ContextList* list = nullptr;
+  ExecCtx exec_ctx;
+  grpc_stream_refcount ref;
+  GRPC_STREAM_REF_INIT(&ref, 1, nullptr, nullptr, "phony ref");
+  grpc_endpoint* mock_endpoint = grpc_mock_endpoint_create(discard_write);
+  const grpc_channel_args* args = CoreConfiguration::Get()
+                                      .channel_args_preconditioning()
+                                      .PreconditionChannelArgs(nullptr)
+                                      .ToC();
+  grpc_transport* t = grpc_create_chttp2_transport(args, mock_endpoint, true);
+  grpc_channel_args_destroy(args);
+  FakeCallAttemptTracer tracer;
+  auto channelz_node =
+      MakeRefCounted<channelz::ChannelNode>("target", 0, false);
+  auto reporter = MakeRefCounted<TxLatencyReporter>(&tracer, channelz_node);
+  grpc_chttp2_stream* s = static_cast<grpc_chttp2_stream*>(
+      gpr_malloc(grpc_transport_stream_size(t)));
+  grpc_transport_init_stream(reinterpret_cast<grpc_transport*>(t),
+                             reinterpret_cast<grpc_stream*>(s), &ref, nullptr,
+                             nullptr);
+  s->byte_counter = kByteOffset;
+  s->tx_latency_reporter = reporter;
+  ContextList::Append(&list, s);
+  ASSERT_NE(list, nullptr);
+  Timestamps ts;
+  ts.sendmsg_time.time = gpr_time_from_micros(1000, GPR_CLOCK_REALTIME);
+  ts.scheduled_time.time = gpr_inf_past(GPR_CLOCK_REALTIME);
+  ts.sent_time.time = gpr_time_from_micros(1300, GPR_CLOCK_REALTIME);
+  ts.acked_time.time = gpr_inf_past(GPR_CLOCK_REALTIME);
+  ContextList::Execute(list, &ts, GRPC_ERROR_NONE);
+  ASSERT_EQ(tracer.latencies.size(), 1u);
+  EXPECT_EQ(tracer.latencies[0].byte_offset, kByteOffset);
+  EXPECT_EQ(tracer.latencies[0].sent_latency, absl::Microseconds(300));
+  EXPECT_EQ(tracer.latencies[0].acked_latency, absl::InfiniteDuration());
+  EXPECT_EQ(channelz_node->RenderJson().Dump(),
+            "{\"data\":{\"target\":\"target\",\"txLatency\":{\"sent\":"
+            "[{\"count\":\"1\",\"upperBoundMicros\":\"512\"}]}},"
+            "\"ref\":{\"channelId\":\"" +
+                std::to_string(channelz_node->uuid()) + "\"}}");
+  // Once detached, only channelz sees the timestamps.
+  reporter->Detach();
+  list = nullptr;
+  ContextList::Append(&list, s);
+  ContextList::Execute(list, &ts, GRPC_ERROR_NONE);
+  EXPECT_EQ(tracer.latencies.size(), 1u);
+  EXPECT_NE(channelz_node->RenderJsonString().find("\"count\":\"2\""),
+            std::string::npos);
+  grpc_transport_destroy_stream(reinterpret_cast<grpc_transport*>(t),
+                                reinterpret_cast<grpc_stream*>(s), nullptr);
+  exec_ctx.Flush();
+  gpr_free(s);
+  grpc_transport_destroy(t);
+  exec_ctx.Flush();
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc_core
@@ -25,6 +25,7 @@
 
 #include <functional>
 #include <set>
+#include <string>
 #include <thread>
 
 #include <gmock/gmock.h>
@@ -288,7 +289,7 @@ class FlowControlTest : public ::testing::Test {
   void SetUp() override {
     cq_ = grpc_completion_queue_create_for_next(nullptr);
     // create the server
-    std::string server_address =
+    server_address_ =
         grpc_core::JoinHostPort("localhost", grpc_pick_unused_port_or_die());
     grpc_arg server_args[] = {
         grpc_channel_arg_integer_create(
@@ -303,11 +304,17 @@ class FlowControlTest : public ::testing::Test {
     grpc_server_register_completion_queue(server_, cq_, nullptr);
     grpc_server_credentials* server_creds =
         grpc_insecure_server_credentials_create();
-    GPR_ASSERT(grpc_server_add_http2_port(server_, server_address.c_str(),
+    GPR_ASSERT(grpc_server_add_http2_port(server_, server_address_.c_str(),
                                           server_creds));
     grpc_server_credentials_release(server_creds);
     grpc_server_start(server_);
-    // create the channel (bdp pings are enabled by default)
+    channel_ = CreateChannel(/*bbr_flow_control=*/false);
+    VerifyChannelReady(channel_, cq_);
+    g_target_initial_window_size_mocker->Reset();
+  }
+
+  // Creates a channel to the server (bdp pings are enabled by default).
+  grpc_channel* CreateChannel(bool bbr_flow_control) {
     grpc_arg client_args[] = {
         grpc_channel_arg_integer_create(
             const_cast<char*>(GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA), 0),
@@ -316,15 +323,17 @@ class FlowControlTest : public ::testing::Test {
         grpc_channel_arg_integer_create(
             const_cast<char*>(GRPC_ARG_MAX_RECEIVE_MESSAGE_LENGTH), -1),
         grpc_channel_arg_integer_create(
-            const_cast<char*>(GRPC_ARG_MAX_SEND_MESSAGE_LENGTH), -1)};
+            const_cast<char*>(GRPC_ARG_MAX_SEND_MESSAGE_LENGTH), -1),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_HTTP2_BBR_FLOW_CONTROL),
+            bbr_flow_control)};
     grpc_channel_args client_channel_args = {GPR_ARRAY_SIZE(client_args),
                                              client_args};
     grpc_channel_credentials* creds = grpc_insecure_credentials_create();
-    channel_ = grpc_channel_create(server_address.c_str(), creds,
-                                   &client_channel_args);
+    grpc_channel* channel = grpc_channel_create(server_address_.c_str(), creds,
+                                                &client_channel_args);
     grpc_channel_credentials_release(creds);
-    VerifyChannelReady(channel_, cq_);
-    g_target_initial_window_size_mocker->Reset();
+    return channel;
   }
 
   void TearDown() override {
@@ -339,6 +348,7 @@ class FlowControlTest : public ::testing::Test {
     grpc_completion_queue_destroy(cq_);
   }
 
+  std::string server_address_;
   grpc_server* server_ = nullptr;
   grpc_channel* channel_ = nullptr;
   grpc_completion_queue* cq_ = nullptr;
@@ -360,6 +370,111 @@ TEST_F(FlowControlTest, TestWindowSizeUpdatesDoNotCauseStalledStreams) {
   }
 }
 
+TEST_F(FlowControlTest, TestBbrFlowControlLargePayloads) {
+  grpc_channel* channel = CreateChannel(/*bbr_flow_control=*/true);
+  VerifyChannelReady(channel, cq_);
+  for (int i = 0; i < 10; ++i) {
+    PerformCallWithLargePayload(channel, server_, cq_);
+    VerifyChannelConnected(channel, cq_);
+  }
+  grpc_channel_destroy(channel);
+}
+
+TEST(MemoryPressureWindowScaleTest, ShrinksSmoothlyAsPressureRises) {
+  using grpc_core::chttp2::MemoryPressureWindowScale;
+  EXPECT_EQ(MemoryPressureWindowScale(0), 1);
+  EXPECT_EQ(MemoryPressureWindowScale(0.5), 1);
+  EXPECT_EQ(MemoryPressureWindowScale(0.95), 0);
+  EXPECT_EQ(MemoryPressureWindowScale(1), 0);
+  double last = 1;
+  for (double pressure = 0.5; pressure <= 0.95; pressure += 0.01) {
+    const double scale = MemoryPressureWindowScale(pressure);
+    EXPECT_LE(scale, last);
+    // No step of pressure takes away more than a tenth of the window.
+    EXPECT_LT(last - scale, 0.1);
+    last = scale;
+  }
+}
+
+using grpc_core::Duration;
+using grpc_core::Timestamp;
+using grpc_core::chttp2::BbrWindowModel;
+using grpc_core::chttp2::kDefaultWindow;
+
+constexpr double kBandwidth = 10e6;  // bytes per second
+constexpr double kRtt = 0.1;         // seconds
+
+Timestamp Start() { return Timestamp::FromMillisecondsAfterProcessEpoch(1000); }
+
+TEST(BbrWindowModelTest, KeepsCurrentWindowUntilFirstSample) {
+  BbrWindowModel model(Start());
+  EXPECT_EQ(model.TargetWindow(12345, 0), 12345);
+}
+
+TEST(BbrWindowModelTest, StartupGain) {
+  BbrWindowModel model(Start());
+  model.AddSample(kBandwidth, kRtt, Start());
+  EXPECT_FALSE(model.filled_pipe());
+  EXPECT_DOUBLE_EQ(model.TargetWindow(kDefaultWindow, 0),
+                   2.885 * kBandwidth * kRtt);
+  // A small sample never aims below the default window.
+  BbrWindowModel idle_model(Start());
+  idle_model.AddSample(1000, kRtt, Start());
+  EXPECT_EQ(idle_model.TargetWindow(kDefaultWindow, 0), kDefaultWindow);
+}
+
+TEST(BbrWindowModelTest, StartupEndsWhenBandwidthStopsGrowing) {
+  BbrWindowModel model(Start());
+  double bandwidth = kBandwidth;
+  // Doubling the bandwidth keeps the startup gain.
+  for (int i = 0; i < 5; ++i) {
+    model.AddSample(bandwidth, kRtt, Start());
+    EXPECT_FALSE(model.filled_pipe());
+    bandwidth *= 2;
+  }
+  bandwidth /= 2;
+  // Three samples without 25% growth leave startup.
+  for (int i = 0; i < 2; ++i) {
+    model.AddSample(bandwidth * 1.2, kRtt, Start());
+    EXPECT_FALSE(model.filled_pipe());
+  }
+  model.AddSample(bandwidth * 1.2, kRtt, Start());
+  EXPECT_TRUE(model.filled_pipe());
+  EXPECT_DOUBLE_EQ(model.bottleneck_bandwidth(), bandwidth * 1.2);
+  EXPECT_DOUBLE_EQ(model.TargetWindow(kDefaultWindow, 0),
+                   2 * bandwidth * 1.2 * kRtt);
+}
+
+TEST(BbrWindowModelTest, MinRttExpires) {
+  BbrWindowModel model(Start());
+  model.AddSample(kBandwidth, kRtt, Start());
+  // A larger RTT does not replace a recent min RTT, a smaller one does.
+  model.AddSample(kBandwidth, 2 * kRtt, Start() + Duration::Seconds(5));
+  EXPECT_DOUBLE_EQ(model.min_rtt(), kRtt);
+  model.AddSample(kBandwidth, kRtt / 2, Start() + Duration::Seconds(6));
+  EXPECT_DOUBLE_EQ(model.min_rtt(), kRtt / 2);
+  // Over 10s after the min RTT was taken, the next sample replaces it.
+  model.AddSample(kBandwidth, 2 * kRtt, Start() + Duration::Seconds(15));
+  EXPECT_DOUBLE_EQ(model.min_rtt(), kRtt / 2);
+  model.AddSample(kBandwidth, 2 * kRtt, Start() + Duration::Seconds(17));
+  EXPECT_DOUBLE_EQ(model.min_rtt(), 2 * kRtt);
+}
+
+TEST(BbrWindowModelTest, MemoryPressureOnlyShrinksWindow) {
+  BbrWindowModel model(Start());
+  model.AddSample(kBandwidth, kRtt, Start());
+  const double target = model.TargetWindow(kDefaultWindow, 0);
+  // Low pressure does not inflate the window.
+  EXPECT_DOUBLE_EQ(model.TargetWindow(kDefaultWindow, 0.5), target);
+  EXPECT_DOUBLE_EQ(model.TargetWindow(kDefaultWindow, 0.8), target);
+  EXPECT_NEAR(model.TargetWindow(kDefaultWindow, 0.85), target / 2, 1);
+  EXPECT_EQ(model.TargetWindow(kDefaultWindow, 0.95), 0);
+  // The current window shrinks too before the first sample.
+  BbrWindowModel unsampled_model(Start());
+  EXPECT_NEAR(unsampled_model.TargetWindow(kDefaultWindow, 0.85),
+              kDefaultWindow / 2.0, 1);
+}
+
 }  // namespace
 
 int main(int argc, char** argv) {
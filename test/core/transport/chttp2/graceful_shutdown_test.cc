@@ -22,12 +22,11 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include <thread>
+#include <string>
 
 #include <gmock/gmock.h>
 
-#include "absl/synchronization/mutex.h"
-#include "absl/synchronization/notification.h"
+#include "absl/strings/str_cat.h"
 
 #include <grpc/grpc.h>
 #include <grpc/grpc_posix.h>
@@ -39,12 +38,12 @@
 #include "src/core/lib/channel/channel_stack_builder.h"
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/gprpp/host_port.h"
-#include "src/core/lib/iomgr/endpoint_pair.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/surface/server.h"
 #include "test/core/end2end/cq_verifier.h"
+#include "test/core/transport/chttp2/raw_http2_server_fixture.h"
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
 #include "test/core/util/test_tcp_server.h"
@@ -54,122 +53,15 @@ namespace {
 
 void* Tag(intptr_t t) { return reinterpret_cast<void*>(t); }
 
-class GracefulShutdownTest : public ::testing::Test {
+class GracefulShutdownTest : public testing::RawHttp2ServerTest {
  protected:
-  GracefulShutdownTest() { SetupAndStart(); }
-
-  ~GracefulShutdownTest() override { ShutdownAndDestroy(); }
-
-  // Sets up the client and server
-  void SetupAndStart() {
-    ExecCtx exec_ctx;
-    cq_ = grpc_completion_queue_create_for_next(nullptr);
-    cqv_ = cq_verifier_create(cq_);
+  GracefulShutdownTest() {
     grpc_arg server_args[] = {
         grpc_channel_arg_integer_create(
             const_cast<char*>(GRPC_ARG_HTTP2_BDP_PROBE), 0),
         grpc_channel_arg_integer_create(
             const_cast<char*>(GRPC_ARG_KEEPALIVE_TIME_MS), INT_MAX)};
-    grpc_channel_args server_channel_args = {GPR_ARRAY_SIZE(server_args),
-                                             server_args};
-    // Create server
-    server_ = grpc_server_create(&server_channel_args, nullptr);
-    auto* core_server = Server::FromC(server_);
-    grpc_server_register_completion_queue(server_, cq_, nullptr);
-    grpc_server_start(server_);
-    fds_ = grpc_iomgr_create_endpoint_pair("fixture", nullptr);
-    auto* transport = grpc_create_chttp2_transport(core_server->channel_args(),
-                                                   fds_.server, false);
-    grpc_endpoint_add_to_pollset(fds_.server, grpc_cq_pollset(cq_));
-    GPR_ASSERT(core_server->SetupTransport(transport, nullptr,
-                                           core_server->channel_args(),
-                                           nullptr) == GRPC_ERROR_NONE);
-    grpc_chttp2_transport_start_reading(transport, nullptr, nullptr, nullptr);
-    // Start polling on the client
-    absl::Notification client_poller_thread_started_notification;
-    client_poll_thread_ = absl::make_unique<std::thread>(
-        [this, &client_poller_thread_started_notification]() {
-          grpc_completion_queue* client_cq =
-              grpc_completion_queue_create_for_next(nullptr);
-          {
-            ExecCtx exec_ctx;
-            grpc_endpoint_add_to_pollset(fds_.client,
-                                         grpc_cq_pollset(client_cq));
-            grpc_endpoint_add_to_pollset(fds_.server,
-                                         grpc_cq_pollset(client_cq));
-          }
-          client_poller_thread_started_notification.Notify();
-          while (!shutdown_) {
-            GPR_ASSERT(grpc_completion_queue_next(
-                           client_cq, grpc_timeout_milliseconds_to_deadline(10),
-                           nullptr)
-                           .type == GRPC_QUEUE_TIMEOUT);
-          }
-          grpc_completion_queue_destroy(client_cq);
-        });
-    client_poller_thread_started_notification.WaitForNotification();
-    // Write connection prefix and settings frame
-    constexpr char kPrefix[] =
-        "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n\x00\x00\x00\x04\x00\x00\x00\x00\x00";
-    Write(absl::string_view(kPrefix, sizeof(kPrefix) - 1));
-    // Start reading on the client
-    grpc_slice_buffer_init(&read_buffer_);
-    GRPC_CLOSURE_INIT(&on_read_done_, OnReadDone, this, nullptr);
-    grpc_endpoint_read(fds_.client, &read_buffer_, &on_read_done_, false,
-                       /*min_progress_size=*/1);
-  }
-
-  // Shuts down and destroys the client and server.
-  void ShutdownAndDestroy() {
-    shutdown_ = true;
-    ExecCtx exec_ctx;
-    grpc_endpoint_shutdown(
-        fds_.client, GRPC_ERROR_CREATE_FROM_STATIC_STRING("Client shutdown"));
-    ExecCtx::Get()->Flush();
-    client_poll_thread_->join();
-    GPR_ASSERT(read_end_notification_.WaitForNotificationWithTimeout(
-        absl::Seconds(5)));
-    grpc_endpoint_destroy(fds_.client);
-    ExecCtx::Get()->Flush();
-    // Shutdown and destroy server
-    grpc_server_shutdown_and_notify(server_, cq_, Tag(1000));
-    CQ_EXPECT_COMPLETION(cqv_, Tag(1000), true);
-    cq_verify(cqv_);
-    grpc_server_destroy(server_);
-    cq_verifier_destroy(cqv_);
-    grpc_completion_queue_destroy(cq_);
-  }
-
-  static void OnReadDone(void* arg, grpc_error_handle error) {
-    GracefulShutdownTest* self = static_cast<GracefulShutdownTest*>(arg);
-    if (error == GRPC_ERROR_NONE) {
-      {
-        MutexLock lock(&self->mu_);
-        for (size_t i = 0; i < self->read_buffer_.count; ++i) {
-          absl::StrAppend(&self->read_bytes_,
-                          StringViewFromSlice(self->read_buffer_.slices[i]));
-        }
-        self->read_cv_.SignalAll();
-      }
-      grpc_slice_buffer_reset_and_unref(&self->read_buffer_);
-      grpc_endpoint_read(self->fds_.client, &self->read_buffer_,
-                         &self->on_read_done_, false, /*min_progress_size=*/1);
-    } else {
-      grpc_slice_buffer_destroy(&self->read_buffer_);
-      self->read_end_notification_.Notify();
-    }
-  }
-
-  // Waits for \a bytes to show up in read_bytes_
-  void WaitForReadBytes(absl::string_view bytes) {
-    std::atomic<bool> done{false};
-    {
-      MutexLock lock(&mu_);
-      while (!absl::StrContains(read_bytes_, bytes)) {
-        read_cv_.WaitWithTimeout(&mu_, absl::Seconds(5));
-      }
-    }
-    done = true;
+    SetupAndStart({GPR_ARRAY_SIZE(server_args), server_args});
   }
 
   void WaitForGoaway(uint32_t last_stream_id, uint32_t error_code = 0,
@@ -194,52 +86,6 @@ class GracefulShutdownTest : public ::testing::Test {
     grpc_slice ping_slice = grpc_chttp2_ping_create(1, opaque_data);
     Write(StringViewFromSlice(ping_slice));
   }
-
-  // This is a blocking call. It waits for the write callback to be invoked
-  // before returning. (In other words, do not call this from a thread that
-  // should not be blocked, for example, a polling thread.)
-  void Write(absl::string_view bytes) {
-    ExecCtx exec_ctx;
-    grpc_slice slice =
-        StaticSlice::FromStaticBuffer(bytes.data(), bytes.size()).TakeCSlice();
-    grpc_slice_buffer buffer;
-    grpc_slice_buffer_init(&buffer);
-    grpc_slice_buffer_add(&buffer, slice);
-    WriteBuffer(&buffer);
-    grpc_slice_buffer_destroy(&buffer);
-  }
-
-  void WriteBuffer(grpc_slice_buffer* buffer) {
-    absl::Notification on_write_done_notification_;
-    GRPC_CLOSURE_INIT(&on_write_done_, OnWriteDone,
-                      &on_write_done_notification_, nullptr);
-    grpc_endpoint_write(fds_.client, buffer, &on_write_done_, nullptr,
-                        /*max_frame_size=*/INT_MAX);
-    ExecCtx::Get()->Flush();
-    GPR_ASSERT(on_write_done_notification_.WaitForNotificationWithTimeout(
-        absl::Seconds(5)));
-  }
-
-  static void OnWriteDone(void* arg, grpc_error_handle error) {
-    GPR_ASSERT(error == GRPC_ERROR_NONE);
-    absl::Notification* on_write_done_notification_ =
-        static_cast<absl::Notification*>(arg);
-    on_write_done_notification_->Notify();
-  }
-
-  grpc_endpoint_pair fds_;
-  grpc_server* server_ = nullptr;
-  grpc_completion_queue* cq_ = nullptr;
-  cq_verifier* cqv_ = nullptr;
-  std::unique_ptr<std::thread> client_poll_thread_;
-  std::atomic<bool> shutdown_{false};
-  grpc_closure on_read_done_;
-  Mutex mu_;
-  CondVar read_cv_;
-  absl::Notification read_end_notification_;
-  grpc_slice_buffer read_buffer_;
-  std::string read_bytes_ ABSL_GUARDED_BY(mu_);
-  grpc_closure on_write_done_;
 };
 
 TEST_F(GracefulShutdownTest, GracefulGoaway) {
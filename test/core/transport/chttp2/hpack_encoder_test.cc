@@ -211,10 +211,26 @@ static void test_basic_headers() {
       false,
   };
   verify(params, "000005 0104 deadbeef 00 0161 0161", 1, "a", "a");
-  verify(params, "00000a 0104 deadbeef 00 0161 0161 00 0162 0163", 2, "a", "a",
+  // The value of a repeats, so it is now worth a table entry.
+  verify(params, "00000a 0104 deadbeef 40 0161 0161 00 0162 0163", 2, "a", "a",
          "b", "c");
 }
 
+static void test_values_indexed_once_repeated() {
+  verify_params params = {
+      false,
+      false,
+  };
+  // Values seen once are not added to the table.
+  verify(params, "000005 0104 deadbeef 00 0161 0162", 1, "a", "b");
+  verify(params, "000005 0104 deadbeef 00 0161 0163", 1, "a", "c");
+  verify(params, "000005 0104 deadbeef 00 0161 0164", 1, "a", "d");
+  // A repeated value is added, and referred to afterwards.
+  verify(params, "000005 0104 deadbeef 40 0161 0163", 1, "a", "c");
+  verify(params, "000001 0104 deadbeef be", 1, "a", "c");
+  verify(params, "000005 0104 deadbeef 00 0161 0165", 1, "a", "e");
+}
+
 static void verify_continuation_headers(const char* key, const char* value,
                                         bool is_eof) {
   auto arena = grpc_core::MakeScopedArena(1024, g_memory_allocator);
@@ -248,6 +264,48 @@ static void test_continuation_headers() {
   verify_continuation_headers("key2", value2, true);
 }
 
+static void verify_pre_encoded(grpc_core::PreEncodedMetadata* md,
+                               const char* expected) {
+  auto arena = grpc_core::MakeScopedArena(1024, g_memory_allocator);
+  grpc_metadata_batch b(arena.get());
+  b.Append(md->key(), grpc_core::Slice(md->RefValueSlice()),
+           CrashOnAppendError);
+  grpc_slice_buffer output;
+  grpc_slice_buffer_init(&output);
+  grpc_transport_one_way_stats stats;
+  stats = {};
+  grpc_core::HPackCompressor::EncodeHeaderOptions hopt = {
+      0xdeadbeef, /* stream_id */
+      false,      /* is_eof */
+      false,      /* use_true_binary_metadata */
+      16384,      /* max_frame_size */
+      &stats /* stats */};
+  g_compressor->EncodeHeaders(hopt, b, &output);
+  verify_frames(output, false);
+  grpc_slice merged = grpc_slice_merge(output.slices, output.count);
+  grpc_slice_buffer_destroy_internal(&output);
+  grpc_slice expect = parse_hexstring(expected);
+  if (!grpc_slice_eq(merged, expect)) {
+    char* got_str = grpc_dump_slice(merged, GPR_DUMP_HEX);
+    gpr_log(GPR_ERROR, "mismatched output for %s", expected);
+    gpr_log(GPR_ERROR, "GOT:    %s", got_str);
+    gpr_free(got_str);
+    g_failure = 1;
+  }
+  grpc_slice_unref_internal(merged);
+  grpc_slice_unref_internal(expect);
+}
+
+static void test_pre_encoded_headers() {
+  grpc_core::PreEncodedMetadata* md =
+      grpc_core::PreEncodedMetadata::Create("a", "b");
+  // First use inserts into the dynamic table, later uses refer to it.
+  verify_pre_encoded(md, "000005 0104 deadbeef 40 0161 0162");
+  verify_pre_encoded(md, "000001 0104 deadbeef be");
+  verify_pre_encoded(md, "000001 0104 deadbeef be");
+  md->Unref();
+}
+
 static void run_test(void (*test)(), const char* name) {
   gpr_log(GPR_INFO, "RUN TEST: %s", name);
   grpc_core::ExecCtx exec_ctx;
@@ -261,7 +319,9 @@ int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   grpc_init();
   TEST(test_basic_headers);
+  TEST(test_values_indexed_once_repeated);
   TEST(test_continuation_headers);
+  TEST(test_pre_encoded_headers);
   grpc_shutdown();
   return g_failure;
 }
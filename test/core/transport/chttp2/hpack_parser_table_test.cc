@@ -139,6 +139,31 @@ TEST(HpackParserTableTest, ManyAdditions) {
   }
 }
 
+TEST(HpackParserTableTest, CountsEvictions) {
+  ExecCtx exec_ctx;
+  HPackTable tbl;
+
+  // Each entry takes 32 bytes of overhead plus 8 of key and value, so the
+  // default 4096 byte table holds 102 of them.
+  for (int i = 0; i < 102; i++) {
+    ASSERT_EQ(tbl.Add(HPackTable::Memento(
+                  Slice::FromCopiedString(absl::StrCat("k", i % 10, "xx")),
+                  Slice::FromCopiedString("vvvv"))),
+              GRPC_ERROR_NONE);
+  }
+  EXPECT_EQ(tbl.num_entries(), 102);
+  EXPECT_EQ(tbl.num_evictions(), 0);
+  ASSERT_EQ(tbl.Add(HPackTable::Memento(Slice::FromCopiedString("k0xx"),
+                                        Slice::FromCopiedString("vvvv"))),
+            GRPC_ERROR_NONE);
+  EXPECT_EQ(tbl.num_entries(), 102);
+  EXPECT_EQ(tbl.num_evictions(), 1);
+  // Shrinking the table is not counted.
+  tbl.SetMaxBytes(0);
+  EXPECT_EQ(tbl.num_entries(), 0);
+  EXPECT_EQ(tbl.num_evictions(), 1);
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
@@ -0,0 +1,124 @@
+//
+//
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <grpc/support/port_platform.h>
+
+#include <limits.h>
+
+#include <vector>
+
+#include <gmock/gmock.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/time.h"
+#include "test/core/transport/chttp2/raw_http2_server_fixture.h"
+#include "test/core/util/test_config.h"
+
+// Checks that a transport that keeps reading sends no keepalive pings, and
+// that it sends one once the peer has been quiet for the keepalive time.
+
+namespace grpc_core {
+namespace {
+
+constexpr uint8_t kFrameTypePing = 6;
+constexpr uint8_t kFlagAck = 1;
+
+Duration KeepaliveTime() {
+  return Duration::Milliseconds(1000 * grpc_test_slowdown_factor());
+}
+
+class KeepalivePingTest : public testing::RawHttp2ServerTest {
+ protected:
+  // Sets up a server transport with keepalive pings enabled even without
+  // calls.
+  void SetupAndStart() {
+    grpc_arg server_args[] = {
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_HTTP2_BDP_PROBE), 0),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_KEEPALIVE_TIME_MS),
+            KeepaliveTime().millis()),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_KEEPALIVE_TIMEOUT_MS), INT_MAX),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS), 1),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA), 0)};
+    RawHttp2ServerTest::SetupAndStart(
+        {GPR_ARRAY_SIZE(server_args), server_args});
+  }
+
+  // The number of keepalive pings, that is PING frames that are not acks.
+  static int Pings(const std::vector<Frame>& frames) {
+    int pings = 0;
+    for (const Frame& frame : frames) {
+      if (frame.type == kFrameTypePing && (frame.flags & kFlagAck) == 0) {
+        ++pings;
+      }
+    }
+    return pings;
+  }
+
+  // Waits for a keepalive ping to be read, and returns whether it was.
+  bool WaitForPing(absl::Duration timeout) {
+    return WaitForFrames(
+        [](const std::vector<Frame>& frames) { return Pings(frames) > 0; },
+        timeout);
+  }
+};
+
+TEST_F(KeepalivePingTest, PingSentAfterIdle) {
+  const absl::Time start = absl::Now();
+  SetupAndStart();
+  ASSERT_TRUE(WaitForPing(absl::Seconds(10)));
+  // The keepalive time counts from the last read, which was the prefix.
+  // Allow a tenth of it for the time being cached by the transport's ExecCtx.
+  const absl::Duration elapsed = absl::Now() - start;
+  EXPECT_GE(elapsed, absl::Milliseconds(KeepaliveTime().millis() * 9 / 10));
+}
+
+TEST_F(KeepalivePingTest, NoPingWhileReading) {
+  SetupAndStart();
+  // A connection WINDOW_UPDATE every tenth of the keepalive time, for three
+  // times the keepalive time.
+  constexpr char kWindowUpdate[] =
+      "\x00\x00\x04\x08\x00\x00\x00\x00\x00"
+      "\x00\x00\x00\x01";
+  for (int i = 0; i < 30; ++i) {
+    Write(absl::string_view(kWindowUpdate, sizeof(kWindowUpdate) - 1));
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(
+        KeepaliveTime().millis() / 10));
+  }
+  EXPECT_EQ(Pings(Frames()), 0);
+  // Once the reads stop, the keepalive ping follows.
+  EXPECT_TRUE(WaitForPing(absl::Seconds(10)));
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int result = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return result;
+}
@@ -0,0 +1,271 @@
+//
+//
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "test/core/transport/chttp2/raw_http2_server_fixture.h"
+
+#include <limits.h>
+#include <string.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/byte_buffer.h>
+
+#include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/lib/surface/completion_queue.h"
+#include "src/core/lib/surface/server.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+void* Tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+// Request for /foo/bar on the stream id in the last byte of the frame header,
+// with literal headers only, so that it can be sent again for another
+// stream.
+constexpr char kRequestFrame[] =
+    "\x00\x00\xbe\x01\x05\x00\x00\x00\x01"
+    "\x10\x05:path\x08/foo/bar"
+    "\x10\x07:scheme\x04http"
+    "\x10\x07:method\x04POST"
+    "\x10\x0a:authority\x09localhost"
+    "\x10\x0c"
+    "content-type\x10"
+    "application/grpc"
+    "\x10\x14grpc-accept-encoding\x15identity,deflate,gzip"
+    "\x10\x02te\x08trailers"
+    "\x10\x0auser-agent\x17grpc-c/0.12.0.0 (linux)";
+
+}  // namespace
+
+RawHttp2ServerTest::~RawHttp2ServerTest() {
+  if (server_ != nullptr) ShutdownAndDestroy();
+}
+
+void RawHttp2ServerTest::SetupAndStart(const grpc_channel_args& server_args,
+                                       absl::string_view settings) {
+  ExecCtx exec_ctx;
+  cq_ = grpc_completion_queue_create_for_next(nullptr);
+  cqv_ = cq_verifier_create(cq_);
+  // Create server
+  server_ = grpc_server_create(&server_args, nullptr);
+  auto* core_server = Server::FromC(server_);
+  grpc_server_register_completion_queue(server_, cq_, nullptr);
+  grpc_server_start(server_);
+  fds_ = grpc_iomgr_create_endpoint_pair("fixture", nullptr);
+  auto* transport = grpc_create_chttp2_transport(core_server->channel_args(),
+                                                 fds_.server, false);
+  grpc_endpoint_add_to_pollset(fds_.server, grpc_cq_pollset(cq_));
+  GPR_ASSERT(core_server->SetupTransport(transport, nullptr,
+                                         core_server->channel_args(),
+                                         nullptr) == GRPC_ERROR_NONE);
+  grpc_chttp2_transport_start_reading(transport, nullptr, nullptr, nullptr);
+  // Start polling on the client
+  absl::Notification client_poller_thread_started_notification;
+  client_poll_thread_ = absl::make_unique<std::thread>(
+      [this, &client_poller_thread_started_notification]() {
+        grpc_completion_queue* client_cq =
+            grpc_completion_queue_create_for_next(nullptr);
+        {
+          ExecCtx exec_ctx;
+          grpc_endpoint_add_to_pollset(fds_.client,
+                                       grpc_cq_pollset(client_cq));
+          grpc_endpoint_add_to_pollset(fds_.server,
+                                       grpc_cq_pollset(client_cq));
+        }
+        client_poller_thread_started_notification.Notify();
+        while (!shutdown_) {
+          GPR_ASSERT(grpc_completion_queue_next(
+                         client_cq, grpc_timeout_milliseconds_to_deadline(10),
+                         nullptr)
+                         .type == GRPC_QUEUE_TIMEOUT);
+        }
+        grpc_completion_queue_destroy(client_cq);
+      });
+  client_poller_thread_started_notification.WaitForNotification();
+  // Write connection prefix and settings frame
+  constexpr char kPreface[] = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+  Write(absl::StrCat(absl::string_view(kPreface, sizeof(kPreface) - 1),
+                     settings));
+  // Start reading on the client
+  grpc_slice_buffer_init(&read_buffer_);
+  GRPC_CLOSURE_INIT(&on_read_done_, OnReadDone, this, nullptr);
+  grpc_endpoint_read(fds_.client, &read_buffer_, &on_read_done_, false,
+                     /*min_progress_size=*/1);
+}
+
+void RawHttp2ServerTest::ShutdownAndDestroy() {
+  shutdown_ = true;
+  ExecCtx exec_ctx;
+  grpc_endpoint_shutdown(
+      fds_.client, GRPC_ERROR_CREATE_FROM_STATIC_STRING("Client shutdown"));
+  ExecCtx::Get()->Flush();
+  client_poll_thread_->join();
+  GPR_ASSERT(read_end_notification_.WaitForNotificationWithTimeout(
+      absl::Seconds(5)));
+  grpc_endpoint_destroy(fds_.client);
+  ExecCtx::Get()->Flush();
+  // Shutdown and destroy server
+  grpc_server_shutdown_and_notify(server_, cq_, Tag(1000));
+  grpc_server_cancel_all_calls(server_);
+  CQ_EXPECT_COMPLETION(cqv_, Tag(1000), true);
+  cq_verify(cqv_);
+  grpc_server_destroy(server_);
+  server_ = nullptr;
+  cq_verifier_destroy(cqv_);
+  grpc_completion_queue_destroy(cq_);
+}
+
+void RawHttp2ServerTest::OnReadDone(void* arg, grpc_error_handle error) {
+  RawHttp2ServerTest* self = static_cast<RawHttp2ServerTest*>(arg);
+  if (error == GRPC_ERROR_NONE) {
+    {
+      MutexLock lock(&self->mu_);
+      for (size_t i = 0; i < self->read_buffer_.count; ++i) {
+        absl::StrAppend(&self->read_bytes_,
+                        StringViewFromSlice(self->read_buffer_.slices[i]));
+      }
+      self->read_cv_.SignalAll();
+    }
+    grpc_slice_buffer_reset_and_unref(&self->read_buffer_);
+    grpc_endpoint_read(self->fds_.client, &self->read_buffer_,
+                       &self->on_read_done_, false, /*min_progress_size=*/1);
+  } else {
+    grpc_slice_buffer_destroy(&self->read_buffer_);
+    self->read_end_notification_.Notify();
+  }
+}
+
+void RawHttp2ServerTest::WaitForReadBytes(absl::string_view bytes) {
+  MutexLock lock(&mu_);
+  while (!absl::StrContains(read_bytes_, bytes)) {
+    read_cv_.WaitWithTimeout(&mu_, absl::Seconds(5));
+  }
+}
+
+std::vector<RawHttp2ServerTest::Frame> RawHttp2ServerTest::FramesLocked() {
+  std::vector<Frame> frames;
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(read_bytes_.data());
+  size_t remaining = read_bytes_.size();
+  while (remaining >= 9) {
+    Frame frame;
+    frame.length = (uint32_t(p[0]) << 16) | (uint32_t(p[1]) << 8) | p[2];
+    frame.type = p[3];
+    frame.flags = p[4];
+    frame.stream_id = ((uint32_t(p[5]) & 0x7f) << 24) |
+                      (uint32_t(p[6]) << 16) | (uint32_t(p[7]) << 8) | p[8];
+    if (remaining < 9 + frame.length) break;
+    frames.push_back(frame);
+    p += 9 + frame.length;
+    remaining -= 9 + frame.length;
+  }
+  return frames;
+}
+
+std::vector<RawHttp2ServerTest::Frame> RawHttp2ServerTest::Frames() {
+  MutexLock lock(&mu_);
+  return FramesLocked();
+}
+
+bool RawHttp2ServerTest::WaitForFrames(
+    const std::function<bool(const std::vector<Frame>&)>& done,
+    absl::Duration timeout, std::vector<Frame>* frames) {
+  MutexLock lock(&mu_);
+  const absl::Time deadline = absl::Now() + timeout;
+  bool timed_out = false;
+  while (true) {
+    std::vector<Frame> read = FramesLocked();
+    const bool is_done = done(read);
+    if (frames != nullptr) *frames = std::move(read);
+    if (is_done || timed_out) return is_done;
+    timed_out = read_cv_.WaitWithDeadline(&mu_, deadline);
+  }
+}
+
+void RawHttp2ServerTest::Write(absl::string_view bytes) {
+  ExecCtx exec_ctx;
+  grpc_slice slice = grpc_slice_from_copied_buffer(bytes.data(), bytes.size());
+  grpc_slice_buffer buffer;
+  grpc_slice_buffer_init(&buffer);
+  grpc_slice_buffer_add(&buffer, slice);
+  absl::Notification on_write_done_notification;
+  GRPC_CLOSURE_INIT(&on_write_done_, OnWriteDone, &on_write_done_notification,
+                    nullptr);
+  grpc_endpoint_write(fds_.client, &buffer, &on_write_done_, nullptr,
+                      /*max_frame_size=*/INT_MAX);
+  ExecCtx::Get()->Flush();
+  GPR_ASSERT(on_write_done_notification.WaitForNotificationWithTimeout(
+      absl::Seconds(5)));
+  grpc_slice_buffer_destroy(&buffer);
+}
+
+grpc_call* RawHttp2ServerTest::StartRequest(uint8_t stream_id, intptr_t tag) {
+  grpc_call* call;
+  grpc_call_details call_details;
+  grpc_metadata_array request_metadata;
+  grpc_call_details_init(&call_details);
+  grpc_metadata_array_init(&request_metadata);
+  GPR_ASSERT(GRPC_CALL_OK == grpc_server_request_call(
+                                 server_, &call, &call_details,
+                                 &request_metadata, cq_, cq_, Tag(tag)));
+  std::string frame(kRequestFrame, sizeof(kRequestFrame) - 1);
+  frame[8] = static_cast<char>(stream_id);
+  Write(frame);
+  CQ_EXPECT_COMPLETION(cqv_, Tag(tag), true);
+  cq_verify(cqv_);
+  grpc_call_details_destroy(&call_details);
+  grpc_metadata_array_destroy(&request_metadata);
+  return call;
+}
+
+grpc_byte_buffer* RawHttp2ServerTest::SendResponse(grpc_call* call,
+                                                   size_t size, bool finish,
+                                                   intptr_t tag) {
+  grpc_slice payload = grpc_slice_malloc(size);
+  memset(GRPC_SLICE_START_PTR(payload), 'a', size);
+  grpc_byte_buffer* message = grpc_raw_byte_buffer_create(&payload, 1);
+  grpc_slice_unref(payload);
+  grpc_slice status_details = grpc_slice_from_static_string("done");
+  grpc_op ops[3];
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  ops[1].op = GRPC_OP_SEND_MESSAGE;
+  ops[1].data.send_message.send_message = message;
+  ops[2].op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+  ops[2].data.send_status_from_server.status = GRPC_STATUS_OK;
+  ops[2].data.send_status_from_server.status_details = &status_details;
+  GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(call, ops, finish ? 3 : 2,
+                                                   Tag(tag), nullptr));
+  return message;
+}
+
+void RawHttp2ServerTest::OnWriteDone(void* arg, grpc_error_handle error) {
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+  static_cast<absl::Notification*>(arg)->Notify();
+}
+
+}  // namespace testing
+}  // namespace grpc_core
@@ -0,0 +1,130 @@
+//
+//
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#ifndef GRPC_TEST_CORE_TRANSPORT_CHTTP2_RAW_HTTP2_SERVER_FIXTURE_H
+#define GRPC_TEST_CORE_TRANSPORT_CHTTP2_RAW_HTTP2_SERVER_FIXTURE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/time.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/endpoint_pair.h"
+#include "test/core/end2end/cq_verifier.h"
+
+namespace grpc_core {
+namespace testing {
+
+// A SETTINGS frame with no settings.
+constexpr absl::string_view kEmptySettingsFrame(
+    "\x00\x00\x00\x04\x00\x00\x00\x00\x00", 9);
+
+// Fixture for tests of the server side of chttp2 that play the client
+// themselves: a server transport sits on one end of an endpoint pair, and
+// the test writes raw HTTP/2 to the other end and reads what comes back.
+class RawHttp2ServerTest : public ::testing::Test {
+ protected:
+  struct Frame {
+    uint8_t type;
+    uint8_t flags;
+    uint32_t stream_id;
+    uint32_t length;
+  };
+
+  ~RawHttp2ServerTest() override;
+
+  // Starts a server with server_args and a transport for it, and writes the
+  // connection preface followed by settings, which must be a complete
+  // SETTINGS frame.
+  void SetupAndStart(const grpc_channel_args& server_args,
+                     absl::string_view settings = kEmptySettingsFrame);
+
+  // Shuts down and destroys the client and server. Done on destruction if
+  // the test has not done it already.
+  void ShutdownAndDestroy();
+
+  // Waits for bytes to show up in what the server wrote.
+  void WaitForReadBytes(absl::string_view bytes);
+
+  // The complete frames the server wrote so far.
+  std::vector<Frame> Frames();
+
+  // Waits up to timeout for done to return true for the complete frames the
+  // server wrote, and returns whether it did. If frames is not null, it is
+  // set to the frames done was last called with.
+  bool WaitForFrames(
+      const std::function<bool(const std::vector<Frame>&)>& done,
+      absl::Duration timeout, std::vector<Frame>* frames = nullptr);
+
+  // This is a blocking call. It waits for the write callback to be invoked
+  // before returning. (In other words, do not call this from a thread that
+  // should not be blocked, for example, a polling thread.)
+  void Write(absl::string_view bytes);
+
+  // Starts a request for /foo/bar on stream_id, and returns the server call
+  // for it once the server has it.
+  grpc_call* StartRequest(uint8_t stream_id, intptr_t tag);
+
+  // Sends initial metadata and a message of size bytes on call, and the
+  // status too if finish. Returns the message, to be destroyed once the
+  // batch is done.
+  static grpc_byte_buffer* SendResponse(grpc_call* call, size_t size,
+                                        bool finish, intptr_t tag);
+
+  grpc_endpoint_pair fds_;
+  grpc_server* server_ = nullptr;
+  grpc_completion_queue* cq_ = nullptr;
+  cq_verifier* cqv_ = nullptr;
+
+ private:
+  static void OnReadDone(void* arg, grpc_error_handle error);
+  static void OnWriteDone(void* arg, grpc_error_handle error);
+
+  std::vector<Frame> FramesLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  std::unique_ptr<std::thread> client_poll_thread_;
+  std::atomic<bool> shutdown_{false};
+  grpc_closure on_read_done_;
+  Mutex mu_;
+  CondVar read_cv_;
+  absl::Notification read_end_notification_;
+  grpc_slice_buffer read_buffer_;
+  std::string read_bytes_ ABSL_GUARDED_BY(mu_);
+  grpc_closure on_write_done_;
+};
+
+}  // namespace testing
+}  // namespace grpc_core
+
+#endif  // GRPC_TEST_CORE_TRANSPORT_CHTTP2_RAW_HTTP2_SERVER_FIXTURE_H
@@ -167,6 +167,44 @@ static void test_periodic_compaction(uint32_t n) {
   grpc_chttp2_stream_map_destroy(&map);
 }
 
+struct delete_during_for_each_state {
+  grpc_chttp2_stream_map* map;
+  uint32_t next_expected;
+};
+
+/* deletes the visited key and the one after it: the latter must not be
+   visited */
+static void delete_visited_and_next(void* user_data, uint32_t stream_id,
+                                    void* ptr) {
+  delete_during_for_each_state* state =
+      static_cast<delete_during_for_each_state*>(user_data);
+  GPR_ASSERT(state->next_expected == stream_id);
+  GPR_ASSERT(ptr == grpc_chttp2_stream_map_delete(state->map, stream_id));
+  if (grpc_chttp2_stream_map_find(state->map, stream_id + 1) != nullptr) {
+    grpc_chttp2_stream_map_delete(state->map, stream_id + 1);
+  }
+  state->next_expected += 2;
+}
+
+/* delete entries from within for_each, as closing streams does */
+static void test_delete_during_for_each(uint32_t n) {
+  grpc_chttp2_stream_map map;
+  uint32_t i;
+
+  LOG_TEST("test_delete_during_for_each");
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (i = 1; i <= n + 1; i++) {
+    grpc_chttp2_stream_map_add(&map, i, reinterpret_cast<void*>(i));
+  }
+  delete_during_for_each_state state = {&map, 1};
+  grpc_chttp2_stream_map_for_each(&map, delete_visited_and_next, &state);
+  GPR_ASSERT(state.next_expected >= n + 2);
+  GPR_ASSERT(grpc_chttp2_stream_map_size(&map) == 0);
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
 int main(int argc, char** argv) {
   uint32_t n = 1;
   uint32_t prev = 1;
@@ -182,6 +220,7 @@ int main(int argc, char** argv) {
     test_delete_evens_sweep(n);
     test_delete_evens_incremental(n);
     test_periodic_compaction(n);
+    test_delete_during_for_each(n);
 
     tmp = n;
     n += prev;
@@ -0,0 +1,173 @@
+//
+//
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <grpc/support/port_platform.h>
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+
+#include <grpc/byte_buffer.h>
+#include <grpc/grpc.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "test/core/end2end/cq_verifier.h"
+#include "test/core/transport/chttp2/raw_http2_server_fixture.h"
+#include "test/core/util/test_config.h"
+
+// Checks that with GRPC_ARG_HTTP2_STREAM_WRITE_QUANTUM, the DATA of a small
+// response is interleaved behind one quantum of a bulk response that became
+// writable at the same time, instead of after all of it.
+
+namespace grpc_core {
+namespace {
+
+void* Tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+constexpr uint32_t kQuantum = 16 * 1024;
+constexpr size_t kBulkMessageSize = 1024 * 1024;
+
+constexpr uint8_t kFrameTypeData = 0;
+constexpr uint8_t kFrameTypeHeaders = 1;
+
+class StreamWriteQuantumTest : public testing::RawHttp2ServerTest {
+ protected:
+  // Sets up a server transport with the given quantum.
+  void SetupAndStart(int quantum) {
+    grpc_arg server_args[] = {
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_HTTP2_BDP_PROBE), 0),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_KEEPALIVE_TIME_MS), INT_MAX),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_HTTP2_STREAM_WRITE_QUANTUM), quantum)};
+    // Settings with a 16MB initial stream window. The connection window
+    // stays at the default 65535 bytes.
+    constexpr char kSettings[] =
+        "\x00\x00\x06\x04\x00\x00\x00\x00\x00"
+        "\x00\x04\x01\x00\x00\x00";
+    RawHttp2ServerTest::SetupAndStart(
+        {GPR_ARRAY_SIZE(server_args), server_args},
+        absl::string_view(kSettings, sizeof(kSettings) - 1));
+  }
+
+  // Waits until done returns true for the frames read, and returns them.
+  std::vector<Frame> WaitForFrames(
+      const std::function<bool(const std::vector<Frame>&)>& done) {
+    std::vector<Frame> frames;
+    GPR_ASSERT(
+        RawHttp2ServerTest::WaitForFrames(done, absl::Seconds(10), &frames));
+    return frames;
+  }
+
+  static size_t CountFrames(const std::vector<Frame>& frames, uint8_t type,
+                            uint32_t stream_id) {
+    size_t count = 0;
+    for (const Frame& frame : frames) {
+      if (frame.type == type && frame.stream_id == stream_id) ++count;
+    }
+    return count;
+  }
+
+  static size_t DataBytes(const std::vector<Frame>& frames,
+                          uint32_t stream_id) {
+    size_t bytes = 0;
+    for (const Frame& frame : frames) {
+      if (frame.type == kFrameTypeData && frame.stream_id == stream_id) {
+        bytes += frame.length;
+      }
+    }
+    return bytes;
+  }
+
+  // Makes a bulk response on stream 1 and a small one on stream 3 writable
+  // at the same time, and returns how many bytes of bulk DATA were written
+  // before the small response's.
+  size_t BulkBytesBeforeSmallResponse() {
+    grpc_call* bulk = StartRequest(1, 100);
+    grpc_call* small = StartRequest(3, 101);
+    // The bulk response uses up the connection window, and stalls.
+    grpc_byte_buffer* bulk_message =
+        SendResponse(bulk, kBulkMessageSize, /*finish=*/false, 200);
+    WaitForFrames([](const std::vector<Frame>& frames) {
+      return DataBytes(frames, 1) == 65535;
+    });
+    // The headers of the small response go out, but its DATA stalls too.
+    grpc_byte_buffer* small_message =
+        SendResponse(small, 100, /*finish=*/true, 201);
+    std::vector<Frame> stalled =
+        WaitForFrames([](const std::vector<Frame>& frames) {
+          return CountFrames(frames, kFrameTypeHeaders, 3) == 1;
+        });
+    EXPECT_EQ(DataBytes(stalled, 3), 0);
+    // Open the connection window for both.
+    constexpr char kWindowUpdate[] =
+        "\x00\x00\x04\x08\x00\x00\x00\x00\x00"
+        "\x00\x40\x00\x00";
+    Write(absl::string_view(kWindowUpdate, sizeof(kWindowUpdate) - 1));
+    std::vector<Frame> frames =
+        WaitForFrames([](const std::vector<Frame>& frames) {
+          return DataBytes(frames, 3) > 0;
+        });
+    size_t bulk_bytes = 0;
+    for (size_t i = stalled.size(); i < frames.size(); ++i) {
+      if (frames[i].type != kFrameTypeData) continue;
+      if (frames[i].stream_id == 3) break;
+      bulk_bytes += frames[i].length;
+    }
+    grpc_call_cancel(bulk, nullptr);
+    CQ_EXPECT_COMPLETION_ANY_STATUS(cqv_, Tag(200));
+    CQ_EXPECT_COMPLETION(cqv_, Tag(201), true);
+    cq_verify(cqv_);
+    grpc_byte_buffer_destroy(bulk_message);
+    grpc_byte_buffer_destroy(small_message);
+    grpc_call_unref(bulk);
+    grpc_call_unref(small);
+    return bulk_bytes;
+  }
+};
+
+TEST_F(StreamWriteQuantumTest, SmallResponseWaitsAtMostOneQuantum) {
+  SetupAndStart(kQuantum);
+  EXPECT_LE(BulkBytesBeforeSmallResponse(), kQuantum);
+}
+
+TEST_F(StreamWriteQuantumTest, ZeroQuantumWritesBulkResponseFirst) {
+  SetupAndStart(0);
+  // Without a quantum, the bulk response fills the write before the small
+  // one gets a turn.
+  EXPECT_GT(BulkBytesBeforeSmallResponse(), 4 * kQuantum);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int result = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return result;
+}
@@ -0,0 +1,198 @@
+//
+//
+// Copyright 2026 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <grpc/support/port_platform.h>
+
+#include <limits.h>
+
+#include <vector>
+
+#include <gmock/gmock.h>
+
+#include <grpc/byte_buffer.h>
+#include <grpc/grpc.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/stats.h"
+#include "test/core/end2end/cq_verifier.h"
+#include "test/core/transport/chttp2/raw_http2_server_fixture.h"
+#include "test/core/util/test_config.h"
+
+// Checks that with GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_US a write that
+// follows closely on the previous one is held for the window, and that the
+// window ends early on GRPC_ARG_HTTP2_WRITE_COALESCING_BYTES or when the
+// transport closes.
+
+namespace grpc_core {
+namespace {
+
+void* Tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+// The largest window the transport accepts.
+constexpr int kDelayUs = 100000;
+constexpr absl::Duration kDelay = absl::Microseconds(kDelayUs);
+constexpr int kCoalescingBytes = 1024;
+
+constexpr uint8_t kFrameTypeData = 0;
+constexpr uint8_t kFrameTypePing = 6;
+constexpr uint8_t kFrameTypeGoaway = 7;
+constexpr uint8_t kFlagAck = 1;
+
+class WriteCoalescingTest : public testing::RawHttp2ServerTest {
+ protected:
+  void SetUp() override {
+    grpc_arg server_args[] = {
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_HTTP2_BDP_PROBE), 0),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_KEEPALIVE_TIME_MS), INT_MAX),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_HTTP2_WRITE_COALESCING_DELAY_US),
+            kDelayUs),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_HTTP2_WRITE_COALESCING_BYTES),
+            kCoalescingBytes)};
+    SetupAndStart({GPR_ARRAY_SIZE(server_args), server_args});
+    first_ = StartRequest(1, 100);
+    second_ = StartRequest(3, 101);
+  }
+
+  void TearDown() override {
+    for (grpc_byte_buffer* message : messages_) {
+      grpc_byte_buffer_destroy(message);
+    }
+    grpc_call_unref(first_);
+    grpc_call_unref(second_);
+  }
+
+  // Pings the server and waits for the ack, so that the server has just
+  // started a write and the next one falls within the window.
+  void Ping() {
+    constexpr char kPing[] =
+        "\x00\x00\x08\x06\x00\x00\x00\x00\x00"
+        "\x00\x00\x00\x00\x00\x00\x00\x01";
+    Write(absl::string_view(kPing, sizeof(kPing) - 1));
+    ASSERT_TRUE(WaitForFrames(
+        [](const std::vector<Frame>& frames) {
+          for (const Frame& frame : frames) {
+            if (frame.type == kFrameTypePing && (frame.flags & kFlagAck)) {
+              return true;
+            }
+          }
+          return false;
+        },
+        absl::Seconds(10)));
+  }
+
+  // Finishes call with a message of size bytes.
+  void Respond(grpc_call* call, size_t size, intptr_t tag) {
+    messages_.push_back(SendResponse(call, size, /*finish=*/true, tag));
+  }
+
+  // Waits for a DATA frame on stream_id, and returns how long that took.
+  absl::Duration WaitForData(uint32_t stream_id, absl::Time start) {
+    EXPECT_TRUE(WaitForFrames(
+        [stream_id](const std::vector<Frame>& frames) {
+          for (const Frame& frame : frames) {
+            if (frame.type == kFrameTypeData && frame.stream_id == stream_id) {
+              return true;
+            }
+          }
+          return false;
+        },
+        absl::Seconds(10)));
+    return absl::Now() - start;
+  }
+
+  grpc_call* first_ = nullptr;
+  grpc_call* second_ = nullptr;
+  std::vector<grpc_byte_buffer*> messages_;
+};
+
+TEST_F(WriteCoalescingTest, HeldWriteFlushedAfterDelay) {
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data before;
+  grpc_stats_collect(&before);
+#endif
+  Ping();
+  // Whether the two responses are written together or one after the other,
+  // the second one waits for the window to close.
+  const absl::Time start = absl::Now();
+  Respond(first_, 100, 200);
+  Respond(second_, 100, 201);
+  // Allow a tenth of the window for the timer firing early.
+  EXPECT_GE(WaitForData(3, start), kDelay * 9 / 10);
+  CQ_EXPECT_COMPLETION(cqv_, Tag(200), true);
+  CQ_EXPECT_COMPLETION(cqv_, Tag(201), true);
+  cq_verify(cqv_);
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data after;
+  grpc_stats_data diff;
+  grpc_stats_collect(&after);
+  grpc_stats_diff(&after, &before, &diff);
+  EXPECT_GE(diff.counters[GRPC_STATS_COUNTER_HTTP2_COALESCED_WRITES], 1);
+#endif
+}
+
+TEST_F(WriteCoalescingTest, HeldWriteFlushedOnceBytesQueued) {
+  Ping();
+  Respond(first_, 100, 200);
+  // A response larger than the threshold is either gathered into the held
+  // write, which ends the window, or is written without being held.
+  const absl::Time start = absl::Now();
+  Respond(second_, 2 * kCoalescingBytes, 201);
+  EXPECT_LT(WaitForData(3, start), kDelay);
+  CQ_EXPECT_COMPLETION(cqv_, Tag(200), true);
+  CQ_EXPECT_COMPLETION(cqv_, Tag(201), true);
+  cq_verify(cqv_);
+}
+
+TEST_F(WriteCoalescingTest, CloseFlushesHeldWrite) {
+  Ping();
+  Respond(first_, 100, 200);
+  Respond(second_, 100, 201);
+  // Closing the transport does not wait for the window to close.
+  const absl::Time start = absl::Now();
+  grpc_server_shutdown_and_notify(server_, cq_, Tag(1));
+  grpc_server_cancel_all_calls(server_);
+  EXPECT_TRUE(WaitForFrames(
+      [](const std::vector<Frame>& frames) {
+        for (const Frame& frame : frames) {
+          if (frame.type == kFrameTypeGoaway) return true;
+        }
+        return false;
+      },
+      absl::Seconds(10)));
+  EXPECT_LT(absl::Now() - start, kDelay);
+  CQ_EXPECT_COMPLETION_ANY_STATUS(cqv_, Tag(200));
+  CQ_EXPECT_COMPLETION_ANY_STATUS(cqv_, Tag(201));
+  CQ_EXPECT_COMPLETION(cqv_, Tag(1), true);
+  cq_verify(cqv_);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int result = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return result;
+}
@@ -125,6 +125,42 @@ TEST(MetadataMapTest, NonEncodableTrait) {
   EXPECT_EQ(map.DebugString(), "GrpcStreamNetworkState: not sent on wire");
 }
 
+TEST(MetadataMapTest, ManyUnknownKeys) {
+  auto arena = MakeScopedArena(1024, g_memory_allocator);
+  EmptyMetadataMap map(arena.get());
+  auto on_error = [](absl::string_view, const Slice&) { abort(); };
+  // Enough keys for lookups to go through the index.
+  for (int i = 0; i < 40; i++) {
+    map.Append(absl::StrCat("x-key-", i), Slice::FromCopiedString("v"),
+               on_error);
+  }
+  map.Append("x-key-3", Slice::FromCopiedString("w"), on_error);
+  std::string buffer;
+  EXPECT_EQ(map.GetStringValue("x-key-0", &buffer), "v");
+  EXPECT_EQ(map.GetStringValue("x-key-3", &buffer), "v,w");
+  EXPECT_EQ(map.GetStringValue("x-key-39", &buffer), "v");
+  EXPECT_EQ(map.GetStringValue("x-missing", &buffer), absl::nullopt);
+  // Appending keeps the index up to date.
+  for (int i = 40; i < 100; i++) {
+    map.Append(absl::StrCat("x-key-", i), Slice::FromCopiedString("v"),
+               on_error);
+  }
+  map.Append("x-key-3", Slice::FromCopiedString("x"), on_error);
+  EXPECT_EQ(map.GetStringValue("x-key-3", &buffer), "v,w,x");
+  EXPECT_EQ(map.GetStringValue("x-key-99", &buffer), "v");
+  // Removing a missing key leaves the map alone.
+  map.Remove("x-missing");
+  EXPECT_EQ(map.count(), 102u);
+  map.Remove("x-key-3");
+  EXPECT_EQ(map.count(), 99u);
+  EXPECT_EQ(map.GetStringValue("x-key-3", &buffer), absl::nullopt);
+  EXPECT_EQ(map.GetStringValue("x-key-4", &buffer), "v");
+  map.Append("x-key-3", Slice::FromCopiedString("y"), on_error);
+  EXPECT_EQ(map.GetStringValue("x-key-3", &buffer), "y");
+  map.Clear();
+  EXPECT_EQ(map.GetStringValue("x-key-4", &buffer), absl::nullopt);
+}
+
 TEST(DebugStringBuilderTest, AddOne) {
   metadata_detail::DebugStringBuilder b;
   b.Add("a", "b");
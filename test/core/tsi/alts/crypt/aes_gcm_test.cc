@@ -419,6 +419,73 @@ static void gsec_test_multiple_encrypt_decrypt(gsec_aead_crypter* crypter) {
   gpr_free(message_lengths);
 }
 
+/* Seals a batch of frames with one call and checks that each frame matches
+   what a single encrypt produces and that the batch decrypts back. */
+static void gsec_test_batch_encrypt_decrypt(gsec_aead_crypter* crypter) {
+  GPR_ASSERT(crypter != nullptr);
+  const size_t kNumFrames = 8;
+  size_t nonce_length, tag_length;
+  gsec_aead_crypter_nonce_length(crypter, &nonce_length, nullptr);
+  gsec_aead_crypter_tag_length(crypter, &tag_length, nullptr);
+  uint8_t* nonces[kNumFrames];
+  uint8_t* messages[kNumFrames];
+  uint8_t* ciphertexts[kNumFrames];
+  uint8_t* plaintexts[kNumFrames];
+  struct iovec message_vecs[kNumFrames];
+  struct iovec ciphertext_vecs[kNumFrames];
+  gsec_aead_frame frames[kNumFrames];
+  size_t ind;
+  for (ind = 0; ind < kNumFrames; ind++) {
+    size_t message_length = gsec_test_bias_random_uint32(kTestMaxLength) + 1;
+    gsec_test_random_array(&nonces[ind], nonce_length);
+    gsec_test_random_array(&messages[ind], message_length);
+    ciphertexts[ind] =
+        static_cast<uint8_t*>(gpr_malloc(message_length + tag_length));
+    plaintexts[ind] = static_cast<uint8_t*>(gpr_malloc(message_length));
+    message_vecs[ind] = {messages[ind], message_length};
+    frames[ind] = {nonces[ind],
+                   nullptr,
+                   0,
+                   &message_vecs[ind],
+                   1,
+                   {ciphertexts[ind], message_length + tag_length},
+                   0};
+  }
+  GPR_ASSERT(gsec_aead_crypter_encrypt_iovec_batch(crypter, nonce_length,
+                                                   frames, kNumFrames,
+                                                   nullptr) == GRPC_STATUS_OK);
+  for (ind = 0; ind < kNumFrames; ind++) {
+    size_t message_length = message_vecs[ind].iov_len;
+    GPR_ASSERT(frames[ind].output_bytes_written == message_length + tag_length);
+    uint8_t* expected =
+        static_cast<uint8_t*>(gpr_malloc(message_length + tag_length));
+    size_t bytes_written = 0;
+    GPR_ASSERT(gsec_aead_crypter_encrypt(
+                   crypter, nonces[ind], nonce_length, nullptr, 0,
+                   messages[ind], message_length, expected,
+                   message_length + tag_length, &bytes_written,
+                   nullptr) == GRPC_STATUS_OK);
+    GPR_ASSERT(memcmp(expected, ciphertexts[ind], bytes_written) == 0);
+    gpr_free(expected);
+    ciphertext_vecs[ind] = {ciphertexts[ind], bytes_written};
+    frames[ind].input_vec = &ciphertext_vecs[ind];
+    frames[ind].output_vec = {plaintexts[ind], message_length};
+    frames[ind].output_bytes_written = 0;
+  }
+  GPR_ASSERT(gsec_aead_crypter_decrypt_iovec_batch(crypter, nonce_length,
+                                                   frames, kNumFrames,
+                                                   nullptr) == GRPC_STATUS_OK);
+  for (ind = 0; ind < kNumFrames; ind++) {
+    GPR_ASSERT(frames[ind].output_bytes_written == message_vecs[ind].iov_len);
+    GPR_ASSERT(memcmp(plaintexts[ind], messages[ind],
+                      message_vecs[ind].iov_len) == 0);
+    gpr_free(nonces[ind]);
+    gpr_free(messages[ind]);
+    gpr_free(ciphertexts[ind]);
+    gpr_free(plaintexts[ind]);
+  }
+}
+
 static void gsec_test_encryption_failure(gsec_aead_crypter* crypter) {
   GPR_ASSERT(crypter != nullptr);
   size_t aad_length = kTestMaxLength;
@@ -824,6 +891,7 @@ static void gsec_test_do_generic_crypter_tests() {
   for (ind = 0; ind < kTestNumCrypters; ind++) {
     gsec_test_encrypt_decrypt(crypters[ind]);
     gsec_test_multiple_encrypt_decrypt(crypters[ind]);
+    gsec_test_batch_encrypt_decrypt(crypters[ind]);
     gsec_test_encryption_failure(crypters[ind]);
     gsec_test_decryption_failure(crypters[ind]);
   }
@@ -26,6 +26,8 @@
 #include <grpc/grpc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
 #include "test/core/util/test_config.h"
 
 namespace grpc_core {
@@ -45,13 +47,18 @@ class SessionTracker {
 
   ~SessionTracker() { SSL_CTX_free(ssl_context_); }
 
-  tsi::SslSessionPtr NewSession(long id) {
+  tsi::SslSessionPtr NewSession(long id, bool single_use = false) {
     static int ex_data_id = SSL_SESSION_get_ex_new_index(
         0, nullptr, nullptr, nullptr, DestroyExData);
     GPR_ASSERT(ex_data_id != -1);
     // OpenSSL and different version of BoringSSL don't agree on API
     // so try both.
     tsi::SslSessionPtr session = NewSessionInternal(SSL_SESSION_new);
+    if (single_use) {
+      // TLS 1.3 sessions should be used only once.
+      EXPECT_EQ(
+          SSL_SESSION_set_protocol_version(session.get(), TLS1_3_VERSION), 1);
+    }
     SessionExDataId* data = new SessionExDataId{this, id};
     int result = SSL_SESSION_set_ex_data(session.get(), ex_data_id, data);
     EXPECT_EQ(result, 1);
@@ -142,6 +149,88 @@ TEST(SslSessionCacheTest, LruCache) {
   EXPECT_EQ(tracker.AliveCount(), 0);
 }
 
+TEST(SslSessionCacheTest, SingleUseSessions) {
+  SessionTracker tracker;
+  {
+    RefCountedPtr<tsi::SslSessionLRUCache> cache =
+        tsi::SslSessionLRUCache::Create(3);
+    // All tickets issued for a connection are kept.
+    tsi::SslSessionPtr sess1 = tracker.NewSession(1, true);
+    SSL_SESSION* sess1_ptr = sess1.get();
+    cache->Put("first.dropbox.com", std::move(sess1));
+    tsi::SslSessionPtr sess2 = tracker.NewSession(2, true);
+    SSL_SESSION* sess2_ptr = sess2.get();
+    cache->Put("first.dropbox.com", std::move(sess2));
+    EXPECT_EQ(cache->Size(), 1);
+    EXPECT_EQ(tracker.AliveCount(), 2);
+    // Each one is handed out once, oldest first, except for the last one.
+    EXPECT_EQ(cache->Get("first.dropbox.com").get(), sess1_ptr);
+    EXPECT_FALSE(tracker.IsAlive(1));
+    EXPECT_EQ(cache->Get("first.dropbox.com").get(), sess2_ptr);
+    EXPECT_EQ(cache->Get("first.dropbox.com").get(), sess2_ptr);
+    EXPECT_TRUE(tracker.IsAlive(2));
+    // Only the newest tickets are kept.
+    const long max_sessions = tsi::SslSessionLRUCache::kMaxSessionsPerKey;
+    for (long id = 3; id < 3 + max_sessions; id++) {
+      cache->Put("first.dropbox.com", tracker.NewSession(id, true));
+    }
+    EXPECT_FALSE(tracker.IsAlive(2));
+    EXPECT_EQ(tracker.AliveCount(), max_sessions);
+    // A session that is not single-use replaces them all.
+    cache->Put("first.dropbox.com", tracker.NewSession(100));
+    EXPECT_EQ(tracker.AliveCount(), 1);
+    EXPECT_TRUE(tracker.IsAlive(100));
+  }
+  EXPECT_EQ(tracker.AliveCount(), 0);
+}
+
+TEST(SslSessionCacheTest, ShardedCapacity) {
+  SessionTracker tracker;
+  {
+    // Large enough to be sharded.
+    const long capacity = 1000;
+    RefCountedPtr<tsi::SslSessionLRUCache> cache =
+        tsi::SslSessionLRUCache::Create(capacity);
+    for (long id = 0; id < 4 * capacity; id++) {
+      std::string domain = std::to_string(id) + ".random.domain";
+      cache->Put(domain.c_str(), tracker.NewSession(id));
+    }
+    EXPECT_EQ(cache->Size(), capacity);
+    EXPECT_EQ(tracker.AliveCount(), capacity);
+    // The most recently added session is still there.
+    EXPECT_TRUE(cache->Get("3999.random.domain"));
+  }
+  EXPECT_EQ(tracker.AliveCount(), 0);
+}
+
+TEST(SslSessionCacheTest, ReclaimedUnderMemoryPressure) {
+  ExecCtx exec_ctx;
+  SessionTracker tracker;
+  MemoryQuotaRefPtr memory_quota = MakeMemoryQuota("test");
+  memory_quota->SetSize(1024 * 1024);
+  {
+    RefCountedPtr<tsi::SslSessionLRUCache> cache =
+        tsi::SslSessionLRUCache::Create(100, memory_quota);
+    for (long id = 0; id < 10; id++) {
+      std::string domain = std::to_string(id) + ".random.domain";
+      cache->Put(domain.c_str(), tracker.NewSession(id));
+    }
+    exec_ctx.Flush();
+    EXPECT_EQ(cache->Size(), 10);
+    // Take the rest of the quota, so that it has to reclaim the sessions.
+    MemoryOwner other = memory_quota->CreateMemoryOwner("other");
+    other.Reserve(1024 * 1024);
+    exec_ctx.Flush();
+    EXPECT_EQ(cache->Size(), 0);
+    EXPECT_EQ(tracker.AliveCount(), 0);
+    other.Release(1024 * 1024);
+    // Sessions are cached again once the quota has room.
+    cache->Put("new.random.domain", tracker.NewSession(10));
+    EXPECT_EQ(cache->Size(), 1);
+  }
+  EXPECT_EQ(tracker.AliveCount(), 0);
+}
+
 }  // namespace
 }  // namespace grpc_core
 
@@ -22,9 +22,22 @@
 #include <stdio.h>
 #include <string.h>
 
+#ifdef GPR_LINUX
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <openssl/crypto.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
 #include <openssl/pem.h>
+#include <openssl/rsa.h>
 
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
@@ -32,11 +45,14 @@
 #include <grpc/support/string_util.h>
 
 #include "src/core/lib/gprpp/memory.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/load_file.h"
 #include "src/core/lib/security/security_connector/security_connector.h"
 #include "src/core/tsi/transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
 #include "src/core/tsi/transport_security_interface.h"
 #include "test/core/tsi/transport_security_test_lib.h"
+#include "test/core/util/slice_splitter.h"
 #include "test/core/util/test_config.h"
 
 #define SSL_TSI_TEST_ALPN1 "foo"
@@ -103,6 +119,8 @@ typedef struct ssl_tsi_test_fixture {
   size_t ssl_bio_buf_size;
   tsi_ssl_server_handshaker_factory* server_handshaker_factory;
   tsi_ssl_client_handshaker_factory* client_handshaker_factory;
+  tsi::SslPrivateKeySigner* server_private_key_signer;
+  bool enable_kernel_tls_tx;
 } ssl_tsi_test_fixture;
 
 static void ssl_test_setup_handshakers(tsi_test_fixture* fixture) {
@@ -135,6 +153,7 @@ static void ssl_test_setup_handshakers(tsi_test_fixture* fixture) {
   }
   client_options.min_tls_version = test_tls_version;
   client_options.max_tls_version = test_tls_version;
+  client_options.enable_kernel_tls_tx = ssl_fixture->enable_kernel_tls_tx;
   GPR_ASSERT(tsi_create_ssl_client_handshaker_factory_with_options(
                  &client_options, &ssl_fixture->client_handshaker_factory) ==
              TSI_OK);
@@ -169,6 +188,8 @@ static void ssl_test_setup_handshakers(tsi_test_fixture* fixture) {
   server_options.session_ticket_key_size = ssl_fixture->session_ticket_key_size;
   server_options.min_tls_version = test_tls_version;
   server_options.max_tls_version = test_tls_version;
+  server_options.private_key_signer = ssl_fixture->server_private_key_signer;
+  server_options.enable_kernel_tls_tx = ssl_fixture->enable_kernel_tls_tx;
   GPR_ASSERT(tsi_create_ssl_server_handshaker_factory_with_options(
                  &server_options, &ssl_fixture->server_handshaker_factory) ==
              TSI_OK);
@@ -1053,6 +1074,307 @@ void ssl_tsi_test_do_handshake_with_custom_bio_pair() {
   tsi_test_fixture_destroy(fixture);
 }
 
+// Protects a message made of slices of mixed sizes with one zero-copy
+// protector and checks that the peer's unprotects it, fed in small chunks.
+// Anything the sender wrote after the receiver's handshake finished (TLS 1.3
+// session tickets) is in pending_bytes and is unprotected first.
+static void ssl_tsi_test_zero_copy_send_message(
+    tsi_zero_copy_grpc_protector* sender,
+    tsi_zero_copy_grpc_protector* receiver, const unsigned char* pending_bytes,
+    size_t pending_bytes_size) {
+  const size_t slice_sizes[] = {9, 100, 5, 20000, 1, 3000, 16384, 7, 40000};
+  grpc_slice_buffer message;
+  grpc_slice_buffer unprotected;
+  grpc_slice_buffer protected_slices;
+  grpc_slice_buffer received;
+  grpc_slice_buffer_init(&message);
+  grpc_slice_buffer_init(&unprotected);
+  grpc_slice_buffer_init(&protected_slices);
+  grpc_slice_buffer_init(&received);
+  char next = 0;
+  for (size_t size : slice_sizes) {
+    grpc_slice slice = GRPC_SLICE_MALLOC(size);
+    for (size_t i = 0; i < size; i++) {
+      GRPC_SLICE_START_PTR(slice)[i] = static_cast<uint8_t>(next++);
+    }
+    grpc_slice_buffer_add(&message, grpc_slice_ref(slice));
+    grpc_slice_buffer_add(&unprotected, slice);
+  }
+  if (pending_bytes_size > 0) {
+    grpc_slice_buffer_add(
+        &protected_slices,
+        grpc_slice_from_copied_buffer(
+            reinterpret_cast<const char*>(pending_bytes), pending_bytes_size));
+  }
+  GPR_ASSERT(tsi_zero_copy_grpc_protector_protect(
+                 sender, &unprotected, &protected_slices) == TSI_OK);
+  GPR_ASSERT(unprotected.length == 0);
+  GPR_ASSERT(protected_slices.length > message.length);
+  grpc_slice_buffer chunk;
+  grpc_slice_buffer_init(&chunk);
+  while (protected_slices.length > 0) {
+    grpc_slice_buffer_move_first(
+        &protected_slices, std::min<size_t>(protected_slices.length, 1031),
+        &chunk);
+    GPR_ASSERT(tsi_zero_copy_grpc_protector_unprotect(receiver, &chunk,
+                                                      &received) == TSI_OK);
+  }
+  GPR_ASSERT(received.length == message.length);
+  grpc_slice expected = grpc_slice_merge(message.slices, message.count);
+  grpc_slice actual = grpc_slice_merge(received.slices, received.count);
+  GPR_ASSERT(grpc_slice_eq(expected, actual));
+  grpc_slice_unref(expected);
+  grpc_slice_unref(actual);
+  grpc_slice_buffer_destroy(&chunk);
+  grpc_slice_buffer_destroy(&message);
+  grpc_slice_buffer_destroy(&unprotected);
+  grpc_slice_buffer_destroy(&protected_slices);
+  grpc_slice_buffer_destroy(&received);
+}
+
+void ssl_tsi_test_do_round_trip_zero_copy() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_do_round_trip_zero_copy");
+  grpc_core::ExecCtx exec_ctx;
+  tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+  tsi_test_do_handshake(fixture);
+  tsi_frame_protector_type frame_protector_type;
+  GPR_ASSERT(tsi_handshaker_result_get_frame_protector_type(
+                 fixture->client_result, &frame_protector_type) == TSI_OK);
+  GPR_ASSERT(frame_protector_type == TSI_FRAME_PROTECTOR_NORMAL_OR_ZERO_COPY);
+  tsi_zero_copy_grpc_protector* client_protector = nullptr;
+  tsi_zero_copy_grpc_protector* server_protector = nullptr;
+  GPR_ASSERT(tsi_handshaker_result_create_zero_copy_grpc_protector(
+                 fixture->client_result, nullptr, &client_protector) ==
+             TSI_OK);
+  GPR_ASSERT(tsi_handshaker_result_create_zero_copy_grpc_protector(
+                 fixture->server_result, nullptr, &server_protector) ==
+             TSI_OK);
+  const unsigned char* pending_bytes;
+  size_t pending_bytes_size;
+  tsi_test_channel_read_pending_bytes(fixture, /*is_client=*/false,
+                                      &pending_bytes, &pending_bytes_size);
+  ssl_tsi_test_zero_copy_send_message(client_protector, server_protector,
+                                      pending_bytes, pending_bytes_size);
+  tsi_test_channel_read_pending_bytes(fixture, /*is_client=*/true,
+                                      &pending_bytes, &pending_bytes_size);
+  ssl_tsi_test_zero_copy_send_message(server_protector, client_protector,
+                                      pending_bytes, pending_bytes_size);
+  tsi_zero_copy_grpc_protector_destroy(client_protector);
+  tsi_zero_copy_grpc_protector_destroy(server_protector);
+  tsi_test_fixture_destroy(fixture);
+}
+
+#ifdef GPR_LINUX
+// Unprotects size bytes with protector and appends the result to out.
+static void ssl_tsi_test_unprotect(tsi_frame_protector* protector,
+                                   const unsigned char* bytes, size_t size,
+                                   std::string* out) {
+  unsigned char buffer[4096];
+  size_t buffer_size;
+  do {
+    size_t consumed = size;
+    buffer_size = sizeof(buffer);
+    GPR_ASSERT(tsi_frame_protector_unprotect(protector, bytes, &consumed,
+                                             buffer,
+                                             &buffer_size) == TSI_OK);
+    bytes += consumed;
+    size -= consumed;
+    out->append(reinterpret_cast<char*>(buffer), buffer_size);
+  } while (size > 0 || buffer_size == sizeof(buffer));
+}
+
+// Protects message with protector, as one frame.
+static std::string ssl_tsi_test_protect(tsi_frame_protector* protector,
+                                        const std::string& message) {
+  unsigned char buffer[4096];
+  size_t message_size = message.size();
+  size_t buffer_size = sizeof(buffer);
+  GPR_ASSERT(tsi_frame_protector_protect(
+                 protector,
+                 reinterpret_cast<const unsigned char*>(message.data()),
+                 &message_size, buffer, &buffer_size) == TSI_OK);
+  GPR_ASSERT(message_size == message.size());
+  std::string protected_bytes(reinterpret_cast<char*>(buffer), buffer_size);
+  size_t still_pending_size;
+  do {
+    buffer_size = sizeof(buffer);
+    GPR_ASSERT(tsi_frame_protector_protect_flush(protector, buffer,
+                                                 &buffer_size,
+                                                 &still_pending_size) ==
+               TSI_OK);
+    protected_bytes.append(reinterpret_cast<char*>(buffer), buffer_size);
+  } while (still_pending_size > 0);
+  return protected_bytes;
+}
+
+// Does a handshake in memory, and tries to hand the client's write keys to
+// the kernel for client_fd. Then sends a message from client_fd to server_fd,
+// encrypted by the kernel or else by the client's frame protector, and
+// checks that the server's frame protector unprotects it. Returns whether
+// the kernel encrypted the message.
+static bool ssl_tsi_test_send_with_kernel_tls_tx(bool enable_kernel_tls_tx,
+                                                 int client_fd,
+                                                 int server_fd) {
+  tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+  reinterpret_cast<ssl_tsi_test_fixture*>(fixture)->enable_kernel_tls_tx =
+      enable_kernel_tls_tx;
+  tsi_test_do_handshake(fixture);
+  const bool kernel_tx = tsi_handshaker_result_enable_kernel_tx_protection(
+                             fixture->client_result, client_fd) == TSI_OK;
+  tsi_frame_protector* client_protector = nullptr;
+  tsi_frame_protector* server_protector = nullptr;
+  GPR_ASSERT(tsi_handshaker_result_create_frame_protector(
+                 fixture->client_result, nullptr, &client_protector) ==
+             TSI_OK);
+  GPR_ASSERT(tsi_handshaker_result_create_frame_protector(
+                 fixture->server_result, nullptr, &server_protector) ==
+             TSI_OK);
+  const std::string message = "written with kernel TLS, if available";
+  const std::string sent =
+      kernel_tx ? message : ssl_tsi_test_protect(client_protector, message);
+  GPR_ASSERT(send(client_fd, sent.data(), sent.size(), 0) ==
+             static_cast<ssize_t>(sent.size()));
+  std::string received;
+  const unsigned char* pending_bytes;
+  size_t pending_bytes_size;
+  tsi_test_channel_read_pending_bytes(fixture, /*is_client=*/false,
+                                      &pending_bytes, &pending_bytes_size);
+  ssl_tsi_test_unprotect(server_protector, pending_bytes, pending_bytes_size,
+                         &received);
+  while (received.size() < message.size()) {
+    unsigned char buffer[1024];
+    ssize_t n = recv(server_fd, buffer, sizeof(buffer), 0);
+    GPR_ASSERT(n > 0);
+    ssl_tsi_test_unprotect(server_protector, buffer, static_cast<size_t>(n),
+                           &received);
+  }
+  GPR_ASSERT(received == message);
+  tsi_frame_protector_destroy(client_protector);
+  tsi_frame_protector_destroy(server_protector);
+  tsi_test_fixture_destroy(fixture);
+  return kernel_tx;
+}
+
+static void ssl_tsi_test_create_tcp_socket_pair(int* client_fd,
+                                                int* server_fd) {
+  int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+  GPR_ASSERT(listen_fd >= 0);
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t addr_len = sizeof(addr);
+  GPR_ASSERT(bind(listen_fd, reinterpret_cast<struct sockaddr*>(&addr),
+                  sizeof(addr)) == 0);
+  GPR_ASSERT(listen(listen_fd, 1) == 0);
+  GPR_ASSERT(getsockname(listen_fd, reinterpret_cast<struct sockaddr*>(&addr),
+                         &addr_len) == 0);
+  *client_fd = socket(AF_INET, SOCK_STREAM, 0);
+  GPR_ASSERT(*client_fd >= 0);
+  GPR_ASSERT(connect(*client_fd, reinterpret_cast<struct sockaddr*>(&addr),
+                     sizeof(addr)) == 0);
+  *server_fd = accept(listen_fd, nullptr, nullptr);
+  GPR_ASSERT(*server_fd >= 0);
+  close(listen_fd);
+}
+
+void ssl_tsi_test_kernel_tls_tx() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_kernel_tls_tx");
+  // The kernel does not do TLS on a unix socket, which leaves the handshaker
+  // result as it was, as when the kernel has no TLS support.
+  int fds[2];
+  GPR_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+  GPR_ASSERT(!ssl_tsi_test_send_with_kernel_tls_tx(true, fds[0], fds[1]));
+  close(fds[0]);
+  close(fds[1]);
+  // Neither without the option, nor for TLS 1.2.
+  int client_fd;
+  int server_fd;
+  ssl_tsi_test_create_tcp_socket_pair(&client_fd, &server_fd);
+  GPR_ASSERT(!ssl_tsi_test_send_with_kernel_tls_tx(false, client_fd,
+                                                   server_fd));
+  close(client_fd);
+  close(server_fd);
+  ssl_tsi_test_create_tcp_socket_pair(&client_fd, &server_fd);
+  const bool kernel_tx =
+      ssl_tsi_test_send_with_kernel_tls_tx(true, client_fd, server_fd);
+  GPR_ASSERT(!kernel_tx || test_tls_version == tsi_tls_version::TSI_TLS1_3);
+  if (!kernel_tx && test_tls_version == tsi_tls_version::TSI_TLS1_3) {
+    gpr_log(GPR_INFO, "Kernel TLS not available, only tested the fallback");
+  }
+  close(client_fd);
+  close(server_fd);
+}
+#endif
+
+#ifdef OPENSSL_IS_BORINGSSL
+// Signs with a private key on another thread, as a remote signer would.
+struct TestPrivateKeySigner {
+  EVP_PKEY* key;
+  int* sign_count;
+};
+
+static void test_private_key_sign(void* user_data,
+                                  uint16_t signature_algorithm,
+                                  const unsigned char* in, size_t in_len,
+                                  grpc_tls_private_key_sign_done_cb done_cb,
+                                  void* done_arg) {
+  TestPrivateKeySigner* signer = static_cast<TestPrivateKeySigner*>(user_data);
+  ++*signer->sign_count;
+  std::string input(reinterpret_cast<const char*>(in), in_len);
+  std::thread([signer, signature_algorithm, input, done_cb, done_arg]() {
+    std::vector<uint8_t> signature(EVP_PKEY_size(signer->key));
+    size_t signature_size = signature.size();
+    EVP_MD_CTX* ctx = EVP_MD_CTX_new();
+    EVP_PKEY_CTX* pkey_ctx = nullptr;
+    bool ok =
+        EVP_DigestSignInit(
+            ctx, &pkey_ctx,
+            SSL_get_signature_algorithm_digest(signature_algorithm), nullptr,
+            signer->key) &&
+        (!SSL_is_signature_algorithm_rsa_pss(signature_algorithm) ||
+         (EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) &&
+          EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1))) &&
+        EVP_DigestSign(ctx, signature.data(), &signature_size,
+                       reinterpret_cast<const uint8_t*>(input.data()),
+                       input.size());
+    EVP_MD_CTX_free(ctx);
+    done_cb(done_arg, ok ? GRPC_STATUS_OK : GRPC_STATUS_INTERNAL,
+            signature.data(), signature_size);
+  }).detach();
+}
+
+static void test_private_key_signer_destroy(void* user_data) {
+  TestPrivateKeySigner* signer = static_cast<TestPrivateKeySigner*>(user_data);
+  EVP_PKEY_free(signer->key);
+  delete signer;
+}
+
+void ssl_tsi_test_do_handshake_with_private_key_signer() {
+  gpr_log(GPR_INFO, "ssl_tsi_test_do_handshake_with_private_key_signer");
+  tsi_test_fixture* fixture = ssl_tsi_test_fixture_create();
+  ssl_tsi_test_fixture* ssl_fixture =
+      reinterpret_cast<ssl_tsi_test_fixture*>(fixture);
+  // Without SNI, the server uses its first key cert pair.
+  const char* pem_key =
+      ssl_fixture->key_cert_lib->server_pem_key_cert_pairs[0].private_key;
+  BIO* bio = BIO_new_mem_buf(pem_key, static_cast<int>(strlen(pem_key)));
+  int sign_count = 0;
+  grpc_tls_private_key_signer signer = {
+      new TestPrivateKeySigner{
+          PEM_read_bio_PrivateKey(bio, nullptr, nullptr, nullptr),
+          &sign_count},
+      test_private_key_sign, test_private_key_signer_destroy};
+  BIO_free(bio);
+  auto private_key_signer =
+      grpc_core::MakeRefCounted<tsi::SslPrivateKeySigner>(signer);
+  ssl_fixture->server_private_key_signer = private_key_signer.get();
+  tsi_test_do_handshake(fixture);
+  tsi_test_fixture_destroy(fixture);
+  GPR_ASSERT(sign_count == 1);
+}
+#endif
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   grpc_init();
@@ -1078,6 +1400,7 @@ int main(int argc, char** argv) {
     // BoringSSL and OpenSSL have different behaviors on mismatched ALPN.
     ssl_tsi_test_do_handshake_alpn_client_no_server();
     ssl_tsi_test_do_handshake_alpn_client_server_mismatch();
+    ssl_tsi_test_do_handshake_with_private_key_signer();
 #endif
     ssl_tsi_test_do_handshake_alpn_server_no_client();
     ssl_tsi_test_do_handshake_alpn_client_server_ok();
@@ -1085,6 +1408,10 @@ int main(int argc, char** argv) {
     ssl_tsi_test_do_round_trip_for_all_configs();
     ssl_tsi_test_do_round_trip_with_error_on_stack();
     ssl_tsi_test_do_round_trip_odd_buffer_size();
+    ssl_tsi_test_do_round_trip_zero_copy();
+#ifdef GPR_LINUX
+    ssl_tsi_test_kernel_tls_tx();
+#endif
     ssl_tsi_test_handshaker_factory_internals();
     ssl_tsi_test_duplicate_root_certificates();
     ssl_tsi_test_extract_x509_subject_names();
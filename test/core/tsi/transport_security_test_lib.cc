@@ -290,6 +290,22 @@ void tsi_test_frame_protector_receive_message_from_peer(
   gpr_free(message_buffer);
 }
 
+void tsi_test_channel_read_pending_bytes(tsi_test_fixture* fixture,
+                                         bool is_client,
+                                         const unsigned char** bytes,
+                                         size_t* bytes_size) {
+  GPR_ASSERT(fixture != nullptr);
+  tsi_test_channel* channel = fixture->channel;
+  uint8_t* buf = is_client ? channel->client_channel : channel->server_channel;
+  size_t* bytes_read = is_client ? &channel->bytes_read_from_client_channel
+                                 : &channel->bytes_read_from_server_channel;
+  size_t bytes_written = is_client ? channel->bytes_written_to_client_channel
+                                   : channel->bytes_written_to_server_channel;
+  *bytes = buf + *bytes_read;
+  *bytes_size = bytes_written - *bytes_read;
+  *bytes_read = bytes_written;
+}
+
 grpc_error_handle on_handshake_next_done(
     tsi_result result, void* user_data, const unsigned char* bytes_to_send,
     size_t bytes_to_send_size, tsi_handshaker_result* handshaker_result) {
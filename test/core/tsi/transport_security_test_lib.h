@@ -213,6 +213,14 @@ void tsi_test_frame_protector_receive_message_from_peer(
     tsi_frame_protector* protector, unsigned char* message,
     size_t* bytes_received, bool is_client);
 
+/* This method returns the bytes sent to the client (server) through the
+   fixture's channel that it has not read yet, e.g. what the peer sent after
+   the client's (server's) handshake finished, and marks them read. */
+void tsi_test_channel_read_pending_bytes(tsi_test_fixture* fixture,
+                                         bool is_client,
+                                         const unsigned char** bytes,
+                                         size_t* bytes_size);
+
 /* This method performs a full TSI handshake between a client and a server.
    Note that the test library will implement the new TSI handshaker API to
    perform handshakes. */
@@ -0,0 +1,335 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "test/core/util/network_emulation_endpoint.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <random>
+
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/slice/slice_internal.h"
+
+namespace grpc_core {
+namespace testing {
+
+namespace {
+
+// Writes are cut into segments of this size, each of which is delayed
+// independently, like TCP segments on a typical Ethernet path.
+constexpr size_t kSegmentSize = 1448;
+
+double NowSeconds() {
+  gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+  return now.tv_sec + 1e-9 * now.tv_nsec;
+}
+
+Timestamp ToTimestamp(double seconds) {
+  return Timestamp::FromTimespecRoundUp(gpr_time_from_nanos(
+      static_cast<int64_t>(seconds * 1e9), GPR_CLOCK_MONOTONIC));
+}
+
+class NetworkEmulationEndpoint {
+ public:
+  NetworkEmulationEndpoint(grpc_endpoint* wrapped,
+                           const NetworkProfile& profile)
+      : wrapped_(wrapped), profile_(profile), rng_(profile.seed) {
+    base_.vtable = &kVtable;
+    grpc_slice_buffer_init(&outgoing_);
+    GRPC_CLOSURE_INIT(&on_write_timer_, OnWriteTimer, this,
+                      grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&on_delivery_timer_, OnDeliveryTimer, this,
+                      grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&on_wrapped_write_done_, OnWrappedWriteDone, this,
+                      grpc_schedule_on_exec_ctx);
+  }
+
+  ~NetworkEmulationEndpoint() {
+    for (Segment& segment : in_flight_) {
+      grpc_slice_unref_internal(segment.slice);
+    }
+    grpc_slice_buffer_destroy_internal(&outgoing_);
+    grpc_endpoint_destroy(wrapped_);
+  }
+
+  grpc_endpoint* base() { return &base_; }
+
+ private:
+  struct Segment {
+    double deliver_at;
+    grpc_slice slice;
+  };
+
+  static NetworkEmulationEndpoint* FromBase(grpc_endpoint* ep) {
+    return reinterpret_cast<NetworkEmulationEndpoint*>(ep);
+  }
+
+  void Ref() { refs_.fetch_add(1, std::memory_order_relaxed); }
+  void Unref() {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+  }
+
+  double Uniform() { return std::uniform_real_distribution<>(0, 1)(rng_); }
+
+  // Puts \a slice on the link: it finishes serializing once the bytes ahead
+  // of it have, and then arrives after the path delay, but never before the
+  // bytes sent ahead of it.
+  void AddSegmentLocked(grpc_slice slice, double now)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    const double one_way = profile_.rtt_seconds / 2;
+    link_free_at_ = std::max(now, link_free_at_);
+    if (profile_.bandwidth_bytes_per_second > 0) {
+      link_free_at_ +=
+          GRPC_SLICE_LENGTH(slice) / profile_.bandwidth_bytes_per_second;
+    }
+    double delay = one_way + profile_.jitter_seconds * Uniform();
+    if (Uniform() < profile_.loss_probability) {
+      delay += profile_.rtt_seconds;
+    }
+    if (Uniform() < profile_.reorder_probability) {
+      delay += one_way * Uniform();
+    }
+    last_delivery_ = std::max(last_delivery_, link_free_at_ + delay);
+    in_flight_.push_back({last_delivery_, slice});
+  }
+
+  // Hands every segment that has arrived to the wrapped endpoint, and arms
+  // the delivery timer for the next one.
+  void DeliverLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    if (shutdown_ || wrapped_write_pending_) return;
+    // Timers may fire up to a millisecond early.
+    const double now = NowSeconds() + 1e-3;
+    while (!in_flight_.empty() && in_flight_.front().deliver_at <= now) {
+      grpc_slice_buffer_add(&outgoing_, in_flight_.front().slice);
+      in_flight_.pop_front();
+    }
+    if (outgoing_.length > 0) {
+      wrapped_write_pending_ = true;
+      Ref();
+      grpc_endpoint_write(wrapped_, &outgoing_, &on_wrapped_write_done_,
+                          nullptr, INT32_MAX);
+      return;
+    }
+    if (!in_flight_.empty() && !delivery_timer_armed_) {
+      delivery_timer_armed_ = true;
+      Ref();
+      grpc_timer_init(&delivery_timer_,
+                      ToTimestamp(in_flight_.front().deliver_at),
+                      &on_delivery_timer_);
+    }
+  }
+
+  static void OnWriteTimer(void* arg, grpc_error_handle /*error*/) {
+    auto* self = static_cast<NetworkEmulationEndpoint*>(arg);
+    {
+      MutexLock lock(&self->mu_);
+      self->write_timer_armed_ = false;
+      if (self->pending_write_cb_ != nullptr) {
+        ExecCtx::Run(DEBUG_LOCATION, self->pending_write_cb_, GRPC_ERROR_NONE);
+        self->pending_write_cb_ = nullptr;
+      }
+    }
+    self->Unref();
+  }
+
+  static void OnDeliveryTimer(void* arg, grpc_error_handle /*error*/) {
+    auto* self = static_cast<NetworkEmulationEndpoint*>(arg);
+    {
+      MutexLock lock(&self->mu_);
+      self->delivery_timer_armed_ = false;
+      self->DeliverLocked();
+    }
+    self->Unref();
+  }
+
+  static void OnWrappedWriteDone(void* arg, grpc_error_handle /*error*/) {
+    auto* self = static_cast<NetworkEmulationEndpoint*>(arg);
+    {
+      MutexLock lock(&self->mu_);
+      self->wrapped_write_pending_ = false;
+      grpc_slice_buffer_reset_and_unref_internal(&self->outgoing_);
+      self->DeliverLocked();
+    }
+    self->Unref();
+  }
+
+  static void Read(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                   grpc_closure* cb, bool urgent, int min_progress_size) {
+    grpc_endpoint_read(FromBase(ep)->wrapped_, slices, cb, urgent,
+                       min_progress_size);
+  }
+
+  static void Write(grpc_endpoint* ep, grpc_slice_buffer* slices,
+                    grpc_closure* cb, void* /*arg*/, int /*max_frame_size*/) {
+    NetworkEmulationEndpoint* self = FromBase(ep);
+    MutexLock lock(&self->mu_);
+    if (self->shutdown_) {
+      ExecCtx::Run(DEBUG_LOCATION, cb,
+                   GRPC_ERROR_CREATE_FROM_STATIC_STRING("Endpoint shutdown"));
+      return;
+    }
+    GPR_ASSERT(self->pending_write_cb_ == nullptr);
+    const double now = NowSeconds();
+    for (size_t i = 0; i < slices->count; i++) {
+      const size_t length = GRPC_SLICE_LENGTH(slices->slices[i]);
+      for (size_t offset = 0; offset < length; offset += kSegmentSize) {
+        self->AddSegmentLocked(
+            grpc_slice_sub(slices->slices[i], offset,
+                           std::min(length, offset + kSegmentSize)),
+            now);
+      }
+    }
+    // The write completes once its last byte is on the wire.
+    if (self->link_free_at_ <= now) {
+      ExecCtx::Run(DEBUG_LOCATION, cb, GRPC_ERROR_NONE);
+    } else {
+      self->pending_write_cb_ = cb;
+      self->write_timer_armed_ = true;
+      self->Ref();
+      grpc_timer_init(&self->write_timer_, ToTimestamp(self->link_free_at_),
+                      &self->on_write_timer_);
+    }
+    self->DeliverLocked();
+  }
+
+  static void AddToPollset(grpc_endpoint* ep, grpc_pollset* pollset) {
+    grpc_endpoint_add_to_pollset(FromBase(ep)->wrapped_, pollset);
+  }
+
+  static void AddToPollsetSet(grpc_endpoint* ep, grpc_pollset_set* pollset) {
+    grpc_endpoint_add_to_pollset_set(FromBase(ep)->wrapped_, pollset);
+  }
+
+  static void DeleteFromPollsetSet(grpc_endpoint* ep,
+                                   grpc_pollset_set* pollset) {
+    grpc_endpoint_delete_from_pollset_set(FromBase(ep)->wrapped_, pollset);
+  }
+
+  static void Shutdown(grpc_endpoint* ep, grpc_error_handle why) {
+    NetworkEmulationEndpoint* self = FromBase(ep);
+    {
+      MutexLock lock(&self->mu_);
+      self->ShutdownLocked(GRPC_ERROR_REF(why));
+    }
+    grpc_endpoint_shutdown(self->wrapped_, why);
+  }
+
+  // Returns false if the endpoint was already shut down.
+  bool ShutdownLocked(grpc_error_handle why)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    if (shutdown_) {
+      GRPC_ERROR_UNREF(why);
+      return false;
+    }
+    shutdown_ = true;
+    if (write_timer_armed_) grpc_timer_cancel(&write_timer_);
+    if (delivery_timer_armed_) grpc_timer_cancel(&delivery_timer_);
+    if (pending_write_cb_ != nullptr) {
+      ExecCtx::Run(DEBUG_LOCATION, pending_write_cb_, GRPC_ERROR_REF(why));
+      pending_write_cb_ = nullptr;
+    }
+    GRPC_ERROR_UNREF(why);
+    return true;
+  }
+
+  static void Destroy(grpc_endpoint* ep) {
+    NetworkEmulationEndpoint* self = FromBase(ep);
+    bool shutdown_wrapped;
+    {
+      MutexLock lock(&self->mu_);
+      shutdown_wrapped = self->ShutdownLocked(
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING("Endpoint destroyed"));
+    }
+    // Flushes out any write still pending on the wrapped endpoint.
+    if (shutdown_wrapped) {
+      grpc_endpoint_shutdown(
+          self->wrapped_,
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING("Endpoint destroyed"));
+    }
+    self->Unref();
+  }
+
+  static absl::string_view GetPeer(grpc_endpoint* ep) {
+    return grpc_endpoint_get_peer(FromBase(ep)->wrapped_);
+  }
+
+  static absl::string_view GetLocalAddress(grpc_endpoint* ep) {
+    return grpc_endpoint_get_local_address(FromBase(ep)->wrapped_);
+  }
+
+  static int GetFd(grpc_endpoint* /*ep*/) { return -1; }
+
+  static bool CanTrackErr(grpc_endpoint* /*ep*/) { return false; }
+
+  static const grpc_endpoint_vtable kVtable;
+
+  // Must be the first member, so that FromBase() can cast.
+  grpc_endpoint base_;
+  grpc_endpoint* const wrapped_;
+  const NetworkProfile profile_;
+  std::atomic<int> refs_{1};
+  Mutex mu_;
+  std::mt19937_64 rng_ ABSL_GUARDED_BY(mu_);
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  // When the link finishes serializing the bytes queued on it.
+  double link_free_at_ ABSL_GUARDED_BY(mu_) = 0;
+  // Arrival time of the last segment queued; later ones may not overtake it.
+  double last_delivery_ ABSL_GUARDED_BY(mu_) = 0;
+  std::deque<Segment> in_flight_ ABSL_GUARDED_BY(mu_);
+  grpc_closure* pending_write_cb_ ABSL_GUARDED_BY(mu_) = nullptr;
+  bool write_timer_armed_ ABSL_GUARDED_BY(mu_) = false;
+  grpc_timer write_timer_;
+  grpc_closure on_write_timer_;
+  bool delivery_timer_armed_ ABSL_GUARDED_BY(mu_) = false;
+  grpc_timer delivery_timer_;
+  grpc_closure on_delivery_timer_;
+  bool wrapped_write_pending_ ABSL_GUARDED_BY(mu_) = false;
+  grpc_slice_buffer outgoing_ ABSL_GUARDED_BY(mu_);
+  grpc_closure on_wrapped_write_done_;
+};
+
+const grpc_endpoint_vtable NetworkEmulationEndpoint::kVtable = {
+    NetworkEmulationEndpoint::Read,
+    NetworkEmulationEndpoint::Write,
+    NetworkEmulationEndpoint::AddToPollset,
+    NetworkEmulationEndpoint::AddToPollsetSet,
+    NetworkEmulationEndpoint::DeleteFromPollsetSet,
+    NetworkEmulationEndpoint::Shutdown,
+    NetworkEmulationEndpoint::Destroy,
+    NetworkEmulationEndpoint::GetPeer,
+    NetworkEmulationEndpoint::GetLocalAddress,
+    NetworkEmulationEndpoint::GetFd,
+    NetworkEmulationEndpoint::CanTrackErr,
+};
+
+}  // namespace
+
+grpc_endpoint* CreateNetworkEmulationEndpoint(grpc_endpoint* wrapped,
+                                              const NetworkProfile& profile) {
+  return (new NetworkEmulationEndpoint(wrapped, profile))->base();
+}
+
+}  // namespace testing
+}  // namespace grpc_core
@@ -0,0 +1,58 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef GRPC_TEST_CORE_UTIL_NETWORK_EMULATION_ENDPOINT_H
+#define GRPC_TEST_CORE_UTIL_NETWORK_EMULATION_ENDPOINT_H
+
+#include <stdint.h>
+
+#include "src/core/lib/iomgr/endpoint.h"
+
+namespace grpc_core {
+namespace testing {
+
+// Properties of one direction of an emulated network path.
+struct NetworkProfile {
+  // Link bandwidth. 0 means unlimited.
+  double bandwidth_bytes_per_second = 0;
+  // Round-trip time; each direction adds half of it.
+  double rtt_seconds = 0;
+  // Each segment is delayed by an extra uniformly random [0, jitter).
+  double jitter_seconds = 0;
+  // Probability that a segment is lost. The byte stream stays reliable, so a
+  // lost segment is delivered one extra RTT late, as after a fast
+  // retransmit, and holds back everything sent after it.
+  double loss_probability = 0;
+  // Probability that a segment arrives out of order, i.e. up to one extra
+  // one-way delay late. As with loss, later bytes wait for it.
+  double reorder_probability = 0;
+  // Seed for the random choices above, so runs are reproducible.
+  uint64_t seed = 0;
+};
+
+// Wraps \a wrapped (taking ownership) so that bytes written to the returned
+// endpoint are passed on to \a wrapped as if they had crossed a network path
+// with the given \a profile. Reads are passed through unchanged, so both ends
+// of a connection should be wrapped to emulate both directions.
+grpc_endpoint* CreateNetworkEmulationEndpoint(grpc_endpoint* wrapped,
+                                              const NetworkProfile& profile);
+
+}  // namespace testing
+}  // namespace grpc_core
+
+#endif  // GRPC_TEST_CORE_UTIL_NETWORK_EMULATION_ENDPOINT_H
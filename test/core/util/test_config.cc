@@ -39,11 +39,16 @@
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/examine_stack.h"
+#include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/surface/init.h"
 #include "test/core/event_engine/test_init.h"
 #include "test/core/util/build.h"
 #include "test/core/util/stack_tracer.h"
 
+#ifdef GRPC_POSIX_SOCKET_EV_EPOLL1
+#include "src/core/lib/iomgr/ev_io_uring_linux.h"
+#endif
+
 int64_t g_fixture_slowdown_factor = 1;
 int64_t g_poller_slowdown_factor = 1;
 
@@ -110,6 +115,14 @@ void ParseTestArgs(int* argc, char** argv) {
   int i = 1;
   while (i < *argc) {
     if (absl::StartsWith(argv[i], poller_flag)) {
+#ifdef GRPC_POSIX_SOCKET_EV_EPOLL1
+      // The io_uring variants of tests only run on kernels supporting it.
+      if (strcmp(argv[i] + poller_flag.length(), "io_uring") == 0 &&
+          !grpc_is_io_uring_supported()) {
+        gpr_log(GPR_INFO, "io_uring not supported by the kernel, skipping");
+        exit(0);
+      }
+#endif
       gpr_setenv("GRPC_POLL_STRATEGY", argv[i] + poller_flag.length());
       // remove the spent argv
       RmArg(i, argc, argv);
@@ -16,6 +16,7 @@
  *
  */
 
+#include <google/protobuf/wrappers.pb.h>
 #include <gtest/gtest.h>
 
 #include <grpc/impl/codegen/byte_buffer.h>
@@ -185,6 +186,36 @@ TEST_F(WriterTest, LargeBlockLargeBackup) {
   BufferWriterTest(4096, 8192, 4095);
 }
 
+void SerializeTest(size_t value_size, size_t expected_slices) {
+  google::protobuf::StringValue msg;
+  msg.set_value(std::string(value_size, 'a'));
+  ByteBuffer bb;
+  bool own_buffer;
+  EXPECT_TRUE(
+      SerializationTraits<google::protobuf::StringValue>::Serialize(
+          msg, &bb, &own_buffer)
+          .ok());
+  EXPECT_EQ(bb.Length(), msg.ByteSizeLong());
+  std::vector<Slice> slices;
+  EXPECT_TRUE(bb.Dump(&slices).ok());
+  EXPECT_EQ(slices.size(), expected_slices);
+  google::protobuf::StringValue parsed;
+  EXPECT_TRUE(
+      SerializationTraits<google::protobuf::StringValue>::Deserialize(&bb,
+                                                                      &parsed)
+          .ok());
+  EXPECT_EQ(parsed.value(), msg.value());
+}
+
+TEST_F(WriterTest, SerializeIntoSingleSlice) {
+  SerializeTest(1, 1);
+  SerializeTest(64 * 1024, 1);
+}
+
+TEST_F(WriterTest, SerializeIntoBlocks) {
+  SerializeTest(kProtoBufferWriterMaxBufferLength, 2);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace grpc
@@ -0,0 +1,129 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <grpcpp/ext/upb_message.h>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpcpp/impl/grpc_library.h>
+#include <grpcpp/support/byte_buffer.h>
+
+#include "src/proto/grpc/health/v1/health.upb.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc {
+namespace {
+
+using Request =
+    experimental::UpbMessage<grpc_health_v1_HealthCheckRequest,
+                             &grpc_health_v1_HealthCheckRequest_msginit>;
+
+class UpbMessageTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() { grpc::internal::GrpcLibraryInitializer init; }
+
+  static ByteBuffer Serialize(const Request& request) {
+    ByteBuffer bb;
+    bool own_buffer;
+    EXPECT_TRUE(
+        SerializationTraits<Request>::Serialize(request, &bb, &own_buffer)
+            .ok());
+    EXPECT_TRUE(own_buffer);
+    return bb;
+  }
+
+  static std::string Service(const Request& request) {
+    upb_StringView service =
+        grpc_health_v1_HealthCheckRequest_service(request.msg());
+    return std::string(service.data, service.size);
+  }
+};
+
+TEST_F(UpbMessageTest, RoundTrip) {
+  Request request;
+  grpc_health_v1_HealthCheckRequest_set_service(
+      request.mutable_msg(), upb_StringView_FromString("grpc.test.Service"));
+  ByteBuffer bb = Serialize(request);
+  Request parsed;
+  ASSERT_TRUE(SerializationTraits<Request>::Deserialize(&bb, &parsed).ok());
+  EXPECT_FALSE(bb.Valid());
+  EXPECT_EQ(Service(parsed), "grpc.test.Service");
+}
+
+TEST_F(UpbMessageTest, EmptyMessage) {
+  ByteBuffer bb = Serialize(Request());
+  EXPECT_EQ(bb.Length(), 0u);
+  Request parsed;
+  ASSERT_TRUE(SerializationTraits<Request>::Deserialize(&bb, &parsed).ok());
+  ASSERT_NE(parsed.msg(), nullptr);
+  EXPECT_EQ(Service(parsed), "");
+}
+
+TEST_F(UpbMessageTest, ParsedStringsReferenceReceivedSlice) {
+  Request request;
+  grpc_health_v1_HealthCheckRequest_set_service(
+      request.mutable_msg(), upb_StringView_FromString("grpc.test.Service"));
+  ByteBuffer bb = Serialize(request);
+  Slice slice;
+  ASSERT_TRUE(bb.TrySingleSlice(&slice).ok());
+  Request parsed;
+  ASSERT_TRUE(SerializationTraits<Request>::Deserialize(&bb, &parsed).ok());
+  upb_StringView service =
+      grpc_health_v1_HealthCheckRequest_service(parsed.msg());
+  const char* begin = reinterpret_cast<const char*>(slice.begin());
+  EXPECT_GE(service.data, begin);
+  EXPECT_LE(service.data + service.size, begin + slice.size());
+}
+
+TEST_F(UpbMessageTest, ParsesMessageInManySlices) {
+  Request request;
+  grpc_health_v1_HealthCheckRequest_set_service(
+      request.mutable_msg(), upb_StringView_FromString("grpc.test.Service"));
+  ByteBuffer bb = Serialize(request);
+  std::vector<Slice> slices;
+  ASSERT_TRUE(bb.Dump(&slices).ok());
+  ASSERT_EQ(slices.size(), 1u);
+  const std::string bytes(reinterpret_cast<const char*>(slices[0].begin()),
+                          slices[0].size());
+  slices.clear();
+  for (char c : bytes) slices.emplace_back(&c, 1);
+  ByteBuffer split(slices.data(), slices.size());
+  Request parsed;
+  ASSERT_TRUE(SerializationTraits<Request>::Deserialize(&split, &parsed).ok());
+  EXPECT_EQ(Service(parsed), "grpc.test.Service");
+}
+
+TEST_F(UpbMessageTest, InvalidMessage) {
+  Slice slice(std::string("\xff\xff\xff"));
+  ByteBuffer bb(&slice, 1);
+  Request parsed;
+  EXPECT_FALSE(SerializationTraits<Request>::Deserialize(&bb, &parsed).ok());
+  EXPECT_EQ(parsed.msg(), nullptr);
+}
+
+}  // namespace
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -90,6 +90,26 @@ TEST_F(AdminServicesTest, ValidateRegisteredServices) {
 #endif  // GRPC_NO_XDS or DISABLED_XDS_PROTO_IN_CC
 }
 
+TEST_F(AdminServicesTest, ExportOpenMetrics) {
+  // Makes a call on the reflection channel, so that it shows up in channelz.
+  GetServiceList();
+  std::string metrics = experimental::ExportOpenMetrics();
+  EXPECT_THAT(metrics,
+              ::testing::HasSubstr(
+                  "# TYPE grpc_core_client_calls_created counter\n"));
+  EXPECT_THAT(metrics,
+              ::testing::HasSubstr(
+                  "grpc_core_call_initial_size_bucket{le=\"+Inf\"} "));
+  EXPECT_THAT(metrics,
+              ::testing::HasSubstr(
+                  "grpc_channelz_calls_started_total{kind=\"channel\","));
+  EXPECT_THAT(metrics,
+              ::testing::HasSubstr(
+                  "grpc_channelz_calls_started_total{kind=\"server\","));
+  EXPECT_THAT(metrics, ::testing::HasSubstr("grpc_memory_quota_pressure "));
+  EXPECT_THAT(metrics, ::testing::EndsWith("\n# EOF\n"));
+}
+
 }  // namespace testing
 }  // namespace grpc
 
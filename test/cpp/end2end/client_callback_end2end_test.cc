@@ -744,6 +744,48 @@ TEST_P(ClientCallbackEnd2endTest, RequestStream) {
   }
 }
 
+TEST_P(ClientCallbackEnd2endTest, RequestStreamWriteBatch) {
+  ResetStub();
+  class BatchWriteClient : public grpc::ClientWriteReactor<EchoRequest> {
+   public:
+    explicit BatchWriteClient(grpc::testing::EchoTestService::Stub* stub) {
+      for (auto& request : requests_) request.set_message("Hello server.");
+      stub->async()->RequestStream(&context_, &response_, this);
+      StartWriteBatch(requests_, 3, WriteOptions().set_last_message());
+      StartCall();
+    }
+    void OnWriteDone(bool ok) override {
+      EXPECT_TRUE(ok);
+      num_write_done_++;
+    }
+    void OnDone(const Status& s) override {
+      EXPECT_TRUE(s.ok());
+      EXPECT_EQ(num_write_done_, 1);
+      EXPECT_EQ(response_.message(),
+                "Hello server.Hello server.Hello server.");
+      std::unique_lock<std::mutex> l(mu_);
+      done_ = true;
+      cv_.notify_one();
+    }
+    void Await() {
+      std::unique_lock<std::mutex> l(mu_);
+      while (!done_) {
+        cv_.wait(l);
+      }
+    }
+
+   private:
+    EchoRequest requests_[3];
+    EchoResponse response_;
+    ClientContext context_;
+    int num_write_done_ = 0;
+    std::mutex mu_;
+    std::condition_variable cv_;
+    bool done_ = false;
+  } test{stub_.get()};
+  test.Await();
+}
+
 TEST_P(ClientCallbackEnd2endTest, ClientCancelsRequestStream) {
   ResetStub();
   WriteClient test{stub_.get(), DO_NOT_CANCEL, 3, ClientCancelInfo{2}};
@@ -28,6 +28,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
+#include "absl/types/optional.h"
 
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
@@ -46,6 +47,7 @@
 #include "src/core/ext/filters/client_channel/backup_poller.h"
 #include "src/core/ext/filters/client_channel/global_subchannel_pool.h"
 #include "src/core/ext/filters/client_channel/resolver/fake/fake_resolver.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
 #include "src/core/lib/address_utils/parse_address.h"
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/backoff/backoff.h"
@@ -89,6 +91,7 @@ class MyTestServiceImpl : public TestServiceImpl {
     {
       grpc::internal::MutexLock lock(&mu_);
       ++request_count_;
+      if (fail_) return Status(StatusCode::UNAVAILABLE, "failing on purpose");
     }
     AddClient(context->peer());
     if (request->has_param() && request->param().has_backend_metrics()) {
@@ -97,6 +100,12 @@ class MyTestServiceImpl : public TestServiceImpl {
       // populating this data, use that API here.
       context->AddTrailingMetadata("x-endpoint-load-metrics-bin",
                                    load_report.SerializeAsString());
+    } else {
+      grpc::internal::MutexLock lock(&mu_);
+      if (load_report_.has_value()) {
+        context->AddTrailingMetadata("x-endpoint-load-metrics-bin",
+                                     load_report_->SerializeAsString());
+      }
     }
     return TestServiceImpl::Echo(context, request, response);
   }
@@ -111,6 +120,18 @@ class MyTestServiceImpl : public TestServiceImpl {
     request_count_ = 0;
   }
 
+  // Sets the load report returned with RPCs that do not carry their own.
+  void SetLoadReport(xds::data::orca::v3::OrcaLoadReport load_report) {
+    grpc::internal::MutexLock lock(&mu_);
+    load_report_ = std::move(load_report);
+  }
+
+  // Makes Echo RPCs fail with UNAVAILABLE while set.
+  void SetFail(bool fail) {
+    grpc::internal::MutexLock lock(&mu_);
+    fail_ = fail;
+  }
+
   std::set<std::string> clients() {
     grpc::internal::MutexLock lock(&clients_mu_);
     return clients_;
@@ -124,6 +145,8 @@ class MyTestServiceImpl : public TestServiceImpl {
 
   grpc::internal::Mutex mu_;
   int request_count_ = 0;
+  absl::optional<xds::data::orca::v3::OrcaLoadReport> load_report_;
+  bool fail_ = false;
   grpc::internal::Mutex clients_mu_;
   std::set<std::string> clients_;
 };
@@ -1024,6 +1047,25 @@ TEST_F(PickFirstTest, ReconnectWithoutNewResolverResultStartsFromTopOfList) {
   WaitForServer(stub, 0, DEBUG_LOCATION);
 }
 
+TEST_F(PickFirstTest, HappyEyeballsSkipsUnavailableAddresses) {
+  ChannelArguments args;
+  args.SetInt(GRPC_ARG_HAPPY_EYEBALLS_CONNECTION_ATTEMPT_DELAY_MS, 100);
+  std::vector<int> ports = {grpc_pick_unused_port_or_die(),
+                            grpc_pick_unused_port_or_die(),
+                            grpc_pick_unused_port_or_die()};
+  CreateServers(3, ports);
+  StartServer(2);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("pick_first", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(ports);
+  WaitForServer(stub, 2, DEBUG_LOCATION);
+  // Once the last server is selected, the channel keeps using it.
+  for (size_t i = 0; i < 10; ++i) CheckRpcSendOk(stub, DEBUG_LOCATION);
+  EXPECT_EQ(0, servers_[0]->service_.request_count());
+  EXPECT_EQ(0, servers_[1]->service_.request_count());
+}
+
 TEST_F(PickFirstTest, CheckStateBeforeStartWatch) {
   std::vector<int> ports = {grpc_pick_unused_port_or_die()};
   StartServers(1, ports);
@@ -1826,6 +1868,53 @@ TEST_F(RoundRobinTest, HealthCheckingServiceNamePerChannel) {
   EnableDefaultHealthCheckService(false);
 }
 
+TEST_F(RoundRobinTest, HealthCheckingSharedStreams) {
+  EnableDefaultHealthCheckService(true);
+  // Start server.
+  const int kNumServers = 1;
+  StartServers(kNumServers);
+  std::vector<int> ports = GetServersPorts();
+  // Create two channels sharing health check streams, with different
+  // channel args, so that they do not share a subchannel.
+  ChannelArguments args;
+  args.SetServiceConfigJSON(
+      "{\"healthCheckConfig\": "
+      "{\"serviceName\": \"health_check_service_name\"}}");
+  args.SetInt(GRPC_ARG_SHARE_HEALTH_CHECK_STREAMS, 1);
+  args.SetInt("grpc.testing.channel_index", 1);
+  auto response_generator1 = BuildResolverResponseGenerator();
+  auto channel1 = BuildChannel("round_robin", response_generator1, args);
+  auto stub1 = BuildStub(channel1);
+  response_generator1.SetNextResolution(ports);
+  args.SetInt("grpc.testing.channel_index", 2);
+  auto response_generator2 = BuildResolverResponseGenerator();
+  auto channel2 = BuildChannel("round_robin", response_generator2, args);
+  auto stub2 = BuildStub(channel2);
+  response_generator2.SetNextResolution(ports);
+  // Neither channel should become READY, because health checks should be
+  // failing.
+  EXPECT_FALSE(WaitForChannelReady(channel1.get(), 1));
+  EXPECT_FALSE(WaitForChannelReady(channel2.get(), 1));
+  // Enable health checks on the backend, and wait for both channels to
+  // succeed.
+  servers_[0]->SetServingStatus("health_check_service_name", true);
+  CheckRpcSendOk(stub1, DEBUG_LOCATION, true /* wait_for_ready */);
+  CheckRpcSendOk(stub2, DEBUG_LOCATION, true /* wait_for_ready */);
+  // Each channel has its own connection to the backend.
+  EXPECT_EQ(2UL, servers_[0]->service_.clients().size());
+  // Destroy the first channel.  The second one should still see health
+  // status changes.
+  stub1.reset();
+  channel1.reset();
+  servers_[0]->SetServingStatus("health_check_service_name", false);
+  EXPECT_TRUE(WaitForChannelNotReady(channel2.get()));
+  CheckRpcSendFailure(stub2);
+  servers_[0]->SetServingStatus("health_check_service_name", true);
+  CheckRpcSendOk(stub2, DEBUG_LOCATION, true /* wait_for_ready */);
+  // Clean up.
+  EnableDefaultHealthCheckService(false);
+}
+
 TEST_F(RoundRobinTest,
        HealthCheckingServiceNameChangesAfterSubchannelsCreated) {
   EnableDefaultHealthCheckService(true);
@@ -1854,6 +1943,158 @@ TEST_F(RoundRobinTest,
   EnableDefaultHealthCheckService(false);
 }
 
+//
+// least_request tests
+//
+
+using LeastRequestTest = ClientLbEnd2endTest;
+
+TEST_F(LeastRequestTest, Basic) {
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": [{\"least_request_experimental\": {}}]}");
+  // Every backend gets picked.
+  do {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  } while (!SeenAllServers());
+  EXPECT_EQ("least_request_experimental",
+            channel->GetLoadBalancingPolicyName());
+}
+
+TEST_F(LeastRequestTest, AvoidsBackendWithCallsInFlight) {
+  // Sampling 10 times out of 2 backends, a pick misses the idle backend with
+  // probability 1/1024.
+  const char* kServiceConfigJson =
+      "{\"loadBalancingConfig\": [{\"least_request_experimental\": "
+      "{\"choiceCount\": 10}}]}";
+  const int kNumServers = 2;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  // Start a stream on the first backend only, and keep it open.
+  response_generator.SetNextResolution({servers_[0]->port_},
+                                       kServiceConfigJson);
+  ClientContext context;
+  auto stream = stub->BidiStream(&context);
+  EchoRequest request;
+  EchoResponse response;
+  request.set_message(kRequestMessage);
+  ASSERT_TRUE(stream->Write(request));
+  ASSERT_TRUE(stream->Read(&response));
+  // The stream keeps counting for the first backend across the update.
+  response_generator.SetNextResolution(GetServersPorts(), kServiceConfigJson);
+  WaitForServer(stub, 1, DEBUG_LOCATION);
+  ResetCounters();
+  const int kNumRpcs = 10;
+  for (int i = 0; i < kNumRpcs; ++i) CheckRpcSendOk(stub, DEBUG_LOCATION);
+  EXPECT_GE(servers_[1]->service_.request_count(), kNumRpcs - 1);
+  stream->WritesDone();
+  EXPECT_TRUE(stream->Finish().ok());
+}
+
+//
+// weighted_round_robin tests
+//
+
+using WeightedRoundRobinTest = ClientLbEnd2endTest;
+
+TEST_F(WeightedRoundRobinTest, Basic) {
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": "
+      "[{\"weighted_round_robin_experimental\": {}}]}");
+  // Without weights yet, every backend gets picked.
+  do {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  } while (!SeenAllServers());
+  EXPECT_EQ("weighted_round_robin_experimental",
+            channel->GetLoadBalancingPolicyName());
+}
+
+TEST_F(WeightedRoundRobinTest, WeightsFromPerCallReports) {
+  const int kNumServers = 2;
+  StartServers(kNumServers);
+  // Backend 0 serves 4 times as many requests per CPU as backend 1.
+  xds::data::orca::v3::OrcaLoadReport load_report;
+  load_report.set_rps(100);
+  load_report.set_cpu_utilization(0.1);
+  servers_[0]->service_.SetLoadReport(load_report);
+  load_report.set_cpu_utilization(0.4);
+  servers_[1]->service_.SetLoadReport(load_report);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": [{\"weighted_round_robin_experimental\": "
+      "{\"blackoutPeriod\": \"0s\", \"weightUpdatePeriod\": \"0.1s\"}}]}");
+  do {
+    CheckRpcSendOk(stub, DEBUG_LOCATION);
+  } while (!SeenAllServers());
+  // Let a picker with both weights be created.
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(500));
+  CheckRpcSendOk(stub, DEBUG_LOCATION);
+  ResetCounters();
+  const int kNumRpcs = 500;
+  for (int i = 0; i < kNumRpcs; ++i) CheckRpcSendOk(stub, DEBUG_LOCATION);
+  EXPECT_NEAR(servers_[0]->service_.request_count(), kNumRpcs * 4 / 5,
+              kNumRpcs / 10);
+  EXPECT_NEAR(servers_[1]->service_.request_count(), kNumRpcs / 5,
+              kNumRpcs / 10);
+}
+
+//
+// outlier_detection tests
+//
+
+using OutlierDetectionTest = ClientLbEnd2endTest;
+
+TEST_F(OutlierDetectionTest, EjectsFailingBackend) {
+  const int kNumServers = 3;
+  StartServers(kNumServers);
+  servers_[0]->service_.SetFail(true);
+  auto response_generator = BuildResolverResponseGenerator();
+  auto channel = BuildChannel("", response_generator);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(
+      GetServersPorts(),
+      "{\"loadBalancingConfig\": [{\"outlier_detection_experimental\": {"
+      "\"interval\": \"0.5s\", \"maxEjectionPercent\": 50, "
+      "\"failurePercentageEjection\": {\"threshold\": 50, "
+      "\"minimumHosts\": 3, \"requestVolume\": 10}, "
+      "\"childPolicy\": [{\"round_robin\": {}}]}}]}");
+  WaitForServers(stub, 0, kNumServers, DEBUG_LOCATION,
+                 /*ignore_failure=*/true);
+  EXPECT_EQ("outlier_detection_experimental",
+            channel->GetLoadBalancingPolicyName());
+  // Backend 0 gets its share of RPCs, and fails all of them, until the
+  // end of an interval in which every backend saw enough RPCs.
+  const absl::Time deadline =
+      absl::Now() + (absl::Seconds(10) * grpc_test_slowdown_factor());
+  do {
+    ResetCounters();
+    for (int i = 0; i < 30; ++i) SendRpc(stub);
+    ASSERT_LT(absl::Now(), deadline);
+  } while (servers_[0]->service_.request_count() > 0);
+  // Once ejected, backend 0 gets no RPCs and every RPC succeeds.
+  const int kNumRpcs = 30;
+  for (int i = 0; i < kNumRpcs; ++i) CheckRpcSendOk(stub, DEBUG_LOCATION);
+  EXPECT_EQ(0, servers_[0]->service_.request_count());
+  EXPECT_EQ(kNumRpcs, servers_[1]->service_.request_count() +
+                          servers_[2]->service_.request_count());
+}
+
 //
 // LB policy pick args
 //
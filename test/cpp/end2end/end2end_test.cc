@@ -28,6 +28,7 @@
 #include <grpc/support/log.h>
 #include <grpc/support/time.h>
 #include <grpcpp/channel.h>
+#include <grpcpp/channel_set.h>
 #include <grpcpp/client_context.h>
 #include <grpcpp/create_channel.h>
 #include <grpcpp/resource_quota.h>
@@ -899,6 +900,45 @@ TEST_P(End2endTest, ReconnectChannel) {
   SendRpc(stub_.get(), 1, false);
 }
 
+TEST_P(End2endTest, ChannelPoolOpensChannelsUnderLoad) {
+  // Peer is not meaningful for inproc
+  if (GetParam().inproc) {
+    return;
+  }
+  ResetStub();
+  ChannelArguments args;
+  auto channel_creds = GetCredentialsProvider()->GetChannelCredentials(
+      GetParam().credentials_type, &args);
+  experimental::ChannelPoolOptions options;
+  options.max_channels = 2;
+  options.max_calls_per_channel = 1;
+  auto stub = grpc::testing::EchoTestService::NewStub(
+      experimental::CreateChannelPool(server_address_.str(), channel_creds,
+                                      args, options));
+  EchoRequest request;
+  request.set_message("hello");
+  request.mutable_param()->set_echo_peer(true);
+  EchoResponse first_response;
+  {
+    ClientContext context;
+    EXPECT_TRUE(stub->Echo(&context, request, &first_response).ok());
+  }
+
+  // The first channel is idle again and takes the stream, which then keeps
+  // it at its limit.
+  ClientContext stream_context;
+  EchoResponse stream_response;
+  auto stream = stub->RequestStream(&stream_context, &stream_response);
+  EchoResponse second_response;
+  {
+    ClientContext context;
+    EXPECT_TRUE(stub->Echo(&context, request, &second_response).ok());
+  }
+  EXPECT_NE(first_response.param().peer(), second_response.param().peer());
+  stream->WritesDone();
+  EXPECT_TRUE(stream->Finish().ok());
+}
+
 TEST_P(End2endTest, RequestStreamOneRequest) {
   ResetStub();
   EchoRequest request;
@@ -962,6 +1002,22 @@ TEST_P(End2endTest, RequestStreamTwoRequestsWithWriteThrough) {
   EXPECT_TRUE(s.ok());
 }
 
+TEST_P(End2endTest, RequestStreamWriteBatch) {
+  ResetStub();
+  std::vector<EchoRequest> requests(3);
+  EchoResponse response;
+  ClientContext context;
+
+  auto stream = stub_->RequestStream(&context, &response);
+  for (auto& request : requests) request.set_message("hello");
+  EXPECT_TRUE(stream->WriteBatch(requests.data(), requests.size()));
+  EXPECT_TRUE(stream->WriteBatch(requests.data(), 1));
+  stream->WritesDone();
+  Status s = stream->Finish();
+  EXPECT_EQ(response.message(), "hellohellohellohello");
+  EXPECT_TRUE(s.ok());
+}
+
 TEST_P(End2endTest, RequestStreamTwoRequestsWithCoalescingApi) {
   ResetStub();
   EchoRequest request;
@@ -996,6 +1052,27 @@ TEST_P(End2endTest, ResponseStream) {
   EXPECT_TRUE(s.ok());
 }
 
+TEST_P(End2endTest, ResponseStreamWithMaxBufferedReceiveBytes) {
+  ResetStub();
+  EchoRequest request;
+  EchoResponse response;
+  ClientContext context;
+  // Each response is several times the bound, which must only slow the
+  // stream down.
+  context.set_max_buffered_receive_bytes(1024);
+  request.set_message(std::string(100 * 1024, 'a'));
+
+  auto stream = stub_->ResponseStream(&context, request);
+  for (int i = 0; i < kServerDefaultResponseStreamsToSend; ++i) {
+    EXPECT_TRUE(stream->Read(&response));
+    EXPECT_EQ(response.message(), request.message() + std::to_string(i));
+  }
+  EXPECT_FALSE(stream->Read(&response));
+
+  Status s = stream->Finish();
+  EXPECT_TRUE(s.ok());
+}
+
 TEST_P(End2endTest, ResponseStreamWithCoalescingApi) {
   ResetStub();
   EchoRequest request;
@@ -1400,6 +1477,49 @@ TEST_P(End2endTest, ChannelStateOnLameChannel) {
   }
 }
 
+TEST_P(End2endTest, ChannelSetState) {
+  if (GetParam().inproc) {
+    return;
+  }
+  ResetStub();
+  // A lame channel, which is reported once.
+  auto lame_channel =
+      grpc::CreateChannel("dns:///", InsecureChannelCredentials());
+  experimental::ChannelSet channel_set;
+  EXPECT_EQ(channel_set.WatchAll({channel_, lame_channel}), 0u);
+  // The first changes are the current states.
+  std::vector<experimental::ChannelSet::StateChange> changes;
+  auto deadline = [] {
+    return std::chrono::system_clock::now() + std::chrono::seconds(10);
+  };
+  ASSERT_TRUE(channel_set.Next(&changes, deadline()));
+  ASSERT_EQ(changes.size(), 2u);
+  EXPECT_EQ(changes[0].index, 0u);
+  EXPECT_EQ(changes[0].state, GRPC_CHANNEL_IDLE);
+  EXPECT_EQ(changes[1].index, 1u);
+  EXPECT_EQ(changes[1].state, GRPC_CHANNEL_TRANSIENT_FAILURE);
+  // Did not ask to connect, no state change.
+  changes.clear();
+  EXPECT_FALSE(channel_set.Next(
+      &changes,
+      std::chrono::system_clock::now() + std::chrono::milliseconds(10)));
+  EXPECT_TRUE(changes.empty());
+  // Without re-arming anything, every change is reported until the channel
+  // is READY.
+  channel_->GetState(true);
+  grpc_connectivity_state state = GRPC_CHANNEL_IDLE;
+  while (state != GRPC_CHANNEL_READY) {
+    changes.clear();
+    ASSERT_TRUE(channel_set.Next(&changes, deadline()));
+    ASSERT_EQ(changes.size(), 1u);
+    EXPECT_EQ(changes[0].index, 0u);
+    EXPECT_NE(changes[0].state, state);
+    state = changes[0].state;
+  }
+  channel_set.Shutdown();
+  EXPECT_FALSE(channel_set.Next(&changes, deadline()));
+}
+
 // Talking to a non-existing service.
 TEST_P(End2endTest, NonExistingService) {
   ResetChannel();
@@ -390,6 +390,63 @@ TEST_F(GenericEnd2endTest, SimpleBidiStreaming) {
   EXPECT_TRUE(recv_status.ok());
 }
 
+// The server echoes the received buffer by moving it into its write.
+TEST_F(GenericEnd2endTest, BidiStreamingForwardBuffer) {
+  ResetStub();
+
+  const std::string kMethodName(
+      "/grpc.cpp.test.util.EchoTestService/BidiStream");
+  EchoRequest send_request;
+  EchoRequest recv_request;
+  Status recv_status;
+  ClientContext cli_ctx;
+  GenericServerContext srv_ctx;
+  GenericServerAsyncReaderWriter srv_stream(&srv_ctx);
+
+  send_request.set_message("Hello");
+  std::thread request_call([this]() { server_ok(2); });
+  std::unique_ptr<GenericClientAsyncReaderWriter> cli_stream =
+      generic_stub_->PrepareCall(&cli_ctx, kMethodName, &cli_cq_);
+  cli_stream->StartCall(tag(1));
+  client_ok(1);
+
+  generic_service_.RequestCall(&srv_ctx, &srv_stream, srv_cq_.get(),
+                               srv_cq_.get(), tag(2));
+  request_call.join();
+
+  std::unique_ptr<ByteBuffer> send_buffer =
+      SerializeToByteBuffer(&send_request);
+  cli_stream->Write(std::move(*send_buffer), tag(3));
+  EXPECT_FALSE(send_buffer->Valid());
+  client_ok(3);
+
+  ByteBuffer recv_buffer;
+  srv_stream.Read(&recv_buffer, tag(4));
+  server_ok(4);
+
+  srv_stream.Write(std::move(recv_buffer), tag(5));
+  EXPECT_FALSE(recv_buffer.Valid());
+  server_ok(5);
+
+  cli_stream->Read(&recv_buffer, tag(6));
+  client_ok(6);
+  EXPECT_TRUE(ParseFromByteBuffer(&recv_buffer, &recv_request));
+  EXPECT_EQ(send_request.message(), recv_request.message());
+
+  cli_stream->WritesDone(tag(7));
+  client_ok(7);
+
+  srv_stream.Read(&recv_buffer, tag(8));
+  server_fail(8);
+
+  srv_stream.Finish(Status::OK, tag(9));
+  server_ok(9);
+
+  cli_stream->Finish(&recv_status, tag(10));
+  client_ok(10);
+  EXPECT_TRUE(recv_status.ok());
+}
+
 TEST_F(GenericEnd2endTest, Deadline) {
   ResetStub();
   SendRpc(1, true,
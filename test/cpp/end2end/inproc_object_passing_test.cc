@@ -0,0 +1,176 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/memory/memory.h"
+
+#include <grpc/grpc.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/end2end/interceptors_util.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+class EchoServiceImpl : public EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* /*context*/, const EchoRequest* request,
+              EchoResponse* response) override {
+    response->set_message(request->message());
+    return Status::OK;
+  }
+
+  Status BidiStream(
+      ServerContext* /*context*/,
+      ServerReaderWriter<EchoResponse, EchoRequest>* stream) override {
+    EchoRequest request;
+    EchoResponse response;
+    while (stream->Read(&request)) {
+      response.set_message(request.message());
+      stream->Write(response);
+    }
+    return Status::OK;
+  }
+};
+
+class InprocObjectPassingTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ServerBuilder builder;
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+  }
+
+  void TearDown() override { server_->Shutdown(); }
+
+  void ResetStub(ChannelArguments args,
+                 std::vector<std::unique_ptr<
+                     experimental::ClientInterceptorFactoryInterface>>
+                     interceptor_creators = {}) {
+    args.SetInt(GRPC_ARG_INPROC_OBJECT_PASSING, 1);
+    channel_ = server_->experimental().InProcessChannelWithInterceptors(
+        args, std::move(interceptor_creators));
+    stub_ = EchoTestService::NewStub(channel_);
+  }
+
+  void SendUnaryRpcs(int num_rpcs, const std::string& message) {
+    for (int i = 0; i < num_rpcs; ++i) {
+      EchoRequest request;
+      EchoResponse response;
+      request.set_message(message + std::to_string(i));
+      ClientContext context;
+      Status s = stub_->Echo(&context, request, &response);
+      EXPECT_TRUE(s.ok()) << s.error_message();
+      EXPECT_EQ(response.message(), request.message());
+    }
+  }
+
+  EchoServiceImpl service_;
+  std::unique_ptr<Server> server_;
+  std::shared_ptr<Channel> channel_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+};
+
+TEST_F(InprocObjectPassingTest, Unary) {
+  ResetStub(ChannelArguments());
+  SendUnaryRpcs(10, "hello");
+  // Larger than one slice of the serialized form.
+  SendUnaryRpcs(2, std::string(1024 * 1024, 'a'));
+}
+
+TEST_F(InprocObjectPassingTest, BidiStream) {
+  ResetStub(ChannelArguments());
+  ClientContext context;
+  auto stream = stub_->BidiStream(&context);
+  EchoRequest request;
+  EchoResponse response;
+  for (int i = 0; i < 10; ++i) {
+    request.set_message("message" + std::to_string(i));
+    ASSERT_TRUE(stream->Write(request));
+    ASSERT_TRUE(stream->Read(&response));
+    EXPECT_EQ(response.message(), request.message());
+  }
+  stream->WritesDone();
+  EXPECT_FALSE(stream->Read(&response));
+  EXPECT_TRUE(stream->Finish().ok());
+}
+
+TEST_F(InprocObjectPassingTest, CallbackClient) {
+  ResetStub(ChannelArguments());
+  for (int i = 0; i < 10; ++i) {
+    EchoRequest request;
+    EchoResponse response;
+    request.set_message("callback" + std::to_string(i));
+    ClientContext context;
+    grpc_core::Mutex mu;
+    grpc_core::CondVar cv;
+    bool done = false;
+    Status status;
+    stub_->async()->Echo(&context, &request, &response, [&](Status s) {
+      grpc_core::MutexLock lock(&mu);
+      status = std::move(s);
+      done = true;
+      cv.Signal();
+    });
+    grpc_core::MutexLock lock(&mu);
+    while (!done) cv.Wait(&mu);
+    EXPECT_TRUE(status.ok()) << status.error_message();
+    EXPECT_EQ(response.message(), request.message());
+  }
+}
+
+TEST_F(InprocObjectPassingTest, InterceptorsSeeBytes) {
+  std::vector<std::unique_ptr<experimental::ClientInterceptorFactoryInterface>>
+      creators;
+  creators.push_back(absl::make_unique<PhonyInterceptorFactory>());
+  PhonyInterceptor::Reset();
+  ResetStub(ChannelArguments(), std::move(creators));
+  SendUnaryRpcs(10, "intercepted");
+  EXPECT_EQ(PhonyInterceptor::GetNumTimesRun(), 10);
+}
+
+TEST_F(InprocObjectPassingTest, CompressedChannel) {
+  ChannelArguments args;
+  args.SetCompressionAlgorithm(GRPC_COMPRESS_GZIP);
+  ResetStub(args);
+  SendUnaryRpcs(10, std::string(1024, 'z'));
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
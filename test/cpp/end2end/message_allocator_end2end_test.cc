@@ -48,6 +48,8 @@ namespace grpc {
 namespace testing {
 namespace {
 
+constexpr int kServerStreamingResponses = 3;
+
 class CallbackTestServiceImpl : public EchoTestService::CallbackService {
  public:
   explicit CallbackTestServiceImpl() {}
@@ -71,6 +73,48 @@ class CallbackTestServiceImpl : public EchoTestService::CallbackService {
     return reactor;
   }
 
+  // Echoes the request kServerStreamingResponses times, writing from the
+  // allocated response when there is one.
+  ServerWriteReactor<EchoResponse>* ResponseStream(
+      CallbackServerContext* context, const EchoRequest* request) override {
+    class Reactor : public ServerWriteReactor<EchoResponse> {
+     public:
+      Reactor(RpcAllocatorState* allocator_state, const EchoRequest* request)
+          : response_(
+                allocator_state != nullptr
+                    ? static_cast<MessageHolder<EchoRequest, EchoResponse>*>(
+                          allocator_state)
+                          ->response()
+                    : &local_response_) {
+        response_->set_message(request->message());
+        NextWrite();
+      }
+      void OnWriteDone(bool ok) override {
+        if (!ok) {
+          Finish(Status(StatusCode::UNKNOWN, "write failed"));
+          return;
+        }
+        NextWrite();
+      }
+      void OnDone() override { delete this; }
+
+     private:
+      void NextWrite() {
+        if (num_writes_ == kServerStreamingResponses) {
+          Finish(Status::OK);
+          return;
+        }
+        num_writes_++;
+        StartWrite(response_);
+      }
+
+      EchoResponse local_response_;
+      EchoResponse* const response_;
+      int num_writes_ = 0;
+    };
+    return new Reactor(context->GetRpcAllocatorState(), request);
+  }
+
  private:
   std::function<void(RpcAllocatorState* allocator_state, const EchoRequest* req,
                      EchoResponse* resp)>
@@ -118,6 +162,7 @@ class MessageAllocatorEnd2endTestBase
       builder.AddListeningPort(server_address_.str(), server_creds);
     }
     callback_service_.SetMessageAllocatorFor_Echo(allocator);
+    callback_service_.SetMessageAllocatorFor_ResponseStream(allocator);
     builder.RegisterService(&callback_service_);
 
     server_ = builder.BuildAndStart();
@@ -187,6 +232,24 @@ class MessageAllocatorEnd2endTestBase
     }
   }
 
+  void SendServerStreamingRpcs(int num_rpcs) {
+    for (int i = 0; i < num_rpcs; i++) {
+      EchoRequest request;
+      EchoResponse response;
+      ClientContext cli_ctx;
+      request.set_message(std::string(1024 * (i + 1), 'x'));
+      auto reader = stub_->ResponseStream(&cli_ctx, request);
+      int num_responses = 0;
+      while (reader->Read(&response)) {
+        EXPECT_EQ(request.message(), response.message());
+        num_responses++;
+      }
+      EXPECT_TRUE(reader->Finish().ok());
+      EXPECT_EQ(kServerStreamingResponses,
+                num_responses);
+    }
+  }
+
   int picked_port_{0};
   std::shared_ptr<Channel> channel_;
   std::unique_ptr<EchoTestService::Stub> stub_;
@@ -203,6 +266,12 @@ TEST_P(NullAllocatorTest, SimpleRpc) {
   SendRpcs(1);
 }
 
+TEST_P(NullAllocatorTest, ServerStreamingRpc) {
+  CreateServer(nullptr);
+  ResetStub();
+  SendServerStreamingRpcs(1);
+}
+
 class SimpleAllocatorTest : public MessageAllocatorEnd2endTestBase {
  public:
   class SimpleAllocator : public MessageAllocator<EchoRequest, EchoResponse> {
@@ -317,6 +386,19 @@ TEST_P(SimpleAllocatorTest, RpcWithReleaseRequest) {
   }
 }
 
+TEST_P(SimpleAllocatorTest, ServerStreamingRpc) {
+  const int kRpcCount = 10;
+  std::unique_ptr<SimpleAllocator> allocator(new SimpleAllocator);
+  CreateServer(allocator.get());
+  ResetStub();
+  SendServerStreamingRpcs(kRpcCount);
+  // Messages are released after the server side OnDone.
+  DestroyServer();
+  EXPECT_EQ(kRpcCount, allocator->allocation_count);
+  EXPECT_EQ(kRpcCount, allocator->messages_deallocation_count);
+  EXPECT_EQ(0, allocator->request_deallocation_count);
+}
+
 class ArenaAllocatorTest : public MessageAllocatorEnd2endTestBase {
  public:
   class ArenaAllocator : public MessageAllocator<EchoRequest, EchoResponse> {
@@ -352,6 +434,15 @@ TEST_P(ArenaAllocatorTest, SimpleRpc) {
   EXPECT_EQ(kRpcCount, allocator->allocation_count);
 }
 
+TEST_P(ArenaAllocatorTest, ServerStreamingRpc) {
+  const int kRpcCount = 10;
+  std::unique_ptr<ArenaAllocator> allocator(new ArenaAllocator);
+  CreateServer(allocator.get());
+  ResetStub();
+  SendServerStreamingRpcs(kRpcCount);
+  EXPECT_EQ(kRpcCount, allocator->allocation_count);
+}
+
 std::vector<TestScenario> CreateTestScenarios(bool test_insecure) {
   std::vector<TestScenario> scenarios;
   std::vector<std::string> credentials_types{
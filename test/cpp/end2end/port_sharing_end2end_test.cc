@@ -110,6 +110,9 @@ class TestTcpServer {
   // Read some data before handing off the connection.
   void SetQueueData() { queue_data_ = true; }
 
+  // Hand connections over through the batch API.
+  void SetUseBatch() { use_batch_ = true; }
+
   void Start() {
     test_tcp_server_start(&tcp_server_, port_);
     gpr_log(GPR_INFO, "Test TCP server started at %s", address_.c_str());
@@ -181,7 +184,11 @@ class TestTcpServer {
     }
     gpr_log(GPR_INFO, "Handing off fd %d with data size %d from listener fd %d",
             fd_, static_cast<int>(p.read_buffer.Length()), listener_fd_);
-    connection_acceptor_->HandleNewConnection(&p);
+    if (use_batch_) {
+      connection_acceptor_->HandleNewConnections(&p, 1);
+    } else {
+      connection_acceptor_->HandleNewConnection(&p);
+    }
   }
 
   std::mutex mu_;
@@ -190,6 +197,7 @@ class TestTcpServer {
   int listener_fd_ = -1;
   int fd_ = -1;
   bool queue_data_ = false;
+  bool use_batch_ = false;
 
   grpc_closure on_fd_released_;
   std::thread running_thread_;
@@ -211,6 +219,7 @@ class PortSharingEnd2endTest : public ::testing::TestWithParam<TestScenario> {
       tcp_server1_.SetQueueData();
       tcp_server2_.SetQueueData();
     }
+    tcp_server2_.SetUseBatch();
     tcp_server1_.Start();
     tcp_server2_.Start();
     ServerBuilder builder;
@@ -1011,6 +1011,168 @@ TEST_F(RlsEnd2endTest, CachedResponse) {
   EXPECT_EQ(backends_[0]->service_.request_count(), 2);
 }
 
+// Once a key's response is cached, the pickers route calls for it without
+// the LB policy's lock.  Calls from several threads for keys with different
+// targets and header data must still be routed by key.
+TEST_F(RlsEnd2endTest, CachedResponsesUsedFromManyThreads) {
+  const char* kTestValue2 = "test_value_2";
+  const char* kHeaderData = "header_data";
+  const char* kHeaderData2 = "header_data_2";
+  constexpr int kNumThreads = 4;
+  constexpr int kNumRpcsPerThread = 10;
+  StartBackends(2);
+  SetNextResolution(
+      MakeServiceConfigBuilder()
+          .AddKeyBuilder(absl::StrFormat("\"names\":[{"
+                                         "  \"service\":\"%s\","
+                                         "  \"method\":\"%s\""
+                                         "}],"
+                                         "\"headers\":["
+                                         "  {"
+                                         "    \"key\":\"%s\","
+                                         "    \"names\":["
+                                         "      \"key1\""
+                                         "    ]"
+                                         "  }"
+                                         "]",
+                                         kServiceValue, kMethodValue, kTestKey))
+          .Build());
+  rls_server_->service_.SetResponse(
+      BuildRlsRequest({{kTestKey, kTestValue}}),
+      BuildRlsResponse({TargetStringForPort(backends_[0]->port_)},
+                       kHeaderData));
+  rls_server_->service_.SetResponse(
+      BuildRlsRequest({{kTestKey, kTestValue2}}),
+      BuildRlsResponse({TargetStringForPort(backends_[1]->port_)},
+                       kHeaderData2));
+  // Populate the cache.
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", kTestValue}}));
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", kTestValue2}}));
+  EXPECT_EQ(rls_server_->service_.request_count(), 2);
+  // Send RPCs for both keys concurrently.
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      const char* value = i % 2 == 0 ? kTestValue : kTestValue2;
+      for (int j = 0; j < kNumRpcsPerThread; ++j) {
+        CheckRpcSendOk(DEBUG_LOCATION,
+                       RpcOptions().set_metadata({{"key1", value}}));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  // No further RLS requests were needed.
+  EXPECT_EQ(rls_server_->service_.request_count(), 2);
+  EXPECT_EQ(rls_server_->service_.response_count(), 2);
+  EXPECT_EQ(backends_[0]->service_.request_count(),
+            1 + kNumThreads / 2 * kNumRpcsPerThread);
+  EXPECT_EQ(backends_[1]->service_.request_count(),
+            1 + kNumThreads / 2 * kNumRpcsPerThread);
+  EXPECT_THAT(backends_[0]->service_.rls_data(),
+              ::testing::ElementsAre(kHeaderData));
+  EXPECT_THAT(backends_[1]->service_.rls_data(),
+              ::testing::ElementsAre(kHeaderData2));
+}
+
+// A key whose RLS request failed is in backoff, so its calls go through the
+// LB policy's lock to the default target, while a cached key next to it is
+// still routed to its own target.
+TEST_F(RlsEnd2endTest, EntryInBackoffNextToCachedEntry) {
+  const char* kTestValue2 = "test_value_2";
+  StartBackends(2);
+  SetNextResolution(
+      MakeServiceConfigBuilder()
+          .AddKeyBuilder(absl::StrFormat("\"names\":[{"
+                                         "  \"service\":\"%s\","
+                                         "  \"method\":\"%s\""
+                                         "}],"
+                                         "\"headers\":["
+                                         "  {"
+                                         "    \"key\":\"%s\","
+                                         "    \"names\":["
+                                         "      \"key1\""
+                                         "    ]"
+                                         "  }"
+                                         "]",
+                                         kServiceValue, kMethodValue, kTestKey))
+          .set_default_target(TargetStringForPort(backends_[1]->port_))
+          .Build());
+  rls_server_->service_.SetResponse(
+      BuildRlsRequest({{kTestKey, kTestValue}}),
+      BuildRlsResponse({TargetStringForPort(backends_[0]->port_)}));
+  // No response for kTestValue2, so its RLS request fails.
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", kTestValue}}));
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", kTestValue2}}));
+  EXPECT_EQ(rls_server_->service_.request_count(), 2);
+  EXPECT_EQ(backends_[0]->service_.request_count(), 1);
+  EXPECT_EQ(backends_[1]->service_.request_count(), 1);
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", kTestValue}}));
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", kTestValue2}}));
+  // The entry in backoff did not start another RLS request.
+  EXPECT_EQ(rls_server_->service_.request_count(), 2);
+  EXPECT_EQ(rls_server_->service_.response_count(), 1);
+  EXPECT_EQ(backends_[0]->service_.request_count(), 2);
+  EXPECT_EQ(backends_[1]->service_.request_count(), 2);
+}
+
+// Once a cached entry goes stale, a picker that was created while it was
+// fresh no longer routes its calls without the lock: the next call starts
+// the refresh.  While the refresh is pending or in backoff after failing,
+// calls keep using the data until it expires.
+TEST_F(RlsEnd2endTest, StaleCacheEntryWithFailedRefresh) {
+  StartBackends(1);
+  SetNextResolution(
+      MakeServiceConfigBuilder()
+          .AddKeyBuilder(absl::StrFormat("\"names\":[{"
+                                         "  \"service\":\"%s\","
+                                         "  \"method\":\"%s\""
+                                         "}],"
+                                         "\"headers\":["
+                                         "  {"
+                                         "    \"key\":\"%s\","
+                                         "    \"names\":["
+                                         "      \"key1\""
+                                         "    ]"
+                                         "  }"
+                                         "]",
+                                         kServiceValue, kMethodValue, kTestKey))
+          .set_max_age(grpc_core::Duration::Seconds(10))
+          .set_stale_age(grpc_core::Duration::Seconds(1))
+          .Build());
+  rls_server_->service_.SetResponse(
+      BuildRlsRequest({{kTestKey, kTestValue}}),
+      BuildRlsResponse({TargetStringForPort(backends_[0]->port_)}));
+  // Calls while the entry is fresh need only one RLS request.
+  for (int i = 0; i < 3; ++i) {
+    CheckRpcSendOk(DEBUG_LOCATION,
+                   RpcOptions().set_metadata({{"key1", kTestValue}}));
+  }
+  EXPECT_EQ(rls_server_->service_.request_count(), 1);
+  EXPECT_EQ(backends_[0]->service_.request_count(), 3);
+  // Have the refresh fail.
+  rls_server_->service_.RemoveResponse(
+      BuildRlsRequest({{kTestKey, kTestValue}}));
+  // Wait longer than stale age.
+  gpr_sleep_until(grpc_timeout_seconds_to_deadline(2));
+  // This call uses the stale data, and starts the refresh.
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", kTestValue}}));
+  // The refresh is pending or has failed, and the data has not expired.
+  CheckRpcSendOk(DEBUG_LOCATION,
+                 RpcOptions().set_metadata({{"key1", kTestValue}}));
+  EXPECT_EQ(backends_[0]->service_.request_count(), 5);
+  // Wait for the refresh to fail.  It was the only one started.
+  gpr_sleep_until(grpc_timeout_seconds_to_deadline(1));
+  EXPECT_EQ(rls_server_->service_.request_count(), 2);
+  EXPECT_EQ(rls_server_->service_.response_count(), 1);
+}
+
 TEST_F(RlsEnd2endTest, StaleCacheEntry) {
   StartBackends(1);
   SetNextResolution(
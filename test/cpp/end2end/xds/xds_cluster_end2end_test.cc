@@ -24,6 +24,7 @@
 #include "absl/strings/str_cat.h"
 
 #include "src/core/ext/filters/client_channel/backup_poller.h"
+#include "src/core/lib/debug/stats.h"
 #include "test/cpp/end2end/xds/xds_end2end_test_lib.h"
 
 namespace grpc {
@@ -118,7 +119,7 @@ TEST_P(CdsTest, AcceptsEdsConfigSourceOfTypeAds) {
 }
 
 // Tests that CDS client should send a NACK if the lb_policy in CDS response
-// is other than ROUND_ROBIN.
+// is not supported, which includes LEAST_REQUEST unless enabled.
 TEST_P(CdsTest, WrongLbPolicy) {
   auto cluster = default_cluster_;
   cluster.set_lb_policy(Cluster::LEAST_REQUEST);
@@ -129,6 +130,40 @@ TEST_P(CdsTest, WrongLbPolicy) {
               ::testing::HasSubstr("LB policy is not supported."));
 }
 
+// Tests that the LEAST_REQUEST LB policy is accepted when enabled.
+TEST_P(CdsTest, LeastRequestLbPolicy) {
+  ScopedExperimentalEnvVar env_var(
+      "GRPC_XDS_EXPERIMENTAL_ENABLE_LEAST_REQUEST_LB");
+  CreateAndStartBackends(2);
+  auto cluster = default_cluster_;
+  cluster.set_lb_policy(Cluster::LEAST_REQUEST);
+  cluster.mutable_least_request_lb_config()->mutable_choice_count()->set_value(
+      3);
+  balancer_->ads_service()->SetCdsResource(cluster);
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends()}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForAllBackends(DEBUG_LOCATION);
+  auto response_state = balancer_->ads_service()->cds_response_state();
+  ASSERT_TRUE(response_state.has_value());
+  EXPECT_EQ(response_state->state, AdsServiceImpl::ResponseState::ACKED);
+}
+
+// Tests that CDS client should send a NACK if the least request choice count
+// cannot compare backends.
+TEST_P(CdsTest, LeastRequestChoiceCountTooSmall) {
+  ScopedExperimentalEnvVar env_var(
+      "GRPC_XDS_EXPERIMENTAL_ENABLE_LEAST_REQUEST_LB");
+  auto cluster = default_cluster_;
+  cluster.set_lb_policy(Cluster::LEAST_REQUEST);
+  cluster.mutable_least_request_lb_config()->mutable_choice_count()->set_value(
+      1);
+  balancer_->ads_service()->SetCdsResource(cluster);
+  const auto response_state = WaitForCdsNack(DEBUG_LOCATION);
+  ASSERT_TRUE(response_state.has_value()) << "timed out waiting for NACK";
+  EXPECT_THAT(response_state->error_message,
+              ::testing::HasSubstr("choice_count must be at least 2."));
+}
+
 // Tests that CDS client should send a NACK if the lrs_server in CDS response
 // is other than SELF.
 TEST_P(CdsTest, WrongLrsServer) {
@@ -535,6 +570,67 @@ TEST_P(EdsTest, IgnoresDuplicateUpdates) {
   }
 }
 
+// Tests that with GRPC_ARG_XDS_UPDATE_COALESCING_WINDOW_MS, EDS updates
+// that arrive within the window of the previous one are applied together
+// when it ends: only the last one ever reaches the child policy.
+TEST_P(EdsTest, CoalescesUpdatesWithinWindow) {
+  const int kWindowMs = 2000 * grpc_test_slowdown_factor();
+  ChannelArguments channel_args;
+  channel_args.SetInt(GRPC_ARG_XDS_UPDATE_COALESCING_WINDOW_MS, kWindowMs);
+  ResetStub(/*failover_timeout_ms=*/0, &channel_args);
+  CreateAndStartBackends(4);
+  // Sets the EDS resource to point to backend idx, and waits for the
+  // client to ACK it.
+  auto set_eds_and_wait_for_ack = [&](size_t idx) {
+    while (balancer_->ads_service()->eds_response_state().has_value()) {
+    }
+    EdsResourceArgs args(
+        {{"locality0", CreateEndpointsForBackends(idx, idx + 1)}});
+    balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+    const gpr_timespec deadline =
+        grpc_timeout_milliseconds_to_deadline(kWindowMs / 4);
+    while (true) {
+      auto response_state = balancer_->ads_service()->eds_response_state();
+      if (response_state.has_value()) {
+        EXPECT_EQ(response_state->state,
+                  AdsServiceImpl::ResponseState::ACKED);
+        break;
+      }
+      ASSERT_LT(gpr_time_cmp(gpr_now(GPR_CLOCK_MONOTONIC), deadline), 0);
+      gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+    }
+  };
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data before;
+  grpc_stats_collect(&before);
+#endif
+  // The first update creates the child policy, and is applied right away.
+  // The channel connects to the xDS server on the first RPC.
+  EdsResourceArgs args({{"locality0", CreateEndpointsForBackends(0, 1)}});
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  // Picker changes are held by the window as well.
+  WaitForBackend(DEBUG_LOCATION, 0,
+                 WaitForBackendOptions().set_allow_failures(true));
+  // The next update is applied right away too, and opens the window. The
+  // two that follow it within the window are folded into one.
+  set_eds_and_wait_for_ack(1);
+  set_eds_and_wait_for_ack(2);
+  set_eds_and_wait_for_ack(3);
+  WaitForBackend(DEBUG_LOCATION, 3,
+                 WaitForBackendOptions()
+                     .set_reset_counters(false)
+                     .set_allow_failures(true)
+                     .set_timeout_ms(5000 + 2 * kWindowMs));
+  EXPECT_EQ(0U, backends_[2]->backend_service()->request_count());
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data after;
+  grpc_stats_data diff;
+  grpc_stats_collect(&after);
+  grpc_stats_diff(&after, &before, &diff);
+  EXPECT_GE(diff.counters[GRPC_STATS_COUNTER_XDS_COALESCED_UPDATES], 1);
+#endif
+}
+
 // Tests that EDS client should send a NACK if the EDS update contains
 // sparse priorities.
 TEST_P(EdsTest, NacksSparsePriorityList) {
@@ -1087,6 +1183,37 @@ TEST_P(FailoverTest, SwitchBackToHigherPriority) {
   EXPECT_EQ(kNumRpcs, backends_[0]->backend_service()->request_count());
 }
 
+// A pre-warmed lower priority gets no RPCs until the current priority
+// fails, and then takes over.
+TEST_P(FailoverTest, PrewarmedPriorityUsedOnlyOnFailover) {
+  ChannelArguments channel_args;
+  channel_args.SetInt(GRPC_ARG_PRIORITY_PREWARM_CHILDREN, 1);
+  ResetStub(/*failover_timeout_ms=*/500, &channel_args);
+  CreateAndStartBackends(3);
+  const size_t kNumRpcs = 100;
+  EdsResourceArgs args({
+      {"locality0", CreateEndpointsForBackends(0, 1), kDefaultLocalityWeight,
+       0},
+      {"locality1", CreateEndpointsForBackends(1, 2), kDefaultLocalityWeight,
+       1},
+      {"locality2", CreateEndpointsForBackends(2, 3), kDefaultLocalityWeight,
+       2},
+  });
+  balancer_->ads_service()->SetEdsResource(BuildEdsResource(args));
+  WaitForBackend(DEBUG_LOCATION, 0);
+  CheckRpcSendOk(DEBUG_LOCATION, kNumRpcs);
+  EXPECT_EQ(kNumRpcs, backends_[0]->backend_service()->request_count());
+  EXPECT_EQ(0U, backends_[1]->backend_service()->request_count());
+  EXPECT_EQ(0U, backends_[2]->backend_service()->request_count());
+  ShutdownBackend(0);
+  WaitForBackend(
+      DEBUG_LOCATION, 1,
+      WaitForBackendOptions().set_reset_counters(false).set_allow_failures(
+          true));
+  CheckRpcSendOk(DEBUG_LOCATION, kNumRpcs);
+  EXPECT_EQ(0U, backends_[2]->backend_service()->request_count());
+}
+
 // The first update only contains unavailable priorities. The second update
 // contains available priorities.
 TEST_P(FailoverTest, UpdateInitialUnavailable) {
@@ -3069,6 +3069,60 @@ TEST_P(XdsRbacTestWithRouteOverrideAlwaysPresent,
   SendRpc([this]() { return CreateInsecureChannel(); }, {}, {});
 }
 
+// Test that an RBACPerRoute override applies to the calls matching its own
+// route only.
+TEST_P(XdsRbacTestWithRouteOverrideAlwaysPresent, PerRouteOverrideOnOneRoute) {
+  HttpConnectionManager http_connection_manager;
+  Listener listener = default_server_listener_;
+  auto* filter = http_connection_manager.add_http_filters();
+  filter->set_name("rbac");
+  // Create a top-level RBAC policy with a DENY action for all RPCs
+  RBAC rbac;
+  auto* rules = rbac.mutable_rules();
+  rules->set_action(RBAC_Action_DENY);
+  Policy policy;
+  policy.add_permissions()->set_any(true);
+  policy.add_principals()->set_any(true);
+  (*rules->mutable_policies())["policy"] = policy;
+  filter->mutable_typed_config()->PackFrom(rbac);
+  filter = http_connection_manager.add_http_filters();
+  filter->set_name("router");
+  filter->mutable_typed_config()->PackFrom(
+      envoy::extensions::filters::http::router::v3::Router());
+  ServerHcmAccessor().Pack(http_connection_manager, &listener);
+  // A route with an Empty RBACPerRoute override, which allows RPCs,
+  // followed by the default route.
+  auto route_config_with_override = [this](absl::string_view prefix) {
+    RouteConfiguration route_config = default_server_route_config_;
+    auto* virtual_host = route_config.mutable_virtual_hosts(0);
+    *virtual_host->add_routes() = virtual_host->routes(0);
+    auto* route = virtual_host->mutable_routes(0);
+    route->mutable_match()->set_prefix(std::string(prefix));
+    google::protobuf::Any filter_config;
+    filter_config.PackFrom(RBACPerRoute());
+    (*route->mutable_typed_per_filter_config())["rbac"] =
+        std::move(filter_config);
+    return route_config;
+  };
+  SetServerListenerNameAndRouteConfiguration(
+      balancer_.get(), listener, backends_[0]->port(),
+      route_config_with_override("/grpc.testing.EchoTestService/"));
+  backends_[0]->Start();
+  backends_[0]->notifier()->WaitOnServingStatusChange(
+      absl::StrCat(ipv6_only_ ? "[::1]:" : "127.0.0.1:", backends_[0]->port()),
+      grpc::StatusCode::OK);
+  // Echo matches the overridden route.
+  for (int i = 0; i < 3; ++i) {
+    SendRpc([this]() { return CreateInsecureChannel(); }, {}, {});
+  }
+  // Echo now matches the default route, which keeps the top-level policy.
+  SetServerListenerNameAndRouteConfiguration(
+      balancer_.get(), listener, backends_[0]->port(),
+      route_config_with_override("/grpc.testing.EchoTest1Service/"));
+  SendRpc([this]() { return CreateInsecureChannel(); }, {}, {},
+          /*test_expects_failure=*/true, grpc::StatusCode::PERMISSION_DENIED);
+}
+
 // Adds Action Permutations to XdsRbacTest
 using XdsRbacTestWithActionPermutations = XdsRbacTest;
 
@@ -16,10 +16,17 @@
  *
  */
 
-/* This benchmark exists to ensure that immediately-firing alarms are fast */
+/* This benchmark exists to ensure that immediately-firing alarms are fast,
+   and that alarms used as per-request timeouts, which are set and
+   cancelled long before they expire, are cheap to churn through */
+
+#include <memory>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
+#include "absl/memory/memory.h"
+
 #include <grpc/grpc.h>
 #include <grpcpp/alarm.h>
 #include <grpcpp/completion_queue.h>
@@ -47,6 +54,62 @@ static void BM_Alarm_Tag_Immediate(benchmark::State& state) {
 }
 BENCHMARK(BM_Alarm_Tag_Immediate);
 
+// A new alarm per request, set to a timeout that the request beats.
+static void BM_Alarm_Tag_SetCancel(benchmark::State& state) {
+  TrackCounters track_counters;
+  CompletionQueue cq;
+  void* output_tag;
+  bool ok;
+  for (auto _ : state) {
+    Alarm alarm;
+    alarm.Set(&cq, grpc_timeout_seconds_to_deadline(30), nullptr);
+    alarm.Cancel();
+    cq.Next(&output_tag, &ok);
+    GPR_ASSERT(!ok);
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Alarm_Tag_SetCancel);
+
+// Many outstanding timeouts, each replaced by a new alarm as its request
+// completes. Args: number of outstanding alarms.
+static void BM_Alarm_Tag_Churn(benchmark::State& state) {
+  TrackCounters track_counters;
+  CompletionQueue cq;
+  std::vector<std::unique_ptr<Alarm>> alarms(state.range(0));
+  for (auto& alarm : alarms) {
+    alarm = absl::make_unique<Alarm>();
+    alarm->Set(&cq, grpc_timeout_seconds_to_deadline(30), nullptr);
+  }
+  void* output_tag;
+  bool ok;
+  size_t next = 0;
+  for (auto _ : state) {
+    alarms[next]->Cancel();
+    cq.Next(&output_tag, &ok);
+    alarms[next] = absl::make_unique<Alarm>();
+    alarms[next]->Set(&cq, grpc_timeout_seconds_to_deadline(30), nullptr);
+    next = (next + 1) % alarms.size();
+  }
+  for (auto& alarm : alarms) {
+    alarm->Cancel();
+    cq.Next(&output_tag, &ok);
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Alarm_Tag_Churn)->Arg(1000)->Arg(100000);
+
+// Alarms created for requests that finish without needing them.
+static void BM_Alarm_CreateDestroy(benchmark::State& state) {
+  TrackCounters track_counters;
+  for (auto _ : state) {
+    Alarm alarm;
+    benchmark::DoNotOptimize(&alarm);
+  }
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_Alarm_CreateDestroy);
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -39,6 +39,14 @@ static void BM_Arena_NoOp(benchmark::State& state) {
 }
 BENCHMARK(BM_Arena_NoOp)->Range(1, 1024 * 1024);
 
+// Same as BM_Arena_NoOp, with every arena buffer coming from malloc.
+static void BM_Arena_NoOp_Unpooled(benchmark::State& state) {
+  Arena::TestOnlySetBlockPoolEnabled(false);
+  BM_Arena_NoOp(state);
+  Arena::TestOnlySetBlockPoolEnabled(true);
+}
+BENCHMARK(BM_Arena_NoOp_Unpooled)->Range(1, 1024 * 1024);
+
 static void BM_Arena_ManyAlloc(benchmark::State& state) {
   Arena* a = Arena::Create(state.range(0), g_memory_allocator);
   const size_t realloc_after =
@@ -66,6 +74,14 @@ static void BM_Arena_Batch(benchmark::State& state) {
 }
 BENCHMARK(BM_Arena_Batch)->Ranges({{1, 64 * 1024}, {1, 64}, {1, 1024}});
 
+static void BM_Arena_Batch_Unpooled(benchmark::State& state) {
+  Arena::TestOnlySetBlockPoolEnabled(false);
+  BM_Arena_Batch(state);
+  Arena::TestOnlySetBlockPoolEnabled(true);
+}
+BENCHMARK(BM_Arena_Batch_Unpooled)
+    ->Ranges({{1, 64 * 1024}, {1, 64}, {1, 1024}});
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -22,6 +22,8 @@
 
 #include <benchmark/benchmark.h>
 
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
 #include <grpcpp/impl/grpc_library.h>
 #include <grpcpp/support/byte_buffer.h>
 
@@ -115,6 +117,87 @@ static void BM_ByteBufferReader_Peek(benchmark::State& state) {
 }
 BENCHMARK(BM_ByteBufferReader_Peek)->Ranges({{64 * 1024, 1024 * 1024}});
 
+// Returns a refcounted slice of slice_size bytes, as framing and encoders
+// produce them.
+static grpc_slice MakeSmallSlice(size_t slice_size) {
+  grpc_slice slice = grpc_slice_malloc_large(slice_size);
+  memset(GRPC_SLICE_START_PTR(slice), 'a', slice_size);
+  return slice;
+}
+
+// Builds a buffer out of 256 small slices, then releases it, as a transport
+// does with the frames of a write. Args: slice size.
+static void BM_SliceBuffer_AddSmallSlices(benchmark::State& state) {
+  constexpr int kNumSlices = 256;
+  const size_t slice_size = state.range(0);
+  grpc_slice_buffer buffer;
+  grpc_slice_buffer_init(&buffer);
+  for (auto _ : state) {
+    for (int i = 0; i < kNumSlices; ++i) {
+      grpc_slice_buffer_add(&buffer, MakeSmallSlice(slice_size));
+    }
+    benchmark::DoNotOptimize(buffer.count);
+    grpc_slice_buffer_reset_and_unref(&buffer);
+  }
+  grpc_slice_buffer_destroy(&buffer);
+  state.SetItemsProcessed(state.iterations() * kNumSlices);
+  state.SetBytesProcessed(state.iterations() * kNumSlices * slice_size);
+}
+BENCHMARK(BM_SliceBuffer_AddSmallSlices)->Arg(32)->Arg(64)->Arg(128)->Arg(512);
+
+// Streams small slices through a buffer: the producer adds one at a time
+// and the consumer reads 4 KiB whenever there is that much. Args: slice
+// size.
+static void BM_SliceBuffer_StreamSmallSlices(benchmark::State& state) {
+  constexpr size_t kReadSize = 4096;
+  const size_t slice_size = state.range(0);
+  grpc_slice_buffer buffer;
+  grpc_slice_buffer_init(&buffer);
+  std::unique_ptr<char[]> read_buffer(new char[kReadSize]);
+  for (auto _ : state) {
+    grpc_slice_buffer_add(&buffer, MakeSmallSlice(slice_size));
+    if (buffer.length >= kReadSize) {
+      grpc_slice_buffer_move_first_into_buffer(&buffer, kReadSize,
+                                               read_buffer.get());
+    }
+  }
+  grpc_slice_buffer_destroy(&buffer);
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * slice_size);
+}
+BENCHMARK(BM_SliceBuffer_StreamSmallSlices)
+    ->Arg(32)
+    ->Arg(64)
+    ->Arg(128)
+    ->Arg(512);
+
+// Hands small slices from one buffer to another, a message at a time, as
+// the transport does from the stream's flow controlled buffer to its
+// outgoing buffer. Args: slice size.
+static void BM_SliceBuffer_MoveSmallSlices(benchmark::State& state) {
+  constexpr int kSlicesPerMessage = 16;
+  const size_t slice_size = state.range(0);
+  grpc_slice_buffer message;
+  grpc_slice_buffer outgoing;
+  grpc_slice_buffer_init(&message);
+  grpc_slice_buffer_init(&outgoing);
+  for (auto _ : state) {
+    for (int i = 0; i < kSlicesPerMessage; ++i) {
+      grpc_slice_buffer_add(&message, MakeSmallSlice(slice_size));
+    }
+    grpc_slice_buffer_move_into(&message, &outgoing);
+    if (outgoing.length >= 64 * 1024) {
+      grpc_slice_buffer_reset_and_unref(&outgoing);
+    }
+  }
+  grpc_slice_buffer_destroy(&message);
+  grpc_slice_buffer_destroy(&outgoing);
+  state.SetItemsProcessed(state.iterations() * kSlicesPerMessage);
+  state.SetBytesProcessed(state.iterations() * kSlicesPerMessage *
+                          slice_size);
+}
+BENCHMARK(BM_SliceBuffer_MoveSmallSlices)->Arg(32)->Arg(128)->Arg(512);
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -44,6 +44,7 @@
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/profiling/timers.h"
+#include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/resource_quota/resource_quota.h"
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/transport/transport_impl.h"
@@ -769,6 +770,14 @@ static void BM_IsolatedCall_NoOp(benchmark::State& state) {
 }
 BENCHMARK(BM_IsolatedCall_NoOp);
 
+// Same as BM_IsolatedCall_NoOp, without recycling of call arenas.
+static void BM_IsolatedCall_NoOp_UnpooledArena(benchmark::State& state) {
+  grpc_core::Arena::TestOnlySetBlockPoolEnabled(false);
+  BM_IsolatedCall_NoOp(state);
+  grpc_core::Arena::TestOnlySetBlockPoolEnabled(true);
+}
+BENCHMARK(BM_IsolatedCall_NoOp_UnpooledArena);
+
 static void BM_IsolatedCall_Unary(benchmark::State& state) {
   IsolatedCallFixture fixture;
   gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
@@ -65,6 +65,14 @@ BENCHMARK_TEMPLATE(BM_CallbackBidiStreaming, MinInProcess, NoOpMutator,
                    NoOpMutator)
     ->Apply(StreamingPingPongMsgsNumberArgs);
 
+// Reactions run inline on the completing thread
+BENCHMARK_TEMPLATE(BM_CallbackBidiStreaming, InlineCallbacksInProcess,
+                   NoOpMutator, NoOpMutator)
+    ->Apply(StreamingPingPongMsgSizeArgs);
+BENCHMARK_TEMPLATE(BM_CallbackBidiStreaming, InlineCallbacksInProcess,
+                   NoOpMutator, NoOpMutator)
+    ->Apply(StreamingPingPongMsgsNumberArgs);
+
 // Client context with different metadata
 BENCHMARK_TEMPLATE(BM_CallbackBidiStreaming, InProcess,
                    Client_AddMetadata<RandomBinaryMetadata<10>, 1>, NoOpMutator)
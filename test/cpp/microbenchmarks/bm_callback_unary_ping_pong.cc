@@ -48,6 +48,19 @@ BENCHMARK_TEMPLATE(BM_CallbackUnaryPingPong, MinInProcess, NoOpMutator,
                    NoOpMutator)
     ->Apply(SweepSizesArgs);
 
+// Reactions run inline on the completing thread
+BENCHMARK_TEMPLATE(BM_CallbackUnaryPingPong, InlineCallbacksInProcess,
+                   NoOpMutator, NoOpMutator)
+    ->Apply(SweepSizesArgs);
+
+// Client context reset between calls rather than constructed for each
+BENCHMARK_TEMPLATE(BM_CallbackUnaryPingPongResetContext, InProcess)
+    ->Args({0, 0})
+    ->Args({1, 1});
+BENCHMARK_TEMPLATE(BM_CallbackUnaryPingPongResetContext, MinInProcess)
+    ->Args({0, 0})
+    ->Args({1, 1});
+
 // Client context with different metadata
 BENCHMARK_TEMPLATE(BM_CallbackUnaryPingPong, InProcess,
                    Client_AddMetadata<RandomBinaryMetadata<10>, 1>, NoOpMutator)
@@ -23,6 +23,11 @@
 #include <grpc/grpc.h>
 #include <grpc/grpc_security.h>
 
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channel_stack_builder_impl.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/surface/channel_init.h"
 #include "test/core/util/test_config.h"
 #include "test/cpp/microbenchmarks/helpers.h"
 #include "test/cpp/util/test_config.h"
@@ -80,6 +85,30 @@ BENCHMARK_TEMPLATE(BM_InsecureChannelCreateDestroy, LameChannelFixture)
     ->Range(0, 512);
 ;
 
+// Runs the subchannel stages of ChannelInit, as each new connection does,
+// with and without the cache of their filter lists.
+template <bool kCached>
+static void BM_SubchannelStackCreate(benchmark::State& state) {
+  grpc_core::ExecCtx exec_ctx;
+  const grpc_core::ChannelArgs args =
+      grpc_core::ChannelArgs()
+          .Set(GRPC_ARG_DEFAULT_AUTHORITY, "localhost:1234")
+          .Set(GRPC_ARG_PRIMARY_USER_AGENT_STRING, "bm_channel")
+          .Set(GRPC_ARG_KEEPALIVE_TIME_MS, 30000);
+  const grpc_core::ChannelInit& channel_init =
+      grpc_core::CoreConfiguration::Get().channel_init();
+  for (auto _ : state) {
+    grpc_core::ChannelStackBuilderImpl builder("subchannel",
+                                               GRPC_CLIENT_SUBCHANNEL);
+    builder.SetChannelArgs(args);
+    bool ok = kCached ? channel_init.CreateStackCached(&builder, "chttp2")
+                      : channel_init.CreateStack(&builder);
+    benchmark::DoNotOptimize(ok);
+  }
+}
+BENCHMARK_TEMPLATE(BM_SubchannelStackCreate, false);
+BENCHMARK_TEMPLATE(BM_SubchannelStackCreate, true);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
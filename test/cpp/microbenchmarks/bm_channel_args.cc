@@ -0,0 +1,185 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark ChannelArgs with as many args as a channel carries: setting,
+   looking up and comparing args, and converting from grpc_channel_args.
+   The same operations on an AVL, which used to back ChannelArgs, are the
+   baseline. Allocations per operation are reported as a counter. */
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/avl/avl.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+static std::atomic<int64_t> g_allocs{0};
+
+void* operator new(std::size_t size) {
+  g_allocs.fetch_add(1, std::memory_order_relaxed);
+  void* p = malloc(size == 0 ? 1 : size);
+  if (p == nullptr) throw std::bad_alloc();
+  return p;
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, std::size_t) noexcept { free(p); }
+
+namespace grpc_core {
+namespace {
+
+using Avl = AVL<std::string, ChannelArgs::Value>;
+
+std::string Key(int i) { return absl::StrCat("grpc.test.arg_", i); }
+
+// Counts the allocations made while the object is alive.
+class AllocCounter {
+ public:
+  explicit AllocCounter(benchmark::State& state)
+      : state_(state), start_(g_allocs.load(std::memory_order_relaxed)) {}
+  ~AllocCounter() {
+    state_.counters["allocs_per_op"] = benchmark::Counter(
+        static_cast<double>(g_allocs.load(std::memory_order_relaxed) -
+                            start_),
+        benchmark::Counter::kAvgIterations);
+  }
+
+ private:
+  benchmark::State& state_;
+  const int64_t start_;
+};
+
+// Half of the args are ints and half strings.
+ChannelArgs::Value MakeValue(int i) {
+  if (i % 2 == 0) return i;
+  return absl::StrCat("value_", i);
+}
+
+ChannelArgs MakeChannelArgs(int num_args) {
+  ChannelArgs args;
+  for (int i = 0; i < num_args; ++i) args = args.Set(Key(i), MakeValue(i));
+  return args;
+}
+
+Avl MakeAvl(int num_args) {
+  Avl avl;
+  for (int i = 0; i < num_args; ++i) avl = avl.Add(Key(i), MakeValue(i));
+  return avl;
+}
+
+// Args: number of args already set. Each iteration adds one arg.
+void BM_ChannelArgsSet(benchmark::State& state) {
+  const ChannelArgs args = MakeChannelArgs(state.range(0));
+  const std::string key = Key(state.range(0) / 2) + "_new";
+  AllocCounter allocs(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(args.Set(key, 42));
+  }
+}
+BENCHMARK(BM_ChannelArgsSet)->ArgName("args")->Arg(10)->Arg(40)->Arg(60);
+
+void BM_AvlSet(benchmark::State& state) {
+  const Avl avl = MakeAvl(state.range(0));
+  const std::string key = Key(state.range(0) / 2) + "_new";
+  AllocCounter allocs(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(avl.Add(key, 42));
+  }
+}
+BENCHMARK(BM_AvlSet)->ArgName("args")->Arg(10)->Arg(40)->Arg(60);
+
+// Args: number of args set. Each iteration looks up every arg.
+void BM_ChannelArgsGet(benchmark::State& state) {
+  const int num_args = state.range(0);
+  const ChannelArgs args = MakeChannelArgs(num_args);
+  std::vector<std::string> keys;
+  for (int i = 0; i < num_args; ++i) keys.push_back(Key(i));
+  for (auto _ : state) {
+    for (const std::string& key : keys) {
+      benchmark::DoNotOptimize(args.Get(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_args);
+}
+BENCHMARK(BM_ChannelArgsGet)->ArgName("args")->Arg(10)->Arg(40)->Arg(60);
+
+void BM_AvlGet(benchmark::State& state) {
+  const int num_args = state.range(0);
+  const Avl avl = MakeAvl(num_args);
+  std::vector<std::string> keys;
+  for (int i = 0; i < num_args; ++i) keys.push_back(Key(i));
+  for (auto _ : state) {
+    for (const std::string& key : keys) {
+      benchmark::DoNotOptimize(avl.Lookup(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_args);
+}
+BENCHMARK(BM_AvlGet)->ArgName("args")->Arg(10)->Arg(40)->Arg(60);
+
+// Comparing args built separately, as the subchannel pool and channel
+// stack caches do, so no entries are shared.
+void BM_ChannelArgsCompare(benchmark::State& state) {
+  const ChannelArgs a = MakeChannelArgs(state.range(0));
+  const ChannelArgs b = MakeChannelArgs(state.range(0));
+  for (auto _ : state) {
+    GPR_ASSERT(a == b);
+    benchmark::DoNotOptimize(a < b);
+  }
+}
+BENCHMARK(BM_ChannelArgsCompare)->ArgName("args")->Arg(10)->Arg(40)->Arg(60);
+
+void BM_ChannelArgsFromC(benchmark::State& state) {
+  const ChannelArgs args = MakeChannelArgs(state.range(0));
+  const grpc_channel_args* c_args = args.ToC();
+  AllocCounter allocs(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ChannelArgs::FromC(c_args));
+  }
+  grpc_channel_args_destroy(c_args);
+}
+BENCHMARK(BM_ChannelArgsFromC)->ArgName("args")->Arg(10)->Arg(40)->Arg(60);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
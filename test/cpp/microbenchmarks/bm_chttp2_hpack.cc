@@ -22,13 +22,19 @@
 
 #include <memory>
 #include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
+#include "absl/strings/string_view.h"
+
 #include <grpc/slice.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 #include "src/core/lib/gprpp/time.h"
@@ -625,6 +631,90 @@ using RepresentativeServerTrailingMetadata = FromEncoderFixture<
 using MoreRepresentativeClientInitialMetadata = FromEncoderFixture<
     hpack_encoder_fixtures::MoreRepresentativeClientInitialMetadata>;
 
+// Headers as sent by peers that huffman compress every string literal, which
+// gRPC's own encoder only does for binary metadata.
+static std::vector<uint8_t> HuffmanLiterals(
+    const std::vector<std::pair<const char*, std::string>>& headers) {
+  std::vector<uint8_t> out;
+  auto append_string = [&out](absl::string_view s) {
+    grpc_slice input = grpc_slice_from_copied_buffer(s.data(), s.size());
+    grpc_slice compressed = grpc_chttp2_huffman_compress(input);
+    grpc_slice_unref(input);
+    // Length, with the huffman bit and a 7 bit prefix.
+    size_t length = GRPC_SLICE_LENGTH(compressed);
+    if (length < 0x7f) {
+      out.push_back(0x80 | length);
+    } else {
+      out.push_back(0xff);
+      for (length -= 0x7f; length >= 0x80; length >>= 7) {
+        out.push_back(0x80 | (length & 0x7f));
+      }
+      out.push_back(length);
+    }
+    out.insert(out.end(), GRPC_SLICE_START_PTR(compressed),
+               GRPC_SLICE_END_PTR(compressed));
+    grpc_slice_unref(compressed);
+  };
+  for (const auto& header : headers) {
+    // Literal header field without indexing, new name.
+    out.push_back(0x00);
+    append_string(header.first);
+    append_string(header.second);
+  }
+  return out;
+}
+
+// An OAuth bearer token: a JWT with a large payload, as issued by most
+// identity providers.
+class HuffmanAuthorization {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    std::string token =
+        "Bearer eyJhbGciOiJSUzI1NiIsImtpZCI6IjE2NzBkNzA0ZDQ5MGM3YzNhZjQxMjM"
+        "0NjQ3ZWM2NWY3NTQxNGI1NTIiLCJ0eXAiOiJKV1QifQ.";
+    // The payload and the signature are base64url: no dictionary words, so
+    // a pseudo-random sequence is representative.
+    static constexpr char kBase64Url[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    uint32_t x = 12345;
+    for (int i = 0; i < 1100; i++) {
+      x = x * 1103515245 + 12345;
+      token.push_back(kBase64Url[(x >> 16) % 64]);
+      if (i == 750) token.push_back('.');
+    }
+    return {MakeSlice(HuffmanLiterals({{"authorization", token}}))};
+  }
+};
+
+// The custom metadata added by tracing, proxies and the application.
+class HuffmanCustomMetadata {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    return {MakeSlice(HuffmanLiterals({
+        {"user-agent",
+         "grpc-java-netty/1.46.0 my-service-client/2.13.4 (linux; amd64)"},
+        {"x-request-id", "7f3c1e9a-2b4d-4c8e-9f61-0a5d3e7b2c14"},
+        {"x-b3-traceid", "80f198ee56343ba864fe8b2a57d3eff7"},
+        {"x-b3-spanid", "e457b5a2e4d86bd1"},
+        {"x-b3-parentspanid", "05e3ac9a4f6e3b90"},
+        {"x-b3-sampled", "1"},
+        {"traceparent",
+         "00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01"},
+        {"x-forwarded-for", "203.0.113.195, 70.41.3.18, 150.172.238.178"},
+        {"x-forwarded-proto", "https"},
+        {"x-envoy-expected-rq-timeout-ms", "15000"},
+        {"x-client-version", "2.13.4"},
+        {"x-tenant-id", "acme-corp-production-eu-west-1"},
+        {"x-session-id", "s%3Aj9Gq2wK8xN4vB7mT1pL6zR3cY5hF0dA.eXk"},
+        {"accept-language", "en-US,en;q=0.9,fr;q=0.8"},
+        {"x-feature-flags", "checkout_v2,new_search_ranking,dark_mode"},
+        {"x-idempotency-key", "b6c0d4a8-91f2-4e37-8a5c-d2f1e6b09374"},
+    }))};
+  }
+};
+
 // Send the same deadline repeatedly
 class SameDeadline {
  public:
@@ -672,6 +762,8 @@ BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
                    RepresentativeServerInitialMetadata);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, SameDeadline);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, HuffmanAuthorization);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, HuffmanCustomMetadata);
 
 }  // namespace hpack_parser_fixtures
 
@@ -0,0 +1,132 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the chttp2 stream id -> stream map as the stream count grows */
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/ext/transport/chttp2/transport/stream_map.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+// Client initiated stream ids: odd and increasing.
+static uint32_t StreamId(size_t i) { return static_cast<uint32_t>(2 * i + 1); }
+
+static void* StreamFor(uint32_t id) {
+  return reinterpret_cast<void*>(static_cast<uintptr_t>(id));
+}
+
+// Per frame lookup: every incoming frame resolves its stream id. Frames are
+// spread over all open streams in a scrambled order, as with many concurrent
+// server streams.
+static void BM_StreamMapFind(benchmark::State& state) {
+  const size_t num_streams = state.range(0);
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (size_t i = 0; i < num_streams; i++) {
+    grpc_chttp2_stream_map_add(&map, StreamId(i), StreamFor(StreamId(i)));
+  }
+  std::vector<uint32_t> frames(4096);
+  uint32_t x = 12345;
+  for (uint32_t& id : frames) {
+    x = x * 1103515245 + 12345;
+    id = StreamId((x >> 8) % num_streams);
+  }
+  size_t next = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        grpc_chttp2_stream_map_find(&map, frames[next++ & 4095]));
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StreamMapFind)->Range(1, 64 * 1024);
+
+// Lookup of ids that are not (or no longer) in the map, eg. frames racing
+// with a stream being closed.
+static void BM_StreamMapFindMissing(benchmark::State& state) {
+  const size_t num_streams = state.range(0);
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (size_t i = 0; i < num_streams; i++) {
+    grpc_chttp2_stream_map_add(&map, StreamId(i), StreamFor(StreamId(i)));
+  }
+  uint32_t id = 2;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(grpc_chttp2_stream_map_find(&map, id));
+    id = (id + 2) & 0xffff;
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StreamMapFindMissing)->Range(1, 64 * 1024);
+
+// Steady state churn with a fixed number of open streams: each iteration
+// opens a new stream, closes the oldest one and looks up a live stream.
+static void BM_StreamMapChurn(benchmark::State& state) {
+  const size_t num_streams = state.range(0);
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  size_t oldest = 0;
+  size_t next = 0;
+  for (; next < num_streams; next++) {
+    grpc_chttp2_stream_map_add(&map, StreamId(next), StreamFor(StreamId(next)));
+  }
+  for (auto _ : state) {
+    grpc_chttp2_stream_map_add(&map, StreamId(next), StreamFor(StreamId(next)));
+    next++;
+    benchmark::DoNotOptimize(
+        grpc_chttp2_stream_map_delete(&map, StreamId(oldest)));
+    oldest++;
+    benchmark::DoNotOptimize(grpc_chttp2_stream_map_find(
+        &map, StreamId(oldest + (next - oldest) / 2)));
+    // Stream ids are 31 bits; start over before running out.
+    if (next == (1u << 30) - 1) {
+      state.PauseTiming();
+      grpc_chttp2_stream_map_destroy(&map);
+      grpc_chttp2_stream_map_init(&map, 8);
+      for (oldest = next = 0; next < num_streams; next++) {
+        grpc_chttp2_stream_map_add(&map, StreamId(next),
+                                   StreamFor(StreamId(next)));
+      }
+      state.ResumeTiming();
+    }
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StreamMapChurn)->Range(1, 64 * 1024);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -19,6 +19,7 @@
 #include <string.h>
 
 #include <atomic>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -42,6 +43,7 @@ static gpr_mu g_mu;
 static gpr_cv g_cv;
 static int g_threads_active;
 static bool g_active;
+static int g_tags_per_work;
 
 namespace grpc {
 namespace testing {
@@ -69,7 +71,7 @@ static void cq_done_cb(void* /*done_arg*/, grpc_cq_completion* cq_completion) {
   gpr_free(cq_completion);
 }
 
-/* Queues a completion tag if deadline is > 0.
+/* Queues g_tags_per_work completion tags if deadline is > 0.
  * Does nothing if deadline is 0 (i.e gpr_time_0(GPR_CLOCK_MONOTONIC)) */
 static grpc_error_handle pollset_work(grpc_pollset* ps,
                                       grpc_pollset_worker** /*worker*/,
@@ -82,10 +84,12 @@ static grpc_error_handle pollset_work(grpc_pollset* ps,
   gpr_mu_unlock(&ps->mu);
 
   void* tag = reinterpret_cast<void*>(10);  // Some random number
-  GPR_ASSERT(grpc_cq_begin_op(g_cq, tag));
-  grpc_cq_end_op(
-      g_cq, tag, GRPC_ERROR_NONE, cq_done_cb, nullptr,
-      static_cast<grpc_cq_completion*>(gpr_malloc(sizeof(grpc_cq_completion))));
+  for (int i = 0; i < g_tags_per_work; i++) {
+    GPR_ASSERT(grpc_cq_begin_op(g_cq, tag));
+    grpc_cq_end_op(g_cq, tag, GRPC_ERROR_NONE, cq_done_cb, nullptr,
+                   static_cast<grpc_cq_completion*>(
+                       gpr_malloc(sizeof(grpc_cq_completion))));
+  }
   grpc_core::ExecCtx::Get()->Flush();
   gpr_mu_lock(&ps->mu);
   return GRPC_ERROR_NONE;
@@ -111,7 +115,9 @@ static const grpc_event_engine_vtable* init_engine_vtable(bool) {
   return &g_vtable;
 }
 
-static void setup() {
+static void setup(int tags_per_work) {
+  g_tags_per_work = tags_per_work;
+
   // This test should only ever be run with a non or any polling engine
   // Override the polling engine for the non-polling engine
   // and add a custom polling engine
@@ -161,14 +167,12 @@ static void teardown() {
  and its Finish call must take place before grpc_shutdown so that it can use
  grpc_stats).
 */
-static void BM_Cq_Throughput(benchmark::State& state) {
+static void start_thread(int thd_idx, int tags_per_work) {
   gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
-  auto thd_idx = state.thread_index();
-
   gpr_mu_lock(&g_mu);
   g_threads_active++;
   if (thd_idx == 0) {
-    setup();
+    setup(tags_per_work);
     g_active = true;
     gpr_cv_broadcast(&g_cv);
   } else {
@@ -177,19 +181,10 @@ static void BM_Cq_Throughput(benchmark::State& state) {
     }
   }
   gpr_mu_unlock(&g_mu);
+}
 
-  // Use a TrackCounters object to monitor the gRPC performance statistics
-  // (optionally including low-level counters) before and after the test
-  TrackCounters track_counters;
-
-  for (auto _ : state) {
-    GPR_ASSERT(grpc_completion_queue_next(g_cq, deadline, nullptr).type ==
-               GRPC_OP_COMPLETE);
-  }
-
-  state.SetItemsProcessed(state.iterations());
-  track_counters.Finish(state);
-
+static void finish_thread(int thd_idx) {
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
   gpr_mu_lock(&g_mu);
   g_threads_active--;
   if (g_threads_active == 0) {
@@ -207,8 +202,60 @@ static void BM_Cq_Throughput(benchmark::State& state) {
   }
 }
 
+static void BM_Cq_Throughput(benchmark::State& state) {
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  auto thd_idx = state.thread_index();
+  start_thread(thd_idx, 1);
+
+  // Use a TrackCounters object to monitor the gRPC performance statistics
+  // (optionally including low-level counters) before and after the test
+  TrackCounters track_counters;
+
+  for (auto _ : state) {
+    GPR_ASSERT(grpc_completion_queue_next(g_cq, deadline, nullptr).type ==
+               GRPC_OP_COMPLETE);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  track_counters.Finish(state);
+
+  finish_thread(thd_idx);
+}
+
 BENCHMARK(BM_Cq_Throughput)->ThreadRange(1, 16)->UseRealTime();
 
+/* Each poll queues a burst of 16 completions, which are drained either one at
+   a time (batch size 1, same as grpc_completion_queue_next) or up to
+   state.range(0) per grpc_completion_queue_next_batch call. */
+static void BM_Cq_BatchThroughput(benchmark::State& state) {
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  auto thd_idx = state.thread_index();
+  size_t max_events = state.range(0);
+  start_thread(thd_idx, 16);
+
+  TrackCounters track_counters;
+
+  std::vector<grpc_event> events(max_events);
+  int64_t items = 0;
+  for (auto _ : state) {
+    size_t n = grpc_completion_queue_next_batch(g_cq, events.data(),
+                                                max_events, deadline, nullptr);
+    GPR_ASSERT(n > 0 && events[0].type == GRPC_OP_COMPLETE);
+    items += n;
+  }
+
+  state.SetItemsProcessed(items);
+  track_counters.Finish(state);
+
+  finish_thread(thd_idx);
+}
+
+BENCHMARK(BM_Cq_BatchThroughput)
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 16}})
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
 }  // namespace testing
 }  // namespace grpc
 
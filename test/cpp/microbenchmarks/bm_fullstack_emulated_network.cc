@@ -0,0 +1,136 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark gRPC end2end over emulated network paths, to evaluate chttp2 flow
+   control and BDP estimation at realistic bandwidth-delay products. Results
+   are wall-clock: the time is spent waiting on the emulated network. */
+
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/fullstack_streaming_pump.h"
+#include "test/cpp/microbenchmarks/fullstack_unary_ping_pong.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+/*******************************************************************************
+ * NETWORK PROFILES
+ */
+
+// Same-zone datacenter: 10Gbps, 0.5ms RTT. BDP ~625KB.
+struct Datacenter {
+  static grpc_core::testing::NetworkProfile Get() {
+    grpc_core::testing::NetworkProfile profile;
+    profile.bandwidth_bytes_per_second = 1.25e9;
+    profile.rtt_seconds = 0.0005;
+    return profile;
+  }
+};
+
+// Cross-region: 1Gbps, 50ms RTT, 1ms jitter. BDP ~6MB.
+struct CrossRegion {
+  static grpc_core::testing::NetworkProfile Get() {
+    grpc_core::testing::NetworkProfile profile;
+    profile.bandwidth_bytes_per_second = 125e6;
+    profile.rtt_seconds = 0.05;
+    profile.jitter_seconds = 0.001;
+    return profile;
+  }
+};
+
+// Intercontinental: 1Gbps, 150ms RTT, 2ms jitter, 0.01% loss. BDP ~19MB.
+struct Intercontinental {
+  static grpc_core::testing::NetworkProfile Get() {
+    grpc_core::testing::NetworkProfile profile;
+    profile.bandwidth_bytes_per_second = 125e6;
+    profile.rtt_seconds = 0.15;
+    profile.jitter_seconds = 0.002;
+    profile.loss_probability = 1e-4;
+    return profile;
+  }
+};
+
+// Lossy WAN: 100Mbps, 80ms RTT, 5ms jitter, 0.1% loss and reordering.
+struct LossyWan {
+  static grpc_core::testing::NetworkProfile Get() {
+    grpc_core::testing::NetworkProfile profile;
+    profile.bandwidth_bytes_per_second = 12.5e6;
+    profile.rtt_seconds = 0.08;
+    profile.jitter_seconds = 0.005;
+    profile.loss_probability = 1e-3;
+    profile.reorder_probability = 1e-3;
+    return profile;
+  }
+};
+
+/*******************************************************************************
+ * CONFIGURATIONS
+ */
+
+// Args: message size.
+static void StreamingSizesArgs(benchmark::internal::Benchmark* b) {
+  b->Arg(16 * 1024)->Arg(1024 * 1024)->Arg(8 * 1024 * 1024)->UseRealTime();
+}
+
+// Args: request size, response size.
+static void UnarySizesArgs(benchmark::internal::Benchmark* b) {
+  b->Args({0, 0})->Args({0, 1024 * 1024})->UseRealTime();
+}
+
+BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, EmulatedNetwork<Datacenter>)
+    ->Apply(StreamingSizesArgs);
+BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, EmulatedNetwork<CrossRegion>)
+    ->Apply(StreamingSizesArgs);
+BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient,
+                   EmulatedNetwork<Intercontinental>)
+    ->Apply(StreamingSizesArgs);
+BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, EmulatedNetwork<LossyWan>)
+    ->Apply(StreamingSizesArgs);
+BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, EmulatedNetwork<CrossRegion>)
+    ->Apply(StreamingSizesArgs);
+
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, EmulatedNetwork<Datacenter>, NoOpMutator,
+                   NoOpMutator)
+    ->Apply(UnarySizesArgs);
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, EmulatedNetwork<CrossRegion>, NoOpMutator,
+                   NoOpMutator)
+    ->Apply(UnarySizesArgs);
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, EmulatedNetwork<Intercontinental>,
+                   NoOpMutator, NoOpMutator)
+    ->Apply(UnarySizesArgs);
+BENCHMARK_TEMPLATE(BM_UnaryPingPong, EmulatedNetwork<LossyWan>, NoOpMutator,
+                   NoOpMutator)
+    ->Apply(UnarySizesArgs);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark streaming throughput of the inproc transport as threads are
+   added: each thread pumps messages on its own stream, and all streams share
+   one in-process channel, so throughput should grow with cores. */
+
+#include <climits>
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+// Drains the requests of a stream, unless the first one sets
+// param.server_notify_client_when_started: then its message is written back
+// over and over until the client cancels.
+class PumpService : public EchoTestService::CallbackService {
+ public:
+  ServerBidiReactor<EchoRequest, EchoResponse>* BidiStream(
+      CallbackServerContext* /*context*/) override {
+    class Reactor : public ServerBidiReactor<EchoRequest, EchoResponse> {
+     public:
+      Reactor() { StartRead(&request_); }
+
+      void OnReadDone(bool ok) override {
+        if (!ok) {
+          Finish(Status::OK);
+        } else if (request_.param().server_notify_client_when_started()) {
+          response_.set_message(request_.message());
+          StartWrite(&response_);
+        } else {
+          StartRead(&request_);
+        }
+      }
+
+      void OnWriteDone(bool ok) override {
+        if (ok) {
+          StartWrite(&response_);
+        } else {
+          Finish(Status::OK);
+        }
+      }
+
+      void OnDone() override { delete this; }
+
+     private:
+      EchoRequest request_;
+      EchoResponse response_;
+    };
+    return new Reactor();
+  }
+};
+
+// One server and in-process channel for all threads and runs of a
+// benchmark, so that the threads share a transport.
+class SharedInProcessServer {
+ public:
+  static std::shared_ptr<Channel> GetChannel() {
+    static SharedInProcessServer* server = new SharedInProcessServer();
+    return server->channel_;
+  }
+
+ private:
+  SharedInProcessServer() {
+    ServerBuilder builder;
+    builder.RegisterService(&service_);
+    builder.SetMaxReceiveMessageSize(INT_MAX);
+    builder.SetMaxSendMessageSize(INT_MAX);
+    server_ = builder.BuildAndStart();
+    ChannelArguments args;
+    args.SetMaxReceiveMessageSize(INT_MAX);
+    args.SetMaxSendMessageSize(INT_MAX);
+    channel_ = server_->InProcessChannel(args);
+  }
+
+  PumpService service_;
+  std::unique_ptr<Server> server_;
+  std::shared_ptr<Channel> channel_;
+};
+
+static void BM_InProcessPumpStreamClientToServer(benchmark::State& state) {
+  std::unique_ptr<EchoTestService::Stub> stub(
+      EchoTestService::NewStub(SharedInProcessServer::GetChannel()));
+  EchoRequest request;
+  if (state.range(0) > 0) {
+    request.set_message(std::string(state.range(0), 'a'));
+  }
+  ClientContext context;
+  auto stream = stub->BidiStream(&context);
+  for (auto _ : state) {
+    GPR_ASSERT(stream->Write(request));
+  }
+  stream->WritesDone();
+  GPR_ASSERT(stream->Finish().ok());
+  state.SetBytesProcessed(state.range(0) * state.iterations());
+}
+BENCHMARK(BM_InProcessPumpStreamClientToServer)
+    ->Arg(0)
+    ->Arg(16 * 1024)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+
+static void BM_InProcessPumpStreamServerToClient(benchmark::State& state) {
+  std::unique_ptr<EchoTestService::Stub> stub(
+      EchoTestService::NewStub(SharedInProcessServer::GetChannel()));
+  EchoRequest request;
+  request.mutable_param()->set_server_notify_client_when_started(true);
+  if (state.range(0) > 0) {
+    request.set_message(std::string(state.range(0), 'a'));
+  }
+  ClientContext context;
+  auto stream = stub->BidiStream(&context);
+  GPR_ASSERT(stream->Write(request));
+  EchoResponse response;
+  for (auto _ : state) {
+    GPR_ASSERT(stream->Read(&response));
+  }
+  context.TryCancel();
+  while (stream->Read(&response)) {
+  }
+  stream->Finish();
+  state.SetBytesProcessed(state.range(0) * state.iterations());
+}
+BENCHMARK(BM_InProcessPumpStreamServerToClient)
+    ->Arg(0)
+    ->Arg(16 * 1024)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,192 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the default health check service: unary Check calls, and the
+   fan-out of serving status changes to Watch streams. */
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/support/log.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/health_check_service_interface.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/client_callback.h>
+
+#include "src/proto/grpc/health/v1/health.grpc.pb.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+using grpc::health::v1::Health;
+using grpc::health::v1::HealthCheckRequest;
+using grpc::health::v1::HealthCheckResponse;
+
+const char kServiceName[] = "benchmark.Service";
+
+class HealthCheckServer {
+ public:
+  HealthCheckServer() {
+    EnableDefaultHealthCheckService(true);
+    ServerBuilder builder;
+    server_ = builder.BuildAndStart();
+    stub_ = Health::NewStub(server_->InProcessChannel(ChannelArguments()));
+    server_->GetHealthCheckService()->SetServingStatus(kServiceName, true);
+  }
+
+  ~HealthCheckServer() { server_->Shutdown(); }
+
+  Health::Stub* stub() { return stub_.get(); }
+  HealthCheckServiceInterface* service() {
+    return server_->GetHealthCheckService();
+  }
+
+ private:
+  std::unique_ptr<Server> server_;
+  std::unique_ptr<Health::Stub> stub_;
+};
+
+void BM_HealthCheck(benchmark::State& state) {
+  HealthCheckServer server;
+  HealthCheckRequest request;
+  request.set_service(kServiceName);
+  for (auto _ : state) {
+    ClientContext context;
+    HealthCheckResponse response;
+    Status status = server.stub()->Check(&context, request, &response);
+    GPR_ASSERT(status.ok());
+    GPR_ASSERT(response.status() == HealthCheckResponse::SERVING);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HealthCheck);
+
+// Counts the responses received by all the watchers.
+class WatchCounter {
+ public:
+  void OnResponse() {
+    std::lock_guard<std::mutex> lock(mu_);
+    ++responses_;
+    cv_.notify_all();
+  }
+  void OnDone() {
+    std::lock_guard<std::mutex> lock(mu_);
+    ++done_;
+    cv_.notify_all();
+  }
+  void WaitForResponses(size_t responses) {
+    std::unique_lock<std::mutex> lock(mu_);
+    cv_.wait(lock, [&] { return responses_ >= responses; });
+  }
+  void WaitForDone(size_t done) {
+    std::unique_lock<std::mutex> lock(mu_);
+    cv_.wait(lock, [&] { return done_ >= done; });
+  }
+
+ private:
+  std::mutex mu_;
+  std::condition_variable cv_;
+  size_t responses_ = 0;
+  size_t done_ = 0;
+};
+
+class Watcher : public ClientReadReactor<HealthCheckResponse> {
+ public:
+  Watcher(Health::Stub* stub, WatchCounter* counter) : counter_(counter) {
+    request_.set_service(kServiceName);
+    stub->async()->Watch(&context_, &request_, this);
+    StartRead(&response_);
+    StartCall();
+  }
+
+  void Cancel() { context_.TryCancel(); }
+
+  void OnReadDone(bool ok) override {
+    if (!ok) return;
+    counter_->OnResponse();
+    StartRead(&response_);
+  }
+
+  void OnDone(const Status& /*status*/) override { counter_->OnDone(); }
+
+ private:
+  WatchCounter* counter_;
+  ClientContext context_;
+  HealthCheckRequest request_;
+  HealthCheckResponse response_;
+};
+
+// Each iteration flips the serving status and waits for every watcher to
+// receive the update.
+void BM_HealthWatchFanOut(benchmark::State& state) {
+  const size_t num_watchers = state.range(0);
+  HealthCheckServer server;
+  WatchCounter counter;
+  std::vector<std::unique_ptr<Watcher>> watchers;
+  for (size_t i = 0; i < num_watchers; ++i) {
+    watchers.emplace_back(new Watcher(server.stub(), &counter));
+  }
+  // Every watcher first receives the current status.
+  size_t expected_responses = num_watchers;
+  counter.WaitForResponses(expected_responses);
+  bool serving = true;
+  for (auto _ : state) {
+    serving = !serving;
+    server.service()->SetServingStatus(kServiceName, serving);
+    expected_responses += num_watchers;
+    counter.WaitForResponses(expected_responses);
+  }
+  state.SetItemsProcessed(state.iterations() * num_watchers);
+  for (auto& watcher : watchers) watcher->Cancel();
+  counter.WaitForDone(num_watchers);
+}
+BENCHMARK(BM_HealthWatchFanOut)
+    ->ArgName("watchers")
+    ->Arg(1)
+    ->Arg(100)
+    ->Arg(1000)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,173 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark parsing of the JSON documents gRPC reads on resolver updates:
+   service configs, RLS configs and xDS bootstraps. */
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/json/json.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+// A service config with one methodConfig per method of num_services
+// services of 10 methods, each with a retry policy.
+std::string MakeServiceConfig(int num_services) {
+  std::vector<std::string> method_configs;
+  for (int service = 0; service < num_services; ++service) {
+    for (int method = 0; method < 10; ++method) {
+      method_configs.push_back(absl::StrCat(
+          "{\"name\":[{\"service\":\"example.api.v1.Service", service,
+          "\",\"method\":\"Method", method,
+          "\"}],\"timeout\":\"", 1 + method,
+          ".5s\",\"waitForReady\":true,\"maxRequestMessageBytes\":4194304,"
+          "\"retryPolicy\":{\"maxAttempts\":4,\"initialBackoff\":\"0.1s\","
+          "\"maxBackoff\":\"10s\",\"backoffMultiplier\":2.5,"
+          "\"retryableStatusCodes\":[\"UNAVAILABLE\",\"RESOURCE_EXHAUSTED\"]}"
+          "}"));
+    }
+  }
+  return absl::StrCat(
+      "{\"loadBalancingConfig\":[{\"round_robin\":{}}],"
+      "\"retryThrottling\":{\"maxTokens\":10,\"tokenRatio\":0.1},"
+      "\"methodConfig\":[",
+      absl::StrJoin(method_configs, ","), "]}");
+}
+
+// An RLS LB policy config with num_builders gRPC key builders.
+std::string MakeRlsConfig(int num_builders) {
+  std::vector<std::string> builders;
+  for (int i = 0; i < num_builders; ++i) {
+    builders.push_back(absl::StrCat(
+        "{\"names\":[{\"service\":\"example.api.v1.Service", i,
+        "\"}],\"headers\":[{\"key\":\"user\",\"names\":[\"x-user-id\","
+        "\"x-google-user\"]},{\"key\":\"region\",\"names\":[\"x-region\"]}],"
+        "\"extraKeys\":{\"host\":\"server\",\"service\":\"svc\","
+        "\"method\":\"rpc\"},\"constantKeys\":{\"tier\":\"prod\"}}"));
+  }
+  return absl::StrCat(
+      "{\"routeLookupConfig\":{\"grpcKeybuilders\":[",
+      absl::StrJoin(builders, ","),
+      "],\"lookupService\":\"rls.example.com:443\","
+      "\"lookupServiceTimeout\":\"10s\",\"maxAge\":\"300s\","
+      "\"staleAge\":\"240s\",\"cacheSizeBytes\":10485760,"
+      "\"defaultTarget\":\"fallback.example.com\"},"
+      "\"childPolicy\":[{\"grpclb\":{}}],"
+      "\"childPolicyConfigTargetFieldName\":\"serviceName\"}");
+}
+
+// A typical xDS bootstrap file, pretty-printed as written by deployment
+// tooling.
+std::string MakeXdsBootstrap() {
+  return "{\n"
+         "  \"xds_servers\": [\n"
+         "    {\n"
+         "      \"server_uri\": \"trafficdirector.googleapis.com:443\",\n"
+         "      \"channel_creds\": [\n"
+         "        {\"type\": \"google_default\"}\n"
+         "      ],\n"
+         "      \"server_features\": [\"xds_v3\", "
+         "\"ignore_resource_deletion\"]\n"
+         "    }\n"
+         "  ],\n"
+         "  \"node\": {\n"
+         "    \"id\": \"projects/123456789012/networks/default/nodes/"
+         "5e6f7a8b-9c0d-4e1f-a2b3-c4d5e6f7a8b9\",\n"
+         "    \"cluster\": \"cluster\",\n"
+         "    \"metadata\": {\n"
+         "      \"INSTANCE_IP\": \"10.128.0.17\",\n"
+         "      \"TRAFFICDIRECTOR_GCP_PROJECT_NUMBER\": \"123456789012\",\n"
+         "      \"TRAFFICDIRECTOR_NETWORK_NAME\": \"default\"\n"
+         "    },\n"
+         "    \"locality\": {\n"
+         "      \"zone\": \"us-central1-a\"\n"
+         "    }\n"
+         "  },\n"
+         "  \"certificate_providers\": {\n"
+         "    \"google_cloud_private_spiffe\": {\n"
+         "      \"plugin_name\": \"file_watcher\",\n"
+         "      \"config\": {\n"
+         "        \"certificate_file\": \"/var/run/secrets/workload-spiffe-"
+         "credentials/certificates.pem\",\n"
+         "        \"private_key_file\": \"/var/run/secrets/workload-spiffe-"
+         "credentials/private_key.pem\",\n"
+         "        \"ca_certificate_file\": \"/var/run/secrets/workload-spiffe-"
+         "credentials/ca_certificates.pem\",\n"
+         "        \"refresh_interval\": \"600s\"\n"
+         "      }\n"
+         "    }\n"
+         "  },\n"
+         "  \"server_listener_resource_name_template\": \"grpc/server?"
+         "xds.resource.listening_address=%s\"\n"
+         "}\n";
+}
+
+void RunJsonParse(benchmark::State& state, const std::string& json) {
+  for (auto _ : state) {
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    grpc_core::Json parsed = grpc_core::Json::Parse(json, &error);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    benchmark::DoNotOptimize(parsed);
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+// Args: number of services, of 10 methods each.
+void BM_JsonParseServiceConfig(benchmark::State& state) {
+  RunJsonParse(state, MakeServiceConfig(state.range(0)));
+}
+BENCHMARK(BM_JsonParseServiceConfig)->ArgName("services")->Arg(1)->Arg(500);
+
+// Args: number of key builders.
+void BM_JsonParseRlsConfig(benchmark::State& state) {
+  RunJsonParse(state, MakeRlsConfig(state.range(0)));
+}
+BENCHMARK(BM_JsonParseRlsConfig)->ArgName("builders")->Arg(1)->Arg(1000);
+
+void BM_JsonParseXdsBootstrap(benchmark::State& state) {
+  RunJsonParse(state, MakeXdsBootstrap());
+}
+BENCHMARK(BM_JsonParseXdsBootstrap);
+
+}  // namespace
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
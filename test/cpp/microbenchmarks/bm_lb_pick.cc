@@ -0,0 +1,362 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark LB policies over fake subchannels that are always READY:
+   concurrent picks from their pickers, and the time an address update takes
+   to rebuild the subchannel lists and pickers. */
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy/address_filtering.h"
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/resolver/xds/xds_resolver.h"
+#include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/work_serializer.h"
+#include "src/core/lib/json/json.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+// The number of children of the weighted_target and xds_cluster_manager
+// policies.
+constexpr int kNumChildren = 4;
+
+// A subchannel that is always READY.
+class FakeSubchannel : public grpc_core::SubchannelInterface {
+ public:
+  grpc_connectivity_state CheckConnectivityState() override {
+    return GRPC_CHANNEL_READY;
+  }
+
+  void WatchConnectivityState(
+      grpc_connectivity_state /*initial_state*/,
+      std::unique_ptr<ConnectivityStateWatcherInterface> watcher) override {
+    watchers_.push_back(std::move(watcher));
+  }
+
+  void CancelConnectivityStateWatch(
+      ConnectivityStateWatcherInterface* watcher) override {
+    watchers_.erase(
+        std::remove_if(
+            watchers_.begin(), watchers_.end(),
+            [watcher](const std::unique_ptr<ConnectivityStateWatcherInterface>&
+                          w) { return w.get() == watcher; }),
+        watchers_.end());
+  }
+
+  void RequestConnection() override {}
+  void ResetBackoff() override {}
+  void AddDataWatcher(std::unique_ptr<DataWatcherInterface>) override {}
+  const grpc_channel_args* channel_args() override { return nullptr; }
+
+ private:
+  std::vector<std::unique_ptr<ConnectivityStateWatcherInterface>> watchers_;
+};
+
+// Keeps the READY picker that the policy reports.
+class FakeHelper
+    : public grpc_core::LoadBalancingPolicy::ChannelControlHelper {
+ public:
+  explicit FakeHelper(
+      std::unique_ptr<grpc_core::LoadBalancingPolicy::SubchannelPicker>*
+          picker)
+      : picker_(picker) {}
+
+  grpc_core::RefCountedPtr<grpc_core::SubchannelInterface> CreateSubchannel(
+      grpc_core::ServerAddress /*address*/,
+      const grpc_channel_args& /*args*/) override {
+    return grpc_core::MakeRefCounted<FakeSubchannel>();
+  }
+
+  void UpdateState(
+      grpc_connectivity_state state, const absl::Status& /*status*/,
+      std::unique_ptr<grpc_core::LoadBalancingPolicy::SubchannelPicker> picker)
+      override {
+    if (state == GRPC_CHANNEL_READY) *picker_ = std::move(picker);
+  }
+
+  void RequestReresolution() override {}
+  absl::string_view GetAuthority() override { return "server.example.com"; }
+  void AddTraceEvent(TraceSeverity /*severity*/,
+                     absl::string_view /*message*/) override {}
+
+ private:
+  std::unique_ptr<grpc_core::LoadBalancingPolicy::SubchannelPicker>* picker_;
+};
+
+// Provides the call attributes that the ring_hash and xds_cluster_manager
+// pickers route on, as the xDS config selector would.
+class FakeCallState : public grpc_core::LoadBalancingPolicy::CallState {
+ public:
+  FakeCallState(std::string ring_hash, std::string cluster)
+      : ring_hash_(std::move(ring_hash)), cluster_(std::move(cluster)) {}
+
+  // None of the benchmarked pickers allocate.
+  void* Alloc(size_t /*size*/) override {
+    GPR_UNREACHABLE_CODE(return nullptr);
+  }
+
+  absl::string_view ExperimentalGetCallAttribute(const char* key) override {
+    if (key == grpc_core::kRequestRingHashAttribute) return ring_hash_;
+    if (key == grpc_core::kXdsClusterAttribute) return cluster_;
+    return absl::string_view();
+  }
+
+ private:
+  std::string ring_hash_;
+  std::string cluster_;
+};
+
+// Each policy provides:
+// - static const char* Config(), its LB config as it would appear in the
+//   service config;
+// - static constexpr bool kHierarchical, whether its addresses are split among
+//   kNumChildren children by hierarchical path.
+
+struct PickFirst {
+  static const char* Config() { return R"([{"pick_first": {}}])"; }
+  static constexpr bool kHierarchical = false;
+};
+
+struct RoundRobin {
+  static const char* Config() { return R"([{"round_robin": {}}])"; }
+  static constexpr bool kHierarchical = false;
+};
+
+struct RingHash {
+  static const char* Config() {
+    return R"([{"ring_hash_experimental": {}}])";
+  }
+  static constexpr bool kHierarchical = false;
+};
+
+struct WeightedTarget {
+  static const char* Config() {
+    return R"([{"weighted_target_experimental": {"targets": {
+        "child0": {"weight": 1, "childPolicy": [{"round_robin": {}}]},
+        "child1": {"weight": 2, "childPolicy": [{"round_robin": {}}]},
+        "child2": {"weight": 3, "childPolicy": [{"round_robin": {}}]},
+        "child3": {"weight": 4, "childPolicy": [{"round_robin": {}}]}
+      }}}])";
+  }
+  static constexpr bool kHierarchical = true;
+};
+
+// Every child of xds_cluster_manager gets all of the addresses.
+struct XdsClusterManager {
+  static const char* Config() {
+    return R"([{"xds_cluster_manager_experimental": {"children": {
+        "child0": {"childPolicy": [{"round_robin": {}}]},
+        "child1": {"childPolicy": [{"round_robin": {}}]},
+        "child2": {"childPolicy": [{"round_robin": {}}]},
+        "child3": {"childPolicy": [{"round_robin": {}}]}
+      }}}])";
+  }
+  static constexpr bool kHierarchical = false;
+};
+
+template <class Policy>
+grpc_core::ServerAddressList MakeAddresses(int num_addresses) {
+  grpc_core::ServerAddressList addresses;
+  for (int i = 0; i < num_addresses; ++i) {
+    grpc_resolved_address address;
+    GPR_ASSERT(GRPC_ERROR_NONE ==
+               grpc_string_to_sockaddr(&address, "127.0.0.1", 1000 + i));
+    std::map<const char*,
+             std::unique_ptr<grpc_core::ServerAddress::AttributeInterface>>
+        attributes;
+    if (Policy::kHierarchical) {
+      attributes[grpc_core::kHierarchicalPathAttributeKey] =
+          grpc_core::MakeHierarchicalPathAttribute(
+              {absl::StrCat("child", i % kNumChildren)});
+    }
+    addresses.emplace_back(address, nullptr, std::move(attributes));
+  }
+  return addresses;
+}
+
+// A policy over num_addresses READY subchannels.
+template <class Policy>
+class LbPolicyFixture {
+ public:
+  explicit LbPolicyFixture(int num_addresses)
+      : addresses_(MakeAddresses<Policy>(num_addresses)) {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_error_handle error = GRPC_ERROR_NONE;
+    grpc_core::Json json = grpc_core::Json::Parse(Policy::Config(), &error);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    config_ = grpc_core::LoadBalancingPolicyRegistry::ParseLoadBalancingConfig(
+        json, &error);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    grpc_core::LoadBalancingPolicy::Args args;
+    args.work_serializer = std::make_shared<grpc_core::WorkSerializer>();
+    args.channel_control_helper = absl::make_unique<FakeHelper>(&picker_);
+    args.args = &channel_args_;
+    policy_ = grpc_core::LoadBalancingPolicyRegistry::CreateLoadBalancingPolicy(
+        config_->name(), std::move(args));
+    Update();
+    GPR_ASSERT(picker_ != nullptr);
+  }
+
+  ~LbPolicyFixture() {
+    grpc_core::ExecCtx exec_ctx;
+    picker_.reset();
+    policy_.reset();
+  }
+
+  // Sends the policy its addresses again. The subchannel lists and pickers
+  // are rebuilt from scratch. Must be called with an ExecCtx.
+  void Update() {
+    grpc_core::LoadBalancingPolicy::UpdateArgs update;
+    update.addresses = addresses_;
+    update.config = config_;
+    update.args = grpc_channel_args_copy(&channel_args_);
+    policy_->UpdateLocked(std::move(update));
+  }
+
+  grpc_core::LoadBalancingPolicy::SubchannelPicker* picker() {
+    return picker_.get();
+  }
+
+ private:
+  grpc_channel_args channel_args_ = {0, nullptr};
+  grpc_core::ServerAddressList addresses_;
+  grpc_core::RefCountedPtr<grpc_core::LoadBalancingPolicy::Config> config_;
+  std::unique_ptr<grpc_core::LoadBalancingPolicy::SubchannelPicker> picker_;
+  grpc_core::OrphanablePtr<grpc_core::LoadBalancingPolicy> policy_;
+};
+
+void* g_fixture;
+
+}  // namespace
+
+// Args: number of addresses. Each thread hashes to its own point on the ring
+// and routes to its own cluster.
+template <class Policy>
+static void BM_LbPick(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    g_fixture = new LbPolicyFixture<Policy>(state.range(0));
+  }
+  FakeCallState call_state(
+      absl::StrCat(0x9e3779b97f4a7c15u * (state.thread_index() + 1)),
+      absl::StrCat("child", state.thread_index() % kNumChildren));
+  grpc_core::LoadBalancingPolicy::PickArgs args;
+  args.path = "/grpc.testing.EchoTestService/Echo";
+  args.call_state = &call_state;
+  grpc_core::ExecCtx exec_ctx;
+  for (auto _ : state) {
+    auto* fixture = static_cast<LbPolicyFixture<Policy>*>(g_fixture);
+    auto result = fixture->picker()->Pick(args);
+    GPR_ASSERT(absl::holds_alternative<
+               grpc_core::LoadBalancingPolicy::PickResult::Complete>(
+        result.result));
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    delete static_cast<LbPolicyFixture<Policy>*>(g_fixture);
+  }
+}
+BENCHMARK_TEMPLATE(BM_LbPick, PickFirst)
+    ->ArgNames({"addresses"})
+    ->Arg(16)
+    ->Threads(1)
+    ->Threads(64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LbPick, RoundRobin)
+    ->ArgNames({"addresses"})
+    ->Arg(16)
+    ->Arg(1024)
+    ->Threads(1)
+    ->Threads(64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LbPick, RingHash)
+    ->ArgNames({"addresses"})
+    ->Arg(16)
+    ->Arg(1024)
+    ->Threads(1)
+    ->Threads(64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LbPick, WeightedTarget)
+    ->ArgNames({"addresses"})
+    ->Arg(16)
+    ->Arg(1024)
+    ->Threads(1)
+    ->Threads(64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_LbPick, XdsClusterManager)
+    ->ArgNames({"addresses"})
+    ->Arg(16)
+    ->Arg(1024)
+    ->Threads(1)
+    ->Threads(64)
+    ->UseRealTime();
+
+// Args: number of addresses. Includes releasing the previous subchannels.
+template <class Policy>
+static void BM_LbUpdate(benchmark::State& state) {
+  LbPolicyFixture<Policy> fixture(state.range(0));
+  for (auto _ : state) {
+    grpc_core::ExecCtx exec_ctx;
+    fixture.Update();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+static void UpdateSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"addresses"});
+  for (int addresses : {10, 1000, 10000}) b->Arg(addresses);
+}
+BENCHMARK_TEMPLATE(BM_LbUpdate, PickFirst)->Apply(UpdateSizes);
+BENCHMARK_TEMPLATE(BM_LbUpdate, RoundRobin)->Apply(UpdateSizes);
+BENCHMARK_TEMPLATE(BM_LbUpdate, RingHash)->Apply(UpdateSizes);
+BENCHMARK_TEMPLATE(BM_LbUpdate, WeightedTarget)->Apply(UpdateSizes);
+BENCHMARK_TEMPLATE(BM_LbUpdate, XdsClusterManager)->Apply(UpdateSizes);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
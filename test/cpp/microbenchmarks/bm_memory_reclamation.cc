@@ -0,0 +1,180 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark reclamation of cache memory under memory quota pressure, with
+   the SSL session cache as the cache. BM_ReclaimSslSessions times how long
+   an allocation that overcommits the quota takes to get the memory back,
+   and reports the bytes recovered per reclamation as a counter.
+   BM_SslSessionCachePut is the cost of charging the cache to a quota on the
+   handshake path, against a cache that is not charged to any. */
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <openssl/ssl.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/tsi/ssl/session_cache/ssl_session_cache.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+constexpr size_t kQuotaSize = 64 * 1024 * 1024;
+
+// OpenSSL and different versions of BoringSSL don't agree on the signature
+// of SSL_SESSION_new, so support both.
+tsi::SslSessionPtr NewSessionInternal(SSL_SESSION* (*cb)(), SSL_CTX*) {
+  return tsi::SslSessionPtr(cb());
+}
+
+tsi::SslSessionPtr NewSessionInternal(SSL_SESSION* (*cb)(const SSL_CTX*),
+                                      SSL_CTX* ssl_ctx) {
+  return tsi::SslSessionPtr(cb(ssl_ctx));
+}
+
+size_t TotalUsage(const MemoryQuota& memory_quota) {
+  size_t total = 0;
+  for (size_t bytes : memory_quota.GetUsage()) total += bytes;
+  return total;
+}
+
+class SessionCacheFixture {
+ public:
+  explicit SessionCacheFixture(bool charged)
+      : ssl_ctx_(SSL_CTX_new(TLS_method())),
+        memory_quota_(MakeMemoryQuota("bm_memory_reclamation")) {
+    memory_quota_->SetSize(kQuotaSize);
+    cache_ = tsi::SslSessionLRUCache::Create(
+        kMaxSessions, charged ? memory_quota_ : nullptr);
+  }
+
+  ~SessionCacheFixture() {
+    cache_.reset();
+    SSL_CTX_free(ssl_ctx_);
+  }
+
+  const MemoryQuotaRefPtr& memory_quota() const { return memory_quota_; }
+  tsi::SslSessionLRUCache* cache() const { return cache_.get(); }
+
+  void Fill(size_t num_sessions) {
+    for (size_t i = 0; i < num_sessions; ++i) {
+      cache_->Put(Key(i).c_str(), NewSession());
+    }
+  }
+
+  tsi::SslSessionPtr NewSession() {
+    return NewSessionInternal(SSL_SESSION_new, ssl_ctx_);
+  }
+
+  static std::string Key(size_t i) {
+    return absl::StrCat("server", i, ".example.com");
+  }
+
+  static constexpr size_t kMaxSessions = 10000;
+
+ private:
+  SSL_CTX* ssl_ctx_;
+  MemoryQuotaRefPtr memory_quota_;
+  RefCountedPtr<tsi::SslSessionLRUCache> cache_;
+};
+
+static void BM_ReclaimSslSessions(benchmark::State& state) {
+  ExecCtx exec_ctx;
+  SessionCacheFixture fixture(/*charged=*/true);
+  MemoryOwner pressure =
+      fixture.memory_quota()->CreateMemoryOwner("pressure");
+  size_t recovered = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    fixture.Fill(state.range(0));
+    exec_ctx.Flush();
+    size_t before = TotalUsage(*fixture.memory_quota());
+    state.ResumeTiming();
+    // Take the whole quota, and wait for the cache to give its share back.
+    pressure.Reserve(kQuotaSize);
+    exec_ctx.Flush();
+    state.PauseTiming();
+    GPR_ASSERT(fixture.cache()->Size() == 0);
+    pressure.Release(kQuotaSize);
+    size_t after = TotalUsage(*fixture.memory_quota());
+    if (before > after) recovered += before - after;
+    state.ResumeTiming();
+  }
+  state.counters["recovered_bytes"] =
+      benchmark::Counter(recovered, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_ReclaimSslSessions)
+    ->ArgName("sessions")
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(10000);
+
+static void BM_SslSessionCachePut(benchmark::State& state) {
+  ExecCtx exec_ctx;
+  SessionCacheFixture fixture(/*charged=*/state.range(0) != 0);
+  const size_t num_keys = SessionCacheFixture::kMaxSessions / 2;
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < num_keys; ++i) {
+    keys.push_back(SessionCacheFixture::Key(i));
+  }
+  std::vector<tsi::SslSessionPtr> sessions;
+  size_t i = 0;
+  for (auto _ : state) {
+    if (sessions.empty()) {
+      state.PauseTiming();
+      for (size_t j = 0; j < 1000; ++j) {
+        sessions.push_back(fixture.NewSession());
+      }
+      exec_ctx.Flush();
+      state.ResumeTiming();
+    }
+    fixture.cache()->Put(keys[i++ % num_keys].c_str(),
+                         std::move(sessions.back()));
+    sessions.pop_back();
+  }
+}
+BENCHMARK(BM_SslSessionCachePut)->ArgName("charged")->Arg(0)->Arg(1);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark percent encoding and decoding of status messages and paths */
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/lib/slice/percent_encoding.h"
+#include "src/core/lib/slice/slice.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// A status message of state.range(0) bytes, with a byte to encode every
+// state.range(1) bytes, or none if that is 0.
+std::string MakeMessage(benchmark::State& state, char reserved) {
+  std::string message;
+  const int64_t period = state.range(1);
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    message.push_back(period != 0 && i % period == period - 1
+                          ? reserved
+                          : "status message "[i % 15]);
+  }
+  return message;
+}
+
+void SetCounters(benchmark::State& state) {
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_PercentEncode(benchmark::State& state) {
+  const Slice input = Slice::FromCopiedString(MakeMessage(state, '\n'));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        PercentEncodeSlice(input.Ref(), PercentEncodingType::Compatible));
+  }
+  SetCounters(state);
+}
+
+void BM_PercentDecode(benchmark::State& state) {
+  const Slice input = PercentEncodeSlice(
+      Slice::FromCopiedString(MakeMessage(state, '\n')),
+      PercentEncodingType::Compatible);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(PermissivePercentDecodeSlice(input.Ref()));
+  }
+  SetCounters(state);
+}
+
+void PercentEncodingArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"bytes", "reserved_every"});
+  for (int bytes : {16, 128, 1024, 16384}) {
+    for (int period : {0, 64, 8}) b->Args({bytes, period});
+  }
+}
+
+BENCHMARK(BM_PercentEncode)->Apply(PercentEncodingArgs);
+BENCHMARK(BM_PercentDecode)->Apply(PercentEncodingArgs);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark RBAC: evaluating calls against authorization policies with many
+   rules, the way the server authz filter does, and translating and
+   compiling a policy update. */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+
+#include <grpc/grpc.h>
+#include <grpc/grpc_security_constants.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/security/authorization/authorization_engine.h"
+#include "src/core/lib/security/authorization/grpc_authorization_engine.h"
+#include "src/core/lib/security/authorization/rbac_translator.h"
+#include "test/core/util/evaluate_args_test_util.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+// An authorization policy as a fleet of services would have it: per
+// service, a rule allowing its callers on its methods when they carry
+// their tenant header, and a few rules denying blocked clients.
+std::string MakeAuthzPolicy(int num_rules) {
+  std::vector<std::string> allow_rules;
+  for (int i = 0; i < num_rules; ++i) {
+    allow_rules.push_back(absl::StrCat(
+        R"({"name": "allow_service)", i, R"(",
+            "source": {"principals": ["spiffe://example.com/caller)", i,
+        R"(", "spiffe://example.com/admin"]},
+            "request": {"paths": ["/pkg.Service)", i, R"(/*"],
+                        "headers": [{"key": "x-tenant",
+                                     "values": ["tenant)",
+        i, R"(", "tenant)", i, R"(-*"]}]}})"));
+  }
+  std::vector<std::string> deny_rules;
+  for (int i = 0; i < 4; ++i) {
+    deny_rules.push_back(absl::StrCat(
+        R"({"name": "deny_blocked)", i, R"(",
+            "source": {"principals": ["spiffe://example.com/blocked)", i,
+        R"("]}})"));
+  }
+  return absl::StrCat(R"({"name": "authz", "deny_rules": [)",
+                      absl::StrJoin(deny_rules, ","), R"(], "allow_rules": [)",
+                      absl::StrJoin(allow_rules, ","), "]}");
+}
+
+// The deny and allow engines of a policy.
+struct Engines {
+  explicit Engines(const std::string& policy) {
+    auto policies = grpc_core::GenerateRbacPolicies(policy);
+    GPR_ASSERT(policies.ok());
+    deny = grpc_core::GrpcAuthorizationEngine(
+        std::move(policies->deny_policy));
+    allow = grpc_core::GrpcAuthorizationEngine(
+        std::move(policies->allow_policy));
+  }
+
+  grpc_core::GrpcAuthorizationEngine deny{grpc_core::Rbac::Action::kDeny};
+  grpc_core::GrpcAuthorizationEngine allow{grpc_core::Rbac::Action::kAllow};
+};
+
+}  // namespace
+
+// Args: number of allow rules, whether the call is allowed. Allowed calls
+// are for the last service; the others have the wrong tenant, so no allow
+// rule matches.
+static void BM_RbacEvaluate(benchmark::State& state) {
+  grpc_core::ExecCtx exec_ctx;
+  const int num_rules = state.range(0);
+  const bool allowed = state.range(1) != 0;
+  Engines engines(MakeAuthzPolicy(num_rules));
+  const std::string path =
+      absl::StrCat("/pkg.Service", num_rules - 1, "/Method");
+  const std::string tenant =
+      allowed ? absl::StrCat("tenant", num_rules - 1, "-eu") : "other";
+  const std::string spiffe_id =
+      absl::StrCat("spiffe://example.com/caller", num_rules - 1);
+  grpc_core::EvaluateArgsTestUtil util;
+  util.AddPairToMetadata(":path", path.c_str());
+  util.AddPairToMetadata(":authority", "service.example.com");
+  util.AddPairToMetadata("x-tenant", tenant.c_str());
+  util.AddPropertyToAuthContext(GRPC_PEER_SPIFFE_ID_PROPERTY_NAME,
+                                spiffe_id.c_str());
+  util.SetPeerEndpoint("ipv4:10.0.0.1:12345");
+  util.SetLocalEndpoint("ipv4:10.0.0.2:443");
+  // One channel for all calls, so connection-level rules are cached after
+  // the first call as on a real connection.
+  grpc_core::EvaluateArgs args = util.MakeEvaluateArgs();
+  for (auto _ : state) {
+    GPR_ASSERT(engines.deny.Evaluate(args).type ==
+               grpc_core::AuthorizationEngine::Decision::Type::kAllow);
+    GPR_ASSERT((engines.allow.Evaluate(args).type ==
+                grpc_core::AuthorizationEngine::Decision::Type::kAllow) ==
+               allowed);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RbacEvaluate)
+    ->ArgNames({"rules", "allowed"})
+    ->ArgsProduct({{10, 100, 1000}, {0, 1}});
+
+// What a policy update costs: translating the policy to RBAC and compiling
+// the engines. Args: number of allow rules.
+static void BM_RbacPolicyUpdate(benchmark::State& state) {
+  grpc_core::ExecCtx exec_ctx;
+  const std::string policy = MakeAuthzPolicy(state.range(0));
+  for (auto _ : state) {
+    Engines engines(policy);
+    benchmark::DoNotOptimize(engines.allow.num_policies());
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * policy.size());
+}
+BENCHMARK(BM_RbacPolicyUpdate)->ArgName("rules")->Arg(10)->Arg(100)->Arg(1000);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark building and looking up ring_hash tables as clusters grow */
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+// Defaults of the ring_hash_experimental config.
+static constexpr size_t kMinRingSize = 1024;
+static constexpr size_t kMaxRingSize = 8388608;
+static constexpr size_t kMaglevTableSize = 65537;
+
+// Endpoints of a cluster, as EDS would send them. When weighted is set, the
+// weights vary from 1 to 10, which makes rings larger.
+static std::vector<grpc_core::RingHashTable::Endpoint> MakeEndpoints(
+    size_t num_endpoints, bool weighted) {
+  std::vector<grpc_core::RingHashTable::Endpoint> endpoints(num_endpoints);
+  for (size_t i = 0; i < num_endpoints; ++i) {
+    endpoints[i].address = absl::StrCat("10.", i / 65536, ".", i / 256 % 256,
+                                        ".", i % 256, ":443");
+    if (weighted) endpoints[i].weight = 1 + i % 10;
+  }
+  return endpoints;
+}
+
+static grpc_core::RingHashTable MakeTable(
+    const std::vector<grpc_core::RingHashTable::Endpoint>& endpoints,
+    bool maglev) {
+  return maglev ? grpc_core::RingHashTable::MakeMaglev(endpoints,
+                                                       kMaglevTableSize)
+                : grpc_core::RingHashTable::MakeRing(endpoints, kMinRingSize,
+                                                     kMaxRingSize);
+}
+
+// Args: number of endpoints, weighted, maglev.
+static void TableArgs(benchmark::internal::Benchmark* b) {
+  for (int num_endpoints : {10, 100, 1000, 10000}) {
+    for (int weighted : {0, 1}) {
+      for (int maglev : {0, 1}) b->Args({num_endpoints, weighted, maglev});
+    }
+  }
+}
+
+static void BM_RingHashBuild(benchmark::State& state) {
+  const auto endpoints = MakeEndpoints(state.range(0), state.range(1) != 0);
+  const bool maglev = state.range(2) != 0;
+  size_t table_size = 0;
+  for (auto _ : state) {
+    grpc_core::RingHashTable table = MakeTable(endpoints, maglev);
+    table_size = table.size();
+    benchmark::DoNotOptimize(table);
+  }
+  state.counters["entries"] = table_size;
+}
+BENCHMARK(BM_RingHashBuild)->Apply(TableArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_RingHashPick(benchmark::State& state) {
+  const auto endpoints = MakeEndpoints(state.range(0), state.range(1) != 0);
+  const grpc_core::RingHashTable table =
+      MakeTable(endpoints, state.range(2) != 0);
+  std::vector<uint64_t> hashes(4096);
+  uint64_t x = 12345;
+  for (uint64_t& hash : hashes) {
+    x = x * 6364136223846793005u + 1442695040888963407u;
+    hash = x;
+  }
+  size_t next = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        table.endpoint_index(table.FindPosition(hashes[next++ & 4095])));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RingHashPick)->Apply(TableArgs);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,207 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark concurrent picks from the round_robin picker */
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/memory/memory.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel_interface.h"
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/work_serializer.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+// A subchannel that is always READY.
+class FakeSubchannel : public grpc_core::SubchannelInterface {
+ public:
+  grpc_connectivity_state CheckConnectivityState() override {
+    return GRPC_CHANNEL_READY;
+  }
+
+  void WatchConnectivityState(
+      grpc_connectivity_state /*initial_state*/,
+      std::unique_ptr<ConnectivityStateWatcherInterface> watcher) override {
+    watchers_.push_back(std::move(watcher));
+  }
+
+  void CancelConnectivityStateWatch(
+      ConnectivityStateWatcherInterface* watcher) override {
+    watchers_.erase(
+        std::remove_if(
+            watchers_.begin(), watchers_.end(),
+            [watcher](const std::unique_ptr<ConnectivityStateWatcherInterface>&
+                          w) { return w.get() == watcher; }),
+        watchers_.end());
+  }
+
+  void RequestConnection() override {}
+  void ResetBackoff() override {}
+  void AddDataWatcher(std::unique_ptr<DataWatcherInterface>) override {}
+  const grpc_channel_args* channel_args() override { return nullptr; }
+
+ private:
+  std::vector<std::unique_ptr<ConnectivityStateWatcherInterface>> watchers_;
+};
+
+// Keeps the READY picker that the policy reports.
+class FakeHelper
+    : public grpc_core::LoadBalancingPolicy::ChannelControlHelper {
+ public:
+  explicit FakeHelper(
+      std::unique_ptr<grpc_core::LoadBalancingPolicy::SubchannelPicker>*
+          picker)
+      : picker_(picker) {}
+
+  grpc_core::RefCountedPtr<grpc_core::SubchannelInterface> CreateSubchannel(
+      grpc_core::ServerAddress /*address*/,
+      const grpc_channel_args& /*args*/) override {
+    return grpc_core::MakeRefCounted<FakeSubchannel>();
+  }
+
+  void UpdateState(
+      grpc_connectivity_state state, const absl::Status& /*status*/,
+      std::unique_ptr<grpc_core::LoadBalancingPolicy::SubchannelPicker> picker)
+      override {
+    if (state == GRPC_CHANNEL_READY) *picker_ = std::move(picker);
+  }
+
+  void RequestReresolution() override {}
+  absl::string_view GetAuthority() override { return "server.example.com"; }
+  void AddTraceEvent(TraceSeverity /*severity*/,
+                     absl::string_view /*message*/) override {}
+
+ private:
+  std::unique_ptr<grpc_core::LoadBalancingPolicy::SubchannelPicker>* picker_;
+};
+
+// A round_robin policy over num_subchannels READY subchannels.
+class RoundRobinFixture {
+ public:
+  RoundRobinFixture(int num_subchannels, bool per_cpu_picks) {
+    grpc_core::ExecCtx exec_ctx;
+    grpc_arg arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_ROUND_ROBIN_PER_CPU_PICKS), per_cpu_picks);
+    grpc_channel_args channel_args = {1, &arg};
+    grpc_core::LoadBalancingPolicy::Args args;
+    args.work_serializer = std::make_shared<grpc_core::WorkSerializer>();
+    args.channel_control_helper = absl::make_unique<FakeHelper>(&picker_);
+    args.args = &channel_args;
+    policy_ = grpc_core::LoadBalancingPolicyRegistry::CreateLoadBalancingPolicy(
+        "round_robin", std::move(args));
+    grpc_core::LoadBalancingPolicy::UpdateArgs update;
+    grpc_core::ServerAddressList addresses;
+    for (int i = 0; i < num_subchannels; ++i) {
+      grpc_resolved_address address;
+      GPR_ASSERT(GRPC_ERROR_NONE ==
+                 grpc_string_to_sockaddr(&address, "127.0.0.1", 1000 + i));
+      addresses.emplace_back(address, nullptr);
+    }
+    update.addresses = std::move(addresses);
+    update.args = grpc_channel_args_copy(&channel_args);
+    policy_->UpdateLocked(std::move(update));
+    GPR_ASSERT(picker_ != nullptr);
+  }
+
+  ~RoundRobinFixture() {
+    grpc_core::ExecCtx exec_ctx;
+    picker_.reset();
+    policy_.reset();
+  }
+
+  grpc_core::LoadBalancingPolicy::SubchannelPicker* picker() {
+    return picker_.get();
+  }
+
+ private:
+  std::unique_ptr<grpc_core::LoadBalancingPolicy::SubchannelPicker> picker_;
+  grpc_core::OrphanablePtr<grpc_core::LoadBalancingPolicy> policy_;
+};
+
+RoundRobinFixture* g_fixture;
+grpc_core::Mutex* g_mu;
+
+}  // namespace
+
+// Args: number of subchannels, per-CPU picks, picks serialized by a mutex
+// as the client channel used to do.
+static void BM_RoundRobinPick(benchmark::State& state) {
+  const bool serialized = state.range(2) != 0;
+  if (state.thread_index() == 0) {
+    g_fixture = new RoundRobinFixture(state.range(0), state.range(1) != 0);
+    g_mu = new grpc_core::Mutex();
+  }
+  grpc_core::ExecCtx exec_ctx;
+  for (auto _ : state) {
+    if (serialized) {
+      grpc_core::MutexLock lock(g_mu);
+      benchmark::DoNotOptimize(g_fixture->picker()->Pick(
+          grpc_core::LoadBalancingPolicy::PickArgs()));
+    } else {
+      benchmark::DoNotOptimize(g_fixture->picker()->Pick(
+          grpc_core::LoadBalancingPolicy::PickArgs()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    delete g_fixture;
+    delete g_mu;
+  }
+}
+BENCHMARK(BM_RoundRobinPick)
+    ->ArgNames({"subchannels", "per_cpu", "serialized"})
+    ->Args({16, 0, 1})
+    ->Args({16, 0, 0})
+    ->Args({16, 1, 0})
+    ->Args({256, 0, 0})
+    ->Args({256, 1, 0})
+    ->Threads(1)
+    ->Threads(64)
+    ->UseRealTime();
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
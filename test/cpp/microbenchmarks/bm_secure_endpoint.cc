@@ -0,0 +1,203 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark secure endpoints: a message written to the client end of an
+   in-memory endpoint pair and read from the server end, in the clear or
+   through secure endpoints with the fake, ALTS and TLS protectors. The
+   in-memory endpoint copies what is written, so the insecure benchmark is
+   the baseline to compare with. */
+
+#include <limits.h>
+#include <string.h>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/security/transport/secure_endpoint.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "test/core/util/passthru_endpoint.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/microbenchmarks/tsi_fixtures.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+// Reads from an endpoint until a given number of bytes arrived.
+class Reader {
+ public:
+  explicit Reader(grpc_endpoint* endpoint) : endpoint_(endpoint) {
+    grpc_slice_buffer_init(&buffer_);
+    GRPC_CLOSURE_INIT(&on_read_, OnRead, this, grpc_schedule_on_exec_ctx);
+  }
+  ~Reader() { grpc_slice_buffer_destroy_internal(&buffer_); }
+
+  void Start(size_t bytes) {
+    remaining_ = bytes;
+    Read();
+  }
+  bool done() const { return remaining_ == 0; }
+
+ private:
+  void Read() {
+    grpc_endpoint_read(endpoint_, &buffer_, &on_read_, /*urgent=*/false,
+                       /*min_progress_size=*/1);
+  }
+
+  static void OnRead(void* arg, grpc_error_handle error) {
+    auto* reader = static_cast<Reader*>(arg);
+    GPR_ASSERT(error == GRPC_ERROR_NONE);
+    GPR_ASSERT(reader->buffer_.length <= reader->remaining_);
+    reader->remaining_ -= reader->buffer_.length;
+    grpc_slice_buffer_reset_and_unref_internal(&reader->buffer_);
+    if (reader->remaining_ > 0) reader->Read();
+  }
+
+  grpc_endpoint* endpoint_;
+  grpc_slice_buffer buffer_;
+  grpc_closure on_read_;
+  size_t remaining_ = 0;
+};
+
+void OnWriteDone(void* arg, grpc_error_handle error) {
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+  *static_cast<bool*>(arg) = true;
+}
+
+// Writes state.range(0) bytes from client to server per iteration.
+void RunEndpointPair(benchmark::State& state, grpc_endpoint* client,
+                     grpc_endpoint* server) {
+  grpc_slice message = grpc_slice_malloc(state.range(0));
+  memset(GRPC_SLICE_START_PTR(message), 'a', GRPC_SLICE_LENGTH(message));
+  grpc_slice_buffer write_buffer;
+  grpc_slice_buffer_init(&write_buffer);
+  Reader reader(server);
+  bool write_done;
+  grpc_closure on_write_done;
+  GRPC_CLOSURE_INIT(&on_write_done, OnWriteDone, &write_done,
+                    grpc_schedule_on_exec_ctx);
+  for (auto _ : state) {
+    grpc_core::ExecCtx exec_ctx;
+    reader.Start(GRPC_SLICE_LENGTH(message));
+    write_done = false;
+    grpc_slice_buffer_add(&write_buffer, grpc_slice_ref_internal(message));
+    grpc_endpoint_write(client, &write_buffer, &on_write_done, nullptr,
+                        /*max_frame_size=*/INT_MAX);
+    exec_ctx.Flush();
+    GPR_ASSERT(write_done && reader.done());
+    grpc_slice_buffer_reset_and_unref_internal(&write_buffer);
+  }
+  grpc_slice_buffer_destroy_internal(&write_buffer);
+  grpc_slice_unref_internal(message);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void DestroyEndpoints(grpc_endpoint* client, grpc_endpoint* server) {
+  grpc_core::ExecCtx exec_ctx;
+  for (grpc_endpoint* endpoint : {client, server}) {
+    grpc_endpoint_shutdown(
+        endpoint, GRPC_ERROR_CREATE_FROM_STATIC_STRING("benchmark done"));
+    grpc_endpoint_destroy(endpoint);
+  }
+}
+
+void BM_InsecureEndpoint(benchmark::State& state) {
+  grpc_passthru_endpoint_stats* stats = grpc_passthru_endpoint_stats_create();
+  grpc_endpoint* client;
+  grpc_endpoint* server;
+  grpc_passthru_endpoint_create(&client, &server, stats);
+  RunEndpointPair(state, client, server);
+  DestroyEndpoints(client, server);
+  grpc_passthru_endpoint_stats_destroy(stats);
+}
+
+template <class Fixture, bool kZeroCopy>
+void BM_SecureEndpoint(benchmark::State& state) {
+  TsiProtectors protectors;
+  Fixture::CreateProtectors(kZeroCopy, &protectors);
+  grpc_passthru_endpoint_stats* stats = grpc_passthru_endpoint_stats_create();
+  grpc_endpoint* client;
+  grpc_endpoint* server;
+  grpc_passthru_endpoint_create(&client, &server, stats);
+  const grpc_channel_args* args = grpc_core::CoreConfiguration::Get()
+                                      .channel_args_preconditioning()
+                                      .PreconditionChannelArgs(nullptr)
+                                      .ToC();
+  // The secure endpoints take the protectors.
+  client = grpc_secure_endpoint_create(protectors.client,
+                                       protectors.client_zero_copy, client,
+                                       nullptr, args, 0);
+  server = grpc_secure_endpoint_create(protectors.server,
+                                       protectors.server_zero_copy, server,
+                                       nullptr, args, 0);
+  protectors.client = nullptr;
+  protectors.server = nullptr;
+  protectors.client_zero_copy = nullptr;
+  protectors.server_zero_copy = nullptr;
+  grpc_channel_args_destroy(args);
+  RunEndpointPair(state, client, server);
+  DestroyEndpoints(client, server);
+  grpc_passthru_endpoint_stats_destroy(stats);
+  state.SetLabel(Fixture::Name());
+}
+
+void MessageSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"bytes"});
+  for (int bytes : {64, 1024, 16384, 65536, 1 << 20}) b->Arg(bytes);
+}
+
+BENCHMARK(BM_InsecureEndpoint)->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_SecureEndpoint, FakeTsi, false)->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_SecureEndpoint, FakeTsi, true)->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_SecureEndpoint, AltsTsi<false>, false)
+    ->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_SecureEndpoint, AltsTsi<false>, true)
+    ->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_SecureEndpoint, AltsTsi<true>, true)
+    ->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_SecureEndpoint, SslTsi, false)->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_SecureEndpoint, SslTsi, true)->Apply(MessageSizes);
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
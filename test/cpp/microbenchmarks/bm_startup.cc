@@ -0,0 +1,122 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark the startup of a process: grpc_init, and grpc_init followed by
+   the first unary RPC. Every iteration starts from a shut down library, so
+   unlike the other benchmarks this one does not hold a LibraryInitializer. */
+
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+class EchoServiceImpl : public EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* /*context*/, const EchoRequest* request,
+              EchoResponse* response) override {
+    response->set_message(request->message());
+    return Status::OK;
+  }
+};
+
+void ShutdownLibrary() {
+  grpc_shutdown_blocking();
+  GPR_ASSERT(grpc_wait_until_shutdown(10));
+}
+
+void BM_GrpcInit(benchmark::State& state) {
+  for (auto _ : state) {
+    grpc_init();
+    state.PauseTiming();
+    ShutdownLibrary();
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(BM_GrpcInit);
+
+// Measures grpc_init, creating a channel, and a unary RPC on it, which
+// connects the channel. Starting the server is not measured.
+void BM_GrpcInitAndFirstUnaryRpc(benchmark::State& state) {
+  const int port = grpc_pick_unused_port_or_die();
+  const std::string server_address = absl::StrCat("localhost:", port);
+  EchoServiceImpl service;
+  for (auto _ : state) {
+    grpc_init();
+    state.PauseTiming();
+    ServerBuilder builder;
+    builder.AddListeningPort(server_address, InsecureServerCredentials());
+    builder.RegisterService(&service);
+    std::unique_ptr<Server> server = builder.BuildAndStart();
+    state.ResumeTiming();
+    {
+      std::unique_ptr<EchoTestService::Stub> stub = EchoTestService::NewStub(
+          CreateChannel(server_address, InsecureChannelCredentials()));
+      ClientContext context;
+      EchoRequest request;
+      EchoResponse response;
+      request.set_message("startup");
+      Status status = stub->Echo(&context, request, &response);
+      GPR_ASSERT(status.ok());
+      state.PauseTiming();
+    }
+    server->Shutdown();
+    server.reset();
+    ShutdownLibrary();
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(BM_GrpcInitAndFirstUnaryRpc)->UseRealTime();
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
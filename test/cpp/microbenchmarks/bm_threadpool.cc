@@ -24,6 +24,7 @@
 #include <grpc/grpc.h>
 
 #include "src/core/lib/iomgr/executor/threadpool.h"
+#include "src/core/lib/iomgr/executor/work_stealing_threadpool.h"
 #include "test/core/util/test_config.h"
 #include "test/cpp/microbenchmarks/helpers.h"
 #include "test/cpp/util/test_config.h"
@@ -312,6 +313,240 @@ static void BM_SpikyLoad(benchmark::State& state) {
 }
 BENCHMARK(BM_SpikyLoad)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
 
+// The benchmarks below repeat the ones above against WorkStealingThreadPool,
+// which runs grpc_closures rather than grpc_completion_queue_functors.
+
+// Closure counterpart of AddAnotherFunctor.
+class AddAnotherClosure {
+ public:
+  AddAnotherClosure(grpc_core::WorkStealingThreadPool* pool,
+                    BlockingCounter* counter, int num_add)
+      : pool_(pool), counter_(counter), num_add_(num_add) {
+    GRPC_CLOSURE_INIT(&closure_, &AddAnotherClosure::Run, this, nullptr);
+  }
+  grpc_closure* closure() { return &closure_; }
+
+  static void Run(void* arg, grpc_error_handle /*error*/) {
+    auto* callback = static_cast<AddAnotherClosure*>(arg);
+    if (--callback->num_add_ > 0) {
+      callback->pool_->Run(
+          (new AddAnotherClosure(callback->pool_, callback->counter_,
+                                 callback->num_add_))
+              ->closure(),
+          GRPC_ERROR_NONE);
+    } else {
+      callback->counter_->DecrementCount();
+    }
+    // Suicides.
+    delete callback;
+  }
+
+ private:
+  grpc_core::WorkStealingThreadPool* pool_;
+  BlockingCounter* counter_;
+  int num_add_;
+  grpc_closure closure_;
+};
+
+template <int kConcurrentFunctor>
+static void WorkStealingAddAnother(benchmark::State& state) {
+  const int num_iterations = state.range(0);
+  const int num_threads = state.range(1);
+  // Number of adds done by each closure.
+  const int num_add = num_iterations / kConcurrentFunctor;
+  grpc_core::WorkStealingThreadPool pool(num_threads);
+  while (state.KeepRunningBatch(num_iterations)) {
+    BlockingCounter counter(kConcurrentFunctor);
+    for (int i = 0; i < kConcurrentFunctor; ++i) {
+      pool.Run((new AddAnotherClosure(&pool, &counter, num_add))->closure(),
+               GRPC_ERROR_NONE);
+    }
+    counter.Wait();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(WorkStealingAddAnother, 1)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingAddAnother, 4)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingAddAnother, 8)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingAddAnother, 16)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingAddAnother, 32)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingAddAnother, 64)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingAddAnother, 128)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingAddAnother, 512)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingAddAnother, 2048)
+    ->RangePair(524288, 524288, 1, 1024);
+
+// Closure counterpart of SuicideFunctorForAdd.
+class SuicideClosureForAdd {
+ public:
+  explicit SuicideClosureForAdd(BlockingCounter* counter) : counter_(counter) {
+    GRPC_CLOSURE_INIT(&closure_, &SuicideClosureForAdd::Run, this, nullptr);
+  }
+  grpc_closure* closure() { return &closure_; }
+
+  static void Run(void* arg, grpc_error_handle /*error*/) {
+    auto* callback = static_cast<SuicideClosureForAdd*>(arg);
+    callback->counter_->DecrementCount();
+    delete callback;
+  }
+
+ private:
+  BlockingCounter* counter_;
+  grpc_closure closure_;
+};
+
+// Performs the scenario of external thread(s) adding closures into pool.
+static void BM_WorkStealingExternalAdd(benchmark::State& state) {
+  static grpc_core::WorkStealingThreadPool* external_add_pool = nullptr;
+  int thread_idx = state.thread_index();
+  // Setup for each run of test.
+  if (thread_idx == 0) {
+    const int num_threads = state.range(1);
+    external_add_pool = new grpc_core::WorkStealingThreadPool(num_threads);
+  }
+  const int num_iterations = state.range(0) / state.threads();
+  while (state.KeepRunningBatch(num_iterations)) {
+    BlockingCounter counter(num_iterations);
+    for (int i = 0; i < num_iterations; ++i) {
+      external_add_pool->Run((new SuicideClosureForAdd(&counter))->closure(),
+                             GRPC_ERROR_NONE);
+    }
+    counter.Wait();
+  }
+
+  // Teardown at the end of each test run.
+  if (thread_idx == 0) {
+    state.SetItemsProcessed(state.range(0));
+    delete external_add_pool;
+  }
+}
+BENCHMARK(BM_WorkStealingExternalAdd)
+    // First pair is range for number of iterations (num_iterations).
+    // Second pair is range for thread pool size (num_threads).
+    ->RangePair(524288, 524288, 1, 1024)
+    ->ThreadRange(1, 256);  // Concurrent external thread(s) up to 256
+
+// Closure counterpart of AddSelfFunctor.
+class AddSelfClosure {
+ public:
+  AddSelfClosure(grpc_core::WorkStealingThreadPool* pool,
+                 BlockingCounter* counter, int num_add)
+      : pool_(pool), counter_(counter), num_add_(num_add) {
+    GRPC_CLOSURE_INIT(&closure_, &AddSelfClosure::Run, this, nullptr);
+  }
+  grpc_closure* closure() { return &closure_; }
+
+  static void Run(void* arg, grpc_error_handle /*error*/) {
+    auto* callback = static_cast<AddSelfClosure*>(arg);
+    if (--callback->num_add_ > 0) {
+      callback->pool_->Run(&callback->closure_, GRPC_ERROR_NONE);
+    } else {
+      callback->counter_->DecrementCount();
+      // Suicides.
+      delete callback;
+    }
+  }
+
+ private:
+  grpc_core::WorkStealingThreadPool* pool_;
+  BlockingCounter* counter_;
+  int num_add_;
+  grpc_closure closure_;
+};
+
+template <int kConcurrentFunctor>
+static void WorkStealingAddSelf(benchmark::State& state) {
+  const int num_iterations = state.range(0);
+  const int num_threads = state.range(1);
+  // Number of adds done by each closure.
+  const int num_add = num_iterations / kConcurrentFunctor;
+  grpc_core::WorkStealingThreadPool pool(num_threads);
+  while (state.KeepRunningBatch(num_iterations)) {
+    BlockingCounter counter(kConcurrentFunctor);
+    for (int i = 0; i < kConcurrentFunctor; ++i) {
+      pool.Run((new AddSelfClosure(&pool, &counter, num_add))->closure(),
+               GRPC_ERROR_NONE);
+    }
+    counter.Wait();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(WorkStealingAddSelf, 1)->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingAddSelf, 4)->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingAddSelf, 8)->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingAddSelf, 16)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingAddSelf, 32)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingAddSelf, 64)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingAddSelf, 128)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingAddSelf, 512)
+    ->RangePair(524288, 524288, 1, 1024);
+BENCHMARK_TEMPLATE(WorkStealingAddSelf, 2048)
+    ->RangePair(524288, 524288, 1, 1024);
+
+// Closure counterpart of ShortWorkFunctorForAdd.
+class ShortWorkClosureForAdd {
+ public:
+  BlockingCounter* counter_;
+
+  ShortWorkClosureForAdd() {
+    GRPC_CLOSURE_INIT(&closure_, &ShortWorkClosureForAdd::Run, this, nullptr);
+    val_ = 0;
+  }
+  grpc_closure* closure() { return &closure_; }
+
+  static void Run(void* arg, grpc_error_handle /*error*/) {
+    auto* callback = static_cast<ShortWorkClosureForAdd*>(arg);
+    // Uses pad to avoid compiler complaining unused variable error.
+    callback->pad[0] = 0;
+    for (int i = 0; i < 1000; ++i) {
+      callback->val_++;
+    }
+    callback->counter_->DecrementCount();
+  }
+
+ private:
+  grpc_closure closure_;
+  char pad[CACHELINE_SIZE];
+  volatile int val_;
+};
+
+// Same as BM_SpikyLoad. Idle workers of the work-stealing pool also sleep
+// between spikes, so this measures how quickly they pick work up again.
+static void BM_WorkStealingSpikyLoad(benchmark::State& state) {
+  const int num_threads = state.range(0);
+
+  const int kNumSpikes = 1000;
+  const int batch_size = 3 * num_threads;
+  std::vector<ShortWorkClosureForAdd> work_vector(batch_size);
+  grpc_core::WorkStealingThreadPool pool(num_threads);
+  while (state.KeepRunningBatch(kNumSpikes * batch_size)) {
+    for (int i = 0; i != kNumSpikes; ++i) {
+      BlockingCounter counter(batch_size);
+      for (auto& w : work_vector) {
+        w.counter_ = &counter;
+        pool.Run(w.closure(), GRPC_ERROR_NONE);
+      }
+      counter.Wait();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+BENCHMARK(BM_WorkStealingSpikyLoad)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -0,0 +1,173 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Compares the timer implementations with many outstanding timers */
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/iomgr/timer_manager.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+extern grpc_timer_vtable* grpc_timer_impl;
+extern grpc_timer_vtable grpc_generic_timer_vtable;
+extern grpc_timer_vtable grpc_wheel_timer_vtable;
+
+namespace grpc {
+namespace testing {
+
+/* The range over which BM_TimerFire spreads its deadlines */
+static constexpr int64_t kFireWindowMs = 1000;
+
+/* Selects the implementation under test from the first benchmark argument */
+static grpc_timer_vtable* TimerImpl(int64_t index) {
+  return index == 0 ? &grpc_generic_timer_vtable : &grpc_wheel_timer_vtable;
+}
+
+/* Initializes the timer list of an implementation for the duration of one
+   benchmark, unless grpc_init already did. Timer manager threads are disabled
+   in main(), so only the benchmark drives the list. */
+class ScopedTimerList {
+ public:
+  explicit ScopedTimerList(grpc_timer_vtable* vtable)
+      : vtable_(vtable), owned_(vtable != grpc_timer_impl) {
+    if (owned_) vtable_->list_init();
+  }
+  ~ScopedTimerList() {
+    if (owned_) vtable_->list_shutdown();
+  }
+
+  grpc_timer_vtable* operator->() const { return vtable_; }
+
+ private:
+  grpc_timer_vtable* vtable_;
+  bool owned_;
+};
+
+struct TimerEntry {
+  grpc_timer timer;
+  grpc_closure closure;
+};
+
+static void DoNothing(void* /*arg*/, grpc_error_handle /*error*/) {}
+
+static void InitEntries(std::vector<TimerEntry>* entries) {
+  for (TimerEntry& entry : *entries) {
+    GRPC_CLOSURE_INIT(&entry.closure, DoNothing, nullptr,
+                      grpc_schedule_on_exec_ctx);
+  }
+}
+
+/* One timer set and cancelled per iteration, on top of state.range(1) timers
+   outstanding with deadlines spread over the next hour. */
+static void BM_TimerInitCancel(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  ScopedTimerList timers(TimerImpl(state.range(0)));
+  std::vector<TimerEntry> entries(state.range(1) + 1);
+  InitEntries(&entries);
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int64_t> delay_ms(1000, 3600 * 1000);
+  grpc_core::Timestamp now = grpc_core::ExecCtx::Get()->Now();
+  TimerEntry& probe = entries.back();
+  for (size_t i = 0; i + 1 < entries.size(); i++) {
+    timers->init(&entries[i].timer,
+                 now + grpc_core::Duration::Milliseconds(delay_ms(rng)),
+                 &entries[i].closure);
+  }
+  for (auto _ : state) {
+    timers->init(&probe.timer,
+                 now + grpc_core::Duration::Milliseconds(delay_ms(rng)),
+                 &probe.closure);
+    timers->cancel(&probe.timer);
+    exec_ctx.Flush();
+  }
+  for (size_t i = 0; i + 1 < entries.size(); i++) {
+    timers->cancel(&entries[i].timer);
+  }
+  exec_ctx.Flush();
+  state.SetItemsProcessed(state.iterations());
+  track_counters.Finish(state);
+}
+
+/* Each iteration sets state.range(1) timers due within the next
+   kFireWindowMs, then advances time by one millisecond at a time, checking
+   the timers after each step, until all of them have fired. */
+static void BM_TimerFire(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_core::ExecCtx exec_ctx;
+  ScopedTimerList timers(TimerImpl(state.range(0)));
+  std::vector<TimerEntry> entries(state.range(1));
+  InitEntries(&entries);
+  for (auto _ : state) {
+    grpc_core::Timestamp start = grpc_core::ExecCtx::Get()->Now();
+    for (size_t i = 0; i < entries.size(); i++) {
+      timers->init(&entries[i].timer,
+                   start + grpc_core::Duration::Milliseconds(
+                               1 + static_cast<int64_t>(i) % kFireWindowMs),
+                   &entries[i].closure);
+    }
+    for (int64_t t = 1; t <= kFireWindowMs; t++) {
+      exec_ctx.TestOnlySetNow(start + grpc_core::Duration::Milliseconds(t));
+      /* Stand in for the timer manager thread that would have been kicked */
+      timers->consume_kick();
+      timers->check(nullptr);
+      exec_ctx.Flush();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+  track_counters.Finish(state);
+}
+
+static void TimerArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"wheel", "outstanding"});
+  for (int impl = 0; impl <= 1; impl++) {
+    for (int outstanding : {1, 1024, 1 << 20}) {
+      b->Args({impl, outstanding});
+    }
+  }
+}
+BENCHMARK(BM_TimerInitCancel)->Apply(TimerArgs);
+BENCHMARK(BM_TimerFire)->Apply(TimerArgs);
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  grpc_timer_manager_set_threading(false);
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
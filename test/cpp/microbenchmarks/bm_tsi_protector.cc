@@ -0,0 +1,209 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark TSI frame protectors and handshakes: a message protected by the
+   client and unprotected by the server, for the fake, ALTS and TLS
+   protectors, and complete TLS handshakes. */
+
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/tsi/fake_transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/microbenchmarks/tsi_fixtures.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+constexpr size_t kFrameBufferSize = 16384;
+
+void SetCounters(benchmark::State& state, const char* name) {
+  state.SetLabel(name);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// Appends the protected frames of message to protected_bytes.
+void Protect(tsi_frame_protector* protector, const std::string& message,
+             std::vector<unsigned char>* protected_bytes) {
+  unsigned char frames[kFrameBufferSize];
+  const unsigned char* bytes =
+      reinterpret_cast<const unsigned char*>(message.data());
+  size_t remaining = message.size();
+  while (remaining > 0) {
+    size_t consumed = remaining;
+    size_t written = sizeof(frames);
+    GPR_ASSERT(tsi_frame_protector_protect(protector, bytes, &consumed, frames,
+                                           &written) == TSI_OK);
+    protected_bytes->insert(protected_bytes->end(), frames, frames + written);
+    bytes += consumed;
+    remaining -= consumed;
+  }
+  size_t still_pending;
+  do {
+    size_t written = sizeof(frames);
+    GPR_ASSERT(tsi_frame_protector_protect_flush(protector, frames, &written,
+                                                 &still_pending) == TSI_OK);
+    protected_bytes->insert(protected_bytes->end(), frames, frames + written);
+  } while (still_pending > 0);
+}
+
+// Returns the number of bytes recovered from protected_bytes.
+size_t Unprotect(tsi_frame_protector* protector,
+                 const std::vector<unsigned char>& protected_bytes) {
+  unsigned char message[kFrameBufferSize];
+  size_t offset = 0;
+  size_t total = 0;
+  bool output_full;
+  do {
+    size_t consumed = protected_bytes.size() - offset;
+    size_t written = sizeof(message);
+    GPR_ASSERT(tsi_frame_protector_unprotect(
+                   protector, protected_bytes.data() + offset, &consumed,
+                   message, &written) == TSI_OK);
+    offset += consumed;
+    total += written;
+    output_full = written == sizeof(message);
+  } while (offset < protected_bytes.size() || output_full);
+  return total;
+}
+
+template <class Fixture>
+void BM_FrameProtector(benchmark::State& state) {
+  TsiProtectors protectors;
+  Fixture::CreateProtectors(/*zero_copy=*/false, &protectors);
+  const std::string message(state.range(0), 'a');
+  std::vector<unsigned char> protected_bytes;
+  for (auto _ : state) {
+    protected_bytes.clear();
+    Protect(protectors.client, message, &protected_bytes);
+    GPR_ASSERT(Unprotect(protectors.server, protected_bytes) ==
+               message.size());
+  }
+  SetCounters(state, Fixture::Name());
+}
+
+template <class Fixture>
+void BM_ZeroCopyProtector(benchmark::State& state) {
+  TsiProtectors protectors;
+  Fixture::CreateProtectors(/*zero_copy=*/true, &protectors);
+  grpc_slice message = grpc_slice_malloc(state.range(0));
+  memset(GRPC_SLICE_START_PTR(message), 'a', GRPC_SLICE_LENGTH(message));
+  grpc_slice_buffer unprotected;
+  grpc_slice_buffer protected_slices;
+  grpc_slice_buffer_init(&unprotected);
+  grpc_slice_buffer_init(&protected_slices);
+  for (auto _ : state) {
+    grpc_slice_buffer_add(&unprotected, grpc_slice_ref(message));
+    GPR_ASSERT(tsi_zero_copy_grpc_protector_protect(
+                   protectors.client_zero_copy, &unprotected,
+                   &protected_slices) == TSI_OK);
+    GPR_ASSERT(tsi_zero_copy_grpc_protector_unprotect(
+                   protectors.server_zero_copy, &protected_slices,
+                   &unprotected) == TSI_OK);
+    GPR_ASSERT(unprotected.length == GRPC_SLICE_LENGTH(message));
+    grpc_slice_buffer_reset_and_unref(&unprotected);
+  }
+  grpc_slice_buffer_destroy(&unprotected);
+  grpc_slice_buffer_destroy(&protected_slices);
+  grpc_slice_unref(message);
+  SetCounters(state, Fixture::Name());
+}
+
+void MessageSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"bytes"});
+  for (int bytes : {64, 1024, 16384, 65536, 1 << 20}) b->Arg(bytes);
+}
+
+BENCHMARK_TEMPLATE(BM_FrameProtector, FakeTsi)->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_FrameProtector, AltsTsi<false>)->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_FrameProtector, SslTsi)->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_ZeroCopyProtector, FakeTsi)->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_ZeroCopyProtector, AltsTsi<false>)->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_ZeroCopyProtector, AltsTsi<true>)->Apply(MessageSizes);
+BENCHMARK_TEMPLATE(BM_ZeroCopyProtector, SslTsi)->Apply(MessageSizes);
+
+// Complete handshakes, without the network. The ALTS handshake is done by
+// the handshaker service, so it is not covered here.
+void BM_SslHandshake(benchmark::State& state) {
+  SslTsi* ssl = SslTsi::Get();
+  for (auto _ : state) {
+    tsi_handshaker* client;
+    tsi_handshaker* server;
+    ssl->CreateHandshakers(&client, &server);
+    tsi_handshaker_result* client_result;
+    tsi_handshaker_result* server_result;
+    GPR_ASSERT(
+        DoTsiHandshake(client, server, &client_result, &server_result));
+    tsi_handshaker_result_destroy(client_result);
+    tsi_handshaker_result_destroy(server_result);
+    tsi_handshaker_destroy(client);
+    tsi_handshaker_destroy(server);
+  }
+  state.SetLabel(SslTsi::Name());
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SslHandshake);
+
+void BM_FakeHandshake(benchmark::State& state) {
+  for (auto _ : state) {
+    tsi_handshaker* client = tsi_create_fake_handshaker(/*is_client=*/1);
+    tsi_handshaker* server = tsi_create_fake_handshaker(/*is_client=*/0);
+    tsi_handshaker_result* client_result;
+    tsi_handshaker_result* server_result;
+    GPR_ASSERT(
+        DoTsiHandshake(client, server, &client_result, &server_result));
+    tsi_handshaker_result_destroy(client_result);
+    tsi_handshaker_result_destroy(server_result);
+    tsi_handshaker_destroy(client);
+    tsi_handshaker_destroy(server);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FakeHandshake);
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
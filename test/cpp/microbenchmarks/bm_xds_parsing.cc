@@ -0,0 +1,334 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark decoding of xDS EDS and RDS resources, the comparison with the
+   previous version of a resource that decides whether watchers are
+   notified, and the memory that decoding takes. */
+
+#include <stdlib.h>
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/hash/hash.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "envoy/config/core/v3/address.upb.h"
+#include "envoy/config/core/v3/base.upb.h"
+#include "envoy/config/endpoint/v3/endpoint.upb.h"
+#include "envoy/config/endpoint/v3/endpoint_components.upb.h"
+#include "envoy/config/route/v3/route.upb.h"
+#include "envoy/config/route/v3/route_components.upb.h"
+#include "envoy/type/matcher/v3/regex.upb.h"
+#include "google/protobuf/wrappers.upb.h"
+#include "upb/def.hpp"
+#include "upb/upb.hpp"
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/xds/upb_utils.h"
+#include "src/core/ext/xds/xds_bootstrap.h"
+#include "src/core/ext/xds/xds_client.h"
+#include "src/core/ext/xds/xds_endpoint.h"
+#include "src/core/ext/xds/xds_route_config.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+constexpr int kNumLocalities = 10;
+
+// Returns a serialized ClusterLoadAssignment with num_endpoints endpoints
+// spread over kNumLocalities localities.
+std::string MakeClusterLoadAssignment(int num_endpoints) {
+  upb::Arena arena;
+  std::vector<std::string> strings;
+  strings.reserve(num_endpoints + kNumLocalities + 1);
+  auto string_view = [&strings](std::string s) {
+    strings.push_back(std::move(s));
+    return grpc_core::StdStringToUpbString(strings.back());
+  };
+  auto* cla = envoy_config_endpoint_v3_ClusterLoadAssignment_new(arena.ptr());
+  envoy_config_endpoint_v3_ClusterLoadAssignment_set_cluster_name(
+      cla, string_view("eds_service_name"));
+  for (int i = 0; i < kNumLocalities; ++i) {
+    auto* locality_endpoints =
+        envoy_config_endpoint_v3_ClusterLoadAssignment_add_endpoints(
+            cla, arena.ptr());
+    auto* locality =
+        envoy_config_endpoint_v3_LocalityLbEndpoints_mutable_locality(
+            locality_endpoints, arena.ptr());
+    envoy_config_core_v3_Locality_set_region(locality, string_view("region"));
+    envoy_config_core_v3_Locality_set_zone(
+        locality, string_view(absl::StrCat("zone", i)));
+    auto* weight =
+        envoy_config_endpoint_v3_LocalityLbEndpoints_mutable_load_balancing_weight(
+            locality_endpoints, arena.ptr());
+    google_protobuf_UInt32Value_set_value(weight, 1);
+    for (int j = i; j < num_endpoints; j += kNumLocalities) {
+      auto* lb_endpoint =
+          envoy_config_endpoint_v3_LocalityLbEndpoints_add_lb_endpoints(
+              locality_endpoints, arena.ptr());
+      auto* endpoint = envoy_config_endpoint_v3_LbEndpoint_mutable_endpoint(
+          lb_endpoint, arena.ptr());
+      auto* socket_address =
+          envoy_config_core_v3_Address_mutable_socket_address(
+              envoy_config_endpoint_v3_Endpoint_mutable_address(endpoint,
+                                                                arena.ptr()),
+              arena.ptr());
+      envoy_config_core_v3_SocketAddress_set_address(
+          socket_address,
+          string_view(absl::StrCat("10.", j / 65536, ".", (j / 256) % 256, ".",
+                                   j % 256)));
+      envoy_config_core_v3_SocketAddress_set_port_value(socket_address, 443);
+    }
+  }
+  size_t size;
+  char* serialized = envoy_config_endpoint_v3_ClusterLoadAssignment_serialize(
+      cla, arena.ptr(), &size);
+  return std::string(serialized, size);
+}
+
+// A route table as a control plane generates it for num_services
+// services, shaped like the one in bm_xds_routing: one virtual host per
+// service with a header-based canary route, a few method routes, a regex
+// route and a service-wide prefix, then a wildcard virtual host.
+std::string MakeRouteConfiguration(int num_services) {
+  upb::Arena arena;
+  std::vector<std::string> strings;
+  strings.reserve(num_services * 16 + 1);
+  auto string_view = [&strings](std::string s) {
+    strings.push_back(std::move(s));
+    return grpc_core::StdStringToUpbString(strings.back());
+  };
+  auto add_route = [&](envoy_config_route_v3_VirtualHost* virtual_host,
+                       const std::string& cluster) {
+    auto* route =
+        envoy_config_route_v3_VirtualHost_add_routes(virtual_host, arena.ptr());
+    envoy_config_route_v3_RouteAction_set_cluster(
+        envoy_config_route_v3_Route_mutable_route(route, arena.ptr()),
+        string_view(cluster));
+    return envoy_config_route_v3_Route_mutable_match(route, arena.ptr());
+  };
+  auto* route_config =
+      envoy_config_route_v3_RouteConfiguration_new(arena.ptr());
+  envoy_config_route_v3_RouteConfiguration_set_name(
+      route_config, string_view("route_config_name"));
+  for (int i = 0; i < num_services; ++i) {
+    auto* virtual_host =
+        envoy_config_route_v3_RouteConfiguration_add_virtual_hosts(
+            route_config, arena.ptr());
+    for (std::string domain : {absl::StrCat("service", i, ".example.com"),
+                               absl::StrCat("service", i, ".example.com:443"),
+                               absl::StrCat("*.service", i, ".example.com")}) {
+      envoy_config_route_v3_VirtualHost_add_domains(
+          virtual_host, string_view(std::move(domain)), arena.ptr());
+    }
+    const std::string service = absl::StrCat("/pkg.Service", i, "/");
+    const std::string cluster = absl::StrCat("cluster", i);
+    auto* canary = add_route(virtual_host, absl::StrCat(cluster, "-canary"));
+    envoy_config_route_v3_RouteMatch_set_prefix(canary, string_view(service));
+    auto* header =
+        envoy_config_route_v3_RouteMatch_add_headers(canary, arena.ptr());
+    envoy_config_route_v3_HeaderMatcher_set_name(header,
+                                                 string_view("x-canary"));
+    envoy_config_route_v3_HeaderMatcher_set_exact_match(header,
+                                                        string_view("true"));
+    for (int j = 0; j < 4; ++j) {
+      envoy_config_route_v3_RouteMatch_set_path(
+          add_route(virtual_host, cluster),
+          string_view(absl::StrCat(service, "Method", j)));
+    }
+    envoy_type_matcher_v3_RegexMatcher_set_regex(
+        envoy_config_route_v3_RouteMatch_mutable_safe_regex(
+            add_route(virtual_host, cluster), arena.ptr()),
+        string_view(absl::StrCat("/pkg\\.Service", i, "/(List|Watch)[A-Z].*")));
+    envoy_config_route_v3_RouteMatch_set_prefix(
+        add_route(virtual_host, cluster), string_view(service));
+  }
+  auto* default_host =
+      envoy_config_route_v3_RouteConfiguration_add_virtual_hosts(
+          route_config, arena.ptr());
+  envoy_config_route_v3_VirtualHost_add_domains(default_host, string_view("*"),
+                                                arena.ptr());
+  envoy_config_route_v3_RouteMatch_set_prefix(
+      add_route(default_host, "default_cluster"), string_view(""));
+  size_t size;
+  char* serialized = envoy_config_route_v3_RouteConfiguration_serialize(
+      route_config, arena.ptr(), &size);
+  return std::string(serialized, size);
+}
+
+// Counts the bytes that an arena takes from the heap: the memory the
+// decoded upb messages of a resource hold while it is parsed.
+struct CountingAlloc {
+  static void* Alloc(upb_alloc* alloc, void* ptr, size_t /*oldsize*/,
+                     size_t size) {
+    if (size == 0) {
+      free(ptr);
+      return nullptr;
+    }
+    reinterpret_cast<CountingAlloc*>(alloc)->bytes += size;
+    return realloc(ptr, size);
+  }
+
+  upb_alloc alloc = {&CountingAlloc::Alloc};
+  size_t bytes = 0;
+};
+
+// Decodes a resource as XdsApi does for ADS responses.
+std::unique_ptr<grpc_core::XdsResourceType::ResourceData> Decode(
+    const grpc_core::XdsResourceType* type, absl::string_view serialized,
+    upb_DefPool* symtab, upb_Arena* arena) {
+  static const grpc_core::XdsBootstrap::XdsServer* server = [] {
+    auto* server = new grpc_core::XdsBootstrap::XdsServer();
+    server->server_features.insert("xds_v3");
+    return server;
+  }();
+  const grpc_core::XdsEncodingContext context = {
+      nullptr, *server, &grpc_core::grpc_xds_client_trace, symtab, arena, true,
+      nullptr};
+  auto result = type->Decode(context, serialized, false);
+  GPR_ASSERT(result.ok() && result->resource.ok());
+  return std::move(*result->resource);
+}
+
+// Reports the heap bytes an arena took per decode.
+void SetArenaBytes(benchmark::State& state, const CountingAlloc& alloc) {
+  state.counters["arena_bytes"] = benchmark::Counter(
+      static_cast<double>(alloc.bytes), benchmark::Counter::kAvgIterations);
+}
+
+}  // namespace
+
+// Args: number of endpoints, arena initial block reused across decodes as
+// XdsApi does for ADS responses.
+static void BM_XdsEdsDecode(benchmark::State& state) {
+  grpc_core::ExecCtx exec_ctx;
+  const std::string serialized = MakeClusterLoadAssignment(state.range(0));
+  const bool reuse_arena_block = state.range(1) != 0;
+  const size_t block_size = serialized.size() * 4;
+  auto block = absl::make_unique<char[]>(block_size);
+  upb::SymbolTable symtab;
+  CountingAlloc alloc;
+  for (auto _ : state) {
+    upb_Arena* arena =
+        reuse_arena_block
+            ? upb_Arena_Init(block.get(), block_size, &alloc.alloc)
+            : upb_Arena_Init(nullptr, 0, &alloc.alloc);
+    Decode(grpc_core::XdsEndpointResourceType::Get(), serialized,
+           symtab.ptr(), arena);
+    upb_Arena_Free(arena);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * serialized.size());
+  SetArenaBytes(state, alloc);
+}
+BENCHMARK(BM_XdsEdsDecode)
+    ->ArgNames({"endpoints", "reuse_block"})
+    ->ArgsProduct({{100, 10000}, {0, 1}});
+
+// Args: number of services.
+static void BM_XdsRdsDecode(benchmark::State& state) {
+  grpc_core::ExecCtx exec_ctx;
+  const std::string serialized = MakeRouteConfiguration(state.range(0));
+  upb::SymbolTable symtab;
+  grpc_core::XdsRouteConfigResourceType::Get()->InitUpbSymtab(symtab.ptr());
+  CountingAlloc alloc;
+  for (auto _ : state) {
+    upb_Arena* arena = upb_Arena_Init(nullptr, 0, &alloc.alloc);
+    Decode(grpc_core::XdsRouteConfigResourceType::Get(), serialized,
+           symtab.ptr(), arena);
+    upb_Arena_Free(arena);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * serialized.size());
+  SetArenaBytes(state, alloc);
+}
+BENCHMARK(BM_XdsRdsDecode)->ArgName("services")->Arg(10)->Arg(1000);
+
+// Compares a decoded resource with an equal one, as XdsClient does with the
+// resource it has before notifying watchers of an update. Args: number of
+// endpoints or services.
+template <class ResourceType>
+static void BM_XdsResourcesEqual(benchmark::State& state) {
+  grpc_core::ExecCtx exec_ctx;
+  const std::string serialized =
+      std::is_same<ResourceType, grpc_core::XdsEndpointResourceType>::value
+          ? MakeClusterLoadAssignment(state.range(0))
+          : MakeRouteConfiguration(state.range(0));
+  upb::SymbolTable symtab;
+  ResourceType::Get()->InitUpbSymtab(symtab.ptr());
+  upb::Arena arena;
+  auto resource =
+      Decode(ResourceType::Get(), serialized, symtab.ptr(), arena.ptr());
+  auto previous =
+      Decode(ResourceType::Get(), serialized, symtab.ptr(), arena.ptr());
+  for (auto _ : state) {
+    GPR_ASSERT(
+        ResourceType::Get()->ResourcesEqual(resource.get(), previous.get()));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_XdsResourcesEqual, grpc_core::XdsEndpointResourceType)
+    ->ArgName("endpoints")
+    ->Arg(100)
+    ->Arg(10000);
+BENCHMARK_TEMPLATE(BM_XdsResourcesEqual, grpc_core::XdsRouteConfigResourceType)
+    ->ArgName("services")
+    ->Arg(10)
+    ->Arg(1000);
+
+// What XdsClient does instead of decoding when the server resends an
+// unchanged resource: hash the serialized resource and compare it with the
+// one it has.
+static void BM_XdsEdsUnchangedCheck(benchmark::State& state) {
+  const std::string serialized = MakeClusterLoadAssignment(state.range(0));
+  const std::string cached = serialized;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(absl::Hash<absl::string_view>()(serialized));
+    benchmark::DoNotOptimize(cached == serialized);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * serialized.size());
+}
+BENCHMARK(BM_XdsEdsUnchangedCheck)
+    ->ArgName("endpoints")
+    ->Arg(100)
+    ->Arg(10000);
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/* Benchmark xDS route and virtual host selection */
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/xds/xds_route_config.h"
+#include "src/core/ext/xds/xds_routing.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/matchers/matchers.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+using Matchers = grpc_core::XdsRouteConfigResource::Route::Matchers;
+
+class RouteListIterator : public grpc_core::XdsRouting::RouteListIterator {
+ public:
+  explicit RouteListIterator(const std::vector<Matchers>* routes)
+      : routes_(routes) {}
+
+  size_t Size() const override { return routes_->size(); }
+
+  const Matchers& GetMatchersForRoute(size_t index) const override {
+    return (*routes_)[index];
+  }
+
+ private:
+  const std::vector<Matchers>* routes_;
+};
+
+class VirtualHostListIterator
+    : public grpc_core::XdsRouting::VirtualHostListIterator {
+ public:
+  explicit VirtualHostListIterator(
+      const std::vector<std::vector<std::string>>* domains)
+      : domains_(domains) {}
+
+  size_t Size() const override { return domains_->size(); }
+
+  const std::vector<std::string>& GetDomainsForVirtualHost(
+      size_t index) const override {
+    return (*domains_)[index];
+  }
+
+ private:
+  const std::vector<std::vector<std::string>>* domains_;
+};
+
+Matchers MakeRoute(grpc_core::StringMatcher::Type type,
+                   absl::string_view path) {
+  Matchers matchers;
+  matchers.path_matcher =
+      grpc_core::StringMatcher::Create(type, path).value();
+  return matchers;
+}
+
+// A route table as a control plane generates it for num_services
+// services: per service, a header-based canary route, a few method
+// routes, a regex route and a service-wide prefix, then a default route.
+std::vector<Matchers> MakeRouteTable(int num_services) {
+  std::vector<Matchers> routes;
+  for (int i = 0; i < num_services; ++i) {
+    const std::string service = absl::StrCat("/pkg.Service", i, "/");
+    Matchers canary =
+        MakeRoute(grpc_core::StringMatcher::Type::kPrefix, service);
+    canary.header_matchers.push_back(
+        grpc_core::HeaderMatcher::Create(
+            "x-canary", grpc_core::HeaderMatcher::Type::kExact, "true")
+            .value());
+    routes.push_back(std::move(canary));
+    for (int j = 0; j < 4; ++j) {
+      routes.push_back(MakeRoute(grpc_core::StringMatcher::Type::kExact,
+                                 absl::StrCat(service, "Method", j)));
+    }
+    routes.push_back(
+        MakeRoute(grpc_core::StringMatcher::Type::kSafeRegex,
+                  absl::StrCat("/pkg\\.Service", i, "/(List|Watch)[A-Z].*")));
+    routes.push_back(
+        MakeRoute(grpc_core::StringMatcher::Type::kPrefix, service));
+  }
+  routes.push_back(MakeRoute(grpc_core::StringMatcher::Type::kPrefix, ""));
+  return routes;
+}
+
+// One virtual host per service, plus a wildcard one.
+std::vector<std::vector<std::string>> MakeDomains(int num_services) {
+  std::vector<std::vector<std::string>> domains;
+  for (int i = 0; i < num_services; ++i) {
+    domains.push_back({absl::StrCat("service", i, ".example.com"),
+                       absl::StrCat("service", i, ".example.com:443"),
+                       absl::StrCat("*.service", i, ".example.com")});
+  }
+  domains.push_back({"*"});
+  return domains;
+}
+
+auto* g_memory_allocator = new grpc_core::MemoryAllocator(
+    grpc_core::ResourceQuota::Default()->memory_quota()->CreateMemoryAllocator(
+        "test"));
+
+}  // namespace
+
+// Args: number of services, compiled route index. Requests go to a regex
+// route of the last service, which is near the end of the table.
+static void BM_XdsRouteSelection(benchmark::State& state) {
+  grpc_core::ExecCtx exec_ctx;
+  const int num_services = state.range(0);
+  const std::vector<Matchers> routes = MakeRouteTable(num_services);
+  const RouteListIterator iterator(&routes);
+  const grpc_core::XdsRouting::RouteIndex index(iterator);
+  const std::string path =
+      absl::StrCat("/pkg.Service", num_services - 1, "/ListThings");
+  auto arena = grpc_core::MakeScopedArena(1024, g_memory_allocator);
+  grpc_metadata_batch md(arena.get());
+  if (state.range(1) != 0) {
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(index.GetRouteForRequest(iterator, path, &md));
+    }
+  } else {
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(
+          grpc_core::XdsRouting::GetRouteForRequest(iterator, path, &md));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_XdsRouteSelection)
+    ->ArgNames({"services", "indexed"})
+    ->ArgsProduct({{1, 16, 128}, {0, 1}});
+
+// Args: number of services, compiled virtual host index. Requests go to
+// the wildcard domain of the last service.
+static void BM_XdsVirtualHostSelection(benchmark::State& state) {
+  const int num_services = state.range(0);
+  const std::vector<std::vector<std::string>> domains =
+      MakeDomains(num_services);
+  const VirtualHostListIterator iterator(&domains);
+  const grpc_core::XdsRouting::VirtualHostIndex index(iterator);
+  const std::string host =
+      absl::StrCat("canary.service", num_services - 1, ".example.com");
+  if (state.range(1) != 0) {
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(index.FindVirtualHostForDomain(host));
+    }
+  } else {
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(
+          grpc_core::XdsRouting::FindVirtualHostForDomain(iterator, host));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_XdsVirtualHostSelection)
+    ->ArgNames({"services", "indexed"})
+    ->ArgsProduct({{1, 16, 128}, {0, 1}});
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -38,21 +38,28 @@ namespace testing {
  * BENCHMARKING KERNELS
  */
 
+// If reset_context is set, the client context is reset between calls
+// rather than destroyed and constructed again.
 inline void SendCallbackUnaryPingPong(
     benchmark::State* state, ClientContext* cli_ctx, EchoRequest* request,
     EchoResponse* response, EchoTestService::Stub* stub_, bool* done,
-    std::mutex* mu, std::condition_variable* cv) {
+    std::mutex* mu, std::condition_variable* cv, bool reset_context) {
   int response_msgs_size = state->range(1);
   cli_ctx->AddMetadata(kServerMessageSize, std::to_string(response_msgs_size));
   stub_->async()->Echo(
       cli_ctx, request, response,
-      [state, cli_ctx, request, response, stub_, done, mu, cv](Status s) {
+      [state, cli_ctx, request, response, stub_, done, mu, cv,
+       reset_context](Status s) {
         GPR_ASSERT(s.ok());
         if (state->KeepRunning()) {
-          cli_ctx->~ClientContext();
-          new (cli_ctx) ClientContext();
+          if (reset_context) {
+            cli_ctx->Reset();
+          } else {
+            cli_ctx->~ClientContext();
+            new (cli_ctx) ClientContext();
+          }
           SendCallbackUnaryPingPong(state, cli_ctx, request, response, stub_,
-                                    done, mu, cv);
+                                    done, mu, cv, reset_context);
         } else {
           std::lock_guard<std::mutex> l(*mu);
           *done = true;
@@ -61,8 +68,9 @@ inline void SendCallbackUnaryPingPong(
       });
 };
 
-template <class Fixture, class ClientContextMutator, class ServerContextMutator>
-static void BM_CallbackUnaryPingPong(benchmark::State& state) {
+template <class Fixture>
+static void RunCallbackUnaryPingPong(benchmark::State& state,
+                                     bool reset_context) {
   int request_msgs_size = state.range(0);
   int response_msgs_size = state.range(1);
   CallbackStreamingTestService service;
@@ -85,7 +93,7 @@ static void BM_CallbackUnaryPingPong(benchmark::State& state) {
   if (state.KeepRunning()) {
     GPR_TIMER_SCOPE("BenchmarkCycle", 0);
     SendCallbackUnaryPingPong(&state, &cli_ctx, &request, &response,
-                              stub_.get(), &done, &mu, &cv);
+                              stub_.get(), &done, &mu, &cv, reset_context);
   }
   std::unique_lock<std::mutex> l(mu);
   while (!done) {
@@ -97,6 +105,17 @@ static void BM_CallbackUnaryPingPong(benchmark::State& state) {
                           response_msgs_size * state.iterations());
 }
 
+template <class Fixture, class ClientContextMutator, class ServerContextMutator>
+static void BM_CallbackUnaryPingPong(benchmark::State& state) {
+  RunCallbackUnaryPingPong<Fixture>(state, /*reset_context=*/false);
+}
+
+// Reuses one client context for all the calls, with ClientContext::Reset().
+template <class Fixture>
+static void BM_CallbackUnaryPingPongResetContext(benchmark::State& state) {
+  RunCallbackUnaryPingPong<Fixture>(state, /*reset_context=*/true);
+}
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -27,6 +27,8 @@
 #include <grpcpp/security/server_credentials.h>
 #include <grpcpp/server.h>
 #include <grpcpp/server_builder.h>
+#include <grpcpp/support/client_interceptor.h>
+#include <grpcpp/support/server_interceptor.h>
 
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
 #include "src/core/lib/channel/channel_args.h"
@@ -38,6 +40,7 @@
 #include "src/core/lib/surface/completion_queue.h"
 #include "src/core/lib/surface/server.h"
 #include "src/cpp/client/create_channel_internal.h"
+#include "test/core/util/network_emulation_endpoint.h"
 #include "test/core/util/passthru_endpoint.h"
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
@@ -59,6 +62,12 @@ class FixtureConfiguration {
     b->SetMaxReceiveMessageSize(INT_MAX);
     b->SetMaxSendMessageSize(INT_MAX);
   }
+
+  virtual std::vector<
+      std::unique_ptr<experimental::ClientInterceptorFactoryInterface>>
+  CreateClientInterceptors() const {
+    return {};
+  }
 };
 
 class BaseFixture : public TrackCounters {};
@@ -78,10 +87,12 @@ class FullstackFixture : public BaseFixture {
     ChannelArguments args;
     config.ApplyCommonChannelArguments(&args);
     if (address.length() > 0) {
-      channel_ = grpc::CreateCustomChannel(address,
-                                           InsecureChannelCredentials(), args);
+      channel_ = experimental::CreateCustomChannelWithInterceptors(
+          address, InsecureChannelCredentials(), args,
+          config.CreateClientInterceptors());
     } else {
-      channel_ = server_->InProcessChannel(args);
+      channel_ = server_->experimental().InProcessChannelWithInterceptors(
+          args, config.CreateClientInterceptors());
     }
   }
 
@@ -211,9 +222,7 @@ class EndpointPairFixture : public BaseFixture {
                                           nullptr);
 
       channel_ = grpc::CreateChannelInternal(
-          "", channel,
-          std::vector<std::unique_ptr<
-              experimental::ClientInterceptorFactoryInterface>>());
+          "", channel, fixture_configuration.CreateClientInterceptors());
     }
   }
 
@@ -303,6 +312,30 @@ class InProcessCHTTP2 : public InProcessCHTTP2WithExplicitStats {
                                          fixture_configuration) {}
 };
 
+/* A socketpair whose two directions each behave like the network path
+   returned by Profile::Get(), so that flow control and the BDP estimator run
+   against realistic bandwidth-delay products. */
+template <class Profile>
+class EmulatedNetwork : public EndpointPairFixture {
+ public:
+  explicit EmulatedNetwork(Service* service,
+                           const FixtureConfiguration& fixture_configuration =
+                               FixtureConfiguration())
+      : EndpointPairFixture(service, MakeEndpoints(), fixture_configuration) {}
+
+ private:
+  static grpc_endpoint_pair MakeEndpoints() {
+    grpc_endpoint_pair p = grpc_iomgr_create_endpoint_pair("test", nullptr);
+    grpc_core::testing::NetworkProfile profile = Profile::Get();
+    p.client =
+        grpc_core::testing::CreateNetworkEmulationEndpoint(p.client, profile);
+    profile.seed++;
+    p.server =
+        grpc_core::testing::CreateNetworkEmulationEndpoint(p.server, profile);
+    return p;
+  }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // Minimal stack fixtures
 
@@ -331,6 +364,90 @@ typedef MinStackize<InProcess> MinInProcess;
 typedef MinStackize<SockPair> MinSockPair;
 typedef MinStackize<InProcessCHTTP2> MinInProcessCHTTP2;
 
+class InlineCallbacksConfiguration : public FixtureConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetInt(GRPC_ARG_INLINE_CALLBACK_REACTIONS, 16);
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    b->AddChannelArgument(GRPC_ARG_INLINE_CALLBACK_REACTIONS, 16);
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+  }
+};
+
+template <class Base>
+class InlineCallbacksize : public Base {
+ public:
+  explicit InlineCallbacksize(Service* service)
+      : Base(service, InlineCallbacksConfiguration()) {}
+};
+
+typedef InlineCallbacksize<InProcess> InlineCallbacksInProcess;
+
+////////////////////////////////////////////////////////////////////////////////
+// Fixtures with pass-through interceptors on both client and server
+
+class PassThroughInterceptor : public experimental::Interceptor {
+ public:
+  void Intercept(experimental::InterceptorBatchMethods* methods) override {
+    methods->Proceed();
+  }
+};
+
+class PassThroughClientInterceptorFactory
+    : public experimental::ClientInterceptorFactoryInterface {
+ public:
+  experimental::Interceptor* CreateClientInterceptor(
+      experimental::ClientRpcInfo* /*info*/) override {
+    return new PassThroughInterceptor;
+  }
+};
+
+class PassThroughServerInterceptorFactory
+    : public experimental::ServerInterceptorFactoryInterface {
+ public:
+  experimental::Interceptor* CreateServerInterceptor(
+      experimental::ServerRpcInfo* /*info*/) override {
+    return new PassThroughInterceptor;
+  }
+};
+
+template <int kInterceptors>
+class InterceptorsConfiguration : public FixtureConfiguration {
+  void ApplyCommonServerBuilderConfig(ServerBuilder* b) const override {
+    std::vector<
+        std::unique_ptr<experimental::ServerInterceptorFactoryInterface>>
+        creators;
+    for (int i = 0; i < kInterceptors; i++) {
+      creators.emplace_back(new PassThroughServerInterceptorFactory);
+    }
+    b->experimental().SetInterceptorCreators(std::move(creators));
+    FixtureConfiguration::ApplyCommonServerBuilderConfig(b);
+  }
+
+  std::vector<std::unique_ptr<experimental::ClientInterceptorFactoryInterface>>
+  CreateClientInterceptors() const override {
+    std::vector<
+        std::unique_ptr<experimental::ClientInterceptorFactoryInterface>>
+        creators;
+    for (int i = 0; i < kInterceptors; i++) {
+      creators.emplace_back(new PassThroughClientInterceptorFactory);
+    }
+    return creators;
+  }
+};
+
+template <class Base, int kInterceptors>
+class Interceptorize : public Base {
+ public:
+  explicit Interceptorize(Service* service)
+      : Base(service, InterceptorsConfiguration<kInterceptors>()) {}
+};
+
+typedef Interceptorize<InProcess, 1> OneInterceptorInProcess;
+typedef Interceptorize<InProcess, 5> FiveInterceptorsInProcess;
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -0,0 +1,253 @@
+/*
+ *
+ * Copyright 2022 gRPC authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef TEST_CPP_MICROBENCHMARKS_TSI_FIXTURES_H
+#define TEST_CPP_MICROBENCHMARKS_TSI_FIXTURES_H
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <grpc/slice.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/load_file.h"
+#include "src/core/lib/slice/slice_internal.h"
+#include "src/core/tsi/alts/frame_protector/alts_frame_protector.h"
+#include "src/core/tsi/alts/handshaker/alts_handshaker_client.h"
+#include "src/core/tsi/alts/zero_copy_frame_protector/alts_zero_copy_grpc_protector.h"
+#include "src/core/tsi/fake_transport_security.h"
+#include "src/core/tsi/ssl_transport_security.h"
+#include "src/core/tsi/transport_security_grpc.h"
+#include "src/core/tsi/transport_security_interface.h"
+
+namespace grpc {
+namespace testing {
+
+// The protectors of both ends of a connection. Data is protected by the
+// client and unprotected by the server. Whichever protectors are still set
+// are destroyed with the object.
+struct TsiProtectors {
+  TsiProtectors() = default;
+  TsiProtectors(const TsiProtectors&) = delete;
+  TsiProtectors& operator=(const TsiProtectors&) = delete;
+  ~TsiProtectors() {
+    if (client != nullptr) tsi_frame_protector_destroy(client);
+    if (server != nullptr) tsi_frame_protector_destroy(server);
+    if (client_zero_copy != nullptr) {
+      tsi_zero_copy_grpc_protector_destroy(client_zero_copy);
+    }
+    if (server_zero_copy != nullptr) {
+      tsi_zero_copy_grpc_protector_destroy(server_zero_copy);
+    }
+  }
+
+  tsi_frame_protector* client = nullptr;
+  tsi_frame_protector* server = nullptr;
+  tsi_zero_copy_grpc_protector* client_zero_copy = nullptr;
+  tsi_zero_copy_grpc_protector* server_zero_copy = nullptr;
+};
+
+// Runs a handshake between two synchronous handshakers to completion, in
+// memory. Returns false if either fails.
+inline bool DoTsiHandshake(tsi_handshaker* client, tsi_handshaker* server,
+                           tsi_handshaker_result** client_result,
+                           tsi_handshaker_result** server_result) {
+  std::string to_server;
+  std::string to_client;
+  auto step = [](tsi_handshaker* handshaker, std::string* received,
+                 std::string* to_send, tsi_handshaker_result** result) {
+    const unsigned char* bytes = nullptr;
+    size_t bytes_size = 0;
+    tsi_result status = tsi_handshaker_next(
+        handshaker, reinterpret_cast<const unsigned char*>(received->data()),
+        received->size(), &bytes, &bytes_size, result, nullptr, nullptr);
+    received->clear();
+    if (status != TSI_OK && status != TSI_INCOMPLETE_DATA) return false;
+    to_send->append(reinterpret_cast<const char*>(bytes), bytes_size);
+    return true;
+  };
+  *client_result = nullptr;
+  *server_result = nullptr;
+  bool client_started = false;
+  while (*client_result == nullptr || *server_result == nullptr) {
+    bool ok;
+    if (*client_result == nullptr && (!client_started || !to_client.empty())) {
+      client_started = true;
+      ok = step(client, &to_client, &to_server, client_result);
+    } else if (*server_result == nullptr && !to_server.empty()) {
+      ok = step(server, &to_server, &to_client, server_result);
+    } else {
+      ok = false;
+    }
+    if (!ok) {
+      for (tsi_handshaker_result* result : {*client_result, *server_result}) {
+        if (result != nullptr) tsi_handshaker_result_destroy(result);
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+// Creates the protectors of both ends from their handshake results, which
+// are destroyed.
+inline void CreateProtectorsFromHandshake(tsi_handshaker_result* client_result,
+                                          tsi_handshaker_result* server_result,
+                                          bool zero_copy,
+                                          TsiProtectors* protectors) {
+  if (zero_copy) {
+    GPR_ASSERT(tsi_handshaker_result_create_zero_copy_grpc_protector(
+                   client_result, nullptr, &protectors->client_zero_copy) ==
+               TSI_OK);
+    GPR_ASSERT(tsi_handshaker_result_create_zero_copy_grpc_protector(
+                   server_result, nullptr, &protectors->server_zero_copy) ==
+               TSI_OK);
+  } else {
+    GPR_ASSERT(tsi_handshaker_result_create_frame_protector(
+                   client_result, nullptr, &protectors->client) == TSI_OK);
+    GPR_ASSERT(tsi_handshaker_result_create_frame_protector(
+                   server_result, nullptr, &protectors->server) == TSI_OK);
+  }
+  tsi_handshaker_result_destroy(client_result);
+  tsi_handshaker_result_destroy(server_result);
+}
+
+// Each fixture provides:
+// - static const char* Name(), for benchmark labels;
+// - static void CreateProtectors(bool zero_copy, TsiProtectors*).
+
+// The fake protectors frame data without encrypting it.
+class FakeTsi {
+ public:
+  static const char* Name() { return "fake"; }
+  static void CreateProtectors(bool zero_copy, TsiProtectors* protectors) {
+    if (zero_copy) {
+      protectors->client_zero_copy =
+          tsi_create_fake_zero_copy_grpc_protector(nullptr);
+      protectors->server_zero_copy =
+          tsi_create_fake_zero_copy_grpc_protector(nullptr);
+    } else {
+      protectors->client = tsi_create_fake_frame_protector(nullptr);
+      protectors->server = tsi_create_fake_frame_protector(nullptr);
+    }
+  }
+};
+
+// ALTS record protocol with the key size and rekeying of a real ALTS
+// connection. Only the zero-copy protector has an integrity-only mode.
+template <bool kIntegrityOnly>
+class AltsTsi {
+ public:
+  static const char* Name() {
+    return kIntegrityOnly ? "alts_integrity_only" : "alts_privacy_integrity";
+  }
+  static void CreateProtectors(bool zero_copy, TsiProtectors* protectors) {
+    const std::vector<uint8_t> key(kAltsAes128GcmRekeyKeyLength, 0x42);
+    for (bool is_client : {true, false}) {
+      if (zero_copy) {
+        GPR_ASSERT(alts_zero_copy_grpc_protector_create(
+                       key.data(), key.size(), /*is_rekey=*/true, is_client,
+                       kIntegrityOnly, /*enable_extra_copy=*/false, nullptr,
+                       is_client ? &protectors->client_zero_copy
+                                 : &protectors->server_zero_copy) == TSI_OK);
+      } else {
+        GPR_ASSERT(alts_create_frame_protector(
+                       key.data(), key.size(), is_client, /*is_rekey=*/true,
+                       nullptr,
+                       is_client ? &protectors->client : &protectors->server) ==
+                   TSI_OK);
+      }
+    }
+  }
+};
+
+// TLS with the test credentials in src/core/tsi/test_creds, using
+// whichever of OpenSSL or BoringSSL gRPC is built with.
+class SslTsi {
+ public:
+  static const char* Name() {
+#ifdef OPENSSL_IS_BORINGSSL
+    return "ssl_boringssl";
+#else
+    return "ssl_openssl";
+#endif
+  }
+  static void CreateProtectors(bool zero_copy, TsiProtectors* protectors) {
+    tsi_handshaker* client;
+    tsi_handshaker* server;
+    Get()->CreateHandshakers(&client, &server);
+    tsi_handshaker_result* client_result;
+    tsi_handshaker_result* server_result;
+    GPR_ASSERT(
+        DoTsiHandshake(client, server, &client_result, &server_result));
+    tsi_handshaker_destroy(client);
+    tsi_handshaker_destroy(server);
+    CreateProtectorsFromHandshake(client_result, server_result, zero_copy,
+                                  protectors);
+  }
+
+  // Handshakers for a new connection.
+  void CreateHandshakers(tsi_handshaker** client, tsi_handshaker** server) {
+    GPR_ASSERT(tsi_ssl_client_handshaker_factory_create_handshaker(
+                   client_factory_, "waterzooi.test.google.be", 0, 0,
+                   client) == TSI_OK);
+    GPR_ASSERT(tsi_ssl_server_handshaker_factory_create_handshaker(
+                   server_factory_, 0, 0, server) == TSI_OK);
+  }
+
+  static SslTsi* Get() {
+    static SslTsi* ssl_tsi = new SslTsi();
+    return ssl_tsi;
+  }
+
+ private:
+  SslTsi() {
+    const std::string root_cert = LoadCredential("ca.pem");
+    const std::string server_cert = LoadCredential("server1.pem");
+    const std::string server_key = LoadCredential("server1.key");
+    const tsi_ssl_pem_key_cert_pair server_pair = {server_key.c_str(),
+                                                   server_cert.c_str()};
+    GPR_ASSERT(tsi_create_ssl_client_handshaker_factory(
+                   nullptr, root_cert.c_str(), nullptr, nullptr, 0,
+                   &client_factory_) == TSI_OK);
+    GPR_ASSERT(tsi_create_ssl_server_handshaker_factory(
+                   &server_pair, 1, nullptr, 0, nullptr, nullptr, 0,
+                   &server_factory_) == TSI_OK);
+  }
+
+  static std::string LoadCredential(const char* name) {
+    grpc_slice slice;
+    GPR_ASSERT(grpc_load_file(
+                   (std::string("src/core/tsi/test_creds/") + name).c_str(),
+                   0, &slice) == GRPC_ERROR_NONE);
+    std::string contents(grpc_core::StringViewFromSlice(slice));
+    grpc_slice_unref(slice);
+    return contents;
+  }
+
+  tsi_ssl_client_handshaker_factory* client_factory_ = nullptr;
+  tsi_ssl_server_handshaker_factory* server_factory_ = nullptr;
+};
+
+}  // namespace testing
+}  // namespace grpc
+
+#endif  // TEST_CPP_MICROBENCHMARKS_TSI_FIXTURES_H
@@ -21,6 +21,7 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
@@ -134,6 +135,16 @@ class HistogramEntry final {
 
 typedef std::unordered_map<int, int64_t> StatusHistogram;
 
+// Converts an open-loop issue time to the clock used by UsageTimer::Now().
+// Open-loop latencies are measured from the time a request was scheduled to
+// be issued rather than the time it actually was, so that a stalled client
+// does not hide the latency of the requests it failed to send on time
+// (coordinated omission).
+inline double IntendedStartTime(gpr_timespec issue_time) {
+  gpr_timespec ts = gpr_convert_clock_type(issue_time, GPR_CLOCK_REALTIME);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
 inline void MergeStatusHistogram(const StatusHistogram& from,
                                  StatusHistogram* to) {
   for (StatusHistogram::const_iterator it = from.begin(); it != from.end();
@@ -156,6 +167,7 @@ class Client {
   ClientStats Mark(bool reset) {
     Histogram latencies;
     StatusHistogram statuses;
+    std::vector<Histogram> timeline;
     UsageTimer::Result timer_result;
 
     MaybeStartRequests();
@@ -165,22 +177,25 @@ class Client {
     if (reset) {
       std::vector<Histogram> to_merge(threads_.size());
       std::vector<StatusHistogram> to_merge_status(threads_.size());
+      std::vector<std::vector<Histogram>> to_merge_timeline(threads_.size());
 
       for (size_t i = 0; i < threads_.size(); i++) {
-        threads_[i]->BeginSwap(&to_merge[i], &to_merge_status[i]);
+        threads_[i]->BeginSwap(&to_merge[i], &to_merge_status[i],
+                               &to_merge_timeline[i]);
       }
       std::unique_ptr<UsageTimer> timer(new UsageTimer);
       timer_.swap(timer);
       for (size_t i = 0; i < threads_.size(); i++) {
         latencies.Merge(to_merge[i]);
         MergeStatusHistogram(to_merge_status[i], &statuses);
+        MergeTimeline(to_merge_timeline[i], &timeline);
       }
       timer_result = timer->Mark();
       last_reset_poll_count_ = cur_poll_count;
     } else {
       // merge snapshots of each thread histogram
       for (size_t i = 0; i < threads_.size(); i++) {
-        threads_[i]->MergeStatsInto(&latencies, &statuses);
+        threads_[i]->MergeStatsInto(&latencies, &statuses, &timeline);
       }
       timer_result = timer_->Mark();
     }
@@ -198,8 +213,10 @@ class Client {
       }
     }
 
-    grpc_stats_data core_stats;
-    grpc_stats_collect(&core_stats);
+    CoreStatsSnapshot core_stats = CoreStatsSnapshot::Now();
+    CoreStatsSnapshot core_stats_delta =
+        core_stats.Since(last_reset_core_stats_);
+    if (reset) last_reset_core_stats_ = core_stats;
 
     ClientStats stats;
     latencies.FillProto(stats.mutable_latencies());
@@ -213,7 +230,10 @@ class Client {
     stats.set_time_system(timer_result.system);
     stats.set_time_user(timer_result.user);
     stats.set_cq_poll_count(poll_count);
-    CoreStatsToProto(core_stats, stats.mutable_core_stats());
+    CoreStatsToProto(core_stats_delta.data(), stats.mutable_core_stats());
+    for (auto& h : timeline) {
+      h.FillProto(stats.add_latency_timeline());
+    }
     return stats;
   }
 
@@ -234,6 +254,12 @@ class Client {
     return median_latency_collection_interval_seconds_;
   }
 
+  // Returns the length (in seconds) of the intervals latency timelines are
+  // recorded over. If 0, no timelines are recorded.
+  double GetLatencyTimelineIntervalInSeconds() {
+    return latency_timeline_interval_seconds_;
+  }
+
   virtual int GetPollCount() {
     // For sync client.
     return 0;
@@ -257,20 +283,28 @@ class Client {
   class Thread {
    public:
     Thread(Client* client, size_t idx)
-        : client_(client), idx_(idx), impl_(&Thread::ThreadFunc, this) {}
+        : client_(client),
+          idx_(idx),
+          timeline_start_(UsageTimer::Now()),
+          impl_(&Thread::ThreadFunc, this) {}
 
     ~Thread() { impl_.join(); }
 
-    void BeginSwap(Histogram* n, StatusHistogram* s) {
+    void BeginSwap(Histogram* n, StatusHistogram* s,
+                   std::vector<Histogram>* timeline) {
       std::lock_guard<std::mutex> g(mu_);
       n->Swap(&histogram_);
       s->swap(statuses_);
+      timeline->swap(timeline_);
+      timeline_start_ = UsageTimer::Now();
     }
 
-    void MergeStatsInto(Histogram* hist, StatusHistogram* s) {
+    void MergeStatsInto(Histogram* hist, StatusHistogram* s,
+                        std::vector<Histogram>* timeline) {
       std::unique_lock<std::mutex> g(mu_);
       hist->Merge(histogram_);
       MergeStatusHistogram(statuses_, s);
+      MergeTimeline(timeline_, timeline);
     }
 
     std::vector<double> GetMedianPerIntervalList() {
@@ -281,6 +315,15 @@ class Client {
       std::lock_guard<std::mutex> g(mu_);
       if (entry->value_used()) {
         histogram_.Add(entry->value());
+        const double timeline_interval =
+            client_->GetLatencyTimelineIntervalInSeconds();
+        if (timeline_interval > 0) {
+          size_t bucket = static_cast<size_t>(
+              std::max(0.0, UsageTimer::Now() - timeline_start_) /
+              timeline_interval);
+          if (bucket >= timeline_.size()) timeline_.resize(bucket + 1);
+          timeline_[bucket].Add(entry->value());
+        }
         if (client_->GetLatencyCollectionIntervalInSeconds() > 0) {
           histogram_per_interval_.Add(entry->value());
           double now = UsageTimer::Now();
@@ -324,6 +367,10 @@ class Client {
     StatusHistogram statuses_;
     Client* client_;
     const size_t idx_;
+    // Latencies of the requests completed in each interval since the last
+    // reset, if latency_timeline_interval_seconds_ is greater than 0.
+    std::vector<Histogram> timeline_;
+    double timeline_start_;
     std::thread impl_;
     // The following are used only if
     // median_latency_collection_interval_seconds_ is greater than 0
@@ -336,6 +383,15 @@ class Client {
   bool closed_loop_;
   gpr_atm thread_pool_done_;
   double median_latency_collection_interval_seconds_;  // In seconds
+  double latency_timeline_interval_seconds_ = 0;       // In seconds
+
+  static void MergeTimeline(const std::vector<Histogram>& from,
+                            std::vector<Histogram>* to) {
+    if (to->size() < from.size()) to->resize(from.size());
+    for (size_t i = 0; i < from.size(); i++) {
+      (*to)[i].Merge(from[i]);
+    }
+  }
 
   void StartThreads(size_t num_threads) {
     gpr_atm_rel_store(&thread_pool_done_, static_cast<gpr_atm>(false));
@@ -406,6 +462,8 @@ class Client {
   bool started_requests_;
 
   int last_reset_poll_count_;
+  // Core stats are reported for the interval since the last reset.
+  CoreStatsSnapshot last_reset_core_stats_;
 
   void MaybeStartRequests() {
     if (!started_requests_) {
@@ -438,6 +496,8 @@ class ClientImpl : public Client {
     WaitForChannelsToConnect();
     median_latency_collection_interval_seconds_ =
         config.median_latency_collection_interval_millis() / 1e3;
+    latency_timeline_interval_seconds_ =
+        config.latency_timeline_interval_millis() / 1e3;
     ClientRequestCreator<RequestType> create_req(&request_,
                                                  config.payload_config());
   }
@@ -62,6 +62,16 @@ class ClientRpcContext {
   virtual void TryCancel() = 0;
 };
 
+// Arms \a alarm for the next open-loop issue time and returns that time, from
+// which the latency of the request it triggers is measured.
+static double SetIssueAlarm(Alarm* alarm, CompletionQueue* cq,
+                            const std::function<gpr_timespec()>& next_issue,
+                            void* tag) {
+  const gpr_timespec issue_time = next_issue();
+  alarm->Set(cq, issue_time, tag);
+  return IntendedStartTime(issue_time);
+}
+
 template <class RequestType, class ResponseType>
 class ClientRpcContextUnaryImpl : public ClientRpcContext {
  public:
@@ -91,7 +101,7 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
   bool RunNextState(bool /*ok*/, HistogramEntry* entry) override {
     switch (next_state_) {
       case State::READY:
-        start_ = UsageTimer::Now();
+        if (!next_issue_) start_ = UsageTimer::Now();
         response_reader_ = prepare_req_(stub_, &context_, req_, cq_);
         response_reader_->StartCall();
         next_state_ = State::RESP_DONE;
@@ -143,7 +153,8 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
       RunNextState(true, nullptr);
     } else {  // wait for the issue time
       alarm_ = absl::make_unique<Alarm>();
-      alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+      start_ = SetIssueAlarm(alarm_.get(), cq_, next_issue_,
+                             ClientRpcContext::tag(this));
     }
   }
 };
@@ -372,13 +383,14 @@ class ClientRpcContextStreamingPingPongImpl : public ClientRpcContext {
         case State::WAIT:
           next_state_ = State::READY_TO_WRITE;
           alarm_ = absl::make_unique<Alarm>();
-          alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+          start_ = SetIssueAlarm(alarm_.get(), cq_, next_issue_,
+                                 ClientRpcContext::tag(this));
           return true;
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
-          start_ = UsageTimer::Now();
+          if (!next_issue_) start_ = UsageTimer::Now();
           next_state_ = State::WRITE_DONE;
           if (coalesce_ && messages_issued_ == messages_per_stream_ - 1) {
             stream_->WriteLast(req_, WriteOptions(),
@@ -557,14 +569,15 @@ class ClientRpcContextStreamingFromClientImpl : public ClientRpcContext {
           break;  // loop around, don't return
         case State::WAIT:
           alarm_ = absl::make_unique<Alarm>();
-          alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+          start_ = SetIssueAlarm(alarm_.get(), cq_, next_issue_,
+                                 ClientRpcContext::tag(this));
           next_state_ = State::READY_TO_WRITE;
           return true;
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
-          start_ = UsageTimer::Now();
+          if (!next_issue_) start_ = UsageTimer::Now();
           next_state_ = State::WRITE_DONE;
           stream_->Write(req_, ClientRpcContext::tag(this));
           return true;
@@ -805,13 +818,14 @@ class ClientRpcContextGenericStreamingImpl : public ClientRpcContext {
         case State::WAIT:
           next_state_ = State::READY_TO_WRITE;
           alarm_ = absl::make_unique<Alarm>();
-          alarm_->Set(cq_, next_issue_(), ClientRpcContext::tag(this));
+          start_ = SetIssueAlarm(alarm_.get(), cq_, next_issue_,
+                                 ClientRpcContext::tag(this));
           return true;
         case State::READY_TO_WRITE:
           if (!ok) {
             return false;
           }
-          start_ = UsageTimer::Now();
+          if (!next_issue_) start_ = UsageTimer::Now();
           next_state_ = State::WRITE_DONE;
           stream_->Write(req_, ClientRpcContext::tag(this));
           return true;
@@ -145,6 +145,7 @@ static void postprocess_scenario_result(ScenarioResult* result) {
   result->mutable_summary()->set_latency_95(histogram.Percentile(95));
   result->mutable_summary()->set_latency_99(histogram.Percentile(99));
   result->mutable_summary()->set_latency_999(histogram.Percentile(99.9));
+  result->mutable_summary()->set_latency_9999(histogram.Percentile(99.99));
 
   // Calculate qps and cpu load for each client and then aggregate results for
   // all clients
@@ -257,6 +258,7 @@ static void FinishClients(const std::vector<ClientData>& clients,
 
 static void ReceiveFinalStatusFromClients(
     const std::vector<ClientData>& clients, Histogram& merged_latencies,
+    std::vector<Histogram>& merged_timeline,
     std::unordered_map<int, int64_t>& merged_statuses, ScenarioResult& result) {
   gpr_log(GPR_INFO, "Receiving final status from clients");
   ClientStatus client_status;
@@ -267,6 +269,13 @@ static void ReceiveFinalStatusFromClients(
       gpr_log(GPR_INFO, "Received final status from client %zu", i);
       const auto& stats = client_status.stats();
       merged_latencies.MergeProto(stats.latencies());
+      if (merged_timeline.size() <
+          static_cast<size_t>(stats.latency_timeline_size())) {
+        merged_timeline.resize(stats.latency_timeline_size());
+      }
+      for (int i = 0; i < stats.latency_timeline_size(); i++) {
+        merged_timeline[i].MergeProto(stats.latency_timeline(i));
+      }
       for (int i = 0; i < stats.request_results_size(); i++) {
         merged_statuses[stats.request_results(i).status_code()] +=
             stats.request_results(i).count();
@@ -621,6 +630,7 @@ std::unique_ptr<ScenarioResult> RunScenario(
   // Finish a run
   std::unique_ptr<ScenarioResult> result(new ScenarioResult);
   Histogram merged_latencies;
+  std::vector<Histogram> merged_timeline;
   std::unordered_map<int, int64_t> merged_statuses;
 
   // For the case where clients lead the test such as UNARY and
@@ -638,8 +648,8 @@ std::unique_ptr<ScenarioResult> RunScenario(
     FinishServers(servers, server_mark);
   }
 
-  ReceiveFinalStatusFromClients(clients, merged_latencies, merged_statuses,
-                                *result);
+  ReceiveFinalStatusFromClients(clients, merged_latencies, merged_timeline,
+                                merged_statuses, *result);
   ShutdownClients(clients, *result);
 
   if (client_finish_first) {
@@ -658,6 +668,20 @@ std::unique_ptr<ScenarioResult> RunScenario(
     rrc->set_status_code(it->first);
     rrc->set_count(it->second);
   }
+  // Timelines start at the end of the warmup period, when client stats are
+  // reset.
+  const double timeline_interval =
+      client_config.latency_timeline_interval_millis() / 1e3;
+  for (size_t i = 0; i < merged_timeline.size(); i++) {
+    Histogram& h = merged_timeline[i];
+    LatencyTimelinePoint* point = result->add_latency_timeline();
+    point->set_start_time(i * timeline_interval);
+    point->set_count(h.Count());
+    point->set_latency_50(h.Percentile(50));
+    point->set_latency_99(h.Percentile(99));
+    point->set_latency_999(h.Percentile(99.9));
+    point->set_latency_9999(h.Percentile(99.99));
+  }
 
   // Fill in start and end time for the test scenario
   result->mutable_summary()->mutable_start_time()->set_seconds(start_time);
@@ -65,8 +65,10 @@ class Server {
       timer_result = timer_->Mark();
     }
 
-    grpc_stats_data core_stats;
-    grpc_stats_collect(&core_stats);
+    CoreStatsSnapshot core_stats = CoreStatsSnapshot::Now();
+    CoreStatsSnapshot core_stats_delta =
+        core_stats.Since(last_reset_core_stats_);
+    if (reset) last_reset_core_stats_ = core_stats;
 
     ServerStats stats;
     stats.set_time_elapsed(timer_result.wall);
@@ -75,7 +77,7 @@ class Server {
     stats.set_total_cpu_time(timer_result.total_cpu_time);
     stats.set_idle_cpu_time(timer_result.idle_cpu_time);
     stats.set_cq_poll_count(poll_count);
-    CoreStatsToProto(core_stats, stats.mutable_core_stats());
+    CoreStatsToProto(core_stats_delta.data(), stats.mutable_core_stats());
     return stats;
   }
 
@@ -149,6 +151,8 @@ class Server {
   int cores_;
   std::unique_ptr<UsageTimer> timer_;
   int last_reset_poll_count_;
+  // Core stats are reported for the interval since the last reset.
+  CoreStatsSnapshot last_reset_core_stats_;
 };
 
 std::unique_ptr<Server> CreateSynchronousServer(const ServerConfig& config);
@@ -350,6 +350,64 @@ TEST_F(LoadDataStoreTest, UnknownBalancerIdTracking) {
   EXPECT_TRUE(load_data_store.IsTrackedUnknownBalancerId(kLbId3));
 }
 
+TEST_F(LoadDataStoreTest, EvictIdleStoresOfClosedStreams) {
+  LoadDataStore load_data_store;
+  load_data_store.ReportStreamCreated(kHostname1, kLbId1, kLoadKey1);
+  load_data_store.ReportStreamCreated(kHostname1, kLbId2, kLoadKey1);
+  load_data_store.MergeRow(kHostname1, kKey2, LoadRecordValue());
+  load_data_store.ReportStreamClosed(kHostname1, kLbId2);
+  // The store of kLbId2 was merged into since the stores were created.
+  load_data_store.EvictIdleStores();
+  auto store_lb_id_2 = load_data_store.FindPerBalancerStore(kHostname1, kLbId2);
+  ASSERT_NE(store_lb_id_2, nullptr);
+  // It still has load data to report.
+  load_data_store.EvictIdleStores();
+  EXPECT_NE(load_data_store.FindPerBalancerStore(kHostname1, kLbId2), nullptr);
+  store_lb_id_2->ClearLoadRecordMap();
+  load_data_store.EvictIdleStores();
+  EXPECT_EQ(load_data_store.FindPerBalancerStore(kHostname1, kLbId2), nullptr);
+  // The stores of the balancer still receiving reports are kept.
+  auto assigned_stores = load_data_store.GetAssignedStores(kHostname1, kLbId1);
+  EXPECT_EQ(assigned_stores->size(), 2U);
+  EXPECT_TRUE(PerBalancerStoresContains(load_data_store, assigned_stores,
+                                        kHostname1, kLbId1, kLoadKey1));
+  EXPECT_TRUE(PerBalancerStoresContains(load_data_store, assigned_stores,
+                                        kHostname1, kInvalidLbId, ""));
+}
+
+TEST_F(LoadDataStoreTest, KeepStoresWithCallsInProgress) {
+  LoadDataStore load_data_store;
+  load_data_store.ReportStreamCreated(kHostname1, kLbId1, kLoadKey1);
+  load_data_store.ReportStreamCreated(kHostname1, kLbId2, kLoadKey1);
+  load_data_store.MergeRow(kHostname1, kKey2, LoadRecordValue(1));
+  load_data_store.ReportStreamClosed(kHostname1, kLbId2);
+  auto store_lb_id_2 = load_data_store.FindPerBalancerStore(kHostname1, kLbId2);
+  store_lb_id_2->ClearLoadRecordMap();
+  load_data_store.EvictIdleStores();
+  load_data_store.EvictIdleStores();
+  EXPECT_EQ(load_data_store.FindPerBalancerStore(kHostname1, kLbId2),
+            store_lb_id_2);
+}
+
+TEST_F(LoadDataStoreTest, EvictIdleHost) {
+  LoadDataStore load_data_store;
+  load_data_store.ReportStreamCreated(kHostname1, kLbId1, kLoadKey1);
+  load_data_store.ReportStreamCreated(kHostname2, kLbId2, kLoadKey1);
+  load_data_store.ReportStreamClosed(kHostname1, kLbId1);
+  load_data_store.EvictIdleStores();
+  // All the stores of the host without streams are evicted.
+  EXPECT_EQ(load_data_store.FindPerBalancerStore(kHostname1, kLbId1), nullptr);
+  EXPECT_EQ(load_data_store.FindPerBalancerStore(kHostname1, kInvalidLbId),
+            nullptr);
+  EXPECT_NE(load_data_store.FindPerBalancerStore(kHostname2, kLbId2), nullptr);
+  // A new stream for the host starts over.
+  load_data_store.ReportStreamCreated(kHostname1, kLbId3, kLoadKey1);
+  auto assigned_stores = load_data_store.GetAssignedStores(kHostname1, kLbId3);
+  EXPECT_EQ(assigned_stores->size(), 2U);
+  EXPECT_TRUE(PerBalancerStoresContains(load_data_store, assigned_stores,
+                                        kHostname1, kInvalidLbId, ""));
+}
+
 TEST_F(PerBalancerStoreTest, Suspend) {
   PerBalancerStore per_balancer_store(kLbId1, kLoadKey1);
   EXPECT_FALSE(per_balancer_store.IsSuspended());
@@ -16,12 +16,29 @@
  *
  */
 
+#include <grpc/support/port_platform.h>
+
+#ifdef GPR_LINUX
+#include <sched.h>
+#endif
+
+#include <set>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include "absl/strings/str_cat.h"
+
 #include <grpc/grpc.h>
+#include <grpc/support/cpu.h>
+#include <grpcpp/create_channel.h>
 #include <grpcpp/impl/codegen/config.h>
+#include <grpcpp/security/credentials.h>
 #include <grpcpp/server.h>
 #include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+
+#include "src/core/lib/gprpp/sync.h"
 
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
 #include "test/core/util/port.h"
@@ -83,6 +100,80 @@ TEST_F(ServerBuilderTest, CreateServerRepeatedPortWithDisallowedReusePort) {
             nullptr);
 }
 
+#ifdef GPR_LINUX
+// Records the CPUs that the thread handling each call may run on.
+class CpuRecordingService : public testing::EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* /*context*/, const testing::EchoRequest* request,
+              testing::EchoResponse* response) override {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    EXPECT_EQ(sched_getaffinity(0, sizeof(cpus), &cpus), 0);
+    grpc_core::MutexLock lock(&mu_);
+    handler_cpus_.push_back(cpus);
+    response->set_message(request->message());
+    return Status::OK;
+  }
+
+  std::vector<cpu_set_t> handler_cpus() {
+    grpc_core::MutexLock lock(&mu_);
+    return handler_cpus_;
+  }
+
+ private:
+  grpc_core::Mutex mu_;
+  std::vector<cpu_set_t> handler_cpus_ ABSL_GUARDED_BY(mu_);
+};
+
+TEST_F(ServerBuilderTest, PinSyncServerThreads) {
+  // The threads of sync server CQ i are pinned to CPU i, modulo the number of
+  // CPUs. Pinning is best effort, so both CPUs must be allowed.
+  constexpr int kNumCqs = 2;
+  const int num_cpus = static_cast<int>(gpr_cpu_num_cores());
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+  std::set<int> expected_cpus;
+  for (int i = 0; i < kNumCqs; ++i) {
+    const int cpu = i % num_cpus;
+    if (!CPU_ISSET(cpu, &allowed)) {
+      GTEST_SKIP() << "CPU " << cpu << " is not available to this process";
+    }
+    expected_cpus.insert(cpu);
+  }
+  CpuRecordingService service;
+  const std::string address =
+      absl::StrCat("localhost:", grpc_pick_unused_port_or_die());
+  std::unique_ptr<Server> server =
+      ServerBuilder()
+          .RegisterService(&service)
+          .AddListeningPort(address, InsecureServerCredentials())
+          .SetSyncServerOption(ServerBuilder::SyncServerOption::NUM_CQS,
+                               kNumCqs)
+          .AddChannelArgument(GRPC_ARG_SYNC_SERVER_PIN_THREADS, 1)
+          .BuildAndStart();
+  ASSERT_NE(server, nullptr);
+  auto stub = testing::EchoTestService::NewStub(
+      CreateChannel(address, InsecureChannelCredentials()));
+  for (int i = 0; i < 10; ++i) {
+    ClientContext context;
+    testing::EchoRequest request;
+    testing::EchoResponse response;
+    request.set_message("hello");
+    ASSERT_TRUE(stub->Echo(&context, request, &response).ok());
+  }
+  server->Shutdown();
+  const std::vector<cpu_set_t> handler_cpus = service.handler_cpus();
+  ASSERT_EQ(handler_cpus.size(), 10u);
+  for (const cpu_set_t& cpus : handler_cpus) {
+    ASSERT_EQ(CPU_COUNT(&cpus), 1);
+    int cpu = 0;
+    while (!CPU_ISSET(cpu, &cpus)) ++cpu;
+    EXPECT_EQ(expected_cpus.count(cpu), 1) << "handler ran on CPU " << cpu;
+  }
+}
+#endif  // GPR_LINUX
+
 }  // namespace
 }  // namespace grpc
 
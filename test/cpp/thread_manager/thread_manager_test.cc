@@ -28,11 +28,16 @@
 
 #include <gtest/gtest.h>
 
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpcpp/grpcpp.h>
 
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "test/core/util/test_config.h"
 
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_sync_server_adaptive_pollers);
+
 namespace grpc {
 namespace {
 
@@ -178,6 +183,86 @@ TEST_P(ThreadManagerTest, TestThreadQuota) {
   }
 }
 
+// Finds work on every poll for busy_ms, with each request taking a while,
+// and then finds none until shutting down after quiet_ms more.
+class AdaptiveTestThreadManager final : public grpc::ThreadManager {
+ public:
+  AdaptiveTestThreadManager(grpc_resource_quota* rq, int busy_ms,
+                            int quiet_ms)
+      : ThreadManager("AdaptiveTestThreadManager", rq, 1 /* min_pollers */,
+                      8 /* max_pollers */),
+        busy_until_(std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(busy_ms)),
+        quiet_until_(busy_until_ + std::chrono::milliseconds(quiet_ms)),
+        num_polling_(0),
+        max_polling_(0) {}
+
+  grpc::ThreadManager::WorkStatus PollForWork(void** tag, bool* ok) override {
+    *tag = nullptr;
+    *ok = true;
+    auto now = std::chrono::steady_clock::now();
+    if (now >= quiet_until_) {
+      Shutdown();
+      return SHUTDOWN;
+    }
+    int polling = num_polling_.fetch_add(1, std::memory_order_relaxed) + 1;
+    int max_polling = max_polling_.load(std::memory_order_relaxed);
+    while (polling > max_polling &&
+           !max_polling_.compare_exchange_weak(max_polling, polling,
+                                               std::memory_order_relaxed)) {
+    }
+    bool busy = now < busy_until_;
+    std::this_thread::sleep_for(std::chrono::milliseconds(busy ? 1 : 10));
+    num_polling_.fetch_sub(1, std::memory_order_relaxed);
+    return busy ? WORK_FOUND : TIMEOUT;
+  }
+
+  void DoWork(void* /* tag */, bool /*ok*/, bool /*resources*/) override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  }
+
+  // Get the largest number of threads that were in PollForWork() at once
+  int max_polling() const {
+    return max_polling_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  const std::chrono::steady_clock::time_point busy_until_;
+  const std::chrono::steady_clock::time_point quiet_until_;
+  std::atomic_int num_polling_;
+  std::atomic_int max_polling_;
+};
+
+TEST(ThreadManagerAdaptiveTest, GrowsWhenBusyAndShrinksWhenQuiet) {
+  // The target number of pollers is capped at the number of cores.
+  if (gpr_cpu_num_cores() < 2) {
+    GTEST_SKIP() << "needs at least 2 cores";
+  }
+  GPR_GLOBAL_CONFIG_SET(grpc_sync_server_adaptive_pollers, true);
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data before;
+  grpc_stats_collect(&before);
+#endif
+  grpc_resource_quota* rq = grpc_resource_quota_create("Adaptive test");
+  // Every request found by the only poller waits for a thread to poll again,
+  // so the target grows within a window or two. Lowering it takes 50 windows
+  // of 100ms without such waits.
+  AdaptiveTestThreadManager tm(rq, 1000 /* busy_ms */, 6000 /* quiet_ms */);
+  grpc_resource_quota_unref(rq);
+  tm.Initialize();
+  tm.Wait();
+  GPR_GLOBAL_CONFIG_SET(grpc_sync_server_adaptive_pollers, false);
+  EXPECT_GT(tm.max_polling(), 1);
+#if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
+  grpc_stats_data after;
+  grpc_stats_data diff;
+  grpc_stats_collect(&after);
+  grpc_stats_diff(&after, &before, &diff);
+  EXPECT_GE(diff.counters[GRPC_STATS_COUNTER_SYNC_SERVER_POLLERS_GROWN], 1);
+  EXPECT_GE(diff.counters[GRPC_STATS_COUNTER_SYNC_SERVER_POLLERS_SHRUNK], 1);
+#endif
+}
+
 }  // namespace
 }  // namespace grpc
 
@@ -24,6 +24,7 @@
 #include <grpc++/support/byte_buffer.h>
 #include <grpc/grpc.h>
 #include <grpc/slice.h>
+#include <grpcpp/impl/codegen/preserialized_message.h>
 #include <grpcpp/impl/grpc_library.h>
 #include <grpcpp/support/slice.h>
 
@@ -38,6 +39,9 @@ namespace {
 const char* kContent1 = "hello xxxxxxxxxxxxxxxxxxxxxxxxxxxxxx";
 const char* kContent2 = "yyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyyy world";
 
+using PreserializedTraits =
+    SerializationTraits<experimental::PreserializedMessage<ByteBuffer>>;
+
 class ByteBufferTest : public ::testing::Test {
  protected:
   static void SetUpTestCase() { grpc_init(); }
@@ -152,6 +156,34 @@ TEST_F(ByteBufferTest, DumpToSingleSlice) {
   EXPECT_EQ(strlen(kContent1) + strlen(kContent2), slice.size());
 }
 
+TEST_F(ByteBufferTest, PreserializedMessageSharesSlices) {
+  Slice slice(kContent1);
+  ByteBuffer buffer(&slice, 1);
+  experimental::PreserializedMessage<ByteBuffer> msg(buffer);
+  ASSERT_TRUE(msg.status().ok());
+  EXPECT_EQ(strlen(kContent1), msg.Length());
+  // Every stream the message is sent to gets the same bytes.
+  for (int i = 0; i < 2; ++i) {
+    ByteBuffer send_buffer;
+    bool owned = false;
+    auto status =
+        PreserializedTraits::Serialize(msg, &send_buffer, &owned);
+    EXPECT_TRUE(status.ok());
+    EXPECT_TRUE(owned);
+    Slice sent;
+    ASSERT_TRUE(send_buffer.TrySingleSlice(&sent).ok());
+    EXPECT_EQ(sent.begin(), slice.begin());
+  }
+}
+
+TEST_F(ByteBufferTest, EmptyPreserializedMessageFails) {
+  experimental::PreserializedMessage<ByteBuffer> msg;
+  ByteBuffer send_buffer;
+  bool owned = false;
+  EXPECT_FALSE(
+      PreserializedTraits::Serialize(msg, &send_buffer, &owned).ok());
+}
+
 }  // namespace
 }  // namespace grpc
 
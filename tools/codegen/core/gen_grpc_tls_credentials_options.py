@@ -160,7 +160,39 @@ _DATA_MEMBERS = [
         setter_move_semantics=True,
         test_name="DifferentCrlDirectory",
         test_value_1="\"crl_directory_1\"",
-        test_value_2="\"crl_directory_2\"")
+        test_value_2="\"crl_directory_2\""),
+    DataMember(
+        name='private_key_signer',
+        type='grpc_core::RefCountedPtr<tsi::SslPrivateKeySigner>',
+        override_getter="""tsi::SslPrivateKeySigner* private_key_signer() {
+    return private_key_signer_.get();
+  }""",
+        setter_comment=
+        'If set, handshakes sign with the private_key_signer instead of the private key of the identity key-cert pair. Only supported with BoringSSL.',
+        setter_move_semantics=True,
+        test_name="DifferentPrivateKeySigner",
+        test_value_1=
+        "MakeRefCounted<tsi::SslPrivateKeySigner>(grpc_tls_private_key_signer())",
+        test_value_2=
+        "MakeRefCounted<tsi::SslPrivateKeySigner>(grpc_tls_private_key_signer())"
+    ),
+    DataMember(
+        name='verification_cache',
+        type='grpc_core::RefCountedPtr<grpc_core::CertificateVerificationCache>',
+        override_getter=
+        """grpc_core::CertificateVerificationCache* verification_cache() {
+    return verification_cache_.get();
+  }""",
+        setter_comment=
+        'If set, successful results of the certificate verifier are cached and shared by all handshakes using these options.',
+        setter_move_semantics=True,
+        special_comparator=
+        '(verification_cache_ == other.verification_cache_ || (verification_cache_ != nullptr && other.verification_cache_ != nullptr && verification_cache_->ttl() == other.verification_cache_->ttl()))',
+        test_name="DifferentVerificationCache",
+        test_value_1=
+        "MakeRefCounted<CertificateVerificationCache>(Duration::Seconds(1))",
+        test_value_2=
+        "MakeRefCounted<CertificateVerificationCache>(Duration::Seconds(2))")
 ]
 
 
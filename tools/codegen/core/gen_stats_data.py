@@ -57,7 +57,20 @@ inst_map = dict((t[0].__name__, t[1]) for t in types)
 
 stats = []
 
+
+def hdr_buckets(max_value, relative_error):
+    """Number of buckets for which gen_bucket_code() yields HDR-style bounds:
+    unit width buckets up to 1/relative_error, then buckets growing by a
+    factor of (1 + relative_error) up to max_value."""
+    linear = int(math.ceil(1.0 / relative_error))
+    return linear + int(
+        math.ceil(
+            math.log(float(max_value) / linear) / math.log1p(relative_error)))
+
+
 for attr in attrs:
+    if 'relative_error' in attr:
+        attr['buckets'] = hdr_buckets(attr['max'], attr.pop('relative_error'))
     found = False
     for t, lst in types:
         t_name = t.__name__.lower()
@@ -23,6 +23,7 @@ _AVAILABLE_BENCHMARK_TESTS = [
     'bm_cq',
     'bm_call_create',
     'bm_chttp2_hpack',
+    'bm_chttp2_stream_map',
     'bm_chttp2_transport',
     'bm_pollset',
 ]
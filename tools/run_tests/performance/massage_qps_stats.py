@@ -62,6 +62,10 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_pollset_kick_own_thread"] = massage_qps_stats_helpers.counter(
                     core_stats, "pollset_kick_own_thread")
+            stats["core_busy_poll_hits"] = massage_qps_stats_helpers.counter(
+                core_stats, "busy_poll_hits")
+            stats["core_busy_poll_misses"] = massage_qps_stats_helpers.counter(
+                core_stats, "busy_poll_misses")
             stats[
                 "core_histogram_slow_lookups"] = massage_qps_stats_helpers.counter(
                     core_stats, "histogram_slow_lookups")
@@ -75,6 +79,11 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_tcp_backup_poller_polls"] = massage_qps_stats_helpers.counter(
                     core_stats, "tcp_backup_poller_polls")
+            stats[
+                "core_tcp_zerocopy_read_attempts"] = massage_qps_stats_helpers.counter(
+                    core_stats, "tcp_zerocopy_read_attempts")
+            stats["core_tcp_zerocopy_reads"] = massage_qps_stats_helpers.counter(
+                core_stats, "tcp_zerocopy_reads")
             stats["core_http2_op_batches"] = massage_qps_stats_helpers.counter(
                 core_stats, "http2_op_batches")
             stats["core_http2_op_cancel"] = massage_qps_stats_helpers.counter(
@@ -114,6 +123,9 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_http2_partial_writes"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_partial_writes")
+            stats[
+                "core_http2_coalesced_writes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "http2_coalesced_writes")
             stats[
                 "core_http2_initiate_write_due_to_initial_write"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_initiate_write_due_to_initial_write")
@@ -306,6 +318,9 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_server_slowpath_requests_queued"] = massage_qps_stats_helpers.counter(
                     core_stats, "server_slowpath_requests_queued")
+            stats[
+                "core_server_qos_calls_shed"] = massage_qps_stats_helpers.counter(
+                    core_stats, "server_qos_calls_shed")
             stats[
                 "core_cq_ev_queue_trylock_failures"] = massage_qps_stats_helpers.counter(
                     core_stats, "cq_ev_queue_trylock_failures")
@@ -315,6 +330,42 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_cq_ev_queue_transient_pop_failures"] = massage_qps_stats_helpers.counter(
                     core_stats, "cq_ev_queue_transient_pop_failures")
+            stats[
+                "core_xds_coalesced_updates"] = massage_qps_stats_helpers.counter(
+                    core_stats, "xds_coalesced_updates")
+            stats[
+                "core_ssl_session_cache_hits"] = massage_qps_stats_helpers.counter(
+                    core_stats, "ssl_session_cache_hits")
+            stats[
+                "core_ssl_session_cache_misses"] = massage_qps_stats_helpers.counter(
+                    core_stats, "ssl_session_cache_misses")
+            stats[
+                "core_ssl_session_cache_evictions"] = massage_qps_stats_helpers.counter(
+                    core_stats, "ssl_session_cache_evictions")
+            stats[
+                "core_ssl_client_full_handshakes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "ssl_client_full_handshakes")
+            stats[
+                "core_ssl_client_resumed_handshakes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "ssl_client_resumed_handshakes")
+            stats[
+                "core_ssl_server_full_handshakes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "ssl_server_full_handshakes")
+            stats[
+                "core_ssl_server_resumed_handshakes"] = massage_qps_stats_helpers.counter(
+                    core_stats, "ssl_server_resumed_handshakes")
+            stats[
+                "core_work_serializer_run_inline"] = massage_qps_stats_helpers.counter(
+                    core_stats, "work_serializer_run_inline")
+            stats[
+                "core_work_serializer_run_queued"] = massage_qps_stats_helpers.counter(
+                    core_stats, "work_serializer_run_queued")
+            stats[
+                "core_sync_server_pollers_grown"] = massage_qps_stats_helpers.counter(
+                    core_stats, "sync_server_pollers_grown")
+            stats[
+                "core_sync_server_pollers_shrunk"] = massage_qps_stats_helpers.counter(
+                    core_stats, "sync_server_pollers_shrunk")
             h = massage_qps_stats_helpers.histogram(core_stats,
                                                     "call_initial_size")
             stats["core_call_initial_size"] = ",".join(
@@ -507,3 +558,168 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_server_cqs_checked_99p"] = massage_qps_stats_helpers.percentile(
                     h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "busy_poll_spin_micros")
+            stats["core_busy_poll_spin_micros"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_busy_poll_spin_micros_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_busy_poll_spin_micros_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_busy_poll_spin_micros_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_busy_poll_spin_micros_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "http2_write_coalescing_delay_micros")
+            stats["core_http2_write_coalescing_delay_micros"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_http2_write_coalescing_delay_micros_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_http2_write_coalescing_delay_micros_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_http2_write_coalescing_delay_micros_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_http2_write_coalescing_delay_micros_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "lb_pick_latency_micros")
+            stats["core_lb_pick_latency_micros"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_lb_pick_latency_micros_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_lb_pick_latency_micros_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_lb_pick_latency_micros_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_lb_pick_latency_micros_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "http2_write_queue_micros")
+            stats["core_http2_write_queue_micros"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_http2_write_queue_micros_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_http2_write_queue_micros_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_http2_write_queue_micros_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_http2_write_queue_micros_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "pollset_wakeup_micros")
+            stats["core_pollset_wakeup_micros"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_pollset_wakeup_micros_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_pollset_wakeup_micros_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_pollset_wakeup_micros_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_pollset_wakeup_micros_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "executor_queue_delay_micros")
+            stats["core_executor_queue_delay_micros"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_executor_queue_delay_micros_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_executor_queue_delay_micros_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_executor_queue_delay_micros_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_executor_queue_delay_micros_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "timer_lateness_millis")
+            stats["core_timer_lateness_millis"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_timer_lateness_millis_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_timer_lateness_millis_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_timer_lateness_millis_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_timer_lateness_millis_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "poller_flush_closures")
+            stats["core_poller_flush_closures"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_poller_flush_closures_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_poller_flush_closures_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_poller_flush_closures_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_poller_flush_closures_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "poller_flush_micros")
+            stats["core_poller_flush_micros"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_poller_flush_micros_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_poller_flush_micros_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_poller_flush_micros_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_poller_flush_micros_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "work_serializer_queue_depth")
+            stats["core_work_serializer_queue_depth"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_work_serializer_queue_depth_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_work_serializer_queue_depth_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_work_serializer_queue_depth_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_work_serializer_queue_depth_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(core_stats,
+                                                    "combiner_run_micros")
+            stats["core_combiner_run_micros"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_combiner_run_micros_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_combiner_run_micros_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_combiner_run_micros_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_combiner_run_micros_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
@@ -62,8 +62,29 @@ _FORCE_ENVIRON_FOR_WRAPPERS = {
     'GRPC_VERBOSITY': 'DEBUG',
 }
 
+
+def _io_uring_supported():
+    """Whether the kernel can run the io_uring polling engine (5.13+)."""
+    if platform.system() != 'Linux':
+        return False
+    try:
+        version = tuple(
+            int(part) for part in platform.release().split('-')[0].split('.')
+            [:2])
+        if version < (5, 13):
+            return False
+        with open('/proc/sys/kernel/io_uring_disabled') as f:
+            return f.read().strip() == '0'
+    except IOError:
+        # Kernels without the sysctl don't restrict io_uring.
+        return True
+    except ValueError:
+        return False
+
+
 _POLLING_STRATEGIES = {
-    'linux': ['epoll1', 'poll'],
+    'linux': ['epoll1'] + (['io_uring'] if _io_uring_supported() else []) +
+             ['poll'],
     'mac': ['poll'],
 }
 
@@ -492,6 +513,10 @@ class CLanguage(object):
             return ('debian11_openssl102', [
                 "-DgRPC_SSL_PROVIDER=package",
             ])
+        elif compiler == 'gcc10.2_zstd':
+            return ('debian11_zstd', [
+                "-DgRPC_ZSTD_PROVIDER=package",
+            ])
         elif compiler == 'gcc11':
             return ('gcc_11', [])
         elif compiler == 'gcc_musl':
@@ -1554,6 +1579,7 @@ argp.add_argument(
         'gcc6',
         'gcc10.2',
         'gcc10.2_openssl102',
+        'gcc10.2_zstd',
         'gcc11',
         'gcc_musl',
         'clang6',
@@ -300,8 +300,8 @@ def _create_portability_test_jobs(extra_args=[],
 
     # portability C and C++ on x64
     for compiler in [
-            'gcc6', 'gcc10.2_openssl102', 'gcc11', 'gcc_musl', 'clang6',
-            'clang13'
+            'gcc6', 'gcc10.2_openssl102', 'gcc10.2_zstd', 'gcc11', 'gcc_musl',
+            'clang6', 'clang13'
     ]:
         test_jobs += _generate_jobs(languages=['c', 'c++'],
                                     configs=['dbg'],